@@ -339,6 +339,9 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.documentdb.documents.removed.last"));
 
         metrics.add(new Metric("content.proton.documentdb.index.docs_in_memory.last"));
+        metrics.add(new Metric("content.proton.documentdb.index.posting_list_cache.memory_usage.average"));
+        metrics.add(new Metric("content.proton.documentdb.index.posting_list_cache.hit_rate.average"));
+        metrics.add(new Metric("content.proton.documentdb.index.posting_list_cache.lookups.rate"));
         metrics.add(new Metric("content.proton.documentdb.disk_usage.last"));
         metrics.add(new Metric("content.proton.documentdb.memory_usage.allocated_bytes.max"));
         metrics.add(new Metric("content.proton.transport.query.count.rate"));
@@ -523,6 +526,9 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.docs_matched.sum"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.docs_matched.count"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.limited_queries.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.result_cache_hits.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.result_cache_misses.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.result_cache_invalidations.rate"));
 
         return metrics;
     }
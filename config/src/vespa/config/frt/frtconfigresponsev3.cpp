@@ -3,6 +3,7 @@
 #include "compressioninfo.h"
 #include <vespa/fnet/frt/frt.h>
 #include <vespa/vespalib/data/simple_buffer.h>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".config.frt.frtconfigresponsev3");
@@ -22,21 +23,51 @@ std::string make_json(const Slime &slime, bool compact) {
     return buf.get().make_string();
 }
 
+/**
+ * Payload keeping the (possibly compressed) config as received, and
+ * decoding it on first use. Most responses carry a config identical
+ * to the one already held by the agent (same md5), in which case the
+ * payload is dropped without ever being decompressed or parsed.
+ **/
 class V3Payload : public Payload
 {
 public:
-    explicit V3Payload(Slime::UP data) noexcept
-        : _data(std::move(data))
+    V3Payload(const char *buf, uint32_t len, const CompressionInfo &info)
+        : _compressed(buf, buf + len),
+          _info(info),
+          _once(),
+          _data(std::make_unique<Slime>())
     {
     }
 
     const Inspector & getSlimePayload() const override {
+        std::call_once(_once, [this]() { decode(); });
         return _data->get();
     }
 private:
-    Slime::UP _data;
+    void decode() const;
+
+    mutable std::vector<char> _compressed;
+    CompressionInfo           _info;
+    mutable std::once_flag    _once;
+    Slime::UP                 _data;
 };
 
+void
+V3Payload::decode() const
+{
+    DecompressedData data(decompress(_compressed.data(), _compressed.size(), _info.compressionType, _info.uncompressedSize));
+    if (data.memRef.size > 0) {
+        size_t consumedSize = JsonFormat::decode(data.memRef, *_data);
+        if (consumedSize == 0) {
+            std::string json(make_json(*_data, true));
+            LOG(error, "Error decoding JSON. Consumed size: %lu, uncompressed size: %u, compression type: %s, assumed uncompressed size(%u), compressed size: %zu, slime(%s)", consumedSize, data.size, compressionTypeToString(_info.compressionType).c_str(), _info.uncompressedSize, _compressed.size(), json.c_str());
+            LOG_ABORT("Error decoding JSON");
+        }
+    }
+    std::vector<char>().swap(_compressed);
+}
+
 const vespalib::string FRTConfigResponseV3::RESPONSE_TYPES = "sx";
 
 FRTConfigResponseV3::FRTConfigResponseV3(FRT_RPCRequest * request)
@@ -56,20 +87,12 @@ FRTConfigResponseV3::readConfigValue() const
     vespalib::string md5(_data->get()[RESPONSE_CONFIG_MD5].asString().make_string());
     CompressionInfo info;
     info.deserialize(_data->get()[RESPONSE_COMPRESSION_INFO]);
-    auto slime = std::make_unique<Slime>();
-    DecompressedData data(decompress(((*_returnValues)[1]._data._buf), ((*_returnValues)[1]._data._len), info.compressionType, info.uncompressedSize));
-    if (data.memRef.size > 0) {
-        size_t consumedSize = JsonFormat::decode(data.memRef, *slime);
-        if (consumedSize == 0) {
-            std::string json(make_json(*slime, true));
-            LOG(error, "Error decoding JSON. Consumed size: %lu, uncompressed size: %u, compression type: %s, assumed uncompressed size(%u), compressed size: %u, slime(%s)", consumedSize, data.size, compressionTypeToString(info.compressionType).c_str(), info.uncompressedSize, ((*_returnValues)[1]._data._len), json.c_str());
-            LOG_ABORT("Error decoding JSON");
-        }
-    }
+    const char *buf = (*_returnValues)[1]._data._buf;
+    uint32_t len = (*_returnValues)[1]._data._len;
     if (LOG_WOULD_LOG(spam)) {
-        LOG(spam, "read config value md5(%s), payload size: %lu", md5.c_str(), data.memRef.size);
+        LOG(spam, "read config value md5(%s), payload size: %u", md5.c_str(), len);
     }
-    return ConfigValue(std::make_shared<V3Payload>(std::move(slime)), md5);
+    return ConfigValue(std::make_shared<V3Payload>(buf, len, info), md5);
 }
 
 } // namespace config
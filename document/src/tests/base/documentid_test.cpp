@@ -4,6 +4,7 @@
 #include <vespa/document/base/documentid.h>
 #include <vespa/document/base/idstringexception.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 using namespace document;
 using vespalib::string;
@@ -98,6 +99,23 @@ TEST("require that document ids can be assigned") {
     checkUser<IdString>(id2.toString(), 1234);
 }
 
+TEST("require that global ids calculated in batch match single calculation") {
+    std::vector<DocumentId> ids;
+    for (size_t i = 0; i < 21; ++i) {
+        ids.emplace_back(vespalib::make_string("id:%s:%s:n=%zu:%s", ns.c_str(), type.c_str(), i, string(i * 5, 'x').c_str()));
+    }
+    std::vector<const DocumentId *> id_ptrs;
+    for (const auto &id : ids) {
+        id_ptrs.push_back(&id);
+    }
+    ids[3].getGlobalId(); // already calculated ids are left alone
+    DocumentId::calculateGlobalIds(id_ptrs.data(), id_ptrs.size());
+    for (const auto &id : ids) {
+        DocumentId expect(id.toString());
+        EXPECT_EQUAL(expect.getGlobalId(), id.getGlobalId());
+    }
+}
+
 TEST("require that illegal ids fail") {
     EXPECT_EXCEPTION(DocumentId("idg:foo:bar:baz"), IdParseException,
                      "No scheme separator ':' found");
@@ -295,6 +295,36 @@ TEST(DocumentUpdateTest, testUpdateArray)
         std::exception) << "Expected exception when removing an array from a string array.";
 }
 
+TEST(DocumentUpdateTest, assign_followed_by_add_replaces_existing_array)
+{
+    TestDocMan docMan;
+    Document::UP doc(docMan.createDocument());
+    ArrayFieldValue old_array(doc->getType().getField("tags").getDataType());
+    old_array.add(StringFieldValue("old"));
+    doc->setValue(doc->getField("tags"), old_array);
+
+    ArrayFieldValue new_array(doc->getType().getField("tags").getDataType());
+    new_array.add(StringFieldValue("foo"));
+    DocumentUpdate(docMan.getTypeRepo(), *doc->getDataType(), doc->getId())
+        .addUpdate(FieldUpdate(doc->getField("tags"))
+                   .addUpdate(AssignValueUpdate(new_array))
+                   .addUpdate(AddValueUpdate(StringFieldValue("bar"))))
+        .applyTo(*doc);
+    auto fval(doc->getAs<ArrayFieldValue>(doc->getField("tags")));
+    ASSERT_EQ((size_t) 2, fval->size());
+    EXPECT_EQ(std::string("foo"), std::string((*fval)[0].getAsString()));
+    EXPECT_EQ(std::string("bar"), std::string((*fval)[1].getAsString()));
+
+    DocumentUpdate(docMan.getTypeRepo(), *doc->getDataType(), doc->getId())
+        .addUpdate(FieldUpdate(doc->getField("tags"))
+                   .addUpdate(ClearValueUpdate())
+                   .addUpdate(AddValueUpdate(StringFieldValue("baz"))))
+        .applyTo(*doc);
+    auto fval2(doc->getAs<ArrayFieldValue>(doc->getField("tags")));
+    ASSERT_EQ((size_t) 1, fval2->size());
+    EXPECT_EQ(std::string("baz"), std::string((*fval2)[0].getAsString()));
+}
+
 TEST(DocumentUpdateTest, testUpdateWeightedSet)
 {
     // Create a test document
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/random.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <gtest/gtest.h>
+#include <limits>
 
 namespace document {
 
@@ -235,4 +236,50 @@ TEST_F(GlobalIdTest, testBucketOrderCmp)
     }
 }
 
+
+namespace {
+
+bool
+bytewiseBucketOrderLess(const GlobalId &lhs, const GlobalId &rhs)
+{
+    for (size_t i : {0, 1, 2, 3, 8, 9, 10, 11}) {
+        int diff = GlobalId::BucketOrderCmp::compare(lhs.get()[i], rhs.get()[i]);
+        if (diff != 0) {
+            return diff < 0;
+        }
+    }
+    return lhs < rhs;
+}
+
+}
+
+TEST_F(GlobalIdTest, testBucketOrderKey)
+{
+    vespalib::RandomGen rnd(42);
+    GlobalId::BucketOrderCmp cmp;
+    std::vector<GlobalId> gids;
+    for (size_t i = 0; i < 1000; ++i) {
+        unsigned char raw[GlobalId::LENGTH];
+        for (auto &c : raw) {
+            // Few distinct values per byte to get many equal prefixes
+            c = (i % 2 == 0) ? rnd.nextUint32() : (rnd.nextUint32() % 3);
+        }
+        gids.emplace_back(raw);
+    }
+    for (size_t i = 0; i + 1 < gids.size(); ++i) {
+        const GlobalId &a = gids[i];
+        const GlobalId &b = gids[i + 1];
+        EXPECT_EQ(bytewiseBucketOrderLess(a, b), cmp(a, b)) << a << " " << b;
+        EXPECT_EQ(bytewiseBucketOrderLess(b, a), cmp(b, a)) << a << " " << b;
+        EXPECT_FALSE(cmp(a, a));
+    }
+    GlobalId first = GlobalId::parse("gid(0x000000000000000000000000)");
+    GlobalId last = GlobalId::parse("gid(0xffffffffffffffffffffffff)");
+    EXPECT_EQ(0u, GlobalId::BucketOrderCmp::bucketOrderKey(first));
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), GlobalId::BucketOrderCmp::bucketOrderKey(last));
+    // Reversed bits of the first byte end up in the most significant byte of the key
+    GlobalId lowBit = GlobalId::parse("gid(0x010000000000000000000000)");
+    EXPECT_EQ(0x8000000000000000ul, GlobalId::BucketOrderCmp::bucketOrderKey(lowBit));
+}
+
 }
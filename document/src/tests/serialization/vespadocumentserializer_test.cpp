@@ -547,6 +547,38 @@ TEST("requireThatDocumentCanBeSerialized") {
     EXPECT_EQUAL(0, read_version);
 }
 
+TEST("requireThatDocumentCanBeSerializedToPartiallyReadStream") {
+    const DocumentType &type = repo.getDocumentType();
+
+    DocumentId doc_id("id:ns:" + type.getName() + "::");
+    Document value(type, doc_id);
+    value.setValue(type.getField("header field"), IntFieldValue(42));
+    value.setValue(type.getField("body field"), StringFieldValue("foobar"));
+
+    // Size fields are filled in after the fact, and must survive the stream compacting itself when growing.
+    nbostream stream(8);
+    stream << static_cast<uint32_t>(17) << static_cast<uint32_t>(0);
+    uint32_t dummy;
+    stream >> dummy;
+    EXPECT_EQUAL(17u, dummy);
+    VespaDocumentSerializer serializer(stream);
+    serializer.write(value);
+    stream >> dummy;
+    EXPECT_EQUAL(0u, dummy);
+
+    uint16_t read_version;
+    uint32_t size;
+    stream >> read_version >> size;
+    EXPECT_EQUAL(serialization_version, read_version);
+    EXPECT_EQUAL(64u, size);
+    EXPECT_EQUAL(size, stream.size());
+    stream.adjustReadPos(-static_cast<ssize_t>(sizeof(read_version) + sizeof(size)));
+    Document read_value;
+    VespaDocumentDeserializer deserializer(repo, stream, serialization_version);
+    deserializer.read(read_value);
+    EXPECT_EQUAL(value, read_value);
+}
+
 TEST("requireThatOldVersionDocumentCanNotBeDeserialized") {
     uint16_t old_version = 6;
     uint16_t data_size = 432;
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/util/md5.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <ostream>
+#include <vector>
 
 using vespalib::nbostream;
 
@@ -55,7 +56,12 @@ DocumentId::calculateGlobalId() const
 
     unsigned char key[16];
     fastc_md5sum(reinterpret_cast<const unsigned char*>(id.c_str()), id.size(), key);
+    setGlobalId(key);
+}
 
+void
+DocumentId::setGlobalId(unsigned char *key) const
+{
     IdString::LocationType location(_id.getLocation());
     memcpy(key, &location, 4);
 
@@ -63,6 +69,35 @@ DocumentId::calculateGlobalId() const
     _globalId.second.set(key);
 }
 
+void
+DocumentId::calculateGlobalIds(const DocumentId * const * ids, size_t count)
+{
+    std::vector<const DocumentId *> pending;
+    std::vector<const void *> data;
+    std::vector<size_t> sizes;
+    pending.reserve(count);
+    data.reserve(count);
+    sizes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!ids[i]->_globalId.first) {
+            vespalib::stringref id = ids[i]->_id.toString();
+            pending.push_back(ids[i]);
+            data.push_back(id.data());
+            sizes.push_back(id.size());
+        }
+    }
+    std::vector<unsigned char> keys(pending.size() * 16);
+    std::vector<unsigned char *> key_ptrs;
+    key_ptrs.reserve(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        key_ptrs.push_back(&keys[i * 16]);
+    }
+    fastc_md5sum_multi(data.data(), sizes.data(), key_ptrs.data(), pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        pending[i]->setGlobalId(key_ptrs[i]);
+    }
+}
+
 std::ostream &
 operator << (std::ostream & os, const DocumentId & id) {
     return os << id.toString();
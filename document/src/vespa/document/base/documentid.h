@@ -72,12 +72,20 @@ public:
         return _globalId.second;
     }
 
+    /**
+     * Calculates and caches the global ids of many document ids at
+     * once, hashing several of them in parallel. Ids that already have
+     * a cached global id are skipped.
+     */
+    static void calculateGlobalIds(const DocumentId * const * ids, size_t count);
+
     size_t getSerializedSize() const;
 private:
     mutable std::pair<bool, GlobalId> _globalId;
     IdString _id;
 
     void calculateGlobalId() const;
+    void setGlobalId(unsigned char *key) const;
 };
 
 std::ostream & operator << (std::ostream & os, const DocumentId & id);
@@ -64,7 +64,32 @@ public:
      * given bucket.
      */
     struct BucketOrderCmp {
-        bool operator()(const GlobalId &lhs, const GlobalId &rhs) const;
+        bool operator()(const GlobalId &lhs, const GlobalId &rhs) const {
+            uint64_t lhsKey = bucketOrderKey(lhs);
+            uint64_t rhsKey = bucketOrderKey(rhs);
+            if (lhsKey != rhsKey) {
+                return lhsKey < rhsKey;
+            }
+            return lhs < rhs;
+        }
+        /**
+         * Returns the bucket ordered part of the given gid (bytes 0-3 and 8-11, each with its bits
+         * reversed) packed into a single word, such that comparing two keys as unsigned integers
+         * gives the same order as comparing those bytes one by one. The bits of all 8 bytes are
+         * reversed in parallel within the word instead of by table lookup.
+         */
+        static uint64_t bucketOrderKey(const GlobalId &gid) noexcept {
+            uint64_t key = uint64_t(gid._gid._nums[0]) | (uint64_t(gid._gid._nums[2]) << 32);
+            key = ((key >> 1) & 0x5555555555555555ul) | ((key & 0x5555555555555555ul) << 1);
+            key = ((key >> 2) & 0x3333333333333333ul) | ((key & 0x3333333333333333ul) << 2);
+            key = ((key >> 4) & 0x0f0f0f0f0f0f0f0ful) | ((key & 0x0f0f0f0f0f0f0f0ful) << 4);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            key = __builtin_bswap64(key);
+#else
+            key = (key << 32) | (key >> 32);
+#endif
+            return key;
+        }
         //These 2 compare methods are exposed only for testing
         static int compareRaw(unsigned char a, unsigned char b) {
             return a - b;
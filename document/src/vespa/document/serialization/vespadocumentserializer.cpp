@@ -96,29 +96,50 @@ getContentCode(bool hasContent)
            (hasContent ? 0x02u : 0x00u);   // Payload ?
 }
 
+/*
+ * Writes a 32 bit size placeholder, to be filled in by fillInSize() once
+ * the value following it has been written. Avoids serializing into a
+ * temporary stream only to learn its size. Positions are kept relative to
+ * the read position, as the stream compacts itself when growing.
+ */
+size_t
+reserveSize(nbostream &stream)
+{
+    size_t size_pos = stream.size();
+    stream << static_cast<uint32_t>(0);
+    return size_pos;
+}
+
+void
+fillInSize(nbostream &stream, size_t size_pos)
+{
+    size_t end_pos = stream.size();
+    stream.wp(stream.rp() + size_pos);
+    stream << static_cast<uint32_t>(end_pos - size_pos - sizeof(uint32_t));
+    stream.wp(stream.rp() + end_pos);
+}
+
 }
 
 void
 VespaDocumentSerializer::write(const Document &value) {
-    nbostream doc_stream;
-    VespaDocumentSerializer doc_serializer(doc_stream);
-    doc_serializer.write(value.getId());
+    const uint16_t version = serialize_version;
+    _stream << version;
+    size_t size_pos = reserveSize(_stream);
+    write(value.getId());
 
     bool hasContent = ! value.getFields().empty();
-    doc_stream << getContentCode(hasContent);
-    doc_serializer.write(value.getType());
+    _stream << getContentCode(hasContent);
+    write(value.getType());
 
     if ( hasContent ) {
         if (!structNeedsReserialization(value.getFields())) {
-            doc_serializer.writeUnchanged(value.getFields().getFields());
+            writeUnchanged(value.getFields().getFields());
         } else {
-            doc_serializer.write(value.getFields(), AllFields());
+            write(value.getFields(), AllFields());
         }
     }
-
-    const uint16_t version = serialize_version;
-    _stream << version << static_cast<uint32_t>(doc_stream.size());
-    _stream.write(doc_stream.peek(), doc_stream.size());
+    fillInSize(_stream, size_pos);
 }
 
 void
@@ -356,12 +377,10 @@ VespaDocumentSerializer::write(const WeightedSetFieldValue &value) {
     _stream << static_cast<uint32_t>(type->getNestedType().getId());
     _stream << static_cast<uint32_t>(value.size());
     for (const auto & entry : value) {
-        nbostream stream;
-        VespaDocumentSerializer serializer(stream);
-        serializer.write(*entry.first);
-        serializer.write(*entry.second);
-        _stream << static_cast<uint32_t>(stream.size());  // This is unused
-        _stream.write(stream.peek(), stream.size());
+        size_t size_pos = reserveSize(_stream);  // This is unused
+        write(*entry.first);
+        write(*entry.second);
+        fillInSize(_stream, size_pos);
     }
 }
 
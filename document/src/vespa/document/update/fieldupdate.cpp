@@ -65,11 +65,22 @@ FieldUpdate::printXml(XmlOutputStream& xos) const
 }
 
 // Apply this field update to the given document.
+bool
+FieldUpdate::overwritesValue() const
+{
+    if (_updates.empty()) {
+        return false;
+    }
+    ValueUpdate::ValueUpdateType type = _updates.front()->getType();
+    return (type == ValueUpdate::Assign) || (type == ValueUpdate::Clear);
+}
+
 void
 FieldUpdate::applyTo(Document& doc) const
 {
     const DataType& datatype = _field.getDataType();
-    FieldValue::UP value = doc.getValue(_field);
+    // An assign or clear first discards the old value, so don't bother deserializing it
+    FieldValue::UP value = overwritesValue() ? FieldValue::UP() : doc.getValue(_field);
 
     for (const ValueUpdate::CP & update : _updates) {
         if ( ! value) {
@@ -28,6 +28,9 @@ class FieldUpdate : public vespalib::Identifiable,
     std::vector<ValueUpdate::CP> _updates;
     using nbostream = vespalib::nbostream;
 
+    /** @return true if the first value update replaces the existing value regardless of its content. */
+    bool overwritesValue() const;
+
 public:
     typedef vespalib::CloneablePtr<FieldUpdate> CP;
 
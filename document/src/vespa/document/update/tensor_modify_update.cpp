@@ -160,13 +160,19 @@ TensorModifyUpdate::checkCompatibility(const Field& field) const
     }
 }
 
+TensorModifyUpdate::join_fun_t
+TensorModifyUpdate::getJoinFunction() const
+{
+    return document::getJoinFunction(_operation);
+}
+
 std::unique_ptr<vespalib::eval::Value>
 TensorModifyUpdate::applyTo(const vespalib::eval::Value &tensor) const
 {
     auto cellsTensor = _tensor->getAsTensorPtr();
     if (cellsTensor) {
         auto engine = EngineOrFactory::get();
-        return TensorPartialUpdate::modify(tensor, getJoinFunction(_operation), *cellsTensor, engine);
+        return TensorPartialUpdate::modify(tensor, getJoinFunction(), *cellsTensor, engine);
     }
     return {};
 }
@@ -38,7 +38,9 @@ public:
     TensorModifyUpdate &operator=(const TensorModifyUpdate &rhs);
     TensorModifyUpdate &operator=(TensorModifyUpdate &&rhs);
     bool operator==(const ValueUpdate &other) const override;
+    using join_fun_t = double (*)(double, double);
     Operation getOperation() const { return _operation; }
+    join_fun_t getJoinFunction() const;
     const TensorFieldValue &getTensor() const { return *_tensor; }
     void checkCompatibility(const Field &field) const override;
     std::unique_ptr<vespalib::eval::Value> applyTo(const vespalib::eval::Value &tensor) const;
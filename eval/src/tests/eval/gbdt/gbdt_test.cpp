@@ -50,6 +50,11 @@ double eval_ff(const FastForest &ff, FastForest::Context &ctx, const std::vector
     return ff.eval(ctx, &my_params[0]);
 }
 
+double eval_ff_bounded(const FastForest &ff, FastForest::Context &ctx, const std::vector<double> &params, double limit) {
+    std::vector<float> my_params(params.begin(), params.end());
+    return ff.eval_bounded(ctx, &my_params[0], limit);
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that tree stats can be calculated") {
@@ -407,6 +412,68 @@ TEST("require that fast forest evaluation is correct for all tree size categorie
     }
 }
 
+TEST("require that bounded fast forest evaluates to the same as the fast forest") {
+    for (size_t segment_size: std::vector<size_t>({1, 7, 64, 1000})) {
+        vespalib::string expression = Model().max_features(35).less_percent(100).invert_percent(50).make_forest(127, 30);
+        auto function = Function::parse(expression);
+        auto forest = FastForest::try_convert(*function);
+        auto bounded = FastForest::try_convert_bounded(*function, segment_size);
+        ASSERT_TRUE(forest);
+        ASSERT_TRUE(bounded);
+        EXPECT_EQUAL(vespalib::string("ff-segmented"), bounded->impl_name());
+        std::vector<double> inputs(function->num_params(), 0.5);
+        std::vector<double> inputs_nan(function->num_params(), std::numeric_limits<double>::quiet_NaN());
+        auto ctx = forest->create_context();
+        auto bounded_ctx = bounded->create_context();
+        EXPECT_APPROX(eval_ff(*forest, *ctx, inputs), eval_ff(*bounded, *bounded_ctx, inputs), 1e-6);
+        EXPECT_APPROX(eval_ff(*forest, *ctx, inputs_nan), eval_ff(*bounded, *bounded_ctx, inputs_nan), 1e-6);
+    }
+}
+
+TEST("require that bounded fast forest evaluation is exact above the limit") {
+    vespalib::string expression = Model().max_features(35).less_percent(100).invert_percent(50).make_forest(127, 30);
+    auto function = Function::parse(expression);
+    auto bounded = FastForest::try_convert_bounded(*function, 16);
+    ASSERT_TRUE(bounded);
+    auto ctx = bounded->create_context();
+    for (double input: {0.1, 0.5, 0.9}) {
+        std::vector<double> inputs(function->num_params(), input);
+        double expected = eval_ff(*bounded, *ctx, inputs);
+        for (double offset: {-1000.0, -10.0, -1.0, -0.01, 0.0, 0.01, 1.0, 10.0}) {
+            double limit = expected + offset;
+            double result = eval_ff_bounded(*bounded, *ctx, inputs, limit);
+            if (expected > limit) {
+                EXPECT_EQUAL(expected, result);
+            } else {
+                EXPECT_LESS_EQUAL(result, limit);
+                EXPECT_GREATER_EQUAL(result, expected);
+            }
+        }
+    }
+}
+
+TEST("require that bounded fast forest evaluation gives up when no trees can lift the result above the limit") {
+    auto function = Function::parse("if((a<2),1.0,if((b<2),if((c<2),2.0,3.0),4.0))+"
+                                    "if(!(c>=1),10.0,if((a<1),if((b<1),20.0,30.0),40.0))");
+    auto bounded = FastForest::try_convert_bounded(*function, 1);
+    ASSERT_TRUE(bounded);
+    auto ctx = bounded->create_context();
+    std::vector<double> p1({0.5, 0.5, 0.5}); // all true: 1.0 + 10.0
+    EXPECT_EQUAL(11.0, eval_ff_bounded(*bounded, *ctx, p1, 10.0));
+    EXPECT_EQUAL(44.0, eval_ff_bounded(*bounded, *ctx, p1, 44.0));  // 4.0 + 40.0 is the max result
+    EXPECT_EQUAL(14.0, eval_ff_bounded(*bounded, *ctx, p1, 20.0));  // 10.0 + max 4.0 from the other tree
+}
+
+TEST("require that regular fast forest ignores the limit for bounded evaluation") {
+    auto function = Function::parse("if((a<2),1.0,if((b<2),if((c<2),2.0,3.0),4.0))+"
+                                    "if(!(c>=1),10.0,if((a<1),if((b<1),20.0,30.0),40.0))");
+    auto forest = FastForest::try_convert(*function);
+    ASSERT_TRUE(forest);
+    auto ctx = forest->create_context();
+    std::vector<double> p1({0.5, 0.5, 0.5});
+    EXPECT_EQUAL(11.0, eval_ff_bounded(*forest, *ctx, p1, 100.0));
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that GDBT expressions can be detected") {
@@ -214,6 +214,40 @@ TEST(ValueCodecTest, dense_tensors_can_be_encoded_and_decoded) {
     f1.verify_encode_decode(true);
 }
 
+template <typename T>
+void verify_large_dense_tensor(const vespalib::string &type_spec) {
+    size_t num_cells = 1000;
+    TensorSpec spec(type_spec);
+    nbostream expect;
+    expect.putInt1_4Bytes(std::is_same_v<T, double> ? 2 : 6);
+    if (!std::is_same_v<T, double>) {
+        expect.putInt1_4Bytes(std::is_same_v<T, float> ? 1 : std::is_same_v<T, BFloat16> ? 2 : 3);
+    }
+    expect.putInt1_4Bytes(1);
+    expect.writeSmallString("x");
+    expect.putInt1_4Bytes(num_cells);
+    for (size_t i = 0; i < num_cells; ++i) {
+        double value = double(i % 100) - 50.0;
+        spec.add({{"x", i}}, value);
+        expect << (T) value;
+    }
+    auto value = value_from_spec(spec, SimpleValueBuilderFactory::get());
+    nbostream actual;
+    encode_value(*value, actual);
+    ASSERT_EQ(expect.size(), actual.size());
+    EXPECT_EQ(0, memcmp(expect.peek(), actual.peek(), actual.size()));
+    auto decoded = decode_value(actual, SimpleValueBuilderFactory::get());
+    EXPECT_EQ(0u, actual.size());
+    EXPECT_EQ(spec, spec_from_value(*decoded));
+}
+
+TEST(ValueCodecTest, large_dense_tensors_of_all_cell_types_can_be_encoded_and_decoded) {
+    verify_large_dense_tensor<double>("tensor(x[1000])");
+    verify_large_dense_tensor<float>("tensor<float>(x[1000])");
+    verify_large_dense_tensor<BFloat16>("tensor<bfloat16>(x[1000])");
+    verify_large_dense_tensor<int8_t>("tensor<int8>(x[1000])");
+}
+
 TEST(ValueCodecTest, dense_tensors_without_values_are_filled) {
     TensorSpec empty_dense_spec("tensor(x[3],y[2])");
     auto value = value_from_spec(empty_dense_spec, SimpleValueBuilderFactory::get());
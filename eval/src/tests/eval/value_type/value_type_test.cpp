@@ -258,6 +258,17 @@ TEST("require that value types preserve cell type") {
     EXPECT_TRUE(type("tensor(x[10])").cell_type() == CellType::DOUBLE);
     EXPECT_TRUE(type("tensor<double>(x[10])").cell_type() == CellType::DOUBLE);
     EXPECT_TRUE(type("tensor<float>(x[10])").cell_type() == CellType::FLOAT);
+    EXPECT_TRUE(type("tensor<bfloat16>(x[10])").cell_type() == CellType::BFLOAT16);
+    EXPECT_TRUE(type("tensor<int8>(x[10])").cell_type() == CellType::INT8);
+}
+
+TEST("require that compact cell types are decayed to float when computing new cells") {
+    EXPECT_EQUAL(type("tensor<bfloat16>(x[10],y[5])").reduce({"y"}), type("tensor<float>(x[10])"));
+    EXPECT_EQUAL(type("tensor<int8>(x[10],y[5])").reduce({"y"}), type("tensor<float>(x[10])"));
+    EXPECT_EQUAL(type("tensor<bfloat16>(x[10])").map(), type("tensor<float>(x[10])"));
+    EXPECT_EQUAL(type("tensor<int8>(x{})").map(), type("tensor<float>(x{})"));
+    EXPECT_EQUAL(type("tensor<double>(x[10])").map(), type("tensor<double>(x[10])"));
+    EXPECT_EQUAL(type("tensor<int8>(x[10])").rename({"x"}, {"y"}), type("tensor<int8>(y[10])"));
 }
 
 TEST("require that dimension names can be obtained") {
@@ -411,6 +422,9 @@ TEST("require that cell type is handled correctly for join") {
     TEST_DO(verify_join(type("tensor(x{})"), type("tensor<float>(y{})"), type("tensor(x{},y{})")));
     TEST_DO(verify_join(type("tensor<float>(x{})"), type("tensor<float>(y{})"), type("tensor<float>(x{},y{})")));
     TEST_DO(verify_join(type("tensor<float>(x{})"), type("double"), type("tensor<float>(x{})")));
+    TEST_DO(verify_join(type("tensor<bfloat16>(x{})"), type("tensor<int8>(y{})"), type("tensor<float>(x{},y{})")));
+    TEST_DO(verify_join(type("tensor<bfloat16>(x{})"), type("tensor(y{})"), type("tensor(x{},y{})")));
+    TEST_DO(verify_join(type("tensor<int8>(x{})"), type("double"), type("tensor<float>(x{})")));
 }
 
 void verify_not_joinable(const ValueType &a, const ValueType &b) {
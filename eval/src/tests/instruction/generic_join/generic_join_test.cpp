@@ -31,6 +31,8 @@ std::vector<Layout> join_layouts = {
     {x({"a","b","c"})},                                 {y({"foo","bar","baz"})},
     {x({"a","b","c"})},                                 {x({"a","b","c"}),y({"foo","bar","baz"})},
     {x({"a","b"}),y({"foo","bar","baz"})},              {x({"a","b","c"}),y({"foo","bar"})},
+    {x({"a","b"}),y({"foo","bar","baz"})},              {y({"foo","bar"})},
+    {x({"a","b"}),y({"foo","bar","baz"})},              float_cells({x({"a","c"})}),
     {x({"a","b"}),y({"foo","bar","baz"})},              {y({"foo","bar"}),z({"i","j","k","l"})},
     float_cells({x({"a","b"}),y({"foo","bar","baz"})}), {y({"foo","bar"}),z({"i","j","k","l"})},
     {x({"a","b"}),y({"foo","bar","baz"})},              float_cells({y({"foo","bar"}),z({"i","j","k","l"})}),
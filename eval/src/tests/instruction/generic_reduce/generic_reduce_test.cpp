@@ -1,5 +1,6 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/instruction/generic_reduce.h>
@@ -71,6 +72,15 @@ TensorSpec perform_generic_reduce(const TensorSpec &a, const std::vector<vespali
     return spec_from_value(single.eval(std::vector<Value::CREF>({*lhs})));
 }
 
+TensorSpec perform_generic_reduce_fast(const TensorSpec &a, const std::vector<vespalib::string> &dims, Aggr aggr) {
+    Stash stash;
+    const auto &factory = FastValueBuilderFactory::get();
+    auto lhs = value_from_spec(a, factory);
+    auto my_op = GenericReduce::make_instruction(lhs->type(), aggr, dims, factory, stash);
+    InterpretedFunction::EvalSingle single(factory, my_op);
+    return spec_from_value(single.eval(std::vector<Value::CREF>({*lhs})));
+}
+
 TEST(GenericReduceTest, dense_reduce_plan_can_be_created) {
     auto type = ValueType::from_spec("tensor(a[2],aa{},b[2],bb[1],c[2],cc{},d[2],dd[1],e[2],ee{},f[2])");
     auto plan = DenseReducePlan(type, type.reduce({"a", "d", "e"}));
@@ -94,18 +104,32 @@ TEST(GenericReduceTest, sparse_reduce_plan_can_be_created) {
     EXPECT_EQ(plan.keep_dims, expect_keep_dims);
 }
 
-TEST(GenericReduceTest, generic_reduce_works_for_simple_values) {
+TEST(GenericReduceTest, generic_reduce_works_for_simple_and_fast_values) {
     for (const Layout &layout: layouts) {
         TensorSpec input = spec(layout, Div16(N()));
         for (Aggr aggr: {Aggr::SUM, Aggr::AVG, Aggr::MIN, Aggr::MAX}) {
             for (const Domain &domain: layout) {
                 auto expect = reference_reduce(input, {domain.dimension}, aggr);
                 auto actual = perform_generic_reduce(input, {domain.dimension}, aggr);
+                auto fast = perform_generic_reduce_fast(input, {domain.dimension}, aggr);
                 EXPECT_EQ(actual, expect);
+                EXPECT_EQ(fast, expect);
             }
             auto expect = reference_reduce(input, {}, aggr);
             auto actual = perform_generic_reduce(input, {}, aggr);
+            auto fast = perform_generic_reduce_fast(input, {}, aggr);
             EXPECT_EQ(actual, expect);
+            EXPECT_EQ(fast, expect);
+        }
+    }
+}
+
+TEST(GenericReduceTest, fast_sparse_reduce_works_for_multiple_dimensions) {
+    TensorSpec input = spec({x({"a","b","c"}),y({"foo","bar"}),z({"i","j","k","l"})}, Div16(N()));
+    for (Aggr aggr: {Aggr::SUM, Aggr::AVG, Aggr::MIN, Aggr::MAX}) {
+        for (const auto &dims: std::vector<std::vector<vespalib::string>>({{"x","y"}, {"x","z"}, {"y","z"}, {"x","y","z"}})) {
+            auto expect = reference_reduce(input, dims, aggr);
+            EXPECT_EQ(perform_generic_reduce_fast(input, dims, aggr), expect);
         }
     }
 }
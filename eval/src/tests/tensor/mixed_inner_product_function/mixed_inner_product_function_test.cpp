@@ -0,0 +1,120 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/mixed/mixed_inner_product_function.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+const ValueBuilderFactory &fast_factory = FastValueBuilderFactory::get();
+
+struct MySeq : Sequence {
+    double operator[](size_t i) const override { return (i % 7) + 1.5; }
+};
+
+Domain cat() { return Domain("cat", {"a", "b", "c"}); }
+Domain empty_cat() { return Domain("cat", std::vector<vespalib::string>()); }
+
+void add_both(EvalFixture::ParamRepo &repo, const vespalib::string &name, const Layout &layout) {
+    repo.add(name, spec(layout, MySeq()));
+    repo.add(name + "f", spec(float_cells(layout), MySeq()));
+}
+
+EvalFixture::ParamRepo make_params() {
+    EvalFixture::ParamRepo repo;
+    add_both(repo, "x3", {x(3)});
+    add_both(repo, "x8", {x(8)});
+    add_both(repo, "x3y2", {x(3),y(2)});
+    add_both(repo, "y2", {y(2)});
+    add_both(repo, "z5", {z(5)});
+    add_both(repo, "cat_x3", {cat(),x(3)});
+    add_both(repo, "cat_x8", {cat(),x(8)});
+    add_both(repo, "cat_x3y2", {cat(),x(3),y(2)});
+    add_both(repo, "cat_x3z5", {cat(),x(3),z(5)});
+    add_both(repo, "empty_x8", {empty_cat(),x(8)});
+    repo.add("cat", spec({cat()}, MySeq()));
+    return repo;
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, size_t vector_size, size_t out_subspace_size) {
+    auto expect = EvalFixture::ref(expr, param_repo);
+    for (EngineOrFactory engine: {EngineOrFactory(prod_engine), EngineOrFactory(fast_factory)}) {
+        EvalFixture slow_fixture(engine, expr, param_repo, false);
+        EvalFixture fixture(engine, expr, param_repo, true);
+        EXPECT_EQUAL(fixture.result(), expect);
+        EXPECT_EQUAL(slow_fixture.result(), expect);
+        auto info = fixture.find_all<MixedInnerProductFunction>();
+        ASSERT_EQUAL(info.size(), 1u);
+        EXPECT_TRUE(info[0]->result_is_mutable());
+        EXPECT_EQUAL(info[0]->vector_size(), vector_size);
+        EXPECT_EQUAL(info[0]->out_subspace_size(), out_subspace_size);
+    }
+}
+
+void verify_optimized_multi(const vespalib::string &mixed, const vespalib::string &vector,
+                            const vespalib::string &dims, size_t vector_size, size_t out_subspace_size)
+{
+    for (const char *mixed_suffix: {"", "f"}) {
+        for (const char *vector_suffix: {"", "f"}) {
+            auto a = mixed + mixed_suffix;
+            auto b = vector + vector_suffix;
+            auto expr = make_string("reduce(%s*%s,sum,%s)", a.c_str(), b.c_str(), dims.c_str());
+            auto flipped = make_string("reduce(%s*%s,sum,%s)", b.c_str(), a.c_str(), dims.c_str());
+            TEST_STATE(expr.c_str());
+            TEST_DO(verify_optimized(expr, vector_size, out_subspace_size));
+            TEST_DO(verify_optimized(flipped, vector_size, out_subspace_size));
+        }
+    }
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    auto expect = EvalFixture::ref(expr, param_repo);
+    for (EngineOrFactory engine: {EngineOrFactory(prod_engine), EngineOrFactory(fast_factory)}) {
+        EvalFixture fixture(engine, expr, param_repo, true);
+        EXPECT_EQUAL(fixture.result(), expect);
+        auto info = fixture.find_all<MixedInnerProductFunction>();
+        EXPECT_TRUE(info.empty());
+    }
+}
+
+TEST("require that mixed inner product gives same results as reference join/reduce") {
+    TEST_DO(verify_optimized_multi("cat_x3", "x3", "x", 3, 1));
+    TEST_DO(verify_optimized_multi("cat_x8", "x8", "x", 8, 1));
+    TEST_DO(verify_optimized_multi("cat_x3y2", "y2", "y", 2, 3));
+    TEST_DO(verify_optimized_multi("cat_x3y2", "x3y2", "x,y", 6, 1));
+    TEST_DO(verify_optimized_multi("cat_x3z5", "z5", "z", 5, 3));
+}
+
+TEST("require that mixed inner product works with empty mixed tensor") {
+    TEST_DO(verify_optimized_multi("empty_x8", "x8", "x", 8, 1));
+}
+
+TEST("require that expressions similar to mixed inner product are not optimized") {
+    TEST_DO(verify_not_optimized("reduce(cat_x3*x3,prod,x)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3*x3,sum)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3*x3,sum,cat,x)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3y2*x3,sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3y2*y2,sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3y2*y2,sum,x,y)"));
+    TEST_DO(verify_not_optimized("reduce(join(cat_x3,x3,f(x,y)(x+y)),sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3*cat,sum,x)"));
+}
+
+TEST("require that mixed inner product can be debug dumped") {
+    EvalFixture fixture(fast_factory, "reduce(cat_x8*x8,sum,x)", param_repo, true);
+    auto info = fixture.find_all<MixedInnerProductFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    fprintf(stderr, "%s\n", info[0]->as_string().c_str());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
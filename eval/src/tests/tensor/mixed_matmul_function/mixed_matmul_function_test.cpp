@@ -0,0 +1,117 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/mixed/mixed_matmul_function.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+const ValueBuilderFactory &fast_factory = FastValueBuilderFactory::get();
+
+struct MySeq : Sequence {
+    double operator[](size_t i) const override { return (i % 11) + 0.5; }
+};
+
+Domain cat() { return Domain("cat", {"a", "b", "c"}); }
+Domain empty_cat() { return Domain("cat", std::vector<vespalib::string>()); }
+
+void add_both(EvalFixture::ParamRepo &repo, const vespalib::string &name, const Layout &layout) {
+    repo.add(name, spec(layout, MySeq()));
+    repo.add(name + "f", spec(float_cells(layout), MySeq()));
+}
+
+EvalFixture::ParamRepo make_params() {
+    EvalFixture::ParamRepo repo;
+    add_both(repo, "cat_x3", {cat(),x(3)});
+    add_both(repo, "cat_y3", {cat(),y(3)});
+    add_both(repo, "cat_w2x3", {cat(),Domain("w", 2),x(3)});
+    add_both(repo, "cat_x3z2", {cat(),x(3),z(2)});
+    add_both(repo, "empty_x3", {empty_cat(),x(3)});
+    add_both(repo, "x3y4", {x(3),y(4)});
+    add_both(repo, "x4y3", {x(4),y(3)});
+    add_both(repo, "x3", {x(3)});
+    return repo;
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, size_t lhs_size, size_t common_size,
+                      size_t rhs_size, bool rhs_common_inner)
+{
+    auto expect = EvalFixture::ref(expr, param_repo);
+    for (EngineOrFactory engine: {EngineOrFactory(prod_engine), EngineOrFactory(fast_factory)}) {
+        EvalFixture slow_fixture(engine, expr, param_repo, false);
+        EvalFixture fixture(engine, expr, param_repo, true);
+        EXPECT_EQUAL(fixture.result(), expect);
+        EXPECT_EQUAL(slow_fixture.result(), expect);
+        auto info = fixture.find_all<MixedMatMulFunction>();
+        ASSERT_EQUAL(info.size(), 1u);
+        EXPECT_TRUE(info[0]->result_is_mutable());
+        EXPECT_EQUAL(info[0]->lhs_size(), lhs_size);
+        EXPECT_EQUAL(info[0]->common_size(), common_size);
+        EXPECT_EQUAL(info[0]->rhs_size(), rhs_size);
+        EXPECT_EQUAL(info[0]->rhs_common_inner(), rhs_common_inner);
+    }
+}
+
+void verify_optimized_multi(const vespalib::string &mixed, const vespalib::string &matrix, const vespalib::string &dim,
+                            size_t lhs_size, size_t common_size, size_t rhs_size, bool rhs_common_inner)
+{
+    for (const char *mixed_suffix: {"", "f"}) {
+        for (const char *matrix_suffix: {"", "f"}) {
+            auto a = mixed + mixed_suffix;
+            auto b = matrix + matrix_suffix;
+            auto expr = make_string("reduce(%s*%s,sum,%s)", a.c_str(), b.c_str(), dim.c_str());
+            auto flipped = make_string("reduce(%s*%s,sum,%s)", b.c_str(), a.c_str(), dim.c_str());
+            TEST_STATE(expr.c_str());
+            TEST_DO(verify_optimized(expr, lhs_size, common_size, rhs_size, rhs_common_inner));
+            TEST_DO(verify_optimized(flipped, lhs_size, common_size, rhs_size, rhs_common_inner));
+        }
+    }
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    auto expect = EvalFixture::ref(expr, param_repo);
+    for (EngineOrFactory engine: {EngineOrFactory(prod_engine), EngineOrFactory(fast_factory)}) {
+        EvalFixture fixture(engine, expr, param_repo, true);
+        EXPECT_EQUAL(fixture.result(), expect);
+        auto info = fixture.find_all<MixedMatMulFunction>();
+        EXPECT_TRUE(info.empty());
+    }
+}
+
+TEST("require that mixed matmul gives same results as reference join/reduce") {
+    TEST_DO(verify_optimized_multi("cat_x3", "x3y4", "x", 1, 3, 4, false));
+    TEST_DO(verify_optimized_multi("cat_y3", "x4y3", "y", 1, 3, 4, true));
+    TEST_DO(verify_optimized_multi("cat_w2x3", "x3y4", "x", 2, 3, 4, false));
+}
+
+TEST("require that mixed matmul works with empty mixed tensor") {
+    TEST_DO(verify_optimized_multi("empty_x3", "x3y4", "x", 1, 3, 4, false));
+}
+
+TEST("require that expressions similar to mixed matmul are not optimized") {
+    TEST_DO(verify_not_optimized("reduce(cat_x3*x3y4,prod,x)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3*x3y4,sum,y)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3*x3y4,sum,x,y)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3z2*x3y4,sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(cat_x3*x3,sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(join(cat_x3,x3y4,f(x,y)(x+y)),sum,x)"));
+}
+
+TEST("require that mixed matmul can be debug dumped") {
+    EvalFixture fixture(fast_factory, "reduce(cat_w2x3*x3y4,sum,x)", param_repo, true);
+    auto info = fixture.find_all<MixedMatMulFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    fprintf(stderr, "%s\n", info[0]->as_string().c_str());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
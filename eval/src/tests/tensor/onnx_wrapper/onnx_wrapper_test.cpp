@@ -175,6 +175,33 @@ TEST(OnnxTest, simple_onnx_model_can_be_evaluated)
     //-------------------------------------------------------------------------
 }
 
+TEST(OnnxTest, onnx_model_can_be_evaluated_with_different_intra_op_threads)
+{
+    for (size_t threads: {0, 1, 4}) {
+        Onnx model(simple_model, Onnx::Optimize::ENABLE, threads);
+        Onnx::WirePlanner planner;
+        ValueType query_type = ValueType::from_spec("tensor<float>(a[1],b[4])");
+        std::vector<float> query_values({1.0, 2.0, 3.0, 4.0});
+        DenseTensorView query(query_type, TypedCells(query_values));
+        EXPECT_TRUE(planner.bind_input_type(query_type, model.inputs()[0]));
+        ValueType attribute_type = ValueType::from_spec("tensor<float>(a[4],b[1])");
+        std::vector<float> attribute_values({5.0, 6.0, 7.0, 8.0});
+        DenseTensorView attribute(attribute_type, TypedCells(attribute_values));
+        EXPECT_TRUE(planner.bind_input_type(attribute_type, model.inputs()[1]));
+        ValueType bias_type = ValueType::from_spec("tensor<float>(a[1],b[1])");
+        std::vector<float> bias_values({9.0});
+        DenseTensorView bias(bias_type, TypedCells(bias_values));
+        EXPECT_TRUE(planner.bind_input_type(bias_type, model.inputs()[2]));
+        Onnx::WireInfo wire_info = planner.get_wire_info(model);
+        Onnx::EvalContext ctx(model, wire_info);
+        ctx.bind_param(0, query);
+        ctx.bind_param(1, attribute);
+        ctx.bind_param(2, bias);
+        ctx.eval();
+        EXPECT_EQ(GetCell::from(ctx.get_result(0).cells(), 0), 79.0);
+    }
+}
+
 TEST(OnnxTest, dynamic_onnx_model_can_be_evaluated)
 {
     Onnx model(dynamic_model, Onnx::Optimize::ENABLE);
@@ -308,4 +335,9 @@ TEST(OnnxTest, we_guess_batch_dimension_size_when_inference_fails) {
     //-------------------------------------------------------------------------
 }
 
-GTEST_MAIN_RUN_ALL_TESTS()
+int main(int argc, char **argv) {
+    // must be set before the first model is loaded
+    Onnx::set_shared_intra_op_threads(2);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
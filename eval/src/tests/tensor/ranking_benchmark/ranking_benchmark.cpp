@@ -0,0 +1,391 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+// Benchmark evaluating complete expressions shaped like the ones
+// found in production rank profiles; sparse weighted set dot
+// products, dense and mixed embedding similarity, small neural
+// networks, gbdt forests and onnx models. In contrast to the
+// instruction benchmark, which compares single instructions, this
+// benchmark measures the end-to-end cost of evaluating a ranking
+// expression including the optimizations performed when setting up
+// the interpreted function. All implementations of a case are
+// verified to produce the same result as the reference
+// implementation before being timed. Both the time used per
+// evaluation and the number of heap allocations per evaluation are
+// reported.
+//
+// Additional expressions can be benchmarked by passing
+// '--cases=<file>' where each (non-empty, non-comment) line of the
+// file describes a single case:
+//
+//   <name>|<expression>|<param>=<type>[:<labels>]|...
+//
+// Parameter values are generated from their types; mapped
+// dimensions get <labels> labels (default 16). Additional onnx models
+// can be benchmarked by passing '--onnx=<file>'. Unknown dimension
+// sizes of model inputs are bound to 1.
+
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/fast_forest.h>
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/llvm/compiled_function.h>
+#include <vespa/eval/eval/node_types.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/onnx_wrapper.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include "../../eval/gbdt/model.cpp"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::tensor;
+using vespalib::make_string_short::fmt;
+
+//-----------------------------------------------------------------------------
+
+// count all heap allocations done by this program
+
+std::atomic<size_t> num_allocs(0);
+
+void *operator new(size_t size) {
+    num_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+//-----------------------------------------------------------------------------
+
+constexpr double budget = 2.0;
+constexpr size_t alloc_samples = 64;
+constexpr size_t default_labels = 16;
+
+std::string get_source_dir() {
+    const char *dir = getenv("SOURCE_DIRECTORY");
+    return (dir ? dir : ".");
+}
+std::string source_dir = get_source_dir();
+
+std::vector<vespalib::string> extra_case_files;
+std::vector<vespalib::string> extra_onnx_models;
+
+struct Measurement {
+    double ns_per_eval;
+    double allocs_per_eval;
+};
+
+template <typename F>
+Measurement measure(F &&f) {
+    size_t before = num_allocs.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < alloc_samples; ++i) {
+        f();
+    }
+    size_t after = num_allocs.load(std::memory_order_relaxed);
+    double seconds = BenchmarkTimer::benchmark(f, budget);
+    return Measurement{seconds * 1000.0 * 1000.0 * 1000.0, double(after - before) / alloc_samples};
+}
+
+void report(const vespalib::string &impl, const Measurement &m) {
+    fprintf(stderr, "    %-20s: %12.1f ns/eval %8.2f allocs/eval\n", impl.c_str(), m.ns_per_eval, m.allocs_per_eval);
+}
+
+//-----------------------------------------------------------------------------
+
+// generate (deterministic) cell values for all cells of the given type
+struct ValueGen {
+    const ValueType &type;
+    size_t labels;
+    double seq;
+    TensorSpec spec;
+    ValueGen(const ValueType &type_in, size_t labels_in, size_t seed)
+        : type(type_in), labels(labels_in), seq(seed), spec(type_in.to_spec()) {}
+    double next() {
+        seq += 1.0;
+        return ((size_t(seq * 7919) % 2001) / 1000.0) - 1.0;
+    }
+    void add_cells(TensorSpec::Address &addr, size_t dim_idx) {
+        if (dim_idx == type.dimensions().size()) {
+            spec.add(addr, next());
+            return;
+        }
+        const auto &dim = type.dimensions()[dim_idx];
+        if (dim.is_mapped()) {
+            for (size_t i = 0; i < labels; ++i) {
+                addr.insert_or_assign(dim.name, TensorSpec::Label(fmt("%zu", i)));
+                add_cells(addr, dim_idx + 1);
+            }
+        } else {
+            for (size_t i = 0; i < dim.size; ++i) {
+                addr.insert_or_assign(dim.name, TensorSpec::Label(i));
+                add_cells(addr, dim_idx + 1);
+            }
+        }
+    }
+    TensorSpec make() {
+        TensorSpec::Address addr;
+        add_cells(addr, 0);
+        return spec;
+    }
+};
+
+TensorSpec make_value(const vespalib::string &type_spec, size_t labels, size_t seed) {
+    ValueType type = ValueType::from_spec(type_spec);
+    assert(!type.is_error());
+    return ValueGen(type, labels, seed).make();
+}
+
+//-----------------------------------------------------------------------------
+
+size_t next_seed = 0;
+
+struct Param {
+    vespalib::string name;
+    TensorSpec spec;
+    Param(const vespalib::string &name_in, const vespalib::string &type_spec, size_t labels = default_labels)
+        : name(name_in), spec(make_value(type_spec, labels, ++next_seed)) {}
+};
+
+struct Case {
+    vespalib::string name;
+    vespalib::string expr;
+    std::vector<Param> params;
+};
+
+struct Impl {
+    vespalib::string name;
+    EngineOrFactory engine;
+};
+
+std::vector<Impl> impl_list = {{"DefaultTensorEngine", DefaultTensorEngine::ref()},
+                               {"FastValue", FastValueBuilderFactory::get()}};
+
+// evaluation of an expression using an interpreted function
+struct Interpreted {
+    EngineOrFactory engine;
+    std::vector<Value::UP> values;
+    InterpretedFunction ifun;
+    InterpretedFunction::Context ctx;
+    SimpleObjectParams params;
+    Interpreted(EngineOrFactory engine_in, const Function &fun, const std::vector<Param> &params_in)
+        : engine(engine_in), values(make_values(engine_in, params_in)),
+          ifun(engine, fun, make_types(fun, params_in)), ctx(ifun), params(make_refs(values)) {}
+    static std::vector<Value::UP> make_values(EngineOrFactory engine_in, const std::vector<Param> &params_in) {
+        std::vector<Value::UP> result;
+        for (const auto &param: params_in) {
+            result.push_back(engine_in.from_spec(param.spec));
+        }
+        return result;
+    }
+    static std::vector<Value::CREF> make_refs(const std::vector<Value::UP> &values_in) {
+        std::vector<Value::CREF> result;
+        for (const auto &value: values_in) {
+            result.emplace_back(*value);
+        }
+        return result;
+    }
+    static NodeTypes make_types(const Function &fun, const std::vector<Param> &params_in) {
+        std::vector<ValueType> types;
+        for (const auto &param: params_in) {
+            types.push_back(ValueType::from_spec(param.spec.type()));
+        }
+        return NodeTypes(fun, types);
+    }
+    const Value &eval() { return ifun.eval(ctx, params); }
+    TensorSpec result() { return engine.to_spec(eval()); }
+};
+
+void benchmark_case(const Case &c) {
+    fprintf(stderr, "--------------------------------------------------------\n");
+    fprintf(stderr, "Benchmark Case: [%s]\n", c.name.c_str());
+    std::vector<vespalib::string> param_names;
+    for (const auto &param: c.params) {
+        param_names.push_back(param.name);
+    }
+    auto fun = Function::parse(param_names, c.expr);
+    ASSERT_FALSE(fun->has_error()) << fun->get_error();
+    Interpreted reference(SimpleTensorEngine::ref(), *fun, c.params);
+    TensorSpec expect = reference.result();
+    for (const auto &impl: impl_list) {
+        Interpreted interpreted(impl.engine, *fun, c.params);
+        ASSERT_EQ(interpreted.result(), expect) << impl.name;
+        report(impl.name, measure([&](){ interpreted.eval(); }));
+    }
+    bool all_double = std::all_of(c.params.begin(), c.params.end(),
+                                  [](const auto &param){ return (param.spec.type() == "double"); });
+    if (all_double && !CompiledFunction::detect_issues(*fun)) {
+        std::vector<double> args;
+        for (const auto &param: c.params) {
+            args.push_back(param.spec.cells().begin()->second.value);
+        }
+        CompiledFunction compiled(*fun, PassParams::ARRAY);
+        auto fn = compiled.get_function();
+        EXPECT_EQ(TensorSpec("double").add({}, fn(&args[0])), expect);
+        report("CompiledFunction", measure([&](){ fn(&args[0]); }));
+    }
+    fprintf(stderr, "--------------------------------------------------------\n");
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(RankingBenchmark, sparse_weighted_set_dot_product) {
+    benchmark_case({"sparse weighted set dot product", "reduce(query*doc,sum)",
+                    {{"query", "tensor<float>(x{})", 32}, {"doc", "tensor<float>(x{})", 1000}}});
+}
+
+TEST(RankingBenchmark, sparse_times_mixed_feature_vector) {
+    benchmark_case({"sparse times mixed feature vector", "reduce(query*doc,sum,x)",
+                    {{"query", "tensor<float>(x{})", 8}, {"doc", "tensor<float>(x{},y[64])", 200}}});
+}
+
+TEST(RankingBenchmark, dense_embedding_dot_product) {
+    benchmark_case({"dense embedding dot product", "reduce(query*doc,sum)",
+                    {{"query", "tensor<float>(x[256])"}, {"doc", "tensor<float>(x[256])"}}});
+}
+
+TEST(RankingBenchmark, dense_embedding_euclidean_distance) {
+    benchmark_case({"dense embedding euclidean distance", "sqrt(reduce(join(query,doc,f(a,b)((a-b)*(a-b))),sum))",
+                    {{"query", "tensor<float>(x[256])"}, {"doc", "tensor<float>(x[256])"}}});
+}
+
+TEST(RankingBenchmark, mixed_embedding_max_similarity) {
+    benchmark_case({"mixed embedding max similarity", "reduce(reduce(query*doc,sum,x),max)",
+                    {{"query", "tensor<float>(x[128])"}, {"doc", "tensor<float>(cat{},x[128])", 16}}});
+}
+
+TEST(RankingBenchmark, token_level_max_similarity) {
+    benchmark_case({"token level max similarity", "reduce(reduce(reduce(query*doc,sum,x),max,dt),sum,qt)",
+                    {{"query", "tensor<float>(qt[32],x[32])"}, {"doc", "tensor<float>(dt[64],x[32])"}}});
+}
+
+TEST(RankingBenchmark, small_neural_network) {
+    benchmark_case({"small neural network", "reduce(map(reduce(input*w1,sum,i)+b1,f(a)(max(a,0)))*w2,sum)",
+                    {{"input", "tensor<float>(i[64])"}, {"w1", "tensor<float>(h[32],i[64])"},
+                     {"b1", "tensor<float>(h[32])"}, {"w2", "tensor<float>(h[32])"}}});
+}
+
+TEST(RankingBenchmark, gbdt_forest) {
+    auto forest = Function::parse(Model(1234).max_features(64).make_forest(300, 16));
+    ASSERT_FALSE(forest->has_error());
+    Case c{"gbdt forest (300 trees)", forest->dump(), {}};
+    std::vector<float> float_args;
+    for (size_t i = 0; i < forest->num_params(); ++i) {
+        c.params.emplace_back(vespalib::string(forest->param_name(i)), "double");
+        float_args.push_back(c.params.back().spec.cells().begin()->second.value);
+    }
+    benchmark_case(c);
+    if (auto fast_forest = gbdt::FastForest::try_convert(*forest)) {
+        auto ctx = fast_forest->create_context();
+        report("FastForest", measure([&](){ fast_forest->eval(*ctx, &float_args[0]); }));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void benchmark_onnx(const vespalib::string &file) {
+    fprintf(stderr, "--------------------------------------------------------\n");
+    fprintf(stderr, "Benchmark Case: [onnx model %s]\n", file.c_str());
+    Onnx model(file, Onnx::Optimize::ENABLE);
+    Onnx::WirePlanner planner;
+    std::vector<Value::UP> values;
+    for (size_t i = 0; i < model.inputs().size(); ++i) {
+        const auto &info = model.inputs()[i];
+        std::vector<ValueType::Dimension> dims;
+        for (size_t d = 0; d < info.dimensions.size(); ++d) {
+            dims.emplace_back(fmt("d%zu", d), info.dimensions[d].is_known() ? info.dimensions[d].value : 1);
+        }
+        ValueType type = ValueType::tensor_type(std::move(dims), ValueType::CellType::FLOAT);
+        ASSERT_TRUE(planner.bind_input_type(type, info)) << info.name;
+        values.push_back(value_from_spec(ValueGen(type, 1, i).make(), FastValueBuilderFactory::get()));
+    }
+    Onnx::WireInfo wire_info = planner.get_wire_info(model);
+    Onnx::EvalContext ctx(model, wire_info);
+    auto eval = [&](){
+        for (size_t i = 0; i < values.size(); ++i) {
+            ctx.bind_param(i, *values[i]);
+        }
+        ctx.eval();
+    };
+    report("Onnx", measure(eval));
+    fprintf(stderr, "--------------------------------------------------------\n");
+}
+
+TEST(RankingBenchmark, onnx_models) {
+    benchmark_onnx(source_dir + "/../onnx_wrapper/simple.onnx");
+    for (const auto &file: extra_onnx_models) {
+        benchmark_onnx(file);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+Case parse_case(const vespalib::string &line) {
+    std::vector<vespalib::string> parts;
+    size_t pos = 0;
+    for (size_t split = line.find('|'); split != vespalib::string::npos; split = line.find('|', pos)) {
+        parts.push_back(line.substr(pos, split - pos));
+        pos = split + 1;
+    }
+    parts.push_back(line.substr(pos));
+    if (parts.size() < 2) {
+        throw std::invalid_argument(fmt("malformed case: '%s'", line.c_str()));
+    }
+    Case c{parts[0], parts[1], {}};
+    for (size_t i = 2; i < parts.size(); ++i) {
+        auto eq = parts[i].find('=');
+        if (eq == vespalib::string::npos) {
+            throw std::invalid_argument(fmt("malformed param: '%s'", parts[i].c_str()));
+        }
+        vespalib::string type = parts[i].substr(eq + 1);
+        size_t labels = default_labels;
+        auto colon = type.rfind(':');
+        if ((colon != vespalib::string::npos) && (type.find(')', colon) == vespalib::string::npos)) {
+            labels = strtoul(type.substr(colon + 1).c_str(), nullptr, 10);
+            type = type.substr(0, colon);
+        }
+        c.params.emplace_back(parts[i].substr(0, eq), type, labels);
+    }
+    return c;
+}
+
+TEST(RankingBenchmark, cases_from_file) {
+    for (const auto &file: extra_case_files) {
+        std::ifstream input(file.c_str());
+        ASSERT_TRUE(input.good()) << file;
+        std::string line;
+        while (std::getline(input, line)) {
+            if (!line.empty() && (line[0] != '#')) {
+                benchmark_case(parse_case(line));
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    for (int i = 1; i < argc; ++i) {
+        vespalib::string arg(argv[i]);
+        if (arg.find("--cases=") == 0) {
+            extra_case_files.push_back(arg.substr(8));
+        } else if (arg.find("--onnx=") == 0) {
+            extra_onnx_models.push_back(arg.substr(7));
+        } else {
+            fprintf(stderr, "unknown argument: '%s'\n", arg.c_str());
+            return 1;
+        }
+    }
+    return RUN_ALL_TESTS();
+}
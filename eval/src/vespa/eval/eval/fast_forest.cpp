@@ -70,6 +70,10 @@ struct State {
     State(size_t num_params, const std::vector<const nodes::Node *> &trees);
     size_t num_params() const { return cmp_nodes.size(); }
     size_t num_trees() const { return leafs.size(); }
+    bool all_params_used() const {
+        return std::none_of(cmp_nodes.begin(), cmp_nodes.end(),
+                            [](const CmpNodes &cmp_range){ return cmp_range.empty(); });
+    }
     ~State() = default;
 };
 
@@ -121,7 +125,6 @@ State::State(size_t num_params, const std::vector<const nodes::Node *> &trees)
         max_leafs = std::max(max_leafs, leafs[tree_id].size());
     }
     for (CmpNodes &cmp_range: cmp_nodes) {
-        assert(!cmp_range.empty());
         std::sort(cmp_range.begin(), cmp_range.end());
     }
 }
@@ -319,7 +322,7 @@ FixedForest<T>::eval(Context &context, const float *params) const
 {
     T *ctx_masks = &static_cast<FixedContext<T>&>(context).masks[0];
     init_state(ctx_masks);
-    const Mask *mask_pos = &_masks[0];
+    const Mask *mask_pos = _masks.data();
     const float *param_pos = params;
     for (uint32_t size: _mask_sizes) {
         float feature = *param_pos++;
@@ -327,8 +330,8 @@ FixedForest<T>::eval(Context &context, const float *params) const
             apply_masks(ctx_masks, mask_pos, mask_pos + size, feature);
         } else {
             apply_masks(ctx_masks,
-                        &_default_masks[_default_offsets[(param_pos-params)-1]],
-                        &_default_masks[_default_offsets[(param_pos-params)]]);
+                        _default_masks.data() + _default_offsets[(param_pos-params)-1],
+                        _default_masks.data() + _default_offsets[(param_pos-params)]);
         }
         mask_pos += size;
     }
@@ -599,7 +602,7 @@ MultiWordForest::eval(Context &context, const float *params) const
 {
     uint32_t *ctx_words = &static_cast<MultiWordContext&>(context).words[0];
     init_state(ctx_words);
-    const Mask *mask_pos = &_masks[0];
+    const Mask *mask_pos = _masks.data();
     const float *param_pos = params;
     for (const Sizes &size: _mask_sizes) {
         float feature = *param_pos++;
@@ -609,17 +612,143 @@ MultiWordForest::eval(Context &context, const float *params) const
                             mask_pos + size.fixed, mask_pos + size.fixed + size.rle, feature);
         } else {
             apply_fixed_masks(ctx_words,
-                              &_default_masks[_default_offsets[(param_pos-params)-1].fixed],
-                              &_default_masks[_default_offsets[(param_pos-params)-1].rle]);
+                              _default_masks.data() + _default_offsets[(param_pos-params)-1].fixed,
+                              _default_masks.data() + _default_offsets[(param_pos-params)-1].rle);
             apply_rle_masks(reinterpret_cast<unsigned char *>(ctx_words),
-                            &_default_masks[_default_offsets[(param_pos-params)-1].rle],
-                            &_default_masks[_default_offsets[(param_pos-params)].fixed]);
+                            _default_masks.data() + _default_offsets[(param_pos-params)-1].rle,
+                            _default_masks.data() + _default_offsets[(param_pos-params)].fixed);
         }
         mask_pos += (size.fixed + size.rle);
     }
     return get_result(ctx_words);
 }
 
+//-----------------------------------------------------------------------------
+// select the best implementation for a (part of a) forest
+//-----------------------------------------------------------------------------
+
+FastForest::UP
+build_forest(const State &state, size_t min_fixed, size_t max_fixed)
+{
+    if (auto forest = FixedForest<uint8_t>::try_build(state, min_fixed, max_fixed)) {
+        return forest;
+    }
+    if (auto forest = FixedForest<uint16_t>::try_build(state, min_fixed, max_fixed)) {
+        return forest;
+    }
+    if (auto forest = FixedForest<uint32_t>::try_build(state, min_fixed, max_fixed)) {
+        return forest;
+    }
+    if (auto forest = FixedForest<uint64_t>::try_build(state, min_fixed, max_fixed)) {
+        return forest;
+    }
+    if (auto forest = MultiWordForest::try_build(state)) {
+        return forest;
+    }
+    return FastForest::UP();
+}
+
+//-----------------------------------------------------------------------------
+// implementation splitting the trees into segments for bounded evaluation
+//-----------------------------------------------------------------------------
+
+struct SegmentedContext : FastForest::Context {
+    std::vector<FastForest::Context::UP> segments;
+    SegmentedContext() : segments() {}
+};
+
+struct SegmentedForest : FastForest {
+
+    std::vector<FastForest::UP> _segments;
+    std::vector<double>         _max_rest; // max result from segment i and out
+
+    SegmentedForest() : _segments(), _max_rest() {}
+    static FastForest::UP try_build(const State &state, const std::vector<const nodes::Node *> &trees,
+                                    size_t segment_size);
+
+    vespalib::string impl_name() const override { return "ff-segmented"; }
+    Context::UP create_context() const override;
+    double eval(Context &context, const float *params) const override;
+    double eval_bounded(Context &context, const float *params, double limit) const override;
+};
+
+FastForest::UP
+SegmentedForest::try_build(const State &state, const std::vector<const nodes::Node *> &trees,
+                           size_t segment_size)
+{
+    assert(segment_size > 0);
+    std::vector<float> min_leaf;
+    std::vector<float> max_leaf;
+    std::vector<uint32_t> order;
+    for (uint32_t tree_id = 0; tree_id < state.num_trees(); ++tree_id) {
+        const auto &leafs = state.leafs[tree_id];
+        min_leaf.push_back(*std::min_element(leafs.begin(), leafs.end()));
+        max_leaf.push_back(*std::max_element(leafs.begin(), leafs.end()));
+        order.push_back(tree_id);
+    }
+    // trees able to move the result the most are evaluated first
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                     { return ((max_leaf[a] - min_leaf[a]) > (max_leaf[b] - min_leaf[b])); });
+    auto forest = std::make_unique<SegmentedForest>();
+    std::vector<double> segment_max;
+    for (size_t begin = 0; begin < order.size(); begin += segment_size) {
+        size_t end = std::min(order.size(), begin + segment_size);
+        std::vector<const nodes::Node *> segment_trees;
+        double max_result = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            segment_trees.push_back(trees[order[i]]);
+            max_result += max_leaf[order[i]];
+        }
+        auto segment = build_forest(State(state.num_params(), segment_trees), 8, 64);
+        if (!segment) {
+            return FastForest::UP();
+        }
+        forest->_segments.push_back(std::move(segment));
+        segment_max.push_back(max_result);
+    }
+    forest->_max_rest.resize(segment_max.size() + 1, 0.0);
+    for (size_t i = segment_max.size(); i-- > 0; ) {
+        forest->_max_rest[i] = forest->_max_rest[i + 1] + segment_max[i];
+    }
+    return forest;
+}
+
+FastForest::Context::UP
+SegmentedForest::create_context() const
+{
+    auto ctx = std::make_unique<SegmentedContext>();
+    for (const auto &segment: _segments) {
+        ctx->segments.push_back(segment->create_context());
+    }
+    return ctx;
+}
+
+double
+SegmentedForest::eval(Context &context, const float *params) const
+{
+    auto &ctx = static_cast<SegmentedContext&>(context);
+    double result = 0.0;
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        result += _segments[i]->eval(*ctx.segments[i], params);
+    }
+    return result;
+}
+
+double
+SegmentedForest::eval_bounded(Context &context, const float *params, double limit) const
+{
+    auto &ctx = static_cast<SegmentedContext&>(context);
+    double result = 0.0;
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        double max_result = (result + _max_rest[i]);
+        if (!(max_result > limit)) {
+            return max_result;
+        }
+        result += _segments[i]->eval(*ctx.segments[i], params);
+    }
+    return result;
+}
+
 }
 
 //-----------------------------------------------------------------------------
@@ -641,26 +770,35 @@ FastForest::try_convert(const Function &fun, size_t min_fixed, size_t max_fixed)
         gbdt::ForestStats stats(trees);
         if (stats.total_in_checks == 0) {
             State state(fun.num_params(), trees);
-            if (auto forest = FixedForest<uint8_t>::try_build(state, min_fixed, max_fixed)) {
-                return forest;
-            }
-            if (auto forest = FixedForest<uint16_t>::try_build(state, min_fixed, max_fixed)) {
-                return forest;
-            }
-            if (auto forest = FixedForest<uint32_t>::try_build(state, min_fixed, max_fixed)) {
-                return forest;
-            }
-            if (auto forest = FixedForest<uint64_t>::try_build(state, min_fixed, max_fixed)) {
-                return forest;
-            }
-            if (auto forest = MultiWordForest::try_build(state)) {
-                return forest;
-            }
+            assert(state.all_params_used());
+            return build_forest(state, min_fixed, max_fixed);
         }
     }
     return FastForest::UP();
 }
 
+FastForest::UP
+FastForest::try_convert_bounded(const Function &fun, size_t segment_size)
+{
+    const auto &root = fun.root();
+    if (root.is_forest()) {
+        auto trees = gbdt::extract_trees(root);
+        gbdt::ForestStats stats(trees);
+        if (stats.total_in_checks == 0) {
+            State state(fun.num_params(), trees);
+            assert(state.all_params_used());
+            return SegmentedForest::try_build(state, trees, segment_size);
+        }
+    }
+    return FastForest::UP();
+}
+
+double
+FastForest::eval_bounded(Context &context, const float *params, double) const
+{
+    return eval(context, params);
+}
+
 double
 FastForest::estimate_cost_us(const std::vector<double> &params, double budget) const
 {
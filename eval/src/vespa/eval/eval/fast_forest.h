@@ -17,6 +17,11 @@ namespace vespalib::eval::gbdt {
  * Comparisons must be on the form 'feature < const' or '!(feature >=
  * const)'. The inverted form is used to signal that the true branch
  * should be selected when the feature value is missing (NaN).
+ *
+ * Forests converted with try_convert_bounded are split into segments
+ * of trees sorted on how much each tree can affect the result. This
+ * lets eval_bounded stop as soon as the remaining segments cannot
+ * lift the result above a given limit.
  **/
 class FastForest
 {
@@ -33,9 +38,19 @@ public:
         using UP = std::unique_ptr<Context>;
     };
     static UP try_convert(const Function &fun, size_t min_fixed = 8, size_t max_fixed = 64);
+    static UP try_convert_bounded(const Function &fun, size_t segment_size = 128);
     virtual vespalib::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+
+    /**
+     * Evaluate the forest unless the result is known to be less than
+     * or equal to the given limit. The exact result is returned when
+     * it is above the limit. Otherwise, the returned value might be an
+     * upper bound of the result, which is also less than or equal to
+     * the limit. The default implementation always evaluates all trees.
+     **/
+    virtual double eval_bounded(Context &context, const float *params, double limit) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
 };
 
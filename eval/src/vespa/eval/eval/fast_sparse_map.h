@@ -5,7 +5,7 @@
 #include "memory_usage_stuff.h"
 #include <vespa/vespalib/util/arrayref.h>
 #include <vespa/vespalib/stllike/string.h>
-#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/swiss_map.h>
 #include <vector>
 #include <xxhash.h>
 #include <type_traits>
@@ -13,7 +13,7 @@
 namespace vespalib::eval {
 
 /**
- * A wrapper around vespalib::hash_map, using it to map a list of
+ * A wrapper around vespalib::swiss_map, using it to map a list of
  * labels (a sparse address) to an integer value (dense subspace
  * index). Labels are stored in a separate vector to avoid
  * fragmentation caused by hash keys being vectors of values. Labels
@@ -79,7 +79,7 @@ public:
         bool operator()(const Key &a, const Key &b) const { return (a.hash == b.hash); }
     };
 
-    using MapType = vespalib::hash_map<Key,uint32_t,Hash,Equal>;
+    using MapType = vespalib::swiss_map<Key,uint32_t,Hash,Equal>;
 
 private:
     size_t _num_dims;
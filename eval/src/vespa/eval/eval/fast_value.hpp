@@ -152,6 +152,11 @@ struct FastValueIndex final : Value::Index {
                 const FastValueIndex &lhs, const FastValueIndex &rhs,
                 ConstArrayRef<LCT> lhs_cells, ConstArrayRef<RCT> rhs_cells, Stash &stash);
 
+    template <typename LCT, typename RCT, typename OCT, typename Fun>
+        static const Value &sparse_subset_join(const ValueType &res_type, const Fun &fun,
+                const FastValueIndex &lhs, const FastValueIndex &rhs, const std::vector<size_t> &lhs_overlap,
+                ConstArrayRef<LCT> lhs_cells, ConstArrayRef<RCT> rhs_cells, Stash &stash);
+
     size_t size() const override { return map.size(); }
     std::unique_ptr<View> create_view(const std::vector<size_t> &dims) const override;
 };
@@ -220,6 +225,33 @@ FastValueIndex::sparse_full_overlap_join(const ValueType &res_type, const Fun &f
     return result;
 }
 
+// The mapped dimensions of rhs are a subset of the mapped dimensions
+// of lhs (given by lhs_overlap). The hash of each rhs address is
+// calculated from the label hashes stored in lhs, and the lhs hash is
+// reused for the result address.
+template <typename LCT, typename RCT, typename OCT, typename Fun>
+const Value &
+FastValueIndex::sparse_subset_join(const ValueType &res_type, const Fun &fun,
+                                   const FastValueIndex &lhs, const FastValueIndex &rhs, const std::vector<size_t> &lhs_overlap,
+                                   ConstArrayRef<LCT> lhs_cells, ConstArrayRef<RCT> rhs_cells, Stash &stash)
+{
+    auto &result = stash.create<FastValue<OCT>>(res_type, lhs.map.num_dims(), 1, lhs.map.size());
+    lhs.map.each_map_entry([&](auto lhs_subspace, auto hash)
+                           {
+                               auto addr = lhs.map.make_addr(lhs_subspace);
+                               uint64_t rhs_hash = 0;
+                               for (size_t dim: lhs_overlap) {
+                                   rhs_hash = 31 * rhs_hash + addr[dim].hash;
+                               }
+                               auto rhs_subspace = rhs.map.lookup(rhs_hash);
+                               if (rhs_subspace != FastSparseMap::npos()) {
+                                   result.my_index.map.add_mapping(addr, hash);
+                                   result.my_cells.push_back(fun(lhs_cells[lhs_subspace], rhs_cells[rhs_subspace]));
+                               }
+                           });
+    return result;
+}
+
 //-----------------------------------------------------------------------------
 
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "operation.h"
+#include "value_type.h"
 #include <vespa/vespalib/util/typify.h>
 #include <cmath>
 
@@ -10,6 +11,11 @@ namespace vespalib::eval::operation {
 
 //-----------------------------------------------------------------------------
 
+// compact cell types (bfloat16, int8) are computed as float
+template <typename A> constexpr auto promote(A a) { return typename DecayCellType<A>::type(a); }
+
+//-----------------------------------------------------------------------------
+
 struct CallOp1 {
     op1_t my_op1;
     CallOp1(op1_t op1) : my_op1(op1) {}
@@ -19,27 +25,27 @@ struct CallOp1 {
 template <typename T> struct InlineOp1;
 template <> struct InlineOp1<Cube> {
     InlineOp1(op1_t) {}
-    template <typename A> constexpr auto operator()(A a) const { return (a * a * a); }
+    template <typename A> constexpr auto operator()(A a) const { auto x = promote(a); return (x * x * x); }
 };
 template <> struct InlineOp1<Exp> {
     InlineOp1(op1_t) {}
-    template <typename A> constexpr auto operator()(A a) const { return exp(a); }
+    template <typename A> constexpr auto operator()(A a) const { return exp(promote(a)); }
 };
 template <> struct InlineOp1<Inv> {
     InlineOp1(op1_t) {}
-    template <typename A> constexpr auto operator()(A a) const { return (A{1}/a); }
+    template <typename A> constexpr auto operator()(A a) const { auto x = promote(a); return (decltype(x){1}/x); }
 };
 template <> struct InlineOp1<Sqrt> {
     InlineOp1(op1_t) {}
-    template <typename A> constexpr auto operator()(A a) const { return std::sqrt(a); }
+    template <typename A> constexpr auto operator()(A a) const { return std::sqrt(promote(a)); }
 };
 template <> struct InlineOp1<Square> {
     InlineOp1(op1_t) {}
-    template <typename A> constexpr auto operator()(A a) const { return (a * a); }
+    template <typename A> constexpr auto operator()(A a) const { auto x = promote(a); return (x * x); }
 };
 template <> struct InlineOp1<Tanh> {
     InlineOp1(op1_t) {}
-    template <typename A> constexpr auto operator()(A a) const { return std::tanh(a); }
+    template <typename A> constexpr auto operator()(A a) const { return std::tanh(promote(a)); }
 };
 
 struct TypifyOp1 {
@@ -82,23 +88,23 @@ struct SwapArgs2 {
 template <typename T> struct InlineOp2;
 template <> struct InlineOp2<Add> {
     InlineOp2(op2_t) {}
-    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (a+b); }
+    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (promote(a)+promote(b)); }
 };
 template <> struct InlineOp2<Div> {
     InlineOp2(op2_t) {}
-    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (a/b); }
+    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (promote(a)/promote(b)); }
 };
 template <> struct InlineOp2<Mul> {
     InlineOp2(op2_t) {}
-    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (a*b); }
+    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (promote(a)*promote(b)); }
 };
 template <> struct InlineOp2<Pow> {
     InlineOp2(op2_t) {}
-    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return std::pow(a,b); }
+    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return std::pow(promote(a),promote(b)); }
 };
 template <> struct InlineOp2<Sub> {
     InlineOp2(op2_t) {}
-    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (a-b); }
+    template <typename A, typename B> constexpr auto operator()(A a, B b) const { return (promote(a)-promote(b)); }
 };
 
 struct TypifyOp2 {
@@ -122,8 +128,8 @@ struct TypifyOp2 {
 
 //-----------------------------------------------------------------------------
 
-template <typename A, typename OP1>
-void apply_op1_vec(A *dst, const A *src, size_t n, OP1 &&f) {
+template <typename D, typename A, typename OP1>
+void apply_op1_vec(D *dst, const A *src, size_t n, OP1 &&f) {
     for (size_t i = 0; i < n; ++i) {
         dst[i] = f(src[i]);
     }
@@ -48,7 +48,7 @@ InterpretedFunction::State::~State() = default;
 void
 InterpretedFunction::State::init(const LazyParams &params_in) {
     params = &params_in;
-    stash.clear();
+    stash.recycle();
     stack.clear();
     program_offset = 0;
     if_cnt = 0;
@@ -128,7 +128,7 @@ InterpretedFunction::EvalSingle::EvalSingle(EngineOrFactory engine, Instruction
 const Value &
 InterpretedFunction::EvalSingle::eval(const std::vector<Value::CREF> &stack)
 {
-    _state.stash.clear();
+    _state.stash.recycle();
     _state.stack = stack;
     _op.perform(_state);
     assert(_state.stack.size() == 1);
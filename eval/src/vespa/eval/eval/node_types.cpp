@@ -109,7 +109,7 @@ struct TypeResolver : public NodeVisitor, public NodeTraverser {
     }
 
     void resolve_op1(const Node &node) {
-        bind(type(node.get_child(0)), node);
+        bind(type(node.get_child(0)).map(), node);
     }
 
     void resolve_op2(const Node &node) {
@@ -572,7 +572,7 @@ const TensorFunction &reduce(const TensorFunction &child, Aggr aggr, const std::
 }
 
 const TensorFunction &map(const TensorFunction &child, map_fun_t function, Stash &stash) {
-    ValueType result_type = child.result_type();
+    ValueType result_type = child.result_type().map();
     return stash.create<Map>(result_type, child, function);
 }
 
@@ -6,6 +6,7 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <cstring>
 
 using vespalib::make_string_short::fmt;
 
@@ -17,11 +18,15 @@ using CellType = ValueType::CellType;
 
 constexpr uint32_t DOUBLE_CELL_TYPE = 0;
 constexpr uint32_t FLOAT_CELL_TYPE = 1;
+constexpr uint32_t BFLOAT16_CELL_TYPE = 2;
+constexpr uint32_t INT8_CELL_TYPE = 3;
 
 inline uint32_t cell_type_to_id(CellType cell_type) {
     switch (cell_type) {
     case CellType::DOUBLE: return DOUBLE_CELL_TYPE;
     case CellType::FLOAT: return FLOAT_CELL_TYPE;
+    case CellType::BFLOAT16: return BFLOAT16_CELL_TYPE;
+    case CellType::INT8: return INT8_CELL_TYPE;
     }
     throw IllegalArgumentException(fmt("Unknown CellType=%u", (uint32_t)cell_type));
 }
@@ -30,6 +35,8 @@ inline CellType id_to_cell_type(uint32_t id) {
     switch (id) {
     case DOUBLE_CELL_TYPE: return CellType::DOUBLE;
     case FLOAT_CELL_TYPE: return CellType::FLOAT;
+    case BFLOAT16_CELL_TYPE: return CellType::BFLOAT16;
+    case INT8_CELL_TYPE: return CellType::INT8;
     }
     throw IllegalArgumentException(fmt("Unknown CellType id=%u", id));
 }
@@ -143,13 +150,66 @@ void decode_mapped_labels(nbostream &input, size_t num_mapped_dims, std::vector<
     }
 }
 
+// Convert cells between host and network byte order in place. Cells
+// are handled as raw bytes, so this works for all cell types.
+template<typename T>
+void swap_cell_bytes(T *cells, size_t num_cells) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if constexpr (sizeof(T) == 8) {
+        for (size_t i = 0; i < num_cells; ++i) {
+            uint64_t bits;
+            memcpy(&bits, &cells[i], sizeof(bits));
+            bits = __builtin_bswap64(bits);
+            memcpy(&cells[i], &bits, sizeof(bits));
+        }
+    } else if constexpr (sizeof(T) == 4) {
+        for (size_t i = 0; i < num_cells; ++i) {
+            uint32_t bits;
+            memcpy(&bits, &cells[i], sizeof(bits));
+            bits = __builtin_bswap32(bits);
+            memcpy(&cells[i], &bits, sizeof(bits));
+        }
+    } else if constexpr (sizeof(T) == 2) {
+        for (size_t i = 0; i < num_cells; ++i) {
+            uint16_t bits;
+            memcpy(&bits, &cells[i], sizeof(bits));
+            bits = __builtin_bswap16(bits);
+            memcpy(&cells[i], &bits, sizeof(bits));
+        }
+    } else {
+        static_assert(sizeof(T) == 1);
+    }
+#else
+    (void) cells;
+    (void) num_cells;
+#endif
+}
+
+// Dense cells are converted in chunks of cells instead of writing
+// them to the stream one by one.
+template<typename T>
+void encode_cells(nbostream &output, ConstArrayRef<T> cells)
+{
+    if constexpr (sizeof(T) == 1) {
+        output.write(cells.begin(), cells.size());
+    } else {
+        constexpr size_t chunk_size = 256;
+        T chunk[chunk_size];
+        for (size_t pos = 0; pos < cells.size(); pos += chunk_size) {
+            size_t n = std::min(chunk_size, cells.size() - pos);
+            memcpy(chunk, cells.begin() + pos, n * sizeof(T));
+            swap_cell_bytes(chunk, n);
+            output.write(chunk, n * sizeof(T));
+        }
+    }
+}
+
 template<typename T>
 void decode_cells(nbostream &input, size_t num_cells, ArrayRef<T> dst)
 {
     assert(num_cells == dst.size());
-    for (size_t i = 0; i < num_cells; ++i) {
-        dst[i] = input.readValue<T>();
-    }
+    input.read(dst.begin(), num_cells * sizeof(T));
+    swap_cell_bytes(dst.begin(), num_cells);
 }
 
 struct DecodeState {
@@ -279,11 +339,8 @@ struct ContentEncoder {
         size_t subspace;
         while (view->next_result(a_refs, subspace)) {
             encode_mapped_labels(output, state.num_mapped_dims, address);
-            auto iter = value.cells().typify<T>().begin();
-            iter += (subspace * state.subspace_size);
-            for (size_t i = 0; i < state.subspace_size; ++i) {
-                output << *iter++;
-            }
+            auto cells = value.cells().typify<T>();
+            encode_cells(output, ConstArrayRef<T>(cells.begin() + (subspace * state.subspace_size), state.subspace_size));
         }
     }
 };
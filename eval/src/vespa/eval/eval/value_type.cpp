@@ -23,6 +23,8 @@ CellType unify(CellType b) {
     switch (b) {
     case CellType::DOUBLE: return unify<A,double>();
     case CellType::FLOAT: return unify<A,float>();
+    case CellType::BFLOAT16: return unify<A,BFloat16>();
+    case CellType::INT8: return unify<A,int8_t>();
     }
     abort();
 }
@@ -31,6 +33,8 @@ CellType unify(CellType a, CellType b) {
     switch (a) {
     case CellType::DOUBLE: return unify<double>(b);
     case CellType::FLOAT: return unify<float>(b);
+    case CellType::BFLOAT16: return unify<BFloat16>(b);
+    case CellType::INT8: return unify<int8_t>(b);
     }
     abort();
 }
@@ -266,7 +270,16 @@ ValueType::reduce(const std::vector<vespalib::string> &dimensions_in) const
     if (removed != dimensions_in.size()) {
         return error_type();
     }
-    return tensor_type(std::move(result), _cell_type);
+    return tensor_type(std::move(result), decay_cell_type(_cell_type));
+}
+
+ValueType
+ValueType::map() const
+{
+    if (!is_tensor()) {
+        return *this;
+    }
+    return tensor_type(_dimensions, decay_cell_type(_cell_type));
 }
 
 ValueType
@@ -324,9 +337,9 @@ ValueType::join(const ValueType &lhs, const ValueType &rhs)
     if (lhs.is_error() || rhs.is_error()) {
         return error_type();
     } else if (lhs.is_double()) {
-        return rhs;
+        return rhs.map();
     } else if (rhs.is_double()) {
-        return lhs;
+        return lhs.map();
     }
     MyJoin result(lhs._dimensions, rhs._dimensions);
     if (result.mismatch) {
@@ -352,13 +365,18 @@ ValueType::merge(const ValueType &lhs, const ValueType &rhs)
 CellType
 ValueType::unify_cell_types(const ValueType &a, const ValueType &b) {
     if (a.is_double()) {
-        return b.cell_type();
+        return decay_cell_type(b.cell_type());
     } else if (b.is_double()) {
-        return a.cell_type();
+        return decay_cell_type(a.cell_type());
     }
     return unify(a.cell_type(), b.cell_type());
 }
 
+CellType
+ValueType::decay_cell_type(CellType cell_type) {
+    return (cell_type == CellType::DOUBLE) ? CellType::DOUBLE : CellType::FLOAT;
+}
+
 ValueType
 ValueType::concat(const ValueType &lhs, const ValueType &rhs, const vespalib::string &dimension)
 {
@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <type_traits>
 #include <vector>
 
 namespace vespalib::eval {
@@ -17,7 +19,9 @@ class ValueType
 {
 public:
     enum class Type { ERROR, DOUBLE, TENSOR };
-    enum class CellType : char { FLOAT, DOUBLE };
+    // BFLOAT16 and INT8 are compact storage formats; computing new
+    // cells from them will produce FLOAT (see decay_cell_type)
+    enum class CellType : char { FLOAT, DOUBLE, BFLOAT16, INT8 };
     struct Dimension {
         using size_type = uint32_t;
         static constexpr size_type npos = -1;
@@ -76,6 +80,7 @@ public:
     bool operator!=(const ValueType &rhs) const { return !(*this == rhs); }
 
     ValueType reduce(const std::vector<vespalib::string> &dimensions_in) const;
+    ValueType map() const;
     ValueType rename(const std::vector<vespalib::string> &from,
                      const std::vector<vespalib::string> &to) const;
 
@@ -88,6 +93,7 @@ public:
     static ValueType join(const ValueType &lhs, const ValueType &rhs);
     static ValueType merge(const ValueType &lhs, const ValueType &rhs);
     static CellType unify_cell_types(const ValueType &a, const ValueType &b);
+    static CellType decay_cell_type(CellType cell_type);
     static ValueType concat(const ValueType &lhs, const ValueType &rhs, const vespalib::string &dimension);
     static ValueType either(const ValueType &one, const ValueType &other);
 };
@@ -99,16 +105,24 @@ std::ostream &operator<<(std::ostream &os, const ValueType &type);
 template <typename CT> inline bool check_cell_type(ValueType::CellType type);
 template <> inline bool check_cell_type<double>(ValueType::CellType type) { return (type == ValueType::CellType::DOUBLE); }
 template <> inline bool check_cell_type<float>(ValueType::CellType type) { return (type == ValueType::CellType::FLOAT); }
+template <> inline bool check_cell_type<BFloat16>(ValueType::CellType type) { return (type == ValueType::CellType::BFLOAT16); }
+template <> inline bool check_cell_type<int8_t>(ValueType::CellType type) { return (type == ValueType::CellType::INT8); }
 
-template <typename LCT, typename RCT> struct UnifyCellTypes{};
-template <> struct UnifyCellTypes<double, double> { using type = double; };
-template <> struct UnifyCellTypes<double, float>  { using type = double; };
-template <> struct UnifyCellTypes<float,  double> { using type = double; };
-template <> struct UnifyCellTypes<float,  float>  { using type = float; };
+// the cell type used for cells computed from cells of type CT
+template <typename CT> struct DecayCellType { using type = CT; };
+template <> struct DecayCellType<BFloat16> { using type = float; };
+template <> struct DecayCellType<int8_t>   { using type = float; };
+
+// the cell type used for cells computed from cells of types LCT and RCT
+template <typename LCT, typename RCT> struct UnifyCellTypes {
+    using type = std::conditional_t<std::is_same_v<LCT,double> || std::is_same_v<RCT,double>, double, float>;
+};
 
 template <typename CT> inline ValueType::CellType get_cell_type();
 template <> inline ValueType::CellType get_cell_type<double>() { return ValueType::CellType::DOUBLE; }
 template <> inline ValueType::CellType get_cell_type<float>() { return ValueType::CellType::FLOAT; }
+template <> inline ValueType::CellType get_cell_type<BFloat16>() { return ValueType::CellType::BFLOAT16; }
+template <> inline ValueType::CellType get_cell_type<int8_t>() { return ValueType::CellType::INT8; }
 
 struct TypifyCellType {
     template <typename T> using Result = TypifyResultType<T>;
@@ -116,6 +130,23 @@ struct TypifyCellType {
         switch(value) {
         case ValueType::CellType::DOUBLE: return f(Result<double>());
         case ValueType::CellType::FLOAT:  return f(Result<float>());
+        case ValueType::CellType::BFLOAT16: return f(Result<BFloat16>());
+        case ValueType::CellType::INT8: return f(Result<int8_t>());
+        }
+        abort();
+    }
+};
+
+// only the cell types resulting from decay (double and float); used
+// by implementations that do not store compact cells themselves
+struct TypifyDecayedCellType {
+    template <typename T> using Result = TypifyResultType<T>;
+    template <typename F> static decltype(auto) resolve(ValueType::CellType value, F &&f) {
+        switch(value) {
+        case ValueType::CellType::DOUBLE: return f(Result<double>());
+        case ValueType::CellType::FLOAT:  return f(Result<float>());
+        case ValueType::CellType::BFLOAT16:
+        case ValueType::CellType::INT8: break;
         }
         abort();
     }
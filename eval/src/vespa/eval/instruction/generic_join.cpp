@@ -104,6 +104,33 @@ void my_sparse_full_overlap_join_op(State &state, uint64_t param_in) {
 
 //-----------------------------------------------------------------------------
 
+template <typename LCT, typename RCT, typename OCT, typename Fun>
+void my_sparse_subset_join_op(State &state, uint64_t param_in) {
+    const auto &param = unwrap_param<JoinParam>(param_in);
+    const Value &lhs = state.peek(1);
+    const Value &rhs = state.peek(0);
+    const Value::Index &lhs_index = lhs.index();
+    const Value::Index &rhs_index = rhs.index();
+    if ((std::type_index(typeid(lhs_index)) == std::type_index(typeid(FastValueIndex))) &&
+        (std::type_index(typeid(rhs_index)) == std::type_index(typeid(FastValueIndex))))
+    {
+        auto lhs_cells = lhs.cells().typify<LCT>();
+        auto rhs_cells = rhs.cells().typify<RCT>();
+        const FastValueIndex &lhs_fast = static_cast<const FastValueIndex&>(lhs_index);
+        const FastValueIndex &rhs_fast = static_cast<const FastValueIndex&>(rhs_index);
+        return (param.sparse_plan.rhs_overlap.size() == rhs_fast.map.num_dims())
+            ? state.pop_pop_push(FastValueIndex::sparse_subset_join<LCT,RCT,OCT,Fun>
+                                 (param.res_type, Fun(param.function), lhs_fast, rhs_fast, param.sparse_plan.lhs_overlap,
+                                  lhs_cells, rhs_cells, state.stash))
+            : state.pop_pop_push(FastValueIndex::sparse_subset_join<RCT,LCT,OCT,SwapArgs2<Fun>>
+                                 (param.res_type, SwapArgs2<Fun>(param.function), rhs_fast, lhs_fast, param.sparse_plan.rhs_overlap,
+                                  rhs_cells, lhs_cells, state.stash));
+    }
+    my_mixed_join_op<LCT,RCT,OCT,Fun>(state, param_in);
+};
+
+//-----------------------------------------------------------------------------
+
 template <typename LCT, typename RCT, typename OCT, typename Fun>
 void my_dense_join_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<JoinParam>(param_in);
@@ -145,6 +172,9 @@ struct SelectGenericJoinOp {
         {
             return my_sparse_full_overlap_join_op<LCT,RCT,OCT,Fun>;
         }
+        if ((param.dense_plan.out_size == 1) && param.sparse_plan.is_subset_join()) {
+            return my_sparse_subset_join_op<LCT,RCT,OCT,Fun>;
+        }
         return my_mixed_join_op<LCT,RCT,OCT,Fun>;
     }
 };
@@ -235,6 +265,18 @@ SparseJoinPlan::SparseJoinPlan(const ValueType &lhs_type, const ValueType &rhs_t
                  [](const auto &a, const auto &b){ return (a.name < b.name); });
 }
 
+bool
+SparseJoinPlan::is_subset_join() const
+{
+    size_t lhs_only = 0;
+    size_t rhs_only = 0;
+    for (Source source: sources) {
+        lhs_only += (source == Source::LHS) ? 1 : 0;
+        rhs_only += (source == Source::RHS) ? 1 : 0;
+    }
+    return (lhs_overlap.size() > 0) && ((lhs_only == 0) != (rhs_only == 0));
+}
+
 SparseJoinPlan::~SparseJoinPlan() = default;
 
 //-----------------------------------------------------------------------------
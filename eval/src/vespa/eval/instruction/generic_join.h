@@ -60,6 +60,8 @@ struct SparseJoinPlan {
     std::vector<size_t> lhs_overlap;
     std::vector<size_t> rhs_overlap;
     SparseJoinPlan(const ValueType &lhs_type, const ValueType &rhs_type);
+    // the mapped dimensions of one side is a strict subset of those of the other side
+    bool is_subset_join() const;
     ~SparseJoinPlan();
 };
 
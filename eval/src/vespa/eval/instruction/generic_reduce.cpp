@@ -2,10 +2,12 @@
 
 #include "generic_reduce.h"
 #include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/fast_value.hpp>
 #include <vespa/eval/eval/wrap_param.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/typify.h>
 #include <cassert>
+#include <typeindex>
 
 using namespace vespalib::eval::tensor_function;
 
@@ -135,16 +137,126 @@ void my_generic_reduce_op(State &state, uint64_t param_in) {
     state.pop_push(result_ref);
 };
 
+//-----------------------------------------------------------------------------
+
+// Reduce a dense value into cells allocated in the stash, avoiding
+// the heap allocations of a value builder for each evaluation.
+template <typename ICT, typename OCT, typename AGGR>
+void my_dense_reduce_op(State &state, uint64_t param_in) {
+    const auto &param = unwrap_param<ReduceParam>(param_in);
+    auto cells = state.peek(0).cells().typify<ICT>();
+    AGGR aggr;
+    auto first = [&](size_t idx) { aggr.first(cells[idx]); };
+    auto next = [&](size_t idx) { aggr.next(cells[idx]); };
+    ArrayRef<OCT> out_cells = state.stash.create_array<OCT>(param.dense_plan.out_size);
+    OCT *dst = out_cells.begin();
+    auto reduce_cells = [&](size_t rel_idx)
+                        {
+                            param.dense_plan.execute_reduce(rel_idx, first, next);
+                            *dst++ = aggr.result();
+                        };
+    param.dense_plan.execute_keep(reduce_cells);
+    if (param.res_type.is_double()) {
+        state.pop_push(state.stash.create<DoubleValue>(out_cells[0]));
+    } else {
+        state.pop_push(state.stash.create<DenseValueView>(param.res_type, TypedCells(out_cells)));
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+// Reduce a value with a fast index, grouping subspaces on the label
+// hashes already stored in the index instead of copying labels into
+// map keys. Result subspaces are added to the index of the result as
+// they are found, and the input subspaces of each result subspace are
+// tracked as linked lists in a single shared vector.
+template <typename ICT, typename OCT, typename AGGR>
+const Value &
+fast_sparse_reduce(const FastValueIndex &index, ConstArrayRef<ICT> cells, const ReduceParam &param, Stash &stash) {
+    constexpr uint32_t npos = -1;
+    const auto &map = index.map;
+    const auto &keep_dims = param.sparse_plan.keep_dims;
+    size_t num_subspaces = map.size();
+    auto &result = stash.create<FastValue<OCT>>(param.res_type, keep_dims.size(), param.dense_plan.out_size,
+                                                keep_dims.empty() ? 1 : num_subspaces);
+    auto &result_map = result.my_index.map;
+    std::vector<uint32_t> first;
+    std::vector<uint32_t> last;
+    std::vector<uint32_t> next(num_subspaces, npos);
+    std::vector<FastSparseMap::HashedLabel> keep_addr;
+    keep_addr.reserve(keep_dims.size());
+    for (size_t subspace = 0; subspace < num_subspaces; ++subspace) {
+        auto addr = map.make_addr(subspace);
+        uint64_t hash = 0;
+        for (size_t dim: keep_dims) {
+            hash = 31 * hash + addr[dim].hash;
+        }
+        size_t group = result_map.lookup(hash);
+        if (group == FastSparseMap::npos()) {
+            group = first.size();
+            keep_addr.clear();
+            for (size_t dim: keep_dims) {
+                keep_addr.push_back(addr[dim]);
+            }
+            result_map.add_mapping(ConstArrayRef<FastSparseMap::HashedLabel>(keep_addr), hash);
+            first.push_back(subspace);
+            last.push_back(subspace);
+        } else {
+            next[last[group]] = subspace;
+            last[group] = subspace;
+        }
+    }
+    if (first.empty() && keep_dims.empty()) {
+        result_map.add_mapping(ConstArrayRef<FastSparseMap::HashedLabel>(), 0);
+        result.my_cells.resize(param.dense_plan.out_size, OCT{});
+        return result;
+    }
+    result.my_cells.resize(first.size() * param.dense_plan.out_size);
+    OCT *dst = result.my_cells.data();
+    AGGR aggr;
+    auto first_cell = [&](size_t idx) { aggr.first(cells[idx]); };
+    auto next_cell = [&](size_t idx) { aggr.next(cells[idx]); };
+    for (uint32_t head: first) {
+        auto reduce_cells = [&](size_t rel_idx)
+                            {
+                                uint32_t pos = head;
+                                param.dense_plan.execute_reduce((pos * param.dense_plan.in_size) + rel_idx, first_cell, next_cell);
+                                for (pos = next[pos]; pos != npos; pos = next[pos]) {
+                                    param.dense_plan.execute_reduce((pos * param.dense_plan.in_size) + rel_idx, next_cell);
+                                }
+                                *dst++ = aggr.result();
+                            };
+        param.dense_plan.execute_keep(reduce_cells);
+    }
+    return result;
+}
+
+template <typename ICT, typename OCT, typename AGGR>
+void my_sparse_reduce_op(State &state, uint64_t param_in) {
+    const auto &param = unwrap_param<ReduceParam>(param_in);
+    const Value &value = state.peek(0);
+    const Value::Index &index = value.index();
+    if (std::type_index(typeid(index)) == std::type_index(typeid(FastValueIndex))) {
+        const FastValueIndex &fast_index = static_cast<const FastValueIndex&>(index);
+        return state.pop_push(fast_sparse_reduce<ICT, OCT, AGGR>(fast_index, value.cells().typify<ICT>(), param, state.stash));
+    }
+    my_generic_reduce_op<ICT, OCT, AGGR>(state, param_in);
+};
+
 struct SelectGenericReduceOp {
-    template <typename ICT, typename OCT, typename AGGR> static auto invoke() {
-        return my_generic_reduce_op<ICT, OCT, typename AGGR::template templ<ICT>>;
+    template <typename ICT, typename OCT, typename AGGR> static auto invoke(const ReduceParam &param) {
+        using AggrType = typename AGGR::template templ<typename DecayCellType<ICT>::type>;
+        if (!param.sparse_plan.keep_dims.empty() || (param.sparse_plan.num_reduce_dims > 0)) {
+            return my_sparse_reduce_op<ICT, OCT, AggrType>;
+        }
+        return my_dense_reduce_op<ICT, OCT, AggrType>;
     }
 };
 
 struct PerformGenericReduce {
     template <typename ICT, typename OCT, typename AGGR>
     static auto invoke(const Value &input, const ReduceParam &param) {
-        return generic_reduce<ICT, OCT, typename AGGR::template templ<ICT>>(input, param);
+        return generic_reduce<ICT, OCT, typename AGGR::template templ<typename DecayCellType<ICT>::type>>(input, param);
     }
 };
 
@@ -223,7 +335,7 @@ GenericReduce::make_instruction(const ValueType &type, Aggr aggr, const std::vec
                                 const ValueBuilderFactory &factory, Stash &stash)
 {
     auto &param = stash.create<ReduceParam>(type, dimensions, factory);
-    auto fun = typify_invoke<3,ReduceTypify,SelectGenericReduceOp>(type.cell_type(), param.res_type.cell_type(), aggr);
+    auto fun = typify_invoke<3,ReduceTypify,SelectGenericReduceOp>(type.cell_type(), param.res_type.cell_type(), aggr, param);
     return Instruction(fun, wrap_param<ReduceParam>(param));
 }
 
@@ -26,6 +26,8 @@
 #include "dense/vector_from_doubles_function.h"
 #include "dense/dense_tensor_create_function.h"
 #include "dense/dense_tensor_peek_function.h"
+#include "mixed/mixed_inner_product_function.h"
+#include "mixed/mixed_matmul_function.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/simple_value.h>
@@ -213,7 +215,9 @@ struct CallSparseTensorBuilder {
     }
 };
 
-using MyTypify = eval::TypifyCellType;
+// compact cell types are not stored by the default tensor
+// implementation; such tensors are wrapped simple values instead
+using MyTypify = eval::TypifyDecayedCellType;
 
 Value::UP
 DefaultTensorEngine::from_spec(const TensorSpec &spec) const
@@ -224,6 +228,8 @@ DefaultTensorEngine::from_spec(const TensorSpec &spec) const
     } else if (type.is_double()) {
         double value = spec.cells().empty() ? 0.0 : spec.cells().begin()->second.value;
         return std::make_unique<DoubleValue>(value);
+    } else if (!Tensor::supported({type})) {
+        return std::make_unique<WrappedSimpleValue>(simple_engine().from_spec(spec));
     } else if (type.is_dense()) {
         return typify_invoke<1,MyTypify,CallDenseTensorBuilder>(type.cell_type(), type, spec);
     } else if (type.is_sparse()) {
@@ -289,6 +295,8 @@ DefaultTensorEngine::optimize(const TensorFunction &expr, Stash &stash) const
             child.set(DenseXWProductFunction::optimize(child.get(), stash));
             child.set(DenseMatMulFunction::optimize(child.get(), stash));
             child.set(DenseMultiMatMulFunction::optimize(child.get(), stash));
+            child.set(MixedInnerProductFunction::optimize(child.get(), stash));
+            child.set(MixedMatMulFunction::optimize(child.get(), stash));
             nodes.pop_back();
         }
     }
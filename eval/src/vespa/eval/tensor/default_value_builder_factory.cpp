@@ -29,8 +29,11 @@ struct CreateDefaultValueBuilderBase {
         if (num_mapped_dims == 0) {
             return std::make_unique<DenseTensorValueBuilder<T>>(type, subspace_size);
         }
-        if (subspace_size == 1) {
-            return std::make_unique<SparseTensorValueBuilder<T>>(type, num_mapped_dims, expected_subspaces);
+        if constexpr (std::is_same_v<T, typename DecayCellType<T>::type>) {
+            // sparse tensors with compact cells are packed mixed tensors
+            if (subspace_size == 1) {
+                return std::make_unique<SparseTensorValueBuilder<T>>(type, num_mapped_dims, expected_subspaces);
+            }
         }
         return std::make_unique<packed_mixed_tensor::PackedMixedTensorBuilder<T>>(type, num_mapped_dims, subspace_size, expected_subspaces);
     }
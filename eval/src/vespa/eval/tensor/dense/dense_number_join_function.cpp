@@ -109,11 +109,10 @@ DenseNumberJoinFunction::optimize(const TensorFunction &expr, Stash &stash)
     if (auto join = as<Join>(expr)) {
         const TensorFunction &lhs = join->lhs();
         const TensorFunction &rhs = join->rhs();
-        if (is_dense(lhs) && is_double(rhs)) {
-            assert(cell_type(expr) == cell_type(lhs));
+        // compact cells are decayed by join, which is left to the generic implementation
+        if (is_dense(lhs) && is_double(rhs) && (cell_type(expr) == cell_type(lhs))) {
             return stash.create<DenseNumberJoinFunction>(join->result_type(), lhs, rhs, join->function(), Primary::LHS);
-        } else if (is_double(lhs) && is_dense(rhs)) {
-            assert(cell_type(expr) == cell_type(rhs));
+        } else if (is_double(lhs) && is_dense(rhs) && (cell_type(expr) == cell_type(rhs))) {
             return stash.create<DenseNumberJoinFunction>(join->result_type(), lhs, rhs, join->function(), Primary::RHS);
         }
     }
@@ -83,7 +83,9 @@ const TensorFunction &
 DenseSimpleMapFunction::optimize(const TensorFunction &expr, Stash &stash)
 {
     if (auto map = as<Map>(expr)) {
-        if (map->child().result_type().is_dense()) {
+        const ValueType &child_type = map->child().result_type();
+        // compact cells are decayed by map, which is left to the generic implementation
+        if (child_type.is_dense() && (child_type.cell_type() == map->result_type().cell_type())) {
             return stash.create<DenseSimpleMapFunction>(map->result_type(), map->child(), map->function());
         }
     }
@@ -42,8 +42,8 @@ struct Params {
     }
 };
 
-template <typename CT, typename AGGR>
-CT reduce_cells(const CT *src, size_t dim_size, size_t stride, AGGR &aggr) {
+template <typename ICT, typename AGGR>
+auto reduce_cells(const ICT *src, size_t dim_size, size_t stride, AGGR &aggr) {
     aggr.first(*src);
     for (size_t i = 1; i < dim_size; ++i) {
         src += stride;
@@ -52,17 +52,17 @@ CT reduce_cells(const CT *src, size_t dim_size, size_t stride, AGGR &aggr) {
     return aggr.result();
 }
 
-template <typename CT, typename AGGR>
+template <typename ICT, typename OCT, typename AGGR>
 void my_single_reduce_op(InterpretedFunction::State &state, uint64_t param) {
     const auto &params = unwrap_param<Params>(param);
-    const CT *src = state.peek(0).cells().typify<CT>().cbegin();
-    auto dst_cells = state.stash.create_array<CT>(params.outer_size * params.inner_size);
+    const ICT *src = state.peek(0).cells().typify<ICT>().cbegin();
+    auto dst_cells = state.stash.create_array<OCT>(params.outer_size * params.inner_size);
     AGGR aggr;
-    CT *dst = dst_cells.begin();
+    OCT *dst = dst_cells.begin();
     const size_t block_size = (params.dim_size * params.inner_size);
     for (size_t outer = 0; outer < params.outer_size; ++outer) {
         for (size_t inner = 0; inner < params.inner_size; ++inner) {
-            *dst++ = reduce_cells<CT, AGGR>(src + inner, params.dim_size, params.inner_size, aggr);
+            *dst++ = reduce_cells<ICT, AGGR>(src + inner, params.dim_size, params.inner_size, aggr);
         }
         src += block_size;
     }
@@ -70,15 +70,15 @@ void my_single_reduce_op(InterpretedFunction::State &state, uint64_t param) {
 }
 
 struct MyGetFun {
-    template <typename R1, typename R2> static auto invoke() {
-        return my_single_reduce_op<R1, typename R2::template templ<R1>>;
+    template <typename R1, typename R2, typename R3> static auto invoke() {
+        return my_single_reduce_op<R1, R2, typename R3::template templ<typename eval::DecayCellType<R2>::type>>;
     }
 };
 
 using MyTypify = TypifyValue<TypifyCellType,TypifyAggr>;
 
 bool check_input_type(const ValueType &type) {
-    return (type.is_dense() && ((type.cell_type() == CellType::FLOAT) || (type.cell_type() == CellType::DOUBLE)));
+    return type.is_dense();
 }
 
 } // namespace vespalib::tensor::<unnamed>
@@ -97,7 +97,7 @@ DenseSingleReduceFunction::~DenseSingleReduceFunction() = default;
 InterpretedFunction::Instruction
 DenseSingleReduceFunction::compile_self(eval::EngineOrFactory, Stash &stash) const
 {
-    auto op = typify_invoke<2,MyTypify,MyGetFun>(result_type().cell_type(), _aggr);
+    auto op = typify_invoke<3,MyTypify,MyGetFun>(child().result_type().cell_type(), result_type().cell_type(), _aggr);
     auto &params = stash.create<Params>(result_type(), child().result_type(), _dim_idx);
     return InterpretedFunction::Instruction(op, wrap_param<Params>(params));
 }
@@ -112,7 +112,6 @@ DenseSingleReduceFunction::optimize(const TensorFunction &expr, Stash &stash)
     {
         size_t dim_idx = reduce->child().result_type().dimension_index(reduce->dimensions()[0]);
         assert(dim_idx != ValueType::Dimension::npos);
-        assert(expr.result_type().cell_type() == reduce->child().result_type().cell_type());
         return stash.create<DenseSingleReduceFunction>(expr.result_type(), reduce->child(), dim_idx, reduce->aggr());
     }
     return expr;
@@ -17,5 +17,7 @@ DenseTensorValueBuilder<T>::~DenseTensorValueBuilder() = default;
 
 template class DenseTensorValueBuilder<float>;
 template class DenseTensorValueBuilder<double>;
+template class DenseTensorValueBuilder<BFloat16>;
+template class DenseTensorValueBuilder<int8_t>;
 
 }
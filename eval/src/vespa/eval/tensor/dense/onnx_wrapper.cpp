@@ -9,6 +9,8 @@
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/vespalib/util/classname.h>
 #include <assert.h>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <stdlib.h>
 #include <stdio.h>
@@ -92,6 +94,8 @@ struct CreateVespaTensor {
 
 //-----------------------------------------------------------------------------
 
+std::atomic<size_t> shared_intra_op_threads(0);
+
 template <typename E> vespalib::string type_name(E enum_value) {
     return typify_invoke<1,MyTypify,TypeToString>(enum_value);
 }
@@ -476,8 +480,26 @@ Onnx::EvalContext::get_result(size_t i) const
 //-----------------------------------------------------------------------------
 
 Onnx::Shared::Shared()
-    : _env(ORT_LOGGING_LEVEL_WARNING, "vespa-onnx-wrapper")
+    : _shared_threads(shared_intra_op_threads.load()),
+      _env(nullptr)
 {
+    if (_shared_threads > 0) {
+        const OrtApi &api = Ort::GetApi();
+        OrtThreadingOptions *tp_options = nullptr;
+        Ort::ThrowOnError(api.CreateThreadingOptions(&tp_options));
+        try {
+            Ort::ThrowOnError(api.SetGlobalIntraOpNumThreads(tp_options, _shared_threads));
+            Ort::ThrowOnError(api.SetGlobalInterOpNumThreads(tp_options, 1));
+            _env = Ort::Env(tp_options, ORT_LOGGING_LEVEL_WARNING, "vespa-onnx-wrapper");
+        } catch (...) {
+            api.ReleaseThreadingOptions(tp_options);
+            throw;
+        }
+        api.ReleaseThreadingOptions(tp_options);
+        LOG(info, "using %zu shared onnx intra-op threads", _shared_threads);
+    } else {
+        _env = Ort::Env(ORT_LOGGING_LEVEL_WARNING, "vespa-onnx-wrapper");
+    }
 }
 
 Onnx::Shared &
@@ -514,7 +536,7 @@ Onnx::extract_meta_data()
     }
 }
 
-Onnx::Onnx(const vespalib::string &model_file, Optimize optimize)
+Onnx::Onnx(const vespalib::string &model_file, Optimize optimize, size_t intra_op_threads)
     : _shared(Shared::get()),
       _options(),
       _session(nullptr),
@@ -523,8 +545,12 @@ Onnx::Onnx(const vespalib::string &model_file, Optimize optimize)
       _input_name_refs(),
       _output_name_refs()
 {
-    _options.SetIntraOpNumThreads(1);
-    _options.SetInterOpNumThreads(1);
+    if ((intra_op_threads == 0) && _shared.has_thread_pool()) {
+        _options.DisablePerSessionThreads();
+    } else {
+        _options.SetIntraOpNumThreads(std::max(intra_op_threads, size_t(1)));
+        _options.SetInterOpNumThreads(1);
+    }
     _options.SetGraphOptimizationLevel(convert_optimize(optimize));
     _session = Ort::Session(_shared.env(), model_file.c_str(), _options);
     extract_meta_data();
@@ -532,4 +558,16 @@ Onnx::Onnx(const vespalib::string &model_file, Optimize optimize)
 
 Onnx::~Onnx() = default;
 
+void
+Onnx::set_shared_intra_op_threads(size_t num_threads)
+{
+    shared_intra_op_threads = num_threads;
+}
+
+size_t
+Onnx::get_shared_intra_op_threads()
+{
+    return shared_intra_op_threads.load();
+}
+
 }
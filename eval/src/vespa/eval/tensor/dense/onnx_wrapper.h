@@ -32,6 +32,12 @@ namespace vespalib::tensor {
  * plan. Bind actual vespa values to the model inputs, invoke eval and
  * inspect the results. See the unit test (tests/tensor/onnx_wrapper)
  * for some examples.
+ *
+ * Each model session runs operators using its own intra-op thread
+ * pool of the requested size. Using 0 intra-op threads makes the
+ * session use the process-wide intra-op thread pool instead, which
+ * must be sized with set_shared_intra_op_threads before any model is
+ * loaded (a single thread per session is used if it is not).
  **/
 class Onnx {
 public:
@@ -139,11 +145,13 @@ private:
     // common stuff shared between model sessions
     class Shared {
     private:
+        size_t   _shared_threads;
         Ort::Env _env;
         Shared();
     public:
         static Shared &get();
         Ort::Env &env() { return _env; }
+        bool has_thread_pool() const { return (_shared_threads > 0); }
     };
 
     Shared                   &_shared;
@@ -157,8 +165,10 @@ private:
     void extract_meta_data();
 
 public:
-    Onnx(const vespalib::string &model_file, Optimize optimize);
+    Onnx(const vespalib::string &model_file, Optimize optimize, size_t intra_op_threads = 1);
     ~Onnx();
+    static void set_shared_intra_op_threads(size_t num_threads);
+    static size_t get_shared_intra_op_threads();
     const std::vector<TensorInfo> &inputs() const { return _inputs; }
     const std::vector<TensorInfo> &outputs() const { return _outputs; }
 };
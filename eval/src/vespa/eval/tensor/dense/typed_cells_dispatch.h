@@ -14,6 +14,8 @@ decltype(auto) dispatch_1(const TypedCells &a, Args &&...args) {
     switch (a.type) {
         case CellType::DOUBLE: return TGT::call(a.unsafe_typify<double>(), std::forward<Args>(args)...);
         case CellType::FLOAT:  return TGT::call(a.unsafe_typify<float>(),  std::forward<Args>(args)...);
+        case CellType::BFLOAT16: return TGT::call(a.unsafe_typify<BFloat16>(), std::forward<Args>(args)...);
+        case CellType::INT8: return TGT::call(a.unsafe_typify<int8_t>(), std::forward<Args>(args)...);
     }
     abort();
 }
@@ -23,6 +25,8 @@ decltype(auto) dispatch_2(A1 &&a, const TypedCells &b, Args &&...args) {
     switch (b.type) {
         case CellType::DOUBLE: return dispatch_1<TGT>(std::forward<A1>(a), b.unsafe_typify<double>(), std::forward<Args>(args)...);
         case CellType::FLOAT:  return dispatch_1<TGT>(std::forward<A1>(a), b.unsafe_typify<float>(),  std::forward<Args>(args)...);
+        case CellType::BFLOAT16: return dispatch_1<TGT>(std::forward<A1>(a), b.unsafe_typify<BFloat16>(), std::forward<Args>(args)...);
+        case CellType::INT8: return dispatch_1<TGT>(std::forward<A1>(a), b.unsafe_typify<int8_t>(), std::forward<Args>(args)...);
     }
     abort();
 }
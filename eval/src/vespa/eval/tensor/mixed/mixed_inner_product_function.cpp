@@ -0,0 +1,180 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_inner_product_function.h"
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/typify.h>
+#include <cassert>
+
+namespace vespalib::tensor {
+
+using eval::Aggr;
+using eval::TensorFunction;
+using eval::TypedCells;
+using eval::Value;
+using eval::ValueType;
+using eval::as;
+using hwaccelrated::IAccelrated;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+namespace {
+
+template <typename LCT, typename RCT>
+struct MyDotProduct {
+    static double apply(const IAccelrated &, const LCT *lhs, const RCT *rhs, size_t count) {
+        double result = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            result += lhs[i] * rhs[i];
+        }
+        return result;
+    }
+};
+
+template <typename CT>
+struct MySameDotProduct {
+    static CT apply(const IAccelrated &hw, const CT *lhs, const CT *rhs, size_t count) {
+        return hw.dotProduct(lhs, rhs, count);
+    }
+};
+
+template <> struct MyDotProduct<double,double> : MySameDotProduct<double> {};
+template <> struct MyDotProduct<float,float> : MySameDotProduct<float> {};
+
+template <typename MCT, typename VCT>
+void my_mixed_inner_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const MixedInnerProductFunction::Self &self = unwrap_param<MixedInnerProductFunction::Self>(param);
+    using OCT = typename eval::UnifyCellTypes<MCT,VCT>::type;
+    const Value &mixed = state.peek(1);
+    const MCT *m_cells = mixed.cells().typify<MCT>().cbegin();
+    const VCT *v_cells = state.peek(0).cells().typify<VCT>().cbegin();
+    const IAccelrated &hw = IAccelrated::getAccelerator();
+    size_t num_out_cells = mixed.index().size() * self.out_subspace_size;
+    auto dst_cells = state.stash.create_array<OCT>(num_out_cells);
+    OCT *dst = dst_cells.begin();
+    for (size_t i = 0; i < num_out_cells; ++i) {
+        *dst++ = MyDotProduct<MCT,VCT>::apply(hw, m_cells, v_cells, self.vector_size);
+        m_cells += self.vector_size;
+    }
+    state.pop_pop_push(state.stash.create<eval::ValueView>(self.result_type, mixed.index(), TypedCells(dst_cells)));
+}
+
+// used when values are tensors owned by a tensor engine
+void my_engine_inner_product_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const MixedInnerProductFunction::Self &self = unwrap_param<MixedInnerProductFunction::Self>(param);
+    const Value &product = state.engine.join(state.peek(1), state.peek(0), Mul::f, state.stash);
+    state.pop_pop_push(state.engine.reduce(product, Aggr::SUM, self.reduce_dims, state.stash));
+}
+
+struct MyGetFun {
+    template <typename MCT, typename VCT> static auto invoke() {
+        return my_mixed_inner_product_op<MCT,VCT>;
+    }
+};
+
+bool is_mixed(const ValueType &type) {
+    return ((type.count_mapped_dimensions() > 0) && (type.count_indexed_dimensions() > 0));
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+MixedInnerProductFunction::Self::Self(const eval::ValueType &result_type_in,
+                                      size_t vector_size_in,
+                                      size_t out_subspace_size_in,
+                                      const std::vector<vespalib::string> &reduce_dims_in)
+    : result_type(result_type_in),
+      vector_size(vector_size_in),
+      out_subspace_size(out_subspace_size_in),
+      reduce_dims(reduce_dims_in)
+{
+}
+
+MixedInnerProductFunction::Self::~Self() = default;
+
+MixedInnerProductFunction::MixedInnerProductFunction(const eval::ValueType &result_type,
+                                                     const eval::TensorFunction &mixed_in,
+                                                     const eval::TensorFunction &vector_in)
+    : Super(result_type, mixed_in, vector_in),
+      _vector_size(vector_in.result_type().dense_subspace_size()),
+      _out_subspace_size(result_type.dense_subspace_size())
+{
+    assert(mixed_in.result_type().dense_subspace_size() == (_vector_size * _out_subspace_size));
+}
+
+MixedInnerProductFunction::~MixedInnerProductFunction() = default;
+
+eval::InterpretedFunction::Instruction
+MixedInnerProductFunction::compile_self(eval::EngineOrFactory engine, Stash &stash) const
+{
+    Self &self = stash.create<Self>(result_type(), _vector_size, _out_subspace_size,
+                                    rhs().result_type().dimension_names());
+    if (!engine.is_factory()) {
+        return eval::InterpretedFunction::Instruction(my_engine_inner_product_op, wrap_param<Self>(self));
+    }
+    auto op = typify_invoke<2,eval::TypifyCellType,MyGetFun>(lhs().result_type().cell_type(),
+                                                             rhs().result_type().cell_type());
+    return eval::InterpretedFunction::Instruction(op, wrap_param<Self>(self));
+}
+
+void
+MixedInnerProductFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Super::visit_self(visitor);
+    visitor.visitInt("vector_size", _vector_size);
+    visitor.visitInt("out_subspace_size", _out_subspace_size);
+}
+
+bool
+MixedInnerProductFunction::compatible_types(const ValueType &res, const ValueType &mixed, const ValueType &vector)
+{
+    if (!is_mixed(mixed) || !vector.is_dense() || vector.dimensions().empty() ||
+        (res.count_mapped_dimensions() != mixed.count_mapped_dimensions()))
+    {
+        return false;
+    }
+    std::vector<ValueType::Dimension> indexed;
+    for (const auto &dim: mixed.dimensions()) {
+        if (dim.is_indexed()) {
+            indexed.push_back(dim);
+        }
+    }
+    const auto &vector_dims = vector.dimensions();
+    if (indexed.size() < vector_dims.size()) {
+        return false;
+    }
+    // the vector dimensions must be the innermost dimensions of the dense subspace
+    size_t offset = indexed.size() - vector_dims.size();
+    for (size_t i = 0; i < vector_dims.size(); ++i) {
+        if ((indexed[offset + i] != vector_dims[i]) ||
+            (res.dimension_index(vector_dims[i].name) != ValueType::Dimension::npos))
+        {
+            return false;
+        }
+    }
+    return ((res.dimensions().size() + vector_dims.size()) == mixed.dimensions().size());
+}
+
+const TensorFunction &
+MixedInnerProductFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    const Reduce *reduce = as<Reduce>(expr);
+    if (reduce && (reduce->aggr() == Aggr::SUM) && !reduce->dimensions().empty()) {
+        const ValueType &result_type = reduce->result_type();
+        const Join *join = as<Join>(reduce->child());
+        if (join && (join->function() == Mul::f)) {
+            const TensorFunction &lhs = join->lhs();
+            const TensorFunction &rhs = join->rhs();
+            if (compatible_types(result_type, lhs.result_type(), rhs.result_type())) {
+                return stash.create<MixedInnerProductFunction>(result_type, lhs, rhs);
+            }
+            if (compatible_types(result_type, rhs.result_type(), lhs.result_type())) {
+                return stash.create<MixedInnerProductFunction>(result_type, rhs, lhs);
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
@@ -0,0 +1,53 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function for the inner product of each dense subspace of a
+ * mixed tensor with a dense tensor, like
+ * reduce(tensor(cat{},x[128])*tensor(x[128]),sum,x). The dimensions
+ * of the dense tensor must be the innermost indexed dimensions of the
+ * mixed tensor, and they must be exactly the reduced dimensions. The
+ * result has the same sparse mappings as the mixed tensor, and shares
+ * its index.
+ **/
+class MixedInnerProductFunction : public eval::tensor_function::Op2
+{
+    using Super = eval::tensor_function::Op2;
+public:
+    struct Self {
+        eval::ValueType result_type;
+        size_t vector_size;
+        size_t out_subspace_size;
+        std::vector<vespalib::string> reduce_dims;
+        Self(const eval::ValueType &result_type_in, size_t vector_size_in, size_t out_subspace_size_in,
+             const std::vector<vespalib::string> &reduce_dims_in);
+        ~Self();
+    };
+
+private:
+    size_t _vector_size;
+    size_t _out_subspace_size;
+
+public:
+    MixedInnerProductFunction(const eval::ValueType &result_type,
+                              const eval::TensorFunction &mixed_in,
+                              const eval::TensorFunction &vector_in);
+    ~MixedInnerProductFunction();
+
+    bool result_is_mutable() const override { return true; }
+
+    size_t vector_size() const { return _vector_size; }
+    size_t out_subspace_size() const { return _out_subspace_size; }
+
+    eval::InterpretedFunction::Instruction compile_self(eval::EngineOrFactory engine, Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static bool compatible_types(const eval::ValueType &res, const eval::ValueType &mixed, const eval::ValueType &vector);
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
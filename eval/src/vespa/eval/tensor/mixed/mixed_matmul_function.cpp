@@ -0,0 +1,231 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_matmul_function.h"
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/typify.h>
+#include <cassert>
+
+#include <cblas.h>
+
+namespace vespalib::tensor {
+
+using eval::Aggr;
+using eval::TensorFunction;
+using eval::TypedCells;
+using eval::Value;
+using eval::ValueType;
+using eval::as;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+namespace {
+
+template <typename LCT, typename RCT, bool rhs_common_inner>
+double my_dot_product(const LCT *lhs, const RCT *rhs, size_t common_size, size_t rhs_size) {
+    double result = 0.0;
+    for (size_t i = 0; i < common_size; ++i) {
+        result += ((*lhs) * (*rhs));
+        ++lhs;
+        rhs += (rhs_common_inner ? 1 : rhs_size);
+    }
+    return result;
+}
+
+template <typename LCT, typename RCT, bool rhs_common_inner>
+void my_mixed_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const MixedMatMulFunction::Self &self = unwrap_param<MixedMatMulFunction::Self>(param);
+    using OCT = typename eval::UnifyCellTypes<LCT,RCT>::type;
+    const Value &mixed = state.peek(1);
+    auto rhs_cells = state.peek(0).cells().typify<RCT>();
+    size_t num_rows = mixed.index().size() * self.lhs_size;
+    auto dst_cells = state.stash.create_array<OCT>(num_rows * self.rhs_size);
+    OCT *dst = dst_cells.begin();
+    const LCT *lhs = mixed.cells().typify<LCT>().cbegin();
+    for (size_t i = 0; i < num_rows; ++i) {
+        const RCT *rhs = rhs_cells.cbegin();
+        for (size_t j = 0; j < self.rhs_size; ++j) {
+            *dst++ = my_dot_product<LCT,RCT,rhs_common_inner>(lhs, rhs, self.common_size, self.rhs_size);
+            rhs += (rhs_common_inner ? self.common_size : 1);
+        }
+        lhs += self.common_size;
+    }
+    state.pop_pop_push(state.stash.create<eval::ValueView>(self.result_type, mixed.index(), TypedCells(dst_cells)));
+}
+
+template <bool rhs_common_inner>
+void my_cblas_double_mixed_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const MixedMatMulFunction::Self &self = unwrap_param<MixedMatMulFunction::Self>(param);
+    const Value &mixed = state.peek(1);
+    auto rhs_cells = state.peek(0).cells().typify<double>();
+    size_t num_rows = mixed.index().size() * self.lhs_size;
+    auto dst_cells = state.stash.create_array<double>(num_rows * self.rhs_size);
+    if (num_rows > 0) {
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
+                    num_rows, self.rhs_size, self.common_size, 1.0,
+                    mixed.cells().typify<double>().cbegin(), self.common_size,
+                    rhs_cells.cbegin(), rhs_common_inner ? self.common_size : self.rhs_size,
+                    0.0, dst_cells.begin(), self.rhs_size);
+    }
+    state.pop_pop_push(state.stash.create<eval::ValueView>(self.result_type, mixed.index(), TypedCells(dst_cells)));
+}
+
+template <bool rhs_common_inner>
+void my_cblas_float_mixed_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const MixedMatMulFunction::Self &self = unwrap_param<MixedMatMulFunction::Self>(param);
+    const Value &mixed = state.peek(1);
+    auto rhs_cells = state.peek(0).cells().typify<float>();
+    size_t num_rows = mixed.index().size() * self.lhs_size;
+    auto dst_cells = state.stash.create_array<float>(num_rows * self.rhs_size);
+    if (num_rows > 0) {
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, rhs_common_inner ? CblasTrans : CblasNoTrans,
+                    num_rows, self.rhs_size, self.common_size, 1.0,
+                    mixed.cells().typify<float>().cbegin(), self.common_size,
+                    rhs_cells.cbegin(), rhs_common_inner ? self.common_size : self.rhs_size,
+                    0.0, dst_cells.begin(), self.rhs_size);
+    }
+    state.pop_pop_push(state.stash.create<eval::ValueView>(self.result_type, mixed.index(), TypedCells(dst_cells)));
+}
+
+// used when values are tensors owned by a tensor engine
+void my_engine_mixed_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const MixedMatMulFunction::Self &self = unwrap_param<MixedMatMulFunction::Self>(param);
+    const Value &product = state.engine.join(state.peek(1), state.peek(0), Mul::f, state.stash);
+    state.pop_pop_push(state.engine.reduce(product, Aggr::SUM, self.reduce_dims, state.stash));
+}
+
+struct MyGetFun {
+    template<typename R1, typename R2, typename R3> static auto invoke() {
+        if (std::is_same_v<R1,double> && std::is_same_v<R2,double>) {
+            return my_cblas_double_mixed_matmul_op<R3::value>;
+        } else if (std::is_same_v<R1,float> && std::is_same_v<R2,float>) {
+            return my_cblas_float_mixed_matmul_op<R3::value>;
+        } else {
+            return my_mixed_matmul_op<R1, R2, R3::value>;
+        }
+    }
+};
+
+bool is_matrix(const ValueType &type) {
+    return (type.is_dense() && (type.dimensions().size() == 2));
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+MixedMatMulFunction::Self::Self(const eval::ValueType &result_type_in,
+                                size_t lhs_size_in,
+                                size_t common_size_in,
+                                size_t rhs_size_in,
+                                const vespalib::string &reduce_dim_in)
+    : result_type(result_type_in),
+      lhs_size(lhs_size_in),
+      common_size(common_size_in),
+      rhs_size(rhs_size_in),
+      reduce_dims({reduce_dim_in})
+{
+}
+
+MixedMatMulFunction::Self::~Self() = default;
+
+MixedMatMulFunction::MixedMatMulFunction(const eval::ValueType &result_type,
+                                         const eval::TensorFunction &mixed_in,
+                                         const eval::TensorFunction &matrix_in,
+                                         const vespalib::string &reduce_dim)
+    : Super(result_type, mixed_in, matrix_in),
+      _reduce_dim(reduce_dim),
+      _lhs_size(0),
+      _common_size(0),
+      _rhs_size(0),
+      _rhs_common_inner(false)
+{
+    const ValueType &matrix = matrix_in.result_type();
+    size_t common_idx = matrix.dimension_index(reduce_dim);
+    assert(common_idx != ValueType::Dimension::npos);
+    _common_size = matrix.dimensions()[common_idx].size;
+    _rhs_size = matrix.dimensions()[1 - common_idx].size;
+    _rhs_common_inner = (common_idx == 1);
+    _lhs_size = mixed_in.result_type().dense_subspace_size() / _common_size;
+}
+
+MixedMatMulFunction::~MixedMatMulFunction() = default;
+
+eval::InterpretedFunction::Instruction
+MixedMatMulFunction::compile_self(eval::EngineOrFactory engine, Stash &stash) const
+{
+    Self &self = stash.create<Self>(result_type(), _lhs_size, _common_size, _rhs_size, _reduce_dim);
+    if (!engine.is_factory()) {
+        return eval::InterpretedFunction::Instruction(my_engine_mixed_matmul_op, wrap_param<Self>(self));
+    }
+    using MyTypify = TypifyValue<eval::TypifyCellType,TypifyBool>;
+    auto op = typify_invoke<3,MyTypify,MyGetFun>(lhs().result_type().cell_type(),
+                                                 rhs().result_type().cell_type(),
+                                                 _rhs_common_inner);
+    return eval::InterpretedFunction::Instruction(op, wrap_param<Self>(self));
+}
+
+void
+MixedMatMulFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Super::visit_self(visitor);
+    visitor.visitInt("lhs_size", _lhs_size);
+    visitor.visitInt("common_size", _common_size);
+    visitor.visitInt("rhs_size", _rhs_size);
+    visitor.visitBool("rhs_common_inner", _rhs_common_inner);
+}
+
+bool
+MixedMatMulFunction::compatible_types(const ValueType &res, const ValueType &mixed,
+                                      const ValueType &matrix, const vespalib::string &reduce_dim)
+{
+    if ((mixed.count_mapped_dimensions() == 0) || !is_matrix(matrix) ||
+        (res.count_mapped_dimensions() != mixed.count_mapped_dimensions()))
+    {
+        return false;
+    }
+    size_t common_idx = matrix.dimension_index(reduce_dim);
+    if (common_idx == ValueType::Dimension::npos) {
+        return false;
+    }
+    const auto &common_dim = matrix.dimensions()[common_idx];
+    const auto &other_dim = matrix.dimensions()[1 - common_idx];
+    if (mixed.dimension_index(other_dim.name) != ValueType::Dimension::npos) {
+        return false;
+    }
+    // the reduced dimension must be the innermost indexed dimension
+    // of the mixed tensor, and the other matrix dimension must sort
+    // after all the remaining indexed dimensions of the mixed tensor
+    const ValueType::Dimension *last_indexed = nullptr;
+    for (const auto &dim: mixed.dimensions()) {
+        if (dim.is_indexed()) {
+            if ((last_indexed != nullptr) && !(last_indexed->name < other_dim.name)) {
+                return false;
+            }
+            last_indexed = &dim;
+        }
+    }
+    return ((last_indexed != nullptr) && (*last_indexed == common_dim));
+}
+
+const TensorFunction &
+MixedMatMulFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (reduce && (reduce->aggr() == Aggr::SUM) && (reduce->dimensions().size() == 1)) {
+        auto join = as<Join>(reduce->child());
+        if (join && (join->function() == Mul::f)) {
+            const TensorFunction &lhs = join->lhs();
+            const TensorFunction &rhs = join->rhs();
+            const vespalib::string &reduce_dim = reduce->dimensions()[0];
+            if (compatible_types(expr.result_type(), lhs.result_type(), rhs.result_type(), reduce_dim)) {
+                return stash.create<MixedMatMulFunction>(expr.result_type(), lhs, rhs, reduce_dim);
+            }
+            if (compatible_types(expr.result_type(), rhs.result_type(), lhs.result_type(), reduce_dim)) {
+                return stash.create<MixedMatMulFunction>(expr.result_type(), rhs, lhs, reduce_dim);
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
@@ -0,0 +1,66 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function multiplying each dense subspace of a mixed tensor
+ * with a dense matrix, like
+ * reduce(tensor(cat{},x[128])*tensor(x[128],y[16]),sum,x). The
+ * reduced dimension must be the innermost indexed dimension of the
+ * mixed tensor, and the other matrix dimension must become the
+ * innermost indexed dimension of the result. Since the dense
+ * subspaces of the mixed tensor are stored back to back, all of them
+ * are multiplied with the matrix in a single matrix multiplication.
+ * The result has the same sparse mappings as the mixed tensor, and
+ * shares its index.
+ **/
+class MixedMatMulFunction : public eval::tensor_function::Op2
+{
+    using Super = eval::tensor_function::Op2;
+public:
+    struct Self {
+        eval::ValueType result_type;
+        size_t lhs_size;
+        size_t common_size;
+        size_t rhs_size;
+        std::vector<vespalib::string> reduce_dims;
+        Self(const eval::ValueType &result_type_in,
+             size_t lhs_size_in, size_t common_size_in, size_t rhs_size_in,
+             const vespalib::string &reduce_dim_in);
+        ~Self();
+    };
+
+private:
+    vespalib::string _reduce_dim;
+    size_t _lhs_size;
+    size_t _common_size;
+    size_t _rhs_size;
+    bool   _rhs_common_inner;
+
+public:
+    MixedMatMulFunction(const eval::ValueType &result_type,
+                        const eval::TensorFunction &mixed_in,
+                        const eval::TensorFunction &matrix_in,
+                        const vespalib::string &reduce_dim);
+    ~MixedMatMulFunction();
+
+    bool result_is_mutable() const override { return true; }
+
+    // number of rows of the dense subspace of the mixed tensor
+    size_t lhs_size() const { return _lhs_size; }
+    size_t common_size() const { return _common_size; }
+    size_t rhs_size() const { return _rhs_size; }
+    bool rhs_common_inner() const { return _rhs_common_inner; }
+
+    eval::InterpretedFunction::Instruction compile_self(eval::EngineOrFactory engine, Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static bool compatible_types(const eval::ValueType &res, const eval::ValueType &mixed,
+                                 const eval::ValueType &matrix, const vespalib::string &reduce_dim);
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
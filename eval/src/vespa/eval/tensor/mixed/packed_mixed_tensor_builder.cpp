@@ -50,5 +50,7 @@ PackedMixedTensorBuilder<T>::build(std::unique_ptr<ValueBuilder<T>>)
 
 template class PackedMixedTensorBuilder<float>;
 template class PackedMixedTensorBuilder<double>;
+template class PackedMixedTensorBuilder<BFloat16>;
+template class PackedMixedTensorBuilder<int8_t>;
 
 } // namespace
@@ -52,7 +52,7 @@ size_t decodeDimensions(nbostream & stream, std::vector<Dimension> & dimensions)
 
 template<typename T, typename V>
 void decodeCells(nbostream &stream, size_t cellsSize, V &cells) {
-    T cellValue = 0.0;
+    T cellValue = T();
     for (size_t i = 0; i < cellsSize; ++i) {
         stream >> cellValue;
         cells.emplace_back(cellValue);
@@ -68,6 +68,12 @@ void decodeCells(CellType cell_type, nbostream &stream, size_t cellsSize, V &cel
     case CellType::FLOAT:
         decodeCells<float>(stream, cellsSize, cells);
         break;
+    case CellType::BFLOAT16:
+        decodeCells<BFloat16>(stream, cellsSize, cells);
+        break;
+    case CellType::INT8:
+        decodeCells<int8_t>(stream, cellsSize, cells);
+        break;
     }
 }
 
@@ -86,6 +92,12 @@ DenseBinaryFormat::serialize(nbostream &stream, const DenseTensorView &tensor)
     case CellType::FLOAT:
         encodeCells<float>(stream, cells);
         break;
+    case CellType::BFLOAT16:
+        encodeCells<BFloat16>(stream, cells);
+        break;
+    case CellType::INT8:
+        encodeCells<int8_t>(stream, cells);
+        break;
     }
 }
 
@@ -94,6 +94,12 @@ size_t encodeCells(nbostream &stream, const Tensor &tensor, CellType cell_type)
     case CellType::FLOAT:
         return encodeCells<float>(stream, tensor);
         break;
+    case CellType::BFLOAT16:
+        return encodeCells<BFloat16>(stream, tensor);
+        break;
+    case CellType::INT8:
+        return encodeCells<int8_t>(stream, tensor);
+        break;
     }
     return 0;
 }
@@ -161,8 +167,12 @@ SparseBinaryFormat::deserialize(nbostream &stream, CellType cell_type)
     }
     size_t cellsSize = stream.getInt1_4Bytes();
     ValueType type = ValueType::tensor_type(std::move(dimensions), cell_type);
-    return typify_invoke<1,eval::TypifyCellType,BuildSparseCells>(cell_type,
-        std::move(type), stream, dimensionsSize, cellsSize);
+    // sparse tensors with compact cell types are wrapped simple values
+    assert(cell_type == ValueType::decay_cell_type(cell_type));
+    if (cell_type == CellType::DOUBLE) {
+        return BuildSparseCells::invoke<double>(std::move(type), stream, dimensionsSize, cellsSize);
+    }
+    return BuildSparseCells::invoke<float>(std::move(type), stream, dimensionsSize, cellsSize);
 }
 
 } // namespace
@@ -39,6 +39,8 @@ constexpr uint32_t MIXED_BINARY_FORMAT_WITH_CELLTYPE = 7u;
 
 constexpr uint32_t DOUBLE_VALUE_TYPE = 0;
 constexpr uint32_t FLOAT_VALUE_TYPE = 1;
+constexpr uint32_t BFLOAT16_VALUE_TYPE = 2;
+constexpr uint32_t INT8_VALUE_TYPE = 3;
 
 uint32_t cell_type_to_encoding(CellType cell_type) {
     switch (cell_type) {
@@ -46,6 +48,10 @@ uint32_t cell_type_to_encoding(CellType cell_type) {
         return DOUBLE_VALUE_TYPE;
     case CellType::FLOAT:
         return FLOAT_VALUE_TYPE;
+    case CellType::BFLOAT16:
+        return BFLOAT16_VALUE_TYPE;
+    case CellType::INT8:
+        return INT8_VALUE_TYPE;
     }
     abort();
 }
@@ -57,11 +63,20 @@ encoding_to_cell_type(uint32_t cell_encoding) {
         return CellType::DOUBLE;
     case FLOAT_VALUE_TYPE:
         return CellType::FLOAT;
+    case BFLOAT16_VALUE_TYPE:
+        return CellType::BFLOAT16;
+    case INT8_VALUE_TYPE:
+        return CellType::INT8;
     default:
-        throw IllegalArgumentException(make_string("Received unknown tensor value type = %u. Only 0(double), or 1(float) are legal.", cell_encoding));
+        throw IllegalArgumentException(make_string("Received unknown tensor value type = %u. Only 0(double), 1(float), 2(bfloat16) or 3(int8) are legal.", cell_encoding));
     }
 }
 
+// compact cells are only supported by wrapped simple values
+bool is_compact(CellType cell_type) {
+    return (cell_type != ValueType::decay_cell_type(cell_type));
+}
+
 std::unique_ptr<Tensor>
 wrap_simple_value(std::unique_ptr<eval::Value> simple)
 {
@@ -112,11 +127,19 @@ TypedBinaryFormat::deserialize(nbostream &stream)
     switch (formatId) {
     case SPARSE_BINARY_FORMAT_WITH_CELLTYPE:
         cell_type = encoding_to_cell_type(stream.getInt1_4Bytes());
+        if (is_compact(cell_type)) {
+            stream.adjustReadPos(read_pos - stream.rp());
+            return wrap_simple_value(simple_engine().decode(stream));
+        }
         [[fallthrough]];
     case SPARSE_BINARY_FORMAT_TYPE:
         return SparseBinaryFormat::deserialize(stream, cell_type);
     case DENSE_BINARY_FORMAT_WITH_CELLTYPE:
         cell_type = encoding_to_cell_type(stream.getInt1_4Bytes());
+        if (is_compact(cell_type)) {
+            stream.adjustReadPos(read_pos - stream.rp());
+            return wrap_simple_value(simple_engine().decode(stream));
+        }
         [[fallthrough]];
     case DENSE_BINARY_FORMAT_TYPE:
         return DenseBinaryFormat::deserialize(stream, cell_type);
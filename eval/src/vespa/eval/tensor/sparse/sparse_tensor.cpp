@@ -58,7 +58,7 @@ bool
 SparseTensor::operator==(const SparseTensor &rhs) const
 {
     if (fast_type() == rhs.fast_type() && my_size() == rhs.my_size()) {
-        return typify_invoke<1,eval::TypifyCellType,CompareValues>(_type.cell_type(), *this, rhs);
+        return typify_invoke<1,eval::TypifyDecayedCellType,CompareValues>(_type.cell_type(), *this, rhs);
     }
     return false;
 }
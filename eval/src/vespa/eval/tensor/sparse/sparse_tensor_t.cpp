@@ -181,12 +181,12 @@ SparseTensorT<T>::join(join_fun_t function, const Tensor &arg) const
     auto res_type = eval::ValueType::join(lhs_type, rhs_type);
     if (function == eval::operation::Mul::f) {
         if (lhs_type.dimensions() == rhs_type.dimensions()) {
-            return typify_invoke<1,eval::TypifyCellType,FastSparseJoin<T>>(rhs_ct,
+            return typify_invoke<1,eval::TypifyDecayedCellType,FastSparseJoin<T>>(rhs_ct,
                     *this, *rhs, std::move(res_type));
         }
     }
     auto res_ct = res_type.cell_type();
-    return typify_invoke<2,eval::TypifyCellType,GenericSparseJoin<T>>(rhs_ct, res_ct,
+    return typify_invoke<2,eval::TypifyDecayedCellType,GenericSparseJoin<T>>(rhs_ct, res_ct,
             *this, *rhs, std::move(res_type), function);
 }
 
@@ -196,7 +196,7 @@ SparseTensorT<T>::merge(join_fun_t function, const Tensor &arg) const
 {
     const SparseTensor *rhs = dynamic_cast<const SparseTensor *>(&arg);
     assert(rhs && (fast_type().dimensions() == rhs->fast_type().dimensions()));
-    return typify_invoke<2,eval::TypifyCellType,GenericSparseMerge>(
+    return typify_invoke<2,eval::TypifyDecayedCellType,GenericSparseMerge>(
             fast_type().cell_type(), rhs->fast_type().cell_type(),
             *this, *rhs, function);
 }
@@ -17,6 +17,9 @@ Tensor::supported(TypeList types)
     bool sparse = false;
     bool dense = false;
     for (const eval::ValueType &type: types) {
+        if (type.cell_type() != eval::ValueType::decay_cell_type(type.cell_type())) {
+            return false;
+        }
         dense = (dense || type.is_double());
         for (const auto &dim: type.dimensions()) {
             dense = (dense || dim.is_indexed());
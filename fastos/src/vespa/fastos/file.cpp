@@ -501,6 +501,18 @@ void FastOS_FileInterface::dropFromCache() const
 {
 }
 
+void FastOS_FileInterface::startWriteBack(int64_t, size_t) const
+{
+}
+
+void FastOS_FileInterface::dropFromCache(int64_t, size_t) const
+{
+}
+
+void FastOS_FileInterface::prefetch(int64_t, size_t) const
+{
+}
+
 FastOS_DirectoryScanInterface::FastOS_DirectoryScanInterface(const char *path)
     : _searchPath(strdup(path))
 {
@@ -587,6 +587,34 @@ public:
      **/
     virtual void dropFromCache() const;
 
+    /**
+     * Start write back of the given range of the file to disk, without
+     * waiting for it to complete.
+     *
+     * @param offset start of range
+     * @param length length of range
+     **/
+    virtual void startWriteBack(int64_t offset, size_t length) const;
+
+    /**
+     * Wait for write back of the given range of the file and drop it
+     * from the FS cache. Used together with @ref startWriteBack() by
+     * sequential writers to avoid evicting data that is read by others.
+     *
+     * @param offset start of range
+     * @param length length of range
+     **/
+    virtual void dropFromCache(int64_t offset, size_t length) const;
+
+    /**
+     * Hint that the given range of the file will be read soon. The hint
+     * does not block, allowing reads of several ranges to overlap.
+     *
+     * @param offset start of range
+     * @param length length of range
+     **/
+    virtual void prefetch(int64_t offset, size_t length) const;
+
     enum Error
     {
         ERR_ZERO = 1,   // No error                       New style
@@ -354,6 +354,16 @@ FastOS_Linux_File::EnableDirectIO()
 }
 
 
+void
+FastOS_Linux_File::prefetch(int64_t offset, size_t length) const
+{
+    // Direct IO bypasses the page cache, thus a prefetch would only waste disk bandwidth
+    if (!_directIOEnabled) {
+        FastOS_UNIX_File::prefetch(offset, length);
+    }
+}
+
+
 bool
 FastOS_Linux_File::Open(unsigned int openFlags, const char *filename)
 {
@@ -31,6 +31,7 @@ public:
     bool GetDirectIORestrictions(size_t &memoryAlignment, size_t &transferGranularity, size_t &transferMaximum) override;
     bool DirectIOPadding(int64_t offset, size_t length, size_t &padBefore, size_t &padAfter) override;
     void EnableDirectIO() override;
+    void prefetch(int64_t offset, size_t length) const override;
     bool SetPosition(int64_t desiredPosition) override;
     int64_t GetPosition() override;
     bool SetSize(int64_t newSize) override;
@@ -9,6 +9,7 @@
 
 #include "file.h"
 #include <sstream>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <unistd.h>
@@ -311,6 +312,46 @@ void FastOS_UNIX_File::dropFromCache() const
 #endif
 }
 
+void FastOS_UNIX_File::startWriteBack(int64_t offset, size_t length) const
+{
+#ifdef __linux__
+    sync_file_range(_filedes, offset, length, SYNC_FILE_RANGE_WRITE);
+#else
+    (void) offset;
+    (void) length;
+#endif
+}
+
+void FastOS_UNIX_File::dropFromCache(int64_t offset, size_t length) const
+{
+#ifdef __linux__
+    sync_file_range(_filedes, offset, length,
+                    SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    posix_fadvise(_filedes, offset, length, POSIX_FADV_DONTNEED);
+#else
+    (void) offset;
+    (void) length;
+#endif
+}
+
+void FastOS_UNIX_File::prefetch(int64_t offset, size_t length) const
+{
+    if (_mmapbase != nullptr) {
+        if ((offset < 0) || (offset >= int64_t(_mmaplen))) {
+            return;
+        }
+        // madvise requires a page aligned start address
+        size_t pageSize = getpagesize();
+        size_t start = offset & ~(pageSize - 1);
+        size_t end = std::min(static_cast<size_t>(offset) + length, _mmaplen);
+        madvise(static_cast<char *>(_mmapbase) + start, end - start, MADV_WILLNEED);
+    } else if (_filedes >= 0) {
+#ifdef __linux__
+        posix_fadvise(_filedes, offset, length, POSIX_FADV_WILLNEED);
+#endif
+    }
+}
+
 
 bool
 FastOS_UNIX_File::Close(void)
@@ -90,6 +90,9 @@ public:
     bool Sync() override;
     bool SetSize(int64_t newSize) override;
     void dropFromCache() const override;
+    void startWriteBack(int64_t offset, size_t length) const override;
+    void dropFromCache(int64_t offset, size_t length) const override;
+    void prefetch(int64_t offset, size_t length) const override;
 
     static bool Delete(const char *filename);
     static int GetLastOSError() { return errno; }
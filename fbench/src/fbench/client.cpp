@@ -6,6 +6,7 @@
 #include <httpclient/httpclient.h>
 #include <util/filereader.h>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <vespa/vespalib/encoding/base64.h>
@@ -23,6 +24,7 @@ Client::Client(vespalib::CryptoEngine::SP engine, ClientArguments *args)
                            _args->_extraHeaders, _args->_authority)),
       _reader(new FileReader()),
       _output(),
+      _latencyOutput(),
       _linebufsize(args->_maxLineSize),
       _linebuf(new char[_linebufsize]),
       _stop(false),
@@ -155,12 +157,134 @@ int UrlReader::nextContent()
     return (totLen > 0) ? totLen-1 : 0;
 }
 
+namespace {
+
+/**
+ * Decides when requests should be sent when running with a target
+ * rate or when replaying the timestamps of a query log. Requests are
+ * scheduled relative to the start of the run, so a slow response
+ * does not postpone the requests that follow it.
+ **/
+class RequestSchedule {
+    using clock = std::chrono::steady_clock;
+    clock::time_point _start;
+    double            _targetQps;
+    bool              _replay;
+    double            _firstTimestamp;
+    double            _lastTimestamp;
+    size_t            _requests;
+public:
+    RequestSchedule(double targetQps, bool replay)
+        : _start(clock::now()), _targetQps(targetQps), _replay(replay),
+          _firstTimestamp(0.0), _lastTimestamp(0.0), _requests(0)
+    {
+    }
+    bool active() const { return _replay || (_targetQps > 0); }
+    clock::time_point next(double timestamp) {
+        double offset = 0.0;
+        if (_replay) {
+            if (_requests == 0 || timestamp < _lastTimestamp) {
+                // first query, or the query log was restarted
+                std::chrono::duration<double> elapsed = clock::now() - _start;
+                _firstTimestamp = timestamp - elapsed.count();
+            }
+            _lastTimestamp = timestamp;
+            offset = timestamp - _firstTimestamp;
+        } else {
+            offset = _requests / _targetQps;
+        }
+        ++_requests;
+        return _start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(offset));
+    }
+};
+
+/**
+ * Parse and strip the timestamp in front of an url in a timestamped
+ * query log. Returns false if the line does not start with a
+ * timestamp.
+ **/
+bool stripTimestamp(char *line, int &linelen, double &timestamp)
+{
+    char *end = nullptr;
+    timestamp = strtod(line, &end);
+    if (end == line || (*end != '\t' && *end != ' ')) {
+        return false;
+    }
+    while (*end == '\t' || *end == ' ') {
+        ++end;
+    }
+    linelen -= (end - line);
+    memmove(line, end, linelen + 1);
+    return (linelen > 0);
+}
+
+void
+appendJsonString(std::string &dst, const char *str)
+{
+    dst.push_back('"');
+    for (const char *p = str; *p != '\0'; ++p) {
+        unsigned char c = *p;
+        if (c == '"' || c == '\\') {
+            dst.push_back('\\');
+            dst.push_back(c);
+        } else if (c < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            dst.append(buf);
+        } else {
+            dst.push_back(c);
+        }
+    }
+    dst.push_back('"');
+}
+
+void
+appendCsvString(std::string &dst, const char *str)
+{
+    dst.push_back('"');
+    for (const char *p = str; *p != '\0'; ++p) {
+        if (*p == '"') {
+            dst.push_back('"');
+        }
+        dst.push_back(*p);
+    }
+    dst.push_back('"');
+}
+
+}
+
+void
+Client::writeLatencyRecord(size_t urlNumber, double startMs, double delayMs, const char *url, bool ok,
+                           uint32_t requestStatus, int32_t totalHitCount, int32_t resultSize)
+{
+    char buf[256];
+    std::string record;
+    if (_args->_latencyJson) {
+        snprintf(buf, sizeof(buf),
+                 "{\"client\":%d,\"query\":%zu,\"start_ms\":%.3f,\"delay_ms\":%.3f,\"latency_ms\":%.3f,"
+                 "\"ok\":%s,\"http_status\":%u,\"total_hits\":%d,\"bytes\":%d,\"url\":",
+                 _args->_myNum, urlNumber, startMs, delayMs, _reqTimer->GetTimespan(),
+                 ok ? "true" : "false", requestStatus, totalHitCount, resultSize);
+        record.append(buf);
+        appendJsonString(record, url);
+        record.append("}\n");
+    } else {
+        snprintf(buf, sizeof(buf), "%d,%zu,%.3f,%.3f,%.3f,%d,%u,%d,%d,",
+                 _args->_myNum, urlNumber, startMs, delayMs, _reqTimer->GetTimespan(),
+                 ok ? 1 : 0, requestStatus, totalHitCount, resultSize);
+        record.append(buf);
+        appendCsvString(record, url);
+        record.push_back('\n');
+    }
+    _latencyOutput->write(record.data(), record.size());
+}
 
 void
 Client::run()
 {
     char inputFilename[1024];
     char outputFilename[1024];
+    char latencyFilename[1024];
     char timestr[64];
     int  linelen;
     ///   int  reslen;
@@ -187,6 +311,20 @@ Client::run()
     }
     if (_output)
         _output->write(&FBENCH_DELIMITER[1], strlen(FBENCH_DELIMITER) - 1);
+    if (_args->_latencyPattern != NULL) {
+        snprintf(latencyFilename, 1024, _args->_latencyPattern, _args->_myNum);
+        _latencyOutput = std::make_unique<std::ofstream>(latencyFilename, std::ofstream::out);
+        if (_latencyOutput->fail()) {
+            printf("Client %d: ERROR: could not open file '%s' [write mode]\n",
+                   _args->_myNum, latencyFilename);
+            _status->SetError("Could not open latency output file.");
+            return;
+        }
+        if (!_args->_latencyJson) {
+            const char *header = "client,query,start_ms,delay_ms,latency_ms,ok,http_status,total_hits,bytes,url\n";
+            _latencyOutput->write(header, strlen(header));
+        }
+    }
 
     if (_args->_ignoreCount == 0)
         _masterTimer->Start();
@@ -196,6 +334,8 @@ Client::run()
         _reader->SetFilePos(_args->_queryfileOffset);
 
     UrlReader urlSource(*_reader, *_args);
+    RequestSchedule schedule(_args->_targetQps, _args->_replayTimestamps);
+    auto runStart = std::chrono::steady_clock::now();
     size_t urlNumber = 0;
 
     // run queries
@@ -214,7 +354,24 @@ Client::run()
             }
             break;
         }
-        if (linelen < _linebufsize) {
+        double timestamp = 0.0;
+        bool validLine = (linelen < _linebufsize);
+        if (validLine && _args->_replayTimestamps) {
+            validLine = stripTimestamp(_linebuf, linelen, timestamp);
+        }
+        if (validLine) {
+            double delayMs = 0.0;
+            if (schedule.active()) {
+                auto sendTime = schedule.next(timestamp);
+                auto now = std::chrono::steady_clock::now();
+                if (sendTime > now) {
+                    std::this_thread::sleep_until(sendTime);
+                } else {
+                    delayMs = std::chrono::duration<double, std::milli>(now - sendTime).count();
+                    if (delayMs >= 1.0 && _args->_ignoreCount == 0)
+                        _status->OverTime();
+                }
+            }
             if (_output) {
                 _output->write("URL: ", strlen("URL: "));
                 _output->write(_linebuf, linelen);
@@ -233,9 +390,14 @@ Client::run()
                 cLen = base64_decoded.size();
             }
                         
+            double startMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
             _reqTimer->Start();
             auto fetch_status = _http->Fetch(_linebuf, _output.get(), _args->_usePostMode, content, cLen);
             _reqTimer->Stop();
+            if (_latencyOutput && _args->_ignoreCount == 0) {
+                writeLatencyRecord(urlNumber, startMs, delayMs, _linebuf, fetch_status.Ok(), fetch_status.RequestStatus(),
+                                   fetch_status.TotalHitCount(), fetch_status.ResultSize());
+            }
             _status->AddRequestStatus(fetch_status.RequestStatus());
             if (fetch_status.Ok() && fetch_status.TotalHitCount() == 0)
                 ++_status->_zeroHitQueries;
@@ -263,7 +425,9 @@ Client::run()
                 _status->SkippedRequest();
         }
         _cycleTimer->Stop();
-        if (_args->_cycle < 0) {
+        if (schedule.active()) {
+            // requests are paced by the schedule before they are sent
+        } else if (_args->_cycle < 0) {
             std::this_thread::sleep_for(std::chrono::milliseconds(int(_reqTimer->GetTimespan())));
         } else {
             if (_cycleTimer->GetRemaining() > 0) {
@@ -282,6 +446,9 @@ Client::run()
         _status->SetRealTime(_masterTimer->GetCurrent());
     }
     _masterTimer->Stop();
+    if (_latencyOutput) {
+        _latencyOutput->flush();
+    }
     _status->SetRealTime(_masterTimer->GetTimespan());
     _status->SetReuseCount(_http->GetReuseCount());
     printf(".");
@@ -109,6 +109,34 @@ struct ClientArguments
      **/
     bool        _headerBenchmarkdataCoverage;
 
+    /**
+     * Target number of requests per second for this client. Requests
+     * are scheduled at fixed intervals from the start of the run,
+     * independent of response times. Zero or less means no target
+     * rate; the cycle time is used instead.
+     **/
+    double      _targetQps;
+
+    /**
+     * Indicate whether each line in the query file starts with a
+     * timestamp (in seconds, fractions allowed) followed by a tab or
+     * space. Queries are then sent with the same inter-arrival times
+     * as in the original log.
+     **/
+    bool        _replayTimestamps;
+
+    /**
+     * Pattern that combined with the client number will become the name
+     * of the file this client should write per-query latency records
+     * to. If this pattern is set to NULL no records are written.
+     **/
+    const char *_latencyPattern;
+
+    /**
+     * Write latency records as JSON lines instead of CSV.
+     **/
+    bool        _latencyJson;
+
     uint64_t    _queryfileOffset;
     uint64_t    _queryfileEndOffset;
     bool        _singleQueryFile;
@@ -127,7 +155,9 @@ struct ClientArguments
                     bool headerBenchmarkdataCoverage,
                     uint64_t queryfileOffset, uint64_t queryfileEndOffset, bool singleQueryFile,
                     const std::string & queryStringToAppend, const std::string & extraHeaders,
-                    const std::string &authority, bool postMode)
+                    const std::string &authority, bool postMode,
+                    double targetQps, bool replayTimestamps,
+                    const char *latencyPattern, bool latencyJson)
         : _myNum(myNum),
           _totNum(totNum),
           _filenamePattern(filenamePattern),
@@ -144,6 +174,10 @@ struct ClientArguments
           _base64Decode(base64Decode),
           _usePostMode(postMode),
           _headerBenchmarkdataCoverage(headerBenchmarkdataCoverage),
+          _targetQps(targetQps),
+          _replayTimestamps(replayTimestamps),
+          _latencyPattern(latencyPattern),
+          _latencyJson(latencyJson),
           _queryfileOffset(queryfileOffset),
           _queryfileEndOffset(queryfileEndOffset),
           _singleQueryFile(singleQueryFile),
@@ -180,6 +214,7 @@ private:
     std::unique_ptr<HTTPClient>      _http;
     std::unique_ptr<FileReader>      _reader;
     std::unique_ptr<std::ofstream>   _output;
+    std::unique_ptr<std::ofstream>   _latencyOutput;
     int                              _linebufsize;
     char                            *_linebuf;
     std::atomic<bool>                _stop;
@@ -190,6 +225,8 @@ private:
     Client &operator=(const Client &);
     static void runMe(Client * client);
     void run();
+    void writeLatencyRecord(size_t urlNumber, double startMs, double delayMs, const char *url, bool ok,
+                            uint32_t requestStatus, int32_t totalHitCount, int32_t resultSize);
 
 public:
     typedef std::unique_ptr<Client> UP;
@@ -50,7 +50,11 @@ FBench::FBench()
       _usePostMode(false),
       _headerBenchmarkdataCoverage(false),
       _seconds(60),
-      _singleQueryFile(false)
+      _singleQueryFile(false),
+      _targetQps(0),
+      _replayTimestamps(false),
+      _latencyPattern(NULL),
+      _latencyJson(false)
 {
 }
 
@@ -59,6 +63,7 @@ FBench::~FBench()
     _clients.clear();
     free(_filenamePattern);
     free(_outputPattern);
+    free(_latencyPattern);
 }
 
 bool
@@ -114,7 +119,9 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
                       bool keepAlive, bool base64Decode,
                       bool headerBenchmarkdataCoverage, int seconds,
                       bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                      const std::string &authority, bool postMode)
+                      const std::string &authority, bool postMode,
+                      double targetQps, bool replayTimestamps,
+                      const char *latencyPattern, bool latencyJson)
 {
     _clients.resize(numClients);
     _ignoreCount     = ignoreCount;
@@ -137,6 +144,12 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
     _headerBenchmarkdataCoverage = headerBenchmarkdataCoverage;
     _seconds = seconds;
     _singleQueryFile = singleQueryFile;
+    _targetQps       = targetQps;
+    _replayTimestamps = replayTimestamps;
+    free(_latencyPattern);
+    _latencyPattern  = (latencyPattern == NULL) ?
+                       NULL : strdup(latencyPattern);
+    _latencyJson     = latencyJson;
 }
 
 void
@@ -161,7 +174,8 @@ FBench::CreateClients()
                                 _keepAlive, _base64Decode,
                                 _headerBenchmarkdataCoverage,
                                 off_beg, off_end,
-                                _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode));
+                                _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode,
+                                _targetQps, _replayTimestamps, _latencyPattern, _latencyJson));
         ++i;
     }
 }
@@ -257,7 +271,13 @@ FBench::PrintSummary()
     printf("***************** Benchmark Summary *****************\n");
     printf("clients:                %8ld\n", _clients.size());
     printf("ran for:                %8d seconds\n", _seconds);
-    printf("cycle time:             %8d ms\n", _cycle);
+    if (_replayTimestamps) {
+        printf("cycle time:             replaying query log timestamps\n");
+    } else if (_targetQps > 0) {
+        printf("target query rate:      %8.2f Q/s per client\n", _targetQps);
+    } else {
+        printf("cycle time:             %8d ms\n", _cycle);
+    }
     printf("lower response limit:   %8d bytes\n", _byteLimit);
     printf("skipped requests:       %8ld\n", status._skipCnt);
     printf("failed requests:        %8ld\n", status._failCnt);
@@ -289,7 +309,8 @@ FBench::Usage()
 {
     printf("usage: vespa-fbench [-H extraHeader] [-a queryStringToAppend ] [-n numClients] [-c cycleTime] [-l limit] [-i ignoreCount]\n");
     printf("              [-s seconds] [-q queryFilePattern] [-o outputFilePattern]\n");
-    printf("              [-r restartLimit] [-m maxLineSize] [-k] <hostname> <port>\n\n");
+    printf("              [-r restartLimit] [-m maxLineSize] [-k] [-Q targetQps] [-t]\n");
+    printf("              [-L latencyFilePattern] [-j] <hostname> <port>\n\n");
     printf(" -H <str> : append extra header to each get request.\n");
     printf(" -A <str> : assign autority.  <str> should be hostname:port format. Overrides Host: header sent.\n");
     printf(" -P       : use POST for requests instead of GET.\n");
@@ -308,6 +329,14 @@ FBench::Usage()
     printf(" -m <num> : max line size in input query files [131072].\n");
     printf("            Can not be less than the minimum [1024].\n");
     printf(" -p <num> : print summary every <num> seconds.\n");
+    printf(" -Q <num> : each client will send <num> requests per second, independent\n");
+    printf("            of response times. Overrides the cycle time.\n");
+    printf(" -t       : each line in the query files starts with a timestamp in seconds,\n");
+    printf("            followed by a tab or space. Requests are sent with the same\n");
+    printf("            inter-arrival times as in the query log. Not supported with -P.\n");
+    printf(" -L <str> : write a record with latency, size and status for each request\n");
+    printf("            to files with the given pattern, as CSV (default is not saving.)\n");
+    printf(" -j       : write the latency records as JSON lines instead of CSV.\n");
     printf(" -k       : disable HTTP keep-alive.\n");
     printf(" -d       : Base64 decode POST request content.\n");
     printf(" -y       : write data on coverage to output file.\n");
@@ -345,6 +374,7 @@ FBench::Main(int argc, char *argv[])
 
     const char *queryFilePattern  = "query%03d.txt";
     const char *outputFilePattern = NULL;
+    const char *latencyFilePattern = NULL;
     std::string queryStringToAppend;
     std::string extraHeaders;
     std::string ca_certs_file_name; // -T
@@ -357,6 +387,9 @@ FBench::Main(int argc, char *argv[])
     bool base64Decode = false;
     bool headerBenchmarkdataCoverage = false;
     bool usePostMode = false;
+    double targetQps = 0;
+    bool replayTimestamps = false;
+    bool latencyJson = false;
 
     bool singleQueryFile = false;
     std::string authority;
@@ -371,7 +404,7 @@ FBench::Main(int argc, char *argv[])
 
     idx = 1;
     optError = false;
-    while((opt = GetOpt(argc, argv, "H:A:T:C:K:Da:n:c:l:i:s:q:o:r:m:p:kdxyzP", arg, idx)) != -1) {
+    while((opt = GetOpt(argc, argv, "H:A:T:C:K:Da:n:c:l:i:s:q:o:r:m:p:kdxyzPQ:tL:j", arg, idx)) != -1) {
         switch(opt) {
         case 'A':
             authority = arg;
@@ -431,6 +464,20 @@ FBench::Main(int argc, char *argv[])
         case 'P':
             usePostMode = true;
             break;
+        case 'Q':
+            targetQps = atof(arg);
+            if (targetQps <= 0)
+                optError = true;
+            break;
+        case 't':
+            replayTimestamps = true;
+            break;
+        case 'L':
+            latencyFilePattern = arg;
+            break;
+        case 'j':
+            latencyJson = true;
+            break;
         case 'p':
             printInterval = atoi(arg);
             if (printInterval < 0)
@@ -462,6 +509,10 @@ FBench::Main(int argc, char *argv[])
         Usage();
         return -1;
     }
+    if (replayTimestamps && usePostMode) {
+        fprintf(stderr, "Replaying query log timestamps is not supported with POST requests\n");
+        return -1;
+    }
     // Hostname/port must be in pair
     int args = (argc - idx);
     if (args % 2 != 0) {
@@ -532,7 +583,9 @@ FBench::Main(int argc, char *argv[])
                   keepAlive, base64Decode,
                   headerBenchmarkdataCoverage, seconds,
                   singleQueryFile, queryStringToAppend, extraHeaders,
-                  authority, usePostMode);
+                  authority, usePostMode,
+                  targetQps, replayTimestamps,
+                  latencyFilePattern, latencyJson);
 
     CreateClients();
     StartClients();
@@ -33,6 +33,10 @@ private:
     std::string         _queryStringToAppend;
     std::string         _extraHeaders;
     std::string         _authority;
+    double              _targetQps;
+    bool                _replayTimestamps;
+    char               *_latencyPattern;
+    bool                _latencyJson;
 
     bool init_crypto_engine(const std::string &ca_certs_file_name,
                             const std::string &cert_chain_file_name,
@@ -45,7 +49,9 @@ private:
                        bool keepAlive, bool base64Decode,
                        bool headerBenchmarkdataCoverage, int seconds,
                        bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                       const std::string &authority, bool postMode);
+                       const std::string &authority, bool postMode,
+                       double targetQps, bool replayTimestamps,
+                       const char *latencyPattern, bool latencyJson);
 
     void CreateClients();
     void StartClients();
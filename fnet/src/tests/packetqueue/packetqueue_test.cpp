@@ -0,0 +1,70 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/fnet/packetqueue.h>
+#include <vespa/fnet/packet.h>
+#include <vespa/fnet/context.h>
+#include <string>
+
+class MyPacket : public FNET_Packet
+{
+private:
+    uint32_t _id;
+    uint32_t _len;
+public:
+    MyPacket(uint32_t id, uint32_t len) : _id(id), _len(len) {}
+    uint32_t id() const { return _id; }
+    uint32_t GetPCODE() override { return 0; }
+    uint32_t GetLength() override { return _len; }
+    void Encode(FNET_DataBuffer *) override {}
+    bool Decode(FNET_DataBuffer *, uint32_t) override { return true; }
+};
+
+std::string drain(FNET_PacketQueue_NoLock &queue) {
+    std::string ids;
+    FNET_Context context;
+    while (!queue.IsEmpty_NoLock()) {
+        FNET_Packet *packet = queue.DequeuePacket_NoLock(&context);
+        ids += ids.empty() ? "" : " ";
+        ids += std::to_string(static_cast<MyPacket *>(packet)->id());
+        packet->Free();
+    }
+    return ids;
+}
+
+TEST("require that small packets overtake large packets on other channels") {
+    FNET_PacketQueue_NoLock queue(4);
+    queue.QueuePacket_NoLock(new MyPacket(0, 10), FNET_Context(1u));
+    queue.QueuePacket_NoLock(new MyPacket(1, 1000), FNET_Context(2u));
+    queue.QueuePacket_NoLock(new MyPacket(2, 10), FNET_Context(3u));
+    queue.QueuePacket_NoLock(new MyPacket(3, 10), FNET_Context(2u));
+    queue.QueuePacket_NoLock(new MyPacket(4, 2000), FNET_Context(4u));
+    queue.QueuePacket_NoLock(new MyPacket(5, 10), FNET_Context(5u));
+    queue.PrioritizeSmallPackets_NoLock(100);
+    EXPECT_EQUAL("0 2 5 1 3 4", drain(queue));
+}
+
+TEST("require that reordering handles a wrapped queue") {
+    FNET_PacketQueue_NoLock queue(4);
+    FNET_Context context;
+    queue.QueuePacket_NoLock(new MyPacket(0, 10), FNET_Context(1u));
+    queue.QueuePacket_NoLock(new MyPacket(1, 10), FNET_Context(1u));
+    queue.DequeuePacket_NoLock(&context)->Free();
+    queue.DequeuePacket_NoLock(&context)->Free();
+    queue.QueuePacket_NoLock(new MyPacket(2, 1000), FNET_Context(1u));
+    queue.QueuePacket_NoLock(new MyPacket(3, 1000), FNET_Context(2u));
+    queue.QueuePacket_NoLock(new MyPacket(4, 10), FNET_Context(3u));
+    queue.QueuePacket_NoLock(new MyPacket(5, 10), FNET_Context(1u));
+    queue.PrioritizeSmallPackets_NoLock(100);
+    EXPECT_EQUAL("4 2 3 5", drain(queue));
+}
+
+TEST("require that order is kept when all packets are small") {
+    FNET_PacketQueue_NoLock queue;
+    for (uint32_t i = 0; i < 5; ++i) {
+        queue.QueuePacket_NoLock(new MyPacket(i, 10), FNET_Context(i % 2));
+    }
+    queue.PrioritizeSmallPackets_NoLock(100);
+    EXPECT_EQUAL("0 1 2 3 4", drain(queue));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
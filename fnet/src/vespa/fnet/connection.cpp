@@ -256,7 +256,7 @@ FNET_Connection::handshake()
         size_t chunk_size = std::max(size_t(FNET_READ_SIZE), _socket->min_read_buffer_size());
         ssize_t res = 0;
         do { // drain input pipeline
-            _input.EnsureFree(chunk_size);
+            _input.EnsureFree(read_size(chunk_size));
             res = _socket->drain(_input.GetFree(), _input.GetFreeLen());
             if (res > 0) {
                 _input.FreeToData((uint32_t)res);
@@ -303,6 +303,16 @@ FNET_Connection::handle_packets()
     return !broken;
 }
 
+size_t
+FNET_Connection::read_size(size_t chunk_size) const
+{
+    if (_flags._gotheader && (_input.GetDataLen() < _packetLength)) {
+        size_t missing = std::min(size_t(_packetLength - _input.GetDataLen()), size_t(FNET_READ_AHEAD));
+        return std::max(chunk_size, missing);
+    }
+    return chunk_size;
+}
+
 bool
 FNET_Connection::Read()
 {
@@ -312,7 +322,7 @@ FNET_Connection::Read()
     int      my_errno    = 0;     // sample and preserve errno
     ssize_t  res;                 // single read result
 
-    _input.EnsureFree(chunk_size);
+    _input.EnsureFree(read_size(chunk_size));
     res = _socket->read(_input.GetFree(), _input.GetFreeLen());
     my_errno = errno;
     readCnt++;
@@ -324,7 +334,7 @@ FNET_Connection::Read()
         if (broken || ((_input.GetFreeLen() > 0) && !_flags._framed) || (readCnt >= FNET_READ_REDO)) {
             goto done_read;
         }
-        _input.EnsureFree(chunk_size);
+        _input.EnsureFree(read_size(chunk_size));
         res = _socket->read(_input.GetFree(), _input.GetFreeLen());
         my_errno = errno;
         readCnt++;
@@ -333,7 +343,7 @@ FNET_Connection::Read()
 done_read:
 
     while ((res > 0) && !broken) { // drain input pipeline
-        _input.EnsureFree(chunk_size);
+        _input.EnsureFree(read_size(chunk_size));
         res = _socket->drain(_input.GetFree(), _input.GetFreeLen());
         my_errno = errno;
         if (res > 0) {
@@ -453,8 +463,7 @@ FNET_Connection::Write()
     bool writePending = (_writeWork > 0);
 
     guard.unlock();
-    if (!writePending)
-        EnableWriteEvent(false);
+    EnableWriteEvent(writePending);
 
     return !broken;
 }
@@ -785,8 +794,16 @@ FNET_Connection::HandleWriteEvent()
         break;
     case FNET_CONNECTED:
         {
-            std::unique_lock<std::mutex> guard(_ioc_lock);
-            _queue.FlushPackets_NoLock(&_myQueue);
+            bool newBatch = _myQueue.IsEmpty_NoLock();
+            {
+                std::unique_lock<std::mutex> guard(_ioc_lock);
+                _queue.FlushPackets_NoLock(&_myQueue);
+            }
+            if (newBatch) {
+                // let small packets overtake large ones on other channels;
+                // only fresh batches are reordered to avoid starvation
+                _myQueue.PrioritizeSmallPackets_NoLock(FNET_WRITE_SIZE);
+            }
         }
         broken = !Write();
         break;
@@ -62,7 +62,8 @@ public:
         FNET_READ_SIZE  = 32768,
         FNET_READ_REDO  = 10,
         FNET_WRITE_SIZE = 32768,
-        FNET_WRITE_REDO = 10
+        FNET_WRITE_REDO = 10,
+        FNET_READ_AHEAD = 0x1000000
     };
 
 private:
@@ -220,6 +221,18 @@ private:
      **/
     bool handle_packets();
 
+    /**
+     * Calculate how much free space to make in the input buffer
+     * before the next read. When the header of a partially received
+     * packet is known, room is made for the rest of it (limited by
+     * FNET_READ_AHEAD) so that large packets are read into place
+     * instead of being moved each time the buffer grows.
+     *
+     * @return number of bytes of free space wanted
+     * @param chunk_size minimum read size
+     **/
+    size_t read_size(size_t chunk_size) const;
+
     /**
      * Read incoming data from socket.
      *
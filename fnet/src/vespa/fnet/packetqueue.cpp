@@ -2,7 +2,9 @@
 
 #include "packetqueue.h"
 #include "packet.h"
+#include <algorithm>
 #include <cassert>
+#include <vector>
 #include <chrono>
 
 void
@@ -126,6 +128,50 @@ FNET_PacketQueue_NoLock::FlushPackets_NoLock(FNET_PacketQueue_NoLock *target)
 }
 
 
+void
+FNET_PacketQueue_NoLock::PrioritizeSmallPackets_NoLock(uint32_t maxSmallLen)
+{
+    auto isLarge = [maxSmallLen](FNET_Packet *packet) {
+        return (packet->IsRegularPacket() && packet->GetLength() > maxSmallLen);
+    };
+    uint32_t skip = 0;       // packets already in place
+    uint32_t pos = _out_pos;
+    for (; skip < _bufused && !isLarge(_buf[pos]._packet); ++skip) {
+        if (++pos == _bufsize)
+            pos = 0;                     // wrap around.
+    }
+    if (skip + 1 >= _bufused) {
+        return;
+    }
+    std::vector<_QElem> small;
+    std::vector<_QElem> large;
+    std::vector<uint32_t> blocked; // channels with a large packet so far
+    for (uint32_t i = skip, readPos = pos; i < _bufused; ++i) {
+        const _QElem &elem = _buf[readPos];
+        uint32_t chid = elem._context._value.INT;
+        bool isBlocked = (std::find(blocked.begin(), blocked.end(), chid) != blocked.end());
+        if (isBlocked || (i == skip) || isLarge(elem._packet)) {
+            if (!isBlocked) {
+                blocked.push_back(chid);
+            }
+            large.push_back(elem);
+        } else {
+            small.push_back(elem);
+        }
+        if (++readPos == _bufsize)
+            readPos = 0;                 // wrap around.
+    }
+    for (const auto *list : {&small, &large}) {
+        for (const _QElem &elem : *list) {
+            _buf[pos] = elem;
+            if (++pos == _bufsize)
+                pos = 0;                 // wrap around.
+        }
+    }
+    assert(pos == _in_pos);
+}
+
+
 void
 FNET_PacketQueue_NoLock::DiscardPackets_NoLock()
 {
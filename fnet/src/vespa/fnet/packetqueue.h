@@ -134,6 +134,19 @@ public:
     uint32_t FlushPackets_NoLock(FNET_PacketQueue_NoLock *target);
 
 
+    /**
+     * Reorder the packets in this queue so that packets no larger
+     * than the given length are placed before larger ones. Packets
+     * belonging to the same channel (context integer value) keep
+     * their relative order; a packet following a large packet on its
+     * channel is treated as large itself. This lets small packets on
+     * other channels overtake a large one that is not yet encoded.
+     *
+     * @param maxSmallLen largest packet length considered small.
+     **/
+    void PrioritizeSmallPackets_NoLock(uint32_t maxSmallLen);
+
+
     /**
      * This method is called by the destructor to discard (invoke Free
      * on) all packets in this packet queue. This method is also called
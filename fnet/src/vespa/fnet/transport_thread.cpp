@@ -424,7 +424,7 @@ FNET_TransportThread::handle_wakeup()
             handle_add_cmd(context._value.IOC);
             break;
         case FNET_ControlPacket::FNET_CMD_IOC_ENABLE_WRITE:
-            context._value.IOC->EnableWriteEvent(true);
+            // Write directly; the write event is only enabled if the socket could not take all data
             if (context._value.IOC->HandleWriteEvent()) {
                 context._value.IOC->SubRef();
             } else {
@@ -0,0 +1,85 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+#include <vespa/juniper/tokencache.h>
+#include <vespa/juniper/rpinterface.h>
+#include <vespa/juniper/queryhandle.h>
+#include <vespa/juniper/queryparser.h>
+#include <vespa/juniper/config.h>
+#include <vespa/fastlib/text/normwordfolder.h>
+#include <map>
+#include <random>
+
+using namespace juniper;
+using vespalib::BenchmarkTimer;
+
+const double budget = 2.0;
+
+struct Props : public IJuniperProperties {
+    std::map<std::string, std::string> map;
+    const char *GetProperty(const char *name, const char *def) override {
+        auto pos = map.find(name);
+        return (pos != map.end()) ? pos->second.c_str() : def;
+    }
+};
+
+std::vector<std::string> make_docs(size_t num_docs, size_t num_words) {
+    std::vector<std::string> words;
+    for (size_t i = 0; i < 500; ++i) {
+        words.push_back("word" + std::to_string(i));
+    }
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> pick(0, words.size() - 1);
+    std::vector<std::string> docs;
+    for (size_t i = 0; i < num_docs; ++i) {
+        std::string doc;
+        for (size_t j = 0; j < num_words; ++j) {
+            doc += words[pick(gen)];
+            doc += ((j % 12) == 11) ? ". " : " ";
+        }
+        docs.push_back(doc);
+    }
+    return docs;
+}
+
+double benchmark(const char *name, Props &props, const std::vector<std::string> &docs) {
+    Fast_NormalizeWordFolder wordfolder;
+    Juniper juniper(&props, &wordfolder);
+    auto config = juniper.CreateConfig();
+    std::vector<std::string> queries = {"AND(word1,word2)", "word17", "OR(word100,word200,word300)", "word499"};
+    size_t bytes = 0;
+    auto fun = [&]() {
+        for (const auto &query: queries) {
+            QueryParser parser(query.c_str());
+            QueryHandle handle(parser, nullptr, juniper.getModifier());
+            for (const auto &doc: docs) {
+                Result *result = Analyse(config.get(), &handle, doc.data(), doc.size(), 0, 0, 0);
+                Summary *summary = GetTeaser(result, nullptr);
+                bytes += summary->Length();
+                ReleaseResult(result);
+            }
+        }
+    };
+    double seconds = BenchmarkTimer::benchmark(fun, budget);
+    size_t teasers = queries.size() * docs.size();
+    fprintf(stderr, "%-10s docs=%4zu size=%7zu: %10.3f us/teaser\n", name, docs.size(), docs[0].size(),
+            (seconds * 1000000.0) / teasers);
+    EXPECT_GREATER(bytes, 0u);
+    return seconds;
+}
+
+TEST("benchmark teaser generation with and without token cache") {
+    for (size_t num_words: {100, 1000, 10000}) {
+        auto docs = make_docs(100, num_words);
+        Props plain;
+        Props cached;
+        cached.map["juniper.tokenizer.cache_size"] = "268435456";
+        cached.map["juniper.tokenizer.cache_min_length"] = "0";
+        double plain_time = benchmark("plain", plain, docs);
+        double cached_time = benchmark("cached", cached, docs);
+        fprintf(stderr, "speedup: %g\n", plain_time / cached_time);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
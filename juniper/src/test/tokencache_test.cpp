@@ -0,0 +1,139 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+
+#include <vespa/juniper/tokencache.h>
+#include <vespa/juniper/rpinterface.h>
+#include <vespa/juniper/queryhandle.h>
+#include <vespa/juniper/queryparser.h>
+#include <vespa/juniper/queryvisitor.h>
+#include <vespa/juniper/config.h>
+#include <vespa/juniper/result.h>
+#include <vespa/fastlib/text/normwordfolder.h>
+#include <map>
+
+using namespace juniper;
+
+struct Props : public IJuniperProperties {
+    std::map<std::string, std::string> map;
+    Props &set(const char *name, const char *value) {
+        map[name] = value;
+        return *this;
+    }
+    const char *GetProperty(const char *name, const char *def) override {
+        auto pos = map.find(name);
+        return (pos != map.end()) ? pos->second.c_str() : def;
+    }
+};
+
+struct Collector : public ITokenProcessor {
+    std::vector<std::string> tokens;
+    off_t end = -1;
+    void handle_token(Token &token) override {
+        std::string str;
+        for (int i = 0; i < token.curlen; ++i) {
+            str.push_back(char(token.token[i]));
+        }
+        str += ":" + std::to_string(token.wordpos) + ":" + std::to_string(token.bytepos) + ":" + std::to_string(token.bytelen);
+        tokens.push_back(str);
+    }
+    void handle_end(Token &token) override { end = token.bytepos; }
+};
+
+TokenizedText::SP make_text(const std::string &text) {
+    auto result = std::make_shared<TokenizedText>(text.data(), text.size());
+    ucs4_t chars[16];
+    ITokenProcessor::Token token;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find(' ', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        for (size_t i = start; i < end; ++i) {
+            chars[i - start] = text[i];
+        }
+        token.token = chars;
+        token.curlen = end - start;
+        token.bytepos = start;
+        token.bytelen = end - start;
+        result->add(token);
+        start = end + 1;
+    }
+    return result;
+}
+
+TEST("require that tokenized text can be replayed") {
+    auto text = make_text("foo bar baz");
+    EXPECT_EQUAL(3u, text->num_tokens());
+    Collector collector;
+    text->replay(collector);
+    ASSERT_EQUAL(3u, collector.tokens.size());
+    EXPECT_EQUAL("foo:0:0:3", collector.tokens[0]);
+    EXPECT_EQUAL("bar:1:4:3", collector.tokens[1]);
+    EXPECT_EQUAL("baz:2:8:3", collector.tokens[2]);
+    EXPECT_EQUAL(11, collector.end);
+}
+
+TEST("require that token cache finds inserted texts") {
+    TokenCache cache(1000000, 0);
+    std::string text("foo bar baz");
+    EXPECT_FALSE(cache.lookup(text.data(), text.size()));
+    cache.insert(make_text(text));
+    auto found = cache.lookup(text.data(), text.size());
+    ASSERT_TRUE(found);
+    EXPECT_EQUAL(text, found->text());
+    std::string other("foo bar");
+    EXPECT_FALSE(cache.lookup(other.data(), other.size()));
+    EXPECT_EQUAL(1u, cache.size());
+    EXPECT_EQUAL(1u, cache.hits());
+    EXPECT_EQUAL(2u, cache.misses());
+}
+
+TEST("require that token cache evicts least recently used texts") {
+    size_t entry_size = make_text("text 0")->memory_usage();
+    TokenCache cache(entry_size * 2, 0);
+    cache.insert(make_text("text 0"));
+    cache.insert(make_text("text 1"));
+    EXPECT_TRUE(cache.lookup("text 0", 6));
+    cache.insert(make_text("text 2"));
+    EXPECT_EQUAL(2u, cache.size());
+    EXPECT_TRUE(cache.lookup("text 0", 6));
+    EXPECT_FALSE(cache.lookup("text 1", 6));
+    EXPECT_TRUE(cache.lookup("text 2", 6));
+    EXPECT_LESS_EQUAL(cache.memory_usage(), entry_size * 2);
+}
+
+std::string teaser(Juniper &juniper, Config &config, const char *query, const std::string &content) {
+    QueryParser parser(query);
+    QueryHandle handle(parser, nullptr, juniper.getModifier());
+    Result *result = Analyse(&config, &handle, content.data(), content.size(), 0, 0, 0);
+    Summary *summary = GetTeaser(result, nullptr);
+    std::string text(summary->Text(), summary->Length());
+    ReleaseResult(result);
+    return text;
+}
+
+TEST("require that teasers are the same with and without token cache") {
+    std::string content;
+    for (size_t i = 0; i < 50; ++i) {
+        content += "the monkey consumes bananas and sleeps in the tree afterwards. ";
+    }
+    Fast_NormalizeWordFolder wordfolder;
+    Props plain_props;
+    Juniper plain(&plain_props, &wordfolder);
+    auto plain_config = plain.CreateConfig();
+    EXPECT_TRUE(plain.getTokenCache() == nullptr);
+    Props cached_props;
+    cached_props.set("juniper.tokenizer.cache_size", "1000000");
+    Juniper cached(&cached_props, &wordfolder);
+    auto cached_config = cached.CreateConfig();
+    ASSERT_TRUE(cached.getTokenCache() != nullptr);
+    for (const char *query : {"AND(monkey,tree)", "bananas", "OR(sleeps,consumes)"}) {
+        std::string expect = teaser(plain, *plain_config, query, content);
+        EXPECT_EQUAL(expect, teaser(cached, *cached_config, query, content));
+    }
+    EXPECT_EQUAL(1u, cached.getTokenCache()->size());
+    EXPECT_EQUAL(2u, cached.getTokenCache()->hits());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -56,7 +56,8 @@ Config::Config(const char* config_name, Juniper & juniper) :
         .SetMatchWindowSize(match_winsize)
         .SetMaxMatchCandidates(max_match_candidates)
         .SetWordFolder(& _juniper.getWordFolder())
-        .SetProximityFactor(proximity_factor);
+        .SetProximityFactor(proximity_factor)
+        .SetTokenCache(_juniper.getTokenCache());
 }
 
 Config::~Config()
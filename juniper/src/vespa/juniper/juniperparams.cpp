@@ -78,7 +78,8 @@ MatcherParams::MatcherParams() :
     _max_match_candidates(1000),
     _want_global_rank(false),
     _stem_min(0), _stem_extend(0),
-    _wordfolder(NULL), _proximity_factor(1.0)
+    _wordfolder(NULL), _proximity_factor(1.0),
+    _token_cache(NULL)
 { }
 
 
@@ -160,6 +161,15 @@ MatcherParams& MatcherParams::SetProximityFactor(double factor)
 double MatcherParams::ProximityFactor() { return _proximity_factor; }
 
 
+MatcherParams& MatcherParams::SetTokenCache(juniper::TokenCache* token_cache)
+{
+    _token_cache = token_cache;
+    return *this;
+}
+
+juniper::TokenCache* MatcherParams::TokenCache() { return _token_cache; }
+
+
 bool operator==(MatcherParams& mp1, MatcherParams& mp2)
 {
     return memcmp(&mp1, &mp2, sizeof(MatcherParams)) == 0;
@@ -4,6 +4,8 @@
 #include <string>
 #include <vespa/fastlib/text/wordfolder.h>
 
+namespace juniper { class TokenCache; }
+
 class SummaryConfig;
 
 class DocsumParams
@@ -83,6 +85,9 @@ public:
     MatcherParams& SetProximityFactor(double factor);
     double ProximityFactor();
 
+    MatcherParams& SetTokenCache(juniper::TokenCache* token_cache);
+    juniper::TokenCache* TokenCache();
+
 private:
     size_t _prefix_extend_length;
     size_t _prefix_min_length;
@@ -94,6 +99,7 @@ private:
     size_t _stem_extend;
     Fast_WordFolder* _wordfolder; // The wordfolder object needed as 1st parameter to folderfun
     double _proximity_factor;
+    juniper::TokenCache* _token_cache; // Cache of tokenized texts, NULL if disabled
 
     MatcherParams(MatcherParams &);
     MatcherParams &operator=(MatcherParams &);
@@ -8,6 +8,7 @@
 #include "Matcher.h"
 #include "config.h"
 #include "appender.h"
+#include "tokencache.h"
 
 #include <vespa/log/log.h>
 LOG_SETUP(".juniper.result");
@@ -102,6 +103,31 @@ Result::~Result()
 }
 
 
+void Result::DoScan()
+{
+    TokenCache* cache = _config->_matcherparams.TokenCache();
+    // Special tokens depend on the query, so such texts are always tokenized
+    bool use_cache = (cache != NULL) && cache->want(_docsum_len) && _registry->getSpecialTokens().empty();
+    if (use_cache) {
+        TokenizedText::SP cached = cache->lookup(_docsum, _docsum_len);
+        if (cached) {
+            cached->replay(*_matcher);
+            return;
+        }
+        auto tokenized = std::make_shared<TokenizedText>(_docsum, _docsum_len);
+        TokenRecorder recorder(*tokenized, *_matcher);
+        _tokenizer->SetSuccessor(&recorder);
+        _tokenizer->SetText(_docsum, _docsum_len);
+        _tokenizer->scan();
+        _tokenizer->SetSuccessor(_matcher.get());
+        cache->insert(std::move(tokenized));
+        return;
+    }
+    _tokenizer->SetText(_docsum, _docsum_len);
+    _tokenizer->scan();
+}
+
+
 long Result::GetRelevancy()
 {
     if (!_mo) return PROXIMITYBOOST_NOCONSTRAINT_OFFSET;
@@ -22,8 +22,7 @@ public:
     {
         if (!_scan_done)
         {
-            _tokenizer->SetText(_docsum, _docsum_len);
-            _tokenizer->scan();
+            DoScan();
             _scan_done = true;
         }
     }
@@ -47,6 +46,8 @@ public:
     std::unique_ptr<SpecialTokenRegistry> _registry;
     std::unique_ptr<JuniperTokenizer> _tokenizer;
 private:
+    void DoScan();
+
     std::vector<Summary*> _summaries; // Active summaries for this result
     bool _scan_done;  // State of the result - is text scan done?
 
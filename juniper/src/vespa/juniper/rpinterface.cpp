@@ -8,6 +8,7 @@
 #include "propreader.h"
 #include "result.h"
 #include "config.h"
+#include "tokencache.h"
 #include <vector>
 #include <cassert>
 
@@ -49,7 +50,8 @@ void SetDebug(unsigned int mask)
 Juniper::Juniper(IJuniperProperties* props, Fast_WordFolder* wordfolder, int api_version) :
     _props(props),
     _wordfolder(wordfolder),
-    _modifier(new QueryModifier())
+    _modifier(new QueryModifier()),
+    _token_cache()
 {
     if (api_version != JUNIPER_RP_ABI_VERSION)
     {
@@ -68,6 +70,13 @@ Juniper::Juniper(IJuniperProperties* props, Fast_WordFolder* wordfolder, int api
     unsigned int debug_mask = strtol(_props->GetProperty("juniper.debug_mask", "0"), NULL, 0);
     if (debug_mask) SetDebug(debug_mask);
 
+    // Keep tokenized texts for reuse when the same text is analysed again
+    size_t token_cache_size = strtoul(_props->GetProperty("juniper.tokenizer.cache_size", "0"), NULL, 0);
+    if (token_cache_size > 0) {
+        size_t min_length = strtoul(_props->GetProperty("juniper.tokenizer.cache_min_length", "1024"), NULL, 0);
+        _token_cache.reset(new TokenCache(token_cache_size, min_length));
+    }
+
 }
 
 Juniper::~Juniper()
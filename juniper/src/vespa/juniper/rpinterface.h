@@ -58,6 +58,7 @@ class QueryHandle;
 class Result;
 
 class QueryModifier;
+class TokenCache;
 
 class Summary
 {
@@ -99,6 +100,8 @@ public:
     Fast_WordFolder & getWordFolder() { return *_wordfolder; }
     IJuniperProperties & getProp() { return *_props; }
     QueryModifier & getModifier() { return *_modifier; }
+    /** The cache of tokenized texts shared by all configs, NULL if disabled */
+    TokenCache * getTokenCache() { return _token_cache.get(); }
 
     /** Create a result processing configuration of Juniper for subsequent use
      * @param config_name a symbolic prefix to be used in the fsearch configuration file
@@ -139,6 +142,7 @@ private:
     IJuniperProperties * _props;
     Fast_WordFolder    * _wordfolder;
     std::unique_ptr<QueryModifier>      _modifier;
+    std::unique_ptr<TokenCache>         _token_cache;
 };
 
 /** This function defines an equality relation over Juniper configs,
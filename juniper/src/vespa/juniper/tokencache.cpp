@@ -0,0 +1,169 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "tokencache.h"
+#include <cstring>
+#include <string_view>
+
+namespace juniper {
+
+TokenizedText::TokenizedText(const char *text, size_t len)
+    : _text(text, len),
+      _chars(),
+      _tokens()
+{
+}
+
+TokenizedText::~TokenizedText() = default;
+
+size_t
+TokenizedText::memory_usage() const
+{
+    return sizeof(TokenizedText) + _text.capacity() +
+        _chars.capacity() * sizeof(ucs4_t) + _tokens.capacity() * sizeof(Entry);
+}
+
+void
+TokenizedText::add(const ITokenProcessor::Token &token)
+{
+    _tokens.push_back(Entry{uint32_t(_chars.size()), token.curlen, token.bytepos, token.bytelen});
+    _chars.insert(_chars.end(), token.token, token.token + token.curlen);
+}
+
+void
+TokenizedText::replay(ITokenProcessor &successor) const
+{
+    ITokenProcessor::Token token;
+    off_t wordpos = 0;
+    for (const Entry &entry : _tokens) {
+        token.token = &_chars[entry.offset];
+        token.curlen = entry.curlen;
+        token.wordpos = wordpos++;
+        token.bytepos = entry.bytepos;
+        token.bytelen = entry.bytelen;
+        successor.handle_token(token);
+    }
+    token.bytepos = _text.size();
+    token.bytelen = 0;
+    token.token = nullptr;
+    successor.handle_end(token);
+}
+
+void
+TokenRecorder::handle_token(Token &token)
+{
+    _target.add(token);
+    _successor.handle_token(token);
+}
+
+void
+TokenRecorder::handle_end(Token &token)
+{
+    _successor.handle_end(token);
+}
+
+TokenCache::TokenCache(size_t max_memory, size_t min_text_size)
+    : _lock(),
+      _max_memory(max_memory),
+      _min_text_size(min_text_size),
+      _memory(0),
+      _hits(0),
+      _misses(0),
+      _lru(),
+      _map()
+{
+}
+
+TokenCache::~TokenCache() = default;
+
+size_t
+TokenCache::hash(const char *text, size_t len)
+{
+    return std::hash<std::string_view>()(std::string_view(text, len));
+}
+
+TokenizedText::SP
+TokenCache::lookup(const char *text, size_t len)
+{
+    size_t key = hash(text, len);
+    std::lock_guard<std::mutex> guard(_lock);
+    auto range = _map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        const std::string &cached = (*it->second)->text();
+        if ((cached.size() == len) && (memcmp(cached.data(), text, len) == 0)) {
+            _lru.splice(_lru.begin(), _lru, it->second);
+            ++_hits;
+            return *it->second;
+        }
+    }
+    ++_misses;
+    return TokenizedText::SP();
+}
+
+void
+TokenCache::insert(TokenizedText::SP entry)
+{
+    size_t memory = entry->memory_usage();
+    if (memory > _max_memory) {
+        return;
+    }
+    size_t key = hash(entry->text().data(), entry->text().size());
+    std::lock_guard<std::mutex> guard(_lock);
+    auto range = _map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if ((*it->second)->text() == entry->text()) {
+            return; // inserted by another thread in the meantime
+        }
+    }
+    _lru.push_front(std::move(entry));
+    _map.emplace(key, _lru.begin());
+    _memory += memory;
+    evict();
+}
+
+void
+TokenCache::evict()
+{
+    while (_memory > _max_memory) {
+        const TokenizedText::SP &victim = _lru.back();
+        size_t key = hash(victim->text().data(), victim->text().size());
+        auto range = _map.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (&*it->second == &victim) {
+                _map.erase(it);
+                break;
+            }
+        }
+        _memory -= victim->memory_usage();
+        _lru.pop_back();
+    }
+}
+
+size_t
+TokenCache::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _lru.size();
+}
+
+size_t
+TokenCache::memory_usage() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _memory;
+}
+
+size_t
+TokenCache::hits() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _hits;
+}
+
+size_t
+TokenCache::misses() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _misses;
+}
+
+} // namespace juniper
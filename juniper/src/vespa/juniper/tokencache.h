@@ -0,0 +1,94 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "ITokenProcessor.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace juniper {
+
+/**
+ * The output of tokenizing a text, kept so that later scans of the
+ * same text can replay the tokens into a matcher instead of
+ * tokenizing and folding the text again.
+ **/
+class TokenizedText
+{
+public:
+    struct Entry {
+        uint32_t offset;  // start of folded token in 'chars'
+        int      curlen;
+        off_t    bytepos;
+        int      bytelen;
+    };
+    using SP = std::shared_ptr<const TokenizedText>;
+
+    TokenizedText(const char *text, size_t len);
+    ~TokenizedText();
+    const std::string &text() const { return _text; }
+    size_t num_tokens() const { return _tokens.size(); }
+    size_t memory_usage() const;
+    void add(const ITokenProcessor::Token &token);
+    // Feed all tokens followed by the end token to 'successor'
+    void replay(ITokenProcessor &successor) const;
+private:
+    std::string         _text;
+    std::vector<ucs4_t> _chars;
+    std::vector<Entry>  _tokens;
+};
+
+/**
+ * Token processor stage forwarding tokens to its successor while
+ * recording them in a TokenizedText.
+ **/
+class TokenRecorder : public ITokenProcessor
+{
+public:
+    TokenRecorder(TokenizedText &target, ITokenProcessor &successor)
+        : _target(target), _successor(successor) {}
+    void handle_token(Token &token) override;
+    void handle_end(Token &token) override;
+private:
+    TokenizedText   &_target;
+    ITokenProcessor &_successor;
+};
+
+/**
+ * Thread safe LRU cache of tokenized texts, bounded by the memory
+ * used by the cached entries.
+ **/
+class TokenCache
+{
+public:
+    TokenCache(size_t max_memory, size_t min_text_size);
+    ~TokenCache();
+    // Texts shorter than this are cheaper to tokenize than to cache
+    bool want(size_t len) const { return len >= _min_text_size; }
+    TokenizedText::SP lookup(const char *text, size_t len);
+    void insert(TokenizedText::SP entry);
+    size_t size() const;
+    size_t memory_usage() const;
+    size_t hits() const;
+    size_t misses() const;
+private:
+    using LruList = std::list<TokenizedText::SP>;
+    using Map = std::unordered_multimap<size_t, LruList::iterator>;
+
+    static size_t hash(const char *text, size_t len);
+    void evict();
+
+    mutable std::mutex _lock;
+    size_t             _max_memory;
+    size_t             _min_text_size;
+    size_t             _memory;
+    size_t             _hits;
+    size_t             _misses;
+    LruList            _lru;
+    Map                _map;
+};
+
+} // namespace juniper
@@ -2,16 +2,57 @@
 
 #include "config_subscriber.h"
 #include "empty_forwarder.h"
-#include "rpc_forwarder.h"
 
 #include <vespa/log/log.h>
 LOG_SETUP("");
 
 using cloud::config::log::LogdConfig;
 using ns_log::Logger;
+using vespalib::compression::CompressionConfig;
 
 namespace logdemon {
 
+namespace {
+
+RpcForwarder::Options
+make_forwarder_options(const LogdConfig& config)
+{
+    RpcForwarder::Options options;
+    if (config.logserver.batch.maxmessages > 0) {
+        options.max_messages_per_request = config.logserver.batch.maxmessages;
+    } else {
+        LOG(config, "bad logserver.batch.maxmessages=%d must be positive", config.logserver.batch.maxmessages);
+    }
+    if (config.logserver.batch.maxbytes > 0) {
+        options.max_bytes_per_request = config.logserver.batch.maxbytes;
+    } else {
+        LOG(config, "bad logserver.batch.maxbytes=%d must be positive", config.logserver.batch.maxbytes);
+    }
+    options.max_batch_delay = vespalib::from_s(std::max(0.0, config.logserver.batch.maxdelay));
+    options.compression = (config.logserver.compression == LogdConfig::Logserver::Compression::LZ4)
+                          ? CompressionConfig::LZ4 : CompressionConfig::NONE;
+    options.max_repeats_per_window = std::max(0, config.sampling.maxrepeats);
+    if (config.sampling.window > 0) {
+        options.repeat_window = vespalib::from_s(config.sampling.window);
+    } else {
+        LOG(config, "bad sampling.window=%f must be positive", config.sampling.window);
+    }
+    return options;
+}
+
+bool
+operator!=(const RpcForwarder::Options& lhs, const RpcForwarder::Options& rhs)
+{
+    return (lhs.max_messages_per_request != rhs.max_messages_per_request ||
+            lhs.max_bytes_per_request != rhs.max_bytes_per_request ||
+            lhs.max_batch_delay != rhs.max_batch_delay ||
+            lhs.compression != rhs.compression ||
+            lhs.max_repeats_per_window != rhs.max_repeats_per_window ||
+            lhs.repeat_window != rhs.repeat_window);
+}
+
+}
+
 void
 ConfigSubscriber::configure(std::unique_ptr<LogdConfig> cfg)
 {
@@ -24,6 +65,11 @@ ConfigSubscriber::configure(std::unique_ptr<LogdConfig> cfg)
         _use_logserver = newconf.logserver.use;
         _need_new_forwarder = true;
     }
+    auto forwarder_options = make_forwarder_options(newconf);
+    if (forwarder_options != _forwarder_options) {
+        _forwarder_options = forwarder_options;
+        _need_new_forwarder = true;
+    }
     _state_port = newconf.stateport;
 
     ForwardMap forwardMap;
@@ -94,6 +140,7 @@ ConfigSubscriber::ConfigSubscriber(const config::ConfigUri& configUri)
       _remove_meg(INT_MAX),
       _remove_age(std::chrono::hours(30*24)),
       _use_logserver(true),
+      _forwarder_options(),
       _subscriber(configUri.getContext()),
       _handle(),
       _has_available(false),
@@ -120,7 +167,7 @@ ConfigSubscriber::make_forwarder(Metrics& metrics)
     std::unique_ptr<Forwarder> result;
     if (_use_logserver) {
         result = std::make_unique<RpcForwarder>(metrics, _forward_filter, _server.supervisor(), _logserver_host,
-                                                _logserver_rpc_port, 60.0, 100);
+                                                _logserver_rpc_port, _forwarder_options);
     } else {
         result = std::make_unique<EmptyForwarder>(metrics);
     }
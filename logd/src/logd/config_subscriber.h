@@ -2,6 +2,7 @@
 #pragma once
 
 #include "forwarder.h"
+#include "rpc_forwarder.h"
 #include <logd/config-logd.h>
 #include <vespa/config/config.h>
 #include <vespa/fnet/frt/supervisor.h>
@@ -25,6 +26,7 @@ private:
     int _remove_meg;
     vespalib::duration _remove_age;
     bool _use_logserver;
+    RpcForwarder::Options _forwarder_options;
     config::ConfigSubscriber _subscriber;
     config::ConfigHandle<cloud::config::log::LogdConfig>::UP _handle;
     bool _has_available;
@@ -21,6 +21,8 @@ public:
     virtual ~Forwarder() {}
     virtual void forwardLine(std::string_view log_line) = 0;
     virtual void flush() = 0;
+    // Called periodically; forwarders doing time based batching only flush when the batch is due.
+    virtual void flushIfDue() { flush(); }
     virtual int badLines() const = 0;
     virtual void resetBadLines() = 0;
 };
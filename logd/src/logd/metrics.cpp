@@ -9,7 +9,9 @@ Metrics::Metrics(std::shared_ptr<MetricsManager> m)
       loglevel(metrics->dimension("loglevel")),
       servicename(metrics->dimension("service")),
       loglines(metrics->counter("logd.processed.lines",
-                                "how many log lines have been processed"))
+                                "how many log lines have been processed")),
+      suppressed_lines(metrics->counter("logd.suppressed.lines",
+                                        "how many repeated log lines have not been forwarded"))
 {}
 
 Metrics::~Metrics() = default;
@@ -23,4 +25,13 @@ Metrics::countLine(const vespalib::string &level, const vespalib::string &servic
     loglines.add(1, p);
 }
 
+void
+Metrics::countSuppressedLine(const vespalib::string &level, const vespalib::string &service) const
+{
+    Point p = metrics->pointBuilder()
+            .bind(loglevel, level)
+            .bind(servicename, service);
+    suppressed_lines.add(1, p);
+}
+
 }
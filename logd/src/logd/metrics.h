@@ -18,11 +18,13 @@ struct Metrics {
     const Dimension loglevel;
     const Dimension servicename;
     const Counter loglines;
+    const Counter suppressed_lines;
 
     Metrics(std::shared_ptr<MetricsManager> m);
     ~Metrics();
 
     void countLine(const vespalib::string &level, const vespalib::string &service) const;
+    void countSuppressedLine(const vespalib::string &level, const vespalib::string &service) const;
 };
 
 } // namespace logdemon
@@ -5,7 +5,11 @@
 #include "proto_converter.h"
 #include "rpc_forwarder.h"
 #include <vespa/log/exceptions.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/buffer.h>
+#include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
@@ -14,6 +18,7 @@ LOG_SETUP(".logd.rpc_forwarder");
 using ns_log::BadLogLineException;
 using ns_log::LogMessage;
 using vespalib::make_string;
+using vespalib::compression::CompressionConfig;
 
 namespace logdemon {
 
@@ -41,7 +46,7 @@ RpcForwarder::ping_logserver()
 {
     GuardedRequest request;
     request->SetMethodName("frt.rpc.ping");
-    _target->InvokeSync(request.get(), _rpc_timeout_secs);
+    _target->InvokeSync(request.get(), _options.rpc_timeout_secs);
     if (!request->CheckReturnTypes("")) {
         auto error_msg = make_string("Error in rpc ping to logserver ('%s'): '%s'",
                                      _connection_spec.c_str(), request->GetErrorMessage());
@@ -50,17 +55,53 @@ RpcForwarder::ping_logserver()
     }
 }
 
+RpcForwarder::Options::Options()
+    : rpc_timeout_secs(60.0),
+      max_messages_per_request(100),
+      max_bytes_per_request(1000000),
+      max_batch_delay(vespalib::duration::zero()),
+      compression(CompressionConfig::NONE),
+      max_repeats_per_window(0),
+      repeat_window(60s)
+{
+}
+
+namespace {
+
+RpcForwarder::Options
+make_options(double rpc_timeout_secs, size_t max_messages_per_request)
+{
+    RpcForwarder::Options options;
+    options.rpc_timeout_secs = rpc_timeout_secs;
+    options.max_messages_per_request = max_messages_per_request;
+    return options;
+}
+
+}
+
 RpcForwarder::RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, FRT_Supervisor& supervisor,
                            const vespalib::string &hostname, int rpc_port,
                            double rpc_timeout_secs, size_t max_messages_per_request)
+    : RpcForwarder(metrics, forward_filter, supervisor, hostname, rpc_port,
+                   make_options(rpc_timeout_secs, max_messages_per_request))
+{
+}
+
+RpcForwarder::RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, FRT_Supervisor& supervisor,
+                           const vespalib::string &hostname, int rpc_port,
+                           const Options& options)
     : _metrics(metrics),
       _connection_spec(make_string("tcp/%s:%d", hostname.c_str(), rpc_port)),
-      _rpc_timeout_secs(rpc_timeout_secs),
-      _max_messages_per_request(max_messages_per_request),
+      _options(options),
       _target(supervisor.GetTarget(_connection_spec.c_str())),
       _messages(),
+      _batch_bytes(0),
+      _batch_start(),
       _bad_lines(0),
-      _forward_filter(forward_filter)
+      _forward_filter(forward_filter),
+      _repeat_counts(),
+      _repeat_window_start(vespalib::steady_clock::now()),
+      _suppressed(0)
 {
     ping_logserver();
 }
@@ -69,26 +110,35 @@ RpcForwarder::~RpcForwarder() = default;
 
 namespace {
 
-void
-encode_log_request(const ProtoConverter::ProtoLogRequest& src, FRT_RPCRequest& dst)
+CompressionConfig::Type
+encode_log_request(const ProtoConverter::ProtoLogRequest& src, CompressionConfig::Type compression, FRT_RPCRequest& dst)
 {
     dst.SetMethodName("vespa.logserver.archiveLogMessages");
     auto buf = src.SerializeAsString();
+    vespalib::DataBuffer compressed;
+    auto type = vespalib::compression::compress(CompressionConfig(compression),
+                                                vespalib::ConstBufferRef(buf.data(), buf.size()),
+                                                compressed, false);
     auto& params = *dst.GetParams();
-    params.AddInt8(0); // '0' indicates no compression
+    params.AddInt8(type); // '0' indicates no compression
     params.AddInt32(buf.size());
-    params.AddData(buf.data(), buf.size());
+    params.AddData(compressed.getData(), compressed.getDataLen());
+    return type;
 }
 
 bool
 decode_log_response(FRT_RPCRequest& src, ProtoConverter::ProtoLogResponse& dst)
 {
     auto& values = *src.GetReturn();
-    uint8_t encoding = values[0]._intval8;
-    assert(encoding == 0); // Not using compression
+    auto encoding = CompressionConfig::toType(values[0]._intval8);
     uint32_t uncompressed_size = values[1]._intval32;
-    (void) uncompressed_size;
-    return dst.ParseFromArray(values[2]._data._buf, values[2]._data._len);
+    vespalib::ConstBufferRef blob(values[2]._data._buf, values[2]._data._len);
+    if (!CompressionConfig::isCompressed(encoding)) {
+        return dst.ParseFromArray(blob.data(), blob.size());
+    }
+    vespalib::DataBuffer uncompressed;
+    vespalib::compression::decompress(encoding, uncompressed_size, blob, uncompressed, false);
+    return dst.ParseFromArray(uncompressed.getData(), uncompressed.getDataLen());
 }
 
 bool
@@ -101,6 +151,39 @@ should_forward_log_message(const LogMessage& message, const ForwardMap& filter)
     return false;
 }
 
+uint64_t
+repeat_key(const LogMessage& message)
+{
+    uint64_t key = vespalib::hashValue(message.payload().data(), message.payload().size());
+    key = key * 31 + vespalib::hashValue(message.service().data(), message.service().size());
+    key = key * 31 + vespalib::hashValue(message.component().data(), message.component().size());
+    return key * 31 + message.level();
+}
+
+}
+
+bool
+RpcForwarder::is_suppressed_repeat(const LogMessage& message, vespalib::steady_time now)
+{
+    if (_options.max_repeats_per_window == 0 || message.level() == ns_log::Logger::fatal) {
+        return false;
+    }
+    if (now - _repeat_window_start >= _options.repeat_window) {
+        if (_suppressed > 0) {
+            LOG(info, "Did not forward %zu repeated log messages during the last %2.1f seconds",
+                _suppressed, vespalib::to_s(now - _repeat_window_start));
+        }
+        _repeat_counts.clear();
+        _repeat_window_start = now;
+        _suppressed = 0;
+    }
+    uint32_t& count = _repeat_counts[repeat_key(message)];
+    if (count >= _options.max_repeats_per_window) {
+        ++_suppressed;
+        return true;
+    }
+    ++count;
+    return false;
 }
 
 void
@@ -116,8 +199,19 @@ RpcForwarder::forwardLine(std::string_view line)
     }
     _metrics.countLine(ns_log::Logger::logLevelNames[message.level()], message.service());
     if (should_forward_log_message(message, _forward_filter)) {
+        auto now = vespalib::steady_clock::now();
+        if (is_suppressed_repeat(message, now)) {
+            _metrics.countSuppressedLine(ns_log::Logger::logLevelNames[message.level()], message.service());
+            return;
+        }
+        if (_messages.empty()) {
+            _batch_start = now;
+        }
+        _batch_bytes += line.size();
         _messages.push_back(std::move(message));
-        if (_messages.size() == _max_messages_per_request) {
+        if (_messages.size() >= _options.max_messages_per_request ||
+            _batch_bytes >= _options.max_bytes_per_request)
+        {
             flush();
         }
     }
@@ -129,11 +223,38 @@ RpcForwarder::flush()
     if (_messages.empty()) {
         return;
     }
+    send_batch(CompressionConfig::isCompressed(_options.compression));
+    _messages.clear();
+    _batch_bytes = 0;
+}
+
+void
+RpcForwarder::flushIfDue()
+{
+    if (!_messages.empty() && (vespalib::steady_clock::now() - _batch_start >= _options.max_batch_delay)) {
+        flush();
+    }
+}
+
+void
+RpcForwarder::send_batch(bool allow_compression)
+{
     ProtoConverter::ProtoLogRequest proto_request;
     ProtoConverter::log_messages_to_proto(_messages, proto_request);
     GuardedRequest request;
-    encode_log_request(proto_request, *request);
-    _target->InvokeSync(request.get(), _rpc_timeout_secs);
+    auto compression = allow_compression ? _options.compression : CompressionConfig::NONE;
+    auto used_compression = encode_log_request(proto_request, compression, *request);
+    _target->InvokeSync(request.get(), _options.rpc_timeout_secs);
+    if (CompressionConfig::isCompressed(used_compression) &&
+        request->GetErrorCode() == FRTE_RPC_METHOD_FAILED)
+    {
+        // Older logservers do not accept compressed requests
+        LOG(info, "Logserver ('%s') rejected compressed request: '%s'. Disabling compression",
+            _connection_spec.c_str(), request->GetErrorMessage());
+        _options.compression = CompressionConfig::NONE;
+        send_batch(false);
+        return;
+    }
     if (!request->CheckReturnTypes("bix")) {
         auto error_msg = make_string("Error in rpc reply from logserver ('%s'): '%s'",
                                      _connection_spec.c_str(), request->GetErrorMessage());
@@ -146,7 +267,6 @@ RpcForwarder::flush()
         LOG(warning, "%s", error_msg.c_str());
         throw DecodeException(error_msg);
     }
-    _messages.clear();
 }
 
 int
@@ -6,6 +6,9 @@
 #include "proto_converter.h"
 #include <vespa/log/log_message.h>
 #include <vespa/fnet/frt/frt.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/compressionconfig.h>
+#include <vespa/vespalib/util/time.h>
 #include <memory>
 #include <vector>
 
@@ -22,29 +25,57 @@ using RpcTargetGuard = std::unique_ptr<FRT_Target, RpcTargetSubRef>;
 
 /**
  * Implementation of the Forwarder interface that uses RPC to send protobuf encoded log messages to the logserver.
+ *
+ * Messages are sent in batches limited by number of messages, size and age, and batches are optionally
+ * compressed. Identical messages repeated more than a given number of times within a time window are
+ * not forwarded (they are still in the local log file).
  */
 class RpcForwarder : public Forwarder {
+public:
+    using CompressionType = vespalib::compression::CompressionConfig::Type;
+
+    struct Options {
+        double rpc_timeout_secs;
+        size_t max_messages_per_request;
+        size_t max_bytes_per_request;
+        vespalib::duration max_batch_delay;    // zero means send on every flush
+        CompressionType compression;
+        uint32_t max_repeats_per_window;       // zero means no limit
+        vespalib::duration repeat_window;
+        Options();
+    };
+
 private:
     Metrics& _metrics;
     vespalib::string _connection_spec;
-    double _rpc_timeout_secs;
-    size_t _max_messages_per_request;
+    Options _options;
     RpcTargetGuard _target;
     std::vector<ns_log::LogMessage> _messages;
+    size_t _batch_bytes;
+    vespalib::steady_time _batch_start;
     int _bad_lines;
     ForwardMap _forward_filter;
+    vespalib::hash_map<uint64_t, uint32_t> _repeat_counts;
+    vespalib::steady_time _repeat_window_start;
+    size_t _suppressed;
 
     void ping_logserver();
+    bool is_suppressed_repeat(const ns_log::LogMessage& message, vespalib::steady_time now);
+    void send_batch(bool allow_compression);
 
 public:
     RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, FRT_Supervisor& supervisor,
                  const vespalib::string& logserver_host, int logserver_rpc_port,
                  double rpc_timeout_secs, size_t max_messages_per_request);
+    RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, FRT_Supervisor& supervisor,
+                 const vespalib::string& logserver_host, int logserver_rpc_port,
+                 const Options& options);
     ~RpcForwarder() override;
 
     // Implements Forwarder
     void forwardLine(std::string_view line) override;
     void flush() override;
+    void flushIfDue() override;
     int badLines() const override;
     void resetBadLines() override;
 };
@@ -273,19 +273,22 @@ Watcher::watchfile()
             }
         }
 
-        _forwarder.flush();
+        _forwarder.flushIfDue();
         dcf.saveState(already);
 
         if (_confsubscriber.checkAvailable()) {
             LOG(debug, "new config available, doing reconfigure");
+            _forwarder.flush();
             return;
         }
 
         if (catcher.receivedStopSignal()) {
+            _forwarder.flush();
             throw SigTermException("caught signal");
         }
         snooze(timer);
         if (catcher.receivedStopSignal()) {
+            _forwarder.flush();
             throw SigTermException("caught signal");
         }
         if (++sleepcount > 99) {
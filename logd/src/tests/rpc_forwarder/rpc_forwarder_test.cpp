@@ -3,10 +3,14 @@
 #include <logd/exceptions.h>
 #include <logd/metrics.h>
 #include <logd/rpc_forwarder.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/metrics/dummy_metrics_manager.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <thread>
 
 using namespace logdemon;
+using vespalib::compression::CompressionConfig;
 using vespalib::metrics::DummyMetricsManager;
 
 void
@@ -22,10 +26,18 @@ bool
 decode_log_request(FRT_Values& src, ProtoConverter::ProtoLogRequest& dst)
 {
     uint8_t encoding = src[0]._intval8;
-    assert(encoding == 0);
     uint32_t uncompressed_size = src[1]._intval32;
-    assert(uncompressed_size == src[2]._data._len);
-    return dst.ParseFromArray(src[2]._data._buf, src[2]._data._len);
+    if (encoding == 0) {
+        assert(uncompressed_size == src[2]._data._len);
+        return dst.ParseFromArray(src[2]._data._buf, src[2]._data._len);
+    }
+    assert(encoding == CompressionConfig::LZ4);
+    vespalib::DataBuffer uncompressed;
+    vespalib::compression::decompress(CompressionConfig::LZ4, uncompressed_size,
+                                      vespalib::ConstBufferRef(src[2]._data._buf, src[2]._data._len),
+                                      uncompressed, false);
+    assert(uncompressed_size == uncompressed.getDataLen());
+    return dst.ParseFromArray(uncompressed.getData(), uncompressed.getDataLen());
 }
 
 std::string garbage("garbage");
@@ -34,16 +46,20 @@ struct RpcServer : public FRT_Invokable {
     fnet::frt::StandaloneFRT server;
     int request_count;
     std::vector<std::string> messages;
+    std::vector<int> encodings;
     bool reply_with_error;
     bool reply_with_proto_response;
+    bool reject_compression;
 
 public:
     RpcServer()
         : server(),
           request_count(0),
           messages(),
+          encodings(),
           reply_with_error(false),
-          reply_with_proto_response(true)
+          reply_with_proto_response(true),
+          reject_compression(false)
     {
         FRT_ReflectionBuilder builder(&server.supervisor());
         builder.DefineMethod("vespa.logserver.archiveLogMessages", "bix", "bix",
@@ -55,6 +71,12 @@ public:
         return server.supervisor().GetListenPort();
     }
     void rpc_archive_log_messages(FRT_RPCRequest* request) {
+        uint8_t encoding = (*request->GetParams())[0]._intval8;
+        if (reject_compression && encoding != 0) {
+            request->SetError(FRTE_RPC_METHOD_FAILED, "Invalid compression type");
+            return;
+        }
+        encodings.push_back(encoding);
         ProtoConverter::ProtoLogRequest proto_request;
         ASSERT_TRUE(decode_log_request(*request->GetParams(), proto_request));
         ++request_count;
@@ -115,17 +137,25 @@ make_forward_filter()
     return result;
 }
 
-struct RpcForwarderTest : public ::testing::Test {
+RpcForwarder::Options
+make_options(size_t max_messages)
+{
+    RpcForwarder::Options result;
+    result.max_messages_per_request = max_messages;
+    return result;
+}
+
+struct RpcForwarderTestBase : public ::testing::Test {
     RpcServer server;
     std::shared_ptr<MockMetricsManager> metrics_mgr;
     Metrics metrics;
     ClientSupervisor supervisor;
     RpcForwarder forwarder;
-    RpcForwarderTest()
+    RpcForwarderTestBase(const RpcForwarder::Options& options)
         : server(),
           metrics_mgr(std::make_shared<MockMetricsManager>()),
           metrics(metrics_mgr),
-          forwarder(metrics, make_forward_filter(), supervisor.get(), "localhost", server.get_listen_port(), 60.0, 3)
+          forwarder(metrics, make_forward_filter(), supervisor.get(), "localhost", server.get_listen_port(), options)
     {
     }
     void forward_line(const std::string& payload) {
@@ -149,6 +179,10 @@ struct RpcForwarderTest : public ::testing::Test {
     }
 };
 
+struct RpcForwarderTest : public RpcForwarderTestBase {
+    RpcForwarderTest() : RpcForwarderTestBase(make_options(3)) {}
+};
+
 TEST_F(RpcForwarderTest, does_not_send_rpc_with_no_log_messages)
 {
     expect_messages();
@@ -243,5 +277,129 @@ TEST_F(RpcForwarderTest, throws_when_rpc_reply_does_not_contain_proto_response)
     EXPECT_THROW(flush(), logdemon::DecodeException);
 }
 
+TEST_F(RpcForwarderTest, log_messages_are_sent_uncompressed_by_default)
+{
+    forward_line("a");
+    flush();
+    EXPECT_EQ(std::vector<int>({0}), server.encodings);
+}
+
+TEST_F(RpcForwarderTest, flush_if_due_sends_rpc_when_there_is_no_max_delay)
+{
+    forward_line("a");
+    forwarder.flushIfDue();
+    expect_messages(1, {"a"});
+}
+
+RpcForwarder::Options
+make_batching_options()
+{
+    auto result = make_options(100);
+    result.max_bytes_per_request = 200;
+    result.max_batch_delay = 50ms;
+    return result;
+}
+
+struct BatchingRpcForwarderTest : public RpcForwarderTestBase {
+    BatchingRpcForwarderTest() : RpcForwarderTestBase(make_batching_options()) {}
+};
+
+TEST_F(BatchingRpcForwarderTest, flush_if_due_holds_back_log_messages_until_max_delay_has_passed)
+{
+    forward_line("a");
+    forwarder.flushIfDue();
+    expect_messages();
+    std::this_thread::sleep_for(60ms);
+    forward_line("b");
+    forwarder.flushIfDue();
+    expect_messages(1, {"a", "b"});
+}
+
+TEST_F(BatchingRpcForwarderTest, flush_sends_rpc_before_max_delay_has_passed)
+{
+    forward_line("a");
+    flush();
+    expect_messages(1, {"a"});
+}
+
+TEST_F(BatchingRpcForwarderTest, automatically_sends_rpc_when_max_bytes_limit_is_reached)
+{
+    std::string payload(100, 'x');
+    forward_line(payload);
+    expect_messages();
+    forward_line(payload);
+    expect_messages(1, {payload, payload});
+}
+
+RpcForwarder::Options
+make_compression_options()
+{
+    auto result = make_options(100);
+    result.compression = CompressionConfig::LZ4;
+    return result;
+}
+
+struct CompressingRpcForwarderTest : public RpcForwarderTestBase {
+    CompressingRpcForwarderTest() : RpcForwarderTestBase(make_compression_options()) {}
+};
+
+TEST_F(CompressingRpcForwarderTest, log_messages_are_sent_compressed)
+{
+    std::string payload(1000, 'x');
+    forward_line(payload);
+    forward_line(payload);
+    flush();
+    expect_messages(1, {payload, payload});
+    EXPECT_EQ(std::vector<int>({CompressionConfig::LZ4}), server.encodings);
+}
+
+TEST_F(CompressingRpcForwarderTest, falls_back_to_uncompressed_rpc_when_server_rejects_compression)
+{
+    server.reject_compression = true;
+    std::string payload(1000, 'x');
+    forward_line(payload);
+    flush();
+    forward_line(payload);
+    flush();
+    expect_messages(2, {payload, payload});
+    EXPECT_EQ(std::vector<int>({0, 0}), server.encodings);
+}
+
+RpcForwarder::Options
+make_sampling_options()
+{
+    auto result = make_options(100);
+    result.max_repeats_per_window = 2;
+    result.repeat_window = 50ms;
+    return result;
+}
+
+struct SamplingRpcForwarderTest : public RpcForwarderTestBase {
+    SamplingRpcForwarderTest() : RpcForwarderTestBase(make_sampling_options()) {}
+};
+
+TEST_F(SamplingRpcForwarderTest, repeated_log_messages_are_not_forwarded_within_the_window)
+{
+    forward_line("a");
+    forward_line("a");
+    forward_line("a");
+    forward_line("b");
+    forward_line("error", "a");
+    flush();
+    expect_messages(1, {"a", "a", "b", "a"});
+    EXPECT_EQ(5, metrics_mgr->add_count);
+}
+
+TEST_F(SamplingRpcForwarderTest, repeated_log_messages_are_forwarded_again_in_the_next_window)
+{
+    forward_line("a");
+    forward_line("a");
+    forward_line("a");
+    std::this_thread::sleep_for(60ms);
+    forward_line("a");
+    flush();
+    expect_messages(1, {"a", "a", "a"});
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
 
@@ -1,6 +1,8 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 package ai.vespa.logserver.protocol;
 
+import com.yahoo.compress.CompressionType;
+import com.yahoo.compress.Compressor;
 import com.yahoo.jrt.DataValue;
 import com.yahoo.jrt.ErrorCode;
 import com.yahoo.jrt.Int32Value;
@@ -33,7 +35,7 @@ public class ArchiveLogMessagesMethod {
         this.logDispatcher = logDispatcher;
         this.method = new Method(METHOD_NAME, "bix", "bix", this::log)
                 .methodDesc("Archive log messages")
-                .paramDesc(0, "compressionType", "Compression type (0=raw)")
+                .paramDesc(0, "compressionType", "Compression type (0=raw, 6=lz4)")
                 .paramDesc(1, "uncompressedSize", "Uncompressed size")
                 .paramDesc(2, "logRequest", "Log request encoded with protobuf")
                 .returnDesc(0, "compressionType", "Compression type (0=raw)")
@@ -51,6 +53,8 @@ public class ArchiveLogMessagesMethod {
     }
 
     private static class ArchiveLogMessagesTask implements Runnable {
+        static final Compressor compressor = new Compressor(CompressionType.LZ4);
+
         final Request rpcRequest;
         final LogDispatcher logDispatcher;
 
@@ -63,13 +67,16 @@ public class ArchiveLogMessagesMethod {
         public void run() {
             try {
                 byte compressionType = rpcRequest.parameters().get(0).asInt8();
-                if (compressionType != 0) {
+                if (compressionType != CompressionType.NONE.getCode() && compressionType != CompressionType.LZ4.getCode()) {
                     rpcRequest.setError(ErrorCode.METHOD_FAILED, "Invalid compression type: " + compressionType);
                     rpcRequest.returnRequest();
                     return;
                 }
                 int uncompressedSize = rpcRequest.parameters().get(1).asInt32();
                 byte[] logRequestPayload = rpcRequest.parameters().get(2).asData();
+                if (compressionType == CompressionType.LZ4.getCode()) {
+                    logRequestPayload = compressor.decompress(logRequestPayload, CompressionType.LZ4, uncompressedSize);
+                }
                 if (uncompressedSize != logRequestPayload.length) {
                     rpcRequest.setError(ErrorCode.METHOD_FAILED, String.format("Invalid uncompressed size: got %d while data is of size %d ", uncompressedSize, logRequestPayload.length));
                     rpcRequest.returnRequest();
@@ -1,6 +1,8 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 package ai.vespa.logserver.protocol;
 
+import com.yahoo.compress.CompressionType;
+import com.yahoo.compress.Compressor;
 import com.yahoo.jrt.DataValue;
 import com.yahoo.jrt.Int32Value;
 import com.yahoo.jrt.Int8Value;
@@ -39,13 +41,22 @@ public class ArchiveLogMessagesMethodTest {
 
     @Test
     public void server_dispatches_log_messages_from_log_request() {
+        assertLogMessagesAreDispatched(CompressionType.NONE);
+    }
+
+    @Test
+    public void server_dispatches_log_messages_from_lz4_compressed_log_request() {
+        assertLogMessagesAreDispatched(CompressionType.LZ4);
+    }
+
+    private static void assertLogMessagesAreDispatched(CompressionType compressionType) {
         List<LogMessage> messages = List.of(MESSAGE_1, MESSAGE_2);
         LogDispatcher logDispatcher = mock(LogDispatcher.class);
         try (RpcServer server = new RpcServer(0)) {
             server.addMethod(new ArchiveLogMessagesMethod(logDispatcher).methodDefinition());
             server.start();
             try (TestClient client = new TestClient(server.listenPort())) {
-                client.logMessages(messages);
+                client.logMessages(messages, compressionType);
             }
         }
         verify(logDispatcher).handle(new ArrayList<>(messages));
@@ -62,12 +73,15 @@ public class ArchiveLogMessagesMethodTest {
             this.target = supervisor.connect(new Spec(logserverPort));
         }
 
-        void logMessages(List<LogMessage> messages) {
+        void logMessages(List<LogMessage> messages, CompressionType compressionType) {
             byte[] requestPayload = ProtobufSerialization.toLogRequest(messages);
+            byte[] encodedPayload = (compressionType == CompressionType.LZ4)
+                    ? new Compressor(CompressionType.LZ4).compressUnconditionally(requestPayload)
+                    : requestPayload;
             Request request = new Request(ArchiveLogMessagesMethod.METHOD_NAME);
-            request.parameters().add(new Int8Value((byte)0));
+            request.parameters().add(new Int8Value(compressionType.getCode()));
             request.parameters().add(new Int32Value(requestPayload.length));
-            request.parameters().add(new DataValue(requestPayload));
+            request.parameters().add(new DataValue(encodedPayload));
             target.invokeSync(request, 10/*seconds*/);
             Values returnValues = request.returnValues();
             assertEquals(3, returnValues.size());
@@ -34,6 +34,7 @@ public:
     void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const override {
         v.setData(name, vespalib::Memory(_payload.data(), _payload.size()));
     }
+    size_t size() const override { return _payload.size(); }
 private:
     BlobRef _payload;
 };
@@ -49,6 +50,7 @@ public:
     void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const override {
         v.setData(name, vespalib::Memory(_payload.data(), _payload.size()));
     }
+    size_t size() const override { return _payload.size(); }
 private:
     mutable Blob _payload;
 };
@@ -27,6 +27,7 @@ public:
     virtual ~PayLoadFiller() { }
     virtual void fill(FRT_Values & v) const = 0;
     virtual void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const = 0;
+    virtual size_t size() const = 0;
 };
 
 class RPCSend : public RPCSendAdapter,
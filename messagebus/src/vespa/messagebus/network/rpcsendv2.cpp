@@ -96,6 +96,34 @@ private:
     }
     DataBuffer _buf;
 };
+
+// Room for the fields around the payload, to avoid growing the buffer in the common case
+constexpr size_t HEADER_SIZE_ESTIMATE = 1024;
+
+/*
+ * Encodes the slime and adds it as encoding, decoded size and blob. The buffer is sized
+ * from the payload instead of a fixed 8k, and is handed over as is unless it is
+ * actually compressed, sparing small messages an allocation and a copy each.
+ */
+void
+addEncodedSlime(FRT_Values &values, const Slime &slime, size_t estimatedSize, const CompressionConfig &config)
+{
+    OutputBuf rBuf(estimatedSize);
+    BinaryFormat::encode(slime, rBuf);
+    DataBuffer &encoded = rBuf.getBuf();
+    const size_t decodedSize = encoded.getDataLen();
+    assert(decodedSize <= INT32_MAX);
+    CompressionConfig::Type type = CompressionConfig::NONE;
+    DataBuffer compressed(0);
+    if (config.useCompression() && (decodedSize >= config.minSize)) {
+        compressed = DataBuffer(vespalib::roundUp2inN(decodedSize));
+        type = compress(config, ConstBufferRef(encoded.getData(), decodedSize), compressed, false);
+    }
+    values.AddInt8(type);
+    values.AddInt32(decodedSize);
+    values.AddData(CompressionConfig::isCompressed(type) ? std::move(compressed) : std::move(encoded));
+}
+
 }
 
 void
@@ -123,17 +151,7 @@ RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Rout
     root.setLong(TRACELEVEL_F, traceLevel);
     filler.fill(BLOB_F, root);
 
-    OutputBuf rBuf(8192);
-    BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
-
-    args.AddInt8(type);
-    args.AddInt32(toCompress.size());
-    const auto bufferLength = buf.getDataLen();
-    assert(bufferLength <= INT32_MAX);
-    args.AddData(std::move(buf).stealBuffer(), bufferLength);
+    addEncodedSlime(args, slime, filler.size() + HEADER_SIZE_ESTIMATE, _net->getCompressionConfig());
 }
 
 namespace {
@@ -253,17 +271,7 @@ RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & repl
         }
     }
 
-    OutputBuf rBuf(8192);
-    BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
-
-    ret.AddInt8(type);
-    ret.AddInt32(toCompress.size());
-    assert(buf.getDataLen() <= INT32_MAX);
-    ret.AddData(std::move(buf));
-
+    addEncodedSlime(ret, slime, payload.size() + HEADER_SIZE_ESTIMATE, _net->getCompressionConfig());
 }
 
 } // namespace mbus
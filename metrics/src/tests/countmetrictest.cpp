@@ -3,6 +3,8 @@
 #include <vespa/vespalib/objects/floatingpointtype.h>
 #include <vespa/metrics/countmetric.h>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using vespalib::Double;
 
@@ -39,4 +41,34 @@ TEST(CountMetricTest, testLongCountMetric)
     EXPECT_EQ(int64_t(84), o.getLongValue("value"));
 }
 
+TEST(CountMetricTest, concurrent_increments_are_not_lost)
+{
+    LongCountMetric m("test", {}, "description");
+    m.inc(1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&m]() {
+            for (int i = 0; i < 10000; ++i) {
+                m.inc(2);
+                m.dec(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(uint64_t(40001), m.getValue());
+}
+
+TEST(CountMetricTest, increment_after_reset_starts_from_zero)
+{
+    LongCountMetric m("test", {}, "description");
+    m.inc(10);
+    m.reset();
+    m.inc(3);
+    EXPECT_EQ(uint64_t(3), m.getValue());
+    m.inc(4);
+    EXPECT_EQ(uint64_t(7), m.getValue());
+}
+
 }
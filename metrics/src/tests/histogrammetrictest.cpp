@@ -0,0 +1,129 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/metrics/histogrammetric.h>
+#include <vespa/metrics/jsonwriter.h>
+#include <vespa/metrics/metricmanager.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <thread>
+
+namespace metrics {
+
+TEST(HistogramMetricTest, buckets_cover_all_values_without_gaps)
+{
+    uint32_t prevBucket = 0;
+    for (uint64_t units = 0; units < 100000; ++units) {
+        uint32_t bucket = HistogramMetric::bucketOf(units);
+        ASSERT_LT(bucket, HistogramMetric::NUM_BUCKETS);
+        ASSERT_LE(HistogramMetric::bucketStart(bucket), units);
+        ASSERT_LT(units, HistogramMetric::bucketStart(bucket) + HistogramMetric::bucketWidth(bucket));
+        ASSERT_TRUE(bucket == prevBucket || bucket == prevBucket + 1);
+        prevBucket = bucket;
+    }
+    EXPECT_EQ(HistogramMetric::NUM_BUCKETS - 1, HistogramMetric::bucketOf(uint64_t(-1)));
+}
+
+TEST(HistogramMetricTest, quantiles_are_within_bucket_precision)
+{
+    HistogramMetric m("latency", {}, "description", 0.001);
+    for (int i = 1; i <= 10000; ++i) {
+        m.addValue(i * 0.01);
+    }
+    EXPECT_EQ(10000u, m.getCount());
+    EXPECT_NEAR(50.005, m.getAverage(), 0.001);
+    EXPECT_NEAR(0.01, m.getMinimum(), 1e-9);
+    EXPECT_NEAR(100.0, m.getMaximum(), 1e-9);
+    EXPECT_NEAR(50.0, m.getQuantile(0.5), 50.0 * 0.016);
+    EXPECT_NEAR(99.0, m.getQuantile(0.99), 99.0 * 0.016);
+    EXPECT_NEAR(99.9, m.getQuantile(0.999), 99.9 * 0.016);
+    EXPECT_NEAR(99.0, m.getDoubleValue("p99"), 99.0 * 0.016);
+    EXPECT_EQ(10000, m.getLongValue("count"));
+}
+
+TEST(HistogramMetricTest, values_below_resolution_and_above_range_are_clamped)
+{
+    HistogramMetric m("latency", {}, "description", 1.0);
+    m.addValue(-5.0);
+    m.addValue(0.4);
+    m.addValue(1e30);
+    EXPECT_EQ(3u, m.getCount());
+    EXPECT_EQ(0.0, m.getMinimum());
+    EXPECT_EQ(0.0, m.getQuantile(0.5));
+    EXPECT_EQ(double((uint64_t(1) << HistogramMetric::MAX_UNIT_BITS) - 1), m.getMaximum());
+}
+
+TEST(HistogramMetricTest, snapshots_and_parts_merge_buckets)
+{
+    HistogramMetric a("latency", {}, "description", 1.0);
+    HistogramMetric b("latency", {}, "description", 1.0);
+    for (int i = 0; i < 90; ++i) {
+        a.addValue(10);
+    }
+    for (int i = 0; i < 10; ++i) {
+        b.addValue(1000);
+    }
+    std::vector<Metric::UP> owners;
+    std::unique_ptr<HistogramMetric> snapshot(a.clone(owners, Metric::INACTIVE, nullptr, false));
+    EXPECT_EQ(90u, snapshot->getCount());
+    b.addToSnapshot(*snapshot, owners);
+    EXPECT_EQ(100u, snapshot->getCount());
+    EXPECT_EQ(10.0, snapshot->getQuantile(0.9));
+    EXPECT_NEAR(1000.0, snapshot->getQuantile(0.95), 1000.0 * 0.016);
+    EXPECT_EQ(10.0, snapshot->getMinimum());
+    EXPECT_EQ(1000.0, snapshot->getMaximum());
+
+    HistogramMetric sum("latency", {}, "description", 1.0);
+    a.addToPart(sum);
+    b.addToPart(sum);
+    EXPECT_EQ(100u, sum.getCount());
+    EXPECT_EQ(snapshot->getQuantile(0.99), sum.getQuantile(0.99));
+
+    a.reset();
+    EXPECT_EQ(0u, a.getCount());
+    EXPECT_FALSE(a.used());
+    EXPECT_EQ(0.0, a.getQuantile(0.99));
+}
+
+TEST(HistogramMetricTest, concurrent_recording_is_not_lost)
+{
+    HistogramMetric m("latency", {}, "description", 1.0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&m, t]() {
+            for (int i = 0; i < 10000; ++i) {
+                m.addValue(t * 100 + (i % 100));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(40000u, m.getCount());
+    EXPECT_EQ(0.0, m.getMinimum());
+    EXPECT_EQ(399.0, m.getMaximum());
+}
+
+TEST(HistogramMetricTest, json_output_includes_quantiles)
+{
+    MetricManager mm;
+    HistogramMetric m("latency", {}, "description", 1.0);
+    mm.registerMetric(mm.getMetricLock(), m);
+    for (int i = 1; i <= 50; ++i) {
+        m.addValue(i);
+    }
+    vespalib::asciistream as;
+    vespalib::JsonStream stream(as);
+    JsonWriter writer(stream);
+    {
+        MetricLockGuard guard(mm.getMetricLock());
+        mm.visit(guard, mm.getActiveMetrics(guard), writer, "");
+    }
+    stream.finalize();
+    vespalib::string json = as.str();
+    EXPECT_NE(vespalib::string::npos, json.find("\"count\":50"));
+    EXPECT_NE(vespalib::string::npos, json.find("\"p50\":25.0"));
+    EXPECT_NE(vespalib::string::npos, json.find("\"p99\":50.0"));
+    EXPECT_NE(vespalib::string::npos, json.find("\"max\":50.0"));
+}
+
+}
@@ -791,6 +791,13 @@ TEST_F(MetricManagerTest, test_json_output)
     vespalib::string total = adapter.getTotalMetrics("snapper");
     EXPECT_GT(total.size(), 0);
     EXPECT_NE(total, normal);
+
+    // rendered json is reused until the next snapshot is taken
+    mySet.val6.addValue(8);
+    EXPECT_EQ(normal, adapter.getMetrics("snapper"));
+    timer->_time = 1600;
+    takeSnapshots(mm, 1600);
+    EXPECT_NE(normal, adapter.getMetrics("snapper"));
 }
 
 namespace {
@@ -77,12 +77,18 @@ void
 CountMetric<T, SumOnAdd>::inc(T value)
 {
     bool overflow;
-    Values values;
-    do {
-        values = _values.getValues();
-        overflow = (values._value + value < values._value);
-        values._value += value;
-    } while (!_values.setValues(values));
+    auto fastInc = [value, &overflow](typename Values::AtomicImpl& active) {
+        T old = active._value.fetch_add(value, std::memory_order_relaxed);
+        overflow = (old + value < old);
+    };
+    if (!_values.updateActiveValues(fastInc)) {
+        Values values;
+        do {
+            values = _values.getValues();
+            overflow = (values._value + value < values._value);
+            values._value += value;
+        } while (!_values.setValues(values));
+    }
     if (overflow) {
         _values.reset();
         logWarning("Overflow", "inc");
@@ -94,12 +100,18 @@ void
 CountMetric<T, SumOnAdd>::dec(T value)
 {
     bool underflow;
-    Values values;
-    do {
-        values = _values.getValues();
-        underflow = (values._value - value > values._value);
-        values._value -= value;
-    } while (!_values.setValues(values));
+    auto fastDec = [value, &underflow](typename Values::AtomicImpl& active) {
+        T old = active._value.fetch_sub(value, std::memory_order_relaxed);
+        underflow = (old - value > old);
+    };
+    if (!_values.updateActiveValues(fastDec)) {
+        Values values;
+        do {
+            values = _values.getValues();
+            underflow = (values._value - value > values._value);
+            values._value -= value;
+        } while (!_values.setValues(values));
+    }
     if (underflow) {
         _values.reset();
         logWarning("Underflow", "dec");
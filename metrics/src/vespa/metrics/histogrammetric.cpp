@@ -0,0 +1,293 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "histogrammetric.h"
+#include "memoryconsumption.h"
+#include <vespa/vespalib/util/exceptions.h>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+namespace metrics {
+
+namespace {
+
+constexpr uint64_t MAX_UNITS = (uint64_t(1) << HistogramMetric::MAX_UNIT_BITS) - 1;
+constexpr uint64_t NO_MIN = std::numeric_limits<uint64_t>::max();
+constexpr uint32_t HALF_SUB_BUCKETS = 1u << (HistogramMetric::SUB_BUCKET_BITS - 1);
+
+uint32_t mostSignificantBit(uint64_t value) {
+    return 63 - __builtin_clzl(value);
+}
+
+}
+
+HistogramMetric::HistogramMetric(const String& name, Tags dimensions,
+                                 const String& description, double resolution,
+                                 MetricSet* owner)
+    : AbstractValueMetric(name, std::move(dimensions), description, owner),
+      _resolution(resolution),
+      _buckets(NUM_BUCKETS),
+      _count(0),
+      _totalUnits(0),
+      _minUnits(NO_MIN),
+      _maxUnits(0),
+      _last(0.0)
+{
+    assert(resolution > 0);
+}
+
+HistogramMetric::HistogramMetric(const HistogramMetric& other, CopyType, MetricSet* owner)
+    : AbstractValueMetric(other, owner),
+      _resolution(other._resolution),
+      _buckets(NUM_BUCKETS),
+      _count(0),
+      _totalUnits(0),
+      _minUnits(NO_MIN),
+      _maxUnits(0),
+      _last(0.0)
+{
+    merge(other);
+}
+
+HistogramMetric::~HistogramMetric() = default;
+
+uint32_t
+HistogramMetric::bucketOf(uint64_t units)
+{
+    if (units > MAX_UNITS) {
+        units = MAX_UNITS;
+    }
+    if (units < (HALF_SUB_BUCKETS << 1)) {
+        return units;
+    }
+    uint32_t shift = mostSignificantBit(units) - (SUB_BUCKET_BITS - 1);
+    return (shift * HALF_SUB_BUCKETS) + (units >> shift);
+}
+
+uint64_t
+HistogramMetric::bucketStart(uint32_t bucket)
+{
+    if (bucket < (HALF_SUB_BUCKETS << 1)) {
+        return bucket;
+    }
+    uint32_t shift = (bucket / HALF_SUB_BUCKETS) - 1;
+    return uint64_t(HALF_SUB_BUCKETS + (bucket % HALF_SUB_BUCKETS)) << shift;
+}
+
+uint64_t
+HistogramMetric::bucketWidth(uint32_t bucket)
+{
+    if (bucket < (HALF_SUB_BUCKETS << 1)) {
+        return 1;
+    }
+    return uint64_t(1) << ((bucket / HALF_SUB_BUCKETS) - 1);
+}
+
+void
+HistogramMetric::updateMin(uint64_t units)
+{
+    uint64_t current = _minUnits.load(std::memory_order_relaxed);
+    while ((units < current) &&
+           !_minUnits.compare_exchange_weak(current, units, std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+HistogramMetric::updateMax(uint64_t units)
+{
+    uint64_t current = _maxUnits.load(std::memory_order_relaxed);
+    while ((units > current) &&
+           !_maxUnits.compare_exchange_weak(current, units, std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+HistogramMetric::addValue(double value)
+{
+    if (!std::isfinite(value)) {
+        logNonFiniteValueWarning();
+        return;
+    }
+    double scaled = std::max(0.0, value / _resolution) + 0.5;
+    uint64_t units = (scaled < double(MAX_UNITS)) ? uint64_t(scaled) : MAX_UNITS;
+    _buckets[bucketOf(units)].fetch_add(1, std::memory_order_relaxed);
+    _totalUnits.fetch_add(units, std::memory_order_relaxed);
+    updateMin(units);
+    updateMax(units);
+    _last.store(value, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+HistogramMetric::merge(const HistogramMetric& other)
+{
+    uint64_t count = other.getCount();
+    if (count == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i) {
+        uint64_t bucketCount = other._buckets[i].load(std::memory_order_relaxed);
+        if (bucketCount != 0) {
+            _buckets[i].fetch_add(bucketCount, std::memory_order_relaxed);
+        }
+    }
+    _totalUnits.fetch_add(other._totalUnits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    updateMin(other._minUnits.load(std::memory_order_relaxed));
+    updateMax(other._maxUnits.load(std::memory_order_relaxed));
+    _last.store(other._last.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _count.fetch_add(count, std::memory_order_relaxed);
+}
+
+void
+HistogramMetric::reset()
+{
+    for (Counter& bucket : _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _totalUnits.store(0, std::memory_order_relaxed);
+    _minUnits.store(NO_MIN, std::memory_order_relaxed);
+    _maxUnits.store(0, std::memory_order_relaxed);
+    _last.store(0.0, std::memory_order_relaxed);
+}
+
+double
+HistogramMetric::getAverage() const
+{
+    uint64_t count = getCount();
+    if (count == 0) return 0;
+    return (_totalUnits.load(std::memory_order_relaxed) * _resolution) / count;
+}
+
+double
+HistogramMetric::getMinimum() const
+{
+    if (getCount() == 0) return 0;
+    return _minUnits.load(std::memory_order_relaxed) * _resolution;
+}
+
+double
+HistogramMetric::getMaximum() const
+{
+    if (getCount() == 0) return 0;
+    return _maxUnits.load(std::memory_order_relaxed) * _resolution;
+}
+
+double
+HistogramMetric::getQuantile(double quantile) const
+{
+    uint64_t count = getCount();
+    if (count == 0) return 0;
+    quantile = std::min(1.0, std::max(0.0, quantile));
+    uint64_t rank = std::max(uint64_t(1), uint64_t(std::ceil(quantile * count)));
+    uint64_t seen = 0;
+    uint32_t bucket = 0;
+    for (; bucket < NUM_BUCKETS; ++bucket) {
+        seen += _buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            break;
+        }
+    }
+    if (bucket == NUM_BUCKETS) {
+        // counters updated while we were reading
+        return getMaximum();
+    }
+    double midpoint = bucketStart(bucket) + (bucketWidth(bucket) - 1) / 2.0;
+    double units = std::min(double(_maxUnits.load(std::memory_order_relaxed)),
+                            std::max(double(_minUnits.load(std::memory_order_relaxed)), midpoint));
+    return units * _resolution;
+}
+
+MetricValueClass::UP
+HistogramMetric::getValues() const
+{
+    auto values = std::make_unique<ValueMetricValues<double, double>>();
+    values->_count = getCount();
+    values->_total = _totalUnits.load(std::memory_order_relaxed) * _resolution;
+    if (values->_count > 0) {
+        values->_min = getMinimum();
+        values->_max = getMaximum();
+    }
+    values->_last = _last.load(std::memory_order_relaxed);
+    return values;
+}
+
+bool
+HistogramMetric::inUse(const MetricValueClass& v) const
+{
+    return (v.getLongValue("count") != 0);
+}
+
+void
+HistogramMetric::print(std::ostream& out, bool verbose,
+                       const std::string&, uint64_t) const
+{
+    uint64_t count = getCount();
+    if ((count == 0) && !verbose) return;
+    out << getName() << " average=" << getAverage()
+        << " last=" << _last.load(std::memory_order_relaxed);
+    if (count > 0) {
+        out << " min=" << getMinimum() << " max=" << getMaximum()
+            << " p50=" << getQuantile(0.5) << " p99=" << getQuantile(0.99)
+            << " p999=" << getQuantile(0.999);
+    }
+    out << " count=" << count << " total=" << (_totalUnits.load(std::memory_order_relaxed) * _resolution);
+}
+
+int64_t
+HistogramMetric::getLongValue(stringref id) const
+{
+    if (id == "count") return getCount();
+    return static_cast<int64_t>(getDoubleValue(id));
+}
+
+double
+HistogramMetric::getDoubleValue(stringref id) const
+{
+    if (id == "average" || id == "value") return getAverage();
+    if (id == "last") return _last.load(std::memory_order_relaxed);
+    if (id == "count") return getCount();
+    if (id == "total") return _totalUnits.load(std::memory_order_relaxed) * _resolution;
+    if (id == "min") return getMinimum();
+    if (id == "max") return getMaximum();
+    if (id == "p50") return getQuantile(0.5);
+    if (id == "p90") return getQuantile(0.9);
+    if (id == "p95") return getQuantile(0.95);
+    if (id == "p99") return getQuantile(0.99);
+    if (id == "p999") return getQuantile(0.999);
+    throw vespalib::IllegalArgumentException(
+            "No value " + vespalib::string(id) + " in histogram metric.", VESPA_STRLOC);
+}
+
+void
+HistogramMetric::addMemoryUsage(MemoryConsumption& mc) const
+{
+    ++mc._valueMetricCount;
+    mc._valueMetricValues += _buckets.capacity() * sizeof(Counter);
+    mc._valueMetricMeta += sizeof(HistogramMetric) - sizeof(Metric);
+    Metric::addMemoryUsage(mc);
+}
+
+void
+HistogramMetric::printDebug(std::ostream& out, const std::string& indent) const
+{
+    out << "count=" << getCount() << " ";
+    Metric::printDebug(out, indent);
+}
+
+void
+HistogramMetric::addToPart(Metric& other) const
+{
+    static_cast<HistogramMetric&>(other).merge(*this);
+}
+
+void
+HistogramMetric::addToSnapshot(Metric& other, std::vector<Metric::UP>&) const
+{
+    static_cast<HistogramMetric&>(other).merge(*this);
+}
+
+} // metrics
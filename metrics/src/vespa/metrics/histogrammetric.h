@@ -0,0 +1,98 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * @class metrics::HistogramMetric
+ * @ingroup metrics
+ *
+ * @brief Metric recording the distribution of a value, typically a latency.
+ *
+ * Values are counted in log-linear buckets, like a HDR histogram: below 64
+ * units each unit has its own bucket, and above that every power of two is
+ * split into 32 buckets. Quantiles are thus reported with at most 1.6%
+ * relative error. The unit is given by the resolution; values are rounded
+ * to the nearest unit, and values above 2^36 units end up in the last
+ * bucket.
+ *
+ * Recording is lock-free, one relaxed atomic add per bucket and counter.
+ * Histograms are merged bucket by bucket when added to snapshots and sums,
+ * so quantiles stay correct across periods and parts.
+ *
+ * A histogram metric is a value metric to visitors not knowing about
+ * histograms, reporting count, average, min, max and last.
+ */
+
+#pragma once
+
+#include "valuemetric.h"
+#include <atomic>
+#include <vector>
+
+namespace metrics {
+
+class HistogramMetric : public AbstractValueMetric {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 6;
+    static constexpr uint32_t MAX_UNIT_BITS = 36;
+    static constexpr uint32_t NUM_BUCKETS = (MAX_UNIT_BITS - SUB_BUCKET_BITS + 2) << (SUB_BUCKET_BITS - 1);
+
+    HistogramMetric(const String& name, Tags dimensions,
+                    const String& description, double resolution,
+                    MetricSet* owner = nullptr);
+    HistogramMetric(const HistogramMetric& other, CopyType, MetricSet* owner);
+    ~HistogramMetric() override;
+
+    bool visit(MetricVisitor& visitor, bool tagAsAutoGenerated = false) const override {
+        return visitor.visitHistogramMetric(*this, tagAsAutoGenerated);
+    }
+
+    HistogramMetric* clone(std::vector<Metric::UP>&, CopyType type, MetricSet* owner,
+                           bool /*includeUnused*/) const override {
+        return new HistogramMetric(*this, type, owner);
+    }
+
+    void addValue(double value);
+
+    double getResolution() const { return _resolution; }
+    uint64_t getCount() const { return _count.load(std::memory_order_relaxed); }
+    double getAverage() const;
+    double getMinimum() const;
+    double getMaximum() const;
+    /** Value below which the given fraction (0 to 1) of the values are. */
+    double getQuantile(double quantile) const;
+
+    MetricValueClass::UP getValues() const override;
+    bool inUse(const MetricValueClass& v) const override;
+    bool summedAverage() const override { return false; }
+
+    void reset() override;
+    void print(std::ostream&, bool verbose,
+               const std::string& indent, uint64_t secondsPassed) const override;
+    /** Also accepts p50, p90, p95, p99 and p999 as ids. */
+    int64_t getLongValue(stringref id) const override;
+    double getDoubleValue(stringref id) const override;
+    bool used() const override { return (getCount() > 0); }
+    void addMemoryUsage(MemoryConsumption&) const override;
+    void printDebug(std::ostream&, const std::string& indent) const override;
+    void addToPart(Metric&) const override;
+    void addToSnapshot(Metric&, std::vector<Metric::UP>&) const override;
+
+    static uint32_t bucketOf(uint64_t units);
+    static uint64_t bucketStart(uint32_t bucket);
+    static uint64_t bucketWidth(uint32_t bucket);
+
+private:
+    using Counter = std::atomic<uint64_t>;
+
+    void merge(const HistogramMetric& other);
+    void updateMin(uint64_t units);
+    void updateMax(uint64_t units);
+
+    double                 _resolution;
+    std::vector<Counter>   _buckets;
+    Counter                _count;
+    Counter                _totalUnits;
+    Counter                _minUnits;
+    Counter                _maxUnits;
+    std::atomic<double>    _last;
+};
+
+} // metrics
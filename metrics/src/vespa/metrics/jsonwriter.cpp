@@ -3,6 +3,7 @@
 
 #include "countmetric.h"
 #include "valuemetric.h"
+#include "histogrammetric.h"
 #include "metricsnapshot.h"
 
 #include <iterator>
@@ -119,13 +120,11 @@ JsonWriter::visitCountMetric(const AbstractCountMetric& m, bool)
     return true;
 }
 
-bool
-JsonWriter::visitValueMetric(const AbstractValueMetric& m, bool)
+void
+JsonWriter::writeValues(const AbstractValueMetric& m)
 {
-    writeCommonPrefix(m);
     MetricValueClass::UP values(m.getValues());
-    _stream << "values" << Object()
-        << "average";
+    _stream << "average";
     if (values->getLongValue("count") == 0) {
         _stream << 0.0;
     } else {
@@ -145,6 +144,30 @@ JsonWriter::visitValueMetric(const AbstractValueMetric& m, bool)
     values->output("max", _stream);
     _stream << "last";
     values->output("last", _stream);
+}
+
+bool
+JsonWriter::visitValueMetric(const AbstractValueMetric& m, bool)
+{
+    writeCommonPrefix(m);
+    _stream << "values" << Object();
+    writeValues(m);
+    _stream << End();
+    writeCommonPostfix(m);
+    return true;
+}
+
+bool
+JsonWriter::visitHistogramMetric(const HistogramMetric& m, bool)
+{
+    writeCommonPrefix(m);
+    _stream << "values" << Object();
+    writeValues(m);
+    _stream << "p50" << m.getQuantile(0.5)
+            << "p90" << m.getQuantile(0.9)
+            << "p95" << m.getQuantile(0.95)
+            << "p99" << m.getQuantile(0.99)
+            << "p999" << m.getQuantile(0.999);
     _stream << End();
     writeCommonPostfix(m);
     return true;
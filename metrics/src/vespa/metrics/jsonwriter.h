@@ -27,11 +27,13 @@ private:
     void doneVisitingMetricSet(const MetricSet&) override;
     bool visitCountMetric(const AbstractCountMetric&, bool autoGenerated) override;
     bool visitValueMetric(const AbstractValueMetric&, bool autoGenerated) override;
+    bool visitHistogramMetric(const HistogramMetric&, bool autoGenerated) override;
     void doneVisiting() override;
 
     void checkIfArrayNeedsToBeStarted();
     void writeCommonPrefix(const Metric& m);
     void writeCommonPostfix(const Metric& m);
+    void writeValues(const AbstractValueMetric& m);
 
     void writeDimensions(const DimensionSet&);
     void writeInheritedDimensions();
@@ -3,6 +3,7 @@
 #include "metric.h"
 #include "countmetric.h"
 #include "valuemetric.h"
+#include "histogrammetric.h"
 #include "metricset.h"
 #include "memoryconsumption.h"
 #include <vespa/vespalib/text/stringtokenizer.h>
@@ -29,6 +30,12 @@ MetricVisitor::visitValueMetric(const AbstractValueMetric& m, bool autoGenerated
     return visitMetric(m, autoGenerated);
 }
 
+bool
+MetricVisitor::visitHistogramMetric(const HistogramMetric& m, bool autoGenerated)
+{
+    return visitValueMetric(m, autoGenerated);
+}
+
 bool
 MetricVisitor::visitMetric(const Metric&, bool)
 {
@@ -9,6 +9,7 @@ namespace metrics {
 
 struct AbstractCountMetric;
 struct AbstractValueMetric;
+class HistogramMetric;
 class Metric;
 class MetricSet;
 class MetricSnapshot;
@@ -56,6 +57,14 @@ struct MetricVisitor {
      */
     virtual bool visitValueMetric(const AbstractValueMetric& m,
                                   bool autoGenerated);
+    /**
+     * Visit a histogram metric within an accepted metric set. Default
+     * implementation visits it as a value metric.
+     *
+     * @return True if you want to continue visiting, false to abort.
+     */
+    virtual bool visitHistogramMetric(const HistogramMetric& m,
+                                      bool autoGenerated);
 
     /**
      * Visit function for visiting primitive metrics in one function. Only
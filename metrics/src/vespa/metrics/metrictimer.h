@@ -9,6 +9,7 @@
 #pragma once
 
 #include "valuemetric.h"
+#include "histogrammetric.h"
 #include <chrono>
 
 namespace metrics {
@@ -33,6 +34,14 @@ public:
         return deltaMs;
     }
 
+    /** Adds ms passed since this timer was constructed to given histogram. */
+    double stop(HistogramMetric& metric) const {
+        const auto delta = std::chrono::steady_clock::now() - _startTime;
+        const double deltaMs(std::chrono::duration<double, std::milli>(delta).count());
+        metric.addValue(deltaMs);
+        return deltaMs;
+    }
+
 private:
     std::chrono::steady_clock::time_point _startTime;
 };
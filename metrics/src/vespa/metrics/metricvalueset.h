@@ -76,6 +76,23 @@ public:
      */
     bool setValues(const ValueClass& values);
 
+    /**
+     * Apply an update directly to the active values, for updates that can
+     * be done with a single atomic read-modify-write per field. This is
+     * much cheaper than getValues()/setValues(), and concurrent updates
+     * through this function are not lost. Returns false without calling
+     * func if the metric has just been reset, in which case the update
+     * must be done through getValues()/setValues() to clear the reset.
+     */
+    template <typename Func>
+    bool updateActiveValues(Func func) {
+        if (isReset()) {
+            return false;
+        }
+        func(_values[_activeValueIndex.load(std::memory_order_acquire)]);
+        return true;
+    }
+
     /**
      * Retrieve and reset in a single operation, to minimize chance of
      * alteration in the process.
@@ -6,6 +6,14 @@
 
 namespace metrics {
 
+StateApiAdapter::StateApiAdapter(MetricManager &manager)
+    : _manager(manager),
+      _cache()
+{
+}
+
+StateApiAdapter::~StateApiAdapter() = default;
+
 vespalib::string
 StateApiAdapter::getMetrics(const vespalib::string &consumer)
 {
@@ -15,12 +23,19 @@ StateApiAdapter::getMetrics(const vespalib::string &consumer)
         return ""; // no configuration yet
     }
     const metrics::MetricSnapshot &snapshot(_manager.getMetricSnapshot(guard, periods[0]));
+    CachedMetrics &cached = _cache[consumer];
+    if ((cached.from_time == snapshot.getFromTime()) && (cached.to_time == snapshot.getToTime()) && !cached.json.empty()) {
+        return cached.json;
+    }
     vespalib::asciistream json;
     vespalib::JsonStream stream(json);
     metrics::JsonWriter metricJsonWriter(stream);
     _manager.visit(guard, snapshot, metricJsonWriter, consumer);
     stream.finalize();
-    return json.str();
+    cached.from_time = snapshot.getFromTime();
+    cached.to_time = snapshot.getToTime();
+    cached.json = json.str();
+    return cached.json;
 }
 
 vespalib::string
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/net/metrics_producer.h>
+#include <map>
 
 namespace metrics {
 
@@ -12,14 +13,27 @@ class MetricManager;
  * This is an adapter class that implements the metrics producer
  * interface defined by the state api implementation in vespalib by
  * extracting metrics in json format from a metric manager.
+ *
+ * The json rendered for the latest snapshot period is cached per
+ * consumer until the next snapshot is taken, making repeated scrapes
+ * of the same snapshot cheap.
  **/
 class StateApiAdapter : public vespalib::MetricsProducer
 {
 private:
+    struct CachedMetrics {
+        time_t           from_time;
+        time_t           to_time;
+        vespalib::string json;
+    };
+
     MetricManager &_manager;
+    // protected by the metric lock
+    std::map<vespalib::string, CachedMetrics> _cache;
 
 public:
-    StateApiAdapter(MetricManager &manager) : _manager(manager) {}
+    StateApiAdapter(MetricManager &manager);
+    ~StateApiAdapter() override;
 
     vespalib::string getMetrics(const vespalib::string &consumer) override;
     vespalib::string getTotalMetrics(const vespalib::string &consumer) override;
@@ -90,4 +90,19 @@ PersistenceProvider::updateAsync(const Bucket &bucket, Timestamp timestamp, Docu
     onComplete->onComplete(std::make_unique<UpdateResult>(result));
 }
 
+Result
+PersistenceProvider::createBucket(const Bucket& bucket, Context& context) {
+    auto catcher = std::make_unique<CatchResult>();
+    auto future = catcher->future_result();
+    createBucketAsync(bucket, context, std::move(catcher));
+    return *future.get();
+}
+
+void
+PersistenceProvider::createBucketAsync(const Bucket &bucket, Context &context, OperationComplete::UP onComplete)
+{
+    Result result = createBucket(bucket, context);
+    onComplete->onComplete(std::make_unique<Result>(result));
+}
+
 }
@@ -331,8 +331,11 @@ struct PersistenceProvider
     /**
      * Tells the provider that the given bucket has been created in the
      * service layer. There is no requirement to do anything here.
+     * An implementation must always implement atleast createBucket or createBucketAsync.
+     * If not an eternal recursion will occur.
      */
-    virtual Result createBucket(const Bucket&, Context&) = 0;
+    virtual Result createBucket(const Bucket&, Context&);
+    virtual void createBucketAsync(const Bucket&, Context&, OperationComplete::UP);
 
     /**
      * Deletes the given bucket and all entries contained in that bucket.
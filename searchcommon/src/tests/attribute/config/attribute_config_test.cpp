@@ -38,6 +38,9 @@ TEST_F("test default attribute config", Fixture)
     EXPECT_TRUE(!f._config.getEnableOnlyBitVector());
     EXPECT_TRUE(!f._config.getIsFilter());
     EXPECT_TRUE(!f._config.fastAccess());
+    EXPECT_TRUE(!f._config.paged());
+    EXPECT_TRUE(!f._config.compact());
+    EXPECT_TRUE(!f._config.mapped());
     EXPECT_TRUE(f._config.tensorType().is_error());
 }
 
@@ -53,6 +53,19 @@ public:
 
     bool getIsFilter() const { return _isFilter; }
     bool isMutable() const { return _mutable; }
+    bool paged() const { return _paged; }
+
+    /**
+     * Check if a single value integer attribute without fast search should store
+     * its values bit packed in blocks, trading some update cost for memory.
+     */
+    bool compact() const { return _compact; }
+
+    /**
+     * Check if a single value numeric attribute without fast search should read its
+     * values in place from a (copy-on-write) memory mapping of the saved data file.
+     */
+    bool mapped() const { return _mapped; }
 
     /**
      * Check if this attribute should be fast accessible at all times.
@@ -109,6 +122,9 @@ public:
     Config & setIsFilter(bool isFilter) { _isFilter = isFilter; return *this; }
 
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
+    Config & set_paged(bool paged_in) { _paged = paged_in; return *this; }
+    Config & set_compact(bool compact_in) { _compact = compact_in; return *this; }
+    Config & set_mapped(bool mapped_in) { _mapped = mapped_in; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
@@ -125,6 +141,9 @@ private:
     bool           _isFilter;
     bool           _fastAccess;
     bool           _mutable;
+    bool           _paged;
+    bool           _compact;
+    bool           _mapped;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
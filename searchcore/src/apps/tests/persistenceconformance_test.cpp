@@ -7,6 +7,7 @@
 #include <vespa/config-rank-profiles.h>
 #include <vespa/config-summarymap.h>
 #include <vespa/document/base/testdocman.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
 #include <vespa/fastos/file.h>
 #include <vespa/persistence/conformancetest/conformancetest.h>
 #include <vespa/document/repo/documenttyperepo.h>
@@ -164,6 +165,7 @@ private:
     vespalib::string          _tlsSpec;
     matching::QueryLimiter    _queryLimiter;
     vespalib::Clock           _clock;
+    vespalib::eval::ConstantTensorLoader _constantValueFactory;
     mutable DummyWireService  _metricsWireService;
     mutable MemoryConfigStores _config_stores;
     vespalib::ThreadStackExecutor _summaryExecutor;
@@ -199,6 +201,7 @@ public:
                                _tlsSpec,
                                _queryLimiter,
                                _clock,
+                               _constantValueFactory,
                                docType,
                                bucketSpace,
                                *b->getProtonConfigSP(),
@@ -223,6 +226,7 @@ DocumentDBFactory::DocumentDBFactory(const vespalib::string &baseDir, int tlsLis
       _tlsSpec(vespalib::make_string("tcp/localhost:%d", tlsListenPort)),
       _queryLimiter(),
       _clock(),
+      _constantValueFactory(vespalib::eval::EngineOrFactory::get()),
       _metricsWireService(),
       _summaryExecutor(8, 128 * 1024)
 {}
@@ -90,7 +90,8 @@ void
 BmMessageBus::ReplyHandler::handleReply(std::unique_ptr<Reply> reply)
 {
     auto msg_id = reply->getContext().value.UINT64;
-    auto tracker = _pending_hash.release(msg_id);
+    PendingTracker::TimePoint start_time;
+    auto tracker = _pending_hash.release(msg_id, start_time);
     if (tracker != nullptr) {
         bool failed = false;
         if (reply->getType() == 0 || reply->hasErrors()) {
@@ -113,7 +114,7 @@ BmMessageBus::ReplyHandler::handleReply(std::unique_ptr<Reply> reply)
             ++_errors;
             LOG(error, "Unexpected %s", reply_as_string(*reply).c_str());
         }
-        tracker->release();
+        tracker->release(start_time);
     } else {
         ++_errors;
         LOG(error, "Untracked %s", reply_as_string(*reply).c_str());
@@ -124,8 +125,9 @@ void
 BmMessageBus::ReplyHandler::message_aborted(uint64_t msg_id)
 {
     ++_errors;
-    auto tracker = _pending_hash.release(msg_id);
-    tracker->release();
+    PendingTracker::TimePoint start_time;
+    auto tracker = _pending_hash.release(msg_id, start_time);
+    tracker->release(start_time);
 }
 
 BmMessageBus::BmMessageBus(const config::ConfigUri& config_uri,
@@ -25,10 +25,11 @@ BmStorageLink::onDown(const std::shared_ptr<storage::api::StorageMessage>& msg)
 bool
 BmStorageLink::onUp(const std::shared_ptr<storage::api::StorageMessage>& msg)
 {
-    auto tracker = _pending_hash.release(msg->getMsgId());
+    PendingTracker::TimePoint start_time;
+    auto tracker = _pending_hash.release(msg->getMsgId(), start_time);
     if (tracker != nullptr) {
         check_error(*msg);
-        tracker->release();
+        tracker->release(start_time);
         return true;
     }
     return false;
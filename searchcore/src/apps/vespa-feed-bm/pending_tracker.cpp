@@ -10,7 +10,8 @@ PendingTracker::PendingTracker(uint32_t limit)
       _limit(limit),
       _mutex(),
       _cond(),
-      _bucket_info_queue()
+      _bucket_info_queue(),
+      _latencies()
 {
 }
 
@@ -5,7 +5,9 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <vector>
 
 namespace storage::spi { struct PersistenceProvider; }
 
@@ -15,38 +17,48 @@ class BucketInfoQueue;
 
 /*
  * Class to track number of pending operations, used as backpressure during
- * benchmark feeding.
+ * benchmark feeding. Also records the latency of each operation, measured
+ * from when it got a pending slot until it was released.
  */
 class PendingTracker {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+private:
     uint32_t                _pending;
     uint32_t                _limit;
     std::mutex              _mutex;
     std::condition_variable _cond;
     std::unique_ptr<BucketInfoQueue> _bucket_info_queue;
+    std::vector<double>     _latencies;
 
 public:
     PendingTracker(uint32_t limit);
     ~PendingTracker();
 
-    void release() {
+    void release(TimePoint start_time) {
+        std::chrono::duration<double> latency = std::chrono::steady_clock::now() - start_time;
         std::unique_lock<std::mutex> guard(_mutex);
+        _latencies.push_back(latency.count());
         --_pending;
         if (_pending < _limit) {
             _cond.notify_all();
         }
     }
-    void retain() {
+    TimePoint retain() {
         std::unique_lock<std::mutex> guard(_mutex);
         while (_pending >= _limit) {
             _cond.wait(guard);
         }
         ++_pending;
+        return std::chrono::steady_clock::now();
     }
 
     void drain();
 
     void attach_bucket_info_queue(storage::spi::PersistenceProvider& provider, std::atomic<uint32_t>& errors);
     BucketInfoQueue *get_bucket_info_queue() { return _bucket_info_queue.get(); }
+    // Latencies (in seconds) of released operations, only stable after drain()
+    const std::vector<double>& get_latencies() const { return _latencies; }
 };
 
 }
@@ -1,7 +1,6 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "pending_tracker_hash.h"
-#include "pending_tracker.h"
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <cassert>
 
@@ -22,20 +21,21 @@ PendingTrackerHash::~PendingTrackerHash()
 void
 PendingTrackerHash::retain(uint64_t msg_id, PendingTracker &tracker)
 {
-    tracker.retain();
+    auto start_time = tracker.retain();
     std::lock_guard lock(_mutex);
-    _pending.insert(std::make_pair(msg_id, &tracker));
+    _pending.insert(std::make_pair(msg_id, std::make_pair(&tracker, start_time)));
 }
 
 PendingTracker *
-PendingTrackerHash::release(uint64_t msg_id)
+PendingTrackerHash::release(uint64_t msg_id, PendingTracker::TimePoint &start_time)
 {
     std::lock_guard lock(_mutex);
     auto itr = _pending.find(msg_id);
     if (itr == _pending.end()) {
         return nullptr;
     }
-    auto tracker = itr->second;
+    auto tracker = itr->second.first;
+    start_time = itr->second.second;
     _pending.erase(itr);
     return tracker;
 }
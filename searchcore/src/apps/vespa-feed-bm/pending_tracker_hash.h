@@ -2,24 +2,23 @@
 
 #pragma once
 
+#include "pending_tracker.h"
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <mutex>
 
 namespace feedbm {
 
-class PendingTracker;
-
 /*
  * Class maintaing mapping from message id to pending tracker
  */
 class PendingTrackerHash
 {
     std::mutex _mutex;
-    vespalib::hash_map<uint64_t, PendingTracker *> _pending;
+    vespalib::hash_map<uint64_t, std::pair<PendingTracker *, PendingTracker::TimePoint>> _pending;
 public:
     PendingTrackerHash();
     ~PendingTrackerHash();
-    PendingTracker *release(uint64_t msg_id);
+    PendingTracker *release(uint64_t msg_id, PendingTracker::TimePoint &start_time);
     void retain(uint64_t msg_id, PendingTracker &tracker);
 };
 
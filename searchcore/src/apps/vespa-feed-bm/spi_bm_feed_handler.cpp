@@ -36,6 +36,7 @@ class MyOperationComplete : public storage::spi::OperationComplete
     std::atomic<uint32_t> &_errors;
     Bucket _bucket;
     PendingTracker& _tracker;
+    PendingTracker::TimePoint _start_time;
 public:
     MyOperationComplete(std::atomic<uint32_t> &errors, const Bucket& bucket, PendingTracker& tracker);
     ~MyOperationComplete();
@@ -46,14 +47,14 @@ public:
 MyOperationComplete::MyOperationComplete(std::atomic<uint32_t> &errors, const Bucket& bucket, PendingTracker& tracker)
     : _errors(errors),
       _bucket(bucket),
-      _tracker(tracker)
+      _tracker(tracker),
+      _start_time(_tracker.retain())
 {
-    _tracker.retain();
 }
 
 MyOperationComplete::~MyOperationComplete()
 {
-    _tracker.release();
+    _tracker.release(_start_time);
 }
 
 void
@@ -119,10 +120,12 @@ SpiBmFeedHandler::get(const document::Bucket& bucket, vespalib::stringref field_
     get_bucket_info_loop(tracker);
     Bucket spi_bucket(bucket);
     auto field_set = _field_set_repo.getFieldSet(field_set_string);
+    auto start_time = tracker.retain();
     auto result = _provider.get(spi_bucket, *field_set, document_id, context);
     if (result.hasError()) {
         ++_errors;
     }
+    tracker.release(start_time);
 }
 
 void
@@ -48,9 +48,10 @@ public:
     }
     void retain(uint64_t msg_id, PendingTracker &tracker) { _pending_hash.retain(msg_id, tracker); }
     void release(uint64_t msg_id) {
-        auto tracker = _pending_hash.release(msg_id);
+        PendingTracker::TimePoint start_time;
+        auto tracker = _pending_hash.release(msg_id, start_time);
         if (tracker != nullptr) {
-            tracker->release();
+            tracker->release(start_time);
         } else {
             ++_errors;
         }
@@ -26,14 +26,21 @@
 #include <vespa/config-upgrading.h>
 #include <vespa/config/common/configcontext.h>
 #include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/datatype/tensor_data_type.h>
 #include <vespa/document/fieldset/fieldsetrepo.h>
 #include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/tensorfieldvalue.h>
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/document_type_repo_factory.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/test/make_bucket_space.h>
 #include <vespa/document/update/assignvalueupdate.h>
 #include <vespa/document/update/documentupdate.h>
+#include <vespa/document/update/tensor_modify_update.h>
+#include <vespa/eval/eval/engine_or_factory.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/eval/value.h>
 #include <vespa/fastos/app.h>
 #include <vespa/messagebus/config-messagebus.h>
 #include <vespa/messagebus/testlib/slobrok.h>
@@ -73,8 +80,10 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
 #include <getopt.h>
 #include <iostream>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP("vespa-feed-bm");
@@ -126,6 +135,9 @@ using document::Field;
 using document::FieldSetRepo;
 using document::FieldUpdate;
 using document::IntFieldValue;
+using document::TensorDataType;
+using document::TensorFieldValue;
+using document::TensorModifyUpdate;
 using document::test::makeBucketSpace;
 using feedbm::BmClusterController;
 using feedbm::BmMessageBus;
@@ -146,6 +158,8 @@ using storage::rpc::SharedRpcResources;
 using storage::rpc::StorageApiRpcService;
 using storage::spi::PersistenceProvider;
 using vespalib::compression::CompressionConfig;
+using vespalib::eval::EngineOrFactory;
+using vespalib::eval::TensorSpec;
 using vespalib::makeLambdaTask;
 using proton::ThreadingServiceConfig;
 
@@ -154,12 +168,14 @@ using DocumentDBMap = std::map<DocTypeName, std::shared_ptr<DocumentDB>>;
 namespace {
 
 vespalib::string base_dir = "testdb";
+vespalib::string tensor_type_spec = "tensor(x{})";
+constexpr uint32_t document_id_batch_size = 64;
 
 std::shared_ptr<DocumenttypesConfig> make_document_type() {
     using Struct = document::config_builder::Struct;
     using DataType = document::DataType;
     document::config_builder::DocumenttypesConfigBuilderHelper builder;
-    builder.document(42, "test", Struct("test.header").addField("int", DataType::T_INT), Struct("test.body"));
+    builder.document(42, "test", Struct("test.header").addField("int", DataType::T_INT).addTensorField("tensor", tensor_type_spec), Struct("test.body"));
     return std::make_shared<DocumenttypesConfig>(builder.config());
 }
 
@@ -169,6 +185,11 @@ std::shared_ptr<AttributesConfig> make_attributes_config() {
     attribute.name = "int";
     attribute.datatype = AttributesConfig::Attribute::Datatype::INT32;
     builder.attribute.emplace_back(attribute);
+    AttributesConfig::Attribute tensor_attribute;
+    tensor_attribute.name = "tensor";
+    tensor_attribute.datatype = AttributesConfig::Attribute::Datatype::TENSOR;
+    tensor_attribute.tensortype = tensor_type_spec;
+    builder.attribute.emplace_back(tensor_attribute);
     return std::make_shared<AttributesConfig>(builder);
 }
 
@@ -267,6 +288,7 @@ class BMParams {
     uint32_t _client_threads;
     uint32_t _get_passes;
     vespalib::string _indexing_sequencer;
+    uint32_t _mixed_passes;
     uint32_t _put_passes;
     uint32_t _update_passes;
     uint32_t _remove_passes;
@@ -281,6 +303,7 @@ class BMParams {
     bool     _use_message_bus;
     bool     _use_storage_chain;
     bool     _use_legacy_bucket_db;
+    bool     _tensor_updates;
     uint32_t get_start(uint32_t thread_id) const {
         return (_documents / _client_threads) * thread_id + std::min(thread_id, _documents % _client_threads);
     }
@@ -290,6 +313,7 @@ public:
           _client_threads(1),
           _get_passes(0),
           _indexing_sequencer(),
+          _mixed_passes(0),
           _put_passes(2),
           _update_passes(1),
           _remove_passes(2),
@@ -303,7 +327,8 @@ public:
           _use_document_api(false),
           _use_message_bus(false),
           _use_storage_chain(false),
-          _use_legacy_bucket_db(false)
+          _use_legacy_bucket_db(false),
+          _tensor_updates(false)
     {
     }
     BMRange get_range(uint32_t thread_id) const {
@@ -314,6 +339,7 @@ public:
     uint32_t get_client_threads() const { return _client_threads; }
     uint32_t get_get_passes() const { return _get_passes; }
     const vespalib::string & get_indexing_sequencer() const { return _indexing_sequencer; }
+    uint32_t get_mixed_passes() const { return _mixed_passes; }
     uint32_t get_put_passes() const { return _put_passes; }
     uint32_t get_update_passes() const { return _update_passes; }
     uint32_t get_remove_passes() const { return _remove_passes; }
@@ -326,11 +352,13 @@ public:
     bool get_use_message_bus() const { return _use_message_bus; }
     bool get_use_storage_chain() const { return _use_storage_chain; }
     bool get_use_legacy_bucket_db() const { return _use_legacy_bucket_db; }
+    bool get_tensor_updates() const { return _tensor_updates; }
     void set_documents(uint32_t documents_in) { _documents = documents_in; }
     void set_max_pending(uint32_t max_pending_in) { _max_pending = max_pending_in; }
     void set_client_threads(uint32_t threads_in) { _client_threads = threads_in; }
     void set_get_passes(uint32_t get_passes_in) { _get_passes = get_passes_in; }
     void set_indexing_sequencer(vespalib::stringref sequencer) { _indexing_sequencer = sequencer; }
+    void set_mixed_passes(uint32_t mixed_passes_in) { _mixed_passes = mixed_passes_in; }
     void set_put_passes(uint32_t put_passes_in) { _put_passes = put_passes_in; }
     void set_update_passes(uint32_t update_passes_in) { _update_passes = update_passes_in; }
     void set_remove_passes(uint32_t remove_passes_in) { _remove_passes = remove_passes_in; }
@@ -344,6 +372,7 @@ public:
     void set_use_message_bus(bool use_message_bus_in) { _use_message_bus = use_message_bus_in; }
     void set_use_storage_chain(bool use_storage_chain_in) { _use_storage_chain = use_storage_chain_in; }
     void set_use_legacy_bucket_db(bool use_legacy_bucket_db_in) { _use_legacy_bucket_db = use_legacy_bucket_db_in; }
+    void set_tensor_updates(bool tensor_updates_in) { _tensor_updates = tensor_updates_in; }
     bool check() const;
     bool needs_service_layer() const { return _enable_service_layer || _enable_distributor || _use_storage_chain || _use_message_bus || _use_document_api; }
     bool needs_distributor() const { return _enable_distributor || _use_document_api; }
@@ -625,6 +654,9 @@ struct PersistenceProviderFixture {
     DocTypeName                                _doc_type_name;
     const DocumentType*                        _document_type;
     const Field&                               _field;
+    const Field&                               _tensor_field;
+    const TensorDataType&                      _tensor_data_type;
+    bool                                       _tensor_updates;
     std::shared_ptr<DocumentDBConfig>          _document_db_config;
     vespalib::string                           _base_dir;
     DummyFileHeaderContext                     _file_header_context;
@@ -641,6 +673,7 @@ struct PersistenceProviderFixture {
     vespalib::string                           _tls_spec;
     matching::QueryLimiter                     _query_limiter;
     vespalib::Clock                            _clock;
+    vespalib::eval::ConstantTensorLoader       _constant_value_factory;
     DummyWireService                           _metrics_wire_service;
     MemoryConfigStores                         _config_stores;
     vespalib::ThreadStackExecutor              _summary_executor;
@@ -676,6 +709,7 @@ struct PersistenceProviderFixture {
     DocumentId make_document_id(uint32_t n, uint32_t i) const;
     std::unique_ptr<Document> make_document(uint32_t n, uint32_t i) const;
     std::unique_ptr<DocumentUpdate> make_document_update(uint32_t n, uint32_t i) const;
+    std::unique_ptr<TensorFieldValue> make_tensor_field_value(double value) const;
     void create_buckets();
     void wait_slobrok(const vespalib::string &name);
     void start_service_layer(const BMParams& params);
@@ -694,6 +728,9 @@ PersistenceProviderFixture::PersistenceProviderFixture(const BMParams& params)
       _doc_type_name("test"),
       _document_type(_repo->getDocumentType(_doc_type_name.getName())),
       _field(_document_type->getField("int")),
+      _tensor_field(_document_type->getField("tensor")),
+      _tensor_data_type(dynamic_cast<const TensorDataType &>(_tensor_field.getDataType())),
+      _tensor_updates(params.get_tensor_updates()),
       _document_db_config(make_document_db_config(_document_types, _repo, _doc_type_name)),
       _base_dir(base_dir),
       _file_header_context(),
@@ -710,6 +747,7 @@ PersistenceProviderFixture::PersistenceProviderFixture(const BMParams& params)
       _tls_spec(vespalib::make_string("tcp/localhost:%d", _tls_listen_port)),
       _query_limiter(),
       _clock(),
+      _constant_value_factory(vespalib::eval::EngineOrFactory::get()),
       _metrics_wire_service(),
       _config_stores(),
       _summary_executor(8, 128 * 1024),
@@ -791,6 +829,7 @@ PersistenceProviderFixture::create_document_db(const BMParams & params)
                                                 _tls_spec,
                                                 _query_limiter,
                                                 _clock,
+                                                _constant_value_factory,
                                                 _doc_type_name,
                                                 _bucket_space,
                                                 *bootstrap_config->getProtonConfigSP(),
@@ -821,6 +860,9 @@ PersistenceProviderFixture::make_document(uint32_t n, uint32_t i) const
     auto document = std::make_unique<Document>(*_document_type, id);
     document->setRepo(*_repo);
     document->setFieldValue(_field, std::make_unique<IntFieldValue>(i));
+    if (_tensor_updates) {
+        document->setFieldValue(_tensor_field, make_tensor_field_value(i));
+    }
     return document;
 }
 
@@ -829,10 +871,22 @@ PersistenceProviderFixture::make_document_update(uint32_t n, uint32_t i) const
 {
     auto id = make_document_id(n, i);
     auto document_update = std::make_unique<DocumentUpdate>(*_repo, *_document_type, id);
-    document_update->addUpdate(FieldUpdate(_field).addUpdate(AssignValueUpdate(IntFieldValue(15))));
+    if (_tensor_updates) {
+        document_update->addUpdate(FieldUpdate(_tensor_field).addUpdate(TensorModifyUpdate(TensorModifyUpdate::Operation::ADD, make_tensor_field_value(1.0))));
+    } else {
+        document_update->addUpdate(FieldUpdate(_field).addUpdate(AssignValueUpdate(IntFieldValue(15))));
+    }
     return document_update;
 }
 
+std::unique_ptr<TensorFieldValue>
+PersistenceProviderFixture::make_tensor_field_value(double value) const
+{
+    auto result = std::make_unique<TensorFieldValue>(_tensor_data_type);
+    *result = EngineOrFactory::get().from_spec(TensorSpec(tensor_type_spec).add({{"x", "0"}}, value));
+    return result;
+}
+
 void
 PersistenceProviderFixture::create_buckets()
 {
@@ -1027,8 +1081,41 @@ make_feed(vespalib::ThreadStackExecutor &executor, const BMParams &bm_params, st
     return serialized_feed_v;
 }
 
+/*
+ * Collects operation latencies (in seconds) reported by the pending
+ * trackers of the client threads, and summarizes them as percentiles.
+ */
+class LatencySampler {
+    std::mutex          _lock;
+    std::vector<double> _latencies;
+public:
+    LatencySampler() : _lock(), _latencies() {}
+    void sample(const std::vector<double>& latencies) {
+        std::lock_guard guard(_lock);
+        _latencies.insert(_latencies.end(), latencies.begin(), latencies.end());
+    }
+    void merge(LatencySampler& rhs) {
+        std::lock_guard guard(rhs._lock);
+        sample(rhs._latencies);
+    }
+    vespalib::string summary();
+};
+
+vespalib::string
+LatencySampler::summary()
+{
+    std::lock_guard guard(_lock);
+    if (_latencies.empty()) {
+        return "latency ms: n/a";
+    }
+    std::sort(_latencies.begin(), _latencies.end());
+    auto percentile = [this](double p) { return _latencies[std::min(_latencies.size() - 1, static_cast<size_t>(p * _latencies.size()))] * 1000.0; };
+    return vespalib::make_string("latency ms: p50=%.3f, p90=%.3f, p99=%.3f, max=%.3f",
+                                 percentile(0.50), percentile(0.90), percentile(0.99), _latencies.back() * 1000.0);
+}
+
 void
-put_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed, int64_t time_bias)
+put_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed, int64_t time_bias, LatencySampler& latencies)
 {
     LOG(debug, "put_async_task([%u..%u))", range.get_start(), range.get_end());
     feedbm::PendingTracker pending_tracker(max_pending);
@@ -1046,6 +1133,7 @@ put_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange rang
     }
     assert(is.empty());
     pending_tracker.drain();
+    latencies.sample(pending_tracker.get_latencies());
 }
 
 class AvgSampler {
@@ -1064,14 +1152,15 @@ public:
 
 void
 run_put_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor& executor, int pass, int64_t& time_bias,
-                    const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler)
+                    const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler, LatencySampler& latencies)
 {
     uint32_t old_errors = f._feed_handler->get_error_count();
+    LatencySampler pass_latencies;
     auto start_time = std::chrono::steady_clock::now();
     for (uint32_t i = 0; i < bm_params.get_client_threads(); ++i) {
         auto range = bm_params.get_range(i);
-        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range, time_bias]()
-                                        { put_async_task(f, max_pending, range, serialized_feed, time_bias); }));
+        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range, time_bias, &pass_latencies]()
+                                        { put_async_task(f, max_pending, range, serialized_feed, time_bias, pass_latencies); }));
     }
     executor.sync();
     auto end_time = std::chrono::steady_clock::now();
@@ -1079,7 +1168,8 @@ run_put_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor
     uint32_t new_errors = f._feed_handler->get_error_count() - old_errors;
     double throughput = bm_params.get_documents() / elapsed.count();
     sampler.sample(throughput);
-    LOG(info, "putAsync: pass=%u, errors=%u, puts/s: %8.2f", pass, new_errors, throughput);
+    LOG(info, "putAsync: pass=%u, errors=%u, puts/s: %8.2f, %s", pass, new_errors, throughput, pass_latencies.summary().c_str());
+    latencies.merge(pass_latencies);
     time_bias += bm_params.get_documents();
 }
 
@@ -1098,7 +1188,7 @@ make_update_feed(PersistenceProviderFixture &f, BMRange range, BucketSelector bu
 }
 
 void
-update_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed, int64_t time_bias)
+update_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed, int64_t time_bias, LatencySampler& latencies)
 {
     LOG(debug, "update_async_task([%u..%u))", range.get_start(), range.get_end());
     feedbm::PendingTracker pending_tracker(max_pending);
@@ -1116,18 +1206,20 @@ update_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange r
     }
     assert(is.empty());
     pending_tracker.drain();
+    latencies.sample(pending_tracker.get_latencies());
 }
 
 void
 run_update_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor& executor, int pass, int64_t& time_bias,
-                       const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler)
+                       const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler, LatencySampler& latencies)
 {
     uint32_t old_errors = f._feed_handler->get_error_count();
+    LatencySampler pass_latencies;
     auto start_time = std::chrono::steady_clock::now();
     for (uint32_t i = 0; i < bm_params.get_client_threads(); ++i) {
         auto range = bm_params.get_range(i);
-        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range, time_bias]()
-                                        { update_async_task(f, max_pending, range, serialized_feed, time_bias); }));
+        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range, time_bias, &pass_latencies]()
+                                        { update_async_task(f, max_pending, range, serialized_feed, time_bias, pass_latencies); }));
     }
     executor.sync();
     auto end_time = std::chrono::steady_clock::now();
@@ -1135,39 +1227,66 @@ run_update_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecu
     uint32_t new_errors = f._feed_handler->get_error_count() - old_errors;
     double throughput = bm_params.get_documents() / elapsed.count();
     sampler.sample(throughput);
-    LOG(info, "updateAsync: pass=%u, errors=%u, updates/s: %8.2f", pass, new_errors, throughput);
+    LOG(info, "updateAsync: pass=%u, errors=%u, updates/s: %8.2f, %s", pass, new_errors, throughput, pass_latencies.summary().c_str());
+    latencies.merge(pass_latencies);
     time_bias += bm_params.get_documents();
 }
 
+/*
+ * Reads the next batch of bucket ids and document ids from a serialized
+ * get or remove feed, calculating the global ids of the whole batch at
+ * once instead of one at a time when the operations are handled.
+ */
+void
+read_document_id_batch(vespalib::nbostream &is, uint32_t count, std::vector<BucketId> &bucket_ids, std::vector<DocumentId> &document_ids)
+{
+    bucket_ids.clear();
+    document_ids.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        bucket_ids.emplace_back();
+        is >> bucket_ids.back();
+        document_ids.emplace_back(is);
+    }
+    std::vector<const DocumentId *> document_id_ptrs;
+    for (const auto &document_id : document_ids) {
+        document_id_ptrs.push_back(&document_id);
+    }
+    DocumentId::calculateGlobalIds(document_id_ptrs.data(), document_id_ptrs.size());
+}
+
 void
-get_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed)
+get_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed, LatencySampler& latencies)
 {
     LOG(debug, "get_async_task([%u..%u))", range.get_start(), range.get_end());
     feedbm::PendingTracker pending_tracker(max_pending);
     vespalib::nbostream is(serialized_feed.data(), serialized_feed.size());
-    BucketId bucket_id;
+    std::vector<BucketId> bucket_ids;
+    std::vector<DocumentId> document_ids;
     vespalib::string all_fields(document::AllFields::NAME);
     auto bucket_space = f._bucket_space;
-    for (unsigned int i = range.get_start(); i < range.get_end(); ++i) {
-        is >> bucket_id;
-        document::Bucket bucket(bucket_space, bucket_id);
-        DocumentId document_id(is);
-        f._feed_handler->get(bucket, all_fields, document_id, pending_tracker);
+    for (unsigned int i = range.get_start(); i < range.get_end(); i += document_id_batch_size) {
+        read_document_id_batch(is, std::min(document_id_batch_size, range.get_end() - i), bucket_ids, document_ids);
+        for (uint32_t j = 0; j < document_ids.size(); ++j) {
+            document::Bucket bucket(bucket_space, bucket_ids[j]);
+            f._feed_handler->get(bucket, all_fields, document_ids[j], pending_tracker);
+        }
     }
     assert(is.empty());
     pending_tracker.drain();
+    latencies.sample(pending_tracker.get_latencies());
 }
 
 void
 run_get_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor& executor, int pass,
-                       const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler)
+                       const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler, LatencySampler& latencies)
 {
     uint32_t old_errors = f._feed_handler->get_error_count();
+    LatencySampler pass_latencies;
     auto start_time = std::chrono::steady_clock::now();
     for (uint32_t i = 0; i < bm_params.get_client_threads(); ++i) {
         auto range = bm_params.get_range(i);
-        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range]()
-                                        { get_async_task(f, max_pending, range, serialized_feed); }));
+        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range, &pass_latencies]()
+                                        { get_async_task(f, max_pending, range, serialized_feed, pass_latencies); }));
     }
     executor.sync();
     auto end_time = std::chrono::steady_clock::now();
@@ -1175,7 +1294,8 @@ run_get_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor
     uint32_t new_errors = f._feed_handler->get_error_count() - old_errors;
     double throughput = bm_params.get_documents() / elapsed.count();
     sampler.sample(throughput);
-    LOG(info, "getAsync: pass=%u, errors=%u, gets/s: %8.2f", pass, new_errors, throughput);
+    LOG(info, "getAsync: pass=%u, errors=%u, gets/s: %8.2f, %s", pass, new_errors, throughput, pass_latencies.summary().c_str());
+    latencies.merge(pass_latencies);
 }
 
 vespalib::nbostream
@@ -1194,35 +1314,39 @@ make_remove_feed(PersistenceProviderFixture &f, BMRange range, BucketSelector bu
 }
 
 void
-remove_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed, int64_t time_bias)
+remove_async_task(PersistenceProviderFixture &f, uint32_t max_pending, BMRange range, const vespalib::nbostream &serialized_feed, int64_t time_bias, LatencySampler& latencies)
 {
     LOG(debug, "remove_async_task([%u..%u))", range.get_start(), range.get_end());
     feedbm::PendingTracker pending_tracker(max_pending);
     f._feed_handler->attach_bucket_info_queue(pending_tracker);
     vespalib::nbostream is(serialized_feed.data(), serialized_feed.size());
-    BucketId bucket_id;
+    std::vector<BucketId> bucket_ids;
+    std::vector<DocumentId> document_ids;
     auto bucket_space = f._bucket_space;
     bool use_timestamp = !f._feed_handler->manages_timestamp();
-    for (unsigned int i = range.get_start(); i < range.get_end(); ++i) {
-        is >> bucket_id;
-        document::Bucket bucket(bucket_space, bucket_id);
-        DocumentId document_id(is);
-        f._feed_handler->remove(bucket, document_id, (use_timestamp ? (time_bias + i) : 0), pending_tracker);
+    for (unsigned int i = range.get_start(); i < range.get_end(); i += document_id_batch_size) {
+        read_document_id_batch(is, std::min(document_id_batch_size, range.get_end() - i), bucket_ids, document_ids);
+        for (uint32_t j = 0; j < document_ids.size(); ++j) {
+            document::Bucket bucket(bucket_space, bucket_ids[j]);
+            f._feed_handler->remove(bucket, document_ids[j], (use_timestamp ? (time_bias + i + j) : 0), pending_tracker);
+        }
     }
     assert(is.empty());
     pending_tracker.drain();
+    latencies.sample(pending_tracker.get_latencies());
 }
 
 void
 run_remove_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor& executor, int pass, int64_t& time_bias,
-                       const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler)
+                       const std::vector<vespalib::nbostream>& serialized_feed_v, const BMParams& bm_params, AvgSampler& sampler, LatencySampler& latencies)
 {
     uint32_t old_errors = f._feed_handler->get_error_count();
+    LatencySampler pass_latencies;
     auto start_time = std::chrono::steady_clock::now();
     for (uint32_t i = 0; i < bm_params.get_client_threads(); ++i) {
         auto range = bm_params.get_range(i);
-        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range, time_bias]()
-                                        { remove_async_task(f, max_pending, range, serialized_feed, time_bias); }));
+        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = serialized_feed_v[i], range, time_bias, &pass_latencies]()
+                                        { remove_async_task(f, max_pending, range, serialized_feed, time_bias, pass_latencies); }));
     }
     executor.sync();
     auto end_time = std::chrono::steady_clock::now();
@@ -1230,7 +1354,8 @@ run_remove_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecu
     uint32_t new_errors = f._feed_handler->get_error_count() - old_errors;
     double throughput = bm_params.get_documents() / elapsed.count();
     sampler.sample(throughput);
-    LOG(info, "removeAsync: pass=%u, errors=%u, removes/s: %8.2f", pass, new_errors, throughput);
+    LOG(info, "removeAsync: pass=%u, errors=%u, removes/s: %8.2f, %s", pass, new_errors, throughput, pass_latencies.summary().c_str());
+    latencies.merge(pass_latencies);
     time_bias += bm_params.get_documents();
 }
 
@@ -1239,12 +1364,13 @@ benchmark_async_put(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor
                     int64_t& time_bias, const std::vector<vespalib::nbostream>& feed, const BMParams& params)
 {
     AvgSampler sampler;
+    LatencySampler latencies;
     LOG(info, "--------------------------------");
     LOG(info, "putAsync: %u small documents, passes=%u", params.get_documents(), params.get_put_passes());
     for (uint32_t pass = 0; pass < params.get_put_passes(); ++pass) {
-        run_put_async_tasks(f, executor, pass, time_bias, feed, params, sampler);
+        run_put_async_tasks(f, executor, pass, time_bias, feed, params, sampler, latencies);
     }
-    LOG(info, "putAsync: AVG puts/s: %8.2f", sampler.avg());
+    LOG(info, "putAsync: AVG puts/s: %8.2f, %s", sampler.avg(), latencies.summary().c_str());
 }
 
 void
@@ -1255,12 +1381,13 @@ benchmark_async_update(PersistenceProviderFixture& f, vespalib::ThreadStackExecu
         return;
     }
     AvgSampler sampler;
+    LatencySampler latencies;
     LOG(info, "--------------------------------");
     LOG(info, "updateAsync: %u small documents, passes=%u", params.get_documents(), params.get_update_passes());
     for (uint32_t pass = 0; pass < params.get_update_passes(); ++pass) {
-        run_update_async_tasks(f, executor, pass, time_bias, feed, params, sampler);
+        run_update_async_tasks(f, executor, pass, time_bias, feed, params, sampler, latencies);
     }
-    LOG(info, "updateAsync: AVG updates/s: %8.2f", sampler.avg());
+    LOG(info, "updateAsync: AVG updates/s: %8.2f, %s", sampler.avg(), latencies.summary().c_str());
 }
 
 void
@@ -1273,10 +1400,74 @@ benchmark_async_get(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor
     LOG(info, "--------------------------------");
     LOG(info, "getAsync: %u small documents, passes=%u", params.get_documents(), params.get_get_passes());
     AvgSampler sampler;
+    LatencySampler latencies;
     for (uint32_t pass = 0; pass < params.get_get_passes(); ++pass) {
-        run_get_async_tasks(f, executor, pass, feed, params, sampler);
+        run_get_async_tasks(f, executor, pass, feed, params, sampler, latencies);
+    }
+    LOG(info, "getAsync: AVG gets/s: %8.2f, %s", sampler.avg(), latencies.summary().c_str());
+}
+
+/*
+ * Run updates and gets concurrently, each client thread having both an
+ * update task and a get task. Throughput and latency are reported
+ * separately for each kind of operation.
+ */
+void
+run_mixed_async_tasks(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor& executor, int pass, int64_t& time_bias,
+                      const std::vector<vespalib::nbostream>& update_feed_v, const std::vector<vespalib::nbostream>& get_feed_v,
+                      const BMParams& bm_params, AvgSampler& update_sampler, AvgSampler& get_sampler,
+                      LatencySampler& update_latencies, LatencySampler& get_latencies)
+{
+    using TimePoint = std::chrono::steady_clock::time_point;
+    uint32_t old_errors = f._feed_handler->get_error_count();
+    LatencySampler pass_update_latencies;
+    LatencySampler pass_get_latencies;
+    std::vector<TimePoint> update_end_times(bm_params.get_client_threads());
+    std::vector<TimePoint> get_end_times(bm_params.get_client_threads());
+    auto start_time = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < bm_params.get_client_threads(); ++i) {
+        auto range = bm_params.get_range(i);
+        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = update_feed_v[i], range, time_bias, &pass_update_latencies, &end_time = update_end_times[i]]()
+                                        { update_async_task(f, max_pending, range, serialized_feed, time_bias, pass_update_latencies);
+                                          end_time = std::chrono::steady_clock::now(); }));
+        executor.execute(makeLambdaTask([&f, max_pending = bm_params.get_max_pending(), &serialized_feed = get_feed_v[i], range, &pass_get_latencies, &end_time = get_end_times[i]]()
+                                        { get_async_task(f, max_pending, range, serialized_feed, pass_get_latencies);
+                                          end_time = std::chrono::steady_clock::now(); }));
     }
-    LOG(info, "getAsync: AVG gets/s: %8.2f", sampler.avg());
+    executor.sync();
+    std::chrono::duration<double> update_elapsed = *std::max_element(update_end_times.begin(), update_end_times.end()) - start_time;
+    std::chrono::duration<double> get_elapsed = *std::max_element(get_end_times.begin(), get_end_times.end()) - start_time;
+    uint32_t new_errors = f._feed_handler->get_error_count() - old_errors;
+    double update_throughput = bm_params.get_documents() / update_elapsed.count();
+    double get_throughput = bm_params.get_documents() / get_elapsed.count();
+    update_sampler.sample(update_throughput);
+    get_sampler.sample(get_throughput);
+    LOG(info, "mixedAsync: pass=%u, errors=%u, updates/s: %8.2f, %s", pass, new_errors, update_throughput, pass_update_latencies.summary().c_str());
+    LOG(info, "mixedAsync: pass=%u, gets/s: %8.2f, %s", pass, get_throughput, pass_get_latencies.summary().c_str());
+    update_latencies.merge(pass_update_latencies);
+    get_latencies.merge(pass_get_latencies);
+    time_bias += bm_params.get_documents();
+}
+
+void
+benchmark_async_mixed(PersistenceProviderFixture& f, vespalib::ThreadStackExecutor& executor, int64_t& time_bias,
+                      const std::vector<vespalib::nbostream>& update_feed, const std::vector<vespalib::nbostream>& get_feed,
+                      const BMParams& params)
+{
+    if (params.get_mixed_passes() == 0) {
+        return;
+    }
+    LOG(info, "--------------------------------");
+    LOG(info, "mixedAsync: %u small documents, passes=%u", params.get_documents(), params.get_mixed_passes());
+    AvgSampler update_sampler;
+    AvgSampler get_sampler;
+    LatencySampler update_latencies;
+    LatencySampler get_latencies;
+    for (uint32_t pass = 0; pass < params.get_mixed_passes(); ++pass) {
+        run_mixed_async_tasks(f, executor, pass, time_bias, update_feed, get_feed, params, update_sampler, get_sampler, update_latencies, get_latencies);
+    }
+    LOG(info, "mixedAsync: AVG updates/s: %8.2f, %s", update_sampler.avg(), update_latencies.summary().c_str());
+    LOG(info, "mixedAsync: AVG gets/s: %8.2f, %s", get_sampler.avg(), get_latencies.summary().c_str());
 }
 
 void
@@ -1289,10 +1480,11 @@ benchmark_async_remove(PersistenceProviderFixture& f, vespalib::ThreadStackExecu
     LOG(info, "--------------------------------");
     LOG(info, "removeAsync: %u small documents, passes=%u", params.get_documents(), params.get_remove_passes());
     AvgSampler sampler;
+    LatencySampler latencies;
     for (uint32_t pass = 0; pass < params.get_remove_passes(); ++pass) {
-        run_remove_async_tasks(f, executor, pass, time_bias, feed, params, sampler);
+        run_remove_async_tasks(f, executor, pass, time_bias, feed, params, sampler, latencies);
     }
-    LOG(info, "removeAsync: AVG removes/s: %8.2f", sampler.avg());
+    LOG(info, "removeAsync: AVG removes/s: %8.2f, %s", sampler.avg(), latencies.summary().c_str());
 }
 
 void benchmark_async_spi(const BMParams &bm_params)
@@ -1316,7 +1508,8 @@ void benchmark_async_spi(const BMParams &bm_params)
         f.start_message_bus();
     }
     f.create_feed_handler(bm_params);
-    vespalib::ThreadStackExecutor executor(bm_params.get_client_threads(), 128 * 1024);
+    // mixed passes run an update task and a get task per client thread
+    vespalib::ThreadStackExecutor executor(bm_params.get_client_threads() * 2, 128 * 1024);
     auto put_feed = make_feed(executor, bm_params, [&f](BMRange range, BucketSelector bucket_selector) { return make_put_feed(f, range, bucket_selector); }, f.num_buckets(), "put");
     auto update_feed = make_feed(executor, bm_params, [&f](BMRange range, BucketSelector bucket_selector) { return make_update_feed(f, range, bucket_selector); }, f.num_buckets(), "update");
     auto remove_feed = make_feed(executor, bm_params, [&f](BMRange range, BucketSelector bucket_selector) { return make_remove_feed(f, range, bucket_selector); }, f.num_buckets(), "remove");
@@ -1325,6 +1518,7 @@ void benchmark_async_spi(const BMParams &bm_params)
     benchmark_async_put(f, executor, time_bias, put_feed, bm_params);
     benchmark_async_update(f, executor, time_bias, update_feed, bm_params);
     benchmark_async_get(f, executor, remove_feed, bm_params);
+    benchmark_async_mixed(f, executor, time_bias, update_feed, remove_feed, bm_params);
     benchmark_async_remove(f, executor, time_bias, remove_feed, bm_params);
     LOG(info, "--------------------------------");
 
@@ -1365,6 +1559,7 @@ App::usage()
         "[--get-passes get-passes]\n"
         "[--indexing-sequencer [latency,throughput,adaptive]]\n"
         "[--max-pending max-pending]\n"
+        "[--mixed-passes mixed-passes]\n"
         "[--documents documents]\n"
         "[--put-passes put-passes]\n"
         "[--update-passes update-passes]\n"
@@ -1375,6 +1570,7 @@ App::usage()
         "[--enable-distributor]\n"
         "[--enable-service-layer]\n"
         "[--skip-get-spi-bucket-info]\n"
+        "[--tensor-updates]\n"
         "[--use-document-api]\n"
         "[--use-message-bus\n"
         "[--use-storage-chain]\n"
@@ -1395,6 +1591,7 @@ App::get_options()
         { "get-passes", 1, nullptr, 0 },
         { "indexing-sequencer", 1, nullptr, 0 },
         { "max-pending", 1, nullptr, 0 },
+        { "mixed-passes", 1, nullptr, 0 },
         { "put-passes", 1, nullptr, 0 },
         { "update-passes", 1, nullptr, 0 },
         { "remove-passes", 1, nullptr, 0 },
@@ -1402,6 +1599,7 @@ App::get_options()
         { "rpc-network-threads", 1, nullptr, 0 },
         { "rpc-targets-per-node", 1, nullptr, 0 },
         { "skip-get-spi-bucket-info", 0, nullptr, 0 },
+        { "tensor-updates", 0, nullptr, 0 },
         { "use-document-api", 0, nullptr, 0 },
         { "use-legacy-bucket-db", 0, nullptr, 0 },
         { "use-message-bus", 0, nullptr, 0 },
@@ -1415,6 +1613,7 @@ App::get_options()
         LONGOPT_GET_PASSES,
         LONGOPT_INDEXING_SEQUENCER,
         LONGOPT_MAX_PENDING,
+        LONGOPT_MIXED_PASSES,
         LONGOPT_PUT_PASSES,
         LONGOPT_UPDATE_PASSES,
         LONGOPT_REMOVE_PASSES,
@@ -1422,6 +1621,7 @@ App::get_options()
         LONGOPT_RPC_NETWORK_THREADS,
         LONGOPT_RPC_TARGETS_PER_NODE,
         LONGOPT_SKIP_GET_SPI_BUCKET_INFO,
+        LONGOPT_TENSOR_UPDATES,
         LONGOPT_USE_DOCUMENT_API,
         LONGOPT_USE_LEGACY_BUCKET_DB,
         LONGOPT_USE_MESSAGE_BUS,
@@ -1454,6 +1654,9 @@ App::get_options()
             case LONGOPT_MAX_PENDING:
                 _bm_params.set_max_pending(atoi(opt_argument));
                 break;
+            case LONGOPT_MIXED_PASSES:
+                _bm_params.set_mixed_passes(atoi(opt_argument));
+                break;
             case LONGOPT_PUT_PASSES:
                 _bm_params.set_put_passes(atoi(opt_argument));
                 break;
@@ -1475,6 +1678,9 @@ App::get_options()
             case LONGOPT_SKIP_GET_SPI_BUCKET_INFO:
                 _bm_params.set_skip_get_spi_bucket_info(true);
                 break;
+            case LONGOPT_TENSOR_UPDATES:
+                _bm_params.set_tensor_updates(true);
+                break;
             case LONGOPT_USE_DOCUMENT_API:
                 _bm_params.set_use_document_api(true);
                 break;
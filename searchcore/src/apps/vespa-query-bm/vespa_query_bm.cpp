@@ -0,0 +1,848 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <tests/proton/common/dummydbowner.h>
+#include <vespa/config-attributes.h>
+#include <vespa/config-bucketspaces.h>
+#include <vespa/config-imported-fields.h>
+#include <vespa/config-indexschema.h>
+#include <vespa/config-rank-profiles.h>
+#include <vespa/config-summary.h>
+#include <vespa/config-summarymap.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/document/repo/document_type_repo_factory.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/test/make_bucket_space.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/fastos/app.h>
+#include <vespa/metrics/loadtype.h>
+#include <vespa/persistence/spi/persistenceprovider.h>
+#include <vespa/searchcommon/common/schemaconfigurer.h>
+#include <vespa/searchcore/proton/common/hw_info.h>
+#include <vespa/searchcore/proton/matching/querylimiter.h>
+#include <vespa/searchcore/proton/metrics/metricswireservice.h>
+#include <vespa/searchcore/proton/persistenceengine/ipersistenceengineowner.h>
+#include <vespa/searchcore/proton/persistenceengine/persistenceengine.h>
+#include <vespa/searchcore/proton/server/bootstrapconfig.h>
+#include <vespa/searchcore/proton/server/document_db_maintenance_config.h>
+#include <vespa/searchcore/proton/server/documentdb.h>
+#include <vespa/searchcore/proton/server/documentdbconfigmanager.h>
+#include <vespa/searchcore/proton/server/fileconfigmanager.h>
+#include <vespa/searchcore/proton/server/memoryconfigstore.h>
+#include <vespa/searchcore/proton/server/persistencehandlerproxy.h>
+#include <vespa/searchcore/proton/server/threading_service_config.h>
+#include <vespa/searchlib/engine/docsumreply.h>
+#include <vespa/searchlib/engine/docsumrequest.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/searchsummary/config/config-juniperrc.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <cinttypes>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-query-bm");
+
+using namespace cloud::config::filedistribution;
+using namespace proton;
+using namespace std::chrono_literals;
+using namespace vespa::config::search::core;
+using namespace vespa::config::search::summary;
+using namespace vespa::config::search;
+using vespa::config::content::core::BucketspacesConfig;
+
+using document::BucketId;
+using document::BucketIdFactory;
+using document::BucketSpace;
+using document::Document;
+using document::DocumentId;
+using document::DocumentType;
+using document::DocumentTypeRepo;
+using document::DocumentTypeRepoFactory;
+using document::DocumenttypesConfig;
+using document::Field;
+using document::IntFieldValue;
+using document::test::makeBucketSpace;
+using search::TuneFileDocumentDB;
+using search::engine::DocsumReply;
+using search::engine::DocsumRequest;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::index::DummyFileHeaderContext;
+using search::index::Schema;
+using search::index::SchemaBuilder;
+using search::query::QueryBuilder;
+using search::query::SimpleQueryNodeTypes;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+using search::transactionlog::TransLogServer;
+using storage::spi::PersistenceProvider;
+using vespalib::SimpleThreadBundle;
+using vespalib::makeLambdaTask;
+
+namespace {
+
+vespalib::string base_dir = "testdb";
+
+storage::spi::LoadType default_load_type(0, "default");
+storage::spi::Context context(default_load_type, storage::spi::Priority(0), storage::spi::Trace::TraceLevel(0));
+
+std::shared_ptr<DocumenttypesConfig> make_document_type() {
+    using Struct = document::config_builder::Struct;
+    using DataType = document::DataType;
+    document::config_builder::DocumenttypesConfigBuilderHelper builder;
+    builder.document(42, "test", Struct("test.header").addField("int", DataType::T_INT), Struct("test.body"));
+    return std::make_shared<DocumenttypesConfig>(builder.config());
+}
+
+std::shared_ptr<AttributesConfig> make_attributes_config() {
+    AttributesConfigBuilder builder;
+    AttributesConfig::Attribute attribute;
+    attribute.name = "int";
+    attribute.datatype = AttributesConfig::Attribute::Datatype::INT32;
+    attribute.fastsearch = true;
+    builder.attribute.emplace_back(attribute);
+    return std::make_shared<AttributesConfig>(builder);
+}
+
+std::shared_ptr<RankProfilesConfig> make_rank_profiles_config() {
+    RankProfilesConfigBuilder builder;
+    RankProfilesConfigBuilder::Rankprofile rank_profile;
+    rank_profile.name = "default";
+    builder.rankprofile.emplace_back(rank_profile);
+    return std::make_shared<RankProfilesConfig>(builder);
+}
+
+std::shared_ptr<SummaryConfig> make_summary_config() {
+    SummaryConfigBuilder builder;
+    SummaryConfigBuilder::Classes summary_class;
+    summary_class.id = 0;
+    summary_class.name = "default";
+    SummaryConfigBuilder::Classes::Fields field;
+    field.name = "int";
+    field.type = "integer";
+    summary_class.fields.emplace_back(field);
+    builder.defaultsummaryid = 0;
+    builder.classes.emplace_back(summary_class);
+    return std::make_shared<SummaryConfig>(builder);
+}
+
+std::shared_ptr<SummarymapConfig> make_summarymap_config() {
+    SummarymapConfigBuilder builder;
+    SummarymapConfigBuilder::Override attribute_override;
+    attribute_override.field = "int";
+    attribute_override.command = "attribute";
+    attribute_override.arguments = "int";
+    builder.override.emplace_back(attribute_override);
+    return std::make_shared<SummarymapConfig>(builder);
+}
+
+std::shared_ptr<DocumentDBConfig> make_document_db_config(std::shared_ptr<DocumenttypesConfig> document_types, std::shared_ptr<const DocumentTypeRepo> repo, const DocTypeName& doc_type_name)
+{
+    auto indexschema = std::make_shared<IndexschemaConfig>();
+    auto attributes = make_attributes_config();
+    auto summary = make_summary_config();
+    std::shared_ptr<Schema> schema(new Schema());
+    SchemaBuilder::build(*indexschema, *schema);
+    SchemaBuilder::build(*attributes, *schema);
+    SchemaBuilder::build(*summary, *schema);
+    return std::make_shared<DocumentDBConfig>(
+            1,
+            make_rank_profiles_config(),
+            std::make_shared<matching::RankingConstants>(),
+            std::make_shared<matching::OnnxModels>(),
+            indexschema,
+            attributes,
+            summary,
+            make_summarymap_config(),
+            std::make_shared<JuniperrcConfig>(),
+            document_types,
+            repo,
+            std::make_shared<ImportedFieldsConfig>(),
+            std::make_shared<TuneFileDocumentDB>(),
+            schema,
+            std::make_shared<DocumentDBMaintenanceConfig>(),
+            search::LogDocumentStore::Config(),
+            std::make_shared<const ThreadingServiceConfig>(ThreadingServiceConfig::make(1)),
+            "client",
+            doc_type_name.getName());
+}
+
+class MyPersistenceEngineOwner : public IPersistenceEngineOwner
+{
+    void setClusterState(BucketSpace, const storage::spi::ClusterState &) override { }
+};
+
+struct MyResourceWriteFilter : public IResourceWriteFilter
+{
+    bool acceptWriteOperation() const override { return true; }
+    State getAcceptState() const override { return IResourceWriteFilter::State(); }
+};
+
+class BMParams {
+    uint32_t _documents;
+    uint32_t _values;
+    uint32_t _client_threads;
+    uint32_t _threads_per_search;
+    uint32_t _queries;
+    uint32_t _passes;
+    uint32_t _hits;
+    bool     _docsums;
+    vespalib::string _corpus_file;
+    vespalib::string _query_file;
+public:
+    BMParams()
+        : _documents(160000),
+          _values(1000),
+          _client_threads(1),
+          _threads_per_search(1),
+          _queries(10000),
+          _passes(2),
+          _hits(10),
+          _docsums(false),
+          _corpus_file(),
+          _query_file()
+    {
+    }
+    uint32_t get_documents() const { return _documents; }
+    uint32_t get_values() const { return _values; }
+    uint32_t get_client_threads() const { return _client_threads; }
+    uint32_t get_threads_per_search() const { return _threads_per_search; }
+    uint32_t get_queries() const { return _queries; }
+    uint32_t get_passes() const { return _passes; }
+    uint32_t get_hits() const { return _hits; }
+    bool get_docsums() const { return _docsums; }
+    const vespalib::string & get_corpus_file() const { return _corpus_file; }
+    const vespalib::string & get_query_file() const { return _query_file; }
+    void set_documents(uint32_t documents_in) { _documents = documents_in; }
+    void set_values(uint32_t values_in) { _values = values_in; }
+    void set_client_threads(uint32_t threads_in) { _client_threads = threads_in; }
+    void set_threads_per_search(uint32_t threads_in) { _threads_per_search = threads_in; }
+    void set_queries(uint32_t queries_in) { _queries = queries_in; }
+    void set_passes(uint32_t passes_in) { _passes = passes_in; }
+    void set_hits(uint32_t hits_in) { _hits = hits_in; }
+    void set_docsums(bool docsums_in) { _docsums = docsums_in; }
+    void set_corpus_file(vespalib::stringref corpus_file_in) { _corpus_file = corpus_file_in; }
+    void set_query_file(vespalib::stringref query_file_in) { _query_file = query_file_in; }
+    bool check() const;
+};
+
+bool
+BMParams::check() const
+{
+    if (_client_threads < 1) {
+        std::cerr << "Too few client threads: " << _client_threads << std::endl;
+        return false;
+    }
+    if (_client_threads > 256) {
+        std::cerr << "Too many client threads: " << _client_threads << std::endl;
+        return false;
+    }
+    if (_threads_per_search < 1) {
+        std::cerr << "Too few threads per search: " << _threads_per_search << std::endl;
+        return false;
+    }
+    if (_corpus_file.empty() && _documents < 1) {
+        std::cerr << "Too few documents: " << _documents << std::endl;
+        return false;
+    }
+    if (_values < 1) {
+        std::cerr << "Too few values: " << _values << std::endl;
+        return false;
+    }
+    if (_query_file.empty() && _queries < 1) {
+        std::cerr << "Too few queries: " << _queries << std::endl;
+        return false;
+    }
+    if (_passes < 1) {
+        std::cerr << "Passes too low: " << _passes << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Document db with a persistence engine in front of it, used to load
+ * the corpus and to run queries and docsum requests in-process.
+ */
+struct QueryBmFixture {
+    std::shared_ptr<DocumenttypesConfig>       _document_types;
+    std::shared_ptr<const DocumentTypeRepo>    _repo;
+    DocTypeName                                _doc_type_name;
+    const DocumentType*                        _document_type;
+    const Field&                               _field;
+    std::shared_ptr<DocumentDBConfig>          _document_db_config;
+    vespalib::string                           _base_dir;
+    DummyFileHeaderContext                     _file_header_context;
+    int                                        _tls_listen_port;
+    TransLogServer                             _tls;
+    vespalib::string                           _tls_spec;
+    matching::QueryLimiter                     _query_limiter;
+    vespalib::Clock                            _clock;
+    vespalib::eval::ConstantTensorLoader       _constant_value_factory;
+    DummyWireService                           _metrics_wire_service;
+    MemoryConfigStores                         _config_stores;
+    vespalib::ThreadStackExecutor              _summary_executor;
+    DummyDBOwner                               _document_db_owner;
+    BucketSpace                                _bucket_space;
+    std::shared_ptr<DocumentDB>                _document_db;
+    MyPersistenceEngineOwner                   _persistence_owner;
+    MyResourceWriteFilter                      _write_filter;
+    std::shared_ptr<PersistenceEngine>         _persistence_engine;
+    BucketIdFactory                            _bucket_id_factory;
+    uint32_t                                   _bucket_bits;
+
+    QueryBmFixture();
+    ~QueryBmFixture();
+    void create_document_db();
+    uint32_t num_buckets() const { return (1u << _bucket_bits); }
+    document::Bucket make_bucket(const DocumentId &id) const;
+    std::unique_ptr<Document> make_document(uint32_t i, uint32_t value) const;
+    void create_buckets();
+    bool put(std::unique_ptr<Document> document, uint64_t timestamp);
+};
+
+QueryBmFixture::QueryBmFixture()
+    : _document_types(make_document_type()),
+      _repo(DocumentTypeRepoFactory::make(*_document_types)),
+      _doc_type_name("test"),
+      _document_type(_repo->getDocumentType(_doc_type_name.getName())),
+      _field(_document_type->getField("int")),
+      _document_db_config(make_document_db_config(_document_types, _repo, _doc_type_name)),
+      _base_dir(base_dir),
+      _file_header_context(),
+      _tls_listen_port(9017),
+      _tls("tls", _tls_listen_port, _base_dir, _file_header_context),
+      _tls_spec(vespalib::make_string("tcp/localhost:%d", _tls_listen_port)),
+      _query_limiter(),
+      _clock(),
+      _constant_value_factory(vespalib::eval::EngineOrFactory::get()),
+      _metrics_wire_service(),
+      _config_stores(),
+      _summary_executor(8, 128 * 1024),
+      _document_db_owner(),
+      _bucket_space(makeBucketSpace(_doc_type_name.getName())),
+      _document_db(),
+      _persistence_owner(),
+      _write_filter(),
+      _persistence_engine(),
+      _bucket_id_factory(),
+      _bucket_bits(8)
+{
+    create_document_db();
+    _persistence_engine = std::make_unique<PersistenceEngine>(_persistence_owner, _write_filter, -1, false);
+    auto proxy = std::make_shared<PersistenceHandlerProxy>(_document_db);
+    _persistence_engine->putHandler(_persistence_engine->getWLock(), _bucket_space, _doc_type_name, proxy);
+}
+
+QueryBmFixture::~QueryBmFixture()
+{
+    if (_persistence_engine) {
+        _persistence_engine->destroyIterators();
+        _persistence_engine->removeHandler(_persistence_engine->getWLock(), _bucket_space, _doc_type_name);
+    }
+    if (_document_db) {
+        _document_db->close();
+    }
+}
+
+void
+QueryBmFixture::create_document_db()
+{
+    vespalib::mkdir(_base_dir, false);
+    vespalib::mkdir(_base_dir + "/" + _doc_type_name.getName(), false);
+    vespalib::string input_cfg = _base_dir + "/" + _doc_type_name.getName() + "/baseconfig";
+    {
+        FileConfigManager fileCfg(input_cfg, "", _doc_type_name.getName());
+        fileCfg.saveConfig(*_document_db_config, 1);
+    }
+    config::DirSpec spec(input_cfg + "/config-1");
+    auto tuneFileDocDB = std::make_shared<TuneFileDocumentDB>();
+    DocumentDBConfigHelper mgr(spec, _doc_type_name.getName());
+    auto bootstrap_config = std::make_shared<BootstrapConfig>(1,
+                                                              _document_types,
+                                                              _repo,
+                                                              std::make_shared<ProtonConfigBuilder>(),
+                                                              std::make_shared<FiledistributorrpcConfig>(),
+                                                              std::make_shared<BucketspacesConfig>(),
+                                                              tuneFileDocDB, HwInfo());
+    mgr.forwardConfig(bootstrap_config);
+    mgr.nextGeneration(0ms);
+    _document_db = std::make_shared<DocumentDB>(_base_dir,
+                                                mgr.getConfig(),
+                                                _tls_spec,
+                                                _query_limiter,
+                                                _clock,
+                                                _constant_value_factory,
+                                                _doc_type_name,
+                                                _bucket_space,
+                                                *bootstrap_config->getProtonConfigSP(),
+                                                _document_db_owner,
+                                                _summary_executor,
+                                                _summary_executor,
+                                                _tls,
+                                                _metrics_wire_service,
+                                                _file_header_context,
+                                                _config_stores.getConfigStore(_doc_type_name.toString()),
+                                                std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024),
+                                                HwInfo());
+    _document_db->start();
+    _document_db->waitForOnlineState();
+}
+
+document::Bucket
+QueryBmFixture::make_bucket(const DocumentId &id) const
+{
+    BucketId bucket_id(_bucket_bits, _bucket_id_factory.getBucketId(id).getRawId());
+    return document::Bucket(_bucket_space, bucket_id.stripUnused());
+}
+
+std::unique_ptr<Document>
+QueryBmFixture::make_document(uint32_t i, uint32_t value) const
+{
+    DocumentId id(vespalib::make_string("id::test::%u", i));
+    auto document = std::make_unique<Document>(*_document_type, id);
+    document->setRepo(*_repo);
+    document->setFieldValue(_field, std::make_unique<IntFieldValue>(value));
+    return document;
+}
+
+void
+QueryBmFixture::create_buckets()
+{
+    for (uint32_t i = 0; i < num_buckets(); ++i) {
+        BucketId bucket_id(_bucket_bits, i);
+        // AbstractPersistenceProvider::createBucket() is a no-op, use the default that forwards to createBucketAsync()
+        _persistence_engine->PersistenceProvider::createBucket(storage::spi::Bucket(document::Bucket(_bucket_space, bucket_id)), context);
+    }
+}
+
+bool
+QueryBmFixture::put(std::unique_ptr<Document> document, uint64_t timestamp)
+{
+    storage::spi::Bucket bucket(make_bucket(document->getId()));
+    auto result = _persistence_engine->put(bucket, storage::spi::Timestamp(timestamp), std::move(document), context);
+    return !result.hasError();
+}
+
+/*
+ * Generates documents where the int field cycles through the
+ * configured number of distinct values.
+ */
+uint32_t
+load_generated_corpus(QueryBmFixture &f, const BMParams &params)
+{
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < params.get_documents(); ++i) {
+        if (!f.put(f.make_document(i, i % params.get_values()), i + 1)) {
+            ++errors;
+        }
+    }
+    return errors;
+}
+
+/*
+ * Loads documents serialized back to back, as in the feed.dat file
+ * written by vespa-dump-feed. The documents must be of the 'test'
+ * document type used by this benchmark.
+ */
+uint32_t
+load_dumped_corpus(QueryBmFixture &f, const vespalib::string &file_name, uint32_t &documents)
+{
+    vespalib::nbostream is;
+    {
+        vespalib::File file(file_name);
+        file.open(vespalib::File::READONLY);
+        size_t file_size = file.stat()._size;
+        is.reserve(file_size);
+        auto buf = std::make_unique<char[]>(file_size);
+        file.read(buf.get(), file_size, 0);
+        is.write(buf.get(), file_size);
+    }
+    uint32_t errors = 0;
+    documents = 0;
+    while (!is.empty()) {
+        auto document = std::make_unique<Document>(*f._repo, is);
+        if (!f.put(std::move(document), documents + 1)) {
+            ++errors;
+        }
+        ++documents;
+    }
+    return errors;
+}
+
+/*
+ * Builds the serialized query tree for one line of the query log. The
+ * line holds whitespace separated terms for the int field, which are
+ * or'ed together. Terms can be plain numbers or ranges like [10;20].
+ */
+vespalib::string
+make_stack_dump(const vespalib::string &line)
+{
+    std::vector<vespalib::string> terms;
+    std::istringstream is(line);
+    std::string term;
+    while (is >> term) {
+        terms.emplace_back(term);
+    }
+    if (terms.empty()) {
+        return vespalib::string();
+    }
+    QueryBuilder<SimpleQueryNodeTypes> builder;
+    if (terms.size() > 1) {
+        builder.addOr(terms.size());
+    }
+    int32_t id = 0;
+    for (const auto &t : terms) {
+        builder.addNumberTerm(t, "int", ++id, Weight(100));
+    }
+    return StackDumpCreator::create(*builder.build());
+}
+
+std::vector<vespalib::string>
+make_queries(const BMParams &params)
+{
+    std::vector<vespalib::string> queries;
+    if (!params.get_query_file().empty()) {
+        std::ifstream input(params.get_query_file());
+        if (!input) {
+            throw vespalib::IllegalArgumentException(vespalib::make_string("Cannot open query file '%s'", params.get_query_file().c_str()));
+        }
+        std::string line;
+        while (std::getline(input, line)) {
+            auto stack_dump = make_stack_dump(line);
+            if (!stack_dump.empty()) {
+                queries.emplace_back(std::move(stack_dump));
+            }
+        }
+    } else {
+        // Mix of single term, two term and range queries
+        uint32_t values = params.get_values();
+        for (uint32_t i = 0; i < params.get_queries(); ++i) {
+            uint32_t value = (i * 7919u) % values;
+            switch (i % 3) {
+            case 0:
+                queries.emplace_back(make_stack_dump(vespalib::make_string("%u", value)));
+                break;
+            case 1:
+                queries.emplace_back(make_stack_dump(vespalib::make_string("%u %u", value, (value + 1) % values)));
+                break;
+            default:
+                queries.emplace_back(make_stack_dump(vespalib::make_string("[%u;%u]", value, value + 10)));
+                break;
+            }
+        }
+    }
+    return queries;
+}
+
+double
+get_cpu_seconds()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+class AvgSampler {
+private:
+    double _total;
+    size_t _samples;
+
+public:
+    AvgSampler() : _total(0), _samples(0) {}
+    void sample(double val) {
+        _total += val;
+        ++_samples;
+    }
+    double avg() const { return _total / (double)_samples; }
+};
+
+/*
+ * Latencies (in seconds) for all queries in a pass, summarized as
+ * percentiles.
+ */
+vespalib::string
+latency_summary(std::vector<double> &latencies)
+{
+    if (latencies.empty()) {
+        return "latency ms: n/a";
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) { return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))] * 1000.0; };
+    return vespalib::make_string("latency ms: p50=%.3f, p90=%.3f, p99=%.3f, max=%.3f",
+                                 percentile(0.50), percentile(0.90), percentile(0.99), latencies.back() * 1000.0);
+}
+
+struct QueryStats {
+    std::vector<double> latencies;
+    uint64_t            hits;
+    uint32_t            errors;
+    QueryStats() : latencies(), hits(0), errors(0) {}
+};
+
+void
+query_task(QueryBmFixture &f, SimpleThreadBundle::Pool &thread_bundle_pool, const BMParams &params,
+           const std::vector<vespalib::string> &queries, uint32_t thread_id, QueryStats &stats)
+{
+    LOG(debug, "query_task(thread=%u)", thread_id);
+    stats.latencies.reserve(queries.size() / params.get_client_threads() + 1);
+    for (size_t i = thread_id; i < queries.size(); i += params.get_client_threads()) {
+        const auto &stack_dump = queries[i];
+        auto start_time = std::chrono::steady_clock::now();
+        SearchRequest request;
+        request.setTimeout(60s);
+        request.maxhits = params.get_hits();
+        request.stackDump.assign(stack_dump.data(), stack_dump.data() + stack_dump.size());
+        auto bundle = thread_bundle_pool.obtain();
+        auto reply = f._document_db->match(request, *bundle);
+        thread_bundle_pool.release(std::move(bundle));
+        if (!reply || !reply->valid) {
+            ++stats.errors;
+        } else {
+            stats.hits += reply->hits.size();
+            if (params.get_docsums() && !reply->hits.empty()) {
+                DocsumRequest docsum_request;
+                docsum_request.setTimeout(60s);
+                docsum_request.resultClassName = "default";
+                for (const auto &hit : reply->hits) {
+                    docsum_request.hits.emplace_back(hit.gid);
+                }
+                auto docsum_reply = f._document_db->getDocsums(docsum_request);
+                if (!docsum_reply) {
+                    ++stats.errors;
+                }
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        stats.latencies.push_back(elapsed.count());
+    }
+}
+
+void
+run_query_tasks(QueryBmFixture &f, vespalib::ThreadStackExecutor &executor, SimpleThreadBundle::Pool &thread_bundle_pool,
+                int pass, const std::vector<vespalib::string> &queries, const BMParams &params,
+                AvgSampler &qps_sampler, AvgSampler &cpu_sampler)
+{
+    std::vector<QueryStats> stats(params.get_client_threads());
+    double start_cpu = get_cpu_seconds();
+    auto start_time = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < params.get_client_threads(); ++i) {
+        executor.execute(makeLambdaTask([&f, &thread_bundle_pool, &params, &queries, i, &thread_stats = stats[i]]()
+                                        { query_task(f, thread_bundle_pool, params, queries, i, thread_stats); }));
+    }
+    executor.sync();
+    auto end_time = std::chrono::steady_clock::now();
+    double cpu = get_cpu_seconds() - start_cpu;
+    std::chrono::duration<double> elapsed = end_time - start_time;
+    std::vector<double> latencies;
+    uint64_t hits = 0;
+    uint32_t errors = 0;
+    for (auto &thread_stats : stats) {
+        latencies.insert(latencies.end(), thread_stats.latencies.begin(), thread_stats.latencies.end());
+        hits += thread_stats.hits;
+        errors += thread_stats.errors;
+    }
+    double throughput = queries.size() / elapsed.count();
+    double cpu_per_query = cpu * 1000.0 / queries.size();
+    qps_sampler.sample(throughput);
+    cpu_sampler.sample(cpu_per_query);
+    LOG(info, "query: pass=%u, errors=%u, hits=%" PRIu64 ", queries/s: %8.2f, cpu ms/query: %.3f, %s",
+        pass, errors, hits, throughput, cpu_per_query, latency_summary(latencies).c_str());
+}
+
+void
+benchmark_queries(const BMParams &params)
+{
+    vespalib::rmdir(base_dir, true);
+    QueryBmFixture f;
+    LOG(info, "start initialize");
+    f._persistence_engine->initialize();
+    LOG(info, "create %u buckets", f.num_buckets());
+    f.create_buckets();
+    auto start_time = std::chrono::steady_clock::now();
+    uint32_t documents = params.get_documents();
+    uint32_t errors = 0;
+    if (!params.get_corpus_file().empty()) {
+        LOG(info, "load corpus from '%s'", params.get_corpus_file().c_str());
+        errors = load_dumped_corpus(f, params.get_corpus_file(), documents);
+    } else {
+        LOG(info, "generate corpus of %u small documents", documents);
+        errors = load_generated_corpus(f, params);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    LOG(info, "loaded %u documents, errors=%u, puts/s: %8.2f", documents, errors, documents / elapsed.count());
+    auto queries = make_queries(params);
+    vespalib::ThreadStackExecutor executor(params.get_client_threads(), 128 * 1024);
+    SimpleThreadBundle::Pool thread_bundle_pool(params.get_threads_per_search());
+    AvgSampler qps_sampler;
+    AvgSampler cpu_sampler;
+    LOG(info, "--------------------------------");
+    LOG(info, "query: %zu queries, passes=%u, client threads=%u, threads per search=%u, docsums=%s",
+        queries.size(), params.get_passes(), params.get_client_threads(), params.get_threads_per_search(),
+        (params.get_docsums() ? "true" : "false"));
+    for (uint32_t pass = 0; pass < params.get_passes(); ++pass) {
+        run_query_tasks(f, executor, thread_bundle_pool, pass, queries, params, qps_sampler, cpu_sampler);
+    }
+    LOG(info, "query: AVG queries/s: %8.2f, cpu ms/query: %.3f", qps_sampler.avg(), cpu_sampler.avg());
+    LOG(info, "--------------------------------");
+}
+
+}
+
+class App : public FastOS_Application
+{
+    BMParams _bm_params;
+public:
+    App();
+    ~App() override;
+    void usage();
+    bool get_options();
+    int Main() override;
+};
+
+App::App()
+    : _bm_params()
+{
+}
+
+App::~App() = default;
+
+void
+App::usage()
+{
+    std::cerr <<
+        "vespa-query-bm version 0.0\n"
+        "\n"
+        "USAGE:\n";
+    std::cerr <<
+        "vespa-query-bm\n"
+        "[--client-threads threads]\n"
+        "[--corpus-file feed.dat]\n"
+        "[--docsums]\n"
+        "[--documents documents]\n"
+        "[--hits hits]\n"
+        "[--passes passes]\n"
+        "[--queries queries]\n"
+        "[--query-file query-file]\n"
+        "[--threads-per-search threads]\n"
+        "[--values values]\n"
+        "\n"
+        "Each line in the query file holds whitespace separated terms for the\n"
+        "'int' field, e.g. '42', '17 4711' or '[10;20]'. Terms on a line are or'ed." << std::endl;
+}
+
+bool
+App::get_options()
+{
+    int c;
+    const char *opt_argument = nullptr;
+    int long_opt_index = 0;
+    static struct option long_opts[] = {
+        { "client-threads", 1, nullptr, 0 },
+        { "corpus-file", 1, nullptr, 0 },
+        { "docsums", 0, nullptr, 0 },
+        { "documents", 1, nullptr, 0 },
+        { "hits", 1, nullptr, 0 },
+        { "passes", 1, nullptr, 0 },
+        { "queries", 1, nullptr, 0 },
+        { "query-file", 1, nullptr, 0 },
+        { "threads-per-search", 1, nullptr, 0 },
+        { "values", 1, nullptr, 0 }
+    };
+    enum longopts_enum {
+        LONGOPT_CLIENT_THREADS,
+        LONGOPT_CORPUS_FILE,
+        LONGOPT_DOCSUMS,
+        LONGOPT_DOCUMENTS,
+        LONGOPT_HITS,
+        LONGOPT_PASSES,
+        LONGOPT_QUERIES,
+        LONGOPT_QUERY_FILE,
+        LONGOPT_THREADS_PER_SEARCH,
+        LONGOPT_VALUES
+    };
+    int opt_index = 1;
+    resetOptIndex(opt_index);
+    while ((c = GetOptLong("", opt_argument, opt_index, long_opts, &long_opt_index)) != -1) {
+        switch (c) {
+        case 0:
+            switch(long_opt_index) {
+            case LONGOPT_CLIENT_THREADS:
+                _bm_params.set_client_threads(atoi(opt_argument));
+                break;
+            case LONGOPT_CORPUS_FILE:
+                _bm_params.set_corpus_file(opt_argument);
+                break;
+            case LONGOPT_DOCSUMS:
+                _bm_params.set_docsums(true);
+                break;
+            case LONGOPT_DOCUMENTS:
+                _bm_params.set_documents(atoi(opt_argument));
+                break;
+            case LONGOPT_HITS:
+                _bm_params.set_hits(atoi(opt_argument));
+                break;
+            case LONGOPT_PASSES:
+                _bm_params.set_passes(atoi(opt_argument));
+                break;
+            case LONGOPT_QUERIES:
+                _bm_params.set_queries(atoi(opt_argument));
+                break;
+            case LONGOPT_QUERY_FILE:
+                _bm_params.set_query_file(opt_argument);
+                break;
+            case LONGOPT_THREADS_PER_SEARCH:
+                _bm_params.set_threads_per_search(atoi(opt_argument));
+                break;
+            case LONGOPT_VALUES:
+                _bm_params.set_values(atoi(opt_argument));
+                break;
+            default:
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+    return _bm_params.check();
+}
+
+int
+App::Main()
+{
+    if (!get_options()) {
+        usage();
+        return 1;
+    }
+    benchmark_queries(_bm_params);
+    return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+    DummyFileHeaderContext::setCreator("vespa-query-bm");
+    App app;
+    auto exit_value = app.Entry(argc, argv);
+    vespalib::rmdir(base_dir, true);
+    return exit_value;
+}
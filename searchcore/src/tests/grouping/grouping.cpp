@@ -245,6 +245,25 @@ TEST_F("testGroupingManager", DoomFixture()) {
     ASSERT_TRUE(!manager.empty());
 }
 
+TEST_F("require that relevance order is only needed by groupings that do not resort", DoomFixture()) {
+    Grouping ordered;
+    ordered.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0"))));
+    Grouping resort;
+    resort.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0")))
+                          .addOrderBy(MU<AttributeNode>("attr1"), false));
+    ASSERT_TRUE(!ordered.needResort());
+    ASSERT_TRUE(resort.needResort());
+
+    GroupingContext resortContext(f1.clock, f1.timeOfDoom);
+    resortContext.addGrouping(GroupingContext::GroupingPtr(new Grouping(resort)));
+    EXPECT_FALSE(GroupingManager(resortContext).needRelevanceOrder());
+
+    GroupingContext mixedContext(f1.clock, f1.timeOfDoom);
+    mixedContext.addGrouping(GroupingContext::GroupingPtr(new Grouping(resort)));
+    mixedContext.addGrouping(GroupingContext::GroupingPtr(new Grouping(ordered)));
+    EXPECT_TRUE(GroupingManager(mixedContext).needRelevanceOrder());
+}
+
 TEST_F("testGroupingSession", DoomFixture()) {
     MyWorld world;
     world.basicSetup();
@@ -238,6 +238,7 @@ struct ParallelAttributeManager
     std::shared_ptr<AttributeManager::SP> mgr;
     vespalib::ThreadStackExecutor masterExecutor;
     ExecutorThreadService master;
+    AttributeLoadProgress::SP loadProgress;
     AttributeManagerInitializer::SP initializer;
 
     ParallelAttributeManager(search::SerialNum configSerialNum, AttributeManager::SP baseAttrMgr,
@@ -256,10 +257,12 @@ ParallelAttributeManager::ParallelAttributeManager(search::SerialNum configSeria
       mgr(std::make_shared<AttributeManager::SP>()),
       masterExecutor(1, 128 * 1024),
       master(masterExecutor),
+      loadProgress(std::make_shared<AttributeLoadProgress>()),
       initializer(std::make_shared<AttributeManagerInitializer>(configSerialNum, documentMetaStoreInitTask,
                                                                 documentMetaStore, baseAttrMgr, attrCfg,
                                                                 attributeGrow, attributeGrowNumDocs,
-                                                                fastAccessAttributesOnly, master, mgr))
+                                                                fastAccessAttributesOnly, master, mgr,
+                                                                loadProgress))
 {
     documentMetaStore->setCommittedDocIdLimit(docIdLimit);
     vespalib::ThreadStackExecutor executor(3, 128 * 1024);
@@ -732,6 +735,10 @@ TEST_F("require that attributes can be initialized and loaded in parallel", Base
         TEST_DO(validateAttribute(*a2->get()));
         AttributeGuard::UP a3 = newMgr.mgr->get()->getAttribute("a3");
         TEST_DO(validateAttribute(*a3->get()));
+        EXPECT_EQUAL(3u, newMgr.loadProgress->getRegistered());
+        EXPECT_EQUAL(3u, newMgr.loadProgress->getLoaded());
+        EXPECT_TRUE(newMgr.loadProgress->getLoading().empty());
+        EXPECT_EQUAL(1.0, newMgr.loadProgress->getProgress());
     }
 }
 
@@ -559,7 +559,8 @@ TEST_F("Test that basic select works", TestFixture)
 
     MyIntAv *v = f._amgr.getAsMyIntAttribute("aa");
     EXPECT_TRUE(v != nullptr);
-    EXPECT_EQUAL(8u, v->getGets());
+    // Sessions evaluate simple numeric comparisons without fetching attribute content
+    EXPECT_EQUAL(4u, v->getGets());
 }
 
 struct PreDocSelectFixture : public TestFixture {
@@ -598,6 +599,78 @@ TEST_F("Test that single value attribute with complex attribute field results in
     TEST_DO(checkSelect(cs, f.db().getDoc(3u), Result::False));
 }
 
+struct MultiValueAttributeFixture : public TestFixture {
+    MultiValueAttributeFixture()
+        : TestFixture()
+    {
+        addArray(1u, {3, 5});
+        addArray(2u, {7});
+        addArray(3u, {});
+    }
+    void addArray(uint32_t lid, const std::vector<int32_t> &values) {
+        AttributeGuard::UP guard = _amgr.getAttribute("aaa");
+        auto &av = static_cast<IntegerAttribute &>(*guard->get());
+        while (lid >= av.getNumDocs()) {
+            AttributeVector::DocId docId(0u);
+            ASSERT_TRUE(av.addDoc(docId));
+        }
+        for (int32_t value : values) {
+            EXPECT_TRUE(av.append(lid, value, 1));
+        }
+        av.commit();
+    }
+};
+
+TEST_F("Test that plain multi value attribute field results in pre-document only select", MultiValueAttributeFixture)
+{
+    CachedSelect::SP cs = f.testParse("test.aaa == 3", "test");
+    EXPECT_TRUE(cs->preDocOnlySelect());
+    EXPECT_EQUAL(1u, cs->mvAttrFieldNodes());
+    EXPECT_FALSE(cs->createSession()->hasFastPreDocOnlyCompare());
+    TEST_DO(checkSelect(cs, 1u, Result::True));
+    TEST_DO(checkSelect(cs, 2u, Result::False));
+    TEST_DO(checkSelect(cs, 3u, Result::False));
+
+    cs = f.testParse("test.aaa > 4", "test");
+    EXPECT_TRUE(cs->preDocOnlySelect());
+    TEST_DO(checkSelect(cs, 1u, Result::True));
+    TEST_DO(checkSelect(cs, 2u, Result::True));
+    TEST_DO(checkSelect(cs, 3u, Result::Invalid));
+}
+
+TEST_F("Test that simple numeric attribute comparison uses fast path in session", TestFixture)
+{
+    MyDB &db(*f._db);
+
+    db.addDoc(1u, "id:ns:test::1", "hello", "null", 45, 37);
+    db.addDoc(2u, "id:ns:test::2", "gotcha", "foo", 3, 25);
+    db.addDoc(3u, "id:ns:test::3", "gotcha", "foo", noIntVal, noIntVal);
+
+    CachedSelect::SP cs = f.testParse("45 > test.aa", "test");
+    EXPECT_TRUE(cs->createSession()->hasFastPreDocOnlyCompare());
+    TEST_DO(checkSelect(cs, 1u, Result::False,   false));
+    TEST_DO(checkSelect(cs, 2u, Result::True,    true));
+    TEST_DO(checkSelect(cs, 3u, Result::Invalid, false));
+
+    cs = f.testParse("test.aa != 3", "test");
+    EXPECT_TRUE(cs->createSession()->hasFastPreDocOnlyCompare());
+    TEST_DO(checkSelect(cs, 1u, Result::True,  true));
+    TEST_DO(checkSelect(cs, 2u, Result::False, false));
+    TEST_DO(checkSelect(cs, 3u, Result::True,  true));
+
+    cs = f.testParse("test.aa >= 40 + 4.5", "test");
+    EXPECT_TRUE(cs->createSession()->hasFastPreDocOnlyCompare());
+    TEST_DO(checkSelect(cs, 1u, Result::True,    true));
+    TEST_DO(checkSelect(cs, 2u, Result::False,   false));
+    TEST_DO(checkSelect(cs, 3u, Result::Invalid, false));
+
+    cs = f.testParse("test.aa == 3 or test.aa == 45", "test");
+    EXPECT_FALSE(cs->createSession()->hasFastPreDocOnlyCompare());
+    TEST_DO(checkSelect(cs, 1u, Result::True,  true));
+    TEST_DO(checkSelect(cs, 2u, Result::True,  true));
+    TEST_DO(checkSelect(cs, 3u, Result::False, false));
+}
+
 TEST_F("Test performance when using attributes", TestFixture)
 {
     MyDB &db(*f._db);
@@ -33,6 +33,7 @@
 #include <vespa/searchlib/transactionlog/translogserver.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
 #include <vespa/vespalib/encoding/base64.h>
 #include <vespa/config-bucketspaces.h>
 #include <vespa/vespalib/testkit/testapp.h>
@@ -175,6 +176,7 @@ public:
     bool _mkdirOk;
     matching::QueryLimiter _queryLimiter;
     vespalib::Clock _clock;
+    vespalib::eval::ConstantTensorLoader _constantValueFactory;
     DummyWireService _dummy;
     config::DirSpec _spec;
     DocumentDBConfigHelper _configMgr;
@@ -194,6 +196,7 @@ public:
           _mkdirOk(FastOS_File::MakeDirectory("tmpdb")),
           _queryLimiter(),
           _clock(),
+          _constantValueFactory(vespalib::eval::EngineOrFactory::get()),
           _dummy(),
           _spec(TEST_PATH("")),
           _configMgr(_spec, getDocTypeName()),
@@ -216,7 +219,7 @@ public:
         if (! FastOS_File::MakeDirectory((std::string("tmpdb/") + docTypeName).c_str())) {
             LOG_ABORT("should not be reached");
         }
-        _ddb.reset(new DocumentDB("tmpdb", _configMgr.getConfig(), "tcp/localhost:9013", _queryLimiter, _clock,
+        _ddb.reset(new DocumentDB("tmpdb", _configMgr.getConfig(), "tcp/localhost:9013", _queryLimiter, _clock, _constantValueFactory,
                                   DocTypeName(docTypeName), makeBucketSpace(),
 				  *b->getProtonConfigSP(), *this, _summaryExecutor, _summaryExecutor,
                                   _tls, _dummy, _fileHeaderContext, ConfigStore::UP(new MemoryConfigStore),
@@ -473,6 +476,88 @@ TEST_F("requireThatAdapterHandlesMultipleDocuments", Fixture)
 }
 
 
+TEST_F("requireThatAdapterReadsPrefetchedDocumentsInParallel", Fixture)
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    constexpr uint32_t numDocs = 40;
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        bc._bld.startDocument(vespalib::make_string("id:ns:searchdocument::%u", i)).
+            startSummaryField("a").
+            addInt(1000 + i).
+            endField();
+        bc.endDocument(i);
+    }
+
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, f.getResultConfig(), "class1",
+                             bc.createFieldCacheRepo(f.getResultConfig())->getFieldCache("class1"),
+                             f.getMarkupFields());
+    dsa.setPrefetchExecutor(&executor);
+    std::vector<uint32_t> docIds;
+    for (uint32_t i = 0; i <= numDocs; ++i) {
+        docIds.push_back(numDocs - i);
+    }
+    dsa.prefetch(docIds);
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        GeneralResultPtr res = getResult(dsa, i);
+        EXPECT_EQUAL(1000u + i, res->GetEntry("a")->_intval);
+    }
+    EXPECT_TRUE(dsa.getMappedDocsum(numDocs).pt() == nullptr);
+    { // doc 0 (again), no longer prefetched
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(1000u, res->GetEntry("a")->_intval);
+    }
+    uint64_t flushToken = bc._str.initFlush(bc._serialNum - 1);
+    bc._str.flush(flushToken);
+}
+
+TEST_F("requireThatAdapterReadsCoveredClassFromSummaryFieldColumns", Fixture)
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0").
+        startSummaryField("a").
+        addInt(1000).
+        endField();
+    bc.endDocument(0);
+    bc._bld.startDocument("id:ns:searchdocument::1").
+        startSummaryField("a").
+        addInt(2000).endField();
+    Document::UP doc = bc._bld.endDocument();
+
+    auto columns = std::make_shared<SummaryFieldColumns>(std::vector<vespalib::string>({"a"}), bc._repo);
+    columns->put(1, *doc);
+    EXPECT_EQUAL(1u, columns->getNumDocs());
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, f.getResultConfig(), "class1",
+                             bc.createFieldCacheRepo(f.getResultConfig())->getFieldCache("class1"),
+                             f.getMarkupFields(), columns);
+    EXPECT_TRUE(dsa.usesColumns());
+    { // doc 0 is only in the document store
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(1000u, res->GetEntry("a")->_intval);
+    }
+    { // doc 1 is only in the columns
+        GeneralResultPtr res = getResult(dsa, 1);
+        EXPECT_EQUAL(2000u, res->GetEntry("a")->_intval);
+    }
+    columns->remove(1);
+    EXPECT_EQUAL(0u, columns->getNumDocs());
+    {
+        DocsumStoreValue docsum = dsa.getMappedDocsum(1);
+        EXPECT_TRUE(docsum.pt() == nullptr);
+    }
+
+    DocumentStoreAdapter uncovered(bc._str, *bc._repo, f.getResultConfig(), "class4",
+                                   bc.createFieldCacheRepo(f.getResultConfig())->getFieldCache("class4"),
+                                   f.getMarkupFields(), columns);
+    EXPECT_FALSE(uncovered.usesColumns());
+}
+
 TEST_F("requireThatAdapterHandlesDocumentIdField", Fixture)
 {
     Schema s;
@@ -185,7 +185,7 @@ Fixture::initViewSet(ViewSet &views)
     using IndexManager = proton::index::IndexManager;
     using IndexConfig = proton::index::IndexConfig;
     auto matchers = std::make_shared<Matchers>(_clock, _queryLimiter, _constantValueRepo);
-    auto indexMgr = make_shared<IndexManager>(BASE_DIR, IndexConfig(searchcorespi::index::WarmupConfig(), 2, 0), Schema(), 1,
+    auto indexMgr = make_shared<IndexManager>(BASE_DIR, IndexConfig(searchcorespi::index::WarmupConfig(), 2, 0, 0), Schema(), 1,
                                               views._reconfigurer, views._writeService, _summaryExecutor,
                                               TuneFileIndexManager(), TuneFileAttributes(), views._fileHeaderContext);
     auto attrMgr = make_shared<AttributeManager>(BASE_DIR, "test.subdb", TuneFileAttributes(), views._fileHeaderContext,
@@ -612,6 +612,41 @@ TEST_F("require that we can reconfigure matchers", Fixture)
     }
 }
 
+DocumentDBConfig::SP
+createConfig(const Schema::SP &schema, const vespalib::string &b_property_value)
+{
+    auto rankProfiles = std::make_shared<RankProfilesConfigBuilder>();
+    for (const vespalib::string name : {"a", "b"}) {
+        rankProfiles->rankprofile.emplace_back();
+        rankProfiles->rankprofile.back().name = name;
+        rankProfiles->rankprofile.back().fef.property.emplace_back();
+        rankProfiles->rankprofile.back().fef.property.back().name = "vespa.matchphase.degradation.maxhits";
+        rankProfiles->rankprofile.back().fef.property.back().value = (name == "b") ? b_property_value : "100";
+    }
+    return test::DocumentDBConfigBuilder(0, schema, "client", DOC_TYPE).
+            repo(createRepo()).rankProfiles(rankProfiles).build();
+}
+
+TEST_F("require that matchers for unchanged rank profiles are reused", Fixture)
+{
+    ViewPtrs o = f._views.getViewPtrs();
+    auto oldConfig = createConfig(o.fv->getSchema(), "200");
+    f._configurer->reconfigure(*oldConfig, *createConfig(o.fv->getSchema()),
+                               ReconfigParams(CCR().setRankProfilesChanged(true)), f._resolver);
+    Matchers::SP oldMatchers = f._views.getViewPtrs().sv->getMatchers();
+    f._configurer->reconfigure(*createConfig(o.fv->getSchema(), "300"), *oldConfig,
+                               ReconfigParams(CCR().setRankProfilesChanged(true)), f._resolver);
+    Matchers::SP newMatchers = f._views.getViewPtrs().sv->getMatchers();
+    EXPECT_NOT_EQUAL(oldMatchers.get(), newMatchers.get());
+    EXPECT_EQUAL(oldMatchers->lookup("a").get(), newMatchers->lookup("a").get());
+    EXPECT_NOT_EQUAL(oldMatchers->lookup("b").get(), newMatchers->lookup("b").get());
+
+    f._configurer->reconfigure(*createConfig(o.fv->getSchema(), "300"), *createConfig(o.fv->getSchema(), "300"),
+                               ReconfigParams(CCR().setRankProfilesChanged(true).setRankingConstantsChanged(true)), f._resolver);
+    Matchers::SP rebuiltMatchers = f._views.getViewPtrs().sv->getMatchers();
+    EXPECT_NOT_EQUAL(newMatchers->lookup("a").get(), rebuiltMatchers->lookup("a").get());
+}
+
 TEST("require that attribute manager (imported attributes) should change when imported fields has changed")
 {
     ReconfigParams params(CCR().setImportedFieldsChanged(true));
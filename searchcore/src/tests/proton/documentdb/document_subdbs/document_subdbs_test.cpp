@@ -25,6 +25,7 @@
 #include <vespa/searchcore/proton/test/test.h>
 #include <vespa/searchcore/proton/test/thread_utils.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/test/insertion_operators.h>
@@ -168,7 +169,7 @@ struct MyFastAccessConfig
 {
     FastAccessConfig _cfg;
     MyFastAccessConfig()
-        : _cfg(MyStoreOnlyConfig()._cfg, true, true, FastAccessAttributesOnly)
+        : _cfg(MyStoreOnlyConfig()._cfg, true, true, FastAccessAttributesOnly, 0)
     {
     }
 };
@@ -197,7 +198,7 @@ MyFastAccessContext::MyFastAccessContext(IThreadingService &writeService,
     : _storeOnlyCtx(writeService, bucketDB, bucketDBHandlerInitializer),
       _attributeMetrics(nullptr),
       _wireService(),
-      _ctx(_storeOnlyCtx._ctx, _attributeMetrics, _wireService)
+      _ctx(_storeOnlyCtx._ctx, _attributeMetrics, _wireService, std::make_shared<AttributeLoadProgress>())
 {}
 MyFastAccessContext::~MyFastAccessContext() = default;
 
@@ -215,6 +216,7 @@ struct MySearchableContext
     MyFastAccessContext _fastUpdCtx;
     QueryLimiter _queryLimiter;
     vespalib::Clock _clock;
+    vespalib::eval::ConstantTensorLoader _constantValueFactory;
     SearchableContext _ctx;
     MySearchableContext(IThreadingService &writeService,
                         std::shared_ptr<BucketDBOwner> bucketDB,
@@ -233,9 +235,9 @@ MySearchableContext::MySearchableContext(IThreadingService &writeService,
                                          std::shared_ptr<BucketDBOwner> bucketDB,
                                          IBucketDBHandlerInitializer & bucketDBHandlerInitializer)
     : _fastUpdCtx(writeService, bucketDB, bucketDBHandlerInitializer),
-      _queryLimiter(), _clock(),
+      _queryLimiter(), _clock(), _constantValueFactory(vespalib::eval::EngineOrFactory::get()),
       _ctx(_fastUpdCtx._ctx, _queryLimiter,
-           _clock, dynamic_cast<vespalib::SyncableThreadExecutor &>(writeService.shared()))
+           _clock, _constantValueFactory, dynamic_cast<vespalib::SyncableThreadExecutor &>(writeService.shared()))
 {}
 MySearchableContext::~MySearchableContext() = default;
 
@@ -98,7 +98,8 @@ struct MyDocumentRetriever : public DocumentRetrieverBaseForTest
 {
     std::shared_ptr<const DocumentTypeRepo> _repo;
     DocumentVector       _docs;
-    MyDocumentRetriever(std::shared_ptr<const DocumentTypeRepo> repo) : _repo(std::move(repo)), _docs() {
+    mutable size_t       _bulkReads;
+    MyDocumentRetriever(std::shared_ptr<const DocumentTypeRepo> repo) : _repo(std::move(repo)), _docs(), _bulkReads(0) {
         _docs.push_back(Document::SP()); // lid 0 invalid
     }
     const document::DocumentTypeRepo &getDocumentTypeRepo() const override { return *_repo; }
@@ -107,6 +108,10 @@ struct MyDocumentRetriever : public DocumentRetrieverBaseForTest
     Document::UP getFullDocument(DocumentIdT lid) const override {
         return Document::UP(_docs[lid]->clone());
     }
+    void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const override {
+        ++_bulkReads;
+        DocumentRetrieverBaseForTest::visitDocuments(lids, visitor, readConsistency);
+    }
 
     CachedSelect::SP parseSelect(const vespalib::string &) const override {
         return CachedSelect::SP();
@@ -282,6 +287,22 @@ TEST_F("require that we can move all documents", MoveFixture)
     }
 }
 
+TEST_F("require that documents moved in one step are fetched with a single bulk read", MoveFixture)
+{
+    f.setupForBucket(f._source.bucket(1), 6, 9);
+    f.moveDocuments(3);
+    EXPECT_FALSE(f._mover.bucketDone());
+    EXPECT_EQUAL(3u, f._handler._moves.size());
+    EXPECT_EQUAL(3u, f._mover.getDocsMoved());
+    EXPECT_EQUAL(1u, f._source._realRetriever->_bulkReads);
+    f.moveDocuments(3);
+    EXPECT_TRUE(f._mover.bucketDone());
+    EXPECT_EQUAL(5u, f._mover.getDocsMoved());
+    EXPECT_EQUAL(2u, f._source._realRetriever->_bulkReads);
+    f.setupForBucket(f._source.bucket(2), 6, 9);
+    EXPECT_EQUAL(0u, f._mover.getDocsMoved());
+}
+
 TEST_F("require that bucket is cached when IDocumentMoveHandler handles move operation", MoveFixture)
 {
     f.setupForBucket(f._source.bucket(1), 6, 9);
@@ -557,7 +578,7 @@ struct ControllerFixtureBase
     test::DiskMemUsageNotifier  _diskMemUsageNotifier;
     BucketMoveJob               _bmj;
     MyCountJobRunner            _runner;
-    ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts);
+    ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts, uint32_t maxDocsToMove);
     ~ControllerFixtureBase();
     ControllerFixtureBase &addReady(const BucketId &bucket) {
         _calc->addReady(bucket);
@@ -612,7 +633,8 @@ struct ControllerFixtureBase
     }
 };
 
-ControllerFixtureBase::ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts)
+ControllerFixtureBase::ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts,
+                                             uint32_t maxDocsToMove)
     : _builder(),
       _calc(std::make_shared<test::BucketStateCalculator>()),
       _bucketHandler(),
@@ -627,7 +649,7 @@ ControllerFixtureBase::ControllerFixtureBase(const BlockableMaintenanceJobConfig
       _bmj(_calc, _moveHandler, _modifiedHandler, _ready._subDb,
            _notReady._subDb, _fbh, _bucketCreateNotifier, _clusterStateHandler, _bucketHandler,
            _diskMemUsageNotifier, blockableConfig,
-           "test", makeBucketSpace()),
+           "test", makeBucketSpace(), maxDocsToMove),
       _runner(_bmj)
 {
 }
@@ -639,8 +661,8 @@ const BlockableMaintenanceJobConfig BLOCKABLE_CONFIG(RESOURCE_LIMIT_FACTOR, MAX_
 
 struct ControllerFixture : public ControllerFixtureBase
 {
-    ControllerFixture(const BlockableMaintenanceJobConfig &blockableConfig = BLOCKABLE_CONFIG)
-        : ControllerFixtureBase(blockableConfig, blockableConfig.getMaxOutstandingMoveOps() != MAX_OUTSTANDING_OPS)
+    ControllerFixture(const BlockableMaintenanceJobConfig &blockableConfig = BLOCKABLE_CONFIG, uint32_t maxDocsToMove = 1)
+        : ControllerFixtureBase(blockableConfig, blockableConfig.getMaxOutstandingMoveOps() != MAX_OUTSTANDING_OPS, maxDocsToMove)
     {
         _builder.createDocs(1, 1, 4); // 3 docs
         _builder.createDocs(2, 4, 6); // 2 docs
@@ -654,7 +676,7 @@ struct ControllerFixture : public ControllerFixtureBase
 
 struct OnlyReadyControllerFixture : public ControllerFixtureBase
 {
-    OnlyReadyControllerFixture() : ControllerFixtureBase(BLOCKABLE_CONFIG, false)
+    OnlyReadyControllerFixture() : ControllerFixtureBase(BLOCKABLE_CONFIG, false, 1)
     {
         _builder.createDocs(1, 1, 2); // 1 docs
         _builder.createDocs(2, 2, 4); // 2 docs
@@ -776,6 +798,24 @@ TEST_F("require that we move buckets in several steps", ControllerFixture)
     EXPECT_EQUAL(f._notReady.bucket(4), f.bucketsModified()[2]);
 }
 
+TEST_F("require that a batch of documents is moved from a bucket each time the job runs", ControllerFixture(BLOCKABLE_CONFIG, 2))
+{
+    // bucket 4 should be moved
+    f.addReady(f._ready.bucket(1));
+    f.addReady(f._ready.bucket(2));
+    f.addReady(f._notReady.bucket(4));
+    EXPECT_FALSE(f._bmj.run());
+    EXPECT_EQUAL(2u, f.docsMoved().size());
+    EXPECT_TRUE(assertEqual(f._notReady.bucket(4), f._notReady.docs(4)[0], 2, 1, f.docsMoved()[0]));
+    EXPECT_TRUE(assertEqual(f._notReady.bucket(4), f._notReady.docs(4)[1], 2, 1, f.docsMoved()[1]));
+    EXPECT_EQUAL(0u, f.bucketsModified().size());
+    EXPECT_TRUE(f._bmj.run());
+    EXPECT_EQUAL(3u, f.docsMoved().size());
+    EXPECT_TRUE(assertEqual(f._notReady.bucket(4), f._notReady.docs(4)[2], 2, 1, f.docsMoved()[2]));
+    EXPECT_EQUAL(1u, f.bucketsModified().size());
+    EXPECT_EQUAL(f._notReady.bucket(4), f.bucketsModified()[0]);
+}
+
 TEST_F("require that we can change calculator and continue scanning where we left off", ControllerFixture)
 {
     // no buckets should move
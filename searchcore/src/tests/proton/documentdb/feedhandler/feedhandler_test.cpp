@@ -20,6 +20,7 @@
 #include <vespa/searchcore/proton/server/ddbstate.h>
 #include <vespa/searchcore/proton/server/executorthreadingservice.h>
 #include <vespa/searchcore/proton/server/feedhandler.h>
+#include <vespa/searchcore/proton/server/feedstates.h>
 #include <vespa/searchcore/proton/server/i_feed_handler_owner.h>
 #include <vespa/searchcore/proton/server/ireplayconfig.h>
 #include <vespa/searchcore/proton/test/dummy_feed_view.h>
@@ -29,6 +30,7 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/io/fileutil.h>
 
 #include <vespa/log/log.h>
@@ -50,6 +52,8 @@ using search::index::schema::DataType;
 using vespalib::makeLambdaTask;
 using search::transactionlog::TransLogServer;
 using search::transactionlog::DomainConfig;
+using search::transactionlog::Packet;
+using search::transactionlog::client::RPC;
 using storage::spi::RemoveResult;
 using storage::spi::Result;
 using storage::spi::Timestamp;
@@ -178,6 +182,7 @@ struct MyFeedView : public test::DummyFeedView {
     MyDocumentMetaStore metaStore;
     int put_count;
     SerialNum put_serial;
+    std::vector<SerialNum> put_serials;
     int heartbeat_count;
     int remove_count;
     int move_count;
@@ -212,6 +217,7 @@ struct MyFeedView : public test::DummyFeedView {
         EXPECT_EQUAL(documentType, &putOp.getDocument()->getType());
         ++put_count;
         put_serial = putOp.getSerialNum();
+        put_serials.push_back(put_serial);
         metaStore.allocate(putOp.getDocument()->getId().getGlobalId());
         if (putLatch) {
             putLatch->countDown();
@@ -253,6 +259,7 @@ MyFeedView::MyFeedView(const std::shared_ptr<const DocumentTypeRepo> &dtr, const
       metaStore(),
       put_count(0),
       put_serial(0),
+      put_serials(),
       heartbeat_count(0),
       remove_count(0),
       move_count(0),
@@ -523,6 +530,32 @@ TEST_F("require that heartBeat calls FeedView's heartBeat",
     EXPECT_EQUAL(1, f.feedView.heartbeat_count);
 }
 
+TEST_F("require that replayed packet is decoded in parallel and replayed in serial number order", FeedHandlerFixture)
+{
+    const uint32_t numPuts = 300;
+    Packet packet(0x10000);
+    for (uint32_t i = 0; i < numPuts; ++i) {
+        DocumentContext doc_context(vespalib::make_string("id:ns:searchdocument::%u", i), *f.schema.builder);
+        PutOperation op(doc_context.bucketId, Timestamp(10 + i), std::move(doc_context.doc));
+        vespalib::nbostream os;
+        op.serialize(os);
+        packet.add(Packet::Entry(i + 1, FeedOperation::PUT, vespalib::ConstBufferRef(os.data(), os.size())));
+    }
+    ReplayTransactionLogContext ctx;
+    IFeedView *feedViewPtr = &f.feedView;
+    ThreadStackExecutor decodeExecutor(4, 0x10000);
+    ReplayTransactionLogState state(f.handler.getDocTypeName(), feedViewPtr, f._bucketDBHandler,
+                                    f.replayConfig, ctx.config_store, decodeExecutor);
+    auto wrap = std::make_shared<PacketWrapper>(packet, nullptr);
+    state.receive(wrap, f.writeService.master());
+    wrap->gate.await();
+    EXPECT_EQUAL(RPC::OK, wrap->result);
+    EXPECT_EQUAL(int(numPuts), f.feedView.put_count);
+    EXPECT_EQUAL(numPuts, f.feedView.put_serials.size());
+    EXPECT_TRUE(std::is_sorted(f.feedView.put_serials.begin(), f.feedView.put_serials.end()));
+    EXPECT_EQUAL(numPuts, f.feedView.put_serial);
+}
+
 TEST_F("require that outdated remove is ignored", FeedHandlerFixture)
 {
     DocumentContext doc_context("id:ns:searchdocument::foo", *f.schema.builder);
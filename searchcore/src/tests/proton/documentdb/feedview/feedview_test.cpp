@@ -21,8 +21,11 @@
 #include <vespa/searchcore/proton/test/thread_utils.h>
 #include <vespa/searchcore/proton/test/threading_service_observer.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/update/assignvalueupdate.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/time.h>
 
 #include <vespa/log/log.h>
@@ -1107,6 +1110,33 @@ TEST_F("require that update to non fast-access attribute also updates document s
     requireThatUpdateUpdatesAttributeAndDocumentStore(f, "a1");
 }
 
+TEST_F("require that consecutive updates of same document are all applied to document store", SearchableFeedViewFixture)
+{
+    DocumentContext dc1 = f.doc1();
+    f.putAndWait(dc1);
+    const document::Field &field = f.getBuilder().getDocumentType().getField("s1");
+    std::vector<std::unique_ptr<UpdateOperation>> ops;
+    FeedTokenContext::List tokens;
+    for (uint32_t i = 0; i < 3; ++i) {
+        DocumentContext dc("id:ns:searchdocument::1", 20 + i, f.getBuilder());
+        dc.upd->addUpdate(document::FieldUpdate(field).addUpdate(
+                document::AssignValueUpdate(document::StringFieldValue(vespalib::make_string("update%u", i)))));
+        ops.push_back(std::make_unique<UpdateOperation>(dc.bid, dc.ts, dc.upd));
+        tokens.push_back(std::make_shared<FeedTokenContext>(f._tracer));
+    }
+    f.runInMaster([&] () {
+        for (uint32_t i = 0; i < ops.size(); ++i) {
+            f.performUpdate(tokens[i]->ft, *ops[i]);
+        }
+    });
+    for (auto &token : tokens) {
+        token->mt.await();
+    }
+    EXPECT_EQUAL(4u, f.msa._store._lastSyncToken);
+    EXPECT_EQUAL(1u, f.msa._store._docs.size());
+    EXPECT_EQUAL(vespalib::string("update2"), f.msa._store._docs[1]->getValue("s1")->toString());
+}
+
 TEST_F("require that update() to fast-access predicate attribute updates attribute and document store",
        FastAccessFeedViewFixture)
 {
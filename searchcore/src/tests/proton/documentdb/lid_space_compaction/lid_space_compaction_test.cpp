@@ -283,14 +283,15 @@ struct JobTestBase : public ::testing::Test {
               double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
               vespalib::duration interval = JOB_DELAY,
               bool nodeRetired = false,
-              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS)
+              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+              uint32_t maxDocsToMove = 1)
     {
         _handler = std::make_unique<MyHandler>(maxOutstandingMoveOps != MAX_OUTSTANDING_MOVE_OPS);
         _job = std::make_unique<LidSpaceCompactionJob>(DocumentDBLidSpaceCompactionConfig(interval, allowedLidBloat,
                                                                                           allowedLidBloatFactor,
                                                                                           REMOVE_BATCH_BLOCK_RATE,
                                                                                           REMOVE_BLOCK_RATE,
-                                                                                          false, maxDocsToScan),
+                                                                                          false, maxDocsToScan, maxDocsToMove),
                                                        *_handler, _storer, _frozenHandler, _diskMemUsageNotifier,
                                                        BlockableMaintenanceJobConfig(resourceLimitFactor, maxOutstandingMoveOps),
                                                        _clusterStateHandler, nodeRetired);
@@ -388,8 +389,10 @@ struct JobTest : public JobTestBase {
               double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
               vespalib::duration interval = JOB_DELAY,
               bool nodeRetired = false,
-              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS) {
-        JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, maxDocsToScan, resourceLimitFactor, interval, nodeRetired, maxOutstandingMoveOps);
+              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+              uint32_t maxDocsToMove = 1) {
+        JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, maxDocsToScan, resourceLimitFactor, interval, nodeRetired,
+                          maxOutstandingMoveOps, maxDocsToMove);
         _jobRunner = std::make_unique<MyDirectJobRunner>(*_job);
     }
     void init_with_interval(vespalib::duration interval) {
@@ -398,6 +401,10 @@ struct JobTest : public JobTestBase {
     void init_with_node_retired(bool retired) {
         init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN, RESOURCE_LIMIT_FACTOR, JOB_DELAY, retired);
     }
+    void init_with_max_docs_to_move(uint32_t maxDocsToMove) {
+        init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN, RESOURCE_LIMIT_FACTOR, JOB_DELAY, false,
+             MAX_OUTSTANDING_MOVE_OPS, maxDocsToMove);
+    }
 };
 
 struct HandlerTest : public ::testing::Test {
@@ -469,6 +476,18 @@ TEST_F(JobTest, job_returns_false_when_multiple_move_operations_or_compaction_ar
     assertJobContext(4, 7, 3, 7, 1);
 }
 
+TEST_F(JobTest, multiple_move_operations_are_created_per_run_when_max_docs_to_move_is_above_1)
+{
+    init_with_max_docs_to_move(2);
+    setupThreeDocumentsToCompact();
+    EXPECT_FALSE(run());
+    assertJobContext(3, 8, 2, 0, 0);
+    EXPECT_FALSE(run());
+    assertJobContext(4, 7, 3, 0, 0);
+    endScan().compact();
+    assertJobContext(4, 7, 3, 7, 1);
+}
+
 TEST_F(JobTest, job_is_blocked_if_trying_to_move_document_for_frozen_bucket)
 {
     _frozenHandler._bucket = BUCKET_ID_1;
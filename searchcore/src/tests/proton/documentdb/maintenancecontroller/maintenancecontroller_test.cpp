@@ -21,6 +21,7 @@
 #include <vespa/searchcore/proton/server/i_operation_storer.h>
 #include <vespa/searchcore/proton/server/ibucketmodifiedhandler.h>
 #include <vespa/searchcore/proton/server/idocumentmovehandler.h>
+#include <vespa/searchcore/proton/server/igetserialnum.h>
 #include <vespa/searchcore/proton/server/iheartbeathandler.h>
 #include <vespa/searchcore/proton/server/ipruneremoveddocumentshandler.h>
 #include <vespa/searchcore/proton/server/maintenance_controller_explorer.h>
@@ -211,7 +212,8 @@ struct MySessionCachePruner : public ISessionCachePruner
 class MyFeedHandler : public IDocumentMoveHandler,
                       public IPruneRemovedDocumentsHandler,
                       public IHeartBeatHandler,
-                      public IOperationStorer
+                      public IOperationStorer,
+                      public IGetSerialNum
 {
     FastOS_ThreadId                _executorThreadId;
     std::vector<MyDocumentSubDB *> _subDBs;
@@ -233,6 +235,10 @@ public:
         return ++_serialNum;
     }
 
+    SerialNum getSerialNum() const override {
+        return _serialNum;
+    }
+
     // Implements IOperationStorer
     void appendOperation(const FeedOperation &op, DoneCallback) override;
     CommitResult startCommit(DoneCallback) override {
@@ -422,7 +428,8 @@ public:
                            _mcCfg->getAttributeUsageFilterConfig(),
                            _mcCfg->getAttributeUsageSampleInterval(),
                            _mcCfg->getBlockableJobConfig(),
-                           _mcCfg->getFlushConfig());
+                           _mcCfg->getFlushConfig(),
+                           _mcCfg->getBucketMoveConfig());
         _mcCfg = newCfg;
         forwardMaintenanceConfig();
     }
@@ -439,7 +446,8 @@ public:
                            _mcCfg->getAttributeUsageFilterConfig(),
                            _mcCfg->getAttributeUsageSampleInterval(),
                            _mcCfg->getBlockableJobConfig(),
-                           _mcCfg->getFlushConfig());
+                           _mcCfg->getFlushConfig(),
+                           _mcCfg->getBucketMoveConfig());
         _mcCfg = newCfg;
         forwardMaintenanceConfig();
     }
@@ -456,7 +464,8 @@ public:
                            _mcCfg->getAttributeUsageFilterConfig(),
                            _mcCfg->getAttributeUsageSampleInterval(),
                            _mcCfg->getBlockableJobConfig(),
-                           _mcCfg->getFlushConfig());
+                           _mcCfg->getFlushConfig(),
+                           _mcCfg->getBucketMoveConfig());
         _mcCfg = newCfg;
         forwardMaintenanceConfig();
     }
@@ -471,7 +480,8 @@ public:
                            _mcCfg->getAttributeUsageFilterConfig(),
                            _mcCfg->getAttributeUsageSampleInterval(),
                            _mcCfg->getBlockableJobConfig(),
-                           _mcCfg->getFlushConfig());
+                           _mcCfg->getFlushConfig(),
+                           _mcCfg->getBucketMoveConfig());
         _mcCfg = newCfg;
         forwardMaintenanceConfig();
     }
@@ -880,7 +890,7 @@ MaintenanceControllerFixture::injectMaintenanceJobs()
                                             _fh, _fh, _bmc, _clusterStateHandler, _bucketHandler,
                                             _calc,
                                             _diskMemUsageNotifier,
-                                            _jobTrackers, *this,
+                                            _jobTrackers, *this, _fh,
                                             _readyAttributeManager,
                                             _notReadyAttributeManager,
                                             std::make_unique<const AttributeConfigInspector>(AttributesConfigBuilder()),
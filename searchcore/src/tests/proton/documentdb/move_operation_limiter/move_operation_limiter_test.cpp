@@ -6,6 +6,7 @@ LOG_SETUP("move_operation_limiter_test");
 #include <vespa/searchcore/proton/server/move_operation_limiter.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <queue>
+#include <thread>
 
 using namespace proton;
 
@@ -100,6 +101,15 @@ TEST_F("require that destructor callback has reference to limiter via shared ptr
     EXPECT_FALSE(f.job.blocked);
 }
 
+TEST_F("require that average latency of ended operations is tracked", Fixture)
+{
+    EXPECT_TRUE(f.limiter->getAverageLatency() == vespalib::duration::zero());
+    f.beginOp();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    f.endOp();
+    EXPECT_TRUE(f.limiter->getAverageLatency() > vespalib::duration::zero());
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
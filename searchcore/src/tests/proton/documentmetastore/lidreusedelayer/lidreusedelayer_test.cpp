@@ -144,9 +144,7 @@ public:
     {
     }
 
-    ~Fixture() {
-        commit();
-    }
+    ~Fixture() = default;
 
     template <typename FunctionType>
     void runInMaster(FunctionType func) {
@@ -204,10 +202,6 @@ public:
         } );
     }
 
-    void commit() {
-        runInMaster([&] () { cycleLids(_lidReuseDelayer->getReuseLids()); });
-    }
-
     void
     sync()
     {
@@ -260,39 +254,30 @@ TEST_F("require that lid vector is delayed", Fixture)
 }
 
 
-TEST_F("require that reuse can be batched", Fixture)
+TEST_F("require that reuse is not delayed until commit with visibility delay", Fixture)
 {
     f._store._freeListActive = true;
     f.configureLidReuseDelayer(false, true);
-    EXPECT_FALSE(f.delayReuse(4));
-    EXPECT_FALSE(f.delayReuse({ 5, 6, 7}));
-    EXPECT_TRUE(f._store.assertWork(0, 0, 0));
-    EXPECT_TRUE(assertThreadObserver(3, 0, 0, f._writeService));
-    f.commit();
-    EXPECT_TRUE(f._store.assertWork(0, 1, 4));
-    EXPECT_TRUE(assertThreadObserver(5, 1, 0, f._writeService));
-    EXPECT_FALSE(f.delayReuse(8));
-    EXPECT_FALSE(f.delayReuse({ 9, 10}));
-    EXPECT_TRUE(f._store.assertWork(0, 1, 4));
-    EXPECT_TRUE(assertThreadObserver(7, 1, 0, f._writeService));
+    EXPECT_TRUE(f.delayReuse(4));
+    f.scheduleDelayReuseLid(4);
+    EXPECT_TRUE(f._store.assertWork(1, 0, 1));
+    EXPECT_TRUE(assertThreadObserver(4, 1, 0, f._writeService));
+    EXPECT_TRUE(f.delayReuse({ 5, 6, 7}));
+    f.scheduleDelayReuseLids({ 5, 6, 7});
+    EXPECT_TRUE(f._store.assertWork(1, 1, 4));
+    EXPECT_TRUE(assertThreadObserver(7, 2, 0, f._writeService));
 }
 
 
-TEST_F("require that single element array is optimized", Fixture)
+TEST_F("require that lids are reused faster with no indexed fields and visibility delay", Fixture)
 {
     f._store._freeListActive = true;
-    f.configureLidReuseDelayer(false, true);
-    EXPECT_FALSE(f.delayReuse({ 4}));
-    EXPECT_TRUE(f._store.assertWork(0, 0, 0));
-    EXPECT_TRUE(assertThreadObserver(2, 0, 0, f._writeService));
-    f.commit();
-    f.configureLidReuseDelayer(true, true);
+    f.configureLidReuseDelayer(false, false);
+    EXPECT_FALSE(f.delayReuse(4));
     EXPECT_TRUE(f._store.assertWork(1, 0, 1));
-    EXPECT_TRUE(assertThreadObserver(5, 1, 0, f._writeService));
-    EXPECT_TRUE(f.delayReuse({ 8}));
-    f.scheduleDelayReuseLids({ 8});
-    EXPECT_TRUE(f._store.assertWork(2, 0, 2));
-    EXPECT_TRUE(assertThreadObserver(8, 2, 0, f._writeService));
+    EXPECT_FALSE(f.delayReuse({ 5, 6, 7}));
+    EXPECT_TRUE(f._store.assertWork(1, 1, 4));
+    EXPECT_TRUE(assertThreadObserver(3, 0, 0, f._writeService));
 }
 
 
@@ -296,6 +296,16 @@ public:
 
 };
 
+class SizedTarget : public SimpleTarget {
+public:
+    uint64_t _bytesToWrite;
+    SizedTarget(const vespalib::string &name, uint64_t bytesToWrite)
+        : SimpleTarget(name, 0, false),
+          _bytesToWrite(bytesToWrite)
+    {}
+    uint64_t getApproxBytesToWriteToDisk() const override { return _bytesToWrite; }
+};
+
 class GCTarget : public SimpleTarget {
 public:
     GCTarget(const vespalib::string &name, search::SerialNum flushedSerial)
@@ -425,10 +435,11 @@ struct Fixture
     SimpleStrategy::SP strategy;
     FlushEngine engine;
 
-    Fixture(uint32_t numThreads, uint32_t idleIntervalMS, SimpleStrategy::SP strategy_)
+    Fixture(uint32_t numThreads, uint32_t idleIntervalMS, SimpleStrategy::SP strategy_,
+            uint32_t numSmallThreads = 0, uint64_t smallTargetBytes = 0)
         : tlsStatsFactory(std::make_shared<SimpleTlsStatsFactory>()),
           strategy(strategy_),
-          engine(tlsStatsFactory, strategy, numThreads, idleIntervalMS)
+          engine(tlsStatsFactory, strategy, numThreads, idleIntervalMS, numSmallThreads, smallTargetBytes)
     {
     }
 
@@ -712,6 +723,30 @@ TEST_F("require that concurrency works", Fixture(2, 1))
     target2->_proceed.countDown();
 }
 
+TEST_F("require that small targets are flushed while large targets use all flush threads",
+       Fixture(1, 1, std::make_shared<SimpleStrategy>(), 1, 1000))
+{
+    auto large1 = std::make_shared<SizedTarget>("large1", 100000);
+    auto large2 = std::make_shared<SizedTarget>("large2", 100000);
+    auto small = std::make_shared<SizedTarget>("small", 100);
+    f.addTargetToStrategy(large1);
+    f.addTargetToStrategy(large2);
+    f.addTargetToStrategy(small);
+    auto handler = std::make_shared<SimpleHandler>(Targets({large1, large2, small}), "handler", 9);
+    f.putFlushHandler("handler", handler);
+    f.engine.start();
+
+    EXPECT_TRUE(large1->_initDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(small->_initDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(!large2->_initDone.await(SHORT_TIMEOUT));
+    assertThatHandlersInCurrentSet(f.engine, {"handler.large1", "handler.small"});
+    large1->_proceed.countDown();
+    EXPECT_TRUE(large1->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(large2->_initDone.await(LONG_TIMEOUT));
+    small->_proceed.countDown();
+    large2->_proceed.countDown();
+}
+
 TEST_F("require that state explorer can list flush targets", Fixture(1, 1))
 {
     auto target = std::make_shared<SimpleTarget>("target1", 100, false);
@@ -0,0 +1,136 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+
+#include <vespa/searchcore/proton/flushengine/memory_budget_flush_strategy.h>
+#include <vespa/searchcore/proton/flushengine/tls_stats_map.h>
+#include <vespa/searchcore/proton/test/dummy_flush_handler.h>
+#include <vespa/searchcore/proton/test/dummy_flush_target.h>
+#include <sstream>
+
+using namespace proton;
+using search::SerialNum;
+using searchcorespi::IFlushTarget;
+
+using Config = MemoryBudgetFlushStrategy::Config;
+
+struct SimpleFlushTarget : public test::DummyFlushTarget
+{
+    SerialNum flushedSerial;
+    uint64_t approxDiskBytes;
+    int64_t memoryGain;
+    uint64_t transientMemory;
+    bool urgent;
+    SimpleFlushTarget(const vespalib::string &name,
+                      SerialNum flushedSerial_,
+                      uint64_t approxDiskBytes_,
+                      int64_t memoryGain_,
+                      uint64_t transientMemory_,
+                      bool urgent_) noexcept
+        : test::DummyFlushTarget(name, Type::FLUSH, Component::OTHER),
+          flushedSerial(flushedSerial_),
+          approxDiskBytes(approxDiskBytes_),
+          memoryGain(memoryGain_),
+          transientMemory(transientMemory_),
+          urgent(urgent_)
+    {}
+    MemoryGain getApproxMemoryGain() const override { return MemoryGain(memoryGain, 0); }
+    SerialNum getFlushedSerialNum() const override { return flushedSerial; }
+    uint64_t getApproxBytesToWriteToDisk() const override { return approxDiskBytes; }
+    uint64_t get_approx_transient_memory() const override { return transientMemory; }
+    bool needUrgentFlush() const override { return urgent; }
+};
+
+class ContextsBuilder
+{
+private:
+    FlushContext::List _result;
+    IFlushHandler::SP _handler;
+
+public:
+    ContextsBuilder() : _result(), _handler(std::make_shared<test::DummyFlushHandler>("handler1")) {}
+    ContextsBuilder &add(const vespalib::string &targetName, SerialNum flushedSerial, uint64_t approxDiskBytes,
+                         int64_t memoryGain, uint64_t transientMemory = 0, bool urgent = false) {
+        auto target = std::make_shared<SimpleFlushTarget>(targetName, flushedSerial, approxDiskBytes,
+                                                          memoryGain, transientMemory, urgent);
+        _result.push_back(std::make_shared<FlushContext>(_handler, target, 0));
+        return *this;
+    }
+    // Expensive to write compared to replaying the transaction log, only flushed due to memory
+    ContextsBuilder &addMemory(const vespalib::string &targetName, int64_t memoryGain,
+                               uint64_t transientMemory = 0, bool urgent = false) {
+        return add(targetName, 100, 10000, memoryGain, transientMemory, urgent);
+    }
+    FlushContext::List build() const { return _result; }
+};
+
+flushengine::TlsStatsMap
+defaultTransactionLogStats()
+{
+    flushengine::TlsStatsMap::Map result;
+    result.insert(std::make_pair("handler1", flushengine::TlsStats(1000, 11, 110)));
+    return result;
+}
+
+/**
+ * The content of the TLS is serial numbers 11 -> 110, 1000 bytes.
+ * The cost config is: tlsReplayByteCost=2.0, tlsReplayOperationCost=0.0, flushTargetsWriteCost=4.0,
+ * and the memory budget is 1000 with a low watermark factor of 0.8.
+ */
+struct Fixture
+{
+    flushengine::TlsStatsMap _tlsStatsMap;
+    MemoryBudgetFlushStrategy strategy;
+    Fixture()
+        : _tlsStatsMap(defaultTransactionLogStats()),
+          strategy(Config(1000, 0.8, PrepareRestartFlushStrategy::Config(2.0, 0.0, 4.0)))
+    {}
+    vespalib::string getFlushTargets(const ContextsBuilder &builder) const {
+        std::ostringstream oss;
+        oss << "[";
+        bool comma = false;
+        for (const auto &flushContext : strategy.getFlushTargets(builder.build(), _tlsStatsMap)) {
+            if (comma) {
+                oss << ",";
+            }
+            oss << flushContext->getTarget()->getName();
+            comma = true;
+        }
+        oss << "]";
+        return oss.str();
+    }
+};
+
+TEST_F("require that nothing is flushed when within budget and replay is cheap", Fixture)
+{
+    EXPECT_EQUAL("[]", f.getFlushTargets(ContextsBuilder().addMemory("foo", 300).addMemory("bar", 400)));
+}
+
+TEST_F("require that targets with largest memory gain are flushed when above budget", Fixture)
+{
+    EXPECT_EQUAL("[foo]", f.getFlushTargets(ContextsBuilder().addMemory("baz", 200).addMemory("foo", 600).addMemory("bar", 300)));
+    EXPECT_EQUAL("[foo,bar]", f.getFlushTargets(ContextsBuilder().addMemory("baz", 280).addMemory("foo", 300).addMemory("qux", 270).addMemory("bar", 290)));
+}
+
+TEST_F("require that transient memory is included in predicted peak", Fixture)
+{
+    EXPECT_EQUAL("[]", f.getFlushTargets(ContextsBuilder().addMemory("foo", 300).addMemory("bar", 400, 200)));
+    EXPECT_EQUAL("[foo]", f.getFlushTargets(ContextsBuilder().addMemory("foo", 300).addMemory("bar", 400, 400)));
+}
+
+TEST_F("require that targets whose transient memory exceeds budget are deferred", Fixture)
+{
+    EXPECT_EQUAL("[bar,baz]", f.getFlushTargets(ContextsBuilder().addMemory("foo", 600, 500).addMemory("bar", 300).addMemory("baz", 200)));
+}
+
+TEST_F("require that urgent targets are flushed first", Fixture)
+{
+    EXPECT_EQUAL("[bar,foo]", f.getFlushTargets(ContextsBuilder().addMemory("foo", 1100).addMemory("bar", 10, 0, true)));
+}
+
+TEST_F("require that targets are flushed when replay cost exceeds write cost", Fixture)
+{
+    EXPECT_EQUAL("[]", f.getFlushTargets(ContextsBuilder().add("foo", 10, 167, 0).add("bar", 10, 167, 0).add("baz", 10, 167, 0)));
+    EXPECT_EQUAL("[bar,baz,foo]", f.getFlushTargets(ContextsBuilder().add("foo", 10, 166, 0).add("bar", 10, 166, 0).add("baz", 10, 166, 0)));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,9 @@
 
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
 #include <vespa/searchcorespi/index/warmupindexcollection.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 
@@ -12,9 +15,15 @@ using namespace proton;
 using namespace searchcorespi;
 using search::FixedSourceSelector;
 using search::index::FieldLengthInfo;
+using search::query::SimpleStringTerm;
+using search::query::Weight;
+using search::queryeval::FakeRequestContext;
 using search::queryeval::FakeSearchable;
+using search::queryeval::FieldSpec;
+using search::queryeval::FieldSpecList;
 using search::queryeval::ISourceSelector;
 using searchcorespi::index::WarmupConfig;
+using searchcorespi::index::WarmupTerms;
 
 class MockIndexSearchable : public FakeIndexSearchable {
 private:
@@ -43,6 +52,7 @@ public:
     std::shared_ptr<IndexSearchable> _fusion_source;
     vespalib::ThreadStackExecutor    _executor;
     std::shared_ptr<IndexSearchable> _warmup;
+    WarmupTerms::SP                  _warmup_terms;
 
     void expect_searchable_can_be_appended(IndexCollection::UP collection) {
         const uint32_t id = 42;
@@ -75,7 +85,7 @@ public:
     }
 
     IndexCollection::UP create_warmup(const IndexCollection::SP& prev, const IndexCollection::SP& next) {
-        return std::make_unique<WarmupIndexCollection>(WarmupConfig(1s, false), prev, next, *_warmup, _executor, *this);
+        return std::make_unique<WarmupIndexCollection>(WarmupConfig(1s, false), prev, next, *_warmup, _executor, *this, _warmup_terms);
     }
 
     virtual void warmupDone(ISearchableIndexCollection::SP current) override {
@@ -88,7 +98,8 @@ public:
           _source2(new MockIndexSearchable({7, 11})),
           _fusion_source(new FakeIndexSearchable),
           _executor(1, 128*1024),
-          _warmup(new FakeIndexSearchable)
+          _warmup(new FakeIndexSearchable),
+          _warmup_terms(std::make_shared<WarmupTerms>())
     {}
     ~IndexCollectionTest() = default;
 };
@@ -160,4 +171,39 @@ TEST_F(IndexCollectionTest, returns_empty_field_length_info_when_no_searchables_
     EXPECT_EQ(0, collection->get_field_length_info("foo").get_num_samples());
 }
 
+TEST_F(IndexCollectionTest, warmup_collection_records_searched_terms)
+{
+    _warmup_terms->record("f1", "baz");
+    auto warmup = create_warmup(make_shared_collection(), make_shared_collection());
+    FakeRequestContext requestContext;
+    FieldSpecList fields;
+    fields.add(FieldSpec("f1", 1, 1));
+    for (const char *term : {"foo", "bar", "foo"}) {
+        SimpleStringTerm node(term, "f1", 0, Weight(100));
+        warmup->createBlueprint(requestContext, fields, node);
+    }
+    _executor.sync();
+    std::vector<WarmupTerms::Term> expected({{"f1", "foo"}, {"f1", "bar"}, {"f1", "baz"}});
+    EXPECT_EQ(expected, _warmup_terms->get_terms());
+
+    const vespalib::string file_name("warmup-terms-test.txt");
+    _warmup_terms->save(file_name);
+    WarmupTerms loaded;
+    loaded.load(file_name);
+    EXPECT_EQ(expected, loaded.get_terms());
+    vespalib::unlink(file_name);
+}
+
+TEST(WarmupTermsTest, least_frequent_terms_are_dropped_when_full)
+{
+    WarmupTerms terms(4);
+    for (const char *term : {"a", "a", "a", "b", "b", "c", "d"}) {
+        terms.record("f", term);
+    }
+    EXPECT_EQ(4u, terms.size());
+    terms.record("f", "e");
+    std::vector<WarmupTerms::Term> expected({{"f", "a"}, {"f", "b"}, {"f", "e"}});
+    EXPECT_EQ(expected, terms.get_terms());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
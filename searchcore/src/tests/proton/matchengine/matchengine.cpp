@@ -178,6 +178,42 @@ TEST("requireThatEmptySearchReplyIsReturnedWhenEngineIsClosed")
     EXPECT_EQUAL(7u, reply->getDistributionKey());
 }
 
+TEST("requireThatQueriesThatWaitedTooLongAreRejected")
+{
+    MatchEngine engine(1, 1, 7);
+    engine.setNodeUp(true);
+    auto handler = std::make_shared<MySearchHandler>(3);
+    engine.putSearchHandler(DocTypeName("foo"), handler);
+
+    auto *expired = new SearchRequest();
+    expired->setTimeout(vespalib::duration::zero());
+    LocalSearchClient client;
+    engine.search(SearchRequest::Source(expired), client);
+    SearchReply::UP reply = client.getReply(10000);
+    ASSERT_TRUE(reply);
+    EXPECT_EQUAL(3u, reply->hits.size()); // rejection is disabled by default
+    EXPECT_EQUAL(0u, engine.getRejectedQueries());
+
+    engine.setMaxQueueTimeFactor(0.5);
+    expired = new SearchRequest();
+    expired->setTimeout(vespalib::duration::zero());
+    engine.search(SearchRequest::Source(expired), client);
+    reply = client.getReply(10000);
+    ASSERT_TRUE(reply);
+    EXPECT_EQUAL(0u, reply->hits.size());
+    EXPECT_TRUE(reply->coverage.wasDegradedByTimeout());
+    EXPECT_EQUAL(7u, reply->getDistributionKey());
+    EXPECT_EQUAL(1u, engine.getRejectedQueries());
+
+    auto *fresh = new SearchRequest();
+    fresh->setTimeout(std::chrono::seconds(600));
+    engine.search(SearchRequest::Source(fresh), client);
+    reply = client.getReply(10000);
+    ASSERT_TRUE(reply);
+    EXPECT_EQUAL(3u, reply->hits.size());
+    EXPECT_EQUAL(1u, engine.getRejectedQueries());
+}
+
 TEST("requireThatStateIsReported")
 {
     MatchEngine engine(1, 1, 7);
@@ -190,7 +226,8 @@ TEST("requireThatStateIsReported")
             "    \"status\": {\n"
             "        \"state\": \"OFFLINE\",\n"
             "        \"message\": \"Search interface is offline\"\n"
-            "    }\n"
+            "    },\n"
+            "    \"rejected_queries\": 0\n"
             "}\n",
             slime.toString());
 }
@@ -305,4 +305,118 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work-stealing scheduler starts by dividing the docid space equally") {
+    WorkStealingDocidRangeScheduler scheduler(4, 1, 1, 16);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 15u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 5)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 9)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(9, 13)));
+    TEST_DO(verify_range(scheduler.first_range(3), DocidRange(13, 16)));
+    EXPECT_EQUAL(scheduler.total_size(0), 4u);
+    EXPECT_EQUAL(scheduler.total_size(1), 4u);
+    EXPECT_EQUAL(scheduler.total_size(2), 4u);
+    EXPECT_EQUAL(scheduler.total_size(3), 3u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work-stealing scheduler reports the full span to all threads") {
+    WorkStealingDocidRangeScheduler scheduler(3, 4, 1, 16);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1,16)));
+    TEST_DO(verify_range(scheduler.total_span(1), DocidRange(1,16)));
+    TEST_DO(verify_range(scheduler.total_span(2), DocidRange(1,16)));
+}
+
+TEST("require that the work-stealing scheduler does not support work-sharing") {
+    WorkStealingDocidRangeScheduler scheduler(2, 4, 1, 16);
+    EXPECT_TRUE(scheduler.make_idle_observer().is_always_zero());
+    TEST_DO(verify_range(scheduler.share_range(0, DocidRange(1, 5)), DocidRange(1, 5)));
+}
+
+TEST("require that the work-stealing scheduler steals half of the tasks of the busiest peer") {
+    WorkStealingDocidRangeScheduler scheduler(3, 4, 1, 25);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(9, 11)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(11, 13)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(3, 5)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(5, 7)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(7, 9)));
+    // thread 2 has not started yet and has the most queued work
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(21, 23)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(17, 19)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(23, 25)));
+    EXPECT_EQUAL(scheduler.total_size(0), 12u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 6u);
+}
+
+TEST("require that the work-stealing scheduler splits the last task of a peer") {
+    WorkStealingDocidRangeScheduler scheduler(2, 4, 1, 17);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 3)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(3, 5)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(5, 7)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(7, 9)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(13, 15)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(9, 11)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(11, 13)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(16, 17)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(15, 16)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 11u);
+    EXPECT_EQUAL(scheduler.total_size(1), 5u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work-stealing scheduler respects the minimal task size") {
+    WorkStealingDocidRangeScheduler scheduler(2, 4, 3, 11);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 6)));
+    // a task with size 5 will not be split
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(6, 11)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 10u);
+    EXPECT_EQUAL(scheduler.total_size(1), 0u);
+}
+
+TEST_MT_FF("require that the work-stealing scheduler protects against documents underflow",
+           2, WorkStealingDocidRangeScheduler(num_threads, 4, 1, 0), TimeBomb(60))
+{
+    TEST_DO(verify_range(f1.first_range(thread_id), DocidRange()));
+    EXPECT_EQUAL(f1.total_size(thread_id), 0u);
+    EXPECT_EQUAL(f1.unassigned_size(), 0u);
+}
+
+TEST_MT_FFF("require that the work-stealing scheduler assigns each docid exactly once",
+            16, WorkStealingDocidRangeScheduler(num_threads, 16, 1, 10000),
+            std::vector<std::atomic<uint32_t>>(10000), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f2[docid].fetch_add(1);
+        }
+        if ((thread_id % 4) == 0) {
+            // slow workers make the others steal
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        size_t total = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            total += f1.total_size(i);
+        }
+        EXPECT_EQUAL(total, 9999u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        EXPECT_EQUAL(f2[0].load(), 0u);
+        size_t wrong = 0;
+        for (uint32_t docid = 1; docid < 10000; ++docid) {
+            wrong += (f2[docid].load() == 1) ? 0 : 1;
+        }
+        EXPECT_EQUAL(wrong, 0u);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -4,6 +4,8 @@
 #include <vespa/searchlib/queryeval/termasstring.h>
 #include <vespa/searchlib/queryeval/andsearchstrict.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/searchlib/attribute/extendableattributes.h>
+#include <vespa/searchlib/test/mock_attribute_context.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -20,6 +22,8 @@ using search::queryeval::AndSearchStrict;
 using search::queryeval::termAsString;
 using search::queryeval::FakeRequestContext;
 using search::fef::TermFieldMatchDataArray;
+using search::SingleFloatExtAttribute;
+using search::attribute::test::MockAttributeContext;
 
 //-----------------------------------------------------------------------------
 
@@ -399,4 +403,60 @@ TEST("require that the match phase limiter can use strict diversity") {
     verifyDiversity(AttributeLimiter::STRICT);
 }
 
+SingleFloatExtAttribute *make_tiered_attribute(const vespalib::string &name, uint32_t num_blocks) {
+    auto *attr = new SingleFloatExtAttribute(name);
+    search::AttributeVector::DocId docid(0);
+    for (uint32_t i = 0; i < num_blocks * BlockBoundLimiter::BLOCK_SIZE; ++i) {
+        attr->addDoc(docid);
+        attr->add(i / BlockBoundLimiter::BLOCK_SIZE, docid); // value = block number
+    }
+    return attr;
+}
+
+TEST("require that the block bound limiter selects the blocks with the best bounds") {
+    std::unique_ptr<SingleFloatExtAttribute> attr(make_tiered_attribute("limiter_attribute", 4));
+    EXPECT_TRUE(BlockBoundLimiter::supports(*attr));
+    for (bool descending: {true, false}) {
+        BlockBoundLimiter limiter(*attr, descending, 4096);
+        EXPECT_FALSE(limiter.was_used());
+        SearchIterator::UP s1 = limiter.create_search(1500, true);
+        SearchIterator::UP s2 = limiter.create_search(1500, false);
+        EXPECT_TRUE(limiter.was_used());
+        s1->initFullRange();
+        s2->initFullRange();
+        if (descending) {
+            EXPECT_EQUAL(2048, limiter.getEstimatedHits());
+            EXPECT_FALSE(s1->seek(2047));
+            EXPECT_EQUAL(2048u, s1->getDocId());
+            EXPECT_TRUE(s2->seek(4095));
+        } else {
+            EXPECT_EQUAL(2047, limiter.getEstimatedHits());
+            EXPECT_TRUE(s1->seek(1));
+            EXPECT_TRUE(s2->seek(2047));
+            EXPECT_FALSE(s2->seek(2048));
+        }
+    }
+}
+
+TEST("require that the match phase limiter uses block bounds for attributes without fast-search") {
+    MockAttributeContext attributeContext;
+    attributeContext.add(make_tiered_attribute("limiter_attribute", 10));
+    FakeRequestContext requestContext(&attributeContext);
+    MockSearchable searchable;
+    MatchPhaseLimiter yes_limiter(10240, searchable, requestContext,
+                                  DegradationParams("limiter_attribute", 200, true, 1.0, 0.2, 1.0),
+                                  DiversityParams("", 1, 10.0, AttributeLimiter::LOOSE));
+    MaybeMatchPhaseLimiter &limiter = yes_limiter;
+    SearchIterator::UP search = limiter.maybe_limit(prepare(new MockSearch("search")), 0.1, 10240, nullptr);
+    EXPECT_EQUAL(0u, searchable.create_cnt);
+    EXPECT_TRUE(limiter.was_limited());
+    LimitedSearch *strict_and = dynamic_cast<LimitedSearch*>(search.get());
+    ASSERT_TRUE(strict_and != nullptr);
+    const MockSearch *ms = dynamic_cast<const MockSearch*>(&strict_and->getFirst());
+    ASSERT_TRUE(ms != nullptr);
+    EXPECT_EQUAL("search", ms->term);
+    limiter.updateDocIdSpaceEstimate(1024, 9216);
+    EXPECT_EQUAL(1024u + (2048u * 9216u) / 10240u, limiter.getDocIdSpaceEstimate());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -42,6 +42,18 @@ TEST("requireThatDocCountsAddUp") {
     EXPECT_EQUAL(2u, stats.limited_queries());
 }
 
+TEST("requireThatResultCacheCountsAddUp") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.resultCacheHits());
+    EXPECT_EQUAL(0u, stats.resultCacheMisses());
+    EXPECT_EQUAL(0u, stats.resultCacheInvalidations());
+    stats.add(MatchingStats().resultCacheHits(3).resultCacheMisses(2).resultCacheInvalidations(1));
+    stats.add(MatchingStats().resultCacheHits(1).resultCacheMisses(1).resultCacheInvalidations(5));
+    EXPECT_EQUAL(4u, stats.resultCacheHits());
+    EXPECT_EQUAL(3u, stats.resultCacheMisses());
+    EXPECT_EQUAL(6u, stats.resultCacheInvalidations());
+}
+
 TEST("requireThatAverageTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeAvg(), 0.00001);
@@ -96,6 +108,20 @@ TEST("requireThatAverageTimesAreRecorded") {
     EXPECT_EQUAL(4u, stats.queryLatencyCount());
 }
 
+TEST("requireThatQueryLatencySamplesAreRecorded") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.queryLatencySamples().size());
+    stats.queryLatency(5.0).queryLatency(1.0);
+    stats.add(MatchingStats().queryLatency(3.0));
+    stats.add(MatchingStats());
+    stats.add(MatchingStats().queryLatency(2.0));
+    ASSERT_EQUAL(3u, stats.queryLatencySamples().size());
+    EXPECT_EQUAL(1.0, stats.queryLatencySamples()[0]);
+    EXPECT_EQUAL(3.0, stats.queryLatencySamples()[1]);
+    EXPECT_EQUAL(2.0, stats.queryLatencySamples()[2]);
+    EXPECT_EQUAL(stats.queryLatencyCount(), stats.queryLatencySamples().size());
+}
+
 TEST("requireThatMinMaxTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeMin(), 0.00001);
@@ -16,6 +16,7 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/aggregation/grouping.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
+#include <vespa/searchlib/attribute/bitvector_search_cache.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/common/featureset.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
@@ -32,6 +33,8 @@
 #include <vespa/searchcore/proton/matching/match_params.h>
 #include <vespa/searchcore/proton/matching/match_tools.h>
 #include <vespa/searchcore/proton/matching/match_context.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchcore/proton/matching/shared_score_threshold.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/engine_or_factory.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
@@ -90,6 +93,26 @@ vespalib::string make_simple_stack_dump(const vespalib::string &field, const ves
     return StackDumpCreator::create(*builder.build());
 }
 
+vespalib::string make_filter_stack_dump(const vespalib::string &a1_term, const vespalib::string &a2_term,
+                                        const vespalib::string &f1_term)
+{
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addAnd(3);
+    builder.addStringTerm(a1_term, "a1", 1, search::query::Weight(1)).setRanked(false);
+    builder.addStringTerm(f1_term, "f1", 2, search::query::Weight(1));
+    builder.addStringTerm(a2_term, "a2", 3, search::query::Weight(1)).setRanked(false);
+    return StackDumpCreator::create(*builder.build());
+}
+
+vespalib::string make_range_filter_stack_dump(int64_t from, int64_t to, const vespalib::string &f1_term)
+{
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addAnd(2);
+    builder.addRangeTerm(search::query::Range(from, to), "a1", 1, search::query::Weight(1)).setRanked(false);
+    builder.addStringTerm(f1_term, "f1", 2, search::query::Weight(1));
+    return StackDumpCreator::create(*builder.build());
+}
+
 vespalib::string make_same_element_stack_dump(const vespalib::string &a1_term, const vespalib::string &f1_term)
 {
     QueryBuilder<ProtonNodeTypes> builder;
@@ -315,7 +338,10 @@ struct MyWorld {
     }
 
     SearchReply::UP performSearch(SearchRequest::SP req, size_t threads) {
-        Matcher::SP matcher = createMatcher();
+        return performSearch(createMatcher(), std::move(req), threads);
+    }
+
+    SearchReply::UP performSearch(Matcher::SP matcher, SearchRequest::SP req, size_t threads) {
         SearchSession::OwnershipBundle owned_objects;
         owned_objects.search_handler = std::make_shared<MySearchHandler>(matcher);
         owned_objects.context = std::make_unique<MatchContext>(std::make_unique<MockAttributeContext>(),
@@ -454,6 +480,120 @@ TEST("require that matching also returns hits when only bitvector is used (multi
     }
 }
 
+TEST("require that cached results are reused until visible documents change") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    ASSERT_TRUE(matcher->getResultCache() != nullptr);
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    SearchReply::UP first = world.performSearch(matcher, request, 1);
+    SearchReply::UP second = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(2u, world.matchingStats.queries());
+    EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheMisses());
+    ASSERT_EQUAL(9u, first->hits.size());
+    ASSERT_EQUAL(first->hits.size(), second->hits.size());
+    for (size_t i = 0; i < first->hits.size(); ++i) {
+        EXPECT_EQUAL(first->hits[i].gid, second->hits[i].gid);
+        EXPECT_EQUAL(first->hits[i].metric, second->hits[i].metric);
+    }
+    EXPECT_EQUAL(first->totalHitCount, second->totalHitCount);
+
+    SearchRequest::SP other = world.createSimpleRequest("f1", "foo");
+    SearchReply::UP third = world.performSearch(matcher, other, 1);
+    EXPECT_EQUAL(3u, third->hits.size());
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(2u, matcher->getResultCache()->size());
+
+    world.searchContext.setVisibilityGeneration(1);
+    SearchReply::UP fourth = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(9u, fourth->hits.size());
+    EXPECT_EQUAL(21u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(3u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheInvalidations());
+    EXPECT_EQUAL(1u, matcher->getResultCache()->size());
+}
+
+TEST("require that results are not cached unless enabled") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    Matcher::SP matcher = world.createMatcher();
+    EXPECT_TRUE(matcher->getResultCache() == nullptr);
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, request, 1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(18u, world.matchingStats.docsMatched());
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheMisses());
+}
+
+TEST("require that pure filter parts of the query are cached") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(indexproperties::matching::FilterCacheMaxMemory::NAME, "100000");
+    FakeResult a1_result;
+    FakeResult a2_result;
+    for (uint32_t i = 10; i < NUM_DOCS; ++i) {
+        a1_result.doc(i);
+        if (i % 300 != 0) {
+            a2_result.doc(i);
+        }
+    }
+    world.searchContext.attr().addResult("a1", "x", a1_result);
+    world.searchContext.attr().addResult("a2", "y", a2_result);
+    Matcher::SP matcher = world.createMatcher();
+    ASSERT_TRUE(matcher->getFilterCache() != nullptr);
+    SearchRequest::SP request = world.createRequest(make_filter_stack_dump("x", "y", "spread"));
+    SearchReply::UP first = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(1u, matcher->getFilterCache()->size());
+    SearchReply::UP second = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(1u, matcher->getFilterCache()->size());
+    ASSERT_EQUAL(6u, first->hits.size());
+    ASSERT_EQUAL(first->hits.size(), second->hits.size());
+    for (size_t i = 0; i < first->hits.size(); ++i) {
+        EXPECT_EQUAL(first->hits[i].gid, second->hits[i].gid);
+    }
+    EXPECT_EQUAL(document::DocumentId("id:ns:searchdocument::800").getGlobalId(), first->hits[0].gid);
+
+    world.setStackDump(*request, make_filter_stack_dump("y", "x", "spread"));
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(2u, matcher->getFilterCache()->size());
+    world.searchContext.setVisibilityGeneration(1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(3u, matcher->getFilterCache()->size());
+}
+
+TEST("require that a single pure filter range term is cached") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(indexproperties::matching::FilterCacheMaxMemory::NAME, "100000");
+    FakeResult a1_result;
+    for (uint32_t i = 10; i < NUM_DOCS; ++i) {
+        a1_result.doc(i);
+    }
+    world.searchContext.attr().addResult("a1", "[10;1000]", a1_result);
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createRequest(make_range_filter_stack_dump(10, 1000, "spread"));
+    SearchReply::UP first = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(1u, matcher->getFilterCache()->size());
+    SearchReply::UP second = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(1u, matcher->getFilterCache()->size());
+    ASSERT_EQUAL(9u, first->hits.size());
+    ASSERT_EQUAL(first->hits.size(), second->hits.size());
+    for (size_t i = 0; i < first->hits.size(); ++i) {
+        EXPECT_EQUAL(first->hits[i].gid, second->hits[i].gid);
+    }
+    world.setStackDump(*request, make_range_filter_stack_dump(20, 1000, "spread"));
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(2u, matcher->getFilterCache()->size());
+}
+
 TEST("require that ranking is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -752,6 +892,42 @@ TEST("require that getSummaryFeatures can use cached query setup") {
     EXPECT_EQUAL(100, f[3].as_double());
 }
 
+TEST("require that summary features are reused within a search session") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "foo");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    request->sessionId.push_back('a');
+    world.performSearch(request, 1);
+    SearchSession::SP session = world.sessionManager->pickSearch("a");
+    ASSERT_TRUE(session);
+    EXPECT_FALSE(session->get_summary_features({30}));
+
+    DocsumRequest::SP docsum_request(new DocsumRequest);
+    docsum_request->sessionId = request->sessionId;
+    docsum_request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    for (uint32_t docid : {30, 10, 15}) {
+        docsum_request->hits.push_back(DocsumRequest::Hit());
+        docsum_request->hits.back().docid = docid;
+    }
+    FeatureSet::SP fs = world.getSummaryFeatures(docsum_request);
+    EXPECT_EQUAL(2u, fs->numDocs());  // "foo" has two hits
+    auto cached = session->get_summary_features({10, 30});
+    ASSERT_TRUE(cached);
+    EXPECT_FALSE(session->get_summary_features({10, 20}));
+
+    docsum_request->hits.erase(docsum_request->hits.begin() + 1, docsum_request->hits.end());
+    fs = world.getSummaryFeatures(docsum_request);
+    ASSERT_EQUAL(4u, fs->numFeatures());
+    ASSERT_EQUAL(1u, fs->numDocs());
+    const auto *f = fs->getFeaturesByDocId(30);
+    ASSERT_TRUE(f);
+    EXPECT_EQUAL(30, f[0].as_double());
+    EXPECT_EQUAL(100, f[3].as_double());
+    EXPECT_EQUAL(cached.get(), session->get_summary_features({30}).get());
+}
+
 TEST("require that getSummaryFeatures prefers cached query setup") {
     MyWorld world;
     world.basicSetup();
@@ -882,6 +1058,19 @@ TEST("require that arithmetic used for rank drop limit works") {
     EXPECT_TRUE(!(small <= limit));
 }
 
+TEST("require that shared score threshold never decreases") {
+    SharedScoreThreshold threshold;
+    EXPECT_EQUAL(-HUGE_VAL, threshold.get());
+    threshold.update(-HUGE_VAL);
+    EXPECT_EQUAL(-HUGE_VAL, threshold.get());
+    threshold.update(10.0);
+    EXPECT_EQUAL(10.0, threshold.get());
+    threshold.update(5.0);
+    EXPECT_EQUAL(10.0, threshold.get());
+    threshold.update(20.0);
+    EXPECT_EQUAL(20.0, threshold.get());
+}
+
 TEST("require that termwise limit is set correctly for first phase ranking program") {
     MyWorld world;
     world.basicSetup();
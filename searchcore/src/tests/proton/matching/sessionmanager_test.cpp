@@ -5,6 +5,7 @@
 #include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchcore/proton/matching/session_manager_explorer.h>
 #include <vespa/searchcore/proton/matching/search_session.h>
+#include <vespa/searchcore/proton/matching/slow_query_log.h>
 #include <vespa/searchcore/proton/matching/match_tools.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/test/insertion_operators.h>
@@ -70,7 +71,7 @@ TEST("require that SessionManager can be explored") {
     session_manager.insert(std::make_shared<SearchSession>("baz", start, doom,
                                                            MatchToolsFactory::UP(), SearchSession::OwnershipBundle()));
     SessionManagerExplorer explorer(session_manager);
-    EXPECT_EQUAL(std::vector<vespalib::string>({"search"}),
+    EXPECT_EQUAL(std::vector<vespalib::string>({"search", "slow_queries"}),
                  explorer.get_children_names());
     std::unique_ptr<StateExplorer> search = explorer.get_child("search");
     ASSERT_TRUE(search.get() != nullptr);
@@ -84,6 +85,56 @@ TEST("require that SessionManager can be explored") {
     EXPECT_EQUAL(3u, full_state.get()["sessions"].entries());
 }
 
+QueryResourceUsage make_usage(const vespalib::string &rank_profile, double latency_s) {
+    QueryResourceUsage usage;
+    usage.rank_profile = rank_profile;
+    usage.latency_s = latency_s;
+    usage.threads.resize(2);
+    usage.threads[0].cpu_time_s = latency_s;
+    usage.threads[0].stash_bytes = 100;
+    usage.threads[1].cpu_time_s = latency_s / 2;
+    usage.threads[1].stash_bytes = 200;
+    return usage;
+}
+
+TEST("require that slow query log keeps the slowest queries") {
+    SlowQueryLog log(3);
+    EXPECT_TRUE(log.isSlowEnough(0.0));
+    log.add(make_usage("a", 0.2));
+    log.add(make_usage("b", 0.1));
+    log.add(make_usage("c", 0.4));
+    EXPECT_TRUE(!log.isSlowEnough(0.1));
+    EXPECT_TRUE(log.isSlowEnough(0.3));
+    log.add(make_usage("d", 0.05));
+    log.add(make_usage("e", 0.3));
+    std::vector<QueryResourceUsage> entries = log.getEntries();
+    ASSERT_EQUAL(3u, entries.size());
+    EXPECT_EQUAL("c", entries[0].rank_profile);
+    EXPECT_EQUAL("e", entries[1].rank_profile);
+    EXPECT_EQUAL("a", entries[2].rank_profile);
+}
+
+TEST("require that slow query log can be explored") {
+    SessionManager session_manager(10);
+    session_manager.getSlowQueryLog().add(make_usage("default", 0.5));
+    SessionManagerExplorer explorer(session_manager);
+    std::unique_ptr<StateExplorer> slow_queries = explorer.get_child("slow_queries");
+    ASSERT_TRUE(slow_queries.get() != nullptr);
+    vespalib::Slime state;
+    vespalib::Slime full_state;
+    slow_queries->get_state(vespalib::slime::SlimeInserter(state), false);
+    slow_queries->get_state(vespalib::slime::SlimeInserter(full_state), true);
+    EXPECT_EQUAL(1, state.get()["numQueries"].asLong());
+    EXPECT_EQUAL(0u, state.get()["queries"].entries());
+    ASSERT_EQUAL(1u, full_state.get()["queries"].entries());
+    const vespalib::slime::Inspector &query = full_state.get()["queries"][0];
+    EXPECT_EQUAL("default", query["rank_profile"].asString().make_string());
+    EXPECT_EQUAL(0.5, query["latency"].asDouble());
+    EXPECT_EQUAL(0.75, query["cpu_time"].asDouble());
+    EXPECT_EQUAL(300, query["stash_bytes"].asLong());
+    EXPECT_EQUAL(2u, query["threads"].entries());
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
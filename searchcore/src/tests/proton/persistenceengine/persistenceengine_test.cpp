@@ -629,6 +629,28 @@ TEST_F("require that createBucket() is routed to handlers and merged", SimpleFix
 }
 
 
+struct CaptureResult : storage::spi::OperationComplete {
+    std::unique_ptr<Result> &_result;
+    explicit CaptureResult(std::unique_ptr<Result> &result) : _result(result) {}
+    void onComplete(std::unique_ptr<Result> result) override { _result = std::move(result); }
+    void addResultHandler(const storage::spi::ResultHandler *) override { }
+};
+
+TEST_F("require that createBucketAsync() completes once all handlers have replied", SimpleFixture)
+{
+    storage::spi::LoadType loadType(0, "default");
+    Context context(loadType, storage::spi::Priority(0), storage::spi::Trace::TraceLevel(0));
+    f.hset.handler1._createBucketResult = Result(Result::ErrorType::TRANSIENT_ERROR, "err1a");
+    f.hset.handler2._createBucketResult = Result(Result::ErrorType::PERMANENT_ERROR, "err2a");
+
+    std::unique_ptr<Result> result;
+    f.engine.createBucketAsync(bucket1, context, std::make_unique<CaptureResult>(result));
+    ASSERT_TRUE(result);
+    EXPECT_EQUAL(Result::ErrorType::PERMANENT_ERROR, result->getErrorCode());
+    EXPECT_EQUAL("err1a, err2a", result->getErrorMessage());
+}
+
+
 TEST_F("require that deleteBucket() is routed to handlers and merged", SimpleFixture)
 {
     storage::spi::LoadType loadType(0, "default");
@@ -0,0 +1,81 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/common/icommitable.h>
+#include <vespa/searchcore/proton/server/documentdb_commit_job.h>
+#include <vespa/searchcore/proton/server/igetserialnum.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <thread>
+
+using namespace proton;
+using search::SerialNum;
+
+namespace {
+
+struct MyCommitter : public ICommitable {
+    uint32_t commits = 0;
+    vespalib::duration cost = vespalib::duration::zero();
+    void commit() override {
+        ++commits;
+        if (cost != vespalib::duration::zero()) {
+            std::this_thread::sleep_for(cost);
+        }
+    }
+    void commitAndWait(ILidCommitState &) override { }
+    void commitAndWait(ILidCommitState &, uint32_t) override { }
+    void commitAndWait(ILidCommitState &, const std::vector<uint32_t> &) override { }
+};
+
+struct MyGetSerialNum : public IGetSerialNum {
+    SerialNum serialNum = 0;
+    SerialNum getSerialNum() const override { return serialNum; }
+};
+
+struct DocumentDBCommitJobTest : public ::testing::Test {
+    MyCommitter committer;
+    MyGetSerialNum serial;
+};
+
+}
+
+TEST_F(DocumentDBCommitJobTest, no_commit_before_visibility_delay_when_nothing_is_fed)
+{
+    DocumentDBCommitJob job(committer, serial, 100s);
+    EXPECT_TRUE(job.run());
+    EXPECT_EQ(0u, committer.commits);
+}
+
+TEST_F(DocumentDBCommitJobTest, commits_before_visibility_delay_when_commits_are_cheap)
+{
+    DocumentDBCommitJob job(committer, serial, 100s);
+    EXPECT_EQ(12500ms, job.getCommitInterval());
+    DocumentDBCommitJob fast_job(committer, serial, 80ms);
+    EXPECT_EQ(10ms, fast_job.getCommitInterval());
+    serial.serialNum = 1;
+    std::this_thread::sleep_for(20ms);
+    EXPECT_TRUE(fast_job.run());
+    EXPECT_EQ(1u, committer.commits);
+    EXPECT_TRUE(fast_job.run());
+    EXPECT_EQ(1u, committer.commits);
+}
+
+TEST_F(DocumentDBCommitJobTest, commit_interval_grows_with_commit_cost)
+{
+    DocumentDBCommitJob job(committer, serial, 80ms);
+    committer.cost = 5ms;
+    serial.serialNum = 1;
+    std::this_thread::sleep_for(20ms);
+    EXPECT_TRUE(job.run());
+    EXPECT_EQ(1u, committer.commits);
+    EXPECT_LE(50ms, job.getCommitInterval());
+    EXPECT_GE(80ms, job.getCommitInterval());
+}
+
+TEST_F(DocumentDBCommitJobTest, always_commits_after_visibility_delay)
+{
+    DocumentDBCommitJob job(committer, serial, 10ms);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_TRUE(job.run());
+    EXPECT_EQ(1u, committer.commits);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
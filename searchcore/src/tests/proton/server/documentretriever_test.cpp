@@ -476,6 +476,20 @@ TEST_F("require that we can look up NONE and DOCIDONLY field sets", Fixture) {
         EXPECT_TRUE(doc->getFields().empty());
 }
 
+TEST_F("require that only wanted attribute fields are patched into partial stored document", Fixture) {
+    DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
+    const DocumentType &doc_type = *f.repo.getDocumentType(doc_type_name);
+    document::FieldCollection field_set(doc_type, document::Field::Set::Builder()
+            .add(&doc_type.getField(static_field))
+            .add(&doc_type.getField(dyn_field_i)).build());
+    Document::UP doc = f._retriever->getPartialDocument(meta_data.lid, doc_id, field_set);
+    ASSERT_TRUE(doc);
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(static_field), static_value));
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(dyn_field_i), dyn_value_i));
+    EXPECT_FALSE(doc->hasValue(dyn_field_s));
+    EXPECT_FALSE(doc->hasValue(position_field));
+}
+
 TEST_F("require that attributes are patched into stored document unless also index field", Fixture) {
     f.addIndexField(Schema::IndexField(dyn_field_s, DataType::STRING)).build();
     DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
@@ -54,7 +54,8 @@ GroupingContext::GroupingContext(const vespalib::Clock & clock, vespalib::steady
     _clock(clock),
     _timeOfDoom(timeOfDoom),
     _os(),
-    _groupingList()
+    _groupingList(),
+    _approximate(false)
 {
     deserialize(groupSpec, groupSpecLen);
 }
@@ -63,7 +64,8 @@ GroupingContext::GroupingContext(const vespalib::Clock & clock, vespalib::steady
     _clock(clock),
     _timeOfDoom(timeOfDoom),
     _os(),
-    _groupingList()
+    _groupingList(),
+    _approximate(false)
 {
 }
 
@@ -71,7 +73,8 @@ GroupingContext::GroupingContext(const GroupingContext & rhs) :
     _clock(rhs._clock),
     _timeOfDoom(rhs._timeOfDoom),
     _os(),
-    _groupingList()
+    _groupingList(),
+    _approximate(rhs._approximate)
 {
 }
 
@@ -26,6 +26,7 @@ private:
     vespalib::steady_time   _timeOfDoom;
     vespalib::nbostream     _os;
     GroupingList            _groupingList;
+    bool                    _approximate;
 public:
 
     /**
@@ -73,6 +74,7 @@ public:
      * @return a list of groupings.
      **/
     GroupingList &getGroupingList() { return _groupingList; }
+    const GroupingList &getGroupingList() const { return _groupingList; }
 
     /**
      * Serialize the grouping expressions in this context.
@@ -112,6 +114,11 @@ public:
      * @return true if ranking is required.
      */
     bool needRanking() const;
+    /**
+     * Enable approximate grouping for the groupings in this context, see GroupingLevel::setApproximate.
+     */
+    void setApproximate(bool approximate) { _approximate = approximate; }
+    bool isApproximate() const { return _approximate; }
 };
 
 }
@@ -45,6 +45,7 @@ GroupingManager::init(const IAttributeContext &attrCtx)
             for (size_t k = grouping.getFirstLevel(); k <= grouping.getLastLevel() &&
                             k < levels.size(); k++) {
                 GroupingLevel & level(levels[k]);
+                level.setApproximate(_groupingContext.isApproximate());
                 ExpressionNode & en = *level.getExpression().getRoot();
 
                 if (en.inherits(AttributeNode::classId)) {
@@ -62,6 +63,18 @@ GroupingManager::init(const IAttributeContext &attrCtx)
     std::swap(list, groupingList);
 }
 
+bool
+GroupingManager::needRelevanceOrder() const
+{
+    const GroupingContext::GroupingList &groupingList(_groupingContext.getGroupingList());
+    for (const auto &grouping : groupingList) {
+        if ( ! grouping->needResort()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void
 GroupingManager::groupInRelevanceOrder(const RankedHit *searchResults, uint32_t binSize)
 {
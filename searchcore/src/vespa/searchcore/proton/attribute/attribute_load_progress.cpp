@@ -0,0 +1,74 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "attribute_load_progress.h"
+#include <algorithm>
+
+namespace proton {
+
+AttributeLoadProgress::AttributeLoadProgress()
+    : _lock(),
+      _registered(0),
+      _loaded(0),
+      _loading()
+{
+}
+
+AttributeLoadProgress::~AttributeLoadProgress() = default;
+
+void
+AttributeLoadProgress::registerAttribute()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    ++_registered;
+}
+
+void
+AttributeLoadProgress::startLoad(const vespalib::string &name)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _loading.push_back(name);
+}
+
+void
+AttributeLoadProgress::completeLoad(const vespalib::string &name)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = std::find(_loading.begin(), _loading.end(), name);
+    if (itr != _loading.end()) {
+        _loading.erase(itr);
+    }
+    ++_loaded;
+}
+
+uint32_t
+AttributeLoadProgress::getRegistered() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _registered;
+}
+
+uint32_t
+AttributeLoadProgress::getLoaded() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _loaded;
+}
+
+std::vector<vespalib::string>
+AttributeLoadProgress::getLoading() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _loading;
+}
+
+double
+AttributeLoadProgress::getProgress() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_registered == 0) {
+        return 1.0;
+    }
+    return static_cast<double>(_loaded) / _registered;
+}
+
+} // namespace proton
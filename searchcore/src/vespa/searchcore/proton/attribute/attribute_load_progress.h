@@ -0,0 +1,43 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace proton {
+
+/**
+ * Class used to track the progress of loading a set of attribute vectors from disk
+ * at startup. Attributes are registered when their initializer task is created
+ * and are loaded by multiple initializer threads.
+ */
+class AttributeLoadProgress
+{
+private:
+    mutable std::mutex            _lock;
+    uint32_t                      _registered;
+    uint32_t                      _loaded;
+    std::vector<vespalib::string> _loading;
+
+public:
+    using SP = std::shared_ptr<AttributeLoadProgress>;
+
+    AttributeLoadProgress();
+    ~AttributeLoadProgress();
+    void registerAttribute();
+    void startLoad(const vespalib::string &name);
+    void completeLoad(const vespalib::string &name);
+    uint32_t getRegistered() const;
+    uint32_t getLoaded() const;
+    std::vector<vespalib::string> getLoading() const;
+
+    /**
+     * Returns the fraction of registered attributes that are loaded, 1.0 if none are registered.
+     */
+    double getProgress() const;
+};
+
+} // namespace proton
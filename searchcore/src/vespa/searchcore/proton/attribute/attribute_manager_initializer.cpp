@@ -23,17 +23,21 @@ private:
     AttributeInitializer::UP _initializer;
     DocumentMetaStore::SP _documentMetaStore;
     InitializedAttributesResult &_result;
+    AttributeLoadProgress &_loadProgress;
 
 public:
     AttributeInitializerTask(AttributeInitializer::UP initializer,
                              DocumentMetaStore::SP documentMetaStore,
-                             InitializedAttributesResult &result)
+                             InitializedAttributesResult &result,
+                             AttributeLoadProgress &loadProgress)
         : _initializer(std::move(initializer)),
           _documentMetaStore(documentMetaStore),
-          _result(result)
+          _result(result),
+          _loadProgress(loadProgress)
     {}
 
     void run() override {
+        _loadProgress.startLoad(_initializer->getName());
         AttributeInitializerResult result = _initializer->init();
         if (result) {
             AttributesInitializerBase::considerPadAttribute(*result.getAttribute(),
@@ -41,6 +45,7 @@ public:
                                                             _documentMetaStore->getCommittedDocIdLimit());
             _result.add(result);
         }
+        _loadProgress.completeLoad(_initializer->getName());
     }
     size_t get_transient_memory_usage() const override {
         return _initializer->get_transient_memory_usage();
@@ -97,12 +102,14 @@ private:
     InitializerTask::SP _documentMetaStoreInitTask;
     DocumentMetaStore::SP _documentMetaStore;
     InitializedAttributesResult &_attributesResult;
+    AttributeLoadProgress &_loadProgress;
 
 public:
     AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
                                      InitializerTask::SP documentMetaStoreInitTask,
                                      DocumentMetaStore::SP documentMetaStore,
-                                     InitializedAttributesResult &attributesResult);
+                                     InitializedAttributesResult &attributesResult,
+                                     AttributeLoadProgress &loadProgress);
     ~AttributeInitializerTasksBuilder();
     void add(AttributeInitializer::UP initializer) override;
 };
@@ -110,11 +117,13 @@ public:
 AttributeInitializerTasksBuilder::AttributeInitializerTasksBuilder(InitializerTask &attrMgrInitTask,
                                                                    InitializerTask::SP documentMetaStoreInitTask,
                                                                    DocumentMetaStore::SP documentMetaStore,
-                                                                   InitializedAttributesResult &attributesResult)
+                                                                   InitializedAttributesResult &attributesResult,
+                                                                   AttributeLoadProgress &loadProgress)
     : _attrMgrInitTask(attrMgrInitTask),
       _documentMetaStoreInitTask(documentMetaStoreInitTask),
       _documentMetaStore(documentMetaStore),
-      _attributesResult(attributesResult)
+      _attributesResult(attributesResult),
+      _loadProgress(loadProgress)
 { }
 
 AttributeInitializerTasksBuilder::~AttributeInitializerTasksBuilder() = default;
@@ -124,7 +133,9 @@ AttributeInitializerTasksBuilder::add(AttributeInitializer::UP initializer) {
     InitializerTask::SP attributeInitTask =
             std::make_shared<AttributeInitializerTask>(std::move(initializer),
                                                        _documentMetaStore,
-                                                       _attributesResult);
+                                                       _attributesResult,
+                                                       _loadProgress);
+    _loadProgress.registerAttribute();
     attributeInitTask->addDependency(_documentMetaStoreInitTask);
     _attrMgrInitTask.addDependency(attributeInitTask);
 }
@@ -148,7 +159,8 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
                                                          size_t attributeGrowNumDocs,
                                                          bool fastAccessAttributesOnly,
                                                          searchcorespi::index::IThreadService &master,
-                                                         std::shared_ptr<AttributeManager::SP> attrMgrResult)
+                                                         std::shared_ptr<AttributeManager::SP> attrMgrResult,
+                                                         AttributeLoadProgress::SP loadProgress)
     : _configSerialNum(configSerialNum),
       _documentMetaStore(documentMetaStore),
       _attrMgr(),
@@ -158,10 +170,12 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
       _fastAccessAttributesOnly(fastAccessAttributesOnly),
       _master(master),
       _attributesResult(),
-      _attrMgrResult(attrMgrResult)
+      _attrMgrResult(attrMgrResult),
+      _loadProgress(std::move(loadProgress))
 {
     addDependency(documentMetaStoreInitTask);
-    AttributeInitializerTasksBuilder tasksBuilder(*this, documentMetaStoreInitTask, documentMetaStore, _attributesResult);
+    AttributeInitializerTasksBuilder tasksBuilder(*this, documentMetaStoreInitTask, documentMetaStore,
+                                                  _attributesResult, *_loadProgress);
     AttributeCollectionSpec::UP attrSpec = createAttributeSpec();
     _attrMgr = std::make_shared<AttributeManager>(*baseAttrMgr, *attrSpec, tasksBuilder);
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "attribute_load_progress.h"
 #include "attributemanager.h"
 #include "initialized_attributes_result.h"
 #include <vespa/searchcommon/common/growstrategy.h>
@@ -30,6 +31,7 @@ private:
     searchcorespi::index::IThreadService &_master;
     InitializedAttributesResult _attributesResult;
     std::shared_ptr<AttributeManager::SP> _attrMgrResult;
+    AttributeLoadProgress::SP _loadProgress;
 
     AttributeCollectionSpec::UP createAttributeSpec() const;
 
@@ -43,7 +45,8 @@ public:
                                 size_t attributeGrowNumDocs,
                                 bool fastAccessAttributesOnly,
                                 searchcorespi::index::IThreadService &master,
-                                std::shared_ptr<AttributeManager::SP> attrMgrResult);
+                                std::shared_ptr<AttributeManager::SP> attrMgrResult,
+                                AttributeLoadProgress::SP loadProgress);
 
     virtual void run() override;
 };
@@ -611,31 +611,37 @@ AttributeWriter::internalPut(SerialNum serialNum, const Document &doc, DocumentI
         buildFieldPaths(doc.getType(), dataType);
     }
     auto extractor = std::make_shared<DocumentFieldExtractor>(doc);
+    ISequencedTaskExecutor::TaskList tasks;
+    tasks.reserve(_writeContexts.size());
     for (const auto &wc : _writeContexts) {
         if (wc.use_two_phase_put()) {
             assert(wc.getFields().size() == 1);
             auto prepare_task = std::make_unique<PreparePutTask>(serialNum, lid, wc.getFields()[0], extractor);
             auto complete_task = std::make_unique<CompletePutTask>(*prepare_task, immediateCommit, onWriteDone);
             _shared_executor.execute(std::move(prepare_task));
-            _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(complete_task));
+            tasks.emplace_back(wc.getExecutorId(), std::move(complete_task));
         } else {
             if (allAttributes || wc.hasStructFieldAttribute()) {
                 auto putTask = std::make_unique<PutTask>(wc, serialNum, extractor, lid, immediateCommit, allAttributes,
                                                          onWriteDone);
-                _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(putTask));
+                tasks.emplace_back(wc.getExecutorId(), std::move(putTask));
             }
         }
     }
+    _attributeFieldWriter.executeTasks(std::move(tasks));
 }
 
 void
 AttributeWriter::internalRemove(SerialNum serialNum, DocumentIdT lid, bool immediateCommit,
                                 OnWriteDoneType onWriteDone)
 {
+    ISequencedTaskExecutor::TaskList tasks;
+    tasks.reserve(_writeContexts.size());
     for (const auto &wc : _writeContexts) {
-        auto removeTask = std::make_unique<RemoveTask>(wc, serialNum, lid, immediateCommit, onWriteDone);
-        _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(removeTask));
+        tasks.emplace_back(wc.getExecutorId(),
+                           std::make_unique<RemoveTask>(wc, serialNum, lid, immediateCommit, onWriteDone));
     }
+    _attributeFieldWriter.executeTasks(std::move(tasks));
 }
 
 AttributeWriter::AttributeWriter(proton::IAttributeManager::SP mgr)
@@ -21,6 +21,7 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.attribute.attributemanager");
@@ -119,10 +120,11 @@ AttributeManager::internalAddAttribute(const AttributeSpec &spec,
                                        uint64_t serialNum,
                                        const IAttributeFactory &factory)
 {
-    AttributeInitializer initializer(_diskLayout->createAttributeDir(spec.getName()), _documentSubDbName, spec, serialNum, factory);
+    AttributeInitializer initializer(_diskLayout->createAttributeDir(spec.getName()), _documentSubDbName, spec, serialNum, factory, &_shared_executor);
     AttributeInitializerResult result = initializer.init();
     if (result) {
         result.getAttribute()->setInterlock(_interlock);
+        result.getAttribute()->setCompactionExecutor(&_shared_executor);
         auto shrinker = allocShrinker(result.getAttribute(), _attributeFieldWriter, *_diskLayout);
         addAttribute(AttributeWrap::normalAttribute(result.getAttribute()), shrinker);
     }
@@ -193,7 +195,7 @@ AttributeManager::addNewAttributes(const Spec &newSpec,
 
         AttributeInitializer::UP initializer =
             std::make_unique<AttributeInitializer>(_diskLayout->createAttributeDir(aspec.getName()), _documentSubDbName,
-                        aspec, newSpec.getCurrentSerialNum(), *_factory);
+                        aspec, newSpec.getCurrentSerialNum(), *_factory, &_shared_executor);
         initializerRegistry.add(std::move(initializer));
 
         // TODO: Might want to use hardlinks to make attribute vector
@@ -308,6 +310,7 @@ AttributeManager::addInitializedAttributes(const std::vector<AttributeInitialize
         assert(result);
         auto attr = result.getAttribute();
         attr->setInterlock(_interlock);
+        attr->setCompactionExecutor(&_shared_executor);
         auto shrinker = allocShrinker(attr, _attributeFieldWriter, *_diskLayout);
         addAttribute(AttributeWrap::normalAttribute(attr), shrinker);
     }
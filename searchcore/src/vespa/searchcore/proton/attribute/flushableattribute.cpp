@@ -3,6 +3,7 @@
 #include "attributedisklayout.h"
 #include "flushableattribute.h"
 #include "attribute_directory.h"
+#include "attribute_transient_memory_calculator.h"
 #include <vespa/searchlib/attribute/attributefilesavetarget.h>
 #include <vespa/searchlib/attribute/attributesaver.h>
 #include <vespa/searchlib/util/dirtraverse.h>
@@ -248,4 +249,13 @@ FlushableAttribute::get_replay_operation_cost() const
     return _replay_operation_cost;
 }
 
+uint64_t
+FlushableAttribute::get_approx_transient_memory() const
+{
+    // Attribute is saved to memory before being written to a slow disk, and
+    // loading the flushed snapshot again might need memory for sorting values.
+    uint64_t save_buffer = _hwInfo.disk().slow() ? _attr->getEstimatedSaveByteSize() : 0u;
+    return save_buffer + AttributeTransientMemoryCalculator()(*_attr, _attr->getConfig());
+}
+
 } // namespace proton
@@ -73,6 +73,7 @@ public:
     virtual FlushStats getLastFlushStats() const override { return _lastStats; }
     virtual uint64_t getApproxBytesToWriteToDisk() const override;
     virtual double get_replay_operation_cost() const override;
+    virtual uint64_t get_approx_transient_memory() const override;
 };
 
 } // namespace proton
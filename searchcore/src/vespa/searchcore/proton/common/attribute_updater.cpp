@@ -224,6 +224,16 @@ applyTensorUpdate(TensorAttribute &vec, uint32_t lid, const TensorUpdateType &up
     }
 }
 
+void
+applyTensorModifyUpdate(TensorAttribute &vec, uint32_t lid, const TensorModifyUpdate &update)
+{
+    auto cellsTensor = update.getTensor().getAsTensorPtr();
+    if (cellsTensor && vec.modify_tensor(lid, update.getJoinFunction(), *cellsTensor)) {
+        return;
+    }
+    applyTensorUpdate(vec, lid, update, false);
+}
+
 }
 
 template <>
@@ -240,7 +250,7 @@ AttributeUpdater::handleUpdate(TensorAttribute &vec, uint32_t lid, const ValueUp
             updateValue(vec, lid, assign.getValue());
         }
     } else if (op == ValueUpdate::TensorModifyUpdate) {
-        applyTensorUpdate(vec, lid, static_cast<const TensorModifyUpdate &>(upd), false);
+        applyTensorModifyUpdate(vec, lid, static_cast<const TensorModifyUpdate &>(upd));
     } else if (op == ValueUpdate::TensorAddUpdate) {
         applyTensorUpdate(vec, lid, static_cast<const TensorAddUpdate &>(upd), true);
     } else if (op == ValueUpdate::TensorRemoveUpdate) {
@@ -12,6 +12,7 @@ LOG_SETUP(".proton.common.attribute_field_value_node");
 
 namespace proton {
 
+using document::select::ArrayValue;
 using document::select::Context;
 using document::select::FloatValue;
 using document::select::IntegerValue;
@@ -29,6 +30,59 @@ using vespalib::IllegalArgumentException;
 using vespalib::IllegalStateException;
 using vespalib::make_string;
 
+namespace {
+
+template <typename T, typename MakeValue>
+std::unique_ptr<Value>
+getMultiValue(const IAttributeVector &v, uint32_t docId, MakeValue makeValue)
+{
+    AttributeContent<T> content;
+    content.fill(v, docId);
+    if (content.size() == 0u) {
+        return std::make_unique<NullValue>();
+    }
+    if (content.size() == 1u) {
+        // Matches field value node, which returns a single element collection as a plain value
+        return makeValue(content[0]);
+    }
+    std::vector<ArrayValue::VariableValue> values;
+    values.reserve(content.size());
+    for (const T &elem : content) {
+        values.emplace_back(document::fieldvalue::VariableMap(), Value::SP(makeValue(elem)));
+    }
+    return std::make_unique<ArrayValue>(values);
+}
+
+/*
+ * Builds the value the document field value node would produce for an array
+ * or weighted set field: the elements (or keys) as an array value.
+ */
+std::unique_ptr<Value>
+getMultiValue(const IAttributeVector &v, uint32_t docId)
+{
+    switch (v.getBasicType()) {
+    case BasicType::STRING:
+        return getMultiValue<const char *>(v, docId, [](const char *elem) { return std::make_unique<StringValue>(elem); });
+    case BasicType::BOOL:
+    case BasicType::UINT2:
+    case BasicType::UINT4:
+    case BasicType::INT8:
+    case BasicType::INT16:
+    case BasicType::INT32:
+    case BasicType::INT64:
+        return getMultiValue<IAttributeVector::largeint_t>(v, docId, [](IAttributeVector::largeint_t elem)
+                                                           { return std::make_unique<IntegerValue>(elem, false); });
+    case BasicType::FLOAT:
+    case BasicType::DOUBLE:
+        return getMultiValue<double>(v, docId, [](double elem) { return std::make_unique<FloatValue>(elem); });
+    default:
+        throw IllegalArgumentException(make_string("Attribute '%s' of type '%s' can not be used for selection",
+                                                   v.getName().c_str(), BasicType(v.getBasicType()).asString()));
+    }
+}
+
+}
+
 AttributeFieldValueNode::
 AttributeFieldValueNode(const vespalib::string& doctype,
                         const vespalib::string& field,
@@ -47,6 +101,9 @@ getValue(const Context &context) const
     uint32_t docId(sc._docId); 
     assert(docId != 0u);
     const auto& v = sc.guarded_attribute_at_index(_attr_guard_index);
+    if (v.hasMultiValue()) {
+        return getMultiValue(v, docId);
+    }
     if (v.isUndefined(docId)) {
         return std::make_unique<NullValue>();
     }
@@ -12,7 +12,7 @@ class AttributeFieldValueNode : public document::select::FieldValueNode
     uint32_t _attr_guard_index;
 
 public:
-    // Precondition: attribute must be of a single-value type.
+    // Precondition: attribute must be single-value, or a plain array or weighted set of numbers or strings.
     AttributeFieldValueNode(const vespalib::string& doctype,
                             const vespalib::string& field,
                             uint32_t attr_guard_index);
@@ -20,6 +20,7 @@ public:
     std::unique_ptr<document::select::Value> getValue(const Context &context) const override;
     std::unique_ptr<document::select::Value> traceValue(const Context &context, std::ostream& out) const override;
     document::select::ValueNode::UP clone() const override;
+    uint32_t attr_guard_index() const noexcept { return _attr_guard_index; }
 };
 
 } // namespace proton
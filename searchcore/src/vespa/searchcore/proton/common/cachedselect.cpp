@@ -2,6 +2,7 @@
 
 #include "attributefieldvaluenode.h"
 #include "cachedselect.h"
+#include "numeric_attribute_compare.h"
 #include "select_utils.h"
 #include "selectcontext.h"
 #include "selectpruner.h"
@@ -43,6 +44,9 @@ public:
     AttrVisitor(const search::IAttributeManager &amgr, CachedSelect::AttributeVectors &attributes);
     ~AttrVisitor() override;
 
+    uint32_t allocateGuardIndex(const vespalib::string &name,
+                                std::shared_ptr<search::attribute::ReadableAttributeVector> av);
+
     /*
      * Mutate field value nodes representing single value attributes into
      * attribute field valulue nodes.
@@ -63,6 +67,22 @@ AttrVisitor::AttrVisitor(const search::IAttributeManager &amgr, CachedSelect::At
 
 AttrVisitor::~AttrVisitor() = default;
 
+uint32_t
+AttrVisitor::allocateGuardIndex(const vespalib::string &name,
+                                std::shared_ptr<search::attribute::ReadableAttributeVector> av)
+{
+    auto it(_amap.find(name));
+    if (it != _amap.end()) {
+        // Already allocated location for guard
+        return it->second;
+    }
+    // Allocate new location for guard
+    uint32_t idx = _attributes.size();
+    _amap[name] = idx;
+    _attributes.push_back(std::move(av));
+    return idx;
+}
+
 bool isSingleValueThatWeHandle(BasicType type) {
     return (type != BasicType::PREDICATE) && (type != BasicType::TENSOR) && (type != BasicType::REFERENCE);
 }
@@ -89,28 +109,16 @@ AttrVisitor::visitFieldValueNode(const FieldValueNode &expr)
         if (attr->getCollectionType() == CollectionType::SINGLE) {
             if (isSingleValueThatWeHandle(attr->getBasicType())) {
                 ++_svAttrs;
-                auto it(_amap.find(name));
-                uint32_t idx(invalidIdx());
-                if (it == _amap.end()) {
-                    // Allocate new location for guard
-                    idx = _attributes.size();
-                    _amap[name] = idx;
-                    _attributes.push_back(av);
-                } else {
-                    // Already allocated location for guard
-                    idx = it->second;
-                }
-                assert(idx != invalidIdx());
-                _valueNode = std::make_unique<AttributeFieldValueNode>(expr.getDocType(), name, idx);
+                _valueNode = std::make_unique<AttributeFieldValueNode>(expr.getDocType(), name, allocateGuardIndex(name, av));
             } else {
                 ++_complexAttrs;
                 // Don't try to optimize predicate/tensor/reference attributes yet.
                 _valueNode = expr.clone();
             }
         } else {
-            // Don't try to optimize multivalue attribute vectors yet
+            // Array and weighted set attributes produce the same array value as the document field
             ++_mvAttrs;
-            _valueNode = expr.clone();
+            _valueNode = std::make_unique<AttributeFieldValueNode>(expr.getDocType(), name, allocateGuardIndex(name, av));
         }
     } else {
         _valueNode = expr.clone();
@@ -121,19 +129,26 @@ AttrVisitor::visitFieldValueNode(const FieldValueNode &expr)
 
 CachedSelect::Session::Session(std::unique_ptr<document::select::Node> docSelect,
                                std::unique_ptr<document::select::Node> preDocOnlySelect,
-                               std::unique_ptr<document::select::Node> preDocSelect)
+                               std::unique_ptr<document::select::Node> preDocSelect,
+                               std::unique_ptr<NumericAttributeCompare> preDocOnlyCompare)
     : _docSelect(std::move(docSelect)),
       _preDocOnlySelect(std::move(preDocOnlySelect)),
-      _preDocSelect(std::move(preDocSelect))
+      _preDocSelect(std::move(preDocSelect)),
+      _preDocOnlyCompare(std::move(preDocOnlyCompare))
 {
 }
 
+CachedSelect::Session::~Session() = default;
+
 bool
 CachedSelect::Session::contains(const SelectContext &context) const
 {
     if (_preDocSelect && (_preDocSelect->contains(context) == document::select::Result::False)) {
         return false;
     }
+    if (_preDocOnlyCompare) {
+        return _preDocOnlyCompare->matches(context);
+    }
     return (!_preDocOnlySelect) ||
             (_preDocOnlySelect && (_preDocOnlySelect->contains(context) == document::select::Result::True));
 }
@@ -172,10 +187,11 @@ CachedSelect::setPreDocumentSelect(const search::IAttributeManager &attrMgr,
     assert(_fieldNodes == allAttrVisitor.getFieldNodes());
     assert(_attrFieldNodes == (allAttrVisitor._mvAttrs + allAttrVisitor._svAttrs + allAttrVisitor._complexAttrs));
     _svAttrFieldNodes = allAttrVisitor._svAttrs;
+    _mvAttrFieldNodes = allAttrVisitor._mvAttrs;
 
-    if (_fieldNodes == _svAttrFieldNodes) {
+    if (_fieldNodes == (_svAttrFieldNodes + _mvAttrFieldNodes)) {
         _preDocOnlySelect = std::move(allAttrVisitor.getNode());
-    } else if (_svAttrFieldNodes > 0) {
+    } else if ((_svAttrFieldNodes + _mvAttrFieldNodes) > 0) {
         _attributes.clear();
         AttrVisitor someAttrVisitor(attrMgr, _attributes);
         noDocsPruner.getNode()->visit(someAttrVisitor);
@@ -189,6 +205,7 @@ CachedSelect::CachedSelect()
       _fieldNodes(0u),
       _attrFieldNodes(0u),
       _svAttrFieldNodes(0u),
+      _mvAttrFieldNodes(0u),
       _allFalse(false),
       _allTrue(false),
       _allInvalid(false),
@@ -254,7 +271,9 @@ CachedSelect::createSession() const
 {
     return std::make_unique<Session>((_docSelect ? _docSelect->clone() : NodeUP()),
                                      (_preDocOnlySelect ? _preDocOnlySelect->clone() : NodeUP()),
-                                     (_preDocSelect ? _preDocSelect->clone() : NodeUP()));
+                                     (_preDocSelect ? _preDocSelect->clone() : NodeUP()),
+                                     (_preDocOnlySelect ? NumericAttributeCompare::create(*_preDocOnlySelect, _attributes)
+                                                        : std::unique_ptr<NumericAttributeCompare>()));
 }
 
 }
@@ -19,6 +19,7 @@ namespace search::attribute { class ReadableAttributeVector; }
 
 namespace proton {
 
+class NumericAttributeCompare;
 class SelectContext;
 class SelectPruner;
 
@@ -36,20 +37,25 @@ public:
         std::unique_ptr<document::select::Node> _docSelect;
         std::unique_ptr<document::select::Node> _preDocOnlySelect;
         std::unique_ptr<document::select::Node> _preDocSelect;
+        // Fast path replacing evaluation of _preDocOnlySelect when it is a simple numeric attribute comparison
+        std::unique_ptr<NumericAttributeCompare> _preDocOnlyCompare;
 
     public:
         Session(std::unique_ptr<document::select::Node> docSelect,
                 std::unique_ptr<document::select::Node> preDocOnlySelect,
-                std::unique_ptr<document::select::Node> preDocSelect);
+                std::unique_ptr<document::select::Node> preDocSelect,
+                std::unique_ptr<NumericAttributeCompare> preDocOnlyCompare);
+        ~Session();
         bool contains(const SelectContext &context) const;
         bool contains(const document::Document &doc) const;
         const document::select::Node &selectNode() const;
+        bool hasFastPreDocOnlyCompare() const { return static_cast<bool>(_preDocOnlyCompare); }
     };
 
     using AttributeVectors = std::vector<std::shared_ptr<search::attribute::ReadableAttributeVector>>;
 
 private:
-    // Single value attributes referenced from selection expression
+    // Single value and plain multi value attributes referenced from selection expression
     AttributeVectors _attributes;
 
     // Pruned selection expression, specific for a document type
@@ -57,12 +63,13 @@ private:
     uint32_t _fieldNodes;
     uint32_t _attrFieldNodes;
     uint32_t _svAttrFieldNodes;
+    uint32_t _mvAttrFieldNodes;
     bool _allFalse;
     bool _allTrue;
     bool _allInvalid;
 
     /**
-     * If expression doesn't reference multi value attributes or
+     * If expression doesn't reference complex attribute field paths or
      * non-attribute fields then this selection expression can be used
      * without retrieving document from document store (must use
      * SelectContext class and populate _docId instead).
@@ -70,7 +77,7 @@ private:
     std::unique_ptr<document::select::Node> _preDocOnlySelect;
 
     /**
-     * If expression references at least one single value attribute field
+     * If expression references at least one plain attribute field
      * then this selection expression can be used to disqualify a
      * document without retrieving it from document store if it evaluates to false.
      */
@@ -88,6 +95,7 @@ public:
     uint32_t fieldNodes() const { return _fieldNodes; }
     uint32_t attrFieldNodes() const { return _attrFieldNodes; }
     uint32_t svAttrFieldNodes() const { return _svAttrFieldNodes; }
+    uint32_t mvAttrFieldNodes() const { return _mvAttrFieldNodes; }
     bool allFalse() const { return _allFalse; }
     bool allTrue() const { return _allTrue; }
     bool allInvalid() const { return _allInvalid; }
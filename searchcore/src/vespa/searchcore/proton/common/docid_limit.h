@@ -2,21 +2,32 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 
 namespace proton {
 
 /**
  * Class representing the end of a local document id range.
+ *
+ * It also tracks a generation that is bumped each time the limit is
+ * updated after feed operations or a commit have become visible for
+ * searching. A search observing the same generation before it starts
+ * will see the same set of visible documents.
  */
 class DocIdLimit
 {
 private:
     std::atomic<uint32_t> _docIdLimit;
+    std::atomic<uint64_t> _generation;
 
 public:
-    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit) {}
-    void set(uint32_t docIdLimit) { _docIdLimit = docIdLimit; }
+    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit), _generation(0) {}
+    void set(uint32_t docIdLimit) {
+        _docIdLimit = docIdLimit;
+        _generation.fetch_add(1, std::memory_order_release);
+    }
     uint32_t get() const { return _docIdLimit; }
+    uint64_t getGeneration() const { return _generation.load(std::memory_order_acquire); }
 
     void bumpUpLimit(uint32_t newLimit) {
         for (;;) {
@@ -28,6 +39,7 @@ public:
                                                   std::memory_order_relaxed))
                 break;
         }
+        _generation.fetch_add(1, std::memory_order_release);
     }
 };
 
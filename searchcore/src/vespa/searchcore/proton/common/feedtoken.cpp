@@ -46,4 +46,8 @@ OwningState::~OwningState() {
     ack();
 }
 
+SharedOwningState::~SharedOwningState() {
+    ack();
+}
+
 } // namespace proton
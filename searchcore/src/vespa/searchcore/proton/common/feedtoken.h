@@ -59,6 +59,21 @@ private:
     std::unique_ptr<ITransport> _owned;
 };
 
+/**
+ * This shares ownership of the transport object, so that it can be used fully asynchronous
+ * by several feed tokens, e.g. one per persistence handler.
+ */
+class SharedOwningState : public State {
+public:
+    SharedOwningState(std::shared_ptr<ITransport> transport)
+        : State(*transport),
+          _owned(std::move(transport))
+    {}
+    ~SharedOwningState() override;
+private:
+    std::shared_ptr<ITransport> _owned;
+};
+
 inline std::shared_ptr<State>
 make(ITransport & latch) {
     return std::make_shared<State>(latch);
@@ -67,6 +82,10 @@ inline std::shared_ptr<State>
 make(std::unique_ptr<ITransport> transport) {
     return std::make_shared<OwningState>(std::move(transport));
 }
+inline std::shared_ptr<State>
+make_shared_owning(std::shared_ptr<ITransport> transport) {
+    return std::make_shared<SharedOwningState>(std::move(transport));
+}
 
 }
 
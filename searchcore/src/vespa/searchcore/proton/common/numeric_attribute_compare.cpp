@@ -0,0 +1,172 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numeric_attribute_compare.h"
+#include "attributefieldvaluenode.h"
+#include "selectcontext.h"
+#include <vespa/document/select/compare.h>
+#include <vespa/document/select/operator.h>
+#include <vespa/document/select/value.h>
+#include <vespa/document/select/valuenodes.h>
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/attribute/attribute_read_guard.h>
+#include <vespa/searchlib/attribute/readable_attribute_vector.h>
+
+namespace proton {
+
+using document::select::ArithmeticValueNode;
+using document::select::Compare;
+using document::select::CurrentTimeValueNode;
+using document::select::FloatValue;
+using document::select::FloatValueNode;
+using document::select::FunctionOperator;
+using document::select::IntegerValue;
+using document::select::IntegerValueNode;
+using document::select::Value;
+using document::select::ValueNode;
+using search::attribute::BasicType;
+
+namespace {
+
+bool
+isConstantNumeric(const ValueNode &node)
+{
+    if (dynamic_cast<const IntegerValueNode *>(&node) != nullptr ||
+        dynamic_cast<const FloatValueNode *>(&node) != nullptr ||
+        dynamic_cast<const CurrentTimeValueNode *>(&node) != nullptr)
+    {
+        return true;
+    }
+    const auto *arithmetic = dynamic_cast<const ArithmeticValueNode *>(&node);
+    return (arithmetic != nullptr) &&
+            isConstantNumeric(arithmetic->getLeft()) &&
+            isConstantNumeric(arithmetic->getRight());
+}
+
+bool
+lookupOp(const document::select::Operator &op, bool mirror, NumericAttributeCompare::Op &result)
+{
+    using Op = NumericAttributeCompare::Op;
+    if (&op == &FunctionOperator::LT) {
+        result = mirror ? Op::GT : Op::LT;
+    } else if (&op == &FunctionOperator::LEQ) {
+        result = mirror ? Op::GEQ : Op::LEQ;
+    } else if (&op == &FunctionOperator::GT) {
+        result = mirror ? Op::LT : Op::GT;
+    } else if (&op == &FunctionOperator::GEQ) {
+        result = mirror ? Op::LEQ : Op::GEQ;
+    } else if (&op == &FunctionOperator::EQ) {
+        result = Op::EQ;
+    } else if (&op == &FunctionOperator::NE) {
+        result = Op::NE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool
+compare(T lhs, NumericAttributeCompare::Op op, T rhs)
+{
+    using Op = NumericAttributeCompare::Op;
+    switch (op) {
+    case Op::LT:  return lhs < rhs;
+    case Op::LEQ: return lhs <= rhs;
+    case Op::GT:  return lhs > rhs;
+    case Op::GEQ: return lhs >= rhs;
+    case Op::EQ:  return lhs == rhs;
+    case Op::NE:  return lhs != rhs;
+    }
+    return false;
+}
+
+}
+
+NumericAttributeCompare::NumericAttributeCompare(uint32_t attrGuardIndex, bool integerAttribute, Op op,
+                                                 bool integerConstant, int64_t intConstant, double floatConstant)
+    : _attrGuardIndex(attrGuardIndex),
+      _integerAttribute(integerAttribute),
+      _op(op),
+      _integerConstant(integerConstant),
+      _intConstant(intConstant),
+      _floatConstant(floatConstant)
+{
+}
+
+std::unique_ptr<NumericAttributeCompare>
+NumericAttributeCompare::create(const document::select::Node &select, const CachedSelect::AttributeVectors &attributes)
+{
+    const auto *cmp = dynamic_cast<const Compare *>(&select);
+    if (cmp == nullptr) {
+        return {};
+    }
+    const auto *attrNode = dynamic_cast<const AttributeFieldValueNode *>(&cmp->getLeft());
+    const ValueNode *constNode = &cmp->getRight();
+    bool mirror = false;
+    if (attrNode == nullptr) {
+        attrNode = dynamic_cast<const AttributeFieldValueNode *>(&cmp->getRight());
+        constNode = &cmp->getLeft();
+        mirror = true;
+    }
+    Op op;
+    if (attrNode == nullptr || !isConstantNumeric(*constNode) || !lookupOp(cmp->getOperator(), mirror, op)) {
+        return {};
+    }
+    uint32_t attrGuardIndex = attrNode->attr_guard_index();
+    if (attrGuardIndex >= attributes.size()) {
+        return {};
+    }
+    bool integerAttribute;
+    {
+        auto guard = attributes[attrGuardIndex]->makeReadGuard(false);
+        if (guard->attribute()->hasMultiValue()) {
+            return {};
+        }
+        switch (guard->attribute()->getBasicType()) {
+        case BasicType::BOOL:
+        case BasicType::UINT2:
+        case BasicType::UINT4:
+        case BasicType::INT8:
+        case BasicType::INT16:
+        case BasicType::INT32:
+        case BasicType::INT64:
+            integerAttribute = true;
+            break;
+        case BasicType::FLOAT:
+        case BasicType::DOUBLE:
+            integerAttribute = false;
+            break;
+        default:
+            return {};
+        }
+    }
+    std::unique_ptr<Value> value = constNode->getValue(document::select::Context());
+    if (value->getType() == Value::Integer) {
+        int64_t intConstant = static_cast<const IntegerValue &>(*value).getValue();
+        return std::make_unique<NumericAttributeCompare>(attrGuardIndex, integerAttribute, op,
+                                                         true, intConstant, static_cast<double>(intConstant));
+    } else if (value->getType() == Value::Float) {
+        double floatConstant = static_cast<const FloatValue &>(*value).getValue();
+        return std::make_unique<NumericAttributeCompare>(attrGuardIndex, integerAttribute, op,
+                                                         false, 0, floatConstant);
+    }
+    return {};
+}
+
+bool
+NumericAttributeCompare::matches(const SelectContext &context) const
+{
+    const auto &attr = context.guarded_attribute_at_index(_attrGuardIndex);
+    uint32_t docId = context._docId;
+    if (attr.isUndefined(docId)) {
+        // Comparing against null only yields true for inequality
+        return (_op == Op::NE);
+    }
+    if (_integerAttribute && _integerConstant) {
+        return compare<int64_t>(attr.getInt(docId), _op, _intConstant);
+    }
+    double lhs = _integerAttribute ? static_cast<double>(attr.getInt(docId)) : attr.getFloat(docId);
+    return compare<double>(lhs, _op, _floatConstant);
+}
+
+}
@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "cachedselect.h"
+#include <memory>
+
+namespace document::select { class Node; }
+
+namespace proton {
+
+class SelectContext;
+
+/**
+ * Fast evaluation of a selection expression that has been reduced to a single
+ * comparison between a single value numeric attribute and a constant numeric
+ * expression (e.g. "music.year > 2000" or "music.ts > now() - 3600").
+ *
+ * Reads the attribute value directly instead of evaluating the node tree,
+ * avoiding the value allocations and virtual calls done per document by the
+ * generic evaluation. Gives the same result as evaluating the node to True.
+ */
+class NumericAttributeCompare
+{
+public:
+    enum class Op { LT, LEQ, GT, GEQ, EQ, NE };
+
+    NumericAttributeCompare(uint32_t attrGuardIndex, bool integerAttribute, Op op,
+                            bool integerConstant, int64_t intConstant, double floatConstant);
+
+    /**
+     * Returns nullptr if the selection does not have the supported form.
+     * Constant expressions (including now()) are evaluated once, here.
+     */
+    static std::unique_ptr<NumericAttributeCompare>
+    create(const document::select::Node &select, const CachedSelect::AttributeVectors &attributes);
+
+    bool matches(const SelectContext &context) const;
+
+    uint32_t attrGuardIndex() const noexcept { return _attrGuardIndex; }
+    Op op() const noexcept { return _op; }
+private:
+    uint32_t _attrGuardIndex;
+    bool     _integerAttribute;
+    Op       _op;
+    bool     _integerConstant;
+    int64_t  _intConstant;
+    double   _floatConstant;
+};
+
+}
@@ -45,7 +45,6 @@ using document::FieldPath;
 using document::Field;
 using document::FieldNotFoundException;
 using search::AttributeGuard;
-using search::attribute::CollectionType;
 
 namespace proton {
 
@@ -435,16 +434,14 @@ SelectPruner::visitFieldValueNode(const FieldValueNode &expr)
     
     _valueNode = expr.clone(); // Replace with different node type for attrs ?
     _valueNode->clearParentheses();
-    bool svAttr = false;
+    bool plainAttr = false;
     bool attrField = false;
     if (_amgr != nullptr) {
         auto attr = _amgr->readable_attribute_vector(name);
         if (attr) {
             attrField = true;
-            auto ag = attr->makeReadGuard(false);
-            if ((ag->attribute()->getCollectionType() == CollectionType::SINGLE) && !complex) {
-                svAttr = true;
-            }
+            // Plain references to single value, array and weighted set attributes can be evaluated without the document
+            plainAttr = !complex;
         } else if (is_imported) {
             // Imported field present in document config but not yet in attribute config.
             // Treat as missing (null) in document, as this matches behavior elsewhere in the pipeline.
@@ -452,7 +449,7 @@ SelectPruner::visitFieldValueNode(const FieldValueNode &expr)
             return;
         }
     }
-    if (!_hasDocuments && !svAttr) {
+    if (!_hasDocuments && !plainAttr) {
         setInvalidVal();
         return;
     }
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/common/location.h>
 #include <vespa/searchlib/common/matching_elements.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/ring_tracer.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
@@ -35,6 +36,8 @@ using namespace matching;
 
 namespace {
 
+RT_Tag docsum_tag("proton.docsum");
+
 Memory DOCSUMS("docsums");
 Memory DOCSUM("docsum");
 Memory ERRORS("errors");
@@ -61,6 +64,26 @@ DocsumContext::initState()
     }
 }
 
+void
+DocsumContext::prefetchDocsums(const IDocsumWriter::ResolveClassInfo & rci)
+{
+    if (rci.mustSkip || rci.allGenerated) {
+        return;
+    }
+    // Lets the disk fetch all the documents in parallel instead of one at a time while the docsums are written.
+    std::vector<uint32_t> docIds;
+    docIds.reserve(_docsumState._docsumcnt);
+    for (uint32_t i = 0; i < _docsumState._docsumcnt; i++) {
+        uint32_t docId = _docsumState._docsumbuf[i];
+        if (docId != search::endDocId) {
+            docIds.push_back(docId);
+        }
+    }
+    if ( ! docIds.empty()) {
+        _docsumStore.prefetch(docIds);
+    }
+}
+
 DocsumReply::UP
 DocsumContext::createReply()
 {
@@ -70,6 +93,7 @@ DocsumContext::createReply()
     reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    prefetchDocsums(rci);
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
         buf.reset();
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -114,6 +138,7 @@ DocsumContext::createSlimeReply()
     const Symbol docsumSym = response->insert(DOCSUM);
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
                                                                          _docsumStore.getSummaryClassId());
+    prefetchDocsums(rci);
     uint32_t i(0);
     for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -154,6 +179,7 @@ DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docs
 DocsumReply::UP
 DocsumContext::getDocsums()
 {
+    RT_Sample sample(docsum_tag);
     if (_request.useRootSlime()) {
         return std::make_unique<DocsumReply>(createSlimeReply());
     }
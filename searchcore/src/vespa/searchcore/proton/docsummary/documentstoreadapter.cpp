@@ -6,6 +6,12 @@
 #include <vespa/eval/eval/engine_or_factory.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.documentstoreadapter");
@@ -19,6 +25,56 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+// Prefetching fewer documents than this is not worth the task overhead
+constexpr size_t MIN_PARALLEL_READ = 16;
+constexpr size_t READ_CHUNK_SIZE = 4;
+
+/**
+ * Documents read by the calling thread and helper tasks. Chunks of
+ * documents are claimed from a shared counter, so the caller never
+ * waits for tasks that have not started; tasks started after all
+ * chunks are claimed do nothing.
+ */
+class ParallelRead {
+private:
+    const search::IDocumentStore  & _docStore;
+    const DocumentTypeRepo        & _repo;
+    const std::vector<uint32_t>     _docIds;
+    std::vector<Document::UP>       _docs;
+    std::atomic<size_t>             _next;
+    std::mutex                      _lock;
+    std::condition_variable         _cond;
+    size_t                          _done;
+public:
+    ParallelRead(const search::IDocumentStore & docStore, const DocumentTypeRepo & repo,
+                 const std::vector<uint32_t> & docIds)
+        : _docStore(docStore), _repo(repo), _docIds(docIds), _docs(docIds.size()),
+          _next(0), _lock(), _cond(), _done(0)
+    { }
+    bool readChunk() {
+        size_t begin = _next.fetch_add(READ_CHUNK_SIZE, std::memory_order_relaxed);
+        if (begin >= _docIds.size()) {
+            return false;
+        }
+        size_t end = std::min(begin + READ_CHUNK_SIZE, _docIds.size());
+        for (size_t i = begin; i < end; ++i) {
+            _docs[i] = _docStore.read(_docIds[i], _repo);
+        }
+        std::lock_guard<std::mutex> guard(_lock);
+        _done += (end - begin);
+        if (_done == _docIds.size()) {
+            _cond.notify_all();
+        }
+        return true;
+    }
+    void wait() {
+        std::unique_lock<std::mutex> guard(_lock);
+        _cond.wait(guard, [this]() { return _done == _docIds.size(); });
+    }
+    const std::vector<uint32_t> & docIds() const { return _docIds; }
+    std::vector<Document::UP> & docs() { return _docs; }
+};
+
 }
 
 bool
@@ -99,13 +155,36 @@ DocumentStoreAdapter::writeField(const FieldValue &value, ResType type)
 }
 
 
+void
+DocumentStoreAdapter::writeSummaryField(const ResConfigEntry &entry, const FieldValue *fieldValue, uint32_t docId)
+{
+    const vespalib::string fieldName(entry._bindname);
+    if ( ! fieldValue) {
+        LOG(spam, "No field value for field '%s' in the document for docId %u. Adding empty field",
+            fieldName.c_str(), docId);
+        _resultPacker.AddEmpty();
+        return;
+    }
+    LOG(spam, "writeField(%s): value(%s), type(%d)", fieldName.c_str(), fieldValue->toString().c_str(), entry._type);
+    bool markup = _markupFields.find(fieldName) != _markupFields.end();
+    FieldValue::UP convertedFieldValue = SummaryFieldConverter::convertSummaryField(markup, *fieldValue);
+    if (convertedFieldValue) {
+        if (!writeField(*convertedFieldValue, entry._type)) {
+            LOG(warning, "Error while writing field '%s' for docId %u", fieldName.c_str(), docId);
+        }
+    } else {
+        LOG(spam, "No converted field value for field '%s' in the document for docId %u. Adding empty field",
+            fieldName.c_str(), docId);
+        _resultPacker.AddEmpty();
+    }
+}
+
 void
 DocumentStoreAdapter::convertFromSearchDoc(Document &doc, uint32_t docId)
 {
     for (size_t i = 0; i < _resultClass->GetNumEntries(); ++i) {
         const ResConfigEntry * entry = _resultClass->GetEntry(i);
         const vespalib::string fieldName(entry->_bindname);
-        bool markup = _markupFields.find(fieldName) != _markupFields.end();
         if (fieldName == DOCUMENT_ID_FIELD) {
             StringFieldValue value(doc.getId().toString());
             if (!writeField(value, entry->_type)) {
@@ -121,24 +200,53 @@ DocumentStoreAdapter::convertFromSearchDoc(Document &doc, uint32_t docId)
             continue;
         }
         FieldValue::UP fieldValue = doc.getValue(*field);
-        if ( ! fieldValue) {
-            LOG(spam, "No field value for field '%s' in the document for docId %u. Adding empty field",
-                fieldName.c_str(), docId);
+        writeSummaryField(*entry, fieldValue.get(), docId);
+    }
+}
+
+bool
+DocumentStoreAdapter::convertFromColumns(uint32_t docId)
+{
+    std::vector<SummaryFieldColumns::FieldValueUP> values;
+    if ( ! _columns->read(docId, _columnIds, values)) {
+        return false;
+    }
+    auto value = values.begin();
+    for (size_t i = 0; i < _resultClass->GetNumEntries(); ++i) {
+        const ResConfigEntry * entry = _resultClass->GetEntry(i);
+        if ( ! _fieldCache->getField(i)) {
             _resultPacker.AddEmpty();
             continue;
         }
-        LOG(spam, "writeField(%s): value(%s), type(%d)", fieldName.c_str(), fieldValue->toString().c_str(), entry->_type);
-        FieldValue::UP convertedFieldValue = SummaryFieldConverter::convertSummaryField(markup, *fieldValue);
-        if (convertedFieldValue) {
-            if (!writeField(*convertedFieldValue, entry->_type)) {
-                LOG(warning, "Error while writing field '%s' for docId %u", fieldName.c_str(), docId);
+        writeSummaryField(*entry, value->get(), docId);
+        ++value;
+    }
+    return true;
+}
+
+void
+DocumentStoreAdapter::setupColumns(SummaryFieldColumns::SP columns)
+{
+    if ( ! columns || (_resultClass == nullptr) || (_fieldCache->size() != _resultClass->GetNumEntries())) {
+        return;
+    }
+    // Only result classes where all fields found in the document have a column can be served from the columns
+    std::vector<int> columnIds;
+    for (size_t i = 0; i < _resultClass->GetNumEntries(); ++i) {
+        const vespalib::string fieldName(_resultClass->GetEntry(i)->_bindname);
+        if (fieldName == DOCUMENT_ID_FIELD) {
+            return;
+        }
+        if (_fieldCache->getField(i)) {
+            int columnId = columns->getColumnId(fieldName);
+            if (columnId < 0) {
+                return;
             }
-        } else {
-            LOG(spam, "No converted field value for field '%s' in the document for docId %u. Adding empty field",
-                fieldName.c_str(), docId);
-            _resultPacker.AddEmpty();
+            columnIds.push_back(columnId);
         }
     }
+    _columns = std::move(columns);
+    _columnIds = std::move(columnIds);
 }
 
 DocumentStoreAdapter::
@@ -147,7 +255,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                      const ResultConfig & resultConfig,
                      const vespalib::string & resultClassName,
                      const FieldCache::CSP & fieldCache,
-                     const std::set<vespalib::string> &markupFields)
+                     const std::set<vespalib::string> &markupFields,
+                     SummaryFieldColumns::SP columns)
     : _docStore(docStore),
       _repo(repo),
       _resultConfig(resultConfig),
@@ -155,12 +264,62 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                    LookupResultClass(resultConfig.LookupResultClassId(resultClassName.c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _columns(),
+      _columnIds(),
+      _prefetchExecutor(nullptr),
+      _prefetched()
 {
+    setupColumns(std::move(columns));
 }
 
 DocumentStoreAdapter::~DocumentStoreAdapter() = default;
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> & docIds)
+{
+    _docStore.prefetch(docIds);
+    if ((_prefetchExecutor != nullptr) && !_columns && (docIds.size() >= MIN_PARALLEL_READ)) {
+        readDocuments(docIds);
+    }
+}
+
+void
+DocumentStoreAdapter::readDocuments(const std::vector<uint32_t> & docIds)
+{
+    auto work = std::make_shared<ParallelRead>(_docStore, _repo, docIds);
+    size_t numTasks = std::min(_prefetchExecutor->getNumThreads(), (docIds.size() / READ_CHUNK_SIZE) - 1);
+    for (size_t i = 0; i < numTasks; ++i) {
+        auto rejected = _prefetchExecutor->execute(vespalib::makeLambdaTask([work]() {
+            while (work->readChunk()) { }
+        }));
+        if (rejected) {
+            break;
+        }
+    }
+    while (work->readChunk()) { }
+    work->wait();
+    for (size_t i = 0; i < work->docIds().size(); ++i) {
+        if (work->docs()[i]) {
+            _prefetched[work->docIds()[i]] = std::move(work->docs()[i]);
+        }
+    }
+}
+
+Document::UP
+DocumentStoreAdapter::readDocument(uint32_t docId)
+{
+    if ( ! _prefetched.empty()) {
+        auto itr = _prefetched.find(docId);
+        if (itr != _prefetched.end()) {
+            Document::UP document = std::move(itr->second);
+            _prefetched.erase(itr);
+            return document;
+        }
+    }
+    return _docStore.read(docId, _repo);
+}
+
 DocsumStoreValue
 DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
 {
@@ -168,7 +327,16 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
         LOG(warning, "Error during init of result class '%s' with class id %u", _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    if (_columns && convertFromColumns(docId)) {
+        const char * buf;
+        uint32_t buflen;
+        if (!_resultPacker.GetDocsumBlob(&buf, &buflen)) {
+            LOG(warning, "Error while getting the docsum blob for docId %u. Returning empty docsum", docId);
+            return DocsumStoreValue();
+        }
+        return DocsumStoreValue(buf, buflen);
+    }
+    Document::UP document = readDocument(docId);
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return DocsumStoreValue();
@@ -3,11 +3,15 @@
 #pragma once
 
 #include "fieldcache.h"
+#include "summaryfieldcolumns.h"
 #include <vespa/searchsummary/docsummary/docsumstore.h>
 #include <vespa/searchsummary/docsummary/resultconfig.h>
 #include <vespa/searchsummary/docsummary/resultpacker.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+
+namespace vespalib { class ThreadExecutor; }
 
 namespace proton {
 
@@ -21,6 +25,13 @@ private:
     search::docsummary::ResultPacker         _resultPacker;
     FieldCache::CSP                          _fieldCache;
     const std::set<vespalib::string>       & _markupFields;
+    SummaryFieldColumns::SP                  _columns;
+    std::vector<int>                         _columnIds;
+    vespalib::ThreadExecutor               * _prefetchExecutor;
+    vespalib::hash_map<uint32_t, document::Document::UP> _prefetched;
+
+    void readDocuments(const std::vector<uint32_t> & docIds);
+    document::Document::UP readDocument(uint32_t docId);
 
     bool
     writeStringField(const char * buf,
@@ -31,24 +42,48 @@ private:
     writeField(const document::FieldValue &value,
                search::docsummary::ResType type);
 
+    void
+    writeSummaryField(const search::docsummary::ResConfigEntry &entry,
+                      const document::FieldValue *fieldValue, uint32_t docId);
+
     void
     convertFromSearchDoc(document::Document &doc, uint32_t docId);
 
+    bool
+    convertFromColumns(uint32_t docId);
+
+    void
+    setupColumns(SummaryFieldColumns::SP columns);
+
 public:
     DocumentStoreAdapter(const search::IDocumentStore &docStore,
                          const document::DocumentTypeRepo &repo,
                          const search::docsummary::ResultConfig &resultConfig,
                          const vespalib::string &resultClassName,
                          const FieldCache::CSP &fieldCache,
-                         const std::set<vespalib::string> &markupFields);
+                         const std::set<vespalib::string> &markupFields,
+                         SummaryFieldColumns::SP columns = SummaryFieldColumns::SP());
     ~DocumentStoreAdapter();
 
+    /**
+     * @return true if docsums are read from summary field columns when present there.
+     */
+    bool usesColumns() const { return static_cast<bool>(_columns); }
+
     const search::docsummary::ResultClass *getResultClass() const {
         return _resultClass;
     }
 
+    /**
+     * Set an executor used to read and deserialize prefetched documents in
+     * parallel. The calling thread takes part in the work, so this is safe
+     * to use with a busy executor.
+     */
+    void setPrefetchExecutor(vespalib::ThreadExecutor * executor) { _prefetchExecutor = executor; }
+
     uint32_t getNumDocs() const override { return _docStore.getDocIdLimit(); }
     search::docsummary::DocsumStoreValue getMappedDocsum(uint32_t docId) override;
+    void prefetch(const std::vector<uint32_t> & docIds) override;
     uint32_t getSummaryClassId() const override { return _resultClass->GetClassID(); }
 
 };
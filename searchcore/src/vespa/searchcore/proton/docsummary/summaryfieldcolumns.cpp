@@ -0,0 +1,113 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "summaryfieldcolumns.h"
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/repo/documenttyperepo.h>
+
+using document::Document;
+using document::DocumentType;
+
+namespace proton {
+
+SummaryFieldColumns::SummaryFieldColumns(const std::vector<vespalib::string> &fieldNames,
+                                         std::shared_ptr<const document::DocumentTypeRepo> repo)
+    : _fieldNames(fieldNames),
+      _repo(std::move(repo)),
+      _lock(),
+      _present(),
+      _columns(fieldNames.size()),
+      _numDocs(0)
+{
+}
+
+SummaryFieldColumns::~SummaryFieldColumns() = default;
+
+int
+SummaryFieldColumns::getColumnId(const vespalib::string &fieldName) const
+{
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        if (_fieldNames[i] == fieldName) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void
+SummaryFieldColumns::put(uint32_t lid, const Document &doc)
+{
+    std::vector<FieldValueUP> values;
+    values.reserve(_fieldNames.size());
+    const DocumentType &docType = doc.getType();
+    for (const auto &fieldName : _fieldNames) {
+        values.push_back(docType.hasField(fieldName) ? doc.getValue(docType.getField(fieldName)) : FieldValueUP());
+    }
+    std::vector<FieldValueUP> replaced;
+    replaced.reserve(_fieldNames.size());
+    std::lock_guard guard(_lock);
+    if (lid >= _present.size()) {
+        _present.resize(lid + 1, false);
+        for (auto &column : _columns) {
+            column.resize(lid + 1);
+        }
+    }
+    if ( ! _present[lid]) {
+        _present[lid] = true;
+        ++_numDocs;
+    }
+    for (size_t i = 0; i < _columns.size(); ++i) {
+        // Old values are destroyed after the lock is released
+        replaced.push_back(std::move(_columns[i][lid]));
+        _columns[i][lid] = std::move(values[i]);
+    }
+}
+
+void
+SummaryFieldColumns::remove(uint32_t lid)
+{
+    std::vector<FieldValueUP> removed;
+    std::lock_guard guard(_lock);
+    if ((lid < _present.size()) && _present[lid]) {
+        _present[lid] = false;
+        --_numDocs;
+        for (auto &column : _columns) {
+            removed.push_back(std::move(column[lid]));
+        }
+    }
+}
+
+void
+SummaryFieldColumns::clear()
+{
+    std::vector<std::vector<FieldValueUP>> columns(_fieldNames.size());
+    std::lock_guard guard(_lock);
+    _present.clear();
+    _columns.swap(columns);
+    _numDocs = 0;
+}
+
+bool
+SummaryFieldColumns::read(uint32_t lid, const std::vector<int> &columnIds, std::vector<FieldValueUP> &values) const
+{
+    std::lock_guard guard(_lock);
+    if ((lid >= _present.size()) || ! _present[lid]) {
+        return false;
+    }
+    values.clear();
+    values.reserve(columnIds.size());
+    for (int columnId : columnIds) {
+        const FieldValueUP &value = _columns[columnId][lid];
+        values.emplace_back(value ? FieldValueUP(value->clone()) : FieldValueUP());
+    }
+    return true;
+}
+
+size_t
+SummaryFieldColumns::getNumDocs() const
+{
+    std::lock_guard guard(_lock);
+    return _numDocs;
+}
+
+} // namespace proton
@@ -0,0 +1,68 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace document {
+    class Document;
+    class DocumentTypeRepo;
+    class FieldValue;
+}
+
+namespace proton {
+
+/**
+ * In-memory columnar store of the values of selected (hot) summary fields, with one column
+ * per field indexed by lid. It is populated when documents are put to the summary manager,
+ * and lets docsum requests for result classes covered by the columns skip reading,
+ * decompressing and deserializing the whole document from the document store.
+ *
+ * The columns are not persisted. Only lids with a document put since the columns were
+ * created are present; all other lids must be read from the document store.
+ */
+class SummaryFieldColumns
+{
+public:
+    using SP = std::shared_ptr<SummaryFieldColumns>;
+    using FieldValueUP = std::unique_ptr<document::FieldValue>;
+
+    SummaryFieldColumns(const std::vector<vespalib::string> &fieldNames,
+                        std::shared_ptr<const document::DocumentTypeRepo> repo);
+    ~SummaryFieldColumns();
+
+    const std::vector<vespalib::string> &getFieldNames() const { return _fieldNames; }
+    const std::shared_ptr<const document::DocumentTypeRepo> &getRepo() const { return _repo; }
+
+    /**
+     * @return the column holding the given field, or -1 if the field has no column.
+     */
+    int getColumnId(const vespalib::string &fieldName) const;
+
+    void put(uint32_t lid, const document::Document &doc);
+    void remove(uint32_t lid);
+    void clear();
+
+    /**
+     * Copies the values of the given lid from the given (valid) columns. A field
+     * missing in the document gives an empty value.
+     *
+     * @return false if the lid is not present, leaving values untouched.
+     */
+    bool read(uint32_t lid, const std::vector<int> &columnIds, std::vector<FieldValueUP> &values) const;
+
+    size_t getNumDocs() const;
+
+private:
+    const std::vector<vespalib::string>                     _fieldNames;
+    const std::shared_ptr<const document::DocumentTypeRepo> _repo;
+    mutable std::mutex                                      _lock;
+    std::vector<bool>                                       _present;
+    std::vector<std::vector<FieldValueUP>>                  _columns;
+    size_t                                                  _numDocs;
+};
+
+} // namespace proton
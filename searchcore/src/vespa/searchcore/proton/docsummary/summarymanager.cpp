@@ -83,7 +83,8 @@ SummaryManager::SummarySetup::
 SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName, const SummaryConfig & summaryCfg,
              const SummarymapConfig & summarymapCfg, const JuniperrcConfig & juniperCfg,
              search::IAttributeManager::SP attributeMgr, search::IDocumentStore::SP docStore,
-             std::shared_ptr<const DocumentTypeRepo> repo)
+             std::shared_ptr<const DocumentTypeRepo> repo, SummaryFieldColumns::SP columns,
+             vespalib::ThreadExecutor * prefetchExecutor)
     : _docsumWriter(),
       _wordFolder(std::make_unique<Fast_NormalizeWordFolder>()),
       _juniperProps(juniperCfg),
@@ -92,7 +93,10 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
       _docStore(std::move(docStore)),
       _fieldCacheRepo(),
       _repo(repo),
-      _markupFields()
+      _markupFields(),
+      _documentFields(),
+      _columns(std::move(columns)),
+      _prefetchExecutor(prefetchExecutor)
 {
     auto resultConfig = std::make_unique<ResultConfig>();
     if (!resultConfig->ReadConfig(summaryCfg, make_string("SummaryManager(%s)", baseDir.c_str()).c_str())) {
@@ -115,6 +119,9 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
                 continue;
             // Assume just one argument: source field that must contain markup
             _markupFields.insert(markupField);
+        } else if (o.command == "matchedelementsfilter") {
+            // Reads the source field from the document instead of the docsum blob
+            _documentFields.insert(o.field);
         }
     }
     const DocumentType *docType = repo->getDocumentType(docTypeName.getName());
@@ -130,10 +137,33 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
     }
 }
 
+bool
+SummaryManager::SummarySetup::needsDocument(const vespalib::string &resultClassName)
+{
+    const ResultConfig &resultConfig = getResultConfig();
+    const ResultClass *resultClass = resultConfig.LookupResultClass(resultConfig.LookupResultClassId(resultClassName.c_str()));
+    if (resultClass == nullptr) {
+        return true;
+    }
+    for (uint32_t i = 0; i < resultClass->GetNumEntries(); ++i) {
+        if (_documentFields.find(resultClass->GetEntry(i)->_bindname) != _documentFields.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 IDocsumStore::UP
 SummaryManager::SummarySetup::createDocsumStore(const vespalib::string &resultClassName) {
-    return std::make_unique<DocumentStoreAdapter>(*_docStore, *_repo, getResultConfig(), resultClassName,
-                                                  _fieldCacheRepo->getFieldCache(resultClassName), _markupFields);
+    SummaryFieldColumns::SP columns;
+    if (_columns && !needsDocument(resultClassName)) {
+        columns = _columns;
+    }
+    auto store = std::make_unique<DocumentStoreAdapter>(*_docStore, *_repo, getResultConfig(), resultClassName,
+                                                        _fieldCacheRepo->getFieldCache(resultClassName), _markupFields,
+                                                        std::move(columns));
+    store->setPrefetchExecutor(_prefetchExecutor);
+    return store;
 }
 
 
@@ -143,7 +173,31 @@ SummaryManager::createSummarySetup(const SummaryConfig & summaryCfg, const Summa
                                    const search::IAttributeManager::SP &attributeMgr)
 {
     return std::make_shared<SummarySetup>(_baseDir, _docTypeName, summaryCfg, summarymapCfg,
-                                          juniperCfg, attributeMgr, _docStore, repo);
+                                          juniperCfg, attributeMgr, _docStore, repo,
+                                          updateColumns(summaryCfg.columnarfields, repo), &_executor);
+}
+
+SummaryFieldColumns::SP
+SummaryManager::getColumns() const
+{
+    std::lock_guard guard(_columnsLock);
+    return _columns;
+}
+
+SummaryFieldColumns::SP
+SummaryManager::updateColumns(const std::vector<vespalib::string> &fieldNames,
+                              const std::shared_ptr<const DocumentTypeRepo> &repo)
+{
+    std::lock_guard guard(_columnsLock);
+    if (_columns && (_columns->getFieldNames() == fieldNames) && (_columns->getRepo() == repo)) {
+        return _columns;
+    }
+    if (_columns) {
+        // Summary setups still using the old columns must fall back to the document store.
+        _columns->clear();
+    }
+    _columns = fieldNames.empty() ? SummaryFieldColumns::SP() : std::make_shared<SummaryFieldColumns>(fieldNames, repo);
+    return _columns;
 }
 
 SummaryManager::SummaryManager(vespalib::ThreadExecutor & executor, const LogDocumentStore::Config & storeConfig,
@@ -154,8 +208,11 @@ SummaryManager::SummaryManager(vespalib::ThreadExecutor & executor, const LogDoc
     : _baseDir(baseDir),
       _docTypeName(docTypeName),
       _docStore(),
+      _executor(executor),
       _tuneFileSummary(tuneFileSummary),
-      _currentSerial(0u)
+      _currentSerial(0u),
+      _columnsLock(),
+      _columns()
 {
     _docStore = std::make_shared<LogDocumentStore>(executor, baseDir, storeConfig, growStrategy, tuneFileSummary,
                                                    fileHeaderContext, tlSyncer, std::move(bucketizer));
@@ -168,6 +225,9 @@ SummaryManager::putDocument(uint64_t syncToken, search::DocumentIdT lid, const D
 {
     _docStore->write(syncToken, lid, doc);
     _currentSerial = syncToken;
+    if (auto columns = getColumns()) {
+        columns->put(lid, doc);
+    }
 }
 
 void
@@ -175,6 +235,10 @@ SummaryManager::putDocument(uint64_t syncToken, search::DocumentIdT lid, const v
 {
     _docStore->write(syncToken, lid, doc);
     _currentSerial = syncToken;
+    if (auto columns = getColumns()) {
+        // Not worth deserializing the document, the lid is read from the document store instead
+        columns->remove(lid);
+    }
 }
 
 void
@@ -182,6 +246,9 @@ SummaryManager::removeDocument(uint64_t syncToken, search::DocumentIdT lid)
 {
     _docStore->remove(syncToken, lid);
     _currentSerial = syncToken;
+    if (auto columns = getColumns()) {
+        columns->remove(lid);
+    }
 }
 
 namespace {
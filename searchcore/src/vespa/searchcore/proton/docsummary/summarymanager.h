@@ -3,6 +3,7 @@
 
 #include "isummarymanager.h"
 #include "fieldcacherepo.h"
+#include "summaryfieldcolumns.h"
 #include <vespa/searchcore/proton/attribute/attributemanager.h>
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcorespi/flush/iflushtarget.h>
@@ -34,6 +35,11 @@ public:
         FieldCacheRepo::UP                    _fieldCacheRepo;
         const std::shared_ptr<const document::DocumentTypeRepo>  _repo;
         std::set<vespalib::string>            _markupFields;
+        std::set<vespalib::string>            _documentFields;
+        SummaryFieldColumns::SP               _columns;
+        vespalib::ThreadExecutor            * _prefetchExecutor;
+
+        bool needsDocument(const vespalib::string &resultClassName);
     public:
         SummarySetup(const vespalib::string & baseDir,
                      const DocTypeName & docTypeName,
@@ -42,7 +48,9 @@ public:
                      const vespa::config::search::summary::JuniperrcConfig & juniperCfg,
                      search::IAttributeManager::SP attributeMgr,
                      search::IDocumentStore::SP docStore,
-                     std::shared_ptr<const document::DocumentTypeRepo> repo);
+                     std::shared_ptr<const document::DocumentTypeRepo> repo,
+                     SummaryFieldColumns::SP columns = SummaryFieldColumns::SP(),
+                     vespalib::ThreadExecutor * prefetchExecutor = nullptr);
 
         search::docsummary::IDocsumWriter & getDocsumWriter() const override { return *_docsumWriter; }
         search::docsummary::ResultConfig & getResultConfig() override { return *_docsumWriter->GetResultConfig(); }
@@ -58,8 +66,15 @@ private:
     vespalib::string               _baseDir;
     DocTypeName                    _docTypeName;
     std::shared_ptr<search::IDocumentStore> _docStore;
+    vespalib::ThreadExecutor     & _executor;
     const search::TuneFileSummary  _tuneFileSummary;
     uint64_t                       _currentSerial;
+    mutable std::mutex             _columnsLock;
+    SummaryFieldColumns::SP        _columns;
+
+    SummaryFieldColumns::SP getColumns() const;
+    SummaryFieldColumns::SP updateColumns(const std::vector<vespalib::string> &fieldNames,
+                                          const std::shared_ptr<const document::DocumentTypeRepo> &repo);
 
 public:
     typedef std::shared_ptr<SummaryManager> SP;
@@ -132,6 +132,14 @@ public:
 }
 
 namespace {
+
+/*
+ * How far ahead in a bucket's lid list the meta data is prefetched when
+ * iterating the bucket. The lids of a bucket are scattered over the meta
+ * data vector, so this lets the cache misses for them overlap.
+ */
+constexpr size_t META_DATA_PREFETCH_DISTANCE = 8;
+
 class ShrinkBlockHeld : public GenerationHeldBase
 {
     DocumentMetaStore &_dms;
@@ -318,6 +326,19 @@ DocumentMetaStore::upperBound(const BucketId &bucketId,
     return treeView.upperBound(KeyComp::FIND_DOC_ID, upperComp);
 }
 
+template <typename TreeView>
+void
+DocumentMetaStore::collectBucketLids(const BucketId &bucketId,
+                                     const TreeView &treeView,
+                                     std::vector<DocId> &lids) const
+{
+    auto itr = lowerBound(bucketId, treeView);
+    auto end = upperBound(bucketId, treeView);
+    for (; itr != end; ++itr) {
+        lids.push_back(itr.getKey());
+    }
+}
+
 void
 DocumentMetaStore::updateMetaDataAndBucketDB(const GlobalId &gid,
                                              DocId lid,
@@ -705,11 +726,14 @@ void
 DocumentMetaStore::getMetaData(const BucketId &bucketId,
                                search::DocumentMetaData::Vector &result) const
 {
-    TreeType::FrozenView frozenTreeView = _gidToLidMap.getFrozenView();
-    TreeType::ConstIterator itr = lowerBound(bucketId, frozenTreeView);
-    TreeType::ConstIterator end = upperBound(bucketId, frozenTreeView);
-    for (; itr != end; ++itr) {
-        DocId lid = itr.getKey();
+    std::vector<DocId> lids;
+    collectBucketLids(bucketId, _gidToLidMap.getFrozenView(), lids);
+    result.reserve(result.size() + lids.size());
+    for (size_t i = 0; i < lids.size(); ++i) {
+        if (i + META_DATA_PREFETCH_DISTANCE < lids.size()) {
+            prefetchMetaData(lids[i + META_DATA_PREFETCH_DISTANCE]);
+        }
+        DocId lid = lids[i];
         if (validLid(lid)) {
             const RawDocumentMetaData &rawData = getRawMetaData(lid);
             if (bucketId.getUsedBits() != rawData.getBucketUsedBits())
@@ -796,10 +820,14 @@ void
 DocumentMetaStore::getLids(const BucketId &bucketId, std::vector<DocId> &lids)
 {
     // Called by writer thread
-    TreeType::Iterator itr = lowerBound(bucketId);
-    TreeType::Iterator end = upperBound(bucketId);
-    for (; itr != end; ++itr) {
-        DocId lid = itr.getKey();
+    std::vector<DocId> bucketLids;
+    collectBucketLids(bucketId, _gidToLidMap, bucketLids);
+    lids.reserve(lids.size() + bucketLids.size());
+    for (size_t i = 0; i < bucketLids.size(); ++i) {
+        if (i + META_DATA_PREFETCH_DISTANCE < bucketLids.size()) {
+            prefetchMetaData(bucketLids[i + META_DATA_PREFETCH_DISTANCE]);
+        }
+        DocId lid = bucketLids[i];
         assert(validLid(lid));
         const RawDocumentMetaData &metaData = getRawMetaData(lid);
         uint8_t bucketUsedBits = metaData.getBucketUsedBits();
@@ -826,11 +854,14 @@ DocumentMetaStore::handleSplit(const bucketdb::SplitBucketSession &session)
         }
     }
 
-    TreeType::Iterator itr = lowerBound(source);
-    TreeType::Iterator end = upperBound(source);
+    std::vector<DocId> lids;
+    collectBucketLids(source, _gidToLidMap, lids);
     bucketdb::BucketDeltaPair deltas;
-    for (; itr != end; ++itr) {
-        DocId lid = itr.getKey();
+    for (size_t i = 0; i < lids.size(); ++i) {
+        if (i + META_DATA_PREFETCH_DISTANCE < lids.size()) {
+            prefetchMetaData(lids[i + META_DATA_PREFETCH_DISTANCE]);
+        }
+        DocId lid = lids[i];
         assert(validLid(lid));
         RawDocumentMetaData &metaData = _metaDataStore[lid];
         uint8_t bucketUsedBits = metaData.getBucketUsedBits();
@@ -871,11 +902,14 @@ DocumentMetaStore::handleJoin(const bucketdb::JoinBucketsSession &session)
     const BucketId &source2(session.getSource2());
     const BucketId &target(session.getTarget());
 
-    TreeType::Iterator itr = lowerBound(target);
-    TreeType::Iterator end = upperBound(target);
+    std::vector<DocId> lids;
+    collectBucketLids(target, _gidToLidMap, lids);
     bucketdb::BucketDeltaPair deltas;
-    for (; itr != end; ++itr) {
-        DocId lid = itr.getKey();
+    for (size_t i = 0; i < lids.size(); ++i) {
+        if (i + META_DATA_PREFETCH_DISTANCE < lids.size()) {
+            prefetchMetaData(lids[i + META_DATA_PREFETCH_DISTANCE]);
+        }
+        DocId lid = lids[i];
         assert(validLid(lid));
         RawDocumentMetaData &metaData = _metaDataStore[lid];
         assert(BucketId::validUsedBits(metaData.getBucketUsedBits()));
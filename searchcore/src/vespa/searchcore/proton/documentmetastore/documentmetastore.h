@@ -103,6 +103,21 @@ private:
     upperBound(const BucketId &bucketId,
                const TreeView &treeView) const;
 
+    /**
+     * Collects the lids of all documents in the given bucket (including
+     * documents in overlapping buckets) by walking the gid tree only,
+     * without touching the meta data of each document.
+     */
+    template <typename TreeView>
+    void
+    collectBucketLids(const BucketId &bucketId,
+                      const TreeView &treeView,
+                      std::vector<DocId> &lids) const;
+
+    void prefetchMetaData(DocId lid) const {
+        __builtin_prefetch(&_metaDataStore[lid]);
+    }
+
     void updateMetaDataAndBucketDB(const GlobalId &gid,
                                    DocId lid,
                                    const RawDocumentMetaData &newMetaData);
@@ -18,6 +18,13 @@ public:
 
     virtual bool operator()(const document::GlobalId &lhs,
                             const document::GlobalId &rhs) const = 0;
+
+    /**
+     * Returns true if this ordering is the one given by
+     * document::GlobalId::BucketOrderCmp, allowing callers to compare
+     * precomputed bucket order keys instead of calling this object.
+     */
+    virtual bool isBucketOrder() const { return false; }
 };
 
 
@@ -39,6 +46,8 @@ public:
     bool operator()(const document::GlobalId &lhs, const document::GlobalId &rhs) const override {
         return _comp(lhs, rhs);
     }
+
+    bool isBucketOrder() const override { return true; }
 };
 
 
@@ -26,6 +26,8 @@ private:
     const document::GlobalId &_gid;
     const MetaDataStore      &_metaDataStore;
     const IGidCompare        &_gidCompare;
+    bool                      _bucketOrder;
+    uint64_t                  _findKey;
 
     const document::GlobalId &getGid(DocId lid) const {
         if (lid != FIND_DOC_ID) {
@@ -34,6 +36,13 @@ private:
         return _gid;
     }
 
+    uint64_t getBucketOrderKey(DocId lid) const {
+        if (lid != FIND_DOC_ID) {
+            return document::GlobalId::BucketOrderCmp::bucketOrderKey(_metaDataStore[lid].getGid());
+        }
+        return _findKey;
+    }
+
 public:
     /**
      * Creates a comparator that returns the given gid if
@@ -49,7 +58,17 @@ public:
                         const IGidCompare &gidCompare);
 
     bool operator()(const DocId &lhs, const DocId &rhs) const {
-            return _gidCompare(getGid(lhs), getGid(rhs));
+        if (_bucketOrder) {
+            // Word compare of the bucket ordered gid bytes, with the key of the
+            // gid being looked up computed only once per lookup.
+            uint64_t lhsKey = getBucketOrderKey(lhs);
+            uint64_t rhsKey = getBucketOrderKey(rhs);
+            if (lhsKey != rhsKey) {
+                return lhsKey < rhsKey;
+            }
+            return getGid(lhs) < getGid(rhs);
+        }
+        return _gidCompare(getGid(lhs), getGid(rhs));
     }
 
 };
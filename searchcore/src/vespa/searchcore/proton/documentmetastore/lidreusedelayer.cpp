@@ -17,14 +17,11 @@ LidReuseDelayer::LidReuseDelayer(IThreadingService &writeService, IStore &docume
       _documentMetaStore(documentMetaStore),
       _immediateCommit(config.visibilityDelay() == vespalib::duration::zero()),
       _allowEarlyAck(config.allowEarlyAck()),
-      _config(config),
-      _pendingLids()
+      _config(config)
 {
 }
 
-LidReuseDelayer::~LidReuseDelayer() {
-    assert(_pendingLids.empty());
-}
+LidReuseDelayer::~LidReuseDelayer() = default;
 
 bool
 LidReuseDelayer::delayReuse(uint32_t lid)
@@ -32,10 +29,6 @@ LidReuseDelayer::delayReuse(uint32_t lid)
     assert(_writeService.master().isCurrentThread());
     if ( ! _documentMetaStore.getFreeListActive())
         return false;
-    if ( ! _immediateCommit) {
-        _pendingLids.push_back(lid);
-        return false;
-    }
     if ( ! _config.hasIndexedOrAttributeFields() ) {
         _documentMetaStore.removeComplete(lid);
         return false;
@@ -49,10 +42,6 @@ LidReuseDelayer::delayReuse(const std::vector<uint32_t> &lids)
     assert(_writeService.master().isCurrentThread());
     if ( ! _documentMetaStore.getFreeListActive() || lids.empty())
         return false;
-    if ( ! _immediateCommit) {
-        _pendingLids.insert(_pendingLids.end(), lids.cbegin(), lids.cend());
-        return false;
-    }
     if ( ! _config.hasIndexedOrAttributeFields()) {
         _documentMetaStore.removeBatchComplete(lids);
         return false;
@@ -60,15 +49,5 @@ LidReuseDelayer::delayReuse(const std::vector<uint32_t> &lids)
     return true;
 }
 
-std::vector<uint32_t>
-LidReuseDelayer::getReuseLids()
-{
-    std::vector<uint32_t> result;
-    assert(_writeService.master().isCurrentThread());
-    result = _pendingLids;
-    _pendingLids.clear();
-    return result;
-}
-
 }
 
@@ -20,7 +20,10 @@ struct IStore;
  * where lids are put on a hold list to ensure that queries started
  * before lid was purged also blocks reuse of lid.
  *
- * Currently only works correctly when visibility delay is 0.
+ * Lids are handed over to the hold list as soon as the remove has been
+ * applied, also when visibility delay is non-zero, so reuse does not
+ * wait for the next commit. A lid reused before the commit behaves as
+ * a put to an existing lid for the memory index and attribute vectors.
  */
 class LidReuseDelayer
 {
@@ -29,7 +32,6 @@ class LidReuseDelayer
     const bool _immediateCommit;
     const bool _allowEarlyAck;
     LidReuseDelayerConfig _config;
-    std::vector<uint32_t> _pendingLids; // lids waiting for commit
 
 public:
     LidReuseDelayer(searchcorespi::index::IThreadingService &writeService, IStore &documentMetaStore,
@@ -37,7 +39,6 @@ public:
     ~LidReuseDelayer();
     bool delayReuse(uint32_t lid);
     bool delayReuse(const std::vector<uint32_t> &lids);
-    std::vector<uint32_t> getReuseLids();
 
     bool needImmediateCommit() const { return _immediateCommit; }
     bool allowEarlyAck() const { return _allowEarlyAck; }
@@ -12,7 +12,9 @@ CachedFlushTarget::CachedFlushTarget(const IFlushTarget::SP &target)
       _memoryGain(target->getApproxMemoryGain()),
       _diskGain(target->getApproxDiskGain()),
       _needUrgentFlush(target->needUrgentFlush()),
-      _approxBytesToWriteToDisk(target->getApproxBytesToWriteToDisk())
+      _approxBytesToWriteToDisk(target->getApproxBytesToWriteToDisk()),
+      _approxTransientMemory(target->get_approx_transient_memory()),
+      _replayOperationCost(target->get_replay_operation_cost())
 {
     // empty
 }
@@ -21,6 +21,8 @@ private:
     DiskGain          _diskGain;
     bool              _needUrgentFlush;
     uint64_t          _approxBytesToWriteToDisk;
+    uint64_t          _approxTransientMemory;
+    double            _replayOperationCost;
 
 public:
     /**
@@ -52,6 +54,8 @@ public:
     virtual FlushStats getLastFlushStats() const override { return _target->getLastFlushStats(); }
 
     virtual uint64_t getApproxBytesToWriteToDisk() const override;
+    virtual uint64_t get_approx_transient_memory() const override { return _approxTransientMemory; }
+    virtual double get_replay_operation_cost() const override { return _replayOperationCost; }
 };
 
 } // namespace proton
@@ -60,29 +60,34 @@ FlushEngine::FlushMeta::~FlushMeta() = default;
 
 FlushEngine::FlushInfo::FlushInfo()
     : FlushMeta("", 0),
-      _target()
+      _target(),
+      _small(false)
 {
 }
 
 FlushEngine::FlushInfo::~FlushInfo() = default;
 
 
-FlushEngine::FlushInfo::FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string & destination)
+FlushEngine::FlushInfo::FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string & destination, bool small)
     : FlushMeta(destination, taskId),
-      _target(target)
+      _target(target),
+      _small(small)
 {
 }
 
 FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
-                         IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS)
+                         IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS,
+                         uint32_t numSmallThreads, uint64_t smallTargetBytes)
     : _closed(false),
       _maxConcurrent(numThreads),
+      _maxConcurrentSmall(numSmallThreads),
+      _smallTargetBytes(smallTargetBytes),
       _idleIntervalMS(idleIntervalMS),
       _taskId(0),
       _threadPool(128 * 1024),
       _strategy(std::move(strategy)),
       _priorityStrategy(),
-      _executor(numThreads, 128 * 1024),
+      _executor(numThreads + numSmallThreads, 128 * 1024),
       _lock(),
       _cond(),
       _handlers(),
@@ -94,6 +99,11 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStats
       _pendingPrune()
 { }
 
+FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
+                         IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS)
+    : FlushEngine(std::move(tlsStatsFactory), std::move(strategy), numThreads, idleIntervalMS, 0, 0)
+{ }
+
 FlushEngine::~FlushEngine()
 {
     close();
@@ -138,20 +148,45 @@ FlushEngine::kick()
 }
 
 bool
-FlushEngine::canFlushMore(const std::unique_lock<std::mutex> &guard) const
+FlushEngine::isSmallTarget(const IFlushTarget &target) const
+{
+    return (_maxConcurrentSmall > 0) && (target.getApproxBytesToWriteToDisk() <= _smallTargetBytes);
+}
+
+bool
+FlushEngine::canFlushMore(const std::unique_lock<std::mutex> &guard, bool largeTarget) const
 {
     (void) guard;
-    return _maxConcurrent > _flushing.size();
+    if (_maxConcurrent + _maxConcurrentSmall <= _flushing.size()) {
+        return false;
+    }
+    if (largeTarget) {
+        uint32_t numLarge = 0;
+        for (const auto & it : _flushing) {
+            if ( ! it.second._small) {
+                ++numLarge;
+            }
+        }
+        return _maxConcurrent > numLarge;
+    }
+    return true;
+}
+
+bool
+FlushEngine::canFlushLarge() const
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    return canFlushMore(guard, true);
 }
 
 bool
-FlushEngine::wait(size_t minimumWaitTimeIfReady)
+FlushEngine::wait(size_t minimumWaitTimeIfReady, bool largeTarget)
 {
     std::unique_lock<std::mutex> guard(_lock);
-    if ( (minimumWaitTimeIfReady > 0) && canFlushMore(guard) && _pendingPrune.empty()) {
+    if ( (minimumWaitTimeIfReady > 0) && canFlushMore(guard, largeTarget) && _pendingPrune.empty()) {
         _cond.wait_for(guard, std::chrono::milliseconds(minimumWaitTimeIfReady));
     }
-    while ( ! canFlushMore(guard) && _pendingPrune.empty()) {
+    while ( ! canFlushMore(guard, largeTarget) && _pendingPrune.empty()) {
         _cond.wait_for(guard, 1s); // broadcast when flush done
     }
     return !_closed;
@@ -162,7 +197,7 @@ FlushEngine::Run(FastOS_ThreadInterface *, void *)
 {
     bool shouldIdle = false;
     vespalib::string prevFlushName;
-    while (wait(shouldIdle ? _idleIntervalMS : 0)) {
+    while (wait(shouldIdle ? _idleIntervalMS : 0, false)) {
         shouldIdle = false;
         if (prune()) {
             continue; // Prune attempted on one or more handlers
@@ -270,7 +305,12 @@ FlushContext::SP
 FlushEngine::initNextFlush(const FlushContext::List &lst)
 {
     FlushContext::SP ctx;
+    bool canFlushLargeTarget = canFlushLarge();
     for (const FlushContext::SP & it : lst) {
+        if ( ! canFlushLargeTarget && ! isSmallTarget(*it->getTarget())) {
+            LOG(debug, "Skipping large target '%s' while all large flush slots are busy", it->getName().c_str());
+            continue;
+        }
         if (LOG_WOULD_LOG(event)) {
             EventLogger::flushInit(it->getName());
         }
@@ -290,7 +330,7 @@ FlushEngine::flushAll(const FlushContext::List &lst)
 {
     LOG(debug, "%ld targets to flush.", lst.size());
     for (const FlushContext::SP & ctx : lst) {
-        if (wait(0)) {
+        if (wait(0, ! isSmallTarget(*ctx->getTarget()))) {
             if (ctx->initFlush()) {
                 logTarget("initiated", *ctx);
                 _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx), *this, ctx));
@@ -408,7 +448,7 @@ FlushEngine::initFlush(const IFlushHandler::SP &handler, const IFlushTarget::SP
         std::lock_guard<std::mutex> guard(_lock);
         taskId = _taskId++;
         vespalib::string name(FlushContext::createName(*handler, *target));
-        FlushInfo flush(taskId, target, name);
+        FlushInfo flush(taskId, target, name, isSmallTarget(*target));
         _flushing[taskId] = flush;
     }
     LOG(debug, "FlushEngine::initFlush(handler='%s', target='%s') => taskId='%d'",
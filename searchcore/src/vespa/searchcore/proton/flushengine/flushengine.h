@@ -39,15 +39,18 @@ private:
     struct FlushInfo : public FlushMeta
     {
         FlushInfo();
-        FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string &destination);
+        FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string &destination, bool small);
         ~FlushInfo();
 
         IFlushTarget::SP  _target;
+        bool              _small;
     };
     typedef std::map<uint32_t, FlushInfo> FlushMap;
     typedef HandlerMap<IFlushHandler> FlushHandlerMap;
     bool                           _closed;
     const uint32_t                 _maxConcurrent;
+    const uint32_t                 _maxConcurrentSmall;
+    const uint64_t                 _smallTargetBytes;
     const uint32_t                 _idleIntervalMS;
     uint32_t                       _taskId;    
     FastOS_ThreadPool              _threadPool;
@@ -73,8 +76,10 @@ private:
     uint32_t initFlush(const FlushContext &ctx);
     uint32_t initFlush(const IFlushHandler::SP &handler, const IFlushTarget::SP &target);
     void flushDone(const FlushContext &ctx, uint32_t taskId);
-    bool canFlushMore(const std::unique_lock<std::mutex> &guard) const;
-    bool wait(size_t minimumWaitTimeIfReady);
+    bool isSmallTarget(const IFlushTarget &target) const;
+    bool canFlushMore(const std::unique_lock<std::mutex> &guard, bool largeTarget) const;
+    bool canFlushLarge() const;
+    bool wait(size_t minimumWaitTimeIfReady, bool largeTarget);
     bool isFlushing(const std::lock_guard<std::mutex> &guard, const vespalib::string & name) const;
 
     friend class FlushTask;
@@ -95,7 +100,13 @@ public:
      * @param strategy   The flushing strategy to use.
      * @param numThreads The number of worker threads to use.
      * @param idleInterval The interval between when flushes are checked whne there are no one progressing.
+     * @param numSmallThreads The number of extra worker threads only used for small targets,
+     *                        letting many small targets flush while large targets are flushing.
+     * @param smallTargetBytes Targets writing at most this many bytes to disk are small.
      */
+    FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
+                IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS,
+                uint32_t numSmallThreads, uint64_t smallTargetBytes);
     FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
                 IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS);
 
@@ -78,5 +78,17 @@ FlushTargetProxy::getApproxBytesToWriteToDisk() const
     return _target->getApproxBytesToWriteToDisk();
 }
 
+uint64_t
+FlushTargetProxy::get_approx_transient_memory() const
+{
+    return _target->get_approx_transient_memory();
+}
+
+double
+FlushTargetProxy::get_replay_operation_cost() const
+{
+    return _target->get_replay_operation_cost();
+}
+
 
 } // namespace proton
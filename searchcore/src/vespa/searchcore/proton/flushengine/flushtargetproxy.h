@@ -68,6 +68,8 @@ public:
     getLastFlushStats() const override;
 
     virtual uint64_t getApproxBytesToWriteToDisk() const override;
+    virtual uint64_t get_approx_transient_memory() const override;
+    virtual double get_replay_operation_cost() const override;
 };
 
 } // namespace proton
@@ -1,9 +1,16 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "flushtask.h"
+#include <vespa/vespalib/util/ring_tracer.h>
 
 namespace proton {
 
+namespace {
+
+RT_Tag flush_tag("proton.flush");
+
+}
+
 FlushTask::FlushTask(uint32_t taskId,
                      FlushEngine &engine,
                      const FlushContext::SP &ctx)
@@ -22,6 +29,7 @@ FlushTask::~FlushTask()
 void
 FlushTask::run()
 {
+    RT_Sample sample(flush_tag);
     searchcorespi::FlushTask::UP task(_context->getTask());
     search::SerialNum flushSerial(task->getFlushSerial());
     if (flushSerial != 0) {
@@ -0,0 +1,181 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "memory_budget_flush_strategy.h"
+#include "flush_target_candidates.h"
+#include "flush_target_candidate.h"
+#include "tls_stats_map.h"
+#include <algorithm>
+#include <cinttypes>
+#include <map>
+#include <set>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.flushengine.memory_budget_flush_strategy");
+
+namespace proton {
+
+using searchcorespi::IFlushTarget;
+
+using Config = MemoryBudgetFlushStrategy::Config;
+using FlushContextsMap = std::map<vespalib::string, FlushContext::List>;
+
+MemoryBudgetFlushStrategy::Config::Config(uint64_t memoryBudget_,
+                                          double lowWatermarkFactor_,
+                                          const PrepareRestartFlushStrategy::Config &replayCost_)
+    : memoryBudget(memoryBudget_),
+      lowWatermarkFactor(lowWatermarkFactor_),
+      replayCost(replayCost_)
+{
+}
+
+MemoryBudgetFlushStrategy::MemoryBudgetFlushStrategy(const Config &cfg)
+    : _cfg(cfg)
+{
+}
+
+namespace {
+
+uint64_t
+getMemoryGain(const FlushContext &ctx)
+{
+    int64_t gain = ctx.getTarget()->getApproxMemoryGain().gain();
+    return (gain > 0) ? gain : 0;
+}
+
+uint64_t
+getTransientMemory(const FlushContext &ctx)
+{
+    return ctx.getTarget()->get_approx_transient_memory();
+}
+
+/**
+ * Tracks the predicted memory usage while selecting targets to flush.
+ */
+class MemoryPrediction
+{
+    uint64_t _used;
+    uint64_t _maxTransient;
+    uint64_t _budget;
+public:
+    MemoryPrediction(const FlushContext::List &targets, uint64_t budget)
+        : _used(0),
+          _maxTransient(0),
+          _budget(budget)
+    {
+        for (const auto &ctx : targets) {
+            _used += getMemoryGain(*ctx);
+            _maxTransient = std::max(_maxTransient, getTransientMemory(*ctx));
+        }
+    }
+    uint64_t used() const { return _used; }
+    uint64_t peak() const { return _used + _maxTransient; }
+    bool canFlush(const FlushContext &ctx) const {
+        uint64_t transient = getTransientMemory(ctx);
+        return (transient == 0) || (_used + transient <= _budget);
+    }
+    void flushed(const FlushContext &ctx) {
+        _used -= std::min(_used, getMemoryGain(ctx));
+    }
+};
+
+void
+addMemoryPressureTargets(const FlushContext::List &targets, uint64_t lowWatermark,
+                         MemoryPrediction &prediction, FlushContext::List &result)
+{
+    FlushContext::List sorted(targets);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto &lhs, const auto &rhs) {
+                  return getMemoryGain(*lhs) > getMemoryGain(*rhs);
+              });
+    for (const auto &ctx : sorted) {
+        if (prediction.peak() <= lowWatermark || getMemoryGain(*ctx) == 0) {
+            break;
+        }
+        if (ctx->getTarget()->needUrgentFlush()) {
+            continue; // already selected
+        }
+        if (!prediction.canFlush(*ctx)) {
+            LOG(debug, "addMemoryPressureTargets(): Deferring '%s', transient memory %" PRIu64 " exceeds budget",
+                ctx->getName().c_str(), getTransientMemory(*ctx));
+            continue;
+        }
+        result.push_back(ctx);
+        prediction.flushed(*ctx);
+    }
+}
+
+FlushContext::List
+findBestReplayTargets(const FlushContext::List &flushContexts,
+                      const flushengine::TlsStats &tlsStats,
+                      const PrepareRestartFlushStrategy::Config &cfg)
+{
+    std::vector<FlushTargetCandidate> candidates;
+    candidates.reserve(flushContexts.size());
+    for (const auto &flushContext : flushContexts) {
+        candidates.emplace_back(flushContext, tlsStats.getLastSerial(), cfg);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &lhs, const auto &rhs) {
+                  if (lhs.get_flushed_serial() == rhs.get_flushed_serial()) {
+                      return lhs.get_flush_context()->getName() < rhs.get_flush_context()->getName();
+                  }
+                  return lhs.get_flushed_serial() < rhs.get_flushed_serial();
+              });
+    FlushTargetCandidates bestSet(candidates, 0, tlsStats, cfg);
+    for (size_t numCandidates = 1; numCandidates <= candidates.size(); ++numCandidates) {
+        FlushTargetCandidates nextSet(candidates, numCandidates, tlsStats, cfg);
+        if (nextSet.getTotalCost() < bestSet.getTotalCost()) {
+            bestSet = nextSet;
+        }
+    }
+    return bestSet.getCandidates();
+}
+
+}
+
+FlushContext::List
+MemoryBudgetFlushStrategy::getFlushTargets(const FlushContext::List &targetList,
+                                           const flushengine::TlsStatsMap &tlsStatsMap) const
+{
+    FlushContext::List result;
+    std::set<vespalib::string> selected;
+    auto select = [&](const FlushContext::SP &ctx) {
+        if (selected.insert(ctx->getName()).second) {
+            result.push_back(ctx);
+        }
+    };
+    MemoryPrediction prediction(targetList, _cfg.memoryBudget);
+    LOG(debug, "getFlushTargets(): used=%" PRIu64 ", predictedPeak=%" PRIu64 ", budget=%" PRIu64,
+        prediction.used(), prediction.peak(), _cfg.memoryBudget);
+    for (const auto &ctx : targetList) {
+        if (ctx->getTarget()->needUrgentFlush()) {
+            select(ctx);
+            prediction.flushed(*ctx);
+        }
+    }
+    if (prediction.peak() > _cfg.memoryBudget) {
+        FlushContext::List memoryTargets;
+        addMemoryPressureTargets(targetList, _cfg.memoryBudget * _cfg.lowWatermarkFactor, prediction, memoryTargets);
+        for (const auto &ctx : memoryTargets) {
+            select(ctx);
+        }
+    }
+    FlushContextsMap perHandler;
+    for (const auto &ctx : targetList) {
+        if (ctx->getTarget()->getType() != IFlushTarget::Type::GC) {
+            perHandler[ctx->getHandler()->getName()].push_back(ctx);
+        }
+    }
+    for (const auto &entry : perHandler) {
+        const auto &tlsStats = tlsStatsMap.getTlsStats(entry.first);
+        for (const auto &ctx : findBestReplayTargets(entry.second, tlsStats, _cfg.replayCost)) {
+            if (selected.count(ctx->getName()) == 0 && prediction.canFlush(*ctx)) {
+                select(ctx);
+                prediction.flushed(*ctx);
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace proton
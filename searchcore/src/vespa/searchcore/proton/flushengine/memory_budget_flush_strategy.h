@@ -0,0 +1,48 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "iflushstrategy.h"
+#include "prepare_restart_flush_strategy.h"
+
+namespace proton {
+
+/**
+ * Flush strategy that keeps the memory used by flush targets within a
+ * global memory budget while minimizing the time needed to replay the
+ * transaction log on restart.
+ *
+ * The predicted peak memory usage is the memory that can be freed by
+ * flushing all targets + the largest transient memory needed by a single
+ * flush. When it exceeds the budget, the targets freeing the most memory
+ * are flushed until the prediction is below the low watermark, skipping
+ * targets whose transient memory would push usage above the budget.
+ *
+ * In addition, for each flush handler the set of targets that minimizes
+ * the cost of replaying the transaction log + the cost of writing the
+ * targets to disk is flushed, using the same cost model as
+ * PrepareRestartFlushStrategy.
+ */
+class MemoryBudgetFlushStrategy : public IFlushStrategy
+{
+public:
+    struct Config
+    {
+        uint64_t memoryBudget;
+        double   lowWatermarkFactor;
+        PrepareRestartFlushStrategy::Config replayCost;
+        Config(uint64_t memoryBudget_,
+               double lowWatermarkFactor_,
+               const PrepareRestartFlushStrategy::Config &replayCost_);
+    };
+
+private:
+    Config _cfg;
+
+public:
+    MemoryBudgetFlushStrategy(const Config &cfg);
+
+    FlushContext::List getFlushTargets(const FlushContext::List &targetList,
+                                       const flushengine::TlsStatsMap &tlsStatsMap) const override;
+};
+
+} // namespace proton
@@ -12,8 +12,9 @@ namespace proton {
 
 DiskIndexWrapper::DiskIndexWrapper(const vespalib::string &indexDir,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
-    : _index(indexDir, cacheSize),
+                                   size_t cacheSize,
+                                   size_t postingListCacheSize)
+    : _index(indexDir, cacheSize, postingListCacheSize),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch);
@@ -24,8 +25,9 @@ DiskIndexWrapper::DiskIndexWrapper(const vespalib::string &indexDir,
 
 DiskIndexWrapper::DiskIndexWrapper(const DiskIndexWrapper &oldIndex,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
-    : _index(oldIndex._index.getIndexDir(), cacheSize),
+                                   size_t cacheSize,
+                                   size_t postingListCacheSize)
+    : _index(oldIndex._index.getIndexDir(), cacheSize, postingListCacheSize),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch, oldIndex._index);
@@ -15,11 +15,13 @@ private:
 public:
     DiskIndexWrapper(const vespalib::string &indexDir,
                      const search::TuneFileSearch &tuneFileSearch,
-                     size_t cacheSize);
+                     size_t cacheSize,
+                     size_t postingListCacheSize);
 
     DiskIndexWrapper(const DiskIndexWrapper &oldIndex,
                      const search::TuneFileSearch &tuneFileSearch,
-                     size_t cacheSize);
+                     size_t cacheSize,
+                     size_t postingListCacheSize);
 
     /**
      * Implements searchcorespi::IndexSearchable
@@ -33,7 +35,9 @@ public:
         return _index.createBlueprint(requestContext, fields, term);
     }
     search::SearchableStats getSearchableStats() const override {
-        return search::SearchableStats().sizeOnDisk(_index.getSize());
+        return search::SearchableStats()
+            .sizeOnDisk(_index.getSize())
+            .postingListCacheStats(_index.getPostingListCacheStats());
     }
 
     search::SerialNum getSerialNum() const override;
@@ -27,8 +27,10 @@ namespace proton::index {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         size_t postingListCacheSize,
                                                          IThreadingService &threadingService)
     : _cacheSize(cacheSize),
+      _postingListCacheSize(postingListCacheSize),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -48,14 +50,14 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema& schema,
 IDiskIndex::SP
 IndexManager::MaintainerOperations::loadDiskIndex(const vespalib::string &indexDir)
 {
-    return std::make_shared<DiskIndexWrapper>(indexDir, _tuneFileSearch, _cacheSize);
+    return std::make_shared<DiskIndexWrapper>(indexDir, _tuneFileSearch, _cacheSize, _postingListCacheSize);
 }
 
 IDiskIndex::SP
 IndexManager::MaintainerOperations::reloadDiskIndex(const IDiskIndex &oldIndex)
 {
     return std::make_shared<DiskIndexWrapper>(dynamic_cast<const DiskIndexWrapper &>(oldIndex),
-                                              _tuneFileSearch, _cacheSize);
+                                              _tuneFileSearch, _cacheSize, _postingListCacheSize);
 }
 
 bool
@@ -82,7 +84,8 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const FileHeaderContext &fileHeaderContext) :
-    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize, threadingService),
+    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize,
+                indexConfig.postingListCacheSize, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, schema, serialNum, tuneFileAttributes),
                 IndexMaintainerContext(threadingService, reconfigurer, fileHeaderContext, warmupExecutor),
                 _operations)
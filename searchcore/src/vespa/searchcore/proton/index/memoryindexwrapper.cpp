@@ -27,7 +27,8 @@ MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema& schema,
              threadingService.indexFieldWriter()),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
-      _tuneFileIndexing(tuneFileIndexing)
+      _tuneFileIndexing(tuneFileIndexing),
+      _flushExecutor(threadingService.shared())
 {
 }
 
@@ -43,7 +44,7 @@ MemoryIndexWrapper::flushToDisk(const vespalib::string &flushDir,
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext,
                                                  serialNum);
     indexBuilder.open(docIdLimit, numWords, *this, _tuneFileIndexing, fileHeaderContext);
-    _index.dump(indexBuilder);
+    _index.dump(indexBuilder, _flushExecutor);
     indexBuilder.close();
 }
 
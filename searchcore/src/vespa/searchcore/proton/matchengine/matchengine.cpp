@@ -5,6 +5,7 @@
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/smart_buffer.h>
 #include <vespa/vespalib/data/slime/binary_format.h>
+#include <vespa/vespalib/util/numa_nodes.h>
 
 #include <vespa/log/log.h>
 
@@ -41,15 +42,31 @@ namespace proton {
 
 using namespace vespalib::slime;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool numaAware)
     : _lock(),
       _distributionKey(distributionKey),
       _closed(false),
       _handlers(),
       _executor(std::max(size_t(1), numThreads / threadsPerSearch), 256 * 1024),
       _threadBundlePool(std::max(size_t(1), threadsPerSearch)),
-      _nodeUp(false)
+      _numaThreadBundlePools(),
+      _nextNumaNode(0),
+      _nodeUp(false),
+      _maxQueueTimeFactor(0.0),
+      _rejectedQueries(0)
 {
+    if (numaAware) {
+        auto nodes = vespalib::NumaNodes::cpus_per_node();
+        if (nodes.size() > 1) {
+            for (auto &cpus : nodes) {
+                _numaThreadBundlePools.push_back(std::make_unique<vespalib::SimpleThreadBundle::Pool>(
+                        std::max(size_t(1), threadsPerSearch), std::move(cpus)));
+            }
+            LOG(info, "Distributing searches across %zu NUMA nodes", nodes.size());
+        } else {
+            LOG(info, "NUMA aware matching requested, but found %zu NUMA nodes", nodes.size());
+        }
+    }
 }
 
 MatchEngine::~MatchEngine()
@@ -108,6 +125,31 @@ MatchEngine::search(search::engine::SearchRequest::Source request,
     return search::engine::SearchReply::UP();
 }
 
+bool
+MatchEngine::shouldReject(const search::engine::SearchRequest &request) const
+{
+    double maxQueueTimeFactor = _maxQueueTimeFactor.load(std::memory_order_relaxed);
+    if (maxQueueTimeFactor <= 0.0) {
+        return false;
+    }
+    // The request is timed from when it was received, so the time used so far is its queue time.
+    double queueTime = vespalib::to_s(request.getTimeUsed());
+    return request.expired() || (queueTime >= vespalib::to_s(request.getTimeout()) * maxQueueTimeFactor);
+}
+
+vespalib::SimpleThreadBundle::Pool &
+MatchEngine::selectThreadBundlePool()
+{
+    if (_numaThreadBundlePools.empty()) {
+        return _threadBundlePool;
+    }
+    uint32_t node = _nextNumaNode.fetch_add(1, std::memory_order_relaxed) % _numaThreadBundlePools.size();
+    vespalib::SimpleThreadBundle::Pool &pool = *_numaThreadBundlePools[node];
+    // the calling thread runs the first part of the search itself
+    vespalib::NumaNodes::pin_current_thread(pool.cpus());
+    return pool;
+}
+
 void
 MatchEngine::performSearch(search::engine::SearchRequest::Source req,
                            search::engine::SearchClient &client)
@@ -118,8 +160,19 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req,
     if (searchRequest) {
         // 3 is the minimum level required for backend tracing.
         searchRequest->setTraceLevel(search::fef::indexproperties::trace::Level::lookup(searchRequest->propertiesMap.modelOverrides(), searchRequest->getTraceLevel()), 3);
+        if (shouldReject(*searchRequest)) {
+            _rejectedQueries.fetch_add(1, std::memory_order_relaxed);
+            LOG(debug, "Rejecting query that waited %1.3f of %1.3f seconds before matching",
+                vespalib::to_s(searchRequest->getTimeUsed()), vespalib::to_s(searchRequest->getTimeout()));
+            ret->coverage.degradeTimeout();
+            ret->request = req.release();
+            ret->setDistributionKey(_distributionKey);
+            client.searchDone(std::move(ret));
+            return;
+        }
         ISearchHandler::SP searchHandler;
-        vespalib::SimpleThreadBundle::UP threadBundle = _threadBundlePool.obtain();
+        vespalib::SimpleThreadBundle::Pool &threadBundlePool = selectThreadBundlePool();
+        vespalib::SimpleThreadBundle::UP threadBundle = threadBundlePool.obtain();
         { // try to find the match handler corresponding to the specified search doc type
             DocTypeName docTypeName(*searchRequest);
             std::lock_guard<std::mutex> guard(_lock);
@@ -137,7 +190,7 @@ MatchEngine::performSearch(search::engine::SearchRequest::Source req,
                 ret = snapshot.get()->match(*searchRequest, *threadBundle); // use the first handler
             }
         }
-        _threadBundlePool.release(std::move(threadBundle));
+        threadBundlePool.release(std::move(threadBundle));
     }
     ret->request = req.release();
     ret->setDistributionKey(_distributionKey);
@@ -185,6 +238,7 @@ MatchEngine::get_state(const Inserter &inserter, bool full) const
     (void) full;
     Cursor &object = inserter.insertObject();
     StateReporterUtils::convertToSlime(*reportStatus(), ObjectInserter(object, "status"));
+    object.setLong("rejected_queries", getRejectedQueries());
 }
 
 } // namespace proton
@@ -9,6 +9,7 @@
 #include <vespa/vespalib/net/state_explorer.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <atomic>
 #include <mutex>
 
 namespace proton {
@@ -23,7 +24,14 @@ private:
     HandlerMap<ISearchHandler>         _handlers;
     vespalib::ThreadStackExecutor      _executor;
     vespalib::SimpleThreadBundle::Pool _threadBundlePool;
+    std::vector<std::unique_ptr<vespalib::SimpleThreadBundle::Pool>> _numaThreadBundlePools;
+    std::atomic<uint32_t>              _nextNumaNode;
     bool                               _nodeUp;
+    std::atomic<double>                _maxQueueTimeFactor;
+    std::atomic<uint64_t>              _rejectedQueries;
+
+    bool shouldReject(const search::engine::SearchRequest &request) const;
+    vespalib::SimpleThreadBundle::Pool &selectThreadBundlePool();
 
 public:
     /**
@@ -43,8 +51,10 @@ public:
      * @param numThreads Number of threads allocated for handling search requests.
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
+     * @param numaAware run all threads of a search on the cpus of a single
+     *                  NUMA node, distributing searches across the nodes.
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool numaAware = false);
 
     /**
      * Frees any allocated resources. this will also stop all internal threads
@@ -121,6 +131,21 @@ public:
     void
     setNodeUp(bool nodeUp);
 
+    /**
+     * Set the max fraction of a query's timeout it may have spent waiting
+     * in the queue before it is matched. Queries that have waited longer,
+     * or that have already timed out, are rejected with a reply degraded by
+     * timeout instead of being matched, since they would most likely time
+     * out anyway. 0 disables rejection.
+     */
+    void setMaxQueueTimeFactor(double factor) { _maxQueueTimeFactor.store(factor, std::memory_order_relaxed); }
+
+    /** obtain the number of NUMA nodes searches are distributed across, 0 if not NUMA aware */
+    size_t getNumaNodes() const { return _numaThreadBundlePools.size(); }
+
+    /** obtain the number of queries rejected due to queue time */
+    uint64_t getRejectedQueries() const { return _rejectedQueries.load(std::memory_order_relaxed); }
+
     StatusReport::UP reportStatus() const;
 
     search::engine::SearchReply::UP search(
@@ -0,0 +1,91 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_bound_limiter.h"
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+using search::BitVector;
+using search::BitVectorIterator;
+using search::attribute::IAttributeVector;
+using search::fef::TermFieldMatchData;
+using search::queryeval::SearchIterator;
+
+namespace proton::matching {
+
+BlockBoundLimiter::BlockBoundLimiter(const IAttributeVector &attribute, bool descending, uint32_t docIdLimit)
+    : _attribute(attribute),
+      _descending(descending),
+      _docIdLimit(std::min(docIdLimit, attribute.getCommittedDocIdLimit())),
+      _lock(),
+      _selected(),
+      _match_datas(),
+      _estimatedHits(-1)
+{
+}
+
+BlockBoundLimiter::~BlockBoundLimiter() = default;
+
+bool
+BlockBoundLimiter::supports(const IAttributeVector &attribute)
+{
+    return ( ! attribute.getIsFastSearch() &&
+             ! attribute.hasMultiValue() &&
+             (attribute.isIntegerType() || attribute.isFloatingPointType()));
+}
+
+std::vector<double>
+BlockBoundLimiter::calculate_bounds() const
+{
+    const double worst = _descending ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+    std::vector<double> bounds((_docIdLimit + BLOCK_SIZE - 1) / BLOCK_SIZE, worst);
+    for (uint32_t lid = 1; lid < _docIdLimit; ++lid) {
+        if (_attribute.isUndefined(lid)) {
+            continue;
+        }
+        double value = _attribute.getFloat(lid);
+        double &bound = bounds[lid / BLOCK_SIZE];
+        bound = _descending ? std::max(bound, value) : std::min(bound, value);
+    }
+    return bounds;
+}
+
+void
+BlockBoundLimiter::select_blocks(size_t want_hits)
+{
+    std::vector<double> bounds = calculate_bounds();
+    std::vector<uint32_t> order(bounds.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&bounds, this](uint32_t a, uint32_t b) {
+        return _descending ? (bounds[a] > bounds[b]) : (bounds[a] < bounds[b]);
+    });
+    _selected = BitVector::create(_docIdLimit);
+    size_t covered = 0;
+    for (uint32_t block : order) {
+        if (covered >= want_hits) {
+            break;
+        }
+        uint32_t begin = std::max(block * BLOCK_SIZE, 1u);
+        uint32_t end = std::min((block + 1) * BLOCK_SIZE, _docIdLimit);
+        _selected->setInterval(begin, end);
+        covered += (end - begin);
+    }
+    _selected->invalidateCachedCount();
+    _estimatedHits = covered;
+}
+
+SearchIterator::UP
+BlockBoundLimiter::create_search(size_t want_hits, bool strictSearch)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if ( ! _selected ) {
+        select_blocks(want_hits);
+    }
+    _match_datas.push_back(std::make_unique<TermFieldMatchData>());
+    return BitVectorIterator::create(_selected.get(), *_match_datas.back(), strictSearch);
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <mutex>
+#include <vector>
+
+namespace search { class BitVector; }
+namespace search::attribute { class IAttributeVector; }
+
+namespace proton::matching {
+
+/**
+ * This class is responsible for creating search iterators limiting
+ * the search space to the blocks of local document ids with the best
+ * bounds on the degradation attribute. It is used for match phase
+ * degradation when the degradation attribute has no posting lists
+ * (not fast-search), which the attribute limiter depends on.
+ *
+ * Each block of BLOCK_SIZE lids is represented by the best value
+ * found in it (highest when descending, lowest when ascending). Blocks
+ * are selected in bound order until they cover the wanted number of
+ * documents. This is precise when documents are fed in tiers of
+ * similar values and degrades gracefully otherwise. As with the
+ * attribute limiter, the first thread requesting a search decides the
+ * selection shared by all threads.
+ **/
+class BlockBoundLimiter
+{
+public:
+    static constexpr uint32_t BLOCK_SIZE = 1024;
+    BlockBoundLimiter(const search::attribute::IAttributeVector &attribute, bool descending, uint32_t docIdLimit);
+    ~BlockBoundLimiter();
+    static bool supports(const search::attribute::IAttributeVector &attribute);
+    search::queryeval::SearchIterator::UP create_search(size_t want_hits, bool strictSearch);
+    bool was_used() const { return ! _match_datas.empty(); }
+    ssize_t getEstimatedHits() const { return _estimatedHits; }
+private:
+    std::vector<double> calculate_bounds() const;
+    void select_blocks(size_t want_hits);
+
+    const search::attribute::IAttributeVector                 & _attribute;
+    bool                                                        _descending;
+    uint32_t                                                    _docIdLimit;
+    std::mutex                                                  _lock;
+    std::unique_ptr<search::BitVector>                          _selected;
+    std::vector<std::unique_ptr<search::fef::TermFieldMatchData>> _match_datas;
+    ssize_t                                                     _estimatedHits;
+};
+
+}
@@ -5,13 +5,23 @@
 #include "termdatafromnode.h"
 #include "same_element_builder.h"
 #include <vespa/searchcorespi/index/indexsearchable.h>
+#include <vespa/searchlib/attribute/bitvector_search_cache.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/query/tree/customtypevisitor.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/equiv_blueprint.h>
 #include <vespa/searchlib/queryeval/get_weight_from_node.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <algorithm>
+#include <mutex>
 
 using namespace search::queryeval;
+using search::BitVector;
+using search::attribute::BitVectorSearchCache;
 
 namespace proton::matching {
 
@@ -48,6 +58,118 @@ struct Mixer {
     }
 };
 
+/**
+ * Leaf blueprint matching the documents set in a cached filter bit vector.
+ */
+class CachedFilterBlueprint : public SimpleLeafBlueprint
+{
+private:
+    BitVectorSearchCache::Entry::SP _entry;
+    mutable std::mutex _lock;
+    mutable std::vector<std::unique_ptr<search::fef::TermFieldMatchData>> _matchDataVector;
+
+    SearchIterator::UP
+    createLeafSearch(const search::fef::TermFieldMatchDataArray &tfmda, bool strict) const override
+    {
+        assert(tfmda.size() == 0);
+        (void) tfmda;
+        return createFilterSearch(strict, FilterConstraint::UPPER_BOUND);
+    }
+public:
+    CachedFilterBlueprint(BitVectorSearchCache::Entry::SP entry)
+        : SimpleLeafBlueprint(FieldSpecBaseList()),
+          _entry(std::move(entry)),
+          _lock(),
+          _matchDataVector()
+    {
+        uint32_t estHits = _entry->bitVector->countTrueBits();
+        setEstimate(HitEstimate(estHits, (estHits == 0)));
+    }
+
+    SearchIterator::UP createFilterSearch(bool strict, FilterConstraint) const override {
+        auto tfmd = std::make_unique<search::fef::TermFieldMatchData>();
+        search::fef::TermFieldMatchData &ref = *tfmd;
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _matchDataVector.push_back(std::move(tfmd));
+        }
+        uint32_t docIdLimit = std::min(get_docid_limit(), _entry->docIdLimit);
+        return search::BitVectorIterator::create(_entry->bitVector.get(), docIdLimit, ref, strict);
+    }
+};
+
+template <typename NodeType>
+bool
+appendFilterTermKey(search::query::Node &node, const char *type, vespalib::asciistream &os,
+                    search::fef::TermFieldHandle &maxHandle)
+{
+    auto *term = dynamic_cast<NodeType *>(&node);
+    if (term == nullptr) {
+        return false;
+    }
+    if (term->numFields() == 0) {
+        return false;
+    }
+    os << type << "(";
+    for (size_t i = 0; i < term->numFields(); ++i) {
+        const ProtonTermData::FieldEntry &field = term->field(i);
+        if (!field.attribute_field || (term->isRanked() && !field.filter_field)) {
+            return false;
+        }
+        maxHandle = std::max(maxHandle, field.getHandle());
+        os << field.field_name << ",";
+    }
+    os << term->getTerm() << ")";
+    return true;
+}
+
+/**
+ * Builds the canonical form of a pure filter query subtree, where all
+ * terms search attribute fields only and are either unranked or search
+ * filter fields only. Children of intermediate
+ * nodes are sorted, so the form does not depend on their order.
+ *
+ * @return false if the subtree is not a pure filter.
+ **/
+bool
+makeFilterKey(search::query::Node &node, vespalib::string &key, search::fef::TermFieldHandle &maxHandle)
+{
+    vespalib::asciistream os;
+    const char *intermediate = nullptr;
+    if (dynamic_cast<ProtonAnd *>(&node) != nullptr) {
+        intermediate = "AND";
+    } else if (dynamic_cast<ProtonOr *>(&node) != nullptr) {
+        intermediate = "OR";
+    }
+    if (intermediate != nullptr) {
+        const auto &children = static_cast<search::query::Intermediate &>(node).getChildren();
+        if (children.empty()) {
+            return false;
+        }
+        std::vector<vespalib::string> childKeys;
+        for (search::query::Node *child : children) {
+            childKeys.emplace_back();
+            if (!makeFilterKey(*child, childKeys.back(), maxHandle)) {
+                return false;
+            }
+        }
+        std::sort(childKeys.begin(), childKeys.end());
+        os << intermediate << "(";
+        for (const auto &childKey : childKeys) {
+            os << childKey << ",";
+        }
+        os << ")";
+    } else if (!appendFilterTermKey<ProtonStringTerm>(node, "STRING", os, maxHandle) &&
+               !appendFilterTermKey<ProtonNumberTerm>(node, "NUMBER", os, maxHandle) &&
+               !appendFilterTermKey<ProtonPrefixTerm>(node, "PREFIX", os, maxHandle) &&
+               !appendFilterTermKey<ProtonRangeTerm>(node, "RANGE", os, maxHandle))
+    {
+        return false;
+    }
+    key = os.str();
+    return true;
+}
+
 /**
  * requires that match data space has been reserved
  */
@@ -57,14 +179,123 @@ class BlueprintBuilderVisitor :
 private:
     const IRequestContext & _requestContext;
     ISearchContext &_context;
+    BitVectorSearchCache *_filterCache;
     Blueprint::UP   _result;
 
     void buildChildren(IntermediateBlueprint &parent,
                        const std::vector<search::query::Node *> &children)
     {
         for (size_t i = 0; i < children.size(); ++i) {
-            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context));
+            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context, _filterCache));
+        }
+    }
+
+    BitVectorSearchCache::Entry::SP
+    evaluateFilter(const std::vector<search::query::Node *> &filters, bool isAnd, search::fef::TermFieldHandle maxHandle,
+                   uint32_t docIdLimit)
+    {
+        std::unique_ptr<IntermediateBlueprint> filter;
+        if (isAnd) {
+            filter = std::make_unique<AndBlueprint>();
+        } else {
+            filter = std::make_unique<OrBlueprint>();
+        }
+        for (search::query::Node *node : filters) {
+            filter->addChild(BlueprintBuilder::build(_requestContext, *node, _context));
+        }
+        filter->setDocIdLimit(docIdLimit);
+        Blueprint::UP blueprint = Blueprint::optimize(std::move(filter));
+        blueprint->fetchPostings(ExecuteInfo::create(true, 1.0));
+        blueprint->freeze();
+        search::fef::MatchData md(search::fef::MatchData::params().numTermFields(maxHandle + 1));
+        SearchIterator::UP search = blueprint->createSearch(md, true);
+        search->initRange(1, docIdLimit);
+        std::shared_ptr<BitVector> bitVector(search->get_hits(1));
+        bitVector->countTrueBits(); // cache the count before the bit vector is shared
+        // Cached filters are only used while the visible documents are unchanged, so no
+        // document meta store read guard is needed to prevent reuse of the cached lids.
+        return std::make_shared<BitVectorSearchCache::Entry>(BitVectorSearchCache::ReadGuardUP(),
+                                                             std::move(bitVector), docIdLimit);
+    }
+
+    BitVectorSearchCache::Entry::SP
+    lookupFilter(const std::vector<search::query::Node *> &filters, std::vector<vespalib::string> &filterKeys,
+                 bool isAnd, search::fef::TermFieldHandle maxHandle)
+    {
+        std::sort(filterKeys.begin(), filterKeys.end());
+        uint32_t docIdLimit = _context.getDocIdLimit();
+        vespalib::asciistream os;
+        os << _context.getVisibilityGeneration() << ":" << docIdLimit << ":" << (isAnd ? "AND" : "OR") << "(";
+        for (const auto &filterKey : filterKeys) {
+            os << filterKey << ",";
+        }
+        os << ")";
+        vespalib::string key = os.str();
+        BitVectorSearchCache::Entry::SP entry = _filterCache->find(key);
+        if (!entry) {
+            entry = evaluateFilter(filters, isAnd, maxHandle, docIdLimit);
+            _filterCache->insert(key, entry);
+        }
+        return entry;
+    }
+
+    /**
+     * Replaces a single pure filter term whose search merges the posting lists of
+     * many dictionary entries (range and prefix terms) with a cached filter
+     * blueprint, so the merge is done once per visible generation instead of per query.
+     *
+     * @return false if the term was not handled.
+     **/
+    bool buildCachedFilterTerm(search::query::Node &n) {
+        if (_filterCache == nullptr) {
+            return false;
         }
+        std::vector<vespalib::string> filterKeys(1);
+        search::fef::TermFieldHandle maxHandle = 0;
+        if (!makeFilterKey(n, filterKeys[0], maxHandle)) {
+            return false;
+        }
+        _result = std::make_unique<CachedFilterBlueprint>(lookupFilter({&n}, filterKeys, true, maxHandle));
+        return true;
+    }
+
+    /**
+     * Replaces the pure filter children of an AND or OR node with a single cached
+     * filter blueprint. For OR all children must be pure filters.
+     *
+     * @return false if the node was not handled.
+     **/
+    bool buildCachedFilter(search::query::Intermediate &n, bool isAnd) {
+        if (_filterCache == nullptr) {
+            return false;
+        }
+        std::vector<search::query::Node *> filters;
+        std::vector<search::query::Node *> others;
+        std::vector<vespalib::string> filterKeys;
+        search::fef::TermFieldHandle maxHandle = 0;
+        for (search::query::Node *child : n.getChildren()) {
+            vespalib::string childKey;
+            if (makeFilterKey(*child, childKey, maxHandle)) {
+                filters.push_back(child);
+                filterKeys.push_back(childKey);
+            } else {
+                others.push_back(child);
+            }
+        }
+        if ((filters.size() < 2) || (!isAnd && !others.empty())) {
+            return false;
+        }
+        BitVectorSearchCache::Entry::SP entry = lookupFilter(filters, filterKeys, isAnd, maxHandle);
+        auto cached = std::make_unique<CachedFilterBlueprint>(std::move(entry));
+        if (others.empty()) {
+            _result = std::move(cached);
+        } else {
+            auto blueprint = std::make_unique<AndBlueprint>();
+            blueprint->addChild(std::move(cached));
+            buildChildren(*blueprint, others);
+            _result = std::move(blueprint);
+        }
+        return true;
     }
 
     template <typename NodeType>
@@ -134,9 +365,17 @@ private:
     }
 
 protected:
-    void visit(ProtonAnd &n)         override { buildIntermediate(new AndBlueprint(), n); }
+    void visit(ProtonAnd &n) override {
+        if (!buildCachedFilter(n, true)) {
+            buildIntermediate(new AndBlueprint(), n);
+        }
+    }
     void visit(ProtonAndNot &n)      override { buildIntermediate(new AndNotBlueprint(), n); }
-    void visit(ProtonOr &n)          override { buildIntermediate(new OrBlueprint(), n); }
+    void visit(ProtonOr &n) override {
+        if (!buildCachedFilter(n, false)) {
+            buildIntermediate(new OrBlueprint(), n);
+        }
+    }
     void visit(ProtonWeakAnd &n)     override { buildWeakAnd(n); }
     void visit(ProtonEquiv &n)       override { buildEquiv(n); }
     void visit(ProtonRank &n)        override { buildIntermediate(new RankBlueprint(), n); }
@@ -152,8 +391,16 @@ protected:
     void visit(ProtonPhrase &n)          override { buildTerm(n); }
     void visit(ProtonNumberTerm &n)      override { buildTerm(n); }
     void visit(ProtonLocationTerm &n)    override { buildTerm(n); }
-    void visit(ProtonPrefixTerm &n)      override { buildTerm(n); }
-    void visit(ProtonRangeTerm &n)       override { buildTerm(n); }
+    void visit(ProtonPrefixTerm &n) override {
+        if (!buildCachedFilterTerm(n)) {
+            buildTerm(n);
+        }
+    }
+    void visit(ProtonRangeTerm &n) override {
+        if (!buildCachedFilterTerm(n)) {
+            buildTerm(n);
+        }
+    }
     void visit(ProtonStringTerm &n)      override { buildTerm(n); }
     void visit(ProtonSubstringTerm &n)   override { buildTerm(n); }
     void visit(ProtonSuffixTerm &n)      override { buildTerm(n); }
@@ -162,9 +409,11 @@ protected:
     void visit(ProtonNearestNeighborTerm &n) override { buildTerm(n); }
 
 public:
-    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context) :
+    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context,
+                            BitVectorSearchCache *filterCache) :
         _requestContext(requestContext),
         _context(context),
+        _filterCache(filterCache),
         _result()
     { }
     Blueprint::UP build() {
@@ -178,9 +427,10 @@ public:
 search::queryeval::Blueprint::UP
 BlueprintBuilder::build(const IRequestContext & requestContext,
                         search::query::Node &node,
-                        ISearchContext &context)
+                        ISearchContext &context,
+                        BitVectorSearchCache *filterCache)
 {
-    BlueprintBuilderVisitor visitor(requestContext, context);
+    BlueprintBuilderVisitor visitor(requestContext, context, filterCache);
     node.accept(visitor);
     Blueprint::UP result = visitor.build();
     result->setDocIdLimit(context.getDocIdLimit());
@@ -6,17 +6,27 @@
 #include <vespa/searchlib/query/tree/node.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 
+namespace search::attribute { class BitVectorSearchCache; }
+
 namespace proton::matching {
 
 struct BlueprintBuilder {
     /**
      * Build a tree of blueprints from the query tree and inject
      * blueprint meta-data back into corresponding query tree nodes.
+     *
+     * When a filter cache is given, the pure filter children of AND
+     * and OR nodes (unranked or filter terms searching attribute fields
+     * only) are evaluated into
+     * a single cached bit vector that is reused by later queries with
+     * the same filter as long as the visible documents are unchanged.
+     * Match data is not unpacked for the terms of cached filters.
      */
     static search::queryeval::Blueprint::UP
     build(const search::queryeval::IRequestContext & requestContext,
           search::query::Node &node,
-          ISearchContext &context);
+          ISearchContext &context,
+          search::attribute::BitVectorSearchCache *filterCache = nullptr);
 };
 
 }
@@ -2,6 +2,7 @@
 
 #include "docid_range_scheduler.h"
 #include <cassert>
+#include <thread>
 
 namespace proton::matching {
 
@@ -160,4 +161,137 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::assign(size_t thread_id, DocidRange range)
+{
+    _workers[thread_id].assigned += range.size();
+    _unassigned.fetch_sub(range.size(), std::memory_order::memory_order_relaxed);
+    return range;
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::take_own(size_t thread_id)
+{
+    Worker &worker = _workers[thread_id];
+    Guard guard(worker.lock);
+    if (worker.tasks.empty()) {
+        return DocidRange();
+    }
+    DocidRange range = worker.tasks.front();
+    worker.tasks.pop_front();
+    worker.queued.store(worker.queued.load(std::memory_order::memory_order_relaxed) - range.size(),
+                        std::memory_order::memory_order_relaxed);
+    return range;
+}
+
+size_t
+WorkStealingDocidRangeScheduler::find_victim(size_t thread_id) const
+{
+    size_t victim = thread_id;
+    size_t max_queued = 0;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        size_t queued = _workers[i].queued.load(std::memory_order::memory_order_relaxed);
+        if ((i != thread_id) && (queued > max_queued)) {
+            victim = i;
+            max_queued = queued;
+        }
+    }
+    return victim;
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::steal(size_t thread_id, size_t victim)
+{
+    std::vector<DocidRange> stolen;
+    {
+        Worker &worker = _workers[victim];
+        Guard guard(worker.lock);
+        size_t num_tasks = worker.tasks.size();
+        if (num_tasks == 0) {
+            return DocidRange();
+        }
+        if (num_tasks == 1) {
+            DocidRange &last = worker.tasks.back();
+            if (last.size() >= (2 * _min_task)) {
+                uint32_t middle = last.begin + (last.size() / 2);
+                stolen.emplace_back(middle, last.end);
+                last.end = middle;
+            } else {
+                stolen.push_back(last);
+                worker.tasks.pop_back();
+            }
+        } else {
+            stolen.assign(worker.tasks.end() - (num_tasks / 2), worker.tasks.end());
+            worker.tasks.erase(worker.tasks.end() - (num_tasks / 2), worker.tasks.end());
+        }
+        size_t stolen_size = 0;
+        for (const DocidRange &range : stolen) {
+            stolen_size += range.size();
+        }
+        worker.queued.store(worker.queued.load(std::memory_order::memory_order_relaxed) - stolen_size,
+                            std::memory_order::memory_order_relaxed);
+    }
+    if (stolen.size() > 1) {
+        // keep the rest of the loot stealable by other threads
+        Worker &worker = _workers[thread_id];
+        Guard guard(worker.lock);
+        size_t queued = worker.queued.load(std::memory_order::memory_order_relaxed);
+        for (size_t i = 1; i < stolen.size(); ++i) {
+            worker.tasks.push_back(stolen[i]);
+            queued += stolen[i].size();
+        }
+        worker.queued.store(queued, std::memory_order::memory_order_relaxed);
+    }
+    return stolen[0];
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, size_t tasks_per_thread,
+                                                                 uint32_t min_task, uint32_t docid_limit)
+    : _splitter(DocidRange(1, docid_limit), num_threads),
+      _min_task(std::max(1u, min_task)),
+      _workers(num_threads),
+      _unassigned(_splitter.full_range().size())
+{
+    for (size_t i = 0; i < num_threads; ++i) {
+        DocidRange part = _splitter.get(i);
+        size_t num_tasks = std::max(size_t(1), std::min(tasks_per_thread, part.size() / _min_task));
+        DocidRangeSplitter task_splitter(part, num_tasks);
+        for (size_t j = 0; j < num_tasks; ++j) {
+            DocidRange task = task_splitter.get(j);
+            if (!task.empty()) {
+                _workers[i].tasks.push_back(task);
+            }
+        }
+        _workers[i].queued.store(part.size(), std::memory_order::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    for (;;) {
+        DocidRange range = take_own(thread_id);
+        if (!range.empty()) {
+            return assign(thread_id, range);
+        }
+        if (_unassigned.load(std::memory_order::memory_order_relaxed) == 0) {
+            return DocidRange();
+        }
+        size_t victim = find_victim(thread_id);
+        if (victim != thread_id) {
+            range = steal(thread_id, victim);
+            if (!range.empty()) {
+                return assign(thread_id, range);
+            }
+        } else {
+            // the remaining tasks are being moved between other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }
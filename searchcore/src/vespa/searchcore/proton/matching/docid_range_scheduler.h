@@ -8,6 +8,7 @@
 #include <condition_variable>
 #include <atomic>
 #include <algorithm>
+#include <deque>
 #include <vector>
 
 namespace proton::matching {
@@ -204,4 +205,46 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A work-stealing scheduler that begins by giving each thread an
+ * equal part of the docid space, split into a deque of tasks. Each
+ * thread takes tasks from the front of its own deque. When a thread
+ * runs out of tasks, it steals the back half of the deque of the peer
+ * with the most queued work, splitting the last task of that peer in
+ * two if needed. Threads only lock their own deque and the deque of
+ * the peer they steal from, so there is no central lock to contend
+ * on. Work that is already assigned to a thread is never shared.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    using Guard = std::lock_guard<std::mutex>;
+    struct Worker {
+        std::mutex             lock;
+        std::deque<DocidRange> tasks;
+        std::atomic<size_t>    queued;
+        size_t                 assigned;
+        Worker() : lock(), tasks(), queued(0), assigned(0) {}
+    };
+    DocidRangeSplitter  _splitter;
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+    std::atomic<size_t> _unassigned;
+
+    VESPA_DLL_LOCAL DocidRange assign(size_t thread_id, DocidRange range);
+    VESPA_DLL_LOCAL DocidRange take_own(size_t thread_id);
+    VESPA_DLL_LOCAL size_t find_victim(size_t thread_id) const;
+    VESPA_DLL_LOCAL DocidRange steal(size_t thread_id, size_t victim);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, size_t tasks_per_thread, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler();
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    DocidRange total_span(size_t) const override { return _splitter.full_range(); }
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override { return _unassigned.load(std::memory_order::memory_order_relaxed); }
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+};
+
 }
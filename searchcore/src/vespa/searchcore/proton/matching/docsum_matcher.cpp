@@ -3,17 +3,13 @@
 #include "docsum_matcher.h"
 #include "match_tools.h"
 #include "search_session.h"
-#include <vespa/eval/eval/tensor.h>
-#include <vespa/eval/eval/tensor_engine.h>
-#include <vespa/eval/eval/engine_or_factory.h>
-#include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/searchcommon/attribute/i_search_context.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
 #include <vespa/searchlib/queryeval/same_element_blueprint.h>
 #include <vespa/searchlib/queryeval/same_element_search.h>
 #include <vespa/searchlib/queryeval/matching_elements_search.h>
-#include <vespa/searchlib/fef/feature_resolver.h>
+#include <vespa/searchlib/fef/feature_extractor.h>
 #include <vespa/searchlib/fef/rank_program.h>
 
 #include <vespa/log/log.h>
@@ -22,7 +18,7 @@ LOG_SETUP(".proton.matching.docsum_matcher");
 using search::FeatureSet;
 using search::MatchingElements;
 using search::MatchingElementsFields;
-using search::fef::FeatureResolver;
+using search::fef::FeatureExtractor;
 using search::fef::RankProgram;
 using search::queryeval::AndNotBlueprint;
 using search::queryeval::Blueprint;
@@ -50,39 +46,19 @@ get_feature_set(const MatchToolsFactory &mtf,
     }
     RankProgram &rankProgram = matchTools->rank_program();
 
-    std::vector<vespalib::string> featureNames;
-    FeatureResolver resolver(rankProgram.get_seeds(false));
-    featureNames.reserve(resolver.num_features());
-    for (size_t i = 0; i < resolver.num_features(); ++i) {
-        featureNames.emplace_back(resolver.name_of(i));
-    }
-    auto retval = std::make_unique<FeatureSet>(featureNames, docs.size());
+    FeatureExtractor extractor(rankProgram);
+    auto retval = extractor.make_feature_set(docs.size());
     if (docs.empty()) {
         return retval;
     }
-    FeatureSet &fs = *retval;
-
+    rankProgram.set_upcoming_docids(docs);
     SearchIterator &search = matchTools->search();
     search.initRange(docs.front(), docs.back()+1);
     for (uint32_t i = 0; i < docs.size(); ++i) {
         if (search.seek(docs[i])) {
             uint32_t docId = search.getDocId();
             search.unpack(docId);
-            auto * f = fs.getFeaturesByIndex(fs.addDocId(docId));
-            for (uint32_t j = 0; j < featureNames.size(); ++j) {
-                if (resolver.is_object(j)) {
-                    auto obj = resolver.resolve(j).as_object(docId);
-                    if (! obj.get().type().is_double()) {
-                        vespalib::nbostream buf;
-                        vespalib::eval::EngineOrFactory::get().encode(obj.get(), buf);
-                        f[j].set_data(vespalib::Memory(buf.peek(), buf.size()));
-                    } else {
-                        f[j].set_double(obj.get().as_double());
-                    }
-                } else {
-                    f[j].set_double(resolver.resolve(j).as_number(docId));
-                }
-            }
+            extractor.extract(docId, *retval);
         } else {
             LOG(debug, "getFeatureSet: Did not find hit for docid '%u'. Skipping hit", docs[i]);
         }
@@ -93,6 +69,19 @@ get_feature_set(const MatchToolsFactory &mtf,
     return retval;
 }
 
+FeatureSet::UP
+copy_feature_set(const FeatureSet &src, const std::vector<uint32_t> &docs)
+{
+    auto retval = std::make_unique<FeatureSet>(src.getNames(), docs.size());
+    for (uint32_t docId : docs) {
+        if (const auto * from = src.getFeaturesByDocId(docId)) {
+            auto * to = retval->getFeaturesByIndex(retval->addDocId(docId));
+            std::copy(from, from + src.numFeatures(), to);
+        }
+    }
+    return retval;
+}
+
 template<typename T>
 const T *as(const Blueprint &bp) { return dynamic_cast<const T *>(&bp); }
 
@@ -190,7 +179,21 @@ DocsumMatcher::get_summary_features() const
     if (!_mtf) {
         return std::make_unique<FeatureSet>();
     }
-    return get_feature_set(*_mtf, _docs, true);
+    if (!_from_session) {
+        return get_feature_set(*_mtf, _docs, true);
+    }
+    // Summary features only depend on the query and the documents, so
+    // repeated docsum requests for the same hits within a query session
+    // share a single rank program evaluation.
+    if (auto cached = _from_session->get_summary_features(_docs)) {
+        if (auto onSummaryTask = _mtf->createOnSummaryTask()) {
+            onSummaryTask->run(_docs);
+        }
+        return copy_feature_set(*cached, _docs);
+    }
+    std::shared_ptr<const FeatureSet> features = get_feature_set(*_mtf, _docs, true);
+    _from_session->set_summary_features(_docs, features);
+    return copy_feature_set(*features, _docs);
 }
 
 FeatureSet::UP
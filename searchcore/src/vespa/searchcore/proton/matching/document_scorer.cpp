@@ -25,11 +25,24 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
-    : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+    : _rankProgram(rankProgram),
+      _searchItr(searchItr),
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _docids()
 {
 }
 
+void
+DocumentScorer::prepare(const std::vector<search::queryeval::HitCollector::Hit> &hits)
+{
+    _docids.clear();
+    _docids.reserve(hits.size());
+    for (const auto &hit: hits) {
+        _docids.push_back(hit.first);
+    }
+    _rankProgram.set_upcoming_docids(_docids);
+}
+
 feature_t
 DocumentScorer::score(uint32_t docId)
 {
@@ -16,8 +16,10 @@ namespace proton::matching {
 class DocumentScorer : public search::queryeval::HitCollector::DocumentScorer
 {
 private:
+    search::fef::RankProgram &_rankProgram;
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    std::vector<uint32_t> _docids;
 
 public:
     DocumentScorer(search::fef::RankProgram &rankProgram,
@@ -28,7 +30,8 @@ public:
         return _scoreFeature.as_number(docId);
     }
 
-    virtual search::feature_t score(uint32_t docId) override;
+    void prepare(const std::vector<search::queryeval::HitCollector::Hit> &hits) override;
+    search::feature_t score(uint32_t docId) override;
 };
 
 }
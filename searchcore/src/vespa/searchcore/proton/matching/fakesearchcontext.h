@@ -29,6 +29,7 @@ private:
     IndexCollection::SP                    _indexes;
     FakeSearchable                         _attrSearchable;
     uint32_t                               _docIdLimit;
+    uint64_t                               _visibilityGeneration;
 
 public:
     FakeSearchContext(size_t initialNumDocs=0);
@@ -44,6 +45,11 @@ public:
         return *this;
     }
 
+    FakeSearchContext &setVisibilityGeneration(uint64_t generation) {
+        _visibilityGeneration = generation;
+        return *this;
+    }
+
     FakeSearchable &attr() { return _attrSearchable; }
 
     FakeIndexSearchable &idx(uint32_t i) {
@@ -64,6 +70,10 @@ public:
     uint32_t getDocIdLimit() override {
         return _docIdLimit;
     }
+
+    uint64_t getVisibilityGeneration() override {
+        return _visibilityGeneration;
+    }
     virtual const vespalib::Doom & getDoom() const { return _doom; }
 };
 
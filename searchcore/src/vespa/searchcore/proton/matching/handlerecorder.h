@@ -18,6 +18,13 @@ namespace proton::matching {
  * same lifespan as the recorder itself.
  * After the Binders has gone out of scope this recorder has a list of all feature handles that might be
  * by this query. This can then be used to avoid a lot of unpacking of data.
+ *
+ * tag_match_data maps the recorded details to the minimal unpacking needed per term field:
+ *  - not recorded: tagged as not needed; only the docid matters (filter / bitvector search).
+ *  - Interleaved: only number of occurrences and field length (e.g. bm25).
+ *  - Normal: full positions (e.g. nativeRank, fieldMatch).
+ * Iterators consult these flags when unpacking, and the search is rebuilt when a later
+ * rank phase needs more details than the one it was created for.
  */
 class HandleRecorder
 {
@@ -59,6 +59,16 @@ public:
      **/
     virtual uint32_t getDocIdLimit() = 0;
 
+    /**
+     * Obtain the generation of visible documents this context was
+     * created at. The generation changes whenever the set of documents
+     * visible for searching may have changed, making it usable for
+     * detecting that results computed earlier may be stale.
+     *
+     * @return visibility generation
+     **/
+    virtual uint64_t getVisibilityGeneration() = 0;
+
     /**
      * Deleting the context will trigger cleanup in the
      * implementation.
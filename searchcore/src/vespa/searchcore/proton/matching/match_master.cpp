@@ -44,10 +44,19 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
     }
 };
 
+// With many threads per search, stealing from per-thread deques scales better than the central lock
+constexpr uint32_t WORK_STEALING_MIN_THREADS = 16;
+constexpr size_t WORK_STEALING_TASKS_PER_THREAD = 16;
+constexpr uint32_t WORK_STEALING_MIN_TASK = 128;
+
 DocidRangeScheduler::UP
 createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
 {
     if (numSearchPartitions == 0) {
+        if (numThreads >= WORK_STEALING_MIN_THREADS) {
+            return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, WORK_STEALING_TASKS_PER_THREAD,
+                                                                     WORK_STEALING_MIN_TASK, numDocs);
+        }
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
@@ -72,6 +81,9 @@ MatchMaster::match(search::engine::Trace & trace,
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.heapSize));
     TimedMatchLoopCommunicator timedCommunicator(communicator);
     DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    SharedScoreThreshold scoreThreshold;
+    bool shareScoreThreshold = ((threadBundle.size() > 1) && resultProcessor.onlyUsesBestRankedHits() &&
+                                !mtf.should_diversify());
 
     std::vector<MatchThread::UP> threadState;
     std::vector<vespalib::Runnable*> targets;
@@ -80,6 +92,7 @@ MatchMaster::match(search::engine::Trace & trace,
                 ? static_cast<IMatchLoopCommunicator&>(timedCommunicator)
                 : static_cast<IMatchLoopCommunicator&>(communicator);
         threadState.emplace_back(std::make_unique<MatchThread>(i, threadBundle.size(), params, mtf, com, *scheduler,
+                                                               shareScoreThreshold ? &scoreThreshold : nullptr,
                                                                resultProcessor, mergeDirector, distributionKey,
                                                                trace.getRelativeTime(), trace.getLevel()));
         targets.push_back(threadState.back().get());
@@ -98,6 +111,10 @@ MatchMaster::match(search::engine::Trace & trace,
         const MatchThread & matchThread = *threadState[i];
         match_time_s = std::max(match_time_s, matchThread.get_match_time());
         _stats.merge_partition(matchThread.get_thread_stats(), i);
+        _resource_usage.threads.push_back(matchThread.get_resource_usage());
+        _resource_usage.docs_matched += matchThread.get_thread_stats().docsMatched();
+        _resource_usage.docs_ranked += matchThread.get_thread_stats().docsRanked();
+        _resource_usage.docs_reranked += matchThread.get_thread_stats().docsReRanked();
         if (inserter && matchThread.getTrace().hasTrace()) {
             vespalib::slime::inject(matchThread.getTrace().getRoot(), *inserter);
         }
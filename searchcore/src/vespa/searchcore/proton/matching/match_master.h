@@ -4,6 +4,7 @@
 
 #include "result_processor.h"
 #include "matching_stats.h"
+#include "query_resource_usage.h"
 
 namespace vespalib { struct ThreadBundle; }
 namespace search { class FeatureSet; }
@@ -20,10 +21,12 @@ struct MatchParams;
 class MatchMaster
 {
 private:
-    MatchingStats _stats;
+    MatchingStats      _stats;
+    QueryResourceUsage _resource_usage;
 
 public:
     const MatchingStats & getStats() const { return _stats; }
+    const QueryResourceUsage & getResourceUsage() const { return _resource_usage; }
     ResultProcessor::Result::UP match(search::engine::Trace & trace,
                                       const MatchParams &params,
                                       vespalib::ThreadBundle &threadBundle,
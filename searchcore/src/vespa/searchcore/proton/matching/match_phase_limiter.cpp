@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "match_phase_limiter.h"
+#include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchlib/queryeval/andsearchstrict.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/log/log.h>
@@ -76,18 +77,22 @@ MatchPhaseLimiter::MatchPhaseLimiter(uint32_t docIdLimit, Searchable &searchable
       _calculator(degradation.max_hits, diversity.min_groups, degradation.sample_percentage),
       _limiter_factory(searchable_attributes, requestContext, degradation.attribute, degradation.descending,
                        diversity.attribute, diversity.cutoff_factor, diversity.cutoff_strategy),
+      _block_limiter(),
       _coverage(docIdLimit)
-{ }
+{
+    const auto *attribute = requestContext.getAttribute(degradation.attribute);
+    if ((attribute != nullptr) && BlockBoundLimiter::supports(*attribute)) {
+        _block_limiter = std::make_unique<BlockBoundLimiter>(*attribute, degradation.descending, docIdLimit);
+    }
+}
 
 namespace {
 
 template <bool PRE_FILTER>
 SearchIterator::UP
-do_limit(AttributeLimiter &limiter_factory, SearchIterator::UP search,
-         size_t wanted_num_docs, size_t max_group_size,
-         uint32_t current_id, uint32_t end_id)
+do_limit(SearchIterator::UP limiter, SearchIterator::UP search,
+         size_t wanted_num_docs, uint32_t current_id, uint32_t end_id)
 {
-    SearchIterator::UP limiter = limiter_factory.create_search(wanted_num_docs, max_group_size, PRE_FILTER);
     limiter = search->andWith(std::move(limiter), wanted_num_docs);
     if (limiter) {
         search = std::make_unique<LimitedSearchT<PRE_FILTER>>(std::move(limiter), std::move(search));
@@ -98,6 +103,20 @@ do_limit(AttributeLimiter &limiter_factory, SearchIterator::UP search,
 
 } // namespace proton::matching::<unnamed>
 
+SearchIterator::UP
+MatchPhaseLimiter::create_limiter(size_t wanted_num_docs, size_t max_group_size, bool strictSearch)
+{
+    return (_block_limiter)
+        ? _block_limiter->create_search(wanted_num_docs, strictSearch)
+        : _limiter_factory.create_search(wanted_num_docs, max_group_size, strictSearch);
+}
+
+ssize_t
+MatchPhaseLimiter::getEstimatedHits() const
+{
+    return (_block_limiter) ? _block_limiter->getEstimatedHits() : _limiter_factory.getEstimatedHits();
+}
+
 SearchIterator::UP
 MatchPhaseLimiter::maybe_limit(SearchIterator::UP search, double match_freq, size_t num_docs, Cursor * trace)
 {
@@ -125,6 +144,9 @@ MatchPhaseLimiter::maybe_limit(SearchIterator::UP search, double match_freq, siz
     bool use_pre_filter = (wanted_num_docs < (total_query_hits * _postFilterMultiplier));
     if (trace) {
         trace->setString("action", use_pre_filter ? "Will limit with prefix filter" : "Will limit with postfix filter");
+        if (_block_limiter) {
+            trace->setString("limiter", "block_bounds");
+        }
         trace->setLong("max_group_size", max_group_size);
         trace->setLong("current_docid", current_id);
         trace->setLong("end_docid", end_id);
@@ -134,15 +156,16 @@ MatchPhaseLimiter::maybe_limit(SearchIterator::UP search, double match_freq, siz
         " max_group_size=%zu, current_docid=%u, end_docid=%u, total_query_hits=%ld",
         use_pre_filter ? "pre" : "post", match_freq, num_docs, max_filter_docs, wanted_num_docs,
         max_group_size, current_id, end_id, total_query_hits);
+    SearchIterator::UP limiter = create_limiter(wanted_num_docs, max_group_size, use_pre_filter);
     return (use_pre_filter)
-        ? do_limit<true>(_limiter_factory, std::move(search), wanted_num_docs, max_group_size, current_id, end_id)
-        : do_limit<false>(_limiter_factory, std::move(search), wanted_num_docs, max_group_size, current_id, end_id);
+        ? do_limit<true>(std::move(limiter), std::move(search), wanted_num_docs, current_id, end_id)
+        : do_limit<false>(std::move(limiter), std::move(search), wanted_num_docs, current_id, end_id);
 }
 
 void
 MatchPhaseLimiter::updateDocIdSpaceEstimate(size_t searchedDocIdSpace, size_t remainingDocIdSpace)
 {
-    _coverage.update(searchedDocIdSpace, remainingDocIdSpace, _limiter_factory.getEstimatedHits());
+    _coverage.update(searchedDocIdSpace, remainingDocIdSpace, getEstimatedHits());
 }
 
 size_t
@@ -4,6 +4,7 @@
 
 #include "match_phase_limit_calculator.h"
 #include "attribute_limiter.h"
+#include "block_bound_limiter.h"
 
 #include <vespa/searchlib/queryeval/searchable.h>
 #include <vespa/vespalib/stllike/string.h>
@@ -107,6 +108,8 @@ struct DegradationParams {
 
 /**
  * This class is is used when rank phase limiting is configured.
+ * Degradation attributes without fast-search are limited by block
+ * bounds (see BlockBoundLimiter) instead of by attribute range search.
  **/
 class MatchPhaseLimiter : public MaybeMatchPhaseLimiter
 {
@@ -133,15 +136,21 @@ private:
     const double              _maxFilterCoverage;
     MatchPhaseLimitCalculator _calculator;
     AttributeLimiter          _limiter_factory;
+    std::unique_ptr<BlockBoundLimiter> _block_limiter;
     Coverage                  _coverage;
 
+    SearchIterator::UP create_limiter(size_t wanted_num_docs, size_t max_group_size, bool strictSearch);
+    ssize_t getEstimatedHits() const;
+
 public:
     MatchPhaseLimiter(uint32_t docIdLimit,
                       search::queryeval::Searchable &searchable_attributes,
                       search::queryeval::IRequestContext & requestContext,
                       DegradationParams degradation, DiversityParams diversity);
     bool is_enabled() const override { return true; }
-    bool was_limited() const override { return _limiter_factory.was_used(); }
+    bool was_limited() const override {
+        return _limiter_factory.was_used() || (_block_limiter && _block_limiter->was_used());
+    }
     size_t sample_hits_per_thread(size_t num_threads) const override {
         return _calculator.sample_hits_per_thread(num_threads);
     }
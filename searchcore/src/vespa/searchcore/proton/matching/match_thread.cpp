@@ -3,6 +3,7 @@
 #include "match_thread.h"
 #include "document_scorer.h"
 #include "match_tools.h"
+#include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchcore/grouping/groupingmanager.h>
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchlib/engine/trace.h>
@@ -11,10 +12,13 @@
 #include <vespa/searchlib/queryeval/multibitvectoriterator.h>
 #include <vespa/searchlib/queryeval/andnotsearch.h>
 #include <vespa/vespalib/util/closure.h>
+#include <vespa/vespalib/util/ring_tracer.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 
+#include <ctime>
+
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.match_thread");
 
@@ -32,6 +36,9 @@ using search::attribute::AttributeOperation;
 
 namespace {
 
+RT_Tag match_loop_tag("proton.matching.match_loop");
+RT_Tag second_phase_tag("proton.matching.second_phase");
+
 struct WaitTimer {
     double &wait_time_s;
     vespalib::Timer wait_time;
@@ -61,6 +68,17 @@ struct FastBlackListingStrategy {
     }
 };
 
+// how many hits to score between each synchronization with the shared score threshold
+constexpr uint32_t SCORE_THRESHOLD_SYNC_INTERVAL = 64;
+
+double thread_cpu_time_s() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
 LazyValue get_score_feature(const RankProgram &rankProgram) {
     FeatureResolver resolver(rankProgram.get_seeds());
     assert(resolver.num_features() == 1u);
@@ -71,32 +89,100 @@ LazyValue get_score_feature(const RankProgram &rankProgram) {
 
 //-----------------------------------------------------------------------------
 
-MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads)
+MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads,
+                              SharedScoreThreshold *scoreThreshold)
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
       _ranking(tools.rank_program()),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
-      _doom(tools.getDoom())
+      _doom(tools.getDoom()),
+      _shared_threshold(scoreThreshold),
+      _score_threshold(-HUGE_VAL),
+      _scored_since_sync(0),
+      _use_batch(_ranking.supports_batch()),
+      _batch_fill(0),
+      _batch_docids(_use_batch ? RankProgram::batch_size : 0),
+      _batch_scores(_use_batch ? RankProgram::batch_size : 0)
+{
+    // hits below the shared threshold are collected without their score, so the
+    // score need not be calculated exactly for them (unless they may be dropped)
+    if ((_shared_threshold != nullptr) && std::isnan(rankDropLimit) && !_use_batch) {
+        _ranking.bind_score_threshold(&_score_threshold);
+    }
+}
+
+MatchThread::Context::~Context()
 {
+    if ((_shared_threshold != nullptr) && std::isnan(_rankDropLimit) && !_use_batch) {
+        _ranking.bind_score_threshold(nullptr);
+    }
 }
 
 template <bool use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    addScoredHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::batchHit(uint32_t docId) {
+    _batch_docids[_batch_fill++] = docId;
+    if (_batch_fill == _batch_docids.size()) {
+        flushBatch<use_rank_drop_limit>();
+    }
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::flushBatch() {
+    if (_batch_fill == 0) {
+        return;
+    }
+    _ranking.run_batch(vespalib::ConstArrayRef<uint32_t>(&_batch_docids[0], _batch_fill),
+                       vespalib::ArrayRef<search::feature_t>(&_batch_scores[0], _batch_fill));
+    for (uint32_t i = 0; i < _batch_fill; ++i) {
+        addScoredHit<use_rank_drop_limit>(_batch_docids[i], _batch_scores[i]);
+    }
+    _batch_fill = 0;
+}
+
+template <bool use_rank_drop_limit>
+void
+MatchThread::Context::addScoredHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
     }
     if (use_rank_drop_limit) {
         if (__builtin_expect(score > _rankDropLimit, true)) {
-            _hits.addHit(docId, score);
+            _hits.addHit(docId, applyScoreThreshold(score));
         }
     } else {
-        _hits.addHit(docId, score);
+        _hits.addHit(docId, applyScoreThreshold(score));
+    }
+}
+
+double
+MatchThread::Context::applyScoreThreshold(double score) {
+    if (_shared_threshold == nullptr) {
+        return score;
     }
+    if (++_scored_since_sync == SCORE_THRESHOLD_SYNC_INTERVAL) {
+        syncScoreThreshold();
+    }
+    // a hit below the shared threshold cannot be among the best ranked hits of
+    // the query, so it is collected like hits that the local heap would drop
+    return (score < _score_threshold) ? search::default_rank_value : score;
+}
+
+void
+MatchThread::Context::syncScoreThreshold() {
+    _scored_since_sync = 0;
+    _shared_threshold->update(_hits.getScoreThreshold());
+    _score_threshold = _shared_threshold->get();
 }
 
 //-----------------------------------------------------------------------------
@@ -159,8 +245,13 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     uint32_t docId = search->seekFirst(docid_range.begin);
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
-            search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            if (context.useBatch()) {
+                // batched rank programs do not use match data
+                context.batchHit<use_rank_drop_limit>(docId);
+            } else {
+                search->unpack(docId);
+                context.rankHit<use_rank_drop_limit>(docId);
+            }
         } else {
             context.addHit(docId);
         }
@@ -175,6 +266,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -185,7 +279,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     bool softDoomed = false;
     uint32_t docsCovered = 0;
     vespalib::duration overtime(vespalib::duration::zero());
-    Context context(matchParams.rankDropLimit, tools, hits, num_threads);
+    Context context(matchParams.rankDropLimit, tools, hits, num_threads, scoreThreshold);
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty();
          docid_range = scheduler.next_range(thread_id))
@@ -277,6 +371,7 @@ MatchThread::match_loop_helper(MatchTools &tools, HitCollector &hits)
 search::ResultSet::UP
 MatchThread::findMatches(MatchTools &tools)
 {
+    vespalib::Timer setup_time;
     tools.setup_first_phase();
     if (isFirstThread()) {
         LOG(spam, "SearchIterator: %s", tools.search().asString().c_str());
@@ -289,13 +384,21 @@ MatchThread::findMatches(MatchTools &tools)
             tools.search().asSlime(inserter);
         }
     }
-    HitCollector hits(matchParams.numDocs, matchParams.arraySize);
+    HitCollector hits(matchParams.numDocs, matchParams.arraySize,
+                      matchToolsFactory.createDiversityGroups(), matchToolsFactory.max_hits_per_group());
+    resource_usage.setup_time_s += vespalib::to_s(setup_time.elapsed());
+    resource_usage.stash_bytes += tools.rank_program().stash_bytes_used();
     trace->addEvent(4, "Start match and first phase rank");
-    match_loop_helper(tools, hits);
+    {
+        RT_Sample sample(match_loop_tag);
+        match_loop_helper(tools, hits);
+    }
     if (tools.has_second_phase_rank()) {
         { // 2nd phase ranking
+            RT_Sample sample(second_phase_tag);
             trace->addEvent(4, "Start second phase rerank");
             tools.setup_second_phase();
+            resource_usage.stash_bytes += tools.rank_program().stash_bytes_used();
             DocidRange docid_range = scheduler.total_span(thread_id);
             tools.search().initRange(docid_range.begin, docid_range.end);
             auto sorted_hit_seq = matchToolsFactory.should_diversify()
@@ -352,10 +455,13 @@ MatchThread::processResult(const Doom & doom,
         man.groupUnordered(hits, numHits, bits);
     }
     if (doom.hard_doom()) return;
-    size_t sortLimit = hasGrouping ? numHits : context.result->maxSize();
+    // Groupings aggregating all hits unordered are done above, so only groupings
+    // that need the hits of this thread in relevance order require a full sort.
+    bool groupInRelevanceOrder = hasGrouping && search::grouping::GroupingManager(*context.grouping).needRelevanceOrder();
+    size_t sortLimit = groupInRelevanceOrder ? numHits : context.result->maxSize();
     result->sort(*context.sort->sorter, sortLimit);
     if (doom.hard_doom()) return;
-    if (hasGrouping) {
+    if (groupInRelevanceOrder) {
         search::grouping::GroupingManager man(*context.grouping);
         man.groupInRelevanceOrder(hits, numHits);
     }
@@ -397,6 +503,7 @@ MatchThread::MatchThread(size_t thread_id_in,
                          const MatchToolsFactory &mtf,
                          IMatchLoopCommunicator &com,
                          DocidRangeScheduler &sched,
+                         SharedScoreThreshold *scoreThreshold_in,
                          ResultProcessor &rp,
                          vespalib::DualMergeDirector &md,
                          uint32_t distributionKey,
@@ -409,6 +516,7 @@ MatchThread::MatchThread(size_t thread_id_in,
     communicator(com),
     scheduler(sched),
     idle_observer(scheduler.make_idle_observer()),
+    scoreThreshold(scoreThreshold_in),
     _distributionKey(distributionKey),
     resultProcessor(rp),
     mergeDirector(md),
@@ -417,6 +525,7 @@ MatchThread::MatchThread(size_t thread_id_in,
     total_time_s(0.0),
     match_time_s(0.0),
     wait_time_s(0.0),
+    resource_usage(),
     match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores()),
     trace(std::make_unique<Trace>(relativeTime, traceLevel))
 {
@@ -425,10 +534,12 @@ MatchThread::MatchThread(size_t thread_id_in,
 void
 MatchThread::run()
 {
+    double start_cpu_time_s = thread_cpu_time_s();
     vespalib::Timer total_time;
     vespalib::Timer match_time(total_time);
     trace->addEvent(4, "Start MatchThread::run");
     MatchTools::UP matchTools = matchToolsFactory.createMatchTools();
+    resource_usage.setup_time_s = vespalib::to_s(total_time.elapsed());
     search::ResultSet::UP result = findMatches(*matchTools);
     match_time_s = vespalib::to_s(match_time.elapsed());
     resultContext = resultProcessor.createThreadContext(matchTools->getDoom(), thread_id, _distributionKey);
@@ -449,6 +560,7 @@ MatchThread::run()
     thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
     trace->addEvent(4, "Start thread merge");
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
+    resource_usage.cpu_time_s = thread_cpu_time_s() - start_cpu_time_s;
     trace->addEvent(4, "MatchThread::run Done");
 }
 
@@ -6,8 +6,10 @@
 #include "match_params.h"
 #include "matching_stats.h"
 #include "partial_result.h"
+#include "query_resource_usage.h"
 #include "result_processor.h"
 #include "docid_range_scheduler.h"
+#include "shared_score_threshold.h"
 #include <vespa/vespalib/util/runnable.h>
 #include <vespa/vespalib/util/dual_merge_director.h>
 #include <vespa/searchlib/common/resultset.h>
@@ -53,6 +55,7 @@ private:
     IMatchLoopCommunicator       &communicator;
     DocidRangeScheduler          &scheduler;
     IdleObserver                  idle_observer;
+    SharedScoreThreshold         *scoreThreshold;
     uint32_t                      _distributionKey;
     ResultProcessor              &resultProcessor;
     vespalib::DualMergeDirector  &mergeDirector;
@@ -61,15 +64,22 @@ private:
     double                        total_time_s;
     double                        match_time_s;
     double                        wait_time_s;
+    QueryResourceUsage::Thread    resource_usage;
     bool                          match_with_ranking;
     std::unique_ptr<Trace>        trace;
 
     class Context {
     public:
         Context(double rankDropLimit, MatchTools &tools, HitCollector &hits,
-                uint32_t num_threads) __attribute__((noinline));
+                uint32_t num_threads, SharedScoreThreshold *scoreThreshold) __attribute__((noinline));
+        ~Context();
         template <bool use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <bool use_rank_drop_limit>
+        void batchHit(uint32_t docId);
+        template <bool use_rank_drop_limit>
+        void flushBatch();
+        bool useBatch() const { return _use_batch; }
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -77,12 +87,24 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <bool use_rank_drop_limit>
+        void addScoredHit(uint32_t docId, double score);
+        double applyScoreThreshold(double score);
+        void syncScoreThreshold() __attribute__((noinline));
+
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
         RankProgram    &_ranking;
         double          _rankDropLimit;
         HitCollector   &_hits;
         const Doom     &_doom;
+        SharedScoreThreshold          *_shared_threshold;
+        double                         _score_threshold;
+        uint32_t                       _scored_since_sync;
+        bool                           _use_batch;
+        uint32_t                       _batch_fill;
+        std::vector<uint32_t>          _batch_docids;
+        std::vector<search::feature_t> _batch_scores;
     };
 
     double estimate_match_frequency(uint32_t matches, uint32_t searchedSoFar) __attribute__((noinline));
@@ -119,6 +141,7 @@ public:
                 const MatchToolsFactory &mtf,
                 IMatchLoopCommunicator &com,
                 DocidRangeScheduler &sched,
+                SharedScoreThreshold *scoreThreshold_in,
                 ResultProcessor &rp,
                 vespalib::DualMergeDirector &md,
                 uint32_t distributionKey,
@@ -127,6 +150,7 @@ public:
     void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
+    const QueryResourceUsage::Thread &get_resource_usage() const { return resource_usage; }
     PartialResult::UP extract_result() { return std::move(resultContext->result); }
     const Trace & getTrace() const { return *trace; }
 };
@@ -18,6 +18,7 @@ LOG_SETUP(".proton.matching.match_tools");
 using search::attribute::IAttributeContext;
 using search::queryeval::IRequestContext;
 using search::queryeval::IDiversifier;
+using search::queryeval::IDiversityGroups;
 using search::attribute::diversity::DiversityFilter;
 using search::attribute::BasicType;
 using search::attribute::AttributeBlueprintParams;
@@ -69,13 +70,14 @@ extractDiversityParams(const RankSetup &rankSetup, const Properties &rankPropert
 AttributeBlueprintParams
 extractAttributeBlueprintParams(const RankSetup& rank_setup, const Properties &rankProperties)
 {
-    return AttributeBlueprintParams(NearestNeighborBruteForceLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_brute_force_limit()));
+    return AttributeBlueprintParams(NearestNeighborBruteForceLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_brute_force_limit()),
+                                    NearestNeighborPostFilterLimit::lookup(rankProperties, rank_setup.get_nearest_neighbor_post_filter_limit()));
 }
 
 } // namespace proton::matching::<unnamed>
 
 void
-MatchTools::setup(search::fef::RankProgram::UP rank_program, double termwise_limit)
+MatchTools::setup(search::fef::RankProgram::UP rank_program, double termwise_limit, bool adaptive_termwise)
 {
     if (_search) {
         _match_data->soft_reset();
@@ -91,6 +93,7 @@ MatchTools::setup(search::fef::RankProgram::UP rank_program, double termwise_lim
     if (!can_reuse_search) {
         recorder.tag_match_data(*_match_data);
         _match_data->set_termwise_limit(termwise_limit);
+        _match_data->set_adaptive_termwise(adaptive_termwise);
         _search = _query.createSearch(*_match_data);
         _used_handles = recorder.get_handles();
         _search_has_changed = false;
@@ -131,7 +134,8 @@ void
 MatchTools::setup_first_phase()
 {
     setup(_rankSetup.create_first_phase_program(),
-          TermwiseLimit::lookup(_queryEnv.getProperties(), _rankSetup.get_termwise_limit()));
+          TermwiseLimit::lookup(_queryEnv.getProperties(), _rankSetup.get_termwise_limit()),
+          AdaptiveTermwise::check(_queryEnv.getProperties(), _rankSetup.get_adaptive_termwise()));
 }
 
 void
@@ -167,7 +171,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const IIndexEnvironment    & indexEnv,
                   const RankSetup            & rankSetup,
                   const Properties           & rankProperties,
-                  const Properties           & featureOverrides)
+                  const Properties           & featureOverrides,
+                  search::attribute::BitVectorSearchCache * filterCache)
     : _queryLimiter(queryLimiter),
       _requestContext(doom, attributeContext, rankProperties, extractAttributeBlueprintParams(rankSetup, rankProperties)),
       _query(),
@@ -177,10 +182,12 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
       _diversityParams(),
+      _maxHitsPerGroup(0),
       _valid(false)
 {
     trace.addEvent(4, "MTF: Start");
     _query.setWhiteListBlueprint(metaStore.createWhiteListBlueprint());
+    _query.setFilterCache(filterCache);
     trace.addEvent(5, "MTF: Build query");
     _valid = _query.buildTree(queryStack, location, viewResolver, indexEnv,
                               rankSetup.split_unpacking_iterators(),
@@ -200,6 +207,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
         trace.addEvent(5, "MTF: prepareSharedState");
         _rankSetup.prepareSharedState(_queryEnv, _queryEnv.getObjectStore());
         _diversityParams = extractDiversityParams(_rankSetup, rankProperties);
+        _maxHitsPerGroup = hitcollector::MaxHitsPerGroup::lookup(rankProperties, _rankSetup.getMaxHitsPerGroup());
         DegradationParams degradationParams = extractDegradationParams(_rankSetup, rankProperties);
 
         if (degradationParams.enabled()) {
@@ -240,6 +248,20 @@ MatchToolsFactory::createDiversifier(uint32_t heapSize) const
                                    _diversityParams.cutoff_strategy == DiversityParams::CutoffStrategy::STRICT);
 }
 
+std::unique_ptr<IDiversityGroups>
+MatchToolsFactory::createDiversityGroups() const
+{
+    if (_diversityParams.attribute.empty() || (_maxHitsPerGroup == 0)) {
+        return std::unique_ptr<IDiversityGroups>();
+    }
+    auto attr = _requestContext.getAttribute(_diversityParams.attribute);
+    if ( !attr) {
+        LOG(warning, "Skipping max hits per group due to no %s attribute.", _diversityParams.attribute.c_str());
+        return std::unique_ptr<IDiversityGroups>();
+    }
+    return search::attribute::diversity::create_groups(*attr);
+}
+
 std::unique_ptr<AttributeOperationTask>
 MatchToolsFactory::createTask(vespalib::stringref attribute, vespalib::stringref operation) const {
     return (!attribute.empty() && ! operation.empty())
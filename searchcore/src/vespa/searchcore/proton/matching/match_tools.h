@@ -17,6 +17,7 @@
 #include <vespa/vespalib/util/doom.h>
 #include <vespa/vespalib/util/clock.h>
 
+namespace search::attribute { class BitVectorSearchCache; }
 namespace search::engine { class Trace; }
 
 namespace search::fef {
@@ -41,7 +42,7 @@ private:
     search::queryeval::SearchIterator::UP  _search;
     HandleRecorder::HandleMap              _used_handles;
     bool                                   _search_has_changed;
-    void setup(std::unique_ptr<search::fef::RankProgram>, double termwise_limit = 1.0);
+    void setup(std::unique_ptr<search::fef::RankProgram>, double termwise_limit = 1.0, bool adaptive_termwise = false);
 public:
     typedef std::unique_ptr<MatchTools> UP;
     MatchTools(const MatchTools &) = delete;
@@ -99,6 +100,7 @@ private:
     const search::fef::RankSetup    & _rankSetup;
     const search::fef::Properties   & _featureOverrides;
     DiversityParams                   _diversityParams;
+    uint32_t                          _maxHitsPerGroup;
     bool                              _valid;
 
     std::unique_ptr<AttributeOperationTask>
@@ -119,13 +121,16 @@ public:
                       const search::fef::IIndexEnvironment &indexEnv,
                       const search::fef::RankSetup &rankSetup,
                       const search::fef::Properties &rankProperties,
-                      const search::fef::Properties &featureOverrides);
+                      const search::fef::Properties &featureOverrides,
+                      search::attribute::BitVectorSearchCache *filterCache = nullptr);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
     MatchTools::UP createMatchTools() const;
     bool should_diversify() const { return _diversityParams.enabled(); }
     std::unique_ptr<search::queryeval::IDiversifier> createDiversifier(uint32_t heapSize) const;
+    uint32_t max_hits_per_group() const { return _maxHitsPerGroup; }
+    std::unique_ptr<search::queryeval::IDiversityGroups> createDiversityGroups() const;
     search::queryeval::Blueprint::HitEstimate estimate() const { return _query.estimate(); }
     bool has_first_phase_rank() const;
     std::unique_ptr<AttributeOperationTask> createOnMatchTask() const;
@@ -6,8 +6,10 @@
 #include "match_tools.h"
 #include "match_params.h"
 #include "matcher.h"
+#include "query_result_cache.h"
 #include "sessionmanager.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
+#include <vespa/searchlib/attribute/bitvector_search_cache.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
@@ -15,6 +17,7 @@
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/ranksetup.h>
 #include <vespa/searchlib/fef/test/plugin/setup.h>
+#include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 
 #include <vespa/log/log.h>
@@ -109,7 +112,9 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
       _startTime(my_clock::now()),
       _clock(clock),
       _queryLimiter(queryLimiter),
-      _distributionKey(distributionKey)
+      _distributionKey(distributionKey),
+      _resultCache(),
+      _filterCache()
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -118,8 +123,18 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
     if (!_rankSetup->compile()) {
         throw vespalib::IllegalArgumentException("failed to compile rank setup", VESPA_STRLOC);
     }
+    uint32_t resultCacheSize = ResultCacheSize::lookup(props);
+    if (resultCacheSize > 0) {
+        _resultCache = std::make_unique<QueryResultCache>(resultCacheSize);
+    }
+    uint32_t filterCacheMaxMemory = FilterCacheMaxMemory::lookup(props);
+    if (filterCacheMaxMemory > 0) {
+        _filterCache = std::make_unique<search::attribute::BitVectorSearchCache>(filterCacheMaxMemory);
+    }
 }
 
+Matcher::~Matcher() = default;
+
 MatchingStats
 Matcher::getStats()
 {
@@ -127,6 +142,12 @@ Matcher::getStats()
     MatchingStats stats = std::move(_stats);
     _stats = MatchingStats();
     _stats.softDoomFactor(stats.softDoomFactor());
+    if (_resultCache) {
+        QueryResultCache::Stats cacheStats = _resultCache->takeStats();
+        stats.resultCacheHits(cacheStats.hits)
+             .resultCacheMisses(cacheStats.misses)
+             .resultCacheInvalidations(cacheStats.invalidations);
+    }
     return stats;
 }
 
@@ -156,7 +177,7 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
     return std::make_unique<MatchToolsFactory>(_queryLimiter, doom, searchContext, attrContext,
                                                request.trace(), request.getStackRef(), request.location,
                                                _viewResolver, metaStore, _indexEnv, *_rankSetup,
-                                               rankProperties, feature_overrides);
+                                               rankProperties, feature_overrides, _filterCache.get());
 }
 
 size_t
@@ -178,6 +199,18 @@ namespace {
             }
         }
     }
+
+    std::vector<vespalib::string> extractQueryFields(vespalib::stringref stack) {
+        std::vector<vespalib::string> fields;
+        search::SimpleQueryStackDumpIterator iterator(stack);
+        while (iterator.next()) {
+            vespalib::stringref field = iterator.getIndexName();
+            if (!field.empty() && (std::find(fields.begin(), fields.end(), field) == fields.end())) {
+                fields.emplace_back(field);
+            }
+        }
+        return fields;
+    }
 }
 
 SearchReply::UP
@@ -187,14 +220,30 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
 {
     vespalib::Timer total_matching_time;
     MatchingStats my_stats;
+    QueryResourceUsage resource_usage;
+    vespalib::system_time start_time = vespalib::system_clock::now();
     SearchReply::UP reply = std::make_unique<SearchReply>();
     size_t covered = 0;
     uint32_t numActiveLids = 0;
     bool isDoomExplicit = false;
+    vespalib::string resultCacheKey;
+    uint64_t visibilityGeneration = searchContext.getVisibilityGeneration();
+    if (_resultCache && QueryResultCache::isCacheable(request)) {
+        resultCacheKey = QueryResultCache::makeKey(request);
+        SearchReply::UP cached = _resultCache->lookup(resultCacheKey, visibilityGeneration);
+        if (cached) {
+            my_stats.queries(1).queryLatency(vespalib::to_s(total_matching_time.elapsed()));
+            std::lock_guard<std::mutex> guard(_statsLock);
+            _stats.add(my_stats);
+            return cached;
+        }
+    }
     { // we want to measure full set-up and tear-down time as part of
       // collateral time
         GroupingContext groupingContext(_clock, request.getTimeOfDoom(),
                                         &request.groupSpec[0], request.groupSpec.size());
+        groupingContext.setApproximate(ApproximateGrouping::check(request.propertiesMap.rankProperties(),
+                                                                  ApproximateGrouping::check(_indexEnv.getProperties())));
         SessionId sessionId(&request.sessionId[0], request.sessionId.size());
         bool shouldCacheSearchSession = false;
         bool shouldCacheGroupingSession = false;
@@ -215,8 +264,10 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             feature_overrides = owned_objects.feature_overrides.get();
         }
 
+        vespalib::Timer query_setup_time;
         MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext,
                                                                metaStore, *feature_overrides);
+        double query_setup_time_s = vespalib::to_s(query_setup_time.elapsed());
         isDoomExplicit = mtf->getRequestContext().getDoom().isExplicitSoftDoom();
         traceQuery(6, request.trace(), mtf->query());
         if (!mtf->valid()) {
@@ -239,6 +290,8 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         uint32_t numParts = NumSearchPartitions::lookup(rankProperties, _rankSetup->getNumSearchPartitions());
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
                                                           _distributionKey, numParts);
+        resource_usage = master.getResourceUsage();
+        resource_usage.query_setup_time_s = query_setup_time_s;
         my_stats = MatchMaster::getStats(std::move(master));
 
         bool wasLimited = mtf->match_limiter().was_limited();
@@ -283,10 +336,24 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             coverage.degradeTimeout();
             LOG(debug, "soft doomed, degraded from timeout covered = %" PRIu64, coverage.getCovered());
         }
+        if (!resultCacheKey.empty() && (coverage.getDegradeReason() == 0)) {
+            _resultCache->insert(resultCacheKey, visibilityGeneration, *reply);
+        }
         LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%" PRIu64 ", rankprofile=%s",
             numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount,
             request.ranking.c_str());
     }
+    resource_usage.start_time = start_time;
+    resource_usage.rank_profile = request.ranking;
+    resource_usage.latency_s = vespalib::to_s(total_matching_time.elapsed());
+    if (vespalib::slime::Cursor *cursor = request.trace().maybeCreateCursor(3, "resource_usage")) {
+        resource_usage.toSlime(*cursor);
+    }
+    SlowQueryLog &slowQueryLog = sessionMgr.getSlowQueryLog();
+    if (slowQueryLog.isSlowEnough(resource_usage.latency_s)) {
+        resource_usage.fields = extractQueryFields(request.getStackRef());
+        slowQueryLog.add(std::move(resource_usage));
+    }
     double querySetupTime = vespalib::to_s(total_matching_time.elapsed()) - my_stats.queryLatencyAvg();
     my_stats.queryCollateralTime(querySetupTime); // TODO: Remove in Vespa 8
     my_stats.querySetupTime(querySetupTime);
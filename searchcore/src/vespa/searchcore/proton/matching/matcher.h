@@ -27,7 +27,10 @@ namespace search::grouping {
     class GroupingSession;
 }
 namespace search::index { class Schema; }
-namespace search::attribute { class IAttributeContext; }
+namespace search::attribute {
+    class BitVectorSearchCache;
+    class IAttributeContext;
+}
 namespace search::engine {
     class Request;
     class SearchRequest;
@@ -42,6 +45,7 @@ namespace proton::matching {
 class ISearchContext;
 class SessionManager;
 class MatchToolsFactory;
+class QueryResultCache;
 
 /**
  * The Matcher is responsible for performing searches.
@@ -66,6 +70,8 @@ private:
     const vespalib::Clock        &_clock;
     QueryLimiter                 &_queryLimiter;
     uint32_t                      _distributionKey;
+    std::unique_ptr<QueryResultCache> _resultCache;
+    std::unique_ptr<search::attribute::BitVectorSearchCache> _filterCache;
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const Properties & rankProperties) const;
@@ -91,9 +97,16 @@ public:
             const vespalib::Clock &clock, QueryLimiter &queryLimiter,
             const IConstantValueRepo &constantValueRepo, OnnxModels onnxModels,
             uint32_t distributionKey);
+    ~Matcher();
 
     const search::fef::IIndexEnvironment &get_index_env() const { return _indexEnv; }
 
+    /**
+     * @return the result cache of this matcher, or nullptr if result caching is not enabled
+     **/
+    const QueryResultCache *getResultCache() const { return _resultCache.get(); }
+    const search::attribute::BitVectorSearchCache *getFilterCache() const { return _filterCache.get(); }
+
     /**
      * Observe and reset stats for this object.
      *
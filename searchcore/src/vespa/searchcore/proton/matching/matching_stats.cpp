@@ -22,6 +22,9 @@ constexpr double MAX_CHANGE_FACTOR = 5;
 MatchingStats::MatchingStats()
     : _queries(0),
       _limited_queries(0),
+      _resultCacheHits(0),
+      _resultCacheMisses(0),
+      _resultCacheInvalidations(0),
       _docidSpaceCovered(0),
       _docsMatched(0),
       _docsRanked(0),
@@ -32,6 +35,7 @@ MatchingStats::MatchingStats()
       _queryCollateralTime(), // TODO: Remove in Vespa 8
       _querySetupTime(),
       _queryLatency(),
+      _queryLatencySamples(),
       _matchTime(),
       _groupingTime(),
       _rerankTime(),
@@ -62,6 +66,9 @@ MatchingStats::add(const MatchingStats &rhs)
 {
     _queries += rhs._queries;
     _limited_queries += rhs._limited_queries;
+    _resultCacheHits += rhs._resultCacheHits;
+    _resultCacheMisses += rhs._resultCacheMisses;
+    _resultCacheInvalidations += rhs._resultCacheInvalidations;
 
     _docidSpaceCovered += rhs._docidSpaceCovered;
     _docsMatched += rhs._docsMatched;
@@ -73,6 +80,8 @@ MatchingStats::add(const MatchingStats &rhs)
     _queryCollateralTime.add(rhs._queryCollateralTime); // TODO: Remove in Vespa 8
     _querySetupTime.add(rhs._querySetupTime);
     _queryLatency.add(rhs._queryLatency);
+    _queryLatencySamples.insert(_queryLatencySamples.end(),
+                                rhs._queryLatencySamples.begin(), rhs._queryLatencySamples.end());
     _matchTime.add(rhs._matchTime);
     _groupingTime.add(rhs._groupingTime);
     _rerankTime.add(rhs._rerankTime);
@@ -118,6 +118,9 @@ public:
 private:
     size_t                 _queries;
     size_t                 _limited_queries;
+    size_t                 _resultCacheHits;
+    size_t                 _resultCacheMisses;
+    size_t                 _resultCacheInvalidations;
     size_t                 _docidSpaceCovered;
     size_t                 _docsMatched;
     size_t                 _docsRanked;
@@ -128,6 +131,7 @@ private:
     Avg                    _queryCollateralTime; // TODO: Remove in Vespa 8
     Avg                    _querySetupTime;
     Avg                    _queryLatency;
+    std::vector<double>    _queryLatencySamples;
     Avg                    _matchTime;
     Avg                    _groupingTime;
     Avg                    _rerankTime;
@@ -148,6 +152,15 @@ public:
     MatchingStats &limited_queries(size_t value) { _limited_queries = value; return *this; }
     size_t limited_queries() const { return _limited_queries; }
 
+    MatchingStats &resultCacheHits(size_t value) { _resultCacheHits = value; return *this; }
+    size_t resultCacheHits() const { return _resultCacheHits; }
+
+    MatchingStats &resultCacheMisses(size_t value) { _resultCacheMisses = value; return *this; }
+    size_t resultCacheMisses() const { return _resultCacheMisses; }
+
+    MatchingStats &resultCacheInvalidations(size_t value) { _resultCacheInvalidations = value; return *this; }
+    size_t resultCacheInvalidations() const { return _resultCacheInvalidations; }
+
     MatchingStats &docidSpaceCovered(size_t value) { _docidSpaceCovered = value; return *this; }
     size_t docidSpaceCovered() const { return _docidSpaceCovered; }
 
@@ -182,11 +195,17 @@ public:
     double querySetupTimeMin() const { return _querySetupTime.min(); }
     double querySetupTimeMax() const { return _querySetupTime.max(); }
 
-    MatchingStats &queryLatency(double time_s) { _queryLatency.set(time_s); return *this; }
+    MatchingStats &queryLatency(double time_s) {
+        _queryLatency.set(time_s);
+        _queryLatencySamples.assign(1, time_s);
+        return *this;
+    }
     double queryLatencyAvg() const { return _queryLatency.avg(); }
     size_t queryLatencyCount() const { return _queryLatency.count(); }
     double queryLatencyMin() const { return _queryLatency.min(); }
     double queryLatencyMax() const { return _queryLatency.max(); }
+    // individual query latencies, used to track the latency distribution
+    const std::vector<double> &queryLatencySamples() const { return _queryLatencySamples; }
 
     MatchingStats &matchTime(double time_s) { _matchTime.set(time_s); return *this; }
     double matchTimeAvg() const { return _matchTime.avg(); }
@@ -120,6 +120,18 @@ PartialResult::merge(Source &rhs)
     PartialResult &r = static_cast<PartialResult&>(rhs);
     assert(_hasSortData == r._hasSortData);
     _totalHits += r._totalHits;
+    // Threads with no hits are common with many match threads and a
+    // selective query; skip rebuilding the hit and sort ref vectors
+    // when the merge cannot change their contents.
+    if (r._hits.empty() && (_hits.size() <= _maxSize)) {
+        return;
+    }
+    if (_hits.empty() && (r._hits.size() <= _maxSize)) {
+        std::swap(_hits, r._hits);
+        std::swap(_sortData, r._sortData);
+        std::swap(_sortDataSize, r._sortDataSize);
+        return;
+    }
     if (_hasSortData) {
         _sortDataSize = mergeHits(_maxSize, _hits, _sortData, r._hits, r._sortData);
     } else {
@@ -12,6 +12,7 @@
 #include <vespa/searchlib/common/geo_location_parser.h>
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/vespalib/util/ring_tracer.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.query");
@@ -43,6 +44,9 @@ namespace proton::matching {
 
 namespace {
 
+RT_Tag blueprint_build_tag("proton.matching.blueprint_build");
+RT_Tag fetch_postings_tag("proton.matching.fetch_postings");
+
 Node::UP
 inject(Node::UP query, Node::UP to_inject) {
     if (auto * my_and = dynamic_cast<search::query::And *>(query.get())) {
@@ -200,10 +204,11 @@ Query::setWhiteListBlueprint(Blueprint::UP whiteListBlueprint)
 void
 Query::reserveHandles(const IRequestContext & requestContext, ISearchContext &context, MatchDataLayout &mdl)
 {
+    RT_Sample sample(blueprint_build_tag);
     MatchDataReserveVisitor reserve_visitor(mdl);
     _query_tree->accept(reserve_visitor);
 
-    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context);
+    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context, _filterCache);
     LOG(debug, "original blueprint:\n%s\n", _blueprint->asString().c_str());
     if (_whiteListBlueprint) {
         auto andBlueprint = std::make_unique<AndBlueprint>();
@@ -234,6 +239,7 @@ Query::optimize()
 void
 Query::fetchPostings()
 {
+    RT_Sample sample(fetch_postings_tag);
     _blueprint->fetchPostings(search::queryeval::ExecuteInfo::create(true, 1.0));
 }
 
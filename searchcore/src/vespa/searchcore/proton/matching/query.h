@@ -10,6 +10,8 @@
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/irequestcontext.h>
 
+namespace search::attribute { class BitVectorSearchCache; }
+
 namespace proton::matching {
 
 class ViewResolver;
@@ -22,6 +24,7 @@ private:
     search::query::Node::UP _query_tree;
     Blueprint::UP           _blueprint;
     Blueprint::UP           _whiteListBlueprint;
+    search::attribute::BitVectorSearchCache *_filterCache = nullptr;
     std::vector<search::common::GeoLocationSpec> _locations;
 
 public:
@@ -42,6 +45,14 @@ public:
      **/
     void setWhiteListBlueprint(Blueprint::UP whiteListBlueprint);
 
+    /**
+     * Use the given cache for the result of pure filter parts of the
+     * query when building the blueprint tree. Must outlive the query.
+     *
+     * @param filterCache the cache, or nullptr to not cache filters.
+     **/
+    void setFilterCache(search::attribute::BitVectorSearchCache *filterCache) { _filterCache = filterCache; }
+
     /**
      * Build query tree from a stack dump.
      *
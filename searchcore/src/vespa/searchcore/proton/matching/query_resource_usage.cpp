@@ -0,0 +1,84 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_resource_usage.h"
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <algorithm>
+
+namespace proton::matching {
+
+QueryResourceUsage::QueryResourceUsage()
+    : start_time(),
+      rank_profile(),
+      fields(),
+      latency_s(0.0),
+      query_setup_time_s(0.0),
+      docs_matched(0),
+      docs_ranked(0),
+      docs_reranked(0),
+      threads()
+{
+}
+
+QueryResourceUsage::QueryResourceUsage(const QueryResourceUsage &) = default;
+QueryResourceUsage::QueryResourceUsage(QueryResourceUsage &&) noexcept = default;
+QueryResourceUsage & QueryResourceUsage::operator = (const QueryResourceUsage &) = default;
+QueryResourceUsage & QueryResourceUsage::operator = (QueryResourceUsage &&) noexcept = default;
+QueryResourceUsage::~QueryResourceUsage() = default;
+
+double
+QueryResourceUsage::cpu_time_s() const
+{
+    double sum = 0.0;
+    for (const auto &thread : threads) {
+        sum += thread.cpu_time_s;
+    }
+    return sum;
+}
+
+double
+QueryResourceUsage::setup_time_s() const
+{
+    double max = 0.0;
+    for (const auto &thread : threads) {
+        max = std::max(max, thread.setup_time_s);
+    }
+    return max;
+}
+
+size_t
+QueryResourceUsage::stash_bytes() const
+{
+    size_t sum = 0;
+    for (const auto &thread : threads) {
+        sum += thread.stash_bytes;
+    }
+    return sum;
+}
+
+void
+QueryResourceUsage::toSlime(vespalib::slime::Cursor &object) const
+{
+    object.setString("start_time", vespalib::to_string(start_time));
+    object.setString("rank_profile", rank_profile);
+    vespalib::slime::Cursor &fieldArray = object.setArray("fields");
+    for (const auto &field : fields) {
+        fieldArray.addString(field);
+    }
+    object.setDouble("latency", latency_s);
+    object.setDouble("query_setup_time", query_setup_time_s);
+    object.setDouble("iterator_setup_time", setup_time_s());
+    object.setDouble("cpu_time", cpu_time_s());
+    object.setLong("stash_bytes", stash_bytes());
+    object.setLong("docs_matched", docs_matched);
+    object.setLong("docs_ranked", docs_ranked);
+    object.setLong("docs_reranked", docs_reranked);
+    vespalib::slime::Cursor &threadArray = object.setArray("threads");
+    for (const auto &thread : threads) {
+        vespalib::slime::Cursor &entry = threadArray.addObject();
+        entry.setDouble("cpu_time", thread.cpu_time_s);
+        entry.setDouble("iterator_setup_time", thread.setup_time_s);
+        entry.setLong("stash_bytes", thread.stash_bytes);
+    }
+}
+
+}
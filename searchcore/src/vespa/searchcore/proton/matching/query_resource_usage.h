@@ -0,0 +1,54 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
+#include <vector>
+
+namespace vespalib::slime { struct Cursor; }
+
+namespace proton::matching {
+
+/**
+ * Resources used by a single query in the matching pipeline. Unlike
+ * MatchingStats, which is aggregated per rank profile, this is kept
+ * per query so that expensive queries can be identified.
+ **/
+struct QueryResourceUsage
+{
+    /**
+     * Resources used by a single match thread.
+     **/
+    struct Thread {
+        double cpu_time_s;
+        double setup_time_s;
+        size_t stash_bytes;
+        Thread() : cpu_time_s(0.0), setup_time_s(0.0), stash_bytes(0) {}
+    };
+
+    vespalib::system_time         start_time;
+    vespalib::string              rank_profile;
+    std::vector<vespalib::string> fields;
+    double                        latency_s;
+    double                        query_setup_time_s;
+    size_t                        docs_matched;
+    size_t                        docs_ranked;
+    size_t                        docs_reranked;
+    std::vector<Thread>           threads;
+
+    QueryResourceUsage();
+    QueryResourceUsage(const QueryResourceUsage &);
+    QueryResourceUsage(QueryResourceUsage &&) noexcept;
+    QueryResourceUsage & operator = (const QueryResourceUsage &);
+    QueryResourceUsage & operator = (QueryResourceUsage &&) noexcept;
+    ~QueryResourceUsage();
+
+    double cpu_time_s() const;
+    double setup_time_s() const;
+    size_t stash_bytes() const;
+
+    void toSlime(vespalib::slime::Cursor &object) const;
+};
+
+}
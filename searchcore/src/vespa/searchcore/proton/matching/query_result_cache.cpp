@@ -0,0 +1,129 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+class PropertiesSerializer : public IPropertiesVisitor {
+    vespalib::nbostream &_os;
+public:
+    explicit PropertiesSerializer(vespalib::nbostream &os) : _os(os) {}
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        _os << key << values.size();
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            _os << values.getAt(i);
+        }
+    }
+};
+
+void serializeProperties(vespalib::nbostream &os, const Properties &props) {
+    os << props.numKeys();
+    PropertiesSerializer serializer(os);
+    props.visitProperties(serializer);
+}
+
+}
+
+QueryResultCache::QueryResultCache(size_t maxEntries)
+    : _lock(),
+      _maxEntries(maxEntries),
+      _cache(maxEntries),
+      _generation(0),
+      _stats()
+{
+}
+
+QueryResultCache::~QueryResultCache() = default;
+
+bool
+QueryResultCache::isCacheable(const SearchRequest &request)
+{
+    return request.groupSpec.empty() && request.sessionId.empty() &&
+           (request.getTraceLevel() == 0) && !request.dumpFeatures;
+}
+
+vespalib::string
+QueryResultCache::makeKey(const SearchRequest &request)
+{
+    vespalib::nbostream os;
+    os << request.ranking << request.getStackRef() << request.location << request.sortSpec
+       << request.offset << request.maxhits;
+    serializeProperties(os, request.propertiesMap.rankProperties());
+    serializeProperties(os, request.propertiesMap.featureOverrides());
+    return vespalib::string(os.peek(), os.size());
+}
+
+bool
+QueryResultCache::adjustGeneration(uint64_t generation)
+{
+    if (generation < _generation) {
+        // Request started before the last observed change
+        return false;
+    }
+    if (generation > _generation) {
+        _stats.invalidations += _cache.size();
+        Cache empty(_maxEntries);
+        _cache.swap(empty);
+        _generation = generation;
+    }
+    return true;
+}
+
+std::unique_ptr<QueryResultCache::SearchReply>
+QueryResultCache::lookup(const vespalib::string &key, uint64_t generation)
+{
+    std::shared_ptr<const SearchReply> reply;
+    {
+        std::lock_guard guard(_lock);
+        if (adjustGeneration(generation)) {
+            auto *found = _cache.findAndRef(key);
+            if (found != nullptr) {
+                reply = *found;
+            }
+        }
+        if (reply) {
+            ++_stats.hits;
+        } else {
+            ++_stats.misses;
+        }
+    }
+    return reply ? std::make_unique<SearchReply>(*reply) : std::unique_ptr<SearchReply>();
+}
+
+void
+QueryResultCache::insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply)
+{
+    auto copy = std::make_shared<const SearchReply>(reply);
+    std::lock_guard guard(_lock);
+    if (adjustGeneration(generation)) {
+        _cache[key] = std::move(copy);
+    }
+}
+
+size_t
+QueryResultCache::size() const
+{
+    std::lock_guard guard(_lock);
+    return _cache.size();
+}
+
+QueryResultCache::Stats
+QueryResultCache::takeStats()
+{
+    std::lock_guard guard(_lock);
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
+
+}
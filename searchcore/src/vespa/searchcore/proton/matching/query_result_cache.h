@@ -0,0 +1,79 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+
+namespace search::engine {
+    class SearchReply;
+    class SearchRequest;
+}
+
+namespace proton::matching {
+
+/**
+ * Opt-in cache of search replies for a single rank profile. Replies
+ * are keyed on the serialized query tree and everything else in the
+ * request affecting which hits are returned and how they are ranked.
+ *
+ * All entries belong to a single visibility generation (see
+ * ISearchContext::getVisibilityGeneration). Observing a newer
+ * generation invalidates all cached replies, so a cached reply is only
+ * returned until the next time the visible documents changed.
+ **/
+class QueryResultCache
+{
+public:
+    using SearchReply = search::engine::SearchReply;
+    using SearchRequest = search::engine::SearchRequest;
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t invalidations;
+        Stats() : hits(0), misses(0), invalidations(0) {}
+    };
+
+private:
+    using Cache = vespalib::lrucache_map<vespalib::LruParam<vespalib::string, std::shared_ptr<const SearchReply>>>;
+
+    mutable std::mutex _lock;
+    const size_t       _maxEntries;
+    Cache              _cache;
+    uint64_t           _generation;
+    Stats              _stats;
+
+    bool adjustGeneration(uint64_t generation);
+
+public:
+    explicit QueryResultCache(size_t maxEntries);
+    ~QueryResultCache();
+
+    /**
+     * Returns true if the reply to the given request may be cached.
+     * Grouping, session caching, tracing and feature dumping all give
+     * replies with content not kept by this cache.
+     **/
+    static bool isCacheable(const SearchRequest &request);
+
+    static vespalib::string makeKey(const SearchRequest &request);
+
+    /**
+     * Returns a copy of the reply cached for the given key, or an
+     * empty pointer if none is cached at the given generation.
+     **/
+    std::unique_ptr<SearchReply> lookup(const vespalib::string &key, uint64_t generation);
+    void insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply);
+
+    size_t size() const;
+
+    /**
+     * Observe and reset the hit, miss and invalidation counts.
+     **/
+    Stats takeStats();
+};
+
+}
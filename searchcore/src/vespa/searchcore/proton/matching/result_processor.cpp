@@ -79,6 +79,12 @@ ResultProcessor::ResultProcessor(IAttributeContext &attrContext,
 
 ResultProcessor::~ResultProcessor() = default;
 
+bool
+ResultProcessor::onlyUsesBestRankedHits() const
+{
+    return (_groupingContext.empty() && _sortSpec.empty());
+}
+
 void
 ResultProcessor::prepareThreadContextCreation(size_t num_threads)
 {
@@ -100,6 +100,13 @@ public:
                     size_t offset, size_t hits);
     ~ResultProcessor();
 
+    /**
+     * Returns true if the rank scores of matched hits are only used to
+     * select the best ranked hits, that is, there is neither grouping
+     * nor sorting involved.
+     **/
+    bool onlyUsesBestRankedHits() const;
+
     size_t countFS4Hits();
     void prepareThreadContextCreation(size_t num_threads);
     Context::UP createThreadContext(const vespalib::Doom & hardDoom, size_t thread_id, uint32_t distributionKey);
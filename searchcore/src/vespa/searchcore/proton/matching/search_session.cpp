@@ -2,6 +2,8 @@
 #include "search_session.h"
 #include "match_tools.h"
 #include "match_context.h"
+#include <vespa/searchlib/common/featureset.h>
+#include <algorithm>
 
 namespace proton::matching {
 
@@ -12,10 +14,33 @@ SearchSession::SearchSession(const SessionId &id, vespalib::steady_time create_t
       _create_time(create_time),
       _time_of_doom(time_of_doom),
       _owned_objects(std::move(owned_objects)),
-      _match_tools_factory(std::move(match_tools_factory))
+      _match_tools_factory(std::move(match_tools_factory)),
+      _summary_features_lock(),
+      _summary_features_docs(),
+      _summary_features()
 {
 }
 
+std::shared_ptr<const search::FeatureSet>
+SearchSession::get_summary_features(const std::vector<uint32_t> &docs) const
+{
+    std::lock_guard<std::mutex> guard(_summary_features_lock);
+    if (_summary_features &&
+        std::includes(_summary_features_docs.begin(), _summary_features_docs.end(), docs.begin(), docs.end()))
+    {
+        return _summary_features;
+    }
+    return {};
+}
+
+void
+SearchSession::set_summary_features(const std::vector<uint32_t> &docs, std::shared_ptr<const search::FeatureSet> features)
+{
+    std::lock_guard<std::mutex> guard(_summary_features_lock);
+    _summary_features_docs = docs;
+    _summary_features = std::move(features);
+}
+
 void
 SearchSession::releaseEnumGuards() {
     _owned_objects.context->releaseEnumGuards();
@@ -7,7 +7,10 @@
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/time.h>
 #include <memory>
+#include <mutex>
+#include <vector>
 
+namespace search { class FeatureSet; }
 namespace search::fef { class Properties; }
 
 namespace proton::matching {
@@ -39,6 +42,9 @@ private:
     vespalib::steady_time _time_of_doom;
     OwnershipBundle       _owned_objects;
     std::unique_ptr<MatchToolsFactory> _match_tools_factory;
+    mutable std::mutex    _summary_features_lock;
+    std::vector<uint32_t> _summary_features_docs;
+    std::shared_ptr<const search::FeatureSet> _summary_features;
 
 public:
     typedef std::shared_ptr<SearchSession> SP;
@@ -62,6 +68,19 @@ public:
     vespalib::steady_time getTimeOfDoom() const { return _time_of_doom; }
 
     MatchToolsFactory &getMatchToolsFactory() { return *_match_tools_factory; }
+
+    /**
+     * Summary features calculated for an earlier docsum request
+     * against this session, if they were calculated for all the given
+     * (sorted) docs. Otherwise nullptr is returned.
+     */
+    std::shared_ptr<const search::FeatureSet> get_summary_features(const std::vector<uint32_t> &docs) const;
+
+    /**
+     * Remember summary features calculated for the given (sorted)
+     * docs, to be reused by later docsum requests.
+     */
+    void set_summary_features(const std::vector<uint32_t> &docs, std::shared_ptr<const search::FeatureSet> features);
 };
 
 }
@@ -13,6 +13,7 @@ namespace proton::matching {
 namespace {
 
 const vespalib::string SEARCH = "search";
+const vespalib::string SLOW_QUERIES = "slow_queries";
 
 class SearchSessionExplorer : public vespalib::StateExplorer
 {
@@ -37,6 +38,26 @@ public:
     }
 };
 
+class SlowQueryLogExplorer : public vespalib::StateExplorer
+{
+private:
+    const SlowQueryLog &_log;
+
+public:
+    SlowQueryLogExplorer(const SlowQueryLog &log) : _log(log) {}
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override {
+        Cursor &state = inserter.insertObject();
+        std::vector<QueryResourceUsage> entries = _log.getEntries();
+        state.setLong("numQueries", entries.size());
+        if (full) {
+            Cursor &array = state.setArray("queries");
+            for (const auto &entry : entries) {
+                entry.toSlime(array.addObject());
+            }
+        }
+    }
+};
+
 } // namespace proton::matching::<unnamed>
 
 void
@@ -47,7 +68,7 @@ SessionManagerExplorer::get_state(const Inserter &, bool) const
 std::vector<vespalib::string>
 SessionManagerExplorer::get_children_names() const
 {
-    return std::vector<vespalib::string>({SEARCH});
+    return std::vector<vespalib::string>({SEARCH, SLOW_QUERIES});
 }
 
 std::unique_ptr<StateExplorer>
@@ -56,6 +77,9 @@ SessionManagerExplorer::get_child(vespalib::stringref name) const
     if (name == SEARCH) {
         return std::make_unique<SearchSessionExplorer>(_manager);
     }
+    if (name == SLOW_QUERIES) {
+        return std::make_unique<SlowQueryLogExplorer>(_manager.getSlowQueryLog());
+    }
     return std::unique_ptr<StateExplorer>();
 }
 
@@ -170,7 +170,8 @@ struct SearchSessionCache : public SessionMap<SearchSession> {
 
 SessionManager::SessionManager(uint32_t maxSize)
     : _grouping_cache(std::make_unique<GroupingSessionCache>(maxSize)),
-      _search_map(std::make_unique<SearchSessionCache>()) {
+      _search_map(std::make_unique<SearchSessionCache>()),
+      _slow_query_log(SLOW_QUERY_LOG_SIZE) {
 }
 
 SessionManager::~SessionManager() { }
@@ -3,6 +3,7 @@
 
 #include "search_session.h"
 #include "isessioncachepruner.h"
+#include "slow_query_log.h"
 #include <vespa/searchcore/grouping/groupingsession.h>
 #include <vespa/searchcore/grouping/sessionid.h>
 #include <vespa/vespalib/stllike/lrucache_map.h>
@@ -44,10 +45,12 @@ public:
 private:
     std::unique_ptr<GroupingSessionCache> _grouping_cache;
     std::unique_ptr<SearchSessionCache> _search_map;
+    SlowQueryLog _slow_query_log;
 
 public:
     typedef std::unique_ptr<SessionManager> UP;
     typedef std::shared_ptr<SessionManager> SP;
+    static constexpr size_t SLOW_QUERY_LOG_SIZE = 32;
 
     SessionManager(uint32_t maxSizeGrouping);
     ~SessionManager() override;
@@ -62,6 +65,9 @@ public:
     size_t getNumSearchSessions() const;
     std::vector<SearchSessionInfo> getSortedSearchSessionInfo() const;
 
+    SlowQueryLog &getSlowQueryLog() { return _slow_query_log; }
+    const SlowQueryLog &getSlowQueryLog() const { return _slow_query_log; }
+
     void pruneTimedOutSessions(vespalib::steady_time currentTime) override;
     void close();
 };
@@ -0,0 +1,35 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/common/feature.h>
+#include <atomic>
+#include <cmath>
+
+namespace proton::matching {
+
+/**
+ * A first phase score threshold shared between the match threads of
+ * a single query. Each thread publishes the lowest score among its
+ * own best ranked hits once its hit collector is full. Since every
+ * thread keeps the same number of best ranked hits, a hit scoring
+ * lower than the highest published threshold can never be among the
+ * best ranked hits across all threads. The threshold never decreases.
+ **/
+class SharedScoreThreshold
+{
+private:
+    std::atomic<search::feature_t> _threshold;
+public:
+    SharedScoreThreshold() : _threshold(-HUGE_VAL) {}
+    search::feature_t get() const { return _threshold.load(std::memory_order_relaxed); }
+    void update(search::feature_t threshold) {
+        search::feature_t current = get();
+        while ((threshold > current) &&
+               !_threshold.compare_exchange_weak(current, threshold, std::memory_order_relaxed))
+        {
+        }
+    }
+};
+
+}
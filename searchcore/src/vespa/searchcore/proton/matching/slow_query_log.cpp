@@ -0,0 +1,48 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "slow_query_log.h"
+#include <algorithm>
+
+namespace proton::matching {
+
+SlowQueryLog::SlowQueryLog(size_t maxEntries)
+    : _lock(),
+      _maxEntries(maxEntries),
+      _entries()
+{
+    _entries.reserve(maxEntries + 1);
+}
+
+SlowQueryLog::~SlowQueryLog() = default;
+
+bool
+SlowQueryLog::isSlowEnough(double latency_s) const
+{
+    std::lock_guard guard(_lock);
+    return (_maxEntries > 0) && ((_entries.size() < _maxEntries) || (latency_s > _entries.back().latency_s));
+}
+
+void
+SlowQueryLog::add(QueryResourceUsage usage)
+{
+    std::lock_guard guard(_lock);
+    if ((_maxEntries == 0) || ((_entries.size() == _maxEntries) && (usage.latency_s <= _entries.back().latency_s))) {
+        return;
+    }
+    auto pos = std::upper_bound(_entries.begin(), _entries.end(), usage.latency_s,
+                                [](double latency_s, const QueryResourceUsage &entry)
+                                { return latency_s > entry.latency_s; });
+    _entries.insert(pos, std::move(usage));
+    if (_entries.size() > _maxEntries) {
+        _entries.pop_back();
+    }
+}
+
+std::vector<QueryResourceUsage>
+SlowQueryLog::getEntries() const
+{
+    std::lock_guard guard(_lock);
+    return _entries;
+}
+
+}
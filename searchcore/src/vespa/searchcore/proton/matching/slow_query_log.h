@@ -0,0 +1,34 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "query_resource_usage.h"
+#include <mutex>
+
+namespace proton::matching {
+
+/**
+ * Keeps the resource usage of the N slowest queries seen, used to
+ * find expensive query patterns through the state explorer.
+ **/
+class SlowQueryLog
+{
+private:
+    mutable std::mutex              _lock;
+    const size_t                    _maxEntries;
+    std::vector<QueryResourceUsage> _entries; // sorted on decreasing latency
+
+public:
+    explicit SlowQueryLog(size_t maxEntries);
+    ~SlowQueryLog();
+
+    /**
+     * Returns true if a query with the given latency would be kept,
+     * used to avoid collecting details about queries that are not.
+     **/
+    bool isSlowEnough(double latency_s) const;
+    void add(QueryResourceUsage usage);
+    std::vector<QueryResourceUsage> getEntries() const;
+};
+
+}
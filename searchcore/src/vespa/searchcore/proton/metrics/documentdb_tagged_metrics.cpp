@@ -8,6 +8,13 @@ namespace proton {
 
 using matching::MatchingStats;
 
+namespace {
+
+// query latencies are in seconds, recorded with 10 microsecond resolution
+constexpr double QUERY_LATENCY_RESOLUTION = 0.00001;
+
+}
+
 DocumentDBTaggedMetrics::JobMetrics::JobMetrics(metrics::MetricSet* parent)
     : MetricSet("job", {}, "Job load average for various jobs in a document database", parent),
       attributeFlush("attribute_flush", {}, "Flushing of attribute vector(s) to disk", this),
@@ -99,11 +106,23 @@ DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::ResourceUsageMe
 
 DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::~ResourceUsageMetrics() = default;
 
+DocumentDBTaggedMetrics::IndexMetrics::PostingListCacheMetrics::PostingListCacheMetrics(MetricSet *parent)
+    : MetricSet("posting_list_cache", {}, "Disk index posting list cache metrics", parent),
+      memoryUsage("memory_usage", {}, "Memory usage of the cache (in bytes)", this),
+      elements("elements", {}, "Number of elements in the cache", this),
+      hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
+      lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this)
+{
+}
+
+DocumentDBTaggedMetrics::IndexMetrics::PostingListCacheMetrics::~PostingListCacheMetrics() = default;
+
 DocumentDBTaggedMetrics::IndexMetrics::IndexMetrics(MetricSet *parent)
     : MetricSet("index", {}, "Index metrics (memory and disk) for this document db", parent),
       diskUsage("disk_usage", {}, "Disk space usage in bytes", this),
       memoryUsage(this),
-      docsInMemory("docs_in_memory", {}, "Number of documents in memory index", this)
+      docsInMemory("docs_in_memory", {}, "Number of documents in memory index", this),
+      postingListCache(this)
 {
 }
 
@@ -121,8 +140,9 @@ DocumentDBTaggedMetrics::MatchingMetrics::update(const MatchingStats &stats)
                                       stats.queryCollateralTimeMin(), stats.queryCollateralTimeMax());
     querySetupTime.addValueBatch(stats.querySetupTimeAvg(), stats.querySetupTimeCount(),
                                       stats.querySetupTimeMin(), stats.querySetupTimeMax());
-    queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount(),
-                               stats.queryLatencyMin(), stats.queryLatencyMax());
+    for (double latency : stats.queryLatencySamples()) {
+        queryLatency.addValue(latency);
+    }
 }
 
 DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
@@ -134,7 +154,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
       queryCollateralTime("query_collateral_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
       querySetupTime("query_setup_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
+      queryLatency("query_latency", {}, "Total latency (sec) when matching and ranking a query", QUERY_LATENCY_RESOLUTION, this)
 {
 }
 
@@ -149,6 +169,9 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
+      resultCacheHits("result_cache_hits", {}, "Number of queries answered from the result cache", this),
+      resultCacheMisses("result_cache_misses", {}, "Number of cacheable queries not found in the result cache", this),
+      resultCacheInvalidations("result_cache_invalidations", {}, "Number of cached results dropped because documents became visible or were removed", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
       softDoomFactor("soft_doom_factor", {}, "Factor used to compute soft-timeout", this),
       matchTime("match_time", {}, "Average time (sec) for matching a query (1st phase)", this),
@@ -156,7 +179,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       rerankTime("rerank_time", {}, "Average time (sec) spent on 2nd phase ranking", this),
       queryCollateralTime("query_collateral_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
       querySetupTime("query_setup_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
+      queryLatency("query_latency", {}, "Total latency (sec) when matching and ranking a query", QUERY_LATENCY_RESOLUTION, this)
 {
     softDoomFactor.set(MatchingStats::INITIAL_SOFT_DOOM_FACTOR);
     for (size_t i = 0; i < numDocIdPartitions; ++i) {
@@ -198,6 +221,9 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
     docsReRanked.inc(stats.docsReRanked());
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
+    resultCacheHits.inc(stats.resultCacheHits());
+    resultCacheMisses.inc(stats.resultCacheMisses());
+    resultCacheInvalidations.inc(stats.resultCacheInvalidations());
     softDoomedQueries.inc(stats.softDoomed());
     softDoomFactor.set(stats.softDoomFactor());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
@@ -210,8 +236,9 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
                                       stats.queryCollateralTimeMin(), stats.queryCollateralTimeMax());
     querySetupTime.addValueBatch(stats.querySetupTimeAvg(), stats.querySetupTimeCount(),
                                       stats.querySetupTimeMin(), stats.querySetupTimeMax());
-    queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount(),
-                               stats.queryLatencyMin(), stats.queryLatencyMax());
+    for (double latency : stats.queryLatencySamples()) {
+        queryLatency.addValue(latency);
+    }
     if (stats.getNumPartitions() > 0) {
         if (stats.getNumPartitions() <= partitions.size()) {
             for (size_t i = 0; i < stats.getNumPartitions(); ++i) {
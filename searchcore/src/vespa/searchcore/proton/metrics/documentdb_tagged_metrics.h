@@ -5,6 +5,7 @@
 #include "memory_usage_metrics.h"
 #include "executor_threading_service_metrics.h"
 #include "sessionmanager_metrics.h"
+#include <vespa/metrics/histogrammetric.h>
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/searchcore/proton/matching/matching_stats.h>
@@ -101,9 +102,21 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
 
     struct IndexMetrics : metrics::MetricSet
     {
+        struct PostingListCacheMetrics : metrics::MetricSet
+        {
+            metrics::LongValueMetric memoryUsage;
+            metrics::LongValueMetric elements;
+            metrics::LongAverageMetric hitRate;
+            metrics::LongCountMetric lookups;
+
+            PostingListCacheMetrics(metrics::MetricSet *parent);
+            ~PostingListCacheMetrics() override;
+        };
+
         metrics::LongValueMetric diskUsage;
         MemoryUsageMetrics memoryUsage;
         metrics::LongValueMetric docsInMemory;
+        PostingListCacheMetrics postingListCache;
 
         IndexMetrics(metrics::MetricSet *parent);
         ~IndexMetrics() override;
@@ -117,7 +130,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         metrics::LongCountMetric softDoomedQueries;
         metrics::DoubleAverageMetric queryCollateralTime;
         metrics::DoubleAverageMetric querySetupTime;
-        metrics::DoubleAverageMetric queryLatency;
+        metrics::HistogramMetric queryLatency;
 
         struct RankProfileMetrics : metrics::MetricSet {
             struct DocIdPartition : metrics::MetricSet {
@@ -140,6 +153,9 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     docsReRanked;
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
+            metrics::LongCountMetric     resultCacheHits;
+            metrics::LongCountMetric     resultCacheMisses;
+            metrics::LongCountMetric     resultCacheInvalidations;
             metrics::LongCountMetric     softDoomedQueries;
             metrics::DoubleValueMetric   softDoomFactor;
             metrics::DoubleAverageMetric matchTime;
@@ -147,7 +163,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::DoubleAverageMetric rerankTime;
             metrics::DoubleAverageMetric queryCollateralTime;
             metrics::DoubleAverageMetric querySetupTime;
-            metrics::DoubleAverageMetric queryLatency;
+            metrics::HistogramMetric queryLatency;
             DocIdPartitions              partitions;
 
             RankProfileMetrics(const vespalib::string &name,
@@ -516,19 +516,17 @@ PersistenceEngine::destroyIterator(IteratorId id, Context&)
 }
 
 
-Result
-PersistenceEngine::createBucket(const Bucket &b, Context &)
+void
+PersistenceEngine::createBucketAsync(const Bucket &b, Context &, OperationComplete::UP onComplete)
 {
     ReadGuard rguard(_rwMutex);
-    LOG(spam, "createBucket(%s)", b.toString().c_str());
+    LOG(spam, "createBucketAsync(%s)", b.toString().c_str());
     HandlerSnapshot snap = getHandlerSnapshot(rguard, b.getBucketSpace());
-    TransportLatch latch(snap.size());
+    auto transportContext = std::make_shared<AsyncTranportContext>(snap.size(), std::move(onComplete));
     for (; snap.handlers().valid(); snap.handlers().next()) {
         IPersistenceHandler *handler = snap.handlers().get();
-        handler->handleCreateBucket(feedtoken::make(latch), b);
+        handler->handleCreateBucket(feedtoken::make_shared_owning(transportContext), b);
     }
-    latch.await();
-    return latch.getResult();
 }
 
 
@@ -6,6 +6,7 @@
 #include <vespa/searchcore/proton/common/hw_info_sampler.h>
 #include <vespa/config-bucketspaces.h>
 #include <vespa/searchlib/common/tunefileinfo.hpp>
+#include <vespa/searchlib/common/write_throttle.h>
 #include <vespa/vespalib/io/fileutil.h>
 
 
@@ -22,13 +23,32 @@ using vespa::config::content::core::BucketspacesConfig;
 using document::DocumenttypesConfig;
 using document::DocumentTypeRepoFactory;
 using BucketspacesConfigSP = std::shared_ptr<BucketspacesConfig>;
+using vespalib::compression::CompressionConfig;
 
 namespace proton {
 
+namespace {
+
+CompressionConfig
+deriveCompression(const ProtonConfig::Attribute::Write::Compression &config)
+{
+    CompressionConfig compression;
+    if (config.type == ProtonConfig::Attribute::Write::Compression::Type::LZ4) {
+        compression.type = CompressionConfig::LZ4;
+    } else if (config.type == ProtonConfig::Attribute::Write::Compression::Type::ZSTD) {
+        compression.type = CompressionConfig::ZSTD;
+    }
+    compression.compressionLevel = config.level;
+    return compression;
+}
+
+}
+
 BootstrapConfigManager::BootstrapConfigManager(const vespalib::string & configId)
     : _pendingConfigSnapshot(),
       _configId(configId),
-      _pendingConfigMutex()
+      _pendingConfigMutex(),
+      _attributeWriteThrottle(std::make_shared<search::WriteThrottle>(0))
 { }
 
 BootstrapConfigManager::~BootstrapConfigManager() { }
@@ -84,6 +104,10 @@ BootstrapConfigManager::update(const ConfigSnapshot & snapshot)
         tune._index._indexing._write.setFromConfig<ProtonConfig::Indexing::Write>(conf.indexing.write.io);
         tune._index._indexing._read.setFromConfig<ProtonConfig::Indexing::Read>(conf.indexing.read.io);
         tune._attr._write.setFromConfig<ProtonConfig::Attribute::Write>(conf.attribute.write.io);
+        _attributeWriteThrottle->setMaxBytesPerSecond(conf.attribute.write.maxbytespersecond);
+        _attributeWriteThrottle->setBackoff(conf.attribute.write.backoff.queuedqueries, conf.attribute.write.backoff.factor);
+        tune._attr._throttle = _attributeWriteThrottle;
+        tune._attr._compression = deriveCompression(conf.attribute.write.compression);
         tune._index._search._read.setWantMemoryMap();
         tune._index._search._read.setFromMmapConfig<ProtonConfig::Search::Mmap>(conf.search.mmap);
         tune._summary._write.setFromConfig<ProtonConfig::Summary::Write>(conf.summary.write.io);
@@ -6,6 +6,7 @@
 #include <mutex>
 
 namespace config { class ConfigSnapshot; };
+namespace search { class WriteThrottle; }
 namespace proton {
 
 class BootstrapConfig;
@@ -27,6 +28,7 @@ private:
     std::shared_ptr<BootstrapConfig> _pendingConfigSnapshot;
     vespalib::string                 _configId;
     mutable std::mutex               _pendingConfigMutex;
+    std::shared_ptr<search::WriteThrottle> _attributeWriteThrottle;
 };
 
 } // namespace proton
@@ -131,6 +131,8 @@ BucketMoveJob::moveDocuments(DocumentBucketMover &mover,
     assert(mover.getBucket() == bucketGuard->getBucket());
     mover.moveDocuments(maxDocsToMove);
     if (mover.bucketDone()) {
+        LOG(debug, "moveDocuments(): bucket(%s) done, %zu documents moved from sub db %u",
+            mover.getBucket().toString().c_str(), mover.getDocsMoved(), mover.getSource()->sub_db_id());
         _modifiedHandler.notifyBucketModified(mover.getBucket());
     }
 }
@@ -161,7 +163,8 @@ BucketMoveJob(const IBucketStateCalculator::SP &calc,
               IDiskMemUsageNotifier &diskMemUsageNotifier,
               const BlockableMaintenanceJobConfig &blockableConfig,
               const vespalib::string &docTypeName,
-              document::BucketSpace bucketSpace)
+              document::BucketSpace bucketSpace,
+              uint32_t maxDocsToMove)
     : BlockableMaintenanceJob("move_buckets." + docTypeName, vespalib::duration::zero(), vespalib::duration::zero(), blockableConfig),
       IClusterStateChangedHandler(),
       IBucketFreezeListener(),
@@ -186,7 +189,8 @@ BucketMoveJob(const IBucketStateCalculator::SP &calc,
       _delayedMover(*_moveOpsLimiter),
       _clusterStateChangedNotifier(clusterStateChangedNotifier),
       _bucketStateChangedNotifier(bucketStateChangedNotifier),
-      _diskMemUsageNotifier(diskMemUsageNotifier)
+      _diskMemUsageNotifier(diskMemUsageNotifier),
+      _maxDocsToMove(std::max(1u, maxDocsToMove))
 {
     if (blockedDueToClusterState(_calc)) {
         setBlocked(BlockedReason::CLUSTER_STATE);
@@ -334,7 +338,7 @@ BucketMoveJob::run()
     if (isBlocked()) {
         return true; // indicate work is done, since node state is bad
     }
-    scanAndMove(200, 1);
+    scanAndMove(200, _maxDocsToMove);
     if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
         return true;
     }
@@ -105,6 +105,8 @@ private:
     IClusterStateChangedNotifier      &_clusterStateChangedNotifier;
     IBucketStateChangedNotifier       &_bucketStateChangedNotifier;
     IDiskMemUsageNotifier             &_diskMemUsageNotifier;
+    // Max documents moved from the current bucket per job run, fetched and fed as one batch.
+    uint32_t                           _maxDocsToMove;
 
     ScanResult
     scanBuckets(size_t maxBucketsToScan,
@@ -149,7 +151,8 @@ public:
                   IDiskMemUsageNotifier &diskMemUsageNotifier,
                   const BlockableMaintenanceJobConfig &blockableConfig,
                   const vespalib::string &docTypeName,
-                  document::BucketSpace bucketSpace);
+                  document::BucketSpace bucketSpace,
+                  uint32_t maxDocsToMove);
 
     virtual ~BucketMoveJob();
 
@@ -5,6 +5,7 @@
 #include "document_meta_store_read_guards.h"
 #include "document_subdb_collection_explorer.h"
 #include "maintenance_controller_explorer.h"
+#include <vespa/searchcore/proton/attribute/attribute_load_progress.h>
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_explorer.h>
 #include <vespa/searchcore/proton/matching/session_manager_explorer.h>
@@ -31,6 +32,18 @@ DocumentDBExplorer::get_state(const Inserter &inserter, bool full) const
     {
         StateReporterUtils::convertToSlime(*_docDb->reportStatus(), ObjectInserter(object, "status"));
     }
+    {
+        const AttributeLoadProgress &progress = _docDb->getDocumentSubDBs().getAttributeLoadProgress();
+        if (progress.getLoaded() < progress.getRegistered()) {
+            Cursor &attributeLoad = object.setObject("attributeLoad");
+            attributeLoad.setLong("registered", progress.getRegistered());
+            attributeLoad.setLong("loaded", progress.getLoaded());
+            Cursor &loading = attributeLoad.setArray("loading");
+            for (const auto &name : progress.getLoading()) {
+                loading.addString(name);
+            }
+        }
+    }
     {
         DocumentMetaStoreReadGuards dmss(_docDb->getDocumentSubDBs());
         Cursor &documents = object.setObject("documents");
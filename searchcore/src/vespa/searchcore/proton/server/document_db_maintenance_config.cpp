@@ -56,7 +56,9 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig()
       _remove_batch_block_rate(0.5),
       _remove_block_rate(100),
       _disabled(false),
-      _maxDocsToScan(10000)
+      _maxDocsToScan(10000),
+      _maxDocsToMove(1),
+      _maxMoveLatency(vespalib::duration::zero())
 {
 }
 
@@ -66,7 +68,9 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(vespalib:
                                                                        double remove_batch_block_rate,
                                                                        double remove_block_rate,
                                                                        bool disabled,
-                                                                       uint32_t maxDocsToScan)
+                                                                       uint32_t maxDocsToScan,
+                                                                       uint32_t maxDocsToMove,
+                                                                       vespalib::duration maxMoveLatency)
     : _delay(std::min(MAX_DELAY_SEC, interval)),
       _interval(interval),
       _allowedLidBloat(allowedLidBloat),
@@ -74,7 +78,9 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(vespalib:
       _remove_batch_block_rate(remove_batch_block_rate),
       _remove_block_rate(remove_block_rate),
       _disabled(disabled),
-      _maxDocsToScan(maxDocsToScan)
+      _maxDocsToScan(maxDocsToScan),
+      _maxDocsToMove(std::max(1u, maxDocsToMove)),
+      _maxMoveLatency(maxMoveLatency)
 {
 }
 
@@ -93,10 +99,28 @@ DocumentDBLidSpaceCompactionConfig::operator==(const DocumentDBLidSpaceCompactio
            _interval == rhs._interval &&
            _allowedLidBloat == rhs._allowedLidBloat &&
            _allowedLidBloatFactor == rhs._allowedLidBloatFactor &&
-           _disabled == rhs._disabled;
+           _disabled == rhs._disabled &&
+           _maxDocsToMove == rhs._maxDocsToMove &&
+           _maxMoveLatency == rhs._maxMoveLatency;
 }
 
 
+DocumentDBBucketMoveConfig::DocumentDBBucketMoveConfig()
+    : _maxDocsToMove(1)
+{
+}
+
+DocumentDBBucketMoveConfig::DocumentDBBucketMoveConfig(uint32_t maxDocsToMove)
+    : _maxDocsToMove(std::max(1u, maxDocsToMove))
+{
+}
+
+bool
+DocumentDBBucketMoveConfig::operator==(const DocumentDBBucketMoveConfig &rhs) const
+{
+    return _maxDocsToMove == rhs._maxDocsToMove;
+}
+
 BlockableMaintenanceJobConfig::BlockableMaintenanceJobConfig()
     : _resourceLimitFactor(1.0),
       _maxOutstandingMoveOps(10)
@@ -124,7 +148,8 @@ DocumentDBMaintenanceConfig::DocumentDBMaintenanceConfig()
       _attributeUsageFilterConfig(),
       _attributeUsageSampleInterval(60s),
       _blockableJobConfig(),
-      _flushConfig()
+      _flushConfig(),
+      _bucketMove()
 {
 }
 
@@ -139,7 +164,8 @@ DocumentDBMaintenanceConfig(const DocumentDBPruneRemovedDocumentsConfig &pruneRe
                             const AttributeUsageFilterConfig &attributeUsageFilterConfig,
                             vespalib::duration attributeUsageSampleInterval,
                             const BlockableMaintenanceJobConfig &blockableJobConfig,
-                            const DocumentDBFlushConfig &flushConfig)
+                            const DocumentDBFlushConfig &flushConfig,
+                            const DocumentDBBucketMoveConfig &bucketMove)
     : _pruneRemovedDocuments(pruneRemovedDocuments),
       _heartBeat(heartBeat),
       _sessionCachePruneInterval(groupingSessionPruneInterval),
@@ -148,7 +174,8 @@ DocumentDBMaintenanceConfig(const DocumentDBPruneRemovedDocumentsConfig &pruneRe
       _attributeUsageFilterConfig(attributeUsageFilterConfig),
       _attributeUsageSampleInterval(attributeUsageSampleInterval),
       _blockableJobConfig(blockableJobConfig),
-      _flushConfig(flushConfig)
+      _flushConfig(flushConfig),
+      _bucketMove(bucketMove)
 {
 }
 
@@ -164,7 +191,8 @@ operator==(const DocumentDBMaintenanceConfig &rhs) const
         _attributeUsageFilterConfig == rhs._attributeUsageFilterConfig &&
         _attributeUsageSampleInterval == rhs._attributeUsageSampleInterval &&
         _blockableJobConfig == rhs._blockableJobConfig &&
-        _flushConfig == rhs._flushConfig;
+        _flushConfig == rhs._flushConfig &&
+        _bucketMove == rhs._bucketMove;
 }
 
 } // namespace proton
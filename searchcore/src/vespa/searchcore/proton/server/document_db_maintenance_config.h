@@ -51,6 +51,8 @@ private:
     double               _remove_block_rate;
     bool                 _disabled;
     uint32_t             _maxDocsToScan;
+    uint32_t             _maxDocsToMove;
+    vespalib::duration   _maxMoveLatency;
 
 public:
     DocumentDBLidSpaceCompactionConfig();
@@ -60,7 +62,9 @@ public:
                                        double remove_batch_block_rate,
                                        double remove_block_rate,
                                        bool disabled,
-                                       uint32_t maxDocsToScan = 10000);
+                                       uint32_t maxDocsToScan = 10000,
+                                       uint32_t maxDocsToMove = 1,
+                                       vespalib::duration maxMoveLatency = vespalib::duration::zero());
 
     static DocumentDBLidSpaceCompactionConfig createDisabled();
     bool operator==(const DocumentDBLidSpaceCompactionConfig &rhs) const;
@@ -72,6 +76,21 @@ public:
     double get_remove_block_rate() const { return _remove_block_rate; }
     bool isDisabled() const { return _disabled; }
     uint32_t getMaxDocsToScan() const { return _maxDocsToScan; }
+    uint32_t getMaxDocsToMove() const { return _maxDocsToMove; }
+    vespalib::duration getMaxMoveLatency() const { return _maxMoveLatency; }
+};
+
+class DocumentDBBucketMoveConfig
+{
+private:
+    uint32_t _maxDocsToMove;
+
+public:
+    DocumentDBBucketMoveConfig();
+    DocumentDBBucketMoveConfig(uint32_t maxDocsToMove);
+
+    bool operator==(const DocumentDBBucketMoveConfig &rhs) const;
+    uint32_t getMaxDocsToMove() const { return _maxDocsToMove; }
 };
 
 class BlockableMaintenanceJobConfig {
@@ -103,6 +122,7 @@ private:
     vespalib::duration                    _attributeUsageSampleInterval;
     BlockableMaintenanceJobConfig         _blockableJobConfig;
     DocumentDBFlushConfig                 _flushConfig;
+    DocumentDBBucketMoveConfig            _bucketMove;
 
 public:
     DocumentDBMaintenanceConfig();
@@ -114,7 +134,8 @@ public:
                                 const AttributeUsageFilterConfig &attributeUsageFilterConfig,
                                 vespalib::duration attributeUsageSampleInterval,
                                 const BlockableMaintenanceJobConfig &blockableJobConfig,
-                                const DocumentDBFlushConfig &flushConfig);
+                                const DocumentDBFlushConfig &flushConfig,
+                                const DocumentDBBucketMoveConfig &bucketMove);
 
     DocumentDBMaintenanceConfig(const DocumentDBMaintenanceConfig &) = delete;
     DocumentDBMaintenanceConfig & operator = (const DocumentDBMaintenanceConfig &) = delete;
@@ -149,6 +170,7 @@ public:
         return _blockableJobConfig;
     }
     const DocumentDBFlushConfig &getFlushConfig() const { return _flushConfig; }
+    const DocumentDBBucketMoveConfig &getBucketMoveConfig() const { return _bucketMove; }
 };
 
 } // namespace proton
@@ -8,6 +8,7 @@
 #include <vespa/searchcore/proton/feedoperation/moveoperation.h>
 #include <vespa/searchcore/proton/persistenceengine/i_document_retriever.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <map>
 
 using document::BucketId;
 using document::Document;
@@ -19,27 +20,6 @@ namespace proton {
 
 typedef IDocumentMetaStore::Iterator Iterator;
 
-void
-DocumentBucketMover::moveDocument(DocumentIdT lid,
-                                  const document::GlobalId &gid,
-                                  Timestamp timestamp)
-{
-    Document::SP doc(_source->retriever()->getFullDocument(lid).release());
-    if (!doc || doc->getId().getGlobalId() != gid)
-        return; // Failed to retrieve document, removed or changed identity
-    // TODO(geirst): what if doc is NULL?
-    BucketId bucketId = _bucket.stripUnused();
-    MoveOperation op(bucketId, timestamp, doc, DbDocumentId(_source->sub_db_id(), lid), _targetSubDbId);
-
-    // We cache the bucket for the document we are going to move to avoid getting
-    // inconsistent bucket info (getBucketInfo()) while moving between ready and not-ready
-    // sub dbs as the bucket info is not updated atomically in this case.
-    _bucketDb->takeGuard()->cacheBucket(bucketId);
-    _handler->handleMove(op, _limiter.beginOperation());
-    _bucketDb->takeGuard()->uncacheBucket();
-}
-
-
 DocumentBucketMover::DocumentBucketMover(IMoveOperationLimiter &limiter)
     : _limiter(limiter),
       _bucket(),
@@ -49,7 +29,8 @@ DocumentBucketMover::DocumentBucketMover(IMoveOperationLimiter &limiter)
       _bucketDb(nullptr),
       _bucketDone(true),
       _lastGid(),
-      _lastGidValid(false)
+      _lastGidValid(false),
+      _docsMoved(0)
 { }
 
 
@@ -68,29 +49,66 @@ DocumentBucketMover::setupForBucket(const BucketId &bucket,
     _bucketDone = false;
     _lastGid = GlobalId();
     _lastGidValid = false;
+    _docsMoved = 0;
 }
 
 
 namespace
 {
 
-class MoveKey
+/**
+ * Collects the documents fetched in a single bulk read from the source document store.
+ */
+class MoveDocumentCollector : public search::IDocumentVisitor
 {
 public:
-    DocumentIdT _lid;
-    document::GlobalId _gid;
-    Timestamp _timestamp;
-
-    MoveKey(DocumentIdT lid,
-            const document::GlobalId &gid,
-            Timestamp timestamp)
-        : _lid(lid),
-          _gid(gid),
-          _timestamp(timestamp)
-    {
+    std::map<DocumentIdT, Document::UP> _docs;
+
+    MoveDocumentCollector() : _docs() {}
+    ~MoveDocumentCollector() override;
+    void visit(uint32_t lid, Document::UP doc) override {
+        if (doc) {
+            _docs[lid] = std::move(doc);
+        }
     }
+    bool allowVisitCaching() const override { return false; }
 };
 
+MoveDocumentCollector::~MoveDocumentCollector() = default;
+
+}
+
+void
+DocumentBucketMover::moveBatch(const std::vector<MoveKey> &toMove)
+{
+    if (toMove.empty()) {
+        return;
+    }
+    IDocumentRetriever::LidVector lids;
+    lids.reserve(toMove.size());
+    for (const MoveKey &key : toMove) {
+        lids.push_back(key._lid);
+    }
+    // Fetch all documents in one go, letting the document store share chunk reads between them.
+    MoveDocumentCollector collector;
+    _source->retriever()->visitDocuments(lids, collector, storage::spi::ReadConsistency::STRONG);
+    BucketId bucketId = _bucket.stripUnused();
+
+    // We cache the bucket for the documents we are going to move to avoid getting
+    // inconsistent bucket info (getBucketInfo()) while moving between ready and not-ready
+    // sub dbs as the bucket info is not updated atomically in this case.
+    _bucketDb->takeGuard()->cacheBucket(bucketId);
+    for (const MoveKey &key : toMove) {
+        auto itr = collector._docs.find(key._lid);
+        if (itr == collector._docs.end() || itr->second->getId().getGlobalId() != key._gid) {
+            continue; // Failed to retrieve document, removed or changed identity
+        }
+        Document::SP doc(std::move(itr->second));
+        MoveOperation op(bucketId, key._timestamp, doc, DbDocumentId(_source->sub_db_id(), key._lid), _targetSubDbId);
+        _handler->handleMove(op, _limiter.beginOperation());
+        ++_docsMoved;
+    }
+    _bucketDb->takeGuard()->uncacheBucket();
 }
 
 void DocumentBucketMover::setBucketDone() {
@@ -108,8 +126,7 @@ DocumentBucketMover::moveDocuments(size_t maxDocsToMove)
     const Iterator end = _source->meta_store()->upperBound(_bucket);
     size_t docsMoved = 0;
     size_t docsSkipped = 0; // In absence of a proper cost metric
-    typedef std::vector<MoveKey> MoveVec;
-    MoveVec toMove;
+    std::vector<MoveKey> toMove;
     for (; itr != end && docsMoved < maxDocsToMove; ++itr) {
         DocumentIdT lid = itr.getKey();
         const RawDocumentMetaData &metaData = _source->meta_store()->getRawMetaData(lid);
@@ -120,7 +137,6 @@ DocumentBucketMover::moveDocuments(size_t maxDocsToMove)
                 docsSkipped = 0;
             }
         } else {
-            // moveDocument(lid, metaData.getTimestamp());
             toMove.push_back(MoveKey(lid, metaData.getGid(), metaData.getTimestamp()));
             ++docsMoved;
         }
@@ -130,9 +146,7 @@ DocumentBucketMover::moveDocuments(size_t maxDocsToMove)
     if (itr == end) {
         setBucketDone();
     }
-    for (const MoveKey & key : toMove) {
-        moveDocument(key._lid, key._gid, key._timestamp);
-    }
+    moveBatch(toMove);
 }
 
 
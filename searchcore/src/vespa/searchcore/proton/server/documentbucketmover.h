@@ -7,6 +7,7 @@
 #include <vespa/searchlib/query/base.h>
 #include <persistence/spi/types.h>
 #include "ifrozenbuckethandler.h"
+#include <vector>
 
 namespace proton {
 
@@ -23,6 +24,19 @@ class MaintenanceDocumentSubDB;
 class DocumentBucketMover
 {
 private:
+    struct MoveKey
+    {
+        search::DocumentIdT     _lid;
+        document::GlobalId      _gid;
+        storage::spi::Timestamp _timestamp;
+
+        MoveKey(search::DocumentIdT lid, const document::GlobalId &gid, storage::spi::Timestamp timestamp)
+            : _lid(lid),
+              _gid(gid),
+              _timestamp(timestamp)
+        { }
+    };
+
     IMoveOperationLimiter          &_limiter;
     document::BucketId              _bucket;
     const MaintenanceDocumentSubDB *_source;
@@ -32,10 +46,14 @@ private:
     bool                            _bucketDone;
     document::GlobalId              _lastGid;
     bool                            _lastGidValid;
+    size_t                          _docsMoved;
 
-    void moveDocument(search::DocumentIdT lid,
-                      const document::GlobalId &gid,
-                      storage::spi::Timestamp timestamp);
+    /**
+     * Moves the given documents as one batch. The documents are fetched with a
+     * single bulk read from the source sub database, and the bucket is cached
+     * in the bucket db while the whole batch is handed to the move handler.
+     */
+    void moveBatch(const std::vector<MoveKey> &toMove);
 
     void setBucketDone();
 public:
@@ -49,6 +67,10 @@ public:
     void moveDocuments(size_t maxDocsToMove);
     void cancel() { setBucketDone(); }
     bool bucketDone() const { return _bucketDone; }
+    /**
+     * Returns the number of documents moved from the current bucket so far.
+     */
+    size_t getDocsMoved() const { return _docsMoved; }
     const MaintenanceDocumentSubDB * getSource() const { return _source; }
 };
 
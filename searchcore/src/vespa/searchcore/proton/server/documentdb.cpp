@@ -15,6 +15,7 @@
 #include <vespa/searchcore/proton/persistenceengine/commit_and_wait_document_retriever.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/searchcore/proton/attribute/attribute_config_inspector.h>
+#include <vespa/searchcore/proton/attribute/attribute_load_progress.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
@@ -76,17 +77,20 @@ makeGrowStrategy(uint32_t docsInitialCapacity, const Allocation &allocCfg)
 }
 
 DocumentSubDBCollection::Config
-makeSubDBConfig(const ProtonConfig::Distribution & distCfg, const Allocation & allocCfg, size_t numSearcherThreads) {
+makeSubDBConfig(const ProtonConfig::Distribution & distCfg, const Allocation & allocCfg,
+                const ProtonConfig::Summary::Cache & cacheCfg, size_t numSearcherThreads) {
     size_t initialNumDocs(allocCfg.initialnumdocs);
     GrowStrategy searchableGrowth = makeGrowStrategy(initialNumDocs * distCfg.searchablecopies, allocCfg);
     GrowStrategy removedGrowth = makeGrowStrategy(std::max(1024ul, initialNumDocs/100), allocCfg);
     GrowStrategy notReadyGrowth = makeGrowStrategy(initialNumDocs * (distCfg.redundancy - distCfg.searchablecopies), allocCfg);
-    return DocumentSubDBCollection::Config(searchableGrowth, notReadyGrowth, removedGrowth, allocCfg.amortizecount, numSearcherThreads);
+    return DocumentSubDBCollection::Config(searchableGrowth, notReadyGrowth, removedGrowth, allocCfg.amortizecount,
+                                           numSearcherThreads, std::max(INT64_C(0), cacheCfg.notready.maxbytes));
 }
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return index::IndexConfig(WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), cfg.maxflushed, cfg.cache.size);
+    return index::IndexConfig(WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), cfg.maxflushed,
+                              cfg.cache.size, cfg.postinglistcache.size);
 }
 
 ProtonConfig::Documentdb _G_defaultProtonDocumentDBConfig;
@@ -114,6 +118,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
                        const vespalib::string &tlsSpec,
                        matching::QueryLimiter &queryLimiter,
                        const vespalib::Clock &clock,
+                       const vespalib::eval::ConstantValueFactory &constantValueFactory,
                        const DocTypeName &docTypeName,
                        document::BucketSpace bucketSpace,
                        const ProtonConfig &protonCfg,
@@ -167,10 +172,10 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _feedHandler(std::make_unique<FeedHandler>(_writeService, tlsSpec, docTypeName, *this, _writeFilter, *this, tlsWriterFactory)),
       _visibility(*_feedHandler, _writeService, _feedView),
       _subDBs(*this, *this, *_feedHandler, _docTypeName, _writeService, warmupExecutor, fileHeaderContext,
-              metricsWireService, getMetrics(), queryLimiter, clock, _configMutex, _baseDir,
+              metricsWireService, getMetrics(), queryLimiter, clock, constantValueFactory, _configMutex, _baseDir,
               makeSubDBConfig(protonCfg.distribution,
                               findDocumentDB(protonCfg.documentdb, docTypeName.getName())->allocation,
-                              protonCfg.numsearcherthreads),
+                              protonCfg.summary.cache, protonCfg.numsearcherthreads),
               hwInfo),
       _maintenanceController(_writeService.master(), sharedExecutor, _docTypeName),
       _lidSpaceCompactionHandlers(),
@@ -849,8 +854,16 @@ DocumentDB::reportStatus() const
     }
 
     if (_initGate.getCount() != 0) {
-        return StatusReport::create(params.state(StatusReport::PARTIAL).
-                message("DocumentDB initializing components"));
+        const AttributeLoadProgress &attributeLoadProgress = _subDBs.getAttributeLoadProgress();
+        uint32_t registeredAttributes = attributeLoadProgress.getRegistered();
+        if (registeredAttributes == 0) {
+            return StatusReport::create(params.state(StatusReport::PARTIAL).
+                    message("DocumentDB initializing components"));
+        }
+        float progress = attributeLoadProgress.getProgress() * 100.0f;
+        vespalib::string msg = make_string("DocumentDB initializing components (%u of %u attributes loaded)",
+                                           attributeLoadProgress.getLoaded(), registeredAttributes);
+        return StatusReport::create(params.state(StatusReport::PARTIAL).progress(progress).message(msg));
     } else if (_feedHandler->isDoingReplay()) {
         float progress = _feedHandler->getReplayProgress() * 100.0f;
         vespalib::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done)",
@@ -963,6 +976,7 @@ DocumentDB::injectMaintenanceJobs(const DocumentDBMaintenanceConfig &config, std
             _dmUsageForwarder,
             _jobTrackers,
             _visibility,  // ICommitable
+            *_feedHandler, // IGetSerialNum
             _subDBs.getReadySubDB()->getAttributeManager(),
             _subDBs.getNotReadySubDB()->getAttributeManager(),
             std::move(attribute_config_inspector),
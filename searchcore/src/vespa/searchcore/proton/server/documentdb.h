@@ -43,6 +43,7 @@ namespace search {
     }
 }
 
+namespace vespalib::eval { struct ConstantValueFactory; }
 namespace vespa::config::search::core::internal { class InternalProtonType; }
 
 namespace proton {
@@ -247,6 +248,7 @@ public:
                const vespalib::string &tlsSpec,
                matching::QueryLimiter &queryLimiter,
                const vespalib::Clock &clock,
+               const vespalib::eval::ConstantValueFactory &constantValueFactory,
                const DocTypeName &docTypeName,
                document::BucketSpace bucketSpace,
                const ProtonConfig &protonCfg,
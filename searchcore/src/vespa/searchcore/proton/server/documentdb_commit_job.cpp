@@ -1,20 +1,53 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "documentdb_commit_job.h"
+#include "igetserialnum.h"
 #include <vespa/searchcore/proton/common/icommitable.h>
+#include <algorithm>
 
 namespace proton {
 
-DocumentDBCommitJob::DocumentDBCommitJob(ICommitable & committer, vespalib::duration visibilityDelay) :
-    IMaintenanceJob("documentdb_commit", visibilityDelay, visibilityDelay),
-    _committer(committer)
+namespace {
+
+vespalib::duration
+runInterval(vespalib::duration visibilityDelay)
+{
+    return std::min(visibilityDelay, std::max(visibilityDelay / DocumentDBCommitJob::RUNS_PER_VISIBILITY_DELAY,
+                                              vespalib::duration(1ms)));
+}
+
+}
+
+DocumentDBCommitJob::DocumentDBCommitJob(ICommitable & committer, const IGetSerialNum & getSerialNum,
+                                         vespalib::duration visibilityDelay)
+    : IMaintenanceJob("documentdb_commit", runInterval(visibilityDelay), runInterval(visibilityDelay)),
+      _committer(committer),
+      _getSerialNum(getSerialNum),
+      _visibilityDelay(visibilityDelay),
+      _minCommitInterval(runInterval(visibilityDelay)),
+      _commitInterval(_minCommitInterval),
+      _lastCommitTime(vespalib::steady_clock::now()),
+      _lastCommitSerialNum(getSerialNum.getSerialNum())
 {
 }
 
 bool
 DocumentDBCommitJob::run()
 {
+    vespalib::steady_time now = vespalib::steady_clock::now();
+    search::SerialNum serialNum = _getSerialNum.getSerialNum();
+    vespalib::duration sinceLastCommit = now - _lastCommitTime;
+    if (sinceLastCommit < _visibilityDelay) {
+        if ((serialNum == _lastCommitSerialNum) || (sinceLastCommit < _commitInterval)) {
+            return true;
+        }
+    }
     _committer.commit();
+    vespalib::duration commitCost = vespalib::steady_clock::now() - now;
+    _commitInterval = std::clamp(std::chrono::duration_cast<vespalib::duration>(commitCost / COMMIT_COST_BUDGET),
+                                 _minCommitInterval, _visibilityDelay);
+    _lastCommitTime = now;
+    _lastCommitSerialNum = serialNum;
     return true;
 }
 
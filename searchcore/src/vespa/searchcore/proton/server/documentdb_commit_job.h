@@ -2,24 +2,44 @@
 #pragma once
 
 #include "i_maintenance_job.h"
+#include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/util/time.h>
 
 namespace proton {
 
 class ICommitable;
+class IGetSerialNum;
 
 /**
  * Job that regularly commits the documentdb.
+ *
+ * The job runs several times per visibility delay. When new operations
+ * have been fed it commits as soon as the time since the last commit
+ * exceeds the commit interval, which is adapted so that commits take at
+ * most COMMIT_COST_BUDGET of the master thread. At low feed rates this
+ * makes changes visible well before the visibility delay, while at high
+ * feed rates more operations are coalesced per commit. A commit is always
+ * done when a full visibility delay has passed.
  */
 class DocumentDBCommitJob : public IMaintenanceJob
 {
 private:
-    ICommitable & _committer;
+    ICommitable              & _committer;
+    const IGetSerialNum      & _getSerialNum;
+    const vespalib::duration   _visibilityDelay;
+    const vespalib::duration   _minCommitInterval;
+    vespalib::duration         _commitInterval;
+    vespalib::steady_time      _lastCommitTime;
+    search::SerialNum          _lastCommitSerialNum;
 
 public:
-    DocumentDBCommitJob(ICommitable & committer, vespalib::duration visibilityDelay);
+    static constexpr double COMMIT_COST_BUDGET = 0.1;
+    static constexpr uint32_t RUNS_PER_VISIBILITY_DELAY = 8;
+
+    DocumentDBCommitJob(ICommitable & committer, const IGetSerialNum & getSerialNum, vespalib::duration visibilityDelay);
 
     bool run() override;
+    vespalib::duration getCommitInterval() const { return _commitInterval; }
 };
 
 } // namespace proton
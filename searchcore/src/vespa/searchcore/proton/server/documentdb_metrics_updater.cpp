@@ -40,7 +40,9 @@ DocumentDBMetricsUpdater::DocumentDBMetricsUpdater(const DocumentSubDBCollection
       _writeService(writeService),
       _jobTrackers(jobTrackers),
       _sessionManager(sessionManager),
-      _writeFilter(writeFilter)
+      _writeFilter(writeFilter),
+      _lastDocStoreCacheStats(),
+      _lastPostingListCacheStats()
 {
 }
 
@@ -69,12 +71,31 @@ updateDiskUsageMetric(metrics::LongValueMetric &metric, uint64_t diskUsage, Tota
 }
 
 void
-updateIndexMetrics(DocumentDBTaggedMetrics &metrics, const search::SearchableStats &stats, TotalStats &totalStats)
+updatePostingListCacheMetrics(DocumentDBTaggedMetrics::IndexMetrics::PostingListCacheMetrics &metrics,
+                              const CacheStats &cacheStats, CacheStats &lastCacheStats, TotalStats &totalStats)
+{
+    totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
+    metrics.memoryUsage.set(cacheStats.memory_used);
+    metrics.elements.set(cacheStats.elements);
+    // Statistics restart from zero when disk indexes are replaced after fusion
+    if (cacheStats.lookups() >= lastCacheStats.lookups() && cacheStats.hits >= lastCacheStats.hits) {
+        metrics.hitRate.addTotalValueWithCount(cacheStats.hits - lastCacheStats.hits,
+                                               cacheStats.lookups() - lastCacheStats.lookups());
+        metrics.lookups.inc(cacheStats.lookups() - lastCacheStats.lookups());
+    }
+    lastCacheStats = cacheStats;
+}
+
+void
+updateIndexMetrics(DocumentDBTaggedMetrics &metrics, const search::SearchableStats &stats,
+                   CacheStats &lastPostingListCacheStats, TotalStats &totalStats)
 {
     DocumentDBTaggedMetrics::IndexMetrics &indexMetrics = metrics.index;
     updateDiskUsageMetric(indexMetrics.diskUsage, stats.sizeOnDisk(), totalStats);
     updateMemoryUsageMetrics(indexMetrics.memoryUsage, stats.memoryUsage(), totalStats);
     indexMetrics.docsInMemory.set(stats.docsInMemory());
+    updatePostingListCacheMetrics(indexMetrics.postingListCache, stats.postingListCacheStats(),
+                                  lastPostingListCacheStats, totalStats);
 }
 
 struct TempAttributeMetric
@@ -288,7 +309,7 @@ DocumentDBMetricsUpdater::updateMetrics(DocumentDBTaggedMetrics &metrics)
 {
     TotalStats totalStats;
     ExecutorThreadingServiceStats threadingServiceStats = _writeService.getStats();
-    updateIndexMetrics(metrics, _subDBs.getReadySubDB()->getSearchableStats(), totalStats);
+    updateIndexMetrics(metrics, _subDBs.getReadySubDB()->getSearchableStats(), _lastPostingListCacheStats, totalStats);
     updateAttributeMetrics(metrics, _subDBs, totalStats);
     updateMatchingMetrics(metrics, *_subDBs.getReadySubDB());
     updateSessionCacheMetrics(metrics, _sessionManager);
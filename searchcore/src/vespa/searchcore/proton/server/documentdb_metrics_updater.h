@@ -36,6 +36,8 @@ private:
     const AttributeUsageFilter &_writeFilter;
     // Last updated document store cache statistics. Necessary due to metrics implementation is upside down.
     DocumentStoreCacheStats _lastDocStoreCacheStats;
+    // Last updated disk index posting list cache statistics.
+    search::CacheStats _lastPostingListCacheStats;
 
     void updateMiscMetrics(DocumentDBTaggedMetrics &metrics, const ExecutorThreadingServiceStats &threadingServiceStats);
     void updateAttributeResourceUsageMetrics(DocumentDBTaggedMetrics::AttributeMetrics &metrics);
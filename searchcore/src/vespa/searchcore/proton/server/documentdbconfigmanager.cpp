@@ -141,7 +141,10 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.lidspacecompaction.allowedlidbloatfactor,
                     proton.lidspacecompaction.removebatchblockrate,
                     proton.lidspacecompaction.removeblockrate,
-                    isDocumentTypeGlobal),
+                    isDocumentTypeGlobal,
+                    10000,
+                    proton.lidspacecompaction.maxdocstomove,
+                    vespalib::from_s(proton.lidspacecompaction.maxmovelatency)),
             AttributeUsageFilterConfig(
                     proton.writefilter.attribute.enumstorelimit,
                     proton.writefilter.attribute.multivaluelimit),
@@ -151,7 +154,8 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.maintenancejobs.maxoutstandingmoveops),
             DocumentDBFlushConfig(
                     proton.index.maxflushed,
-                    proton.index.maxflushedretired));
+                    proton.index.maxflushedretired),
+            DocumentDBBucketMoveConfig(proton.bucketmove.maxdocstomove));
 }
 
 template<typename T>
@@ -174,6 +178,8 @@ derive(ProtonConfig::Summary::Cache::UpdateStrategy strategy) {
             return DocumentStore::Config::UpdateStrategy::INVALIDATE;
         case ProtonConfig::Summary::Cache::UpdateStrategy::UPDATE:
             return DocumentStore::Config::UpdateStrategy::UPDATE;
+        case ProtonConfig::Summary::Cache::UpdateStrategy::INSERT:
+            return DocumentStore::Config::UpdateStrategy::INSERT;
     }
     return DocumentStore::Config::UpdateStrategy::INVALIDATE;
 }
@@ -194,14 +200,17 @@ deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::M
     DocumentStore::Config config(getStoreConfig(summary.cache, hwInfo));
     const ProtonConfig::Summary::Log & log(summary.log);
     const ProtonConfig::Summary::Log::Chunk & chunk(log.chunk);
-    WriteableFileChunk::Config fileConfig(deriveCompression(chunk.compression), chunk.maxbytes);
+    WriteableFileChunk::Config fileConfig(deriveCompression(chunk.compression), chunk.maxbytes, chunk.dictionarysize);
     LogDataStore::Config logConfig;
     logConfig.setMaxFileSize(log.maxfilesize)
             .setMaxNumLids(log.maxnumlids)
             .setMaxDiskBloatFactor(std::min(flush.diskbloatfactor, flush.each.diskbloatfactor))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compactCompression(deriveCompression(log.compact.compression))
-            .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
+            .setMaxConcurrentCompactions(log.compact.maxconcurrent)
+            .setMaxCompactionBytesPerSecond(log.compact.maxbytespersecond)
+            .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread)
+            .setChunkCacheBytes(chunk.cache.maxbytes);
     return LogDocumentStore::Config(config, logConfig);
 }
 
@@ -238,29 +238,12 @@ DocumentRetriever::getPartialDocument(search::DocumentIdT lid, const document::D
     if (needFetchFromDocStore(fieldSet)) {
         doc = _doc_store.read(lid, getDocumentTypeRepo());
         if (doc) {
-            populate(lid, *doc);
+            populate(lid, *doc, fieldSet);
             FieldSet::stripFields(*doc, fieldSet);
         }
     } else {
         doc = std::make_unique<Document>(getDocumentType(), docId);
-        switch (fieldSet.getType()) {
-            case FieldSet::Type::ALL:
-                populate(lid, *doc);
-                break;
-            case FieldSet::Type::FIELD: {
-                const auto & field = static_cast<const Field&>(fieldSet);
-                populate(lid, *doc, Field::Set::Builder().add(&field).build());
-                break;
-            }
-            case FieldSet::Type::SET: {
-                const auto &set = static_cast<const document::FieldCollection &>(fieldSet);
-                populate(lid, *doc, set.getFields());
-                break;
-            }
-            case FieldSet::Type::NONE:
-            case FieldSet::Type::DOCID:
-                break;
-        }
+        populate(lid, *doc, fieldSet);
         doc->setRepo(getDocumentTypeRepo());
     }
     return doc;
@@ -275,11 +258,54 @@ DocumentRetriever::visitDocuments(const LidVector & lids, search::IDocumentVisit
 
 void
 DocumentRetriever::populate(DocumentIdT lid, Document & doc) const {
-    populate(lid, doc, _attributeFields);
+    populate(lid, doc, _attributeFields, _possiblePositionFields);
+}
+
+void
+DocumentRetriever::populate(DocumentIdT lid, Document & doc, const FieldSet & fieldSet) const
+{
+    switch (fieldSet.getType()) {
+        case FieldSet::Type::ALL:
+            populate(lid, doc);
+            break;
+        case FieldSet::Type::FIELD: {
+            const auto & field = static_cast<const Field&>(fieldSet);
+            populate(lid, doc, Field::Set::Builder().add(&field).build());
+            break;
+        }
+        case FieldSet::Type::SET: {
+            const auto &set = static_cast<const document::FieldCollection &>(fieldSet);
+            populate(lid, doc, set.getFields());
+            break;
+        }
+        case FieldSet::Type::NONE:
+        case FieldSet::Type::DOCID:
+            break;
+    }
+}
+
+void
+DocumentRetriever::populate(DocumentIdT lid, Document & doc, const Field::Set & wantedFields) const
+{
+    // Only the wanted attribute fields are fetched, as the rest would be stripped from the document anyway.
+    Field::Set::Builder attrBuilder;
+    for (const Field* field : wantedFields) {
+        if (isFieldAttribute(*field)) {
+            attrBuilder.add(field);
+        }
+    }
+    PositionFields positionFields;
+    for (const auto & positionField : _possiblePositionFields) {
+        if (wantedFields.contains(*positionField.first)) {
+            positionFields.push_back(positionField);
+        }
+    }
+    populate(lid, doc, attrBuilder.build(), positionFields);
 }
 
 void
-DocumentRetriever::populate(DocumentIdT lid, Document & doc, const Field::Set & attributeFields) const
+DocumentRetriever::populate(DocumentIdT lid, Document & doc, const Field::Set & attributeFields,
+                            const PositionFields & positionFields) const
 {
     for (const Field* field : attributeFields) {
         AttributeGuard::UP attr = _attr_manager.getAttribute(field->getName());
@@ -289,7 +315,7 @@ DocumentRetriever::populate(DocumentIdT lid, Document & doc, const Field::Set &
             doc.remove(*field);
         }
     }
-    fillInPositionFields(doc, lid, _possiblePositionFields, _attr_manager);
+    fillInPositionFields(doc, lid, positionFields, _attr_manager);
 }
 
 const IAttributeManager *
@@ -49,7 +49,10 @@ public:
     void populate(search::DocumentIdT lid, document::Document & doc) const;
     bool needFetchFromDocStore(const document::FieldSet &) const;
 private:
-    void populate(search::DocumentIdT lid, document::Document & doc, const document::Field::Set & attributeFields) const;
+    void populate(search::DocumentIdT lid, document::Document & doc, const document::FieldSet & fieldSet) const;
+    void populate(search::DocumentIdT lid, document::Document & doc, const document::Field::Set & wantedFields) const;
+    void populate(search::DocumentIdT lid, document::Document & doc, const document::Field::Set & attributeFields,
+                  const PositionFields & positionFields) const;
 
     bool isFieldAttribute(const document::Field & field) const override;
     const search::index::Schema     &_schema;
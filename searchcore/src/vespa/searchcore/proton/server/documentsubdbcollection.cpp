@@ -6,6 +6,7 @@
 #include "i_document_subdb_owner.h"
 #include "maintenancecontroller.h"
 #include "searchabledocsubdb.h"
+#include <vespa/searchcore/proton/attribute/attribute_load_progress.h>
 #include <vespa/searchcore/proton/persistenceengine/commit_and_wait_document_retriever.h>
 #include <vespa/searchcore/proton/metrics/documentdb_tagged_metrics.h>
 #include <vespa/vespalib/util/lambdatask.h>
@@ -20,12 +21,14 @@ using vespalib::makeLambdaTask;
 namespace proton {
 
 DocumentSubDBCollection::Config::Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-                                        size_t fixedAttributeTotalSkew, size_t numSearchThreads)
+                                        size_t fixedAttributeTotalSkew, size_t numSearchThreads,
+                                        size_t notReadyDocumentCacheBytes)
     : _readyGrowth(ready),
       _notReadyGrowth(notReady),
       _removedGrowth(removed),
       _fixedAttributeTotalSkew(fixedAttributeTotalSkew),
-      _numSearchThreads(numSearchThreads)
+      _numSearchThreads(numSearchThreads),
+      _notReadyDocumentCacheBytes(notReadyDocumentCacheBytes)
 { }
 
 DocumentSubDBCollection::DocumentSubDBCollection(
@@ -40,6 +43,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
         DocumentDBTaggedMetrics &metrics,
         matching::QueryLimiter &queryLimiter,
         const vespalib::Clock &clock,
+        const vespalib::eval::ConstantValueFactory &constantValueFactory,
         std::mutex &configMutex,
         const vespalib::string &baseDir,
         const Config & cfg,
@@ -52,6 +56,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
       _notReadySubDbId(2),
       _retrievers(),
       _reprocessingRunner(),
+      _attributeLoadProgress(std::make_shared<AttributeLoadProgress>()),
       _bucketDB(),
       _bucketDBHandler(),
       _hwInfo(hwInfo)
@@ -68,11 +73,12 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                             StoreOnlyDocSubDB::Config(docTypeName, "0.ready", baseDir,
                                     cfg.getReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
                                     _readySubDbId, SubDbType::READY),
-                            true, true, false),
+                            true, true, false, 0),
                     cfg.getNumSearchThreads()),
                 SearchableDocSubDB::Context(
-                        FastAccessDocSubDB::Context(context, metrics.ready.attributes, metricsWireService),
-                        queryLimiter, clock, warmupExecutor)));
+                        FastAccessDocSubDB::Context(context, metrics.ready.attributes, metricsWireService,
+                                                    _attributeLoadProgress),
+                        queryLimiter, clock, constantValueFactory, warmupExecutor)));
 
     _subDBs.push_back
         (new StoreOnlyDocSubDB(
@@ -86,8 +92,9 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                         StoreOnlyDocSubDB::Config(docTypeName, "2.notready", baseDir,
                                 cfg.getNotReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
                                 _notReadySubDbId, SubDbType::NOTREADY),
-                        true, true, true),
-                FastAccessDocSubDB::Context(context, metrics.notReady.attributes, metricsWireService)));
+                        true, true, true, cfg.getNotReadyDocumentCacheBytes()),
+                FastAccessDocSubDB::Context(context, metrics.notReady.attributes, metricsWireService,
+                                            _attributeLoadProgress)));
 }
 
 
@@ -310,6 +317,12 @@ DocumentSubDBCollection::getReprocessingProgress() const
     return _reprocessingRunner.getProgress();
 }
 
+const AttributeLoadProgress &
+DocumentSubDBCollection::getAttributeLoadProgress() const
+{
+    return *_attributeLoadProgress;
+}
+
 void
 DocumentSubDBCollection::close()
 {
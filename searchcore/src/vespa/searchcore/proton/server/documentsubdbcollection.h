@@ -14,6 +14,7 @@ namespace vespalib {
     class Clock;
     class SyncableThreadExecutor;
     class ThreadStackExecutorBase;
+    namespace eval { struct ConstantValueFactory; }
 }
 
 namespace search {
@@ -28,6 +29,7 @@ namespace searchcorespi {
 
 namespace proton {
 
+class AttributeLoadProgress;
 class DocumentDBConfig;
 struct DocumentDBTaggedMetrics;
 class MaintenanceController;
@@ -64,18 +66,20 @@ public:
     public:
         using GrowStrategy = search::GrowStrategy;
         Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-               size_t fixedAttributeTotalSkew, size_t numSearchThreads);
+               size_t fixedAttributeTotalSkew, size_t numSearchThreads, size_t notReadyDocumentCacheBytes);
         GrowStrategy getReadyGrowth() const { return _readyGrowth; }
         GrowStrategy getNotReadyGrowth() const { return _notReadyGrowth; }
         GrowStrategy getRemovedGrowth() const { return _removedGrowth; }
         size_t getNumSearchThreads() const { return _numSearchThreads; }
         size_t getFixedAttributeTotalSkew() const { return _fixedAttributeTotalSkew; }
+        size_t getNotReadyDocumentCacheBytes() const { return _notReadyDocumentCacheBytes; }
     private:
         const GrowStrategy _readyGrowth;
         const GrowStrategy _notReadyGrowth;
         const GrowStrategy _removedGrowth;
         const size_t       _fixedAttributeTotalSkew;
         const size_t       _numSearchThreads;
+        const size_t       _notReadyDocumentCacheBytes;
     };
 
 private:
@@ -93,6 +97,7 @@ private:
     vespalib::VarHolder<RetrieversSP> _retrievers;
     using ReprocessingTasks = std::vector<std::shared_ptr<IReprocessingTask>>;
     ReprocessingRunner _reprocessingRunner;
+    std::shared_ptr<AttributeLoadProgress> _attributeLoadProgress;
     std::shared_ptr<BucketDBOwner> _bucketDB;
     std::unique_ptr<bucketdb::BucketDBHandler> _bucketDBHandler;
     HwInfo _hwInfo;
@@ -110,6 +115,7 @@ public:
             DocumentDBTaggedMetrics &metrics,
             matching::QueryLimiter & queryLimiter,
             const vespalib::Clock &clock,
+            const vespalib::eval::ConstantValueFactory &constantValueFactory,
             std::mutex &configMutex,
             const vespalib::string &baseDir,
             const Config & cfg,
@@ -163,6 +169,7 @@ public:
     IFlushTargetList getFlushTargets();
     ReprocessingRunner &getReprocessingRunner() { return _reprocessingRunner; }
     double getReprocessingProgress() const;
+    const AttributeLoadProgress &getAttributeLoadProgress() const;
     void close();
     void tearDownReferences(IDocumentDBReferenceResolver &resolver);
     void validateDocStore(FeedHandler & feedHandler, SerialNum serialNum);
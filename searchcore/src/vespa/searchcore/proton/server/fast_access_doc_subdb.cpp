@@ -81,7 +81,8 @@ FastAccessDocSubDB::createAttributeManagerInitializer(const DocumentDBConfig &co
                                                          _attributeGrowNumDocs,
                                                          _fastAccessAttributesOnly,
                                                          _writeService.master(),
-                                                         attrMgrResult);
+                                                         attrMgrResult,
+                                                         _attributeLoadProgress);
 }
 
 void
@@ -191,13 +192,32 @@ FastAccessDocSubDB::createReprocessingTask(IReprocessingInitializer &initializer
                                                     getSubDbName(), docIdLimit);
 }
 
+search::LogDocumentStore::Config
+FastAccessDocSubDB::adjustStoreConfig(const search::LogDocumentStore::Config &config) const
+{
+    if (_documentCacheBytes == 0) {
+        return config;
+    }
+    // Keep all written documents compressed in the document cache, so they can be moved without disk access.
+    using search::DocumentStore;
+    auto compression = (config.getCompression().type != DocumentStore::Config::CompressionConfig::NONE)
+                       ? config.getCompression()
+                       : DocumentStore::Config().getCompression();
+    DocumentStore::Config storeConfig(compression, _documentCacheBytes, config.getInitialCacheEntries());
+    storeConfig.allowVisitCaching(config.allowVisitCaching())
+            .updateStrategy(DocumentStore::Config::UpdateStrategy::INSERT);
+    return search::LogDocumentStore::Config(storeConfig, config.getLogConfig());
+}
+
 FastAccessDocSubDB::FastAccessDocSubDB(const Config &cfg, const Context &ctx)
     : Parent(cfg._storeOnlyCfg, ctx._storeOnlyCtx),
       _hasAttributes(cfg._hasAttributes),
       _fastAccessAttributesOnly(cfg._fastAccessAttributesOnly),
+      _documentCacheBytes(cfg._documentCacheBytes),
       _initAttrMgr(),
       _fastAccessFeedView(),
       _subAttributeMetrics(ctx._subAttributeMetrics),
+      _attributeLoadProgress(ctx._attributeLoadProgress),
       _addMetrics(cfg._addMetrics),
       _metricsWireService(ctx._metricsWireService),
       _docIdLimit(0)
@@ -3,6 +3,7 @@
 
 #include "fast_access_doc_subdb_configurer.h"
 #include "storeonlydocsubdb.h"
+#include <vespa/searchcore/proton/attribute/attribute_load_progress.h>
 #include <vespa/searchcore/proton/attribute/attributemanager.h>
 #include <vespa/searchcore/proton/common/docid_limit.h>
 #include <vespa/searchcore/proton/metrics/attribute_metrics.h>
@@ -31,14 +32,17 @@ public:
         const bool                      _hasAttributes;
         const bool                      _addMetrics;
         const bool                      _fastAccessAttributesOnly;
+        const size_t                    _documentCacheBytes;
         Config(const StoreOnlyDocSubDB::Config &storeOnlyCfg,
                bool hasAttributes,
                bool addMetrics,
-               bool fastAccessAttributesOnly)
+               bool fastAccessAttributesOnly,
+               size_t documentCacheBytes)
         : _storeOnlyCfg(storeOnlyCfg),
           _hasAttributes(hasAttributes),
           _addMetrics(addMetrics),
-          _fastAccessAttributesOnly(fastAccessAttributesOnly)
+          _fastAccessAttributesOnly(fastAccessAttributesOnly),
+          _documentCacheBytes(documentCacheBytes)
         { }
     };
 
@@ -47,12 +51,15 @@ public:
         const StoreOnlyDocSubDB::Context _storeOnlyCtx;
         AttributeMetrics                &_subAttributeMetrics;
         MetricsWireService              &_metricsWireService;
+        AttributeLoadProgress::SP        _attributeLoadProgress;
         Context(const StoreOnlyDocSubDB::Context &storeOnlyCtx,
                 AttributeMetrics &subAttributeMetrics,
-                MetricsWireService &metricsWireService)
+                MetricsWireService &metricsWireService,
+                AttributeLoadProgress::SP attributeLoadProgress)
         : _storeOnlyCtx(storeOnlyCtx),
           _subAttributeMetrics(subAttributeMetrics),
-          _metricsWireService(metricsWireService)
+          _metricsWireService(metricsWireService),
+          _attributeLoadProgress(std::move(attributeLoadProgress))
         { }
     };
 
@@ -62,9 +69,11 @@ private:
 
     const bool                    _hasAttributes;
     const bool                    _fastAccessAttributesOnly;
+    const size_t                  _documentCacheBytes;
     AttributeManager::SP          _initAttrMgr;
     Configurer::FeedViewVarHolder _fastAccessFeedView;
     AttributeMetrics             &_subAttributeMetrics;
+    AttributeLoadProgress::SP     _attributeLoadProgress;
 
     std::shared_ptr<initializer::InitializerTask>
     createAttributeManagerInitializer(const DocumentDBConfig &configSnapshot,
@@ -88,6 +97,7 @@ protected:
     AttributeManager::SP getAndResetInitAttributeManager();
     virtual IFlushTargetList getFlushTargetsInternal() override;
     void reconfigureAttributeMetrics(const IAttributeManager &newMgr, const IAttributeManager &oldMgr);
+    search::LogDocumentStore::Config adjustStoreConfig(const search::LogDocumentStore::Config &config) const override;
 
     IReprocessingTask::UP createReprocessingTask(IReprocessingInitializer &initializer,
                                                  const std::shared_ptr<const document::DocumentTypeRepo> &docTypeRepo) const;
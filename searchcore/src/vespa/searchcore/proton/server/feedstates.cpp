@@ -9,8 +9,9 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
-#include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -19,18 +20,15 @@ using search::transactionlog::Packet;
 using search::transactionlog::client::RPC;
 using search::SerialNum;
 using vespalib::Executor;
-using vespalib::makeClosure;
 using vespalib::makeLambdaTask;
-using vespalib::makeTask;
 using vespalib::make_string;
 using proton::bucketdb::IBucketDBHandler;
 
 namespace proton {
 
 namespace {
-typedef vespalib::Closure1<const Packet::Entry &>::UP EntryHandler;
-
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
+const size_t REPLAY_DECODE_BATCH_SIZE = 64;
 
 void
 handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
@@ -47,17 +45,94 @@ handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
     }
 }
 
+/**
+ * Decodes the given entries, which are not new config entries, into feed operations.
+ * Batches of entries are decoded in parallel by the given executor.
+ */
+std::vector<FeedOperation::UP>
+decodeEntries(const std::vector<Packet::Entry> &entries, size_t begin, size_t end,
+              const document::DocumentTypeRepo &repo, Executor &executor)
+{
+    std::vector<FeedOperation::UP> ops(end - begin);
+    const size_t numBatches = (ops.size() + REPLAY_DECODE_BATCH_SIZE - 1) / REPLAY_DECODE_BATCH_SIZE;
+    if (numBatches <= 1) {
+        for (size_t i(begin); i < end; ++i) {
+            ops[i - begin] = ReplayPacketDispatcher::decodeEntry(entries[i], repo);
+        }
+        return ops;
+    }
+    vespalib::CountDownLatch latch(numBatches);
+    std::mutex errorLock;
+    std::exception_ptr error;
+    for (size_t batch(0); batch < numBatches; ++batch) {
+        size_t batchBegin = begin + batch * REPLAY_DECODE_BATCH_SIZE;
+        size_t batchEnd = std::min(end, batchBegin + REPLAY_DECODE_BATCH_SIZE);
+        auto task = makeLambdaTask([&, batchBegin, batchEnd]() {
+            try {
+                for (size_t i(batchBegin); i < batchEnd; ++i) {
+                    ops[i - begin] = ReplayPacketDispatcher::decodeEntry(entries[i], repo);
+                }
+            } catch (...) {
+                std::lock_guard guard(errorLock);
+                if ( ! error) {
+                    error = std::current_exception();
+                }
+            }
+            latch.countDown();
+        });
+        auto rejected = executor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return ops;
+}
+
 void
-handlePacket(PacketWrapper & wrap, EntryHandler entryHandler)
+handlePacket(PacketWrapper & wrap, IReplayPacketHandler &packet_handler, Executor &decode_executor)
 {
+    // Called in executor thread.
+    std::vector<Packet::Entry> entries;
+    entries.reserve(wrap.packet.size());
     vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
     while ( !handle.empty() ) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        entryHandler->call(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    ReplayPacketDispatcher dispatcher(packet_handler);
+    for (size_t begin(0); begin < entries.size(); ) {
+        const Packet::Entry &first = entries[begin];
+        if (first.type() == FeedOperation::NEW_CONFIG) {
+            // Entries following a new config might need the new document type repo to be decoded.
+            LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", first.serial(), first.type());
+            dispatcher.replayEntry(first);
+            packet_handler.optionalCommit(first.serial());
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, first.serial());
+            }
+            ++begin;
+            continue;
+        }
+        size_t end(begin + 1);
+        while ((end < entries.size()) && (entries[end].type() != FeedOperation::NEW_CONFIG)) {
+            ++end;
+        }
+        auto ops = decodeEntries(entries, begin, end, packet_handler.getDeserializeRepo(), decode_executor);
+        for (size_t i(begin); i < end; ++i) {
+            const Packet::Entry &entry = entries[i];
+            LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
+            dispatcher.replayOperation(*ops[i - begin]);
+            ops[i - begin].reset();
+            packet_handler.optionalCommit(entry.serial());
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, entry.serial());
+            }
         }
+        begin = end;
     }
     wrap.result = RPC::OK;
     wrap.gate.countDown();
@@ -133,15 +208,6 @@ public:
     }
 };
 
-void startDispatch(IReplayPacketHandler *packet_handler, const Packet::Entry &entry) {
-    // Called by handlePacket() in executor thread.
-    LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
-
-    ReplayPacketDispatcher dispatcher(*packet_handler);
-    dispatcher.replayEntry(entry);
-    packet_handler->optionalCommit(entry.serial());
-}
-
 }  // namespace
 
 ReplayTransactionLogState::ReplayTransactionLogState(
@@ -149,18 +215,21 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IFeedView *& feed_view_ptr,
         IBucketDBHandler &bucketDBHandler,
         IReplayConfig &replay_config,
-        FeedConfigStore &config_store)
+        FeedConfigStore &config_store,
+        Executor &decode_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store))
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store)),
+      _decode_executor(decode_executor)
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
-    EntryHandler closure = makeClosure(&startDispatch, _packet_handler.get());
-    executor.execute(makeLambdaTask([wrap = wrap, dispatch = std::move(closure)] () mutable { handlePacket(*wrap, std::move(dispatch)); }));
+    executor.execute(makeLambdaTask([wrap = wrap, packet_handler = _packet_handler.get(), decode_executor = &_decode_executor] () {
+        handlePacket(*wrap, *packet_handler, *decode_executor);
+    }));
 }
 
 }  // namespace proton
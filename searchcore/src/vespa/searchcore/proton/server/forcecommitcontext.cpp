@@ -31,12 +31,6 @@ ForceCommitContext::~ForceCommitContext()
     }
 }
 
-void
-ForceCommitContext::reuseLids(std::vector<uint32_t> &&lids)
-{
-    _task->reuseLids(std::move(lids));
-}
-
 void
 ForceCommitContext::holdUnblockShrinkLidSpace()
 {
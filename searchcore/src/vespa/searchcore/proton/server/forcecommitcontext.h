@@ -38,7 +38,6 @@ public:
 
     ~ForceCommitContext() override;
 
-    void reuseLids(std::vector<uint32_t> &&lids);
     void holdUnblockShrinkLidSpace();
     void registerCommittedDocIdLimit(uint32_t committedDocIdLimit, DocIdLimit *docIdLimit);
 };
@@ -6,31 +6,16 @@
 namespace proton {
 
 ForceCommitDoneTask::ForceCommitDoneTask(IDocumentMetaStore &documentMetaStore)
-    : _lidsToReuse(),
-      _holdUnblockShrinkLidSpace(false),
+    : _holdUnblockShrinkLidSpace(false),
       _documentMetaStore(documentMetaStore)
 {
 }
 
 ForceCommitDoneTask::~ForceCommitDoneTask() = default;
 
-void
-ForceCommitDoneTask::reuseLids(std::vector<uint32_t> &&lids)
-{
-    assert(_lidsToReuse.empty());
-    _lidsToReuse = std::move(lids);
-}
-
 void
 ForceCommitDoneTask::run()
 {
-    if (!_lidsToReuse.empty()) {
-        if (_lidsToReuse.size() == 1) {
-            _documentMetaStore.removeComplete(_lidsToReuse[0]);
-        } else {
-            _documentMetaStore.removeBatchComplete(_lidsToReuse);
-        }
-    }
     if (_holdUnblockShrinkLidSpace) {
         _documentMetaStore.holdUnblockShrinkLidSpace();
     }
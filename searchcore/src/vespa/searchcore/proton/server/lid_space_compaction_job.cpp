@@ -42,27 +42,47 @@ LidSpaceCompactionJob::getNextDocument(const LidUsageStats &stats)
     return document;
 }
 
+void
+LidSpaceCompactionJob::adjustBatchSize()
+{
+    uint32_t maxDocsToMove = _cfg.getMaxDocsToMove();
+    vespalib::duration maxMoveLatency = _cfg.getMaxMoveLatency();
+    if (maxMoveLatency == vespalib::duration::zero()) {
+        _batchSize = maxDocsToMove;
+    } else if (_moveOpsLimiter->getAverageLatency() > maxMoveLatency) {
+        _batchSize = std::max(1u, _batchSize / 2);
+    } else {
+        _batchSize = std::min(maxDocsToMove, _batchSize + 1);
+    }
+}
+
 bool
 LidSpaceCompactionJob::scanDocuments(const LidUsageStats &stats)
 {
-    if (_scanItr->valid()) {
-        DocumentMetaData document = getNextDocument(stats);
-        if (document.valid()) {
-            IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
-            if ( ! bucketGuard ) {
-                // the job is blocked until the bucket for this document is thawed
-                setBlocked(BlockedReason::FROZEN_BUCKET);
-                _retryFrozenDocument = true;
-                return true;
-            } else {
-                MoveOperation::UP op = _handler.createMoveOperation(document, stats.getLowestFreeLid());
-                search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
-                _opStorer.appendOperation(*op, context);
-                _handler.handleMove(*op, std::move(context));
-                if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
-                    return true;
-                }
-            }
+    adjustBatchSize();
+    LidUsageStats currStats = stats;
+    for (uint32_t moved = 0; (moved < _batchSize) && _scanItr->valid(); ++moved) {
+        if (moved > 0) {
+            // the previous move changed the lowest free lid
+            currStats = _handler.getLidStatus();
+        }
+        DocumentMetaData document = getNextDocument(currStats);
+        if ( ! document.valid()) {
+            break;
+        }
+        IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
+        if ( ! bucketGuard ) {
+            // the job is blocked until the bucket for this document is thawed
+            setBlocked(BlockedReason::FROZEN_BUCKET);
+            _retryFrozenDocument = true;
+            return true;
+        }
+        MoveOperation::UP op = _handler.createMoveOperation(document, currStats.getLowestFreeLid());
+        search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
+        _opStorer.appendOperation(*op, context);
+        _handler.handleMove(*op, std::move(context));
+        if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
+            return true;
         }
     }
     if (!_scanItr->valid()){
@@ -122,7 +142,8 @@ LidSpaceCompactionJob::LidSpaceCompactionJob(const DocumentDBLidSpaceCompactionC
       _clusterStateChangedNotifier(clusterStateChangedNotifier),
       _ops_rate_tracker(std::make_shared<RemoveOperationsRateTracker>(config.get_remove_batch_block_rate(),
                                                                       config.get_remove_block_rate())),
-      _is_disabled(false)
+      _is_disabled(false),
+      _batchSize(1)
 {
     _diskMemUsageNotifier.addDiskMemUsageListener(this);
     _clusterStateChangedNotifier.addClusterStateChangedHandler(this);
@@ -23,6 +23,10 @@ class IClusterStateChangedNotifier;
  *
  * Compaction is handled by moving documents from high lids to low free lids.
  * A handler is typically working over a single document sub db.
+ *
+ * Up to maxDocsToMove documents are moved each time the job runs. When a max
+ * move latency is configured, the batch size is halved while moves take longer
+ * than that to complete through the feed pipeline, and grown again otherwise.
  */
 class LidSpaceCompactionJob : public BlockableMaintenanceJob,
                               public IDiskMemUsageListener,
@@ -40,10 +44,12 @@ private:
     IClusterStateChangedNotifier &_clusterStateChangedNotifier;
     std::shared_ptr<RemoveOperationsRateTracker> _ops_rate_tracker;
     bool _is_disabled;
+    uint32_t _batchSize;
 
     bool hasTooMuchLidBloat(const search::LidUsageStats &stats) const;
     bool shouldRestartScanDocuments(const search::LidUsageStats &stats) const;
     search::DocumentMetaData getNextDocument(const search::LidUsageStats &stats);
+    void adjustBatchSize();
     bool scanDocuments(const search::LidUsageStats &stats);
     void compactLidSpace(const search::LidUsageStats &stats);
     void refreshRunnable();
@@ -59,7 +59,8 @@ injectBucketMoveJob(MaintenanceController &controller,
                     const std::shared_ptr<IBucketStateCalculator> &calc,
                     DocumentDBJobTrackers &jobTrackers,
                     IDiskMemUsageNotifier &diskMemUsageNotifier,
-                    const BlockableMaintenanceJobConfig &blockableConfig)
+                    const BlockableMaintenanceJobConfig &blockableConfig,
+                    const DocumentDBBucketMoveConfig &bucketMoveConfig)
 {
     auto bmj = std::make_unique<BucketMoveJob>(calc,
                                 moveHandler,
@@ -72,7 +73,8 @@ injectBucketMoveJob(MaintenanceController &controller,
                                 bucketStateChangedNotifier,
                                 diskMemUsageNotifier,
                                 blockableConfig,
-                                docTypeName, bucketSpace);
+                                docTypeName, bucketSpace,
+                                bucketMoveConfig.getMaxDocsToMove());
     controller.registerJobInMasterThread(trackJob(jobTrackers.getBucketMove(), std::move(bmj)));
 }
 
@@ -98,6 +100,7 @@ MaintenanceJobsInjector::injectJobs(MaintenanceController &controller,
                                     IDiskMemUsageNotifier &diskMemUsageNotifier,
                                     DocumentDBJobTrackers &jobTrackers,
                                     ICommitable &commit,
+                                    const IGetSerialNum &getSerialNum,
                                     IAttributeManagerSP readyAttributeManager,
                                     IAttributeManagerSP notReadyAttributeManager,
                                     std::unique_ptr<const AttributeConfigInspector> attribute_config_inspector,
@@ -106,7 +109,7 @@ MaintenanceJobsInjector::injectJobs(MaintenanceController &controller,
     controller.registerJobInMasterThread(std::make_unique<HeartBeatJob>(hbHandler, config.getHeartBeatConfig()));
     controller.registerJobInDefaultPool(std::make_unique<PruneSessionCacheJob>(scPruner, config.getSessionCachePruneInterval()));
     if (config.hasVisibilityDelay() && config.allowEarlyAck()) {
-        controller.registerJobInMasterThread(std::make_unique<DocumentDBCommitJob>(commit, config.getVisibilityDelay()));
+        controller.registerJobInMasterThread(std::make_unique<DocumentDBCommitJob>(commit, getSerialNum, config.getVisibilityDelay()));
     }
     const MaintenanceDocumentSubDB &mRemSubDB(controller.getRemSubDB());
     auto pruneRDjob = std::make_unique<PruneRemovedDocumentsJob>(config.getPruneRemovedDocumentsConfig(), *mRemSubDB.meta_store(),
@@ -120,7 +123,8 @@ MaintenanceJobsInjector::injectJobs(MaintenanceController &controller,
     }
     injectBucketMoveJob(controller, fbHandler, bucketCreateNotifier, docTypeName, bucketSpace, moveHandler, bucketModifiedHandler,
                         clusterStateChangedNotifier, bucketStateChangedNotifier, calc, jobTrackers,
-                        diskMemUsageNotifier, config.getBlockableJobConfig());
+                        diskMemUsageNotifier, config.getBlockableJobConfig(),
+                        config.getBucketMoveConfig());
     controller.registerJobInMasterThread(std::make_unique<SampleAttributeUsageJob>
                                                  (readyAttributeManager,
                                                   notReadyAttributeManager,
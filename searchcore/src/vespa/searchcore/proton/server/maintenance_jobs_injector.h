@@ -21,6 +21,7 @@ class IBucketStateChangedNotifier;
 struct IBucketStateCalculator;
 struct IAttributeManager;
 class AttributeUsageFilter;
+class IGetSerialNum;
 class IDiskMemUsageNotifier;
 class TransientMemoryUsageProvider;
 namespace bucketdb { class IBucketCreateNotifier; }
@@ -53,6 +54,7 @@ struct MaintenanceJobsInjector
                            IDiskMemUsageNotifier &diskMemUsageNotifier,
                            DocumentDBJobTrackers &jobTrackers,
                            ICommitable & commit,
+                           const IGetSerialNum & getSerialNum,
                            IAttributeManagerSP readyAttributeManager,
                            IAttributeManagerSP notReadyAttributeManager,
                            std::unique_ptr<const AttributeConfigInspector> attribute_config_inspector,
@@ -60,8 +60,10 @@ MatchView::getMatcher(const vespalib::string & rankProfile) const
 
 MatchContext::UP
 MatchView::createContext() const {
+    // Sample the generation first, so searching sees at least what was visible at that generation
+    uint64_t visibilityGeneration = _docIdLimit.getGeneration();
     IAttributeContext::UP attrCtx = _attrMgr->createContext();
-    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get());
+    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get(), visibilityGeneration);
     return std::make_unique<MatchContext>(std::move(attrCtx), std::move(searchCtx));
 }
 
@@ -10,8 +10,12 @@ using BlockedReason = IBlockableMaintenanceJob::BlockedReason;
 
 struct MoveOperationLimiter::Callback : public search::IDestructorCallback {
     MoveOperationLimiter::SP _limiter;
-    Callback(MoveOperationLimiter::SP limiter) noexcept : _limiter(std::move(limiter)) {}
-    virtual ~Callback() { _limiter->endOperation(); }
+    vespalib::steady_time _start;
+    Callback(MoveOperationLimiter::SP limiter) noexcept
+        : _limiter(std::move(limiter)),
+          _start(vespalib::steady_clock::now())
+    {}
+    virtual ~Callback() { _limiter->endOperation(vespalib::steady_clock::now() - _start); }
 };
 
 bool
@@ -21,12 +25,13 @@ MoveOperationLimiter::isOnLimit(const LockGuard &) const
 }
 
 void
-MoveOperationLimiter::endOperation()
+MoveOperationLimiter::endOperation(vespalib::duration latency)
 {
     LockGuard guard(_mutex);
     bool considerUnblock = isOnLimit(guard);
     assert(_outstandingOps > 0);
     --_outstandingOps;
+    _avgLatency = (_avgLatency * 7 + latency) / 8;
     if (_job && considerUnblock) {
         _job->unBlock(BlockedReason::OUTSTANDING_OPS);
     }
@@ -37,7 +42,8 @@ MoveOperationLimiter::MoveOperationLimiter(IBlockableMaintenanceJob *job,
     : _mutex(),
       _job(job),
       _outstandingOps(0),
-      _maxOutstandingOps(maxOutstandingOps)
+      _maxOutstandingOps(maxOutstandingOps),
+      _avgLatency(vespalib::duration::zero())
 {
 }
 
@@ -57,6 +63,13 @@ MoveOperationLimiter::isAboveLimit() const
     return (_outstandingOps >= _maxOutstandingOps);
 }
 
+vespalib::duration
+MoveOperationLimiter::getAverageLatency() const
+{
+    LockGuard guard(_mutex);
+    return _avgLatency;
+}
+
 std::shared_ptr<search::IDestructorCallback>
 MoveOperationLimiter::beginOperation()
 {
@@ -3,6 +3,7 @@
 
 #include "i_move_operation_limiter.h"
 #include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/vespalib/util/time.h>
 #include <memory>
 #include <mutex>
 
@@ -16,6 +17,7 @@ class IBlockableMaintenanceJob;
  * When crossing the boundary of max outstanding operations the job is blocked/unblocked.
  * Create a destructor callback with beginOperation() and pass this to the component(s) responsible for handling the move operation.
  * When this object is destructed (in any thread) the limiter is signaled and the job can be unblocked (if blocked).
+ * The time from begin to end of each operation is tracked as a moving average latency.
  */
 class MoveOperationLimiter : public IMoveOperationLimiter,
                              public std::enable_shared_from_this<MoveOperationLimiter> {
@@ -28,9 +30,10 @@ private:
     IBlockableMaintenanceJob *_job;
     uint32_t _outstandingOps;
     const uint32_t _maxOutstandingOps;
+    vespalib::duration _avgLatency;
 
     bool isOnLimit(const LockGuard &guard) const;
-    void endOperation();
+    void endOperation(vespalib::duration latency);
 
 public:
     using SP = std::shared_ptr<MoveOperationLimiter>;
@@ -39,6 +42,7 @@ public:
     ~MoveOperationLimiter();
     void clearJob();
     bool isAboveLimit() const;
+    vespalib::duration getAverageLatency() const;
     virtual std::shared_ptr<search::IDestructorCallback> beginOperation() override;
 };
 
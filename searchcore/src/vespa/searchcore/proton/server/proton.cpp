@@ -20,22 +20,27 @@
 #include <vespa/eval/eval/engine_or_factory.h>
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/onnx_wrapper.h>
 #include <vespa/searchcore/proton/flushengine/flush_engine_explorer.h>
 #include <vespa/searchcore/proton/flushengine/flushengine.h>
+#include <vespa/searchcore/proton/flushengine/memory_budget_flush_strategy.h>
 #include <vespa/searchcore/proton/flushengine/tls_stats_factory.h>
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
 #include <vespa/searchcore/proton/reference/document_db_reference_registry.h>
 #include <vespa/searchcore/proton/summaryengine/docsum_by_slime.h>
 #include <vespa/searchcore/proton/summaryengine/summaryengine.h>
 #include <vespa/searchlib/common/packets.h>
+#include <vespa/searchlib/common/write_throttle.h>
 #include <vespa/searchlib/transactionlog/trans_log_server_explorer.h>
 #include <vespa/searchlib/transactionlog/translogserverapp.h>
 #include <vespa/searchlib/util/fileheadertk.h>
 #include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/net/ring_tracer_explorer.h>
 #include <vespa/vespalib/net/state_server.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/util/host_name.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/random.h>
 
 #include <vespa/searchlib/aggregation/forcelink.hpp>
@@ -85,6 +90,14 @@ set_tensor_implementation(const ProtonConfig& cfg)
     LOG(info, "Tensor implementation used: %s", EngineOrFactory::get().to_string().c_str());
 }
 
+void
+set_onnx_shared_threads(const ProtonConfig& cfg)
+{
+    if (cfg.onnx.sharedthreads > 0) {
+        vespalib::tensor::Onnx::set_shared_intra_op_threads(cfg.onnx.sharedthreads);
+    }
+}
+
 void
 setBucketCheckSumType(const ProtonConfig & proton)
 {
@@ -213,6 +226,7 @@ Proton::Proton(const config::ConfigUri & configUri,
       _docsumBySlime(),
       _memoryFlushConfigUpdater(),
       _flushEngine(),
+      _attributeWriteThrottle(),
       _prepareRestartHandler(),
       _rpcHooks(),
       _healthAdapter(*this),
@@ -231,6 +245,8 @@ Proton::Proton(const config::ConfigUri & configUri,
       _compile_cache_executor_binding(),
       _queryLimiter(),
       _clock(0.001),
+      _tensorLoader(vespalib::eval::EngineOrFactory::get()),
+      _constantValueCache(_tensorLoader),
       _threadPool(128 * 1024),
       _distributionKey(-1),
       _isInitializing(true),
@@ -270,8 +286,11 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     const HwInfo & hwInfo = configSnapshot->getHwInfo();
 
     set_tensor_implementation(protonConfig);
+    set_onnx_shared_threads(protonConfig);
     setBucketCheckSumType(protonConfig);
     setFS4Compression(protonConfig);
+    // Used by attributes configured as paged.
+    vespalib::alloc::MmapFileAllocatorFactory::instance().setup(protonConfig.basedir + "/swapdirs");
     _diskMemUsageSampler = std::make_unique<DiskMemUsageSampler>(protonConfig.basedir,
                                                                  diskMemUsageSamplerConfig(protonConfig, hwInfo));
 
@@ -280,7 +299,8 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _fileHeaderContext.setClusterName(protonConfig.clustername, protonConfig.basedir);
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  protonConfig.numthreadspersearch,
-                                                 protonConfig.distributionkey);
+                                                 protonConfig.distributionkey,
+                                                 protonConfig.numaawarematching);
     _distributionKey = protonConfig.distributionkey;
     _summaryEngine= std::make_unique<SummaryEngine>(protonConfig.numsummarythreads);
     _docsumBySlime = std::make_unique<DocsumBySlime>(*_summaryEngine);
@@ -296,6 +316,14 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
         strategy = memoryFlush;
         break;
     }
+    case ProtonConfig::Flush::Strategy::MEMORYBUDGET: {
+        PrepareRestartFlushStrategy::Config replayCost(flush.preparerestart.replaycost,
+                                                       flush.preparerestart.replayoperationcost,
+                                                       flush.preparerestart.writecost);
+        strategy = std::make_shared<MemoryBudgetFlushStrategy>(
+                MemoryBudgetFlushStrategy::Config(flush.memory.maxmemory, flush.memorybudget.lowwatermarkfactor, replayCost));
+        break;
+    }
     case ProtonConfig::Flush::Strategy::SIMPLE:
     default:
         strategy = std::make_shared<SimpleFlush>();
@@ -305,7 +333,9 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     vespalib::chdir(protonConfig.basedir);
     _tls->start();
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
-                                                 strategy, flush.maxconcurrent, flush.idleinterval*1000);
+                                                 strategy, flush.maxconcurrent, flush.idleinterval*1000,
+                                                 flush.maxconcurrentsmall, flush.smalltargetbytes);
+    _attributeWriteThrottle = configSnapshot->getTuneFileDocumentDBSP()->_attr._throttle;
     _metricsEngine->addExternalMetrics(_summaryEngine->getMetrics());
 
     char tmp[1024];
@@ -371,6 +401,9 @@ Proton::applyConfig(const BootstrapConfig::SP & configSnapshot)
     _queryLimiter.configure(protonConfig.search.memory.limiter.maxthreads,
                             protonConfig.search.memory.limiter.mincoverage,
                             protonConfig.search.memory.limiter.minhits);
+    if (_matchEngine) {
+        _matchEngine->setMaxQueueTimeFactor(protonConfig.search.admission.maxqueuetimefactor);
+    }
     const std::shared_ptr<const DocumentTypeRepo> repo = configSnapshot->getDocumentTypeRepoSP();
 
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, configSnapshot->getHwInfo()));
@@ -598,11 +631,12 @@ Proton::addDocumentDB(const document::DocumentType &docType,
     if (!initializeThreads) {
         // If configured value for initialize threads was 0, or we
         // are performing a reconfig after startup has completed, then use
-        // 1 thread per document type.
-        initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(1, 128 * 1024);
+        // separate threads per document type.
+        uint32_t threadsPerDocumentDB = std::max(1, config.initialize.threads_per_documentdb);
+        initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(threadsPerDocumentDB, 128 * 1024);
     }
     auto ret = std::make_shared<DocumentDB>(config.basedir + "/documents", documentDBConfig, config.tlsspec,
-                                            _queryLimiter, _clock, docTypeName, bucketSpace, config, *this,
+                                            _queryLimiter, _clock, _constantValueCache, docTypeName, bucketSpace, config, *this,
                                             *_warmupExecutor, *_sharedExecutor, *_tls->getTransLogServer(),
                                             *_metricsEngine, _fileHeaderContext, std::move(config_store),
                                             initializeThreads, bootstrapConfig->getHwInfo());
@@ -756,7 +790,11 @@ Proton::updateMetrics(const metrics::UpdateHook::MetricLockGuard &)
             updateExecutorMetrics(metrics.flush, _flushEngine->getExecutorStats());
         }
         if (_matchEngine) {
-            updateExecutorMetrics(metrics.match, _matchEngine->getExecutorStats());
+            auto matchStats = _matchEngine->getExecutorStats();
+            updateExecutorMetrics(metrics.match, matchStats);
+            if (_attributeWriteThrottle) {
+                _attributeWriteThrottle->reportLoad(matchStats.queueSize.average());
+            }
         }
         if (_summaryEngine) {
             updateExecutorMetrics(metrics.docsum, _summaryEngine->getExecutorStats());
@@ -851,6 +889,7 @@ const vespalib::string DOCUMENT_DB = "documentdb";
 const vespalib::string FLUSH_ENGINE = "flushengine";
 const vespalib::string TLS_NAME = "tls";
 const vespalib::string RESOURCE_USAGE = "resourceusage";
+const vespalib::string RING_TRACER = "ringtracer";
 
 struct StateExplorerProxy : vespalib::StateExplorer {
     const StateExplorer &explorer;
@@ -896,7 +935,7 @@ Proton::get_state(const vespalib::slime::Inserter &, bool) const
 std::vector<vespalib::string>
 Proton::get_children_names() const
 {
-    std::vector<vespalib::string> names({DOCUMENT_DB, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, RESOURCE_USAGE});
+    std::vector<vespalib::string> names({DOCUMENT_DB, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, RESOURCE_USAGE, RING_TRACER});
     return names;
 }
 
@@ -914,6 +953,8 @@ Proton::get_child(vespalib::stringref name) const
         return std::make_unique<search::transactionlog::TransLogServerExplorer>(_tls->getTransLogServer());
     } else if (name == RESOURCE_USAGE && _diskMemUsageSampler) {
         return std::make_unique<ResourceUsageExplorer>(_diskMemUsageSampler->writeFilter());
+    } else if (name == RING_TRACER) {
+        return std::make_unique<vespalib::RingTracerExplorer>();
     }
     return Explorer_UP(nullptr);
 }
@@ -26,10 +26,13 @@
 #include <vespa/vespalib/net/state_explorer.h>
 #include <vespa/vespalib/util/varholder.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/eval/value_cache/constant_value_cache.h>
 #include <mutex>
 #include <shared_mutex>
 
 namespace vespalib { class StateServer; }
+namespace search { class WriteThrottle; }
 namespace search::transactionlog { class TransLogServerApp; }
 namespace proton {
 
@@ -99,6 +102,7 @@ private:
     std::unique_ptr<DocsumBySlime>  _docsumBySlime;
     MemoryFlushConfigUpdater::UP    _memoryFlushConfigUpdater;
     std::unique_ptr<FlushEngine>    _flushEngine;
+    std::shared_ptr<search::WriteThrottle> _attributeWriteThrottle;
     std::unique_ptr<PrepareRestartHandler> _prepareRestartHandler;
     RPCHooks::UP                    _rpcHooks;
     HealthAdapter                   _healthAdapter;
@@ -115,6 +119,8 @@ private:
     vespalib::eval::CompileCache::ExecutorBinding::UP _compile_cache_executor_binding;
     matching::QueryLimiter          _queryLimiter;
     vespalib::Clock                 _clock;
+    vespalib::eval::ConstantTensorLoader _tensorLoader;
+    vespalib::eval::ConstantValueCache   _constantValueCache; // shared by all document dbs
     FastOS_ThreadPool               _threadPool;
     uint32_t                        _distributionKey;
     bool                            _isInitializing;
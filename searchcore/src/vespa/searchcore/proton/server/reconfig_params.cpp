@@ -42,6 +42,13 @@ ReconfigParams::shouldMatchersChange() const
     return _res.rankProfilesChanged || _res.rankingConstantsChanged || _res.onnxModelsChanged || shouldSchemaChange();
 }
 
+bool
+ReconfigParams::shouldAllMatchersChange() const
+{
+    // Matchers for unchanged rank profiles can only be reused when nothing they share has changed
+    return _res.rankingConstantsChanged || _res.onnxModelsChanged || shouldSchemaChange();
+}
+
 bool
 ReconfigParams::shouldIndexManagerChange() const
 {
@@ -18,6 +18,7 @@ public:
     bool configHasChanged() const;
     bool shouldSchemaChange() const;
     bool shouldMatchersChange() const;
+    bool shouldAllMatchersChange() const;
     bool shouldIndexManagerChange() const;
     bool shouldAttributeManagerChange() const;
     bool shouldSummaryManagerChange() const;
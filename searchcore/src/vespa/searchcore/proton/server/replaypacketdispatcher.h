@@ -4,6 +4,9 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
+
+namespace document { class DocumentTypeRepo; }
 
 namespace proton {
 
@@ -19,9 +22,6 @@ private:
     typedef search::transactionlog::Packet Packet;
     IReplayPacketHandler &_handler;
 
-    template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
-
 protected:
     virtual void store(const FeedOperation &op);
 
@@ -30,6 +30,20 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Deserializes the given packet entry into a feed operation using the given repo.
+     * This does not touch the handler, and can be done for many entries in parallel as long
+     * as none of them are new config entries, which are never decoded by this function.
+     *
+     * @return the feed operation, or an empty pointer for a new config entry.
+     */
+    static std::unique_ptr<FeedOperation> decodeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo);
+
+    /**
+     * Dispatches a feed operation returned by decodeEntry() to the handler.
+     */
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
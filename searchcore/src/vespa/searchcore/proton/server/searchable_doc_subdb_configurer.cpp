@@ -125,10 +125,51 @@ Matchers::UP
 SearchableDocSubDBConfigurer::createMatchers(const Schema::SP &schema,
                                              const RankProfilesConfig &cfg,
                                              const OnnxModels &onnxModels)
+{
+    return createMatchers(schema, cfg, onnxModels, RankProfilesConfig(), nullptr);
+}
+
+namespace {
+
+const RankProfilesConfig::Rankprofile *
+findRankProfile(const RankProfilesConfig &cfg, const vespalib::string &name)
+{
+    for (const auto &profile : cfg.rankprofile) {
+        if (profile.name == name) {
+            return &profile;
+        }
+    }
+    return nullptr;
+}
+
+}
+
+Matchers::UP
+SearchableDocSubDBConfigurer::createMatchers(const Schema::SP &schema,
+                                             const RankProfilesConfig &cfg,
+                                             const OnnxModels &onnxModels,
+                                             const RankProfilesConfig &oldCfg,
+                                             const Matchers &oldMatchers)
+{
+    return createMatchers(schema, cfg, onnxModels, oldCfg, &oldMatchers);
+}
+
+Matchers::UP
+SearchableDocSubDBConfigurer::createMatchers(const Schema::SP &schema,
+                                             const RankProfilesConfig &cfg,
+                                             const OnnxModels &onnxModels,
+                                             const RankProfilesConfig &oldCfg,
+                                             const Matchers *oldMatchers)
 {
     auto newMatchers = std::make_unique<Matchers>(_clock, _queryLimiter, _constantValueRepo);
     for (const auto &profile : cfg.rankprofile) {
         vespalib::string name = profile.name;
+        const auto *oldProfile = findRankProfile(oldCfg, name);
+        if ((oldMatchers != nullptr) && (oldProfile != nullptr) && (*oldProfile == profile)) {
+            // Unchanged rank profile; keep the already compiled rank setup.
+            newMatchers->add(name, oldMatchers->lookup(name));
+            continue;
+        }
         search::fef::Properties properties;
         for (const auto &property : profile.fef.property) {
             properties.add(property.name, property.value);
@@ -202,9 +243,15 @@ SearchableDocSubDBConfigurer::reconfigure(const DocumentDBConfig &newConfig,
     Matchers::SP matchers = searchView->getMatchers();
     if (params.shouldMatchersChange()) {
         _constantValueRepo.reconfigure(newConfig.getRankingConstants());
-        Matchers::SP newMatchers = createMatchers(newConfig.getSchemaSP(),
-                                                  newConfig.getRankProfilesConfig(),
-                                                  newConfig.getOnnxModels());
+        Matchers::SP newMatchers = params.shouldAllMatchersChange()
+                                   ? createMatchers(newConfig.getSchemaSP(),
+                                                    newConfig.getRankProfilesConfig(),
+                                                    newConfig.getOnnxModels())
+                                   : createMatchers(newConfig.getSchemaSP(),
+                                                    newConfig.getRankProfilesConfig(),
+                                                    newConfig.getOnnxModels(),
+                                                    oldConfig.getRankProfilesConfig(),
+                                                    *matchers);
         matchers = newMatchers;
         shouldMatchViewChange = true;
     }
@@ -66,6 +66,12 @@ private:
 
     void reconfigureSearchView(ISummaryManager::ISummarySetup::SP summarySetup, MatchView::SP matchView);
 
+    Matchers::UP createMatchers(const search::index::Schema::SP &schema,
+                                const vespa::config::search::RankProfilesConfig &cfg,
+                                const proton::matching::OnnxModels &onnxModels,
+                                const vespa::config::search::RankProfilesConfig &oldCfg,
+                                const Matchers *oldMatchers);
+
 public:
     SearchableDocSubDBConfigurer(const SearchableDocSubDBConfigurer &) = delete;
     SearchableDocSubDBConfigurer & operator = (const SearchableDocSubDBConfigurer &) = delete;
@@ -83,6 +89,17 @@ public:
                                 const vespa::config::search::RankProfilesConfig &cfg,
                                 const proton::matching::OnnxModels &onnxModels);
 
+    /**
+     * Create matchers, reusing the matchers in oldMatchers for rank
+     * profiles that are identical in cfg and oldCfg. Only valid when
+     * schema, ranking constants and onnx models are unchanged.
+     **/
+    Matchers::UP createMatchers(const search::index::Schema::SP &schema,
+                                const vespa::config::search::RankProfilesConfig &cfg,
+                                const proton::matching::OnnxModels &onnxModels,
+                                const vespa::config::search::RankProfilesConfig &oldCfg,
+                                const Matchers &oldMatchers);
+
     void reconfigureIndexSearchable();
 
     void reconfigure(const DocumentDBConfig &newConfig,
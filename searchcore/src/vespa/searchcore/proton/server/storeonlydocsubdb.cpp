@@ -297,7 +297,7 @@ StoreOnlyDocSubDB::createInitializer(const DocumentDBConfig &configSnapshot, Ser
     auto dmsInitTask = createDocumentMetaStoreInitializer(configSnapshot.getTuneFileDocumentDBSP()->_attr,
                                                           result->writableResult().writableDocumentMetaStore());
     result->addDocumentMetaStoreInitTask(dmsInitTask);
-    auto summaryTask = createSummaryManagerInitializer(configSnapshot.getStoreConfig(),
+    auto summaryTask = createSummaryManagerInitializer(adjustStoreConfig(configSnapshot.getStoreConfig()),
                                                        configSnapshot.getTuneFileDocumentDBSP()->_summary,
                                                        result->result().documentMetaStore()->documentMetaStore(),
                                                        result->writableResult().writableSummaryManager());
@@ -420,7 +420,13 @@ StoreOnlyDocSubDB::applyConfig(const DocumentDBConfig &newConfigSnapshot, const
 void
 StoreOnlyDocSubDB::reconfigure(const search::LogDocumentStore::Config & config)
 {
-    _rSummaryMgr->reconfigure(config);
+    _rSummaryMgr->reconfigure(adjustStoreConfig(config));
+}
+
+search::LogDocumentStore::Config
+StoreOnlyDocSubDB::adjustStoreConfig(const search::LogDocumentStore::Config &config) const
+{
+    return config;
 }
 
 void
@@ -184,6 +184,12 @@ protected:
     vespalib::string getSubDbName() const;
 
     void reconfigure(const search::LogDocumentStore::Config & protonConfig);
+    /**
+     * Returns the document store config used by this sub database,
+     * given the one shared by all sub databases.
+     */
+    virtual search::LogDocumentStore::Config
+    adjustStoreConfig(const search::LogDocumentStore::Config &config) const;
 public:
     StoreOnlyDocSubDB(const Config &cfg, const Context &ctx);
     ~StoreOnlyDocSubDB() override;
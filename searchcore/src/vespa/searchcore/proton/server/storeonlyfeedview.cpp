@@ -19,6 +19,7 @@
 #include <vespa/searchlib/common/gatecallback.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.storeonlyfeedview");
@@ -44,6 +45,9 @@ namespace proton {
 
 namespace {
 
+// Upper bound for updated documents remembered before the ones already made are forgotten.
+constexpr size_t MAX_REMEMBERED_UPDATED_DOCS = 1024;
+
 class PutDoneContextForMove : public PutDoneContext {
 private:
     IDestructorCallback::SP _moveDoneCtx;
@@ -230,6 +234,7 @@ StoreOnlyFeedView::StoreOnlyFeedView(const Context &ctx, const PersistentParams
       _lidReuseDelayer(ctx._writeService, _documentMetaStoreContext->get(), ctx._lidReuseDelayerConfig),
       _pendingLidsForDocStore(),
       _pendingLidsForCommit(createUncommitedLidTracker(_lidReuseDelayer.allowEarlyAck())),
+      _updatedDocs(),
       _schema(ctx._schema),
       _writeService(ctx._writeService),
       _params(params),
@@ -266,11 +271,6 @@ StoreOnlyFeedView::internalForceCommit(SerialNum serialNum, OnForceCommitDoneTyp
     LOG(debug, "internalForceCommit: serial=%" PRIu64 ".", serialNum);
     _writeService.summary().execute(makeLambdaTask([onDone=onCommitDone]() {(void) onDone;}));
     _writeService.summary().wakeup();
-    std::vector<uint32_t> lidsToReuse;
-    lidsToReuse = _lidReuseDelayer.getReuseLids();
-    if (!lidsToReuse.empty()) {
-        onCommitDone->reuseLids(std::move(lidsToReuse));
-    }
 }
 
 void
@@ -417,6 +417,7 @@ void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid,
 
 void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP doc, OnOperationDoneType onDone)
 {
+    _updatedDocs.erase(lid);
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Winline" // Avoid spurious inlining warning from GCC related to lambda destructor.
     summaryExecutor().execute(
@@ -428,6 +429,7 @@ void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP do
 #pragma GCC diagnostic pop
 }
 void StoreOnlyFeedView::removeSummary(SerialNum serialNum, Lid lid, OnWriteDoneType onDone) {
+    _updatedDocs.erase(lid);
     summaryExecutor().execute(
             makeLambdaTask([serialNum, lid, onDone, trackerToken = _pendingLidsForDocStore.produce(lid), this] {
                 (void) onDone;
@@ -498,7 +500,12 @@ StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp)
         PromisedDoc promisedDoc;
         FutureDoc futureDoc = promisedDoc.get_future().share();
         onWriteDone->setDocument(futureDoc);
-        _pendingLidsForDocStore.waitComplete(lid);
+        // Repeated updates of the same document build on the document produced by the previous
+        // update instead of waiting for it to be written to and read back from the document store.
+        FutureDoc prevUpdatedDoc = useDocumentStore(serialNum) ? takeUpdatedDoc(lid) : FutureDoc();
+        if ( ! prevUpdatedDoc.valid()) {
+            _pendingLidsForDocStore.waitComplete(lid);
+        }
         if (updateScope._indexedFields) {
             updateIndexedFields(serialNum, lid, futureDoc, immediateCommit, onWriteDone);
         }
@@ -506,26 +513,66 @@ StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp)
         FutureStream futureStream = promisedStream.get_future();
         if (useDocumentStore(serialNum)) {
             putSummary(serialNum, lid, std::move(futureStream), onWriteDone);
+            rememberUpdatedDoc(lid, futureDoc);
         }
         _writeService
                 .shared()
                 .execute(makeLambdaTask(
                          [upd = updOp.getUpdate(), serialNum, lid, onWriteDone, promisedDoc = std::move(promisedDoc),
-                          promisedStream = std::move(promisedStream), this]() mutable
+                          promisedStream = std::move(promisedStream), prevUpdatedDoc = std::move(prevUpdatedDoc), this]() mutable
                           {
                              makeUpdatedDocument(serialNum, lid, *upd, onWriteDone,
-                                                 std::move(promisedDoc), std::move(promisedStream));
+                                                 std::move(promisedDoc), std::move(promisedStream),
+                                                 std::move(prevUpdatedDoc));
                           }));
         updateAttributes(serialNum, lid, std::move(futureDoc), immediateCommit, onWriteDone);
     }
 }
 
+StoreOnlyFeedView::FutureDoc
+StoreOnlyFeedView::takeUpdatedDoc(Lid lid)
+{
+    auto itr = _updatedDocs.find(lid);
+    if (itr == _updatedDocs.end()) {
+        return FutureDoc();
+    }
+    FutureDoc doc = std::move(itr->second);
+    _updatedDocs.erase(itr);
+    return doc;
+}
+
+void
+StoreOnlyFeedView::rememberUpdatedDoc(Lid lid, FutureDoc doc)
+{
+    if (_updatedDocs.size() >= MAX_REMEMBERED_UPDATED_DOCS) {
+        // Forget the documents that have already been made, the document store has (or soon will have) them.
+        std::vector<Lid> ready;
+        for (const auto & entry : _updatedDocs) {
+            if (entry.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                ready.push_back(entry.first);
+            }
+        }
+        for (Lid readyLid : ready) {
+            _updatedDocs.erase(readyLid);
+        }
+    }
+    _updatedDocs[lid] = std::move(doc);
+}
+
 void
 StoreOnlyFeedView::makeUpdatedDocument(SerialNum serialNum, Lid lid, const DocumentUpdate & update,
                                        OnOperationDoneType onWriteDone, PromisedDoc promisedDoc,
-                                       PromisedStream promisedStream)
+                                       PromisedStream promisedStream, FutureDoc prevUpdatedDoc)
 {
-    Document::UP prevDoc = _summaryAdapter->get(lid, *_repo);
+    Document::UP prevDoc;
+    if (prevUpdatedDoc.valid()) {
+        const auto & doc = prevUpdatedDoc.get();
+        if (doc) {
+            prevDoc.reset(doc->clone());
+        }
+    } else {
+        prevDoc = _summaryAdapter->get(lid, *_repo);
+    }
     Document::UP newDoc;
     vespalib::nbostream newStream(12345);
     assert(!onWriteDone->hasToken() || useDocumentStore(serialNum));
@@ -21,6 +21,7 @@
 #include <vespa/searchcorespi/index/ithreadingservice.h>
 #include <vespa/searchlib/query/base.h>
 #include <vespa/vespalib/util/threadstackexecutorbase.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 #include <future>
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 
@@ -145,6 +146,8 @@ private:
     LidReuseDelayer                                          _lidReuseDelayer;
     PendingLidTracker                                        _pendingLidsForDocStore;
     std::unique_ptr<PendingLidTrackerBase>                   _pendingLidsForCommit;
+    // Documents produced by recent updates, used as base for the next update of the same lid.
+    vespalib::hash_map<Lid, FutureDoc>                       _updatedDocs;
 
 protected:
     const search::index::Schema::SP          _schema;
@@ -192,7 +195,9 @@ private:
     void considerEarlyAck(FeedToken &token);
 
     void makeUpdatedDocument(SerialNum serialNum, Lid lid, const DocumentUpdate & update, OnOperationDoneType onWriteDone,
-                             PromisedDoc promisedDoc, PromisedStream promisedStream);
+                             PromisedDoc promisedDoc, PromisedStream promisedStream, FutureDoc prevUpdatedDoc);
+    FutureDoc takeUpdatedDoc(Lid lid);
+    void rememberUpdatedDoc(Lid lid, FutureDoc doc);
 
 protected:
     virtual void internalDeleteBucket(const DeleteBucketOperation &delOp);
@@ -141,6 +141,13 @@ public:
      */
     virtual double get_replay_operation_cost() const { return 0.0; }
 
+    /**
+     * Returns the approximate amount of memory temporarily needed in
+     * addition to the memory already used by this target when it is
+     * flushed, e.g. for buffering data before it is written to disk.
+     */
+    virtual uint64_t get_approx_transient_memory() const { return 0; }
+
     /**
      * Returns the last serial number for the transaction applied to
      * target before it was flushed to disk.  The transaction log can
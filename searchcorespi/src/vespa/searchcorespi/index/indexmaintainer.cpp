@@ -397,7 +397,7 @@ IndexMaintainer::swapInNewIndex(LockGuard & guard,
             LOG(debug, "Warming up a disk index.");
             indexes = std::make_shared<WarmupIndexCollection>
                       (_warmupConfig, getLeaf(guard, _source_list, true), indexes,
-                       static_cast<IDiskIndex &>(source), _ctx.getWarmupExecutor(), *this);
+                       static_cast<IDiskIndex &>(source), _ctx.getWarmupExecutor(), *this, _warmupTerms);
         } else {
             LOG(debug, "No warmup needed as it is a memory index that is mapped in.");
         }
@@ -709,9 +709,28 @@ IndexMaintainer::makeSureAllRemainingWarmupIsDone(ISearchableIndexCollection::SP
     LOG(info, "Sync warmupExecutor.");
     _ctx.getWarmupExecutor().sync();
     LOG(info, "Now the keep alive of the warmupindexcollection should be gone.");
+    if (_warmupTerms) {
+        _warmupTerms->save(WarmupTerms::file_name(_base_dir));
+    }
     return true;
 }
 
+void
+IndexMaintainer::prefetchWarmupTerms(const ISearchableIndexCollection::SP &sourceList)
+{
+    auto terms = _warmupTerms->get_terms();
+    if (terms.empty()) {
+        return;
+    }
+    LOG(info, "Prefetching %zu recorded warmup terms from disk indexes in '%s'", terms.size(), _base_dir.c_str());
+    bool unpack = _warmupConfig.getUnpack();
+    for (auto &term : terms) {
+        _ctx.getWarmupExecutor().execute(makeLambdaTask([sourceList, term = std::move(term), unpack]() {
+            WarmupTerms::warmup_term(*sourceList, term, unpack);
+        }));
+    }
+}
+
 void
 IndexMaintainer::warmupDone(ISearchableIndexCollection::SP current)
 {
@@ -837,6 +856,7 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
                                  IIndexMaintainerOperations &operations)
     : _base_dir(config.getBaseDir()),
       _warmupConfig(config.getWarmup()),
+      _warmupTerms(),
       _active_indexes(new ActiveDiskIndexes()),
       _layout(config.getBaseDir()),
       _schema(config.getSchema()),
@@ -908,6 +928,13 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
     sourceList->setCurrentIndex(_current_index_id);
     _source_list = std::move(sourceList);
     _fusion_spec = spec;
+    if (_warmupConfig.getDuration() > vespalib::duration::zero()) {
+        _warmupTerms = std::make_shared<WarmupTerms>();
+        _warmupTerms->load(WarmupTerms::file_name(_base_dir));
+        if (_next_id > 1) {
+            prefetchWarmupTerms(_source_list);
+        }
+    }
     _ctx.getThreadingService().master().execute(makeLambdaTask([this,&config]() {pruneRemovedFields(_schema, config.getSerialNum()); }));
     _ctx.getThreadingService().master().sync();
 }
@@ -75,6 +75,7 @@ class IndexMaintainer : public IIndexManager,
 
     const vespalib::string _base_dir;
     const WarmupConfig     _warmupConfig;
+    WarmupTerms::SP        _warmupTerms;
     ActiveDiskIndexes::SP  _active_indexes;
     IndexDiskLayout        _layout;
     Schema                 _schema;             // Protected by SL + IUL
@@ -270,6 +271,7 @@ class IndexMaintainer : public IIndexManager,
     bool reconfigure(vespalib::Closure0<bool>::UP closure);
     virtual void warmupDone(ISearchableIndexCollection::SP current) override;
     bool makeSureAllRemainingWarmupIsDone(ISearchableIndexCollection::SP keepAlive);
+    void prefetchWarmupTerms(const ISearchableIndexCollection::SP &sourceList);
     void scheduleCommit();
     void commit();
     void pruneRemovedFields(const Schema &schema, SerialNum serialNum);
@@ -0,0 +1,171 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "warmup_terms.h"
+#include "indexsearchable.h"
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <algorithm>
+#include <fstream>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchcorespi.index.warmup_terms");
+
+using search::fef::MatchDataLayout;
+using search::query::SimpleStringTerm;
+using search::query::Weight;
+using search::queryeval::Blueprint;
+using search::queryeval::FakeRequestContext;
+using search::queryeval::FieldSpec;
+using search::queryeval::FieldSpecList;
+using search::queryeval::SearchIterator;
+
+namespace searchcorespi::index {
+
+namespace {
+
+using Entry = std::pair<WarmupTerms::Term, uint64_t>;
+
+std::vector<Entry>
+sorted_by_count(const std::map<WarmupTerms::Term, uint64_t> &counts)
+{
+    std::vector<Entry> entries(counts.begin(), counts.end());
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry &a, const Entry &b) { return a.second > b.second; });
+    return entries;
+}
+
+}
+
+WarmupTerms::WarmupTerms(size_t max_terms)
+    : _lock(),
+      _counts(),
+      _max_terms(std::max(max_terms, size_t(2)))
+{
+}
+
+WarmupTerms::~WarmupTerms() = default;
+
+void
+WarmupTerms::record(const vespalib::string &field, const vespalib::string &term)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _counts.find(Term(field, term));
+    if (itr != _counts.end()) {
+        ++itr->second;
+        return;
+    }
+    if (_counts.size() >= _max_terms) {
+        // Keep the most frequent half with halved counts, letting the hot set drift over time.
+        std::vector<Entry> entries = sorted_by_count(_counts);
+        _counts.clear();
+        for (size_t i = 0; i < _max_terms / 2; ++i) {
+            _counts[entries[i].first] = std::max(entries[i].second / 2, uint64_t(1));
+        }
+    }
+    _counts[Term(field, term)] = 1;
+}
+
+std::vector<WarmupTerms::Term>
+WarmupTerms::get_terms() const
+{
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        entries = sorted_by_count(_counts);
+    }
+    std::vector<Term> result;
+    result.reserve(entries.size());
+    for (auto &entry : entries) {
+        result.push_back(std::move(entry.first));
+    }
+    return result;
+}
+
+size_t
+WarmupTerms::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _counts.size();
+}
+
+void
+WarmupTerms::save(const vespalib::string &file_name) const
+{
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        entries = sorted_by_count(_counts);
+    }
+    vespalib::string tmp_name = file_name + ".tmp";
+    {
+        std::ofstream out(tmp_name.c_str(), std::ios::out | std::ios::trunc);
+        for (const auto &entry : entries) {
+            const Term &term = entry.first;
+            if ((term.first.find('\t') != vespalib::string::npos) ||
+                (term.first.find('\n') != vespalib::string::npos) ||
+                (term.second.find('\n') != vespalib::string::npos)) {
+                continue;
+            }
+            out << entry.second << '\t' << term.first << '\t' << term.second << '\n';
+        }
+        out.flush();
+        if (!out) {
+            LOG(warning, "Failed writing warmup terms to '%s'", tmp_name.c_str());
+            return;
+        }
+    }
+    vespalib::rename(tmp_name, file_name);
+}
+
+void
+WarmupTerms::load(const vespalib::string &file_name)
+{
+    std::ifstream in(file_name.c_str());
+    if (!in) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    std::string line;
+    while (std::getline(in, line) && (_counts.size() < _max_terms)) {
+        size_t field_pos = line.find('\t');
+        size_t term_pos = (field_pos != std::string::npos) ? line.find('\t', field_pos + 1) : std::string::npos;
+        if (term_pos == std::string::npos) {
+            LOG(warning, "Ignoring malformed line in warmup terms file '%s'", file_name.c_str());
+            continue;
+        }
+        uint64_t count = strtoull(line.c_str(), nullptr, 10);
+        Term term(line.substr(field_pos + 1, term_pos - field_pos - 1), line.substr(term_pos + 1));
+        _counts[term] += std::max(count, uint64_t(1));
+    }
+    LOG(debug, "Loaded %zu warmup terms from '%s'", _counts.size(), file_name.c_str());
+}
+
+void
+WarmupTerms::warmup_term(IndexSearchable &searchable, const Term &term, bool unpack)
+{
+    MatchDataLayout mdl;
+    FieldSpecList fields;
+    fields.add(FieldSpec(term.first, 0, mdl.allocTermField(0)));
+    SimpleStringTerm node(term.second, term.first, 0, Weight(100));
+    FakeRequestContext requestContext;
+    Blueprint::UP blueprint = searchable.createBlueprint(requestContext, fields, node);
+    blueprint->fetchPostings(search::queryeval::ExecuteInfo::TRUE);
+    auto matchData = mdl.createMatchData();
+    SearchIterator::UP it(blueprint->createSearch(*matchData, true));
+    it->initFullRange();
+    for (uint32_t docId = it->seekFirst(1); !it->isAtEnd(); docId = it->seekNext(docId + 1)) {
+        if (unpack) {
+            it->unpack(docId);
+        }
+    }
+}
+
+vespalib::string
+WarmupTerms::file_name(const vespalib::string &base_dir)
+{
+    return base_dir + "/warmup-terms.txt";
+}
+
+}
@@ -0,0 +1,59 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace searchcorespi { class IndexSearchable; }
+
+namespace searchcorespi::index {
+
+/**
+ * Bounded record of how often (field, term) pairs have been searched
+ * while warming up new disk indexes. The most frequent terms are saved
+ * in the index base directory, so the posting lists of the hot set can
+ * be read into the page cache right away after fusion, flush and
+ * restart, instead of waiting for live queries to ask for them.
+ */
+class WarmupTerms {
+public:
+    using SP = std::shared_ptr<WarmupTerms>;
+    using Term = std::pair<vespalib::string, vespalib::string>; // (field name, term)
+    static constexpr size_t DEFAULT_MAX_TERMS = 10000;
+
+    explicit WarmupTerms(size_t max_terms = DEFAULT_MAX_TERMS);
+    ~WarmupTerms();
+
+    /**
+     * Count a search for the given term. New terms are ignored when
+     * max_terms distinct terms are already recorded.
+     */
+    void record(const vespalib::string &field, const vespalib::string &term);
+
+    /**
+     * Returns the recorded terms, most frequent first.
+     */
+    std::vector<Term> get_terms() const;
+    size_t size() const;
+
+    void save(const vespalib::string &file_name) const;
+    void load(const vespalib::string &file_name);
+
+    /**
+     * Reads the posting lists of the given term in the given searchable.
+     */
+    static void warmup_term(IndexSearchable &searchable, const Term &term, bool unpack);
+
+    static vespalib::string file_name(const vespalib::string &base_dir);
+private:
+    using Counts = std::map<Term, uint64_t>;
+    mutable std::mutex _lock;
+    Counts             _counts;
+    const size_t       _max_terms;
+};
+
+}
@@ -2,6 +2,7 @@
 #include "warmupindexcollection.h"
 #include "idiskindex.h"
 #include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/query/tree/termnodes.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -20,10 +21,11 @@ using search::queryeval::Blueprint;
 using search::queryeval::ISourceSelector;
 using search::queryeval::SearchIterator;
 using vespalib::makeClosure;
+using vespalib::makeLambdaTask;
 using vespalib::makeTask;
 using TermMap = vespalib::hash_set<vespalib::string>;
 
-class FieldTermMap : public vespalib::hash_map<uint32_t, TermMap>
+class FieldTermMap : public vespalib::hash_map<vespalib::string, TermMap>
 {
 
 };
@@ -33,13 +35,15 @@ WarmupIndexCollection::WarmupIndexCollection(const WarmupConfig & warmupConfig,
                                              ISearchableIndexCollection::SP next,
                                              IndexSearchable & warmup,
                                              vespalib::SyncableThreadExecutor & executor,
-                                             IWarmupDone & warmupDone) :
+                                             IWarmupDone & warmupDone,
+                                             index::WarmupTerms::SP warmupTerms) :
     _warmupConfig(warmupConfig),
     _prev(std::move(prev)),
     _next(std::move(next)),
     _warmup(warmup),
     _executor(executor),
     _warmupDone(warmupDone),
+    _warmupTerms(std::move(warmupTerms)),
     _warmupEndTime(vespalib::steady_clock::now() + warmupConfig.getDuration()),
     _handledTerms(std::make_unique<FieldTermMap>())
 {
@@ -50,6 +54,28 @@ WarmupIndexCollection::WarmupIndexCollection(const WarmupConfig & warmupConfig,
     }
     LOG(debug, "For %g seconds I will warm up '%s' %s unpack.", vespalib::to_s(warmupConfig.getDuration()), typeid(_warmup).name(), warmupConfig.getUnpack() ? "with" : "without");
     LOG(debug, "%s", toString().c_str());
+    prefetchRecordedTerms();
+}
+
+void
+WarmupIndexCollection::prefetchRecordedTerms()
+{
+    if (!_warmupTerms) {
+        return;
+    }
+    auto terms = _warmupTerms->get_terms();
+    LOG(debug, "Prefetching %zu recorded terms", terms.size());
+    for (auto &term : terms) {
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            (*_handledTerms)[term.first].insert(term.second);
+        }
+        _executor.execute(makeLambdaTask([this, term = std::move(term)]() {
+            if (_warmupEndTime != vespalib::steady_time()) {
+                index::WarmupTerms::warmup_term(_warmup, term, doUnpack());
+            }
+        }));
+    }
 }
 
 void
@@ -127,13 +153,16 @@ WarmupIndexCollection::fireWarmup(Task::UP task)
 }
 
 bool
-WarmupIndexCollection::handledBefore(uint32_t fieldId, const Node &term)
+WarmupIndexCollection::handledBefore(const vespalib::string &field, const Node &term)
 {
     const StringBase * sb(dynamic_cast<const StringBase *>(&term));
     if (sb != nullptr) {
         const vespalib::string & s = sb->getTerm();
+        if (_warmupTerms) {
+            _warmupTerms->record(field, s);
+        }
         std::lock_guard<std::mutex> guard(_lock);
-        TermMap::insert_result found = (*_handledTerms)[fieldId].insert(s);
+        TermMap::insert_result found = (*_handledTerms)[field].insert(s);
         return ! found.second;
     }
     return true;
@@ -164,7 +193,7 @@ WarmupIndexCollection::createBlueprint(const IRequestContext & requestContext,
         const FieldSpec & f(fields[i]);
         FieldSpec fs(f.getName(), f.getFieldId(), mdl.allocTermField(f.getFieldId()), f.isFilter());
         fsl.add(fs);
-        needWarmUp = needWarmUp || ! handledBefore(fs.getFieldId(), term);
+        needWarmUp = needWarmUp || ! handledBefore(fs.getName(), term);
     }
     if (needWarmUp) {
         Task::UP task(new WarmupTask(mdl.createMatchData(), *this));
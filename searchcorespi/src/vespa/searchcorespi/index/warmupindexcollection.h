@@ -4,6 +4,7 @@
 
 #include "isearchableindexcollection.h"
 #include "warmupconfig.h"
+#include "warmup_terms.h"
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 
@@ -19,6 +20,9 @@ public:
 /**
  * Index collection that holds a reference to the active one and a new one that
  * is to be warmed up.
+ *
+ * Terms searched during warmup are counted in the given warmup terms, and the
+ * terms recorded by earlier warmups are read from the new index right away.
  */
 class WarmupIndexCollection : public ISearchableIndexCollection,
                               public std::enable_shared_from_this<WarmupIndexCollection>
@@ -31,7 +35,8 @@ public:
                           ISearchableIndexCollection::SP next,
                           IndexSearchable & warmup,
                           vespalib::SyncableThreadExecutor & executor,
-                          IWarmupDone & warmupDone);
+                          IWarmupDone & warmupDone,
+                          index::WarmupTerms::SP warmupTerms);
     ~WarmupIndexCollection() override;
     // Implements IIndexCollection
     const ISourceSelector &getSourceSelector() const override;
@@ -89,7 +94,8 @@ private:
     };
 
     void fireWarmup(Task::UP task);
-    bool handledBefore(uint32_t fieldId, const Node &term);
+    void prefetchRecordedTerms();
+    bool handledBefore(const vespalib::string &field, const Node &term);
 
     const WarmupConfig                 _warmupConfig;
     ISearchableIndexCollection::SP     _prev;
@@ -97,6 +103,7 @@ private:
     IndexSearchable                  & _warmup;
     vespalib::SyncableThreadExecutor & _executor;
     IWarmupDone                      & _warmupDone;
+    index::WarmupTerms::SP             _warmupTerms;
     vespalib::steady_time              _warmupEndTime;
     std::mutex                         _lock;
     std::unique_ptr<FieldTermMap>      _handledTerms;
@@ -10,12 +10,14 @@
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/data/fileheader.h>
 #include <vespa/fastos/file.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("attributefilewriter_test");
 
 using search::index::DummyFileHeaderContext;
+using vespalib::compression::CompressionConfig;
 
 namespace search {
 
@@ -33,7 +35,7 @@ struct Fixture {
     const vespalib::string _desc;
     AttributeFileWriter _writer;
 
-    Fixture()
+    Fixture(CompressionConfig compression = CompressionConfig())
         : _tuneFileAttributes(),
           _fileHeaderContext(),
           _header(),
@@ -43,6 +45,7 @@ struct Fixture {
                   _header,
                   _desc)
     {
+        _tuneFileAttributes._compression = compression;
         removeTestFile();
     }
 
@@ -93,6 +96,42 @@ TEST_F("Test that buffer writer passes on written data", Fixture)
 }
 
 
+TEST_F("Test that compressed file is decompressed when loaded", Fixture(CompressionConfig(CompressionConfig::LZ4)))
+{
+    std::vector<int> a;
+    const size_t mysize = 3000000;
+    a.reserve(mysize);
+    for (uint32_t i = 0; i < mysize; ++i) {
+        a.emplace_back(i % 1000);
+    }
+    EXPECT_TRUE(f._writer.open(testFileName));
+    std::unique_ptr<BufferWriter> writer(f._writer.allocBufferWriter());
+    writer->write(&a[0], a.size() * sizeof(int));
+    writer->flush();
+    writer.reset();
+    f._writer.close();
+    {
+        FastOS_File file(testFileName.c_str());
+        EXPECT_TRUE(file.OpenReadOnly());
+        EXPECT_LESS(file.GetSize(), int64_t(a.size() * sizeof(int) / 2));
+    }
+    fileutil::LoadedBuffer::UP loaded(FileUtil::loadFile(testFileName));
+    EXPECT_EQUAL(a.size() * sizeof(int), loaded->size());
+    EXPECT_TRUE(memcmp(&a[0], loaded->buffer(), loaded->size()) == 0);
+    EXPECT_EQUAL(f._desc, loaded->getHeader().getTag("desc").asString());
+    EXPECT_FALSE(loaded->getHeader().hasTag("compression.type"));
+
+    auto file = FileUtil::openFile(testFileName);
+    vespalib::FileHeader header;
+    size_t headerLen = header.readFile(*file);
+    EXPECT_EQUAL(f._desc, header.getTag("desc").asString());
+    EXPECT_EQUAL(int64_t(headerLen + a.size() * sizeof(int)), file->GetSize());
+    std::vector<int> b(mysize);
+    file->ReadBuf(&b[0], b.size() * sizeof(int), headerLen);
+    EXPECT_TRUE(a == b);
+}
+
+
 TEST_F("Test that we can pass buffer directly", Fixture)
 {
     using Buffer = IAttributeFileWriter::Buffer;
@@ -271,6 +271,24 @@ AttributeManagerTest::testConfigConvert()
         a.ismutable = true;
         EXPECT_TRUE(CC::convert(a).isMutable());
     }
+    { // paged
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).paged());
+        a.paged = true;
+        EXPECT_TRUE(CC::convert(a).paged());
+    }
+    { // compact
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).compact());
+        a.compact = true;
+        EXPECT_TRUE(CC::convert(a).compact());
+    }
+    { // mapped
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).mapped());
+        a.mapped = true;
+        EXPECT_TRUE(CC::convert(a).mapped());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
@@ -12,9 +12,9 @@ using BitVectorSP = BitVectorSearchCache::BitVectorSP;
 using Entry = BitVectorSearchCache::Entry;
 
 Entry::SP
-makeEntry()
+makeEntry(uint32_t numBits = 5)
 {
-    return std::make_shared<Entry>(IDocumentMetaStoreContext::IReadGuard::UP(), BitVector::create(5), 10);
+    return std::make_shared<Entry>(IDocumentMetaStoreContext::IReadGuard::UP(), BitVector::create(numBits), 10);
 }
 
 struct Fixture {
@@ -60,4 +60,39 @@ TEST_F("require that cache can be cleared", Fixture)
     EXPECT_TRUE(f.cache.find("bar").get() == nullptr);
 }
 
+TEST("require that memory usage of cached bit vectors is tracked")
+{
+    BitVectorSearchCache cache;
+    auto entry = makeEntry(1000);
+    cache.insert("foo", entry);
+    cache.insert("bar", Entry::SP());
+    EXPECT_EQUAL(entry->bitVector->getFileBytes(), cache.getMemoryUsage());
+    cache.clear();
+    EXPECT_EQUAL(0u, cache.getMemoryUsage());
+}
+
+TEST("require that least recently used bit vectors are evicted when max memory usage is exceeded")
+{
+    size_t entrySize = makeEntry(1000)->bitVector->getFileBytes();
+    BitVectorSearchCache cache(2 * entrySize);
+    cache.insert("foo", makeEntry(1000));
+    cache.insert("bar", makeEntry(1000));
+    EXPECT_TRUE(cache.find("foo").get() != nullptr);
+    cache.insert("baz", makeEntry(1000));
+    EXPECT_EQUAL(2u, cache.size());
+    EXPECT_EQUAL(2 * entrySize, cache.getMemoryUsage());
+    EXPECT_TRUE(cache.find("foo").get() != nullptr);
+    EXPECT_TRUE(cache.find("bar").get() == nullptr);
+    EXPECT_TRUE(cache.find("baz").get() != nullptr);
+}
+
+TEST("require that bit vector larger than max memory usage is not cached")
+{
+    BitVectorSearchCache cache(makeEntry(1000)->bitVector->getFileBytes());
+    cache.insert("foo", makeEntry(1000));
+    cache.insert("bar", makeEntry(100000));
+    EXPECT_EQUAL(1u, cache.size());
+    EXPECT_TRUE(cache.find("foo").get() != nullptr);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,200 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/document/update/arithmeticvalueupdate.h>
+#include <vespa/searchcommon/attribute/i_search_context.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/singlecompactintegerattribute.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/vespalib/io/fileutil.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("compact_integer_attribute_test");
+
+using document::ArithmeticValueUpdate;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::IntegerAttributeTemplate;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+
+using CompactAttribute = search::SingleValueCompactIntegerAttribute<IntegerAttributeTemplate<int64_t>>;
+
+constexpr uint32_t block_size = CompactAttribute::BLOCK_SIZE;
+constexpr int64_t undefined = std::numeric_limits<int64_t>::min();
+
+Config
+make_config(bool compact)
+{
+    Config cfg(BasicType::INT64, CollectionType::SINGLE);
+    cfg.set_compact(compact);
+    return cfg;
+}
+
+class CompactIntegerAttributeTest : public ::testing::Test {
+protected:
+    std::shared_ptr<AttributeVector> _compact;
+    std::shared_ptr<AttributeVector> _plain;
+
+    CompactIntegerAttributeTest()
+        : _compact(AttributeFactory::createAttribute("compact", make_config(true))),
+          _plain(AttributeFactory::createAttribute("plain", make_config(false)))
+    {
+    }
+    ~CompactIntegerAttributeTest() override;
+
+    IntegerAttribute &compact() { return dynamic_cast<IntegerAttribute &>(*_compact); }
+    IntegerAttribute &plain() { return dynamic_cast<IntegerAttribute &>(*_plain); }
+
+    void add_docs(uint32_t num_docs) {
+        _compact->addDocs(num_docs);
+        _plain->addDocs(num_docs);
+    }
+    void update(uint32_t doc, int64_t value) {
+        compact().update(doc, value);
+        plain().update(doc, value);
+    }
+    void commit() {
+        _compact->commit();
+        _plain->commit();
+    }
+    void assert_same_values() {
+        ASSERT_EQ(_plain->getNumDocs(), _compact->getNumDocs());
+        for (uint32_t doc = 0; doc < _plain->getNumDocs(); ++doc) {
+            ASSERT_EQ(_plain->getInt(doc), _compact->getInt(doc)) << "doc " << doc;
+        }
+    }
+};
+
+CompactIntegerAttributeTest::~CompactIntegerAttributeTest() = default;
+
+TEST_F(CompactIntegerAttributeTest, compact_attribute_is_created_from_config)
+{
+    EXPECT_TRUE(dynamic_cast<CompactAttribute *>(_compact.get()) != nullptr);
+    EXPECT_TRUE(dynamic_cast<CompactAttribute *>(_plain.get()) == nullptr);
+}
+
+TEST_F(CompactIntegerAttributeTest, values_are_kept_across_packing_and_updates)
+{
+    uint32_t num_docs = 10 * block_size + 17;
+    add_docs(num_docs);
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        if (doc % 7 != 0) {
+            update(doc, (doc / block_size == 3) ? 42 : doc % 100);
+        }
+    }
+    update(5 * block_size + 1, -1000000000000);
+    update(6 * block_size + 2, std::numeric_limits<int64_t>::max());
+    commit();
+    assert_same_values();
+    // Values outside the frame of already packed blocks
+    update(1, 1000000);
+    update(3 * block_size, 43);
+    update(3 * block_size + 1, undefined + 1);
+    update(4 * block_size + 5, -3);
+    assert_same_values();
+    commit();
+    assert_same_values();
+    compact().apply(2, ArithmeticValueUpdate(ArithmeticValueUpdate::Add, 10));
+    plain().apply(2, ArithmeticValueUpdate(ArithmeticValueUpdate::Add, 10));
+    _compact->clearDoc(8);
+    _plain->clearDoc(8);
+    commit();
+    assert_same_values();
+    add_docs(3 * block_size);
+    update(num_docs + 1, 12345);
+    commit();
+    assert_same_values();
+}
+
+TEST_F(CompactIntegerAttributeTest, small_values_use_less_memory)
+{
+    uint32_t num_docs = 100 * block_size;
+    add_docs(num_docs);
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        update(doc, 1000000000000 + (doc * 31) % 1000);
+    }
+    commit();
+    assert_same_values();
+    _compact->commit(true);
+    _plain->commit(true);
+    EXPECT_LT(_compact->getStatus().getUsed() * 2, _plain->getStatus().getUsed());
+}
+
+TEST_F(CompactIntegerAttributeTest, search_context_decodes_values)
+{
+    uint32_t num_docs = 4 * block_size;
+    add_docs(num_docs);
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        update(doc, doc % 50);
+    }
+    commit();
+    auto sc = _compact->createSearchContext(std::make_unique<QueryTermSimple>("[10;19]", QueryTermSimple::WORD),
+                                            SearchContextParams());
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        uint32_t value = doc % 50;
+        EXPECT_EQ(value >= 10 && value <= 19, sc->matches(doc)) << "doc " << doc;
+    }
+}
+
+TEST_F(CompactIntegerAttributeTest, lid_space_can_be_shrunk_into_packed_block)
+{
+    uint32_t num_docs = 4 * block_size;
+    add_docs(num_docs);
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        update(doc, doc % 10);
+    }
+    commit();
+    uint32_t wanted_lid_limit = 2 * block_size + 10;
+    for (auto &attr : {_compact, _plain}) {
+        attr->compactLidSpace(wanted_lid_limit);
+        attr->commit();
+        ASSERT_TRUE(attr->canShrinkLidSpace());
+        attr->shrinkLidSpace();
+    }
+    EXPECT_EQ(wanted_lid_limit, _compact->getNumDocs());
+    add_docs(block_size);
+    update(wanted_lid_limit + 1, 1000);
+    commit();
+    assert_same_values();
+    EXPECT_EQ(undefined, _compact->getInt(wanted_lid_limit));
+}
+
+TEST_F(CompactIntegerAttributeTest, saved_file_is_compatible_with_plain_attribute)
+{
+    uint32_t num_docs = 3 * block_size + 5;
+    add_docs(num_docs);
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        update(doc, (doc % 3 == 0) ? undefined : doc * 3);
+    }
+    commit();
+    ASSERT_TRUE(_compact->save("compact_saved"));
+    auto loaded_plain = AttributeFactory::createAttribute("compact_saved", make_config(false));
+    ASSERT_TRUE(loaded_plain->load());
+    ASSERT_TRUE(_plain->save("plain_saved"));
+    auto loaded_compact = AttributeFactory::createAttribute("plain_saved", make_config(true));
+    ASSERT_TRUE(loaded_compact->load());
+    ASSERT_EQ(num_docs, loaded_plain->getNumDocs());
+    ASSERT_EQ(num_docs, loaded_compact->getNumDocs());
+    for (uint32_t doc = 0; doc < num_docs; ++doc) {
+        EXPECT_EQ(_plain->getInt(doc), loaded_plain->getInt(doc));
+        EXPECT_EQ(_plain->getInt(doc), loaded_compact->getInt(doc));
+    }
+    // The loaded attribute accepts new documents and updates.
+    uint32_t doc = 0;
+    loaded_compact->addDoc(doc);
+    EXPECT_EQ(num_docs, doc);
+    dynamic_cast<IntegerAttribute &>(*loaded_compact).update(1, 7);
+    loaded_compact->commit();
+    EXPECT_EQ(7, loaded_compact->getInt(1));
+    EXPECT_EQ(undefined, loaded_compact->getInt(doc));
+    vespalib::unlink("compact_saved.dat");
+    vespalib::unlink("plain_saved.dat");
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
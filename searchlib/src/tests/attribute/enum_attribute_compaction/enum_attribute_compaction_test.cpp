@@ -6,6 +6,7 @@
 #include <vespa/searchlib/attribute/integerbase.h>
 #include <vespa/searchlib/attribute/stringbase.h>
 #include <vespa/searchlib/test/weighted_type_test_utils.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("enum_attribute_compaction_test");
@@ -13,6 +14,7 @@ LOG_SETUP("enum_attribute_compaction_test");
 using search::IntegerAttribute;
 using search::StringAttribute;
 using search::AttributeVector;
+using search::CompactionStrategy;
 using search::attribute::Config;
 using search::attribute::BasicType;
 using search::attribute::CollectionType;
@@ -53,12 +55,15 @@ struct TestData<StringAttribute> {
 class CompactionTestBase : public ::testing::TestWithParam<CollectionType::Type> {
 public:
     std::shared_ptr<AttributeVector> _v;
+    vespalib::ThreadStackExecutor _executor;
 
     CompactionTestBase()
-        : _v()
+        : _v(),
+          _executor(4, 128 * 1024)
     {
     }
     void SetUp() override;
+    void setup_incremental_compaction(uint32_t max_moves_per_step);
     virtual BasicType get_basic_type() const = 0;
     CollectionType get_collection_type() const noexcept { return GetParam(); }
     void add_docs(uint32_t num_docs);
@@ -73,6 +78,16 @@ CompactionTestBase::SetUp()
     _v = search::AttributeFactory::createAttribute("test", cfg);
 }
 
+void
+CompactionTestBase::setup_incremental_compaction(uint32_t max_moves_per_step)
+{
+    Config cfg(get_basic_type(), get_collection_type());
+    cfg.setFastSearch(true);
+    cfg.setCompactionStrategy(CompactionStrategy(0.2, 0.2, max_moves_per_step));
+    _v = search::AttributeFactory::createAttribute("test", cfg);
+    _v->setCompactionExecutor(&_executor);
+}
+
 void
 CompactionTestBase::add_docs(uint32_t num_docs)
 {
@@ -105,7 +120,7 @@ public:
     void set_values(uint32_t doc_id);
     void check_values(uint32_t doc_id);
     void check_cleared_values(uint32_t doc_id);
-    void test_enum_store_compaction();
+    void test_enum_store_compaction(uint32_t doc_count_scale = 1);
     BasicType get_basic_type() const override { return TestData<VectorType>::basic_type; }
 };
 
@@ -172,12 +187,12 @@ CompactionTest<VectorType>::check_cleared_values(uint32_t doc_id)
 
 template <typename VectorType>
 void
-CompactionTest<VectorType>::test_enum_store_compaction()
+CompactionTest<VectorType>::test_enum_store_compaction(uint32_t doc_count_scale)
 {
     constexpr size_t DEAD_BYTES_SLACK = 0x10000u;
     constexpr uint32_t canary_stride = 256;
     uint32_t dead_limit = DEAD_BYTES_SLACK / 8;
-    uint32_t doc_count = dead_limit * 3;
+    uint32_t doc_count = dead_limit * 3 * doc_count_scale;
     if (_v->hasMultiValue() || std::is_same_v<VectorType,StringAttribute>) {
         doc_count /= 2;
     }
@@ -220,6 +235,12 @@ TEST_P(IntegerCompactionTest, compact)
     test_enum_store_compaction();
 }
 
+TEST_P(IntegerCompactionTest, compact_incrementally)
+{
+    setup_incremental_compaction(64);
+    test_enum_store_compaction(3);
+}
+
 VESPA_GTEST_INSTANTIATE_TEST_SUITE_P(IntegerCompactionTestSet, IntegerCompactionTest, ::testing::Values(CollectionType::SINGLE, CollectionType::ARRAY, CollectionType::WSET));
 
 using StringCompactionTest = CompactionTest<StringAttribute>;
@@ -229,6 +250,12 @@ TEST_P(StringCompactionTest, compact)
     test_enum_store_compaction();
 }
 
+TEST_P(StringCompactionTest, compact_incrementally)
+{
+    setup_incremental_compaction(64);
+    test_enum_store_compaction(3);
+}
+
 VESPA_GTEST_INSTANTIATE_TEST_SUITE_P(StringCompactionTestSet, StringCompactionTest, ::testing::Values(CollectionType::SINGLE, CollectionType::ARRAY, CollectionType::WSET));
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,119 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/searchcommon/attribute/i_search_context.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/loadedenumvalue.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("loaded_enum_value_test");
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::LoadedEnumAttribute;
+using search::attribute::LoadedEnumAttributeVector;
+using search::attribute::SearchContextParams;
+using search::attribute::sortLoadedByEnum;
+
+namespace {
+
+LoadedEnumAttributeVector
+make_loaded(size_t num_values, uint32_t num_enums)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> enum_dist(0, num_enums - 1);
+    LoadedEnumAttributeVector loaded;
+    loaded.reserve(num_values);
+    for (uint32_t doc_id = 0; doc_id < num_values; ++doc_id) {
+        loaded.push_back(LoadedEnumAttribute(enum_dist(gen), doc_id, 1));
+    }
+    std::shuffle(loaded.begin(), loaded.end(), gen);
+    return loaded;
+}
+
+void
+assert_sorted_as_sequential(size_t num_values, uint32_t num_enums)
+{
+    auto expected = make_loaded(num_values, num_enums);
+    auto actual = expected;
+    sortLoadedByEnum(expected);
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    sortLoadedByEnum(actual, &executor);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].getEnum(), actual[i].getEnum()) << "i=" << i;
+        ASSERT_EQ(expected[i].getDocId(), actual[i].getDocId()) << "i=" << i;
+    }
+}
+
+}
+
+TEST(LoadedEnumValueTest, parallel_sort_of_small_vector_matches_sequential_sort)
+{
+    assert_sorted_as_sequential(1000, 10);
+}
+
+TEST(LoadedEnumValueTest, parallel_sort_of_large_vector_matches_sequential_sort)
+{
+    assert_sorted_as_sequential(3 * 256 * 1024 + 17, 1000);
+}
+
+TEST(LoadedEnumValueTest, parallel_sort_of_vector_with_few_enums_matches_sequential_sort)
+{
+    assert_sorted_as_sequential(5 * 256 * 1024, 3);
+}
+
+TEST(LoadedEnumValueTest, fast_search_attribute_loaded_with_executor_has_posting_lists)
+{
+    constexpr uint32_t num_docs = 600 * 1024;
+    vespalib::mkdir("loaded_enum_value", false);
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    cfg.setFastSearch(true);
+    {
+        auto attr = AttributeFactory::createAttribute("loaded_enum_value/a", cfg);
+        attr->addDocs(num_docs);
+        auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+        for (uint32_t doc_id = 0; doc_id < num_docs; ++doc_id) {
+            int_attr.update(doc_id, doc_id % 7);
+        }
+        attr->commit();
+        ASSERT_TRUE(attr->save());
+    }
+    auto attr = AttributeFactory::createAttribute("loaded_enum_value/a", cfg);
+    ASSERT_TRUE(attr->isEnumeratedSaveFormat());
+    vespalib::ThreadStackExecutor executor(4, 128 * 1024);
+    ASSERT_TRUE(attr->load(&executor));
+    EXPECT_EQ(num_docs, attr->getNumDocs());
+    EXPECT_EQ(5, attr->getInt(12));
+    auto ctx = attr->getSearch(std::make_unique<QueryTermSimple>("5", QueryTermSimple::WORD), SearchContextParams());
+    ctx->fetchPostings(search::queryeval::ExecuteInfo::TRUE);
+    search::fef::TermFieldMatchData tfmd;
+    auto itr = ctx->createIterator(&tfmd, true);
+    itr->initRange(1, num_docs);
+    uint32_t hits = 0;
+    uint32_t expected_doc_id = 5;
+    for (uint32_t doc_id = itr->seekFirst(1); !itr->isAtEnd(); doc_id = itr->seekNext(doc_id + 1)) {
+        EXPECT_EQ(expected_doc_id, doc_id);
+        expected_doc_id += 7;
+        ++hits;
+    }
+    EXPECT_EQ((num_docs - 1 - 5) / 7 + 1, hits);
+    vespalib::rmdir("loaded_enum_value", true);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
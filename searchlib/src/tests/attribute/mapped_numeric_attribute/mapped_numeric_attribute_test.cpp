@@ -0,0 +1,222 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/document/update/arithmeticvalueupdate.h>
+#include <vespa/searchcommon/attribute/i_search_context.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/floatbase.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/singlemappednumericattribute.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/vespalib/io/fileutil.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("mapped_numeric_attribute_test");
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::FloatingPointAttribute;
+using search::FloatingPointAttributeTemplate;
+using search::IntegerAttribute;
+using search::IntegerAttributeTemplate;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+
+using MappedAttribute = search::SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int64_t>>;
+
+constexpr uint32_t num_docs = 5000;
+constexpr int64_t undefined = std::numeric_limits<int64_t>::min();
+
+namespace {
+
+Config
+make_config(bool mapped, BasicType type = BasicType::INT64)
+{
+    Config cfg(type, CollectionType::SINGLE);
+    cfg.set_mapped(mapped);
+    return cfg;
+}
+
+int64_t
+value_of(uint32_t doc)
+{
+    return (doc % 11 == 0) ? undefined : static_cast<int64_t>(doc) * 1000;
+}
+
+void
+save_plain(const vespalib::string &name)
+{
+    auto attr = AttributeFactory::createAttribute(name, make_config(false));
+    attr->addDocs(num_docs);
+    auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        int_attr.update(doc, value_of(doc));
+    }
+    attr->commit();
+    ASSERT_TRUE(attr->save());
+}
+
+std::shared_ptr<AttributeVector>
+load(const vespalib::string &name, bool mapped)
+{
+    auto attr = AttributeFactory::createAttribute(name, make_config(mapped));
+    EXPECT_TRUE(attr->load());
+    return attr;
+}
+
+const MappedAttribute &
+as_mapped(const AttributeVector &attr)
+{
+    return dynamic_cast<const MappedAttribute &>(attr);
+}
+
+}
+
+class MappedNumericAttributeTest : public ::testing::Test {
+protected:
+    MappedNumericAttributeTest() {
+        save_plain("plain");
+    }
+    ~MappedNumericAttributeTest() override;
+};
+
+MappedNumericAttributeTest::~MappedNumericAttributeTest()
+{
+    vespalib::unlink("plain.dat");
+    vespalib::unlink("saved.dat");
+}
+
+TEST_F(MappedNumericAttributeTest, mapped_attribute_is_created_from_config)
+{
+    auto mapped = AttributeFactory::createAttribute("mapped", make_config(true));
+    EXPECT_TRUE(dynamic_cast<MappedAttribute *>(mapped.get()) != nullptr);
+    auto plain = AttributeFactory::createAttribute("plain", make_config(false));
+    EXPECT_TRUE(dynamic_cast<MappedAttribute *>(plain.get()) == nullptr);
+}
+
+TEST_F(MappedNumericAttributeTest, values_are_read_in_place_from_saved_file)
+{
+    auto attr = load("plain", true);
+    EXPECT_EQ(num_docs, as_mapped(*attr).getMappedDocs());
+    ASSERT_EQ(num_docs, attr->getNumDocs());
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        ASSERT_EQ(value_of(doc), attr->getInt(doc)) << "doc " << doc;
+    }
+}
+
+TEST_F(MappedNumericAttributeTest, updates_and_added_documents_do_not_change_mapped_file)
+{
+    auto attr = load("plain", true);
+    auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+    int_attr.update(3, 17);
+    int_attr.apply(4, document::ArithmeticValueUpdate(document::ArithmeticValueUpdate::Add, 5));
+    attr->clearDoc(5);
+    uint32_t doc = 0;
+    attr->addDoc(doc);
+    EXPECT_EQ(num_docs, doc);
+    int_attr.update(doc, 42);
+    attr->commit();
+    EXPECT_EQ(17, attr->getInt(3));
+    EXPECT_EQ(value_of(4) + 5, attr->getInt(4));
+    EXPECT_EQ(undefined, attr->getInt(5));
+    EXPECT_EQ(42, attr->getInt(num_docs));
+    EXPECT_EQ(value_of(6), attr->getInt(6));
+
+    auto plain = load("plain", false);
+    EXPECT_EQ(num_docs, plain->getNumDocs());
+    EXPECT_EQ(value_of(3), plain->getInt(3));
+    EXPECT_EQ(value_of(4), plain->getInt(4));
+
+    ASSERT_TRUE(attr->save("saved"));
+    auto saved = load("saved", false);
+    ASSERT_EQ(num_docs + 1, saved->getNumDocs());
+    for (uint32_t lid = 0; lid <= num_docs; ++lid) {
+        ASSERT_EQ(attr->getInt(lid), saved->getInt(lid)) << "lid " << lid;
+    }
+}
+
+TEST_F(MappedNumericAttributeTest, search_context_covers_mapped_and_added_documents)
+{
+    auto attr = load("plain", true);
+    attr->addDocs(10);
+    dynamic_cast<IntegerAttribute &>(*attr).update(num_docs + 2, 12000);
+    attr->commit();
+    auto sc = attr->createSearchContext(std::make_unique<QueryTermSimple>("[10000;20000]", QueryTermSimple::WORD),
+                                        SearchContextParams());
+    for (uint32_t doc = 1; doc < num_docs; ++doc) {
+        int64_t value = value_of(doc);
+        EXPECT_EQ(value >= 10000 && value <= 20000, sc->matches(doc)) << "doc " << doc;
+    }
+    EXPECT_TRUE(sc->matches(num_docs + 2));
+    EXPECT_FALSE(sc->matches(num_docs + 3));
+}
+
+TEST_F(MappedNumericAttributeTest, lid_space_can_be_shrunk_into_mapped_documents)
+{
+    auto attr = load("plain", true);
+    uint32_t wanted_lid_limit = num_docs / 2;
+    attr->compactLidSpace(wanted_lid_limit);
+    attr->commit();
+    ASSERT_TRUE(attr->canShrinkLidSpace());
+    attr->shrinkLidSpace();
+    EXPECT_EQ(wanted_lid_limit, attr->getNumDocs());
+    EXPECT_EQ(wanted_lid_limit, as_mapped(*attr).getMappedDocs());
+    uint32_t doc = 0;
+    attr->addDoc(doc);
+    EXPECT_EQ(wanted_lid_limit, doc);
+    EXPECT_EQ(undefined, attr->getInt(doc));
+    dynamic_cast<IntegerAttribute &>(*attr).update(doc, 7);
+    attr->commit();
+    EXPECT_EQ(7, attr->getInt(doc));
+    EXPECT_EQ(value_of(wanted_lid_limit - 1), attr->getInt(wanted_lid_limit - 1));
+}
+
+TEST_F(MappedNumericAttributeTest, enumerated_file_is_loaded_to_heap)
+{
+    Config cfg = make_config(false);
+    cfg.setFastSearch(true);
+    {
+        auto attr = AttributeFactory::createAttribute("enumerated", cfg);
+        attr->addDocs(100);
+        auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+        for (uint32_t doc = 0; doc < 100; ++doc) {
+            int_attr.update(doc, doc % 3);
+        }
+        attr->commit();
+        ASSERT_TRUE(attr->save());
+    }
+    auto attr = load("enumerated", true);
+    EXPECT_EQ(0u, as_mapped(*attr).getMappedDocs());
+    ASSERT_EQ(100u, attr->getNumDocs());
+    for (uint32_t doc = 0; doc < 100; ++doc) {
+        EXPECT_EQ(doc % 3, attr->getInt(doc));
+    }
+    vespalib::unlink("enumerated.dat");
+    vespalib::unlink("enumerated.udat");
+}
+
+TEST_F(MappedNumericAttributeTest, floating_point_values_are_mapped)
+{
+    {
+        auto attr = AttributeFactory::createAttribute("float", make_config(false, BasicType::DOUBLE));
+        attr->addDocs(100);
+        for (uint32_t doc = 0; doc < 100; ++doc) {
+            dynamic_cast<FloatingPointAttribute &>(*attr).update(doc, doc * 0.5);
+        }
+        attr->commit();
+        ASSERT_TRUE(attr->save());
+    }
+    auto attr = AttributeFactory::createAttribute("float", make_config(true, BasicType::DOUBLE));
+    ASSERT_TRUE(attr->load());
+    using MappedDouble = search::SingleValueMappedNumericAttribute<FloatingPointAttributeTemplate<double>>;
+    EXPECT_EQ(100u, dynamic_cast<const MappedDouble &>(*attr).getMappedDocs());
+    for (uint32_t doc = 0; doc < 100; ++doc) {
+        EXPECT_EQ(doc * 0.5, attr->getFloat(doc));
+    }
+    vespalib::unlink("float.dat");
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
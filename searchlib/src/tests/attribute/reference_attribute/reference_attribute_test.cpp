@@ -407,6 +407,36 @@ TEST_F(ReferenceAttributeTest, notifyReferencedPut_and_notifyReferencedRemove_ch
     assertLids(11, { });
 }
 
+TEST_F(ReferenceAttributeTest, reverse_mapping_can_be_compacted)
+{
+    preparePopulateTargetLids(*this);
+    auto factory = std::make_shared<MyGidToLidMapperFactory>();
+    setGidToLidMapperFactory(factory);
+    search::attribute::Status oldStatus = getStatus();
+    search::attribute::Status newStatus = oldStatus;
+    uint64_t iter = 0;
+    uint64_t iterLimit = 100000;
+    for (; iter < iterLimit; ++iter) {
+        set(5, toGid(doc1));
+        commit();
+        clear(5);
+        newStatus = getStatus();
+        if (newStatus.getUsed() < oldStatus.getUsed()) {
+            break;
+        }
+        oldStatus = newStatus;
+    }
+    EXPECT_GT(iterLimit, iter);
+    LOG(info, "iter = %" PRIu64 ", memory usage %" PRIu64 ", -> %" PRIu64,
+        iter, oldStatus.getUsed(), newStatus.getUsed());
+    assertLids(10, { 1, 3 });
+    assertLids(17, { 2 });
+    set(5, toGid(doc1));
+    commit();
+    assertLids(10, { 1, 3, 5 });
+    assertTargetLid(5, 10);
+}
+
 TEST_F(ReferenceAttributeTest, unique_gids_are_tracked)
 {
     EXPECT_EQ(0u, getUniqueGids());
@@ -4,6 +4,7 @@
 #include <vespa/searchlib/attribute/attributeiterators.h>
 #include <vespa/searchlib/attribute/searchcontextelementiterator.h>
 #include <vespa/searchlib/attribute/flagattribute.h>
+#include <vespa/searchlib/attribute/min_max_block_index.h>
 #include <vespa/searchlib/attribute/singleboolattribute.h>
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
 #include <vespa/searchlib/attribute/singlestringattribute.h>
@@ -272,6 +273,10 @@ private:
     void single_bool_attribute_search_context_handles_true_and_false_queries();
     void single_bool_attribute_search_iterator_handles_true_and_false_queries();
 
+    template <typename VectorType>
+    void requireThatRangeSearchIsWorkingAcrossMinMaxBlocks(const vespalib::string &name, const Config &cfg);
+    void requireThatRangeSearchIsWorkingAcrossMinMaxBlocks();
+
     // init maps with config objects
     void initIntegerConfig();
     void initFloatConfig();
@@ -2011,6 +2016,65 @@ SearchContextTest::SearchContextTest() :
 
 SearchContextTest::~SearchContextTest() = default;
 
+template <typename VectorType>
+void
+SearchContextTest::requireThatRangeSearchIsWorkingAcrossMinMaxBlocks(const vespalib::string &name, const Config &cfg)
+{
+    const uint32_t blockSize = attribute::MinMaxBlockIndexBase::BLOCK_SIZE;
+    const uint32_t numDocs = 5 * blockSize;
+    AttributePtr a = AttributeFactory::createAttribute(name, cfg);
+    auto &va = dynamic_cast<VectorType &>(*a);
+    LOG(info, "requireThatRangeSearchIsWorkingAcrossMinMaxBlocks: vector '%s'", a->getName().c_str());
+    addDocs(*a, numDocs);
+    for (uint32_t doc = 1; doc <= numDocs; ++doc) {
+        va.update(doc, (doc / blockSize) * 1000 + doc % 100);
+    }
+    a->commit(true);
+    auto expectRange = [&](const vespalib::string &term, double low, double high) {
+        DocSet expected;
+        for (uint32_t doc = 1; doc <= numDocs; ++doc) {
+            double value = a->getFloat(doc);
+            if ((low <= value) && (value <= high)) {
+                expected.put(doc);
+            }
+        }
+        performRangeSearch(va, term, expected);
+    };
+    TEST_DO(expectRange("[2000;2050]", 2000, 2050));
+    TEST_DO(expectRange("[650;1099]", 650, 1099));
+    TEST_DO(expectRange("[5000;6000]", 5000, 6000));
+
+    // Value moved into a block that could not match before
+    va.update(10, 2025);
+    a->commit();
+    TEST_DO(expectRange("[2000;2050]", 2000, 2050));
+
+    // Bounds of a block are tightened when its min and max values are overwritten
+    for (uint32_t doc = 3 * blockSize; doc < 4 * blockSize; ++doc) {
+        va.update(doc, 3000);
+    }
+    a->commit();
+    TEST_DO(expectRange("[3050;3099]", 3050, 3099));
+    TEST_DO(expectRange("3000", 3000, 3000));
+
+    // Cleared documents (undefined values) never match
+    a->clearDoc(blockSize + 1);
+    a->commit();
+    TEST_DO(expectRange("<1050", -1000000, 1049));
+}
+
+void
+SearchContextTest::requireThatRangeSearchIsWorkingAcrossMinMaxBlocks()
+{
+    requireThatRangeSearchIsWorkingAcrossMinMaxBlocks<IntegerAttribute>("s-int32", _integerCfg["s-int32"]);
+    {
+        Config cfg(BasicType::INT64, CollectionType::SINGLE);
+        cfg.setIsFilter(true);
+        requireThatRangeSearchIsWorkingAcrossMinMaxBlocks<IntegerAttribute>("s-int64-filter", cfg);
+    }
+    requireThatRangeSearchIsWorkingAcrossMinMaxBlocks<FloatingPointAttribute>("s-float", _floatCfg["s-float"]);
+}
+
 int
 SearchContextTest::Main()
 {
@@ -2035,6 +2099,7 @@ SearchContextTest::Main()
     TEST_DO(requireThatOutOfBoundsSearchTermGivesZeroHits());
     TEST_DO(single_bool_attribute_search_context_handles_true_and_false_queries());
     TEST_DO(single_bool_attribute_search_iterator_handles_true_and_false_queries());
+    TEST_DO(requireThatRangeSearchIsWorkingAcrossMinMaxBlocks());
 
     TEST_DONE();
 }
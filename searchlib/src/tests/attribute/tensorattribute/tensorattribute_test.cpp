@@ -23,6 +23,7 @@
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/util/bufferwriter.h>
 
@@ -154,6 +155,12 @@ public:
     void expect_complete_add(uint32_t exp_docid, const DoubleVector& exp_vector) const {
         expect_entry(exp_docid, exp_vector, _complete_adds);
     }
+    void expect_prepare_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _prepare_adds);
+    }
+    void expect_complete_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _complete_adds);
+    }
     generation_t get_transfer_gen() const { return _transfer_gen; }
     generation_t get_trim_gen() const { return _trim_gen; }
     size_t memory_usage_cnt() const { return _memory_usage_cnt; }
@@ -434,10 +441,10 @@ struct Fixture {
         EXPECT_TRUE(saveok);
     }
 
-    void load() {
+    void load(vespalib::Executor *executor = nullptr) {
         _tensorAttr = makeAttr();
         _attr = _tensorAttr;
-        bool loadok = _attr->load();
+        bool loadok = _attr->load(executor);
         EXPECT_TRUE(loadok);
     }
 
@@ -848,6 +855,20 @@ TEST_F("onLoad() reconstructs nearest neighbor index if save file does not exist
     index.expect_adds({{1, {3, 5}}, {2, {7, 9}}});
 }
 
+TEST_F("onLoad() reconstructs nearest neighbor index in two phases when executor is given", DenseTensorAttributeMockIndex)
+{
+    f.set_example_tensors();
+    f.save();
+    EXPECT_FALSE(vespalib::fileExists(attr_name + ".nnidx"));
+
+    vespalib::ThreadStackExecutor executor(1, 128 * 1024);
+    f.load(&executor); // index is reconstructed by preparing in executor and completing in loading thread
+    auto& index = f.mock_index();
+    index.expect_adds({});
+    index.expect_prepare_adds({{1, {3, 5}}, {2, {7, 9}}});
+    index.expect_complete_adds({{1, {3, 5}}, {2, {7, 9}}});
+}
+
 TEST_F("onLoads() ignores saved nearest neighbor index if not enabled in config", DenseTensorAttributeMockIndex)
 {
     f.save_example_tensors_with_mock_index();
@@ -906,13 +927,13 @@ public:
         return EngineOrFactory::get().from_spec(spec);
     }
 
-    std::unique_ptr<NearestNeighborBlueprint> make_blueprint(double brute_force_limit = 0.05) {
+    std::unique_ptr<NearestNeighborBlueprint> make_blueprint(double brute_force_limit = 0.05, double post_filter_limit = 1.0) {
         search::queryeval::FieldSpec field("foo", 0, 0);
         auto bp = std::make_unique<NearestNeighborBlueprint>(
             field,
             as_dense_tensor(),
             createDenseTensor(vec_2d(17, 42)),
-            3, true, 5, brute_force_limit);
+            3, true, 5, brute_force_limit, post_filter_limit);
         EXPECT_EQUAL(11u, bp->getState().estimate().estHits);
         EXPECT_TRUE(bp->may_approximate());
         return bp;
@@ -955,6 +976,25 @@ TEST_F("NN blueprint handles weak filter", NearestNeighborBlueprintFixture)
     bp->set_global_filter(*weak_filter);
     EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
     EXPECT_TRUE(bp->may_approximate());
+    EXPECT_FALSE(bp->uses_post_filter());
+}
+
+TEST_F("NN blueprint handles weak filter triggering post filtering", NearestNeighborBlueprintFixture)
+{
+    auto bp = f.make_blueprint(0.05, 0.5);
+    auto filter = search::BitVector::create(11);
+    filter->setBit(1);
+    filter->setBit(3);
+    filter->setBit(5);
+    filter->setBit(7);
+    filter->setBit(9);
+    filter->setBit(10);
+    filter->invalidateCachedCount();
+    auto weak_filter = GlobalFilter::create(std::move(filter));
+    bp->set_global_filter(*weak_filter);
+    EXPECT_EQUAL(3u, bp->getState().estimate().estHits);
+    EXPECT_TRUE(bp->may_approximate());
+    EXPECT_TRUE(bp->uses_post_filter());
 }
 
 TEST_F("NN blueprint handles strong filter triggering brute force search", NearestNeighborBlueprintFixture)
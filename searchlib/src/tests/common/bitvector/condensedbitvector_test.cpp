@@ -1,10 +1,12 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/common/condensedbitvectors.h>
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/log/log.h>
 
 LOG_SETUP("condensedbitvector_test");
 
+using search::BitVector;
 using search::CondensedBitVector;
 using vespalib::GenerationHolder;
 
@@ -45,4 +47,24 @@ TEST("Verify set/get")
     EXPECT_EQUAL(1u, sum);
 }
 
+TEST("Verify that hits are and'ed with all keys in the set")
+{
+    GenerationHolder genHolder;
+    CondensedBitVector::UP cbv(CondensedBitVector::create(8, genHolder));
+    cbv->set(3, 2, true);
+    cbv->set(3, 5, true);
+    cbv->set(7, 5, true);
+    cbv->set(7, 6, true);
+    BitVector::UP bv = BitVector::create(10);
+    bv->setInterval(0, 10);
+    bv->invalidateCachedCount();
+    cbv->andHitsInto({3}, *bv);
+    EXPECT_EQUAL(2u, bv->countTrueBits());
+    EXPECT_TRUE(bv->testBit(2));
+    EXPECT_TRUE(bv->testBit(5));
+    cbv->andHitsInto({3, 7}, *bv);
+    EXPECT_EQUAL(1u, bv->countTrueBits());
+    EXPECT_TRUE(bv->testBit(5));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -523,4 +523,28 @@ TEST(GeoLocationParserTest, can_parse_what_query_tree_produces) {
     EXPECT_EQ(4, result_3.bounding_box.y.high);    
 }
 
+TEST(GeoLocationTest, zcurve_inside_limit_matches_point_inside_limit) {
+    using vespalib::geo::ZCurve;
+    std::vector<GeoLocation> locations = {
+        GeoLocation(Point{300,-400}, 500),
+        GeoLocation(Point{1200,400}, 500, Aspect{0.25}),
+        GeoLocation(Box{Range{-100,250},Range{-700,-300}}, Point{300,-400}, 500),
+        GeoLocation(Box{Range{-100,250},Range{-700,-300}}),
+        GeoLocation(Point{0,0}, 0),
+        GeoLocation(Point{0,0}, 1)
+    };
+    for (const auto &location : locations) {
+        for (int32_t x = -1000; x <= 3500; x += 7) {
+            for (int32_t y = -1000; y <= 1000; y += 7) {
+                EXPECT_EQ(location.inside_limit(Point{x,y}), location.inside_limit(ZCurve::encode(x, y)));
+            }
+        }
+        for (int32_t x = -2; x <= 2; ++x) {
+            for (int32_t y = -2; y <= 2; ++y) {
+                EXPECT_EQ(location.inside_limit(Point{x,y}), location.inside_limit(ZCurve::encode(x, y)));
+            }
+        }
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -59,6 +59,7 @@ private:
     void requireThatWeCanReadPostingList();
     void require_that_we_can_get_field_length_info();
     void requireThatWeCanReadBitVector();
+    void requireThatPostingListCacheAdmitsRepeatedLookups();
     void requireThatBlueprintIsCreated();
     void requireThatBlueprintCanCreateSearchIterators();
     void requireThatSearchIteratorsConforms();
@@ -185,6 +186,7 @@ Test::requireThatWeCanReadPostingList()
     TermFieldMatchDataArray mda;
     { // field 'f1'
         LookupResult::UP r = _index->lookup(0, "w1");
+        _index->prefetchPostingList(*r);
         PostingListHandle::UP h = _index->readPostingList(*r);
         SearchIterator * sb = h->createIterator(r->counts, mda);
         sb->initFullRange();
@@ -228,6 +230,42 @@ Test::requireThatWeCanReadBitVector()
     }
 }
 
+void
+Test::requireThatPostingListCacheAdmitsRepeatedLookups()
+{
+    TermFieldMatchDataArray mda;
+    { // word 'w1' in field 'f1'
+        LookupResult::UP r = _index->lookup(0, "w1");
+        for (uint32_t i = 0; i < 3; ++i) {
+            auto h = _index->getPostingList(*r);
+            EXPECT_TRUE(h);
+            SearchIterator::UP sb(h->createIterator(r->counts, mda));
+            sb->initFullRange();
+            EXPECT_EQUAL("1,3", toString(*sb));
+        }
+        // first lookup bypasses the cache, second is admitted, third is a hit
+        CacheStats stats = _index->getPostingListCacheStats();
+        EXPECT_EQUAL(3u, stats.lookups());
+        EXPECT_EQUAL(1u, stats.hits);
+        EXPECT_EQUAL(1u, stats.elements);
+        EXPECT_LESS(0u, stats.memory_used);
+    }
+    { // word 'w2' in field 'f2'
+        BitVector::UP exp(BitVector::create(32));
+        for (uint32_t docId = 1; docId < 18; ++docId) exp->setBit(docId);
+        LookupResult::UP r = _index->lookup(1, "w2");
+        for (uint32_t i = 0; i < 3; ++i) {
+            auto bv = _index->getBitVector(*r);
+            EXPECT_TRUE(bv);
+            EXPECT_TRUE(*bv == *exp);
+        }
+        CacheStats stats = _index->getPostingListCacheStats();
+        EXPECT_EQUAL(6u, stats.lookups());
+        EXPECT_EQUAL(2u, stats.hits);
+        EXPECT_EQUAL(2u, stats.elements);
+    }
+}
+
 void
 Test::requireThatBlueprintIsCreated()
 {
@@ -365,6 +403,11 @@ Test::Main()
     TEST_DO(requireThatBlueprintCanCreateSearchIterators());
     TEST_DO(requireThatSearchIteratorsConforms());
 
+    TEST_DO(openIndex("index/5", false, false, false, false, false, 1024 * 1024));
+    TEST_DO(requireThatPostingListCacheAdmitsRepeatedLookups());
+    TEST_DO(requireThatBlueprintIsCreated());
+    TEST_DO(requireThatBlueprintCanCreateSearchIterators());
+
     TEST_DONE();
 }
 
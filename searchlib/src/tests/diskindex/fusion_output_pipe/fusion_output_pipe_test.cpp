@@ -0,0 +1,92 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/diskindex/fusion_output_pipe.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <thread>
+
+using search::index::DocIdAndFeatures;
+
+namespace search::diskindex {
+
+namespace {
+
+class RecordingWriter {
+    vespalib::asciistream _os;
+public:
+    void newWord(uint64_t word_num, vespalib::stringref word) {
+        _os << "[" << word_num << ":" << word << "]";
+    }
+    void add(const DocIdAndFeatures &features) {
+        _os << features.doc_id() << "/" << features.blob().size() << ",";
+    }
+    vespalib::string str() const { return _os.str(); }
+};
+
+template <class Writer>
+void
+write_postings(Writer &writer, uint32_t num_words)
+{
+    DocIdAndFeatures features;
+    for (uint32_t word_num = 1; word_num <= num_words; ++word_num) {
+        vespalib::asciistream word;
+        word << "w" << word_num;
+        writer.newWord(word_num, word.str());
+        for (uint32_t doc_id = 1; doc_id <= word_num % 7 + 1; ++doc_id) {
+            features.clear(doc_id * 3);
+            features.blob().resize(doc_id % 3);
+            writer.add(features);
+        }
+    }
+}
+
+vespalib::string
+expected_postings(uint32_t num_words)
+{
+    RecordingWriter writer;
+    write_postings(writer, num_words);
+    return writer.str();
+}
+
+vespalib::string
+piped_postings(uint32_t num_words, uint32_t num_batches, size_t batch_size)
+{
+    FusionOutputPipe pipe(num_batches, batch_size);
+    RecordingWriter writer;
+    std::thread consumer([&pipe, &writer]() { pipe.drain(writer); });
+    write_postings(pipe, num_words);
+    pipe.close();
+    consumer.join();
+    return writer.str();
+}
+
+}
+
+TEST(FusionOutputPipeTest, require_that_empty_pipe_can_be_drained)
+{
+    EXPECT_EQ("", piped_postings(0, 2, 1024));
+}
+
+TEST(FusionOutputPipeTest, require_that_postings_pass_through_pipe_in_order)
+{
+    EXPECT_EQ(expected_postings(10), piped_postings(10, 2, 1024 * 1024));
+}
+
+TEST(FusionOutputPipeTest, require_that_postings_pass_through_pipe_with_many_small_batches)
+{
+    EXPECT_EQ(expected_postings(1000), piped_postings(1000, 2, 1));
+    EXPECT_EQ(expected_postings(1000), piped_postings(1000, 4, 500));
+}
+
+TEST(FusionOutputPipeTest, require_that_word_num_is_tracked_by_producer)
+{
+    FusionOutputPipe pipe(2, 1024);
+    EXPECT_EQ(0u, pipe.getSparseWordNum());
+    pipe.newWord(5, "foo");
+    EXPECT_EQ(5u, pipe.getSparseWordNum());
+    pipe.close();
+}
+
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -8,6 +8,7 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 LOG_SETUP("chunk_test");
 
@@ -98,4 +99,17 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), 282);
 }
 
+TEST("require that V2 can use a zstd dictionary") {
+    vespalib::compression::ZStdDictionary dictionary(vespalib::ConstBufferRef(MY_LONG_STRING, strlen(MY_LONG_STRING)), 9);
+    ChunkFormatV2 chunk(10);
+    chunk.getBuffer().write(MY_LONG_STRING, strlen(MY_LONG_STRING));
+    vespalib::DataBuffer buffer;
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD), &dictionary);
+    EXPECT_LESS(buffer.getDataLen(), 100u);
+    ChunkFormat::UP deserialized = ChunkFormat::deserialize(buffer.getData(), buffer.getDataLen(), false, &dictionary);
+    std::vector<char> v(strlen(MY_LONG_STRING));
+    deserialized->getBuffer().read(&v[0], v.size());
+    EXPECT_EQUAL(0, memcmp(MY_LONG_STRING, &v[0], v.size()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
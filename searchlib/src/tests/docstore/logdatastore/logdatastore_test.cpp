@@ -16,6 +16,7 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <iomanip>
+#include <map>
 
 using document::BucketId;
 using namespace search::docstore;
@@ -38,6 +39,7 @@ using namespace search;
 using namespace search::docstore;
 using search::index::DummyFileHeaderContext;
 using vespalib::compression::CompressionConfig;
+using namespace std::chrono_literals;
 
 namespace {
 
@@ -265,6 +267,35 @@ TEST("testGrowingChunkedByNumLids") {
     verifyGrowing(config,10, 10);
 }
 
+TEST("testGrowingChunkedByNumLidsCompactingConcurrently") {
+    LogDataStore::Config config;
+    config.setMaxNumLids(1000).setMaxDiskBloatFactor(0.1).setMaxBucketSpread(3.0).setMinFileSizeFactor(0.2)
+            .compactCompression({CompressionConfig::LZ4})
+            .setMaxConcurrentCompactions(4).setMaxCompactionBytesPerSecond(100000000)
+            .setFileConfig({{CompressionConfig::LZ4, 9, 60}, 1000});
+    // Concurrent compactions share the active file, so fewer files may be needed
+    verifyGrowing(config, 8, 10);
+}
+
+TEST("require that compaction throttle limits the rate of reads") {
+    docstore::CompactionThrottle unlimited(0);
+    vespalib::Timer unlimitedTimer;
+    for (size_t i(0); i < 10; i++) {
+        unlimited.acquire(1000000000);
+    }
+    EXPECT_LESS(unlimitedTimer.elapsed(), 1s);
+
+    docstore::CompactionThrottle throttle(1000000);
+    vespalib::Timer timer;
+    for (size_t i(0); i < 4; i++) {
+        throttle.acquire(100000);
+    }
+    // The first read starts right away, the next three wait for 0.1s each
+    EXPECT_GREATER_EQUAL(timer.elapsed(), 300ms);
+    throttle.setMaxBytesPerSecond(0);
+    EXPECT_EQUAL(0u, throttle.getMaxBytesPerSecond());
+}
+
 void fetchAndTest(IDataStore & datastore, uint32_t lid, const void *a, size_t sz)
 {
     vespalib::DataBuffer buf;
@@ -611,6 +642,41 @@ TEST("test the invalidate cache strategy") {
     TEST_DO(verifyCacheStats(ds.getCacheStats(), 0, 3, 1, 221));
 }
 
+void
+verifyCacheStats(CacheStats cs, size_t hits, size_t misses, size_t elements) {
+    EXPECT_EQUAL(hits, cs.hits);
+    EXPECT_EQUAL(misses, cs.misses);
+    EXPECT_EQUAL(elements, cs.elements);
+}
+
+TEST("test the insert cache strategy") {
+    VisitCacheStore vcs(DocumentStore::Config::UpdateStrategy::INSERT);
+    IDocumentStore & ds = vcs.getStore();
+    for (size_t i(1); i <= 10; i++) {
+        vcs.write(i);
+    }
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 0, 0, 10));
+    size_t memory_used = ds.getCacheStats().memory_used;
+    EXPECT_GREATER(memory_used, 10*200u);
+    vcs.verifyRead(7);
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 1, 0, 10));
+    vcs.write(7, 17);
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 1, 0, 10));
+    EXPECT_GREATER(ds.getCacheStats().memory_used, memory_used);
+    vcs.verifyVisit({3, 5, 7}, false);
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 4, 0, 10));
+    vcs.remove(5);
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 4, 0, 9));
+    vcs.verifyVisit({3, 5, 7}, {3, 7}, false);
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 6, 0, 9));
+    vcs.recreate();
+    IDocumentStore & ds2 = vcs.getStore();
+    vcs.verifyVisit({3, 7}, false);
+    TEST_DO(verifyCacheStats(ds2.getCacheStats(), 0, 0, 0));
+    vcs.verifyRead(7);
+    TEST_DO(verifyCacheStats(ds2.getCacheStats(), 0, 1, 1));
+}
+
 TEST("test that the integrated visit cache works.") {
     VisitCacheStore vcs(DocumentStore::Config::UpdateStrategy::INVALIDATE);
     IDocumentStore & ds = vcs.getStore();
@@ -842,13 +908,14 @@ struct Fixture {
 
     Fixture(const vespalib::string &dirName = "tmp",
             bool dirCleanup = true,
-            size_t maxFileSize = 4096 * 2)
+            size_t maxFileSize = 4096 * 2,
+            size_t chunkCacheBytes = 0)
         : executor(1, 0x20000),
           dir(dirName),
           serialNum(0),
           fileHeaderCtx(),
           tlSyncer(),
-          store(executor, dirName, getBasicConfig(maxFileSize), GrowStrategy(),
+          store(executor, dirName, getBasicConfig(maxFileSize).setChunkCacheBytes(chunkCacheBytes), GrowStrategy(),
                 TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr)
     {
         dir.cleanup(dirCleanup);
@@ -978,6 +1045,69 @@ TEST_F("require that getLid() is protected by docIdLimit", Fixture)
     EXPECT_FALSE(f.store.getLid(guard, 2).valid());
 }
 
+TEST_F("require that prefetch of lids on file, in memory and missing does not disturb reads", Fixture)
+{
+    f.write(10);
+    f.writeUntilNewChunk(100);
+    f.write(20);
+    f.flush();
+    f.write(30);
+    f.store.prefetch({10, 100, 20, 30, 40, 1000});
+    TEST_DO(f.assertContent({10,100,101,102,20,30}, 103));
+}
+
+TEST_F("require that chunks read repeatedly are served from the chunk cache", Fixture("tmp", true, 4096 * 2, 1000000))
+{
+    f.write(10);
+    f.writeUntilNewChunk(100);
+    f.flush();
+    vespalib::DataBuffer buffer;
+    EXPECT_GREATER(f.store.read(10, buffer), 0u);
+    EXPECT_EQUAL(0u, f.store.getChunkCacheStats().elements);
+    EXPECT_GREATER(f.store.read(10, buffer), 0u);
+    EXPECT_EQUAL(1u, f.store.getChunkCacheStats().elements);
+    EXPECT_EQUAL(0u, f.store.getChunkCacheStats().hits);
+    vespalib::DataBuffer cached;
+    EXPECT_EQUAL(1024u, f.store.read(10, cached));
+    EXPECT_EQUAL(genData(10, 1024), vespalib::string(cached.getData(), cached.getDataLen()));
+    EXPECT_EQUAL(1u, f.store.getChunkCacheStats().hits);
+    TEST_DO(f.assertContent({10,100,101,102}, 103));
+}
+
+TEST_F("require that chunk cache is not used when disabled", Fixture)
+{
+    f.write(10);
+    f.writeUntilNewChunk(100);
+    f.flush();
+    TEST_DO(f.assertContent({10,100,101,102}, 103));
+    TEST_DO(f.assertContent({10,100,101,102}, 103));
+    EXPECT_EQUAL(0u, f.store.getChunkCacheStats().elements);
+    EXPECT_EQUAL(0u, f.store.getChunkCacheStats().lookups());
+}
+
+struct CollectingVisitor : public IBufferVisitor {
+    std::map<uint32_t, vespalib::string> visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        visited[lid] = vespalib::string(buf.c_str(), buf.size());
+    }
+};
+
+TEST_F("require that visiting lids spread over many adjacent chunks returns all of them", Fixture("tmp", true, 1000000))
+{
+    IDataStore::LidVector lids;
+    for (uint32_t lid = 1; lid < 400; lid += 2) {
+        f.write(lid);
+        lids.push_back(lid);
+    }
+    f.flush();
+    CollectingVisitor visitor;
+    f.store.read(lids, visitor);
+    EXPECT_EQUAL(lids.size(), visitor.visited.size());
+    for (const auto &entry : visitor.visited) {
+        EXPECT_EQUAL(genData(entry.first, 1024), entry.second);
+    }
+}
+
 TEST_F("require that lid space can be compacted and shrunk", Fixture)
 {
     f.write(1).write(2);
@@ -1045,6 +1175,83 @@ TEST("require that findIncompleteCompactedFiles does expected filtering") {
 
 }
 
+namespace {
+
+vespalib::string
+makeSimilarDoc(uint32_t lid)
+{
+    vespalib::asciistream os;
+    os << "{\"title\":\"This is the title of document " << lid << "\",\"category\":\"" << (lid % 17)
+       << "\",\"body\":\"All documents are rather similar apart from their numbers, " << lid * 13
+       << ", which makes them compress well with a shared dictionary\",\"popularity\":" << lid % 101 << "}";
+    return os.str();
+}
+
+void
+writeSimilarDocs(LogDataStore & datastore, uint32_t firstLid, uint32_t endLid)
+{
+    for (uint32_t lid(firstLid); lid < endLid; lid++) {
+        vespalib::string doc = makeSimilarDoc(lid);
+        datastore.write(lid, lid, doc.data(), doc.size());
+    }
+    datastore.flush(datastore.initFlush(endLid - 1));
+}
+
+void
+verifySimilarDocs(IDataStore & datastore, uint32_t endLid)
+{
+    for (uint32_t lid(1); lid < endLid; lid++) {
+        vespalib::string doc = makeSimilarDoc(lid);
+        fetchAndTest(datastore, lid, doc.data(), doc.size());
+    }
+}
+
+size_t
+writeSimilarDocsToFiles(const vespalib::string & dir, size_t dictionarySize)
+{
+    DirectoryHandler tmpDir(dir);
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1, 128*1024);
+    MyTlSyncer tlSyncer;
+    LogDataStore::Config config;
+    config.setMaxNumLids(3000).setFileConfig({{CompressionConfig::ZSTD, 3, 100}, 4096, dictionarySize});
+    size_t diskFootprint(0);
+    {
+        LogDataStore datastore(executor, dir, config, GrowStrategy(),
+                               TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        EXPECT_FALSE(datastore.getCompressionDictionary());
+        writeSimilarDocs(datastore, 1, 2900);
+        EXPECT_FALSE(datastore.getCompressionDictionary());
+        writeSimilarDocs(datastore, 2900, 9000);
+        EXPECT_EQUAL(dictionarySize > 0, bool(datastore.getCompressionDictionary()));
+        verifySimilarDocs(datastore, 9000);
+        VisitCache visitCache(datastore, 100000, {CompressionConfig::ZSTD, 3, 100});
+        CompressedBlobSet blobs = visitCache.read({8000, 8001, 8002});
+        BlobSet uncompressed = blobs.getBlobSet();
+        for (uint32_t lid : {8000, 8001, 8002}) {
+            vespalib::string doc = makeSimilarDoc(lid);
+            EXPECT_EQUAL(doc, vespalib::string(uncompressed.get(lid).c_str(), uncompressed.get(lid).size()));
+        }
+        diskFootprint = datastore.getDiskFootprint() - datastore.getDiskHeaderFootprint();
+    }
+    {
+        LogDataStore datastore(executor, dir, config, GrowStrategy(),
+                               TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        EXPECT_EQUAL(dictionarySize > 0, bool(datastore.getCompressionDictionary()));
+        verifySimilarDocs(datastore, 9000);
+    }
+    return diskFootprint;
+}
+
+}
+
+TEST("require that chunks are compressed with dictionary trained from previous file") {
+    size_t plain = writeSimilarDocsToFiles("plain", 0);
+    size_t withDictionary = writeSimilarDocsToFiles("dictionary", 4096);
+    fprintf(stdout, "Disk footprint of chunks is %zu without and %zu with dictionary\n", plain, withDictionary);
+    EXPECT_LESS(withDictionary, plain);
+}
+
 TEST("require that config equality operator detects inequality") {
     using C = LogDataStore::Config;
     EXPECT_TRUE(C() == C());
@@ -1053,8 +1260,12 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setMaxBucketSpread(0.3));
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
+    EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({CompressionConfig::LZ4, 9, 60}, 0x10000, 4096)));
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setMaxConcurrentCompactions(2));
+    EXPECT_FALSE(C() == C().setMaxCompactionBytesPerSecond(1000));
+    EXPECT_FALSE(C() == C().setChunkCacheBytes(1000000));
 }
 
 TEST_MAIN() {
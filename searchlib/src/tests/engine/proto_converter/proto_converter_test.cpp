@@ -484,6 +484,24 @@ TEST_F(DocsumReplyTest, require_that_slime_summaries_are_converted) {
     EXPECT_EQ(slime.get()[0]["my_field"].asLong(), 42);
 }
 
+TEST_F(DocsumReplyTest, require_that_large_slime_summaries_are_converted) {
+    reply._root = std::make_unique<Slime>();
+    auto &list = reply._root->setArray();
+    std::string text(1000, 'x');
+    for (size_t i = 0; i < 100; ++i) {
+        auto &doc = list.addObject();
+        doc.setLong("my_field", i);
+        doc.setString("my_text", vespalib::Memory(text));
+    }
+    convert();
+    const auto &mem = proto.slime_summaries();
+    Slime slime;
+    EXPECT_EQ(BinaryFormat::decode(Memory(mem.data(), mem.size()), slime), mem.size());
+    ASSERT_EQ(slime.get().entries(), 100);
+    EXPECT_EQ(slime.get()[99]["my_field"].asLong(), 99);
+    EXPECT_EQ(slime.get()[99]["my_text"].asString().make_string(), text);
+}
+
 TEST_F(DocsumReplyTest, require_that_missing_root_slime_gives_empty_payload) {
     reply._root.reset();
     convert();
@@ -184,6 +184,22 @@ TEST_F(Bm25ExecutorTest, score_is_calculated_for_multiple_terms)
     EXPECT_TRUE(execute(score(3.0, 20, idf(25)) + score(7.0, 5.0, idf(35))));
 }
 
+TEST_F(Bm25ExecutorTest, score_is_calculated_for_short_fields)
+{
+    setup();
+    prepare_term(0, 0, 3, 0);
+    prepare_term(1, 0, 7, 255);
+    EXPECT_TRUE(execute(score(3.0, 0, idf(25)) + score(7.0, 255, idf(35))));
+}
+
+TEST_F(Bm25ExecutorTest, score_is_calculated_for_long_fields)
+{
+    setup();
+    prepare_term(0, 0, 3, 256);
+    prepare_term(1, 0, 7, 5000);
+    EXPECT_TRUE(execute(score(3.0, 256, idf(25)) + score(7.0, 5000, idf(35))));
+}
+
 TEST_F(Bm25ExecutorTest, term_that_does_not_match_document_is_ignored)
 {
     setup();
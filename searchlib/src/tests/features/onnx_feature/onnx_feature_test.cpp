@@ -27,6 +27,7 @@ std::string source_dir = get_source_dir();
 std::string vespa_dir = source_dir + "/" + "../../../../..";
 std::string simple_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/simple.onnx";
 std::string dynamic_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/dynamic.onnx";
+std::string guess_batch_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/guess_batch.onnx";
 std::string strange_names_model = source_dir + "/" + "strange_names.onnx";
 
 uint32_t default_docid = 1;
@@ -61,6 +62,9 @@ struct OnnxFeatureTest : ::testing::Test {
     void add_onnx(const OnnxModel &model) {
         indexEnv.addOnnxModel(model);
     }
+    void set_batch_size(size_t batch_size) {
+        indexEnv.getProperties().add(indexproperties::eval::OnnxBatchSize::NAME, fmt("%zu", batch_size));
+    }
     void compile(const vespalib::string &seed) {
         resolver->addSeed(seed);
         ASSERT_TRUE(resolver->compile());
@@ -137,4 +141,36 @@ TEST_F(OnnxFeatureTest, input_features_and_output_names_can_be_specified) {
     EXPECT_EQ(get("onnxModel(custom_names).my_second_output", 1), expect_sub);
 }
 
+TEST_F(OnnxFeatureTest, upcoming_documents_can_be_evaluated_in_batches) {
+    set_batch_size(2);
+    add_expr("in1", "tensor<float>(x[1]):[docid]");
+    add_expr("in2", "tensor<float>(x[1]):[docid*2]");
+    add_onnx(OnnxModel("guess_batch", guess_batch_model));
+    compile(onnx_feature("guess_batch"));
+    std::vector<uint32_t> docs({1, 2, 5, 7, 8});
+    program.set_upcoming_docids(docs);
+    auto expect = [](double value){ return TensorSpec("tensor<float>(d0[1])").add({{"d0",0}}, value); };
+    EXPECT_EQ(get(1), expect(3.0));
+    EXPECT_EQ(get(2), expect(6.0));
+    EXPECT_EQ(get(3), expect(9.0)); // not upcoming
+    EXPECT_EQ(get(5), expect(15.0));
+    EXPECT_EQ(get("onnxModel(guess_batch).out", 5), expect(15.0));
+    EXPECT_EQ(get(8), expect(24.0)); // 7 skipped
+    EXPECT_EQ(get(9), expect(27.0));
+}
+
+TEST_F(OnnxFeatureTest, models_without_batch_dimension_are_evaluated_one_document_at_a_time) {
+    set_batch_size(2);
+    add_expr("query_tensor", "tensor<float>(a[1],b[4]):[[docid,2,3,4]]");
+    add_expr("attribute_tensor", "tensor<float>(a[4],b[1]):[[5],[6],[7],[8]]");
+    add_expr("bias_tensor", "tensor<float>(a[1],b[2]):[[4,5]]");
+    add_onnx(OnnxModel("dynamic", dynamic_model));
+    compile(onnx_feature("dynamic"));
+    std::vector<uint32_t> docs({1, 2, 3});
+    program.set_upcoming_docids(docs);
+    EXPECT_EQ(get(1), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 79.0));
+    EXPECT_EQ(get(2), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 84.0));
+    EXPECT_EQ(get(3), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 89.0));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -4,6 +4,7 @@
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/searchlib/fef/feature_type.h>
 #include <vespa/searchlib/fef/featurenameparser.h>
+#include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
 #include <vespa/searchlib/fef/test/dummy_dependency_handler.h>
 #include <vespa/searchlib/fef/test/indexenvironment.h>
@@ -67,15 +68,18 @@ struct SetupResult {
     RankingExpressionBlueprint rank;
     DummyDependencyHandler deps;
     bool setup_ok;
-    SetupResult(const TypeMap &object_inputs, const vespalib::string &expression);
+    SetupResult(const TypeMap &object_inputs, const vespalib::string &expression,
+                const Properties &props = Properties());
     ~SetupResult();
 };
 
 SetupResult::SetupResult(const TypeMap &object_inputs,
-                         const vespalib::string &expression)
+                         const vespalib::string &expression,
+                         const Properties &props)
     : stash(), index_env(), query_env(&index_env), rank(make_replacer()), deps(rank), setup_ok(false)
 {
     rank.setName("self");
+    index_env.getProperties().import(props);
     index_env.getProperties().add("self.rankingScript", expression);
     for (const auto &input: object_inputs) {
         deps.define_object_input(input.first, ValueType::from_spec(input.second));
@@ -107,6 +111,17 @@ void verify_setup_fail(const TypeMap &object_inputs,
     EXPECT_EQUAL(0u, result.deps.output.size());
 }
 
+void verify_inputs(const Properties &props, const vespalib::string &expression,
+                   const std::vector<vespalib::string> &expect)
+{
+    SetupResult result({}, expression, props);
+    EXPECT_TRUE(result.setup_ok);
+    ASSERT_EQUAL(result.deps.input.size(), expect.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_EQUAL(result.deps.input[i], expect[i]);
+    }
+}
+
 void verify_input_count(const vespalib::string &expression, size_t expect) {
     SetupResult result({}, expression);
     EXPECT_TRUE(result.setup_ok);
@@ -154,4 +169,36 @@ TEST_F("require that replaced expressions create the appropriate executor", Setu
     EXPECT_TRUE(dynamic_cast<DummyExecutor*>(&executor) != nullptr);
 }
 
+Properties make_inline_props(bool inline_functions) {
+    Properties props;
+    props.add(indexproperties::eval::InlineFunctions::NAME, inline_functions ? "true" : "false");
+    props.add("rankingExpression(f1).rankingScript", "a+rankingExpression(f2)");
+    props.add("rankingExpression(f2).rankingScript", "b*2");
+    props.add("rankingExpression(loop).rankingScript", "rankingExpression(loop)+1");
+    return props;
+}
+
+TEST("require that referenced ranking expressions are not inlined by default") {
+    TEST_DO(verify_inputs(make_inline_props(false), "rankingExpression(f1)*c",
+                          {"rankingExpression(f1)", "c"}));
+}
+
+TEST("require that referenced ranking expressions can be inlined") {
+    TEST_DO(verify_inputs(make_inline_props(true), "rankingExpression(f1)*c", {"a", "b", "c"}));
+    TEST_DO(verify_inputs(make_inline_props(true), "rankingExpression(f2)+rankingExpression(f2)", {"b"}));
+}
+
+TEST("require that only plain references to known ranking expressions are inlined") {
+    TEST_DO(verify_inputs(make_inline_props(true), "rankingExpression(f1).out+rankingExpression(f3)",
+                          {"rankingExpression(f1).out", "rankingExpression(f3)"}));
+}
+
+TEST("require that inlining of cyclic ranking expressions terminates") {
+    TEST_DO(verify_inputs(make_inline_props(true), "rankingExpression(loop)", {"rankingExpression(loop)"}));
+}
+
+TEST("require that ranking expressions referenced in multiple places are inlined everywhere") {
+    TEST_DO(verify_inputs(make_inline_props(true), "rankingExpression(f1)+rankingExpression(f2)", {"a", "b"}));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
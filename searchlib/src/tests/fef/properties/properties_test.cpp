@@ -234,6 +234,38 @@ TEST("test stuff") {
             p.add("vespa.eval.use_fast_forest", "true");
             EXPECT_EQUAL(eval::UseFastForest::check(p), true);
         }
+        { // vespa.eval.inline_functions
+            EXPECT_EQUAL(eval::InlineFunctions::NAME, vespalib::string("vespa.eval.inline_functions"));
+            EXPECT_EQUAL(eval::InlineFunctions::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(eval::InlineFunctions::check(p), false);
+            p.add("vespa.eval.inline_functions", "true");
+            EXPECT_EQUAL(eval::InlineFunctions::check(p), true);
+        }
+        { // vespa.eval.bounded_fast_forest
+            EXPECT_EQUAL(eval::BoundedFastForest::NAME, vespalib::string("vespa.eval.bounded_fast_forest"));
+            EXPECT_EQUAL(eval::BoundedFastForest::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(eval::BoundedFastForest::check(p), false);
+            p.add("vespa.eval.bounded_fast_forest", "true");
+            EXPECT_EQUAL(eval::BoundedFastForest::check(p), true);
+        }
+        { // vespa.eval.onnx_batch_size
+            EXPECT_EQUAL(eval::OnnxBatchSize::NAME, vespalib::string("vespa.eval.onnx_batch_size"));
+            EXPECT_EQUAL(eval::OnnxBatchSize::DEFAULT_VALUE, 1u);
+            Properties p;
+            EXPECT_EQUAL(eval::OnnxBatchSize::lookup(p), 1u);
+            p.add("vespa.eval.onnx_batch_size", "32");
+            EXPECT_EQUAL(eval::OnnxBatchSize::lookup(p), 32u);
+        }
+        { // vespa.eval.onnx_intra_op_threads
+            EXPECT_EQUAL(eval::OnnxIntraOpThreads::NAME, vespalib::string("vespa.eval.onnx_intra_op_threads"));
+            EXPECT_EQUAL(eval::OnnxIntraOpThreads::DEFAULT_VALUE, 1u);
+            Properties p;
+            EXPECT_EQUAL(eval::OnnxIntraOpThreads::lookup(p), 1u);
+            p.add("vespa.eval.onnx_intra_op_threads", "0");
+            EXPECT_EQUAL(eval::OnnxIntraOpThreads::lookup(p), 0u);
+        }
         { // vespa.rank.firstphase
             EXPECT_EQUAL(rank::FirstPhase::NAME, vespalib::string("vespa.rank.firstphase"));
             EXPECT_EQUAL(rank::FirstPhase::DEFAULT_VALUE, vespalib::string("nativeRank"));
@@ -427,6 +459,15 @@ TEST("test stuff") {
             p.clear().add("vespa.hitcollector.rankscoredroplimit", "123456789.12345");
             EXPECT_EQUAL(hitcollector::RankScoreDropLimit::lookup(p), 123456789.12345);
         }
+        { // vespa.hitcollector.maxhitspergroup
+            EXPECT_EQUAL(hitcollector::MaxHitsPerGroup::NAME, vespalib::string("vespa.hitcollector.maxhitspergroup"));
+            EXPECT_EQUAL(hitcollector::MaxHitsPerGroup::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(hitcollector::MaxHitsPerGroup::lookup(p), 0u);
+            EXPECT_EQUAL(hitcollector::MaxHitsPerGroup::lookup(p, 5), 5u);
+            p.add("vespa.hitcollector.maxhitspergroup", "10");
+            EXPECT_EQUAL(hitcollector::MaxHitsPerGroup::lookup(p), 10u);
+        }
         { // vespa.fieldweight.
             EXPECT_EQUAL(FieldWeight::BASE_NAME, vespalib::string("vespa.fieldweight."));
             EXPECT_EQUAL(FieldWeight::DEFAULT_VALUE, 100u);
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/features/valuefeature.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
 #include <vespa/searchlib/fef/blueprintfactory.h>
+#include <vespa/searchlib/fef/feature_extractor.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/fef/test/indexenvironment.h>
@@ -391,4 +392,107 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+std::vector<double> run_batch(RankProgram &program, const std::vector<uint32_t> &docids) {
+    std::vector<double> result(docids.size(), 31212.0);
+    program.run_batch(docids, result);
+    return result;
+}
+
+TEST_F("require that batch execution is supported when all non-const executors support it", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+ivalue(1)+value(10)").compile();
+    EXPECT_TRUE(f1.program.supports_batch());
+    std::vector<uint32_t> docids({3, 5, 70});
+    auto result = run_batch(f1.program, docids);
+    ASSERT_EQUAL(3u, result.size());
+    for (size_t i = 0; i < docids.size(); ++i) {
+        EXPECT_EQUAL(docids[i] * 2 + 11.0, result[i]);
+        EXPECT_EQUAL(f1.get(docids[i]), result[i]);
+    }
+}
+
+TEST_F("require that batch execution runs each executor once per batch", Fixture()) {
+    f1.add("track(track(docid))").compile();
+    EXPECT_TRUE(f1.program.supports_batch());
+    std::vector<uint32_t> docids;
+    for (uint32_t docid = 1; docid <= RankProgram::batch_size; ++docid) {
+        docids.push_back(docid);
+    }
+    EXPECT_EQUAL(f1.track_cnt, 0u);
+    auto result = run_batch(f1.program, docids);
+    EXPECT_EQUAL(f1.track_cnt, 2u);
+    ASSERT_EQUAL(docids.size(), result.size());
+    EXPECT_EQUAL(1.0, result[0]);
+    EXPECT_EQUAL(double(RankProgram::batch_size), result.back());
+    result = run_batch(f1.program, std::vector<uint32_t>({100}));
+    EXPECT_EQUAL(f1.track_cnt, 4u);
+    EXPECT_EQUAL(100.0, result[0]);
+}
+
+TEST_F("require that batch execution does not affect lazy values", Fixture()) {
+    f1.add("track(docid)").compile();
+    EXPECT_EQUAL(5.0, f1.get(5));
+    EXPECT_EQUAL(f1.track_cnt, 1u);
+    auto result = run_batch(f1.program, std::vector<uint32_t>({7, 8}));
+    EXPECT_EQUAL(7.0, result[0]);
+    EXPECT_EQUAL(8.0, result[1]);
+    EXPECT_EQUAL(f1.track_cnt, 2u);
+    EXPECT_EQUAL(5.0, f1.get(5));
+    EXPECT_EQUAL(f1.track_cnt, 2u);
+}
+
+TEST_F("require that batch execution is not supported when an executor does not support it", Fixture()) {
+    f1.add("mysum(docid,ivalue(1))").compile();
+    EXPECT_FALSE(f1.program.supports_batch());
+}
+
+TEST_F("require that batch execution is not supported for lazy ranking expressions", Fixture()) {
+    f1.lazy_expressions(true).add_expr("rank", "docid*2").compile();
+    EXPECT_FALSE(f1.program.supports_batch());
+}
+
+TEST_F("require that batch execution is not supported for object values", Fixture()) {
+    f1.add("box(docid)").compile();
+    EXPECT_FALSE(f1.program.supports_batch());
+}
+
+TEST_F("require that batch execution is not supported for const seeds", Fixture()) {
+    f1.add("value(1)").compile();
+    EXPECT_FALSE(f1.program.supports_batch());
+}
+
+TEST_F("require that batch execution is not supported for multiple seeds", Fixture()) {
+    f1.add("docid").add("ivalue(1)").compile();
+    EXPECT_FALSE(f1.program.supports_batch());
+}
+
+TEST_F("require that batch execution is not supported for overridden features", Fixture()) {
+    f1.add("track(ivalue(1))").override("ivalue(1)", 2.0).compile();
+    EXPECT_FALSE(f1.program.supports_batch());
+    EXPECT_EQUAL(2.0, f1.get());
+}
+
+TEST_F("require that feature extractor fills feature set for multiple documents", Fixture()) {
+    f1.add("value(1)").add("docid").add("box(docid)").add("track(value(2))").add("track(docid)");
+    f1.compile();
+    EXPECT_EQUAL(f1.track_cnt, 1u);
+    FeatureExtractor extractor(f1.program);
+    EXPECT_EQUAL(5u, extractor.names().size());
+    auto features = extractor.make_feature_set(3);
+    extractor.extract(3, *features);
+    extractor.extract(5, *features);
+    extractor.extract(7, *features);
+    EXPECT_EQUAL(f1.track_cnt, 4u);
+    EXPECT_EQUAL(3u, features->numDocs());
+    for (uint32_t docid : {3u, 5u, 7u}) {
+        const auto *values = features->getFeaturesByDocId(docid);
+        ASSERT_TRUE(values != nullptr);
+        for (size_t i = 0; i < extractor.names().size(); ++i) {
+            const vespalib::string &name = extractor.names()[i];
+            EXPECT_TRUE(values[i].is_double());
+            EXPECT_EQUAL(f1.get(name, docid), values[i].as_double());
+        }
+    }
+    EXPECT_TRUE(features->getFeaturesByDocId(4) == nullptr);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -236,6 +236,25 @@ TEST("append positions") {
     EXPECT_EQUAL(0x32345678u, tfmd.begin()[2].getElementLen());
 }
 
+TEST("append many positions") {
+    TermFieldMatchData tfmd;
+    tfmd.setFieldId(123);
+    tfmd.reset(7);
+    tfmd.reservePositions(10);
+    EXPECT_EQUAL(42u, tfmd.capacity());
+    for (uint32_t i = 0; i < 100; ++i) {
+        tfmd.appendPosition(TermFieldMatchDataPosition(i / 10, i, 1, 100 + i));
+    }
+    EXPECT_EQUAL(100u, tfmd.size());
+    EXPECT_EQUAL(168u, tfmd.capacity());
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_EQUAL(i / 10, tfmd.begin()[i].getElementId());
+        EXPECT_EQUAL(i, tfmd.begin()[i].getPosition());
+        EXPECT_EQUAL(100 + i, tfmd.begin()[i].getElementLen());
+    }
+    EXPECT_EQUAL(199u, tfmd.getIterator().getFieldLength());
+}
+
 TEST("Access subqueries") {
     State state;
     testSetup(state);
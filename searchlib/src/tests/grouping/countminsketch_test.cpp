@@ -0,0 +1,65 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for countminsketch.
+
+#include <vespa/log/log.h>
+LOG_SETUP("countminsketch_test");
+
+#include <vespa/searchlib/grouping/countminsketch.h>
+#include <vespa/vespalib/testkit/testapp.h>
+
+using namespace search;
+
+namespace {
+
+uint64_t makeHash(uint64_t i) {
+    return i * 0x9e3779b97f4a7c15ul;
+}
+
+TEST("require that estimates are exact without collisions") {
+    CountMinSketch<> sketch;
+    EXPECT_EQUAL(0u, sketch.estimate(makeHash(1)));
+    EXPECT_EQUAL(1u, sketch.add(makeHash(1)));
+    EXPECT_EQUAL(2u, sketch.add(makeHash(1)));
+    EXPECT_EQUAL(1u, sketch.add(makeHash(2)));
+    EXPECT_EQUAL(2u, sketch.estimate(makeHash(1)));
+    EXPECT_EQUAL(1u, sketch.estimate(makeHash(2)));
+    EXPECT_EQUAL(3u, sketch.getTotal());
+}
+
+TEST("require that estimates stay within the error bound") {
+    CountMinSketch<256, 4> sketch;
+    std::vector<uint32_t> counts(5000);
+    for (uint32_t i = 0; i < counts.size(); ++i) {
+        counts[i] = 1 + (i % 7 == 0 ? 100 : 0);
+        for (uint32_t j = 0; j < counts[i]; ++j) {
+            sketch.add(makeHash(i));
+        }
+    }
+    size_t outside = 0;
+    for (uint32_t i = 0; i < counts.size(); ++i) {
+        uint32_t estimate = sketch.estimate(makeHash(i));
+        EXPECT_GREATER_EQUAL(estimate, counts[i]);
+        if (estimate > counts[i] + sketch.getErrorBound()) {
+            ++outside;
+        }
+    }
+    // Expected share outside the bound is at most e^-4 (1.8%)
+    EXPECT_LESS(outside, counts.size() / 50);
+}
+
+TEST("require that sketches can be merged") {
+    CountMinSketch<> a;
+    CountMinSketch<> b;
+    a.add(makeHash(1));
+    b.add(makeHash(1));
+    b.add(makeHash(2));
+    a.merge(b);
+    EXPECT_EQUAL(2u, a.estimate(makeHash(1)));
+    EXPECT_EQUAL(1u, a.estimate(makeHash(2)));
+    EXPECT_EQUAL(3u, a.getTotal());
+    EXPECT_EQUAL(1u, a.getErrorBound());
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,7 @@
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/aggregation/fs4hit.h>
 #include <vespa/searchlib/aggregation/predicates.h>
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/expression/fixedwidthbucketfunctionnode.h>
 #include <vespa/searchlib/test/make_attribute_map_lookup_node.h>
 #include <vespa/searchcommon/common/undefinedvalues.h>
@@ -185,6 +186,8 @@ public:
     void testThatNanIsConverted();
     void testNanSorting();
     void testAttributeMapLookup();
+    void testBatchAggregation();
+    void testApproximateGrouping();
     int Main() override;
 private:
     void testAggregationSimple(AggregationContext & ctx, const AggregationResult & aggr, const ResultNode & ir, const vespalib::string &name);
@@ -1948,6 +1951,134 @@ Test::testAttributeMapLookup()
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Verify that aggregations in the root group, which evaluate their
+ * expressions in batches, give the same results as per document
+ * evaluation, also across batch boundaries and with topN.
+ **/
+void
+Test::testBatchAggregation()
+{
+    AggregationContext ctx;
+    IntAttrBuilder intAttr("int");
+    FloatAttrBuilder floatAttr("float");
+    IntAttrBuilder timeAttr("time");
+    const uint32_t numDocs = 1000;
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        ctx.result().add(i);
+        intAttr.add(i % 17);
+        floatAttr.add(i * 0.5);
+        timeAttr.add(int64_t(i) * 86400);
+    }
+    ctx.add(intAttr.sp());
+    ctx.add(floatAttr.sp());
+    ctx.add(timeAttr.sp());
+    BitVector::UP bitVector = BitVector::create(numDocs);
+    bitVector->setInterval(0, numDocs);
+    bitVector->invalidateCachedCount();
+
+    auto makeAdd = []() {
+        auto add = MU<AddFunctionNode>();
+        add->appendArg(MU<AttributeNode>("int")).appendArg(MU<ConstantNode>(MU<Int64ResultNode>(3)));
+        return add;
+    };
+    auto makeMultiply = []() {
+        auto multiply = MU<MultiplyFunctionNode>();
+        multiply->appendArg(MU<AttributeNode>("int")).appendArg(MU<AttributeNode>("float"));
+        return multiply;
+    };
+    auto makeYear = []() {
+        return MU<TimeStampFunctionNode>(MU<AttributeNode>("time"), TimeStampFunctionNode::Year);
+    };
+    Grouping request;
+    request.setRoot(Group().addResult(SumAggregationResult().setExpression(makeAdd()))
+                           .addResult(MaxAggregationResult().setExpression(makeMultiply()))
+                           .addResult(SumAggregationResult().setExpression(makeYear())));
+    for (int64_t topN : {int64_t(-1), int64_t(300)}) {
+        uint32_t numHits = (topN >= 0) ? topN : numDocs;
+        int64_t sum(0);
+        double max(0);
+        int64_t years(0);
+        for (uint32_t i = 0; i < numHits; ++i) {
+            sum += (i % 17) + 3;
+            max = std::max(max, (i % 17) * (i * 0.5));
+            years += TimeStampFunctionNode::getTimePart(int64_t(i) * 86400, TimeStampFunctionNode::Year, true);
+        }
+        Grouping tmp = request;
+        tmp.setTopN(topN);
+        ctx.setup(tmp);
+        tmp.aggregate(ctx.result().hits(), ctx.result().size());
+        EXPECT_EQUAL(sum, tmp.getRoot().getAggregationResult(0).getRank().getInteger());
+        EXPECT_EQUAL(max, tmp.getRoot().getAggregationResult(1).getRank().getFloat());
+        EXPECT_EQUAL(years, tmp.getRoot().getAggregationResult(2).getRank().getInteger());
+
+        Grouping overflow = request;
+        overflow.setTopN(topN);
+        ctx.setup(overflow);
+        overflow.aggregate(ctx.result().hits(), 0, bitVector.get());
+        EXPECT_EQUAL(sum, overflow.getRoot().getAggregationResult(0).getRank().getInteger());
+        EXPECT_EQUAL(max, overflow.getRoot().getAggregationResult(1).getRank().getFloat());
+        EXPECT_EQUAL(years, overflow.getRoot().getAggregationResult(2).getRank().getInteger());
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Verify that approximate grouping keeps at most precision groups,
+ * selecting the groups with the most hits, and reports how many hits
+ * the kept groups may be missing.
+ **/
+void
+Test::testApproximateGrouping()
+{
+    AggregationContext ctx;
+    IntAttrBuilder keyAttr("key");
+    // Many unique keys followed by three frequent ones
+    for (uint32_t i = 0; i < 1400; ++i) {
+        ctx.result().add(i);
+        keyAttr.add(1000 + i);
+    }
+    for (uint32_t i = 1400; i < 2000; ++i) {
+        ctx.result().add(i);
+        keyAttr.add(i % 3);
+    }
+    ctx.add(keyAttr.sp());
+
+    Grouping request;
+    request.setFirstLevel(0).setLastLevel(1);
+    request.addLevel(std::move(GroupingLevel()
+                               .setMaxGroups(3)
+                               .setExpression(MU<AttributeNode>("key"))
+                               .addResult(CountAggregationResult().setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0))))
+                               .addOrderBy(MU<AggregationRefNode>(0), false)));
+    {
+        Grouping exact = request;
+        ctx.setup(exact);
+        exact.aggregate(ctx.result().hits(), ctx.result().size());
+        ASSERT_EQUAL(3u, exact.getRoot().getChildrenSize());
+        EXPECT_EQUAL(200, exact.getRoot().getChild(0).getAggregationResult(0).getRank().getInteger());
+        EXPECT_EQUAL(0u, exact.getLevels()[0].getErrorBound());
+    }
+    Grouping approximate = request;
+    approximate.levels()[0].setApproximate(true);
+    ctx.setup(approximate);
+    approximate.aggregate(ctx.result().hits(), ctx.result().size());
+    const Group &root = approximate.getRoot();
+    uint64_t errorBound = approximate.getLevels()[0].getErrorBound();
+    EXPECT_GREATER(errorBound, 0u);
+    ASSERT_EQUAL(3u, root.getChildrenSize());
+    for (uint32_t i = 0; i < root.getChildrenSize(); ++i) {
+        const Group &group = root.getChild(i);
+        EXPECT_EQUAL(int64_t(i), group.getId().getInteger());
+        int64_t count = group.getAggregationResult(0).getRank().getInteger();
+        EXPECT_LESS_EQUAL(count, 200);
+        EXPECT_GREATER_EQUAL(count + int64_t(errorBound), 200);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 struct RunDiff { ~RunDiff() { system("diff -u lhs.out rhs.out > diff.txt"); }};
 
 //-----------------------------------------------------------------------------
@@ -1979,6 +2110,8 @@ Test::Main()
     testThatNanIsConverted();
     testNanSorting();
     testAttributeMapLookup();
+    testBatchAggregation();
+    testApproximateGrouping();
     TEST_DONE();
 }
 
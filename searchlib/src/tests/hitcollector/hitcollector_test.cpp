@@ -37,6 +37,21 @@ struct PredefinedScorer : public HitCollector::DocumentScorer
     }
 };
 
+struct RecordingScorer : public HitCollector::DocumentScorer
+{
+    std::vector<uint32_t> prepared;
+    std::vector<uint32_t> scored;
+    void prepare(const std::vector<HitCollector::Hit> &hits) override {
+        for (const auto &hit: hits) {
+            prepared.push_back(hit.first);
+        }
+    }
+    feature_t score(uint32_t docId) override {
+        scored.push_back(docId);
+        return docId + 200;
+    }
+};
+
 std::vector<HitCollector::Hit> extract(SortedHitSequence seq) {
     std::vector<HitCollector::Hit> ret;
     while (seq.valid()) {
@@ -138,6 +153,20 @@ TEST("testAddHit") {
     TEST_DO(testAddHit(400, 10)); // 400/32 = 12 which is bigger than 10.
 }
 
+TEST("require that score threshold is the lowest of the best hits once hits are dropped") {
+    HitCollector hc(20, 3);
+    hc.addHit(0, 10);
+    hc.addHit(1, 30);
+    hc.addHit(2, 20);
+    EXPECT_EQUAL(default_rank_value, hc.getScoreThreshold());
+    hc.addHit(3, 5);
+    EXPECT_EQUAL(10.0, hc.getScoreThreshold());
+    hc.addHit(4, 40);
+    EXPECT_EQUAL(20.0, hc.getScoreThreshold());
+    hc.addHit(5, 15);
+    EXPECT_EQUAL(20.0, hc.getScoreThreshold());
+}
+
 struct Fixture {
     HitCollector hc;
     BitVector::UP expBv;
@@ -236,6 +265,18 @@ TEST_F("testReRank - partial", AscendingScoreFixture)
     TEST_DO(checkResult(*rs, f.expBv.get()));
 }
 
+TEST("require that document scorer is prepared with all hits in docid order before scoring") {
+    HitCollector hc(20, 10);
+    for (uint32_t i = 0; i < 20; ++i) {
+        hc.addHit(i, (i % 2 == 0) ? i : 100 - i);
+    }
+    RecordingScorer scorer;
+    EXPECT_EQUAL(4u, hc.reRank(scorer, extract(hc.getSortedHitSequence(4))));
+    std::vector<uint32_t> expect({1, 3, 5, 7});
+    EXPECT_TRUE(scorer.prepared == expect);
+    EXPECT_TRUE(scorer.scored == expect);
+}
+
 TEST_F("require that hits for 2nd phase candidates can be retrieved", DescendingScoreFixture)
 {
     f.addHits();
@@ -527,4 +568,53 @@ TEST("require that hits can be added out of order only after passing array limit
     TEST_DO(checkResult(*rs, nullptr));
 }
 
+struct ModGroups : IDiversityGroups {
+    uint64_t group(uint32_t docId) const override { return docId % 3; }
+};
+
+void testDiverseHits(uint32_t numDocs)
+{
+    HitCollector hc(numDocs, 4, std::make_unique<ModGroups>(), 2);
+    for (uint32_t i = 0; i < 12; ++i) {
+        hc.addHit(i, ((i % 3) == 0) ? (100 + i) : i);
+    }
+    EXPECT_EQUAL(10.0, hc.getScoreThreshold());
+    std::vector<RankedHit> expRh;
+    BitVector::UP expBv(BitVector::create(numDocs));
+    for (uint32_t i = 0; i < 12; ++i) {
+        expBv->setBit(i);
+        if ((i == 6) || (i == 9) || (i >= 10)) {
+            expRh.emplace_back(i, ((i % 3) == 0) ? (100 + i) : i);
+        } else if (numDocs >= 1000) {
+            expRh.emplace_back(i, default_rank_value);
+        }
+    }
+    std::unique_ptr<ResultSet> rs = hc.getResultSet();
+    TEST_DO(checkResult(*rs, expRh));
+    TEST_DO(checkResult(*rs, (numDocs >= 1000) ? nullptr : expBv.get()));
+}
+
+TEST("require that ranked hits are limited per diversity group") {
+    TEST_DO(testDiverseHits(1000));
+    TEST_DO(testDiverseHits(20));
+}
+
+TEST("require that score threshold is not set before diverse hit vector is full") {
+    HitCollector hc(1000, 3, std::make_unique<ModGroups>(), 1);
+    hc.addHit(0, 10);
+    hc.addHit(3, 30);
+    hc.addHit(6, 20);
+    EXPECT_EQUAL(default_rank_value, hc.getScoreThreshold());
+    hc.addHit(1, 5);
+    hc.addHit(2, 15);
+    EXPECT_EQUAL(5.0, hc.getScoreThreshold());
+    auto seq = hc.getSortedHitSequence(3);
+    for (uint32_t expDocId : {3, 2, 1}) {
+        ASSERT_TRUE(seq.valid());
+        EXPECT_EQUAL(expDocId, seq.get().first);
+        seq.next();
+    }
+    EXPECT_FALSE(seq.valid());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -128,6 +128,7 @@ struct DocumentInverterTest : public ::testing::Test {
     FieldLengthCalculator           _calculator;
     MockFieldIndexCollection        _fic;
     DocumentInverter                _inv;
+    DocumentInverter                _sharded_inv;
 
     static Schema makeSchema() {
         Schema schema;
@@ -148,7 +149,8 @@ struct DocumentInverterTest : public ::testing::Test {
           _inserter(),
           _calculator(),
           _fic(_remover, _inserter, _calculator),
-          _inv(_schema, *_invertThreads, *_pushThreads, _fic)
+          _inv(_schema, *_invertThreads, *_pushThreads, _fic),
+          _sharded_inv(_schema, *_invertThreads, *_pushThreads, _fic, 2)
     {
     }
 
@@ -162,6 +164,17 @@ struct DocumentInverterTest : public ::testing::Test {
         }
         _pushThreads->sync();
     }
+
+    void push_sharded_documents() {
+        _invertThreads->sync();
+        for (uint32_t fieldId = 0; fieldId < _sharded_inv.getNumFields(); ++fieldId) {
+            _inserter.setFieldId(fieldId);
+            for (uint32_t shard = 0; shard < _sharded_inv.getNumShards(); ++shard) {
+                _sharded_inv.getInverter(fieldId, shard)->pushDocuments();
+            }
+        }
+        _pushThreads->sync();
+    }
 };
 
 TEST_F(DocumentInverterTest, require_that_fresh_insert_works)
@@ -300,6 +313,39 @@ TEST_F(DocumentInverterTest, require_that_empty_document_can_be_inverted)
               _inserter.toStr());
 }
 
+TEST_F(DocumentInverterTest, require_that_documents_are_inverted_in_shards_by_docid)
+{
+    EXPECT_EQ(2u, _sharded_inv.getNumShards());
+    _sharded_inv.invertDocument(10, *makeDoc10(_b));
+    _sharded_inv.invertDocument(11, *makeDoc11(_b));
+    push_sharded_documents();
+    EXPECT_EQ("f=0,w=a,a=10,"
+              "w=b,a=10,"
+              "w=c,a=10,"
+              "w=d,a=10,"
+              "f=0,w=a,a=11,"
+              "w=b,a=11,"
+              "w=e,a=11,"
+              "w=f,a=11,"
+              "f=1,w=a,a=11,"
+              "w=g,a=11",
+              _inserter.toStr());
+}
+
+TEST_F(DocumentInverterTest, require_that_reput_works_with_shards)
+{
+    _sharded_inv.invertDocument(10, *makeDoc10(_b));
+    _sharded_inv.invertDocument(10, *makeDoc11(_b));
+    push_sharded_documents();
+    EXPECT_EQ("f=0,w=a,a=10,"
+              "w=b,a=10,"
+              "w=e,a=10,"
+              "w=f,a=10,"
+              "f=1,w=a,a=10,"
+              "w=g,a=10",
+              _inserter.toStr());
+}
+
 }
 }
 
@@ -19,6 +19,7 @@
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -136,6 +137,40 @@ public:
     }
 };
 
+/**
+ * Builder handing out one MyBuilder per field, collecting the output
+ * of each field when its field builder is destroyed.
+ */
+class MyParallelBuilder : public MyBuilder {
+private:
+    class FieldBuilder : public MyBuilder {
+        std::string &_out;
+    public:
+        FieldBuilder(const Schema &schema, std::string &out) : MyBuilder(schema), _out(out) {}
+        ~FieldBuilder() override { _out = toStr(); }
+    };
+    std::vector<std::string> _fields;
+
+public:
+    MyParallelBuilder(const Schema &schema)
+        : MyBuilder(schema),
+          _fields(schema.getNumIndexFields())
+    {}
+    std::unique_ptr<IndexBuilder> make_field_builder(uint32_t fieldId) override {
+        return std::make_unique<FieldBuilder>(_schema, _fields[fieldId]);
+    }
+    std::string fieldsToStr() const {
+        std::string result;
+        for (const auto &field : _fields) {
+            if (!result.empty()) {
+                result += ",";
+            }
+            result += field;
+        }
+        return result;
+    }
+};
+
 struct SimpleMatchData {
     TermFieldMatchData term;
     TermFieldMatchDataArray array;
@@ -846,6 +881,31 @@ TEST_F(FieldIndexCollectionTest, require_that_dumping_of_multiple_fields_to_inde
               b.toStr());
 }
 
+TEST_F(FieldIndexCollectionTest, require_that_fields_can_be_dumped_in_parallel_to_field_builders)
+{
+    WrapInserter(fic, 0).word("a").add(5, getFeatures(2, 1)).flush();
+    WrapInserter(fic, 1).word("a").add(5, getFeatures(3, 1)).
+            add(7, getFeatures(3, 2)).
+            word("b").add(5, getFeatures(12, 2)).flush();
+    WrapInserter(fic, 3).word("c").add(9, getFeatures(4, 1)).flush();
+    MyBuilder sequential(schema);
+    fic.dump(sequential);
+    MyParallelBuilder parallel(schema);
+    vespalib::ThreadStackExecutor executor(4, 0x10000);
+    fic.dump(parallel, executor);
+    EXPECT_EQ("", parallel.toStr());
+    EXPECT_EQ(sequential.toStr(), parallel.fieldsToStr());
+    {
+        search::diskindex::IndexBuilder b(schema);
+        b.setPrefix("pdump");
+        TuneFileIndexing tuneFileIndexing;
+        DummyFileHeaderContext fileHeaderContext;
+        b.open(10, 3, MockFieldLengthInspector(), tuneFileIndexing, fileHeaderContext);
+        fic.dump(b, executor);
+        b.close();
+    }
+}
+
 TEST_F(FieldIndexCollectionTest, require_that_dumping_words_with_no_docs_to_index_builder_is_working)
 {
     WrapInserter(fic, 0).word("a").add(2, getFeatures(2, 1)).
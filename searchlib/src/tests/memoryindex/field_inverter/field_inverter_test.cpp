@@ -362,6 +362,32 @@ TEST_F(FieldInverterTest, require_that_average_field_length_is_calculated)
     assert_calculator(1, 2.0, 1);
 }
 
+TEST_F(FieldInverterTest, require_that_repeated_words_are_inverted)
+{
+    auto &inverter = *_inverters[0];
+    inverter.startDoc(18);
+    inverter.startElement(1);
+    for (uint32_t i = 0; i < 3; ++i) {
+        inverter.addWord("foo");
+        inverter.addWord("bar");
+    }
+    inverter.endElement();
+    inverter.endDoc();
+    inverter.startDoc(19);
+    inverter.startElement(1);
+    inverter.addWord("bar");
+    inverter.addWord("bar");
+    inverter.endElement();
+    inverter.endDoc();
+    inverter.remove("foo", 9);
+    _inserter.setVerbose();
+    pushDocuments();
+    EXPECT_EQ("f=0,"
+              "w=bar,a=18(e=0,w=1,l=6[1,3,5]),a=19(e=0,w=1,l=2[0,1]),"
+              "w=foo,r=9,a=18(e=0,w=1,l=6[0,2,4])",
+              _inserter.toStr());
+}
+
 }
 }
 
@@ -54,6 +54,7 @@ private:
     void testNativeAttributeMatch();
     void testNativeProximity();
     void testNativeRank();
+    void testNativeRankScoreThreshold();
 
 public:
     ~Test();
@@ -806,7 +807,53 @@ Test::assertNativeRank(feature_t score,
     return true;
 }
 
-
+void
+Test::testNativeRankScoreThreshold()
+{
+    NativeRankParams params;
+    params.fieldMatchWeight = 100;
+    params.attributeMatchWeight = 100;
+    params.proximityWeight = 25;
+    params.normalizedInputs = true;
+    // fieldMatch, proximity, attributeMatch
+    std::vector<NumberOrObject> in(3);
+    in[0].as_number = 0.5;
+    in[1].as_number = 0.8;
+    in[2].as_number = 0.2;
+    std::vector<LazyValue> inputs;
+    for (const auto &value : in) {
+        inputs.emplace_back(&value);
+    }
+    std::vector<NumberOrObject> out(1);
+    feature_t threshold = -HUGE_VAL;
+    {
+        NativeRankExecutor executor(params);
+        executor.bind_inputs(inputs);
+        executor.bind_outputs(out);
+        executor.bind_score_threshold(&threshold);
+        executor.lazy_execute(1);
+        EXPECT_APPROX(90.0 / 225, out[0].as_number, EPS);
+        threshold = 0.5; // proximity cannot lift the score to the threshold
+        executor.lazy_execute(2);
+        EXPECT_APPROX(95.0 / 225, out[0].as_number, EPS);
+        threshold = 0.7; // neither fieldMatch nor proximity can lift the score to the threshold
+        executor.lazy_execute(3);
+        EXPECT_APPROX(145.0 / 225, out[0].as_number, EPS);
+        threshold = 0.3;
+        executor.lazy_execute(4);
+        EXPECT_APPROX(90.0 / 225, out[0].as_number, EPS);
+    }
+    { // the threshold is ignored when the sub features may be larger than 1
+        params.normalizedInputs = false;
+        NativeRankExecutor executor(params);
+        executor.bind_inputs(inputs);
+        executor.bind_outputs(out);
+        executor.bind_score_threshold(&threshold);
+        threshold = 0.7;
+        executor.lazy_execute(1);
+        EXPECT_APPROX(90.0 / 225, out[0].as_number, EPS);
+    }
+}
 
 int
 Test::Main()
@@ -821,6 +868,7 @@ Test::Main()
     testNativeAttributeMatch();
     testNativeProximity();
     testNativeRank();
+    testNativeRankScoreThreshold();
 
     TEST_DONE();
     return 0;
@@ -1,5 +1,6 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/test/fakedata/fake_match_loop.h>
 #include <vespa/searchlib/test/fakedata/fakeposting.h>
 #include <vespa/searchlib/test/fakedata/fakeword.h>
@@ -33,6 +34,17 @@ validate_posting_list_for_word(const FakePosting& posting, const FakeWord& word)
     } else {
         word.validate(iterator.get(), false);
     }
+    std::unique_ptr<SearchIterator> hits_iterator(posting.createIterator(tfmda));
+    hits_iterator->initRange(1, word.getDocIdLimit());
+    auto hits = hits_iterator->get_hits(1);
+    word.validate(*hits);
+    uint32_t mid_doc_id = word.getDocIdLimit() / 2;
+    std::unique_ptr<SearchIterator> range_hits_iterator(posting.createIterator(tfmda));
+    range_hits_iterator->initRange(mid_doc_id / 2, mid_doc_id);
+    auto range_hits = range_hits_iterator->get_hits(mid_doc_id / 2);
+    for (uint32_t doc_id = mid_doc_id / 2; doc_id < mid_doc_id; ++doc_id) {
+        ASSERT_EQ(hits->testBit(doc_id), range_hits->testBit(doc_id));
+    }
 }
 
 void
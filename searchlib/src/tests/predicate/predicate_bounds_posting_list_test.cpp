@@ -105,6 +105,39 @@ TEST("require that bounds posting list checks bounds.") {
     checkNext(posting_list2, 60, 61, 10);  // [31..40] -> [40..49]
 }
 
+TEST("require that bounds posting list handles documents sharing interval entries.") {
+    PredicateIndex index(generation_handler, generation_holder, limit_provider, config, 8);
+    const auto &bounds_index = index.getBoundsIndex();
+    for (uint32_t id = 1; id < 20; ++id) {
+        PredicateTreeAnnotations annotations(id);
+        auto &vec = annotations.bounds_map[hash];
+        uint32_t lower = (id < 10) ? 3 : 7;  // two distinct, shared entries
+        vec.push_back(IntervalWithBounds{0x0001ffff, 0x80000000 | lower});
+        vec.push_back(IntervalWithBounds{0x0002ffff, 0x80000000 | 4});
+        index.indexDocument(id, annotations);
+    }
+    index.commit();
+    auto it = bounds_index.lookup(hash);
+    ASSERT_TRUE(it.valid());
+    auto ref = it.getData();
+
+    PredicateBoundsPostingList<PredicateIndex::BTreeIterator>
+        posting_list(index.getIntervalStore(),
+                     bounds_index.getBTreePostingList(ref), 5);
+    for (uint32_t id = 1; id < 20; ++id) {
+        checkNext(posting_list, id - 1, id, (id < 10) ? 2 : 1);
+    }
+    EXPECT_FALSE(posting_list.next(19));
+
+    PredicateBoundsPostingList<PredicateIndex::BTreeIterator>
+        posting_list2(index.getIntervalStore(),
+                      bounds_index.getBTreePostingList(ref), 3);
+    for (uint32_t id = 1; id < 10; ++id) {
+        checkNext(posting_list2, id - 1, id, 1);
+    }
+    EXPECT_FALSE(posting_list2.next(9));
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
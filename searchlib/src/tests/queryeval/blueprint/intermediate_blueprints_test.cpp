@@ -1453,4 +1453,55 @@ TEST("require that intermediate cost tier is minimum cost tier of children") {
     EXPECT_EQUAL(bp2->getState().cost_tier(), 2u);
 }
 
+TEST("require that AND sorts children by estimated work within a cost tier") {
+    //-------------------------------------------------------------------------
+    Blueprint::UP top_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(10).create())).
+               addChild(ap(MyLeafSpec(15).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(30).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(5).cost(4.0).create()))));
+    //-------------------------------------------------------------------------
+    Blueprint::UP expect_up(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(15).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(10).create())).
+               addChild(ap(MyLeafSpec(30).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(5).cost(4.0).create()))));
+    //-------------------------------------------------------------------------
+    EXPECT_NOT_EQUAL(expect_up->asString(), top_up->asString());
+    top_up = Blueprint::optimize(std::move(top_up));
+    EXPECT_EQUAL(expect_up->asString(), top_up->asString());
+}
+
+TEST("require that OR sorts children by estimate per unit of cost within a cost tier") {
+    //-------------------------------------------------------------------------
+    Blueprint::UP top_up(
+            ap((new OrBlueprint())->
+               addChild(ap(MyLeafSpec(50).cost(4.0).create())).
+               addChild(ap(MyLeafSpec(20).create())).
+               addChild(ap(MyLeafSpec(15).cost(0.5).create()))));
+    //-------------------------------------------------------------------------
+    Blueprint::UP expect_up(
+            ap((new OrBlueprint())->
+               addChild(ap(MyLeafSpec(15).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(20).create())).
+               addChild(ap(MyLeafSpec(50).cost(4.0).create()))));
+    //-------------------------------------------------------------------------
+    EXPECT_NOT_EQUAL(expect_up->asString(), top_up->asString());
+    top_up = Blueprint::optimize(std::move(top_up));
+    EXPECT_EQUAL(expect_up->asString(), top_up->asString());
+}
+
+TEST("require that intermediate cost is maximum cost of children") {
+    Blueprint::UP bp(
+            ap((new AndBlueprint())->
+               addChild(ap(MyLeafSpec(10).cost(0.5).create())).
+               addChild(ap(MyLeafSpec(20).cost(2.0).create())).
+               addChild(ap(MyLeafSpec(30).create()))));
+    Blueprint::UP leaf(MyLeafSpec(10).create());
+    EXPECT_EQUAL(bp->getState().cost(), 2.0);
+    EXPECT_EQUAL(leaf->getState().cost(), Blueprint::State::COST_NORMAL);
+}
+
 TEST_MAIN() { TEST_DEBUG("lhs.out", "rhs.out"); TEST_RUN_ALL(); }
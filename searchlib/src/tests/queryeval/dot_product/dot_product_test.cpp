@@ -44,6 +44,13 @@ struct DP {
         return *this;
     }
 
+    DP &add_unmatched(size_t num_tokens) {
+        for (size_t i = 0; i < num_tokens; ++i) {
+            add(vespalib::make_string("unmatched%zu", i), 1);
+        }
+        return *this;
+    }
+
     Node::UP createNode() const {
         SimpleDotProduct *node = new SimpleDotProduct("view", 0, Weight(0));
         for (size_t i = 0; i < tokens.size(); ++i) {
@@ -159,6 +166,21 @@ TEST("test Multi") {
     EXPECT_EQUAL(expect, ws.search(index, "multi-field", false));
 }
 
+TEST("test Many Terms") {
+    FakeSearchable index;
+    setupFakeSearchable(index);
+    FakeResult expect = FakeResult()
+                        .doc(3).score(30 * 3 + 130 * 2 * 3 + 230 * 3 * 3)
+                        .doc(5).score(50 * 5 + 150 * 2 * 5)
+                        .doc(7).score(70 * 7);
+    DP ws = DP().add("7", 70).add("5", 50).add("3", 30)
+            .add("15", 150).add("13", 130)
+            .add("23", 230).add_unmatched(DotProductSearch::windowed_term_limit);
+
+    EXPECT_EQUAL(expect, ws.search(index, "multi-field", true));
+    EXPECT_EQUAL(expect, ws.search(index, "multi-field", false));
+}
+
 TEST_F("test Eager Empty Child", MockFixture(search::endDocId, {})) {
     MockSearch *mock = f1.mock;
     SearchIterator &search = *f1.search;
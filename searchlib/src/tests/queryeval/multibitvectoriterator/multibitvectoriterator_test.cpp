@@ -33,6 +33,7 @@ public:
     void testOr();
     void testAndWith(bool invert);
     void testEndGuard(bool invert);
+    void testStrictSearchSpanningWindows(bool isAnd, bool invert);
     void testIteratorConformance();
     void testUnpackOfOr();
     template<typename T>
@@ -582,6 +583,53 @@ Test::testEndGuard(bool invert)
     EXPECT_FALSE(m.seek(_bvs[0]->size()+987));
 }
 
+void
+Test::testStrictSearchSpanningWindows(bool isAnd, bool invert)
+{
+    // Strict iterators combine 32768 documents at a time, make sure to span several windows with a partial last one.
+    const uint32_t docIdLimit = 3*32768 + 1000;
+    std::minstd_rand rnd(7);
+    std::vector<BitVector::UP> bvs;
+    for (size_t i(0); i < 3; i++) {
+        bvs.push_back(BitVector::create(docIdLimit));
+        BitVector & bv(*bvs.back());
+        for (uint32_t docId(1); docId < docIdLimit; docId++) {
+            // Sparse vectors, leaving some all zero words in the combined result
+            if ((rnd() % 7) == 0) {
+                bv.setBit(docId);
+            }
+        }
+        if (invert) {
+            bv.notSelf();
+        }
+    }
+    TermFieldMatchData tfmd;
+    MultiSearch::Children children;
+    for (const auto & bv : bvs) {
+        children.push_back(BitVectorIterator::create(bv.get(), tfmd, true, invert));
+    }
+    SearchIterator::UP s(isAnd ? AndSearch::create(std::move(children), true) : OrSearch::create(std::move(children), true));
+    s = MultiBitVectorIteratorBase::optimize(std::move(s));
+    EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get()) != nullptr);
+    EXPECT_TRUE(Trinary::True == s->is_strict());
+    H expected;
+    for (uint32_t docId(1); docId < docIdLimit; docId++) {
+        size_t numSet(0);
+        for (const auto & bv : bvs) {
+            numSet += (bv->testBit(docId) != invert) ? 1 : 0;
+        }
+        if (isAnd ? (numSet == bvs.size()) : (numSet > 0)) {
+            expected.push_back(docId);
+        }
+    }
+    H actual = seek(*s, docIdLimit);
+    EXPECT_FALSE(expected.empty());
+    EXPECT_TRUE(expected == actual);
+    s->initFullRange();
+    EXPECT_FALSE(s->seek(docIdLimit));
+    EXPECT_TRUE(s->isAtEnd());
+}
+
 class Verifier : public search::test::SearchIteratorVerifier {
 public:
     Verifier(size_t numBv, bool is_and);
@@ -650,6 +698,11 @@ Test::Main()
     testEndGuard(false);
     testEndGuard(true);
     TEST_FLUSH();
+    testStrictSearchSpanningWindows(true, false);
+    testStrictSearchSpanningWindows(true, true);
+    testStrictSearchSpanningWindows(false, false);
+    testStrictSearchSpanningWindows(false, true);
+    TEST_FLUSH();
     testAndNot();
     TEST_FLUSH();
     testAnd();
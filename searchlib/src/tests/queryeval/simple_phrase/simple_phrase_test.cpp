@@ -42,6 +42,7 @@ struct MyTerm : public search::queryeval::SimpleLeafBlueprint {
 class Test : public vespalib::TestApp {
     void requireThatIteratorFindsSimplePhrase(bool useBlueprint);
     void requireThatIteratorFindsLongPhrase(bool useBlueprint);
+    void requireThatPhraseIsFoundInLongPositionLists(bool useBlueprint);
     void requireThatStrictIteratorFindsNextMatch(bool useBlueprint);
     void requireThatPhrasesAreUnpacked(bool useBlueprint, bool unpack_normal_features, bool unpack_interleaved_features);
     void requireThatTermsCanBeEvaluatedInPriorityOrder();
@@ -62,6 +63,7 @@ Test::Main()
 
     TEST_DO(requireThatIteratorFindsSimplePhrase(false));
     TEST_DO(requireThatIteratorFindsLongPhrase(false));
+    TEST_DO(requireThatPhraseIsFoundInLongPositionLists(false));
     TEST_DO(requireThatStrictIteratorFindsNextMatch(false));
     TEST_DO(requireThatPhrasesAreUnpacked(false, true, false));
     TEST_DO(requireThatPhrasesAreUnpacked(false, true, true));
@@ -71,6 +73,7 @@ Test::Main()
 
     TEST_DO(requireThatIteratorFindsSimplePhrase(true));
     TEST_DO(requireThatIteratorFindsLongPhrase(true));
+    TEST_DO(requireThatPhraseIsFoundInLongPositionLists(true));
     TEST_DO(requireThatStrictIteratorFindsNextMatch(true));
     TEST_DO(requireThatPhrasesAreUnpacked(true, true, false));
     TEST_DO(requireThatPhrasesAreUnpacked(true, true, true));
@@ -263,6 +266,44 @@ void Test::requireThatIteratorFindsLongPhrase(bool useBlueprint) {
     EXPECT_TRUE(!search->seek(doc_no_match));
 }
 
+void Test::requireThatPhraseIsFoundInLongPositionLists(bool useBlueprint) {
+    FakeResult foo;
+    FakeResult bar;
+    foo.doc(doc_match).elem(0);
+    bar.doc(doc_match).elem(0);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        foo.pos(3 * i);
+        bar.pos(3 * i + 2);
+        if (i == 499) {
+            bar.pos(1501); // only match in element 0
+        }
+    }
+    foo.elem(1).pos(7);
+    bar.elem(1).pos(8);
+    foo.doc(doc_no_match).elem(0);
+    bar.doc(doc_no_match).elem(0);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        foo.pos(3 * i);
+        bar.pos(3 * i + 2);
+    }
+    foo.elem(1).pos(7);
+    bar.elem(2).pos(8);
+
+    PhraseSearchTest test;
+    test.addTerm("foo", foo).addTerm("bar", bar);
+    test.writable_term_field_match_data().setNeedNormalFeatures(true);
+    test.fetchPostings(useBlueprint);
+    unique_ptr<SearchIterator> search(test.createSearch(useBlueprint));
+    EXPECT_TRUE(search->seek(doc_match));
+    search->unpack(doc_match);
+    ASSERT_EQUAL(2, std::distance(test.tmd().begin(), test.tmd().end()));
+    EXPECT_EQUAL(0u, test.tmd().begin()->getElementId());
+    EXPECT_EQUAL(1500u, test.tmd().begin()->getPosition());
+    EXPECT_EQUAL(1u, (test.tmd().begin() + 1)->getElementId());
+    EXPECT_EQUAL(7u, (test.tmd().begin() + 1)->getPosition());
+    EXPECT_TRUE(!search->seek(doc_no_match));
+}
+
 void Test::requireThatStrictIteratorFindsNextMatch(bool useBlueprint) {
     PhraseSearchTest test;
     test.setStrict(true);
@@ -140,6 +140,44 @@ TEST("test full sourceblender search") {
     EXPECT_EQUAL(expect_unpacked_c, uc->getUnpacked());
 }
 
+TEST("require that children skip documents selecting other sources") {
+    SimpleResult a;
+    SimpleResult b;
+    for (uint32_t docid = 1; docid < 2000; ++docid) {
+        a.addHit(docid);
+        b.addHit(docid);
+    }
+    auto sel = make_unique<MySelector>(5);
+    SimpleResult expect_result;
+    SimpleResult expect_unpacked_a;
+    SimpleResult expect_unpacked_b;
+    for (uint32_t docid = 1; docid < 2000; ++docid) {
+        if (docid % 700 == 3) {
+            sel->set(1, docid);
+            expect_unpacked_a.addHit(docid);
+            expect_result.addHit(docid);
+        } else if ((docid > 1500) && (docid % 2 == 0)) {
+            sel->set(2, docid);
+            expect_unpacked_b.addHit(docid);
+            expect_result.addHit(docid);
+        } else {
+            sel->set(3, docid);
+        }
+    }
+    UnpackChecker *ua = new UnpackChecker(new SimpleSearch(a));
+    UnpackChecker *ub = new UnpackChecker(new SimpleSearch(b));
+    SourceBlenderSearch::Children ab;
+    ab.push_back(SourceBlenderSearch::Child(ua, 1));
+    ab.push_back(SourceBlenderSearch::Child(ub, 2));
+
+    SearchIterator::UP blend(SourceBlenderSearch::create(sel->createIterator(), ab, true));
+    SimpleResult result;
+    result.search(*blend);
+    EXPECT_EQUAL(expect_result, result);
+    EXPECT_EQUAL(expect_unpacked_a, ua->getUnpacked());
+    EXPECT_EQUAL(expect_unpacked_b, ub->getUnpacked());
+}
+
 using search::test::SearchIteratorVerifier;
 
 class Verifier : public SearchIteratorVerifier {
@@ -277,6 +277,66 @@ TEST("require that termwise wrapper is rewindable") {
     TEST_DO(verify(make_expect(1, 5), *search, 1, 5));
 }
 
+TEST("require that adaptive termwise AND/OR search produces appropriate results") {
+    for (uint32_t begin: {1, 2, 5}) {
+        for (uint32_t end: {6, 7, 10}) {
+            for (bool strict_search: {true, false}) {
+                for (bool strict_wrapper: {true, false}) {
+                    TEST_STATE(make_string("begin: %u, end: %u, strict_search: %s, strict_wrapper: %s",
+                                    begin, end, strict_search ? "true" : "false",
+                                    strict_wrapper ? "true" : "false").c_str());
+                    auto search = make_adaptive_termwise(make_search(strict_search), strict_wrapper);
+                    TEST_DO(verify(make_expect(begin, end), *search, begin, end));
+                }
+            }
+        }
+    }
+}
+
+void verify_with_stride(const std::vector<uint32_t> &hits, SearchIterator &search,
+                        uint32_t begin, uint32_t end, uint32_t stride)
+{
+    std::vector<uint32_t> expect;
+    for (uint32_t hit: hits) {
+        if ((hit >= begin) && (hit < end) && ((hit - begin) % stride == 0)) {
+            expect.push_back(hit);
+        }
+    }
+    std::vector<uint32_t> actual;
+    search.initRange(begin, end);
+    for (uint32_t docid = begin; docid < end; docid += stride) {
+        if (search.seek(docid)) {
+            actual.push_back(docid);
+        }
+    }
+    EXPECT_EQUAL(expect, actual);
+}
+
+TEST("require that adaptive termwise search gives the same results for dense and sparse seeks over many windows") {
+    std::vector<uint32_t> hits;
+    for (uint32_t docid = 1; docid < 100000; docid += 3) {
+        hits.push_back(docid);
+    }
+    for (uint32_t stride: {1, 7, 100}) {
+        for (bool strict_search: {true, false}) {
+            for (bool strict_wrapper: {true, false}) {
+                TEST_STATE(make_string("stride: %u, strict_search: %s, strict_wrapper: %s", stride,
+                                       strict_search ? "true" : "false",
+                                       strict_wrapper ? "true" : "false").c_str());
+                auto search = make_adaptive_termwise(UP(new MyTerm(hits, strict_search)), strict_wrapper);
+                TEST_DO(verify_with_stride(hits, *search, 1, 100000, stride));
+                TEST_DO(verify_with_stride(hits, *search, 5000, 70000, stride));
+            }
+        }
+    }
+}
+
+TEST("require that adaptive termwise wrapper is rewindable") {
+    auto search = make_adaptive_termwise(make_search(true), true);
+    TEST_DO(verify(make_expect(3, 7), *search, 3, 7));
+    TEST_DO(verify(make_expect(1, 5), *search, 1, 5));
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that leaf blueprints allow termwise evaluation by default") {
@@ -358,6 +418,15 @@ TEST("require that match data keeps track of the termwise limit") {
     EXPECT_EQUAL(0.03, md->get_termwise_limit());
 }
 
+TEST("require that match data keeps track of adaptive termwise evaluation") {
+    auto md = make_match_data();
+    EXPECT_FALSE(md->get_adaptive_termwise());
+    md->set_adaptive_termwise(true);
+    EXPECT_TRUE(md->get_adaptive_termwise());
+    md->soft_reset();
+    EXPECT_FALSE(md->get_adaptive_termwise());
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that terwise test search string dump is detailed enough") {
@@ -406,6 +475,26 @@ TEST("require that the hit rate must be high enough for termwise evaluation to b
     }
 }
 
+TEST("require that adaptive termwise evaluation is used when the hit rate is below the termwise limit") {
+    auto md = make_match_data();
+    md->set_termwise_limit(1.0);
+    md->set_adaptive_termwise(true);
+    md->resolveTermField(1)->tagAsNotNeeded();
+    md->resolveTermField(2)->tagAsNotNeeded();
+    OrBlueprint my_or;
+    my_or.addChild(UP(new MyBlueprint({1}, true, 1)));
+    my_or.addChild(UP(new MyBlueprint({2}, true, 2)));
+    for (bool strict: {true, false}) {
+        EXPECT_EQUAL(my_or.createSearch(*md, strict)->asString(),
+                     make_adaptive_termwise(OR({ TERM({1}, strict), TERM({2}, strict) }, strict), strict)->asString());
+    }
+    md->set_termwise_limit(0.0);
+    for (bool strict: {true, false}) {
+        EXPECT_EQUAL(my_or.createSearch(*md, strict)->asString(),
+                     make_termwise(OR({ TERM({1}, strict), TERM({2}, strict) }, strict), strict)->asString());
+    }
+}
+
 TEST("require that enough unranked termwise terms are present for termwise evaluation to be activated") {
     auto md = make_match_data();
     md->set_termwise_limit(0.0);
@@ -660,6 +749,17 @@ TEST("test terwise adheres to search iterator requirements.") {
     verifier.verify();
 }
 
+class AdaptiveVerifier : public search::test::SearchIteratorVerifier {
+public:
+    SearchIterator::UP create(bool strict) const override {
+        return make_adaptive_termwise(createIterator(getExpectedDocIds(), strict), strict);
+    }
+};
+TEST("test adaptive termwise adheres to search iterator requirements.") {
+    AdaptiveVerifier verifier;
+    verifier.verify();
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
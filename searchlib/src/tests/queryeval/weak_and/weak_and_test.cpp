@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/queryeval/fake_search.h>
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <vespa/searchlib/queryeval/wand/i_block_max_search.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/queryeval/simplesearch.h>
 #include <vespa/searchlib/queryeval/test/eagerchild.h>
@@ -52,6 +53,134 @@ struct AdvancedWandFixture {
     }
 };
 
+/**
+ * Posting list with num occs, split into blocks of fixed size.
+ */
+class MyBlockMaxSearch : public SearchIterator, public IBlockMaxSearch
+{
+public:
+    using Posting = std::pair<uint32_t, uint32_t>; // docid, num occs
+private:
+    std::vector<Posting> _postings;
+    uint32_t             _block_size;
+    size_t               _pos;
+    uint32_t            &_decoded;
+
+    size_t block_begin() const { return _pos - (_pos % _block_size); }
+    size_t block_end() const { return std::min(block_begin() + _block_size, _postings.size()); }
+    void update_docid() {
+        if (_pos < _postings.size()) {
+            setDocId(_postings[_pos].first);
+        } else {
+            setAtEnd();
+        }
+    }
+    void skip_blocks(uint32_t docid) {
+        while (_pos < _postings.size() && _postings[block_end() - 1].first < docid) {
+            _pos = block_end();
+        }
+    }
+public:
+    MyBlockMaxSearch(std::vector<Posting> postings, uint32_t block_size, uint32_t &decoded)
+        : _postings(std::move(postings)),
+          _block_size(block_size),
+          _pos(0),
+          _decoded(decoded)
+    {
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        skip_blocks(docid);
+        while (_pos < _postings.size() && _postings[_pos].first < docid) {
+            ++_pos;
+            ++_decoded;
+        }
+        update_docid();
+    }
+    void doUnpack(uint32_t) override {}
+    bool has_block_max() const override { return true; }
+    uint32_t seek_block(uint32_t docid) override {
+        size_t old_pos = _pos;
+        skip_blocks(docid);
+        if (_pos != old_pos) {
+            update_docid();
+        }
+        return (_pos < _postings.size()) ? _postings[block_end() - 1].first : search::endDocId;
+    }
+    uint32_t get_block_max_num_occs() const override {
+        uint32_t result = 0;
+        for (size_t i = block_begin(); i < block_end(); ++i) {
+            result = std::max(result, _postings[i].second);
+        }
+        return result;
+    }
+    uint32_t get_num_occs() const override { return _postings[_pos].second; }
+};
+
+struct BlockMaxWandFixture {
+    wand::Terms terms;
+    std::vector<std::vector<MyBlockMaxSearch::Posting>> postings;
+    uint32_t decoded;
+    BlockMaxWandFixture() : terms(), postings(), decoded(0) {}
+    template <typename NumOccs>
+    void add_posting_list(uint32_t stride, int32_t weight, NumOccs num_occs) {
+        std::vector<MyBlockMaxSearch::Posting> list;
+        for (uint32_t docid = stride; docid < 10000; docid += stride) {
+            list.emplace_back(docid, num_occs(docid));
+        }
+        postings.push_back(list);
+        terms.emplace_back(new MyBlockMaxSearch(list, 16, decoded), weight, list.size());
+    }
+    void add_term(uint32_t stride, uint32_t num_occs_mod, int32_t weight) {
+        add_posting_list(stride, weight, [num_occs_mod](uint32_t docid) { return 1 + ((docid * 7) % num_occs_mod); });
+    }
+    uint32_t total_postings() const {
+        uint32_t result = 0;
+        for (const auto &list : postings) {
+            result += list.size();
+        }
+        return result;
+    }
+    std::vector<wand::score_t> expected_top_scores(uint32_t n) const {
+        std::map<uint32_t, wand::score_t> scores;
+        for (size_t i = 0; i < terms.size(); ++i) {
+            wand::score_t max_score = wand::TermFrequencyScorer::calculateMaxScore(terms[i]);
+            for (const auto &posting : postings[i]) {
+                scores[posting.first] += wand::NumOccsScorer::calculate_score(max_score, posting.second);
+            }
+        }
+        std::vector<wand::score_t> result;
+        for (const auto &entry : scores) {
+            result.push_back(entry.second);
+        }
+        std::sort(result.begin(), result.end(), std::greater<wand::score_t>());
+        result.resize(std::min(result.size(), size_t(n)));
+        return result;
+    }
+    std::vector<wand::score_t> hit_top_scores(const SimpleResult &hits, uint32_t n) const {
+        std::vector<wand::score_t> result;
+        for (size_t hit = 0; hit < hits.getHitCount(); ++hit) {
+            uint32_t docid = hits.getHit(hit);
+            wand::score_t score = 0;
+            for (size_t i = 0; i < terms.size(); ++i) {
+                wand::score_t max_score = wand::TermFrequencyScorer::calculateMaxScore(terms[i]);
+                for (const auto &posting : postings[i]) {
+                    if (posting.first == docid) {
+                        score += wand::NumOccsScorer::calculate_score(max_score, posting.second);
+                    }
+                }
+            }
+            result.push_back(score);
+        }
+        std::sort(result.begin(), result.end(), std::greater<wand::score_t>());
+        result.resize(std::min(result.size(), size_t(n)));
+        return result;
+    }
+};
+
 struct WeightOrder {
     bool operator()(const wand::Term &t1, const wand::Term &t2) const {
         return (t1.weight < t2.weight);
@@ -99,6 +228,40 @@ TEST("require that initial docid for subsearches are taken into account") {
                  history);
 }
 
+TEST_F("require that block max wand is used when all terms have block max info", BlockMaxWandFixture) {
+    f.add_term(1, 3, 100);
+    f.add_term(3, 5, 200);
+    SearchIterator::UP search(WeakAndSearch::create(f.terms, 10, true));
+    SimpleResult hits;
+    hits.search(*search);
+    EXPECT_EQUAL(f.expected_top_scores(10), f.hit_top_scores(hits, 10));
+}
+
+TEST_F("require that block max wand finds the best hits", BlockMaxWandFixture) {
+    f.add_term(1, 2, 100);
+    f.add_term(2, 3, 100);
+    f.add_term(7, 11, 300);
+    f.add_term(13, 17, 500);
+    SearchIterator::UP search(WeakAndSearch::createBlockMaxWand(f.terms, 20, true));
+    SimpleResult hits;
+    hits.search(*search);
+    EXPECT_EQUAL(f.expected_top_scores(20), f.hit_top_scores(hits, 20));
+    EXPECT_LESS(hits.getHitCount(), 9999u / 2);
+    EXPECT_LESS(f.decoded, f.total_postings());
+}
+
+TEST_F("require that block max wand skips blocks that cannot enter the heap", BlockMaxWandFixture) {
+    auto num_occs = [](uint32_t docid) { return (docid <= 16) ? 10u : (1u + (docid % 3)); };
+    f.add_posting_list(1, 100, num_occs);
+    f.add_posting_list(1, 100, num_occs);
+    SearchIterator::UP search(WeakAndSearch::createBlockMaxWand(f.terms, 10, true));
+    SimpleResult hits;
+    hits.search(*search);
+    EXPECT_EQUAL(f.expected_top_scores(10), f.hit_top_scores(hits, 10));
+    EXPECT_EQUAL(16u, hits.getHitCount());
+    EXPECT_LESS(f.decoded, 100u);
+}
+
 class IteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
 private:
     SearchIterator::UP create(bool strict) const override {
@@ -111,9 +274,30 @@ private:
     }
 };
 
+class BlockMaxIteratorChildrenVerifier : public search::test::IteratorChildrenVerifier {
+private:
+    mutable uint32_t _decoded = 0;
+    SearchIterator::UP create(bool strict) const override {
+        wand::Terms terms;
+        for (size_t i = 0; i < _num_children; ++i) {
+            std::vector<MyBlockMaxSearch::Posting> postings;
+            for (uint32_t docid : _split_lists[i]) {
+                postings.emplace_back(docid, 1 + (docid % 3));
+            }
+            terms.emplace_back(new MyBlockMaxSearch(postings, 4, _decoded), 100, postings.size());
+        }
+        return SearchIterator::UP(WeakAndSearch::createBlockMaxWand(terms, -1, strict));
+    }
+};
+
 TEST("verify search iterator conformance") {
     IteratorChildrenVerifier verifier;
     verifier.verify();
 }
 
+TEST("verify block max search iterator conformance") {
+    BlockMaxIteratorChildrenVerifier verifier;
+    verifier.verify();
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -30,6 +30,7 @@ public:
     void testStringCaseInsensitiveSort();
     void testSortSpec();
     void testSameAsJavaOrder();
+    void testUcaSortKeyCache();
 };
 
 struct LoadedStrings
@@ -278,6 +279,28 @@ void Test::testSameAsJavaOrder()
 
 TEST_APPHOOK(Test);
 
+void Test::testUcaSortKeyCache()
+{
+    UcaConverterFactory ucaFactory;
+    UcaConverter uncached("nb_NO", "TERTIARY");
+    auto cache = SortKeyCache::get("nb_NO", "TERTIARY");
+    EXPECT_TRUE(cache.get() == SortKeyCache::get("nb_NO", "TERTIARY").get());
+    EXPECT_TRUE(cache.get() != SortKeyCache::get("nb_NO", "PRIMARY").get());
+    size_t before = cache->size();
+    auto first = ucaFactory.create("nb_NO", "TERTIARY");
+    auto second = ucaFactory.create("nb_NO", "TERTIARY");
+    for (const char *value : {"\xc3\xa6bler", "Zebra", "aa", "\xc3\xa5r"}) {
+        ConstBufferRef src(value, strlen(value) + 1);
+        ConstBufferRef exp = uncached.convert(src);
+        vespalib::string expected(exp.c_str(), exp.size());
+        ConstBufferRef a = first->convert(src);
+        EXPECT_EQUAL(expected, vespalib::string(a.c_str(), a.size()));
+        ConstBufferRef b = second->convert(src);
+        EXPECT_EQUAL(expected, vespalib::string(b.c_str(), b.size()));
+    }
+    EXPECT_EQUAL(before + 4, cache->size());
+}
+
 int Test::Main()
 {
     TEST_INIT("sort_test");
@@ -290,6 +313,7 @@ int Test::Main()
     testSortSpec();
     testIcu();
     testSameAsJavaOrder();
+    testUcaSortKeyCache();
 
     TEST_DONE();
 }
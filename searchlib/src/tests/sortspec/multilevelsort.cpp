@@ -427,4 +427,31 @@ TEST("test that [docid] translates to [lid][paritionid]") {
     EXPECT_EQUAL(0, memcmp(SECOND_DESC, sr2.first, 6));
 }
 
+TEST("require that converted string sort data is reused for documents with the same value") {
+    vespalib::Clock clock;
+    vespalib::Doom doom(clock, vespalib::steady_time::max());
+    search::uca::UcaConverterFactory ucaFactory;
+    AttributePtr attr = AttributeFactory::createAttribute("str", Config(BasicType::STRING, CollectionType::SINGLE));
+    auto & strAttr = static_cast<StringAttribute &>(*attr);
+    ASSERT_TRUE(strAttr.addDocs(4));
+    strAttr.update(0, "Bb");
+    strAttr.update(1, "a");
+    strAttr.update(2, "Bb");
+    strAttr.update(3, "Ccc");
+    strAttr.commit();
+    search::AttributeManager mgr;
+    mgr.add(attr);
+    search::AttributeContext ac(mgr);
+    FastS_SortSpec asc(7, doom, ucaFactory);
+    EXPECT_TRUE(asc.Init("+lowercase(str)", ac));
+    RankedHit hits[4] = {RankedHit(0, 0.0), RankedHit(1, 0.0), RankedHit(2, 0.0), RankedHit(3, 0.0)};
+    asc.initWithoutSorting(hits, 4);
+    const std::vector<std::string> expected = {std::string("bb\0", 3), std::string("a\0", 2),
+                                               std::string("bb\0", 3), std::string("ccc\0", 4)};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        auto sr = asc.getSortRef(i);
+        EXPECT_EQUAL(expected[i], std::string(sr.first, sr.second));
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -10,6 +10,7 @@ LOG_SETUP("dense_tensor_store_test");
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
+#include <vespa/vespalib/util/mmap_file_allocator.h>
 
 using search::tensor::DenseTensorStore;
 using vespalib::eval::TensorSpec;
@@ -29,8 +30,9 @@ makeTensor(const TensorSpec &spec)
 struct Fixture
 {
     DenseTensorStore store;
-    Fixture(const vespalib::string &tensorType)
-        : store(ValueType::from_spec(tensorType))
+    Fixture(const vespalib::string &tensorType,
+            std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator = {})
+        : store(ValueType::from_spec(tensorType), std::move(allocator))
     {}
     void assertSetAndGetTensor(const TensorSpec &tensorSpec) {
         Value::UP expTensor = makeTensor(tensorSpec);
@@ -69,6 +71,53 @@ TEST_F("require that correct empty tensor is returned for 1d bound tensor", Fixt
                                    add({{"x", 2}}, 0));
 }
 
+TEST_F("require that we can store 1d bound tensor in memory mapped file",
+       Fixture("tensor(x[3])", std::make_unique<vespalib::alloc::MmapFileAllocator>("dense-tensor-store-dir")))
+{
+    f.assertSetAndGetTensor(TensorSpec("tensor(x[3])").
+                                       add({{"x", 0}}, 2).
+                                       add({{"x", 1}}, 3).
+                                       add({{"x", 2}}, 5));
+}
+
+TEST_F("require that cells can be modified into a new buffer", Fixture("tensor(x[2],y[3])"))
+{
+    Value::UP tensor = makeTensor(TensorSpec("tensor(x[2],y[3])").
+                                  add({{"x", 0}, {"y", 0}}, 1).
+                                  add({{"x", 0}, {"y", 1}}, 2).
+                                  add({{"x", 0}, {"y", 2}}, 3).
+                                  add({{"x", 1}, {"y", 0}}, 4).
+                                  add({{"x", 1}, {"y", 1}}, 5).
+                                  add({{"x", 1}, {"y", 2}}, 6));
+    Value::UP modifier = makeTensor(TensorSpec("tensor(x{},y{})").
+                                    add({{"x", "0"}, {"y", "1"}}, 10).
+                                    add({{"x", "1"}, {"y", "2"}}, 20).
+                                    add({{"x", "1"}, {"y", "3"}}, 30).
+                                    add({{"x", "a"}, {"y", "0"}}, 40));
+    EntryRef ref = f.store.setTensor(*tensor);
+    EntryRef modified = f.store.modify_tensor(ref, [](double a, double b) { return a + b; }, *modifier);
+    ASSERT_TRUE(modified.valid());
+    EXPECT_NOT_EQUAL(ref.ref(), modified.ref());
+    f.assertTensorView(ref, *tensor);
+    f.assertTensorView(modified, *makeTensor(TensorSpec("tensor(x[2],y[3])").
+                                             add({{"x", 0}, {"y", 0}}, 1).
+                                             add({{"x", 0}, {"y", 1}}, 12).
+                                             add({{"x", 0}, {"y", 2}}, 3).
+                                             add({{"x", 1}, {"y", 0}}, 4).
+                                             add({{"x", 1}, {"y", 1}}, 5).
+                                             add({{"x", 1}, {"y", 2}}, 26)));
+}
+
+TEST_F("require that cells are not modified with unsuitable modifier", Fixture("tensor(x[2],y[3])"))
+{
+    Value::UP tensor = makeTensor(TensorSpec("tensor(x[2],y[3])").add({{"x", 0}, {"y", 0}}, 1));
+    EntryRef ref = f.store.setTensor(*tensor);
+    auto replace = [](double, double b) { return b; };
+    EXPECT_FALSE(f.store.modify_tensor(ref, replace, *makeTensor(TensorSpec("tensor(x{})").add({{"x", "0"}}, 2))).valid());
+    EXPECT_FALSE(f.store.modify_tensor(ref, replace, *makeTensor(TensorSpec("tensor(x{},z{})").add({{"x", "0"}, {"z", "0"}}, 2))).valid());
+    EXPECT_FALSE(f.store.modify_tensor(EntryRef(), replace, *makeTensor(TensorSpec("tensor(x{},y{})").add({{"x", "0"}, {"y", "0"}}, 2))).valid());
+}
+
 void
 assertArraySize(const vespalib::string &tensorType, uint32_t expArraySize) {
     Fixture f(tensorType);
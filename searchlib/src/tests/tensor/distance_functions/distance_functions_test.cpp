@@ -182,6 +182,33 @@ TEST(DistanceFunctionsTest, hamming_gives_expected_score)
     EXPECT_DOUBLE_EQ(hamming->to_rawscore(d25), 1.0/(1.0 + 1.0));
 }
 
+TEST(DistanceFunctionsTest, hamming_over_int8_counts_differing_bits)
+{
+    auto ct = vespalib::eval::ValueType::CellType::INT8;
+
+    auto hamming = make_distance_function(DistanceMetric::Hamming, ct);
+
+    std::vector<int8_t> p0(20, 0);
+    std::vector<int8_t> p1(20, 0);
+    p1[0] = 0x01;
+    p1[1] = 0x03;
+    std::vector<int8_t> p2(20, -1);
+    std::vector<int8_t> p3(p0);
+    p3[19] = -128;
+    EXPECT_EQ(hamming->calc(TypedCells(p0), TypedCells(p0)), 0.0);
+    EXPECT_EQ(hamming->calc(TypedCells(p0), TypedCells(p1)), 3.0);
+    EXPECT_DOUBLE_EQ(hamming->to_rawscore(3.0), 1.0/(1.0 + 3.0));
+    EXPECT_EQ(hamming->calc(TypedCells(p0), TypedCells(p2)), 160.0);
+    EXPECT_EQ(hamming->calc(TypedCells(p1), TypedCells(p2)), 157.0);
+    EXPECT_EQ(hamming->calc(TypedCells(p0), TypedCells(p3)), 1.0);
+    EXPECT_EQ(hamming->calc_with_limit(TypedCells(p0), TypedCells(p2), 10.0), 160.0);
+
+    std::vector<TypedCells> cells{TypedCells(p0), TypedCells(p1), TypedCells(p2), TypedCells(p3)};
+    std::vector<double> distances(cells.size());
+    hamming->calc_batch(TypedCells(p1), cells.data(), cells.size(), distances.data());
+    EXPECT_EQ(distances, (std::vector<double>{3.0, 0.0, 157.0, 4.0}));
+}
+
 TEST(GeoDegreesTest, gives_expected_score)
 {
     auto ct = vespalib::eval::ValueType::CellType::DOUBLE;
@@ -299,5 +326,41 @@ TEST(GeoDegreesTest, gives_expected_score)
 
 }
 
+void verify_batch_matches_single(DistanceMetric metric, vespalib::eval::ValueType::CellType ct)
+{
+    auto dist_fun = make_distance_function(metric, ct);
+    std::vector<std::vector<double>> double_vectors = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.5, 0.5, 0.707107},
+                                                       {0.0,-1.0, 0.0}, {1.0, 2.0, 2.0}};
+    std::vector<std::vector<float>> float_vectors;
+    std::vector<TypedCells> cells;
+    for (const auto &v : double_vectors) {
+        float_vectors.emplace_back(v.begin(), v.end());
+    }
+    for (size_t i = 0; i < double_vectors.size(); ++i) {
+        if (ct == vespalib::eval::ValueType::CellType::FLOAT) {
+            cells.emplace_back(float_vectors[i]);
+        } else {
+            cells.emplace_back(double_vectors[i]);
+        }
+    }
+    for (const auto &lhs : cells) {
+        std::vector<double> distances(cells.size());
+        dist_fun->calc_batch(lhs, cells.data(), cells.size(), distances.data());
+        for (size_t i = 0; i < cells.size(); ++i) {
+            EXPECT_DOUBLE_EQ(dist_fun->calc(lhs, cells[i]), distances[i]);
+        }
+    }
+}
+
+TEST(DistanceFunctionsTest, batch_calculation_gives_same_distances_as_single_calculation)
+{
+    for (auto ct : {vespalib::eval::ValueType::CellType::FLOAT, vespalib::eval::ValueType::CellType::DOUBLE}) {
+        verify_batch_matches_single(DistanceMetric::Euclidean, ct);
+        verify_batch_matches_single(DistanceMetric::Angular, ct);
+        verify_batch_matches_single(DistanceMetric::InnerProduct, ct);
+        verify_batch_matches_single(DistanceMetric::Hamming, ct);
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
 
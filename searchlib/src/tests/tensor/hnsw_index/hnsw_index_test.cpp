@@ -6,6 +6,7 @@
 #include <vespa/searchlib/tensor/hnsw_index.h>
 #include <vespa/searchlib/tensor/random_level_generator.h>
 #include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/searchlib/tensor/multi_vector_hnsw_index.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -76,12 +77,17 @@ public:
 
     ~HnswIndexTest() {}
 
-    void init(bool heuristic_select_neighbors) {
+    void init(bool heuristic_select_neighbors, bool quantized_vectors = false) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
+        std::unique_ptr<QuantizedVectorStore> quantized;
+        if (quantized_vectors) {
+            quantized = std::make_unique<QuantizedVectorStore>(search::attribute::DistanceMetric::Euclidean, 2);
+        }
         index = std::make_unique<HnswIndex>(vectors, std::make_unique<FloatSqEuclideanDistance>(),
                                             std::move(generator),
-                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors));
+                                            HnswIndex::Config(5, 2, 10, 0, heuristic_select_neighbors),
+                                            std::move(quantized));
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -219,6 +225,30 @@ TEST_F(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_with_simple_select_ne
     expect_top_3(9, {3, 2});
 }
 
+TEST_F(HnswIndexTest, quantized_vectors_are_used_for_exploration_and_top_k_is_reranked_with_full_precision)
+{
+    init(false, true);
+    EXPECT_TRUE(index->has_quantized_vectors());
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        add_document(docid);
+    }
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        auto qv = vectors.get_vector(docid);
+        auto result = index->find_top_k(1, qv, 10);
+        ASSERT_EQ(1, result.size());
+        EXPECT_EQ(docid, result[0].docid);
+        EXPECT_DOUBLE_EQ(0.0, result[0].distance);
+    }
+    std::vector<float> query = {7, 3};
+    auto result = index->find_top_k(2, vespalib::eval::TypedCells(query), 10);
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(5, result[0].docid);
+    EXPECT_DOUBLE_EQ(1.0, result[0].distance);
+    EXPECT_EQ(6, result[1].docid);
+    EXPECT_DOUBLE_EQ(1.0, result[1].distance);
+    EXPECT_GT(memory_usage().usedBytes(), 0);
+}
+
 TEST_F(HnswIndexTest, 2d_vectors_inserted_and_removed)
 {
     init(false);
@@ -619,5 +649,117 @@ TEST_F(TwoPhaseTest, two_phase_add)
     expect_levels(7, {{2}, {4}});
 }
 
+class MyMultiVectorAccess : public MultiVectorAccess {
+private:
+    using Vector = std::vector<float>;
+    std::vector<std::vector<Vector>> _vectors;
+
+public:
+    MyMultiVectorAccess() : _vectors() {}
+    MyMultiVectorAccess& set(uint32_t docid, const std::vector<Vector>& vecs) {
+        if (docid >= _vectors.size()) {
+            _vectors.resize(docid + 1);
+        }
+        _vectors[docid] = vecs;
+        return *this;
+    }
+    uint32_t get_num_vectors(uint32_t docid) const override {
+        return _vectors[docid].size();
+    }
+    vespalib::eval::TypedCells get_vector(uint32_t docid, uint32_t vector_idx) const override {
+        vespalib::ConstArrayRef<float> ref(_vectors[docid][vector_idx]);
+        return vespalib::eval::TypedCells(ref);
+    }
+};
+
+class MultiVectorHnswIndexTest : public ::testing::Test {
+public:
+    MyMultiVectorAccess vectors;
+    GenerationHandler gen_handler;
+    MultiVectorHnswIndex index;
+
+    MultiVectorHnswIndexTest()
+        : vectors(),
+          gen_handler(),
+          index(vectors, std::make_unique<FloatSqEuclideanDistance>(), std::make_unique<LevelGenerator>(),
+                HnswIndex::Config(5, 2, 10, 0, true))
+    {
+        vectors.set(1, {{2, 2}, {10, 10}})
+               .set(2, {{3, 2}})
+               .set(3, {{8, 3}, {7, 2}, {0, 3}})
+               .set(4, {{20, 20}});
+    }
+    void commit() {
+        index.transfer_hold_lists(gen_handler.getCurrentGeneration());
+        gen_handler.incGeneration();
+        gen_handler.updateFirstUsedGeneration();
+        index.trim_hold_lists(gen_handler.getFirstUsedGeneration());
+    }
+    void add_document(uint32_t docid) {
+        index.add_document(docid);
+        commit();
+    }
+    void remove_document(uint32_t docid) {
+        index.remove_document(docid);
+        commit();
+    }
+    std::vector<NearestNeighborIndex::Neighbor> find_top_k(uint32_t k, std::vector<float> query, const BitVector *filter = nullptr) {
+        vespalib::ConstArrayRef<float> ref(query);
+        vespalib::eval::TypedCells qv(ref);
+        return filter ? index.find_top_k_with_filter(k, qv, *filter, 10) : index.find_top_k(k, qv, 10);
+    }
+    void expect_top_k(uint32_t k, std::vector<float> query, std::vector<std::pair<uint32_t, double>> exp_hits,
+                      const BitVector *filter = nullptr) {
+        auto hits = find_top_k(k, query, filter);
+        ASSERT_EQ(exp_hits.size(), hits.size());
+        for (size_t i = 0; i < hits.size(); ++i) {
+            EXPECT_EQ(exp_hits[i].first, hits[i].docid);
+            EXPECT_DOUBLE_EQ(exp_hits[i].second, hits[i].distance);
+        }
+    }
+};
+
+TEST_F(MultiVectorHnswIndexTest, each_vector_of_a_document_is_a_node_in_the_graph)
+{
+    add_document(1);
+    add_document(2);
+    add_document(3);
+    EXPECT_EQ((std::vector<uint32_t>{1, 2}), index.get_nodeids(1));
+    EXPECT_EQ((std::vector<uint32_t>{3}), index.get_nodeids(2));
+    EXPECT_EQ((std::vector<uint32_t>{4, 5, 6}), index.get_nodeids(3));
+    EXPECT_EQ(6, index.index().count_reachable_nodes());
+    EXPECT_TRUE(index.index().check_link_symmetry());
+}
+
+TEST_F(MultiVectorHnswIndexTest, top_k_returns_best_distance_per_document)
+{
+    add_document(1);
+    add_document(2);
+    add_document(3);
+    add_document(4);
+    expect_top_k(3, {9, 9}, {{1, 2.0}, {2, 85.0}, {3, 37.0}});
+    expect_top_k(2, {1, 3}, {{1, 2.0}, {3, 1.0}});
+    auto filter = BitVector::create(5);
+    filter->setBit(2);
+    filter->setBit(4);
+    filter->invalidateCachedCount();
+    expect_top_k(3, {9, 9}, {{2, 85.0}, {4, 242.0}}, filter.get());
+}
+
+TEST_F(MultiVectorHnswIndexTest, node_ids_are_reused_after_hold_time)
+{
+    add_document(1);
+    add_document(2);
+    auto guard = gen_handler.takeGuard();
+    remove_document(1);
+    add_document(3);
+    EXPECT_EQ((std::vector<uint32_t>{4, 5, 6}), index.get_nodeids(3));
+    expect_top_k(3, {2, 2}, {{2, 1.0}, {3, 5.0}});
+    guard = GenerationHandler::Guard();
+    commit();
+    add_document(1);
+    EXPECT_EQ((std::vector<uint32_t>{2, 1}), index.get_nodeids(1));
+    EXPECT_EQ(6, index.index().count_reachable_nodes());
+}
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/util/bufferwriter.h>
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
 #include <vector>
 
 #include <vespa/log/log.h>
@@ -102,10 +103,10 @@ public:
         saver.save(vector_writer);
         return vector_writer.output;
     }
-    void load_copy(std::vector<char> data) {
+    bool load_copy(std::vector<char> data) {
         HnswIndexLoader loader(copy);
         LoadedBuffer buffer(&data[0], data.size());
-        loader.load(buffer);
+        return loader.load(buffer);
     }
 
     void expect_copy_as_populated() const {
@@ -132,10 +133,37 @@ TEST_F(CopyGraphTest, reconstructs_graph)
 {
     populate(original);
     auto data = save_original();
-    load_copy(data);
+    EXPECT_TRUE(load_copy(data));
     expect_copy_as_populated();
 }
 
+TEST_F(CopyGraphTest, reconstructs_graph_saved_in_interleaved_format)
+{
+    // entry docid, entry level, num nodes, and then for each node: num levels, (num links, links) per level
+    V words = {2, 1, 7,
+               0,
+               1, 3, 2, 4, 6,
+               2, 3, 1, 4, 6, 1, 4,
+               0,
+               2, 3, 1, 2, 6, 1, 2,
+               0,
+               1, 3, 1, 2, 4};
+    std::vector<char> data(words.size() * sizeof(uint32_t));
+    memcpy(&data[0], &words[0], data.size());
+    EXPECT_TRUE(load_copy(data));
+    expect_copy_as_populated();
+}
+
+TEST_F(CopyGraphTest, truncated_data_is_rejected)
+{
+    populate(original);
+    auto data = save_original();
+    data.resize(data.size() - sizeof(uint32_t));
+    EXPECT_FALSE(load_copy(data));
+    EXPECT_EQ(1, copy.size());
+    EXPECT_EQ(0, copy.get_entry_node().docid);
+}
+
 TEST_F(CopyGraphTest, later_changes_ignored)
 {
     populate(original);
@@ -144,7 +172,7 @@ TEST_F(CopyGraphTest, later_changes_ignored)
     VectorBufferWriter vector_writer;
     saver.save(vector_writer);
     auto data = vector_writer.output;
-    load_copy(data);
+    EXPECT_TRUE(load_copy(data));
     expect_copy_as_populated();
 }
 
@@ -0,0 +1,72 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/quantized_vector_store.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vector>
+
+using namespace search::tensor;
+using search::attribute::DistanceMetric;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+
+using FloatVector = std::vector<float>;
+
+TypedCells t(const FloatVector &v) { return TypedCells(v); }
+
+struct QuantizedVectorStoreTest : public ::testing::TestWithParam<DistanceMetric> {
+    std::vector<FloatVector> vectors;
+    QuantizedVectorStore store;
+    DistanceFunction::UP dist_fun;
+
+    QuantizedVectorStoreTest()
+        : vectors({{0.1, 0.2, -0.3, 0.4}, {1.5, -2.0, 0.5, 0.25}, {-0.7, 0.7, 0.7, -0.7}, {0.0, 0.0, 0.0, 1.0}}),
+          store(GetParam(), 4),
+          dist_fun(make_distance_function(GetParam(), ValueType::CellType::FLOAT))
+    {
+        for (uint32_t docid = 0; docid < vectors.size(); ++docid) {
+            store.set(docid + 1, t(vectors[docid]));
+        }
+    }
+    ~QuantizedVectorStoreTest() override;
+};
+
+QuantizedVectorStoreTest::~QuantizedVectorStoreTest() = default;
+
+TEST_P(QuantizedVectorStoreTest, approximate_distance_is_close_to_full_precision_distance)
+{
+    for (const auto &query : vectors) {
+        auto query_vector = store.make_query_vector(t(query));
+        for (uint32_t docid = 1; docid <= vectors.size(); ++docid) {
+            double exp = dist_fun->calc(t(query), t(vectors[docid - 1]));
+            double act = store.calc_distance(query_vector, docid);
+            EXPECT_NEAR(exp, act, 0.05);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DistanceMetrics, QuantizedVectorStoreTest,
+                         ::testing::Values(DistanceMetric::Euclidean, DistanceMetric::Angular, DistanceMetric::InnerProduct));
+
+TEST(QuantizedVectorStoreSupportTest, only_dot_product_based_metrics_are_supported)
+{
+    EXPECT_TRUE(QuantizedVectorStore::supports(DistanceMetric::Euclidean));
+    EXPECT_TRUE(QuantizedVectorStore::supports(DistanceMetric::Angular));
+    EXPECT_TRUE(QuantizedVectorStore::supports(DistanceMetric::InnerProduct));
+    EXPECT_FALSE(QuantizedVectorStore::supports(DistanceMetric::GeoDegrees));
+    EXPECT_FALSE(QuantizedVectorStore::supports(DistanceMetric::Hamming));
+}
+
+TEST(QuantizedVectorStoreMemoryTest, memory_usage_grows_with_stored_vectors)
+{
+    QuantizedVectorStore store(DistanceMetric::Euclidean, 128);
+    FloatVector vector(128, 0.5);
+    auto before = store.memory_usage().usedBytes();
+    for (uint32_t docid = 1; docid < 100; ++docid) {
+        store.set(docid, t(vector));
+    }
+    EXPECT_GE(store.memory_usage().usedBytes(), before + 99 * 128);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
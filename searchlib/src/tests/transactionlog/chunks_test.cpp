@@ -1,6 +1,7 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/transactionlog/chunks.h>
+#include <vespa/searchlib/transactionlog/compression_selector.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <atomic>
 
@@ -115,4 +116,43 @@ TEST("test multi element commitchunk") {
     }
     EXPECT_EQUAL(0u, counter);
 }
+TEST("require that small batches are compressed with lz4 by the compression selector") {
+    CompressionSelector selector(1000, 0.1);
+    selector.observe(Encoding::Compression::zstd, 1000, 100);
+    selector.observe(Encoding::Compression::lz4, 1000, 500);
+    for (size_t i(0); i < 2 * CompressionSelector::PROBE_INTERVAL; i++) {
+        EXPECT_EQUAL(Encoding::Compression::lz4, selector.select(999));
+    }
+}
+
+TEST("require that large batches are compressed with zstd when it compresses enough better than lz4") {
+    CompressionSelector selector(1000, 0.1);
+    EXPECT_EQUAL(Encoding::Compression::zstd, selector.select(1000));
+    selector.observe(Encoding::Compression::zstd, 1000, 300);
+    EXPECT_EQUAL(Encoding::Compression::lz4, selector.select(1000));
+    selector.observe(Encoding::Compression::lz4, 1000, 500);
+    EXPECT_EQUAL(0.3, selector.getRatio(Encoding::Compression::zstd));
+    EXPECT_EQUAL(0.5, selector.getRatio(Encoding::Compression::lz4));
+    size_t numZstd(0);
+    for (size_t i(0); i < 2 * CompressionSelector::PROBE_INTERVAL; i++) {
+        if (selector.select(1000) == Encoding::Compression::zstd) {
+            numZstd++;
+        }
+    }
+    EXPECT_EQUAL(2 * CompressionSelector::PROBE_INTERVAL - 2, numZstd);
+}
+
+TEST("require that large batches are compressed with lz4 when zstd does not compress enough better") {
+    CompressionSelector selector(1000, 0.1);
+    selector.observe(Encoding::Compression::zstd, 1000, 480);
+    selector.observe(Encoding::Compression::lz4, 1000, 500);
+    size_t numLz4(0);
+    for (size_t i(0); i < 2 * CompressionSelector::PROBE_INTERVAL; i++) {
+        if (selector.select(1000) == Encoding::Compression::lz4) {
+            numLz4++;
+        }
+    }
+    EXPECT_EQUAL(2 * CompressionSelector::PROBE_INTERVAL - 2, numLz4);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
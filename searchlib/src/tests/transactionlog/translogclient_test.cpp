@@ -739,8 +739,49 @@ TEST("test sending a lot of data async") {
     }
 }
 
+TEST("require that commits with fsync are grouped and acked after sync") {
+    const unsigned int NUM_PACKETS = 100;
+    const unsigned int NUM_ENTRIES = 100;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    const vespalib::string MANY("many-fsync");
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tlss("test14", 18377, ".", fileHeaderContext,
+                        DomainConfig().setPartSizeLimit(0x80000).setFSyncOnCommit(true));
+    TransLogClient tls("tcp/localhost:18377");
+    createDomainTest(tls, MANY, 0);
+    auto s1 = openDomainTest(tls, MANY);
+    fillDomainTest(tlss, MANY, NUM_PACKETS, NUM_ENTRIES);
+    SerialNum b(0), e(0);
+    size_t c(0);
+    EXPECT_TRUE(s1->status(b, e, c));
+    EXPECT_EQUAL(e, TOTAL_NUM_ENTRIES);
+    EXPECT_EQUAL(c, TOTAL_NUM_ENTRIES);
 
+    const CommitStats stats = tlss.getDomainStats()[MANY].commitStats;
+    EXPECT_EQUAL(TOTAL_NUM_ENTRIES, stats.batchEntries.sum());
+    EXPECT_GREATER_EQUAL(size_t(NUM_PACKETS), stats.batchEntries.count());
+    EXPECT_EQUAL(stats.batchEntries.count(), stats.syncBatches.sum());
+    EXPECT_LESS_EQUAL(1u, stats.syncLatencyUs.count());
+    EXPECT_GREATER_EQUAL(stats.batchEntries.count(), stats.syncLatencyUs.count());
+}
 
+TEST("require that log2 histogram counts samples in power of two buckets") {
+    Log2Histogram histogram;
+    for (uint64_t value : {0ul, 1ul, 2ul, 3ul, 4ul, 1000ul}) {
+        histogram.add(value);
+    }
+    EXPECT_EQUAL(6u, histogram.count());
+    EXPECT_EQUAL(1010u, histogram.sum());
+    EXPECT_EQUAL(1000u, histogram.max());
+    EXPECT_EQUAL(1u, histogram.buckets()[0]);
+    EXPECT_EQUAL(1u, histogram.buckets()[1]);
+    EXPECT_EQUAL(2u, histogram.buckets()[2]);
+    EXPECT_EQUAL(1u, histogram.buckets()[3]);
+    EXPECT_EQUAL(1u, histogram.buckets()[10]);
+    EXPECT_EQUAL(1024u, Log2Histogram::bucketLimit(10));
+    EXPECT_EQUAL(10u, Log2Histogram::bucketOf(1023));
+    EXPECT_EQUAL(11u, Log2Histogram::bucketOf(1024));
+}
 
 TEST("testErase") {
     const unsigned int NUM_PACKETS = 1000;
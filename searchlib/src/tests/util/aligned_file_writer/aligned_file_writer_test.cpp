@@ -0,0 +1,96 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/util/aligned_file_writer.h>
+#include <vespa/fastos/file.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <cstring>
+#include <vector>
+
+using search::AlignedFileWriter;
+
+namespace {
+
+const vespalib::string file_name("aligned_file_writer_test.dat");
+
+std::vector<char>
+make_data(size_t len)
+{
+    std::vector<char> data(len);
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = static_cast<char>((i * 7) % 251);
+    }
+    return data;
+}
+
+std::vector<char>
+read_file()
+{
+    FastOS_File file;
+    EXPECT_TRUE(file.OpenReadOnly(file_name.c_str()));
+    std::vector<char> result(file.GetSize());
+    file.ReadBuf(result.data(), result.size(), 0);
+    return result;
+}
+
+}
+
+class AlignedFileWriterTest : public ::testing::TestWithParam<bool> {
+protected:
+    AlignedFileWriterTest() { vespalib::unlink(file_name); }
+    ~AlignedFileWriterTest() override { vespalib::unlink(file_name); }
+
+    std::vector<char> write_blocks(const std::vector<char> &data, const std::vector<size_t> &block_sizes,
+                                   size_t prefix_len, bool direct_io)
+    {
+        FastOS_File file;
+        if (direct_io) {
+            file.EnableDirectIO();
+        }
+        EXPECT_TRUE(file.OpenWriteOnlyTruncate(file_name.c_str()));
+        std::vector<char> prefix(prefix_len, 'x');
+        if (prefix_len > 0) {
+            auto buf = vespalib::alloc::Alloc::allocAlignedHeap(prefix_len, AlignedFileWriter::ALIGNMENT);
+            memcpy(buf.get(), prefix.data(), prefix_len);
+            file.WriteBuf(buf.get(), prefix_len);
+        }
+        AlignedFileWriter writer(file, GetParam(), 4 * AlignedFileWriter::ALIGNMENT);
+        size_t pos = 0;
+        // Odd block sizes make most source pointers unaligned
+        for (size_t i = 0; pos < data.size(); ++i) {
+            size_t len = std::min(block_sizes[i % block_sizes.size()], data.size() - pos);
+            writer.write(data.data() + pos, len);
+            pos += len;
+        }
+        writer.flush();
+        EXPECT_EQ(data.size(), writer.bytesWritten());
+        file.Close();
+        prefix.insert(prefix.end(), data.begin(), data.end());
+        return prefix;
+    }
+};
+
+TEST_P(AlignedFileWriterTest, blocks_of_any_size_are_written_in_order)
+{
+    auto data = make_data(100000);
+    auto expected = write_blocks(data, {1, 4095, 4097, 20000, 3}, 0, false);
+    EXPECT_EQ(expected, read_file());
+}
+
+TEST_P(AlignedFileWriterTest, blocks_of_any_size_can_be_written_with_direct_io)
+{
+    auto data = make_data(100001);
+    auto expected = write_blocks(data, {17, 8191, 33000}, AlignedFileWriter::ALIGNMENT, true);
+    EXPECT_EQ(expected, read_file());
+}
+
+TEST_P(AlignedFileWriterTest, single_large_write_is_written)
+{
+    auto data = make_data(10 * AlignedFileWriter::ALIGNMENT + 10);
+    auto expected = write_blocks(data, {data.size()}, 0, true);
+    EXPECT_EQ(expected, read_file());
+}
+
+INSTANTIATE_TEST_SUITE_P(WriteBehind, AlignedFileWriterTest, ::testing::Values(false, true));
+
+GTEST_MAIN_RUN_ALL_TESTS()
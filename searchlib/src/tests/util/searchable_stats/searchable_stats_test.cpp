@@ -20,16 +20,21 @@ Test::Main()
         EXPECT_EQUAL(0u, stats.memoryUsage().allocatedBytes());
         EXPECT_EQUAL(0u, stats.docsInMemory());
         EXPECT_EQUAL(0u, stats.sizeOnDisk());
+        EXPECT_EQUAL(0u, stats.postingListCacheStats().lookups());
         {
             SearchableStats rhs;
             EXPECT_EQUAL(&rhs.memoryUsage(vespalib::MemoryUsage(100,0,0,0)), &rhs);
             EXPECT_EQUAL(&rhs.docsInMemory(10), &rhs);
             EXPECT_EQUAL(&rhs.sizeOnDisk(1000), &rhs);
+            EXPECT_EQUAL(&rhs.postingListCacheStats(CacheStats(3, 4, 2, 500, 0)), &rhs);
             EXPECT_EQUAL(&stats.add(rhs), &stats);
         }
         EXPECT_EQUAL(100u, stats.memoryUsage().allocatedBytes());
         EXPECT_EQUAL(10u, stats.docsInMemory());
         EXPECT_EQUAL(1000u, stats.sizeOnDisk());
+        EXPECT_EQUAL(3u, stats.postingListCacheStats().hits);
+        EXPECT_EQUAL(7u, stats.postingListCacheStats().lookups());
+        EXPECT_EQUAL(500u, stats.postingListCacheStats().memory_used);
         EXPECT_EQUAL(&stats.add(SearchableStats().memoryUsage(vespalib::MemoryUsage(100,0,0,0)).docsInMemory(10).sizeOnDisk(1000)), &stats);
         EXPECT_EQUAL(200u, stats.memoryUsage().allocatedBytes());
         EXPECT_EQUAL(20u, stats.docsInMemory());
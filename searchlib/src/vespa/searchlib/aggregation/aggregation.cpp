@@ -2,7 +2,9 @@
 
 #include "aggregation.h"
 #include "expressioncountaggregationresult.h"
+#include <vespa/searchlib/expression/batchevaluator.h>
 #include <vespa/searchlib/expression/resultvector.h>
+#include <vespa/searchlib/common/rankedhit.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/objects/visit.hpp>
 #include <xxhash.h>
@@ -77,6 +79,43 @@ AggregationResult::aggregate(DocId docId, HitRank rank) {
     }
 }
 
+void
+AggregationResult::aggregate(const RankedHit * hits, size_t numHits) {
+    std::unique_ptr<BatchEvaluator> evaluator;
+    if (getExpression() != nullptr) {
+        evaluator = BatchEvaluator::create(*getExpression());
+    }
+    if ( ! evaluator) {
+        for (size_t i(0); i < numHits; i++) {
+            aggregate(hits[i]._docId, hits[i]._rankValue);
+        }
+        return;
+    }
+    ResultNode::UP value(getExpression()->getResult().clone());
+    DocId docIds[BatchEvaluator::BATCH_SIZE];
+    for (size_t offset(0); offset < numHits; offset += BatchEvaluator::BATCH_SIZE) {
+        const RankedHit * batch = hits + offset;
+        size_t batchSize = std::min(numHits - offset, BatchEvaluator::BATCH_SIZE);
+        for (size_t i(0); i < batchSize; i++) {
+            docIds[i] = batch[i]._docId;
+        }
+        const BatchEvaluator::Column & column = evaluator->evaluate(docIds, batchSize);
+        if (column.isFloat()) {
+            auto & floatValue = static_cast<FloatResultNode &>(*value);
+            for (size_t i(0); i < batchSize; i++) {
+                floatValue.set(column.floats()[i]);
+                onAggregate(*value, docIds[i], batch[i]._rankValue);
+            }
+        } else {
+            auto & integerValue = static_cast<Int64ResultNode &>(*value);
+            for (size_t i(0); i < batchSize; i++) {
+                integerValue.set(column.integers()[i]);
+                onAggregate(*value, docIds[i], batch[i]._rankValue);
+            }
+        }
+    }
+}
+
 bool
 AggregationResult::Configure::check(const vespalib::Identifiable &obj) const
 {
@@ -4,6 +4,8 @@
 #include <vespa/searchlib/expression/expressiontree.h>
 #include <vespa/searchlib/expression/resultnode.h>
 
+namespace search { struct RankedHit; }
+
 namespace search::aggregation {
 
 using search::expression::DocId;
@@ -55,6 +57,13 @@ public:
     virtual void postMerge() {}
     void aggregate(const document::Document & doc, HitRank rank);
     void aggregate(DocId docId, HitRank rank);
+    /**
+     * Aggregate a list of hits. When the expression can be evaluated in
+     * batches, it is evaluated column wise for up to BatchEvaluator::BATCH_SIZE
+     * hits at a time before the values are aggregated, otherwise the hits
+     * are aggregated one by one.
+     **/
+    void aggregate(const RankedHit * hits, size_t numHits);
     AggregationResult &setExpression(ExpressionNode::UP expr);
     AggregationResult &setResult(const ResultNode::CP &result) {
         prepare(result.get(), true);
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <cassert>
 #include <algorithm>
+#include <limits>
 
 namespace search::aggregation {
 
@@ -103,6 +104,8 @@ Group::Value::groupSingle(const ResultNode & selectResult, HitRank rank, const G
     }
     GroupHash & childMap = *_childInfo._childMap;
     Group * group(nullptr);
+    GroupingLevel::ApproximateGroups * approximate = level.getApproximateGroups();
+    uint32_t count = (approximate != nullptr) ? approximate->add(this, selectResult) : 0;
     GroupHash::iterator found = childMap.find(selectResult);
     if (found == childMap.end()) { // group not present in child map
         if (level.allowMoreGroups(childMap.size())) {
@@ -111,6 +114,8 @@ Group::Value::groupSingle(const ResultNode & selectResult, HitRank rank, const G
             group->setRank(rank);
             addChild(group);
             childMap.insert(getChildrenSize() - 1);
+        } else if ((approximate != nullptr) && (count > approximate->minCount(this))) {
+            group = replaceSmallestChild(selectResult, rank, count, level);
         }
     } else {
         group = _children[(*found)];
@@ -121,6 +126,36 @@ Group::Value::groupSingle(const ResultNode & selectResult, HitRank rank, const G
     return group;
 }
 
+Group *
+Group::Value::replaceSmallestChild(const ResultNode & selectResult, HitRank rank, uint32_t count, const GroupingLevel & level)
+{
+    GroupingLevel::ApproximateGroups & approximate = *level.getApproximateGroups();
+    uint32_t smallest(0);
+    uint32_t smallestCount(std::numeric_limits<uint32_t>::max());
+    for (uint32_t i(0), m(getChildrenSize()); i < m; i++) {
+        uint32_t childCount = approximate.estimate(this, _children[i]->getId());
+        if (childCount < smallestCount) {
+            smallest = i;
+            smallestCount = childCount;
+        }
+    }
+    // Counts only grow, so this stays a lower bound for the kept groups.
+    approximate.minCount(this) = smallestCount;
+    if ((getChildrenSize() == 0) || (count <= smallestCount)) {
+        return nullptr;
+    }
+    GroupHash & childMap = *_childInfo._childMap;
+    childMap.erase(smallest);
+    delete _children[smallest];
+    Group * group = new Group(level.getGroupPrototype());
+    group->setId(selectResult);
+    group->setRank(rank);
+    _children[smallest] = group;
+    childMap.insert(smallest);
+    approximate.addLateGroup(count);
+    return group;
+}
+
 void
 Group::merge(const GroupingLevelList &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b) {
     bool frozen = (currentLevel < firstLevel);    // is this level frozen ?
@@ -268,6 +303,14 @@ void Group::Value::collect(const Doc & doc, HitRank rank)
     }
 }
 
+void
+Group::Value::collect(const RankedHit * hits, size_t numHits)
+{
+    for(size_t i(0), m(getAggrSize()); i < m; i++) {
+        getAggr(i)->aggregate(hits, numHits);
+    }
+}
+
 void
 Group::Value::addResult(ExpressionNode::UP aggr)
 {
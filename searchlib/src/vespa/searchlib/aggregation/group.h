@@ -96,6 +96,8 @@ private:
         void postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel);
         void partialCopy(const Value & rhs);
         VESPA_DLL_LOCAL Group * groupSingle(const ResultNode & selectResult, HitRank rank, const GroupingLevel & level);
+        VESPA_DLL_LOCAL Group * replaceSmallestChild(const ResultNode & selectResult, HitRank rank, uint32_t count,
+                                                     const GroupingLevel & level);
 
         GroupList groups() const { return _children; }
         void addChild(Group * child);
@@ -115,6 +117,7 @@ private:
 
         template <typename Doc>
         void collect(const Doc & docId, HitRank rank);
+        void collect(const RankedHit * hits, size_t numHits);
     private:
 
         using  ExpressionVector = ExpressionNode::CP *;
@@ -244,6 +247,11 @@ public:
 
     template <typename Doc>
     void collect(const Doc & docId, HitRank rank) { _aggr.collect(docId, rank); }
+    /**
+     * Collect a list of hits into the aggregation results of this group only,
+     * letting each aggregation result evaluate its expression in batches.
+     **/
+    void collect(const RankedHit * hits, size_t numHits) { _aggr.collect(hits, numHits); }
     void postAggregate() { _aggr.postAggregate(); }
     void merge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b);
     void executeOrderBy() { _aggr.executeOrderBy(); }
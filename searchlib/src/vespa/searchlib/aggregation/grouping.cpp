@@ -7,6 +7,7 @@
 #include <vespa/searchlib/expression/resultvector.h>
 #include <vespa/searchlib/expression/attributenode.h>
 #include <vespa/searchlib/expression/documentaccessornode.h>
+#include <vespa/searchlib/expression/batchevaluator.h>
 #include <vespa/searchlib/attribute/stringbase.h>
 #include <vespa/vespalib/objects/serializer.hpp>
 #include <vespa/vespalib/objects/deserializer.hpp>
@@ -151,6 +152,9 @@ Grouping::mergePartial(const Grouping & b)
 void
 Grouping::merge(Grouping & b)
 {
+    for (size_t i(0), m(std::min(_levels.size(), b._levels.size())); i < m; i++) {
+        _levels[i].mergeApproximation(b._levels[i]);
+    }
     _root.merge(_levels, _firstLevel, 0, b._root);
 }
 
@@ -205,17 +209,47 @@ void Grouping::postProcess()
 }
 
 void Grouping::aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len) {
+    if (canAggregateInBatches()) {
+        _root.collect(rankedHit, len);
+        return;
+    }
     for(unsigned int i(0); i < len; i++) {
         aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
     }
 }
 
 void Grouping::aggregateWithClock(const RankedHit * rankedHit, unsigned int len) {
+    if (canAggregateInBatches()) {
+        for(unsigned int i(0); (i < len) && !hasExpired(); i += BatchEvaluator::BATCH_SIZE) {
+            _root.collect(rankedHit + i, std::min(len - i, static_cast<unsigned int>(BatchEvaluator::BATCH_SIZE)));
+        }
+        return;
+    }
     for(unsigned int i(0); (i < len) && !hasExpired(); i++) {
         aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
     }
 }
 
+void Grouping::aggregateInBatches(const BitVector & bVec, size_t maxDocs)
+{
+    RankedHit hits[BatchEvaluator::BATCH_SIZE];
+    size_t numHits(0);
+    size_t numDocs(0);
+    for(DocId d(bVec.getFirstTrueBit()), sz(bVec.size()); (d < sz) && (numDocs < maxDocs); d = bVec.getNextTrueBit(d+1), numDocs++) {
+        hits[numHits++] = RankedHit(d, 0.0);
+        if (numHits == BatchEvaluator::BATCH_SIZE) {
+            if ((_clock != nullptr) && hasExpired()) {
+                return;
+            }
+            _root.collect(hits, numHits);
+            numHits = 0;
+        }
+    }
+    if ((numHits > 0) && ((_clock == nullptr) || !hasExpired())) {
+        _root.collect(hits, numHits);
+    }
+}
+
 void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
 {
     bool isOrdered(! needResort());
@@ -238,7 +272,10 @@ void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const Bi
     } else {
         aggregateWithClock(rankedHit, getMaxN(len));
     }
-    if (bVec != NULL) {
+    if ((bVec != NULL) && canAggregateInBatches()) {
+        unsigned int sz(bVec->size());
+        aggregateInBatches(*bVec, (getTopN() > 0) ? getMaxN(sz) : sz);
+    } else if (bVec != NULL) {
         unsigned int sz(bVec->size());
         if (_clock == NULL) {
             if (getTopN() > 0) {
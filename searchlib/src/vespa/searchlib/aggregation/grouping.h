@@ -34,8 +34,14 @@ private:
     vespalib::steady_time    _timeOfDoom; // Used if clock is specified. This is time when request expires.
 
     bool hasExpired() const { return _clock->getTimeNS() > _timeOfDoom; }
+    /**
+     * Only aggregations directly in the root group can be evaluated in batches,
+     * documents must be grouped one by one when there are grouping levels.
+     **/
+    bool canAggregateInBatches() const { return _levels.empty() && (_firstLevel == 0); }
     void aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len);
     void aggregateWithClock(const RankedHit * rankedHit, unsigned int len);
+    void aggregateInBatches(const BitVector & bVec, size_t maxDocs);
     void postProcess();
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Grouping);
@@ -3,6 +3,7 @@
 #include "groupinglevel.h"
 #include "grouping.h"
 #include <vespa/searchlib/expression/resultvector.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 namespace search::aggregation {
 
@@ -18,8 +19,10 @@ GroupingLevel::GroupingLevel() :
     _precision(-1),
     _isOrdered(false),
     _frozen(false),
+    _approximate(false),
     _classify(),
     _collect(),
+    _approximateGroups(),
     _grouper(NULL)
 { }
 
@@ -45,6 +48,9 @@ GroupingLevel::visitMembers(vespalib::ObjectVisitor &visitor) const
 {
     visit(visitor, "maxGroups", _maxGroups);
     visit(visitor, "precision", _precision);
+    if (_approximate) {
+        visit(visitor, "errorBound", getErrorBound());
+    }
     visit(visitor, "classify",  _classify);
     visit(visitor, "collect",   _collect);
 }
@@ -93,10 +99,41 @@ void GroupingLevel::MultiValueGrouper::groupDoc(Group & g, const ResultNode & re
     }
 }
 
+GroupingLevel::ApproximateGroups::ApproximateGroups()
+    : _sketch(),
+      _minCount(),
+      _errorBound(0)
+{ }
+
+GroupingLevel::ApproximateGroups::~ApproximateGroups() = default;
+
+uint64_t
+GroupingLevel::ApproximateGroups::hash(const void * parent, const ResultNode & id)
+{
+    uint64_t h = id.hash() ^ (reinterpret_cast<uintptr_t>(parent) * 0x9e3779b97f4a7c15ul);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdul;
+    h ^= h >> 33;
+    return h;
+}
+
+void
+GroupingLevel::mergeApproximation(const GroupingLevel & rhs)
+{
+    if (_approximateGroups && rhs._approximateGroups) {
+        _approximateGroups->merge(*rhs._approximateGroups);
+    }
+}
+
 void GroupingLevel::prepare(const Grouping * grouping, uint32_t level, bool isOrdered_)
 {
     _isOrdered = isOrdered_;
     _frozen = level < grouping->getFirstLevel();
+    if (_approximate && !_frozen && !_isOrdered && (_precision > 0)) {
+        _approximateGroups = std::make_shared<ApproximateGroups>();
+    } else {
+        _approximateGroups.reset();
+    }
     if (_classify.getResult().inherits(ResultNodeVector::classId)) {
        _grouper.reset(new MultiValueGrouper(grouping, level));
     } else {
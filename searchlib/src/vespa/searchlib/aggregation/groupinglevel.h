@@ -3,6 +3,8 @@
 
 #include "group.h"
 #include <vespa/searchlib/expression/aggregationrefnode.h>
+#include <vespa/searchlib/grouping/countminsketch.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace search::aggregation {
 
@@ -16,6 +18,38 @@ class Grouping;
  **/
 class GroupingLevel : public vespalib::Identifiable
 {
+public:
+    /**
+     * Approximate hit counts for the groups seen on a level during approximate
+     * grouping. When there are more groups than the precision, these decide
+     * which groups to keep; a new group replaces the kept group with the
+     * lowest count under the same parent when its count has become larger.
+     **/
+    class ApproximateGroups {
+    public:
+        ApproximateGroups();
+        ~ApproximateGroups();
+        uint32_t add(const void * parent, const expression::ResultNode & id) { return _sketch.add(hash(parent, id)); }
+        uint32_t estimate(const void * parent, const expression::ResultNode & id) const { return _sketch.estimate(hash(parent, id)); }
+        /**
+         * A lower bound of the smallest count of the groups kept under the given parent.
+         **/
+        uint32_t & minCount(const void * parent) { return _minCount[parent]; }
+        /**
+         * Register that a group was created after it had been seen count times.
+         **/
+        void addLateGroup(uint32_t count) { _errorBound = std::max(_errorBound, uint64_t(count - 1)); }
+        void merge(const ApproximateGroups & rhs) {
+            _sketch.merge(rhs._sketch);
+            _errorBound += rhs._errorBound;
+        }
+        uint64_t getErrorBound() const { return _errorBound; }
+    private:
+        static uint64_t hash(const void * parent, const expression::ResultNode & id);
+        CountMinSketch<>                           _sketch;
+        vespalib::hash_map<const void *, uint32_t> _minCount;
+        uint64_t                                   _errorBound;
+    };
 private:
     using ResultNode = expression::ResultNode;
     using ExpressionNode = expression::ExpressionNode;
@@ -71,8 +105,10 @@ private:
     int64_t        _precision;
     bool           _isOrdered;
     bool           _frozen;
+    bool           _approximate; // local to the search node, not serialized
     ExpressionTree _classify;
     Group          _collect;
+    std::shared_ptr<ApproximateGroups> _approximateGroups;
 
     vespalib::CloneablePtr<Grouper>    _grouper;
 public:
@@ -96,6 +132,13 @@ public:
     }
     GroupingLevel & freeze() { _frozen = true; return *this; }
     GroupingLevel &setPresicion(int64_t precision) { _precision = precision; return *this; }
+    /**
+     * Enable approximate grouping for this level. Instead of creating a group for every
+     * unique value, at most precision groups are kept per parent group, selected by their
+     * approximate hit counts. Only applies to levels where groups are not ordered by hit rank,
+     * as those already stop creating groups when reaching the precision.
+     **/
+    GroupingLevel &setApproximate(bool approximate) { _approximate = approximate; return *this; }
     GroupingLevel &setExpression(ExpressionNode::UP root) { _classify = std::move(root); return *this; }
     GroupingLevel &addResult(ExpressionNode::UP result) { _collect.addResult(std::move(result)); return *this; }
     GroupingLevel &addResult(const ExpressionNode & result) { return addResult(ExpressionNode::UP(result.clone())); }
@@ -106,7 +149,21 @@ public:
     int64_t getMaxGroups() const { return _maxGroups; }
     int64_t getPrecision() const { return _precision; }
     bool        isFrozen() const { return _frozen; }
-    bool    allowMoreGroups(size_t sz) const { return (!_frozen && (!_isOrdered || (sz < (uint64_t)_precision))); }
+    bool   isApproximate() const { return _approximate; }
+    bool    allowMoreGroups(size_t sz) const {
+        return (!_frozen && ((!_isOrdered && !_approximateGroups) || (sz < (uint64_t)_precision)));
+    }
+    /**
+     * The approximate hit counts used to select groups, or nullptr when grouping is exact.
+     **/
+    ApproximateGroups * getApproximateGroups() const { return _approximateGroups.get(); }
+    /**
+     * The max number of hits that may be missing from the aggregated results of a
+     * group on this level, as groups can be created after some of their hits have been
+     * seen during approximate grouping. 0 when grouping is exact.
+     **/
+    uint64_t getErrorBound() const { return _approximateGroups ? _approximateGroups->getErrorBound() : 0; }
+    void mergeApproximation(const GroupingLevel & rhs);
     const ExpressionTree & getExpression() const { return _classify; }
     ExpressionTree & getExpression() { return _classify; }
     const       Group &getGroupPrototype() const { return _collect; }
@@ -104,6 +104,9 @@ private:
         uint32_t estHits = _search_context->approximateHits();
         HitEstimate estimate(estHits, estHits == 0);
         setEstimate(estimate);
+        if (params.useBitVector() && attribute.getIsFastSearch()) {
+            set_cost(State::COST_CHEAP);
+        }
     }
 
     AttributeFieldBlueprint(const FieldSpec &field, const IAttributeVector &attribute,
@@ -732,12 +735,14 @@ public:
             return fail_nearest_neighbor_term(n, make_string("Attribute tensor type (%s) and query tensor type (%s) are not compatible",
                                                              dense_attr_tensor->getTensorType().to_spec().c_str(), qt_type.to_spec().c_str()));
         }
+        const auto& params = getRequestContext().get_attribute_blueprint_params();
         setResult(std::make_unique<queryeval::NearestNeighborBlueprint>(_field, *dense_attr_tensor,
                                                                         std::move(query_tensor),
                                                                         n.get_target_num_hits(),
                                                                         n.get_allow_approximate(),
                                                                         n.get_explore_additional_hits(),
-                                                                        getRequestContext().get_attribute_blueprint_params().nearest_neighbor_brute_force_limit));
+                                                                        params.nearest_neighbor_brute_force_limit,
+                                                                        params.nearest_neighbor_post_filter_limit));
     }
 };
 
@@ -10,14 +10,17 @@ namespace search::attribute {
 struct AttributeBlueprintParams
 {
     double nearest_neighbor_brute_force_limit;
+    double nearest_neighbor_post_filter_limit;
     
-    AttributeBlueprintParams(double nearest_neighbor_brute_force_limit_in)
-        : nearest_neighbor_brute_force_limit(nearest_neighbor_brute_force_limit_in)
+    AttributeBlueprintParams(double nearest_neighbor_brute_force_limit_in,
+                             double nearest_neighbor_post_filter_limit_in)
+        : nearest_neighbor_brute_force_limit(nearest_neighbor_brute_force_limit_in),
+          nearest_neighbor_post_filter_limit(nearest_neighbor_post_filter_limit_in)
     {
     }
 
     AttributeBlueprintParams()
-        : AttributeBlueprintParams(0.05)
+        : AttributeBlueprintParams(0.05, 1.0)
     {
     }
 };
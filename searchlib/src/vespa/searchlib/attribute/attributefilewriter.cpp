@@ -6,6 +6,9 @@
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
+#include <vespa/searchlib/common/write_throttle.h>
+#include <vespa/searchlib/util/aligned_file_writer.h>
+#include <vespa/searchlib/util/block_compressed_file.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/fastos/file.h>
 
@@ -23,22 +26,7 @@ const uint32_t headerAlign = 4096;
 const uint32_t MIN_ALIGNMENT = 4096;
 
 void
-writeDirectIOAligned(FastOS_FileInterface &file, const void *buf, size_t length)
-{
-    const char * data(static_cast<const char *>(buf));
-    size_t remaining(length);
-    for (size_t maxChunk(2048*1024); maxChunk >= MIN_ALIGNMENT; maxChunk >>= 1) {
-        for ( ; remaining > maxChunk; remaining -= maxChunk, data += maxChunk) {
-            file.WriteBuf(data, maxChunk);
-        }
-    }
-    if (remaining > 0) {
-        file.WriteBuf(data, remaining);
-    }
-}
-
-void
-updateHeader(const vespalib::string &name, uint64_t fileBitSize)
+updateHeader(const vespalib::string &name, uint64_t fileBitSize, bool compressed, uint64_t dataSize)
 {
     vespalib::FileHeader h(headerAlign);
     FastOS_File f;
@@ -48,6 +36,9 @@ updateHeader(const vespalib::string &name, uint64_t fileBitSize)
     typedef vespalib::GenericHeader::Tag Tag;
     h.putTag(Tag("frozen", 1));
     h.putTag(Tag("fileBitSize", fileBitSize));
+    if (compressed) {
+        BlockCompressedFile::addDataSizeTag(h, dataSize);
+    }
     h.rewriteFile(f);
     f.Sync();
     f.Close();
@@ -90,11 +81,14 @@ AttributeFileWriter(const TuneFileAttributes &tuneFileAttributes,
                     const attribute::AttributeHeader &header,
                     const vespalib::string &desc)
     : _file(new FastOS_File()),
+      _writer(),
       _tuneFileAttributes(tuneFileAttributes),
       _fileHeaderContext(fileHeaderContext),
       _header(header),
       _desc(desc),
-      _fileBitSize(0)
+      _fileBitSize(0),
+      _dataSize(0),
+      _pending()
 { }
 
 AttributeFileWriter::~AttributeFileWriter() = default;
@@ -115,6 +109,13 @@ AttributeFileWriter::open(const vespalib::string &fileName)
         return false;
     }
     writeHeader();
+    size_t memoryAlignment = 0;
+    size_t transferGranularity = 0;
+    size_t transferMaximum = 0;
+    // Drop written data from the page cache when direct I/O is wanted but not available
+    bool writeBehind = _tuneFileAttributes._write.getWantDirectIO() &&
+                       !_file->GetDirectIORestrictions(memoryAlignment, transferGranularity, transferMaximum);
+    _writer = std::make_unique<AlignedFileWriter>(*_file, writeBehind);
     return true;
 }
 
@@ -135,6 +136,17 @@ AttributeFileWriter::addTags(vespalib::GenericHeader &header)
     _header.addTags(header);
     using Tag = vespalib::GenericHeader::Tag;
     header.putTag(Tag("desc", _desc));
+    if (compressed()) {
+        BlockCompressedFile::addTags(header, _tuneFileAttributes._compression);
+    }
+}
+
+bool
+AttributeFileWriter::compressed() const
+{
+    auto type = _tuneFileAttributes._compression.type;
+    return (type == vespalib::compression::CompressionConfig::LZ4) ||
+           (type == vespalib::compression::CompressionConfig::ZSTD);
 }
 
 AttributeFileWriter::Buffer
@@ -146,19 +158,59 @@ AttributeFileWriter::allocBuf(size_t size)
 void
 AttributeFileWriter::writeBuf(Buffer buf)
 {
-    size_t bufLen = buf->getDataLen();
-    // TODO: pad to DirectIO boundary when burning bridges
-    writeDirectIOAligned(*_file, buf->getData(), bufLen);
-    _fileBitSize += bufLen * 8;
+    if (!compressed()) {
+        writeData(buf->getData(), buf->getDataLen());
+        return;
+    }
+    if (!_pending) {
+        _pending = std::make_unique<vespalib::DataBuffer>(BlockCompressedFile::BLOCK_SIZE);
+    }
+    const char *data = buf->getData();
+    size_t remaining = buf->getDataLen();
+    _dataSize += remaining;
+    while (remaining > 0) {
+        size_t len = std::min(remaining, BlockCompressedFile::BLOCK_SIZE - _pending->getDataLen());
+        _pending->writeBytes(data, len);
+        data += len;
+        remaining -= len;
+        if (_pending->getDataLen() == BlockCompressedFile::BLOCK_SIZE) {
+            writeCompressedBlock(_pending->getData(), _pending->getDataLen());
+            _pending->clear();
+        }
+    }
+}
+
+void
+AttributeFileWriter::writeData(const void *buf, size_t len)
+{
+    if (_tuneFileAttributes._throttle) {
+        _tuneFileAttributes._throttle->acquire(len);
+    }
+    _writer->write(buf, len);
+    _fileBitSize += len * 8;
+}
+
+void
+AttributeFileWriter::writeCompressedBlock(const char *buf, size_t len)
+{
+    vespalib::DataBuffer block(len);
+    BlockCompressedFile::compressBlock(_tuneFileAttributes._compression, buf, len, block);
+    writeData(block.getData(), block.getDataLen());
 }
 
 void
 AttributeFileWriter::close()
 {
     if (_file->IsOpened()) {
+        if (_pending && _pending->getDataLen() > 0) {
+            writeCompressedBlock(_pending->getData(), _pending->getDataLen());
+            _pending->clear();
+        }
+        _writer->flush();
+        _writer.reset();
         _file->Sync();
         _file->Close();
-        updateHeader(_file->GetFileName(), _fileBitSize);
+        updateHeader(_file->GetFileName(), _fileBitSize, compressed(), _dataSize);
     }
 }
 
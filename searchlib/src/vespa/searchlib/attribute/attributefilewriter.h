@@ -7,31 +7,42 @@
 
 class FastOS_FileInterface;
 
-namespace vespalib { class GenericHeader; }
+namespace vespalib {
+class DataBuffer;
+class GenericHeader;
+}
 
 namespace search {
 
 namespace common { class FileHeaderContext; }
 namespace attribute { class AttributeHeader; }
 
+class AlignedFileWriter;
 class TuneFileAttributes;
 
 /*
  * Class to write to a single attribute vector file. Used by
- * AttributeFileSaveTarget.
+ * AttributeFileSaveTarget. When compression is enabled in the tuning,
+ * the data is written in compressed blocks, see BlockCompressedFile.
  */
 class AttributeFileWriter : public IAttributeFileWriter
 {
     std::unique_ptr<FastOS_FileInterface> _file;
+    std::unique_ptr<AlignedFileWriter> _writer;
     const TuneFileAttributes &_tuneFileAttributes;
     const search::common::FileHeaderContext &_fileHeaderContext;
     const attribute::AttributeHeader &_header;
     vespalib::string _desc;
     uint64_t _fileBitSize;
+    uint64_t _dataSize;
+    std::unique_ptr<vespalib::DataBuffer> _pending;
 
     void addTags(vespalib::GenericHeader &header);
 
     void writeHeader();
+    bool compressed() const;
+    void writeData(const void *buf, size_t len);
+    void writeCompressedBlock(const char *buf, size_t len);
 public:
     AttributeFileWriter(const TuneFileAttributes &tuneFileAttributes,
                         const search::common::FileHeaderContext & fileHeaderContext,
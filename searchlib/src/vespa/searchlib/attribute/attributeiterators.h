@@ -165,6 +165,50 @@ public:
     { }
 };
 
+/**
+ * Strict iterator like AttributeIteratorStrict, for search contexts that
+ * can tell the first lid in a block of lids where a value may match
+ * (skipToCandidate()). Blocks that cannot match are skipped without
+ * looking at the values.
+ *
+ * @param SC the specialized search context type associated with this iterator
+ */
+template <typename SC>
+class BlockSkippingAttributeIteratorStrict : public AttributeIteratorT<SC>
+{
+private:
+    using AttributeIteratorT<SC>::_concreteSearchCtx;
+    using AttributeIteratorT<SC>::setDocId;
+    using AttributeIteratorT<SC>::setAtEnd;
+    using AttributeIteratorT<SC>::isAtEnd;
+    using AttributeIteratorT<SC>::_weight;
+    using Trinary=vespalib::Trinary;
+    void doSeek(uint32_t docId) override;
+    Trinary is_strict() const override { return Trinary::True; }
+public:
+    BlockSkippingAttributeIteratorStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData * matchData)
+        : AttributeIteratorT<SC>(concreteSearchCtx, matchData)
+    { }
+};
+
+
+template <typename SC>
+class BlockSkippingFilterAttributeIteratorStrict : public FilterAttributeIteratorT<SC>
+{
+private:
+    using FilterAttributeIteratorT<SC>::_concreteSearchCtx;
+    using FilterAttributeIteratorT<SC>::setDocId;
+    using FilterAttributeIteratorT<SC>::setAtEnd;
+    using FilterAttributeIteratorT<SC>::isAtEnd;
+    using Trinary=vespalib::Trinary;
+    void doSeek(uint32_t docId) override;
+    Trinary is_strict() const override { return Trinary::True; }
+public:
+    BlockSkippingFilterAttributeIteratorStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData *matchData)
+        : FilterAttributeIteratorT<SC>(concreteSearchCtx, matchData)
+    { }
+};
+
 /**
  * This class acts as an iterator over documents that are results for
  * the subquery represented by the search context object associated
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "attributeiterators.h"
+#include "min_max_block_index.h"
 #include <vespa/vespalib/btree/btreenode.hpp>
 #include <vespa/vespalib/btree/btreeiterator.hpp>
 #include <vespa/searchlib/fef/termfieldmatchdataposition.h>
@@ -158,6 +159,35 @@ void or_hits_helper(BitVector& result, PL& iterator, uint32_t end_id)
                                });
     iterator = end_itr;
 }
+
+/*
+ * Intersect result with the posting list by clearing the gaps between
+ * its keys, instead of materializing it as a full size bit vector
+ * first. This touches result once and allocates nothing.
+ */
+template <typename PL>
+void and_hits_helper(BitVector& result, PL& iterator, uint32_t begin_id, uint32_t end_id)
+{
+    uint32_t gap_start = begin_id;
+    auto clear_gap = [&](uint32_t key) {
+        result.clearInterval(gap_start, key);
+        gap_start = key + 1;
+    };
+    if constexpr (is_tree_iterator_v<PL>) {
+        auto end_itr = iterator;
+        if (end_itr.valid() && end_itr.getKey() < end_id) {
+            end_itr.seek(end_id);
+        }
+        iterator.foreach_key_range(end_itr, clear_gap);
+        iterator = end_itr;
+    } else {
+        for (; iterator.valid() && iterator.getKey() < end_id; ++iterator) {
+            clear_gap(iterator.getKey());
+        }
+    }
+    result.clearInterval(gap_start, result.size());
+    result.invalidateCachedCount();
+}
  
 }
 
@@ -195,7 +225,7 @@ AttributePostingListIteratorT<PL>::or_hits_into(BitVector & result, uint32_t beg
 template <typename PL>
 void
 AttributePostingListIteratorT<PL>::and_hits_into(BitVector &result, uint32_t begin_id) {
-    result.andWith(*get_hits(begin_id));
+    and_hits_helper(result, _iterator, begin_id, getEndId());
 }
 
 template <typename PL>
@@ -233,7 +263,7 @@ FilterAttributePostingListIteratorT<PL>::or_hits_into(BitVector & result, uint32
 template <typename PL>
 void
 FilterAttributePostingListIteratorT<PL>::and_hits_into(BitVector &result, uint32_t begin_id) {
-    result.andWith(*get_hits(begin_id));
+    and_hits_helper(result, _iterator, begin_id, getEndId());
 }
 
 template <typename PL>
@@ -456,6 +486,42 @@ FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
     setAtEnd();
 }
 
+template <typename SC>
+void
+BlockSkippingAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
+{
+    uint32_t nextId = _concreteSearchCtx.skipToCandidate(docId);
+    while (!isAtEnd(nextId)) {
+        if (this->matches(nextId, _weight)) {
+            setDocId(nextId);
+            return;
+        }
+        ++nextId;
+        if ((nextId & attribute::MinMaxBlockIndexBase::BLOCK_MASK) == 0) {
+            nextId = _concreteSearchCtx.skipToCandidate(nextId);
+        }
+    }
+    setAtEnd();
+}
+
+template <typename SC>
+void
+BlockSkippingFilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
+{
+    uint32_t nextId = _concreteSearchCtx.skipToCandidate(docId);
+    while (!isAtEnd(nextId)) {
+        if (this->matches(nextId)) {
+            setDocId(nextId);
+            return;
+        }
+        ++nextId;
+        if ((nextId & attribute::MinMaxBlockIndexBase::BLOCK_MASK) == 0) {
+            nextId = _concreteSearchCtx.skipToCandidate(nextId);
+        }
+    }
+    setAtEnd();
+}
+
 template <typename SC>
 void
 AttributeIteratorT<SC>::or_hits_into(BitVector & result, uint32_t begin_id) {
@@ -129,7 +129,9 @@ AttributeVector::AttributeVector(vespalib::stringref baseFileName, const Config
       _createSerialNum(0u),
       _compactLidSpaceGeneration(0u),
       _hasEnum(false),
-      _loaded(false)
+      _loaded(false),
+      _loadExecutor(nullptr),
+      _compactionExecutor(nullptr)
 {
 }
 
@@ -372,8 +374,15 @@ AttributeVector::isEnumeratedSaveFormat() const
 
 bool
 AttributeVector::load() {
+    return load(nullptr);
+}
+
+bool
+AttributeVector::load(vespalib::Executor *executor) {
     assert(!_loaded);
-    bool loaded = onLoad();
+    _loadExecutor = executor;
+    bool loaded = onLoad(executor);
+    _loadExecutor = nullptr;
     if (loaded) {
         commit();
     }
@@ -382,6 +391,7 @@ AttributeVector::load() {
 }
 
 bool AttributeVector::onLoad() { return false; }
+bool AttributeVector::onLoad(vespalib::Executor *) { return onLoad(); }
 int32_t AttributeVector::getWeight(DocId, uint32_t) const { return 1; }
 
 bool AttributeVector::findEnum(const char *, EnumHandle &) const { return false; }
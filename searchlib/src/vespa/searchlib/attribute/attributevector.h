@@ -36,6 +36,7 @@ namespace document {
 }
 
 namespace vespalib {
+    class Executor;
     class GenericHeader;
 }
 
@@ -316,6 +317,12 @@ protected:
         return _genHolder;
     }
 
+    /**
+     * Returns the executor given to load(), or nullptr when not loading.
+     * Used to parallelize costly parts of loading, e.g. sorting of loaded values.
+     */
+    vespalib::Executor *getLoadExecutor() const { return _loadExecutor; }
+
     template<typename T>
     bool clearDoc(ChangeVectorT< ChangeTemplate<T> > &changes, DocId doc);
 
@@ -447,6 +454,12 @@ public:
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Loads this attribute vector, using the given executor (if not nullptr)
+     * to parallelize costly parts of the load, e.g. rebuilding of a nearest neighbor index
+     * or sorting of loaded enum values before building posting lists.
+     */
+    bool load(vespalib::Executor *executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
     void setCreateSerialNum(uint64_t createSerialNum);
@@ -570,6 +583,7 @@ private:
     virtual bool applyWeight(DocId doc, const FieldValue& fv, const document::AssignValueUpdate& wAdjust);
     virtual void onSave(IAttributeSaveTarget & saveTarget);
     virtual bool onLoad();
+    virtual bool onLoad(vespalib::Executor *executor);
 
 
     BaseName                              _baseFileName;
@@ -587,6 +601,8 @@ private:
     uint64_t                              _compactLidSpaceGeneration;
     bool                                  _hasEnum;
     bool                                  _loaded;
+    vespalib::Executor                   *_loadExecutor;
+    vespalib::Executor                   *_compactionExecutor;
     vespalib::steady_time                 _nextStatUpdateTime;
 
 ////// Locking strategy interface. only available from the Guards.
@@ -657,6 +673,14 @@ public:
         return _interlock;
     }
 
+    /**
+     * Set executor used to parallelize costly parts of compaction, e.g. remapping
+     * of enum indexes after enum store compaction. Compaction runs in the calling
+     * thread when no executor is set.
+     */
+    void setCompactionExecutor(vespalib::Executor *executor) { _compactionExecutor = executor; }
+    vespalib::Executor *getCompactionExecutor() const { return _compactionExecutor; }
+
     std::unique_ptr<AttributeSaver> initSave(vespalib::stringref fileName);
 
     virtual std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName);
@@ -9,8 +9,16 @@ namespace search::attribute {
 using BitVectorSP = BitVectorSearchCache::BitVectorSP;
 
 BitVectorSearchCache::BitVectorSearchCache()
+    : BitVectorSearchCache(UNLIMITED)
+{
+}
+
+BitVectorSearchCache::BitVectorSearchCache(size_t maxMemoryUsage)
     : _mutex(),
-      _cache()
+      _cache(),
+      _maxMemoryUsage(maxMemoryUsage),
+      _memoryUsage(0),
+      _useCounter(0)
 {
 }
 
@@ -18,11 +26,39 @@ BitVectorSearchCache::~BitVectorSearchCache()
 {
 }
 
+size_t
+BitVectorSearchCache::entryMemoryUsage(const Entry::SP &entry)
+{
+    return (entry && entry->bitVector) ? entry->bitVector->getFileBytes() : 0;
+}
+
+void
+BitVectorSearchCache::evictUntilBelow(size_t memoryUsage)
+{
+    // Bit vectors are large, so the cache holds few of them and a linear scan is cheap.
+    while (!_cache.empty() && (_memoryUsage > memoryUsage)) {
+        auto oldest = _cache.begin();
+        for (auto itr = _cache.begin(); itr != _cache.end(); ++itr) {
+            if (itr->second.lastUsed < oldest->second.lastUsed) {
+                oldest = itr;
+            }
+        }
+        _memoryUsage -= entryMemoryUsage(oldest->second.entry);
+        _cache.erase(oldest);
+    }
+}
+
 void
 BitVectorSearchCache::insert(const vespalib::string &term, Entry::SP entry)
 {
+    size_t entrySize = entryMemoryUsage(entry);
     LockGuard guard(_mutex);
-    _cache.insert(std::make_pair(term, std::move(entry)));
+    if ((entrySize > _maxMemoryUsage) || (_cache.find(term) != _cache.end())) {
+        return;
+    }
+    evictUntilBelow(_maxMemoryUsage - entrySize);
+    _cache.insert(std::make_pair(term, CacheEntry(std::move(entry), ++_useCounter)));
+    _memoryUsage += entrySize;
 }
 
 BitVectorSearchCache::Entry::SP
@@ -31,7 +67,8 @@ BitVectorSearchCache::find(const vespalib::string &term) const
     LockGuard guard(_mutex);
     auto itr = _cache.find(term);
     if (itr != _cache.end()) {
-        return itr->second;
+        itr->second.lastUsed = ++_useCounter;
+        return itr->second.entry;
     }
     return Entry::SP();
 }
@@ -43,11 +80,19 @@ BitVectorSearchCache::size() const
     return _cache.size();
 }
 
+size_t
+BitVectorSearchCache::getMemoryUsage() const
+{
+    LockGuard guard(_mutex);
+    return _memoryUsage;
+}
+
 void
 BitVectorSearchCache::clear()
 {
     LockGuard guard(_mutex);
     _cache.clear();
+    _memoryUsage = 0;
 }
 
 }
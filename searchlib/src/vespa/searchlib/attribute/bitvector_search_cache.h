@@ -5,6 +5,7 @@
 #include <vespa/searchlib/common/i_document_meta_store_context.h>
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <limits>
 #include <memory>
 #include <mutex>
 
@@ -15,6 +16,8 @@ namespace search::attribute {
  * Class that caches posting lists (as bit vectors) for a set of search terms.
  *
  * Lifetime of cached bit vectors is controlled by calling clear() at regular intervals.
+ * When a max memory usage is given, the least recently used bit vectors are evicted
+ * when inserting a new one would make the cached bit vectors use more memory than that.
  */
 class BitVectorSearchCache {
 public:
@@ -32,19 +35,36 @@ public:
             : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIdLimit(docIdLimit_) {}
     };
 
+    static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
 private:
     using LockGuard = std::lock_guard<std::mutex>;
-    using Cache = vespalib::hash_map<vespalib::string, Entry::SP>;
+    struct CacheEntry {
+        Entry::SP entry;
+        mutable uint64_t lastUsed;
+        CacheEntry() noexcept : entry(), lastUsed(0) {}
+        CacheEntry(Entry::SP entry_, uint64_t lastUsed_) noexcept : entry(std::move(entry_)), lastUsed(lastUsed_) {}
+    };
+    using Cache = vespalib::hash_map<vespalib::string, CacheEntry>;
 
     mutable std::mutex _mutex;
     Cache _cache;
+    const size_t _maxMemoryUsage;
+    size_t _memoryUsage;
+    mutable uint64_t _useCounter;
+
+    static size_t entryMemoryUsage(const Entry::SP &entry);
+    void evictUntilBelow(size_t memoryUsage);
 
 public:
     BitVectorSearchCache();
+    explicit BitVectorSearchCache(size_t maxMemoryUsage);
     ~BitVectorSearchCache();
     void insert(const vespalib::string &term, Entry::SP entry);
     Entry::SP find(const vespalib::string &term) const;
     size_t size() const;
+    size_t getMemoryUsage() const;
+    size_t getMaxMemoryUsage() const { return _maxMemoryUsage; }
     void clear();
 };
 
@@ -3,6 +3,8 @@
 #include "attributefactory.h"
 #include "predicate_attribute.h"
 #include "singlesmallnumericattribute.h"
+#include "singlecompactintegerattribute.h"
+#include "singlemappednumericattribute.h"
 #include "reference_attribute.h"
 #include "singlenumericattribute.hpp"
 #include "singlestringattribute.h"
@@ -26,17 +28,41 @@ AttributeFactory::createSingleStd(stringref name, const Config & info)
     case BasicType::UINT4:
         return std::make_shared<SingleValueNibbleNumericAttribute>(name, info.getGrowStrategy());
     case BasicType::INT8:
+        if (info.mapped()) {
+            return std::make_shared<SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int8_t>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int8_t>>>(name, info);
     case BasicType::INT16:
         // XXX: Unneeded since we don't have short document fields in java.
+        if (info.mapped()) {
+            return std::make_shared<SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int16_t>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int16_t>>>(name, info);
     case BasicType::INT32:
+        if (info.compact()) {
+            return std::make_shared<SingleValueCompactIntegerAttribute<IntegerAttributeTemplate<int32_t>>>(name, info);
+        }
+        if (info.mapped()) {
+            return std::make_shared<SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int32_t>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t>>>(name, info);
     case BasicType::INT64:
+        if (info.compact()) {
+            return std::make_shared<SingleValueCompactIntegerAttribute<IntegerAttributeTemplate<int64_t>>>(name, info);
+        }
+        if (info.mapped()) {
+            return std::make_shared<SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int64_t>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<IntegerAttributeTemplate<int64_t>>>(name, info);
     case BasicType::FLOAT:
+        if (info.mapped()) {
+            return std::make_shared<SingleValueMappedNumericAttribute<FloatingPointAttributeTemplate<float>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<FloatingPointAttributeTemplate<float>>>(name, info);
     case BasicType::DOUBLE:
+        if (info.mapped()) {
+            return std::make_shared<SingleValueMappedNumericAttribute<FloatingPointAttributeTemplate<double>>>(name, info);
+        }
         return std::make_shared<SingleValueNumericAttribute<FloatingPointAttributeTemplate<double>>>(name, info);
     case BasicType::STRING:
         return std::make_shared<SingleValueStringAttribute>(name, info);
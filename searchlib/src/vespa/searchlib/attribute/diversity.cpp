@@ -4,6 +4,7 @@
 #include "singleenumattribute.h"
 #include "singlenumericattribute.h"
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <cstring>
 
 using std::make_unique;
 namespace search::attribute::diversity {
@@ -100,6 +101,29 @@ DiversityFilterT<Fetcher>::accepted(uint32_t docId) {
     return false;
 }
 
+namespace {
+
+uint64_t to_group(uint32_t value) { return value; }
+uint64_t to_group(int64_t value) { return value; }
+uint64_t to_group(int32_t value) { return to_group(int64_t(value)); }
+uint64_t to_group(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+uint64_t to_group(float value) { return to_group(double(value)); }
+
+}
+
+template <typename Fetcher>
+class DiversityGroupsT final : public queryeval::IDiversityGroups {
+private:
+    Fetcher _diversity;
+public:
+    explicit DiversityGroupsT(Fetcher diversity) : _diversity(diversity) {}
+    uint64_t group(uint32_t docId) const override { return to_group(_diversity.get(docId)); }
+};
+
 std::unique_ptr<DiversityFilter>
 DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hits,
                         size_t max_per_group,size_t cutoff_max_groups, bool cutoff_strict)
@@ -140,4 +164,41 @@ DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hi
     return std::unique_ptr<DiversityFilter>();
 }
 
+std::unique_ptr<queryeval::IDiversityGroups>
+create_groups(const IAttributeVector &diversity_attr)
+{
+    using Groups = std::unique_ptr<queryeval::IDiversityGroups>;
+    if (diversity_attr.hasEnum()) { // must handle enum first
+        FetchEnumFast fastEnum(diversity_attr);
+        return fastEnum.valid()
+               ? Groups(make_unique<DiversityGroupsT<FetchEnumFast>>(fastEnum))
+               : Groups(make_unique<DiversityGroupsT<FetchEnum>>(FetchEnum(diversity_attr)));
+    } else if (diversity_attr.isIntegerType()) {
+        using FetchInt32Fast = FetchNumberFast<SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t> > >;
+        using FetchInt64Fast = FetchNumberFast<SingleValueNumericAttribute<IntegerAttributeTemplate<int64_t> > >;
+        FetchInt32Fast fastInt32(diversity_attr);
+        FetchInt64Fast fastInt64(diversity_attr);
+        if (fastInt32.valid()) {
+            return make_unique<DiversityGroupsT<FetchInt32Fast>>(fastInt32);
+        } else if (fastInt64.valid()) {
+            return make_unique<DiversityGroupsT<FetchInt64Fast>>(fastInt64);
+        } else {
+            return make_unique<DiversityGroupsT<FetchInteger>>(FetchInteger(diversity_attr));
+        }
+    } else if (diversity_attr.isFloatingPointType()) {
+        using FetchFloatFast = FetchNumberFast<SingleValueNumericAttribute<FloatingPointAttributeTemplate<float> > >;
+        using FetchDoubleFast = FetchNumberFast<SingleValueNumericAttribute<FloatingPointAttributeTemplate<double> > >;
+        FetchFloatFast fastFloat(diversity_attr);
+        FetchDoubleFast fastDouble(diversity_attr);
+        if (fastFloat.valid()) {
+            return make_unique<DiversityGroupsT<FetchFloatFast>>(fastFloat);
+        } else if (fastDouble.valid()) {
+            return make_unique<DiversityGroupsT<FetchDoubleFast>>(fastDouble);
+        } else {
+            return make_unique<DiversityGroupsT<FetchFloat>>(FetchFloat(diversity_attr));
+        }
+    }
+    return Groups();
+}
+
 }
@@ -70,6 +70,13 @@ protected:
     size_t _max_total;
 };
 
+/**
+ * Create an object mapping documents to their value in the given
+ * single value diversity attribute. Returns an empty pointer if the
+ * attribute type is not supported.
+ **/
+std::unique_ptr<queryeval::IDiversityGroups> create_groups(const IAttributeVector &diversity_attr);
+
 template <typename Result>
 class DiversityRecorder {
 private:
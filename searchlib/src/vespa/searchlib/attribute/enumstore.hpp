@@ -246,8 +246,8 @@ EnumStoreT<EntryT>::consider_compact(const CompactionStrategy& compaction_strate
                            (used_bytes * compaction_strategy.getMaxDeadBytesRatio() < dead_bytes));
     bool compact_address_space = ((dead_address_space >= DEAD_ADDRESS_SPACE_SLACK) &&
                                   (used_address_space * compaction_strategy.getMaxDeadAddressSpaceRatio() < dead_address_space));
-    if (compact_memory || compact_address_space) {
-        return compact_worst(compact_memory, compact_address_space);
+    if (compact_memory || compact_address_space || _store.is_compacting()) {
+        return _store.compact_worst_step(compact_memory, compact_address_space, compaction_strategy.getMaxMovesPerStep());
     }
     return std::unique_ptr<IEnumStore::EnumIndexRemapper>();
 }
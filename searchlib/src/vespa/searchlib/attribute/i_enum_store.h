@@ -65,6 +65,11 @@ public:
     virtual vespalib::MemoryUsage get_values_memory_usage() const = 0;
     virtual vespalib::MemoryUsage get_dictionary_memory_usage() const = 0;
     virtual vespalib::MemoryUsage update_stat() = 0;
+    /**
+     * Consider starting compaction of the worst buffers, or continue an ongoing compaction by moving a
+     * bounded number of values. Returns a remapper when all values have been moved. The caller must then
+     * remap its enum indexes and call done() on the remapper.
+     */
     virtual std::unique_ptr<EnumIndexRemapper> consider_compact(const CompactionStrategy& compaction_strategy) = 0;
     virtual std::unique_ptr<EnumIndexRemapper> compact_worst(bool compact_memory, bool compact_address_space) = 0;
     virtual uint64_t get_compaction_count() const = 0;
@@ -23,7 +23,9 @@ class ReferenceAttribute;
  * - reference attribute, to ensure that access to lid mapping is safe.
  *
  * Extra information for direct lid to target lid mapping with
- * boundary check is setup during construction.
+ * boundary check is setup during construction. The mapping is the
+ * target lid array maintained incrementally by the reference attribute,
+ * so resolving a target lid is a single array lookup.
  */
 class ImportedAttributeVectorReadGuard : public IAttributeVector,
                                          public AttributeReadGuard
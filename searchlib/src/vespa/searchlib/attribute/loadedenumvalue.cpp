@@ -2,19 +2,87 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
+#include <vector>
 
 namespace search {
 namespace attribute {
 
+namespace {
+
+constexpr size_t MIN_CHUNK_SIZE = 256 * 1024;
+constexpr size_t MAX_CHUNKS = 16;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+radixSortByEnum(LoadedEnumAttribute *values, size_t numValues)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   &loaded[0], loaded.size(), 16);
+                   values, numValues, 16);
+}
+
+template <typename Func>
+void
+runInParallel(vespalib::Executor &executor, size_t numTasks, Func func)
+{
+    vespalib::CountDownLatch latch(numTasks);
+    for (size_t i = 0; i < numTasks; ++i) {
+        auto rejected = executor.execute(vespalib::makeLambdaTask([&func, &latch, i]() {
+            func(i);
+            latch.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+}
+
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+{
+    radixSortByEnum(&loaded[0], loaded.size());
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor)
+{
+    size_t numChunks = std::min(MAX_CHUNKS, loaded.size() / MIN_CHUNK_SIZE);
+    if (executor == nullptr || numChunks < 2) {
+        sortLoadedByEnum(loaded);
+        return;
+    }
+    LoadedEnumAttribute *values = &loaded[0];
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= numChunks; ++i) {
+        bounds.push_back(loaded.size() * i / numChunks);
+    }
+    runInParallel(*executor, numChunks, [values, &bounds](size_t i) {
+        radixSortByEnum(values + bounds[i], bounds[i + 1] - bounds[i]);
+    });
+    // Merge pairs of neighbouring sorted chunks until a single chunk remains.
+    while (bounds.size() > 2) {
+        runInParallel(*executor, (bounds.size() - 1) / 2, [values, &bounds](size_t i) {
+            std::inplace_merge(values + bounds[2 * i], values + bounds[2 * i + 1], values + bounds[2 * i + 2],
+                               LoadedEnumAttribute::EnumCompare());
+        });
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != bounds.back()) {
+            merged.push_back(bounds.back());
+        }
+        bounds.swap(merged);
+    }
 }
 
 } // namespace attribute
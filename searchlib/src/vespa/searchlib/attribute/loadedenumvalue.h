@@ -8,6 +8,8 @@
 #include <cassert>
 #include <limits>
 
+namespace vespalib { class Executor; }
+
 namespace search
 {
 
@@ -147,6 +149,13 @@ public:
 void
 sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
 
+/**
+ * Sort loaded enums, using the given executor (if not nullptr) to sort
+ * chunks of a large vector in parallel before merging them.
+ */
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor);
+
 } // namespace attribute
 
 } // namespace search
@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "min_max_block_index.h"
+
+namespace search::attribute {
+
+template <typename T>
+MinMaxBlockIndex<T>::MinMaxBlockIndex(vespalib::GenerationHolder &genHolder)
+    : _min(genHolder),
+      _max(genHolder),
+      _staleBlocks()
+{
+}
+
+template <typename T>
+MinMaxBlockIndex<T>::~MinMaxBlockIndex() = default;
+
+template <typename T>
+void
+MinMaxBlockIndex<T>::shrink(uint32_t docIdLimit)
+{
+    uint32_t wantedBlocks = (docIdLimit + BLOCK_MASK) >> BLOCK_SHIFT;
+    if (wantedBlocks < numBlocks()) {
+        _min.shrink(wantedBlocks);
+        _max.shrink(wantedBlocks);
+    }
+}
+
+template <typename T>
+vespalib::MemoryUsage
+MinMaxBlockIndex<T>::getMemoryUsage() const
+{
+    vespalib::MemoryUsage usage = _min.getMemoryUsage();
+    usage.merge(_max.getMemoryUsage());
+    usage.incAllocatedBytes(_staleBlocks.capacity() * sizeof(uint32_t));
+    usage.incUsedBytes(_staleBlocks.size() * sizeof(uint32_t));
+    return usage;
+}
+
+template class MinMaxBlockIndex<int8_t>;
+template class MinMaxBlockIndex<int16_t>;
+template class MinMaxBlockIndex<int32_t>;
+template class MinMaxBlockIndex<int64_t>;
+template class MinMaxBlockIndex<float>;
+template class MinMaxBlockIndex<double>;
+
+}
@@ -0,0 +1,144 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcommon/common/undefinedvalues.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace search::attribute {
+
+class MinMaxBlockIndexBase {
+public:
+    static constexpr uint32_t BLOCK_SHIFT = 10;
+    static constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_SHIFT;
+    static constexpr uint32_t BLOCK_MASK = BLOCK_SIZE - 1;
+};
+
+/**
+ * Synopsis of a single value numeric attribute, keeping the minimum and
+ * maximum defined value of each block of BLOCK_SIZE lids. Range search
+ * contexts use it to skip blocks that cannot contain a match.
+ *
+ * Bounds are widened when a value is written. A block where a bound value
+ * is overwritten becomes stale, and its bounds are recomputed by tighten()
+ * on commit. A block with no defined values has min > max.
+ */
+template <typename T>
+class MinMaxBlockIndex : public MinMaxBlockIndexBase {
+private:
+    vespalib::RcuVectorBase<T> _min;
+    vespalib::RcuVectorBase<T> _max;
+    std::vector<uint32_t>      _staleBlocks;
+
+    static constexpr T emptyMin() { return std::numeric_limits<T>::max(); }
+    static constexpr T emptyMax() { return std::numeric_limits<T>::lowest(); }
+
+    template <typename Getter>
+    void computeBlock(uint32_t blockId, uint32_t docIdLimit, Getter get) {
+        T minValue = emptyMin();
+        T maxValue = emptyMax();
+        uint32_t end = std::min(docIdLimit, (blockId + 1) << BLOCK_SHIFT);
+        for (uint32_t docId = blockId << BLOCK_SHIFT; docId < end; ++docId) {
+            T value = get(docId);
+            if (!isUndefined(value)) {
+                minValue = std::min(minValue, value);
+                maxValue = std::max(maxValue, value);
+            }
+        }
+        _min[blockId] = minValue;
+        _max[blockId] = maxValue;
+    }
+
+public:
+    MinMaxBlockIndex(vespalib::GenerationHolder &genHolder);
+    ~MinMaxBlockIndex();
+
+    uint32_t numBlocks() const { return _min.size(); }
+    T getMin(uint32_t blockId) const { return _min[blockId]; }
+    T getMax(uint32_t blockId) const { return _max[blockId]; }
+
+    /**
+     * Return whether adding a block will expand the underlying vectors.
+     */
+    bool isFull() const { return _min.isFull() || _max.isFull(); }
+
+    /**
+     * Make sure there is a block for the given lid, which must be added in lid order.
+     */
+    void addDoc(uint32_t docId) {
+        while (_min.size() <= (docId >> BLOCK_SHIFT)) {
+            _min.push_back(emptyMin());
+            _max.push_back(emptyMax());
+        }
+    }
+    void reserve(uint32_t docIdLimit) {
+        _min.reserve((docIdLimit >> BLOCK_SHIFT) + 1);
+        _max.reserve((docIdLimit >> BLOCK_SHIFT) + 1);
+    }
+
+    /**
+     * Register that the value of the given lid changes from oldValue to newValue.
+     * Must be called before the new value is visible to readers.
+     */
+    void update(uint32_t docId, T oldValue, T newValue) {
+        uint32_t blockId = docId >> BLOCK_SHIFT;
+        if (!isUndefined(oldValue) && !(oldValue == newValue) &&
+            (oldValue == _min[blockId] || oldValue == _max[blockId]) &&
+            (_staleBlocks.empty() || _staleBlocks.back() != blockId))
+        {
+            _staleBlocks.push_back(blockId);
+        }
+        if (!isUndefined(newValue)) {
+            if (newValue < _min[blockId]) {
+                _min[blockId] = newValue;
+            }
+            if (newValue > _max[blockId]) {
+                _max[blockId] = newValue;
+            }
+        }
+    }
+
+    /**
+     * Recompute the bounds of stale blocks, get(docId) giving the current value of a lid.
+     */
+    template <typename Getter>
+    void tighten(uint32_t docIdLimit, Getter get) {
+        if (_staleBlocks.empty()) {
+            return;
+        }
+        std::sort(_staleBlocks.begin(), _staleBlocks.end());
+        auto end = std::unique(_staleBlocks.begin(), _staleBlocks.end());
+        for (auto itr = _staleBlocks.begin(); itr != end; ++itr) {
+            if (*itr < numBlocks()) {
+                computeBlock(*itr, docIdLimit, get);
+            }
+        }
+        _staleBlocks.clear();
+    }
+
+    /**
+     * Recompute all bounds after the values of lids below docIdLimit have been loaded.
+     */
+    template <typename Getter>
+    void rebuild(uint32_t docIdLimit, Getter get) {
+        _min.reset();
+        _max.reset();
+        _staleBlocks.clear();
+        if (docIdLimit > 0) {
+            addDoc(docIdLimit - 1);
+        }
+        for (uint32_t blockId = 0; blockId < numBlocks(); ++blockId) {
+            computeBlock(blockId, docIdLimit, get);
+        }
+    }
+
+    void shrink(uint32_t docIdLimit);
+
+    vespalib::MemoryUsage getMemoryUsage() const;
+};
+
+}
@@ -2,6 +2,9 @@
 
 #include "multienumattribute.h"
 #include "multienumattribute.hpp"
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <stdexcept>
 
 namespace search {
@@ -20,26 +23,59 @@ using EnumIndexRemapper = IEnumStore::EnumIndexRemapper;
 using Value = multivalue::Value<EnumIndex>;
 using WeightedValue = multivalue::WeightedValue<EnumIndex>;
 
+namespace {
+
+constexpr uint32_t MIN_DOCS_PER_REMAP_TASK = 16384;
+constexpr uint32_t MAX_REMAP_TASKS = 16;
+
 template <typename WeightedIndex>
 void
-remap_enum_store_refs(const EnumIndexRemapper& remapper, AttributeVector& v, attribute::MultiValueMapping<WeightedIndex>& multi_value_mapping)
+remap_docs(const EnumIndexRemapper& remapper, attribute::MultiValueMapping<WeightedIndex>& multi_value_mapping,
+           uint32_t doc_begin, uint32_t doc_end)
 {
-    using WeightedIndexVector = std::vector<WeightedIndex>;
+    std::vector<WeightedIndex> indices;
+    for (uint32_t doc = doc_begin; doc < doc_end; ++doc) {
+        vespalib::ConstArrayRef<WeightedIndex> indicesRef(multi_value_mapping.get(doc));
+        indices.assign(indicesRef.cbegin(), indicesRef.cend());
+        for (auto& index : indices) {
+            index = WeightedIndex(remapper.remap(index.value()), index.weight());
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        multi_value_mapping.replace(doc, indices);
+    }
+}
 
+}
+
+template <typename WeightedIndex>
+void
+remap_enum_store_refs(const EnumIndexRemapper& remapper, AttributeVector& v, attribute::MultiValueMapping<WeightedIndex>& multi_value_mapping)
+{
     // update multi_value_mapping with new EnumIndex values after enum store has been compacted.
+    // Values are replaced in place, so disjoint ranges of documents can be remapped in parallel.
+    vespalib::Executor* executor = v.getCompactionExecutor();
+    uint32_t num_docs = v.getNumDocs();
+    uint32_t num_tasks = (executor != nullptr) ? std::min(MAX_REMAP_TASKS, num_docs / MIN_DOCS_PER_REMAP_TASK) : 0u;
     v.logEnumStoreEvent("compactfixup", "drain");
     {
         AttributeVector::EnumModifier enum_guard(v.getEnumModifier());
         v.logEnumStoreEvent("compactfixup", "start");
-        for (uint32_t doc = 0; doc < v.getNumDocs(); ++doc) {
-            vespalib::ConstArrayRef<WeightedIndex> indicesRef(multi_value_mapping.get(doc));
-            WeightedIndexVector indices(indicesRef.cbegin(), indicesRef.cend());
-            for (uint32_t i = 0; i < indices.size(); ++i) {
-                EnumIndex oldIndex = indices[i].value();
-                indices[i] = WeightedIndex(remapper.remap(oldIndex), indices[i].weight());
+        if (num_tasks <= 1) {
+            remap_docs(remapper, multi_value_mapping, 0, num_docs);
+        } else {
+            vespalib::CountDownLatch latch(num_tasks);
+            for (uint32_t i = 0; i < num_tasks; ++i) {
+                uint32_t doc_begin = uint64_t(num_docs) * i / num_tasks;
+                uint32_t doc_end = uint64_t(num_docs) * (i + 1) / num_tasks;
+                auto rejected = executor->execute(vespalib::makeLambdaTask([&, doc_begin, doc_end]() {
+                    remap_docs(remapper, multi_value_mapping, doc_begin, doc_end);
+                    latch.countDown();
+                }));
+                if (rejected) {
+                    rejected->run();
+                }
             }
-            std::atomic_thread_fence(std::memory_order_release);
-            multi_value_mapping.replace(doc, indices);
+            latch.await();
         }
     }
     v.logEnumStoreEvent("compactfixup", "complete");
@@ -101,7 +101,7 @@ MultiValueEnumAttribute<B, M>::load_enumerated_data(ReaderBase& attrReader,
                                                              vespalib::ConstArrayRef<EnumIndex>(loader.get_enum_indexes()),
                                                              attribute::SaveLoadedEnum(loader.get_loaded_enums()));
     loader.release_enum_indexes();
-    loader.sort_loaded_enums();
+    loader.sort_loaded_enums(this->getLoadExecutor());
     this->checkSetMaxValueCount(maxvc);
 }
 
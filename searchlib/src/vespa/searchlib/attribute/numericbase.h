@@ -38,6 +38,7 @@ protected:
         Equal(const QueryTermSimple &queryTerm, bool avoidUndefinedInRange);
         bool isValid() const { return _valid; }
         bool match(T v) const { return v == _value; }
+        bool overlaps(T minValue, T maxValue) const { return (minValue <= _value) && (_value <= maxValue); }
         Int64Range getRange() const {
             return Int64Range(static_cast<int64_t>(_value));
         }
@@ -60,6 +61,7 @@ protected:
         }
         bool isValid() const { return _valid; }
         bool match(T v) const { return (_low <= v) && (v <= _high); }
+        bool overlaps(T minValue, T maxValue) const { return (_low <= maxValue) && (minValue <= _high); }
         int getRangeLimit() const { return _limit; }
         size_t getMaxPerGroup() const { return _max_per_group; }
 
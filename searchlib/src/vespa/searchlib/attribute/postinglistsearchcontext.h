@@ -187,9 +187,9 @@ private:
     using Parent::_toBeSearched;
     using Parent::_enumStore;
     using Parent::isRegex;
-    using Parent::getRegex;
+    using Parent::isRegexMatch;
     bool useThis(const PostingListSearchContext::DictionaryConstIterator & it) const override {
-        return isRegex() ? (getRegex() ? getRegex()->partial_match(_enumStore.get_value(it.getKey())) : false ) : true;
+        return isRegex() ? isRegexMatch(_enumStore.get_value(it.getKey())) : true;
     }
 public:
     StringPostingSearchContext(QueryTermSimpleUP qTerm, bool useBitVector, const AttrT &toBeSearched);
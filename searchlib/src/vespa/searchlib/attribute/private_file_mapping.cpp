@@ -0,0 +1,66 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "private_file_mapping.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchlib.attribute.private_file_mapping");
+
+namespace search::attribute {
+
+PrivateFileMapping::PrivateFileMapping()
+    : _base(nullptr),
+      _size(0)
+{
+}
+
+PrivateFileMapping::~PrivateFileMapping()
+{
+    unmap();
+}
+
+bool
+PrivateFileMapping::map(const vespalib::string &fileName, size_t size)
+{
+    unmap();
+    if (size == 0) {
+        return false;
+    }
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG(warning, "could not open '%s' for mapping: %s", fileName.c_str(), std::strerror(errno));
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < size) {
+        LOG(warning, "file '%s' is too small for a mapping of %zu bytes", fileName.c_str(), size);
+        ::close(fd);
+        return false;
+    }
+    void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        LOG(warning, "could not map %zu bytes of '%s': %s", size, fileName.c_str(), std::strerror(errno));
+        return false;
+    }
+    _base = base;
+    _size = size;
+    return true;
+}
+
+void
+PrivateFileMapping::unmap()
+{
+    if (_base != nullptr) {
+        munmap(_base, _size);
+        _base = nullptr;
+        _size = 0;
+    }
+}
+
+}
@@ -0,0 +1,38 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <cstddef>
+
+namespace search::attribute {
+
+/**
+ * Private memory mapping of a file, used to access the values of a saved
+ * attribute in place. The mapping is writable, but writes are copy-on-write:
+ * a modified page is copied to anonymous memory by the kernel and the file
+ * itself is never changed. Unmodified pages are backed by the page cache.
+ */
+class PrivateFileMapping {
+private:
+    void   *_base;
+    size_t  _size;
+
+public:
+    PrivateFileMapping();
+    PrivateFileMapping(const PrivateFileMapping &) = delete;
+    PrivateFileMapping &operator=(const PrivateFileMapping &) = delete;
+    ~PrivateFileMapping();
+
+    /**
+     * Map the first size bytes of the given file, replacing any current mapping.
+     * Returns false if the file could not be opened or mapped.
+     */
+    bool map(const vespalib::string &fileName, size_t size);
+    void unmap();
+    bool valid() const { return _base != nullptr; }
+    char *data() const { return static_cast<char *>(_base); }
+    size_t size() const { return _size; }
+};
+
+}
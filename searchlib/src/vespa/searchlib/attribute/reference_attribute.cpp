@@ -31,6 +31,13 @@ constexpr size_t DEAD_BYTES_SLACK = 0x10000u;
 
 const vespalib::string uniqueValueCountTag = "uniqueValueCount";
 
+bool
+shouldCompactMemory(const vespalib::MemoryUsage &usage, const CompactionStrategy &compactionStrategy)
+{
+    return ((usage.deadBytes() >= DEAD_BYTES_SLACK) &&
+            (usage.usedBytes() * compactionStrategy.getMaxDeadBytesRatio() < usage.deadBytes()));
+}
+
 uint64_t
 extractUniqueValueCount(const vespalib::GenericHeader &header)
 {
@@ -45,6 +52,7 @@ ReferenceAttribute::ReferenceAttribute(const vespalib::stringref baseFileName,
       _store(),
       _indices(getGenerationHolder()),
       _cached_unique_store_values_memory_usage(),
+      _cached_reverse_mapping_small_arrays_memory_usage(),
       _gidToLidMapperFactory(),
       _referenceMappings(getGenerationHolder(), getCommittedDocIdLimitRef())
 {
@@ -190,6 +198,7 @@ ReferenceAttribute::onUpdateStat()
 {
     vespalib::MemoryUsage total = _store.get_values_memory_usage();
     _cached_unique_store_values_memory_usage = total;
+    _cached_reverse_mapping_small_arrays_memory_usage = _referenceMappings.getReverseMappingSmallArraysMemoryUsage();
     total.merge(_store.get_dictionary_memory_usage());
     total.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
     total.merge(_indices.getMemoryUsage());
@@ -286,14 +295,15 @@ ReferenceAttribute::getReference(DocId doc) const
 bool
 ReferenceAttribute::considerCompact(const CompactionStrategy &compactionStrategy)
 {
-    size_t usedBytes = _cached_unique_store_values_memory_usage.usedBytes();
-    size_t deadBytes = _cached_unique_store_values_memory_usage.deadBytes();
-    bool compactMemory = ((deadBytes >= DEAD_BYTES_SLACK) &&
-                          (usedBytes * compactionStrategy.getMaxDeadBytesRatio() < deadBytes));
-    if (compactMemory) {
+    if (shouldCompactMemory(_cached_unique_store_values_memory_usage, compactionStrategy)) {
         compactWorst();
         return true;
     }
+    // At most one compaction per commit, the reverse mapping is considered when the unique store is ok
+    if (shouldCompactMemory(_cached_reverse_mapping_small_arrays_memory_usage, compactionStrategy)) {
+        compactWorstReverseMapping();
+        return true;
+    }
     return false;
 }
 
@@ -307,6 +317,24 @@ ReferenceAttribute::compactWorst()
     }
 }
 
+void
+ReferenceAttribute::compactWorstReverseMapping()
+{
+    auto toHold = _referenceMappings.startCompactReverseMapping();
+    if (toHold.empty()) {
+        return;
+    }
+    // All references with a reverse mapping are referenced from at least one document
+    uint32_t numDocs = _indices.size();
+    for (uint32_t lid = 0; lid < numDocs; ++lid) {
+        EntryRef ref = _indices[lid];
+        if (ref.valid()) {
+            _referenceMappings.moveReverseMapping(_store.get(ref));
+        }
+    }
+    _referenceMappings.finishCompactReverseMapping(toHold);
+}
+
 uint64_t
 ReferenceAttribute::getUniqueValueCount() const
 {
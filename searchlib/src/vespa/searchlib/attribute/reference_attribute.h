@@ -43,6 +43,7 @@ private:
     ReferenceStore _store;
     ReferenceStoreIndices _indices;
     vespalib::MemoryUsage _cached_unique_store_values_memory_usage;
+    vespalib::MemoryUsage _cached_reverse_mapping_small_arrays_memory_usage;
     std::shared_ptr<IGidToLidMapperFactory> _gidToLidMapperFactory;
     ReferenceMappings _referenceMappings;
 
@@ -57,6 +58,7 @@ private:
 
     bool considerCompact(const CompactionStrategy &compactionStrategy);
     void compactWorst();
+    void compactWorstReverseMapping();
     IndicesCopyVector getIndicesCopy(uint32_t size) const;
     void removeReverseMapping(EntryRef oldRef, uint32_t lid);
     void addReverseMapping(EntryRef newRef, uint32_t lid);
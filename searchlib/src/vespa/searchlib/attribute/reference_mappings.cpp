@@ -77,6 +77,18 @@ ReferenceMappings::addReverseMapping(const Reference &entry, uint32_t lid)
     _targetLids[lid] = entry.lid(); // forward mapping
 }
 
+void
+ReferenceMappings::moveReverseMapping(const Reference &entry)
+{
+    EntryRef revMapIdx = entry.revMapIdx();
+    EntryRef newRevMapIdx = _reverseMapping.move(revMapIdx);
+    if (newRevMapIdx != revMapIdx) {
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.setRevMapIdx(newRevMapIdx);
+        syncReverseMappingIndices(entry);
+    }
+}
+
 void
 ReferenceMappings::buildReverseMapping(const Reference &entry, const std::vector<ReverseMapping::KeyDataType> &adds)
 {
@@ -71,10 +71,16 @@ public:
     void onLoad(uint32_t docIdLimit);
     void shrink(uint32_t docIdLimit);
 
+    // Compaction of small arrays in reverse mapping
+    std::vector<uint32_t> startCompactReverseMapping() { return _reverseMapping.startCompactWorstSmallArrays(); }
+    void moveReverseMapping(const Reference &entry);
+    void finishCompactReverseMapping(const std::vector<uint32_t> &toHold) { _reverseMapping.finishCompact(toHold); }
+
     // Setup mapping after load
     void buildReverseMapping(const Reference &entry, const std::vector<ReverseMapping::KeyDataType> &adds);
 
     vespalib::MemoryUsage getMemoryUsage();
+    vespalib::MemoryUsage getReverseMappingSmallArraysMemoryUsage() const { return _reverseMapping.getSmallArraysMemoryUsage(); }
 
     // Reader API, reader must hold generation guard
     template <typename FunctionType>
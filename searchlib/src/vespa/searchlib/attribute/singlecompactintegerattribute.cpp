@@ -0,0 +1,11 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "singlecompactintegerattribute.h"
+#include "singlecompactintegerattribute.hpp"
+
+namespace search {
+
+template class SingleValueCompactIntegerAttribute<IntegerAttributeTemplate<int32_t>>;
+template class SingleValueCompactIntegerAttribute<IntegerAttributeTemplate<int64_t>>;
+
+} // namespace search
@@ -0,0 +1,250 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "integerbase.h"
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <limits>
+
+namespace search {
+
+/**
+ * Single value integer attribute storing the values in blocks of BLOCK_SIZE documents,
+ * each block using frame-of-reference bit packing: a base value and a fixed bit width
+ * (a power of 2) per block, so any value is found with one shift and mask. The all ones
+ * delta is reserved for the undefined value.
+ *
+ * The block being appended to (the tail), and blocks with an update that does not fit
+ * the frame, are kept plain (one full width value per document) and are packed again on
+ * commit once they are full. Packed and plain blocks are never modified in place except
+ * for single values fitting the frame; a block changing layout is replaced, and the old
+ * one is held until readers are done with it.
+ */
+template <typename B>
+class SingleValueCompactIntegerAttribute final : public B {
+private:
+    using T = typename B::BaseType;
+    using Alloc = vespalib::alloc::Alloc;
+    using BlockVector = vespalib::RcuVectorBase<const uint64_t *>;
+    using DocId = typename B::DocId;
+    using EnumHandle = typename B::EnumHandle;
+    using Weighted = typename B::Weighted;
+    using WeightedEnum = typename B::WeightedEnum;
+    using WeightedFloat = typename B::WeightedFloat;
+    using WeightedInt = typename B::WeightedInt;
+    using generation_t = typename B::generation_t;
+    using largeint_t = typename B::largeint_t;
+
+    using B::getGenerationHolder;
+
+public:
+    static constexpr uint32_t BLOCK_SHIFT = 7;
+    static constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_SHIFT;
+    static constexpr uint32_t BLOCK_MASK = BLOCK_SIZE - 1;
+    static constexpr uint32_t PLAIN_WIDTH = 8 * sizeof(T);
+
+private:
+    // Block layout: base value, bit width, then BLOCK_SIZE * width bits of values.
+    static constexpr uint32_t HEADER_WORDS = 2;
+
+    BlockVector           _blocks;
+    std::vector<Alloc>    _blockAllocs;
+    size_t                _blockBytes;
+    std::vector<uint32_t> _dirtyBlocks;
+
+    T getFromEnum(EnumHandle e) const override {
+        (void) e;
+        return T();
+    }
+
+    static constexpr size_t blockWords(uint32_t width) {
+        return HEADER_WORDS + ((BLOCK_SIZE * width) >> 6);
+    }
+    static constexpr uint64_t widthMask(uint32_t width) {
+        return (width == 64) ? std::numeric_limits<uint64_t>::max() : ((uint64_t(1) << width) - 1);
+    }
+    static uint64_t toBits(T v) {
+        return static_cast<std::make_unsigned_t<T>>(v);
+    }
+    static void writeBits(uint64_t *block, uint32_t idx, uint32_t width, uint64_t bits) {
+        uint32_t bitPos = idx * width;
+        uint64_t &word = block[HEADER_WORDS + (bitPos >> 6)];
+        uint64_t mask = widthMask(width) << (bitPos & 63);
+        word = (word & ~mask) | ((bits << (bitPos & 63)) & mask);
+    }
+    static T decode(const uint64_t *block, uint32_t idx) {
+        uint32_t width = block[1];
+        if (width == 0) {
+            return static_cast<T>(static_cast<int64_t>(block[0]));
+        }
+        uint32_t bitPos = idx * width;
+        uint64_t bits = block[HEADER_WORDS + (bitPos >> 6)] >> (bitPos & 63);
+        if (width == PLAIN_WIDTH) {
+            return static_cast<T>(bits);
+        }
+        uint64_t delta = bits & widthMask(width);
+        if (delta == widthMask(width)) {
+            return attribute::getUndefined<T>();
+        }
+        return static_cast<T>(static_cast<int64_t>(block[0] + delta));
+    }
+    static T getValue(const uint64_t * const *blocks, DocId doc) {
+        return decode(blocks[doc >> BLOCK_SHIFT], doc & BLOCK_MASK);
+    }
+    static uint32_t chooseWidth(const T *values, int64_t &base);
+
+    uint64_t *writableBlock(uint32_t blockId) { return static_cast<uint64_t *>(_blockAllocs[blockId].get()); }
+    bool isPlain(uint32_t blockId) const { return _blocks[blockId][1] == PLAIN_WIDTH; }
+    bool isFull(uint32_t blockId) const { return ((blockId + 1) << BLOCK_SHIFT) <= B::getNumDocs(); }
+    void decodeBlock(uint32_t blockId, T *values) const;
+    Alloc createBlock(const T *values, uint32_t width, int64_t base);
+    void replaceBlock(uint32_t blockId, Alloc block);
+    void holdBlock(uint32_t blockId);
+    void makePlain(uint32_t blockId);
+    void packBlock(uint32_t blockId);
+    void packDirtyBlocks();
+    template <typename NextValue>
+    void loadBlocks(uint32_t numDocs, NextValue nextValue);
+
+    /*
+     * Specialization of SearchContext
+     */
+    template <typename M>
+    class SingleSearchContext final : public M, public AttributeVector::SearchContext
+    {
+    private:
+        const uint64_t * const * _blocks;
+
+        int32_t onFind(DocId docId, int32_t elemId, int32_t & weight) const override {
+            return find(docId, elemId, weight);
+        }
+
+        int32_t onFind(DocId docId, int elemId) const override {
+            return find(docId, elemId);
+        }
+
+        bool valid() const override;
+
+    public:
+        SingleSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const NumericAttribute & toBeSearched);
+        int32_t find(DocId docId, int32_t elemId, int32_t & weight) const {
+            if ( elemId != 0) return -1;
+            const T v = getValue(_blocks, docId);
+            weight = 1;
+            return this->match(v) ? 0 : -1;
+        }
+
+        int32_t find(DocId docId, int elemId) const {
+            if ( elemId != 0) return -1;
+            const T v = getValue(_blocks, docId);
+            return this->match(v) ? 0 : -1;
+        }
+
+        Int64Range getAsIntegerTerm() const override;
+
+        std::unique_ptr<queryeval::SearchIterator>
+        createFilterIterator(fef::TermFieldMatchData * matchData, bool strict) override;
+    };
+
+protected:
+    bool findEnum(T value, EnumHandle & e) const override {
+        (void) value; (void) e;
+        return false;
+    }
+
+public:
+    SingleValueCompactIntegerAttribute(const vespalib::string & baseFileName,
+                                       const AttributeVector::Config & c =
+                                       AttributeVector::Config(AttributeVector::
+                                               BasicType::fromType(T()),
+                                               attribute::CollectionType::SINGLE));
+
+    ~SingleValueCompactIntegerAttribute() override;
+
+    uint32_t getValueCount(DocId doc) const override {
+        if (doc >= B::getNumDocs()) {
+            return 0;
+        }
+        return 1;
+    }
+    void onCommit() override;
+    void onAddDocs(DocId lidLimit) override;
+    void onUpdateStat() override;
+    void removeOldGenerations(generation_t firstUsed) override;
+    void onGenerationChange(generation_t generation) override;
+    bool addDoc(DocId & doc) override;
+    bool onLoad() override;
+
+    bool onLoadEnumerated(ReaderBase &attrReader);
+
+    AttributeVector::SearchContext::UP
+    getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
+
+    void set(DocId doc, T v);
+
+    T getFast(DocId doc) const {
+        return getValue(&_blocks[0], doc);
+    }
+
+    //-------------------------------------------------------------------------
+    // new read api
+    //-------------------------------------------------------------------------
+    T get(DocId doc) const override {
+        return getFast(doc);
+    }
+    largeint_t getInt(DocId doc) const override {
+        return static_cast<largeint_t>(getFast(doc));
+    }
+    double getFloat(DocId doc) const override {
+        return static_cast<double>(getFast(doc));
+    }
+    uint32_t getEnum(DocId doc) const override {
+        (void) doc;
+        return std::numeric_limits<uint32_t>::max(); // does not have enum
+    }
+    uint32_t getAll(DocId doc, T * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = getFast(doc);
+        return 1;
+    }
+    uint32_t get(DocId doc, largeint_t * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<largeint_t>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, double * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<double>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, EnumHandle * e, uint32_t sz) const override {
+        (void) sz;
+        e[0] = getEnum(doc);
+        return 1;
+    }
+    uint32_t getAll(DocId doc, Weighted * v, uint32_t sz) const override {
+        (void) doc; (void) v; (void) sz;
+        return 0;
+    }
+    uint32_t get(DocId doc, WeightedInt * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedInt(static_cast<largeint_t>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedFloat * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedFloat(static_cast<double>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedEnum * e, uint32_t sz) const override {
+        (void) doc; (void) e; (void) sz;
+        return 0;
+    }
+
+    void clearDocs(DocId lidLow, DocId lidLimit) override;
+    void onShrinkLidSpace() override;
+    std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
+};
+
+}
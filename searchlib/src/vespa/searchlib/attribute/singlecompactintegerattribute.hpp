@@ -0,0 +1,480 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "attributeiterators.hpp"
+#include "attributevector.hpp"
+#include "load_utils.h"
+#include "primitivereader.h"
+#include "singlecompactintegerattribute.h"
+#include "singlenumericattributesaver.h"
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <algorithm>
+
+namespace search {
+
+template <typename B>
+SingleValueCompactIntegerAttribute<B>::
+SingleValueCompactIntegerAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c) :
+    B(baseFileName, c),
+    _blocks((c.getGrowStrategy().getDocsInitialCapacity() >> BLOCK_SHIFT) + 1,
+            c.getGrowStrategy().getDocsGrowPercent(),
+            (c.getGrowStrategy().getDocsGrowDelta() >> BLOCK_SHIFT) + 1,
+            getGenerationHolder()),
+    _blockAllocs(),
+    _blockBytes(0),
+    _dirtyBlocks()
+{ }
+
+template <typename B>
+SingleValueCompactIntegerAttribute<B>::~SingleValueCompactIntegerAttribute()
+{
+    getGenerationHolder().clearHoldLists();
+}
+
+template <typename B>
+uint32_t
+SingleValueCompactIntegerAttribute<B>::chooseWidth(const T *values, int64_t &base)
+{
+    bool hasDefined = false;
+    bool hasUndefined = false;
+    int64_t minValue = std::numeric_limits<int64_t>::max();
+    int64_t maxValue = std::numeric_limits<int64_t>::min();
+    for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+        if (attribute::isUndefined(values[i])) {
+            hasUndefined = true;
+        } else {
+            hasDefined = true;
+            minValue = std::min(minValue, static_cast<int64_t>(values[i]));
+            maxValue = std::max(maxValue, static_cast<int64_t>(values[i]));
+        }
+    }
+    if (!hasDefined) {
+        base = attribute::getUndefined<T>();
+        return 0;
+    }
+    if (!hasUndefined && (minValue == maxValue)) {
+        base = minValue;
+        return 0;
+    }
+    uint64_t range = static_cast<uint64_t>(maxValue) - static_cast<uint64_t>(minValue);
+    for (uint32_t width = 1; width < PLAIN_WIDTH; width <<= 1) {
+        // The all ones delta is reserved for the undefined value.
+        if (range < widthMask(width)) {
+            base = minValue;
+            return width;
+        }
+    }
+    base = 0;
+    return PLAIN_WIDTH;
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::decodeBlock(uint32_t blockId, T *values) const
+{
+    const uint64_t *block = _blocks[blockId];
+    for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+        values[i] = decode(block, i);
+    }
+}
+
+template <typename B>
+vespalib::alloc::Alloc
+SingleValueCompactIntegerAttribute<B>::createBlock(const T *values, uint32_t width, int64_t base)
+{
+    Alloc alloc = Alloc::allocHeap(blockWords(width) * sizeof(uint64_t));
+    uint64_t *block = static_cast<uint64_t *>(alloc.get());
+    memset(block, 0, alloc.size());
+    block[0] = static_cast<uint64_t>(base);
+    block[1] = width;
+    if (width != 0) {
+        for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+            uint64_t bits;
+            if (width == PLAIN_WIDTH) {
+                bits = toBits(values[i]);
+            } else if (attribute::isUndefined(values[i])) {
+                bits = widthMask(width);
+            } else {
+                bits = static_cast<uint64_t>(static_cast<int64_t>(values[i])) - static_cast<uint64_t>(base);
+            }
+            writeBits(block, i, width, bits);
+        }
+    }
+    return alloc;
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::holdBlock(uint32_t blockId)
+{
+    _blockBytes -= _blockAllocs[blockId].size();
+    getGenerationHolder().hold(std::make_unique<vespalib::GenerationHeldAlloc<Alloc>>(_blockAllocs[blockId]));
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::replaceBlock(uint32_t blockId, Alloc block)
+{
+    const uint64_t *newBlock = static_cast<const uint64_t *>(block.get());
+    _blockBytes += block.size();
+    std::atomic_thread_fence(std::memory_order_release);
+    if (blockId == _blocks.size()) {
+        _blocks.push_back(newBlock);
+        _blockAllocs.push_back(std::move(block));
+    } else {
+        _blocks[blockId] = newBlock;
+        holdBlock(blockId);
+        _blockAllocs[blockId] = std::move(block);
+    }
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::makePlain(uint32_t blockId)
+{
+    T values[BLOCK_SIZE];
+    decodeBlock(blockId, values);
+    replaceBlock(blockId, createBlock(values, PLAIN_WIDTH, 0));
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::packBlock(uint32_t blockId)
+{
+    T values[BLOCK_SIZE];
+    decodeBlock(blockId, values);
+    int64_t base = 0;
+    uint32_t width = chooseWidth(values, base);
+    if (width < PLAIN_WIDTH) {
+        replaceBlock(blockId, createBlock(values, width, base));
+    }
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::packDirtyBlocks()
+{
+    size_t numKept = 0;
+    for (size_t i = 0; i < _dirtyBlocks.size(); ++i) {
+        uint32_t blockId = _dirtyBlocks[i];
+        if (!isFull(blockId)) {
+            _dirtyBlocks[numKept++] = blockId;
+        } else if (isPlain(blockId)) {
+            packBlock(blockId);
+        }
+    }
+    _dirtyBlocks.resize(numKept);
+    uint32_t tailBlockId = _blocks.size() - 1;
+    if (!_blocks.empty() && isFull(tailBlockId) && isPlain(tailBlockId)) {
+        packBlock(tailBlockId);
+    }
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::set(DocId doc, T v)
+{
+    uint32_t blockId = doc >> BLOCK_SHIFT;
+    uint32_t idx = doc & BLOCK_MASK;
+    uint64_t *block = writableBlock(blockId);
+    uint32_t width = block[1];
+    if (width == PLAIN_WIDTH) {
+        writeBits(block, idx, width, toBits(v));
+        return;
+    }
+    if (width == 0) {
+        if (v == decode(block, idx)) {
+            return;
+        }
+    } else if (attribute::isUndefined(v)) {
+        writeBits(block, idx, width, widthMask(width));
+        return;
+    } else if (static_cast<int64_t>(v) >= static_cast<int64_t>(block[0])) {
+        uint64_t delta = static_cast<uint64_t>(static_cast<int64_t>(v)) - block[0];
+        if (delta < widthMask(width)) {
+            writeBits(block, idx, width, delta);
+            return;
+        }
+    }
+    // Value is outside the frame of the block, keep the block plain until next commit.
+    T values[BLOCK_SIZE];
+    decodeBlock(blockId, values);
+    values[idx] = v;
+    replaceBlock(blockId, createBlock(values, PLAIN_WIDTH, 0));
+    _dirtyBlocks.push_back(blockId);
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::onCommit()
+{
+    this->checkSetMaxValueCount(1);
+
+    {
+        // apply updates
+        typename B::ValueModifier valueGuard(this->getValueModifier());
+        for (const auto & change : this->_changes) {
+            if (change._type == ChangeBase::UPDATE) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, change._data);
+            } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, this->applyArithmetic(getFast(change._doc), change));
+            } else if (change._type == ChangeBase::CLEARDOC) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, this->_defaultValue._data);
+            }
+        }
+        packDirtyBlocks();
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    this->removeAllOldGenerations();
+
+    this->_changes.clear();
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::onUpdateStat()
+{
+    vespalib::MemoryUsage usage = _blocks.getMemoryUsage();
+    usage.incAllocatedBytes(_blockBytes + _blockAllocs.capacity() * sizeof(Alloc));
+    usage.incUsedBytes(_blockBytes + _blockAllocs.size() * sizeof(Alloc));
+    usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    usage.merge(this->getChangeVectorMemoryUsage());
+    uint32_t numDocs = B::getNumDocs();
+    this->updateStatistics(numDocs, numDocs,
+                           usage.allocatedBytes(), usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::onAddDocs(DocId lidLimit) {
+    _blocks.reserve((lidLimit >> BLOCK_SHIFT) + 1);
+    _blockAllocs.reserve((lidLimit >> BLOCK_SHIFT) + 1);
+}
+
+template <typename B>
+bool
+SingleValueCompactIntegerAttribute<B>::addDoc(DocId & doc) {
+    DocId numDocs = B::getNumDocs();
+    if ((numDocs & BLOCK_MASK) == 0) {
+        uint32_t blockId = numDocs >> BLOCK_SHIFT;
+        if (blockId > 0 && isPlain(blockId - 1)) {
+            // The previous tail block is now full, pack it on next commit.
+            _dirtyBlocks.push_back(blockId - 1);
+        }
+        bool incGen = _blocks.isFull();
+        T values[BLOCK_SIZE];
+        std::fill_n(values, BLOCK_SIZE, attribute::getUndefined<T>());
+        replaceBlock(blockId, createBlock(values, PLAIN_WIDTH, 0));
+        std::atomic_thread_fence(std::memory_order_release);
+        B::incNumDocs();
+        doc = B::getNumDocs() - 1;
+        this->updateUncommittedDocIdLimit(doc);
+        if (incGen) {
+            this->incGeneration();
+        } else
+            this->removeAllOldGenerations();
+    } else {
+        set(numDocs, attribute::getUndefined<T>());
+        std::atomic_thread_fence(std::memory_order_release);
+        B::incNumDocs();
+        doc = B::getNumDocs() - 1;
+        this->updateUncommittedDocIdLimit(doc);
+    }
+    return true;
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::removeOldGenerations(generation_t firstUsed)
+{
+    getGenerationHolder().trimHoldLists(firstUsed);
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::onGenerationChange(generation_t generation)
+{
+    getGenerationHolder().transferHoldLists(generation - 1);
+}
+
+template <typename B>
+template <typename NextValue>
+void
+SingleValueCompactIntegerAttribute<B>::loadBlocks(uint32_t numDocs, NextValue nextValue)
+{
+    getGenerationHolder().clearHoldLists();
+    _blocks.reset();
+    _blockAllocs.clear();
+    _blockBytes = 0;
+    _dirtyBlocks.clear();
+    uint32_t numBlocks = (numDocs + BLOCK_MASK) >> BLOCK_SHIFT;
+    _blocks.unsafe_reserve(numBlocks);
+    _blockAllocs.reserve(numBlocks);
+    T values[BLOCK_SIZE];
+    for (uint32_t blockId = 0; blockId < numBlocks; ++blockId) {
+        uint32_t blockDocs = std::min(BLOCK_SIZE, numDocs - (blockId << BLOCK_SHIFT));
+        for (uint32_t i = 0; i < blockDocs; ++i) {
+            values[i] = nextValue();
+        }
+        std::fill(values + blockDocs, values + BLOCK_SIZE, attribute::getUndefined<T>());
+        int64_t base = 0;
+        uint32_t width = (blockDocs == BLOCK_SIZE) ? chooseWidth(values, base) : PLAIN_WIDTH;
+        replaceBlock(blockId, createBlock(values, width, base));
+    }
+
+    B::setNumDocs(numDocs);
+    B::setCommittedDocIdLimit(numDocs);
+}
+
+template <typename B>
+bool
+SingleValueCompactIntegerAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
+{
+    uint32_t numDocs = attrReader.getEnumCount();
+    auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
+    assert((udatBuffer->size() % sizeof(T)) == 0);
+    vespalib::ConstArrayRef<T> map(reinterpret_cast<const T *>(udatBuffer->buffer()),
+                                   udatBuffer->size() / sizeof(T));
+    loadBlocks(numDocs, [&attrReader, &map]() {
+        uint32_t enumValue = attrReader.getNextEnum();
+        assert(enumValue < map.size());
+        return map[enumValue];
+    });
+    return true;
+}
+
+template <typename B>
+bool
+SingleValueCompactIntegerAttribute<B>::onLoad()
+{
+    PrimitiveReader<T> attrReader(*this);
+    bool ok(attrReader.getHasLoadData());
+
+    if (!ok)
+        return false;
+
+    this->setCreateSerialNum(attrReader.getCreateSerialNum());
+
+    if (attrReader.getEnumerated())
+        return onLoadEnumerated(attrReader);
+
+    loadBlocks(attrReader.getDataCount(), [&attrReader]() { return attrReader.getNextData(); });
+    return true;
+}
+
+template <typename B>
+AttributeVector::SearchContext::UP
+SingleValueCompactIntegerAttribute<B>::getSearch(QueryTermSimple::UP qTerm,
+                                                 const attribute::SearchContextParams & params) const
+{
+    (void) params;
+    QueryTermSimple::RangeResult<T> res = qTerm->getRange<T>();
+    if (res.isEqual()) {
+        return std::make_unique<SingleSearchContext<NumericAttribute::Equal<T>>>(std::move(qTerm), *this);
+    } else {
+        return std::make_unique<SingleSearchContext<NumericAttribute::Range<T>>>(std::move(qTerm), *this);
+    }
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::clearDocs(DocId lidLow, DocId lidLimit)
+{
+    assert(lidLow <= lidLimit);
+    assert(lidLimit <= this->getNumDocs());
+    uint32_t count = 0;
+    constexpr uint32_t commit_interval = 1000;
+    for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+        if (!attribute::isUndefined(getFast(lid))) {
+            this->clearDoc(lid);
+        }
+        if ((++count % commit_interval) == 0) {
+            this->commit();
+        }
+    }
+}
+
+template <typename B>
+void
+SingleValueCompactIntegerAttribute<B>::onShrinkLidSpace()
+{
+    uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
+    assert(B::getNumDocs() >= committedDocIdLimit);
+    uint32_t numBlocks = (committedDocIdLimit + BLOCK_MASK) >> BLOCK_SHIFT;
+    for (uint32_t blockId = numBlocks; blockId < _blocks.size(); ++blockId) {
+        holdBlock(blockId);
+    }
+    _blocks.shrink(numBlocks);
+    _blockAllocs.erase(_blockAllocs.begin() + numBlocks, _blockAllocs.end());
+    _dirtyBlocks.erase(std::remove_if(_dirtyBlocks.begin(), _dirtyBlocks.end(),
+                                      [numBlocks](uint32_t blockId) { return blockId >= numBlocks; }),
+                       _dirtyBlocks.end());
+    this->setNumDocs(committedDocIdLimit);
+    if ((committedDocIdLimit & BLOCK_MASK) != 0 && !isPlain(numBlocks - 1)) {
+        // New documents are appended to the partial last block, which must be plain.
+        makePlain(numBlocks - 1);
+    }
+}
+
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValueCompactIntegerAttribute<B>::onInitSave(vespalib::stringref fileName)
+{
+    // Saved as a plain attribute, i.e. the same file format as SingleValueNumericAttribute.
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    const size_t size = numDocs * sizeof(T);
+    auto buf = std::make_unique<IAttributeFileWriter::BufferBuf>(size, 4096);
+    T *values = reinterpret_cast<T *>(buf->getFree());
+    for (DocId doc = 0; doc < numDocs; ++doc) {
+        values[doc] = getFast(doc);
+    }
+    buf->moveFreeToData(size);
+    return std::make_unique<SingleValueNumericAttributeSaver>(this->createAttributeHeader(fileName), std::move(buf));
+}
+
+template <typename B>
+template <typename M>
+bool SingleValueCompactIntegerAttribute<B>::SingleSearchContext<M>::valid() const { return M::isValid(); }
+
+template <typename B>
+template <typename M>
+SingleValueCompactIntegerAttribute<B>::SingleSearchContext<M>::SingleSearchContext(QueryTermSimple::UP qTerm,
+                                                                                   const NumericAttribute & toBeSearched) :
+    M(*qTerm, true),
+    AttributeVector::SearchContext(toBeSearched),
+    _blocks(&static_cast<const SingleValueCompactIntegerAttribute<B> &>(toBeSearched)._blocks[0])
+{ }
+
+template <typename B>
+template <typename M>
+Int64Range
+SingleValueCompactIntegerAttribute<B>::SingleSearchContext<M>::getAsIntegerTerm() const {
+    return M::getRange();
+}
+
+template <typename B>
+template <typename M>
+std::unique_ptr<queryeval::SearchIterator>
+SingleValueCompactIntegerAttribute<B>::SingleSearchContext<M>::
+createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
+{
+    if (!valid()) {
+        return std::make_unique<queryeval::EmptySearch>();
+    }
+    if (getIsFilter()) {
+        return strict
+                 ? std::make_unique<FilterAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+                 : std::make_unique<FilterAttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
+    }
+    return strict
+             ? std::make_unique<AttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+             : std::make_unique<AttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
+}
+}
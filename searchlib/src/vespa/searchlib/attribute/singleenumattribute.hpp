@@ -210,7 +210,7 @@ SingleValueEnumAttribute<B>::load_enumerated_data(ReaderBase& attrReader,
                                              loader.get_enum_indexes(),
                                              attribute::SaveLoadedEnum(loader.get_loaded_enums()));
     loader.release_enum_indexes();
-    loader.sort_loaded_enums();
+    loader.sort_loaded_enums(this->getLoadExecutor());
 }
     
 template <typename B>
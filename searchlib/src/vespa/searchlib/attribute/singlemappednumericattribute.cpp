@@ -0,0 +1,15 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "singlemappednumericattribute.h"
+#include "singlemappednumericattribute.hpp"
+
+namespace search {
+
+template class SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int8_t>>;
+template class SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int16_t>>;
+template class SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int32_t>>;
+template class SingleValueMappedNumericAttribute<IntegerAttributeTemplate<int64_t>>;
+template class SingleValueMappedNumericAttribute<FloatingPointAttributeTemplate<float>>;
+template class SingleValueMappedNumericAttribute<FloatingPointAttributeTemplate<double>>;
+
+} // namespace search
@@ -0,0 +1,208 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "integerbase.h"
+#include "floatbase.h"
+#include "private_file_mapping.h"
+#include <vespa/vespalib/util/rcuvector.h>
+#include <limits>
+
+namespace search {
+
+/**
+ * Single value numeric attribute for read-mostly data, where the values of the
+ * documents present in the saved .dat file are read in place from a private
+ * (copy-on-write) memory mapping of that file instead of being copied to heap.
+ * Updates to those documents are written to the mapping, only copying the
+ * touched pages to anonymous memory. Documents added after loading are stored
+ * in a regular vector (the tail).
+ *
+ * Note that the mapped file keeps using disk space until the attribute is
+ * destroyed, also after a newer snapshot has been saved and the old one removed.
+ */
+template <typename B>
+class SingleValueMappedNumericAttribute final : public B {
+private:
+    using T = typename B::BaseType;
+    using DataVector = vespalib::RcuVectorBase<T>;
+    using DocId = typename B::DocId;
+    using EnumHandle = typename B::EnumHandle;
+    using Weighted = typename B::Weighted;
+    using WeightedEnum = typename B::WeightedEnum;
+    using WeightedFloat = typename B::WeightedFloat;
+    using WeightedInt = typename B::WeightedInt;
+    using generation_t = typename B::generation_t;
+    using largeint_t = typename B::largeint_t;
+
+    using B::getGenerationHolder;
+
+    attribute::PrivateFileMapping _mapping;
+    T                            *_mapped;
+    uint32_t                      _mappedDocs;
+    DataVector                    _tail;
+
+    T getFromEnum(EnumHandle e) const override {
+        (void) e;
+        return T();
+    }
+
+    static T getValue(const T *mapped, uint32_t mappedDocs, const T *tail, DocId doc) {
+        return (doc < mappedDocs) ? mapped[doc] : tail[doc - mappedDocs];
+    }
+    bool mapDataFile(uint32_t headerLen, uint32_t numDocs);
+
+    /*
+     * Specialization of SearchContext
+     */
+    template <typename M>
+    class SingleSearchContext final : public M, public AttributeVector::SearchContext
+    {
+    private:
+        const T  *_mapped;
+        uint32_t  _mappedDocs;
+        const T  *_tail;
+
+        int32_t onFind(DocId docId, int32_t elemId, int32_t & weight) const override {
+            return find(docId, elemId, weight);
+        }
+
+        int32_t onFind(DocId docId, int elemId) const override {
+            return find(docId, elemId);
+        }
+
+        bool valid() const override;
+
+    public:
+        SingleSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const NumericAttribute & toBeSearched);
+        int32_t find(DocId docId, int32_t elemId, int32_t & weight) const {
+            if ( elemId != 0) return -1;
+            const T v = getValue(_mapped, _mappedDocs, _tail, docId);
+            weight = 1;
+            return this->match(v) ? 0 : -1;
+        }
+
+        int32_t find(DocId docId, int elemId) const {
+            if ( elemId != 0) return -1;
+            const T v = getValue(_mapped, _mappedDocs, _tail, docId);
+            return this->match(v) ? 0 : -1;
+        }
+
+        Int64Range getAsIntegerTerm() const override;
+
+        std::unique_ptr<queryeval::SearchIterator>
+        createFilterIterator(fef::TermFieldMatchData * matchData, bool strict) override;
+    };
+
+protected:
+    bool findEnum(T value, EnumHandle & e) const override {
+        (void) value; (void) e;
+        return false;
+    }
+
+public:
+    SingleValueMappedNumericAttribute(const vespalib::string & baseFileName,
+                                      const AttributeVector::Config & c =
+                                      AttributeVector::Config(AttributeVector::
+                                              BasicType::fromType(T()),
+                                              attribute::CollectionType::SINGLE));
+
+    ~SingleValueMappedNumericAttribute() override;
+
+    uint32_t getValueCount(DocId doc) const override {
+        if (doc >= B::getNumDocs()) {
+            return 0;
+        }
+        return 1;
+    }
+    void onCommit() override;
+    void onAddDocs(DocId lidLimit) override;
+    void onUpdateStat() override;
+    void removeOldGenerations(generation_t firstUsed) override;
+    void onGenerationChange(generation_t generation) override;
+    bool addDoc(DocId & doc) override;
+    bool onLoad() override;
+
+    bool onLoadEnumerated(ReaderBase &attrReader);
+
+    AttributeVector::SearchContext::UP
+    getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
+
+    void set(DocId doc, T v) {
+        if (doc < _mappedDocs) {
+            _mapped[doc] = v;
+        } else {
+            _tail[doc - _mappedDocs] = v;
+        }
+    }
+
+    T getFast(DocId doc) const {
+        return getValue(_mapped, _mappedDocs, &_tail[0], doc);
+    }
+
+    /**
+     * Returns the number of documents whose values are read from the mapped file.
+     */
+    uint32_t getMappedDocs() const { return _mappedDocs; }
+
+    //-------------------------------------------------------------------------
+    // new read api
+    //-------------------------------------------------------------------------
+    T get(DocId doc) const override {
+        return getFast(doc);
+    }
+    largeint_t getInt(DocId doc) const override {
+        return static_cast<largeint_t>(getFast(doc));
+    }
+    double getFloat(DocId doc) const override {
+        return static_cast<double>(getFast(doc));
+    }
+    uint32_t getEnum(DocId doc) const override {
+        (void) doc;
+        return std::numeric_limits<uint32_t>::max(); // does not have enum
+    }
+    uint32_t getAll(DocId doc, T * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = getFast(doc);
+        return 1;
+    }
+    uint32_t get(DocId doc, largeint_t * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<largeint_t>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, double * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<double>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, EnumHandle * e, uint32_t sz) const override {
+        (void) sz;
+        e[0] = getEnum(doc);
+        return 1;
+    }
+    uint32_t getAll(DocId doc, Weighted * v, uint32_t sz) const override {
+        (void) doc; (void) v; (void) sz;
+        return 0;
+    }
+    uint32_t get(DocId doc, WeightedInt * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedInt(static_cast<largeint_t>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedFloat * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedFloat(static_cast<double>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedEnum * e, uint32_t sz) const override {
+        (void) doc; (void) e; (void) sz;
+        return 0;
+    }
+
+    void clearDocs(DocId lidLow, DocId lidLimit) override;
+    void onShrinkLidSpace() override;
+    std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
+};
+
+}
@@ -0,0 +1,292 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "attributeiterators.hpp"
+#include "attributevector.hpp"
+#include "load_utils.h"
+#include "primitivereader.h"
+#include "singlemappednumericattribute.h"
+#include "singlenumericattributesaver.h"
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <cstring>
+
+namespace search {
+
+template <typename B>
+SingleValueMappedNumericAttribute<B>::
+SingleValueMappedNumericAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c) :
+    B(baseFileName, c),
+    _mapping(),
+    _mapped(nullptr),
+    _mappedDocs(0),
+    _tail(c.getGrowStrategy().getDocsInitialCapacity(),
+          c.getGrowStrategy().getDocsGrowPercent(),
+          c.getGrowStrategy().getDocsGrowDelta(),
+          getGenerationHolder())
+{ }
+
+template <typename B>
+SingleValueMappedNumericAttribute<B>::~SingleValueMappedNumericAttribute()
+{
+    getGenerationHolder().clearHoldLists();
+}
+
+template <typename B>
+void
+SingleValueMappedNumericAttribute<B>::onCommit()
+{
+    this->checkSetMaxValueCount(1);
+
+    {
+        // apply updates
+        typename B::ValueModifier valueGuard(this->getValueModifier());
+        for (const auto & change : this->_changes) {
+            if (change._type == ChangeBase::UPDATE) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, change._data);
+            } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, this->applyArithmetic(getFast(change._doc), change));
+            } else if (change._type == ChangeBase::CLEARDOC) {
+                std::atomic_thread_fence(std::memory_order_release);
+                set(change._doc, this->_defaultValue._data);
+            }
+        }
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    this->removeAllOldGenerations();
+
+    this->_changes.clear();
+}
+
+template <typename B>
+void
+SingleValueMappedNumericAttribute<B>::onUpdateStat()
+{
+    vespalib::MemoryUsage usage = _tail.getMemoryUsage();
+    // Mapped pages are counted as used, as any of them may be copied to anonymous memory by an update.
+    usage.incAllocatedBytes(_mappedDocs * sizeof(T));
+    usage.incUsedBytes(_mappedDocs * sizeof(T));
+    usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    usage.merge(this->getChangeVectorMemoryUsage());
+    this->updateStatistics(B::getNumDocs(), B::getNumDocs(),
+                           usage.allocatedBytes(), usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
+}
+
+template <typename B>
+void
+SingleValueMappedNumericAttribute<B>::onAddDocs(DocId lidLimit) {
+    if (lidLimit > _mappedDocs) {
+        _tail.reserve(lidLimit - _mappedDocs);
+    }
+}
+
+template <typename B>
+bool
+SingleValueMappedNumericAttribute<B>::addDoc(DocId & doc) {
+    bool incGen = _tail.isFull();
+    _tail.push_back(attribute::getUndefined<T>());
+    std::atomic_thread_fence(std::memory_order_release);
+    B::incNumDocs();
+    doc = B::getNumDocs() - 1;
+    this->updateUncommittedDocIdLimit(doc);
+    if (incGen) {
+        this->incGeneration();
+    } else
+        this->removeAllOldGenerations();
+    return true;
+}
+
+template <typename B>
+void
+SingleValueMappedNumericAttribute<B>::removeOldGenerations(generation_t firstUsed)
+{
+    getGenerationHolder().trimHoldLists(firstUsed);
+}
+
+template <typename B>
+void
+SingleValueMappedNumericAttribute<B>::onGenerationChange(generation_t generation)
+{
+    getGenerationHolder().transferHoldLists(generation - 1);
+}
+
+template <typename B>
+bool
+SingleValueMappedNumericAttribute<B>::mapDataFile(uint32_t headerLen, uint32_t numDocs)
+{
+    if ((headerLen % alignof(T)) != 0 ||
+        !_mapping.map(this->getBaseFileName() + ".dat", headerLen + size_t(numDocs) * sizeof(T)))
+    {
+        return false;
+    }
+    _mapped = reinterpret_cast<T *>(_mapping.data() + headerLen);
+    _mappedDocs = numDocs;
+    return true;
+}
+
+template <typename B>
+bool
+SingleValueMappedNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
+{
+    uint32_t numDocs = attrReader.getEnumCount();
+    auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
+    assert((udatBuffer->size() % sizeof(T)) == 0);
+    vespalib::ConstArrayRef<T> map(reinterpret_cast<const T *>(udatBuffer->buffer()),
+                                   udatBuffer->size() / sizeof(T));
+    getGenerationHolder().clearHoldLists();
+    _tail.reset();
+    _tail.unsafe_reserve(numDocs);
+    for (uint32_t doc = 0; doc < numDocs; ++doc) {
+        uint32_t enumValue = attrReader.getNextEnum();
+        assert(enumValue < map.size());
+        _tail.push_back(map[enumValue]);
+    }
+    B::setNumDocs(numDocs);
+    B::setCommittedDocIdLimit(numDocs);
+    return true;
+}
+
+template <typename B>
+bool
+SingleValueMappedNumericAttribute<B>::onLoad()
+{
+    PrimitiveReader<T> attrReader(*this);
+    bool ok(attrReader.getHasLoadData());
+
+    if (!ok)
+        return false;
+
+    this->setCreateSerialNum(attrReader.getCreateSerialNum());
+
+    if (attrReader.getEnumerated())
+        return onLoadEnumerated(attrReader);
+
+    const size_t sz(attrReader.getDataCount());
+    getGenerationHolder().clearHoldLists();
+    _tail.reset();
+    if (!mapDataFile(attrReader.getDatHeaderLen(), sz)) {
+        // Fall back to reading the values into the tail.
+        _tail.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _tail.push_back(attrReader.getNextData());
+        }
+    }
+
+    B::setNumDocs(sz);
+    B::setCommittedDocIdLimit(sz);
+
+    return true;
+}
+
+template <typename B>
+AttributeVector::SearchContext::UP
+SingleValueMappedNumericAttribute<B>::getSearch(QueryTermSimple::UP qTerm,
+                                                const attribute::SearchContextParams & params) const
+{
+    (void) params;
+    QueryTermSimple::RangeResult<T> res = qTerm->getRange<T>();
+    if (res.isEqual()) {
+        return std::make_unique<SingleSearchContext<NumericAttribute::Equal<T>>>(std::move(qTerm), *this);
+    } else {
+        return std::make_unique<SingleSearchContext<NumericAttribute::Range<T>>>(std::move(qTerm), *this);
+    }
+}
+
+template <typename B>
+void
+SingleValueMappedNumericAttribute<B>::clearDocs(DocId lidLow, DocId lidLimit)
+{
+    assert(lidLow <= lidLimit);
+    assert(lidLimit <= this->getNumDocs());
+    uint32_t count = 0;
+    constexpr uint32_t commit_interval = 1000;
+    for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+        if (!attribute::isUndefined(getFast(lid))) {
+            this->clearDoc(lid);
+        }
+        if ((++count % commit_interval) == 0) {
+            this->commit();
+        }
+    }
+}
+
+template <typename B>
+void
+SingleValueMappedNumericAttribute<B>::onShrinkLidSpace()
+{
+    uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
+    assert(B::getNumDocs() >= committedDocIdLimit);
+    if (committedDocIdLimit < _mappedDocs) {
+        // The mapping is kept, as readers may still access it.
+        _mappedDocs = committedDocIdLimit;
+    }
+    _tail.shrink(committedDocIdLimit - _mappedDocs);
+    this->setNumDocs(committedDocIdLimit);
+}
+
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValueMappedNumericAttribute<B>::onInitSave(vespalib::stringref fileName)
+{
+    // Saved as a plain attribute, i.e. the same file format as SingleValueNumericAttribute.
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    const uint32_t mappedDocs = std::min(numDocs, _mappedDocs);
+    const size_t size = numDocs * sizeof(T);
+    auto buf = std::make_unique<IAttributeFileWriter::BufferBuf>(size, 4096);
+    char *values = buf->getFree();
+    if (mappedDocs > 0) {
+        memcpy(values, _mapped, mappedDocs * sizeof(T));
+    }
+    if (numDocs > mappedDocs) {
+        memcpy(values + mappedDocs * sizeof(T), &_tail[0], (numDocs - mappedDocs) * sizeof(T));
+    }
+    buf->moveFreeToData(size);
+    return std::make_unique<SingleValueNumericAttributeSaver>(this->createAttributeHeader(fileName), std::move(buf));
+}
+
+template <typename B>
+template <typename M>
+bool SingleValueMappedNumericAttribute<B>::SingleSearchContext<M>::valid() const { return M::isValid(); }
+
+template <typename B>
+template <typename M>
+SingleValueMappedNumericAttribute<B>::SingleSearchContext<M>::SingleSearchContext(QueryTermSimple::UP qTerm,
+                                                                                  const NumericAttribute & toBeSearched) :
+    M(*qTerm, true),
+    AttributeVector::SearchContext(toBeSearched),
+    _mapped(static_cast<const SingleValueMappedNumericAttribute<B> &>(toBeSearched)._mapped),
+    _mappedDocs(static_cast<const SingleValueMappedNumericAttribute<B> &>(toBeSearched)._mappedDocs),
+    _tail(&static_cast<const SingleValueMappedNumericAttribute<B> &>(toBeSearched)._tail[0])
+{ }
+
+template <typename B>
+template <typename M>
+Int64Range
+SingleValueMappedNumericAttribute<B>::SingleSearchContext<M>::getAsIntegerTerm() const {
+    return M::getRange();
+}
+
+template <typename B>
+template <typename M>
+std::unique_ptr<queryeval::SearchIterator>
+SingleValueMappedNumericAttribute<B>::SingleSearchContext<M>::
+createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
+{
+    if (!valid()) {
+        return std::make_unique<queryeval::EmptySearch>();
+    }
+    if (getIsFilter()) {
+        return strict
+                 ? std::make_unique<FilterAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+                 : std::make_unique<FilterAttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
+    }
+    return strict
+             ? std::make_unique<AttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
+             : std::make_unique<AttributeIteratorT<SingleSearchContext<M>>>(*this, matchData);
+}
+
+}
@@ -4,6 +4,7 @@
 
 #include "integerbase.h"
 #include "floatbase.h"
+#include "min_max_block_index.h"
 #include <vespa/vespalib/util/rcuvector.h>
 #include <limits>
 
@@ -26,6 +27,7 @@ private:
     using B::getGenerationHolder;
 
     DataVector _data;
+    attribute::MinMaxBlockIndex<T> _minMax;
 
     T getFromEnum(EnumHandle e) const override {
         (void) e;
@@ -40,6 +42,9 @@ private:
     {
     private:
         const T * _data;
+        const attribute::MinMaxBlockIndex<T> & _minMax;
+        uint32_t _numBlocks;
+        bool _canSkipBlocks;
 
         int32_t onFind(DocId docId, int32_t elemId, int32_t & weight) const override {
             return find(docId, elemId, weight);
@@ -66,6 +71,22 @@ private:
             return this->match(v) ? 0 : -1;
         }
 
+        /**
+         * Return the first lid >= docId in a block where a value may match.
+         */
+        uint32_t skipToCandidate(uint32_t docId) const {
+            uint32_t blockId = docId >> attribute::MinMaxBlockIndexBase::BLOCK_SHIFT;
+            if (blockId < _numBlocks && this->overlaps(_minMax.getMin(blockId), _minMax.getMax(blockId))) {
+                return docId;
+            }
+            for (++blockId; blockId < _numBlocks; ++blockId) {
+                if (this->overlaps(_minMax.getMin(blockId), _minMax.getMax(blockId))) {
+                    break;
+                }
+            }
+            return blockId << attribute::MinMaxBlockIndexBase::BLOCK_SHIFT;
+        }
+
         Int64Range getAsIntegerTerm() const override;
 
         std::unique_ptr<queryeval::SearchIterator>
@@ -109,6 +130,7 @@ public:
     getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
 
     void set(DocId doc, T v) {
+        _minMax.update(doc, _data[doc], v);
         _data[doc] = v;
     }
 
@@ -116,6 +138,11 @@ public:
         return _data[doc];
     }
 
+    /// Direct access to the value array, valid while holding a guard on this attribute.
+    const T * getFastPtr() const {
+        return &_data[0];
+    }
+
     //-------------------------------------------------------------------------
     // new read api
     //-------------------------------------------------------------------------
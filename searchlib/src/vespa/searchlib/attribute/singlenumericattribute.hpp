@@ -19,7 +19,8 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
+          getGenerationHolder()),
+    _minMax(getGenerationHolder())
 { }
 
 template <typename B>
@@ -40,15 +41,16 @@ SingleValueNumericAttribute<B>::onCommit()
         for (const auto & change : this->_changes) {
             if (change._type == ChangeBase::UPDATE) {
                 std::atomic_thread_fence(std::memory_order_release);
-                _data[change._doc] = change._data;
+                set(change._doc, change._data);
             } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
                 std::atomic_thread_fence(std::memory_order_release);
-                _data[change._doc] = this->applyArithmetic(_data[change._doc], change);
+                set(change._doc, this->applyArithmetic(_data[change._doc], change));
             } else if (change._type == ChangeBase::CLEARDOC) {
                 std::atomic_thread_fence(std::memory_order_release);
-                _data[change._doc] = this->_defaultValue._data;
+                set(change._doc, this->_defaultValue._data);
             }
         }
+        _minMax.tighten(B::getNumDocs(), [this](DocId doc) { return _data[doc]; });
     }
 
     std::atomic_thread_fence(std::memory_order_release);
@@ -62,6 +64,7 @@ void
 SingleValueNumericAttribute<B>::onUpdateStat()
 {
     vespalib::MemoryUsage usage = _data.getMemoryUsage();
+    usage.merge(_minMax.getMemoryUsage());
     usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
     usage.merge(this->getChangeVectorMemoryUsage());
     this->updateStatistics(_data.size(), _data.size(),
@@ -72,13 +75,16 @@ template <typename B>
 void
 SingleValueNumericAttribute<B>::onAddDocs(DocId lidLimit) {
     _data.reserve(lidLimit);
+    _minMax.reserve(lidLimit);
 }
 
 template <typename B>
 bool
 SingleValueNumericAttribute<B>::addDoc(DocId & doc) {
-    bool incGen = _data.isFull();
+    bool newBlock = (B::getNumDocs() & attribute::MinMaxBlockIndexBase::BLOCK_MASK) == 0;
+    bool incGen = _data.isFull() || (newBlock && _minMax.isFull());
     _data.push_back(attribute::getUndefined<T>());
+    _minMax.addDoc(B::getNumDocs());
     std::atomic_thread_fence(std::memory_order_release);
     B::incNumDocs();
     doc = B::getNumDocs() - 1;
@@ -120,6 +126,7 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
                                    udatBuffer->size() / sizeof(T));
     attribute::loadFromEnumeratedSingleValue(_data, getGenerationHolder(), attrReader,
                                              map, attribute::NoSaveLoadedEnum());
+    _minMax.rebuild(numDocs, [this](DocId doc) { return _data[doc]; });
     return true;
 }
 
@@ -146,6 +153,7 @@ SingleValueNumericAttribute<B>::onLoad()
     for (uint32_t i = 0; i < sz; ++i) {
         _data.push_back(attrReader.getNextData());
     }
+    _minMax.rebuild(sz, [this](DocId doc) { return _data[doc]; });
 
     B::setNumDocs(sz);
     B::setCommittedDocIdLimit(sz);
@@ -193,6 +201,7 @@ SingleValueNumericAttribute<B>::onShrinkLidSpace()
     uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
     assert(_data.size() >= committedDocIdLimit);
     _data.shrink(committedDocIdLimit);
+    _minMax.shrink(committedDocIdLimit);
     this->setNumDocs(committedDocIdLimit);
 }
 
@@ -216,7 +225,12 @@ SingleValueNumericAttribute<B>::SingleSearchContext<M>::SingleSearchContext(Quer
                                                                             const NumericAttribute & toBeSearched) :
     M(*qTerm, true),
     AttributeVector::SearchContext(toBeSearched),
-    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0])
+    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0]),
+    _minMax(static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._minMax),
+    _numBlocks((toBeSearched.getCommittedDocIdLimit() + attribute::MinMaxBlockIndexBase::BLOCK_MASK) >>
+               attribute::MinMaxBlockIndexBase::BLOCK_SHIFT),
+    // Blocks are skipped based on the defined values only.
+    _canSkipBlocks(!this->match(attribute::getUndefined<T>()))
 { }
 
 
@@ -236,6 +250,12 @@ createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
     if (!valid()) {
         return std::make_unique<queryeval::EmptySearch>();
     }
+    if (strict && _canSkipBlocks) {
+        if (getIsFilter()) {
+            return std::make_unique<BlockSkippingFilterAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData);
+        }
+        return std::make_unique<BlockSkippingAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData);
+    }
     if (getIsFilter()) {
         return strict
                  ? std::make_unique<FilterAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
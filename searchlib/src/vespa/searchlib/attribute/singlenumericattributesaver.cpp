@@ -31,6 +31,13 @@ SingleValueNumericAttributeSaver(const attribute::AttributeHeader &header,
 }
 
 
+SingleValueNumericAttributeSaver::
+SingleValueNumericAttributeSaver(const attribute::AttributeHeader &header, Buffer buf)
+  : AttributeSaver(vespalib::GenerationHandler::Guard(), header),
+    _buf(std::move(buf))
+{
+}
+
 SingleValueNumericAttributeSaver::~SingleValueNumericAttributeSaver() = default;
 
 
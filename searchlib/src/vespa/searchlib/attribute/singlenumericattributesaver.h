@@ -24,6 +24,7 @@ private:
 public:
     SingleValueNumericAttributeSaver(const attribute::AttributeHeader &header,
                                      const void *data, size_t size);
+    SingleValueNumericAttributeSaver(const attribute::AttributeHeader &header, Buffer buf);
 
     ~SingleValueNumericAttributeSaver() override;
 };
@@ -9,6 +9,9 @@
 #include <vespa/searchlib/util/fileutil.hpp>
 #include <vespa/vespalib/locale/c.h>
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/regexp.h>
+#include <algorithm>
+#include <cctype>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.attribute.stringbase");
@@ -229,11 +232,40 @@ StringAttribute::StringSearchContext::StringSearchContext(QueryTermSimple::UP qT
     _termUCS4(queryTerm()->getUCS4Term()),
     _bufferLen(toBeSearched.getMaxValueCount()),
     _buffer(nullptr),
-    _regex()
+    _regex(),
+    _regexLiteral()
 {
     if (isRegex()) {
         _regex = vespalib::Regex::from_pattern(_queryTerm->getTerm(), vespalib::Regex::Options::IgnoreCase);
+        vespalib::string literal = vespalib::RegexpUtil::get_required_literal(_queryTerm->getTerm());
+        bool ascii = std::all_of(literal.begin(), literal.end(), [](char c) { return (static_cast<unsigned char>(c) < 0x80); });
+        if (ascii) {
+            for (char c : literal) {
+                _regexLiteral.push_back(std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+    }
+}
+
+bool
+StringAttribute::StringSearchContext::containsLiteral(std::string_view src) const
+{
+    const size_t len = _regexLiteral.size();
+    const char first = _regexLiteral[0];
+    for (size_t pos = 0; pos + len <= src.size(); ++pos) {
+        if (std::tolower(static_cast<unsigned char>(src[pos])) != first) {
+            continue;
+        }
+        size_t i = 1;
+        while ((i < len) && (std::tolower(static_cast<unsigned char>(src[pos + i])) == _regexLiteral[i])) {
+            ++i;
+        }
+        if (i == len) {
+            return true;
+        }
     }
+    // Case folding in the regex engine is unicode aware, e.g. KELVIN SIGN matches 'k'.
+    return std::any_of(src.begin(), src.end(), [](char c) { return (static_cast<unsigned char>(c) >= 0x80); });
 }
 
 StringAttribute::StringSearchContext::~StringSearchContext()
@@ -104,7 +104,7 @@ protected:
         const QueryTermUCS4 * queryTerm() const override;
         bool isMatch(const char *src) const {
             if (__builtin_expect(isRegex(), false)) {
-                return _regex ? _regex->partial_match(std::string_view(src)) : false;
+                return isRegexMatch(std::string_view(src));
             }
             vespalib::Utf8ReaderForZTS u8reader(src);
             uint32_t j = 0;
@@ -164,7 +164,17 @@ protected:
         QueryTermSimpleUP         _queryTerm;
         std::vector<ucs4_t>       _termUCS4;
         const std::optional<vespalib::Regex>& getRegex() const { return _regex; }
+        bool isRegexMatch(std::string_view src) const {
+            if ( ! _regex) {
+                return false;
+            }
+            if ( ! _regexLiteral.empty() && ! containsLiteral(src)) {
+                return false;
+            }
+            return _regex->partial_match(src);
+        }
     private:
+        bool containsLiteral(std::string_view src) const;
         WeightedConstChar * getBuffer() const {
             if (_buffer == nullptr) {
                 _buffer = new WeightedConstChar[_bufferLen];
@@ -174,6 +184,8 @@ protected:
         unsigned                       _bufferLen;
         mutable WeightedConstChar *    _buffer;
         std::optional<vespalib::Regex> _regex;
+        // Lowercased ASCII literal required by the regex, checked before running it.
+        vespalib::string               _regexLiteral;
     };
 private:
     SearchContext::UP getSearch(QueryTermSimpleUP term, const attribute::SearchContextParams & params) const override;
@@ -338,6 +338,9 @@ unpackFeatures(const search::fef::TermFieldMatchDataArray &matchData,
                                       K_VALUE_POSOCC_NUMPOSITIONS,
                                       EC);
         uint32_t numPositions = static_cast<uint32_t>(val64) + 1;
+        if (numPositions > 1) {
+            tfmd->reservePositions(tfmd->size() + numPositions);
+        }
 
         UC64_DECODEEXPGOLOMB_SMALL_NS(o,
                                       K_VALUE_POSOCC_FIRST_WORDPOS,
@@ -826,6 +829,9 @@ unpackFeatures(const search::fef::TermFieldMatchDataArray &matchData,
                                       K_VALUE_POSOCC_NUMPOSITIONS,
                                       EC);
         uint32_t numPositions = static_cast<uint32_t>(val64) + 1;
+        if (numPositions > 1) {
+            tfmd->reservePositions(tfmd->size() + numPositions);
+        }
 
         uint32_t wordPosK = EGPosOccEncodeContext<bigEndian>::
                             calcWordPosK(numPositions, elementLen);
@@ -55,6 +55,30 @@ BitVectorCache::computeCountVector(KeySet & keys, CountVector & v) const
     }
 }
 
+void
+BitVectorCache::andHitsInto(const KeySet & keys, BitVector & result) const
+{
+    std::vector<CondensedBitVector::KeySet> keySets;
+    ChunkV chunks;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        keySets.resize(_chunks.size());
+        for (Key k : keys) {
+            auto found = _keys.find(k);
+            if ((found != _keys.end()) && found->second.isCached()) {
+                const KeyMeta & m = found->second;
+                keySets[m.chunkId()].insert(m.chunkIndex());
+            }
+        }
+        chunks = _chunks;
+    }
+    for (size_t i(0); i < chunks.size(); i++) {
+        if ( ! keySets[i].empty()) {
+            chunks[i]->andHitsInto(keySets[i], result);
+        }
+    }
+}
+
 BitVectorCache::KeySet
 BitVectorCache::lookupCachedSet(const KeyAndCountSet & keys)
 {
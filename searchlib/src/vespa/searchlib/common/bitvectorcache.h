@@ -33,6 +33,12 @@ public:
     BitVectorCache(GenerationHolder &genHolder);
     ~BitVectorCache();
     void computeCountVector(KeySet & keys, CountVector & v) const;
+    /**
+     * Clears the bits in result for documents not matching all the given keys,
+     * one pass per chunk. Keys that are not cached are ignored, so callers should
+     * restrict keys to the set returned by lookupCachedSet.
+     */
+    void andHitsInto(const KeySet & keys, BitVector & result) const;
     KeySet lookupCachedSet(const KeyAndCountSet & keys);
     void set(Key key, uint32_t index, bool v);
     bool get(Key key, uint32_t index) const;
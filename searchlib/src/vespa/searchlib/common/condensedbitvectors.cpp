@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "condensedbitvectors.h"
+#include "bitvector.h"
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/rcuvector.h>
 
@@ -50,6 +51,17 @@ private:
        computeCountVector(computeMask(keys), cv, S());
     }
 
+    void andHitsInto(const KeySet & keys, BitVector & result) const override {
+        const T mask(computeMask(keys));
+        const uint32_t limit(std::min(_v.size(), size_t(result.size())));
+        result.foreach_truebit([&](uint32_t docId) {
+            if ((docId >= limit) || ((_v[docId] & mask) != mask)) {
+                result.clearBit(docId);
+            }
+        });
+        result.invalidateCachedCount();
+    }
+
     void clearIndex(uint32_t index) override {
         _v[index] = 0;
     }
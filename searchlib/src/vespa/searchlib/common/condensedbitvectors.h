@@ -8,6 +8,8 @@
 
 namespace search {
 
+class BitVector;
+
 class CondensedBitVector
 {
 public:
@@ -21,6 +23,11 @@ public:
 
     virtual void initializeCountVector(const KeySet & keys, CountVector & v) const = 0;
     virtual void addCountVector(const KeySet & keys, CountVector & v) const = 0;
+    /**
+     * Clears the bits in result for documents that do not have all the given keys set.
+     * Only the bits already set in result are visited.
+     */
+    virtual void andHitsInto(const KeySet & keys, BitVector & result) const = 0;
     virtual void set(Key key, uint32_t index, bool v) = 0;
     virtual bool get(Key key, uint32_t index) const = 0;
     virtual void clearIndex(uint32_t index) = 0;
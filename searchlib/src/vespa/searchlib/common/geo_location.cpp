@@ -1,6 +1,7 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "geo_location.h"
+#include <algorithm>
 
 using vespalib::geo::ZCurve;
 
@@ -54,6 +55,32 @@ adjust_bounding_box(GeoLocation::Box orig, GeoLocation::Point point, uint32_t ra
                             GeoLocation::Range{min_y, max_y}};
 }
 
+GeoLocation::Box
+inner_box(GeoLocation::Box outer, bool has_point, GeoLocation::Point point, uint32_t radius, GeoLocation::Aspect x_aspect)
+{
+    if (!has_point || radius == GeoLocation::radius_inf) {
+        // no radius; the bounding box is the full limit
+        return outer;
+    }
+    // largest half side of a square inside the circle: 2 * half * half <= radius * radius
+    uint64_t sq_radius = uint64_t(radius) * uint64_t(radius);
+    uint64_t half = static_cast<uint64_t>(radius * 0.70710678118654752440);
+    while (2 * half * half > sq_radius) {
+        --half;
+    }
+    uint64_t half_dx = half;
+    if (x_aspect.active()) {
+        // largest dx with (dx * x_aspect) <= half
+        half_dx = std::min((half << 32) / x_aspect.multiplier, uint64_t(0xffffffffu));
+    }
+    int32_t min_x = std::max(int64_t(outer.x.low), int64_t(point.x) - int64_t(half_dx));
+    int32_t max_x = std::min(int64_t(outer.x.high), int64_t(point.x) + int64_t(half_dx));
+    int32_t min_y = std::max(int64_t(outer.y.low), int64_t(point.y) - int64_t(half));
+    int32_t max_y = std::min(int64_t(outer.y.high), int64_t(point.y) + int64_t(half));
+    return GeoLocation::Box{GeoLocation::Range{min_x, max_x},
+                            GeoLocation::Range{min_y, max_y}};
+}
+
 } // namespace <unnamed>
 
 GeoLocation::GeoLocation()
@@ -63,7 +90,8 @@ GeoLocation::GeoLocation()
     x_aspect(),
     bounding_box(no_box),
     _sq_radius(sq_radius_inf),
-    _z_bounding_box(to_z(no_box))
+    _z_bounding_box(to_z(no_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Point p)
@@ -73,7 +101,8 @@ GeoLocation::GeoLocation(Point p)
     x_aspect(),
     bounding_box(no_box),
     _sq_radius(sq_radius_inf),
-    _z_bounding_box(to_z(no_box))
+    _z_bounding_box(to_z(no_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Point p, Aspect xa)
@@ -83,7 +112,8 @@ GeoLocation::GeoLocation(Point p, Aspect xa)
     x_aspect(xa),
     bounding_box(no_box),
     _sq_radius(sq_radius_inf),
-    _z_bounding_box(to_z(no_box))
+    _z_bounding_box(to_z(no_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Point p, uint32_t r)
@@ -93,7 +123,8 @@ GeoLocation::GeoLocation(Point p, uint32_t r)
     x_aspect(),
     bounding_box(adjust_bounding_box(no_box, p, r, Aspect())),
     _sq_radius(uint64_t(r) * uint64_t(r)),
-    _z_bounding_box(to_z(bounding_box))
+    _z_bounding_box(to_z(bounding_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Point p, uint32_t r, Aspect xa)
@@ -103,7 +134,8 @@ GeoLocation::GeoLocation(Point p, uint32_t r, Aspect xa)
     x_aspect(xa),
     bounding_box(adjust_bounding_box(no_box, p, r, xa)),
     _sq_radius(uint64_t(r) * uint64_t(r)),
-    _z_bounding_box(to_z(bounding_box))
+    _z_bounding_box(to_z(bounding_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Box b)
@@ -113,7 +145,8 @@ GeoLocation::GeoLocation(Box b)
     x_aspect(),
     bounding_box(b),
     _sq_radius(sq_radius_inf),
-    _z_bounding_box(to_z(bounding_box))
+    _z_bounding_box(to_z(bounding_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Box b, Point p)
@@ -123,7 +156,8 @@ GeoLocation::GeoLocation(Box b, Point p)
     x_aspect(),
     bounding_box(b),
     _sq_radius(sq_radius_inf),
-    _z_bounding_box(to_z(bounding_box))
+    _z_bounding_box(to_z(bounding_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Box b, Point p, Aspect xa)
@@ -133,7 +167,8 @@ GeoLocation::GeoLocation(Box b, Point p, Aspect xa)
     x_aspect(xa),
     bounding_box(b),
     _sq_radius(sq_radius_inf),
-    _z_bounding_box(to_z(bounding_box))
+    _z_bounding_box(to_z(bounding_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Box b, Point p, uint32_t r)
@@ -143,7 +178,8 @@ GeoLocation::GeoLocation(Box b, Point p, uint32_t r)
     x_aspect(),
     bounding_box(adjust_bounding_box(b, p, r, Aspect())),
     _sq_radius(uint64_t(r) * uint64_t(r)),
-    _z_bounding_box(to_z(bounding_box))
+    _z_bounding_box(to_z(bounding_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 GeoLocation::GeoLocation(Box b, Point p, uint32_t r, Aspect xa)
@@ -153,7 +189,8 @@ GeoLocation::GeoLocation(Box b, Point p, uint32_t r, Aspect xa)
     x_aspect(xa),
     bounding_box(adjust_bounding_box(b, p, r, xa)),
     _sq_radius(uint64_t(r) * uint64_t(r)),
-    _z_bounding_box(to_z(bounding_box))
+    _z_bounding_box(to_z(bounding_box)),
+    _z_inner_box(to_z(inner_box(bounding_box, has_point, point, radius, x_aspect)))
 {}
 
 uint64_t GeoLocation::sq_distance_to(Point p) const {
@@ -76,6 +76,8 @@ struct GeoLocation
 
     bool inside_limit(int64_t zcurve_encoded_xy) const {
         if (_z_bounding_box.getzFailBoundingBoxTest(zcurve_encoded_xy)) return false;
+        // cheap accept for points inside a box contained in the limit, avoids decoding
+        if (!_z_inner_box.getzFailBoundingBoxTest(zcurve_encoded_xy)) return true;
         int32_t x = 0;
         int32_t y = 0;
         vespalib::geo::ZCurve::decode(zcurve_encoded_xy, &x, &y);
@@ -87,6 +89,8 @@ private:
     static constexpr uint64_t sq_radius_inf = std::numeric_limits<uint64_t>::max();
     const uint64_t _sq_radius;
     const vespalib::geo::ZCurve::BoundingBox _z_bounding_box;
+    // box where all points are inside the limit (square inscribed in the circle, clipped to bounding_box)
+    const vespalib::geo::ZCurve::BoundingBox _z_inner_box;
 };
 
 } // namespace
@@ -7,6 +7,7 @@
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/document/base/globalid.h>
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.attribute.sortresults");
@@ -241,6 +242,17 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
 
     _sortDataArray.resize(n);
 
+    // Converting a string to a collation key is expensive. Documents sharing a
+    // value share the enum handle, so the blob is converted once per value and
+    // copied from its first occurrence.
+    std::vector<ConvertedBlobMap> converted(_vectors.size());
+    std::vector<bool> cacheConverted(_vectors.size(), false);
+    for (size_t v(0); v < _vectors.size(); ++v) {
+        const VectorRef & ref = _vectors[v];
+        cacheConverted[v] = (ref._type < ASC_RANK) && (ref._converter != nullptr) &&
+                            ref._vector->hasEnum() && ! ref._vector->hasMultiValue();
+    }
+
     document::GlobalId gid;
     for (uint32_t i(0), idx(0); (i < n) && !_doom.hard_doom(); ++i) {
         uint32_t len = 0;
@@ -249,6 +261,23 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
             if (available < std::max(sizeof(hits->_docId) + sizeof(_partitionId), sizeof(hits->_rankValue))) {
                 mySortData = realloc(n, variableWidth, available, dataSize, mySortData);
             }
+            const size_t vectorIdx(iter - _vectors.begin());
+            IAttributeVector::EnumHandle enumHandle(0);
+            if (cacheConverted[vectorIdx]) {
+                enumHandle = iter->_vector->getEnum(hits[i].getDocId());
+                auto cached = converted[vectorIdx].find(enumHandle);
+                if (cached != converted[vectorIdx].end()) {
+                    while (available < cached->second.second) {
+                        mySortData = realloc(n, variableWidth, available, dataSize, mySortData);
+                    }
+                    memcpy(mySortData, &_binarySortData[0] + cached->second.first, cached->second.second);
+                    written = cached->second.second;
+                    available -= written;
+                    mySortData += written;
+                    len += written;
+                    continue;
+                }
+            }
             do {
                 switch (iter->_type) {
                 case ASC_DOCID:
@@ -280,6 +309,9 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
                     mySortData = realloc(n, variableWidth, available, dataSize, mySortData);
                 }
             } while(written == -1);
+            if (cacheConverted[vectorIdx]) {
+                converted[vectorIdx][enumHandle] = std::make_pair(uint32_t(mySortData - &_binarySortData[0]), uint32_t(written));
+            }
             available -= written;
             mySortData += written;
             len += written;
@@ -8,6 +8,7 @@
 #include <vector>
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 #define INSERT_SORT_LEVEL 80
 
@@ -60,6 +61,15 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Sorts hits on a sort spec by serializing the sort keys of each hit
+ * into a memcmp-comparable blob and sorting the blobs. The default
+ * method (2) is an MSD radix sort on the blobs that stops descending
+ * into buckets once the requested top-n hits are in order. Each match
+ * thread owns its own sort spec and sorts only its own hits, so blob
+ * generation and sorting already run in parallel across match threads
+ * before the per-thread results are merged.
+ **/
 class FastS_SortSpec : public FastS_IResultSorter
 {
 private:
@@ -97,6 +107,7 @@ private:
     typedef std::vector<VectorRef> VectorRefList;
     typedef vespalib::Array<uint8_t> BinarySortData;
     typedef vespalib::Array<SortData> SortDataArray;
+    using ConvertedBlobMap = vespalib::hash_map<uint32_t, std::pair<uint32_t, uint32_t>>;
     using ConverterFactory = search::common::ConverterFactory;
     uint16_t                 _partitionId;
     vespalib::Doom           _doom;
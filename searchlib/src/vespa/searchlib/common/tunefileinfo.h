@@ -2,10 +2,13 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/compressionconfig.h>
 #include <memory>
 
 namespace search {
 
+class WriteThrottle;
+
 class TuneFileSeqRead
 {
 public:
@@ -197,15 +200,19 @@ class TuneFileAttributes
 {
 public:
     TuneFileSeqWrite _write;
+    // Compression of the blocks of attribute files written to disk. NONE writes the files uncompressed.
+    vespalib::compression::CompressionConfig _compression;
+    // Shared by all attribute flushes. Not part of the tuning compared below.
+    std::shared_ptr<WriteThrottle> _throttle;
 
-    TuneFileAttributes() noexcept : _write() { }
+    TuneFileAttributes() noexcept : _write(), _compression(), _throttle() { }
 
     bool operator==(const TuneFileAttributes &rhs) const {
-        return _write == rhs._write;
+        return _write == rhs._write && _compression == rhs._compression;
     }
 
     bool operator!=(const TuneFileAttributes &rhs) const {
-        return _write != rhs._write;
+        return !(*this == rhs);
     }
 };
 
@@ -0,0 +1,88 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "write_throttle.h"
+#include <thread>
+
+namespace search {
+
+WriteThrottle::WriteThrottle(size_t maxBytesPerSecond)
+    : _lock(),
+      _maxBytesPerSecond(maxBytesPerSecond),
+      _backoffLoadLimit(0.0),
+      _backoffFactor(1.0),
+      _inBackoff(false),
+      _nextFree()
+{
+}
+
+WriteThrottle::~WriteThrottle() = default;
+
+double
+WriteThrottle::bytesPerSecond(const std::lock_guard<std::mutex> &) const
+{
+    return _inBackoff ? (_maxBytesPerSecond * _backoffFactor) : _maxBytesPerSecond;
+}
+
+void
+WriteThrottle::acquire(size_t bytes)
+{
+    vespalib::steady_time start;
+    {
+        std::lock_guard guard(_lock);
+        double rate = bytesPerSecond(guard);
+        if (_maxBytesPerSecond == 0 || rate <= 0.0) {
+            return;
+        }
+        start = std::max(vespalib::steady_clock::now(), _nextFree);
+        _nextFree = start + vespalib::from_s(double(bytes) / rate);
+    }
+    std::this_thread::sleep_until(start);
+}
+
+void
+WriteThrottle::setMaxBytesPerSecond(size_t maxBytesPerSecond)
+{
+    std::lock_guard guard(_lock);
+    _maxBytesPerSecond = maxBytesPerSecond;
+}
+
+size_t
+WriteThrottle::getMaxBytesPerSecond() const
+{
+    std::lock_guard guard(_lock);
+    return _maxBytesPerSecond;
+}
+
+void
+WriteThrottle::setBackoff(double loadLimit, double factor)
+{
+    std::lock_guard guard(_lock);
+    _backoffLoadLimit = loadLimit;
+    _backoffFactor = factor;
+    if (loadLimit <= 0.0) {
+        _inBackoff = false;
+    }
+}
+
+void
+WriteThrottle::reportLoad(double load)
+{
+    std::lock_guard guard(_lock);
+    _inBackoff = (_backoffLoadLimit > 0.0) && (load >= _backoffLoadLimit);
+}
+
+bool
+WriteThrottle::inBackoff() const
+{
+    std::lock_guard guard(_lock);
+    return _inBackoff;
+}
+
+double
+WriteThrottle::getBytesPerSecond() const
+{
+    std::lock_guard guard(_lock);
+    return bytesPerSecond(guard);
+}
+
+}
@@ -0,0 +1,48 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <mutex>
+
+namespace search {
+
+/**
+ * Limits the rate at which data is written to disk. It is shared by all
+ * concurrent writers (e.g. attribute flushes), so their total rate is
+ * bounded. A rate of 0 means unlimited.
+ *
+ * While the reported foreground load (e.g. the number of queued queries)
+ * is at or above the backoff load limit, the rate is multiplied by the
+ * backoff factor to leave disk bandwidth to foreground reads.
+ */
+class WriteThrottle
+{
+public:
+    explicit WriteThrottle(size_t maxBytesPerSecond);
+    ~WriteThrottle();
+    /**
+     * Blocks until the given number of bytes can be written without exceeding the rate.
+     */
+    void acquire(size_t bytes);
+    void setMaxBytesPerSecond(size_t maxBytesPerSecond);
+    size_t getMaxBytesPerSecond() const;
+    /**
+     * A load limit of 0 disables backoff.
+     */
+    void setBackoff(double loadLimit, double factor);
+    void reportLoad(double load);
+    bool inBackoff() const;
+    double getBytesPerSecond() const;
+private:
+    double bytesPerSecond(const std::lock_guard<std::mutex> &guard) const;
+
+    mutable std::mutex    _lock;
+    size_t                _maxBytesPerSecond;
+    double                _backoffLoadLimit;
+    double                _backoffFactor;
+    bool                  _inBackoff;
+    vespalib::steady_time _nextFree;
+};
+
+}
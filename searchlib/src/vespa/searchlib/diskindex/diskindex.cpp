@@ -46,7 +46,27 @@ DiskIndex::Key::Key(const Key &) = default;
 DiskIndex::Key & DiskIndex::Key::operator = (const Key &) = default;
 DiskIndex::Key::~Key() = default;
 
-DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize)
+namespace {
+
+// Max number of words tracked as candidates for admission to the posting list cache
+constexpr size_t maxAdmissionCandidates = 64 * 1024;
+
+}
+
+size_t
+DiskIndex::PostingListCacheEntrySize::operator() (const PostingListCacheEntry & entry) const
+{
+    size_t size = 0;
+    if (entry.postingList) {
+        size += sizeof(PostingListHandle) + entry.postingList->_allocSize;
+    }
+    if (entry.bitVector) {
+        size += sizeof(BitVector) + entry.bitVector->getFileBytes();
+    }
+    return size;
+}
+
+DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize, size_t postingListCacheSize)
     : _indexDir(indexDir),
       _cacheSize(cacheSize),
       _schema(),
@@ -55,6 +75,11 @@ DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize)
       _dicts(),
       _tuneFileSearch(),
       _cache(*this, cacheSize),
+      _postingListCacheSize(postingListCacheSize),
+      _postingListCache(*this, postingListCacheSize),
+      _admissionLock(),
+      _admissionCandidates(),
+      _postingListCacheBypassed(0),
       _size(0)
 {
     calculateSize();
@@ -310,6 +335,104 @@ DiskIndex::readPostingList(const LookupResult &lookupRes) const
     return handle;
 }
 
+bool
+DiskIndex::read(const PostingListCacheKey & key, PostingListCacheEntry & result)
+{
+    result = readPostingListCacheEntry(key);
+    return true;
+}
+
+DiskIndex::PostingListCacheEntry
+DiskIndex::readPostingListCacheEntry(const PostingListCacheKey &key) const
+{
+    PostingListCacheEntry result;
+    if (key.bitVector) {
+        result.bitVector = readBitVector(key.lookup);
+    } else {
+        result.postingList = readPostingList(key.lookup);
+    }
+    return result;
+}
+
+bool
+DiskIndex::admitToPostingListCache(const PostingListCacheKey &key) const
+{
+    if (_postingListCache.hasKey(key)) {
+        return true;
+    }
+    uint64_t candidate = (key.lookup.wordNum << 16) + (static_cast<uint64_t>(key.lookup.indexId) << 1) + (key.bitVector ? 1 : 0);
+    std::lock_guard guard(_admissionLock);
+    if (_admissionCandidates.find(candidate) != _admissionCandidates.end()) {
+        _admissionCandidates.erase(candidate);
+        return true;
+    }
+    if (_admissionCandidates.size() >= maxAdmissionCandidates) {
+        _admissionCandidates.clear();
+    }
+    _admissionCandidates.insert(candidate);
+    return false;
+}
+
+DiskIndex::PostingListCacheEntry
+DiskIndex::readFromPostingListCache(const PostingListCacheKey &key) const
+{
+    if (admitToPostingListCache(key)) {
+        return _postingListCache.read(key);
+    }
+    _postingListCacheBypassed.fetch_add(1, std::memory_order_relaxed);
+    return readPostingListCacheEntry(key);
+}
+
+std::shared_ptr<const index::PostingListHandle>
+DiskIndex::getPostingList(const LookupResult &lookupRes) const
+{
+    if (_postingListCacheSize == 0) {
+        return readPostingList(lookupRes);
+    }
+    SchemaUtil::IndexIterator it(_schema, lookupRes.indexId);
+    const DiskPostingFile *file = _postingFiles[it.getIndex()].get();
+    if (file == nullptr || file->getMemoryMapped()) {
+        // Nothing to save by caching posting lists in memory mapped files
+        return readPostingList(lookupRes);
+    }
+    return readFromPostingListCache(PostingListCacheKey(lookupRes, false)).postingList;
+}
+
+std::shared_ptr<const BitVector>
+DiskIndex::getBitVector(const LookupResult &lookupRes) const
+{
+    if (_postingListCacheSize == 0) {
+        return readBitVector(lookupRes);
+    }
+    return readFromPostingListCache(PostingListCacheKey(lookupRes, true)).bitVector;
+}
+
+CacheStats
+DiskIndex::getPostingListCacheStats() const
+{
+    return CacheStats(_postingListCache.getHit(),
+                      _postingListCache.getMiss() + _postingListCacheBypassed.load(std::memory_order_relaxed),
+                      _postingListCache.size(),
+                      _postingListCache.sizeBytes(),
+                      _postingListCache.getInvalidate());
+}
+
+void
+DiskIndex::prefetchPostingList(const LookupResult &lookupRes) const
+{
+    PostingListHandle handle;
+    handle._bitOffset = lookupRes.bitOffset;
+    handle._bitLength = lookupRes.counts._bitLength;
+    SchemaUtil::IndexIterator it(_schema, lookupRes.indexId);
+    handle._file = _postingFiles[it.getIndex()].get();
+    if (handle._file == nullptr) {
+        return;
+    }
+    const uint32_t firstSegment = 0;
+    const uint32_t numSegments = 0; // means all segments
+    handle._file->prefetchPostingList(lookupRes.counts, firstSegment, numSegments, handle);
+}
+
 BitVector::UP
 DiskIndex::readBitVector(const LookupResult &lookupRes) const
 {
@@ -6,9 +6,13 @@
 #include "zcposoccrandread.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/index/field_length_info.h>
+#include <vespa/searchlib/docstore/cachestats.h>
 #include <vespa/searchlib/queryeval/searchable.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/stllike/cache.h>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <atomic>
+#include <mutex>
 
 namespace search::diskindex {
 
@@ -65,11 +69,46 @@ public:
         IndexList        _indexes;
     };
 
+    /**
+     * Key for the posting list cache, identifying either the posting list
+     * or the bit vector for a word in a field.
+     */
+    struct PostingListCacheKey {
+        LookupResult lookup;
+        bool         bitVector;
+        PostingListCacheKey() : lookup(), bitVector(false) { }
+        PostingListCacheKey(const LookupResult &lookup_in, bool bitVector_in)
+            : lookup(lookup_in),
+              bitVector(bitVector_in)
+        { }
+        uint32_t hash() const noexcept {
+            return (lookup.indexId * 1000003u) ^ static_cast<uint32_t>(lookup.wordNum * 2u + (bitVector ? 1u : 0u));
+        }
+        bool operator == (const PostingListCacheKey & rhs) const {
+            return (lookup.indexId == rhs.lookup.indexId) &&
+                   (lookup.wordNum == rhs.lookup.wordNum) &&
+                   (bitVector == rhs.bitVector);
+        }
+    };
+
+    struct PostingListCacheEntry {
+        std::shared_ptr<const index::PostingListHandle> postingList;
+        std::shared_ptr<const BitVector>                bitVector;
+    };
+
+    struct PostingListCacheEntrySize {
+        size_t operator() (const PostingListCacheEntry & entry) const;
+    };
+
 private:
     using DiskPostingFile = index::PostingListFileRandRead;
     using DiskPostingFileReal = Zc4PosOccRandRead;
     using DiskPostingFileDynamicKReal = ZcPosOccRandRead;
     using Cache = vespalib::cache<vespalib::CacheParam<vespalib::LruParam<Key, LookupResultVector>, DiskIndex>>;
+    using PostingListCache = vespalib::cache<vespalib::CacheParam<vespalib::LruParam<PostingListCacheKey, PostingListCacheEntry>,
+                                                                  DiskIndex,
+                                                                  vespalib::zero<PostingListCacheKey>,
+                                                                  PostingListCacheEntrySize>>;
 
     vespalib::string                       _indexDir;
     size_t                                 _cacheSize;
@@ -79,12 +118,20 @@ private:
     std::vector<std::unique_ptr<index::DictionaryFileRandRead>> _dicts;
     TuneFileSearch                         _tuneFileSearch;
     Cache                                  _cache;
+    size_t                                 _postingListCacheSize;
+    mutable PostingListCache               _postingListCache;
+    mutable std::mutex                     _admissionLock;
+    mutable vespalib::hash_set<uint64_t>   _admissionCandidates;
+    mutable std::atomic<size_t>            _postingListCacheBypassed;
     uint64_t                               _size;
 
     void calculateSize();
     bool loadSchema();
     bool openDictionaries(const TuneFileSearch &tuneFileSearch);
     bool openField(const vespalib::string &fieldDir, const TuneFileSearch &tuneFileSearch);
+    bool admitToPostingListCache(const PostingListCacheKey &key) const;
+    PostingListCacheEntry readPostingListCacheEntry(const PostingListCacheKey &key) const;
+    PostingListCacheEntry readFromPostingListCache(const PostingListCacheKey &key) const;
 
 public:
     /**
@@ -92,8 +139,9 @@ public:
      *
      * @param indexDir the directory where the disk index is located.
      * @param cacheSize optional size (in bytes) of the disk dictionary lookup cache.
+     * @param postingListCacheSize optional size (in bytes) of the posting list and bit vector cache.
      */
-    explicit DiskIndex(const vespalib::string &indexDir, size_t cacheSize=0);
+    explicit DiskIndex(const vespalib::string &indexDir, size_t cacheSize=0, size_t postingListCacheSize=0);
     ~DiskIndex() override;
 
     /**
@@ -123,6 +171,15 @@ public:
      */
     index::PostingListHandle::UP readPostingList(const LookupResult &lookupRes) const;
 
+    /**
+     * Hint that the posting list corresponding to the given lookup result
+     * will be read soon. Does not block, allowing reads of the posting lists
+     * for several terms to overlap.
+     *
+     * @param lookupRes the result of the previous dictionary lookup.
+     */
+    void prefetchPostingList(const LookupResult &lookupRes) const;
+
     /**
      * Read the bit vector corresponding to the given lookup result.
      *
@@ -132,6 +189,35 @@ public:
      */
     BitVector::UP readBitVector(const LookupResult &lookupRes) const;
 
+    /**
+     * Get the posting list corresponding to the given lookup result,
+     * using the posting list cache if enabled.  Posting lists in memory
+     * mapped files are not cached.
+     *
+     * A word is only admitted to the cache when it has been requested
+     * before, to avoid terms only seen once evicting frequently used ones.
+     *
+     * @param lookupRes the result of the previous dictionary lookup.
+     * @return a handle for the posting list in memory.
+     */
+    std::shared_ptr<const index::PostingListHandle> getPostingList(const LookupResult &lookupRes) const;
+
+    /**
+     * Get the bit vector corresponding to the given lookup result,
+     * using the posting list cache if enabled.
+     *
+     * @param lookupRes the result of the previous dictionary lookup.
+     * @return the bit vector or nullptr if no bit vector exists for the
+     *         word in the lookup result.
+     */
+    std::shared_ptr<const BitVector> getBitVector(const LookupResult &lookupRes) const;
+
+    /**
+     * Get statistics for the posting list cache. Lookups for words not
+     * admitted to the cache are counted as misses.
+     */
+    CacheStats getPostingListCacheStats() const;
+
     queryeval::Blueprint::UP createBlueprint(const queryeval::IRequestContext & requestContext,
                                              const queryeval::FieldSpec &field,
                                              const query::Node &term) override;
@@ -152,6 +238,7 @@ public:
      * Needed for the Cache::BackingStore interface.
      */ 
     bool read(const Key & key, LookupResultVector & result);
+    bool read(const PostingListCacheKey & key, PostingListCacheEntry & result);
     
     index::FieldLengthInfo get_field_length_info(const vespalib::string& field_name) const;
 };
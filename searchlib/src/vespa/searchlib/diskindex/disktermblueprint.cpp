@@ -8,6 +8,8 @@
 #include <vespa/searchlib/queryeval/filter_wrapper.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
+#include <cassert>
+
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.disktermblueprint");
 
@@ -45,11 +47,16 @@ DiskTermBlueprint::DiskTermBlueprint(const FieldSpecBase & field,
     _useBitVector(useBitVector),
     _fetchPostingsDone(false),
     _hasEquivParent(false),
+    _readPostings(false),
+    _readPostingsOnce(),
     _postingHandle(),
     _bitVector()
 {
     setEstimate(HitEstimate(_lookupRes->counts._numDocs,
                             _lookupRes->counts._numDocs == 0));
+    if (_useBitVector) {
+        set_cost(State::COST_CHEAP);
+    }
 }
 
 namespace {
@@ -72,14 +79,25 @@ DiskTermBlueprint::fetchPostings(const queryeval::ExecuteInfo &execInfo)
     (void) execInfo;
     if (!_fetchPostingsDone) {
         _hasEquivParent = areAnyParentsEquiv(getParent());
-        _bitVector = _diskIndex.readBitVector(*_lookupRes);
+        _bitVector = _diskIndex.getBitVector(*_lookupRes);
         if (!_useBitVector || !_bitVector) {
-            _postingHandle = _diskIndex.readPostingList(*_lookupRes);
+            // The posting list is read when the first iterator is created, allowing
+            // the reads for all terms in the query to overlap.
+            _diskIndex.prefetchPostingList(*_lookupRes);
+            _readPostings = true;
         }
     }
     _fetchPostingsDone = true;
 }
 
+const index::PostingListHandle &
+DiskTermBlueprint::getPostingHandle() const
+{
+    assert(_readPostings);
+    std::call_once(_readPostingsOnce, [this]() { _postingHandle = _diskIndex.getPostingList(*_lookupRes); });
+    return *_postingHandle;
+}
+
 SearchIterator::UP
 DiskTermBlueprint::createLeafSearch(const TermFieldMatchDataArray & tfmda, bool strict) const
 {
@@ -88,7 +106,7 @@ DiskTermBlueprint::createLeafSearch(const TermFieldMatchDataArray & tfmda, bool
             getName(_lookupRes->indexId).c_str(), _lookupRes->wordNum, _lookupRes->counts._numDocs);
         return BitVectorIterator::create(_bitVector.get(), *tfmda[0], strict);
     }
-    SearchIterator::UP search(_postingHandle->createIterator(_lookupRes->counts, tfmda, _useBitVector));
+    SearchIterator::UP search(getPostingHandle().createIterator(_lookupRes->counts, tfmda, _useBitVector));
     if (_useBitVector) {
         LOG(debug, "Return BooleanMatchIteratorWrapper: %s, wordNum(%" PRIu64 "), docCount(%" PRIu64 ")",
             getName(_lookupRes->indexId).c_str(), _lookupRes->wordNum, _lookupRes->counts._numDocs);
@@ -107,7 +125,7 @@ DiskTermBlueprint::createFilterSearch(bool strict, FilterConstraint) const
     if (_bitVector) {
         wrapper->wrap(BitVectorIterator::create(_bitVector.get(), *tfmda[0], strict));
     } else {
-        wrapper->wrap(_postingHandle->createIterator(_lookupRes->counts, tfmda, _useBitVector));
+        wrapper->wrap(getPostingHandle().createIterator(_lookupRes->counts, tfmda, _useBitVector));
     }
     return wrapper;
 }
@@ -4,6 +4,7 @@
 
 #include "diskindex.h"
 #include <vespa/searchlib/queryeval/blueprint.h>
+#include <mutex>
 
 namespace search::diskindex {
 
@@ -19,8 +20,12 @@ private:
     bool                             _useBitVector;
     bool                             _fetchPostingsDone;
     bool                             _hasEquivParent;
-    index::PostingListHandle::UP     _postingHandle;
-    BitVector::UP                    _bitVector;
+    bool                             _readPostings;
+    mutable std::once_flag           _readPostingsOnce;
+    mutable std::shared_ptr<const index::PostingListHandle> _postingHandle;
+    std::shared_ptr<const BitVector> _bitVector;
+
+    const index::PostingListHandle &getPostingHandle() const;
 
 public:
     /**
@@ -25,7 +25,18 @@ public:
     bool readDocIdLimit(const vespalib::string &dir);
 };
 
-
+/**
+ * Maps document ids from a fusion input index to the fused index.
+ *
+ * The mapping only filters: a document id is either kept unchanged or
+ * dropped (noDocId()) when the selector assigns the document to another
+ * source. Document ids are never renumbered, since the local document
+ * id is shared with the document meta store, attributes, document store
+ * and transaction log replay. Reordering the postings of a single disk
+ * index (e.g. by static rank) would break that correspondence. Moving a
+ * document to another local document id must go through a move
+ * operation in the feed pipeline, as lid space compaction does.
+ **/
 class DocIdMapper
 {
 public:
@@ -74,7 +74,8 @@ public:
     virtual void read();
     virtual bool allowRawFeatures();
 
-    void write(FieldWriter &writer) {
+    template <class Writer>
+    void write(Writer &writer) {
         if (_wordNum != writer.getSparseWordNum()) {
             writer.newWord(_wordNum, _word);
         }
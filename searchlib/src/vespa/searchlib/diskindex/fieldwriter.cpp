@@ -64,6 +64,8 @@ FieldWriter::open(const vespalib::string &prefix,
     }
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
+        // Block max info for L1 skip entries is derived from interleaved num occs
+        params.set("block_max", true);
     }
     
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
@@ -4,6 +4,7 @@
 #include "fieldreader.h"
 #include "dictionarywordreader.h"
 #include "field_length_scanner.h"
+#include "fusion_output_pipe.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/searchlib/bitcompression/posocc_fields_params.h>
 #include <vespa/searchlib/index/field_length_info.h>
@@ -16,6 +17,7 @@
 #include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/document/util/queue.h>
+#include <algorithm>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -44,6 +46,10 @@ namespace search::diskindex {
 
 namespace {
 
+// Memory used for buffering merged postings per field is bounded by batches * batch size
+constexpr uint32_t outputPipeBatches = 4;
+constexpr size_t outputPipeBatchSize = 256 * 1024;
+
 vespalib::string
 createTmpPath(const vespalib::string & base, uint32_t index) {
     vespalib::asciistream os;
@@ -175,14 +181,22 @@ bool
 Fusion::mergeFields(vespalib::ThreadExecutor & executor)
 {
     const Schema &schema = getSchema();
+    std::vector<std::pair<uint64_t, uint32_t>> fields;
+    for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
+        fields.emplace_back(estimateFieldInputSize(iter), iter.getIndex());
+    }
+    // Start with the largest fields to avoid ending with a large field being merged alone
+    std::stable_sort(fields.begin(), fields.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
     std::atomic<uint32_t> failed(0);
+    // Each field merge uses up to two threads, see mergePostings()
     uint32_t maxConcurrentThreads = std::max(1ul, executor.getNumThreads()/2);
     document::Semaphore concurrent(maxConcurrentThreads);
     vespalib::CountDownLatch  done(schema.getNumIndexFields());
-    for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
+    for (const auto &field : fields) {
         concurrent.wait();
-        executor.execute(vespalib::makeLambdaTask([this, index=iter.getIndex(), &failed, &done, &concurrent]() {
-            if (!mergeField(index)) {
+        executor.execute(vespalib::makeLambdaTask([this, index=field.second, &executor, &failed, &done, &concurrent]() {
+            if (!mergeField(index, executor)) {
                 failed++;
             }
             concurrent.post();
@@ -196,8 +210,27 @@ Fusion::mergeFields(vespalib::ThreadExecutor & executor)
 }
 
 
+uint64_t
+Fusion::estimateFieldInputSize(const SchemaUtil::IndexIterator &index) const
+{
+    uint64_t size = 0;
+    for (const auto &oi : _oldIndexes) {
+        if (!index.hasOldFields(oi.getSchema())) {
+            continue;
+        }
+        vespalib::string fieldDir(oi.getPath() + "/" + index.getName() + "/");
+        for (const char *name : { "posocc.dat.compressed", "boolocc.bdat" }) {
+            FastOS_StatInfo statInfo;
+            if (FastOS_File::Stat((fieldDir + name).c_str(), &statInfo)) {
+                size += statInfo._size;
+            }
+        }
+    }
+    return size;
+}
+
 bool
-Fusion::mergeField(uint32_t id)
+Fusion::mergeField(uint32_t id, vespalib::ThreadExecutor & executor)
 {
     typedef SchemaUtil::IndexIterator IndexIterator;
     typedef SchemaUtil::IndexSettings IndexSettings;
@@ -228,7 +261,7 @@ Fusion::mergeField(uint32_t id)
     }
 
     // Tokamak
-    bool res = mergeFieldPostings(index, list, numWordIds);
+    bool res = mergeFieldPostings(index, list, numWordIds, executor);
     if (!res) {
         throw IllegalArgumentException(make_string("Could not merge field postings for field %s dir %s",
                                                    indexName.c_str(), indexDir.c_str()));
@@ -386,8 +419,32 @@ Fusion::setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > & reader
 }
 
 
+void
+Fusion::mergePostings(PostingPriorityQueue<FieldReader> &heap, FieldWriter &writer, vespalib::ThreadExecutor & executor)
+{
+    if (executor.getNumThreads() < 2) {
+        heap.merge(writer, 4);
+        return;
+    }
+    // Decode and merge input postings in this thread while another thread encodes the output postings
+    FusionOutputPipe pipe(outputPipeBatches, outputPipeBatchSize);
+    vespalib::CountDownLatch drained(1);
+    auto rejected = executor.execute(vespalib::makeLambdaTask([&pipe, &writer, &drained]() {
+        pipe.drain(writer);
+        drained.countDown();
+    }));
+    if (rejected) {
+        heap.merge(writer, 4);
+        return;
+    }
+    heap.merge(pipe, 4);
+    pipe.close();
+    drained.await();
+}
+
 bool
-Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index, const WordNumMappingList & list, uint64_t numWordIds)
+Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index, const WordNumMappingList & list, uint64_t numWordIds,
+                           vespalib::ThreadExecutor & executor)
 {
     std::vector<std::unique_ptr<FieldReader>> readers;
     PostingPriorityQueue<FieldReader> heap;
@@ -409,7 +466,7 @@ Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index, const WordNum
         return false;
     }
 
-    heap.merge(fieldWriter, 4);
+    mergePostings(heap, fieldWriter, executor);
     assert(heap.empty());
 
     for (auto &reader : readers) {
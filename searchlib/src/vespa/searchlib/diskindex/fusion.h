@@ -49,14 +49,18 @@ private:
     using WordNumMappingList = std::vector<WordNumMapping>;
 
     bool mergeFields(vespalib::ThreadExecutor & executor);
-    bool mergeField(uint32_t id);
+    bool mergeField(uint32_t id, vespalib::ThreadExecutor & executor);
+    uint64_t estimateFieldInputSize(const SchemaUtil::IndexIterator &index) const;
     std::shared_ptr<FieldLengthScanner> allocate_field_length_scanner(const SchemaUtil::IndexIterator &index);
     bool openInputFieldReaders(const SchemaUtil::IndexIterator &index, const WordNumMappingList & list,
                                std::vector<std::unique_ptr<FieldReader> > & readers);
     bool openFieldWriter(const SchemaUtil::IndexIterator &index, FieldWriter & writer, const index::FieldLengthInfo &field_length_info);
     bool setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > & readers,
                         FieldWriter &writer, PostingPriorityQueue<FieldReader> &heap);
-    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index, const WordNumMappingList & list, uint64_t  numWordIds);
+    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index, const WordNumMappingList & list, uint64_t  numWordIds,
+                            vespalib::ThreadExecutor & executor);
+    static void mergePostings(PostingPriorityQueue<FieldReader> &heap, FieldWriter &writer,
+                              vespalib::ThreadExecutor & executor);
     bool openInputWordReaders(const vespalib::string & dir, const SchemaUtil::IndexIterator &index,
                               std::vector<std::unique_ptr<DictionaryWordReader> > &readers,
                               PostingPriorityQueue<DictionaryWordReader> &heap);
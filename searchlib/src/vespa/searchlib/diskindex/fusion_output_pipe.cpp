@@ -0,0 +1,127 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fusion_output_pipe.h"
+#include <cassert>
+
+namespace search::diskindex {
+
+using index::WordDocElementFeatures;
+using index::WordDocElementWordPosFeatures;
+
+namespace {
+
+size_t
+features_bytes(const index::DocIdAndFeatures &features)
+{
+    return sizeof(features) +
+        features.blob().size() * sizeof(uint64_t) +
+        features.elements().size() * sizeof(WordDocElementFeatures) +
+        features.word_positions().size() * sizeof(WordDocElementWordPosFeatures);
+}
+
+}
+
+FusionOutputPipe::Word::Word(uint64_t word_num_in, vespalib::stringref word_in, uint32_t first_doc_in)
+    : word_num(word_num_in),
+      word(word_in),
+      first_doc(first_doc_in)
+{
+}
+
+FusionOutputPipe::Word::~Word() = default;
+
+FusionOutputPipe::Batch::Batch()
+    : words(),
+      docs(),
+      num_docs(0),
+      bytes(0)
+{
+}
+
+FusionOutputPipe::Batch::~Batch() = default;
+
+FusionOutputPipe::FusionOutputPipe(uint32_t num_batches, size_t batch_size)
+    : _lock(),
+      _cond(),
+      _free(),
+      _full(),
+      _batch(std::make_unique<Batch>()),
+      _batch_size(batch_size),
+      _word_num(0),
+      _closed(false)
+{
+    assert(num_batches >= 2);
+    for (uint32_t i = 1; i < num_batches; ++i) {
+        _free.push_back(std::make_unique<Batch>());
+    }
+}
+
+FusionOutputPipe::~FusionOutputPipe() = default;
+
+void
+FusionOutputPipe::newWord(uint64_t word_num, vespalib::stringref word)
+{
+    _batch->words.emplace_back(word_num, word, _batch->num_docs);
+    _batch->bytes += sizeof(Word) + word.size();
+    _word_num = word_num;
+}
+
+void
+FusionOutputPipe::add(const DocIdAndFeatures &features)
+{
+    Batch &batch = *_batch;
+    if (batch.num_docs < batch.docs.size()) {
+        batch.docs[batch.num_docs] = features;
+    } else {
+        batch.docs.push_back(features);
+    }
+    ++batch.num_docs;
+    batch.bytes += features_bytes(features);
+    if (batch.bytes >= _batch_size) {
+        flush();
+    }
+}
+
+void
+FusionOutputPipe::flush()
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    _full.push_back(std::move(_batch));
+    _cond.notify_all();
+    _cond.wait(guard, [this]() { return !_free.empty(); });
+    _batch = std::move(_free.back());
+    _free.pop_back();
+}
+
+void
+FusionOutputPipe::close()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_batch->num_docs > 0 || !_batch->words.empty()) {
+        _full.push_back(std::move(_batch));
+    } else {
+        _free.push_back(std::move(_batch));
+    }
+    _closed = true;
+    _cond.notify_all();
+}
+
+std::unique_ptr<FusionOutputPipe::Batch>
+FusionOutputPipe::next_full(std::unique_ptr<Batch> drained)
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    if (drained) {
+        drained->clear();
+        _free.push_back(std::move(drained));
+        _cond.notify_all();
+    }
+    _cond.wait(guard, [this]() { return !_full.empty() || _closed; });
+    if (_full.empty()) {
+        return std::unique_ptr<Batch>();
+    }
+    auto batch = std::move(_full.front());
+    _full.pop_front();
+    return batch;
+}
+
+}
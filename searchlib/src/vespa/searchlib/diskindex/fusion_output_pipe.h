@@ -0,0 +1,104 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search::diskindex {
+
+/**
+ * Pipe between the merging of input posting lists and the field writer
+ * used during fusion of a field. This allows decoding of the input
+ * posting lists and encoding of the output posting list to run on
+ * separate threads.
+ *
+ * Merged postings are buffered in a fixed number of batches that are
+ * handed over when they reach the batch size, bounding the memory used
+ * by the pipe to roughly num_batches * batch_size bytes. The producer
+ * blocks when all batches are in use.
+ */
+class FusionOutputPipe {
+    using DocIdAndFeatures = index::DocIdAndFeatures;
+
+    struct Word {
+        uint64_t         word_num;
+        vespalib::string word;
+        uint32_t         first_doc;
+        Word(uint64_t word_num_in, vespalib::stringref word_in, uint32_t first_doc_in);
+        ~Word();
+    };
+
+    struct Batch {
+        std::vector<Word>             words;
+        std::vector<DocIdAndFeatures> docs;
+        uint32_t                      num_docs;
+        size_t                        bytes;
+        Batch();
+        ~Batch();
+        void clear() {
+            words.clear();
+            num_docs = 0;
+            bytes = 0;
+        }
+    };
+
+    std::mutex                          _lock;
+    std::condition_variable             _cond;
+    std::vector<std::unique_ptr<Batch>> _free;
+    std::deque<std::unique_ptr<Batch>>  _full;
+    std::unique_ptr<Batch>              _batch;
+    const size_t                        _batch_size;
+    uint64_t                            _word_num;
+    bool                                _closed;
+
+    void flush();
+    std::unique_ptr<Batch> next_full(std::unique_ptr<Batch> drained);
+public:
+    FusionOutputPipe(uint32_t num_batches, size_t batch_size);
+    ~FusionOutputPipe();
+
+    void newWord(uint64_t word_num, vespalib::stringref word);
+    void add(const DocIdAndFeatures &features);
+    uint64_t getSparseWordNum() const { return _word_num; }
+
+    /**
+     * Hands over the last batch. Must be called by the producer when
+     * all postings have been added.
+     */
+    void close();
+
+    /**
+     * Writes buffered postings to the given writer until the pipe is
+     * closed and all batches have been written.
+     */
+    template <class Writer>
+    void drain(Writer &writer);
+};
+
+template <class Writer>
+void
+FusionOutputPipe::drain(Writer &writer)
+{
+    std::unique_ptr<Batch> batch;
+    while ((batch = next_full(std::move(batch)))) {
+        auto word = batch->words.begin();
+        auto word_end = batch->words.end();
+        for (uint32_t i = 0; i < batch->num_docs; ++i) {
+            for (; word != word_end && word->first_doc == i; ++word) {
+                writer.newWord(word->word_num, word->word);
+            }
+            writer.add(batch->docs[i]);
+        }
+        for (; word != word_end; ++word) {
+            writer.newWord(word->word_num, word->word);
+        }
+    }
+}
+
+}
@@ -84,6 +84,26 @@ public:
     uint32_t getIndexId() const { return _fieldId; }
 };
 
+/**
+ * Builder adding the words of a single field directly to its field
+ * writer, independent of the state of the owning index builder.
+ */
+class IndexBuilder::FieldBuilder : public index::IndexBuilder {
+private:
+    FieldHandle &_field;
+    bool         _inWord;
+
+public:
+    FieldBuilder(const Schema &schema, FieldHandle &field);
+    ~FieldBuilder() override;
+
+    void startField(uint32_t fieldId) override;
+    void endField() override;
+    void startWord(vespalib::stringref word) override;
+    void endWord() override;
+    void add_document(const index::DocIdAndFeatures &features) override;
+};
+
 
 FileHandle::FileHandle()
     : _fieldWriter()
@@ -195,6 +215,50 @@ IndexBuilder::FieldHandle::close()
     _file.close();
 }
 
+IndexBuilder::FieldBuilder::FieldBuilder(const Schema &schema, FieldHandle &field)
+    : index::IndexBuilder(schema),
+      _field(field),
+      _inWord(false)
+{
+}
+
+IndexBuilder::FieldBuilder::~FieldBuilder() = default;
+
+void
+IndexBuilder::FieldBuilder::startField(uint32_t fieldId)
+{
+    assert(fieldId == _field.getIndexId());
+    (void) fieldId;
+}
+
+void
+IndexBuilder::FieldBuilder::endField()
+{
+    assert(!_inWord);
+}
+
+void
+IndexBuilder::FieldBuilder::startWord(vespalib::stringref word)
+{
+    assert(!_inWord);
+    _inWord = true;
+    _field.new_word(word);
+}
+
+void
+IndexBuilder::FieldBuilder::endWord()
+{
+    assert(_inWord);
+    _inWord = false;
+}
+
+void
+IndexBuilder::FieldBuilder::add_document(const index::DocIdAndFeatures &features)
+{
+    assert(_inWord);
+    _field.add_document(features);
+}
+
 IndexBuilder::IndexBuilder(const Schema &schema)
     : index::IndexBuilder(schema),
       _currentField(nullptr),
@@ -272,6 +336,14 @@ IndexBuilder::add_document(const index::DocIdAndFeatures &features)
     _currentField->add_document(features);
 }
 
+std::unique_ptr<index::IndexBuilder>
+IndexBuilder::make_field_builder(uint32_t fieldId)
+{
+    assert(_currentField == nullptr);
+    assert(fieldId < _fields.size());
+    return std::make_unique<FieldBuilder>(_schema, _fields[fieldId]);
+}
+
 void
 IndexBuilder::setPrefix(vespalib::stringref prefix)
 {
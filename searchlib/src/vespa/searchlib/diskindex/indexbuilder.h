@@ -22,6 +22,7 @@ class BitVectorCandidate;
 class IndexBuilder : public index::IndexBuilder {
 public:
     class FieldHandle;
+    class FieldBuilder;
 
     using Schema = index::Schema;
 private:
@@ -59,6 +60,7 @@ public:
     void startWord(vespalib::stringref word) override;
     void endWord() override;
     void add_document(const index::DocIdAndFeatures &features) override;
+    std::unique_ptr<index::IndexBuilder> make_field_builder(uint32_t fieldId) override;
 
     void setPrefix(vespalib::stringref prefix);
 
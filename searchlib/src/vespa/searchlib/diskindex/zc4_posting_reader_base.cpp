@@ -71,7 +71,9 @@ Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
 
 Zc4PostingReaderBase::L1Skip::L1Skip()
     : NoSkipBase(),
-      _l1_skip_pos(0)
+      _l1_skip_pos(0),
+      _block_max_num_occs(0),
+      _check_max_num_occs(0)
 {
 }
 
@@ -80,6 +82,8 @@ Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size
 {
     NoSkipBase::setup(decode_context, size, doc_id);
     _l1_skip_pos = 0;
+    _block_max_num_occs = 0;
+    _check_max_num_occs = 0;
     if (size != 0) {
         next_skip_entry();
     } else {
@@ -108,6 +112,20 @@ Zc4PostingReaderBase::L1Skip::next_skip_entry()
     _doc_id += (_zc_buf.decode() + 1);
 }
 
+void
+Zc4PostingReaderBase::L1Skip::read_block_max()
+{
+    _block_max_num_occs = _zc_buf.decode() + 1;
+}
+
+void
+Zc4PostingReaderBase::L1Skip::check_block_max()
+{
+    // No block max info when chunk lacks L1 skip entries
+    assert(_block_max_num_occs == 0 || _block_max_num_occs == _check_max_num_occs);
+    _check_max_num_occs = 0;
+}
+
 Zc4PostingReaderBase::L2Skip::L2Skip()
     : L1Skip(),
       _l2_skip_pos(0)
@@ -202,8 +220,12 @@ void
 Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_context)
 {
     // Split docid & features.
+    bool decode_block_max = _posting_params._encode_block_max;
     if (_no_skip.get_doc_id() >= _l1_skip.get_doc_id()) {
         _no_skip.set_features_pos(decode_context.getReadOffset());
+        if (decode_block_max) {
+            _l1_skip.check_block_max();
+        }
         _l1_skip.check(_no_skip, true, _posting_params._encode_features);
         if (_no_skip.get_doc_id() >= _l2_skip.get_doc_id()) {
             _l2_skip.check(_l1_skip, true, _posting_params._encode_features);
@@ -218,9 +240,18 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
             _l2_skip.next_skip_entry();
         }
         _l1_skip.next_skip_entry();
+        if (decode_block_max) {
+            _l1_skip.read_block_max();
+        }
     }
     _no_skip.read(_posting_params._encode_interleaved_features);
+    if (decode_block_max) {
+        _l1_skip.update_check_block_max(_no_skip.get_num_occs());
+    }
     if (_residue == 1) {
+        if (decode_block_max) {
+            _l1_skip.check_block_max();
+        }
         _no_skip.check_end(_last_doc_id);
         _l1_skip.check_end(_last_doc_id);
         _l2_skip.check_end(_last_doc_id);
@@ -250,6 +281,9 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
     uint32_t prev_doc_id = _no_skip.get_doc_id();
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
     _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
+    if (_posting_params._encode_block_max && header._l1_skip_size != 0) {
+        _l1_skip.read_block_max();
+    }
     _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
     _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
     _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id);
@@ -6,6 +6,7 @@
 #include "zcbuf.h"
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/index/postinglistcounts.h>
+#include <algorithm>
 
 namespace search::diskindex {
 
@@ -56,11 +57,16 @@ protected:
     class L1Skip : public NoSkipBase {
     protected:
         uint32_t _l1_skip_pos;
+        uint32_t _block_max_num_occs;  // Max num occs for documents covered by skip entry
+        uint32_t _check_max_num_occs;  // Max num occs seen since previous skip entry
     public:
         L1Skip();
         void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
         void check(const NoSkipBase &no_skip, bool top_level, bool decode_features);
         void next_skip_entry();
+        void read_block_max();
+        void update_check_block_max(uint32_t num_occs) { _check_max_num_occs = std::max(_check_max_num_occs, num_occs); }
+        void check_block_max();
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
     };
     class L2Skip : public L1Skip
@@ -2,6 +2,7 @@
 
 #include "zc4_posting_writer_base.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
+#include <algorithm>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -15,13 +16,15 @@ protected:
     uint32_t _doc_id;
     uint32_t _doc_id_pos;
     uint32_t _feature_pos;
+    uint32_t _block_max_num_occs;
     using DocIdAndFeatureSize = Zc4PostingWriterBase::DocIdAndFeatureSize;
 
 public:
     DocIdEncoder()
         : _doc_id(0u),
           _doc_id_pos(0u),
-          _feature_pos(0u)
+          _feature_pos(0u),
+          _block_max_num_occs(0u)
     {
     }
 
@@ -30,6 +33,8 @@ public:
     uint32_t get_doc_id() const { return _doc_id; }
     uint32_t get_doc_id_pos() const { return _doc_id_pos; }
     uint32_t get_feature_pos() const { return _feature_pos; }
+    uint32_t get_block_max_num_occs() const { return _block_max_num_occs; }
+    void reset_block_max_num_occs() { _block_max_num_occs = 0u; }
 };
 
 class L1SkipEncoder : public DocIdEncoder {
@@ -37,13 +42,15 @@ protected:
     uint32_t _stride_check;
     uint32_t _l1_skip_pos;
     const bool _encode_features;
+    const bool _encode_block_max;
 
 public:
-    L1SkipEncoder(bool encode_features)
+    L1SkipEncoder(bool encode_features, bool encode_block_max)
         : DocIdEncoder(),
           _stride_check(0u),
           _l1_skip_pos(0u),
-          _encode_features(encode_features)
+          _encode_features(encode_features),
+          _encode_block_max(encode_block_max)
     {
     }
 
@@ -51,7 +58,7 @@ public:
     void write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     bool should_write_skip(uint32_t stride) { return ++_stride_check >= stride; }
     void dec_stride_check() { --_stride_check; }
-    void write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id);
+    void write_partial_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder);
     uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
 };
 
@@ -61,7 +68,7 @@ protected:
 
 public:
     L2SkipEncoder(bool encode_features)
-        : L1SkipEncoder(encode_features),
+        : L1SkipEncoder(encode_features, false),
           _l2_skip_pos(0u)
     {
     }
@@ -111,6 +118,7 @@ DocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature
         assert(doc_id_and_feature_size._num_occs > 0);
         zc_buf.encode(doc_id_and_feature_size._num_occs - 1);
     }
+    _block_max_num_occs = std::max(_block_max_num_occs, doc_id_and_feature_size._num_occs);
     _doc_id_pos = zc_buf.size();
 }
 
@@ -123,6 +131,11 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     assert(static_cast<int32_t>(doc_id_delta) > 0);
     zc_buf.encode(doc_id_delta - 1);
     _doc_id = doc_id_encoder.get_doc_id();
+    if (_encode_block_max) {
+        // max num occs for documents since previous skip entry
+        assert(doc_id_encoder.get_block_max_num_occs() > 0);
+        zc_buf.encode(doc_id_encoder.get_block_max_num_occs() - 1);
+    }
     // doc id pos
     zc_buf.encode(doc_id_encoder.get_doc_id_pos() - _doc_id_pos - 1);
     _doc_id_pos = doc_id_encoder.get_doc_id_pos();
@@ -141,10 +154,13 @@ L1SkipEncoder::write_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 }
 
 void
-L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id)
+L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
     if (zc_buf.size() > 0) {
-        zc_buf.encode(doc_id - _doc_id - 1);
+        zc_buf.encode(doc_id_encoder.get_doc_id() - _doc_id - 1);
+        if (_encode_block_max) {
+            zc_buf.encode(doc_id_encoder.get_block_max_num_occs() - 1);
+        }
     }
 }
 
@@ -206,6 +222,7 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -238,7 +255,7 @@ void
 Zc4PostingWriterBase::calc_skip_info(bool encode_features)
 {
     DocIdEncoder doc_id_encoder;
-    L1SkipEncoder l1_skip_encoder(encode_features);
+    L1SkipEncoder l1_skip_encoder(encode_features, _encode_block_max);
     L2SkipEncoder l2_skip_encoder(encode_features);
     L3SkipEncoder l3_skip_encoder(encode_features);
     L4SkipEncoder l4_skip_encoder(encode_features);
@@ -254,6 +271,7 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
     for (const auto &doc_id_and_feature_size : _docIds) {
         if (l1_skip_encoder.should_write_skip(L1SKIPSTRIDE)) {
             l1_skip_encoder.write_skip(_l1Skip, doc_id_encoder);
+            doc_id_encoder.reset_block_max_num_occs();
             if (l2_skip_encoder.should_write_skip(L2SKIPSTRIDE)) {
                 l2_skip_encoder.write_skip(_l2Skip, l1_skip_encoder);
                 if (l3_skip_encoder.should_write_skip(L3SKIPSTRIDE)) {
@@ -267,10 +285,10 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
         doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
     }
     // Extra partial entries for skip tables to simplify iterator during search
-    l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
-    l2_skip_encoder.write_partial_skip(_l2Skip, doc_id_encoder.get_doc_id());
-    l3_skip_encoder.write_partial_skip(_l3Skip, doc_id_encoder.get_doc_id());
-    l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder.get_doc_id());
+    l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder);
+    l2_skip_encoder.write_partial_skip(_l2Skip, doc_id_encoder);
+    l3_skip_encoder.write_partial_skip(_l3Skip, doc_id_encoder);
+    l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder);
 }
 
 void
@@ -290,6 +308,9 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max", _encode_block_max);
+    // Block max uses num occs from interleaved features
+    assert(!_encode_block_max || _encode_interleaved_features);
 }
 
 }
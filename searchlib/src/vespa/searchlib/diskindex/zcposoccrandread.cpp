@@ -27,6 +27,7 @@ namespace {
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_max("block_max");
 
 }
 
@@ -150,6 +151,26 @@ ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
 }
 
 
+void
+ZcPosOccRandRead::prefetchPostingList(const PostingListCounts &counts,
+                                      uint32_t firstSegment,
+                                      uint32_t numSegments,
+                                      const PostingListHandle &handle)
+{
+    // XXX: Ignore segments for now.
+    (void) firstSegment;
+    (void) numSegments;
+    (void) counts;
+
+    if (handle._bitLength == 0) {
+        return;
+    }
+    uint64_t startOffset = (handle._bitOffset + _headerBitSize) >> 3;
+    uint64_t endOffset = (handle._bitOffset + _headerBitSize + handle._bitLength + 7) >> 3;
+    _file->prefetch(startOffset, endOffset - startOffset);
+}
+
+
 bool
 ZcPosOccRandRead::
 open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead)
@@ -217,6 +238,9 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
         _posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max) && (header.getTag(block_max).asInteger() != 0)) {
+        _posting_params._encode_block_max = true;
+    }
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
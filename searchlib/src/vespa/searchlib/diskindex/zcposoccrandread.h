@@ -43,6 +43,9 @@ public:
     void readPostingList(const PostingListCounts &counts, uint32_t firstSegment,
                          uint32_t numSegments, PostingListHandle &handle) override;
 
+    void prefetchPostingList(const PostingListCounts &counts, uint32_t firstSegment,
+                             uint32_t numSegments, const PostingListHandle &handle) override;
+
     bool open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead) override;
     bool close() override;
     template <typename DecodeContext>
@@ -4,6 +4,7 @@
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <vespa/searchlib/common/bitvector.h>
 
 namespace search::diskindex {
 
@@ -39,7 +40,8 @@ template <bool bigEndian>
 ZcRareWordPostingIteratorBase<bigEndian>::
 ZcRareWordPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                               bool decode_normal_features, bool decode_interleaved_features,
-                              bool unpack_normal_features, bool unpack_interleaved_features)
+                              bool unpack_normal_features, bool unpack_interleaved_features,
+                              bool decode_block_max)
     : ZcIteratorBase(matchData, start, docIdLimit),
       _decodeContext(nullptr),
       _residue(0),
@@ -49,6 +51,7 @@ ZcRareWordPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position
       _decode_interleaved_features(decode_interleaved_features),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
+      _decode_block_max(decode_block_max),
       _field_length(0),
       _num_occs(0)
 { }
@@ -58,10 +61,12 @@ template <bool bigEndian, bool dynamic_k>
 ZcRareWordPostingIterator<bigEndian, dynamic_k>::
 ZcRareWordPostingIterator(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                           bool decode_normal_features, bool decode_interleaved_features,
-                          bool unpack_normal_features, bool unpack_interleaved_features)
+                          bool unpack_normal_features, bool unpack_interleaved_features,
+                          bool decode_block_max)
     : ZcRareWordPostingIteratorBase<bigEndian>(matchData, start, docIdLimit,
                                                decode_normal_features, decode_interleaved_features,
-                                               unpack_normal_features, unpack_interleaved_features),
+                                               unpack_normal_features, unpack_interleaved_features,
+                                               decode_block_max),
       _doc_id_k_param()
 {
 }
@@ -189,7 +194,8 @@ ZcRareWordPostingIterator<bigEndian, dynamic_k>::readWordStart(uint32_t docIdLim
 
 ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                                              bool decode_normal_features, bool decode_interleaved_features,
-                                             bool unpack_normal_features, bool unpack_interleaved_features)
+                                             bool unpack_normal_features, bool unpack_interleaved_features,
+                                             bool decode_block_max)
     : ZcIteratorBase(matchData, start, docIdLimit),
       _valI(nullptr),
       _valIBase(nullptr),
@@ -205,9 +211,11 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
       _decode_interleaved_features(decode_interleaved_features),
       _unpack_normal_features(unpack_normal_features),
       _unpack_interleaved_features(unpack_interleaved_features),
+      _decode_block_max(decode_block_max),
       _chunkNo(0),
       _field_length(0),
-      _num_occs(0)
+      _num_occs(0),
+      _l1_block_max_num_occs(std::numeric_limits<uint32_t>::max())
 {
 }
 
@@ -219,10 +227,12 @@ ZcPostingIterator(uint32_t minChunkDocs,
                   const search::fef::TermFieldMatchDataArray &matchData,
                   Position start, uint32_t docIdLimit,
                   bool decode_normal_features, bool decode_interleaved_features,
-                  bool unpack_normal_features, bool unpack_interleaved_features)
+                  bool unpack_normal_features, bool unpack_interleaved_features,
+                  bool decode_block_max)
     : ZcPostingIteratorBase(matchData, start, docIdLimit,
                             decode_normal_features, decode_interleaved_features,
-                            unpack_normal_features, unpack_interleaved_features),
+                            unpack_normal_features, unpack_interleaved_features,
+                            decode_block_max),
       _decodeContext(nullptr),
       _minChunkDocs(minChunkDocs),
       _docIdK(0),
@@ -311,6 +321,14 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
+    if (_decode_block_max) {
+        if (l1SkipSize != 0) {
+            ZCDECODE(_l1._valI, _l1_block_max_num_occs = 1 +);
+        } else {
+            // No skip entries, no upper bound known for chunk
+            _l1_block_max_num_occs = std::numeric_limits<uint32_t>::max();
+        }
+    }
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
     _l4.setup(prevDocId, _chunk._lastDocId, bcompr, l4SkipSize);
@@ -385,7 +403,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l2._valI = _l3._l2Pos = _l4._l2Pos;
     _l3._valI = _l4._l3Pos;
     nextDocId(lastL4SkipDocId);
-    _l1.nextDocId();
+    l1NextDocId();
     _l2.nextDocId();
     _l3.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
@@ -434,7 +452,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l1._valI = _l2._l1Pos = _l3._l1Pos;
     _l2._valI = _l3._l2Pos;
     nextDocId(lastL3SkipDocId);
-    _l1.nextDocId();
+    l1NextDocId();
     _l2.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L3Seek, docId %d docIdPos %d"
@@ -478,7 +496,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     _l1._skipDocId = lastL2SkipDocId;
     _l1._valI = _l2._l1Pos;
     nextDocId(lastL2SkipDocId);
-    _l1.nextDocId();
+    l1NextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
            lastL2SkipDocId,
@@ -504,7 +522,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     do {
         lastL1SkipDocId = _l1._skipDocId;
         _l1.decodeSkipEntry(_decode_normal_features);
-        _l1.nextDocId();
+        l1NextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L1Decode docId %d, docIdPos %d, L1SkipPos %d, nextDocId %d\n",
                lastL1SkipDocId,
@@ -573,6 +591,82 @@ ZcPostingIteratorBase::doSeek(uint32_t docId)
     return;
 }
 
+uint32_t
+ZcPostingIteratorBase::seek_block(uint32_t docId)
+{
+    if (docId > _l1._skipDocId) {
+        doL1SkipSeek(docId);
+    }
+    return _l1._skipDocId;
+}
+
+uint32_t
+ZcPostingIteratorBase::decode_doc_ids(uint32_t *doc_ids, uint32_t *num_occs, uint32_t max_doc_ids)
+{
+    uint32_t oDocId = getDocId();
+    if (isAtEnd(oDocId) || max_doc_ids == 0) {
+        return 0;
+    }
+    uint32_t last_doc_id = std::min(_l1._skipDocId, getEndId() - 1);
+    bool fill_num_occs = (num_occs != nullptr) && _decode_interleaved_features;
+    const uint8_t *oCompr = _valI;
+    uint32_t field_length = _field_length;
+    uint32_t num_occs_val = _num_occs;
+    uint32_t decoded = 0;
+    for (;;) {
+        doc_ids[decoded] = oDocId;
+        if (fill_num_occs) {
+            num_occs[decoded] = num_occs_val;
+        }
+        ++decoded;
+        if (decoded >= max_doc_ids || oDocId >= last_doc_id) {
+            break;
+        }
+        ZCDECODE(oCompr, oDocId += 1 +);
+        if (_decode_interleaved_features) {
+            ZCDECODE(oCompr, field_length = 1 +);
+            ZCDECODE(oCompr, num_occs_val = 1 +);
+        }
+        incNeedUnpack();
+        if (__builtin_expect(oDocId > last_doc_id, false)) {
+            // Passed end id within current skip block
+            _valI = oCompr;
+            setDocId(oDocId);
+            _field_length = field_length;
+            _num_occs = num_occs_val;
+            return decoded;
+        }
+    }
+    _valI = oCompr;
+    setDocId(oDocId);
+    _field_length = field_length;
+    _num_occs = num_occs_val;
+    // Step to next document, using skip info when crossing skip block
+    doSeek(oDocId + 1);
+    return decoded;
+}
+
+BitVector::UP
+ZcPostingIteratorBase::get_hits(uint32_t begin_id)
+{
+    auto result(BitVector::create(begin_id, getEndId()));
+    or_hits_into(*result, begin_id);
+    return result;
+}
+
+void
+ZcPostingIteratorBase::or_hits_into(BitVector &result, uint32_t begin_id)
+{
+    uint32_t doc_ids[bulk_decode_size];
+    seek(begin_id);
+    while (!isAtEnd()) {
+        uint32_t decoded = decode_doc_ids(doc_ids, nullptr, bulk_decode_size);
+        for (uint32_t i = 0; i < decoded; ++i) {
+            result.setBit(doc_ids[i]);
+        }
+    }
+    result.invalidateCachedCount();
+}
 
 template <bool bigEndian>
 void
@@ -5,7 +5,9 @@
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <vespa/searchlib/queryeval/wand/i_block_max_search.h>
 #include <vespa/fastos/dynamiclibrary.h>
+#include <limits>
 
 namespace search::diskindex {
 
@@ -41,7 +43,8 @@ do {                                                         \
     }                                                        \
 } while (0)
 
-class ZcIteratorBase : public queryeval::RankedSearchIteratorBase
+class ZcIteratorBase : public queryeval::RankedSearchIteratorBase,
+                       public queryeval::IBlockMaxSearch
 {
 protected:
     ZcIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit);
@@ -72,15 +75,23 @@ public:
     bool               _decode_interleaved_features;
     bool               _unpack_normal_features;
     bool               _unpack_interleaved_features;
+    bool               _decode_block_max;
     uint32_t           _field_length;
     uint32_t           _num_occs;
 
     ZcRareWordPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                                   bool decode_normal_features, bool decode_interleaved_features,
-                                  bool unpack_normal_features, bool unpack_interleaved_features);
+                                  bool unpack_normal_features, bool unpack_interleaved_features,
+                                  bool decode_block_max);
 
     void doUnpack(uint32_t docId) override;
     void rewind(Position start) override;
+
+    // Rare words have no skip info, all remaining documents are treated as a single block
+    bool has_block_max() const override { return _decode_block_max; }
+    uint32_t seek_block(uint32_t) override { return getDocIdLimit() - 1; }
+    uint32_t get_block_max_num_occs() const override { return std::numeric_limits<uint32_t>::max(); }
+    uint32_t get_num_occs() const override { return _num_occs; }
 };
 
 template <bool dynamic_k> class ZcPostingDocIdKParam;
@@ -130,7 +141,8 @@ public:
     using ParentClass::_decodeContext;
     ZcRareWordPostingIterator(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                               bool decode_normal_features, bool decode_interleaved_features,
-                              bool unpack_normal_features, bool unpack_interleaved_features);
+                              bool unpack_normal_features, bool unpack_interleaved_features,
+                              bool decode_block_max);
     void doSeek(uint32_t docId) override;
     void readWordStart(uint32_t docIdLimit) override;
 };
@@ -138,6 +150,7 @@ public:
 class ZcPostingIteratorBase : public ZcIteratorBase
 {
 protected:
+    static constexpr uint32_t bulk_decode_size = 128;
     const uint8_t *_valI;     // docid deltas
     const uint8_t *_valIBase; // start of docid deltas
     uint64_t _featureSeekPos;
@@ -279,9 +292,11 @@ protected:
     bool     _decode_interleaved_features;
     bool     _unpack_normal_features;
     bool     _unpack_interleaved_features;
+    bool     _decode_block_max;
     uint32_t _chunkNo;
     uint32_t _field_length;
     uint32_t _num_occs;
+    uint32_t _l1_block_max_num_occs; // Max num occs for documents covered by current L1 skip entry
 
     void nextDocId(uint32_t prevDocId) {
         uint32_t docId = prevDocId + 1;
@@ -292,6 +307,12 @@ protected:
             ZCDECODE(_valI, _num_occs = 1 +);
         }
     }
+    void l1NextDocId() {
+        _l1.nextDocId();
+        if (_decode_block_max) {
+            ZCDECODE(_l1._valI, _l1_block_max_num_occs = 1 +);
+        }
+    }
     virtual void featureSeek(uint64_t offset) = 0;
     VESPA_DLL_LOCAL void doChunkSkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL4SkipSeek(uint32_t docId);
@@ -302,7 +323,27 @@ protected:
 public:
     ZcPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                           bool decode_normal_features, bool decode_interleaved_features,
-                          bool unpack_normal_features, bool unpack_interleaved_features);
+                          bool unpack_normal_features, bool unpack_interleaved_features,
+                          bool decode_block_max);
+
+    // L1 skip entries are used as blocks when block max info is present
+    bool has_block_max() const override { return _decode_block_max; }
+    uint32_t seek_block(uint32_t docId) override;
+    uint32_t get_block_max_num_occs() const override { return _l1_block_max_num_occs; }
+    uint32_t get_num_occs() const override { return _num_occs; }
+
+    /**
+     * Bulk decode document ids starting at the current document. The
+     * number of occurrences for each document is also filled in when
+     * num_occs is non-null and interleaved features are present.
+     * Decoding stops at the end of the current L1 skip block, before
+     * the end id or when max_doc_ids entries have been decoded. The
+     * iterator is positioned at the document following the last
+     * decoded one. Returns the number of decoded documents.
+     */
+    uint32_t decode_doc_ids(uint32_t *doc_ids, uint32_t *num_occs, uint32_t max_doc_ids);
+    std::unique_ptr<BitVector> get_hits(uint32_t begin_id) override;
+    void or_hits_into(BitVector &result, uint32_t begin_id) override;
 };
 
 template <bool bigEndian>
@@ -331,7 +372,8 @@ public:
     ZcPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
                       const search::fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
                       bool decode_normal_features, bool decode_interleaved_features,
-                      bool unpack_normal_features, bool unpack_interleaved_features);
+                      bool unpack_normal_features, bool unpack_interleaved_features,
+                      bool decode_block_max);
 
 
     void doUnpack(uint32_t docId) override;
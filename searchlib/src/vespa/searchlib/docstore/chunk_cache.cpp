@@ -0,0 +1,87 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "chunk_cache.h"
+#include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+
+namespace search::docstore {
+
+namespace {
+
+// Chunks are normally tens of kilobytes, so this remembers several times more chunks than fit in the cache.
+constexpr size_t BYTES_PER_DOORKEEPER_ENTRY = 4096;
+constexpr size_t MIN_DOORKEEPER_SIZE = 1024;
+
+}
+
+ChunkCache::ChunkCache(size_t maxBytes)
+    : _store(),
+      _cache(_store, maxBytes),
+      _lock(),
+      _doorkeeper(),
+      _maxDoorkeeperSize(doorkeeperSize(maxBytes)),
+      _enabled(maxBytes != 0)
+{
+}
+
+ChunkCache::~ChunkCache() = default;
+
+size_t
+ChunkCache::doorkeeperSize(size_t maxBytes)
+{
+    return std::max(MIN_DOORKEEPER_SIZE, maxBytes / BYTES_PER_DOORKEEPER_ENTRY);
+}
+
+ChunkCache::Value::Buffer
+ChunkCache::lookup(const Key &key)
+{
+    if ( ! _enabled) {
+        return Value::Buffer();
+    }
+    return _cache.read(key).buffer();
+}
+
+bool
+ChunkCache::admit(const Key &key)
+{
+    std::lock_guard guard(_lock);
+    if (_doorkeeper.find(key.hash()) != _doorkeeper.end()) {
+        _doorkeeper.erase(key.hash());
+        return true;
+    }
+    if (_doorkeeper.size() >= _maxDoorkeeperSize) {
+        _doorkeeper.clear();
+    }
+    _doorkeeper.insert(key.hash());
+    return false;
+}
+
+void
+ChunkCache::offer(const Key &key, const void *buf, size_t len)
+{
+    if ( ! _enabled || ! admit(key)) {
+        return;
+    }
+    auto copy = std::make_shared<vespalib::DataBuffer>(len);
+    copy->writeBytes(buf, len);
+    _cache.write(key, Value(std::move(copy)));
+}
+
+void
+ChunkCache::setCapacityBytes(size_t maxBytes)
+{
+    _cache.setCapacityBytes(maxBytes);
+    {
+        std::lock_guard guard(_lock);
+        _maxDoorkeeperSize = doorkeeperSize(maxBytes);
+    }
+    _enabled = (maxBytes != 0);
+}
+
+CacheStats
+ChunkCache::getCacheStats() const
+{
+    return CacheStats(_cache.getHit(), _cache.getMiss(), _cache.size(), _cache.sizeBytes(), _cache.getInvalidate());
+}
+
+}
@@ -0,0 +1,82 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "cachestats.h"
+#include <vespa/vespalib/stllike/cache.h>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace search::docstore {
+
+/**
+ * Byte budgeted cache of compressed chunks as they are stored in the
+ * summary data files, shared by all file chunks of a log data store.
+ * Documents in a cached chunk can be read without disk access, and
+ * keeping them compressed means many more documents fit in the same
+ * memory than in the document cache.
+ *
+ * A chunk is only admitted when it has been missed before while its
+ * key was still remembered by a small doorkeeper set, so chunks read
+ * a single time (e.g. by visiting) do not evict the frequently read ones.
+ **/
+class ChunkCache {
+public:
+    struct Key {
+        uint64_t nameId;
+        uint32_t chunkId;
+        Key() noexcept : nameId(0), chunkId(0) { }
+        Key(uint64_t nameId_, uint32_t chunkId_) noexcept : nameId(nameId_), chunkId(chunkId_) { }
+        bool operator==(const Key &rhs) const { return (nameId == rhs.nameId) && (chunkId == rhs.chunkId); }
+        size_t hash() const noexcept { return (nameId * 0x9E3779B97F4A7C15ul) ^ chunkId; }
+    };
+    class Value {
+    public:
+        using Buffer = std::shared_ptr<const vespalib::DataBuffer>;
+        Value() : _buffer() { }
+        explicit Value(Buffer buffer) : _buffer(std::move(buffer)) { }
+        const Buffer &buffer() const { return _buffer; }
+        size_t size() const { return _buffer ? _buffer->getDataLen() : 0; }
+    private:
+        Buffer _buffer;
+    };
+
+    explicit ChunkCache(size_t maxBytes);
+    ~ChunkCache();
+
+    /**
+     * Returns the cached chunk with the given key, or an empty buffer if not cached.
+     */
+    Value::Buffer lookup(const Key &key);
+    /**
+     * Offers a chunk that was just read from disk after a failed lookup.
+     * It is copied into the cache if admitted.
+     */
+    void offer(const Key &key, const void *buf, size_t len);
+
+    void setCapacityBytes(size_t maxBytes);
+    bool enabled() const { return _enabled; }
+    CacheStats getCacheStats() const;
+private:
+    using CacheParams = vespalib::CacheParam<
+        vespalib::LruParam<Key, Value>,
+        vespalib::NullStore<Key, Value>,
+        vespalib::zero<Key>,
+        vespalib::size<Value>>;
+    using Cache = vespalib::cache<CacheParams>;
+
+    static size_t doorkeeperSize(size_t maxBytes);
+    bool admit(const Key &key);
+
+    vespalib::NullStore<Key, Value> _store;
+    Cache                           _cache;
+    std::mutex                      _lock;
+    vespalib::hash_set<size_t>      _doorkeeper;
+    size_t                          _maxDoorkeeperSize;
+    std::atomic<bool>               _enabled;
+};
+
+}
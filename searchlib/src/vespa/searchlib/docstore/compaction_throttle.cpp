@@ -0,0 +1,46 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compaction_throttle.h"
+#include <thread>
+
+namespace search::docstore {
+
+CompactionThrottle::CompactionThrottle(size_t maxBytesPerSecond)
+    : _lock(),
+      _maxBytesPerSecond(maxBytesPerSecond),
+      _nextFree()
+{
+}
+
+CompactionThrottle::~CompactionThrottle() = default;
+
+void
+CompactionThrottle::acquire(size_t bytes)
+{
+    vespalib::steady_time start;
+    {
+        std::lock_guard guard(_lock);
+        if (_maxBytesPerSecond == 0) {
+            return;
+        }
+        start = std::max(vespalib::steady_clock::now(), _nextFree);
+        _nextFree = start + vespalib::from_s(double(bytes) / _maxBytesPerSecond);
+    }
+    std::this_thread::sleep_until(start);
+}
+
+void
+CompactionThrottle::setMaxBytesPerSecond(size_t maxBytesPerSecond)
+{
+    std::lock_guard guard(_lock);
+    _maxBytesPerSecond = maxBytesPerSecond;
+}
+
+size_t
+CompactionThrottle::getMaxBytesPerSecond() const
+{
+    std::lock_guard guard(_lock);
+    return _maxBytesPerSecond;
+}
+
+}
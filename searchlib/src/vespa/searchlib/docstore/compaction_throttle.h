@@ -0,0 +1,32 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <mutex>
+
+namespace search::docstore {
+
+/**
+ * Limits the rate at which compaction reads data from disk. It is shared by all the
+ * compactions running concurrently in a data store, so their total rate is bounded.
+ * A rate of 0 means unlimited.
+ */
+class CompactionThrottle
+{
+public:
+    explicit CompactionThrottle(size_t maxBytesPerSecond);
+    ~CompactionThrottle();
+    /**
+     * Blocks until the given number of bytes can be read without exceeding the rate.
+     */
+    void acquire(size_t bytes);
+    void setMaxBytesPerSecond(size_t maxBytesPerSecond);
+    size_t getMaxBytesPerSecond() const;
+private:
+    mutable std::mutex    _lock;
+    size_t                _maxBytesPerSecond;
+    vespalib::steady_time _nextFree;
+};
+
+}
@@ -161,11 +161,41 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
         for (DocumentIdT lid : lids) {
             adapter.visit(lid, blobSet.get(lid));
         }
+    } else if (useCache() && (_config.updateStrategy() == Config::UpdateStrategy::INSERT)) {
+        LidVector uncached;
+        for (DocumentIdT lid : lids) {
+            if (_cache->hasKey(lid)) {
+                DocumentUP doc = read(lid, repo);
+                if (doc) {
+                    visitor.visit(lid, std::move(doc));
+                }
+            } else {
+                uncached.push_back(lid);
+            }
+        }
+        _store->visit(uncached, repo, visitor);
     } else {
         _store->visit(lids, repo, visitor);
     }
 }
 
+void
+DocumentStore::prefetch(const LidVector & lids) const
+{
+    if (useCache()) {
+        LidVector uncached;
+        uncached.reserve(lids.size());
+        for (DocumentIdT lid : lids) {
+            if ( ! _cache->hasKey(lid)) {
+                uncached.push_back(lid);
+            }
+        }
+        _backingStore.prefetch(uncached);
+    } else {
+        _backingStore.prefetch(lids);
+    }
+}
+
 std::unique_ptr<document::Document>
 DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
 {
@@ -210,7 +240,8 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostr
                 _cache->invalidate(lid);
                 break;
             case Config::UpdateStrategy::UPDATE:
-                if (_cache->hasKey(lid)) {
+            case Config::UpdateStrategy::INSERT:
+                if ((_config.updateStrategy() == Config::UpdateStrategy::INSERT) || _cache->hasKey(lid)) {
                     Value value(syncToken);
                     vespalib::DataBuffer buf(stream.size());
                     buf.writeBytes(stream.peek(), stream.size());
@@ -23,7 +23,14 @@ class DocumentStore : public IDocumentStore
 public:
     class Config {
     public:
-        enum UpdateStrategy {INVALIDATE, UPDATE };
+        /**
+         * How the document cache is maintained on write:
+         * INVALIDATE removes the old document from the cache,
+         * UPDATE replaces the old document if it is cached, and
+         * INSERT always puts the new document in the cache, so recently
+         * written documents can be read and visited without disk access.
+         **/
+        enum UpdateStrategy {INVALIDATE, UPDATE, INSERT };
         using CompressionConfig = vespalib::compression::CompressionConfig;
         Config() :
             _compression(CompressionConfig::LZ4, 9, 70),
@@ -67,6 +74,7 @@ public:
 
     DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const override;
     void visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
+    void prefetch(const LidVector & lids) const override;
     void write(uint64_t synkToken, DocumentIdT lid, const document::Document& doc) override;
     void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) override;
     void remove(uint64_t syncToken, DocumentIdT lid) override;
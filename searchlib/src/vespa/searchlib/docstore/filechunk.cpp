@@ -4,12 +4,16 @@
 #include "data_store_file_chunk_stats.h"
 #include "summaryexceptions.h"
 #include "randreaders.h"
+#include "chunk_cache.h"
+#include "compaction_throttle.h"
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/array.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -27,8 +31,11 @@ namespace search {
 namespace {
 
 constexpr size_t ALIGNMENT=0x1000;
+constexpr size_t MAX_COALESCED_READ_SIZE=0x100000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string DICTIONARY_KEY("zstdDictionary");
+const vespalib::string DICTIONARY_LEVEL_KEY("zstdDictionaryLevel");
 
 }
 
@@ -83,6 +90,8 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
+      _dictionary(),
+      _chunkCache(nullptr),
       _modificationTime()
 {
     FastOS_File dataFile(_dataFileName.c_str());
@@ -276,6 +285,9 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        _dictionary = readDictionary(*_file, _dataHeaderLen);
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -337,7 +349,8 @@ appendChunks(FixedParams * args, Chunk::UP chunk)
 
 void
 FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWriteData & dest,
-                    uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress)
+                    uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
+                    docstore::CompactionThrottle *throttle)
 {
     assert(frozen() || visitorProgress);
     vespalib::GenerationHandler::Guard lidReadGuard(db.getLidReadGuard());
@@ -345,13 +358,16 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
     FixedParams fixedParams = {db, dest, lidReadGuard, getFileId().getId(), visitorProgress};
     vespalib::BlockingThreadStackExecutor singleExecutor(1, 64*1024, executor.getNumThreads()*2);
     for (size_t chunkId(0); chunkId < numChunks; chunkId++) {
+        if (throttle != nullptr) {
+            throttle->acquire(_chunkInfo[chunkId].getSize());
+        }
         std::promise<Chunk::UP> promisedChunk;
         std::future<Chunk::UP> futureChunk = promisedChunk.get_future();
         executor.execute(vespalib::makeLambdaTask([promise = std::move(promisedChunk), chunkId, this]() mutable {
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         }));
 
         singleExecutor.execute(vespalib::makeLambdaTask([args = &fixedParams, chunk = std::move(futureChunk)]() mutable {
@@ -366,27 +382,53 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
-    uint32_t prevChunk = begin->getChunkId();
-    uint32_t start(0);
+    std::vector<size_t> chunkStarts;
     for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
-            prevChunk = li.getChunkId();
-            start = i;
+        if ((i == 0) || ((begin + i)->getChunkId() != (begin + i - 1)->getChunkId())) {
+            chunkStarts.push_back(i);
+        }
+    }
+    chunkStarts.push_back(count);
+    // Chunks that follow each other on disk, as the chunks of a bucket do after bucket ordered
+    // compaction, are fetched with a single read.
+    for (size_t first(0), last(0); first + 1 < chunkStarts.size(); first = last) {
+        const ChunkInfo & firstInfo = _chunkInfo[(begin + chunkStarts[first])->getChunkId()];
+        uint64_t runEnd = firstInfo.getOffset() + firstInfo.getSize();
+        for (last = first + 1; last + 1 < chunkStarts.size(); last++) {
+            const ChunkInfo & next = _chunkInfo[(begin + chunkStarts[last])->getChunkId()];
+            if ((next.getOffset() < runEnd) || (next.getOffset() > runEnd + ALIGNMENT) ||
+                (next.getOffset() + next.getSize() - firstInfo.getOffset() > MAX_COALESCED_READ_SIZE))
+            {
+                break;
+            }
+            runEnd = next.getOffset() + next.getSize();
+        }
+        if (last == first + 1) {
+            read(begin + chunkStarts[first], chunkStarts[last] - chunkStarts[first], firstInfo, visitor);
+        } else {
+            vespalib::DataBuffer whole(0ul, ALIGNMENT);
+            FileRandRead::FSP keepAlive(_file->read(firstInfo.getOffset(), whole, runEnd - firstInfo.getOffset()));
+            for (size_t c(first); c < last; c++) {
+                auto chunkBegin = begin + chunkStarts[c];
+                const ChunkInfo & ci = _chunkInfo[chunkBegin->getChunkId()];
+                Chunk chunk(chunkBegin->getChunkId(), whole.getData() + (ci.getOffset() - firstInfo.getOffset()),
+                            ci.getSize(), _skipCrcOnRead, _dictionary.get());
+                visitLids(chunk, chunkBegin, chunkStarts[c + 1] - chunkStarts[c], visitor);
+            }
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
 }
 
 void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    std::unique_ptr<Chunk> chunk = readChunk(begin->getChunkId(), ci);
+    visitLids(*chunk, begin, count, visitor);
+}
+
+void
+FileChunk::visitLids(const Chunk & chunk, LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor)
+{
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -396,6 +438,27 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
     }
 }
 
+void
+FileChunk::prefetch(LidInfoWithLidV::const_iterator begin, size_t count) const
+{
+    uint32_t prevChunk = std::numeric_limits<uint32_t>::max();
+    for (size_t i(0); i < count; i++) {
+        uint32_t chunk = (begin + i)->getChunkId();
+        if (chunk != prevChunk) {
+            if (chunk < _chunkInfo.size()) {
+                prefetch(_chunkInfo[chunk]);
+            }
+            prevChunk = chunk;
+        }
+    }
+}
+
+void
+FileChunk::prefetch(const ChunkInfo & ci) const
+{
+    _file->prefetch(ci.getOffset(), ci.getSize());
+}
+
 ssize_t
 FileChunk::read(uint32_t lid, SubChunkId chunkId,
                 vespalib::DataBuffer & buffer) const
@@ -409,10 +472,26 @@ ssize_t
 FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
                 vespalib::DataBuffer & buffer) const
 {
+    return readChunk(chunkId, chunkInfo)->read(lid, buffer);
+}
+
+std::unique_ptr<Chunk>
+FileChunk::readChunk(SubChunkId chunkId, const ChunkInfo & chunkInfo) const
+{
+    docstore::ChunkCache::Key key(_nameId.getId(), chunkId);
+    if (_chunkCache != nullptr) {
+        docstore::ChunkCache::Value::Buffer cached = _chunkCache->lookup(key);
+        if (cached) {
+            return std::make_unique<Chunk>(chunkId, cached->getData(), cached->getDataLen(), _skipCrcOnRead, _dictionary.get());
+        }
+    }
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
-    return chunk.read(lid, buffer);
+    auto chunk = std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+    if (_chunkCache != nullptr) {
+        _chunkCache->offer(key, whole.getData(), whole.getDataLen());
+    }
+    return chunk;
 }
 
 uint64_t
@@ -473,6 +552,36 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::ZStdDictionarySP
+FileChunk::readDictionary(FileRandRead &datFile, uint32_t dataHeaderLen)
+{
+    vespalib::DataBuffer h(dataHeaderLen, ALIGNMENT);
+    datFile.read(0, h, dataHeaderLen);
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    return readDictionary(header);
+}
+
+FileChunk::ZStdDictionarySP
+FileChunk::readDictionary(const vespalib::GenericHeader &header)
+{
+    if ( ! header.hasTag(DICTIONARY_KEY)) {
+        return ZStdDictionarySP();
+    }
+    std::string raw = vespalib::Base64::decode(header.getTag(DICTIONARY_KEY).asString());
+    int level = header.getTag(DICTIONARY_LEVEL_KEY).asInteger();
+    return std::make_shared<ZStdDictionary>(vespalib::ConstBufferRef(raw.data(), raw.size()), level);
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary)
+{
+    vespalib::ConstBufferRef raw = dictionary.getRaw();
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_KEY, vespalib::Base64::encode(raw.c_str(), raw.size())));
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_LEVEL_KEY, int64_t(dictionary.getCompressionLevel())));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -487,7 +596,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -20,6 +20,11 @@ namespace vespalib {
     class GenericHeader;
     class ThreadExecutor;
 }
+namespace vespalib::compression { class ZStdDictionary; }
+namespace search::docstore {
+    class ChunkCache;
+    class CompactionThrottle;
+}
 
 namespace search {
 
@@ -105,6 +110,8 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
+    using ZStdDictionarySP = std::shared_ptr<const ZStdDictionary>;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -112,6 +119,10 @@ public:
     virtual size_t updateLidMap(const unique_lock &guard, ISetLid &lidMap, uint64_t serialNum, uint32_t docIdLimit);
     virtual ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const;
     virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
+    /**
+     * Hints that the chunks holding the given lids will be read soon. Lids must be ordered by chunk.
+     */
+    virtual void prefetch(LidInfoWithLidV::const_iterator begin, size_t count) const;
     void remove(uint32_t lid, uint32_t size);
     virtual size_t getDiskFootprint() const { return _diskFootprint; }
     virtual size_t getMemoryFootprint() const;
@@ -159,12 +170,23 @@ public:
     size_t   getErasedBytes() const { return _erasedBytes; }
     uint64_t getLastPersistedSerialNum() const;
     uint32_t getDocIdLimit() const { return _docIdLimit; }
+    /**
+     * The dictionary stored in the '.dat' file header that ZSTD compressed chunks in this file
+     * are compressed with, if any.
+     */
+    const ZStdDictionarySP & getDictionary() const { return _dictionary; }
+    /**
+     * Compressed chunks read from disk are looked up in and offered to the given cache.
+     * Must be set before any read, and the cache must outlive this file chunk.
+     */
+    void setChunkCache(docstore::ChunkCache * chunkCache) { _chunkCache = chunkCache; }
     virtual vespalib::system_time getModificationTime() const;
     virtual bool frozen() const { return true; }
     const vespalib::string & getName() const { return _name; }
     void compact(const IGetLid & iGetLid);
     void appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWriteData & dest,
-                  uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress);
+                  uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
+                  docstore::CompactionThrottle *throttle = nullptr);
     /**
      * Must be called after chunk has been created to allow correct
      * underlying file object to be created.  Must be called before
@@ -235,8 +257,14 @@ protected:
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    void prefetch(const ChunkInfo & ci) const;
+    std::unique_ptr<Chunk> readChunk(SubChunkId chunkId, const ChunkInfo & chunkInfo) const;
+    static void visitLids(const Chunk & chunk, LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor);
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static ZStdDictionarySP readDictionary(FileRandRead &datFile, uint32_t dataHeaderLen);
+    static ZStdDictionarySP readDictionary(const vespalib::GenericHeader &header);
+    static void writeDictionary(vespalib::GenericHeader &header, const ZStdDictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer   * _bucketizer;
@@ -250,6 +278,8 @@ protected:
     uint32_t              _idxHeaderLen;
     uint32_t              _numLids;
     uint32_t              _docIdLimit; // Limit when the file was created. Stored in idx file header.
+    ZStdDictionarySP      _dictionary; // Stored in dat file header.
+    docstore::ChunkCache *_chunkCache;
     vespalib::system_time  _modificationTime;
 };
 
@@ -14,4 +14,15 @@ IDataStore::~IDataStore()
 {
 }
 
+void
+IDataStore::prefetch(const LidVector &) const
+{
+}
+
+std::shared_ptr<const vespalib::compression::ZStdDictionary>
+IDataStore::getCompressionDictionary() const
+{
+    return std::shared_ptr<const vespalib::compression::ZStdDictionary>();
+}
+
 } // namespace search
@@ -10,6 +10,7 @@
 #include <vector>
 
 namespace vespalib { class DataBuffer; }
+namespace vespalib::compression { class ZStdDictionary; }
 namespace search {
 
 class IBufferVisitor;
@@ -62,6 +63,13 @@ public:
     virtual ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const = 0;
     virtual void read(const LidVector & lids, IBufferVisitor & visitor) const = 0;
 
+    /**
+     * Hint that the given lids will be read soon. Implementations backed by files can use this
+     * to let the disk fetch the data for all of them in parallel before they are read one by one.
+     * @param lids The local IDs that will be read.
+     **/
+    virtual void prefetch(const LidVector & lids) const;
+
     /**
      * Write data to the data store.
      * @param serialNum The official unique reference number for this operation.
@@ -127,6 +135,13 @@ public:
      */
     virtual size_t getMaxCompactGain() const { return getDiskBloat(); }
 
+    /**
+     * The dictionary currently used when ZSTD compressing new data, if any.
+     * Data compressed with it can be decompressed as long as the dictionary is kept alive.
+     * @return the dictionary, or an empty pointer if none is used.
+     */
+    virtual std::shared_ptr<const vespalib::compression::ZStdDictionary> getCompressionDictionary() const;
+
 
     /**
      * The sync token used for the last successful flush() operation,
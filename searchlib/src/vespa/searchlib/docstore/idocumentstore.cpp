@@ -15,4 +15,6 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+void IDocumentStore::prefetch(const LidVector &) const { }
+
 } // namespace search
@@ -87,6 +87,12 @@ public:
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
+    /**
+     * Hint that the documents with the given lids will be read soon, so that fetching
+     * them from disk can start for all of them at once.
+     **/
+    virtual void prefetch(const LidVector & lidVector) const;
+
     /**
      * Serialize and store a document.
      * @param doc The document to store
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "storebybucket.h"
+#include "chunk_cache.h"
 #include "compacter.h"
 #include "logdatastore.h"
 #include <vespa/vespalib/stllike/asciistream.h>
@@ -41,6 +42,9 @@ LogDataStore::Config::Config()
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
       _skipCrcOnRead(false),
       _compactCompression(CompressionConfig::LZ4),
+      _maxConcurrentCompactions(1),
+      _maxCompactionBytesPerSecond(0),
+      _chunkCacheBytes(0),
       _fileConfig()
 { }
 
@@ -52,6 +56,9 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
+            (_maxConcurrentCompactions == rhs._maxConcurrentCompactions) &&
+            (_maxCompactionBytesPerSecond == rhs._maxCompactionBytesPerSecond) &&
+            (_chunkCacheBytes == rhs._chunkCacheBytes) &&
             (_fileConfig == rhs._fileConfig);
 }
 
@@ -63,6 +70,7 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _config(config),
       _tune(tune),
       _fileHeaderContext(fileHeaderContext),
+      _chunkCache(std::make_unique<docstore::ChunkCache>(config.getChunkCacheBytes())),
       _genHandler(),
       _lidInfo(growStrategy.getDocsInitialCapacity(),
                growStrategy.getDocsGrowPercent(),
@@ -77,7 +85,8 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _tlSyncer(tlSyncer),
       _bucketizer(std::move(bucketizer)),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _compactionThrottle(config.getMaxCompactionBytesPerSecond())
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
@@ -90,6 +99,14 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
 
 void LogDataStore::reconfigure(const Config & config) {
     _config = config;
+    _compactionThrottle.setMaxBytesPerSecond(config.getMaxCompactionBytesPerSecond());
+    _chunkCache->setCapacityBytes(config.getChunkCacheBytes());
+}
+
+CacheStats
+LogDataStore::getChunkCacheStats() const
+{
+    return _chunkCache->getCacheStats();
 }
 
 void
@@ -126,11 +143,10 @@ LogDataStore::updateLidMap(uint32_t lastFileChunkDocIdLimit)
     }
 }
 
-void
-LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
+LidInfoWithLidV
+LogDataStore::getOrderedLids(const LidVector & lids) const
 {
     LidInfoWithLidV orderedLids;
-    GenerationHandler::Guard guard(_genHandler.takeGuard());
     for (uint32_t lid : lids) {
         if (lid < getDocIdLimit()) {
             LidInfo li = _lidInfo[lid];
@@ -139,22 +155,47 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
             }
         }
     }
+    std::sort(orderedLids.begin(), orderedLids.end());
+    return orderedLids;
+}
+
+template <typename Func>
+void
+LogDataStore::forEachFileChunk(const LidInfoWithLidV & orderedLids, Func func) const
+{
     if (orderedLids.empty()) { return; }
 
-    std::sort(orderedLids.begin(), orderedLids.end());
     uint32_t prevFile = orderedLids[0].getFileId();
     uint32_t start = 0;
     for (size_t curr(1); curr < orderedLids.size(); curr++) {
         const LidInfoWithLid & li = orderedLids[curr];
         if (prevFile != li.getFileId()) {
-            const FileChunk & fc(*_fileChunks[prevFile]);
-            fc.read(orderedLids.begin() + start, curr - start, visitor);
+            func(*_fileChunks[prevFile], orderedLids.begin() + start, curr - start);
             start = curr;
             prevFile = li.getFileId();
         }
     }
-    const FileChunk & fc(*_fileChunks[prevFile]);
-    fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor);
+    func(*_fileChunks[prevFile], orderedLids.begin() + start, orderedLids.size() - start);
+}
+
+void
+LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
+{
+    GenerationHandler::Guard guard(_genHandler.takeGuard());
+    LidInfoWithLidV orderedLids = getOrderedLids(lids);
+    forEachFileChunk(orderedLids, [&visitor](const FileChunk & fc, LidInfoWithLidV::const_iterator begin, size_t count) {
+        fc.read(begin, count, visitor);
+    });
+}
+
+void
+LogDataStore::prefetch(const LidVector & lids) const
+{
+    GenerationHandler::Guard guard(_genHandler.takeGuard());
+    LidInfoWithLidV orderedLids = getOrderedLids(lids);
+    forEachFileChunk(orderedLids, [](const FileChunk & fc, LidInfoWithLidV::const_iterator begin, size_t count) {
+        fc.prefetch(begin, count);
+    });
 }
 
 ssize_t
@@ -211,7 +252,11 @@ LogDataStore::requireSpace(MonitorGuard guard, WriteableFileChunk & active)
               active.getName().c_str(), oldSz, _config.getMaxFileSize(), active.getNumLids(), _config.getMaxNumLids());
     if ((oldSz > _config.getMaxFileSize()) || (active.getNumLids() >= _config.getMaxNumLids())) {
         FileId fileId = allocateFileId(guard);
-        setNewFileChunk(guard, createWritableFile(fileId, active.getSerialNum()));
+        FileChunk::ZStdDictionarySP dictionary = active.getTrainedDictionary();
+        if ( ! dictionary) {
+            dictionary = active.getDictionary();
+        }
+        setNewFileChunk(guard, createWritableFile(fileId, active.getSerialNum(), std::move(dictionary)));
         setActive(guard, fileId);
         std::unique_ptr<FileChunkHolder> activeHolder = holdFileChunk(active.getFileId());
         guard.unlock();
@@ -422,9 +467,26 @@ LogDataStore::findNextToCompact(double bloatLimit, double spreadLimit, bool prio
 
 void
 LogDataStore::compactWorst(double bloatLimit, double spreadLimit, bool prioritizeDiskBloat) {
-    auto worst = findNextToCompact(bloatLimit, spreadLimit, prioritizeDiskBloat);
-    if (worst.first) {
-        compactFile(worst.second);
+    std::vector<FileId> worst;
+    const uint32_t maxConcurrent = std::max(1u, _config.getMaxConcurrentCompactions());
+    while (worst.size() < maxConcurrent) {
+        auto next = findNextToCompact(bloatLimit, spreadLimit, prioritizeDiskBloat);
+        if ( ! next.first) {
+            break;
+        }
+        worst.push_back(next.second);
+    }
+    if (worst.empty()) {
+        return;
+    }
+    // The compactions share the executor for reading chunks and the throttle for limiting disk reads
+    std::vector<std::thread> helpers;
+    for (size_t i(1); i < worst.size(); i++) {
+        helpers.emplace_back([this, fileId = worst[i]]() { compactFile(fileId); });
+    }
+    compactFile(worst[0]);
+    for (std::thread & helper : helpers) {
+        helper.join();
     }
 }
 
@@ -481,7 +543,8 @@ void LogDataStore::compactFile(FileId fileId)
         if ( ! shouldCompactToActiveFile(fc->getDiskFootprint() - fc->getDiskBloat())) {
             MonitorGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
-            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
+            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(),
+                                                      fc->getNameId().next(), fc->getDictionary()));
         }
         size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
         compacter = std::make_unique<BucketCompacter>(numSignificantBucketBits, _config.compactCompression(), *this, _executor,
@@ -490,7 +553,7 @@ void LogDataStore::compactFile(FileId fileId)
         compacter = std::make_unique<docstore::Compacter>(*this);
     }
 
-    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), nullptr);
+    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), nullptr, &_compactionThrottle);
 
     if (destinationFileId.isActive()) {
         flushActiveAndWait(0);
@@ -591,6 +654,13 @@ LogDataStore::getDiskFootprint() const
 }
 
 
+std::shared_ptr<const vespalib::compression::ZStdDictionary>
+LogDataStore::getCompressionDictionary() const
+{
+    MonitorGuard guard(_updateLock);
+    return getActive(guard).getDictionary();
+}
+
 size_t
 LogDataStore::getDiskHeaderFootprint() const
 {
@@ -640,12 +710,14 @@ FileChunk::UP
 LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
     FileChunk::UP file(new FileChunk(fileId, nameId, getBaseDir(), _tune,
                                      _bucketizer.get(), _config.crcOnReadDisabled()));
+    file->setChunkCache(_chunkCache.get());
     file->enableRead();
     return file;
 }
 
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                 FileChunk::ZStdDictionarySP dictionary)
 {
     for (const auto & fc : _fileChunks) {
         if (fc && (fc->getNameId() == nameId)) {
@@ -658,15 +730,18 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     FileChunk::UP file(new WriteableFileChunk(_executor, fileId, nameId, getBaseDir(),
                                               serialNum, docIdLimit,
                                               _config.getFileConfig(), _tune, _fileHeaderContext,
-                                              _bucketizer.get(), _config.crcOnReadDisabled()));
+                                              _bucketizer.get(), _config.crcOnReadDisabled(),
+                                              std::move(dictionary)));
+    file->setChunkCache(_chunkCache.get());
     file->enableRead();
     return file;
 }
 
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, FileChunk::ZStdDictionarySP dictionary)
 {
-    return createWritableFile(fileId, serialNum, NameId(vespalib::system_clock::now().time_since_epoch().count()));
+    return createWritableFile(fileId, serialNum, NameId(vespalib::system_clock::now().time_since_epoch().count()),
+                              std::move(dictionary));
 }
 
 namespace {
@@ -793,10 +868,11 @@ LogDataStore::preload()
         }
         _fileChunks.push_back(isReadOnly()
             ? createReadOnlyFile(FileId(_fileChunks.size()), *partList.rbegin())
-            : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin()));
+            : createWritableFile(FileId(_fileChunks.size()), getMinLastPersistedSerialNum(), *partList.rbegin(),
+                                 FileChunk::ZStdDictionarySP()));
     } else {
         if ( ! isReadOnly() ) {
-            _fileChunks.push_back(createWritableFile(FileId::first(), 0));
+            _fileChunks.push_back(createWritableFile(FileId::first(), 0, FileChunk::ZStdDictionarySP()));
         } else {
             throw vespalib::IllegalArgumentException(getBaseDir() + " does not have any summary data... And that is no good in readonly case.");
         }
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "cachestats.h"
+#include "compaction_throttle.h"
 #include "idatastore.h"
 #include "lid_info.h"
 #include "writeablefilechunk.h"
@@ -46,7 +48,10 @@ public:
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
+        Config & setMaxConcurrentCompactions(uint32_t v) { _maxConcurrentCompactions = v; return *this; }
+        Config & setMaxCompactionBytesPerSecond(size_t v) { _maxCompactionBytesPerSecond = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
+        Config & setChunkCacheBytes(size_t v) { _chunkCacheBytes = v; return *this; }
 
         size_t getMaxFileSize() const { return _maxFileSize; }
         double getMaxDiskBloatFactor() const { return _maxDiskBloatFactor; }
@@ -56,6 +61,9 @@ public:
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         const CompressionConfig & compactCompression() const { return _compactCompression; }
+        uint32_t getMaxConcurrentCompactions() const { return _maxConcurrentCompactions; }
+        size_t getMaxCompactionBytesPerSecond() const { return _maxCompactionBytesPerSecond; }
+        size_t getChunkCacheBytes() const { return _chunkCacheBytes; }
 
         const WriteableFileChunk::Config & getFileConfig() const { return _fileConfig; }
         Config & disableCrcOnRead(bool v) { _skipCrcOnRead = v; return *this;}
@@ -69,6 +77,9 @@ public:
         uint32_t                    _maxNumLids;
         bool                        _skipCrcOnRead;
         CompressionConfig           _compactCompression;
+        uint32_t                    _maxConcurrentCompactions;
+        size_t                      _maxCompactionBytesPerSecond;
+        size_t                      _chunkCacheBytes;
         WriteableFileChunk::Config  _fileConfig;
     };
 public:
@@ -97,6 +108,7 @@ public:
     // Implements IDataStore API
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const override;
     void read(const LidVector & lids, IBufferVisitor & visitor) const override;
+    void prefetch(const LidVector & lids) const override;
     void write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) override;
     void remove(uint64_t serialNum, uint32_t lid) override;
     void flush(uint64_t syncToken) override;
@@ -110,14 +122,17 @@ public:
     size_t getDiskHeaderFootprint() const override;
     size_t getDiskBloat() const override;
     size_t getMaxCompactGain() const override;
+    std::shared_ptr<const vespalib::compression::ZStdDictionary> getCompressionDictionary() const override;
 
     /**
      * Will compact the docsummary up to a lower limit of 5% bloat.
+     * Up to the configured number of files, worst first, are compacted concurrently.
      */
     void compact(uint64_t syncToken);
 
     const Config & getConfig() const { return _config; }
     Config & getConfig() { return _config; }
+    CacheStats getChunkCacheStats() const;
 
     void write(MonitorGuard guard, WriteableFileChunk & destination, uint64_t serialNum, uint32_t lid, const void * buffer, size_t len);
     void write(MonitorGuard guard, FileId destinationFileId, uint32_t lid, const void * buffer, size_t len);
@@ -190,6 +205,14 @@ private:
     // Implements ISetLid API
     void setLid(const ISetLid::unique_lock & guard, uint32_t lid, const LidInfo & lm) override;
 
+    /**
+     * Returns the valid lids among the given ones, ordered by file and chunk.
+     * The caller must hold a generation guard while the result is in use.
+     */
+    LidInfoWithLidV getOrderedLids(const LidVector & lids) const;
+    template <typename Func>
+    void forEachFileChunk(const LidInfoWithLidV & orderedLids, Func func) const;
+
     void compactWorst(double bloatLimit, double spreadLimit, bool prioritizeDiskBloat);
     void compactFile(FileId chunkId);
 
@@ -236,8 +259,9 @@ private:
     double getMaxBucketSpread() const;
 
     FileChunk::UP createReadOnlyFile(FileId fileId, NameId nameId);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, FileChunk::ZStdDictionarySP dictionary);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                     FileChunk::ZStdDictionarySP dictionary);
     vespalib::string createFileName(NameId id) const;
     vespalib::string createDatFileName(NameId id) const;
     vespalib::string createIdxFileName(NameId id) const;
@@ -275,6 +299,7 @@ private:
     Config                                   _config;
     TuneFileSummary                          _tune;
     const search::common::FileHeaderContext &_fileHeaderContext;
+    std::unique_ptr<docstore::ChunkCache>    _chunkCache; // Must outlive the file chunks
     mutable vespalib::GenerationHandler      _genHandler;
     LidInfoVector                            _lidInfo;
     FileChunkVector                          _fileChunks;
@@ -289,6 +314,7 @@ private:
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    docstore::CompactionThrottle             _compactionThrottle;
 };
 
 } // namespace search
@@ -18,6 +18,11 @@ public:
     typedef std::shared_ptr<FastOS_FileInterface> FSP;
     virtual ~FileRandRead() { }
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Hints that the given range will be read soon, so the kernel can start fetching it
+     * from disk without blocking the caller.
+     */
+    virtual void prefetch(size_t offset, size_t sz) = 0;
     virtual int64_t getSize() = 0;
 };
 
@@ -47,6 +47,11 @@ DirectIORandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+DirectIORandRead::prefetch(size_t offset, size_t sz)
+{
+    _file->prefetch(offset, sz);
+}
 
 int64_t
 DirectIORandRead::getSize()
@@ -84,6 +89,12 @@ MMapRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+MMapRandRead::prefetch(size_t offset, size_t sz)
+{
+    _file->prefetch(offset, sz);
+}
+
 int64_t
 MMapRandRead::getSize() {
     return _file->GetSize();
@@ -140,6 +151,13 @@ MMapRandReadDynamic::read(size_t offset, vespalib::DataBuffer & buffer, size_t s
     return file;
 }
 
+void
+MMapRandReadDynamic::prefetch(size_t offset, size_t sz)
+{
+    FSP file(_holder.get());
+    file->prefetch(offset, sz);
+}
+
 bool
 MMapRandReadDynamic::contains(const FastOS_FileInterface & file, size_t sz) {
     return (sz == 0) || (file.MemoryMapPtr(sz - 1) != nullptr);
@@ -161,6 +179,12 @@ NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+NormalRandRead::prefetch(size_t offset, size_t sz)
+{
+    _file->prefetch(offset, sz);
+}
+
 int64_t
 NormalRandRead::getSize()
 {
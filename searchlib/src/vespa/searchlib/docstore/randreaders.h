@@ -15,6 +15,7 @@ class DirectIORandRead : public FileRandRead
 public:
     DirectIORandRead(const vespalib::string & fileName);
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void prefetch(size_t offset, size_t sz) override;
     int64_t getSize() override;
 private:
     std::unique_ptr<FastOS_FileInterface>  _file;
@@ -28,6 +29,7 @@ class MMapRandRead : public FileRandRead
 public:
     MMapRandRead(const vespalib::string & fileName, int mmapFlags, int fadviseOptions);
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void prefetch(size_t offset, size_t sz) override;
     int64_t getSize() override;
     const void * getMapping();
 private:
@@ -39,6 +41,7 @@ class MMapRandReadDynamic : public FileRandRead
 public:
     MMapRandReadDynamic(const vespalib::string & fileName, int mmapFlags, int fadviseOptions);
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void prefetch(size_t offset, size_t sz) override;
     int64_t getSize() override;
 private:
     static bool contains(const FastOS_FileInterface & file, size_t sz);
@@ -55,6 +58,7 @@ class NormalRandRead : public FileRandRead
 public:
     NormalRandRead(const vespalib::string & fileName);
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void prefetch(size_t offset, size_t sz) override;
     int64_t getSize() override;
 private:
     std::unique_ptr<FastOS_FileInterface>  _file;
@@ -75,7 +75,8 @@ BlobSet::get(uint32_t lid) const
 CompressedBlobSet::CompressedBlobSet() :
     _compression(CompressionConfig::Type::LZ4),
     _positions(),
-    _buffer()
+    _buffer(),
+    _dictionary()
 {
 }
 
@@ -83,14 +84,24 @@ CompressedBlobSet::~CompressedBlobSet() = default;
 
 
 CompressedBlobSet::CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed) :
+    CompressedBlobSet(compression, uncompressed, ZStdDictionarySP())
+{
+}
+
+CompressedBlobSet::CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed,
+                                     ZStdDictionarySP dictionary) :
     _compression(compression.type),
     _positions(uncompressed.getPositions()),
-    _buffer()
+    _buffer(),
+    _dictionary()
 {
     if ( ! _positions.empty() ) {
         DataBuffer compressed;
         ConstBufferRef org = uncompressed.getBuffer();
-        _compression = vespalib::compression::compress(compression, org, compressed, false);
+        _compression = vespalib::compression::compress(compression, org, compressed, false, dictionary.get());
+        if (_compression == CompressionConfig::ZSTD) {
+            _dictionary = std::move(dictionary);
+        }
         _buffer = std::make_shared<vespalib::MallocPtr>(compressed.getDataLen());
         memcpy(*_buffer, compressed.getData(), compressed.getDataLen());
     } else {
@@ -106,7 +117,7 @@ CompressedBlobSet::getBlobSet() const
     DataBuffer uncompressed(0, 1, Alloc::alloc(0, 16 * MemoryAllocator::HUGEPAGE_SIZE));
     if ( ! _positions.empty() ) {
         decompress(_compression, getBufferSize(_positions),
-                   ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false);
+                   ConstBufferRef(_buffer->c_str(), _buffer->size()), uncompressed, false, _dictionary.get());
     }
     return BlobSet(_positions, std::move(uncompressed).stealBuffer());
 }
@@ -142,7 +153,7 @@ bool
 VisitCache::BackingStore::read(const KeySet &key, CompressedBlobSet &blobs) const {
     VisitCollector collector;
     _backingStore.read(key.getKeys(), collector);
-    blobs = CompressedBlobSet(_compression, collector.getBlobSet());
+    blobs = CompressedBlobSet(_compression, collector.getBlobSet(), _backingStore.getCompressionDictionary());
     return ! blobs.empty();
 }
 
@@ -13,6 +13,8 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/util/bytebuffer.h>
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search::docstore {
 
 /**
@@ -75,8 +77,13 @@ private:
 class CompressedBlobSet {
 public:
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     CompressedBlobSet();
     CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed);
+    /**
+     * The dictionary is kept alive for as long as the set, and used for ZSTD compression if present.
+     */
+    CompressedBlobSet(const CompressionConfig &compression, const BlobSet & uncompressed, ZStdDictionarySP dictionary);
     CompressedBlobSet(CompressedBlobSet && rhs) = default;
     CompressedBlobSet & operator=(CompressedBlobSet && rhs) = default;
     CompressedBlobSet(const CompressedBlobSet & rhs) = default;
@@ -89,6 +96,7 @@ private:
     CompressionConfig::Type _compression;
     BlobSet::Positions      _positions;
     std::shared_ptr<vespalib::MallocPtr> _buffer;
+    ZStdDictionarySP        _dictionary;
 };
 
 /**
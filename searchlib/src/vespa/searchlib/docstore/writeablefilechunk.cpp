@@ -10,6 +10,7 @@
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.writeablefilechunk");
@@ -28,6 +29,8 @@ namespace {
 
 const uint64_t Alignment = 4096;
 const uint64_t headerAlign = 4096;
+// zstd recommends around 100 times as much sample data as the dictionary size.
+const size_t dictionarySamplesFactor = 100;
 
 }
 
@@ -81,7 +84,8 @@ WriteableFileChunk(vespalib::Executor &executor,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
-                   bool skipCrcOnRead)
+                   bool skipCrcOnRead,
+                   ZStdDictionarySP dictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer, skipCrcOnRead),
       _config(config),
       _serialNum(initialSerialNum),
@@ -107,7 +111,11 @@ WriteableFileChunk(vespalib::Executor &executor,
       _writeMonitor(),
       _writeCond(),
       _executor(executor),
-      _bucketMap(bucketizer)
+      _bucketMap(bucketizer),
+      _dictionarySamples(),
+      _dictionarySampleSizes(),
+      _dictionarySampled(! config.useDictionary()),
+      _trainedDictionary()
 {
     _docIdLimit = docIdLimit;
     if (tune._write.getWantDirectIO()) {
@@ -119,6 +127,9 @@ WriteableFileChunk(vespalib::Executor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
+            if (config.getCompression().type == vespalib::compression::CompressionConfig::ZSTD) {
+                _dictionary = std::move(dictionary);
+            }
             writeDataHeader(fileHeaderContext);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
@@ -256,6 +267,34 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
     }
 }
 
+void
+WriteableFileChunk::prefetch(LidInfoWithLidV::const_iterator begin, size_t count) const
+{
+    if (count == 0) { return; }
+    if (!frozen()) {
+        // Chunks not yet on file are served from memory, so only those already written are prefetched.
+        std::vector<ChunkInfo> chunksOnFile;
+        {
+            std::lock_guard guard(_lock);
+            uint32_t prevChunk = std::numeric_limits<uint32_t>::max();
+            for (size_t i(0); i < count; i++) {
+                uint32_t chunk = (begin + i)->getChunkId();
+                if (chunk != prevChunk) {
+                    if ((chunk < _chunkInfo.size()) && _chunkInfo[chunk].valid()) {
+                        chunksOnFile.push_back(_chunkInfo[chunk]);
+                    }
+                    prevChunk = chunk;
+                }
+            }
+        }
+        for (const ChunkInfo & ci : chunksOnFile) {
+            FileChunk::prefetch(ci);
+        }
+    } else {
+        FileChunk::prefetch(begin, count);
+    }
+}
+
 ssize_t
 WriteableFileChunk::read(uint32_t lid, SubChunkId chunkId, vespalib::DataBuffer & buffer) const
 {
@@ -291,7 +330,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
-    active->pack(serialNum, tmp->getBuf(), _config.getCompression());
+    active->pack(serialNum, tmp->getBuf(), _config.getCompression(), _dictionary.get());
     tmp->setPayLoad();
     if (_alignment > 1) {
         const size_t padAfter((_alignment - tmp->getPayLoad() % _alignment) % _alignment);
@@ -302,9 +341,55 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
         std::lock_guard innerGuard(_lock);
         setDiskFootprint(FileChunk::getDiskFootprint() + tmp->getBuf().getDataLen());
     }
+    sampleForDictionary(*active);
     enque(std::move(tmp));
 }
 
+void
+WriteableFileChunk::sampleForDictionary(const Chunk & chunk)
+{
+    std::vector<char> samples;
+    std::vector<size_t> sampleSizes;
+    {
+        std::lock_guard guard(_lock);
+        if (_dictionarySampled) {
+            return;
+        }
+        const size_t wanted = _config.getDictionarySize() * dictionarySamplesFactor;
+        const vespalib::nbostream & data = chunk.getData();
+        for (const Chunk::Entry & e : chunk.getLids()) {
+            if (e.netSize() > 0) {
+                const char * sample = data.data() + e.getNetOffset();
+                _dictionarySamples.insert(_dictionarySamples.end(), sample, sample + e.netSize());
+                _dictionarySampleSizes.push_back(e.netSize());
+            }
+        }
+        if (_dictionarySamples.size() < wanted) {
+            return;
+        }
+        _dictionarySampled = true;
+        samples.swap(_dictionarySamples);
+        sampleSizes.swap(_dictionarySampleSizes);
+    }
+    auto trained = ZStdDictionary::train(vespalib::ConstBufferRef(samples.data(), samples.size()), sampleSizes,
+                                         _config.getDictionarySize(), _config.getCompression().compressionLevel);
+    if (trained) {
+        LOG(debug, "Trained dictionary of %zu bytes from %zu documents in file %s",
+                   trained->getRaw().size(), sampleSizes.size(), getName().c_str());
+    } else {
+        LOG(warning, "Failed training dictionary from %zu documents in file %s", sampleSizes.size(), getName().c_str());
+    }
+    std::lock_guard guard(_lock);
+    _trainedDictionary = std::move(trained);
+}
+
+FileChunk::ZStdDictionarySP
+WriteableFileChunk::getTrainedDictionary() const
+{
+    std::lock_guard guard(_lock);
+    return _trainedDictionary;
+}
+
 void
 WriteableFileChunk::enque(ProcessedChunkUP tmp)
 {
@@ -724,6 +809,7 @@ WriteableFileChunk::readDataHeader()
         FileHeader h;
         _dataHeaderLen = h.readFile(_dataFile);
         _dataFile.SetPosition(_dataHeaderLen);
+        _dictionary = readDictionary(h);
     } catch (IllegalHeaderException &e) {
         _dataFile.SetPosition(0);
         try {
@@ -790,6 +876,9 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    if (_dictionary) {
+        writeDictionary(h, *_dictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
@@ -27,18 +27,33 @@ public:
         Config() : Config({CompressionConfig::LZ4, 9, 60}, 0x10000) { }
 
         Config(const CompressionConfig &compression, size_t maxChunkBytes)
+            : Config(compression, maxChunkBytes, 0)
+        { }
+        /**
+         * @param dictionarySize Max size of the zstd dictionary trained from the documents written
+         *                       to a file, and used for compressing the chunks of the next file.
+         *                       0 disables dictionary compression.
+         */
+        Config(const CompressionConfig &compression, size_t maxChunkBytes, size_t dictionarySize)
             : _compression(compression),
-              _maxChunkBytes(maxChunkBytes)
+              _maxChunkBytes(maxChunkBytes),
+              _dictionarySize(dictionarySize)
         { }
 
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxChunkBytes() const { return _maxChunkBytes; }
+        size_t getDictionarySize() const { return _dictionarySize; }
+        bool useDictionary() const {
+            return (_dictionarySize > 0) && (_compression.type == CompressionConfig::ZSTD);
+        }
         bool operator == (const Config & rhs) const {
-            return (_compression == rhs._compression) && (_maxChunkBytes == rhs._maxChunkBytes);
+            return (_compression == rhs._compression) && (_maxChunkBytes == rhs._maxChunkBytes) &&
+                   (_dictionarySize == rhs._dictionarySize);
         }
     private:
         CompressionConfig _compression;
         size_t _maxChunkBytes;
+        size_t _dictionarySize;
     };
 
 public:
@@ -47,11 +62,13 @@ public:
                        const vespalib::string & baseName, uint64_t initialSerialNum,
                        uint32_t docIdLimit, const Config & config,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
-                       const IBucketizer * bucketizer, bool crcOnReadDisabled);
+                       const IBucketizer * bucketizer, bool crcOnReadDisabled,
+                       ZStdDictionarySP dictionary = ZStdDictionarySP());
     ~WriteableFileChunk() override;
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const override;
+    void prefetch(LidInfoWithLidV::const_iterator begin, size_t count) const override;
 
     LidInfo append(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len);
     void flush(bool block, uint64_t syncToken);
@@ -68,6 +85,11 @@ public:
     void waitForDiskToCatchUpToNow() const;
     void flushPendingChunks(uint64_t serialNum);
     DataStoreFileChunkStats getStats() const override;
+    /**
+     * Returns the dictionary trained from the documents written to this file so far, if enough
+     * of them have been sampled. Intended for compressing the next file.
+     */
+    ZStdDictionarySP getTrainedDictionary() const;
 
     static uint64_t writeIdxHeader(const common::FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file);
 private:
@@ -89,6 +111,7 @@ private:
     void readDataHeader();
     void readIdxHeader(FastOS_FileInterface & idxFile);
     void writeDataHeader(const common::FileHeaderContext &fileHeaderContext);
+    void sampleForDictionary(const Chunk & chunk);
     bool needFlushPendingChunks(uint64_t serialNum, uint64_t datFileLen);
     bool needFlushPendingChunks(const unique_lock & guard, uint64_t serialNum, uint64_t datFileLen);
     vespalib::system_time unconditionallyFlushPendingChunks(const unique_lock & flushGuard, uint64_t serialNum, uint64_t datFileLen);
@@ -134,6 +157,11 @@ private:
     vespalib::Executor  & _executor;
     ProcessedChunkMap     _orderedChunks;
     BucketDensityComputer _bucketMap;
+    // Documents sampled for training a dictionary, protected by _lock.
+    std::vector<char>     _dictionarySamples;
+    std::vector<size_t>   _dictionarySampleSizes;
+    bool                  _dictionarySampled;
+    ZStdDictionarySP      _trainedDictionary;
 };
 
 } // namespace search
@@ -4,12 +4,35 @@
 #include <vespa/searchlib/common/mapnames.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/slime/binary_format.h>
-#include <vespa/vespalib/data/smart_buffer.h>
+#include <vespa/vespalib/data/output.h>
 
 namespace search::engine {
 
 namespace {
 
+/**
+ * Output writing directly into a protobuf string field, used to avoid
+ * an intermediate buffer when encoding slime.
+ **/
+class StringOutput : public vespalib::Output {
+private:
+    std::string &_str;
+    size_t       _used;
+public:
+    explicit StringOutput(std::string &str) : _str(str), _used(0) { _str.clear(); }
+    ~StringOutput() override { _str.resize(_used); }
+    vespalib::WritableMemory reserve(size_t bytes) override {
+        if (_str.size() < (_used + bytes)) {
+            _str.resize(std::max(_used + bytes, 2 * _str.size()));
+        }
+        return vespalib::WritableMemory(&_str[_used], _str.size() - _used);
+    }
+    Output &commit(size_t bytes) override {
+        _used += bytes;
+        return *this;
+    }
+};
+
 template <typename T>
 vespalib::string make_sort_spec(const T &sorting) {
     vespalib::string spec;
@@ -149,9 +172,8 @@ void
 ProtoConverter::docsum_reply_to_proto(const DocsumReply &reply, ProtoDocsumReply &proto)
 {
     if (reply._root) {
-        vespalib::SmartBuffer buf(4096);
-        vespalib::slime::BinaryFormat::encode(*reply._root, buf);
-        proto.set_slime_summaries(buf.obtain().data, buf.obtain().size);
+        StringOutput output(*proto.mutable_slime_summaries());
+        vespalib::slime::BinaryFormat::encode(*reply._root, output);
     }
 }
 
@@ -17,6 +17,7 @@ LOG_SETUP(".engine.proto_rpc_adapter");
 namespace search::engine {
 
 using vespalib::DataBuffer;
+using vespalib::alloc::Alloc;
 using vespalib::ConstBufferRef;
 using vespalib::compression::CompressionConfig;
 using ProtoSearchRequest = ProtoConverter::ProtoSearchRequest;
@@ -36,32 +37,36 @@ CompressionConfig get_compression_config() {
     return CompressionConfig(streamer.getCompressionType(), streamer.getCompressionLevel(), 80, streamer.getCompressionLimit());
 }
 
+// Both the serialized message and the compressed data are handed
+// over to the rpc return values as is; nothing is copied after the
+// message has been serialized.
 template <typename MSG>
 void encode_message(const MSG &src, FRT_Values &dst) {
     using vespalib::compression::compress;
-    auto output = src.SerializeAsString();
-    ConstBufferRef buf(output.data(), output.size());
-    DataBuffer compressed(output.data(), output.size());
+    size_t size = src.ByteSizeLong();
+    Alloc output = Alloc::alloc(size);
+    src.SerializeWithCachedSizesToArray(static_cast<uint8_t *>(output.get()));
+    ConstBufferRef buf(output.get(), size);
+    DataBuffer compressed;
     CompressionConfig::Type type = compress(get_compression_config(), buf, compressed, true);
     dst.AddInt8(type);
-    dst.AddInt32(buf.size());
-    dst.AddData(compressed.getData(), compressed.getDataLen());
+    dst.AddInt32(size);
+    if ((type == CompressionConfig::Type::NONE) || (type == CompressionConfig::Type::NONE_MULTI)) {
+        // 'compressed' only references 'output' here
+        dst.AddData(std::move(output), size);
+    } else {
+        dst.AddData(std::move(compressed));
+    }
 }
 
 void encode_search_reply(const ProtoSearchReply &src, FRT_Values &dst) {
-    using vespalib::compression::compress;
-    auto output = src.SerializeAsString();
     if (src.grouping_blob().empty()) {
+        size_t size = src.ByteSizeLong();
         dst.AddInt8(CompressionConfig::Type::NONE);
-        dst.AddInt32(output.size());
-        dst.AddData(output.data(), output.size());
+        dst.AddInt32(size);
+        src.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t *>(dst.AddData(size)));
     } else {
-        ConstBufferRef buf(output.data(), output.size());
-        DataBuffer compressed(output.data(), output.size());
-        CompressionConfig::Type type = compress(get_compression_config(), buf, compressed, true);
-        dst.AddInt8(type);
-        dst.AddInt32(buf.size());
-        dst.AddData(compressed.getData(), compressed.getDataLen());
+        encode_message(src, dst);
     }
 }
 
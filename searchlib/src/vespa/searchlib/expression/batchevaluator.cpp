@@ -0,0 +1,233 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batchevaluator.h"
+#include "addfunctionnode.h"
+#include "attributenode.h"
+#include "constantnode.h"
+#include "floatresultnode.h"
+#include "integerresultnode.h"
+#include "maxfunctionnode.h"
+#include "minfunctionnode.h"
+#include "multiplyfunctionnode.h"
+#include "timestamp.h"
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <algorithm>
+
+namespace search::expression {
+
+using attribute::IAttributeVector;
+using Kernel = BatchEvaluator::Kernel;
+using KernelUP = BatchEvaluator::KernelUP;
+
+void
+BatchEvaluator::Column::resize(size_t numDocs)
+{
+    if (_isFloat) {
+        _floats.resize(numDocs);
+    } else {
+        _integers.resize(numDocs);
+    }
+}
+
+namespace {
+
+bool isExactly(const vespalib::Identifiable &obj, unsigned id) {
+    return obj.getClass().id() == id;
+}
+
+bool hasIntegerResult(const ExpressionNode &node) {
+    return isExactly(node.getResult(), Int64ResultNode::classId);
+}
+
+bool hasFloatResult(const ExpressionNode &node) {
+    return isExactly(node.getResult(), FloatResultNode::classId);
+}
+
+class IntegerAttributeKernel : public Kernel {
+    const IAttributeVector &_attribute;
+    void onEvaluate(const DocId *docIds, size_t numDocs) override {
+        int64_t *dst = mutableColumn().integers();
+        for (size_t i = 0; i < numDocs; ++i) {
+            dst[i] = _attribute.getInt(docIds[i]);
+        }
+    }
+public:
+    IntegerAttributeKernel(const IAttributeVector &attribute) : Kernel(false), _attribute(attribute) {}
+};
+
+class FloatAttributeKernel : public Kernel {
+    const IAttributeVector &_attribute;
+    void onEvaluate(const DocId *docIds, size_t numDocs) override {
+        double *dst = mutableColumn().floats();
+        for (size_t i = 0; i < numDocs; ++i) {
+            dst[i] = _attribute.getFloat(docIds[i]);
+        }
+    }
+public:
+    FloatAttributeKernel(const IAttributeVector &attribute) : Kernel(true), _attribute(attribute) {}
+};
+
+template <typename T>
+class ConstantKernel : public Kernel {
+    T _value;
+    void onEvaluate(const DocId *, size_t numDocs) override {
+        if constexpr (std::is_same_v<T, double>) {
+            std::fill(mutableColumn().floats(), mutableColumn().floats() + numDocs, _value);
+        } else {
+            std::fill(mutableColumn().integers(), mutableColumn().integers() + numDocs, _value);
+        }
+    }
+public:
+    ConstantKernel(T value) : Kernel(std::is_same_v<T, double>), _value(value) {}
+};
+
+struct AddOp { template <typename T> static T apply(T a, T b) { return a + b; } };
+struct MultiplyOp { template <typename T> static T apply(T a, T b) { return a * b; } };
+struct MinOp { template <typename T> static T apply(T a, T b) { return (b < a) ? b : a; } };
+struct MaxOp { template <typename T> static T apply(T a, T b) { return (b > a) ? b : a; } };
+
+/**
+ * Folds the argument columns into the result column like the scalar handler
+ * of NumericFunctionNode, converting integer arguments when the result is float.
+ **/
+template <typename T, typename Op>
+class NumericKernel : public Kernel {
+    std::vector<KernelUP> _args;
+
+    template <typename Fold>
+    static void foldArg(T *dst, const BatchEvaluator::Column &arg, size_t numDocs, Fold fold) {
+        if (arg.isFloat()) {
+            const double *src = arg.floats();
+            for (size_t i = 0; i < numDocs; ++i) {
+                dst[i] = fold(dst[i], static_cast<T>(src[i]));
+            }
+        } else {
+            const int64_t *src = arg.integers();
+            for (size_t i = 0; i < numDocs; ++i) {
+                dst[i] = fold(dst[i], static_cast<T>(src[i]));
+            }
+        }
+    }
+    void onEvaluate(const DocId *docIds, size_t numDocs) override {
+        T *dst;
+        if constexpr (std::is_same_v<T, double>) {
+            dst = mutableColumn().floats();
+        } else {
+            dst = mutableColumn().integers();
+        }
+        for (const auto &arg : _args) {
+            arg->evaluate(docIds, numDocs);
+        }
+        foldArg(dst, _args[0]->column(), numDocs, [](T, T b) { return b; });
+        for (size_t a = 1; a < _args.size(); ++a) {
+            foldArg(dst, _args[a]->column(), numDocs, [](T x, T b) { return Op::apply(x, b); });
+        }
+    }
+public:
+    NumericKernel(std::vector<KernelUP> args) : Kernel(std::is_same_v<T, double>), _args(std::move(args)) {}
+};
+
+class TimeStampKernel : public Kernel {
+    KernelUP                              _arg;
+    TimeStampFunctionNode::TimePart      _timePart;
+    bool                                  _isGmt;
+    void onEvaluate(const DocId *docIds, size_t numDocs) override {
+        _arg->evaluate(docIds, numDocs);
+        const int64_t *src = _arg->column().integers();
+        int64_t *dst = mutableColumn().integers();
+        for (size_t i = 0; i < numDocs; ++i) {
+            dst[i] = TimeStampFunctionNode::getTimePart(src[i], _timePart, _isGmt);
+        }
+    }
+public:
+    TimeStampKernel(KernelUP arg, TimeStampFunctionNode::TimePart timePart, bool isGmt)
+        : Kernel(false), _arg(std::move(arg)), _timePart(timePart), _isGmt(isGmt) {}
+};
+
+KernelUP compile(const ExpressionNode &node);
+
+template <typename Op>
+KernelUP
+compileNumeric(const MultiArgFunctionNode &node)
+{
+    if (node.getNumArgs() == 0) {
+        return KernelUP();
+    }
+    std::vector<KernelUP> args;
+    for (size_t i = 0; i < node.getNumArgs(); ++i) {
+        args.push_back(compile(node.getArg(i)));
+        if (!args.back()) {
+            return KernelUP();
+        }
+    }
+    if (hasIntegerResult(node)) {
+        for (const auto &arg : args) {
+            if (arg->column().isFloat()) {
+                return KernelUP();
+            }
+        }
+        return std::make_unique<NumericKernel<int64_t, Op>>(std::move(args));
+    } else if (hasFloatResult(node)) {
+        return std::make_unique<NumericKernel<double, Op>>(std::move(args));
+    }
+    return KernelUP();
+}
+
+KernelUP
+compile(const ExpressionNode &node)
+{
+    if (isExactly(node, AttributeNode::classId)) {
+        const auto &attributeNode = static_cast<const AttributeNode &>(node);
+        const IAttributeVector *attribute = attributeNode.getAttribute();
+        if ((attribute == nullptr) || attributeNode.hasMultiValue()) {
+            return KernelUP();
+        }
+        if (hasIntegerResult(node) && attribute->isIntegerType()) {
+            return std::make_unique<IntegerAttributeKernel>(*attribute);
+        } else if (hasFloatResult(node) && attribute->isFloatingPointType()) {
+            return std::make_unique<FloatAttributeKernel>(*attribute);
+        }
+    } else if (isExactly(node, ConstantNode::classId)) {
+        if (hasIntegerResult(node)) {
+            return std::make_unique<ConstantKernel<int64_t>>(node.getResult().getInteger());
+        } else if (hasFloatResult(node)) {
+            return std::make_unique<ConstantKernel<double>>(node.getResult().getFloat());
+        }
+    } else if (isExactly(node, AddFunctionNode::classId)) {
+        return compileNumeric<AddOp>(static_cast<const MultiArgFunctionNode &>(node));
+    } else if (isExactly(node, MultiplyFunctionNode::classId)) {
+        return compileNumeric<MultiplyOp>(static_cast<const MultiArgFunctionNode &>(node));
+    } else if (isExactly(node, MinFunctionNode::classId)) {
+        return compileNumeric<MinOp>(static_cast<const MultiArgFunctionNode &>(node));
+    } else if (isExactly(node, MaxFunctionNode::classId)) {
+        return compileNumeric<MaxOp>(static_cast<const MultiArgFunctionNode &>(node));
+    } else if (isExactly(node, TimeStampFunctionNode::classId)) {
+        const auto &timeStamp = static_cast<const TimeStampFunctionNode &>(node);
+        KernelUP arg = compile(static_cast<const MultiArgFunctionNode &>(timeStamp).getArg(0));
+        if (arg && !arg->column().isFloat() && hasIntegerResult(node)) {
+            return std::make_unique<TimeStampKernel>(std::move(arg), timeStamp.getTimePart(), timeStamp.isGmt());
+        }
+    }
+    return KernelUP();
+}
+
+}
+
+BatchEvaluator::BatchEvaluator(KernelUP root)
+    : _root(std::move(root))
+{
+}
+
+BatchEvaluator::~BatchEvaluator() = default;
+
+std::unique_ptr<BatchEvaluator>
+BatchEvaluator::create(const ExpressionNode &root)
+{
+    KernelUP kernel = compile(root);
+    if (!kernel) {
+        return std::unique_ptr<BatchEvaluator>();
+    }
+    return std::make_unique<BatchEvaluator>(std::move(kernel));
+}
+
+}
@@ -0,0 +1,82 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "expressionnode.h"
+#include <memory>
+#include <vector>
+
+namespace search::expression {
+
+/**
+ * Evaluates an expression tree for a batch of documents at a time into a
+ * typed column of values, instead of executing the tree with virtual calls
+ * and result node updates per node for each document.
+ *
+ * Only trees of single value numeric attributes, numeric constants, the
+ * add, multiply, min and max functions and time stamp functions are
+ * supported. The tree must be prepared and have its attributes wired.
+ **/
+class BatchEvaluator
+{
+public:
+    static constexpr size_t BATCH_SIZE = 256;
+
+    class Kernel;
+    using KernelUP = std::unique_ptr<Kernel>;
+
+    /**
+     * A column of values produced for a batch, either integers or floats.
+     **/
+    class Column {
+    public:
+        Column(bool isFloat) : _isFloat(isFloat), _integers(), _floats() {}
+        bool isFloat() const { return _isFloat; }
+        const int64_t *integers() const { return _integers.data(); }
+        const double *floats() const { return _floats.data(); }
+        int64_t *integers() { return _integers.data(); }
+        double *floats() { return _floats.data(); }
+        void resize(size_t numDocs);
+    private:
+        bool                 _isFloat;
+        std::vector<int64_t> _integers;
+        std::vector<double>  _floats;
+    };
+
+    class Kernel {
+    public:
+        Kernel(bool isFloat) : _column(isFloat) {}
+        virtual ~Kernel() = default;
+        const Column &column() const { return _column; }
+        void evaluate(const DocId *docIds, size_t numDocs) {
+            _column.resize(numDocs);
+            onEvaluate(docIds, numDocs);
+        }
+    protected:
+        Column &mutableColumn() { return _column; }
+    private:
+        virtual void onEvaluate(const DocId *docIds, size_t numDocs) = 0;
+        Column _column;
+    };
+
+    BatchEvaluator(KernelUP root);
+    ~BatchEvaluator();
+
+    /**
+     * @return an evaluator for the given tree, or an empty pointer
+     * if the tree contains nodes that can not be evaluated in batches.
+     **/
+    static std::unique_ptr<BatchEvaluator> create(const ExpressionNode &root);
+
+    /**
+     * Evaluate the tree for the given documents, at most BATCH_SIZE.
+     * @return the values, one for each document.
+     **/
+    const Column &evaluate(const DocId *docIds, size_t numDocs) {
+        _root->evaluate(docIds, numDocs);
+        return _root->column();
+    }
+private:
+    KernelUP _root;
+};
+
+}
@@ -26,12 +26,12 @@ public:
     }
     void reset() override { _args.clear(); FunctionNode::reset(); }
     ExpressionNodeVector & expressionNodeVector() { return _args; }
+    size_t getNumArgs() const { return _args.size(); }
+    const ExpressionNode & getArg(size_t n) const { return *_args[n]; }
 protected:
     virtual bool onCalculate(const ExpressionNodeVector & args, ResultNode & result) const;
     bool onExecute() const override;
     void onPrepare(bool preserveAccurateTypes) override;
-    size_t getNumArgs() const { return _args.size(); }
-    const ExpressionNode & getArg(size_t n) const { return *_args[n]; }
     ExpressionNode &       getArg(size_t n)       { return *_args[n]; }
 private:
     void selectMembers(const vespalib::ObjectPredicate & predicate, vespalib::ObjectOperation & operation) override;
@@ -23,6 +23,7 @@ public:
     TimeStampFunctionNode & setTimePart(TimePart timePart) { _timePart = timePart; return *this; }
     bool isGmt()           const { return _isGmt; }
     bool isLocal()         const { return ! isGmt(); }
+    static unsigned getTimePart(time_t time, TimePart, bool gmt);
 protected:
 /*
 unsigned year(timestamp); [1970 - 2039]
@@ -67,7 +68,6 @@ private:
     const ResultNode & getTimeStamp() const { return getArg().getResult(); }
     void init();
     Int64ResultNode & updateIntegerResult() const { return static_cast<Int64ResultNode &>(updateResult()); }
-    static unsigned getTimePart(time_t time, TimePart, bool gmt);
     TimePart _timePart;
     bool     _isGmt;
     std::unique_ptr<Handler> _handler;
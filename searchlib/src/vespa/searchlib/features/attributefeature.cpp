@@ -121,6 +121,10 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *> inputs,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -133,6 +137,15 @@ public:
     void execute(uint32_t docId) override {
         outputs().set_number(0, _attribute.getFloat(docId));
     }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *>,
+                       vespalib::ConstArrayRef<feature_t *> outputs_in) override {
+        feature_t *value = outputs_in[0];
+        for (size_t i = 0; i < docids.size(); ++i) {
+            value[i] = _attribute.getFloat(docids[i]);
+        }
+    }
 };
 
 /**
@@ -237,6 +250,27 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                                          vespalib::ConstArrayRef<const feature_t *>,
+                                          vespalib::ConstArrayRef<feature_t *> outputs_in)
+{
+    feature_t *value = outputs_in[0];
+    feature_t *weight = outputs_in[1];
+    feature_t *contains = outputs_in[2];
+    feature_t *count = outputs_in[3];
+    for (size_t i = 0; i < docids.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+        value[i] = __builtin_expect(attribute::isUndefined(v), false)
+                   ? attribute::getUndefined<feature_t>()
+                   : util::getAsFeature(v);
+        weight[i] = 0;
+        contains[i] = 0;
+        count[i] = 1;
+    }
+}
+
 template <typename T>
 void
 MultiAttributeExecutor<T>::execute(uint32_t docId)
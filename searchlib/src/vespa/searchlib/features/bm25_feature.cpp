@@ -48,8 +48,13 @@ Bm25Executor::Bm25Executor(const fef::FieldInfo& field,
       _terms(),
       _avg_field_length(avg_field_length),
       _k1_mul_b(k1_param * b_param),
-      _k1_mul_one_minus_b(k1_param * (1 - b_param))
+      _k1_mul_one_minus_b(k1_param * (1 - b_param)),
+      _length_norms()
 {
+    _length_norms.reserve(length_norm_table_size);
+    for (uint32_t field_length = 0; field_length < length_norm_table_size; ++field_length) {
+        _length_norms.push_back(calculate_length_norm(field_length));
+    }
     for (size_t i = 0; i < env.getNumTerms(); ++i) {
         const ITermData* term = env.getTerm(i);
         for (size_t j = 0; j < term->numFields(); ++j) {
@@ -85,10 +90,9 @@ Bm25Executor::execute(uint32_t doc_id)
     for (const auto& term : _terms) {
         if (term.tfmd->getDocId() == doc_id) {
             feature_t num_occs = term.tfmd->getNumOccs();
-            feature_t norm_field_length = ((feature_t)term.tfmd->getFieldLength()) / _avg_field_length;
 
             feature_t numerator = num_occs * term.idf_mul_k1_plus_one;
-            feature_t denominator = num_occs + (_k1_mul_one_minus_b + _k1_mul_b * norm_field_length);
+            feature_t denominator = num_occs + get_length_norm(term.tfmd->getFieldLength());
 
             score += numerator / denominator;
         }
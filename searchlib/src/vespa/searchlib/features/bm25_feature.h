@@ -31,6 +31,20 @@ private:
     double _k1_mul_b;
     double _k1_mul_one_minus_b;
 
+    // Length norm part of the denominator (k1 * (1 - b + b * field_length / avg_field_length)),
+    // precomputed for short fields as it only depends on the field length of the document.
+    static constexpr uint32_t length_norm_table_size = 256;
+    std::vector<double> _length_norms;
+
+    double calculate_length_norm(uint32_t field_length) const {
+        return _k1_mul_one_minus_b + _k1_mul_b * (((feature_t)field_length) / _avg_field_length);
+    }
+    double get_length_norm(uint32_t field_length) const {
+        return (field_length < length_norm_table_size)
+            ? _length_norms[field_length]
+            : calculate_length_norm(field_length);
+    }
+
 public:
     Bm25Executor(const fef::FieldInfo& field,
                  const fef::IQueryEnvironment& env,
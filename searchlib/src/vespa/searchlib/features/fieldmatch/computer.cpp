@@ -8,6 +8,9 @@
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/locale/c.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <set>
 
 #include <vespa/log/log.h>
@@ -27,6 +30,7 @@ Computer::Computer(const ComputerSharedState& shared_state, const PhraseSplitter
       _queryTermFieldMatch(_queryTerms.size()),
       _totalTermWeight(_shared_state.get_total_term_weight()),
       _totalTermSignificance(_shared_state.get_total_term_significance()),
+      _proximityUpperBound(0),
       _fieldLength(FieldPositionsIterator::UNKNOWN_LENGTH),
       _currentMetrics(this),
       _finalMetrics(this),
@@ -44,6 +48,7 @@ Computer::Computer(const ComputerSharedState& shared_state, const PhraseSplitter
     for (uint32_t i = 0; i < (getNumQueryTerms() + 1); ++i) {
         _segments.emplace_back(std::make_shared<SegmentStart>(this, _currentMetrics));
     }
+    _proximityUpperBound = calculateProximityUpperBound();
 }
 
 Computer::~Computer() = default;
@@ -110,6 +115,70 @@ Computer::reset(uint32_t docId)
     }
 }
 
+feature_t
+Computer::calculateProximityUpperBound() const
+{
+    // Each pair contributes pow(pairProximity, connectedness / 0.1) * max(0.1, connectedness) to the absolute
+    // proximity, which is the average over all pairs (see Metrics::onPair), and 0.1 if there are no pairs.
+    const std::vector<feature_t> &table = _params.getProximityTable();
+    if (table.empty() || (*std::min_element(table.begin(), table.end()) < 0)) {
+        return std::numeric_limits<feature_t>::infinity();
+    }
+    feature_t maxPairProximity = *std::max_element(table.begin(), table.end());
+    feature_t absoluteProximity = 0.1;
+    feature_t totalConnectedness = 0;
+    for (uint32_t i = 0; i < getNumQueryTerms(); ++i) {
+        feature_t connectedness = getQueryTermData(i).connectedness();
+        if (connectedness < 0) {
+            return std::numeric_limits<feature_t>::infinity();
+        }
+        absoluteProximity = std::max(absoluteProximity,
+                                     std::pow(maxPairProximity, connectedness / 0.1) * std::max(0.1, connectedness));
+        if (i > 0) {
+            totalConnectedness += std::max(0.1, connectedness);
+        }
+    }
+    feature_t averageConnectedness = 0.1;
+    if (getNumQueryTerms() > 1) {
+        averageConnectedness = totalConnectedness / (getNumQueryTerms() - 1);
+    }
+    return absoluteProximity / averageConnectedness;
+}
+
+feature_t
+Computer::getMatchUpperBound() const
+{
+    feature_t proximityCompletenessImportance = _params.getProximityCompletenessImportance();
+    feature_t earlinessImportance = _params.getEarlinessImportance();
+    feature_t relatednessImportance = _params.getRelatednessImportance();
+    feature_t segmentProximityImportance = _params.getSegmentProximityImportance();
+    feature_t occurrenceImportance = _params.getOccurrenceImportance();
+    feature_t fieldCompletenessImportance = _params.getFieldCompletenessImportance();
+    feature_t totalImportance = proximityCompletenessImportance + earlinessImportance +
+                                segmentProximityImportance + occurrenceImportance;
+    if ((proximityCompletenessImportance < 0) || (earlinessImportance < 0) ||
+        (segmentProximityImportance < 0) || (occurrenceImportance < 0) || (totalImportance <= 0) ||
+        (fieldCompletenessImportance < 0) || (fieldCompletenessImportance > 1) ||
+        (_fieldLength == 0) || (_fieldLength == FieldPositionsIterator::UNKNOWN_LENGTH))
+    {
+        return std::numeric_limits<feature_t>::infinity();
+    }
+    // The final metrics only count query terms found in the field by reset(), and at most one match per
+    // field position. Earliness, segment proximity and relatedness are all at most 1.
+    feature_t matches = _simpleMetrics.getMatches();
+    feature_t queryCompleteness = std::min(feature_t(1), matches / getNumQueryTerms());
+    feature_t fieldCompleteness = std::min(feature_t(1), matches / _fieldLength);
+    feature_t completeness = queryCompleteness * (1 - fieldCompletenessImportance) +
+                             fieldCompletenessImportance * fieldCompleteness;
+    feature_t scaledRelatedness = std::max(feature_t(1), 1 - relatednessImportance);
+    // Each matched term contributes at most getMaxOccurrences() occurrences (see setOccurrenceCounts).
+    feature_t occurrence = std::max(feature_t(1), matches * _params.getMaxOccurrences() / _fieldLength);
+    return (proximityCompletenessImportance * scaledRelatedness * _proximityUpperBound * completeness * completeness
+            + earlinessImportance
+            + segmentProximityImportance
+            + occurrenceImportance * occurrence) / totalImportance;
+}
+
 void
 Computer::handleError(uint32_t fieldPos, uint32_t docId) const
 {
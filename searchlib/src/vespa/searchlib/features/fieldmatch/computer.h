@@ -215,6 +215,15 @@ public:
         return _simpleMetrics;
     }
 
+    /**
+     * Returns an upper bound on the match score of the final metrics of the current document, using only
+     * the information gathered by reset(). This is much cheaper than calling run(). Returns infinity if the
+     * parameters do not allow bounding the score.
+     *
+     * @return The upper bound.
+     */
+    feature_t getMatchUpperBound() const;
+
 
 private:
     /**
@@ -282,6 +291,13 @@ private:
 
     void handleError(uint32_t fieldPos, uint32_t docId) const __attribute__((noinline));
 
+    /**
+     * Calculates an upper bound on the proximity metric for this query, or infinity if there is none.
+     *
+     * @return The upper bound.
+     */
+    feature_t calculateProximityUpperBound() const;
+
 
 private:
     typedef std::shared_ptr<BitVector> BitVectorPtr;
@@ -311,6 +327,7 @@ private:
     TermFieldMatchDataVector                   _queryTermFieldMatch;
     uint32_t                                   _totalTermWeight;
     feature_t                                  _totalTermSignificance;
+    feature_t                                  _proximityUpperBound;
 
     // per docid
     uint32_t                                   _fieldLength;
@@ -49,18 +49,21 @@ class FieldMatchExecutor : public fef::FeatureExecutor {
 private:
     fef::PhraseSplitter    _splitter;
     fieldmatch::Computer   _cmp;
+    const feature_t      * _score_threshold;
 
     void handle_bind_match_data(const fef::MatchData &md) override;
 
 public:
     FieldMatchExecutor(const FieldMatchExecutorSharedState& shared_state);
     void execute(uint32_t docId) override;
+    void bind_score_threshold(const feature_t *threshold) override { _score_threshold = threshold; }
 };
 
 FieldMatchExecutor::FieldMatchExecutor(const FieldMatchExecutorSharedState& shared_state)
     : FeatureExecutor(),
       _splitter(shared_state.get_phrase_splitter_query_env()),
-      _cmp(shared_state.get_computer_shared_state(), _splitter)
+      _cmp(shared_state.get_computer_shared_state(), _splitter),
+      _score_threshold(nullptr)
 {
 }
 
@@ -80,6 +83,11 @@ FieldMatchExecutor::execute(uint32_t docId)
                    simple.getMatchesWithPosOcc() > 0 &&
                    !simple.getMatchWithInvalidFieldLength());
 
+    // skip the segmentation when this document cannot reach the score threshold, the score is then 0
+    if (runCmp && (_score_threshold != nullptr) && (_cmp.getMatchUpperBound() < *_score_threshold)) {
+        runCmp = false;
+    }
+
     //LOG(info, "runCmp(%s), simpleMetrics(%s)", runCmp ? "true" : "false", simple.toString().c_str());
 
     if (runCmp) {
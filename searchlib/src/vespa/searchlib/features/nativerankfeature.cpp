@@ -60,7 +60,8 @@ FieldWrapper::FieldWrapper(const IIndexEnvironment & env,
 NativeRankExecutor::NativeRankExecutor(const NativeRankParams & params) :
     FeatureExecutor(),
     _params(params),
-    _divisor(0)
+    _divisor(0),
+    _score_threshold(nullptr)
 {
     _divisor += _params.fieldMatchWeight;
     _divisor += _params.attributeMatchWeight;
@@ -70,11 +71,47 @@ NativeRankExecutor::NativeRankExecutor(const NativeRankParams & params) :
 void
 NativeRankExecutor::execute(uint32_t)
 {
+    if (_score_threshold != nullptr) {
+        execute_with_threshold(*_score_threshold);
+        return;
+    }
     outputs().set_number(0, (inputs().get_number(0) * _params.fieldMatchWeight
                              + inputs().get_number(1) * _params.proximityWeight
                              + inputs().get_number(2) * _params.attributeMatchWeight) / _divisor);
 }
 
+void
+NativeRankExecutor::execute_with_threshold(feature_t threshold)
+{
+    // Sub features are calculated from the cheapest to the most
+    // expensive, stopping as soon as the remaining ones (each at most
+    // 1) cannot lift the score up to the threshold.
+    feature_t sum = inputs().get_number(2) * _params.attributeMatchWeight;
+    feature_t bound = (sum + _params.fieldMatchWeight + _params.proximityWeight) / _divisor;
+    if (bound < threshold) {
+        outputs().set_number(0, bound);
+        return;
+    }
+    sum += inputs().get_number(0) * _params.fieldMatchWeight;
+    bound = (sum + _params.proximityWeight) / _divisor;
+    if (bound < threshold) {
+        outputs().set_number(0, bound);
+        return;
+    }
+    sum += inputs().get_number(1) * _params.proximityWeight;
+    outputs().set_number(0, sum / _divisor);
+}
+
+void
+NativeRankExecutor::bind_score_threshold(const feature_t *threshold)
+{
+    if (_params.normalizedInputs && (_params.fieldMatchWeight >= 0) &&
+        (_params.proximityWeight >= 0) && (_params.attributeMatchWeight >= 0))
+    {
+        _score_threshold = threshold;
+    }
+}
+
 
 NativeRankBlueprint::NativeRankBlueprint() :
     Blueprint("nativeRank"),
@@ -110,6 +147,7 @@ NativeRankBlueprint::setup(const IIndexEnvironment & env,
     }
     _params.proximityWeight = util::strToNum<feature_t>
         (env.getProperties().lookup(getBaseName(), "proximityWeight").get(defProxWeight));
+    _params.normalizedInputs = useTableNormalization(env);
 
     vespalib::string nfm = "nativeFieldMatch";
     vespalib::string np = "nativeProximity";
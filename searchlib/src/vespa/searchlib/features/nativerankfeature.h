@@ -16,7 +16,8 @@ struct NativeRankParams {
     feature_t fieldMatchWeight;
     feature_t attributeMatchWeight;
     feature_t proximityWeight;
-    NativeRankParams() : fieldMatchWeight(0), attributeMatchWeight(0), proximityWeight(0) {}
+    bool      normalizedInputs; // all sub features are in the range [0, 1]
+    NativeRankParams() : fieldMatchWeight(0), attributeMatchWeight(0), proximityWeight(0), normalizedInputs(false) {}
 };
 
 /**
@@ -79,10 +80,14 @@ class NativeRankExecutor : public fef::FeatureExecutor {
 private:
     const NativeRankParams & _params;
     feature_t                _divisor;
+    const feature_t        * _score_threshold;
+
+    void execute_with_threshold(feature_t threshold);
 
 public:
     NativeRankExecutor(const NativeRankParams & params);
     void execute(uint32_t docId) override;
+    void bind_score_threshold(const feature_t *threshold) override;
 };
 
 
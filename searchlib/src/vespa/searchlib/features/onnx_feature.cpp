@@ -2,12 +2,15 @@
 
 #include "onnx_feature.h"
 #include <vespa/searchlib/fef/properties.h>
+#include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/onnx_model.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include <vespa/eval/tensor/dense/dense_tensor_view.h>
 #include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
+#include <algorithm>
+#include <cstring>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.onnx_feature");
@@ -17,8 +20,11 @@ using search::fef::FeatureExecutor;
 using search::fef::FeatureType;
 using search::fef::IIndexEnvironment;
 using search::fef::IQueryEnvironment;
+using search::fef::LazyValue;
 using search::fef::ParameterList;
+using vespalib::ConstArrayRef;
 using vespalib::Stash;
+using vespalib::eval::TypedCells;
 using vespalib::eval::ValueType;
 using vespalib::make_string_short::fmt;
 using vespalib::tensor::MutableDenseTensorView;
@@ -43,6 +49,28 @@ vespalib::string normalize_name(const vespalib::string &name, const char *contex
     return result;
 }
 
+size_t cell_size(ValueType::CellType cell_type) {
+    switch (cell_type) {
+    case ValueType::CellType::DOUBLE:   return sizeof(double);
+    case ValueType::CellType::FLOAT:    return sizeof(float);
+    case ValueType::CellType::BFLOAT16: return sizeof(vespalib::BFloat16);
+    case ValueType::CellType::INT8:     return sizeof(int8_t);
+    }
+    abort();
+}
+
+// the first dimension of the model must be free, and each document must provide a single entry
+bool has_batch_dimension(const Onnx::TensorInfo &model_info, const ValueType &doc_type) {
+    return (!model_info.dimensions.empty() && !model_info.dimensions[0].is_known() &&
+            !doc_type.dimensions().empty() && doc_type.dimensions()[0].is_trivial());
+}
+
+ValueType with_batch_size(const ValueType &doc_type, size_t batch_size) {
+    auto dimensions = doc_type.dimensions();
+    dimensions[0].size = batch_size;
+    return ValueType::tensor_type(std::move(dimensions), doc_type.cell_type());
+}
+
 }
 
 /**
@@ -69,10 +97,143 @@ public:
     }
 };
 
+/**
+ * Feature executor that evaluates an onnx model for a batch of
+ * upcoming documents in a single model run. The model inputs for
+ * upcoming documents are calculated ahead of time, which means that
+ * they must not depend on match data. Documents not announced as
+ * upcoming are evaluated one at a time.
+ */
+class BatchOnnxFeatureExecutor : public FeatureExecutor
+{
+private:
+    const Onnx::WireInfo                &_wire_info;
+    const size_t                         _batch_size;
+    Onnx::EvalContext                    _single_context;
+    Onnx::EvalContext                    _batch_context;
+    ConstArrayRef<LazyValue>             _lazy_inputs;
+    std::vector<std::vector<char>>       _input_cells;
+    std::vector<MutableDenseTensorView>  _batch_inputs;
+    std::vector<MutableDenseTensorView>  _doc_results;
+    std::vector<uint32_t>                _upcoming;
+    size_t                               _next_upcoming;
+    std::vector<uint32_t>                _batch_docids;
+
+    bool select_batch(uint32_t docid, size_t &idx);
+    void eval_batch(size_t begin, size_t end);
+public:
+    BatchOnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info,
+                             const Onnx::WireInfo &batch_wire_info, size_t batch_size);
+    ~BatchOnnxFeatureExecutor() override;
+    bool isPure() override { return true; }
+    void handle_bind_inputs(ConstArrayRef<LazyValue> inputs) override {
+        _lazy_inputs = inputs;
+    }
+    void set_upcoming_docids(ConstArrayRef<uint32_t> docids) override {
+        _upcoming.assign(docids.begin(), docids.end());
+        _next_upcoming = 0;
+        _batch_docids.clear();
+    }
+    void execute(uint32_t docid) override;
+};
+
+BatchOnnxFeatureExecutor::BatchOnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info,
+                                                   const Onnx::WireInfo &batch_wire_info, size_t batch_size)
+    : _wire_info(wire_info),
+      _batch_size(batch_size),
+      _single_context(model, wire_info),
+      _batch_context(model, batch_wire_info),
+      _lazy_inputs(),
+      _input_cells(),
+      _batch_inputs(),
+      _doc_results(),
+      _upcoming(),
+      _next_upcoming(0),
+      _batch_docids()
+{
+    for (const auto &type: batch_wire_info.vespa_inputs) {
+        size_t num_cells = type.dense_subspace_size();
+        _input_cells.emplace_back(num_cells * cell_size(type.cell_type()), 0);
+        _batch_inputs.emplace_back(type);
+        _batch_inputs.back().setCells(TypedCells(_input_cells.back().data(), type.cell_type(), num_cells));
+    }
+    for (const auto &type: wire_info.vespa_outputs) {
+        _doc_results.emplace_back(type);
+    }
+}
+
+BatchOnnxFeatureExecutor::~BatchOnnxFeatureExecutor() = default;
+
+bool
+BatchOnnxFeatureExecutor::select_batch(uint32_t docid, size_t &idx)
+{
+    auto pos = std::lower_bound(_batch_docids.begin(), _batch_docids.end(), docid);
+    if ((pos == _batch_docids.end()) || (*pos != docid)) {
+        while ((_next_upcoming < _upcoming.size()) && (_upcoming[_next_upcoming] < docid)) {
+            ++_next_upcoming;
+        }
+        if ((_next_upcoming == _upcoming.size()) || (_upcoming[_next_upcoming] != docid)) {
+            return false;
+        }
+        size_t end = std::min(_upcoming.size(), _next_upcoming + _batch_size);
+        eval_batch(_next_upcoming, end);
+        _next_upcoming = end;
+        pos = _batch_docids.begin();
+    }
+    idx = (pos - _batch_docids.begin());
+    return true;
+}
+
+void
+BatchOnnxFeatureExecutor::eval_batch(size_t begin, size_t end)
+{
+    _batch_docids.assign(_upcoming.begin() + begin, _upcoming.begin() + end);
+    for (size_t i = 0; i < _lazy_inputs.size(); ++i) {
+        const auto &doc_type = _wire_info.vespa_inputs[i];
+        size_t doc_bytes = doc_type.dense_subspace_size() * cell_size(doc_type.cell_type());
+        char *dst = _input_cells[i].data();
+        for (uint32_t docid: _batch_docids) {
+            TypedCells cells = _lazy_inputs[i].as_object(docid).get().cells();
+            assert(cells.type == doc_type.cell_type());
+            assert((cells.size * cell_size(cells.type)) == doc_bytes);
+            memcpy(dst, cells.data, doc_bytes);
+            dst += doc_bytes;
+        }
+        _batch_context.bind_param(i, _batch_inputs[i]);
+    }
+    _batch_context.eval();
+}
+
+void
+BatchOnnxFeatureExecutor::execute(uint32_t docid)
+{
+    size_t idx = 0;
+    if (select_batch(docid, idx)) {
+        for (size_t i = 0; i < _doc_results.size(); ++i) {
+            const auto &doc_type = _wire_info.vespa_outputs[i];
+            size_t num_cells = doc_type.dense_subspace_size();
+            const char *batch_cells = static_cast<const char *>(_batch_context.get_result(i).cells().data);
+            const char *doc_cells = batch_cells + (idx * num_cells * cell_size(doc_type.cell_type()));
+            _doc_results[i].setCells(TypedCells(doc_cells, doc_type.cell_type(), num_cells));
+            outputs().set_object(i, _doc_results[i]);
+        }
+    } else {
+        for (size_t i = 0; i < _single_context.num_params(); ++i) {
+            _single_context.bind_param(i, _lazy_inputs[i].as_object(docid).get());
+        }
+        _single_context.eval();
+        for (size_t i = 0; i < _single_context.num_results(); ++i) {
+            outputs().set_object(i, _single_context.get_result(i));
+        }
+    }
+}
+
 OnnxBlueprint::OnnxBlueprint()
     : Blueprint("onnxModel"),
       _model(nullptr),
-      _wire_info()
+      _wire_info(),
+      _batch_size(1),
+      _batch_wire_info()
 {
 }
 
@@ -89,8 +250,9 @@ OnnxBlueprint::setup(const IIndexEnvironment &env,
     if (!model_cfg) {
         return fail("no model with name '%s' found", params[0].getValue().c_str());
     }
+    size_t intra_op_threads = fef::indexproperties::eval::OnnxIntraOpThreads::lookup(env.getProperties());
     try {
-        _model = std::make_unique<Onnx>(model_cfg->file_path(), optimize);
+        _model = std::make_unique<Onnx>(model_cfg->file_path(), optimize, intra_op_threads);
     } catch (std::exception &ex) {
         return fail("model setup failed: %s", ex.what());
     }
@@ -126,6 +288,38 @@ OnnxBlueprint::setup(const IIndexEnvironment &env,
         describeOutput(output_name.value(), "output from onnx model", FeatureType::object(output_type));
     }
     _wire_info = planner.get_wire_info(*_model);
+    size_t batch_size = fef::indexproperties::eval::OnnxBatchSize::lookup(env.getProperties());
+    if ((batch_size > 1) && (optimize == Onnx::Optimize::ENABLE) && !plan_batch(batch_size)) {
+        LOG(debug, "onnx model '%s' does not have a batch dimension, evaluating one document at a time",
+            params[0].getValue().c_str());
+    }
+    return true;
+}
+
+bool
+OnnxBlueprint::plan_batch(size_t batch_size)
+{
+    Onnx::WirePlanner planner;
+    for (size_t i = 0; i < _model->inputs().size(); ++i) {
+        const auto &model_input = _model->inputs()[i];
+        const auto &doc_type = _wire_info.vespa_inputs[i];
+        if (!has_batch_dimension(model_input, doc_type) ||
+            !planner.bind_input_type(with_batch_size(doc_type, batch_size), model_input))
+        {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < _model->outputs().size(); ++i) {
+        const auto &model_output = _model->outputs()[i];
+        const auto &doc_type = _wire_info.vespa_outputs[i];
+        if (!has_batch_dimension(model_output, doc_type) ||
+            (planner.make_output_type(model_output) != with_batch_size(doc_type, batch_size)))
+        {
+            return false;
+        }
+    }
+    _batch_wire_info = planner.get_wire_info(*_model);
+    _batch_size = batch_size;
     return true;
 }
 
@@ -133,6 +327,9 @@ FeatureExecutor &
 OnnxBlueprint::createExecutor(const IQueryEnvironment &, Stash &stash) const
 {
     assert(_model);
+    if (_batch_size > 1) {
+        return stash.create<BatchOnnxFeatureExecutor>(*_model, _wire_info, _batch_wire_info, _batch_size);
+    }
     return stash.create<OnnxFeatureExecutor>(*_model, _wire_info);
 }
 
@@ -15,6 +15,10 @@ private:
     using Onnx = vespalib::tensor::Onnx;
     std::unique_ptr<Onnx> _model;
     Onnx::WireInfo _wire_info;
+    size_t _batch_size;
+    Onnx::WireInfo _batch_wire_info;
+
+    bool plan_batch(size_t batch_size);
 public:
     OnnxBlueprint();
     ~OnnxBlueprint() override;
@@ -4,6 +4,7 @@
 #include "utils.h"
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/fef/featurenameparser.h>
 #include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
 #include <vespa/eval/eval/engine_or_factory.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
@@ -27,6 +28,8 @@ using vespalib::eval::PassParams;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
 using vespalib::eval::gbdt::FastForest;
+using vespalib::starts_with;
+using vespalib::ends_with;
 
 namespace search::features {
 
@@ -40,6 +43,73 @@ vespalib::string list_issues(const std::vector<vespalib::string> &issues) {
     return result;
 }
 
+vespalib::string lookup_script(const fef::Properties &props, const vespalib::string &feature_name) {
+    vespalib::string script;
+    fef::Property property = props.lookup(feature_name, "rankingScript");
+    for (uint32_t i = 0; i < property.size(); ++i) {
+        script.append(property.getAt(i));
+    }
+    return script;
+}
+
+bool is_expression_ref(const vespalib::string &name) {
+    return (name.size() > 19) && starts_with(name, "rankingExpression(") && ends_with(name, ")");
+}
+
+// upper bound on nesting of inlined expressions, also stopping cyclic references
+constexpr size_t max_inline_depth = 16;
+
+/**
+ * Replace references to other ranking expressions with the
+ * expressions themselves, making it possible to compile the full
+ * expression tree as a single function. References remaining after
+ * max_inline_depth levels of inlining are resolved as regular
+ * features.
+ **/
+std::shared_ptr<Function const> inline_functions(std::shared_ptr<Function const> function,
+                                                 const fef::Properties &props)
+{
+    for (size_t depth = 0; depth < max_inline_depth; ++depth) {
+        bool changed = false;
+        std::vector<vespalib::string> params;
+        for (size_t i = 0; i < function->num_params(); ++i) {
+            vespalib::string name = function->param_name(i);
+            if (is_expression_ref(name)) {
+                vespalib::string script = lookup_script(props, name);
+                if (!script.empty()) {
+                    name = "(" + script + ")";
+                    changed = true;
+                }
+            }
+            params.push_back(name);
+        }
+        if (!changed) {
+            break;
+        }
+        vespalib::eval::nodes::DumpContext ctx(params);
+        auto result = Function::parse(function->root().dump(ctx), rankingexpression::FeatureNameExtractor());
+        if (result->has_error()) {
+            LOG(warning, "unable to inline ranking expressions: %s", result->get_error().c_str());
+            break;
+        }
+        function = std::move(result);
+    }
+    return function;
+}
+
+// A fast forest calculating the first phase rank score does not need
+// the exact score of hits that will be dropped by the rank drop limit.
+bool use_bounded_forest(const fef::Properties &props, const vespalib::string &feature_name) {
+    if (!fef::indexproperties::eval::BoundedFastForest::check(props)) {
+        return false;
+    }
+    if (std::isnan(fef::indexproperties::hitcollector::RankScoreDropLimit::lookup(props))) {
+        return false;
+    }
+    fef::FeatureNameParser first_phase(fef::indexproperties::rank::FirstPhase::lookup(props));
+    return (first_phase.valid() && (first_phase.executorName() == feature_name));
+}
+
 } // namespace search::features::<unnamed>
 
 //-----------------------------------------------------------------------------
@@ -53,11 +123,16 @@ private:
     const FastForest &_forest;
     FastForest::Context::UP _ctx;
     ArrayRef<float> _params;
+    double _limit;
 
 public:
-    FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
+    FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest, double limit);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids,
+                       ConstArrayRef<const feature_t *> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -76,6 +151,10 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids,
+                       ConstArrayRef<const feature_t *> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -130,10 +209,11 @@ public:
 
 //-----------------------------------------------------------------------------
 
-FastForestExecutor::FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest)
+FastForestExecutor::FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest, double limit)
     : _forest(forest),
       _ctx(_forest.create_context()),
-      _params(param_space)
+      _params(param_space),
+      _limit(limit)
 {
 }
 
@@ -150,7 +230,21 @@ FastForestExecutor::execute(uint32_t)
     for (; i < _params.size(); ++i) {
         _params[i] = inputs().get_number(i);
     }
-    outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
+    outputs().set_number(0, _forest.eval_bounded(*_ctx, &_params[0], _limit));
+}
+
+void
+FastForestExecutor::execute_batch(ConstArrayRef<uint32_t> docids,
+                                  ConstArrayRef<const feature_t *> inputs_in,
+                                  ConstArrayRef<feature_t *> outputs_in)
+{
+    feature_t *result = outputs_in[0];
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs_in[i][doc];
+        }
+        result[doc] = _forest.eval_bounded(*_ctx, &_params[0], _limit);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -177,6 +271,20 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(&_params[0]));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids,
+                                                 ConstArrayRef<const feature_t *> inputs_in,
+                                                 ConstArrayRef<feature_t *> outputs_in)
+{
+    feature_t *result = outputs_in[0];
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs_in[i][doc];
+        }
+        result[doc] = _ranking_function(&_params[0]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -224,6 +332,7 @@ RankingExpressionBlueprint::RankingExpressionBlueprint(rankingexpression::Expres
       _expression_replacer(std::move(replacer)),
       _intrinsic_expression(),
       _fast_forest(),
+      _fast_forest_limit(-std::numeric_limits<double>::infinity()),
       _interpreted_function(),
       _compile_token(),
       _input_is_object()
@@ -260,6 +369,9 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
     if (rank_function->has_error()) {
         return fail("Failed to parse expression '%s': %s", script.c_str(), rank_function->get_error().c_str());
     }
+    if (fef::indexproperties::eval::InlineFunctions::check(env.getProperties())) {
+        rank_function = inline_functions(std::move(rank_function), env.getProperties());
+    }
     _intrinsic_expression = _expression_replacer->maybe_replace(*rank_function, env);
     if (_intrinsic_expression) {
         LOG(info, "%s replaced with %s", getName().c_str(), _intrinsic_expression->describe_self().c_str());
@@ -315,7 +427,12 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
         if (do_compile) {
             // fast forest evaluation is a possible replacement for compiled tree models
             if (fef::indexproperties::eval::UseFastForest::check(env.getProperties())) {
-                _fast_forest = FastForest::try_convert(*rank_function);
+                if (use_bounded_forest(env.getProperties(), getName())) {
+                    _fast_forest = FastForest::try_convert_bounded(*rank_function);
+                    _fast_forest_limit = fef::indexproperties::hitcollector::RankScoreDropLimit::lookup(env.getProperties());
+                } else {
+                    _fast_forest = FastForest::try_convert(*rank_function);
+                }
             }
             if (!_fast_forest) {
                 bool suggest_lazy = CompiledFunction::should_use_lazy_params(*rank_function);
@@ -363,7 +480,7 @@ RankingExpressionBlueprint::createExecutor(const fef::IQueryEnvironment &env, ve
     }
     if (_fast_forest) {
         ArrayRef<float> param_space = stash.create_array<float>(_input_is_object.size(), 0.0);
-        return stash.create<FastForestExecutor>(param_space, *_fast_forest);
+        return stash.create<FastForestExecutor>(param_space, *_fast_forest, _fast_forest_limit);
     }
     assert(_compile_token.get() != nullptr); // will be nullptr for VERIFY_SETUP feature motivation
     if (_compile_token->get().pass_params() == PassParams::ARRAY) {
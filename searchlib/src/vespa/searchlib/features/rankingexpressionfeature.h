@@ -21,6 +21,7 @@ private:
     rankingexpression::ExpressionReplacer::SP  _expression_replacer;
     rankingexpression::IntrinsicExpression::UP _intrinsic_expression;
     vespalib::eval::gbdt::FastForest::UP       _fast_forest;
+    double                                     _fast_forest_limit;
     vespalib::eval::InterpretedFunction::UP    _interpreted_function;
     vespalib::eval::CompileCache::Token::UP    _compile_token;
     std::vector<char>                          _input_is_object;
@@ -0,0 +1,69 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "feature_extractor.h"
+#include "rank_program.h"
+#include <vespa/eval/eval/engine_or_factory.h>
+#include <vespa/eval/eval/value.h>
+
+namespace search::fef {
+
+void
+FeatureExtractor::set_value(uint32_t idx, uint32_t docid, FeatureSet::Value &dst)
+{
+    if (_resolver.is_object(idx)) {
+        auto obj = _resolver.resolve(idx).as_object(docid);
+        if (obj.get().type().is_double()) {
+            dst.set_double(obj.get().as_double());
+        } else {
+            _buf.clear();
+            vespalib::eval::EngineOrFactory::get().encode(obj.get(), _buf);
+            dst.set_data(vespalib::Memory(_buf.peek(), _buf.size()));
+        }
+    } else {
+        dst.set_double(_resolver.resolve(idx).as_number(docid));
+    }
+}
+
+FeatureExtractor::FeatureExtractor(const RankProgram &program)
+    : _resolver(program.get_seeds(false)),
+      _names(),
+      _numbers(),
+      _objects(),
+      _const_values(_resolver.num_features()),
+      _buf()
+{
+    _names.reserve(_resolver.num_features());
+    for (uint32_t i = 0; i < _resolver.num_features(); ++i) {
+        _names.emplace_back(_resolver.name_of(i));
+        if (_resolver.resolve(i).is_const()) {
+            set_value(i, 0, _const_values[i]);
+        } else if (_resolver.is_object(i)) {
+            _objects.push_back(i);
+        } else {
+            _numbers.push_back(i);
+        }
+    }
+}
+
+FeatureExtractor::~FeatureExtractor() = default;
+
+FeatureSet::UP
+FeatureExtractor::make_feature_set(uint32_t expect_docs) const
+{
+    return std::make_unique<FeatureSet>(_names, expect_docs);
+}
+
+void
+FeatureExtractor::extract(uint32_t docid, FeatureSet &features)
+{
+    FeatureSet::Value *dst = features.getFeaturesByIndex(features.addDocId(docid));
+    std::copy(_const_values.begin(), _const_values.end(), dst);
+    for (uint32_t idx : _numbers) {
+        dst[idx].set_double(_resolver.resolve(idx).as_number(docid));
+    }
+    for (uint32_t idx : _objects) {
+        set_value(idx, docid, dst[idx]);
+    }
+}
+
+}
@@ -0,0 +1,55 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "feature_resolver.h"
+#include <vespa/searchlib/common/featureset.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+namespace search::fef {
+
+class RankProgram;
+
+/**
+ * Extracts the values of all seed features of a rank program into a
+ * FeatureSet, as used when dumping summary features and rank
+ * features for a set of hits.
+ *
+ * The seeds are resolved once for all documents, and the values of
+ * constant features are calculated and encoded once, so only the
+ * non-constant features are calculated for each document. Note that
+ * objects of this class reference data owned by the rank program.
+ **/
+class FeatureExtractor
+{
+private:
+    FeatureResolver                 _resolver;
+    FeatureSet::StringVector        _names;
+    std::vector<uint32_t>           _numbers;
+    std::vector<uint32_t>           _objects;
+    std::vector<FeatureSet::Value>  _const_values;
+    vespalib::nbostream             _buf;
+
+    void set_value(uint32_t idx, uint32_t docid, FeatureSet::Value &dst);
+
+public:
+    explicit FeatureExtractor(const RankProgram &program);
+    ~FeatureExtractor();
+
+    const FeatureSet::StringVector &names() const { return _names; }
+
+    /**
+     * Create an empty feature set for the seed features, with room
+     * for the given number of documents.
+     **/
+    FeatureSet::UP make_feature_set(uint32_t expect_docs) const;
+
+    /**
+     * Add the given document to the feature set and fill in the
+     * value of all seed features for it. Any posting information
+     * needed by the rank program must be unpacked first.
+     **/
+    void extract(uint32_t docid, FeatureSet &features);
+};
+
+}
@@ -3,6 +3,9 @@
 #include "featureexecutor.h"
 #include <vespa/vespalib/util/classname.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".fef.featureexecutor");
+
 namespace search::fef {
 
 FeatureExecutor::FeatureExecutor() = default;
@@ -20,6 +23,30 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(vespalib::ConstArrayRef<uint32_t>,
+                               vespalib::ConstArrayRef<const feature_t *>,
+                               vespalib::ConstArrayRef<feature_t *>)
+{
+    LOG_ABORT("should not be reached");
+}
+
+void
+FeatureExecutor::set_upcoming_docids(vespalib::ConstArrayRef<uint32_t>)
+{
+}
+
+void
+FeatureExecutor::bind_score_threshold(const feature_t *)
+{
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
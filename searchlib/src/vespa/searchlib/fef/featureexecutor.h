@@ -150,6 +150,59 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to calculate its outputs
+     * for a batch of documents using execute_batch. Only executors
+     * with number outputs that depend solely on the document id and
+     * the values of their input features (and not on match data) may
+     * support batch execution. This method is implemented to return
+     * false by default.
+     *
+     * @return true if this feature executor supports batch execution
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Execute this feature executor for a batch of documents. Input
+     * and output values are laid out as one array per input and
+     * output feature, where the value of input (or output) idx for
+     * document docids[i] is found at inputs[idx][i] (or
+     * outputs[idx][i]). Only called if supports_batch returns true.
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs input feature values for the batch
+     * @param outputs output feature values for the batch
+     **/
+    virtual void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                               vespalib::ConstArrayRef<const feature_t *> inputs,
+                               vespalib::ConstArrayRef<feature_t *> outputs);
+
+    /**
+     * Tell this executor which documents are about to be evaluated,
+     * in increasing docid order. Executors that are able to evaluate
+     * multiple documents at once may use this to calculate their
+     * outputs for upcoming documents ahead of time. This method does
+     * nothing by default.
+     *
+     * @param docids the local document ids to be evaluated
+     **/
+    virtual void set_upcoming_docids(vespalib::ConstArrayRef<uint32_t> docids);
+
+    /**
+     * Tell this executor that its first output is the score of a
+     * ranking phase where documents scoring below the given threshold
+     * will not be among the best ranked hits. The first output may
+     * then be set to any value below the threshold for such
+     * documents, letting executors of expensive features skip the
+     * full calculation when a cheap upper bound on the score is below
+     * the threshold. The threshold is read for each document and
+     * never decreases. Other outputs are not used in this case. This
+     * method does nothing by default.
+     *
+     * @param threshold where to read the current score threshold
+     **/
+    virtual void bind_score_threshold(const feature_t *threshold);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
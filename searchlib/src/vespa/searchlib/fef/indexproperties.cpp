@@ -88,6 +88,22 @@ const vespalib::string UseFastForest::NAME("vespa.eval.use_fast_forest");
 const bool UseFastForest::DEFAULT_VALUE(false);
 bool UseFastForest::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
 
+const vespalib::string InlineFunctions::NAME("vespa.eval.inline_functions");
+const bool InlineFunctions::DEFAULT_VALUE(false);
+bool InlineFunctions::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
+
+const vespalib::string BoundedFastForest::NAME("vespa.eval.bounded_fast_forest");
+const bool BoundedFastForest::DEFAULT_VALUE(false);
+bool BoundedFastForest::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
+
+const vespalib::string OnnxBatchSize::NAME("vespa.eval.onnx_batch_size");
+const uint32_t OnnxBatchSize::DEFAULT_VALUE(1);
+uint32_t OnnxBatchSize::lookup(const Properties &props) { return lookupUint32(props, NAME, DEFAULT_VALUE); }
+
+const vespalib::string OnnxIntraOpThreads::NAME("vespa.eval.onnx_intra_op_threads");
+const uint32_t OnnxIntraOpThreads::DEFAULT_VALUE(1);
+uint32_t OnnxIntraOpThreads::lookup(const Properties &props) { return lookupUint32(props, NAME, DEFAULT_VALUE); }
+
 } // namespace eval
 
 namespace rank {
@@ -229,6 +245,21 @@ TermwiseLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string AdaptiveTermwise::NAME("vespa.matching.termwise_adaptive");
+const bool AdaptiveTermwise::DEFAULT_VALUE(false);
+
+bool
+AdaptiveTermwise::check(const Properties &props)
+{
+    return check(props, DEFAULT_VALUE);
+}
+
+bool
+AdaptiveTermwise::check(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 const vespalib::string NumThreadsPerSearch::NAME("vespa.matching.numthreadspersearch");
 const uint32_t NumThreadsPerSearch::DEFAULT_VALUE(std::numeric_limits<uint32_t>::max());
 
@@ -259,6 +290,51 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string ResultCacheSize::NAME("vespa.matching.resultcache.size");
+const uint32_t ResultCacheSize::DEFAULT_VALUE(0);
+
+uint32_t
+ResultCacheSize::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ResultCacheSize::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string FilterCacheMaxMemory::NAME("vespa.matching.filtercache.maxmemory");
+const uint32_t FilterCacheMaxMemory::DEFAULT_VALUE(0);
+
+uint32_t
+FilterCacheMaxMemory::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+FilterCacheMaxMemory::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ApproximateGrouping::NAME("vespa.matching.grouping.approximate");
+const bool ApproximateGrouping::DEFAULT_VALUE(false);
+
+bool
+ApproximateGrouping::check(const Properties &props)
+{
+    return check(props, DEFAULT_VALUE);
+}
+
+bool
+ApproximateGrouping::check(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -290,6 +366,22 @@ NearestNeighborBruteForceLimit::lookup(const Properties &props, double defaultVa
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string NearestNeighborPostFilterLimit::NAME("vespa.matching.nearest_neighbor.post_filter_limit");
+
+const double NearestNeighborPostFilterLimit::DEFAULT_VALUE(1.0);
+
+double
+NearestNeighborPostFilterLimit::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+double
+NearestNeighborPostFilterLimit::lookup(const Properties &props, double defaultValue)
+{
+    return lookupDouble(props, NAME, defaultValue);
+}
+
 const vespalib::string GlobalFilterLimit::NAME("vespa.matching.global_filter_limit");
 
 const double GlobalFilterLimit::DEFAULT_VALUE(0.0);
@@ -510,6 +602,21 @@ RankScoreDropLimit::lookup(const Properties &props)
     return lookupDouble(props, NAME, DEFAULT_VALUE);
 }
 
+const vespalib::string MaxHitsPerGroup::NAME("vespa.hitcollector.maxhitspergroup");
+const uint32_t MaxHitsPerGroup::DEFAULT_VALUE(0);
+
+uint32_t
+MaxHitsPerGroup::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+MaxHitsPerGroup::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 } // namspace hitcollector
 
 
@@ -33,6 +33,34 @@ struct UseFastForest {
     static bool check(const Properties &props);
 };
 
+// inline referenced ranking expressions before compiling. affects rank/summary/dump
+struct InlineFunctions {
+    static const vespalib::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool check(const Properties &props);
+};
+
+// let a first phase fast forest stop early for hits below the rank drop limit. affects rank
+struct BoundedFastForest {
+    static const vespalib::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool check(const Properties &props);
+};
+
+// max number of upcoming documents evaluated by a single onnx model run. affects rank/summary
+struct OnnxBatchSize {
+    static const vespalib::string NAME;
+    static const uint32_t DEFAULT_VALUE;
+    static uint32_t lookup(const Properties &props);
+};
+
+// number of intra-op threads used by each onnx model session, 0 means use the shared thread pool. affects cpu usage
+struct OnnxIntraOpThreads {
+    static const vespalib::string NAME;
+    static const uint32_t DEFAULT_VALUE;
+    static uint32_t lookup(const Properties &props);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -176,6 +204,20 @@ namespace matching {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * When enabled, parts of the query that could be evaluated
+     * termwise but are below the termwise limit measure their hit
+     * density while matching, and switch to termwise evaluation for
+     * the rest of the docid range when that is profitable. The
+     * default is false.
+     **/
+    struct AdaptiveTermwise {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props);
+        static bool check(const Properties &props, bool defaultValue);
+    };
+
     /**
      * Property for the number of threads used per search.
      **/
@@ -205,6 +247,43 @@ namespace matching {
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
 
+    /**
+     * Property for the max number of search results cached per rank
+     * profile. Cached results are reused for identical queries until
+     * the visible documents change. The default value is 0 (no cache).
+     **/
+    struct ResultCacheSize {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * Property for the max memory usage (in bytes) of bit vectors caching
+     * the result of pure filter parts of queries per rank profile. Cached
+     * filter results are reused until the visible documents change. The
+     * default value is 0 (no cache).
+     **/
+    struct FilterCacheMaxMemory {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * When enabled, grouping levels keep at most precision groups per
+     * parent group, selected by approximate hit counts, instead of
+     * creating a group for every unique value. The default is false.
+     **/
+    struct ApproximateGrouping {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props);
+        static bool check(const Properties &props, bool defaultValue);
+    };
+
     /**
      * Property to control fallback to brute force search for nearest
      * neighbor query terms.  If the ratio of candidates in the global
@@ -219,6 +298,20 @@ namespace matching {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * Property to control post filtering for nearest neighbor query
+     * terms. If the ratio of candidates in the global filter is at
+     * least this limit then search the index without the filter,
+     * exploring extra hits (scaled by the inverse ratio), and remove
+     * the hits not in the filter afterwards.
+     **/
+    struct NearestNeighborPostFilterLimit {
+        static const vespalib::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+        static double lookup(const Properties &props, double defaultValue);
+    };
+
     /**
      * Property to control fallback to not building a global filter
      * for a query with a blueprint that wants a global filter. If the
@@ -433,6 +526,18 @@ namespace hitcollector {
         static feature_t lookup(const Properties &props);
     };
 
+    /**
+     * Property for the max number of hits with the same value of the
+     * diversity attribute (see matchphase::DiversityAttribute) kept
+     * with their rank score by the hit collector in each match
+     * thread. 0 (the default) means no limit.
+     **/
+    struct MaxHitsPerGroup {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 
 } // namespace hitcollector
 
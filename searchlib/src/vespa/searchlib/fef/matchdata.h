@@ -18,6 +18,7 @@ class MatchData
 private:
     std::vector<TermFieldMatchData> _termFields;
     double                          _termwise_limit;
+    bool                            _adaptive_termwise;
 
 public:
     /**
@@ -80,6 +81,14 @@ public:
     double get_termwise_limit() const { return _termwise_limit; }
     void set_termwise_limit(double value) { _termwise_limit = value; }
 
+    /**
+     * Whether parts of the query below the termwise limit may switch
+     * to termwise evaluation at runtime, based on the hit density
+     * measured while matching. The initial value is false.
+     **/
+    bool get_adaptive_termwise() const { return _adaptive_termwise; }
+    void set_adaptive_termwise(bool value) { _adaptive_termwise = value; }
+
     /**
      * Obtain the number of term fields allocated in this match data
      * structure.
@@ -131,6 +131,71 @@ RankProgram::unbox(BlueprintResolver::FeatureRef seed, const MatchData &md)
     }
 }
 
+void
+RankProgram::setup_batch()
+{
+    const auto &seeds = _resolver->getSeedMap();
+    if (seeds.size() != 1) {
+        return;
+    }
+    auto seed = seeds.begin()->second;
+    const auto &specs = _resolver->getExecutorSpecs();
+    if (specs[seed.executor].output_types[seed.output].is_object() ||
+        check_const(_executors[seed.executor]->outputs().get_raw(seed.output)))
+    {
+        return;
+    }
+    // executors are ordered such that inputs are calculated by executors with lower index
+    std::vector<bool> needed(specs.size(), false);
+    needed[seed.executor] = true;
+    for (size_t i = specs.size(); i-- > 0; ) {
+        if (!needed[i]) {
+            continue;
+        }
+        if (!_executors[i]->supports_batch()) {
+            return;
+        }
+        for (const auto &type: specs[i].output_types) {
+            if (type.is_object()) {
+                return;
+            }
+        }
+        for (const auto &ref: specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return;
+            }
+            if (!check_const(_executors[ref.executor]->outputs().get_raw(ref.output))) {
+                needed[ref.executor] = true;
+            }
+        }
+    }
+    std::vector<vespalib::ConstArrayRef<feature_t *>> batch_outputs(specs.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        if (!needed[i]) {
+            continue;
+        }
+        size_t num_outputs = specs[i].output_types.size();
+        vespalib::ArrayRef<feature_t *> outputs = _cold_stash.create_array<feature_t *>(num_outputs, nullptr);
+        for (size_t out_idx = 0; out_idx < num_outputs; ++out_idx) {
+            outputs[out_idx] = _cold_stash.create_array<feature_t>(batch_size, 0.0).begin();
+        }
+        size_t num_inputs = specs[i].inputs.size();
+        vespalib::ArrayRef<const feature_t *> inputs = _cold_stash.create_array<const feature_t *>(num_inputs, nullptr);
+        for (size_t input_idx = 0; input_idx < num_inputs; ++input_idx) {
+            auto ref = specs[i].inputs[input_idx];
+            const NumberOrObject *input_value = _executors[ref.executor]->outputs().get_raw(ref.output);
+            if (check_const(input_value)) {
+                inputs[input_idx] = _cold_stash.create_array<feature_t>(batch_size, input_value->as_number).begin();
+            } else {
+                inputs[input_idx] = batch_outputs[ref.executor][ref.output];
+            }
+        }
+        batch_outputs[i] = outputs;
+        _batch_steps.emplace_back(_executors[i], inputs, outputs);
+    }
+    _batch_seed = batch_outputs[seed.executor][seed.output];
+}
+
 FeatureResolver
 RankProgram::resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const
 {
@@ -161,7 +226,9 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _cold_stash(),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_steps(),
+      _batch_seed(nullptr)
 {
 }
 
@@ -221,6 +288,7 @@ RankProgram::setup(const MatchData &md,
         }
     }
     assert(_executors.size() == specs.size());
+    setup_batch();
     LOG(debug, "Num executors = %ld, hot stash = %ld, cold stash = %ld, match data fields = %d",
                _executors.size(), _hot_stash.count_used(), _cold_stash.count_used(), md.getNumTermFields());
     if (LOG_WOULD_LOG(debug)) {
@@ -251,4 +319,44 @@ RankProgram::get_all_features(bool unbox_seeds) const
     return resolve(_resolver->getFeatureMap(), unbox_seeds);
 }
 
+void
+RankProgram::run_batch(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ArrayRef<feature_t> seed_values)
+{
+    assert(supports_batch());
+    assert(docids.size() <= batch_size);
+    assert(seed_values.size() == docids.size());
+    for (const auto &step: _batch_steps) {
+        step.executor->execute_batch(docids, step.inputs, step.outputs);
+    }
+    for (size_t i = 0; i < docids.size(); ++i) {
+        seed_values[i] = _batch_seed[i];
+    }
+}
+
+void
+RankProgram::set_upcoming_docids(vespalib::ConstArrayRef<uint32_t> docids)
+{
+    for (FeatureExecutor *executor: _executors) {
+        executor->set_upcoming_docids(docids);
+    }
+}
+
+void
+RankProgram::bind_score_threshold(const feature_t *threshold)
+{
+    const auto &seeds = _resolver->getSeedMap();
+    if (seeds.size() != 1) {
+        return;
+    }
+    auto seed = seeds.begin()->second;
+    const auto &specs = _resolver->getExecutorSpecs();
+    if ((seed.output != 0) ||
+        specs[seed.executor].output_types[seed.output].is_object() ||
+        check_const(_executors[seed.executor]->outputs().get_raw(seed.output)))
+    {
+        return;
+    }
+    _executors[seed.executor]->bind_score_threshold(threshold);
+}
+
 }
@@ -34,22 +34,41 @@ private:
     using ValueSet = vespalib::hash_set<const NumberOrObject *, vespalib::hash<const NumberOrObject *>,
                                         std::equal_to<>, vespalib::hashtable_base::and_modulator>;
 
+    struct BatchStep {
+        FeatureExecutor                           *executor;
+        vespalib::ConstArrayRef<const feature_t *> inputs;
+        vespalib::ConstArrayRef<feature_t *>       outputs;
+        BatchStep(FeatureExecutor *executor_in,
+                  vespalib::ConstArrayRef<const feature_t *> inputs_in,
+                  vespalib::ConstArrayRef<feature_t *> outputs_in) noexcept
+            : executor(executor_in), inputs(inputs_in), outputs(outputs_in) {}
+    };
+
     BlueprintResolver::SP            _resolver;
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    std::vector<BatchStep>           _batch_steps;
+    const feature_t                 *_batch_seed;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
     void run_const(FeatureExecutor *executor);
     void unbox(BlueprintResolver::FeatureRef seed, const MatchData &md);
+    void setup_batch();
     FeatureResolver resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const;
 
 public:
     typedef std::unique_ptr<RankProgram> UP;
 
+    /**
+     * The maximum number of documents calculated by a single call to
+     * run_batch.
+     **/
+    static constexpr size_t batch_size = 64;
+
     /**
      * Create a new rank program backed by the given resolver.
      *
@@ -59,6 +78,12 @@ public:
     ~RankProgram();
 
     size_t num_executors() const { return _executors.size(); }
+
+    /**
+     * The number of bytes used by feature executors and their
+     * storage, allocated when the program was set up.
+     **/
+    size_t stash_bytes_used() const { return _hot_stash.count_used() + _cold_stash.count_used(); }
     const FeatureExecutor &get_executor(size_t i) const { return *_executors[i]; }
 
     /**
@@ -88,6 +113,50 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    /**
+     * Check if the single seed feature of this rank program can be
+     * calculated for batches of documents using run_batch. This is
+     * the case when all non-constant feature executors needed to
+     * calculate the seed support batch execution. Such programs do
+     * not use match data, so there is no need to unpack posting
+     * information before calling run_batch.
+     **/
+    bool supports_batch() const { return !_batch_steps.empty(); }
+
+    /**
+     * Calculate the value of the single seed feature for a batch of
+     * at most batch_size documents, running each feature executor
+     * once for the whole batch. Only valid if supports_batch returns
+     * true. This does not affect the values obtained through lazy
+     * values resolved from this rank program.
+     *
+     * @param docids the local document ids to calculate the seed for
+     * @param seed_values where to store the seed value for each document
+     **/
+    void run_batch(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ArrayRef<feature_t> seed_values);
+
+    /**
+     * Tell all feature executors which documents are about to be
+     * evaluated, in increasing docid order. This enables executors
+     * to evaluate upcoming documents in batches.
+     *
+     * @param docids the local document ids to be evaluated
+     **/
+    void set_upcoming_docids(vespalib::ConstArrayRef<uint32_t> docids);
+
+    /**
+     * Let the executor calculating the single seed feature of this
+     * rank program skip the full calculation for documents that
+     * cannot score above the given threshold (see
+     * FeatureExecutor::bind_score_threshold). Only use this when
+     * documents with a seed value below the threshold are not ranked
+     * by their seed value. Does nothing if the seed is constant or
+     * not the first output of its executor.
+     *
+     * @param threshold where to read the current score threshold
+     **/
+    void bind_score_threshold(const feature_t *threshold);
 };
 
 }
@@ -37,6 +37,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _split_unpacking_iterators(false),
       _delay_unpacking_iterators(false),
       _termwise_limit(1.0),
+      _adaptive_termwise(false),
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
@@ -59,10 +60,12 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _diversityMinGroups(1),
       _diversityCutoffFactor(10.0),
       _diversityCutoffStrategy("loose"),
+      _maxHitsPerGroup(0),
       _softTimeoutEnabled(false),
       _softTimeoutTailCost(0.1),
       _softTimeoutFactor(0.5),
       _nearest_neighbor_brute_force_limit(0.05),
+      _nearest_neighbor_post_filter_limit(1.0),
       _global_filter_limit(0.0)
 { }
 
@@ -85,6 +88,7 @@ RankSetup::configure()
     split_unpacking_iterators(matching::SplitUnpackingIterators::check(_indexEnv.getProperties()));
     delay_unpacking_iterators(matching::DelayUnpackingIterators::check(_indexEnv.getProperties()));
     set_termwise_limit(matching::TermwiseLimit::lookup(_indexEnv.getProperties()));
+    set_adaptive_termwise(matching::AdaptiveTermwise::check(_indexEnv.getProperties()));
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
@@ -103,10 +107,12 @@ RankSetup::configure()
     setEstimatePoint(hitcollector::EstimatePoint::lookup(_indexEnv.getProperties()));
     setEstimateLimit(hitcollector::EstimateLimit::lookup(_indexEnv.getProperties()));
     setRankScoreDropLimit(hitcollector::RankScoreDropLimit::lookup(_indexEnv.getProperties()));
+    setMaxHitsPerGroup(hitcollector::MaxHitsPerGroup::lookup(_indexEnv.getProperties()));
     setSoftTimeoutEnabled(softtimeout::Enabled::lookup(_indexEnv.getProperties()));
     setSoftTimeoutTailCost(softtimeout::TailCost::lookup(_indexEnv.getProperties()));
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
     set_nearest_neighbor_brute_force_limit(matching::NearestNeighborBruteForceLimit::lookup(_indexEnv.getProperties()));
+    set_nearest_neighbor_post_filter_limit(matching::NearestNeighborPostFilterLimit::lookup(_indexEnv.getProperties()));
     set_global_filter_limit(matching::GlobalFilterLimit::lookup(_indexEnv.getProperties()));
 }
 
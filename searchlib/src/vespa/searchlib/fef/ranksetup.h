@@ -34,6 +34,7 @@ private:
     bool                     _split_unpacking_iterators;
     bool                     _delay_unpacking_iterators;
     double                   _termwise_limit;
+    bool                     _adaptive_termwise;
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
@@ -56,10 +57,12 @@ private:
     uint32_t                 _diversityMinGroups;
     double                   _diversityCutoffFactor;
     vespalib::string         _diversityCutoffStrategy;
+    uint32_t                 _maxHitsPerGroup;
     bool                     _softTimeoutEnabled;
     double                   _softTimeoutTailCost;
     double                   _softTimeoutFactor;
     double                   _nearest_neighbor_brute_force_limit;
+    double                   _nearest_neighbor_post_filter_limit;
     double                   _global_filter_limit;
 
 
@@ -147,6 +150,13 @@ public:
      **/
     double get_termwise_limit() const { return _termwise_limit; }
 
+    /**
+     * Whether termwise evaluation may be turned on at runtime based
+     * on the measured hit density of the query.
+     **/
+    void set_adaptive_termwise(bool value) { _adaptive_termwise = value; }
+    bool get_adaptive_termwise() const { return _adaptive_termwise; }
+
     /**
      * Sets the number of threads per search.
      *
@@ -242,6 +252,11 @@ public:
         return _diversityCutoffStrategy;
     }
 
+    /** get the max number of ranked hits per diversity group kept by each match thread, 0 means no limit **/
+    uint32_t getMaxHitsPerGroup() const {
+        return _maxHitsPerGroup;
+    }
+
     /** set name of attribute to use for graceful degradation in match phase */
     void setDegradationAttribute(const vespalib::string &name) {
         _degradationAttribute = name;
@@ -287,6 +302,11 @@ public:
         _diversityCutoffStrategy  = value;
     }
 
+    /** set the max number of ranked hits per diversity group kept by each match thread **/
+    void setMaxHitsPerGroup(uint32_t value) {
+        _maxHitsPerGroup = value;
+    }
+
     /**
      * Sets the estimate point to be used in parallel query evaluation.
      *
@@ -370,6 +390,9 @@ public:
     void set_nearest_neighbor_brute_force_limit(double v) { _nearest_neighbor_brute_force_limit = v; }
     double get_nearest_neighbor_brute_force_limit() const { return _nearest_neighbor_brute_force_limit; }
 
+    void set_nearest_neighbor_post_filter_limit(double v) { _nearest_neighbor_post_filter_limit = v; }
+    double get_nearest_neighbor_post_filter_limit() const { return _nearest_neighbor_post_filter_limit; }
+
     void set_global_filter_limit(double v) { _global_filter_limit = v; }
     double get_global_filter_limit() const { return _global_filter_limit; }
 
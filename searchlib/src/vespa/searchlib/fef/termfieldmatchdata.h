@@ -230,6 +230,12 @@ public:
         if (_sz == 0 && !allocated()) {
             _sz = 1;
             new (_data._position) TermFieldMatchDataPosition(pos);
+        } else if (__builtin_expect(allocated() && _sz < _data._positions._allocated, true)) {
+            // Fast path used when unpacking many positions into an already allocated vector.
+            if (__builtin_expect(pos.getElementLen() > _data._positions._maxElementLength, false)) {
+                _data._positions._maxElementLength = pos.getElementLen();
+            }
+            _data._positions._positions[_sz++] = pos;
         } else {
             if (!allocated()) {
                 allocateVector();
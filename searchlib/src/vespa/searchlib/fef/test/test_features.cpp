@@ -17,6 +17,15 @@ struct ImpureValueExecutor : FeatureExecutor {
     double value;
     ImpureValueExecutor(double value_in) : value(value_in) {}
     void execute(uint32_t) override { outputs().set_number(0, value); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *>,
+                       vespalib::ConstArrayRef<feature_t *> outputs_in) override
+    {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs_in[0][i] = value;
+        }
+    }
 };
 
 bool
@@ -38,6 +47,15 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *>,
+                       vespalib::ConstArrayRef<feature_t *> outputs_in) override
+    {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs_in[0][i] = docids[i];
+        }
+    }
 };
 
 bool
@@ -90,6 +108,16 @@ struct TrackingExecutor : FeatureExecutor {
         ++ext_cnt;
         outputs().set_number(0, inputs().get_number(0));
     }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *> inputs_in,
+                       vespalib::ConstArrayRef<feature_t *> outputs_in) override
+    {
+        ++ext_cnt;
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs_in[0][i] = inputs_in[0][i];
+        }
+    }
 };
 
 bool
@@ -11,7 +11,7 @@ namespace test {
 
 //-----------------------------------------------------------------------------
 
-// "ivalue(5)" calculates non-const 5.0
+// "ivalue(5)" calculates non-const 5.0 (supports batch execution)
 struct ImpureValueBlueprint : Blueprint {
     double value;
     ImpureValueBlueprint() : Blueprint("ivalue"), value(31212.0) {}
@@ -23,7 +23,7 @@ struct ImpureValueBlueprint : Blueprint {
 
 //-----------------------------------------------------------------------------
 
-// "docid" calculates local document id
+// "docid" calculates local document id (supports batch execution)
 struct DocidBlueprint : Blueprint {
     DocidBlueprint() : Blueprint("docid") {}
     void visitDumpFeatures(const IIndexEnvironment &, IDumpFeatureVisitor &) const override {}
@@ -46,6 +46,7 @@ struct BoxingBlueprint : Blueprint {
 //-----------------------------------------------------------------------------
 
 // "track(docid)" calculates docid and counts execution as a side-effect
+// (supports batch execution, counting each batch as a single execution)
 struct TrackingBlueprint : Blueprint {
     size_t &ext_cnt;
     TrackingBlueprint(size_t &ext_cnt_in) : Blueprint("track"), ext_cnt(ext_cnt_in) {}
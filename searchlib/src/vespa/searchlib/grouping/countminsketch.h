@@ -0,0 +1,76 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace search {
+
+/**
+ * Count-min sketch estimating how many times each hash has been seen,
+ * using Depth rows of Width counters. An estimate is never lower than
+ * the true count, and with probability 1 - e^-Depth it is at most
+ * (e / Width) * getTotal() too high.
+ */
+template <uint32_t Width = 2048, uint32_t Depth = 4>
+class CountMinSketch {
+    static_assert((Width & (Width - 1)) == 0, "Width must be a power of 2");
+    std::vector<uint32_t> _counters;
+    uint64_t              _total;
+
+    static uint32_t bucket(uint64_t hash, uint32_t row) {
+        // Derive the row hashes from the two halves of the hash (double hashing).
+        uint32_t h1 = hash;
+        uint32_t h2 = (hash >> 32) | 1;
+        return row * Width + ((h1 + row * h2) & (Width - 1));
+    }
+
+public:
+    typedef uint64_t hash_type;
+    enum { width = Width, depth = Depth };
+
+    CountMinSketch() : _counters(Width * Depth, 0), _total(0) {}
+
+    /**
+     * Count the given hash once.
+     * @return the estimated count of the hash after it was added.
+     */
+    uint32_t add(uint64_t hash) {
+        ++_total;
+        uint32_t estimate = UINT32_MAX;
+        for (uint32_t row = 0; row < Depth; ++row) {
+            uint32_t &counter = _counters[bucket(hash, row)];
+            estimate = std::min(estimate, ++counter);
+        }
+        return estimate;
+    }
+
+    uint32_t estimate(uint64_t hash) const {
+        uint32_t estimate = UINT32_MAX;
+        for (uint32_t row = 0; row < Depth; ++row) {
+            estimate = std::min(estimate, _counters[bucket(hash, row)]);
+        }
+        return estimate;
+    }
+
+    void merge(const CountMinSketch &other) {
+        for (size_t i = 0; i < _counters.size(); ++i) {
+            _counters[i] += other._counters[i];
+        }
+        _total += other._total;
+    }
+
+    uint64_t getTotal() const { return _total; }
+
+    /**
+     * The amount any estimate may be too high, with probability 1 - e^-Depth.
+     */
+    uint64_t getErrorBound() const {
+        return std::ceil(M_E * _total / Width);
+    }
+};
+
+}  // namespace search
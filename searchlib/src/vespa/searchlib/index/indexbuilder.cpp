@@ -11,4 +11,10 @@ IndexBuilder::IndexBuilder(const Schema &schema)
 
 IndexBuilder::~IndexBuilder() = default;
 
+std::unique_ptr<IndexBuilder>
+IndexBuilder::make_field_builder(uint32_t)
+{
+    return std::unique_ptr<IndexBuilder>();
+}
+
 }
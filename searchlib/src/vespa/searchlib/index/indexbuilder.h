@@ -2,6 +2,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <memory>
 
 namespace search::index {
 
@@ -30,6 +31,15 @@ public:
     virtual void startWord(vespalib::stringref word) = 0;
     virtual void endWord() = 0;
     virtual void add_document(const DocIdAndFeatures &features) = 0;
+
+    /**
+     * Returns a builder for adding the words of the given field only.
+     * Builders for different fields may be used concurrently, from
+     * different threads, when this builder is not used for adding
+     * fields at the same time. Returns an empty pointer if fields can
+     * only be added sequentially through this builder.
+     */
+    virtual std::unique_ptr<IndexBuilder> make_field_builder(uint32_t fieldId);
 };
 
 }
@@ -79,6 +79,12 @@ PostingListFileRandRead::~PostingListFileRandRead()
 {
 }
 
+void
+PostingListFileRandRead::prefetchPostingList(const PostingListCounts &, uint32_t, uint32_t,
+                                             const PostingListHandle &)
+{
+}
+
 void
 PostingListFileRandRead::afterOpen(FastOS_FileInterface &file)
 {
@@ -121,6 +127,16 @@ readPostingList(const PostingListCounts &counts,
                             handle);
 }
 
+void
+PostingListFileRandReadPassThrough::
+prefetchPostingList(const PostingListCounts &counts,
+                    uint32_t firstSegment,
+                    uint32_t numSegments,
+                    const PostingListHandle &handle)
+{
+    _lower->prefetchPostingList(counts, firstSegment, numSegments, handle);
+}
+
 bool
 PostingListFileRandReadPassThrough::open(const vespalib::string &name,
         const TuneFileRandRead &tuneFileRead)
@@ -162,6 +162,16 @@ public:
                     uint32_t numSegments,
                     PostingListHandle &handle) = 0;
 
+    /**
+     * Hint that a (possibly partial) posting list will be read soon,
+     * allowing reads of several posting lists to overlap.
+     */
+    virtual void
+    prefetchPostingList(const PostingListCounts &counts,
+                        uint32_t firstSegment,
+                        uint32_t numSegments,
+                        const PostingListHandle &handle);
+
     /**
      * Open posting list file for random read.
      */
@@ -202,6 +212,9 @@ public:
     void readPostingList(const PostingListCounts &counts, uint32_t firstSegment,
                          uint32_t numSegments, PostingListHandle &handle) override;
 
+    void prefetchPostingList(const PostingListCounts &counts, uint32_t firstSegment,
+                             uint32_t numSegments, const PostingListHandle &handle) override;
+
     bool open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead) override;
     bool close() override;
 };
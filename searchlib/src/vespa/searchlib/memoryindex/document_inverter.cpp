@@ -43,8 +43,10 @@ using search::index::FieldLengthCalculator;
 DocumentInverter::DocumentInverter(const Schema &schema,
                                    ISequencedTaskExecutor &invertThreads,
                                    ISequencedTaskExecutor &pushThreads,
-                                   IFieldIndexCollection &fieldIndexes)
+                                   IFieldIndexCollection &fieldIndexes,
+                                   uint32_t numShards)
     : _schema(schema),
+      _numShards(std::max(1u, numShards)),
       _indexedFieldPaths(),
       _dataType(nullptr),
       _schemaIndexFields(),
@@ -55,26 +57,30 @@ DocumentInverter::DocumentInverter(const Schema &schema,
 {
     _schemaIndexFields.setup(schema);
 
-    for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
-         ++fieldId) {
-        auto &remover(fieldIndexes.get_remover(fieldId));
-        auto &inserter(fieldIndexes.get_inserter(fieldId));
-        auto &calculator(fieldIndexes.get_calculator(fieldId));
-        _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId, remover, inserter, calculator));
+    for (uint32_t shard = 0; shard < _numShards; ++shard) {
+        for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
+             ++fieldId) {
+            auto &remover(fieldIndexes.get_remover(fieldId));
+            auto &inserter(fieldIndexes.get_inserter(fieldId));
+            auto &calculator(fieldIndexes.get_calculator(fieldId));
+            _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId, remover, inserter, calculator));
+        }
     }
-    for (auto &urlField : _schemaIndexFields._uriFields) {
-        Schema::CollectionType collectionType =
-            _schema.getIndexField(urlField._all).getCollectionType();
-        _urlInverters.push_back(std::make_unique<UrlFieldInverter>
-                                (collectionType,
-                                 _inverters[urlField._all].get(),
-                                 _inverters[urlField._scheme].get(),
-                                 _inverters[urlField._host].get(),
-                                 _inverters[urlField._port].get(),
-                                 _inverters[urlField._path].get(),
-                                 _inverters[urlField._query].get(),
-                                 _inverters[urlField._fragment].get(),
-                                 _inverters[urlField._hostname].get()));
+    for (uint32_t shard = 0; shard < _numShards; ++shard) {
+        for (auto &urlField : _schemaIndexFields._uriFields) {
+            Schema::CollectionType collectionType =
+                _schema.getIndexField(urlField._all).getCollectionType();
+            _urlInverters.push_back(std::make_unique<UrlFieldInverter>
+                                    (collectionType,
+                                     getInverter(urlField._all, shard),
+                                     getInverter(urlField._scheme, shard),
+                                     getInverter(urlField._host, shard),
+                                     getInverter(urlField._port, shard),
+                                     getInverter(urlField._path, shard),
+                                     getInverter(urlField._query, shard),
+                                     getInverter(urlField._fragment, shard),
+                                     getInverter(urlField._hostname, shard)));
+        }
     }
 }
 
@@ -124,6 +130,7 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
     if (_indexedFieldPaths.empty() || _dataType != dataType) {
         buildFieldPath(doc.getType(), dataType);
     }
+    uint32_t shard = getShard(docId);
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
         const FieldPath *const fieldPath(_indexedFieldPaths[fieldId].get());
         FieldValue::UP fv;
@@ -132,12 +139,12 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             // FieldValue::UP fv = doc.getNestedFieldValue(fieldPath.begin(), fieldPath.end());
             fv = doc.getValue(*fieldPath);
         }
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getInverter(fieldId, shard);
+        _invertThreads.execute(getInvertComponentId(fieldId, shard),
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
     }
-    uint32_t urlId = 0;
+    uint32_t urlId = _schemaIndexFields._uriFields.size() * shard;
     for (const auto & fi : _schemaIndexFields._uriFields) {
         uint32_t fieldId = fi._all;
         const FieldPath *const fieldPath(_indexedFieldPaths[fieldId].get());
@@ -148,7 +155,7 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             fv = doc.getValue(*fieldPath);
         }
         UrlFieldInverter *inverter = _urlInverters[urlId].get();
-        _invertThreads.execute(fieldId,
+        _invertThreads.execute(getInvertComponentId(fieldId, shard),
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
         ++urlId;
@@ -158,17 +165,18 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
 void
 DocumentInverter::removeDocument(uint32_t docId)
 {
+    uint32_t shard = getShard(docId);
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getInverter(fieldId, shard);
+        _invertThreads.execute(getInvertComponentId(fieldId, shard),
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
     }
-    uint32_t urlId = 0;
+    uint32_t urlId = _schemaIndexFields._uriFields.size() * shard;
     for (const auto & fi : _schemaIndexFields._uriFields) {
         uint32_t fieldId = fi._all;
         UrlFieldInverter *inverter = _urlInverters[urlId].get();
-        _invertThreads.execute(fieldId,
+        _invertThreads.execute(getInvertComponentId(fieldId, shard),
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
         ++urlId;
@@ -178,16 +186,29 @@ DocumentInverter::removeDocument(uint32_t docId)
 void
 DocumentInverter::pushDocuments(const std::shared_ptr<IDestructorCallback> &onWriteDone)
 {
-    uint32_t fieldId = 0;
-    for (auto &inverter : _inverters) {
+    for (uint32_t fieldId = 0; fieldId < getNumFields(); ++fieldId) {
+        std::vector<FieldInverter *> inverters;
+        for (uint32_t shard = 0; shard < _numShards; ++shard) {
+            inverters.push_back(getInverter(fieldId, shard));
+        }
         _pushThreads.execute(fieldId,
-                             [inverter(inverter.get()),
+                             [inverters(std::move(inverters)),
                               onWriteDone]()
-                             {   inverter->applyRemoves();
-                                 inverter->pushDocuments(); });
-        ++fieldId;
+                             {   for (auto inverter : inverters) {
+                                     inverter->applyRemoves();
+                                     inverter->pushDocuments();
+                                 } });
     }
 }
 
+uint32_t
+DocumentInverter::calcNumShards(const Schema &schema, const ISequencedTaskExecutor &invertThreads)
+{
+    index::SchemaIndexFields schemaIndexFields;
+    schemaIndexFields.setup(schema);
+    size_t numInvertedFields = schemaIndexFields._textFields.size() + schemaIndexFields._uriFields.size();
+    return std::max(1ul, invertThreads.getNumExecutors() / std::max(1ul, numInvertedFields));
+}
+
 }
 
@@ -31,6 +31,10 @@ class IFieldIndexCollection;
  * Class used to invert the fields for a set of documents, preparing for pushing changes info field indexes.
  *
  * Each text and uri field in the document is handled separately by a FieldInverter and UrlFieldInverter.
+ *
+ * Each field can be split into multiple shards, where documents are assigned to a shard by document id.
+ * The shards of a field are inverted in parallel by the 'invert threads' executor,
+ * and pushed in sequence to the field index by the 'push threads' executor.
  */
 class DocumentInverter {
 private:
@@ -39,6 +43,7 @@ private:
     DocumentInverter &operator=(const DocumentInverter &) = delete;
 
     const index::Schema &_schema;
+    const uint32_t       _numShards;
 
     void addFieldPath(const document::DocumentType &docType, uint32_t fieldId);
     void buildFieldPath(const document::DocumentType & docType, const document::DataType *dataType);
@@ -52,12 +57,17 @@ private:
 
     index::SchemaIndexFields  _schemaIndexFields;
 
+    // Inverters for all fields in shard 0, followed by inverters for all fields in shard 1, etc.
     std::vector<std::unique_ptr<FieldInverter>> _inverters;
     std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
     ISequencedTaskExecutor &_invertThreads;
     ISequencedTaskExecutor &_pushThreads;
 
     const index::Schema &getSchema() const { return _schema; }
+    uint32_t getShard(uint32_t docId) const { return docId % _numShards; }
+    uint64_t getInvertComponentId(uint32_t fieldId, uint32_t shard) const {
+        return fieldId + static_cast<uint64_t>(shard) * getNumFields();
+    }
 
 public:
     /**
@@ -67,11 +77,13 @@ public:
      * @param invertThreads the executor with threads for doing document inverting.
      * @param pushThreads   the executor with threads for doing pushing of inverted documents
      *                      to corresponding field indexes.
+     * @param numShards     the number of shards each field is split into during inverting.
      */
     DocumentInverter(const index::Schema &schema,
                      ISequencedTaskExecutor &invertThreads,
                      ISequencedTaskExecutor &pushThreads,
-                     IFieldIndexCollection &fieldIndexes);
+                     IFieldIndexCollection &fieldIndexes,
+                     uint32_t numShards = 1);
 
     ~DocumentInverter();
 
@@ -107,13 +119,20 @@ public:
      */
     void removeDocument(uint32_t docId);
 
-    FieldInverter *getInverter(uint32_t fieldId) const {
-        return _inverters[fieldId].get();
+    FieldInverter *getInverter(uint32_t fieldId, uint32_t shard = 0) const {
+        return _inverters[getNumFields() * shard + fieldId].get();
     }
 
     const std::vector<std::unique_ptr<FieldInverter> > & getInverters() const { return _inverters; }
 
-    uint32_t getNumFields() const { return _inverters.size(); }
+    uint32_t getNumFields() const { return _schema.getNumIndexFields(); }
+    uint32_t getNumShards() const { return _numShards; }
+
+    /**
+     * Returns the number of shards to use per field for the given schema, spreading the
+     * inverting of the fields over all threads in the given executor.
+     */
+    static uint32_t calcNumShards(const index::Schema &schema, const ISequencedTaskExecutor &invertThreads);
 };
 
 }
@@ -12,8 +12,13 @@
 #include <vespa/vespalib/btree/btreenodestore.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/btree/btreestore.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <vespa/document/util/queue.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.memoryindex.field_index_collection");
@@ -58,6 +63,39 @@ FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder)
     }
 }
 
+void
+FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder, vespalib::ThreadExecutor &executor)
+{
+    std::vector<std::unique_ptr<search::index::IndexBuilder>> fieldBuilders;
+    for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+        fieldBuilders.push_back(indexBuilder.make_field_builder(fieldId));
+        if ( ! fieldBuilders.back()) {
+            dump(indexBuilder);
+            return;
+        }
+    }
+    // Each field is written by one thread; leave room for other users of the executor
+    uint32_t maxConcurrentThreads = std::max(1ul, executor.getNumThreads() / 2);
+    document::Semaphore concurrent(maxConcurrentThreads);
+    vespalib::CountDownLatch done(_numFields);
+    for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+        concurrent.wait();
+        auto task = vespalib::makeLambdaTask([this, fieldId, &fieldBuilders, &concurrent, &done]() {
+            search::index::IndexBuilder &fieldBuilder = *fieldBuilders[fieldId];
+            fieldBuilder.startField(fieldId);
+            _fieldIndexes[fieldId]->dump(fieldBuilder);
+            fieldBuilder.endField();
+            concurrent.post();
+            done.countDown();
+        });
+        auto rejected = executor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    done.await();
+}
+
 vespalib::MemoryUsage
 FieldIndexCollection::getMemoryUsage() const
 {
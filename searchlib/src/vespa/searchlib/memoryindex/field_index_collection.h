@@ -12,6 +12,8 @@ namespace search::index {
     class Schema;
 }
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search::memoryindex {
 
 class IFieldIndexRemoveListener;
@@ -44,6 +46,12 @@ public:
 
     void dump(search::index::IndexBuilder & indexBuilder);
 
+    /**
+     * Dump all fields, writing independent fields concurrently using
+     * the given executor when the index builder supports it.
+     */
+    void dump(search::index::IndexBuilder & indexBuilder, vespalib::ThreadExecutor & executor);
+
     vespalib::MemoryUsage getMemoryUsage() const;
 
     IFieldIndex *getFieldIndex(uint32_t fieldId) const {
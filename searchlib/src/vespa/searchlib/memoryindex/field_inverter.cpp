@@ -16,6 +16,7 @@
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchlib/common/sort.h>
 #include <vespa/searchlib/util/url.h>
+#include <vespa/vespalib/stllike/hash_set.hpp>
 #include <vespa/vespalib/text/lowercase.h>
 #include <vespa/vespalib/text/utf8.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -166,9 +167,11 @@ FieldInverter::reset()
     _elems.clear();
     _positions.clear();
     _wordRefs.resize(1);
+    _wordRefSet.clear();
     _pendingDocs.clear();
     _abortedDocs.clear();
     _removeDocs.clear();
+    _fieldLengths.clear();
     _oldPosSize = 0u;
 }
 
@@ -196,7 +199,6 @@ FieldInverter::sortWords()
     }
     // Populate word numbers in word buffer and mapping from
     // word numbers to word reference.
-    // TODO: shrink word buffer to only contain unique words
     auto w(_wordRefs.begin() + 1);
     auto we(_wordRefs.end());
     uint32_t wordNum = 1;   // First valid word number
@@ -244,6 +246,10 @@ FieldInverter::saveWord(const vespalib::stringref word)
     if (len == 0) {
         return 0u;
     }
+    auto itr = _wordRefSet.find(word);
+    if (itr != _wordRefSet.end()) {
+        return *itr;
+    }
 
     const size_t fullyPaddedSize = (wordsSize + 4 + len + 1 + 3) & ~3;
     _words.reserve(vespalib::roundUp2inN(fullyPaddedSize));
@@ -258,6 +264,7 @@ FieldInverter::saveWord(const vespalib::stringref word)
     uint32_t wordRef = (wordsSize + 4) >> 2;
     // assert(wordRef != 0);
     _wordRefs.push_back(wordRef);
+    _wordRefSet.insert(wordRef);
     return wordRef;
 }
 
@@ -294,7 +301,7 @@ FieldInverter::endDoc()
             ++itr;
         }
     }
-    _calculator.add_field_length(field_length);
+    _fieldLengths.push_back(field_length);
     uint32_t newPosSize = static_cast<uint32_t>(_positions.size());
     _pendingDocs.insert({ _docId,
                              { _oldPosSize, newPosSize - _oldPosSize } });
@@ -357,10 +364,12 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _features(),
       _elementWordRefs(),
       _wordRefs(1),
+      _wordRefSet(0, WordRefHash(_words), WordRefEqual(_words)),
       _terms(),
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs(),
+      _fieldLengths(),
       _remover(remover),
       _inserter(inserter),
       _calculator(calculator)
@@ -502,6 +511,10 @@ FieldInverter::applyRemoves()
 void
 FieldInverter::pushDocuments()
 {
+    for (auto field_length : _fieldLengths) {
+        _calculator.add_field_length(field_length);
+    }
+    _fieldLengths.clear();
     trimAbortedDocs();
 
     if (_positions.empty()) {
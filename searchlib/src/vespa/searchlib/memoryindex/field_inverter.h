@@ -10,6 +10,7 @@
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/vespalib/stllike/allocator.h>
+#include <vespa/vespalib/stllike/hash_set.h>
 #include <limits>
 #include <map>
 
@@ -135,6 +136,51 @@ private:
         }
     };
 
+    /*
+     * Hash and equality functors for word references, used to look up
+     * words already saved in the word buffer.
+     */
+    class WordRefHash {
+        const WordBuffer *_wordBuffer;
+
+    public:
+        WordRefHash(const WordBuffer &wordBuffer)
+            : _wordBuffer(&wordBuffer)
+        {
+        }
+
+        size_t operator()(const uint32_t wordRef) const {
+            return vespalib::hashValue(&(*_wordBuffer)[static_cast<size_t>(wordRef) << 2]);
+        }
+        size_t operator()(const vespalib::stringref word) const {
+            return vespalib::hashValue(word.data(), word.size());
+        }
+    };
+
+    class WordRefEqual {
+        const WordBuffer *_wordBuffer;
+
+    public:
+        WordRefEqual(const WordBuffer &wordBuffer)
+            : _wordBuffer(&wordBuffer)
+        {
+        }
+
+        const char *getWord(uint32_t wordRef) const {
+            return &(*_wordBuffer)[static_cast<size_t>(wordRef) << 2];
+        }
+
+        bool operator()(const uint32_t lhs, const uint32_t rhs) const {
+            return strcmp(getWord(lhs), getWord(rhs)) == 0;
+        }
+        bool operator()(const uint32_t lhs, const vespalib::stringref rhs) const {
+            const char *word = getWord(lhs);
+            return strncmp(word, rhs.data(), rhs.size()) == 0 && word[rhs.size()] == '\0';
+        }
+    };
+
+    using WordRefSet = vespalib::hash_set<uint32_t, WordRefHash, WordRefEqual>;
+
     /*
      * Range in _positions vector used to represent a document put.
      */
@@ -176,6 +222,7 @@ private:
     index::DocIdAndPosOccFeatures  _features;
     UInt32Vector                   _elementWordRefs;
     UInt32Vector                   _wordRefs;
+    WordRefSet                     _wordRefSet; // Unique words saved in word buffer
 
     using SpanTerm = std::pair<document::Span, const document::FieldValue *>;
     using SpanTermVector = std::vector<SpanTerm>;
@@ -185,6 +232,8 @@ private:
     std::vector<PositionRange>        _abortedDocs;
     std::map<uint32_t, PositionRange> _pendingDocs;
     UInt32Vector                      _removeDocs;
+    // Field lengths of inverted documents, added to the calculator when pushing
+    UInt32Vector                      _fieldLengths;
 
     FieldIndexRemover                &_remover;
     IOrderedFieldIndexInserter       &_inserter;
@@ -199,6 +248,7 @@ public:
 private:
     /**
      * Save the given word in the word buffer and return the word reference.
+     * A word is only saved once, repeated occurrences get the same word reference.
      */
     VESPA_DLL_LOCAL uint32_t saveWord(const vespalib::stringref word);
 
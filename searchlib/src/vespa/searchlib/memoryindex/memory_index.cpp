@@ -57,8 +57,10 @@ MemoryIndex::MemoryIndex(const Schema& schema,
       _invertThreads(invertThreads),
       _pushThreads(pushThreads),
       _fieldIndexes(std::make_unique<FieldIndexCollection>(_schema, inspector)),
-      _inverter0(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads, *_fieldIndexes)),
-      _inverter1(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads, *_fieldIndexes)),
+      _inverter0(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads, *_fieldIndexes,
+                                                    DocumentInverter::calcNumShards(_schema, _invertThreads))),
+      _inverter1(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads, *_fieldIndexes,
+                                                    _inverter0->getNumShards())),
       _inverter(_inverter0.get()),
       _frozen(false),
       _maxDocId(0), // docId 0 is reserved
@@ -133,6 +135,12 @@ MemoryIndex::dump(IndexBuilder &indexBuilder)
     _fieldIndexes->dump(indexBuilder);
 }
 
+void
+MemoryIndex::dump(IndexBuilder &indexBuilder, vespalib::ThreadExecutor &executor)
+{
+    _fieldIndexes->dump(indexBuilder, executor);
+}
+
 namespace {
 
 /**
@@ -14,7 +14,10 @@ namespace search::index {
     class IndexBuilder;
 }
 
-namespace vespalib { class ISequencedTaskExecutor; }
+namespace vespalib {
+    class ISequencedTaskExecutor;
+    class ThreadExecutor;
+}
 
 namespace document { class Document; }
 
@@ -140,6 +143,12 @@ public:
      */
     void dump(index::IndexBuilder &indexBuilder);
 
+    /**
+     * Dump the contents of this index into the given index builder,
+     * writing independent fields concurrently using the given executor.
+     */
+    void dump(index::IndexBuilder &indexBuilder, vespalib::ThreadExecutor &executor);
+
     // Implements Searchable
     queryeval::Blueprint::UP createBlueprint(const queryeval::IRequestContext & requestContext,
                                              const queryeval::FieldSpec &field,
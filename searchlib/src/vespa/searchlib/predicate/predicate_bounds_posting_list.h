@@ -19,6 +19,15 @@ class PredicateBoundsPostingList : public PredicatePostingList {
     uint32_t _interval_count;
     uint32_t _value_diff;
     IntervalWithBounds _single_buf;
+    // Identical interval lists share a single entry in the interval
+    // store (see PredicateRefCache), so the bounds check result for
+    // the last seen entry is reused by subsequent documents.
+    vespalib::datastore::EntryRef _cached_ref;
+    const IntervalWithBounds *_cached_interval;
+    uint32_t _cached_count;
+    bool _has_cached;
+
+    VESPA_DLL_LOCAL void updateCache(vespalib::datastore::EntryRef ref);
 
 public:
     PredicateBoundsPostingList(const PredicateIntervalStore &interval_store,Iterator it,uint32_t value_diff);
@@ -37,7 +46,11 @@ PredicateBoundsPostingList<Iterator>::PredicateBoundsPostingList(
           _iterator(it),
           _current_interval(0),
           _interval_count(0),
-          _value_diff(value_diff) {
+          _value_diff(value_diff),
+          _cached_ref(),
+          _cached_interval(nullptr),
+          _cached_count(0),
+          _has_cached(false) {
 }
 
 namespace {
@@ -52,6 +65,20 @@ namespace {
     }
 }  // namespace
 
+template<typename Iterator>
+void PredicateBoundsPostingList<Iterator>::updateCache(vespalib::datastore::EntryRef ref) {
+    uint32_t count;
+    const IntervalWithBounds *interval = _interval_store.get(ref, count, &_single_buf);
+    while (count > 0 && !checkBounds(interval->bounds, _value_diff)) {
+        ++interval;
+        --count;
+    }
+    _cached_ref = ref;
+    _cached_interval = interval;
+    _cached_count = count;
+    _has_cached = true;
+}
+
 template<typename Iterator>
 bool PredicateBoundsPostingList<Iterator>::next(uint32_t doc_id) {
     if (_iterator.valid() && _iterator.getKey() <= doc_id) {
@@ -61,11 +88,13 @@ bool PredicateBoundsPostingList<Iterator>::next(uint32_t doc_id) {
         if (!_iterator.valid()) {
             return false;
         }
-        _current_interval = _interval_store.get(_iterator.getData(), _interval_count, &_single_buf);
-        if (checkBounds(_current_interval->bounds, _value_diff)) {
-            break;
+        vespalib::datastore::EntryRef ref = _iterator.getData();
+        if (!_has_cached || ref != _cached_ref) {
+            updateCache(ref);
         }
-        if (nextInterval()) {
+        if (_cached_count > 0) {
+            _current_interval = _cached_interval;
+            _interval_count = _cached_count;
             break;
         }
     }
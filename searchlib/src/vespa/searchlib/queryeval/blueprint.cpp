@@ -72,6 +72,7 @@ Blueprint::min(const std::vector<HitEstimate> &data)
 Blueprint::State::State(const FieldSpecBaseList &fields_in)
     : _fields(fields_in),
       _estimate(),
+      _cost(COST_NORMAL),
       _cost_tier(COST_TIER_NORMAL),
       _tree_size(1),
       _allow_termwise_eval(true),
@@ -286,6 +287,16 @@ IntermediateBlueprint::calculate_cost_tier() const
     return cost_tier;
 }
 
+double
+IntermediateBlueprint::calculate_cost() const
+{
+    double cost = _children.empty() ? State::COST_NORMAL : 0.0;
+    for (const Blueprint * child : _children) {
+        cost = std::max(cost, child->getState().cost());
+    }
+    return cost;
+}
+
 uint32_t
 IntermediateBlueprint::calculate_tree_size() const
 {
@@ -384,6 +395,7 @@ IntermediateBlueprint::calculateState() const
     State state(exposeFields());
     state.estimate(calculateEstimate());
     state.cost_tier(calculate_cost_tier());
+    state.cost(calculate_cost());
     state.allow_termwise_eval(infer_allow_termwise_eval());
     state.want_global_filter(infer_want_global_filter());
     state.tree_size(calculate_tree_size());
@@ -411,6 +423,12 @@ IntermediateBlueprint::should_do_termwise_eval(const UnpackInfo &unpack, double
     return (count_termwise_nodes(unpack) > 1);
 }
 
+bool
+IntermediateBlueprint::should_do_adaptive_termwise_eval(const UnpackInfo &unpack, double match_limit) const
+{
+    return (root().hit_ratio() <= match_limit) && should_do_termwise_eval(unpack, 0.0);
+}
+
 void
 IntermediateBlueprint::optimize(Blueprint* &self)
 {
@@ -639,6 +657,13 @@ LeafBlueprint::set_cost_tier(uint32_t value)
     notifyChange();
 }
 
+void
+LeafBlueprint::set_cost(double value)
+{
+    _state.cost(value);
+    notifyChange();
+}
+
 void
 LeafBlueprint::set_allow_termwise_eval(bool value)
 {
@@ -65,6 +65,7 @@ public:
     private:
         FieldSpecBaseList _fields;
         HitEstimate       _estimate;
+        double            _cost;
         uint32_t          _cost_tier;
         uint32_t          _tree_size;
         bool              _allow_termwise_eval;
@@ -75,6 +76,10 @@ public:
         static constexpr uint32_t COST_TIER_EXPENSIVE = 2;
         static constexpr uint32_t COST_TIER_MAX = 999;
 
+        // relative cost of producing or checking a single hit, used to order children within a cost tier
+        static constexpr double COST_CHEAP = 0.5;  // e.g. bit vector lookups
+        static constexpr double COST_NORMAL = 1.0; // e.g. posting list iteration
+
         State(const FieldSpecBaseList &fields_in);
         State(const State &rhs) = delete;
         State(State &&rhs) = default;
@@ -111,6 +116,8 @@ public:
         bool want_global_filter() const { return _want_global_filter; }
         void cost_tier(uint32_t value) { _cost_tier = value; }
         uint32_t cost_tier() const { return _cost_tier; }
+        void cost(double value) { _cost = value; }
+        double cost() const { return _cost; }
     };
 
     // utility that just takes maximum estimate
@@ -119,7 +126,7 @@ public:
     // utility that just takes minium estimate
     static HitEstimate min(const std::vector<HitEstimate> &data);
 
-    // utility to get the greater estimate to sort first, higher tiers last
+    // utility to get the greater estimate per unit of cost to sort first, higher tiers last
     struct TieredGreaterEstimate {
         bool operator () (Blueprint * const &a, Blueprint * const &b) const {
             const auto &lhs = a->getState();
@@ -127,11 +134,16 @@ public:
             if (lhs.cost_tier() != rhs.cost_tier()) {
                 return (lhs.cost_tier() < rhs.cost_tier());
             }
-            return (rhs.estimate() < lhs.estimate());
+            HitEstimate lhs_est = lhs.estimate();
+            HitEstimate rhs_est = rhs.estimate();
+            if (lhs_est.empty != rhs_est.empty) {
+                return rhs_est.empty;
+            }
+            return ((lhs_est.estHits / lhs.cost()) > (rhs_est.estHits / rhs.cost()));
         }
     };
 
-    // utility to get the lesser estimate to sort first, higher tiers last
+    // utility to get the lesser estimated work (estimate times cost) to sort first, higher tiers last
     struct TieredLessEstimate {
         bool operator () (Blueprint * const &a, const Blueprint * const &b) const {
             const auto &lhs = a->getState();
@@ -139,7 +151,12 @@ public:
             if (lhs.cost_tier() != rhs.cost_tier()) {
                 return (lhs.cost_tier() < rhs.cost_tier());
             }
-            return (lhs.estimate() < rhs.estimate());
+            HitEstimate lhs_est = lhs.estimate();
+            HitEstimate rhs_est = rhs.estimate();
+            if (lhs_est.empty != rhs_est.empty) {
+                return lhs_est.empty;
+            }
+            return ((lhs_est.estHits * lhs.cost()) < (rhs_est.estHits * rhs.cost()));
         }
     };
 
@@ -263,6 +280,7 @@ private:
     Children _children;
     HitEstimate calculateEstimate() const;
     uint32_t calculate_cost_tier() const;
+    double calculate_cost() const;
     uint32_t calculate_tree_size() const;
     bool infer_allow_termwise_eval() const;
     bool infer_want_global_filter() const;
@@ -280,6 +298,8 @@ protected:
     virtual bool isPositive(size_t index) const { (void) index; return true; }
 
     bool should_do_termwise_eval(const UnpackInfo &unpack, double match_limit) const;
+    // termwise evaluation would be possible, but the estimated global hit density is below the limit
+    bool should_do_adaptive_termwise_eval(const UnpackInfo &unpack, double match_limit) const;
 
     const Children& get_children() const { return _children; }
 
@@ -328,6 +348,7 @@ protected:
     void optimize(Blueprint* &self) override final;
     void setEstimate(HitEstimate est);
     void set_cost_tier(uint32_t value);
+    void set_cost(double value);
     void set_allow_termwise_eval(bool value);
     void set_want_global_filter(bool value);
     void set_tree_size(uint32_t value);
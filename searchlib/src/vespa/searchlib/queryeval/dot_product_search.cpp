@@ -107,6 +107,114 @@ public:
     void visitMembers(vespalib::ObjectVisitor &) const override {}
 };
 
+/**
+ * Dot product evaluated term-at-a-time within windows of the docid
+ * space. When the first docid of a new window is sought, all children
+ * are traversed in turn across the window. Their weighted scores are
+ * accumulated in a dense array and hits are marked in a bitmap. This
+ * replaces a heap operation per posting by an array update, which
+ * pays off for queries with a large number of terms.
+ **/
+template <typename IteratorPack>
+class WindowedDotProductSearchImpl : public DotProductSearch
+{
+private:
+    static constexpr uint32_t window_size = 4096;
+
+    TermFieldMatchData     &_tmd;
+    std::vector<int32_t>    _weights;
+    std::vector<uint32_t>   _termPos;
+    std::vector<feature_t>  _scores;
+    std::vector<uint64_t>   _hits;
+    uint32_t                _window_begin;
+    uint32_t                _window_end;
+    IteratorPack            _children;
+
+    void fill_window(uint32_t begin) {
+        _window_begin = begin;
+        _window_end = ((getEndId() - begin) > window_size) ? (begin + window_size) : getEndId();
+        std::fill(_scores.begin(), _scores.end(), 0.0);
+        std::fill(_hits.begin(), _hits.end(), 0);
+        for (size_t child = 0; child < _termPos.size(); ++child) {
+            uint32_t docid = _termPos[child];
+            if (docid < begin) {
+                docid = _children.seek(child, begin);
+            }
+            double weight = _weights[child];
+            while (docid < _window_end) {
+                uint32_t offset = docid - begin;
+                _scores[offset] += weight * _children.get_weight(child, docid);
+                _hits[offset >> 6] |= (uint64_t(1) << (offset & 63));
+                docid = _children.seek(child, docid + 1);
+            }
+            _termPos[child] = docid;
+        }
+    }
+
+    uint32_t next_hit(uint32_t docId) const {
+        uint32_t offset = docId - _window_begin;
+        uint32_t end_offset = _window_end - _window_begin;
+        size_t word = offset >> 6;
+        uint64_t bits = _hits[word] & (~uint64_t(0) << (offset & 63));
+        while (bits == 0) {
+            if ((++word << 6) >= end_offset) {
+                return _window_end;
+            }
+            bits = _hits[word];
+        }
+        return _window_begin + (word << 6) + __builtin_ctzl(bits);
+    }
+
+public:
+    WindowedDotProductSearchImpl(TermFieldMatchData &tmd,
+                                 const std::vector<int32_t> &weights,
+                                 IteratorPack &&iteratorPack)
+        : _tmd(tmd),
+          _weights(weights),
+          _termPos(weights.size()),
+          _scores(window_size),
+          _hits(window_size / 64),
+          _window_begin(0),
+          _window_end(0),
+          _children(std::move(iteratorPack))
+    {
+        assert(_weights.size() > 0);
+        assert(_weights.size() == _children.size());
+    }
+
+    void doSeek(uint32_t docId) override {
+        while (docId < getEndId()) {
+            if (docId >= _window_end) {
+                fill_window(docId);
+            }
+            uint32_t hit = next_hit(docId);
+            if (hit < _window_end) {
+                setDocId(hit);
+                return;
+            }
+            docId = _window_end;
+        }
+        setAtEnd();
+    }
+
+    void doUnpack(uint32_t docId) override {
+        _tmd.setRawScore(docId, _scores[docId - _window_begin]);
+    }
+
+    void initRange(uint32_t begin, uint32_t end) override {
+        DotProductSearch::initRange(begin, end);
+        _children.initRange(begin, end);
+        for (size_t i = 0; i < _children.size(); ++i) {
+            _termPos[i] = _children.get_docid(i);
+        }
+        _window_begin = begin;
+        _window_end = begin;
+    }
+    Trinary is_strict() const override { return Trinary::True; }
+
+    void visitMembers(vespalib::ObjectVisitor &) const override {}
+};
+
 class SingleTermDotProductSearch : public DotProductSearch {
 public:
     SingleTermDotProductSearch(TermFieldMatchData &tmd, SearchIterator::UP child,
@@ -152,6 +260,7 @@ DotProductSearch::create(const std::vector<SearchIterator*> &children,
 {
     typedef DotProductSearchImpl<vespalib::LeftArrayHeap, SearchIteratorPack> ArrayHeapImpl;
     typedef DotProductSearchImpl<vespalib::LeftHeap, SearchIteratorPack> HeapImpl;
+    typedef WindowedDotProductSearchImpl<SearchIteratorPack> WindowedImpl;
 
     if (childMatch.size() == 1) {
         return std::make_unique<SingleTermDotProductSearch>(tmd, SearchIterator::UP(children[0]),
@@ -160,6 +269,9 @@ DotProductSearch::create(const std::vector<SearchIterator*> &children,
     if (childMatch.size() < 128) {
         return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, SearchIteratorPack(children, childMatch, std::move(md))));
     }
+    if (childMatch.size() >= windowed_term_limit) {
+        return SearchIterator::UP(new WindowedImpl(tmd, weights, SearchIteratorPack(children, childMatch, std::move(md))));
+    }
     return SearchIterator::UP(new HeapImpl(tmd, weights,  SearchIteratorPack(children, childMatch, std::move(md))));
 }
 
@@ -172,10 +284,14 @@ DotProductSearch::create(TermFieldMatchData &tmd,
 {
     typedef DotProductSearchImpl<vespalib::LeftArrayHeap, AttributeIteratorPack> ArrayHeapImpl;
     typedef DotProductSearchImpl<vespalib::LeftHeap, AttributeIteratorPack> HeapImpl;
+    typedef WindowedDotProductSearchImpl<AttributeIteratorPack> WindowedImpl;
 
     if (iterators.size() < 128) {
         return SearchIterator::UP(new ArrayHeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
     }
+    if (iterators.size() >= windowed_term_limit) {
+        return SearchIterator::UP(new WindowedImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
+    }
     return SearchIterator::UP(new HeapImpl(tmd, weights, AttributeIteratorPack(std::move(iterators))));
 }
 
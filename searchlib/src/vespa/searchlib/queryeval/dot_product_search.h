@@ -25,6 +25,9 @@ protected:
     DotProductSearch() {}
 
 public:
+    // Queries with at least this many terms are evaluated term-at-a-time within docid windows.
+    static constexpr size_t windowed_term_limit = 1024;
+
     // TODO: use MultiSearch::Children to pass ownership
     static SearchIterator::UP create(const std::vector<SearchIterator*> &children,
                                      search::fef::TermFieldMatchData &tmd,
@@ -47,7 +47,8 @@ HitCollector::HitCollector(uint32_t numDocs,
       _scale(1.0),
       _adjust(0),
       _hasReRanked(false),
-      _needReScore(false)
+      _needReScore(false),
+      _diversity()
 {
     if (_maxHitsSize > 0) {
         _collector = std::make_unique<RankedHitCollector>(*this);
@@ -57,8 +58,38 @@ HitCollector::HitCollector(uint32_t numDocs,
     _hits.reserve(maxHitsSize);
 }
 
+HitCollector::HitCollector(uint32_t numDocs,
+                           uint32_t maxHitsSize,
+                           std::unique_ptr<IDiversityGroups> groups,
+                           uint32_t maxHitsPerGroup)
+    : HitCollector(numDocs, maxHitsSize)
+{
+    if ((_maxHitsSize > 0) && groups && (maxHitsPerGroup > 0)) {
+        _diversity = std::make_unique<Diversity>(std::move(groups), maxHitsPerGroup);
+        // the hit vector is a heap from the start, as hits may be
+        // dropped or replaced before it is full.
+        _hitsSortOrder = SortOrder::HEAP;
+        if (_maxDocIdVectorSize > _maxHitsSize) {
+            _collector = std::make_unique<DocIdCollector<true>>(*this);
+        } else {
+            _bitVector = BitVector::create(_numDocs);
+            _bitVector->invalidateCachedCount();
+            _collector = std::make_unique<BitVectorCollector<true>>(*this);
+        }
+    }
+}
+
 HitCollector::~HitCollector() = default;
 
+HitCollector::Diversity::Diversity(std::unique_ptr<IDiversityGroups> groups_in, uint32_t maxPerGroup_in)
+    : groups(std::move(groups_in)),
+      maxPerGroup(maxPerGroup_in),
+      counts()
+{
+}
+
+HitCollector::Diversity::~Diversity() = default;
+
 void
 HitCollector::RankedHitCollector::collect(uint32_t docId, feature_t score)
 {
@@ -95,6 +126,49 @@ HitCollector::CollectorBase::replaceHitInVector(uint32_t docId, feature_t score)
     std::push_heap(_hc._hits.begin(), _hc._hits.end(), ScoreComparator());
 }
 
+void
+HitCollector::CollectorBase::considerForDiverseHitVector(uint32_t docId, feature_t score)
+{
+    std::vector<Hit> &hits = _hc._hits;
+    Diversity &diversity = *_hc._diversity;
+    bool full = (hits.size() == _hc._maxHitsSize);
+    if (full && !(score > hits[0].second)) {
+        return;
+    }
+    uint64_t group = diversity.groups->group(docId);
+    uint32_t &count = diversity.counts[group];
+    if (count < diversity.maxPerGroup) {
+        ++count;
+        if (full) {
+            --diversity.counts[diversity.groups->group(hits[0].first)];
+            replaceHitInVector(docId, score);
+        } else {
+            hits.emplace_back(docId, score);
+            std::push_heap(hits.begin(), hits.end(), ScoreComparator());
+        }
+    } else {
+        replaceWorstHitInGroup(group, docId, score);
+    }
+}
+
+void
+HitCollector::CollectorBase::replaceWorstHitInGroup(uint64_t group, uint32_t docId, feature_t score)
+{
+    std::vector<Hit> &hits = _hc._hits;
+    const IDiversityGroups &groups = *_hc._diversity->groups;
+    ScoreComparator cmp;
+    size_t worst = hits.size();
+    for (size_t i = 0; i < hits.size(); ++i) {
+        if ((groups.group(hits[i].first) == group) && ((worst == hits.size()) || cmp(hits[worst], hits[i]))) {
+            worst = i;
+        }
+    }
+    if ((worst < hits.size()) && (score > hits[worst].second)) {
+        hits[worst] = Hit(docId, score);
+        std::make_heap(hits.begin(), hits.end(), cmp);
+    }
+}
+
 void
 HitCollector::RankedHitCollector::collectAndChangeCollector(uint32_t docId, feature_t score)
 {
@@ -186,6 +260,7 @@ HitCollector::reRank(DocumentScorer &scorer, std::vector<Hit> hits) {
                          -std::numeric_limits<feature_t>::max());
 
     std::sort(hits.begin(), hits.end()); // sort on docId
+    scorer.prepare(hits);
     for (auto &hit : hits) {
         hit.second = scorer.score(hit.first);
         finalScores.low = std::min(finalScores.low, hit.second);
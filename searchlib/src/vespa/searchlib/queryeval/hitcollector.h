@@ -3,11 +3,13 @@
 #pragma once
 
 #include "scores.h"
+#include "idiversifier.h"
 #include <vespa/searchlib/common/hitrank.h>
 #include <vespa/searchlib/common/resultset.h>
 #include <algorithm>
 #include <vector>
 #include <vespa/vespalib/util/sort.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/fastos/dynamiclibrary.h>
 #include "sorted_hit_sequence.h"
 
@@ -25,6 +27,8 @@ public:
      */
     struct DocumentScorer {
         virtual ~DocumentScorer() {}
+        // called with all hits to be scored, sorted on docId, before scoring them
+        virtual void prepare(const std::vector<Hit> &) {}
         virtual feature_t score(uint32_t docId) = 0;
     };
 
@@ -50,6 +54,16 @@ private:
     bool _hasReRanked;
     bool _needReScore;
 
+    // limits the number of hits per diversity group kept in the hit vector
+    struct Diversity {
+        std::unique_ptr<IDiversityGroups>     groups;
+        uint32_t                              maxPerGroup;
+        vespalib::hash_map<uint64_t, uint32_t> counts;
+        Diversity(std::unique_ptr<IDiversityGroups> groups_in, uint32_t maxPerGroup_in);
+        ~Diversity();
+    };
+    std::unique_ptr<Diversity> _diversity;
+
     struct ScoreComparator {
         bool operator() (const Hit & lhs, const Hit & rhs) const {
             if (lhs.second == rhs.second) {
@@ -101,12 +115,16 @@ private:
     public:
         CollectorBase(HitCollector &hc) : _hc(hc) { }
         void considerForHitVector(uint32_t docId, feature_t score) {
-            if (__builtin_expect((score > _hc._hits[0].second), false)) {
+            if (__builtin_expect(bool(_hc._diversity), false)) {
+                considerForDiverseHitVector(docId, score);
+            } else if (__builtin_expect((score > _hc._hits[0].second), false)) {
                 replaceHitInVector(docId, score);
             }
         }
     protected:
         void replaceHitInVector(uint32_t docId, feature_t score);
+        void considerForDiverseHitVector(uint32_t docId, feature_t score) __attribute__((noinline));
+        void replaceWorstHitInGroup(uint64_t group, uint32_t docId, feature_t score);
         HitCollector &_hc;
     };
 
@@ -153,6 +171,20 @@ public:
      * @param maxHitsSize
      **/
     HitCollector(uint32_t numDocs, uint32_t maxHitsSize);
+
+    /**
+     * Creates a hit collector that stores doc id and rank score for
+     * the n (=maxHitsSize) best hits, with at most maxHitsPerGroup of
+     * them in the same diversity group. Other hits are stored with
+     * doc id only.
+     *
+     * @param numDocs
+     * @param maxHitsSize
+     * @param groups tells the diversity group of each document
+     * @param maxHitsPerGroup
+     **/
+    HitCollector(uint32_t numDocs, uint32_t maxHitsSize,
+                 std::unique_ptr<IDiversityGroups> groups, uint32_t maxHitsPerGroup);
     ~HitCollector();
 
     /**
@@ -167,6 +199,18 @@ public:
         _collector->collect(docId, score);
     }
 
+    /**
+     * Returns the lowest score among the n (=maxHitsSize) best hits
+     * once more than n hits have been added, and default_rank_value
+     * until then. Hits scoring lower than this are not stored with
+     * their score.
+     **/
+    feature_t getScoreThreshold() const {
+        return ((_hitsSortOrder == SortOrder::HEAP) && (_hits.size() == _maxHitsSize))
+               ? _hits[0].second
+               : default_rank_value;
+    }
+
     /**
      * Returns a sorted sequence of hits that reference internal
      * data. The number of hits returned in the sequence is controlled
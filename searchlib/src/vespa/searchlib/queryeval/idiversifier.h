@@ -13,4 +13,13 @@ struct IDiversifier {
      */
     virtual bool accepted(uint32_t docId) = 0;
 };
+
+/**
+ * Tells which diversity group a document belongs to. Documents in
+ * the same group get the same key.
+ **/
+struct IDiversityGroups {
+    virtual ~IDiversityGroups() {}
+    virtual uint64_t group(uint32_t docId) const = 0;
+};
 }
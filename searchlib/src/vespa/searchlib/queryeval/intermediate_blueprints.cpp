@@ -163,13 +163,15 @@ AndNotBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                           bool strict, search::fef::MatchData &md) const
 {
     UnpackInfo unpack_info(calculateUnpackInfo(md));
-    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
+    bool adaptive = (md.get_adaptive_termwise() &&
+                     should_do_adaptive_termwise_eval(unpack_info, md.get_termwise_limit()));
+    if (adaptive || should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
         TermwiseBlueprintHelper helper(*this, std::move(sub_searches), unpack_info);
         bool termwise_strict = (strict && inheritStrict(helper.first_termwise));
         auto termwise_search = (helper.first_termwise == 0)
                                ? AndNotSearch::create(helper.get_termwise_children(), termwise_strict)
                                : OrSearch::create(helper.get_termwise_children(), termwise_strict);
-        helper.insert_termwise(std::move(termwise_search), termwise_strict);
+        helper.insert_termwise(std::move(termwise_search), termwise_strict, adaptive);
         auto rearranged = helper.get_result();
         if (rearranged.size() == 1) {
             return std::move(rearranged[0]);
@@ -264,11 +266,13 @@ AndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
 {
     UnpackInfo unpack_info(calculateUnpackInfo(md));
     std::unique_ptr<AndSearch> search;
-    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
+    bool adaptive = (md.get_adaptive_termwise() &&
+                     should_do_adaptive_termwise_eval(unpack_info, md.get_termwise_limit()));
+    if (adaptive || should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
         TermwiseBlueprintHelper helper(*this, std::move(sub_searches), unpack_info);
         bool termwise_strict = (strict && inheritStrict(helper.first_termwise));
         auto termwise_search = AndSearch::create(helper.get_termwise_children(), termwise_strict);
-        helper.insert_termwise(std::move(termwise_search), termwise_strict);
+        helper.insert_termwise(std::move(termwise_search), termwise_strict, adaptive);
         auto rearranged = helper.get_result();
         if (rearranged.size() == 1) {
             return std::move(rearranged[0]);
@@ -352,11 +356,13 @@ OrBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                       bool strict, search::fef::MatchData & md) const
 {
     UnpackInfo unpack_info(calculateUnpackInfo(md));
-    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
+    bool adaptive = (md.get_adaptive_termwise() &&
+                     should_do_adaptive_termwise_eval(unpack_info, md.get_termwise_limit()));
+    if (adaptive || should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
         TermwiseBlueprintHelper helper(*this, std::move(sub_searches), unpack_info);
         bool termwise_strict = (strict && inheritStrict(helper.first_termwise));
         auto termwise_search = OrSearch::create(helper.get_termwise_children(), termwise_strict);
-        helper.insert_termwise(std::move(termwise_search), termwise_strict);
+        helper.insert_termwise(std::move(termwise_search), termwise_strict, adaptive);
         auto rearranged = helper.get_result();
         if (rearranged.size() == 1) {
             return std::move(rearranged[0]);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
+#include <cstring>
 
 namespace search::queryeval {
 
@@ -30,6 +31,21 @@ public:
         return _source.getFast(docId);
     }
 
+    /**
+     * Find the first document id in [docId, limit) using the given
+     * source by scanning the source bytes directly.
+     *
+     * @return the document id found, or limit if there is none
+     **/
+    uint32_t findNextSource(uint32_t docId, uint32_t limit, queryeval::Source source) const {
+        if (docId >= limit) {
+            return limit;
+        }
+        const int8_t *first = _source.getFastPtr() + docId;
+        const void *found = memchr(first, source, limit - docId);
+        return (found != nullptr) ? docId + (static_cast<const int8_t *>(found) - first) : limit;
+    }
+
     uint32_t getDocIdLimit() const {
         return _source.getCommittedDocIdLimit();
     }
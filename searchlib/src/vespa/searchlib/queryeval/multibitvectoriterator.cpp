@@ -16,7 +16,12 @@ using vespalib::hwaccelrated::IAccelrated;
 
 namespace {
 
-template<typename Update>
+/**
+ * Combines the bitvectors one window at a time into _lastWords. The non-strict iterator uses a
+ * small window as it is typically driven by sparse seeks. The strict iterator computes larger
+ * windows, combining one source at a time over the whole window, and scans the result for hits.
+ */
+template<typename Update, uint32_t NumWordsInWindow>
 class MultiBitVectorIterator : public MultiBitVectorIteratorBase
 {
 public:
@@ -26,29 +31,32 @@ public:
           _accel(IAccelrated::getAccelerator()),
           _lastWords()
     {
-        static_assert(sizeof(_lastWords) == 64, "Lastwords should have 64 byte size");
-        static_assert(NumWordsInBatch == 8, "Batch size should be 8 words.");
+        static_assert((NumWordsInWindow % NumWordsInBatch) == 0, "Window size should be a multiple of 8 words.");
         memset(_lastWords, 0, sizeof(_lastWords));
     }
 protected:
     void updateLastValue(uint32_t docId);
     void strictSeek(uint32_t docId);
 private:
+    void fetchWindow(uint32_t baseIndex);
     void doSeek(uint32_t docId) override;
     Trinary is_strict() const override { return Trinary::False; }
     bool acceptExtraFilter() const override { return Update::isAnd(); }
     Update              _update;
     const IAccelrated & _accel;
-    alignas(64) Word    _lastWords[8];
-    static constexpr size_t NumWordsInBatch = sizeof(_lastWords) / sizeof(Word);
+    alignas(64) Word    _lastWords[NumWordsInWindow];
+    static constexpr size_t NumWordsInBatch = 64 / sizeof(Word);
 };
 
+// 4KB windows, corresponding to 32768 documents.
+constexpr uint32_t NumWordsInStrictWindow = 4096 / sizeof(BitWord::Word);
+
 template<typename Update>
-class MultiBitVectorIteratorStrict : public MultiBitVectorIterator<Update>
+class MultiBitVectorIteratorStrict : public MultiBitVectorIterator<Update, NumWordsInStrictWindow>
 {
 public:
     explicit MultiBitVectorIteratorStrict(MultiSearch::Children  children)
-        : MultiBitVectorIterator<Update>(std::move(children))
+        : MultiBitVectorIterator<Update, NumWordsInStrictWindow>(std::move(children))
     { }
 private:
     void doSeek(uint32_t docId) override { this->strictSeek(docId); }
@@ -60,6 +68,9 @@ struct And {
     void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
         accel.and64(offset, src, dest);
     }
+    void operator () (const IAccelrated & accel, size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
+        accel.andBlock(offset, bytes, src, dest);
+    }
     static bool isAnd() { return true; }
 };
 
@@ -68,11 +79,28 @@ struct Or {
     void operator () (const IAccelrated & accel, size_t offset, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
         accel.or64(offset, src, dest);
     }
+    void operator () (const IAccelrated & accel, size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> & src, void *dest) {
+        accel.orBlock(offset, bytes, src, dest);
+    }
     static bool isAnd() { return false; }
 };
 
-template<typename Update>
-void MultiBitVectorIterator<Update>::updateLastValue(uint32_t docId)
+template<typename Update, uint32_t NumWordsInWindow>
+void
+MultiBitVectorIterator<Update, NumWordsInWindow>::fetchWindow(uint32_t baseIndex)
+{
+    if constexpr (NumWordsInWindow == NumWordsInBatch) {
+        _update(_accel, baseIndex*sizeof(Word), _bvs, _lastWords);
+    } else {
+        // The bitvectors are only guaranteed to be readable up to the 64 byte batch holding the guard bit.
+        const uint32_t endIndex = (wordNum(_numDocs) + NumWordsInBatch) & ~(NumWordsInBatch - 1);
+        const uint32_t numWords = std::min(NumWordsInWindow, endIndex - baseIndex);
+        _update(_accel, baseIndex*sizeof(Word), numWords*sizeof(Word), _bvs, _lastWords);
+    }
+}
+
+template<typename Update, uint32_t NumWordsInWindow>
+void MultiBitVectorIterator<Update, NumWordsInWindow>::updateLastValue(uint32_t docId)
 {
     if (docId >= _lastMaxDocIdLimit) {
         if (__builtin_expect(docId >= _numDocs, false)) {
@@ -81,18 +109,18 @@ void MultiBitVectorIterator<Update>::updateLastValue(uint32_t docId)
         }
         const uint32_t index(wordNum(docId));
         if (docId >= _lastMaxDocIdLimitRequireFetch) {
-            uint32_t baseIndex = index & ~(NumWordsInBatch - 1);
-            _update(_accel, baseIndex*sizeof(Word), _bvs, _lastWords);
-            _lastMaxDocIdLimitRequireFetch = (baseIndex + NumWordsInBatch) * WordLen;
+            uint32_t baseIndex = index & ~(NumWordsInWindow - 1);
+            fetchWindow(baseIndex);
+            _lastMaxDocIdLimitRequireFetch = (baseIndex + NumWordsInWindow) * WordLen;
         }
-        _lastValue = _lastWords[index % NumWordsInBatch];
+        _lastValue = _lastWords[index % NumWordsInWindow];
         _lastMaxDocIdLimit = (index + 1) * WordLen;
     }
 }
 
-template<typename Update>
+template<typename Update, uint32_t NumWordsInWindow>
 void
-MultiBitVectorIterator<Update>::doSeek(uint32_t docId)
+MultiBitVectorIterator<Update, NumWordsInWindow>::doSeek(uint32_t docId)
 {
     updateLastValue(docId);
     if (__builtin_expect( ! isAtEnd(), true)) {
@@ -102,9 +130,9 @@ MultiBitVectorIterator<Update>::doSeek(uint32_t docId)
     }
 }
 
-template<typename Update>
+template<typename Update, uint32_t NumWordsInWindow>
 void
-MultiBitVectorIterator<Update>::strictSeek(uint32_t docId)
+MultiBitVectorIterator<Update, NumWordsInWindow>::strictSeek(uint32_t docId)
 {
     for (updateLastValue(docId), _lastValue = _lastValue & checkTab(docId);
          (_lastValue == 0) && __builtin_expect(! isAtEnd(), true);
@@ -120,9 +148,9 @@ MultiBitVectorIterator<Update>::strictSeek(uint32_t docId)
 }
 
 
-typedef MultiBitVectorIterator<And> AndBVIterator;
+typedef MultiBitVectorIterator<And, 8> AndBVIterator;
 typedef MultiBitVectorIteratorStrict<And> AndBVIteratorStrict;
-typedef MultiBitVectorIterator<Or> OrBVIterator;
+typedef MultiBitVectorIterator<Or, 8> OrBVIterator;
 typedef MultiBitVectorIteratorStrict<Or> OrBVIteratorStrict;
 
 bool hasAtLeast2Bitvectors(const MultiSearch::Children & children)
@@ -182,6 +210,7 @@ MultiBitVectorIteratorBase::andWith(UP filter, uint32_t estimate)
     if (filter->isBitVector() && acceptExtraFilter()) {
         const auto & bv = static_cast<const BitVectorIterator &>(*filter);
         _bvs.emplace_back(bv.getBitValues(), bv.isInverted());
+        _numDocs = std::min(_numDocs, bv.getDocIdLimit());
         insert(getChildren().size(), std::move(filter));
         _lastMaxDocIdLimit = 0;  // force reload
         _lastMaxDocIdLimitRequireFetch = 0;
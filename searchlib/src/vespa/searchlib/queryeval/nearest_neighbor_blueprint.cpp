@@ -8,6 +8,9 @@
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <algorithm>
+#include <cmath>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.queryeval.nearest_neighbor_blueprint");
@@ -52,7 +55,8 @@ struct ConvertCellsSelector
 NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                                                    const tensor::DenseTensorAttribute& attr_tensor,
                                                    std::unique_ptr<Value> query_tensor,
-                                                   uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits, double brute_force_limit)
+                                                   uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits,
+                                                   double brute_force_limit, double post_filter_limit)
     : ComplexLeafBlueprint(field),
       _attr_tensor(attr_tensor),
       _query_tensor(std::move(query_tensor)),
@@ -60,6 +64,9 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _approximate(approximate),
       _explore_additional_hits(explore_additional_hits),
       _brute_force_limit(brute_force_limit),
+      _post_filter_limit(post_filter_limit),
+      _filter_hit_ratio(1.0),
+      _post_filter(false),
       _fallback_dist_fun(),
       _distance_heap(target_num_hits),
       _found_hits(),
@@ -98,10 +105,15 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter)
             uint32_t max_hits = _global_filter->filter()->countTrueBits();
             LOG(debug, "set_global_filter getNumDocs: %u / max_hits %u", est_hits, max_hits);
             double max_hit_ratio = static_cast<double>(max_hits) / est_hits;
+            _filter_hit_ratio = max_hit_ratio;
             if (max_hit_ratio < _brute_force_limit) {
                 _approximate = false;
                 LOG(debug, "too many hits filtered out, using brute force implementation");
             } else {
+                if (max_hit_ratio >= _post_filter_limit) {
+                    _post_filter = true;
+                    LOG(debug, "few hits filtered out, using post filtering of index hits");
+                }
                 est_hits = std::min(est_hits, max_hits);
             }
         }
@@ -125,7 +137,9 @@ NearestNeighborBlueprint::perform_top_k()
         if (lhs_type == rhs_type) {
             auto lhs = _query_tensor->cells();
             uint32_t k = _target_num_hits;
-            if (_global_filter->has_filter()) {
+            if (_post_filter) {
+                perform_top_k_post_filter(*nns_index, lhs, k);
+            } else if (_global_filter->has_filter()) {
                 auto filter = _global_filter->filter();
                 _found_hits = nns_index->find_top_k_with_filter(k, lhs, *filter, k + _explore_additional_hits);
             } else {
@@ -135,6 +149,30 @@ NearestNeighborBlueprint::perform_top_k()
     }
 }
 
+void
+NearestNeighborBlueprint::perform_top_k_post_filter(const search::tensor::NearestNeighborIndex& nns_index,
+                                                    vespalib::eval::TypedCells lhs, uint32_t k)
+{
+    using Neighbor = search::tensor::NearestNeighborIndex::Neighbor;
+    const BitVector& filter = *_global_filter->filter();
+    // Explore enough hits to expect k + explore_additional_hits of them to pass the filter.
+    double wanted_hits = std::ceil((k + _explore_additional_hits) / std::max(_filter_hit_ratio, 0.0001));
+    uint32_t post_k = std::min(wanted_hits, static_cast<double>(_attr_tensor.getNumDocs()));
+    post_k = std::max(post_k, k);
+    auto hits = nns_index.find_top_k(post_k, lhs, post_k);
+    hits.erase(std::remove_if(hits.begin(), hits.end(),
+                              [&filter](const Neighbor& hit) { return !filter.testBit(hit.docid); }),
+               hits.end());
+    if (hits.size() > k) {
+        std::nth_element(hits.begin(), hits.begin() + k, hits.end(),
+                         [](const Neighbor& lhs_hit, const Neighbor& rhs_hit) { return lhs_hit.distance < rhs_hit.distance; });
+        hits.resize(k);
+        std::sort(hits.begin(), hits.end(),
+                  [](const Neighbor& lhs_hit, const Neighbor& rhs_hit) { return lhs_hit.docid < rhs_hit.docid; });
+    }
+    _found_hits = std::move(hits);
+}
+
 std::unique_ptr<SearchIterator>
 NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda, bool strict) const
 {
@@ -157,6 +195,7 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     visitor.visitInt("target_num_hits", _target_num_hits);
     visitor.visitBool("approximate", _approximate);
     visitor.visitInt("explore_additional_hits", _explore_additional_hits);
+    visitor.visitBool("post_filter", _post_filter);
 }
 
 bool
@@ -16,6 +16,12 @@ namespace search::queryeval {
  *
  * The search iterator matches the K nearest neighbors in a multi-dimensional vector space,
  * where the query point and document points are dense tensors of order 1.
+ *
+ * When a global filter is set, the strategy is selected based on the ratio of documents in the filter:
+ *   - below brute_force_limit: exact search over the documents in the filter.
+ *   - at least post_filter_limit: index search without the filter, exploring extra hits
+ *     (scaled by the inverse ratio), then removing the hits not in the filter.
+ *   - otherwise: index search where the filter is checked while traversing the graph.
  */
 class NearestNeighborBlueprint : public ComplexLeafBlueprint {
 private:
@@ -25,6 +31,9 @@ private:
     bool _approximate;
     uint32_t _explore_additional_hits;
     double _brute_force_limit;
+    double _post_filter_limit;
+    double _filter_hit_ratio;
+    bool _post_filter;
     search::tensor::DistanceFunction::UP _fallback_dist_fun;
     const search::tensor::DistanceFunction *_dist_fun;
     mutable NearestNeighborDistanceHeap _distance_heap;
@@ -32,11 +41,14 @@ private:
     std::shared_ptr<const GlobalFilter> _global_filter;
 
     void perform_top_k();
+    void perform_top_k_post_filter(const search::tensor::NearestNeighborIndex& nns_index,
+                                   vespalib::eval::TypedCells lhs, uint32_t k);
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                              const tensor::DenseTensorAttribute& attr_tensor,
                              std::unique_ptr<vespalib::eval::Value> query_tensor,
-                             uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits, double brute_force_limit);
+                             uint32_t target_num_hits, bool approximate, uint32_t explore_additional_hits,
+                             double brute_force_limit, double post_filter_limit);
     NearestNeighborBlueprint(const NearestNeighborBlueprint&) = delete;
     NearestNeighborBlueprint& operator=(const NearestNeighborBlueprint&) = delete;
     ~NearestNeighborBlueprint();
@@ -45,6 +57,7 @@ public:
     uint32_t get_target_num_hits() const { return _target_num_hits; }
     void set_global_filter(const GlobalFilter &global_filter) override;
     bool may_approximate() const { return _approximate; }
+    bool uses_post_filter() const { return _post_filter; }
 
     std::unique_ptr<SearchIterator> createLeafSearch(const search::fef::TermFieldMatchDataArray& tfmda,
                                                      bool strict) const override;
@@ -3,6 +3,7 @@
 #include "simple_phrase_search.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <algorithm>
 #include <functional>
 
 using search::fef::TermFieldMatchData;
@@ -34,10 +35,27 @@ class PhraseMatcher {
     uint32_t position(uint32_t word_index)
     { return iterator(word_index)->getPosition(); }
 
-    void iterateToElement(uint32_t word_index) {
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) < _element_id) {
-            ++iterator(word_index);
+    // Skip to the first position of the given word that is not before
+    // (_element_id, pos). Galloping keeps this cheap when the position
+    // lists of long documents are far apart.
+    void seekPosition(uint32_t word_index, uint32_t pos) {
+        auto before = [element_id = _element_id, pos](const fef::TermFieldMatchDataPosition &p) {
+            return ((p.getElementId() < element_id) ||
+                    ((p.getElementId() == element_id) && (p.getPosition() < pos)));
+        };
+        TermFieldMatchData::PositionsIterator &it = iterator(word_index);
+        TermFieldMatchData::PositionsIterator last = end(word_index);
+        if (it == last || !before(*it)) {
+            return;
+        }
+        TermFieldMatchData::PositionsIterator lo = it;
+        for (size_t step = 1;; step <<= 1) {
+            TermFieldMatchData::PositionsIterator hi = (size_t(last - lo) > step) ? (lo + step) : last;
+            if (hi == last || !before(*hi)) {
+                it = std::partition_point(lo + 1, hi, before);
+                return;
+            }
+            lo = hi;
         }
     }
 
@@ -47,16 +65,14 @@ class PhraseMatcher {
             return true;
         }
         uint32_t word_index = *first;
-
-        iterateToElement(word_index);
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) == _element_id) {
-            if (position(word_index) == _position + word_index) {
-                return match(++first, last);
-            } else if (position(word_index) > _position + word_index) {
-                return false;
-            }
-            ++iterator(word_index);
+        uint32_t wanted_position = _position + word_index;
+
+        seekPosition(word_index, wanted_position);
+        if (iterator(word_index) != end(word_index) &&
+            elementId(word_index) == _element_id &&
+            position(word_index) == wanted_position)
+        {
+            return match(++first, last);
         }
         return false;
     }
@@ -23,8 +23,11 @@ class SourceBlenderSearchStrict : public SourceBlenderSearch
 public:
     SourceBlenderSearchStrict(std::unique_ptr<Iterator> sourceSelector, const Children &children);
 private:
+    // how far ahead the source selector is scanned for the next document of a child
+    static constexpr uint32_t SKIP_WINDOW = 256;
     VESPA_DLL_LOCAL void advance() __attribute__((noinline));
-    vespalib::Array<SearchIterator *>  _nextChildren;
+    uint32_t nextCandidate(uint32_t docid, Source source) const;
+    vespalib::Array<Source>  _nextChildren;
 
     void doSeek(uint32_t docid) override;
     Trinary is_strict() const override { return Trinary::True; }
@@ -64,29 +67,43 @@ SourceBlenderSearchStrict::doSeek(uint32_t docid)
         setDocId(docid);
     } else {
         for (auto & child : _children) {
-            getSearch(child)->seek(docid);
+            getSearch(child)->seek(nextCandidate(docid, child));
         }
         advance();
     }
 }
 
+/**
+ * A child can only produce hits for documents selecting its source, so
+ * instead of seeking it one document at a time past documents owned by
+ * other sources, skip directly to the next document in a window of
+ * the source selector that selects it.
+ **/
+uint32_t
+SourceBlenderSearchStrict::nextCandidate(uint32_t docid, Source source) const
+{
+    if (docid >= _docIdLimit) {
+        return docid;
+    }
+    uint32_t limit = ((_docIdLimit - docid) > SKIP_WINDOW) ? (docid + SKIP_WINDOW) : _docIdLimit;
+    return _sourceSelector->findNextSource(docid, limit, source);
+}
+
 void
 SourceBlenderSearchStrict::advance()
 {
     for (;;) {
-        SearchIterator * search = getSearch(_children[0]);
-        uint32_t minNextId = search->getDocId();
+        uint32_t minNextId = getSearch(_children[0])->getDocId();
         _nextChildren.clear();
-        _nextChildren.push_back_fast(search);
+        _nextChildren.push_back_fast(_children[0]);
         for (uint32_t i = 1; i < _children.size(); ++i) {
-            search = getSearch(_children[i]);
-            uint32_t nextId = search->getDocId();
+            uint32_t nextId = getSearch(_children[i])->getDocId();
             if (nextId < minNextId) {
                 minNextId = nextId;
                 _nextChildren.clear();
-                _nextChildren.push_back_fast(search);
+                _nextChildren.push_back_fast(_children[i]);
             } else if (nextId == minNextId) {
-                _nextChildren.push_back_fast(search);
+                _nextChildren.push_back_fast(_children[i]);
             }
         }
         if (isAtEnd(minNextId)) {
@@ -97,14 +114,14 @@ SourceBlenderSearchStrict::advance()
             setAtEnd();
             return;
         }
-        search = getSearch(_sourceSelector->getSource(minNextId));
-        for (SearchIterator * child : _nextChildren) {
-            if (child == search) {
-                _matchedChild = search;
+        Source source = _sourceSelector->getSource(minNextId);
+        for (Source child : _nextChildren) {
+            if (child == source) {
+                _matchedChild = getSearch(child);
                 setDocId(minNextId);
                 return;
             }
-            child->seek(minNextId + 1);
+            getSearch(child)->seek(nextCandidate(minNextId + 1, child));
         }
     }
 }
@@ -34,9 +34,11 @@ TermwiseBlueprintHelper::TermwiseBlueprintHelper(const IntermediateBlueprint &se
 TermwiseBlueprintHelper::~TermwiseBlueprintHelper() = default;
 
 void
-TermwiseBlueprintHelper::insert_termwise(SearchIterator::UP search, bool strict)
+TermwiseBlueprintHelper::insert_termwise(SearchIterator::UP search, bool strict, bool adaptive)
 {
-    auto termwise_search = make_termwise(std::move(search), strict);
+    auto termwise_search = adaptive
+                           ? make_adaptive_termwise(std::move(search), strict)
+                           : make_termwise(std::move(search), strict);
     other_ch.insert(other_ch.begin() + first_termwise, std::move(termwise_search));
 }
 
@@ -29,7 +29,7 @@ public:
                             MultiSearch::Children subSearches, UnpackInfo &unpackInfo);
     ~TermwiseBlueprintHelper();
 
-    void insert_termwise(SearchIterator::UP search, bool strict);
+    void insert_termwise(SearchIterator::UP search, bool strict, bool adaptive = false);
 };
 
 }
@@ -53,6 +53,91 @@ struct TermwiseSearch : public SearchIterator {
     }
 };
 
+/**
+ * Evaluates the search document at a time, like it would without
+ * termwise evaluation, while counting how many docids are seeked in
+ * each window of the active range. When the seek density of a window
+ * is high enough for termwise evaluation to be cheaper, the remaining
+ * part of the range is evaluated termwise into a bitvector fragment.
+ **/
+template <bool IS_STRICT>
+struct AdaptiveTermwiseSearch : public SearchIterator {
+
+    static constexpr uint32_t WINDOW_SIZE = 16 * 1024;
+    // seeks per docid where termwise evaluation starts paying off
+    static constexpr double SEEK_DENSITY_LIMIT = 0.05;
+
+    SearchIterator::UP search;
+    BitVector::UP      result;
+    uint32_t           window_begin;
+    uint32_t           window_end;
+    uint32_t           window_seeks;
+
+    AdaptiveTermwiseSearch(SearchIterator::UP search_in)
+        : search(std::move(search_in)), result(), window_begin(0), window_end(0), window_seeks(0) {}
+
+    void start_window(uint32_t docid) {
+        window_begin = docid;
+        window_end = (getEndId() - docid > WINDOW_SIZE) ? (docid + WINDOW_SIZE) : getEndId();
+        window_seeks = 0;
+    }
+    void end_window(uint32_t docid) {
+        double seek_density = double(window_seeks) / double(docid - window_begin);
+        if (seek_density >= SEEK_DENSITY_LIMIT) {
+            search->initRange(docid, getEndId());
+            result = search->get_hits(docid);
+        } else {
+            start_window(docid);
+        }
+    }
+    void termwise_seek(uint32_t docid) {
+        if (IS_STRICT) {
+            uint32_t nextid = result->getNextTrueBit(docid);
+            if (__builtin_expect(isAtEnd(nextid), false)) {
+                setAtEnd();
+            } else {
+                setDocId(nextid);
+            }
+        } else if (result->testBit(docid)) {
+            setDocId(docid);
+        }
+    }
+
+    Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
+    void initRange(uint32_t beginid, uint32_t endid) override {
+        SearchIterator::initRange(beginid, endid);
+        search->initRange(beginid, endid);
+        result.reset();
+        start_window(beginid);
+        setDocId(std::max(getDocId(), search->getDocId()));
+    }
+    void doSeek(uint32_t docid) override {
+        if (__builtin_expect(isAtEnd(docid), false)) {
+            setAtEnd();
+            return;
+        }
+        if (!result && (docid >= window_end)) {
+            end_window(docid);
+        }
+        if (result) {
+            termwise_seek(docid);
+        } else {
+            ++window_seeks;
+            if (search->seek(docid)) {
+                setDocId(docid);
+            } else if (IS_STRICT) {
+                setDocId(search->getDocId());
+            }
+        }
+    }
+    void doUnpack(uint32_t) override {}
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override {
+        visit(visitor, "search", *search);
+        visit(visitor, "strict", IS_STRICT);
+        visit(visitor, "adaptive", true);
+    }
+};
+
 SearchIterator::UP
 make_termwise(SearchIterator::UP search, bool strict)
 {
@@ -63,4 +148,14 @@ make_termwise(SearchIterator::UP search, bool strict)
     }
 }
 
+SearchIterator::UP
+make_adaptive_termwise(SearchIterator::UP search, bool strict)
+{
+    if (strict) {
+        return std::make_unique<AdaptiveTermwiseSearch<true>>(std::move(search));
+    } else {
+        return std::make_unique<AdaptiveTermwiseSearch<false>>(std::move(search));
+    }
+}
+
 }
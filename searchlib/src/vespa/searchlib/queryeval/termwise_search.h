@@ -22,4 +22,18 @@ namespace search::queryeval {
  **/
 SearchIterator::UP make_termwise(SearchIterator::UP search, bool strict);
 
+/**
+ * Creates an adaptive termwise wrapper for the given search. The
+ * wrapper starts out evaluating the underlying search document at a
+ * time, measuring how densely it is seeked. When the density of a
+ * window of docids indicates that termwise evaluation is cheaper, the
+ * rest of the active range is evaluated termwise like with
+ * make_termwise. The same restrictions on match data apply.
+ *
+ * @return adaptive wrapper of the original search
+ * @param search the search we might want to perform termwise evaluation of
+ * @param strict whether the wrapper itself should be a strict iterator
+ **/
+SearchIterator::UP make_adaptive_termwise(SearchIterator::UP search, bool strict);
+
 }
@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::queryeval {
+
+/**
+ * Interface implemented by term search iterators that can expose
+ * block-max information, used by the block-max variant of weak and
+ * to skip blocks of documents that cannot enter the heap.
+ *
+ * A block is a range of documents in the posting list. The iterator
+ * reports the last document id covered by the current block and an
+ * upper bound for the number of occurrences of the term in any
+ * document within the block.
+ */
+class IBlockMaxSearch {
+public:
+    virtual ~IBlockMaxSearch() = default;
+
+    /**
+     * Returns true if block-max information is available.
+     */
+    virtual bool has_block_max() const = 0;
+
+    /**
+     * Selects the block covering docid without having to decode the
+     * documents in the block. The current document id of the search
+     * iterator might move forward, but never beyond the first document
+     * id >= docid in the posting list. Returns the last document id
+     * covered by the block.
+     */
+    virtual uint32_t seek_block(uint32_t docid) = 0;
+
+    /**
+     * Returns an upper bound for the number of occurrences of the term
+     * within any document covered by the current block.
+     */
+    virtual uint32_t get_block_max_num_occs() const = 0;
+
+    /**
+     * Returns the number of occurrences of the term in the current
+     * document, without unpacking match data.
+     */
+    virtual uint32_t get_num_occs() const = 0;
+};
+
+}
@@ -416,6 +416,22 @@ struct TermFrequencyScorer
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Scorer used with block-max weak and that scales the max score of a
+ * term by a saturating function of the number of occurrences of the
+ * term in a document. The result is never larger than the max score
+ * and never decreases when the number of occurrences grows, making it
+ * usable as an upper bound with block-max number of occurrences.
+ */
+struct NumOccsScorer
+{
+    static score_t calculate_score(score_t max_score, uint32_t num_occs) {
+        return 1 + (score_t) ((max_score - 1) * (num_occs / (num_occs + 1.0)));
+    }
+};
+
+//-----------------------------------------------------------------------------
+
 /**
  * Scorer used with WeakAndAlgorithm that calculates a real dot product upper
  * bound as max score and dot product component score per term.
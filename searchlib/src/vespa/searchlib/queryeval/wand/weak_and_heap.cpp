@@ -1,13 +1,15 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "weak_and_heap.h"
+#include <algorithm>
 
 namespace search::queryeval {
 
 SharedWeakAndPriorityQueue::SharedWeakAndPriorityQueue(uint32_t scoresToTrack) :
     WeakAndHeap(scoresToTrack),
     _bestScores(),
-    _lock()
+    _lock(),
+    _full(false)
 {
     _bestScores.reserve(scoresToTrack);
 }
@@ -20,6 +22,14 @@ SharedWeakAndPriorityQueue::adjust(score_t *begin, score_t *end)
     if (getScoresToTrack() == 0) {
         return;
     }
+    if (_full.load(std::memory_order_relaxed)) {
+        // scores not above the current threshold cannot enter the heap; skip them without locking
+        score_t minScore = getMinScore();
+        end = std::remove_if(begin, end, [minScore](score_t score) { return score <= minScore; });
+        if (begin == end) {
+            return;
+        }
+    }
     std::lock_guard guard(_lock);
     for (score_t *itr = begin; itr != end; ++itr) {
         score_t score = *itr;
@@ -32,6 +42,7 @@ SharedWeakAndPriorityQueue::adjust(score_t *begin, score_t *end)
     }
     if (is_full()) {
         setMinScore(_bestScores.front());
+        _full.store(true, std::memory_order_relaxed);
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include "wand_parts.h"
 #include <vespa/vespalib/util/priority_queue.h>
+#include <atomic>
 #include <mutex>
 
 namespace search::queryeval {
@@ -34,12 +35,16 @@ public:
      **/
     uint32_t getScoresToTrack() const { return _scoresToTrack; }
 
-    score_t getMinScore() const { return _minScore; }
+    /**
+     * The current threshold score. Read by all search iterators sharing
+     * this heap without taking any lock.
+     **/
+    score_t getMinScore() const { return _minScore.load(std::memory_order_relaxed); }
 protected:
-    void setMinScore(score_t minScore) { _minScore = minScore; }
+    void setMinScore(score_t minScore) { _minScore.store(minScore, std::memory_order_relaxed); }
 private:
-    score_t        _minScore;
-    const uint32_t _scoresToTrack;
+    std::atomic<score_t> _minScore;
+    const uint32_t       _scoresToTrack;
 };
 
 /**
@@ -50,8 +55,9 @@ class SharedWeakAndPriorityQueue : public WeakAndHeap
 {
 private:
     typedef vespalib::PriorityQueue<score_t> Scores;
-    Scores         _bestScores;
-    std::mutex     _lock;
+    Scores            _bestScores;
+    std::mutex        _lock;
+    std::atomic<bool> _full;
 
     bool is_full() const { return (_bestScores.size() >= getScoresToTrack()); }
 
@@ -2,6 +2,7 @@
 
 #include "wand_parts.h"
 #include "weak_and_search.h"
+#include "i_block_max_search.h"
 #include <vespa/searchlib/queryeval/orsearch.h>
 #include <vespa/vespalib/util/left_right_heap.h>
 #include <vespa/vespalib/util/priority_queue.h>
@@ -93,6 +94,226 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Block-max variant of weak and, used when all terms expose block-max
+ * information (see IBlockMaxSearch).
+ *
+ * The score of a term in a document is calculated by NumOccsScorer.
+ * The block-max number of occurrences gives an upper bound for the
+ * term score within a block, which is used to skip blocks of
+ * documents that cannot enter the heap.
+ */
+template <bool IS_STRICT>
+class BlockMaxWeakAndSearch : public WeakAndSearch
+{
+private:
+    typedef vespalib::PriorityQueue<score_t> Scores;
+
+    struct BlockMaxTerm {
+        SearchIterator::UP search;
+        IBlockMaxSearch   *block_max;
+        score_t            max_score;
+        BlockMaxTerm(SearchIterator *search_in, score_t max_score_in)
+            : search(search_in),
+              block_max(dynamic_cast<IBlockMaxSearch *>(search_in)),
+              max_score(max_score_in)
+        {
+            assert(block_max != nullptr);
+        }
+        docid_t docid() const { return search->getDocId(); }
+        score_t score() const { return NumOccsScorer::calculate_score(max_score, block_max->get_num_occs()); }
+        score_t block_score() const { return NumOccsScorer::calculate_score(max_score, block_max->get_block_max_num_occs()); }
+    };
+
+    Terms                     _input_terms;
+    std::vector<BlockMaxTerm> _terms;
+    std::vector<ref_t>        _order;     // terms ordered on current docid
+    score_t                   _threshold; // current score threshold
+    Scores                    _scores;    // best n scores
+    const uint32_t            _n;
+
+    const BlockMaxTerm &term(size_t idx) const { return _terms[_order[idx]]; }
+    BlockMaxTerm &term(size_t idx) { return _terms[_order[idx]]; }
+
+    void sort_order() {
+        for (size_t i = 1; i < _order.size(); ++i) {
+            ref_t ref = _order[i];
+            docid_t docid = _terms[ref].docid();
+            size_t j = i;
+            for (; j > 0 && _terms[_order[j - 1]].docid() > docid; --j) {
+                _order[j] = _order[j - 1];
+            }
+            _order[j] = ref;
+        }
+    }
+
+    // Seek terms [0, end) in docid order that are behind docid
+    void seek_terms(size_t end, docid_t docid) {
+        for (size_t i = 0; i < end; ++i) {
+            if (term(i).docid() < docid) {
+                term(i).search->seek(docid);
+            }
+        }
+    }
+
+    void find_candidate() {
+        for (;;) {
+            sort_order();
+            // select pivot using max score for terms
+            size_t pivot = _order.size();
+            score_t upper_bound = 0;
+            for (size_t i = 0; i < _order.size() && !isAtEnd(term(i).docid()); ++i) {
+                upper_bound += term(i).max_score;
+                if (upper_bound >= _threshold) {
+                    pivot = i;
+                    break;
+                }
+            }
+            if (pivot == _order.size()) {
+                setAtEnd();
+                return;
+            }
+            docid_t pivot_docid = term(pivot).docid();
+            while ((pivot + 1 < _order.size()) && (term(pivot + 1).docid() == pivot_docid)) {
+                ++pivot;
+            }
+            // refine upper bound using block max for terms up to pivot
+            docid_t next_docid = (pivot + 1 < _order.size()) ? term(pivot + 1).docid() : search::endDocId;
+            score_t block_upper_bound = 0;
+            for (size_t i = 0; i <= pivot; ++i) {
+                docid_t block_end = term(i).block_max->seek_block(pivot_docid);
+                block_upper_bound += term(i).block_score();
+                next_docid = std::min(next_docid, block_end + 1);
+            }
+            if (block_upper_bound >= _threshold) {
+                bool all_at_pivot = true;
+                for (size_t i = 0; i <= pivot; ++i) {
+                    all_at_pivot = all_at_pivot && (term(i).docid() == pivot_docid);
+                }
+                if (all_at_pivot) {
+                    score_t score = 0;
+                    for (size_t i = 0; i <= pivot; ++i) {
+                        score += term(i).score();
+                    }
+                    if (score >= _threshold) {
+                        setDocId(pivot_docid);
+                        return;
+                    }
+                    seek_terms(pivot + 1, pivot_docid + 1);
+                } else {
+                    seek_terms(pivot + 1, pivot_docid);
+                }
+            } else {
+                // no document before next_docid can reach threshold
+                seek_terms(pivot + 1, next_docid);
+            }
+        }
+    }
+
+    void seek_strict(uint32_t docid) {
+        seek_terms(_order.size(), docid);
+        find_candidate();
+    }
+
+    void seek_unstrict(uint32_t docid) {
+        score_t upper_bound = 0;
+        for (auto &t : _terms) {
+            if (t.docid() < docid) {
+                t.block_max->seek_block(docid);
+            }
+            if (t.docid() <= docid) {
+                upper_bound += t.block_score();
+            }
+        }
+        if (upper_bound < _threshold) {
+            return;
+        }
+        score_t score = 0;
+        for (auto &t : _terms) {
+            if (t.docid() < docid) {
+                t.search->seek(docid);
+            }
+            if (t.docid() == docid) {
+                score += t.score();
+            }
+        }
+        if (score >= _threshold) {
+            setDocId(docid);
+        }
+    }
+
+public:
+    BlockMaxWeakAndSearch(const Terms &terms, uint32_t n)
+        : _input_terms(terms),
+          _terms(),
+          _order(),
+          _threshold(1),
+          _scores(),
+          _n(n)
+    {
+        _terms.reserve(terms.size());
+        _order.reserve(terms.size());
+        for (const Term &t : terms) {
+            _order.push_back(_terms.size());
+            _terms.emplace_back(t.search, TermFrequencyScorer::calculateMaxScore(t));
+        }
+    }
+    size_t get_num_terms() const override { return _terms.size(); }
+    int32_t get_term_weight(size_t idx) const override { return _input_terms[idx].weight; }
+    score_t get_max_score(size_t idx) const override { return _terms[idx].max_score; }
+    const Terms &getTerms() const override { return _input_terms; }
+    uint32_t getN() const override { return _n; }
+    void doSeek(uint32_t docid) override {
+        if (IS_STRICT) {
+            seek_strict(docid);
+        } else {
+            seek_unstrict(docid);
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        score_t score = 0;
+        for (auto &t : _terms) {
+            if (t.docid() == docid) {
+                score += t.score();
+                t.search->unpack(docid);
+            }
+        }
+        _scores.push(score);
+        if (_scores.size() > _n) {
+            _scores.pop_front();
+        }
+        if (_scores.size() == _n) {
+            _threshold = _scores.front();
+        }
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        WeakAndSearch::initRange(begin, end);
+        for (auto &t : _terms) {
+            t.search->initRange(begin, end);
+        }
+        if (_n == 0) {
+            setAtEnd();
+        }
+    }
+    Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
+};
+
+namespace {
+
+bool has_block_max(const Terms &terms) {
+    for (const Term &t : terms) {
+        auto block_max = dynamic_cast<const IBlockMaxSearch *>(t.search);
+        if ((block_max == nullptr) || !block_max->has_block_max()) {
+            return false;
+        }
+    }
+    return !terms.empty();
+}
+
+}
+
+//-----------------------------------------------------------------------------
+
 } // namespace search::queryeval::wand
 
 //-----------------------------------------------------------------------------
@@ -126,10 +347,22 @@ WeakAndSearch::createHeapWand(const Terms &terms, uint32_t n, bool strict)
     }
 }
 
+SearchIterator::UP
+WeakAndSearch::createBlockMaxWand(const Terms &terms, uint32_t n, bool strict)
+{
+    if (strict) {
+        return SearchIterator::UP(new wand::BlockMaxWeakAndSearch<true>(terms, n));
+    } else {
+        return SearchIterator::UP(new wand::BlockMaxWeakAndSearch<false>(terms, n));
+    }
+}
+
 SearchIterator::UP
 WeakAndSearch::create(const Terms &terms, uint32_t n, bool strict)
 {
-    if (terms.size() < 128) {
+    if (wand::has_block_max(terms)) {
+        return createBlockMaxWand(terms, n, strict);
+    } else if (terms.size() < 128) {
         return createArrayWand(terms, n, strict);
     } else {
         return createHeapWand(terms, n, strict);
@@ -18,6 +18,8 @@ struct WeakAndSearch : SearchIterator {
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     static SearchIterator::UP createArrayWand(const Terms &terms, uint32_t n, bool strict);
     static SearchIterator::UP createHeapWand(const Terms &terms, uint32_t n, bool strict);
+    // All terms must implement IBlockMaxSearch
+    static SearchIterator::UP createBlockMaxWand(const Terms &terms, uint32_t n, bool strict);
     static SearchIterator::UP create(const Terms &terms, uint32_t n, bool strict);
 };
 
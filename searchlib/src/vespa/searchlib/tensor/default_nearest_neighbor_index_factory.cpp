@@ -31,17 +31,21 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                                          vespalib::eval::ValueType::CellType cell_type,
                                          const search::attribute::HnswIndexParams& params) const
 {
-    (void) vector_size;
     uint32_t m = params.max_links_per_node();
     HnswIndex::Config cfg(m * 2,
                           m,
                           params.neighbors_to_explore_at_insert(),
                           10000,
                           true);
+    std::unique_ptr<QuantizedVectorStore> quantized_vectors;
+    if (params.quantized_vectors() && QuantizedVectorStore::supports(params.distance_metric())) {
+        quantized_vectors = std::make_unique<QuantizedVectorStore>(params.distance_metric(), vector_size);
+    }
     return std::make_unique<HnswIndex>(vectors,
                                        make_distance_function(params.distance_metric(), cell_type),
                                        make_random_level_generator(m),
-                                       cfg);
+                                       cfg,
+                                       std::move(quantized_vectors));
 }
 
 }
@@ -11,11 +11,17 @@
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <deque>
+#include <future>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.dense_tensor_attribute");
 
 using search::attribute::LoadUtils;
+using vespalib::alloc::MemoryAllocator;
+using vespalib::alloc::MmapFileAllocatorFactory;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
 using vespalib::slime::ObjectInserter;
@@ -27,6 +33,10 @@ namespace {
 
 constexpr uint32_t DENSE_TENSOR_ATTRIBUTE_VERSION = 1;
 const vespalib::string tensorTypeTag("tensortype");
+// Max number of documents that are prepared, but not completed, when rebuilding the index in parallel during load.
+constexpr size_t max_pending_index_prepares = 1000;
+// Number of completed documents between each generation change when rebuilding the index in parallel during load.
+constexpr uint32_t index_completes_per_generation = 1000;
 
 class BlobSequenceReader : public ReaderBase
 {
@@ -59,6 +69,93 @@ BlobSequenceReader::is_present() {
     return true;
 }
 
+/**
+ * Rebuilds the nearest neighbor index in parallel when loading the attribute.
+ *
+ * The costly prepare step of adding a document is done by the executor threads,
+ * while the complete step is done by the loading thread in document id order.
+ */
+class ParallelIndexBuilder {
+private:
+    using PrepareResultUP = std::unique_ptr<PrepareResult>;
+    using Pending = std::pair<uint32_t, std::future<PrepareResultUP>>;
+    AttributeVector& _attr;
+    NearestNeighborIndex& _index;
+    vespalib::Executor& _executor;
+    std::deque<Pending> _pending;
+    uint32_t _completed;
+
+    void complete_first();
+
+public:
+    ParallelIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index, vespalib::Executor& executor);
+    ~ParallelIndexBuilder();
+    void add(uint32_t docid, vespalib::eval::TypedCells vector, vespalib::GenerationHandler::Guard guard);
+    void drain();
+};
+
+ParallelIndexBuilder::ParallelIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index, vespalib::Executor& executor)
+    : _attr(attr),
+      _index(index),
+      _executor(executor),
+      _pending(),
+      _completed(0)
+{
+}
+
+ParallelIndexBuilder::~ParallelIndexBuilder()
+{
+    drain();
+}
+
+void
+ParallelIndexBuilder::complete_first()
+{
+    auto& first = _pending.front();
+    _index.complete_add_document(first.first, first.second.get());
+    _pending.pop_front();
+    if ((++_completed % index_completes_per_generation) == 0) {
+        // Allows memory on hold lists to be freed while loading.
+        _attr.incGeneration();
+    }
+}
+
+void
+ParallelIndexBuilder::add(uint32_t docid, vespalib::eval::TypedCells vector, vespalib::GenerationHandler::Guard guard)
+{
+    std::promise<PrepareResultUP> promise;
+    _pending.emplace_back(docid, promise.get_future());
+    auto task = vespalib::makeLambdaTask([&index = _index, docid, vector, guard = std::move(guard),
+                                          promise = std::move(promise)]() mutable
+                                         {
+                                             promise.set_value(index.prepare_add_document(docid, vector, std::move(guard)));
+                                         });
+    auto rejected = _executor.execute(std::move(task));
+    if (rejected) {
+        rejected->run();
+    }
+    if (_pending.size() > max_pending_index_prepares) {
+        complete_first();
+    }
+}
+
+void
+ParallelIndexBuilder::drain()
+{
+    while (!_pending.empty()) {
+        complete_first();
+    }
+}
+
+std::unique_ptr<MemoryAllocator>
+make_memory_allocator(const vespalib::string& name, bool paged)
+{
+    if (paged) {
+        return MmapFileAllocatorFactory::instance().make_memory_allocator(name);
+    }
+    return {};
+}
+
 bool
 can_use_index_save_file(const search::attribute::Config &config, const search::attribute::AttributeHeader &header)
 {
@@ -106,7 +203,7 @@ DenseTensorAttribute::memory_usage() const
 DenseTensorAttribute::DenseTensorAttribute(vespalib::stringref baseFileName, const Config& cfg,
                                            const NearestNeighborIndexFactory& index_factory)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore),
-      _denseTensorStore(cfg.tensorType()),
+      _denseTensorStore(cfg.tensorType(), make_memory_allocator(getName(), cfg.paged())),
       _index()
 {
     if (cfg.hnsw_index_params().has_value()) {
@@ -160,6 +257,26 @@ DenseTensorAttribute::complete_set_tensor(DocId docid, const vespalib::eval::Val
     }
 }
 
+bool
+DenseTensorAttribute::modify_tensor(DocId docid, join_fun_t function, const vespalib::eval::Value& modifier)
+{
+    EntryRef old_ref;
+    if (docid < _refVector.size()) {
+        old_ref = _refVector[docid];
+    }
+    // Cells are modified in a copy, as readers may still be using the old buffer.
+    EntryRef ref = _denseTensorStore.modify_tensor(old_ref, function, modifier);
+    if (!ref.valid()) {
+        return false;
+    }
+    consider_remove_from_index(docid);
+    setTensorRef(docid, ref);
+    if (_index) {
+        _index->add_document(docid);
+    }
+    return true;
+}
+
 std::unique_ptr<vespalib::eval::Value>
 DenseTensorAttribute::getTensor(DocId docId) const
 {
@@ -185,6 +302,12 @@ DenseTensorAttribute::extract_dense_view(DocId docId, MutableDenseTensorView &te
 
 bool
 DenseTensorAttribute::onLoad()
+{
+    return onLoad(nullptr);
+}
+
+bool
+DenseTensorAttribute::onLoad(vespalib::Executor *executor)
 {
     BlobSequenceReader tensorReader(*this);
     if (!tensorReader.hasData()) {
@@ -200,6 +323,10 @@ DenseTensorAttribute::onLoad()
     uint32_t numDocs(tensorReader.getDocIdLimit());
     _refVector.reset();
     _refVector.unsafe_reserve(numDocs);
+    std::unique_ptr<ParallelIndexBuilder> index_builder;
+    if (_index && !use_index_file && executor != nullptr) {
+        index_builder = std::make_unique<ParallelIndexBuilder>(*this, *_index, *executor);
+    }
     for (uint32_t lid = 0; lid < numDocs; ++lid) {
         if (tensorReader.is_present()) {
             auto raw = _denseTensorStore.allocRawBuffer();
@@ -208,12 +335,19 @@ DenseTensorAttribute::onLoad()
             if (_index && !use_index_file) {
                 // This ensures that get_vector() (via getTensor()) is able to find the newly added tensor.
                 setCommittedDocIdLimit(lid + 1);
-                _index->add_document(lid);
+                if (index_builder) {
+                    index_builder->add(lid, get_vector(lid), getGenerationHandler().takeGuard());
+                } else {
+                    _index->add_document(lid);
+                }
             }
         } else {
             _refVector.push_back(EntryRef());
         }
     }
+    if (index_builder) {
+        index_builder->drain();
+    }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
     if (_index && use_index_file) {
@@ -36,10 +36,12 @@ public:
     void setTensor(DocId docId, const vespalib::eval::Value &tensor) override;
     std::unique_ptr<PrepareResult> prepare_set_tensor(DocId docid, const vespalib::eval::Value& tensor) const override;
     void complete_set_tensor(DocId docid, const vespalib::eval::Value& tensor, std::unique_ptr<PrepareResult> prepare_result) override;
+    bool modify_tensor(DocId docid, join_fun_t function, const vespalib::eval::Value& modifier) override;
     std::unique_ptr<vespalib::eval::Value> getTensor(DocId docId) const override;
     void extract_dense_view(DocId docId, vespalib::tensor::MutableDenseTensorView &tensor) const override;
     bool supports_extract_dense_view() const override { return true; }
     bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
     std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
     void compactWorst() override;
     uint32_t getVersion() const override;
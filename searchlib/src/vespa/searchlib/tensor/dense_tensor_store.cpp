@@ -4,11 +4,14 @@
 #include <vespa/eval/tensor/dense/dense_tensor_view.h>
 #include <vespa/eval/tensor/dense/mutable_dense_tensor_view.h>
 #include <vespa/vespalib/datastore/datastore.hpp>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/typify.h>
 
 using vespalib::datastore::Handle;
 using vespalib::tensor::MutableDenseTensorView;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
+using vespalib::eval::TypifyCellType;
 using CellType = vespalib::eval::ValueType::CellType;
 
 namespace search::tensor {
@@ -18,10 +21,81 @@ namespace {
 constexpr size_t MIN_BUFFER_ARRAYS = 1024;
 constexpr size_t DENSE_TENSOR_ALIGNMENT = 32;
 
+constexpr size_t npos = -1;
+
+/*
+ * Converts the labels of a sparse modifier address to an offset in
+ * the dense cells, or npos if a label is not a valid index.
+ */
+size_t
+dense_offset(const ValueType &type, const std::vector<vespalib::stringref> &addr)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < addr.size(); ++i) {
+        size_t dim_size = type.dimensions()[i].size;
+        size_t coord = 0;
+        if (addr[i].empty()) {
+            return npos;
+        }
+        for (char c : addr[i]) {
+            if ((c < '0') || (c > '9') || (coord >= dim_size)) {
+                return npos;
+            }
+            coord = coord * 10 + (c - '0');
+        }
+        if (coord >= dim_size) {
+            return npos;
+        }
+        offset = offset * dim_size + coord;
+    }
+    return offset;
+}
+
+struct ModifyCells {
+    template <typename ICT, typename MCT>
+    static void invoke(const ValueType &type, void *cells, DenseTensorStore::join_fun_t function, const Value &modifier) {
+        auto dst = static_cast<ICT *>(cells);
+        auto modifier_cells = modifier.cells().typify<MCT>();
+        size_t num_dims = type.dimensions().size();
+        std::vector<vespalib::stringref> addr(num_dims);
+        std::vector<vespalib::stringref *> addr_refs;
+        for (auto &label : addr) {
+            addr_refs.push_back(&label);
+        }
+        auto view = modifier.index().create_view({});
+        view->lookup({});
+        size_t subspace;
+        while (view->next_result(addr_refs, subspace)) {
+            size_t offset = dense_offset(type, addr);
+            if (offset != npos) {
+                dst[offset] = function(dst[offset], modifier_cells[subspace]);
+            }
+        }
+    }
+};
+
+bool
+is_suitable_modifier(const ValueType &type, const ValueType &modifier_type)
+{
+    const auto &dims = type.dimensions();
+    const auto &modifier_dims = modifier_type.dimensions();
+    if (!modifier_type.is_sparse() || (dims.size() != modifier_dims.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (dims[i].name != modifier_dims[i].name) {
+            return false;
+        }
+    }
+    return true;
+}
+
 size_t size_of(CellType type) {
     switch (type) {
     case CellType::DOUBLE: return sizeof(double);
     case CellType::FLOAT: return sizeof(float);
+    case CellType::BFLOAT16: return sizeof(vespalib::BFloat16);
+    case CellType::INT8: return sizeof(int8_t);
     }
     abort();
 }
@@ -48,8 +122,9 @@ DenseTensorStore::TensorSizeCalc::alignedSize() const
     return my_align(bufSize(), DENSE_TENSOR_ALIGNMENT);
 }
 
-DenseTensorStore::BufferType::BufferType(const TensorSizeCalc &tensorSizeCalc)
-    : vespalib::datastore::BufferType<char>(tensorSizeCalc.alignedSize(), MIN_BUFFER_ARRAYS, RefType::offsetSize())
+DenseTensorStore::BufferType::BufferType(const TensorSizeCalc &tensorSizeCalc, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator)
+    : vespalib::datastore::BufferType<char>(tensorSizeCalc.alignedSize(), MIN_BUFFER_ARRAYS, RefType::offsetSize()),
+      _allocator(std::move(allocator))
 {}
 
 DenseTensorStore::BufferType::~BufferType() = default;
@@ -61,11 +136,17 @@ DenseTensorStore::BufferType::cleanHold(void *buffer, size_t offset,
     memset(static_cast<char *>(buffer) + offset, 0, numElems);
 }
 
-DenseTensorStore::DenseTensorStore(const ValueType &type)
+const vespalib::alloc::MemoryAllocator*
+DenseTensorStore::BufferType::get_memory_allocator() const
+{
+    return _allocator.get();
+}
+
+DenseTensorStore::DenseTensorStore(const ValueType &type, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator)
     : TensorStore(_concreteStore),
       _concreteStore(),
       _tensorSizeCalc(type),
-      _bufferType(_tensorSizeCalc),
+      _bufferType(_tensorSizeCalc, std::move(allocator)),
       _type(type),
       _emptySpace()
 {
@@ -177,4 +258,18 @@ DenseTensorStore::setTensor(const vespalib::eval::Value &tensor)
     return setDenseTensor(tensor);
 }
 
+TensorStore::EntryRef
+DenseTensorStore::modify_tensor(EntryRef ref, join_fun_t function, const Value &modifier)
+{
+    if (!ref.valid() || !is_suitable_modifier(_type, modifier.type())) {
+        return RefType();
+    }
+    auto oldraw = getRawBuffer(ref);
+    auto newraw = allocRawBuffer();
+    memcpy(newraw.data, static_cast<const char *>(oldraw), getBufSize());
+    vespalib::typify_invoke<2, TypifyCellType, ModifyCells>(_type.cell_type(), modifier.cells().type,
+                                                            _type, newraw.data, function, modifier);
+    return newraw.ref;
+}
+
 }
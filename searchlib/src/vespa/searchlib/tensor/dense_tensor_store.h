@@ -7,6 +7,7 @@
 #include <vespa/eval/eval/typed_cells.h>
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
+namespace vespalib::alloc { class MemoryAllocator; }
 namespace vespalib::eval { struct Value; }
 
 namespace search::tensor {
@@ -14,6 +15,9 @@ namespace search::tensor {
 /**
  * Class for storing dense tensors with known bounds in memory, used
  * by DenseTensorAttribute.
+ *
+ * An optional memory allocator can be given to place the tensor buffers
+ * elsewhere than on the heap, e.g. in memory mapped files.
  */
 class DenseTensorStore : public TensorStore
 {
@@ -21,6 +25,7 @@ public:
     using RefType = vespalib::datastore::EntryRefT<22>;
     using DataStoreType = vespalib::datastore::DataStoreT<RefType>;
     using ValueType = vespalib::eval::ValueType;
+    using join_fun_t = double (*)(double, double);
 
     struct TensorSizeCalc
     {
@@ -35,10 +40,12 @@ public:
     class BufferType : public vespalib::datastore::BufferType<char>
     {
         using CleanContext = vespalib::datastore::BufferType<char>::CleanContext;
+        std::unique_ptr<vespalib::alloc::MemoryAllocator> _allocator;
     public:
-        BufferType(const TensorSizeCalc &tensorSizeCalc);
+        BufferType(const TensorSizeCalc &tensorSizeCalc, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator);
         ~BufferType() override;
         void cleanHold(void *buffer, size_t offset, size_t numElems, CleanContext cleanCtx) override;
+        const vespalib::alloc::MemoryAllocator* get_memory_allocator() const override;
     };
 private:
     DataStoreType _concreteStore;
@@ -54,7 +61,7 @@ private:
     setDenseTensor(const TensorType &tensor);
 
 public:
-    DenseTensorStore(const ValueType &type);
+    DenseTensorStore(const ValueType &type, std::unique_ptr<vespalib::alloc::MemoryAllocator> allocator);
     ~DenseTensorStore() override;
 
     const ValueType &type() const { return _type; }
@@ -69,6 +76,17 @@ public:
     void getTensor(EntryRef ref, vespalib::tensor::MutableDenseTensorView &tensor) const;
     vespalib::eval::TypedCells get_typed_cells(EntryRef ref) const;
     EntryRef setTensor(const vespalib::eval::Value &tensor);
+    /**
+     * Copies the tensor referenced by ref into a new buffer and applies
+     * function(old cell, modifier cell) to the cells addressed by the
+     * modifier, without building any intermediate tensors. The old
+     * buffer is left untouched for concurrent readers and must be put
+     * on hold by the caller. The modifier must be a sparse tensor with
+     * the same dimension names as the dense type, and modifier cells
+     * outside the bounds are ignored. Returns an invalid ref if ref is
+     * invalid or the modifier is not suitable.
+     */
+    EntryRef modify_tensor(EntryRef ref, join_fun_t function, const vespalib::eval::Value &modifier);
     // The following method is meant to be used only for unit tests.
     uint32_t getArraySize() const { return _bufferType.getArraySize(); }
 };
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 namespace vespalib::eval { struct TypedCells; }
@@ -11,7 +12,7 @@ namespace search::tensor {
 /**
  * Interface used to calculate the distance between two n-dimensional vectors.
  *
- * The vectors must be of same size and same type (float or double).
+ * The vectors must be of same size and same cell type.
  * The actual implementation must know which type the vectors are.
  */
 class DistanceFunction {
@@ -23,6 +24,18 @@ public:
     virtual double calc_with_limit(const vespalib::eval::TypedCells& lhs,
                                    const vespalib::eval::TypedCells& rhs,
                                    double limit) const = 0;
+
+    /**
+     * Calculates the distances between lhs and each of the num_rhs vectors in rhs,
+     * and stores the results in distances.
+     *
+     * Implementations may override this to amortize per vector overhead
+     * and prefetch the cells of the next vector while the current one is calculated.
+     */
+    virtual void calc_batch(const vespalib::eval::TypedCells& lhs,
+                            const vespalib::eval::TypedCells* rhs,
+                            size_t num_rhs,
+                            double* distances) const;
 };
 
 }
@@ -4,19 +4,40 @@
 
 namespace search::tensor {
 
+void
+DistanceFunction::calc_batch(const vespalib::eval::TypedCells& lhs,
+                             const vespalib::eval::TypedCells* rhs,
+                             size_t num_rhs,
+                             double* distances) const
+{
+    for (size_t i = 0; i < num_rhs; ++i) {
+        distances[i] = calc(lhs, rhs[i]);
+    }
+}
+
 template class SquaredEuclideanDistance<float>;
 template class SquaredEuclideanDistance<double>;
+template class SquaredEuclideanDistance<vespalib::BFloat16>;
+template class SquaredEuclideanDistance<int8_t>;
 
 template class AngularDistance<float>;
 template class AngularDistance<double>;
+template class AngularDistance<vespalib::BFloat16>;
+template class AngularDistance<int8_t>;
 
 template class InnerProductDistance<float>;
 template class InnerProductDistance<double>;
+template class InnerProductDistance<vespalib::BFloat16>;
+template class InnerProductDistance<int8_t>;
 
 template class GeoDegreesDistance<float>;
 template class GeoDegreesDistance<double>;
+template class GeoDegreesDistance<vespalib::BFloat16>;
+template class GeoDegreesDistance<int8_t>;
 
 template class HammingDistance<float>;
 template class HammingDistance<double>;
+template class HammingDistance<vespalib::BFloat16>;
+template class HammingDistance<int8_t>;
 
 }
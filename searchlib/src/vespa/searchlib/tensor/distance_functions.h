@@ -5,10 +5,90 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <algorithm>
 #include <cmath>
 
 namespace search::tensor {
 
+namespace distance_helper {
+
+// The number of bytes prefetched from the start of the next vector in a batch.
+constexpr size_t prefetch_bytes = 256;
+
+template <typename FloatType>
+inline void prefetch_cells(const vespalib::eval::TypedCells& cells) {
+    const char* data = static_cast<const char*>(cells.data);
+    size_t bytes = std::min(size_t(cells.size) * sizeof(FloatType), prefetch_bytes);
+    for (size_t offset = 0; offset < bytes; offset += 64) {
+        __builtin_prefetch(data + offset);
+    }
+}
+
+template <typename FloatType>
+inline const FloatType* cells_in_batch(const vespalib::eval::TypedCells* rhs, size_t num_rhs, size_t i, size_t sz) {
+    if (i + 1 < num_rhs) {
+        prefetch_cells<FloatType>(rhs[i + 1]);
+    }
+    auto rhs_vector = rhs[i].typify<FloatType>();
+    assert(sz == rhs_vector.size());
+    (void) sz;
+    return &rhs_vector[0];
+}
+
+// The number of bfloat16 cells expanded to float at a time.
+constexpr size_t convert_chunk_size = 256;
+
+// Calls fun for consecutive chunks of a and b expanded to float.
+template <typename F>
+inline void for_each_float_chunk(const vespalib::hwaccelrated::IAccelrated &hw,
+                                 const vespalib::BFloat16 *a, const vespalib::BFloat16 *b, size_t sz, F &&fun)
+{
+    float a_buf[convert_chunk_size];
+    float b_buf[convert_chunk_size];
+    for (size_t i = 0; i < sz; i += convert_chunk_size) {
+        size_t n = std::min(convert_chunk_size, sz - i);
+        hw.convertBFloat16ToFloat(a + i, a_buf, n);
+        hw.convertBFloat16ToFloat(b + i, b_buf, n);
+        fun(a_buf, b_buf, n);
+    }
+}
+
+template <typename FloatType>
+inline double squared_euclidean_distance(const vespalib::hwaccelrated::IAccelrated &hw,
+                                         const FloatType *a, const FloatType *b, size_t sz)
+{
+    return hw.squaredEuclideanDistance(a, b, sz);
+}
+
+inline double squared_euclidean_distance(const vespalib::hwaccelrated::IAccelrated &hw,
+                                         const vespalib::BFloat16 *a, const vespalib::BFloat16 *b, size_t sz)
+{
+    double sum = 0.0;
+    for_each_float_chunk(hw, a, b, sz, [&](const float *fa, const float *fb, size_t n) {
+        sum += hw.squaredEuclideanDistance(fa, fb, n);
+    });
+    return sum;
+}
+
+template <typename FloatType>
+inline double dot_product(const vespalib::hwaccelrated::IAccelrated &hw,
+                          const FloatType *a, const FloatType *b, size_t sz)
+{
+    return hw.dotProduct(a, b, sz);
+}
+
+inline double dot_product(const vespalib::hwaccelrated::IAccelrated &hw,
+                          const vespalib::BFloat16 *a, const vespalib::BFloat16 *b, size_t sz)
+{
+    double sum = 0.0;
+    for_each_float_chunk(hw, a, b, sz, [&](const float *fa, const float *fb, size_t n) {
+        sum += hw.dotProduct(fa, fb, n);
+    });
+    return sum;
+}
+
+}
+
 /**
  * Calculates the square of the standard Euclidean distance.
  * Will use instruction optimal for the cpu it is running on.
@@ -24,7 +104,16 @@ public:
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        return _computer.squaredEuclideanDistance(&lhs_vector[0], &rhs_vector[0], sz);
+        return distance_helper::squared_euclidean_distance(_computer, &lhs_vector[0], &rhs_vector[0], sz);
+    }
+    void calc_batch(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells* rhs,
+                    size_t num_rhs, double* distances) const override {
+        auto lhs_vector = lhs.typify<FloatType>();
+        size_t sz = lhs_vector.size();
+        for (size_t i = 0; i < num_rhs; ++i) {
+            auto b = distance_helper::cells_in_batch<FloatType>(rhs, num_rhs, i, sz);
+            distances[i] = distance_helper::squared_euclidean_distance(_computer, &lhs_vector[0], b, sz);
+        }
     }
     double to_rawscore(double distance) const override {
         double d = sqrt(distance);
@@ -66,15 +155,31 @@ public:
         assert(sz == rhs_vector.size());
         auto a = &lhs_vector[0];
         auto b = &rhs_vector[0];
-        double a_norm_sq = _computer.dotProduct(a, a, sz);
-        double b_norm_sq = _computer.dotProduct(b, b, sz);
+        double a_norm_sq = distance_helper::dot_product(_computer, a, a, sz);
+        double b_norm_sq = distance_helper::dot_product(_computer, b, b, sz);
         double squared_norms = a_norm_sq * b_norm_sq;
-        double dot_product = _computer.dotProduct(a, b, sz);
+        double dot_product = distance_helper::dot_product(_computer, a, b, sz);
         double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
         double cosine_similarity = dot_product / div;
         double distance = 1.0 - cosine_similarity; // in range [0,2]
         return distance;
     }
+    void calc_batch(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells* rhs,
+                    size_t num_rhs, double* distances) const override {
+        auto lhs_vector = lhs.typify<FloatType>();
+        size_t sz = lhs_vector.size();
+        auto a = &lhs_vector[0];
+        // The norm of lhs is only calculated once for the entire batch.
+        double a_norm_sq = distance_helper::dot_product(_computer, a, a, sz);
+        for (size_t i = 0; i < num_rhs; ++i) {
+            auto b = distance_helper::cells_in_batch<FloatType>(rhs, num_rhs, i, sz);
+            double b_norm_sq = distance_helper::dot_product(_computer, b, b, sz);
+            double squared_norms = a_norm_sq * b_norm_sq;
+            double dot_product = distance_helper::dot_product(_computer, a, b, sz);
+            double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
+            distances[i] = 1.0 - (dot_product / div);
+        }
+    }
     double to_rawscore(double distance) const override {
         double cosine_similarity = 1.0 - distance;
         // should be in in range [-1,1] but roundoff may cause problems:
@@ -109,9 +214,19 @@ public:
         auto rhs_vector = rhs.typify<FloatType>();
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        double score = 1.0 - _computer.dotProduct(&lhs_vector[0], &rhs_vector[0], sz);
+        double score = 1.0 - distance_helper::dot_product(_computer, &lhs_vector[0], &rhs_vector[0], sz);
         return std::max(0.0, score);
     }
+    void calc_batch(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells* rhs,
+                    size_t num_rhs, double* distances) const override {
+        auto lhs_vector = lhs.typify<FloatType>();
+        size_t sz = lhs_vector.size();
+        for (size_t i = 0; i < num_rhs; ++i) {
+            auto b = distance_helper::cells_in_batch<FloatType>(rhs, num_rhs, i, sz);
+            double score = 1.0 - distance_helper::dot_product(_computer, &lhs_vector[0], b, sz);
+            distances[i] = std::max(0.0, score);
+        }
+    }
     double to_rawscore(double distance) const override {
         double score = 1.0 / (1.0 + distance);
         return score;
@@ -217,5 +332,44 @@ public:
     }
 };
 
+/**
+ * Calculates the Hamming distance between int8 vectors where each cell
+ * holds 8 packed bits of a binary vector, defined as
+ * "number of bits where the values are different".
+ */
+class BinaryHammingDistance : public DistanceFunction {
+public:
+    BinaryHammingDistance()
+        : _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator())
+    {}
+    double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override {
+        auto lhs_vector = lhs.typify<int8_t>();
+        auto rhs_vector = rhs.typify<int8_t>();
+        size_t sz = lhs_vector.size();
+        assert(sz == rhs_vector.size());
+        return _computer.binaryHammingDistance(&lhs_vector[0], &rhs_vector[0], sz);
+    }
+    void calc_batch(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells* rhs,
+                    size_t num_rhs, double* distances) const override {
+        auto lhs_vector = lhs.typify<int8_t>();
+        size_t sz = lhs_vector.size();
+        for (size_t i = 0; i < num_rhs; ++i) {
+            auto b = distance_helper::cells_in_batch<int8_t>(rhs, num_rhs, i, sz);
+            distances[i] = _computer.binaryHammingDistance(&lhs_vector[0], b, sz);
+        }
+    }
+    double to_rawscore(double distance) const override {
+        double score = 1.0 / (1.0 + distance);
+        return score;
+    }
+    double calc_with_limit(const vespalib::eval::TypedCells& lhs,
+                           const vespalib::eval::TypedCells& rhs,
+                           double) const override
+    {
+        return calc(lhs, rhs);
+    }
+
+    const vespalib::hwaccelrated::IAccelrated & _computer;
+};
 
 }
@@ -135,11 +135,39 @@ HnswIndex::select_neighbors(const HnswCandidateVector& neighbors, uint32_t max_l
     }
 }
 
+HnswIndex::LinkArrayUpdates::LinkArrayUpdates(const HnswGraph& graph, uint32_t level)
+    : _graph(graph),
+      _level(level),
+      _updates()
+{
+}
+
+HnswIndex::LinkArrayUpdates::~LinkArrayUpdates() = default;
+
+HnswIndex::LinkArrayRef
+HnswIndex::LinkArrayUpdates::get(uint32_t docid) const
+{
+    auto itr = _updates.find(docid);
+    if (itr != _updates.end()) {
+        return itr->second;
+    }
+    return _graph.get_link_array(docid, _level);
+}
+
+void
+HnswIndex::LinkArrayUpdates::flush(HnswGraph& graph)
+{
+    for (const auto& update : _updates) {
+        graph.set_link_array(update.first, _level, update.second);
+    }
+    _updates.clear();
+}
+
 void
-HnswIndex::shrink_if_needed(uint32_t docid, uint32_t level)
+HnswIndex::shrink_if_needed(LinkArrayUpdates& updates, uint32_t docid)
 {
-    auto old_links = _graph.get_link_array(docid, level);
-    uint32_t max_links = max_links_for_level(level);
+    auto old_links = updates.get(docid);
+    uint32_t max_links = max_links_for_level(updates.level());
     if (old_links.size() > max_links) {
         HnswCandidateVector neighbors;
         for (uint32_t neighbor_docid : old_links) {
@@ -152,9 +180,9 @@ HnswIndex::shrink_if_needed(uint32_t docid, uint32_t level)
         for (const auto & neighbor : split.used) {
             new_links.push_back(neighbor.docid);
         }
-        _graph.set_link_array(docid, level, new_links);
+        updates.set(docid, std::move(new_links));
         for (uint32_t removed_docid : split.unused) {
-            remove_link_to(removed_docid, docid, level);
+            remove_link_to(updates, removed_docid, docid);
         }
     }
 }
@@ -163,24 +191,26 @@ void
 HnswIndex::connect_new_node(uint32_t docid, const LinkArrayRef &neighbors, uint32_t level)
 {
     _graph.set_link_array(docid, level, neighbors);
+    LinkArrayUpdates updates(_graph, level);
     for (uint32_t neighbor_docid : neighbors) {
-        auto old_links = _graph.get_link_array(neighbor_docid, level);
-        add_link_to(neighbor_docid, level, old_links, docid);
+        auto old_links = updates.get(neighbor_docid);
+        add_link_to(updates, neighbor_docid, old_links, docid);
     }
     for (uint32_t neighbor_docid : neighbors) {
-        shrink_if_needed(neighbor_docid, level);
+        shrink_if_needed(updates, neighbor_docid);
     }
+    updates.flush(_graph);
 }
 
 void
-HnswIndex::remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level)
+HnswIndex::remove_link_to(LinkArrayUpdates& updates, uint32_t remove_from, uint32_t remove_id)
 {
     LinkArray new_links;
-    auto old_links = _graph.get_link_array(remove_from, level);
+    auto old_links = updates.get(remove_from);
     for (uint32_t id : old_links) {
         if (id != remove_id) new_links.push_back(id);
     }
-    _graph.set_link_array(remove_from, level, new_links);
+    updates.set(remove_from, std::move(new_links));
 }
 
 
@@ -198,8 +228,35 @@ HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
     return _distance_func->calc(lhs, rhs);
 }
 
+HnswIndex::NeighborBatch::NeighborBatch() = default;
+HnswIndex::NeighborBatch::~NeighborBatch() = default;
+
+void
+HnswIndex::calc_distances(const TypedCells& input, NeighborBatch& batch) const
+{
+    size_t num_neighbors = batch.neighbors.size();
+    batch.vectors.clear();
+    for (const auto & neighbor : batch.neighbors) {
+        batch.vectors.push_back(get_vector(neighbor.docid));
+    }
+    batch.distances.resize(num_neighbors);
+    _distance_func->calc_batch(input, batch.vectors.data(), num_neighbors, batch.distances.data());
+    for (size_t i = 0; i < num_neighbors; ++i) {
+        batch.neighbors[i].distance = batch.distances[i];
+    }
+}
+
+void
+HnswIndex::calc_distances(const QuantizedVector& input, NeighborBatch& batch) const
+{
+    for (auto & neighbor : batch.neighbors) {
+        neighbor.distance = calc_distance(input, neighbor.docid);
+    }
+}
+
+template <typename VectorType>
 HnswCandidate
-HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const
+HnswIndex::find_nearest_in_layer(const VectorType& input, const HnswCandidate& entry_point, uint32_t level) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
@@ -219,8 +276,9 @@ HnswIndex::find_nearest_in_layer(const TypedCells& input, const HnswCandidate& e
     return nearest;
 }
 
+template <typename VectorType>
 void
-HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
+HnswIndex::search_layer(const VectorType& input, uint32_t neighbors_to_find,
                         FurthestPriQ& best_neighbors, uint32_t level, const search::BitVector *filter) const
 {
     NearestPriQ candidates;
@@ -241,6 +299,7 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
         }
     }
     double limit_dist = std::numeric_limits<double>::max();
+    NeighborBatch batch;
 
     while (!candidates.empty()) {
         auto cand = candidates.top();
@@ -248,6 +307,7 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
             break;
         }
         candidates.pop();
+        batch.clear();
         for (uint32_t neighbor_docid : _graph.get_link_array(cand.node_ref, level)) {
             auto neighbor_ref = _graph.get_node_ref(neighbor_docid);
             if ((! neighbor_ref.valid())
@@ -257,11 +317,15 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
                 continue;
             }
             visited.mark(neighbor_docid);
-            double dist_to_input = calc_distance(input, neighbor_docid);
+            batch.neighbors.emplace_back(neighbor_docid, neighbor_ref, 0.0);
+        }
+        calc_distances(input, batch);
+        for (const auto & neighbor : batch.neighbors) {
+            double dist_to_input = neighbor.distance;
             if (dist_to_input < limit_dist) {
-                candidates.emplace(neighbor_docid, neighbor_ref, dist_to_input);
-                if ((!filter) || filter->testBit(neighbor_docid)) {
-                    best_neighbors.emplace(neighbor_docid, neighbor_ref, dist_to_input);
+                candidates.push(neighbor);
+                if ((!filter) || filter->testBit(neighbor.docid)) {
+                    best_neighbors.push(neighbor);
                     if (best_neighbors.size() > neighbors_to_find) {
                         best_neighbors.pop();
                         limit_dist = best_neighbors.top().distance;
@@ -273,11 +337,13 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
 }
 
 HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-                     RandomLevelGenerator::UP level_generator, const Config& cfg)
+                     RandomLevelGenerator::UP level_generator, const Config& cfg,
+                     std::unique_ptr<QuantizedVectorStore> quantized_vectors)
     :
       _graph(),
       _vectors(vectors),
       _distance_func(std::move(distance_func)),
+      _quantized_vectors(std::move(quantized_vectors)),
       _level_generator(std::move(level_generator)),
       _cfg(cfg)
 {
@@ -358,6 +424,7 @@ HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neig
 void
 HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
 {
+    set_quantized_vector(docid);
     auto node_ref = _graph.make_node_for_document(docid, op.max_level + 1);
     for (int level = 0; level <= op.max_level; ++level) {
         auto neighbors = filter_valid_docids(level, op.connections[level], docid);
@@ -401,12 +468,12 @@ HnswIndex::complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult>
 }
 
 void
-HnswIndex::mutual_reconnect(const LinkArrayRef &cluster, uint32_t level)
+HnswIndex::mutual_reconnect(LinkArrayUpdates& updates, const LinkArrayRef &cluster)
 {
     std::vector<PairDist> pairs;
     for (uint32_t i = 0; i + 1 < cluster.size(); ++i) {
         uint32_t n_id_1 = cluster[i];
-        LinkArrayRef n_list_1 = _graph.get_link_array(n_id_1, level);
+        LinkArrayRef n_list_1 = updates.get(n_id_1);
         for (uint32_t j = i + 1; j < cluster.size(); ++j) {
             uint32_t n_id_2 = cluster[j];
             if (has_link_to(n_list_1, n_id_2)) continue;
@@ -415,14 +482,14 @@ HnswIndex::mutual_reconnect(const LinkArrayRef &cluster, uint32_t level)
     }
     std::sort(pairs.begin(), pairs.end());
     for (const PairDist & pair : pairs) {
-        LinkArrayRef old_links_1 = _graph.get_link_array(pair.id_first, level);
+        LinkArrayRef old_links_1 = updates.get(pair.id_first);
         if (old_links_1.size() >= _cfg.max_links_on_inserts()) continue;
 
-        LinkArrayRef old_links_2 = _graph.get_link_array(pair.id_second, level);
+        LinkArrayRef old_links_2 = updates.get(pair.id_second);
         if (old_links_2.size() >= _cfg.max_links_on_inserts()) continue;
 
-        add_link_to(pair.id_first, level, old_links_1, pair.id_second);
-        add_link_to(pair.id_second, level, old_links_2, pair.id_first);
+        add_link_to(updates, pair.id_first, old_links_1, pair.id_second);
+        add_link_to(updates, pair.id_second, old_links_2, pair.id_first);
     }
 }
 
@@ -433,15 +500,17 @@ HnswIndex::remove_document(uint32_t docid)
     LevelArrayRef node_levels = _graph.get_level_array(docid);
     for (int level = node_levels.size(); level-- > 0; ) {
         LinkArrayRef my_links = _graph.get_link_array(docid, level);
+        LinkArrayUpdates updates(_graph, level);
         for (uint32_t neighbor_id : my_links) {
             if (need_new_entrypoint) {
                 auto entry_node_ref = _graph.get_node_ref(neighbor_id);
                 _graph.set_entry_node({neighbor_id, entry_node_ref, level});
                 need_new_entrypoint = false;
             }
-            remove_link_to(neighbor_id, docid, level);
+            remove_link_to(updates, neighbor_id, docid);
         }
-        mutual_reconnect(my_links, level);
+        mutual_reconnect(updates, my_links);
+        updates.flush(_graph);
     }
     if (need_new_entrypoint) {
         HnswGraph::EntryNode entry;
@@ -458,6 +527,9 @@ HnswIndex::transfer_hold_lists(generation_t current_gen)
     _graph.node_refs.setGeneration(current_gen + 1);
     _graph.nodes.transferHoldLists(current_gen);
     _graph.links.transferHoldLists(current_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->transfer_hold_lists(current_gen);
+    }
 }
 
 void
@@ -466,6 +538,9 @@ HnswIndex::trim_hold_lists(generation_t first_used_gen)
     _graph.node_refs.removeOldGenerations(first_used_gen);
     _graph.nodes.trimHoldLists(first_used_gen);
     _graph.links.trimHoldLists(first_used_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->trim_hold_lists(first_used_gen);
+    }
 }
 
 vespalib::MemoryUsage
@@ -476,6 +551,9 @@ HnswIndex::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -508,6 +586,7 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    cfgObj.setBool("quantized_vectors", has_quantized_vectors());
 }
 
 std::unique_ptr<NearestNeighborIndexSaver>
@@ -521,7 +600,18 @@ HnswIndex::load(const fileutil::LoadedBuffer& buf)
 {
     assert(get_entry_docid() == 0); // cannot load after index has data
     HnswIndexLoader loader(_graph);
-    return loader.load(buf);
+    if (!loader.load(buf)) {
+        return false;
+    }
+    if (_quantized_vectors) {
+        // The quantized vectors are not saved, but derived from the full precision vectors.
+        for (uint32_t docid = 0; docid < _graph.node_refs.size(); ++docid) {
+            if (_graph.get_node_ref(docid).valid()) {
+                set_quantized_vector(docid);
+            }
+        }
+    }
+    return true;
 }
 
 struct NeighborsByDocId {
@@ -564,6 +654,27 @@ HnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
 
 FurthestPriQ
 HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const BitVector *filter) const
+{
+    if (_quantized_vectors) {
+        auto quantized_vector = _quantized_vectors->make_query_vector(vector);
+        return rerank_with_full_precision(vector, top_k_candidates_helper(quantized_vector, k, filter));
+    }
+    return top_k_candidates_helper(vector, k, filter);
+}
+
+FurthestPriQ
+HnswIndex::rerank_with_full_precision(const TypedCells &vector, const FurthestPriQ &candidates) const
+{
+    FurthestPriQ result;
+    for (const HnswCandidate & candidate : candidates.peek()) {
+        result.emplace(candidate.docid, candidate.node_ref, calc_distance(vector, candidate.docid));
+    }
+    return result;
+}
+
+template <typename VectorType>
+FurthestPriQ
+HnswIndex::top_k_candidates_helper(const VectorType &vector, uint32_t k, const BitVector *filter) const
 {
     FurthestPriQ best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -607,6 +718,7 @@ HnswIndex::set_node(uint32_t docid, const HnswNode &node)
 {
     size_t num_levels = node.size();
     assert(num_levels > 0);
+    set_quantized_vector(docid);
     auto node_ref = _graph.make_node_for_document(docid, num_levels);
     for (size_t level = 0; level < num_levels; ++level) {
         connect_new_node(docid, node.level(level), level);
@@ -7,6 +7,7 @@
 #include "hnsw_index_utils.h"
 #include "hnsw_node.h"
 #include "nearest_neighbor_index.h"
+#include "quantized_vector_store.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
 #include <vespa/eval/eval/typed_cells.h>
@@ -16,6 +17,7 @@
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/util/rcuvector.h>
 #include <vespa/vespalib/util/reusable_set_pool.h>
+#include <map>
 
 namespace search::tensor {
 
@@ -73,19 +75,41 @@ protected:
     using LevelArray = vespalib::Array<AtomicEntryRef>;
 
     using TypedCells = vespalib::eval::TypedCells;
+    using QuantizedVector = QuantizedVectorStore::QueryVector;
 
     HnswGraph _graph;
     const DocVectorAccess& _vectors;
     DistanceFunction::UP _distance_func;
+    std::unique_ptr<QuantizedVectorStore> _quantized_vectors;
     RandomLevelGenerator::UP _level_generator;
     Config _cfg;
     mutable vespalib::ReusableSetPool _visited_set_pool;
 
+    /**
+     * Collects the link array changes at one level during a single add or remove operation.
+     *
+     * Each changed link array is written to the graph (and the old copy put on hold) only once
+     * when flushing, instead of once per individual change.
+     */
+    class LinkArrayUpdates {
+    private:
+        const HnswGraph& _graph;
+        uint32_t _level;
+        std::map<uint32_t, LinkArray> _updates;
+    public:
+        LinkArrayUpdates(const HnswGraph& graph, uint32_t level);
+        ~LinkArrayUpdates();
+        uint32_t level() const { return _level; }
+        LinkArrayRef get(uint32_t docid) const;
+        void set(uint32_t docid, LinkArray links) { _updates[docid] = std::move(links); }
+        void flush(HnswGraph& graph);
+    };
+
     uint32_t max_links_for_level(uint32_t level) const;
-    void add_link_to(uint32_t docid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
+    void add_link_to(LinkArrayUpdates& updates, uint32_t docid, const LinkArrayRef& old_links, uint32_t new_link) {
         LinkArray new_links(old_links.begin(), old_links.end());
         new_links.push_back(new_link);
-        _graph.set_link_array(docid, level, new_links);
+        updates.set(docid, std::move(new_links));
     }
 
     /**
@@ -104,10 +128,10 @@ protected:
     SelectResult select_neighbors_heuristic(const HnswCandidateVector& neighbors, uint32_t max_links) const;
     SelectResult select_neighbors_simple(const HnswCandidateVector& neighbors, uint32_t max_links) const;
     SelectResult select_neighbors(const HnswCandidateVector& neighbors, uint32_t max_links) const;
-    void shrink_if_needed(uint32_t docid, uint32_t level);
+    void shrink_if_needed(LinkArrayUpdates& updates, uint32_t docid);
     void connect_new_node(uint32_t docid, const LinkArrayRef &neighbors, uint32_t level);
-    void mutual_reconnect(const LinkArrayRef &cluster, uint32_t level);
-    void remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level);
+    void mutual_reconnect(LinkArrayUpdates& updates, const LinkArrayRef &cluster);
+    void remove_link_to(LinkArrayUpdates& updates, uint32_t remove_from, uint32_t remove_id);
 
     inline TypedCells get_vector(uint32_t docid) const {
         return _vectors.get_vector(docid);
@@ -115,13 +139,41 @@ protected:
 
     double calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const;
     double calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const;
+    double calc_distance(const QuantizedVector& lhs, uint32_t rhs_docid) const {
+        return _quantized_vectors->calc_distance(lhs, rhs_docid);
+    }
+
+    /**
+     * The unvisited neighbors of a node, for which distances to the input vector are calculated in one batch.
+     */
+    struct NeighborBatch {
+        HnswCandidateVector neighbors;
+        std::vector<TypedCells> vectors;
+        std::vector<double> distances;
+        NeighborBatch();
+        ~NeighborBatch();
+        void clear() { neighbors.clear(); }
+    };
+    void calc_distances(const TypedCells& input, NeighborBatch& batch) const;
+    void calc_distances(const QuantizedVector& input, NeighborBatch& batch) const;
+    void set_quantized_vector(uint32_t docid) {
+        if (_quantized_vectors) {
+            _quantized_vectors->set(docid, get_vector(docid));
+        }
+    }
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
+     * The input is either a full precision vector or a quantized query vector.
      */
-    HnswCandidate find_nearest_in_layer(const TypedCells& input, const HnswCandidate& entry_point, uint32_t level) const;
-    void search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
+    template <typename VectorType>
+    HnswCandidate find_nearest_in_layer(const VectorType& input, const HnswCandidate& entry_point, uint32_t level) const;
+    template <typename VectorType>
+    void search_layer(const VectorType& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
                       uint32_t level, const search::BitVector *filter = nullptr) const;
+    template <typename VectorType>
+    FurthestPriQ top_k_candidates_helper(const VectorType& vector, uint32_t k, const BitVector *filter) const;
+    FurthestPriQ rerank_with_full_precision(const TypedCells& vector, const FurthestPriQ& candidates) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
                                          const BitVector *filter, uint32_t explore_k) const;
 
@@ -146,10 +198,12 @@ protected:
     void internal_complete_add(uint32_t docid, PreparedAddDoc &op);
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-              RandomLevelGenerator::UP level_generator, const Config& cfg);
+              RandomLevelGenerator::UP level_generator, const Config& cfg,
+              std::unique_ptr<QuantizedVectorStore> quantized_vectors = {});
     ~HnswIndex() override;
 
     const Config& config() const { return _cfg; }
+    bool has_quantized_vectors() const { return bool(_quantized_vectors); }
 
     // Implements NearestNeighborIndex
     void add_document(uint32_t docid) override;
@@ -2,6 +2,7 @@
 
 #include "hnsw_index_loader.h"
 #include "hnsw_graph.h"
+#include "hnsw_index_saver.h"
 #include <vespa/searchlib/util/fileutil.h>
 
 namespace search::tensor {
@@ -19,6 +20,64 @@ HnswIndexLoader::load(const fileutil::LoadedBuffer& buf)
     size_t num_readable = buf.size(sizeof(uint32_t));
     _ptr = static_cast<const uint32_t *>(buf.buffer());
     _end = _ptr + num_readable;
+    if ((num_readable > 0) && (*_ptr == HnswIndexSaver::format_marker)) {
+        return load_sectioned();
+    }
+    return load_interleaved();
+}
+
+bool
+HnswIndexLoader::load_sectioned()
+{
+    if (size_t(_end - _ptr) < HnswIndexSaver::header_words) {
+        return false;
+    }
+    const uint32_t *header = _ptr;
+    if (header[1] != HnswIndexSaver::format_version) {
+        return false;
+    }
+    uint32_t entry_docid = header[2];
+    int32_t entry_level = header[3];
+    uint32_t num_nodes = header[4];
+    uint32_t num_link_arrays = header[5];
+    const uint32_t *levels = header + HnswIndexSaver::header_words;
+    // Validate all sections before touching the graph.
+    if (size_t(_end - levels) < (size_t(num_nodes) + num_link_arrays)) {
+        return false;
+    }
+    const uint32_t *link_counts = levels + num_nodes;
+    const uint32_t *links = link_counts + num_link_arrays;
+    size_t sum_levels = 0;
+    for (uint32_t docid = 0; docid < num_nodes; ++docid) {
+        sum_levels += levels[docid];
+    }
+    size_t sum_links = 0;
+    for (uint32_t i = 0; i < num_link_arrays; ++i) {
+        sum_links += link_counts[i];
+    }
+    if ((sum_levels != num_link_arrays) || (size_t(_end - links) != sum_links)) {
+        return false;
+    }
+    for (uint32_t docid = 0; docid < num_nodes; ++docid) {
+        uint32_t num_levels = levels[docid];
+        if (num_levels > 0) {
+            _graph.make_node_for_document(docid, num_levels);
+            for (uint32_t level = 0; level < num_levels; ++level) {
+                uint32_t num_links = *link_counts++;
+                _graph.set_link_array(docid, level, HnswGraph::LinkArrayRef(links, num_links));
+                links += num_links;
+            }
+        }
+    }
+    _graph.node_refs.ensure_size(num_nodes);
+    auto entry_node_ref = _graph.get_node_ref(entry_docid);
+    _graph.set_entry_node({entry_docid, entry_node_ref, entry_level});
+    return true;
+}
+
+bool
+HnswIndexLoader::load_interleaved()
+{
     uint32_t entry_docid = next_int();
     int32_t entry_level = next_int();
     uint32_t num_nodes = next_int();
@@ -12,6 +12,9 @@ struct HnswGraph;
 
 /**
  * Implements loading of HNSW graph structure from binary format.
+ *
+ * Both the sectioned format written by HnswIndexSaver and the old format,
+ * where the links of each node were interleaved with the counts, are supported.
  **/
 class HnswIndexLoader {
 public:
@@ -30,6 +33,8 @@ private:
         }
         return *_ptr++;
     }
+    bool load_sectioned();
+    bool load_interleaved();
 };
 
 }
@@ -33,22 +33,30 @@ HnswIndexSaver::HnswIndexSaver(const HnswGraph &graph)
 void
 HnswIndexSaver::save(BufferWriter& writer) const
 {
-    writer.write(&_meta_data.entry_docid, sizeof(uint32_t));
-    writer.write(&_meta_data.entry_level, sizeof(int32_t));
     uint32_t num_nodes = _meta_data.nodes.size();
-    writer.write(&num_nodes, sizeof(uint32_t));
+    uint32_t num_link_arrays = 0;
+    for (const auto &node : _meta_data.nodes) {
+        num_link_arrays += node.size();
+    }
+    uint32_t header[header_words] = { format_marker, format_version,
+                                      _meta_data.entry_docid, uint32_t(_meta_data.entry_level),
+                                      num_nodes, num_link_arrays };
+    writer.write(header, sizeof(header));
     for (const auto &node : _meta_data.nodes) {
         uint32_t num_levels = node.size();
         writer.write(&num_levels, sizeof(uint32_t));
+    }
+    for (const auto &node : _meta_data.nodes) {
+        for (auto links_ref : node) {
+            uint32_t num_links = links_ref.valid() ? _graph_links.get(links_ref).size() : 0;
+            writer.write(&num_links, sizeof(uint32_t));
+        }
+    }
+    for (const auto &node : _meta_data.nodes) {
         for (auto links_ref : node) {
             if (links_ref.valid()) {
                 vespalib::ConstArrayRef<uint32_t> link_array = _graph_links.get(links_ref);
-                uint32_t num_links = link_array.size();
-                writer.write(&num_links, sizeof(uint32_t));
-                writer.write(link_array.cbegin(), sizeof(uint32_t)*num_links);
-            } else {
-                uint32_t num_links = 0;
-                writer.write(&num_links, sizeof(uint32_t));
+                writer.write(link_array.cbegin(), sizeof(uint32_t)*link_array.size());
             }
         }
     }
@@ -14,11 +14,25 @@ namespace search::tensor {
  * The constructor takes a snapshot of all meta-data, but
  * the links will be fetched from the graph in the save()
  * method.
+ *
+ * The graph is saved in a sectioned format where all sections are arrays of uint32_t:
+ *   header:      format marker, format version, entry docid, entry level, num nodes, num link arrays
+ *   levels:      number of levels per node (num nodes entries)
+ *   link counts: number of links per link array (num link arrays entries)
+ *   links:       the docids of all link arrays, one after another
+ *
+ * This allows the loader to validate the entire file up front and then use the
+ * links directly from the memory mapped file, without decoding them one by one.
  **/
 class HnswIndexSaver : public NearestNeighborIndexSaver {
 public:
     using LevelVector = std::vector<vespalib::datastore::EntryRef>;
 
+    // The first word in the old format is the entry docid, which is never equal to the format marker.
+    static constexpr uint32_t format_marker = 0xffffffff;
+    static constexpr uint32_t format_version = 1;
+    static constexpr uint32_t header_words = 6;
+
     HnswIndexSaver(const HnswGraph &graph);
     ~HnswIndexSaver();
     void save(BufferWriter& writer) const override;
@@ -0,0 +1,25 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/typed_cells.h>
+#include <cstdint>
+
+namespace search::tensor {
+
+/**
+ * Interface that provides access to the vectors that are associated with the given document id,
+ * e.g. the dense subspaces of a mixed tensor like tensor(p{},x[384]).
+ *
+ * All vectors should be the same size and either of type float or double.
+ * Search threads can ask for vectors of a document that has just been removed or changed,
+ * so a vector should be returned for all vector indexes the document has had.
+ */
+class MultiVectorAccess {
+public:
+    virtual ~MultiVectorAccess() {}
+    virtual uint32_t get_num_vectors(uint32_t docid) const = 0;
+    virtual vespalib::eval::TypedCells get_vector(uint32_t docid, uint32_t vector_idx) const = 0;
+};
+
+}
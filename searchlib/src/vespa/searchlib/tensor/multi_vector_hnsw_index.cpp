@@ -0,0 +1,249 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "multi_vector_hnsw_index.h"
+#include "nearest_neighbor_index_saver.h"
+#include <vespa/searchlib/util/state_explorer_utils.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace search::tensor {
+
+namespace {
+
+const std::vector<uint32_t> no_nodeids;
+
+struct NeighborsByDocId {
+    bool operator() (const NearestNeighborIndex::Neighbor &lhs,
+                     const NearestNeighborIndex::Neighbor &rhs)
+    {
+        return (lhs.docid < rhs.docid);
+    }
+};
+
+struct NeighborsByDistance {
+    bool operator() (const NearestNeighborIndex::Neighbor &lhs,
+                     const NearestNeighborIndex::Neighbor &rhs)
+    {
+        return (lhs.distance < rhs.distance);
+    }
+};
+
+}
+
+vespalib::eval::TypedCells
+MultiVectorHnswIndex::NodeVectorAccess::get_vector(uint32_t nodeid) const
+{
+    const NodeInfo& info = _parent._nodes[nodeid];
+    return _parent._vectors.get_vector(info.docid, info.vector_idx);
+}
+
+MultiVectorHnswIndex::MultiVectorHnswIndex(const MultiVectorAccess& vectors, DistanceFunction::UP distance_func,
+                                           RandomLevelGenerator::UP level_generator, const HnswIndex::Config& cfg)
+    : _vectors(vectors),
+      _nodes(),
+      _doc_nodes(),
+      _free_nodeids(),
+      _removed_nodeids(),
+      _held_nodeids(),
+      _node_vectors(*this),
+      _index(std::make_unique<HnswIndex>(_node_vectors, std::move(distance_func), std::move(level_generator), cfg))
+{
+    // Node id 0 is reserved, as is docid 0 in HnswIndex.
+    _nodes.ensure_size(1, NodeInfo());
+}
+
+MultiVectorHnswIndex::~MultiVectorHnswIndex() = default;
+
+uint32_t
+MultiVectorHnswIndex::alloc_nodeid(uint32_t docid, uint32_t vector_idx)
+{
+    uint32_t nodeid;
+    if (_free_nodeids.empty()) {
+        nodeid = _nodes.size();
+        _nodes.ensure_size(nodeid + 1, NodeInfo());
+    } else {
+        nodeid = _free_nodeids.back();
+        _free_nodeids.pop_back();
+    }
+    // Written before the node is linked into the graph, which makes it visible to search threads.
+    _nodes[nodeid] = NodeInfo(docid, vector_idx);
+    return nodeid;
+}
+
+const std::vector<uint32_t>&
+MultiVectorHnswIndex::get_nodeids(uint32_t docid) const
+{
+    return (docid < _doc_nodes.size()) ? _doc_nodes[docid] : no_nodeids;
+}
+
+void
+MultiVectorHnswIndex::add_document(uint32_t docid)
+{
+    if (docid >= _doc_nodes.size()) {
+        _doc_nodes.resize(docid + 1);
+    }
+    auto& nodeids = _doc_nodes[docid];
+    assert(nodeids.empty());
+    uint32_t num_vectors = _vectors.get_num_vectors(docid);
+    for (uint32_t vector_idx = 0; vector_idx < num_vectors; ++vector_idx) {
+        uint32_t nodeid = alloc_nodeid(docid, vector_idx);
+        _index->add_document(nodeid);
+        nodeids.push_back(nodeid);
+    }
+}
+
+std::unique_ptr<PrepareResult>
+MultiVectorHnswIndex::prepare_add_document(uint32_t docid, TypedCells vector,
+                                           vespalib::GenerationHandler::Guard read_guard) const
+{
+    (void) docid;
+    (void) vector;
+    (void) read_guard;
+    return std::unique_ptr<PrepareResult>();
+}
+
+void
+MultiVectorHnswIndex::complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result)
+{
+    (void) prepare_result;
+    add_document(docid);
+}
+
+void
+MultiVectorHnswIndex::remove_document(uint32_t docid)
+{
+    if (docid >= _doc_nodes.size()) {
+        return;
+    }
+    for (uint32_t nodeid : _doc_nodes[docid]) {
+        _index->remove_document(nodeid);
+        _removed_nodeids.push_back(nodeid);
+    }
+    std::vector<uint32_t>().swap(_doc_nodes[docid]);
+}
+
+void
+MultiVectorHnswIndex::transfer_hold_lists(generation_t current_gen)
+{
+    _index->transfer_hold_lists(current_gen);
+    _nodes.setGeneration(current_gen + 1);
+    for (uint32_t nodeid : _removed_nodeids) {
+        _held_nodeids.emplace_back(current_gen, nodeid);
+    }
+    _removed_nodeids.clear();
+}
+
+void
+MultiVectorHnswIndex::trim_hold_lists(generation_t first_used_gen)
+{
+    _index->trim_hold_lists(first_used_gen);
+    _nodes.removeOldGenerations(first_used_gen);
+    while (!_held_nodeids.empty() && (_held_nodeids.front().first < first_used_gen)) {
+        _free_nodeids.push_back(_held_nodeids.front().second);
+        _held_nodeids.pop_front();
+    }
+}
+
+vespalib::MemoryUsage
+MultiVectorHnswIndex::memory_usage() const
+{
+    vespalib::MemoryUsage result = _index->memory_usage();
+    result.merge(_nodes.getMemoryUsage());
+    size_t doc_nodes_bytes = _doc_nodes.capacity() * sizeof(std::vector<uint32_t>);
+    for (const auto& nodeids : _doc_nodes) {
+        doc_nodes_bytes += nodeids.capacity() * sizeof(uint32_t);
+    }
+    result.incAllocatedBytes(doc_nodes_bytes);
+    result.incUsedBytes(doc_nodes_bytes);
+    return result;
+}
+
+void
+MultiVectorHnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
+{
+    auto& object = inserter.insertObject();
+    StateExplorerUtils::memory_usage_to_slime(memory_usage(), object.setObject("memory_usage"));
+    object.setLong("node_ids", _nodes.size());
+    object.setLong("free_node_ids", _free_nodeids.size());
+    object.setLong("held_node_ids", _held_nodeids.size() + _removed_nodeids.size());
+    vespalib::slime::ObjectInserter index_inserter(object, "index");
+    _index->get_state(index_inserter);
+}
+
+std::unique_ptr<NearestNeighborIndexSaver>
+MultiVectorHnswIndex::make_saver() const
+{
+    return std::unique_ptr<NearestNeighborIndexSaver>();
+}
+
+bool
+MultiVectorHnswIndex::load(const fileutil::LoadedBuffer& buf)
+{
+    (void) buf;
+    return false;
+}
+
+std::unique_ptr<BitVector>
+MultiVectorHnswIndex::make_node_filter(const BitVector& filter) const
+{
+    uint32_t node_limit = _nodes.size();
+    auto result = BitVector::create(node_limit);
+    for (uint32_t nodeid = 1; nodeid < node_limit; ++nodeid) {
+        uint32_t docid = _nodes[nodeid].docid;
+        if ((docid < filter.size()) && filter.testBit(docid)) {
+            result->setBit(nodeid);
+        }
+    }
+    result->invalidateCachedCount();
+    return result;
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+MultiVectorHnswIndex::top_k_by_docid(uint32_t k, TypedCells vector,
+                                     const BitVector *filter, uint32_t explore_k) const
+{
+    std::unique_ptr<BitVector> node_filter;
+    if (filter != nullptr) {
+        node_filter = make_node_filter(*filter);
+    }
+    FurthestPriQ candidates = _index->top_k_candidates(vector, std::max(k, explore_k), node_filter.get());
+    // Several nodes can belong to the same document, which is represented by its best distance.
+    std::vector<Neighbor> hits;
+    hits.reserve(candidates.size());
+    for (const HnswCandidate & hit : candidates.peek()) {
+        hits.emplace_back(_nodes[hit.docid].docid, hit.distance);
+    }
+    std::sort(hits.begin(), hits.end(), NeighborsByDocId());
+    std::vector<Neighbor> result;
+    for (const Neighbor & hit : hits) {
+        if (!result.empty() && (result.back().docid == hit.docid)) {
+            result.back().distance = std::min(result.back().distance, hit.distance);
+        } else {
+            result.push_back(hit);
+        }
+    }
+    if (result.size() > k) {
+        std::nth_element(result.begin(), result.begin() + k, result.end(), NeighborsByDistance());
+        result.resize(k);
+    }
+    std::sort(result.begin(), result.end(), NeighborsByDocId());
+    return result;
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+MultiVectorHnswIndex::find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k) const
+{
+    return top_k_by_docid(k, vector, nullptr, explore_k);
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+MultiVectorHnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
+                                             const BitVector &filter, uint32_t explore_k) const
+{
+    return top_k_by_docid(k, vector, &filter, explore_k);
+}
+
+}
@@ -0,0 +1,90 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "doc_vector_access.h"
+#include "hnsw_index.h"
+#include "multi_vector_access.h"
+#include "nearest_neighbor_index.h"
+#include <vespa/vespalib/util/rcuvector.h>
+#include <deque>
+
+namespace search::tensor {
+
+/**
+ * Nearest neighbor index for documents with multiple vectors each, built on top of an HnswIndex.
+ *
+ * Each vector of a document is a separate node in the HNSW graph, identified by a node id.
+ * A node id to document id mapping is used to return the best distance per document when searching.
+ * Node ids of removed documents are put on hold until no search thread can use them before they are reused.
+ *
+ * The index is not saved, but rebuilt from the vectors when the attribute is loaded.
+ */
+class MultiVectorHnswIndex : public NearestNeighborIndex {
+private:
+    using TypedCells = vespalib::eval::TypedCells;
+
+    struct NodeInfo {
+        uint32_t docid;
+        uint32_t vector_idx;
+        NodeInfo() noexcept : docid(0), vector_idx(0) {}
+        NodeInfo(uint32_t docid_in, uint32_t vector_idx_in) noexcept : docid(docid_in), vector_idx(vector_idx_in) {}
+    };
+
+    /**
+     * Provides the vector of a node to the underlying HnswIndex.
+     */
+    class NodeVectorAccess : public DocVectorAccess {
+        const MultiVectorHnswIndex& _parent;
+    public:
+        NodeVectorAccess(const MultiVectorHnswIndex& parent) : _parent(parent) {}
+        vespalib::eval::TypedCells get_vector(uint32_t nodeid) const override;
+    };
+
+    const MultiVectorAccess& _vectors;
+    vespalib::RcuVector<NodeInfo> _nodes;                  // node id -> (docid, vector index), read by search threads
+    std::vector<std::vector<uint32_t>> _doc_nodes;         // docid -> node ids, only used by the writer thread
+    std::vector<uint32_t> _free_nodeids;
+    std::vector<uint32_t> _removed_nodeids;
+    std::deque<std::pair<generation_t, uint32_t>> _held_nodeids;
+    NodeVectorAccess _node_vectors;
+    std::unique_ptr<HnswIndex> _index;
+
+    uint32_t alloc_nodeid(uint32_t docid, uint32_t vector_idx);
+    std::unique_ptr<BitVector> make_node_filter(const BitVector& filter) const;
+    std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector, const BitVector *filter, uint32_t explore_k) const;
+
+public:
+    MultiVectorHnswIndex(const MultiVectorAccess& vectors, DistanceFunction::UP distance_func,
+                         RandomLevelGenerator::UP level_generator, const HnswIndex::Config& cfg);
+    ~MultiVectorHnswIndex() override;
+
+    const HnswIndex& index() const { return *_index; }
+    const std::vector<uint32_t>& get_nodeids(uint32_t docid) const;
+
+    // Implements NearestNeighborIndex
+    void add_document(uint32_t docid) override;
+    /**
+     * The costly part of adding a document is done by complete_add_document(),
+     * as the given vector is just one of the vectors of the document.
+     */
+    std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid,
+            TypedCells vector,
+            vespalib::GenerationHandler::Guard read_guard) const override;
+    void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    void remove_document(uint32_t docid) override;
+    void transfer_hold_lists(generation_t current_gen) override;
+    void trim_hold_lists(generation_t first_used_gen) override;
+    vespalib::MemoryUsage memory_usage() const override;
+    void get_state(const vespalib::slime::Inserter& inserter) const override;
+
+    std::unique_ptr<NearestNeighborIndexSaver> make_saver() const override;
+    bool load(const fileutil::LoadedBuffer& buf) override;
+
+    std::vector<Neighbor> find_top_k(uint32_t k, TypedCells vector, uint32_t explore_k) const override;
+    std::vector<Neighbor> find_top_k_with_filter(uint32_t k, TypedCells vector,
+                                                 const BitVector &filter, uint32_t explore_k) const override;
+    const DistanceFunction *distance_function() const override { return _index->distance_function(); }
+};
+
+}
@@ -0,0 +1,164 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+using search::attribute::DistanceMetric;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+
+namespace search::tensor {
+
+namespace {
+
+constexpr int32_t max_code = 127;
+// Ensures that the squared norm of a code vector fits in an int32_t.
+constexpr size_t max_vector_size = std::numeric_limits<int32_t>::max() / (max_code * max_code);
+
+template <typename FloatType>
+QuantizedVectorStore::VectorParams
+quantize_cells(vespalib::ConstArrayRef<FloatType> cells, int8_t *codes)
+{
+    double max_abs = 0.0;
+    for (FloatType cell : cells) {
+        max_abs = std::max(max_abs, std::abs(double(cell)));
+    }
+    double scale = (max_abs > 0.0) ? (max_abs / max_code) : 1.0;
+    int32_t sq_norm = 0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        int32_t code = std::lround(cells[i] / scale);
+        code = std::clamp(code, -max_code, max_code);
+        codes[i] = code;
+        sq_norm += code * code;
+    }
+    return {float(scale), sq_norm};
+}
+
+}
+
+QuantizedVectorStore::QuantizedVectorStore(DistanceMetric distance_metric, size_t vector_size)
+    : _distance_metric(distance_metric),
+      _vector_size(vector_size),
+      _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator()),
+      _codes(),
+      _params()
+{
+    assert(supports(distance_metric));
+    assert(vector_size <= max_vector_size);
+}
+
+QuantizedVectorStore::~QuantizedVectorStore() = default;
+
+bool
+QuantizedVectorStore::supports(DistanceMetric distance_metric)
+{
+    switch (distance_metric) {
+        case DistanceMetric::Euclidean:
+        case DistanceMetric::Angular:
+        case DistanceMetric::InnerProduct:
+            return true;
+        default:
+            return false;
+    }
+}
+
+QuantizedVectorStore::VectorParams
+QuantizedVectorStore::quantize(const TypedCells &vector, int8_t *codes) const
+{
+    assert(vector.size == _vector_size);
+    switch (vector.type) {
+    case ValueType::CellType::DOUBLE:   return quantize_cells(vector.typify<double>(), codes);
+    case ValueType::CellType::FLOAT:    return quantize_cells(vector.typify<float>(), codes);
+    case ValueType::CellType::BFLOAT16: return quantize_cells(vector.typify<vespalib::BFloat16>(), codes);
+    case ValueType::CellType::INT8:     return quantize_cells(vector.typify<int8_t>(), codes);
+    }
+    abort();
+}
+
+void
+QuantizedVectorStore::set(uint32_t docid, const TypedCells &vector)
+{
+    _codes.ensure_size((docid + 1) * _vector_size);
+    _params.ensure_size(docid + 1);
+    _params[docid] = quantize(vector, &_codes[docid * _vector_size]);
+}
+
+QuantizedVectorStore::QueryVector
+QuantizedVectorStore::make_query_vector(const TypedCells &vector) const
+{
+    QueryVector result;
+    result._codes.resize(_vector_size);
+    result._params = quantize(vector, result._codes.data());
+    return result;
+}
+
+double
+QuantizedVectorStore::calc_distance(const int8_t *lhs_codes, const VectorParams &lhs_params,
+                                    const int8_t *rhs_codes, const VectorParams &rhs_params) const
+{
+    double dot = _computer.dotProduct(lhs_codes, rhs_codes, _vector_size);
+    switch (_distance_metric) {
+        case DistanceMetric::Euclidean: {
+            double lhs_sq_norm = double(lhs_params.sq_norm) * lhs_params.scale * lhs_params.scale;
+            double rhs_sq_norm = double(rhs_params.sq_norm) * rhs_params.scale * rhs_params.scale;
+            double distance = lhs_sq_norm + rhs_sq_norm - 2.0 * lhs_params.scale * rhs_params.scale * dot;
+            return std::max(0.0, distance);
+        }
+        case DistanceMetric::Angular: {
+            double squared_norms = double(lhs_params.sq_norm) * double(rhs_params.sq_norm);
+            double div = (squared_norms > 0) ? std::sqrt(squared_norms) : 1.0;
+            return 1.0 - (dot / div);
+        }
+        case DistanceMetric::InnerProduct: {
+            double score = 1.0 - lhs_params.scale * rhs_params.scale * dot;
+            return std::max(0.0, score);
+        }
+        default:
+            abort();
+    }
+}
+
+double
+QuantizedVectorStore::calc_distance(const QueryVector &lhs, uint32_t rhs_docid) const
+{
+    return calc_distance(lhs._codes.data(), lhs._params,
+                         &_codes[rhs_docid * _vector_size], _params[rhs_docid]);
+}
+
+void
+QuantizedVectorStore::transfer_hold_lists(generation_t current_gen)
+{
+    // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+    _codes.setGeneration(current_gen + 1);
+    _params.setGeneration(current_gen + 1);
+}
+
+void
+QuantizedVectorStore::trim_hold_lists(generation_t first_used_gen)
+{
+    _codes.removeOldGenerations(first_used_gen);
+    _params.removeOldGenerations(first_used_gen);
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::memory_usage() const
+{
+    vespalib::MemoryUsage result;
+    result.merge(_codes.getMemoryUsage());
+    result.merge(_params.getMemoryUsage());
+    return result;
+}
+
+}
+
+namespace vespalib {
+
+template class RcuVectorBase<search::tensor::QuantizedVectorStore::VectorParams>;
+template class RcuVector<search::tensor::QuantizedVectorStore::VectorParams>;
+
+}
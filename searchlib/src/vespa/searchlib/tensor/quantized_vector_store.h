@@ -0,0 +1,86 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <cstdint>
+#include <vector>
+
+namespace search::tensor {
+
+/**
+ * Stores an int8 scalar quantized shadow copy of the vectors indexed by a HnswIndex.
+ *
+ * Each vector is stored as one int8 code per cell together with a per vector scale factor and
+ * the squared norm of the codes. The codes are used to calculate approximate distances
+ * while exploring the graph, which reads 1 byte per cell instead of 4 (float) or 8 (double).
+ * The final candidates are re-ranked using the full precision vectors.
+ *
+ * Supports the distance metrics that can be expressed via a dot product of the codes
+ * (euclidean, angular and inner product).
+ *
+ * Supports 1 write thread and multiple search threads, using generation tracking for memory management.
+ * Codes for a document are written before the document is linked into the graph.
+ */
+class QuantizedVectorStore {
+public:
+    struct VectorParams {
+        float   scale;
+        int32_t sq_norm;
+        VectorParams() noexcept : scale(0.0), sq_norm(0) {}
+        VectorParams(float scale_in, int32_t sq_norm_in) noexcept : scale(scale_in), sq_norm(sq_norm_in) {}
+    };
+
+    /**
+     * A quantized query vector, created once per query.
+     */
+    class QueryVector {
+    private:
+        std::vector<int8_t> _codes;
+        VectorParams _params;
+        friend class QuantizedVectorStore;
+    public:
+        QueryVector() : _codes(), _params() {}
+        const std::vector<int8_t> &codes() const { return _codes; }
+        const VectorParams &params() const { return _params; }
+    };
+
+private:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    search::attribute::DistanceMetric _distance_metric;
+    size_t                            _vector_size;
+    const vespalib::hwaccelrated::IAccelrated & _computer;
+    vespalib::RcuVector<int8_t>       _codes;
+    vespalib::RcuVector<VectorParams> _params;
+
+    VectorParams quantize(const vespalib::eval::TypedCells &vector, int8_t *codes) const;
+    double calc_distance(const int8_t *lhs_codes, const VectorParams &lhs_params,
+                         const int8_t *rhs_codes, const VectorParams &rhs_params) const;
+
+public:
+    QuantizedVectorStore(search::attribute::DistanceMetric distance_metric, size_t vector_size);
+    ~QuantizedVectorStore();
+
+    static bool supports(search::attribute::DistanceMetric distance_metric);
+
+    size_t vector_size() const { return _vector_size; }
+    void set(uint32_t docid, const vespalib::eval::TypedCells &vector);
+    QueryVector make_query_vector(const vespalib::eval::TypedCells &vector) const;
+
+    /**
+     * Calculates the approximate distance between the given query vector and the vector for the given docid.
+     * The result has the same scale as the distance function for the full precision vectors.
+     */
+    double calc_distance(const QueryVector &lhs, uint32_t rhs_docid) const;
+
+    void transfer_hold_lists(generation_t current_gen);
+    void trim_hold_lists(generation_t first_used_gen);
+    vespalib::MemoryUsage memory_usage() const;
+};
+
+}
@@ -270,6 +270,15 @@ TensorAttribute::complete_set_tensor(DocId docid, const vespalib::eval::Value& t
     (void) prepare_result;
 }
 
+bool
+TensorAttribute::modify_tensor(DocId docid, join_fun_t function, const vespalib::eval::Value& modifier)
+{
+    (void) docid;
+    (void) function;
+    (void) modifier;
+    return false;
+}
+
 IMPLEMENT_IDENTIFIABLE_ABSTRACT(TensorAttribute, AttributeVector);
 
 }
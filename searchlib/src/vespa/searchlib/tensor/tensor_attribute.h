@@ -36,6 +36,7 @@ protected:
 public:
     DECLARE_IDENTIFIABLE_ABSTRACT(TensorAttribute);
     using RefCopyVector = vespalib::Array<EntryRef>;
+    using join_fun_t = double (*)(double, double);
     TensorAttribute(vespalib::stringref name, const Config &cfg, TensorStore &tensorStore);
     ~TensorAttribute() override;
     const ITensorAttribute *asTensorAttribute() const override;
@@ -75,6 +76,16 @@ public:
      */
     virtual void complete_set_tensor(DocId docid, const vespalib::eval::Value& tensor, std::unique_ptr<PrepareResult> prepare_result);
 
+    /**
+     * Applies function(old cell, modifier cell) to the cells of the tensor for a document
+     * that are addressed by the sparse modifier tensor, without building a new tensor first.
+     *
+     * This function is only called by the attribute writer thread.
+     * Returns false if this is not supported for the attribute, modifier or document,
+     * in which case the caller should fall back to getTensor() and setTensor().
+     */
+    virtual bool modify_tensor(DocId docid, join_fun_t function, const vespalib::eval::Value& modifier);
+
     virtual void compactWorst() = 0;
 };
 
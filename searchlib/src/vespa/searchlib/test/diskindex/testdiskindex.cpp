@@ -119,7 +119,8 @@ TestDiskIndex::buildIndex(const std::string & dir, bool directio,
 
 void
 TestDiskIndex::openIndex(const std::string &dir, bool directio, bool readmmap,
-                bool fieldEmpty, bool docEmpty, bool wordEmpty)
+                bool fieldEmpty, bool docEmpty, bool wordEmpty,
+                size_t postingListCacheSize)
 {
     buildIndex(dir, directio, fieldEmpty, docEmpty, wordEmpty);
     TuneFileRandRead    tuneFileRead;
@@ -129,7 +130,7 @@ TestDiskIndex::openIndex(const std::string &dir, bool directio, bool readmmap,
     if (readmmap) {
         tuneFileRead.setWantMemoryMap();
     }
-    _index = std::make_unique<DiskIndex>(dir);
+    _index = std::make_unique<DiskIndex>(dir, 0, postingListCacheSize);
     bool ok(_index->setup(tuneFileRead));
     assert(ok);
     (void) ok;
@@ -20,7 +20,8 @@ public:
     DiskIndex & getIndex() { return *_index; }
     void buildSchema();
     void openIndex(const std::string &dir, bool directio, bool readmmap,
-                   bool fieldEmpty, bool docEmpty, bool wordEmpty);
+                   bool fieldEmpty, bool docEmpty, bool wordEmpty,
+                   size_t postingListCacheSize = 0);
 };
 
 }
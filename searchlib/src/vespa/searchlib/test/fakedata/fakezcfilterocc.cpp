@@ -172,6 +172,7 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_max", _posting_params._encode_block_max);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -796,6 +797,17 @@ public:
     }
 };
 
+template <bool bigEndian>
+class FakeZc4SkipPosOccCfBm : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc4SkipPosOccCfBm(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true),
+                                       (bigEndian ? ".zc4skipposoccbe.cf.bm" : ".zc4skipposoccle.cf.bm"))
+    {
+    }
+};
+
 class FakeZc4SkipPosOccCfNoNormalUnpack : public FakeZc4SkipPosOcc<true>
 {
 public:
@@ -910,6 +922,15 @@ static FPFactoryInit
 initSkipPos0lecf(std::make_pair("Zc4SkipPosOccLE.cf",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCf<false> > >));
 
+static FPFactoryInit
+initSkipPos0becfbm(std::make_pair("Zc4SkipPosOccBE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBm<true> > >));
+
+
+static FPFactoryInit
+initSkipPos0lecfbm(std::make_pair("Zc4SkipPosOccLE.cf.bm",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBm<false> > >));
+
 static FPFactoryInit
 initSkipPos0becfnnu(std::make_pair("Zc4SkipPosOccBE.cf.nnu",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfNoNormalUnpack > >));
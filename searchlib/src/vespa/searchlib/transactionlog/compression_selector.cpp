@@ -0,0 +1,76 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compression_selector.h"
+
+namespace search::transactionlog {
+
+namespace {
+
+// Weight of a new sample in the moving average of compression ratios.
+constexpr double SAMPLE_WEIGHT = 0.1;
+
+}
+
+void
+CompressionSelector::Observation::add(double sample) {
+    ratio = valid ? (ratio * (1.0 - SAMPLE_WEIGHT) + sample * SAMPLE_WEIGHT) : sample;
+    valid = true;
+}
+
+CompressionSelector::CompressionSelector(size_t bulkBatchSize, double minZstdGain)
+    : _bulkBatchSize(bulkBatchSize),
+      _minZstdGain(minZstdGain),
+      _numBulkBatches(0),
+      _lz4(),
+      _zstd()
+{ }
+
+Encoding::Compression
+CompressionSelector::chooseForBulk() const {
+    if ( ! _zstd.valid) {
+        return Encoding::Compression::zstd;
+    }
+    if ( ! _lz4.valid) {
+        return Encoding::Compression::lz4;
+    }
+    return (_zstd.ratio <= _lz4.ratio * (1.0 - _minZstdGain))
+           ? Encoding::Compression::zstd
+           : Encoding::Compression::lz4;
+}
+
+Encoding::Compression
+CompressionSelector::select(size_t batchBytes) {
+    if (batchBytes < _bulkBatchSize) {
+        return Encoding::Compression::lz4;
+    }
+    Encoding::Compression chosen = chooseForBulk();
+    if ((++_numBulkBatches % PROBE_INTERVAL) == 0) {
+        return (chosen == Encoding::Compression::zstd) ? Encoding::Compression::lz4 : Encoding::Compression::zstd;
+    }
+    return chosen;
+}
+
+void
+CompressionSelector::observe(Encoding::Compression compression, size_t uncompressedBytes, size_t compressedBytes) {
+    if (uncompressedBytes == 0) {
+        return;
+    }
+    double sample = double(compressedBytes) / uncompressedBytes;
+    if (compression == Encoding::Compression::lz4) {
+        _lz4.add(sample);
+    } else if (compression == Encoding::Compression::zstd) {
+        _zstd.add(sample);
+    }
+}
+
+double
+CompressionSelector::getRatio(Encoding::Compression compression) const {
+    if (compression == Encoding::Compression::lz4) {
+        return _lz4.ratio;
+    } else if (compression == Encoding::Compression::zstd) {
+        return _zstd.ratio;
+    }
+    return 1.0;
+}
+
+}
@@ -0,0 +1,46 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "ichunk.h"
+
+namespace search::transactionlog {
+
+/**
+ * Chooses the compression of each batch written to a domain when adaptive compression is enabled.
+ *
+ * With group commit the batch size follows the feed rate. Small batches come from a lightly loaded
+ * feed where write latency matters, and are compressed with LZ4. Large batches come from bulk feed
+ * where disk bandwidth is the bottleneck, and are compressed with ZSTD as long as ZSTD has been
+ * observed to produce enough less data than LZ4 to pay for being slower. Every PROBE_INTERVAL'th
+ * large batch is compressed with the codec not chosen to keep both observations up to date.
+ *
+ * Not thread safe, it is used by the single committer thread of a domain.
+ */
+class CompressionSelector {
+public:
+    static constexpr uint32_t PROBE_INTERVAL = 16;
+    CompressionSelector(size_t bulkBatchSize, double minZstdGain);
+    Encoding::Compression select(size_t batchBytes);
+    /**
+     * Records the outcome of compressing a batch with the given compression.
+     */
+    void observe(Encoding::Compression compression, size_t uncompressedBytes, size_t compressedBytes);
+    /// The observed average ratio of compressed to uncompressed size, or 1.0 if not observed yet.
+    double getRatio(Encoding::Compression compression) const;
+private:
+    struct Observation {
+        double ratio;
+        bool   valid;
+        Observation() : ratio(1.0), valid(false) { }
+        void add(double sample);
+    };
+    Encoding::Compression chooseForBulk() const;
+
+    size_t      _bulkBatchSize;
+    double      _minZstdGain;
+    uint32_t    _numBulkBatches;
+    Observation _lz4;
+    Observation _zstd;
+};
+
+}
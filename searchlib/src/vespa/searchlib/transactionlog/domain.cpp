@@ -1,12 +1,14 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "domain.h"
+#include "compression_selector.h"
 #include "domainpart.h"
 #include "session.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/ring_tracer.h>
 #include <vespa/fastos/file.h>
 #include <algorithm>
 #include <thread>
@@ -28,11 +30,37 @@ using std::make_shared;
 namespace search::transactionlog {
 namespace {
 
+RT_Tag commit_tag("transactionlog.commit");
+
 std::unique_ptr<CommitChunk>
 createCommitChunk(const DomainConfig &cfg) {
     return std::make_unique<CommitChunk>(cfg.getChunkSizeLimit(), cfg.getChunkSizeLimit()/256);
 }
 
+bool
+useAdaptiveCompression(const DomainConfig &cfg) {
+    Encoding encoding = cfg.getEncoding();
+    return cfg.getAdaptiveCompression() &&
+           (encoding.getCrc() == Encoding::Crc::xxh64) &&
+           ((encoding.getCompression() == Encoding::Compression::lz4) ||
+            (encoding.getCompression() == Encoding::Compression::zstd));
+}
+
+const char *
+getCompressionName(Encoding::Compression compression) {
+    switch (compression) {
+    case Encoding::Compression::none:
+        return "none";
+    case Encoding::Compression::none_multi:
+        return "none_multi";
+    case Encoding::Compression::lz4:
+        return "lz4";
+    case Encoding::Compression::zstd:
+        return "zstd";
+    }
+    return "unknown";
+}
+
 }
 
 Domain::Domain(const string &domainName, const string & baseDir, Executor & executor,
@@ -41,6 +69,13 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & exec
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, 128 * 1024)),
+      _singleSyncer(std::make_unique<vespalib::ThreadStackExecutor>(1, 128 * 1024)),
+      _pendingCommitSyncLock(),
+      _pendingCommitSync(),
+      _commitSyncScheduled(false),
+      _commitStatsLock(),
+      _commitStats(),
+      _compressionSelector(),
       _executor(executor),
       _sessionId(1),
       _syncMonitor(),
@@ -115,6 +150,7 @@ Domain::~Domain() {
     _currentChunkCond.notify_all();
     commitChunk(grabCurrentChunk(guard), guard);
     _singleCommitter->shutdown().sync();
+    _singleSyncer->shutdown().sync();
 }
 
 DomainInfo
@@ -126,6 +162,8 @@ Domain::getDomainInfo() const
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
     }
+    std::lock_guard statsGuard(_commitStatsLock);
+    info.commitStats = _commitStats;
     return info;
 }
 
@@ -385,20 +423,87 @@ void
 Domain::doCommit(std::unique_ptr<CommitChunk> chunk) {
     const Packet & packet = chunk->getPacket();
     if (packet.empty()) return;
-    
+    RT_Sample sample(commit_tag);
+
     vespalib::nbostream_longlivedbuf is(packet.getHandle().data(), packet.getHandle().size());
     Packet::Entry entry;
     entry.deserialize(is);
     DomainPart::SP dp = optionallyRotateFile(entry.serial());
-    dp->commit(entry.serial(), packet);
-    if (_config.getFSyncOnCommit()) {
-        dp->sync();
+    Encoding encoding = selectEncoding(packet);
+    size_t bytesBefore = dp->byteSize();
+    dp->commit(entry.serial(), packet, encoding);
+    size_t bytesWritten = dp->byteSize() - bytesBefore;
+    if (_compressionSelector) {
+        _compressionSelector->observe(encoding.getCompression(), packet.sizeBytes(), bytesWritten);
+    }
+    {
+        std::lock_guard guard(_commitStatsLock);
+        _commitStats.batchEntries.add(packet.size());
+        _commitStats.batchBytes.add(packet.sizeBytes());
+        _commitStats.compression[getCompressionName(encoding.getCompression())].add(packet.sizeBytes(), bytesWritten);
     }
     cleanSessions();
+    if (_config.getFSyncOnCommit()) {
+        syncCommitted(std::move(dp), std::move(chunk));
+        return;
+    }
     LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
         chunk->getNumCallBacks(), chunk->getPacket().size(), chunk->sizeBytes());
 }
 
+Encoding
+Domain::selectEncoding(const Packet & packet) {
+    if ( ! useAdaptiveCompression(_config)) {
+        _compressionSelector.reset();
+        return _config.getEncoding();
+    }
+    if ( ! _compressionSelector) {
+        _compressionSelector = std::make_unique<CompressionSelector>(_config.getBulkBatchSize(), _config.getMinZstdGain());
+    }
+    return Encoding(_config.getEncoding().getCrc(), _compressionSelector->select(packet.sizeBytes()));
+}
+
+void
+Domain::syncCommitted(DomainPartSP dp, std::unique_ptr<CommitChunk> chunk) {
+    // The next batch is written while the previous ones are synced, and acked when a later sync covers it.
+    std::lock_guard guard(_pendingCommitSyncLock);
+    _pendingCommitSync.emplace_back(std::move(dp), std::move(chunk));
+    if ( ! _commitSyncScheduled) {
+        _commitSyncScheduled = true;
+        _singleSyncer->execute(makeLambdaTask([this]() { doSyncCommitted(); }));
+    }
+}
+
+void
+Domain::doSyncCommitted() {
+    for (;;) {
+        PendingSyncList pending;
+        {
+            std::lock_guard guard(_pendingCommitSyncLock);
+            if (_pendingCommitSync.empty()) {
+                _commitSyncScheduled = false;
+                return;
+            }
+            pending.swap(_pendingCommitSync);
+        }
+        vespalib::Timer timer;
+        const DomainPart * synced = nullptr;
+        for (const auto & entry : pending) {
+            // Consecutive batches written to the same part are covered by a single sync.
+            if (entry.first.get() != synced) {
+                entry.first->sync();
+                synced = entry.first.get();
+            }
+        }
+        {
+            std::lock_guard guard(_commitStatsLock);
+            _commitStats.syncBatches.add(pending.size());
+            _commitStats.syncLatencyUs.add(vespalib::count_us(timer.elapsed()));
+        }
+        LOG(debug, "Synced %zu batches, releasing their acks.", pending.size());
+    }
+}
+
 bool
 Domain::erase(SerialNum to)
 {
@@ -10,6 +10,7 @@
 namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
 
+class CompressionSelector;
 class DomainPart;
 class Session;
 
@@ -65,6 +66,9 @@ private:
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
     void doCommit(std::unique_ptr<CommitChunk> chunk);
+    void syncCommitted(DomainPartSP dp, std::unique_ptr<CommitChunk> chunk);
+    void doSyncCommitted();
+    Encoding selectEncoding(const Packet & packet);
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -81,11 +85,20 @@ private:
     using SessionList = std::map<int, std::shared_ptr<Session>>;
     using DomainPartList = std::map<SerialNum, DomainPartSP>;
     using DurationSeconds = std::chrono::duration<double>;
+    using PendingSyncList = std::vector<std::pair<DomainPartSP, std::unique_ptr<CommitChunk>>>;
 
     DomainConfig                 _config;
     std::unique_ptr<CommitChunk> _currentChunk;
     SerialNum                    _lastSerial;
     std::unique_ptr<Executor>    _singleCommitter;
+    std::unique_ptr<Executor>    _singleSyncer;
+    std::mutex                   _pendingCommitSyncLock;
+    PendingSyncList              _pendingCommitSync;
+    bool                         _commitSyncScheduled;
+    mutable std::mutex           _commitStatsLock;
+    CommitStats                  _commitStats;
+    // Only used by the committer thread
+    std::unique_ptr<CompressionSelector> _compressionSelector;
     Executor                    &_executor;
     std::atomic<int>             _sessionId;
     std::mutex                   _syncMonitor;
@@ -1,6 +1,8 @@
 // Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "domainconfig.h"
+#include <algorithm>
+#include <limits>
 
 namespace search::transactionlog {
 
@@ -8,8 +10,44 @@ DomainConfig::DomainConfig()
     : _encoding(Encoding::Crc::xxh64, Encoding::Compression::none),
       _compressionLevel(9),
       _fSyncOnCommit(false),
+      _adaptiveCompression(false),
       _partSizeLimit(0x10000000), // 256M
-      _chunkSizeLimit(0x40000)   // 256k
+      _chunkSizeLimit(0x40000),   // 256k
+      _bulkBatchSize(0x20000),    // 128k
+      _minZstdGain(0.1)
+{ }
+
+Log2Histogram::Log2Histogram()
+    : _buckets(),
+      _count(0),
+      _sum(0),
+      _max(0)
+{ }
+
+size_t
+Log2Histogram::bucketOf(uint64_t value) {
+    return (value == 0) ? 0 : (64 - __builtin_clzl(value));
+}
+
+uint64_t
+Log2Histogram::bucketLimit(size_t bucket) {
+    return (bucket < 64) ? (uint64_t(1) << bucket) : std::numeric_limits<uint64_t>::max();
+}
+
+void
+Log2Histogram::add(uint64_t value) {
+    _buckets[bucketOf(value)]++;
+    _count++;
+    _sum += value;
+    _max = std::max(_max, value);
+}
+
+CommitStats::CommitStats()
+    : batchEntries(),
+      batchBytes(),
+      syncBatches(),
+      syncLatencyUs(),
+      compression()
 { }
 
 }
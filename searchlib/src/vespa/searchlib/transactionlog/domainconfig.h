@@ -3,6 +3,7 @@
 
 #include "ichunk.h"
 #include <vespa/vespalib/util/time.h>
+#include <array>
 #include <map>
 
 namespace search::transactionlog {
@@ -16,17 +17,27 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setAdaptiveCompression(bool v)   { _adaptiveCompression = v; return *this; }
+    DomainConfig & setBulkBatchSize(size_t v)       { _bulkBatchSize = v; return *this; }
+    DomainConfig & setMinZstdGain(double v)         { _minZstdGain = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    /// Choose between LZ4 and ZSTD per batch, see CompressionSelector. Only used with compressing encodings.
+    bool   getAdaptiveCompression() const { return _adaptiveCompression; }
+    size_t       getBulkBatchSize() const { return _bulkBatchSize; }
+    double         getMinZstdGain() const { return _minZstdGain; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
+    bool         _adaptiveCompression;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
+    size_t       _bulkBatchSize;
+    double       _minZstdGain;
 };
 
 struct PartInfo {
@@ -42,6 +53,59 @@ struct PartInfo {
     {}
 };
 
+/**
+ * Histogram of samples in buckets of power of two sizes. Bucket 0 counts zeros,
+ * and bucket i counts the samples in [2^(i-1), 2^i).
+ */
+class Log2Histogram {
+public:
+    static constexpr size_t NUM_BUCKETS = 65;
+    using Buckets = std::array<uint64_t, NUM_BUCKETS>;
+    Log2Histogram();
+    void add(uint64_t value);
+    uint64_t count() const { return _count; }
+    uint64_t   sum() const { return _sum; }
+    uint64_t   max() const { return _max; }
+    const Buckets & buckets() const { return _buckets; }
+    static size_t bucketOf(uint64_t value);
+    /// The exclusive upper limit of the samples counted in the given bucket.
+    static uint64_t bucketLimit(size_t bucket);
+private:
+    Buckets  _buckets;
+    uint64_t _count;
+    uint64_t _sum;
+    uint64_t _max;
+};
+
+/**
+ * Statistics of the batches written with a given compression.
+ */
+struct CompressionStats {
+    uint64_t batches;
+    uint64_t uncompressedBytes;
+    uint64_t compressedBytes;
+    CompressionStats() : batches(0), uncompressedBytes(0), compressedBytes(0) { }
+    void add(size_t uncompressed, size_t compressed) {
+        batches++;
+        uncompressedBytes += uncompressed;
+        compressedBytes += compressed;
+    }
+};
+
+/**
+ * Statistics of the group commits of a domain. Each batch is the packets appended to the domain
+ * since the previous batch, written with a single write. Each sync covers all batches written
+ * since the previous sync.
+ */
+struct CommitStats {
+    Log2Histogram batchEntries;
+    Log2Histogram batchBytes;
+    Log2Histogram syncBatches;
+    Log2Histogram syncLatencyUs;
+    std::map<vespalib::string, CompressionStats> compression;
+    CommitStats();
+};
+
 struct DomainInfo {
     using DurationSeconds = std::chrono::duration<double>;
     SerialNumRange range;
@@ -49,10 +113,11 @@ struct DomainInfo {
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
     std::vector<PartInfo> parts;
+    CommitStats commitStats;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts(), commitStats() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts(), commitStats() {}
 };
 
 using DomainStats = std::map<vespalib::string, DomainInfo>;
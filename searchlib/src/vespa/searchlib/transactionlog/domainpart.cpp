@@ -390,13 +390,19 @@ DomainPart::erase(SerialNum to)
 
 void
 DomainPart::commit(SerialNum firstSerial, const Packet &packet)
+{
+    commit(firstSerial, packet, _encoding);
+}
+
+void
+DomainPart::commit(SerialNum firstSerial, const Packet &packet, Encoding encoding)
 {
     int64_t firstPos(byteSize());
     nbostream_longlivedbuf h(packet.getHandle().data(), packet.getHandle().size());
     if (_range.from() == 0) {
         _range.from(firstSerial);
     }
-    IChunk::UP chunk = IChunk::create(_encoding, _compressionLevel);
+    IChunk::UP chunk = IChunk::create(encoding, _compressionLevel);
     for (size_t i(0); h.size() > 0; i++) {
         //LOG(spam,
         //"Pos(%d) Len(%d), Lim(%d), Remaining(%d)",
@@ -405,9 +411,9 @@ DomainPart::commit(SerialNum firstSerial, const Packet &packet)
         entry.deserialize(h);
         if (_range.to() < entry.serial()) {
             chunk->add(entry);
-            if (_encoding.getCompression() == Encoding::Compression::none) {
-                write(*_transLog, *chunk);
-                chunk = IChunk::create(_encoding, _compressionLevel);
+            if (encoding.getCompression() == Encoding::Compression::none) {
+                write(*_transLog, *chunk, encoding);
+                chunk = IChunk::create(encoding, _compressionLevel);
             }
             _sz++;
             _range.to(entry.serial());
@@ -417,7 +423,7 @@ DomainPart::commit(SerialNum firstSerial, const Packet &packet)
         }
     }
     if ( ! chunk->getEntries().empty()) {
-        write(*_transLog, *chunk);
+        write(*_transLog, *chunk, encoding);
     }
 
     bool merged(false);
@@ -537,11 +543,11 @@ DomainPart::visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet)
 }
 
 void
-DomainPart::write(FastOS_FileInterface &file, const IChunk & chunk)
+DomainPart::write(FastOS_FileInterface &file, const IChunk & chunk, Encoding encoding)
 {
     nbostream os;
     size_t begin = os.wp();
-    os << _encoding.getRaw();  // Placeholder for encoding
+    os << encoding.getRaw();  // Placeholder for encoding
     os << uint32_t(0);         // Placeholder for size
     Encoding realEncoding = chunk.encode(os);
     size_t end = os.wp();
@@ -554,7 +560,7 @@ DomainPart::write(FastOS_FileInterface &file, const IChunk & chunk)
         throw runtime_error(handleWriteError("Failed writing the entry.", file, byteSize(), chunk.range(), os.size()));
     }
     LOG(debug, "Wrote chunk with %zu entries and %zu bytes, range[%" PRIu64 ", %" PRIu64 "] encoding(wanted=%x, real=%x)",
-        chunk.getEntries().size(), os.size(), chunk.range().from(), chunk.range().to(), _encoding.getRaw(), realEncoding.getRaw());
+        chunk.getEntries().size(), os.size(), chunk.range().from(), chunk.range().to(), encoding.getRaw(), realEncoding.getRaw());
     _writtenSerial = chunk.range().to();
     _byteSize.fetch_add(os.size(), std::memory_order_release);
 }
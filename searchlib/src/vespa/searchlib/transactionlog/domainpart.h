@@ -26,6 +26,10 @@ public:
 
     const vespalib::string &fileName() const { return _fileName; }
     void commit(SerialNum firstSerial, const Packet &packet);
+    /**
+     * Commits the packet using the given encoding instead of the default one of this part.
+     */
+    void commit(SerialNum firstSerial, const Packet &packet, Encoding encoding);
     bool erase(SerialNum to);
     bool visit(SerialNumRange &r, Packet &packet);
     bool visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet);
@@ -50,7 +54,7 @@ private:
     static Packet readPacket(FastOS_FileInterface & file, SerialNumRange wanted, size_t targetSize, bool allowTruncate);
     static bool read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc &buf, bool allowTruncate);
 
-    void write(FastOS_FileInterface &file, const IChunk & entry);
+    void write(FastOS_FileInterface &file, const IChunk & entry, Encoding encoding);
     void writeHeader(const common::FileHeaderContext &fileHeaderContext);
 
     class SkipInfo
@@ -15,6 +15,22 @@ namespace search::transactionlog {
 
 namespace {
 
+void
+insertHistogram(Cursor &object, vespalib::stringref name, const Log2Histogram &histogram) {
+    Cursor &cursor = object.setObject(name);
+    cursor.setLong("count", histogram.count());
+    cursor.setLong("sum", histogram.sum());
+    cursor.setLong("max", histogram.max());
+    Cursor &buckets = cursor.setArray("buckets");
+    for (size_t i(0); i < Log2Histogram::NUM_BUCKETS; i++) {
+        if (histogram.buckets()[i] != 0) {
+            Cursor &bucket = buckets.addObject();
+            bucket.setLong("limit", Log2Histogram::bucketLimit(i));
+            bucket.setLong("count", histogram.buckets()[i]);
+        }
+    }
+}
+
 struct DomainExplorer : vespalib::StateExplorer {
     Domain::SP domain;
     DomainExplorer(Domain::SP domain_in) : domain(std::move(domain_in)) {}
@@ -26,6 +42,18 @@ struct DomainExplorer : vespalib::StateExplorer {
         state.setLong("numEntries", info.numEntries);
         state.setLong("byteSize", info.byteSize);
         if (full) {
+            Cursor &commit = state.setObject("commit");
+            insertHistogram(commit, "batchEntries", info.commitStats.batchEntries);
+            insertHistogram(commit, "batchBytes", info.commitStats.batchBytes);
+            insertHistogram(commit, "syncBatches", info.commitStats.syncBatches);
+            insertHistogram(commit, "syncLatencyUs", info.commitStats.syncLatencyUs);
+            Cursor &compression = commit.setObject("compression");
+            for (const auto &entry : info.commitStats.compression) {
+                Cursor &stats = compression.setObject(entry.first);
+                stats.setLong("batches", entry.second.batches);
+                stats.setLong("uncompressedBytes", entry.second.uncompressedBytes);
+                stats.setLong("compressedBytes", entry.second.compressedBytes);
+            }
             Cursor &array = state.setArray("parts");
             for (const PartInfo &part_in: info.parts) {
                 Cursor &part = array.addObject();
@@ -66,7 +66,10 @@ getDomainConfig(const searchlib::TranslogserverConfig & cfg) {
         .setCompressionLevel(cfg.compression.level)
         .setPartSizeLimit(cfg.filesizemax)
         .setChunkSizeLimit(cfg.chunk.sizelimit)
-        .setFSyncOnCommit(cfg.usefsync);
+        .setFSyncOnCommit(cfg.usefsync)
+        .setAdaptiveCompression(cfg.compression.adaptive)
+        .setBulkBatchSize(cfg.compression.bulkbatchsize)
+        .setMinZstdGain(cfg.compression.minzstdgain);
     return dcfg;
 }
 
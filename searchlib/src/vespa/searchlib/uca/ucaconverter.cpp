@@ -4,6 +4,8 @@
 #include <unicode/ustring.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/text/utf8.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <map>
 #include <mutex>
 #include <vespa/log/log.h>
 LOG_SETUP(".search.common.sortspec");
@@ -18,15 +20,70 @@ namespace {
 std::mutex _GlobalDirtyICUThreadSafeLock;
 }
 
+SortKeyCache::SortKeyCache(size_t maxEntries)
+    : _lock(),
+      _cache(maxEntries)
+{
+}
+
+SortKeyCache::~SortKeyCache() = default;
+
+bool
+SortKeyCache::lookup(vespalib::stringref value, vespalib::string &sortKey) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    const vespalib::string *found = _cache.findAndRef(value);
+    if (found == nullptr) {
+        return false;
+    }
+    sortKey = *found;
+    return true;
+}
+
+void
+SortKeyCache::insert(vespalib::stringref value, vespalib::stringref sortKey)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _cache.insert(value, sortKey);
+}
+
+size_t
+SortKeyCache::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _cache.size();
+}
+
+SortKeyCache::SP
+SortKeyCache::get(vespalib::stringref locale, vespalib::stringref strength)
+{
+    static std::mutex lock;
+    static std::map<vespalib::string, SP> caches;
+    vespalib::string name = locale + "/" + strength;
+    std::lock_guard<std::mutex> guard(lock);
+    SP &cache = caches[name];
+    if ( ! cache) {
+        cache = std::make_shared<SortKeyCache>(DEFAULT_MAX_ENTRIES);
+    }
+    return cache;
+}
+
 BlobConverter::UP
 UcaConverterFactory::create(stringref local, stringref strength) const {
-    return std::make_unique<UcaConverter>(local, strength);
+    return std::make_unique<UcaConverter>(local, strength, SortKeyCache::get(local, strength));
 }
 
 UcaConverter::UcaConverter(vespalib::stringref locale, vespalib::stringref strength) :
+    UcaConverter(locale, strength, SortKeyCache::SP())
+{
+}
+
+UcaConverter::UcaConverter(vespalib::stringref locale, vespalib::stringref strength, SortKeyCache::SP sortKeyCache) :
     _buffer(),
     _u16Buffer(128),
-    _collator()
+    _collator(),
+    _sortKeyCache(std::move(sortKeyCache)),
+    _cachedKey()
 {
     UErrorCode status = U_ZERO_ERROR;
     Collator *coll(NULL);
@@ -77,6 +134,10 @@ int UcaConverter::utf8ToUtf16(const ConstBufferRef & src) const
 
 ConstBufferRef UcaConverter::onConvert(const ConstBufferRef & src) const
 {
+    vespalib::stringref value(src.c_str(), src.size());
+    if (_sortKeyCache && _sortKeyCache->lookup(value, _cachedKey)) {
+        return ConstBufferRef(_cachedKey.data(), _cachedKey.size());
+    }
     int32_t u16Wanted(utf8ToUtf16(src));
     if (u16Wanted > (int)_u16Buffer.size()) {
         _u16Buffer.resize(u16Wanted);
@@ -89,6 +150,9 @@ ConstBufferRef UcaConverter::onConvert(const ConstBufferRef & src) const
         wanted = _collator->getSortKey(&_u16Buffer[0], u16Wanted, _buffer.ptr(), _buffer.siz());
         _buffer.check();
     }
+    if (_sortKeyCache) {
+        _sortKeyCache->insert(value, vespalib::stringref(reinterpret_cast<const char *>(_buffer.ptr()), wanted));
+    }
     return ConstBufferRef(_buffer.ptr(), wanted);
 }
 
@@ -5,7 +5,9 @@
 #include <vespa/searchlib/common/converters.h>
 #include <vespa/searchcommon/common/iblobconverter.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/stllike/lrucache_map.h>
 #include <unicode/coll.h>
+#include <mutex>
 #include <vector>
 #include <cassert>
 
@@ -16,6 +18,29 @@ using common::ConverterFactory;
 
 namespace uca {
 
+/**
+ * Bounded cache of collation sort keys for one locale and strength,
+ * keyed on the utf8 value. Shared between queries, so that the sort
+ * key of a value seen by an earlier query is found with a lookup
+ * instead of being generated by ICU again.
+ **/
+class SortKeyCache {
+public:
+    using SP = std::shared_ptr<SortKeyCache>;
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 100000;
+    explicit SortKeyCache(size_t maxEntries);
+    ~SortKeyCache();
+    bool lookup(vespalib::stringref value, vespalib::string &sortKey) const;
+    void insert(vespalib::stringref value, vespalib::stringref sortKey);
+    size_t size() const;
+    /// The process wide cache used for the given locale and strength.
+    static SP get(vespalib::stringref locale, vespalib::stringref strength);
+private:
+    using Cache = vespalib::lrucache_map<vespalib::LruParam<vespalib::string, vespalib::string>>;
+    mutable std::mutex _lock;
+    mutable Cache      _cache;
+};
+
 class UcaConverterFactory : public ConverterFactory {
 public:
     BlobConverter::UP create(stringref local, stringref strength) const override;
@@ -26,6 +51,7 @@ class UcaConverter : public BlobConverter
 public:
     using Collator = icu::Collator;
     UcaConverter(vespalib::stringref locale, vespalib::stringref strength);
+    UcaConverter(vespalib::stringref locale, vespalib::stringref strength, SortKeyCache::SP sortKeyCache);
     ~UcaConverter();
     const Collator & getCollator() const { return *_collator; }
 private:
@@ -59,6 +85,8 @@ private:
     mutable Buffer               _buffer;
     mutable std::vector<UChar>   _u16Buffer;
     std::unique_ptr<Collator>      _collator;
+    SortKeyCache::SP             _sortKeyCache;
+    mutable vespalib::string     _cachedKey;
 };
 
 }
@@ -0,0 +1,91 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "aligned_file_writer.h"
+#include <vespa/fastos/file.h>
+#include <cassert>
+#include <cstring>
+
+namespace search {
+
+namespace {
+
+bool
+isAligned(const void *data)
+{
+    return (reinterpret_cast<uintptr_t>(data) & (AlignedFileWriter::ALIGNMENT - 1)) == 0;
+}
+
+}
+
+AlignedFileWriter::AlignedFileWriter(FastOS_FileInterface &file, bool writeBehind, size_t bufferSize)
+    : _file(file),
+      _buf(vespalib::alloc::Alloc::allocAlignedHeap(bufferSize, ALIGNMENT)),
+      _bufferSize(bufferSize),
+      _used(0),
+      _startOffset(file.GetPosition()),
+      _fileOffset(_startOffset),
+      _writeBehind(writeBehind),
+      _prevChunkOffset(0),
+      _prevChunkLen(0)
+{
+    assert((bufferSize % ALIGNMENT) == 0);
+    assert((_startOffset % ALIGNMENT) == 0);
+}
+
+AlignedFileWriter::~AlignedFileWriter() = default;
+
+void
+AlignedFileWriter::writeChunk(const char *data, size_t len)
+{
+    _file.WriteBuf(data, len);
+    if (_writeBehind) {
+        _file.startWriteBack(_fileOffset, len);
+        if (_prevChunkLen > 0) {
+            _file.dropFromCache(_prevChunkOffset, _prevChunkLen);
+        }
+        _prevChunkOffset = _fileOffset;
+        _prevChunkLen = len;
+    }
+    _fileOffset += len;
+}
+
+void
+AlignedFileWriter::write(const void *buf, size_t len)
+{
+    const char *data = static_cast<const char *>(buf);
+    char *dst = static_cast<char *>(_buf.get());
+    while (len > 0) {
+        if ((_used == 0) && (len >= _bufferSize) && isAligned(data)) {
+            // Large aligned writes bypass the buffer
+            size_t alignedLen = len & ~(ALIGNMENT - 1);
+            writeChunk(data, alignedLen);
+            data += alignedLen;
+            len -= alignedLen;
+            continue;
+        }
+        size_t now = std::min(len, _bufferSize - _used);
+        memcpy(dst + _used, data, now);
+        _used += now;
+        data += now;
+        len -= now;
+        if (_used == _bufferSize) {
+            writeChunk(dst, _used);
+            _used = 0;
+        }
+    }
+}
+
+void
+AlignedFileWriter::flush()
+{
+    if (_used > 0) {
+        writeChunk(static_cast<const char *>(_buf.get()), _used);
+        _used = 0;
+    }
+    if (_writeBehind && (_prevChunkLen > 0)) {
+        _file.dropFromCache(_prevChunkOffset, _prevChunkLen);
+        _prevChunkLen = 0;
+    }
+}
+
+}
@@ -0,0 +1,58 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/alloc.h>
+#include <cstdint>
+
+class FastOS_FileInterface;
+
+namespace search {
+
+/*
+ * Sequential writer collecting data in a buffer aligned for direct
+ * I/O, passing it on to the file in chunks that are aligned both in
+ * memory and in the file. Only the final chunk written by flush() may
+ * have an unaligned length, so callers can write blocks of any size
+ * to a file opened with direct I/O.
+ *
+ * With write behind enabled (used when direct I/O is wanted but not
+ * available for the file), write back of each chunk is started when
+ * it has been written, and the chunk before it is dropped from the
+ * page cache, so writing large files does not evict pages used for
+ * serving.
+ */
+class AlignedFileWriter
+{
+public:
+    static constexpr size_t ALIGNMENT = 4096;
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+    AlignedFileWriter(FastOS_FileInterface &file, bool writeBehind, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~AlignedFileWriter();
+
+    void write(const void *buf, size_t len);
+
+    /*
+     * Writes any buffered data to the file. Must only be called after
+     * the last write, since the file position is no longer aligned if
+     * the amount of data written is not a multiple of the alignment.
+     */
+    void flush();
+
+    uint64_t bytesWritten() const { return _fileOffset + _used - _startOffset; }
+private:
+    void writeChunk(const char *data, size_t len);
+
+    FastOS_FileInterface  &_file;
+    vespalib::alloc::Alloc _buf;
+    size_t                 _bufferSize;
+    size_t                 _used;
+    int64_t                _startOffset;
+    int64_t                _fileOffset;
+    bool                   _writeBehind;
+    int64_t                _prevChunkOffset;
+    size_t                 _prevChunkLen;
+};
+
+}
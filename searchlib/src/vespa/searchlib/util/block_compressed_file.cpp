@@ -0,0 +1,187 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_compressed_file.h"
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using vespalib::DataBuffer;
+using vespalib::GenericHeader;
+using vespalib::IllegalStateException;
+using vespalib::make_string;
+
+namespace search {
+
+namespace {
+
+const vespalib::string compressionPrefix = "compression.";
+const vespalib::string typeTag = "compression.type";
+const vespalib::string levelTag = "compression.level";
+const vespalib::string blockSizeTag = "compression.blockSize";
+const vespalib::string dataSizeTag = "compression.dataSize";
+const vespalib::string fileBitSizeTag = "fileBitSize";
+
+constexpr size_t FILE_HEADER_ALIGN = 4096;
+constexpr size_t BLOCK_HEADER_SIZE = 3 * sizeof(uint32_t);
+constexpr size_t MIN_BLOCKS_PER_THREAD = 16;
+constexpr uint32_t MAX_DECOMPRESS_THREADS = 8;
+
+struct Block {
+    BlockCompressedFile::CompressionConfig::Type type;
+    const char *compressed;
+    size_t      compressedLen;
+    size_t      offset;
+    size_t      len;
+};
+
+const char *
+typeName(BlockCompressedFile::CompressionConfig::Type type)
+{
+    return (type == BlockCompressedFile::CompressionConfig::ZSTD) ? "zstd" : "lz4";
+}
+
+bool
+decompressBlock(const Block &block, char *data)
+{
+    DataBuffer dest(static_cast<void *>(data + block.offset), block.len);
+    try {
+        vespalib::compression::decompress(block.type, block.len,
+                                          vespalib::ConstBufferRef(block.compressed, block.compressedLen),
+                                          dest, false);
+    } catch (const std::exception &) {
+        return false;
+    }
+    return (dest.getData() == data + block.offset) && (dest.getDataLen() == block.len);
+}
+
+}
+
+bool
+BlockCompressedFile::isCompressed(const GenericHeader &header)
+{
+    return header.hasTag(typeTag);
+}
+
+void
+BlockCompressedFile::addTags(GenericHeader &header, const CompressionConfig &compression)
+{
+    using Tag = GenericHeader::Tag;
+    header.putTag(Tag(typeTag, typeName(compression.type)));
+    header.putTag(Tag(levelTag, static_cast<uint32_t>(compression.compressionLevel)));
+    header.putTag(Tag(blockSizeTag, static_cast<uint64_t>(BLOCK_SIZE)));
+}
+
+void
+BlockCompressedFile::addDataSizeTag(GenericHeader &header, uint64_t dataSize)
+{
+    header.putTag(GenericHeader::Tag(dataSizeTag, dataSize));
+}
+
+void
+BlockCompressedFile::compressBlock(const CompressionConfig &compression, const void *buf, size_t len,
+                                   DataBuffer &output)
+{
+    DataBuffer compressed(len);
+    CompressionConfig::Type type = vespalib::compression::compress(compression,
+                                                                   vespalib::ConstBufferRef(buf, len),
+                                                                   compressed, false);
+    output.ensureFree(BLOCK_HEADER_SIZE + compressed.getDataLen());
+    output.writeInt32(type);
+    output.writeInt32(compressed.getDataLen());
+    output.writeInt32(len);
+    output.writeBytes(compressed.getData(), compressed.getDataLen());
+}
+
+vespalib::alloc::Alloc
+BlockCompressedFile::decompress(const GenericHeader &header, size_t headerLen,
+                                const void *file, size_t fileSize, const vespalib::string &fileName,
+                                size_t &imageSize, size_t &imageHeaderLen)
+{
+    if (!header.hasTag(dataSizeTag)) {
+        throw IllegalStateException(make_string("Compressed file '%s' was not completed", fileName.c_str()));
+    }
+    uint64_t dataSize = header.getTag(dataSizeTag).asInteger();
+    std::vector<Block> blocks;
+    const char *pos = static_cast<const char *>(file) + headerLen;
+    const char *end = static_cast<const char *>(file) + fileSize;
+    size_t offset = 0;
+    while (pos < end) {
+        if (size_t(end - pos) < BLOCK_HEADER_SIZE) {
+            throw IllegalStateException(make_string("Truncated block header at offset %zu in '%s'",
+                                                    size_t(pos - static_cast<const char *>(file)), fileName.c_str()));
+        }
+        DataBuffer blockHeader(static_cast<const void *>(pos), BLOCK_HEADER_SIZE);
+        Block block;
+        block.type = CompressionConfig::toType(blockHeader.readInt32());
+        block.compressedLen = blockHeader.readInt32();
+        block.len = blockHeader.readInt32();
+        block.offset = offset;
+        pos += BLOCK_HEADER_SIZE;
+        block.compressed = pos;
+        if ((block.compressedLen > size_t(end - pos)) || (block.len > dataSize - offset)) {
+            throw IllegalStateException(make_string("Bad block at offset %zu in '%s'",
+                                                    size_t(pos - static_cast<const char *>(file)), fileName.c_str()));
+        }
+        blocks.push_back(block);
+        pos += block.compressedLen;
+        offset += block.len;
+    }
+    if (offset != dataSize) {
+        throw IllegalStateException(make_string("Compressed file '%s' has %zu bytes of data, expected %" PRIu64,
+                                                fileName.c_str(), offset, dataSize));
+    }
+
+    vespalib::FileHeader imageHeader(FILE_HEADER_ALIGN);
+    for (size_t i = 0; i < header.getNumTags(); ++i) {
+        const GenericHeader::Tag &tag = header.getTag(i);
+        if (tag.getName().find(compressionPrefix) != 0) {
+            imageHeader.putTag(tag);
+        }
+    }
+    imageHeader.putTag(GenericHeader::Tag(fileBitSizeTag, uint64_t(0)));
+    imageHeaderLen = imageHeader.getSize();
+    imageSize = imageHeaderLen + dataSize;
+    imageHeader.putTag(GenericHeader::Tag(fileBitSizeTag, uint64_t(imageSize * 8)));
+    auto image = vespalib::alloc::Alloc::alloc(imageSize);
+    DataBuffer headerBuf(image.get(), imageHeaderLen);
+    GenericHeader::BufferWriter writer(headerBuf);
+    imageHeader.write(writer);
+
+    char *data = static_cast<char *>(image.get()) + imageHeaderLen;
+    uint32_t numThreads = std::min(std::min(MAX_DECOMPRESS_THREADS, std::max(std::thread::hardware_concurrency(), 1u)),
+                                   static_cast<uint32_t>(blocks.size() / MIN_BLOCKS_PER_THREAD));
+    std::atomic<bool> failed(false);
+    if (numThreads <= 1) {
+        for (const Block &block : blocks) {
+            if (!decompressBlock(block, data)) {
+                failed = true;
+                break;
+            }
+        }
+    } else {
+        vespalib::ThreadStackExecutor executor(numThreads, 128 * 1024);
+        for (uint32_t thread = 0; thread < numThreads; ++thread) {
+            executor.execute(vespalib::makeLambdaTask([&blocks, &failed, data, thread, numThreads]() {
+                for (size_t i = thread; (i < blocks.size()) && !failed; i += numThreads) {
+                    if (!decompressBlock(blocks[i], data)) {
+                        failed = true;
+                    }
+                }
+            }));
+        }
+        executor.sync();
+    }
+    if (failed) {
+        throw IllegalStateException(make_string("Failed decompressing blocks of '%s'", fileName.c_str()));
+    }
+    return image;
+}
+
+}
@@ -0,0 +1,64 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/compressionconfig.h>
+
+namespace vespalib {
+class DataBuffer;
+class GenericHeader;
+}
+
+namespace search {
+
+/*
+ * Layout of data files where the data following the file header is
+ * compressed in blocks, used for attribute vector files when
+ * compression is enabled.
+ *
+ * Each block starts with a small block header (compression type,
+ * compressed size and uncompressed size). The block index is built
+ * by one pass over the block headers, after which the blocks are
+ * decompressed in parallel into the image the file would have had if
+ * it was written uncompressed: a file header without the compression
+ * tags, followed by the uncompressed data.
+ */
+class BlockCompressedFile
+{
+public:
+    using CompressionConfig = vespalib::compression::CompressionConfig;
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    static bool isCompressed(const vespalib::GenericHeader &header);
+
+    /*
+     * Adds the tags describing the compression, before the file header is written.
+     */
+    static void addTags(vespalib::GenericHeader &header, const CompressionConfig &compression);
+
+    /*
+     * Adds the tag with the size of the uncompressed data, when the file is complete.
+     */
+    static void addDataSizeTag(vespalib::GenericHeader &header, uint64_t dataSize);
+
+    /*
+     * Appends the given data as one compressed block to the output buffer.
+     */
+    static void compressBlock(const CompressionConfig &compression, const void *buf, size_t len,
+                              vespalib::DataBuffer &output);
+
+    /*
+     * Decompresses the blocks following the file header in the given
+     * file contents. Returns the uncompressed image of the file, with
+     * its size in imageSize and the length of its file header in
+     * imageHeaderLen. Throws IllegalStateException if the blocks are
+     * corrupt.
+     */
+    static vespalib::alloc::Alloc decompress(const vespalib::GenericHeader &header, size_t headerLen,
+                                             const void *file, size_t fileSize, const vespalib::string &fileName,
+                                             size_t &imageSize, size_t &imageHeaderLen);
+};
+
+}
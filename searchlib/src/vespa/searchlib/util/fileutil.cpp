@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "fileutil.hpp"
+#include "block_compressed_file.h"
 #include "filesizecalculator.h"
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/guard.h>
@@ -25,7 +26,8 @@ namespace fileutil {
 LoadedMmap::LoadedMmap(const vespalib::string &fileName)
     : LoadedBuffer(NULL, 0),
       _mapBuffer(NULL),
-      _mapSize(0)
+      _mapSize(0),
+      _decompressed()
 {
     FileDescriptor fd(open(fileName.c_str(), O_RDONLY, 0664));
     if (fd.valid()) {
@@ -41,10 +43,11 @@ LoadedMmap::LoadedMmap(const vespalib::string &fileName)
                     _mapBuffer = tmpBuffer;
                     uint32_t hl = GenericHeader::getMinSize();
                     bool badHeader = true;
+                    size_t headerLen = 0;
                     if (sz >= hl) {
                         GenericHeader::MMapReader rd(static_cast<const char *>(tmpBuffer), sz);
                         _header = std::make_unique<GenericHeader>();
-                        size_t headerLen = _header->read(rd);
+                        headerLen = _header->read(rd);
                         if ((headerLen <= _mapSize) &&
                             FileSizeCalculator::extractFileSize(*_header, headerLen, fileName, fileSize)) {
                             sz = fileSize;
@@ -56,6 +59,9 @@ LoadedMmap::LoadedMmap(const vespalib::string &fileName)
                     if (badHeader) {
                         throw IllegalStateException(make_string("bad file header: %s", fileName.c_str()));
                     }
+                    if (BlockCompressedFile::isCompressed(*_header)) {
+                        decompress(fileName, headerLen, sz);
+                    }
                 } else {
                     throw IllegalStateException(make_string("Failed mmaping '%s' of size %" PRIu64 " errno(%d)",
                                                             fileName.c_str(), static_cast<uint64_t>(sz), errno));
@@ -72,8 +78,104 @@ LoadedMmap::LoadedMmap(const vespalib::string &fileName)
 }
 
 LoadedMmap::~LoadedMmap() {
-    madvise(_mapBuffer, _mapSize, MADV_DONTNEED);
-    munmap(_mapBuffer, _mapSize);
+    unmap();
+}
+
+void
+LoadedMmap::unmap()
+{
+    if (_mapBuffer != NULL) {
+        madvise(_mapBuffer, _mapSize, MADV_DONTNEED);
+        munmap(_mapBuffer, _mapSize);
+        _mapBuffer = NULL;
+        _mapSize = 0;
+    }
+}
+
+void
+LoadedMmap::decompress(const vespalib::string &fileName, size_t headerLen, size_t fileSize)
+{
+    size_t imageSize(0);
+    size_t imageHeaderLen(0);
+    try {
+        _decompressed = BlockCompressedFile::decompress(*_header, headerLen, _mapBuffer, fileSize, fileName,
+                                                        imageSize, imageHeaderLen);
+    } catch (...) {
+        unmap();
+        throw;
+    }
+    unmap();
+    const char *image = static_cast<const char *>(_decompressed.get());
+    GenericHeader::MMapReader rd(image, imageSize);
+    _header = std::make_unique<GenericHeader>();
+    _header->read(rd);
+    _buffer = const_cast<char *>(image) + imageHeaderLen;
+    _size = imageSize - imageHeaderLen;
+}
+
+}
+
+namespace {
+
+/*
+ * Read only file with contents in memory, used for the uncompressed
+ * image of a block compressed file.
+ */
+class DecompressedFile : public FastOS_FileInterface
+{
+    vespalib::alloc::Alloc _image;
+    size_t _size;
+    size_t _pos;
+    bool   _opened;
+public:
+    DecompressedFile(const vespalib::string &fileName, vespalib::alloc::Alloc image, size_t size)
+        : FastOS_FileInterface(fileName.c_str()),
+          _image(std::move(image)),
+          _size(size),
+          _pos(0),
+          _opened(true)
+    {
+        _openFlags = FASTOS_FILE_OPEN_READ;
+    }
+    bool Open(unsigned int, const char *) override { return false; }
+    bool Close() override { _opened = false; return true; }
+    bool IsOpened() const override { return _opened; }
+    ssize_t Read(void *buffer, size_t length) override {
+        size_t numRead = std::min(length, _size - _pos);
+        memcpy(buffer, static_cast<const char *>(_image.get()) + _pos, numRead);
+        _pos += numRead;
+        return numRead;
+    }
+    ssize_t Write2(const void *, size_t) override { return -1; }
+    bool SetPosition(int64_t position) override {
+        if ((position < 0) || (static_cast<uint64_t>(position) > _size)) {
+            return false;
+        }
+        _pos = position;
+        return true;
+    }
+    int64_t GetPosition() override { return _pos; }
+    int64_t GetSize() override { return _size; }
+    time_t GetModificationTime() override { return 0; }
+    bool Delete() override { return false; }
+    bool Sync() override { return true; }
+    bool SetSize(int64_t) override { return false; }
+};
+
+std::unique_ptr<FastOS_FileInterface>
+openDecompressed(FastOS_FileInterface &file, const vespalib::FileHeader &header, size_t headerLen)
+{
+    uint64_t fileSize = file.GetSize();
+    if (!FileSizeCalculator::extractFileSize(header, headerLen, file.GetFileName(), fileSize)) {
+        throw IllegalStateException(make_string("bad file header: %s", file.GetFileName()));
+    }
+    auto contents = vespalib::alloc::Alloc::alloc(fileSize);
+    file.ReadBuf(contents.get(), fileSize, 0);
+    size_t imageSize(0);
+    size_t imageHeaderLen(0);
+    auto image = BlockCompressedFile::decompress(header, headerLen, contents.get(), fileSize, file.GetFileName(),
+                                                 imageSize, imageHeaderLen);
+    return std::make_unique<DecompressedFile>(file.GetFileName(), std::move(image), imageSize);
 }
 
 }
@@ -88,6 +190,19 @@ FileUtil::openFile(const vespalib::string &fileName)
         file->Close();
         throw IllegalStateException(make_string("Failed opening '%s' for direct IO reading.", file->GetFileName()));
     }
+    if (file->GetSize() >= static_cast<int64_t>(GenericHeader::getMinSize())) {
+        vespalib::FileHeader header;
+        size_t headerLen = 0;
+        try {
+            headerLen = header.readFile(*file);
+        } catch (const vespalib::IllegalHeaderException &) {
+            // Not a file with a header, leave it to the caller.
+        }
+        if ((headerLen > 0) && BlockCompressedFile::isCompressed(header)) {
+            return openDecompressed(*file, header, headerLen);
+        }
+        file->SetPosition(0);
+    }
     return file;
 }
 
@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/stllike/string.h>
 
@@ -40,10 +41,18 @@ namespace search {
             const GenericHeader &getHeader() const { return *_header; }
         };
 
+        /**
+         * Mmaps a file. Block compressed files are decompressed into
+         * memory instead, see BlockCompressedFile.
+         */
         class LoadedMmap : public LoadedBuffer
         {
             void * _mapBuffer;
             size_t _mapSize;
+            vespalib::alloc::Alloc _decompressed;
+
+            void decompress(const vespalib::string &fileName, size_t headerLen, size_t fileSize);
+            void unmap();
         public:
             LoadedMmap(const vespalib::string &fileName);
 
@@ -60,7 +69,9 @@ public:
 
     /**
      * Opens and returns the file with the given name for reading.
-     * Enables direct IO on the file.
+     * Enables direct IO on the file. A block compressed file is
+     * decompressed into memory, and the returned file reads the
+     * uncompressed image of it.
      **/
     static std::unique_ptr<FastOS_FileInterface> openFile(const vespalib::string &fileName);
 
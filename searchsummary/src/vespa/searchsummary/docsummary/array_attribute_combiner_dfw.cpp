@@ -24,6 +24,7 @@ class ArrayAttributeFieldWriterState : public DocsumFieldWriterState
     std::vector<std::unique_ptr<AttributeFieldWriter>> _writers;
     const vespalib::string&                            _field_name;
     const MatchingElements* const                      _matching_elements;
+    std::vector<Cursor *>                              _objects;
 
 public:
     ArrayAttributeFieldWriterState(const std::vector<vespalib::string> &fieldNames,
@@ -33,7 +34,6 @@ public:
                                    const MatchingElements* matching_elements,
                                    bool is_map_of_scalar);
     ~ArrayAttributeFieldWriterState() override;
-    void insert_element(uint32_t element_index, Cursor &array);
     void insertField(uint32_t docId, vespalib::slime::Inserter &target) override;
 };
 
@@ -46,7 +46,8 @@ ArrayAttributeFieldWriterState::ArrayAttributeFieldWriterState(const std::vector
     : DocsumFieldWriterState(),
       _writers(),
       _field_name(field_name),
-      _matching_elements(matching_elements)
+      _matching_elements(matching_elements),
+      _objects()
 {
     size_t fields = fieldNames.size();
     _writers.reserve(fields);
@@ -60,15 +61,6 @@ ArrayAttributeFieldWriterState::ArrayAttributeFieldWriterState(const std::vector
 
 ArrayAttributeFieldWriterState::~ArrayAttributeFieldWriterState() = default;
 
-void
-ArrayAttributeFieldWriterState::insert_element(uint32_t element_index, Cursor &array)
-{
-    Cursor &obj = array.addObject();
-    for (auto &writer : _writers) {
-        writer->print(element_index, obj);
-    }
-}
-
 void
 ArrayAttributeFieldWriterState::insertField(uint32_t docId, vespalib::slime::Inserter &target)
 {
@@ -83,21 +75,25 @@ ArrayAttributeFieldWriterState::insertField(uint32_t docId, vespalib::slime::Ins
         return;
     }
     Cursor &arr = target.insertArray();
+    _objects.assign(elems, nullptr);
     if (_matching_elements != nullptr) {
         auto &elements = _matching_elements->get_matching_elements(docId, _field_name);
         auto elements_iterator = elements.cbegin();
         for (uint32_t idx = 0; idx < elems && elements_iterator != elements.cend(); ++idx) {
             assert(*elements_iterator >= idx);
             if (*elements_iterator == idx) {
-                insert_element(idx, arr);
+                _objects[idx] = &arr.addObject();
                 ++elements_iterator;
             }
         }
     } else {
         for (uint32_t idx = 0; idx < elems; ++idx) {
-            insert_element(idx, arr);
+            _objects[idx] = &arr.addObject();
         }
     }
+    for (auto &writer : _writers) {
+        writer->print_column(_objects);
+    }
 }
 
 }
@@ -4,12 +4,14 @@
 #include <vespa/searchcommon/attribute/attributecontent.h>
 #include <vespa/searchcommon/common/undefinedvalues.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <algorithm>
 #include <cassert>
 
 using search::attribute::BasicType;
 using search::attribute::IAttributeVector;
 using search::attribute::getUndefined;
 using vespalib::slime::Cursor;
+using vespalib::slime::Symbol;
 
 namespace search::docsummary {
 
@@ -33,6 +35,13 @@ protected:
 
     WriteField(vespalib::Memory fieldName, const IAttributeVector &attr);
     ~WriteField() override;
+    uint32_t column_size(const std::vector<Cursor *> &objects) const;
+    Symbol resolve(Symbol &sym, Cursor &cursor) {
+        if (sym.undefined()) {
+            sym = cursor.resolve(_fieldName);
+        }
+        return sym;
+    }
 private:
     void fetch(uint32_t docId) override;
 };
@@ -43,7 +52,7 @@ public:
     WriteStringField(vespalib::Memory fieldName,
                      const IAttributeVector &attr);
     ~WriteStringField() override;
-    void print(uint32_t idx, Cursor &cursor) override;
+    void print_column(const std::vector<Cursor *> &objects) override;
 };
 
 class WriteStringFieldNeverSkip : public WriteField<search::attribute::ConstCharContent>
@@ -53,7 +62,7 @@ public:
                              const IAttributeVector &attr)
       : WriteField(fieldName, attr) {}
     ~WriteStringFieldNeverSkip() override {}
-    void print(uint32_t idx, Cursor &cursor) override;
+    void print_column(const std::vector<Cursor *> &objects) override;
 };
 
 class WriteFloatField : public WriteField<search::attribute::FloatContent>
@@ -62,7 +71,7 @@ public:
     WriteFloatField(vespalib::Memory fieldName,
                     const IAttributeVector &attr);
     ~WriteFloatField() override;
-    void print(uint32_t idx, Cursor &cursor) override;
+    void print_column(const std::vector<Cursor *> &objects) override;
 };
 
 class WriteIntField : public WriteField<search::attribute::IntegerContent>
@@ -73,7 +82,7 @@ public:
                   const IAttributeVector &attr,
                   IAttributeVector::largeint_t undefined);
     ~WriteIntField() override;
-    void print(uint32_t idx, Cursor &cursor) override;
+    void print_column(const std::vector<Cursor *> &objects) override;
 };
 
 template <class Content>
@@ -86,6 +95,13 @@ WriteField<Content>::WriteField(vespalib::Memory fieldName, const IAttributeVect
 template <class Content>
 WriteField<Content>::~WriteField() = default;
 
+template <class Content>
+uint32_t
+WriteField<Content>::column_size(const std::vector<Cursor *> &objects) const
+{
+    return std::min(_size, objects.size());
+}
+
 template <class Content>
 void
 WriteField<Content>::fetch(uint32_t docId)
@@ -103,24 +119,29 @@ WriteStringField::WriteStringField(vespalib::Memory fieldName,
 WriteStringField::~WriteStringField() = default;
 
 void
-WriteStringField::print(uint32_t idx, Cursor &cursor)
+WriteStringField::print_column(const std::vector<Cursor *> &objects)
 {
-    if (idx < _size) {
+    Symbol sym;
+    uint32_t elems = column_size(objects);
+    for (uint32_t idx = 0; idx < elems; ++idx) {
+        Cursor *obj = objects[idx];
         const char *s = _content[idx];
-        if (s[0] != '\0') {
-            cursor.setString(_fieldName, vespalib::Memory(s));
+        if (obj != nullptr && s[0] != '\0') {
+            obj->setString(resolve(sym, *obj), vespalib::Memory(s));
         }
     }
 }
 
 void
-WriteStringFieldNeverSkip::print(uint32_t idx, Cursor &cursor)
-{
-    if (idx < _size) {
-        const char *s = _content[idx];
-        cursor.setString(_fieldName, vespalib::Memory(s));
-    } else {
-        cursor.setString(_fieldName, vespalib::Memory(""));
+WriteStringFieldNeverSkip::print_column(const std::vector<Cursor *> &objects)
+{
+    Symbol sym;
+    uint32_t elems = column_size(objects);
+    for (uint32_t idx = 0; idx < objects.size(); ++idx) {
+        Cursor *obj = objects[idx];
+        if (obj != nullptr) {
+            obj->setString(resolve(sym, *obj), (idx < elems) ? vespalib::Memory(_content[idx]) : vespalib::Memory(""));
+        }
     }
 }
 
@@ -133,12 +154,15 @@ WriteFloatField::WriteFloatField(vespalib::Memory fieldName,
 WriteFloatField::~WriteFloatField() = default;
 
 void
-WriteFloatField::print(uint32_t idx, Cursor &cursor)
+WriteFloatField::print_column(const std::vector<Cursor *> &objects)
 {
-    if (idx < _size) {
+    Symbol sym;
+    uint32_t elems = column_size(objects);
+    for (uint32_t idx = 0; idx < elems; ++idx) {
+        Cursor *obj = objects[idx];
         double val = _content[idx];
-        if (!search::attribute::isUndefined(val)) {
-            cursor.setDouble(_fieldName, val);
+        if (obj != nullptr && !search::attribute::isUndefined(val)) {
+            obj->setDouble(resolve(sym, *obj), val);
         }
     }
 }
@@ -154,12 +178,15 @@ WriteIntField::WriteIntField(vespalib::Memory fieldName,
 WriteIntField::~WriteIntField() = default;
 
 void
-WriteIntField::print(uint32_t idx, Cursor &cursor)
+WriteIntField::print_column(const std::vector<Cursor *> &objects)
 {
-    if (idx < _size) {
+    Symbol sym;
+    uint32_t elems = column_size(objects);
+    for (uint32_t idx = 0; idx < elems; ++idx) {
+        Cursor *obj = objects[idx];
         auto val = _content[idx];
-        if (val != _undefined) {
-            cursor.setLong(_fieldName, _content[idx]);
+        if (obj != nullptr && val != _undefined) {
+            obj->setLong(resolve(sym, *obj), val);
         }
     }
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/data/memory.h>
+#include <vector>
 
 namespace search::attribute { class IAttributeVector; }
 namespace vespalib::slime { struct Cursor; }
@@ -14,6 +15,11 @@ namespace search::docsummary {
  * them into proper position in an array of struct or map of struct.
  * If the value to be inserted is considered to be undefined then
  * the value is not inserted.
+ *
+ * All values of a document are fetched with one read from the
+ * attribute, and then written as a column into the objects already
+ * created for the elements, so the field name is only resolved to a
+ * slime symbol once per document.
  */
 class AttributeFieldWriter
 {
@@ -26,7 +32,11 @@ protected:
 public:
     virtual ~AttributeFieldWriter();
     virtual void fetch(uint32_t docId) = 0;
-    virtual void print(uint32_t idx, vespalib::slime::Cursor &cursor) = 0;
+    /*
+     * Writes the fetched value of each element into the object at the
+     * same index. Elements with a null object are skipped.
+     */
+    virtual void print_column(const std::vector<vespalib::slime::Cursor *> &objects) = 0;
     static std::unique_ptr<AttributeFieldWriter> create(vespalib::Memory fieldName, const search::attribute::IAttributeVector &attr, bool keep_empty_strings = false);
     uint32_t size() const { return _size; }
 };
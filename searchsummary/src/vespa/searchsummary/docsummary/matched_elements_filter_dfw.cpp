@@ -9,19 +9,17 @@
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/searchlib/common/matching_elements.h>
 #include <vespa/searchlib/common/matching_elements_fields.h>
-#include <vespa/vespalib/data/slime/binary_format.h>
+#include <vespa/vespalib/data/slime/binary_view.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/smart_buffer.h>
 #include <cassert>
 
 using document::FieldValue;
 using document::LiteralFieldValueB;
-using vespalib::Slime;
 using vespalib::slime::ArrayInserter;
-using vespalib::slime::BinaryFormat;
+using vespalib::slime::BinaryView;
 using vespalib::slime::Inserter;
 using vespalib::slime::Inspector;
-using vespalib::slime::SlimeInserter;
 using vespalib::slime::inject;
 
 namespace search::docsummary {
@@ -64,15 +62,6 @@ MatchedElementsFilterDFW::~MatchedElementsFilterDFW() = default;
 
 namespace {
 
-void
-decode_input_field_to_slime(const ResEntry& entry, search::RawBuf& target_buf, Slime& input_field_as_slime)
-{
-    const char* buf;
-    uint32_t buf_len;
-    entry._resolve_field(&buf, &buf_len, &target_buf);
-    BinaryFormat::decode(vespalib::Memory(buf, buf_len), input_field_as_slime);
-}
-
 void
 filter_matching_elements_in_input_field_while_converting_to_slime(const FieldValue& input_field_value,
                                                                   const std::vector<uint32_t>& matching_elems,
@@ -85,29 +74,16 @@ filter_matching_elements_in_input_field_while_converting_to_slime(const FieldVal
     assert(converted->getClass().inherits(LiteralFieldValueB::classId));
     auto& literal = static_cast<const LiteralFieldValueB&>(*converted);
     vespalib::stringref buf = literal.getValueRef();
-    Slime input_field_as_slime;
-    BinaryFormat::decode(vespalib::Memory(buf.data(), buf.size()), input_field_as_slime);
-    inject(input_field_as_slime.get(), target);
-}
-
-bool
-resolve_input_field_as_slime(GeneralResult& result, GetDocsumsState& state,
-                             int entry_idx, Slime& input_field_as_slime)
-{
-    ResEntry* entry = result.GetEntry(entry_idx);
-    if (entry != nullptr) {
-        decode_input_field_to_slime(*entry, state._docSumFieldSpace, input_field_as_slime);
-        return true;
-    }
-    return false;
+    BinaryView input_field(vespalib::Memory(buf.data(), buf.size()));
+    inject(input_field.get(), target);
 }
 
 void
-filter_matching_elements_in_input_field(const Slime& input_field, const std::vector<uint32_t>& matching_elems, Slime& output_field)
+filter_matching_elements_in_input_field(const Inspector& input_inspector, const std::vector<uint32_t>& matching_elems,
+                                        Inserter& target)
 {
-    SlimeInserter output_inserter(output_field);
-    Inspector& input_inspector = input_field.get();
-    ArrayInserter array_inserter(output_inserter.insertArray());
+    // Only the matching elements are copied; the input field is inspected in its encoded form.
+    ArrayInserter array_inserter(target.insertArray());
     auto elems_itr = matching_elems.begin();
     for (size_t i = 0; (i < input_inspector.entries()) && (elems_itr != matching_elems.end()); ++i) {
         assert(*elems_itr >= i);
@@ -126,11 +102,13 @@ MatchedElementsFilterDFW::insertField(uint32_t docid, GeneralResult* result, Get
 {
     assert(type == ResType::RES_JSONSTRING);
     int entry_idx = result->GetClass()->GetIndexFromEnumValue(_input_field_enum);
-    Slime input_field;
-    if (resolve_input_field_as_slime(*result, *state, entry_idx, input_field)) {
-        Slime output_field;
-        filter_matching_elements_in_input_field(input_field, get_matching_elements(docid, *state), output_field);
-        inject(output_field.get(), target);
+    ResEntry* entry = result->GetEntry(entry_idx);
+    if (entry != nullptr) {
+        const char* buf;
+        uint32_t buf_len;
+        entry->_resolve_field(&buf, &buf_len, &state->_docSumFieldSpace);
+        BinaryView input_field(vespalib::Memory(buf, buf_len));
+        filter_matching_elements_in_input_field(input_field.get(), get_matching_elements(docid, *state), target);
     } else {
         // Use the document instance if the input field is not in the docsum blob.
         auto field_value = result->get_field_value(_input_field_name);
@@ -14,6 +14,7 @@
 using search::attribute::IAttributeContext;
 using search::attribute::IAttributeVector;
 using vespalib::slime::Cursor;
+using vespalib::slime::Symbol;
 
 namespace search::docsummary {
 
@@ -28,6 +29,8 @@ class StructMapAttributeFieldWriterState : public DocsumFieldWriterState
     std::vector<std::unique_ptr<AttributeFieldWriter>> _valueWriters;
     const vespalib::string&                            _field_name; 
     const MatchingElements* const                      _matching_elements;
+    std::vector<Cursor *>                              _objects;
+    std::vector<Cursor *>                              _value_objects;
 
 public:
     StructMapAttributeFieldWriterState(const vespalib::string &keyAttributeName,
@@ -37,7 +40,6 @@ public:
                                        const vespalib::string &field_name,
                                        const MatchingElements* matching_elements);
     ~StructMapAttributeFieldWriterState() override;
-    void insert_element(uint32_t element_index, Cursor &array);
     void insertField(uint32_t docId, vespalib::slime::Inserter &target) override;
 };
 
@@ -51,7 +53,9 @@ StructMapAttributeFieldWriterState::StructMapAttributeFieldWriterState(const ves
       _keyWriter(),
       _valueWriters(),
       _field_name(field_name),
-      _matching_elements(matching_elements)
+      _matching_elements(matching_elements),
+      _objects(),
+      _value_objects()
 {
     const IAttributeVector *attr = context.getAttribute(keyAttributeName);
     if (attr != nullptr) {
@@ -69,19 +73,6 @@ StructMapAttributeFieldWriterState::StructMapAttributeFieldWriterState(const ves
 
 StructMapAttributeFieldWriterState::~StructMapAttributeFieldWriterState() = default;
 
-void
-StructMapAttributeFieldWriterState::insert_element(uint32_t element_index, Cursor &array)
-{
-    Cursor &keyValueObj = array.addObject();
-    if (_keyWriter) {
-        _keyWriter->print(element_index, keyValueObj);
-    }
-    Cursor &obj = keyValueObj.setObject(valueName);
-    for (auto &valueWriter : _valueWriters) {
-        valueWriter->print(element_index, obj);
-    }
-}
-
 void
 StructMapAttributeFieldWriterState::insertField(uint32_t docId, vespalib::slime::Inserter &target)
 {
@@ -102,21 +93,36 @@ StructMapAttributeFieldWriterState::insertField(uint32_t docId, vespalib::slime:
         return;
     }
     Cursor &arr = target.insertArray();
+    _objects.assign(elems, nullptr);
     if (_matching_elements != nullptr) {
         auto &elements = _matching_elements->get_matching_elements(docId, _field_name);
         auto elements_iterator = elements.cbegin();
         for (uint32_t idx = 0; idx < elems && elements_iterator != elements.cend(); ++idx) {
             assert(*elements_iterator >= idx);
             if (*elements_iterator == idx) {
-                insert_element(idx, arr);
+                _objects[idx] = &arr.addObject();
                 ++elements_iterator;
             }
         }
     } else {
         for (uint32_t idx = 0; idx < elems; ++idx) {
-            insert_element(idx, arr);
+            _objects[idx] = &arr.addObject();
         }
     }
+    // The key is set before the value object to keep the field order of each element.
+    if (_keyWriter) {
+        _keyWriter->print_column(_objects);
+    }
+    Symbol value_sym = arr.resolve(valueName);
+    _value_objects.assign(elems, nullptr);
+    for (uint32_t idx = 0; idx < elems; ++idx) {
+        if (_objects[idx] != nullptr) {
+            _value_objects[idx] = &_objects[idx]->setObject(value_sym);
+        }
+    }
+    for (auto &valueWriter : _valueWriters) {
+        valueWriter->print_column(_value_objects);
+    }
 }
 
 }
@@ -8,22 +8,13 @@ LOG_SETUP(".history");
 namespace slobrok {
 
 void
-History::verify() const
+History::add(const std::string &name, vespalib::GenCnt gen)
 {
     if (_entries.size() > 0) {
-        citer_t i = _entries.cbegin();
-        vespalib::GenCnt gen = i->gen;
-
-        while (++i != _entries.cend()) {
-            gen.add();
-            LOG_ASSERT(gen == i->gen);
-        }
+        vespalib::GenCnt next = _entries.back().gen;
+        next.add();
+        LOG_ASSERT(next == gen);
     }
-}
-
-void
-History::add(const std::string &name, vespalib::GenCnt gen)
-{
     _entries.emplace_back(name, gen);
 
     if (_entries.size() > 1500) {
@@ -31,7 +22,6 @@ History::add(const std::string &name, vespalib::GenCnt gen)
         LOG(debug, "history size after trim: %lu",
             (unsigned long)_entries.size());
     }
-    verify();
 }
 
 
@@ -51,11 +41,12 @@ History::has(vespalib::GenCnt gen) const
 std::set<std::string>
 History::since(vespalib::GenCnt gen) const
 {
-    citer_t i = _entries.cbegin();
+    // generations are consecutive, see add()
+    citer_t i = _entries.cend();
     citer_t end = _entries.cend();
-    while (i != end) {
-        if (i->gen == gen) break;
-        ++i;
+    if (has(gen)) {
+        i = _entries.cbegin() + _entries.front().gen.distance(gen);
+        LOG_ASSERT(i->gen == gen);
     }
     std::set<std::string> ret;
     while (i != end) {
@@ -22,7 +22,6 @@ private:
 
     typedef std::vector<HistoryEntry>::const_iterator citer_t;
 
-    void verify() const;
 public:
     void add(const std::string &name, vespalib::GenCnt gen);
 
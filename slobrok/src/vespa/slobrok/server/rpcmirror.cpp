@@ -16,7 +16,8 @@ IncrementalFetch::IncrementalFetch(FRT_Supervisor *orb,
     : FNET_Task(orb->GetScheduler()),
       _req(req),
       _map(map),
-      _gen(gen)
+      _gen(gen),
+      _batching(false)
 { }
 
 IncrementalFetch::~IncrementalFetch() { }
@@ -73,9 +74,14 @@ IncrementalFetch::updated(VisibleMap &map)
 {
     LOG_ASSERT(&map == &_map);
     (void) &map;
-    // unschedule timeout task
-    Unschedule();
-    completeReq();
+    // keep listening to get aborted notifications while batching
+    _map.addUpdateListener(this);
+    if (!_batching) {
+        _batching = true;
+        // replace timeout task with a short delay collecting more updates
+        Unschedule();
+        Schedule(BATCH_DELAY);
+    }
 }
 
 
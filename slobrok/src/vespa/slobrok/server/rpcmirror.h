@@ -16,8 +16,16 @@ private:
     FRT_RPCRequest  *_req;
     VisibleMap      &_map;
     vespalib::GenCnt _gen;
+    bool             _batching;
 
 public:
+    /**
+     * How long to wait after the first update before answering a
+     * waiting fetch, so that a burst of updates (e.g. after a restart)
+     * is sent as one diff instead of one reply per update.
+     **/
+    static constexpr double BATCH_DELAY = 0.05;
+
     IncrementalFetch(const IncrementalFetch &) = delete;
     IncrementalFetch& operator=(const IncrementalFetch &) = delete;
 
@@ -0,0 +1,52 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/net/ring_tracer_explorer.h>
+#include <vespa/vespalib/util/ring_tracer.h>
+#include <thread>
+
+using namespace vespalib;
+using namespace vespalib::slime;
+
+RT_Tag my_tag("my tag");
+RT_Tag other_tag("other tag");
+
+TEST("require that samples are summarized per tag") {
+    { RT_Sample sample(my_tag); }
+    { RT_Sample sample(my_tag); }
+    { RT_Sample sample(other_tag); }
+    Slime slime;
+    RingTracerExplorer(10s).get_state(SlimeInserter(slime), false);
+    const Inspector &state = slime.get();
+    EXPECT_EQUAL(10.0, state["window"].asDouble());
+    EXPECT_EQUAL(1, state["threads"].asLong());
+    EXPECT_EQUAL(2, state["tags"]["my tag"]["count"].asLong());
+    EXPECT_EQUAL(1, state["tags"]["other tag"]["count"].asLong());
+    EXPECT_TRUE(state["tags"]["my tag"]["max_ms"].asDouble() <= state["tags"]["my tag"]["total_ms"].asDouble());
+    EXPECT_FALSE(state["samples"].valid());
+}
+
+TEST("require that full state lists samples ordered by start time") {
+    Slime slime;
+    RingTracerExplorer(10s).get_state(SlimeInserter(slime), true);
+    const Inspector &samples = slime.get()["samples"];
+    ASSERT_EQUAL(3u, samples.entries());
+    EXPECT_EQUAL("my tag", samples[0]["tag"].asString().make_string());
+    EXPECT_EQUAL("my tag", samples[1]["tag"].asString().make_string());
+    EXPECT_EQUAL("other tag", samples[2]["tag"].asString().make_string());
+    EXPECT_EQUAL(0, samples[0]["thread"].asLong());
+    EXPECT_TRUE(samples[0]["start"].asDouble() <= samples[1]["start"].asDouble());
+    EXPECT_TRUE(samples[1]["start"].asDouble() <= samples[2]["start"].asDouble());
+    EXPECT_TRUE(samples[2]["duration_ms"].asDouble() >= 0.0);
+}
+
+TEST("require that samples outside the time window are not exposed") {
+    std::this_thread::sleep_for(20ms);
+    Slime slime;
+    RingTracerExplorer(10ms).get_state(SlimeInserter(slime), true);
+    EXPECT_EQUAL(0u, slime.get()["tags"].fields());
+    EXPECT_EQUAL(0u, slime.get()["samples"].entries());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
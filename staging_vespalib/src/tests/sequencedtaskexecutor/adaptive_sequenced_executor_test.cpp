@@ -230,6 +230,50 @@ TEST_F("require that executeLambda works", Fixture)
     EXPECT_EQUAL(5, i);
 }
 
+TEST_F("require that executeTasks keeps order within each executor id", Fixture)
+{
+    std::vector<int> res0;
+    std::vector<int> res1;
+    ISequencedTaskExecutor::TaskList tasks;
+    for (int i = 0; i < 10; ++i) {
+        tasks.emplace_back(f._threads.getExecutorId(i % 2), makeLambdaTask([&res0, &res1, i]() {
+            ((i % 2) == 0 ? res0 : res1).push_back(i);
+        }));
+    }
+    f._threads.executeTasks(std::move(tasks));
+    f._threads.sync();
+    EXPECT_EQUAL(std::vector<int>({0, 2, 4, 6, 8}), res0);
+    EXPECT_EQUAL(std::vector<int>({1, 3, 5, 7, 9}), res1);
+}
+
+TEST("require that executeTasks beyond the task limit does not deadlock") {
+    AdaptiveSequencedExecutor executor(4, 2, 0, 5);
+    std::atomic<int> cnt(0);
+    ISequencedTaskExecutor::TaskList tasks;
+    for (int i = 0; i < 100; ++i) {
+        tasks.emplace_back(executor.getExecutorId(i), makeLambdaTask([&cnt]() { ++cnt; }));
+    }
+    executor.executeTasks(std::move(tasks));
+    executor.sync();
+    EXPECT_EQUAL(100, cnt.load());
+}
+
+TEST("require that batching and spinning workers run all tasks in order") {
+    AdaptiveSequencedExecutor executor(4, 2, 0, 50, 8, 1ms);
+    std::vector<std::vector<int>> res(4);
+    for (int i = 0; i < 1000; ++i) {
+        auto id = executor.getExecutorId(i);
+        executor.execute(id, [&res, id, i]() { res[id.getId()].push_back(i); });
+    }
+    executor.sync();
+    for (size_t id = 0; id < res.size(); ++id) {
+        ASSERT_EQUAL(250u, res[id].size());
+        for (size_t i = 0; i < res[id].size(); ++i) {
+            EXPECT_EQUAL(int(id + i * 4), res[id][i]);
+        }
+    }
+}
+
 TEST("require that you get correct number of executors") {
     AdaptiveSequencedExecutor seven(7, 1, 0, 10);
     EXPECT_EQUAL(7u, seven.getNumExecutors());
@@ -0,0 +1,99 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/work_stealing_executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/gate.h>
+#include <atomic>
+#include <thread>
+
+using namespace vespalib;
+
+TEST("require that all tasks are executed") {
+    std::atomic<uint64_t> counter(0);
+    WorkStealingExecutor executor(4, 128*1024, 100);
+    for (uint64_t i(0); i < 10000; i++) {
+        EXPECT_TRUE(executor.execute(makeLambdaTask([&counter] {counter++;})).get() == nullptr);
+    }
+    executor.sync();
+    EXPECT_EQUAL(10000u, counter);
+    auto stats = executor.getStats();
+    EXPECT_EQUAL(10000u, stats.acceptedTasks);
+    EXPECT_EQUAL(0u, stats.rejectedTasks);
+    EXPECT_EQUAL(4u, executor.getNumThreads());
+}
+
+TEST("require that tasks posted by tasks are executed before sync returns") {
+    std::atomic<uint64_t> counter(0);
+    WorkStealingExecutor executor(4, 128*1024, 100);
+    for (uint64_t i(0); i < 1000; i++) {
+        executor.execute(makeLambdaTask([&counter, &executor] {
+            counter++;
+            executor.execute(makeLambdaTask([&counter] {counter++;}));
+        }));
+    }
+    executor.sync();
+    EXPECT_EQUAL(2000u, counter);
+}
+
+TEST("require that many producers can post concurrently") {
+    std::atomic<uint64_t> counter(0);
+    WorkStealingExecutor executor(4, 128*1024, 100);
+    std::vector<std::thread> producers;
+    for (size_t p(0); p < 4; p++) {
+        producers.emplace_back([&counter, &executor] {
+            for (uint64_t i(0); i < 10000; i++) {
+                executor.execute(makeLambdaTask([&counter] {counter++;}));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    executor.sync();
+    EXPECT_EQUAL(40000u, counter);
+}
+
+TEST("require that an idle worker steals tasks from a blocked one") {
+    Gate blocked;
+    std::atomic<uint64_t> counter(0);
+    WorkStealingExecutor executor(2, 128*1024, 100);
+    // Tasks are spread round-robin, so every other task lands behind the blocking one.
+    executor.execute(makeLambdaTask([&blocked] { blocked.await(); }));
+    for (uint64_t i(0); i < 99; i++) {
+        executor.execute(makeLambdaTask([&counter] {counter++;}));
+    }
+    while (counter < 99) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQUAL(99u, counter);
+    blocked.countDown();
+    executor.sync();
+}
+
+TEST("require that producer is blocked when task limit is reached") {
+    Gate blocked;
+    std::atomic<bool> posted(false);
+    WorkStealingExecutor executor(1, 128*1024, 2);
+    executor.execute(makeLambdaTask([&blocked] { blocked.await(); }));
+    executor.execute(makeLambdaTask([] {}));
+    std::thread producer([&executor, &posted] {
+        executor.execute(makeLambdaTask([] {}));
+        posted = true;
+    });
+    std::this_thread::sleep_for(10ms);
+    EXPECT_FALSE(posted);
+    blocked.countDown();
+    producer.join();
+    EXPECT_TRUE(posted);
+    executor.sync();
+}
+
+TEST("require that tasks are rejected after shutdown") {
+    WorkStealingExecutor executor(2, 128*1024, 100);
+    executor.shutdown();
+    EXPECT_TRUE(executor.execute(makeLambdaTask([] {})).get() != nullptr);
+    EXPECT_EQUAL(1u, executor.getStats().rejectedTasks);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,11 +2,18 @@
 
 #include "http_server.h"
 #include <vespa/vespalib/net/crypto_engine.h>
+#include <vespa/vespalib/util/lambdatask.h>
 
 namespace vespalib {
 
+namespace {
+
+VESPA_THREAD_STACK_TAG(http_server_executor);
+
+}
+
 void
-HttpServer::get(Portal::GetRequest req)
+HttpServer::handle(Portal::GetRequest req)
 {
     vespalib::string json_result = _handler_repo.get(req.get_host(), req.get_path(), req.export_params());
     if (json_result.empty()) {
@@ -16,11 +23,19 @@ HttpServer::get(Portal::GetRequest req)
     }
 }
 
+void
+HttpServer::get(Portal::GetRequest req)
+{
+    // a rejected task responds with an error when destructed
+    _executor.execute(makeLambdaTask([this, req = std::move(req)]() mutable { handle(std::move(req)); }));
+}
+
 //-----------------------------------------------------------------------------
 
-HttpServer::HttpServer(int port_in)
+HttpServer::HttpServer(int port_in, uint32_t num_threads)
     : _handler_repo(),
       _server(Portal::create(CryptoEngine::get_default(), port_in)),
+      _executor(num_threads, 128 * 1024, http_server_executor),
       _root(_server->bind("/", *this))
 {
 }
@@ -28,6 +43,7 @@ HttpServer::HttpServer(int port_in)
 HttpServer::~HttpServer()
 {
     _root.reset();
+    _executor.shutdown().sync();
 }
 
 } // namespace vespalib
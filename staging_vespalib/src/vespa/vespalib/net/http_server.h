@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/portal/portal.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include "json_handler_repo.h"
 
 namespace vespalib {
@@ -13,19 +14,25 @@ namespace vespalib {
  * a specific port to the constructor or use 0 to bind to a random
  * port. Note that you may not ask about the actual port until after
  * the server has been started. Request dispatching is done using a
- * JsonHandlerRepo.
+ * JsonHandlerRepo. Requests are handled by a small pool of worker
+ * threads, so that a slow handler (like rendering a large set of
+ * metrics) does not block the portal from serving other requests.
  **/
 class HttpServer : public Portal::GetHandler
 {
 private:
     JsonHandlerRepo _handler_repo;
     Portal::SP _server;
+    ThreadStackExecutor _executor;
     Portal::Token::UP _root;
 
+    void handle(Portal::GetRequest req);
     void get(Portal::GetRequest req) override;
 public:
     typedef std::unique_ptr<HttpServer> UP;
-    HttpServer(int port_in);
+    static constexpr uint32_t DEFAULT_NUM_THREADS = 4;
+    HttpServer(int port_in, uint32_t num_threads);
+    HttpServer(int port_in) : HttpServer(port_in, DEFAULT_NUM_THREADS) {}
     ~HttpServer();
     const vespalib::string &host() const { return _server->my_host(); }
     JsonHandlerRepo &repo() { return _handler_repo; }
@@ -0,0 +1,65 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "ring_tracer_explorer.h"
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/ring_tracer.h>
+#include <algorithm>
+#include <map>
+
+namespace vespalib {
+
+namespace {
+
+struct TagSummary {
+    size_t count = 0;
+    duration total = duration::zero();
+    duration max = duration::zero();
+};
+
+double to_ms(duration d) { return to_s(d) * 1000.0; }
+
+}
+
+RingTracerExplorer::RingTracerExplorer(duration window)
+    : _window(window)
+{
+}
+
+RingTracerExplorer::~RingTracerExplorer() = default;
+
+void
+RingTracerExplorer::get_state(const slime::Inserter &inserter, bool full) const
+{
+    steady_time now = steady_clock::now();
+    system_time utc_now = system_clock::now();
+    auto records = RingTracer::extract(now - _window, now);
+    std::map<uint32_t, TagSummary> summary;
+    for (const auto &record: records) {
+        TagSummary &tag = summary[record.tag_id];
+        ++tag.count;
+        tag.total += record.elapsed();
+        tag.max = std::max(tag.max, record.elapsed());
+    }
+    slime::Cursor &object = inserter.insertObject();
+    object.setDouble("window", to_s(_window));
+    object.setLong("threads", RingTracer::num_threads());
+    slime::Cursor &tags = object.setObject("tags");
+    for (const auto &entry: summary) {
+        slime::Cursor &tag = tags.setObject(RingTracer::tag_name(entry.first));
+        tag.setLong("count", entry.second.count);
+        tag.setDouble("total_ms", to_ms(entry.second.total));
+        tag.setDouble("max_ms", to_ms(entry.second.max));
+    }
+    if (full) {
+        slime::Cursor &samples = object.setArray("samples");
+        for (const auto &record: records) {
+            slime::Cursor &sample = samples.addObject();
+            sample.setLong("thread", record.thread_id);
+            sample.setString("tag", record.tag_name());
+            sample.setDouble("start", to_s(utc_now.time_since_epoch() - (now - record.start)));
+            sample.setDouble("duration_ms", to_ms(record.elapsed()));
+        }
+    }
+}
+
+} // namespace vespalib
@@ -0,0 +1,27 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "state_explorer.h"
+#include <vespa/vespalib/util/time.h>
+
+namespace vespalib {
+
+/**
+ * Exposes the samples logged with RingTracer during the last time
+ * window through the StateExplorer interface. The short form only
+ * summarizes the samples per tag, while the full form also lists the
+ * individual samples, ordered by start time.
+ **/
+class RingTracerExplorer : public StateExplorer
+{
+private:
+    duration _window;
+
+public:
+    explicit RingTracerExplorer(duration window = 10s);
+    ~RingTracerExplorer() override;
+    void get_state(const slime::Inserter &inserter, bool full) const override;
+};
+
+} // namespace vespalib
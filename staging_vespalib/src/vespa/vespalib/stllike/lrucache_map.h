@@ -4,6 +4,7 @@
 #include <vespa/vespalib/stllike/hashtable.h>
 #include <vespa/vespalib/stllike/hash_fun.h>
 #include <vespa/vespalib/stllike/select.h>
+#include <limits>
 #include <vector>
 
 namespace vespalib {
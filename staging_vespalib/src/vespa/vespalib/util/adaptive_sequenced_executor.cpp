@@ -1,6 +1,7 @@
 // Copyright 2020 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "adaptive_sequenced_executor.h"
+#include <thread>
 
 namespace vespalib {
 
@@ -88,6 +89,13 @@ AdaptiveSequencedExecutor::ThreadTools::close()
 
 //-----------------------------------------------------------------------------
 
+bool
+AdaptiveSequencedExecutor::would_block_self(const std::unique_lock<std::mutex> &) const
+{
+    return ((_self.state == Self::State::BLOCKED) ||
+            ((_self.state == Self::State::OPEN) && (_self.pending_tasks >= _cfg.max_pending)));
+}
+
 void
 AdaptiveSequencedExecutor::maybe_block_self(std::unique_lock<std::mutex> &lock)
 {
@@ -112,6 +120,22 @@ AdaptiveSequencedExecutor::maybe_unblock_self(const std::unique_lock<std::mutex>
     return false;
 }
 
+void
+AdaptiveSequencedExecutor::push_wait_queue(Strand *strand)
+{
+    _wait_queue.push(strand);
+    _wait_queue_size.store(_wait_queue.size(), std::memory_order_relaxed);
+}
+
+AdaptiveSequencedExecutor::Strand *
+AdaptiveSequencedExecutor::pop_wait_queue()
+{
+    Strand *strand = _wait_queue.front();
+    _wait_queue.pop();
+    _wait_queue_size.store(_wait_queue.size(), std::memory_order_relaxed);
+    return strand;
+}
+
 AdaptiveSequencedExecutor::Worker *
 AdaptiveSequencedExecutor::get_worker_to_wake(const std::unique_lock<std::mutex> &)
 {
@@ -122,8 +146,7 @@ AdaptiveSequencedExecutor::get_worker_to_wake(const std::unique_lock<std::mutex>
         assert(worker->state == Worker::State::BLOCKED);
         assert(worker->strand == nullptr);
         worker->state = Worker::State::RUNNING;
-        worker->strand = _wait_queue.front();
-        _wait_queue.pop();
+        worker->strand = pop_wait_queue();
         assert(worker->strand->state == Strand::State::WAITING);
         assert(!worker->strand->queue.empty());
         worker->strand->state = Strand::State::ACTIVE;
@@ -134,13 +157,28 @@ AdaptiveSequencedExecutor::get_worker_to_wake(const std::unique_lock<std::mutex>
     return nullptr;
 }
 
+void
+AdaptiveSequencedExecutor::spin_for_strand(std::unique_lock<std::mutex> &lock)
+{
+    // Not being on the worker stack while spinning, producers will
+    // queue strands for us to pick up instead of waking someone.
+    lock.unlock(); // UNLOCK
+    auto deadline = steady_clock::now() + _cfg.spin_time;
+    while ((_wait_queue_size.load(std::memory_order_relaxed) == 0) && (steady_clock::now() < deadline)) {
+        std::this_thread::yield();
+    }
+    lock.lock();
+}
+
 bool
 AdaptiveSequencedExecutor::obtain_strand(Worker &worker, std::unique_lock<std::mutex> &lock)
 {
     assert(worker.strand == nullptr);
+    if (_wait_queue.empty() && (_self.state != Self::State::CLOSED) && (_cfg.spin_time > duration::zero())) {
+        spin_for_strand(lock);
+    }
     if (!_wait_queue.empty()) {
-        worker.strand = _wait_queue.front();
-        _wait_queue.pop();
+        worker.strand = pop_wait_queue();
         assert(worker.strand->state == Strand::State::WAITING);
         assert(!worker.strand->queue.empty());
         worker.strand->state = Strand::State::ACTIVE;
@@ -172,29 +210,33 @@ AdaptiveSequencedExecutor::exchange_strand(Worker &worker, std::unique_lock<std:
     if (!_wait_queue.empty()) {
         worker.strand->state = Strand::State::WAITING;
         _self.waiting_tasks += worker.strand->queue.size();
-        _wait_queue.push(worker.strand);
+        push_wait_queue(worker.strand);
         worker.strand = nullptr;
         return obtain_strand(worker, lock);
     }
     return true;
 }
 
-AdaptiveSequencedExecutor::TaggedTask
-AdaptiveSequencedExecutor::next_task(Worker &worker, std::optional<uint32_t> prev_token)
+bool
+AdaptiveSequencedExecutor::next_tasks(Worker &worker, std::vector<uint32_t> &done, std::vector<TaggedTask> &batch)
 {
-    TaggedTask task;
+    assert(batch.empty());
     Worker *worker_to_wake = nullptr;
     auto guard = std::unique_lock(_mutex);
-    if (prev_token.has_value()) {
-        _barrier.completeEvent(prev_token.value());
+    for (uint32_t token: done) {
+        _barrier.completeEvent(token);
     }
+    done.clear();
     if (exchange_strand(worker, guard)) {
         assert(worker.state == Worker::State::RUNNING);
         assert(worker.strand != nullptr);
         assert(!worker.strand->queue.empty());
-        task = std::move(worker.strand->queue.front());
-        worker.strand->queue.pop();
-        _stats.queueSize.add(--_self.pending_tasks);
+        while (!worker.strand->queue.empty() && (batch.size() < _cfg.max_batch)) {
+            batch.push_back(std::move(worker.strand->queue.front()));
+            worker.strand->queue.pop();
+        }
+        _self.pending_tasks -= batch.size();
+        _stats.queueSize.add(_self.pending_tasks);
         worker_to_wake = get_worker_to_wake(guard);
     } else {
         assert(worker.state == Worker::State::DONE);
@@ -208,32 +250,41 @@ AdaptiveSequencedExecutor::next_task(Worker &worker, std::optional<uint32_t> pre
     if (signal_self) {
         _self.cond.notify_all();
     }
-    return task;
+    return !batch.empty();
 }
 
 void
 AdaptiveSequencedExecutor::worker_main()
 {
     Worker worker;
-    std::optional<uint32_t> prev_token = std::nullopt;
-    while (TaggedTask my_task = next_task(worker, prev_token)) {
-        my_task.task->run();
-        prev_token = my_task.token;
+    std::vector<uint32_t> done;
+    std::vector<TaggedTask> batch;
+    done.reserve(_cfg.max_batch);
+    batch.reserve(_cfg.max_batch);
+    while (next_tasks(worker, done, batch)) {
+        for (TaggedTask &my_task: batch) {
+            my_task.task->run();
+            my_task.task.reset();
+            done.push_back(my_task.token);
+        }
+        batch.clear();
     }
     _thread_tools->allow_worker_exit.await();
 }
 
 AdaptiveSequencedExecutor::AdaptiveSequencedExecutor(size_t num_strands, size_t num_threads,
-                                                     size_t max_waiting, size_t max_pending)
+                                                     size_t max_waiting, size_t max_pending,
+                                                     size_t max_batch, duration spin_time)
     : ISequencedTaskExecutor(num_strands),
       _thread_tools(std::make_unique<ThreadTools>(*this)),
       _mutex(),
       _strands(num_strands),
       _wait_queue(num_strands),
+      _wait_queue_size(0),
       _worker_stack(num_threads),
       _self(),
       _stats(),
-      _cfg(num_threads, max_waiting, max_pending)
+      _cfg(num_threads, max_waiting, max_pending, max_batch, spin_time)
 {
     _stats.queueSize.add(_self.pending_tasks);
     _thread_tools->start(num_threads);
@@ -266,14 +317,11 @@ AdaptiveSequencedExecutor::getExecutorId(uint64_t component) const {
     return ExecutorId(component % _strands.size());
 }
 
-void
-AdaptiveSequencedExecutor::executeTask(ExecutorId id, Task::UP task)
+AdaptiveSequencedExecutor::Worker *
+AdaptiveSequencedExecutor::push_task(ExecutorId id, Task::UP task, std::unique_lock<std::mutex> &)
 {
     assert(id.getId() < _strands.size());
     Strand &strand = _strands[id.getId()];
-    auto guard = std::unique_lock(_mutex);
-    assert(_self.state != Self::State::CLOSED);
-    maybe_block_self(guard);
     strand.queue.push(TaggedTask(std::move(task), _barrier.startEvent()));
     _stats.queueSize.add(++_self.pending_tasks);
     ++_stats.acceptedTasks;
@@ -282,7 +330,7 @@ AdaptiveSequencedExecutor::executeTask(ExecutorId id, Task::UP task)
     } else if (strand.state == Strand::State::IDLE) {
         if (_worker_stack.size() < _cfg.num_threads) {
             strand.state = Strand::State::WAITING;
-            _wait_queue.push(&strand);
+            push_wait_queue(&strand);
             _self.waiting_tasks += strand.queue.size();
         } else {
             strand.state = Strand::State::ACTIVE;
@@ -293,9 +341,48 @@ AdaptiveSequencedExecutor::executeTask(ExecutorId id, Task::UP task)
             assert(worker->strand == nullptr);
             worker->state = Worker::State::RUNNING;
             worker->strand = &strand;
-            guard.unlock(); // UNLOCK
-            worker->cond.notify_one();
+            return worker;
+        }
+    }
+    return nullptr;
+}
+
+void
+AdaptiveSequencedExecutor::executeTask(ExecutorId id, Task::UP task)
+{
+    auto guard = std::unique_lock(_mutex);
+    assert(_self.state != Self::State::CLOSED);
+    maybe_block_self(guard);
+    Worker *worker = push_task(id, std::move(task), guard);
+    guard.unlock(); // UNLOCK
+    if (worker != nullptr) {
+        worker->cond.notify_one();
+    }
+}
+
+void
+AdaptiveSequencedExecutor::executeTasks(TaskList tasks)
+{
+    std::vector<Worker *> workers_to_wake;
+    auto guard = std::unique_lock(_mutex);
+    assert(_self.state != Self::State::CLOSED);
+    for (auto &task: tasks) {
+        if (would_block_self(guard)) {
+            // the workers we handed strands to must run for us to get unblocked
+            for (Worker *worker: workers_to_wake) {
+                worker->cond.notify_one();
+            }
+            workers_to_wake.clear();
+            maybe_block_self(guard);
         }
+        Worker *worker = push_task(task.first, std::move(task.second), guard);
+        if (worker != nullptr) {
+            workers_to_wake.push_back(worker);
+        }
+    }
+    guard.unlock(); // UNLOCK
+    for (Worker *worker: workers_to_wake) {
+        worker->cond.notify_one();
     }
 }
 
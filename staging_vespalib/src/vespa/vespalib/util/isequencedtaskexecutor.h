@@ -28,6 +28,7 @@ public:
     private:
         uint32_t _id;
     };
+    using TaskList = std::vector<std::pair<ExecutorId, vespalib::Executor::Task::UP>>;
     ISequencedTaskExecutor(uint32_t numExecutors);
     virtual ~ISequencedTaskExecutor();
 
@@ -50,6 +51,15 @@ public:
      * @param task   unique pointer to the task to be executed
      */
     virtual void executeTask(ExecutorId id, vespalib::Executor::Task::UP task) = 0;
+    /**
+     * Schedule a list of tasks, each to run after all previously
+     * scheduled tasks with the same id. Tasks with the same id are run
+     * in list order. Implementations may override this to hand over
+     * the whole list with less synchronization than one call per task.
+     *
+     * @param tasks  the tasks to be executed, paired with their executor id
+     */
+    virtual void executeTasks(TaskList tasks);
     /**
      * Call this one to ensure you get the attention of the workers.
      */
@@ -0,0 +1,299 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "work_stealing_executor.h"
+#include <vespa/vespalib/util/threadstackexecutorbase.h>
+#include <vespa/fastos/thread.h>
+#include <cassert>
+
+namespace vespalib {
+
+namespace {
+
+VESPA_THREAD_STACK_TAG(unnamed_work_stealing_executor);
+
+}
+
+struct WorkStealingExecutor::ThreadInit : public FastOS_Runnable {
+    Runnable &worker;
+    init_fun_t init_fun;
+
+    ThreadInit(Runnable &worker_in, init_fun_t init_fun_in)
+        : worker(worker_in), init_fun(std::move(init_fun_in)) {}
+
+    void Run(FastOS_ThreadInterface *, void *) override { init_fun(worker); }
+};
+
+WorkStealingExecutor::Worker::Worker() : lock(), tasks(), stats() {}
+WorkStealingExecutor::Worker::~Worker() = default;
+
+thread_local const WorkStealingExecutor *WorkStealingExecutor::_master = nullptr;
+thread_local uint32_t WorkStealingExecutor::_selfId = 0;
+
+WorkStealingExecutor::WorkStealingExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit)
+    : WorkStealingExecutor(threads, stackSize, taskLimit, unnamed_work_stealing_executor)
+{ }
+
+WorkStealingExecutor::WorkStealingExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit,
+                                           init_fun_t init_fun)
+    : SyncableThreadExecutor(),
+      Runnable(),
+      _workers(),
+      _pool(std::make_unique<FastOS_ThreadPool>(stackSize)),
+      _thread_init(std::make_unique<ThreadInit>(*this, std::move(init_fun))),
+      _nextWorkerId(0),
+      _nextQueue(0),
+      _queued(0),
+      _taskCount(0),
+      _taskLimit(taskLimit),
+      _rejected(0),
+      _closed(false),
+      _stopped(false),
+      _idleWorkers(0),
+      _idleLock(),
+      _idleCond(),
+      _blockedProducers(0),
+      _producerLock(),
+      _producerCond(),
+      _epoch(0),
+      _pending(),
+      _syncWaiting(false),
+      _syncLock(),
+      _syncWaitLock(),
+      _syncCond()
+{
+    assert(threads > 0);
+    assert(taskLimit > 0);
+    _pending[0] = 0;
+    _pending[1] = 0;
+    _workers.reserve(threads);
+    for (uint32_t i = 0; i < threads; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+    for (uint32_t i = 0; i < threads; ++i) {
+        FastOS_ThreadInterface *thread = _pool->NewThread(_thread_init.get());
+        assert(thread != nullptr);
+        (void) thread;
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    shutdown().sync();
+    {
+        std::lock_guard guard(_idleLock);
+        _stopped = true;
+        _idleCond.notify_all();
+    }
+    _pool->Close();
+    assert(_taskCount == 0);
+}
+
+bool
+WorkStealingExecutor::owns_this_thread() const
+{
+    return (_master == this);
+}
+
+size_t
+WorkStealingExecutor::getNumThreads() const
+{
+    return _workers.size();
+}
+
+void
+WorkStealingExecutor::setTaskLimit(uint32_t taskLimit)
+{
+    _taskLimit = taskLimit;
+    if (_blockedProducers.load() > 0) {
+        std::lock_guard guard(_producerLock);
+        _producerCond.notify_all();
+    }
+}
+
+void
+WorkStealingExecutor::wakeup()
+{
+    // Nothing to do here as workers are always attentive.
+}
+
+uint32_t
+WorkStealingExecutor::start_epoch()
+{
+    for (;;) {
+        uint32_t epoch = _epoch.load();
+        _pending[epoch & 1].fetch_add(1);
+        if (_epoch.load() == epoch) {
+            return epoch;
+        }
+        // raced with sync; the task belongs to the next epoch
+        complete_epoch(epoch);
+    }
+}
+
+void
+WorkStealingExecutor::complete_epoch(uint32_t epoch)
+{
+    if ((_pending[epoch & 1].fetch_sub(1) == 1) && _syncWaiting.load()) {
+        std::lock_guard guard(_syncWaitLock);
+        _syncCond.notify_all();
+    }
+}
+
+void
+WorkStealingExecutor::complete_task(uint32_t epoch)
+{
+    _taskCount.fetch_sub(1);
+    if (_blockedProducers.load() > 0) {
+        std::lock_guard guard(_producerLock);
+        _producerCond.notify_all();
+    }
+    complete_epoch(epoch);
+}
+
+void
+WorkStealingExecutor::wait_for_room()
+{
+    if ((_taskCount.load(std::memory_order_relaxed) < getTaskLimit()) || owns_this_thread()) {
+        return;
+    }
+    std::unique_lock guard(_producerLock);
+    _blockedProducers.fetch_add(1);
+    while (!_closed.load() && (_taskCount.load() >= getTaskLimit())) {
+        _producerCond.wait(guard);
+    }
+    _blockedProducers.fetch_sub(1);
+}
+
+WorkStealingExecutor::Task::UP
+WorkStealingExecutor::execute(Task::UP task)
+{
+    wait_for_room();
+    if (_closed.load(std::memory_order_relaxed)) {
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return task;
+    }
+    uint32_t taskCount = _taskCount.fetch_add(1) + 1;
+    uint32_t epoch = start_epoch();
+    if (_closed.load()) {
+        // shut down while we were getting here; a sync may not wait for us
+        complete_task(epoch);
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return task;
+    }
+    uint32_t queue = owns_this_thread()
+                     ? _selfId
+                     : (_nextQueue.fetch_add(1, std::memory_order_relaxed) % _workers.size());
+    Worker &worker = *_workers[queue];
+    {
+        std::lock_guard guard(worker.lock);
+        worker.tasks.emplace_back(std::move(task), epoch);
+        ++worker.stats.acceptedTasks;
+        worker.stats.queueSize.add(taskCount);
+        _queued.fetch_add(1);
+    }
+    if (_idleWorkers.load() > 0) {
+        std::lock_guard guard(_idleLock);
+        _idleCond.notify_one();
+    }
+    return task;
+}
+
+bool
+WorkStealingExecutor::take_task(uint32_t self, TaggedTask &task)
+{
+    const uint32_t numWorkers = _workers.size();
+    {
+        Worker &own = *_workers[self];
+        std::lock_guard guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            _queued.fetch_sub(1);
+            return true;
+        }
+    }
+    for (uint32_t i = 1; i < numWorkers; ++i) {
+        Worker &victim = *_workers[(self + i) % numWorkers];
+        std::lock_guard guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            _queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+WorkStealingExecutor::wait_for_task()
+{
+    std::unique_lock guard(_idleLock);
+    _idleWorkers.fetch_add(1);
+    while ((_queued.load() == 0) && !_stopped.load()) {
+        _idleCond.wait(guard);
+    }
+    _idleWorkers.fetch_sub(1);
+    return (_queued.load() > 0);
+}
+
+void
+WorkStealingExecutor::run()
+{
+    const uint32_t self = _nextWorkerId.fetch_add(1);
+    assert(self < _workers.size());
+    _master = this;
+    _selfId = self;
+    TaggedTask task;
+    for (;;) {
+        if (take_task(self, task)) {
+            task.task->run();
+            task.task.reset();
+            complete_task(task.epoch);
+        } else if (!wait_for_task()) {
+            break;
+        }
+    }
+    _master = nullptr;
+}
+
+WorkStealingExecutor &
+WorkStealingExecutor::sync()
+{
+    std::lock_guard syncGuard(_syncLock);
+    uint32_t epoch = _epoch.fetch_add(1);
+    std::unique_lock guard(_syncWaitLock);
+    _syncWaiting = true;
+    while (_pending[epoch & 1].load() != 0) {
+        _syncCond.wait(guard);
+    }
+    _syncWaiting = false;
+    return *this;
+}
+
+WorkStealingExecutor &
+WorkStealingExecutor::shutdown()
+{
+    _closed = true;
+    {
+        std::lock_guard guard(_producerLock);
+        _producerCond.notify_all();
+    }
+    return *this;
+}
+
+WorkStealingExecutor::Stats
+WorkStealingExecutor::getStats()
+{
+    Stats stats;
+    for (auto &worker : _workers) {
+        std::lock_guard guard(worker->lock);
+        stats.acceptedTasks += worker->stats.acceptedTasks;
+        stats.queueSize.add(worker->stats.queueSize);
+        worker->stats = Stats();
+    }
+    stats.rejectedTasks = _rejected.exchange(0, std::memory_order_relaxed);
+    return stats;
+}
+
+}
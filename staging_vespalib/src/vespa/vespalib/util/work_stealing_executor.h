@@ -0,0 +1,100 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <vespa/vespalib/util/runnable.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class FastOS_ThreadPool;
+
+namespace vespalib {
+
+/**
+ * An executor running tasks in multiple threads, where each worker has its own
+ * task queue. Tasks posted from outside are spread round-robin over the workers,
+ * tasks posted by a worker go to its own queue, and a worker that runs out of tasks
+ * steals from the back of the other queues. There is no lock shared by all
+ * producers and consumers, which makes it suited for very high task rates.
+ *
+ * Like BlockingThreadStackExecutor, a producer is blocked while the number of
+ * accepted, but not yet completed, tasks is at the task limit. Worker threads are
+ * never blocked to avoid deadlock. The limit is checked without locking, so it may
+ * be exceeded by a few tasks when many producers race for the last slot.
+ */
+class WorkStealingExecutor final : public SyncableThreadExecutor,
+                                   public Runnable
+{
+public:
+    using init_fun_t = std::function<int(Runnable&)>;
+
+    WorkStealingExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit);
+    WorkStealingExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit, init_fun_t init_fun);
+    ~WorkStealingExecutor() override;
+
+    Task::UP execute(Task::UP task) override;
+    WorkStealingExecutor & sync() override;
+    WorkStealingExecutor & shutdown() override;
+    size_t getNumThreads() const override;
+    Stats getStats() override;
+    void setTaskLimit(uint32_t taskLimit) override;
+    void wakeup() override;
+    uint32_t getTaskLimit() const { return _taskLimit.load(std::memory_order_relaxed); }
+private:
+    struct TaggedTask {
+        Task::UP task;
+        uint32_t epoch;
+        TaggedTask() : task(), epoch(0) {}
+        TaggedTask(Task::UP task_in, uint32_t epoch_in) : task(std::move(task_in)), epoch(epoch_in) {}
+    };
+    struct Worker {
+        std::mutex             lock;
+        std::deque<TaggedTask> tasks;
+        Stats                  stats;
+        Worker();
+        ~Worker();
+    };
+    struct ThreadInit;
+
+    void run() override;
+    bool owns_this_thread() const;
+    bool take_task(uint32_t self, TaggedTask &task);
+    bool wait_for_task();
+    void wait_for_room();
+    uint32_t start_epoch();
+    void complete_epoch(uint32_t epoch);
+    void complete_task(uint32_t epoch);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::unique_ptr<FastOS_ThreadPool>   _pool;
+    std::unique_ptr<ThreadInit>          _thread_init;
+    std::atomic<uint32_t>                _nextWorkerId;
+    std::atomic<uint32_t>                _nextQueue;
+    std::atomic<uint64_t>                _queued;       // tasks waiting in the worker queues
+    std::atomic<uint32_t>                _taskCount;    // accepted and not completed
+    std::atomic<uint32_t>                _taskLimit;
+    std::atomic<size_t>                  _rejected;
+    std::atomic<bool>                    _closed;
+    std::atomic<bool>                    _stopped;      // workers may exit, set after the final sync
+    std::atomic<uint32_t>                _idleWorkers;
+    std::mutex                           _idleLock;
+    std::condition_variable              _idleCond;
+    std::atomic<uint32_t>                _blockedProducers;
+    std::mutex                           _producerLock;
+    std::condition_variable              _producerCond;
+    std::atomic<uint32_t>                _epoch;
+    std::atomic<uint32_t>                _pending[2];   // tasks not completed per epoch parity
+    std::atomic<bool>                    _syncWaiting;
+    std::mutex                           _syncLock;     // serializes sync calls
+    std::mutex                           _syncWaitLock;
+    std::condition_variable              _syncCond;
+    static thread_local const WorkStealingExecutor *_master;
+    static thread_local uint32_t                    _selfId;
+};
+
+}
@@ -0,0 +1,49 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/bucket/bucketid.h>
+#include <vespa/storage/common/bucket_stripe_utils.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using document::BucketId;
+using namespace ::testing;
+
+namespace storage {
+
+TEST(BucketStripeUtilsTest, stripe_of_bucket_key_uses_least_significant_bucket_bits) {
+    EXPECT_EQ(0, stripe_of_bucket_key(BucketId(16, 0x1234).toKey(), 0));
+    EXPECT_EQ(0, stripe_of_bucket_key(BucketId(16, 0x1234).toKey(), 1));
+    EXPECT_EQ(1, stripe_of_bucket_key(BucketId(16, 0x1235).toKey(), 1));
+    // Bits are reversed: bucket LSB 0b01 maps to stripe 0b10
+    EXPECT_EQ(2, stripe_of_bucket_key(BucketId(16, 0x1231).toKey(), 2));
+    EXPECT_EQ(1, stripe_of_bucket_key(BucketId(16, 0x1232).toKey(), 2));
+    EXPECT_EQ(255, stripe_of_bucket_key(BucketId(16, 0xffff).toKey(), MaxStripeBits));
+}
+
+TEST(BucketStripeUtilsTest, split_buckets_stay_in_the_same_stripe) {
+    BucketId parent(8, 0x5a);
+    uint64_t stripe = stripe_of_bucket_key(parent.toKey(), MaxStripeBits);
+    EXPECT_EQ(stripe, stripe_of_bucket_key(BucketId(9, 0x05a).toKey(), MaxStripeBits));
+    EXPECT_EQ(stripe, stripe_of_bucket_key(BucketId(9, 0x15a).toKey(), MaxStripeBits));
+    EXPECT_EQ(stripe, stripe_of_bucket_key(BucketId(32, 0xabcd005a).toKey(), MaxStripeBits));
+}
+
+TEST(BucketStripeUtilsTest, num_stripe_bits_is_log2_of_stripe_count) {
+    EXPECT_EQ(0, calc_num_stripe_bits(1));
+    EXPECT_EQ(1, calc_num_stripe_bits(2));
+    EXPECT_EQ(2, calc_num_stripe_bits(4));
+    EXPECT_EQ(7, calc_num_stripe_bits(128));
+    EXPECT_EQ(8, calc_num_stripe_bits(256));
+}
+
+TEST(BucketStripeUtilsTest, stripe_count_is_adjusted_to_power_of_2_within_limits) {
+    EXPECT_EQ(1, adjusted_num_stripes(0));
+    EXPECT_EQ(1, adjusted_num_stripes(1));
+    EXPECT_EQ(2, adjusted_num_stripes(2));
+    EXPECT_EQ(4, adjusted_num_stripes(3));
+    EXPECT_EQ(16, adjusted_num_stripes(16));
+    EXPECT_EQ(32, adjusted_num_stripes(17));
+    EXPECT_EQ(256, adjusted_num_stripes(256));
+    EXPECT_EQ(256, adjusted_num_stripes(1000));
+}
+
+}
@@ -1501,6 +1501,22 @@ TEST_F(BucketDBUpdaterTest, pending_cluster_state_send_messages) {
     EXPECT_EQ(std::string(""),
               getSentNodes("distributor:3 storage:3",
                            "distributor:3 storage:3 .1.s:m"));
+
+    EXPECT_EQ(std::string(""),
+              getSentNodes("distributor:3 storage:3",
+                           "distributor:3 storage:3 .1.s:r"));
+
+    EXPECT_EQ(std::string(""),
+              getSentNodes("distributor:3 storage:3 .1.s:r",
+                           "distributor:3 storage:3"));
+
+    EXPECT_EQ(std::string(""),
+              getSentNodes("distributor:3 storage:3",
+                           "distributor:3 storage:3 .1.c:2.0"));
+
+    EXPECT_EQ(getNodeList({1}),
+              getSentNodes("distributor:3 storage:3",
+                           "distributor:3 storage:3 .1.s:r .1.d:3 .1.d.1.s:d"));
 };
 
 TEST_F(BucketDBUpdaterTest, pending_cluster_state_receive) {
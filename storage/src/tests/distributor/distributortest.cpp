@@ -194,6 +194,12 @@ struct DistributorTest : Test, DistributorTestUtil {
         configureDistributor(builder);
     }
 
+    void configure_concurrent_client_gets_enabled(bool enabled) {
+        ConfigBuilder builder;
+        builder.enableConcurrentClientGets = enabled;
+        configureDistributor(builder);
+    }
+
     void configure_metadata_update_phase_enabled(bool enabled) {
         ConfigBuilder builder;
         builder.enableMetadataOnlyFetchPhaseForInconsistentUpdates = enabled;
@@ -1077,6 +1083,19 @@ TEST_F(DistributorTest, stale_reads_config_is_propagated_to_external_operation_h
     EXPECT_FALSE(getExternalOperationHandler().concurrent_gets_enabled());
 }
 
+TEST_F(DistributorTest, concurrent_client_gets_config_is_propagated_to_external_operation_handler) {
+    createLinks();
+    setupDistributor(Redundancy(1), NodeCount(1), "distributor:1 storage:1");
+
+    configure_concurrent_client_gets_enabled(true);
+    EXPECT_TRUE(getConfig().enable_concurrent_client_gets());
+    EXPECT_TRUE(getExternalOperationHandler().concurrent_gets_enabled());
+
+    configure_concurrent_client_gets_enabled(false);
+    EXPECT_FALSE(getConfig().enable_concurrent_client_gets());
+    EXPECT_FALSE(getExternalOperationHandler().concurrent_gets_enabled());
+}
+
 TEST_F(DistributorTest, fast_path_on_consistent_gets_config_is_propagated_to_internal_config) {
     createLinks();
     setupDistributor(Redundancy(1), NodeCount(1), "distributor:1 storage:1");
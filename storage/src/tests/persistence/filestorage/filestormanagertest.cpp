@@ -2020,6 +2020,22 @@ TEST_F(FileStorManagerTest, put_command_size_is_added_to_metric) {
     assert_request_size_set(c, std::move(cmd), thread_metrics_of(*c.manager)->put[defaultLoadType]);
 }
 
+TEST_F(FileStorManagerTest, put_latency_is_added_to_histogram_metric) {
+    TestFileStorComponents c(*this);
+    document::BucketId bucket(16, 4000);
+    createBucket(bucket, 0);
+    auto cmd = std::make_shared<api::PutCommand>(
+            makeDocumentBucket(bucket), _node->getTestDocMan().createRandomDocument(), api::Timestamp(12345));
+    cmd->setAddress(api::StorageMessageAddress("storage", lib::NodeType::STORAGE, 3));
+    c.top.sendDown(cmd);
+    c.top.waitForMessages(1, _waitTime);
+
+    const auto& metric = thread_metrics_of(*c.manager)->put[defaultLoadType];
+    EXPECT_EQ(1.0, metric.latency.getCount());
+    EXPECT_EQ(1u, metric.latency_histogram.getCount());
+    EXPECT_NEAR(metric.latency.getMaximum(), metric.latency_histogram.getMaximum(), 0.01);
+}
+
 TEST_F(FileStorManagerTest, update_command_size_is_added_to_metric) {
     TestFileStorComponents c(*this);
     document::BucketId bucket(16, 4000);
@@ -2128,4 +2144,30 @@ TEST_F(FileStorManagerTest, bucket_db_is_populated_from_provider_when_initialize
     EXPECT_EQ(reported_state->getState(), lib::State::UP);
 }
 
+TEST_F(FileStorManagerTest, bucket_db_init_fetches_bucket_info_for_all_bucket_ranges) {
+    TestFileStorComponents c(*this);
+    std::vector<std::pair<spi::Bucket, spi::BucketInfo>> buckets;
+    for (uint32_t i = 1; i <= 500; ++i) {
+        buckets.emplace_back(make_spi_bucket(i), make_dummy_spi_bucket_info(i));
+    }
+    std::sort(buckets.begin(), buckets.end(), [](auto& lhs, auto& rhs) {
+        return (lhs.first.getBucketId().toKey() < rhs.first.getBucketId().toKey());
+    });
+
+    getDummyPersistence().set_fake_bucket_set(buckets);
+    c.manager->initialize_bucket_databases_from_provider();
+
+    std::vector<std::pair<document::BucketId, api::BucketInfo>> from_db;
+    auto& default_db = _node->content_bucket_db(document::FixedBucketSpaces::default_space());
+    default_db.acquire_read_guard()->for_each([&from_db](uint64_t key, auto& entry) {
+        from_db.emplace_back(document::BucketId::keyToBucketId(key), entry.info);
+    });
+    ASSERT_EQ(from_db.size(), buckets.size());
+    for (size_t i = 0; i < from_db.size(); ++i) {
+        EXPECT_EQ(from_db[i].first, buckets[i].first.getBucket().getBucketId());
+        EXPECT_EQ(from_db[i].second, PersistenceUtil::convertBucketInfo(buckets[i].second));
+    }
+    EXPECT_EQ(_node->getStateUpdater().getReportedNodeState()->getInitProgress(), 1.0);
+}
+
 } // storage
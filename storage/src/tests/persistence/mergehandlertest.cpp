@@ -1176,4 +1176,38 @@ TEST_F(MergeHandlerTest, remove_put_on_existing_timestamp) {
     EXPECT_TRUE(foundTimestamp);
 }
 
+TEST_F(MergeHandlerTest, compressed_payload_is_filled_and_applied) {
+    document::TestDocMan docMan;
+    document::Document::SP doc(docMan.createDocument(std::string(10000, 'x'), "id:test:testdoctype1:n=1234:compressible"));
+    spi::Timestamp ts(10111);
+    doPut(doc, ts);
+
+    MergeHandler handler(getEnv(), getPersistenceProvider(),
+                         getEnv()._component.getClusterName(), getEnv()._component.getClock(),
+                         0x400000, true, 64,
+                         vespalib::compression::CompressionConfig(vespalib::compression::CompressionConfig::LZ4));
+    std::vector<api::ApplyBucketDiffCommand::Entry> diff;
+    {
+        api::ApplyBucketDiffCommand::Entry e;
+        e._entry._timestamp = ts;
+        e._entry._hasMask = 0x1;
+        e._entry._flags = MergeHandler::IN_USE;
+        diff.push_back(e);
+    }
+    spi::Bucket bucket(_bucket);
+    handler.fetchLocalData(bucket, documentapi::LoadType::DEFAULT, diff, 0, *_context);
+    ASSERT_TRUE(diff[0].filled());
+    vespalib::nbostream serialized;
+    doc->serialize(serialized);
+    EXPECT_LT(diff[0]._headerBlob.size(), serialized.size());
+
+    // Apply the compressed entry as a new timestamp on a node lacking it
+    diff[0]._entry._timestamp = ts + 1;
+    handler.applyDiffLocally(bucket, documentapi::LoadType::DEFAULT, diff, 1, *_context);
+    spi::GetResult result = doGet(_bucket.getBucketId(), doc->getId());
+    ASSERT_TRUE(result.hasDocument());
+    EXPECT_EQ(spi::Timestamp(ts + 1), result.getTimestamp());
+    EXPECT_EQ(*doc, result.getDocument());
+}
+
 } // storage
@@ -5,6 +5,7 @@
 #include <tests/persistence/filestorage/forwardingmessagesender.h>
 #include <vespa/document/test/make_document_bucket.h>
 #include <vespa/document/fieldset/fieldsets.h>
+#include <vespa/storage/persistence/messages.h>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".persistencequeuetest");
@@ -18,6 +19,7 @@ class PersistenceQueueTest : public FileStorTestFixture {
 public:
     std::shared_ptr<api::StorageMessage> createPut(uint64_t bucket, uint64_t docIdx);
     std::shared_ptr<api::StorageMessage> createGet(uint64_t bucket) const;
+    std::shared_ptr<api::StorageMessage> createGetIter(uint64_t bucket) const;
 
     void SetUp() override;
 
@@ -81,6 +83,13 @@ std::shared_ptr<api::StorageMessage> PersistenceQueueTest::createGet(uint64_t bu
     return cmd;
 }
 
+std::shared_ptr<api::StorageMessage> PersistenceQueueTest::createGetIter(uint64_t bucket) const {
+    auto cmd = std::make_shared<GetIterCommand>(makeDocumentBucket(document::BucketId(16, bucket)),
+                                                spi::IteratorId(1), 1024);
+    cmd->setAddress(makeSelfAddress());
+    return cmd;
+}
+
 TEST_F(PersistenceQueueTest, fetch_next_unlocked_message_if_bucket_locked) {
     Fixture f(*this);
     // Send 2 puts, 2 to the first bucket, 1 to the second. Calling
@@ -164,4 +173,64 @@ TEST_F(PersistenceQueueTest, exclusive_locked_operation_not_started_if_exclusive
     ASSERT_FALSE(lock1.first.get());
 }
 
+TEST_F(PersistenceQueueTest, active_visitor_iterations_are_limited_per_stripe) {
+    Fixture f(*this);
+
+    f.filestorHandler->schedule(createGetIter(1234));
+    f.filestorHandler->schedule(createGetIter(5432));
+    f.filestorHandler->schedule(createPut(7890, 0));
+
+    auto lock0 = f.filestorHandler->getNextMessage(f.stripeId);
+    ASSERT_TRUE(lock0.first.get());
+    EXPECT_EQ(GetIterCommand::ID, lock0.second->getType().getId());
+
+    // With a single thread the stripe only allows one active iteration,
+    // so the put is processed ahead of the second iteration.
+    auto lock1 = f.filestorHandler->getNextMessage(f.stripeId);
+    ASSERT_TRUE(lock1.first.get());
+    EXPECT_EQ(api::MessageType::PUT_ID, lock1.second->getType().getId());
+
+    // Expected to time out
+    auto lock2 = f.filestorHandler->getNextMessage(f.stripeId);
+    ASSERT_FALSE(lock2.first.get());
+
+    lock0.first.reset();
+    auto lock3 = f.filestorHandler->getNextMessage(f.stripeId);
+    ASSERT_TRUE(lock3.first.get());
+    EXPECT_EQ(GetIterCommand::ID, lock3.second->getType().getId());
+}
+
+TEST_F(PersistenceQueueTest, feed_operations_to_locked_bucket_can_be_fetched_without_relocking) {
+    Fixture f(*this);
+
+    f.filestorHandler->schedule(createPut(1234, 0));
+    f.filestorHandler->schedule(createPut(5432, 0));
+    f.filestorHandler->schedule(createPut(1234, 1));
+
+    auto lock0 = f.filestorHandler->getNextMessage(f.stripeId);
+    ASSERT_TRUE(lock0.first.get());
+    EXPECT_EQ(document::BucketId(16, 1234), lock0.first->getBucket().getBucketId());
+
+    auto msg1 = f.filestorHandler->getNextMessageForLockedBucket(*lock0.first);
+    ASSERT_TRUE(msg1);
+    EXPECT_EQ(document::BucketId(16, 1234), dynamic_cast<api::PutCommand&>(*msg1).getBucketId());
+    EXPECT_FALSE(f.filestorHandler->getNextMessageForLockedBucket(*lock0.first));
+
+    auto lock1 = f.filestorHandler->getNextMessage(f.stripeId);
+    ASSERT_TRUE(lock1.first.get());
+    EXPECT_EQ(document::BucketId(16, 5432), lock1.first->getBucket().getBucketId());
+}
+
+TEST_F(PersistenceQueueTest, operations_are_not_fetched_for_shared_locked_bucket) {
+    Fixture f(*this);
+
+    f.filestorHandler->schedule(createGet(1234));
+    f.filestorHandler->schedule(createPut(1234, 0));
+
+    auto lock0 = f.filestorHandler->getNextMessage(f.stripeId);
+    ASSERT_TRUE(lock0.first.get());
+    EXPECT_EQ(api::LockingRequirements::Shared, lock0.first->lockingRequirements());
+    EXPECT_FALSE(f.filestorHandler->getNextMessageForLockedBucket(*lock0.first));
+}
+
 } // namespace storage
@@ -10,6 +10,7 @@
 #include <vespa/storage/persistence/messages.h>
 #include <vespa/storageapi/message/bucket.h>
 #include <vespa/storageapi/message/state.h>
+#include <vespa/messagebus/dynamicthrottlepolicy.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <unordered_set>
@@ -242,6 +243,25 @@ TEST_F(MergeThrottlerTest, merges_config) {
     }
 }
 
+TEST_F(MergeThrottlerTest, dynamic_throttling_policy_can_be_configured) {
+    using StorServerConfigBuilder = vespa::config::content::core::StorServerConfigBuilder;
+    StorServerConfigBuilder builder;
+    builder.maxMergesPerNode = 64;
+    builder.mergeThrottlingPolicy.type = StorServerConfigBuilder::MergeThrottlingPolicy::Type::DYNAMIC;
+    builder.mergeThrottlingPolicy.minWindowSize = 8;
+    _throttlers[0]->configure(std::make_unique<vespa::config::content::core::StorServerConfig>(builder));
+    {
+        auto* policy = dynamic_cast<const mbus::DynamicThrottlePolicy*>(&_throttlers[0]->getThrottlePolicy());
+        ASSERT_TRUE(policy != nullptr);
+        EXPECT_DOUBLE_EQ(8.0, policy->getMinWindowSize());
+        EXPECT_DOUBLE_EQ(64.0, policy->getMaxWindowSize());
+    }
+    builder.mergeThrottlingPolicy.type = StorServerConfigBuilder::MergeThrottlingPolicy::Type::STATIC;
+    _throttlers[0]->configure(std::make_unique<vespa::config::content::core::StorServerConfig>(builder));
+    EXPECT_TRUE(dynamic_cast<const mbus::DynamicThrottlePolicy*>(&_throttlers[0]->getThrottlePolicy()) == nullptr);
+    EXPECT_EQ(64, _throttlers[0]->getThrottlePolicy().getMaxPendingCount());
+}
+
 // Test that a distributor sending a merge to the lowest-index storage
 // node correctly invokes a merge forwarding chain and subsequent unwind.
 TEST_F(MergeThrottlerTest, chain) {
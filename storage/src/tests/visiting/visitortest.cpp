@@ -855,6 +855,34 @@ TEST_F(VisitorTest, no_more_iterators_sent_while_memory_used_above_limit) {
     ASSERT_TRUE(waitUntilNoActiveVisitors());
 }
 
+TEST_F(VisitorTest, iterator_block_size_is_bounded_by_memory_usage_limit) {
+    initializeTest(TestParams().maxVisitorMemoryUsage(4096)
+                               .parallelBuckets(1));
+    auto cmd = makeCreateVisitor();
+    _top->sendDown(cmd);
+    sendCreateIteratorReply();
+
+    GetIterCommand::SP getIterCmd;
+    ASSERT_NO_FATAL_FAILURE(fetchSingleCommand<GetIterCommand>(*_bottom, getIterCmd));
+    // Default doc block size in test config is 8192
+    EXPECT_EQ(4096u, getIterCmd->getMaxByteSize());
+    sendGetIterReply(*getIterCmd,
+                     api::ReturnCode(api::ReturnCode::OK),
+                     1,
+                     true);
+
+    std::vector<document::Document::SP> docs;
+    std::vector<document::DocumentId> docIds;
+    std::vector<std::string> infoMessages;
+    getMessagesAndReply(1, getSession(0), docs, docIds, infoMessages);
+
+    DestroyIteratorCommand::SP destroyIterCmd;
+    ASSERT_NO_FATAL_FAILURE(fetchSingleCommand<DestroyIteratorCommand>(*_bottom, destroyIterCmd));
+
+    ASSERT_NO_FATAL_FAILURE(verifyCreateVisitorReply(api::ReturnCode::OK));
+    ASSERT_TRUE(waitUntilNoActiveVisitors());
+}
+
 void
 VisitorTest::doTestVisitorInstanceHasConsistencyLevel(
         vespalib::stringref visitorType,
@@ -0,0 +1,34 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bucket_stripe_utils.h"
+#include <vespa/vespalib/util/alloc.h>
+#include <cassert>
+
+namespace storage {
+
+uint8_t
+calc_num_stripe_bits(uint32_t n_stripes) noexcept
+{
+    assert(n_stripes > 0);
+    assert(n_stripes <= (1u << MaxStripeBits));
+    assert((n_stripes & (n_stripes - 1)) == 0);
+    uint8_t bits = 0;
+    while ((1u << bits) < n_stripes) {
+        ++bits;
+    }
+    return bits;
+}
+
+uint32_t
+adjusted_num_stripes(uint32_t n_stripes) noexcept
+{
+    if (n_stripes <= 1) {
+        return 1;
+    }
+    if (n_stripes >= (1u << MaxStripeBits)) {
+        return (1u << MaxStripeBits);
+    }
+    return vespalib::roundUp2inN(n_stripes);
+}
+
+}
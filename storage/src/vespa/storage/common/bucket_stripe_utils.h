@@ -0,0 +1,40 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace storage {
+
+/**
+ * Utilities for partitioning the bucket key space into stripes, where
+ * each stripe owns a contiguous range of the (bit reversed) bucket
+ * keys used by the bucket databases. A bucket with at least
+ * MaxStripeBits used bits always maps to exactly one stripe.
+ */
+constexpr uint8_t MaxStripeBits = 8;
+
+/**
+ * Returns the stripe the given bucket key (as returned by
+ * document::BucketId::toKey()) belongs to.
+ */
+inline uint64_t stripe_of_bucket_key(uint64_t key, uint8_t n_stripe_bits) noexcept {
+    if (n_stripe_bits == 0) {
+        return 0;
+    }
+    return key >> (64 - n_stripe_bits);
+}
+
+/**
+ * Returns the number of bits needed to address the given number of
+ * stripes, which must be a power of 2 no larger than 2^MaxStripeBits.
+ */
+uint8_t calc_num_stripe_bits(uint32_t n_stripes) noexcept;
+
+/**
+ * Adjusts the requested number of stripes to a power of 2 in the
+ * range [1, 2^MaxStripeBits].
+ */
+uint32_t adjusted_num_stripes(uint32_t n_stripes) noexcept;
+
+}
@@ -17,7 +17,8 @@
 #include "storagelink.h"
 #include <vespa/storageframework/generic/thread/runnable.h>
 #include <vespa/vespalib/util/document_runnable.h>
-#include <deque>
+#include <vespa/vespalib/util/mpsc_queue.h>
+#include <atomic>
 #include <limits>
 #include <mutex>
 #include <condition_variable>
@@ -70,7 +71,12 @@ public:
     framework::ComponentRegister& getComponentRegister() { return _compReg; }
 
 private:
-    /** Common class to prevent need for duplicate code. */
+    /**
+     * Common class to prevent need for duplicate code. Messages are
+     * passed through a lock-free queue and the dispatch thread takes
+     * all queued messages at once. The mutex is only used to park the
+     * dispatch thread when idle, and for waiting on flush or room.
+     */
     template<typename Message>
     class Dispatcher : public framework::Runnable
     {
@@ -79,11 +85,16 @@ private:
         unsigned int _maxQueueSize;
         std::mutex              _sync;
         std::condition_variable _syncCond;
-        std::deque< std::shared_ptr<Message> > _messages;
+        vespalib::MpscQueue<std::shared_ptr<Message>> _messages;
+        std::atomic<uint32_t> _pending;   // queued or being sent
+        std::atomic<bool>     _idle;      // dispatch thread is parked or about to park
+        std::atomic<uint32_t> _waiters;   // threads waiting for _pending to drop
+        std::atomic<bool>     _started;
         bool _replyDispatcher;
         std::unique_ptr<framework::Component> _component;
         std::unique_ptr<framework::Thread> _thread;
         void terminate();
+        void wakeWaiters();
 
     public:
         Dispatcher(StorageLinkQueued& parent, unsigned int maxQueueSize, bool replyDispatcher);
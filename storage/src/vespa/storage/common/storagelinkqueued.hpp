@@ -7,6 +7,7 @@
 #include <vespa/storageframework/generic/component/component.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <sstream>
+#include <vector>
 #include <chrono>
 #include <cassert>
 
@@ -33,6 +34,10 @@ StorageLinkQueued::Dispatcher<Message>::Dispatcher(StorageLinkQueued& parent, un
       _sync(),
       _syncCond(),
       _messages(),
+      _pending(0),
+      _idle(false),
+      _waiters(0),
+      _started(false),
       _replyDispatcher(replyDispatcher)
 {
     std::ostringstream name;
@@ -54,50 +59,72 @@ void StorageLinkQueued::Dispatcher<Message>::start()
 }
 
 template<typename Message>
-void StorageLinkQueued::Dispatcher<Message>::add(const std::shared_ptr<Message>& m)
+void StorageLinkQueued::Dispatcher<Message>::wakeWaiters()
 {
-    std::unique_lock<std::mutex> guard(_sync);
+    if (_waiters.load() > 0) {
+        std::lock_guard<std::mutex> guard(_sync);
+        _syncCond.notify_all();
+    }
+}
 
-    if ( ! _thread) start();
-    while ((_messages.size() > _maxQueueSize) && !_thread->interrupted()) {
-        _syncCond.wait_for(guard, 100ms);
+template<typename Message>
+void StorageLinkQueued::Dispatcher<Message>::add(const std::shared_ptr<Message>& m)
+{
+    if ( ! _started.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> guard(_sync);
+        if ( ! _thread) start();
+        _started.store(true, std::memory_order_release);
+    }
+    if (_pending.load(std::memory_order_relaxed) > _maxQueueSize) {
+        std::unique_lock<std::mutex> guard(_sync);
+        ++_waiters;
+        while ((_pending.load() > _maxQueueSize) && !_thread->interrupted()) {
+            _syncCond.wait_for(guard, 100ms);
+        }
+        --_waiters;
+    }
+    ++_pending;
+    _messages.push(m);
+    if (_idle.load()) {
+        std::lock_guard<std::mutex> guard(_sync);
+        _syncCond.notify_all();
     }
-    _messages.push_back(m);
-    _syncCond.notify_one();
 }
 
 template<typename Message>
 void StorageLinkQueued::Dispatcher<Message>::run(framework::ThreadHandle& h)
 {
+    std::vector<std::shared_ptr<Message>> batch;
     while (!h.interrupted()) {
         h.registerTick(framework::PROCESS_CYCLE);
-        std::shared_ptr<Message> message;
-        {
+        if (_messages.pop_all(batch) == 0) {
             std::unique_lock<std::mutex> guard(_sync);
+            _idle.store(true);
             while (!h.interrupted() && _messages.empty()) {
                 _syncCond.wait_for(guard, 100ms);
                 h.registerTick(framework::WAIT_CYCLE);
             }
-            if (h.interrupted()) break;
-            message.swap(_messages.front());
+            _idle.store(false);
+            continue;
         }
-        try {
-            send(message);
-        } catch (std::exception& e) {
-            _parent.logError(vespalib::make_string(
-                    "When running command %s, caught exception %s. "
-                    "Discarding message",
-                    message->toString().c_str(),
-                    e.what()).c_str());
-        }
-
-        {
-            // Since flush() only waits for stack to be empty, we must
-            // pop stack AFTER send have been called.
-            std::lock_guard<std::mutex> guard(_sync);
-            _messages.pop_front();
-            _syncCond.notify_one();
+        for (auto & message : batch) {
+            if (h.interrupted()) break;
+            try {
+                send(message);
+            } catch (std::exception& e) {
+                _parent.logError(vespalib::make_string(
+                        "When running command %s, caught exception %s. "
+                        "Discarding message",
+                        message->toString().c_str(),
+                        e.what()).c_str());
+            }
+            message.reset();
+            // Since flush() only waits for pending to reach zero, we must
+            // count down AFTER send have been called.
+            --_pending;
         }
+        batch.clear();
+        wakeWaiters();
     }
     _parent.logDebug("Finished storage link queued thread");
 }
@@ -107,9 +134,11 @@ void StorageLinkQueued::Dispatcher<Message>::flush()
 {
     using namespace std::chrono_literals;
     std::unique_lock<std::mutex> guard(_sync);
-    while (!_messages.empty()) {
+    ++_waiters;
+    while (_pending.load() != 0) {
         _syncCond.wait_for(guard, 100ms);
     }
+    --_waiters;
 }
 
 }
@@ -242,6 +242,13 @@ public:
         return _enable_metadata_only_fetch_phase_for_inconsistent_updates;
     }
 
+    void set_enable_concurrent_client_gets(bool enable) noexcept {
+        _enable_concurrent_client_gets = enable;
+    }
+    bool enable_concurrent_client_gets() const noexcept {
+        return _enable_concurrent_client_gets;
+    }
+
     uint32_t max_consecutively_inhibited_maintenance_ticks() const noexcept {
         return _max_consecutively_inhibited_maintenance_ticks;
     }
@@ -294,6 +301,7 @@ private:
     bool _merge_operations_disabled;
     bool _use_weak_internal_read_consistency_for_client_gets;
     bool _enable_metadata_only_fetch_phase_for_inconsistent_updates;
+    bool _enable_concurrent_client_gets;
 
     DistrConfig::MinimumReplicaCountingMode _minimumReplicaCountingMode;
     
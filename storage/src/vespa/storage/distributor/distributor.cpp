@@ -888,7 +888,8 @@ Distributor::enableNextConfig()
     _pendingMessageTracker.setNodeBusyDuration(getConfig().getInhibitMergesOnBusyNodeDuration());
     _bucketDBUpdater.set_stale_reads_enabled(getConfig().allowStaleReadsDuringClusterStateTransitions());
     _externalOperationHandler.set_concurrent_gets_enabled(
-            getConfig().allowStaleReadsDuringClusterStateTransitions());
+            getConfig().allowStaleReadsDuringClusterStateTransitions()
+            || getConfig().enable_concurrent_client_gets());
     _externalOperationHandler.set_use_weak_internal_read_consistency_for_gets(
             getConfig().use_weak_internal_read_consistency_for_client_gets());
 }
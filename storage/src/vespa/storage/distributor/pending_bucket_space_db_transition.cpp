@@ -16,6 +16,27 @@ using lib::Node;
 using lib::NodeType;
 using lib::NodeState;
 
+namespace {
+
+/**
+ * A storage node moving between up and retired (or changing capacity)
+ * keeps all its buckets and keeps receiving feed through this
+ * distributor, so the bucket info already in the database is still valid.
+ */
+bool
+stateChangePreservesBucketInfo(const NodeState& oldState, const NodeState& newState)
+{
+    if (!oldState.getState().oneOf("ur") || !newState.getState().oneOf("ur")) {
+        return false;
+    }
+    NodeState adjusted(oldState);
+    adjusted.setState(newState.getState());
+    adjusted.setCapacity(newState.getCapacity());
+    return adjusted.similarTo(newState);
+}
+
+}
+
 PendingBucketSpaceDbTransition::PendingBucketSpaceDbTransition(const PendingClusterState &pendingClusterState,
                                                                DistributorBucketSpace &distributorBucketSpace,
                                                                bool distributionChanged,
@@ -369,7 +390,7 @@ PendingBucketSpaceDbTransition::storageNodeChanged(uint16_t index) {
     NodeState oldNodeState = _prevClusterState.getNodeState(node);
 
     // similarTo() also covers disk states.
-    if (!(oldNodeState.similarTo(newState))) {
+    if (!(oldNodeState.similarTo(newState)) && !stateChangePreservesBucketInfo(oldNodeState, newState)) {
         LOG(debug,
                 "State for storage node %d has changed from '%s' to '%s', "
                 "updating bucket information",
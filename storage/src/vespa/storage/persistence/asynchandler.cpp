@@ -3,9 +3,13 @@
 #include "asynchandler.h"
 #include "persistenceutil.h"
 #include "testandsethelper.h"
+#include <vespa/storage/common/bucketoperationlogger.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".persistence.asynchandler");
+
 namespace storage {
 
 namespace {
@@ -120,6 +124,30 @@ AsyncHandler::handlePut(api::PutCommand& cmd, MessageTracker::UP trackerUP) cons
     return trackerUP;
 }
 
+MessageTracker::UP
+AsyncHandler::handleCreateBucket(api::CreateBucketCommand& cmd, MessageTracker::UP trackerUP) const
+{
+    MessageTracker & tracker = *trackerUP;
+    tracker.setMetric(_env._metrics.createBuckets);
+    LOG(debug, "CreateBucket(%s)", cmd.getBucketId().toString().c_str());
+    if (_env._fileStorHandler.isMerging(cmd.getBucket())) {
+        LOG(warning, "Bucket %s was merging at create time. Unexpected.", cmd.getBucketId().toString().c_str());
+        DUMP_LOGGED_BUCKET_OPERATIONS(cmd.getBucketId());
+    }
+    spi::Bucket bucket(cmd.getBucket());
+    bool activate = cmd.getActive();
+    auto task = makeResultTask([this, bucket, activate, tracker = std::move(trackerUP)](spi::Result::UP response) {
+        if (tracker->checkForError(*response) && activate) {
+            _spi.setActiveState(bucket, spi::BucketInfo::ACTIVE);
+        }
+        tracker->sendReply();
+    });
+    _spi.createBucketAsync(bucket, tracker.context(),
+                           std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
+
+    return trackerUP;
+}
+
 MessageTracker::UP
 AsyncHandler::handleUpdate(api::UpdateCommand& cmd, MessageTracker::UP trackerUP) const
 {
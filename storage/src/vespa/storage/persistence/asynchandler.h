@@ -3,6 +3,7 @@
 
 #include "types.h"
 #include <vespa/storageapi/message/persistence.h>
+#include <vespa/storageapi/message/bucket.h>
 
 namespace document { class BucketIdFactory; }
 namespace vespalib { class ISequencedTaskExecutor; }
@@ -25,6 +26,7 @@ public:
     MessageTrackerUP handlePut(api::PutCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleRemove(api::RemoveCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleUpdate(api::UpdateCommand& cmd, MessageTrackerUP tracker) const;
+    MessageTrackerUP handleCreateBucket(api::CreateBucketCommand& cmd, MessageTrackerUP tracker) const;
 private:
     static bool tasConditionExists(const api::TestAndSetCommand & cmd);
     bool tasConditionMatches(const api::TestAndSetCommand & cmd, MessageTracker & tracker,
@@ -110,6 +110,16 @@ public:
      */
     virtual LockedMessage getNextMessage(uint32_t stripeId) = 0;
 
+    /**
+     * Used by file stor threads to fetch the next queued feed operation
+     * (put, remove, update or revert) to a bucket they already hold an
+     * exclusive lock on, so that consecutive operations to the same bucket
+     * can be processed without releasing and reacquiring the lock.
+     *
+     * @return the message, or nullptr if there is none for the bucket.
+     */
+    virtual std::shared_ptr<api::StorageMessage> getNextMessageForLockedBucket(const BucketLockInterface& lock) = 0;
+
     /**
      * Lock a bucket. By default, each file stor thread has the locks of all
      * buckets in their area of responsibility. If they need to access buckets
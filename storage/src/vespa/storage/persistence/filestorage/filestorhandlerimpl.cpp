@@ -54,6 +54,7 @@ FileStorHandlerImpl::FileStorHandlerImpl(uint32_t numThreads, uint32_t numStripe
       _bucketIdFactory(_component.getBucketIdFactory()),
       _getNextMessageTimeout(100ms),
       _max_active_merges_per_stripe(per_stripe_merge_limit(numThreads, numStripes)),
+      _max_active_iterators_per_stripe(per_stripe_merge_limit(numThreads, numStripes)),
       _paused(false)
 {
     assert(numStripes > 0);
@@ -365,6 +366,17 @@ FileStorHandlerImpl::getNextMessage(uint32_t stripeId)
     return getNextMessage(stripeId, _getNextMessageTimeout);
 }
 
+std::shared_ptr<api::StorageMessage>
+FileStorHandlerImpl::getNextMessageForLockedBucket(const BucketLockInterface& lock)
+{
+    if ((lock.lockingRequirements() != api::LockingRequirements::Exclusive) ||
+        (lock.getBucket().getBucketId().getRawId() == 0) || isClosed() || isPaused())
+    {
+        return {};
+    }
+    return stripe(lock.getBucket()).getNextMessageForLockedBucket(lock.getBucket());
+}
+
 std::shared_ptr<FileStorHandler::BucketLockInterface>
 FileStorHandlerImpl::Stripe::lock(const document::Bucket &bucket, api::LockingRequirements lockReq) {
     std::unique_lock guard(*_lock);
@@ -874,6 +886,50 @@ FileStorHandlerImpl::dispersed_bucket_bits(const document::Bucket& bucket) noexc
     return XXH3_64bits(&raw_id, sizeof(uint64_t));
 }
 
+namespace {
+
+bool message_type_is_merge_related(api::MessageType::Id msg_type_id) {
+    switch (msg_type_id) {
+    case api::MessageType::MERGEBUCKET_ID:
+    case api::MessageType::MERGEBUCKET_REPLY_ID:
+    case api::MessageType::GETBUCKETDIFF_ID:
+    case api::MessageType::GETBUCKETDIFF_REPLY_ID:
+    case api::MessageType::APPLYBUCKETDIFF_ID:
+    case api::MessageType::APPLYBUCKETDIFF_REPLY_ID:
+        return true;
+    default: return false;
+    }
+}
+
+bool message_type_is_iterator_related(api::MessageType::Id msg_type_id) {
+    return (msg_type_id == GetIterCommand::ID);
+}
+
+bool message_type_is_batchable(api::MessageType::Id msg_type_id) {
+    switch (msg_type_id) {
+    case api::MessageType::PUT_ID:
+    case api::MessageType::REMOVE_ID:
+    case api::MessageType::UPDATE_ID:
+    case api::MessageType::REVERT_ID:
+        return true;
+    default: return false;
+    }
+}
+
+bool message_type_is_client_feed_or_read(api::MessageType::Id msg_type_id) {
+    switch (msg_type_id) {
+    case api::MessageType::PUT_ID:
+    case api::MessageType::REMOVE_ID:
+    case api::MessageType::UPDATE_ID:
+    case api::MessageType::GET_ID:
+    case api::MessageType::REVERT_ID:
+        return true;
+    default: return false;
+    }
+}
+
+}
+
 FileStorHandlerImpl::Stripe::Stripe(const FileStorHandlerImpl & owner, MessageSender & messageSender)
     : _owner(owner),
       _messageSender(messageSender),
@@ -882,7 +938,8 @@ FileStorHandlerImpl::Stripe::Stripe(const FileStorHandlerImpl & owner, MessageSe
       _cond(std::make_unique<std::condition_variable>()),
       _queue(std::make_unique<PriorityQueue>()),
       _lockedBuckets(),
-      _active_merges(0)
+      _active_merges(0),
+      _active_iterators(0)
 {}
 
 FileStorHandler::LockedMessage
@@ -910,11 +967,57 @@ FileStorHandlerImpl::Stripe::getNextMessage(vespalib::duration timeout)
     return {}; // No message fetched.
 }
 
+std::shared_ptr<api::StorageMessage>
+FileStorHandlerImpl::Stripe::getNextMessageForLockedBucket(const document::Bucket& bucket)
+{
+    std::unique_lock guard(*_lock);
+    BucketIdx& idx(bmi::get<2>(*_queue));
+    auto range = idx.equal_range(bucket);
+    // Entries for the same bucket are kept in arrival order; pick the first
+    // one with the best priority, as getNextMessage() would have done.
+    auto iter = range.second;
+    for (auto candidate = range.first; candidate != range.second; ++candidate) {
+        if ((iter == range.second) || (candidate->_priority < iter->_priority)) {
+            iter = candidate;
+        }
+    }
+    if ((iter == range.second) || !message_type_is_batchable(iter->_command->getType().getId())) {
+        return {};
+    }
+    std::chrono::milliseconds waitTime(stopQueueTimer(*iter));
+    std::shared_ptr<api::StorageMessage> msg = std::move(iter->_command);
+    idx.erase(iter); // iter not used after this point.
+
+    if (!messageTimedOutInQueue(*msg, waitTime)) {
+        return msg;
+    }
+    std::shared_ptr<api::StorageReply> msgReply(makeQueueTimeoutReply(*msg));
+    guard.unlock();
+    _cond->notify_all();
+    _messageSender.sendReply(msgReply);
+    return {};
+}
+
+std::chrono::milliseconds
+FileStorHandlerImpl::Stripe::stopQueueTimer(const MessageEntry& entry)
+{
+    const api::StorageMessage & m(*entry._command);
+    std::chrono::milliseconds waitTime(uint64_t(entry._timer.stop(_metrics->averageQueueWaitingTime[m.getLoadType()])));
+    const auto msg_type_id = m.getType().getId();
+    if (message_type_is_client_feed_or_read(msg_type_id)) {
+        _metrics->averageClientQueueWaitingTime.addValue(waitTime.count());
+    } else if (message_type_is_merge_related(msg_type_id)) {
+        _metrics->averageMergeQueueWaitingTime.addValue(waitTime.count());
+    } else if (message_type_is_iterator_related(msg_type_id)) {
+        _metrics->averageVisitorQueueWaitingTime.addValue(waitTime.count());
+    }
+    return waitTime;
+}
+
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::getMessage(monitor_guard & guard, PriorityIdx & idx, PriorityIdx::iterator iter) {
 
-    api::StorageMessage & m(*iter->_command);
-    std::chrono::milliseconds waitTime(uint64_t(iter->_timer.stop(_metrics->averageQueueWaitingTime[m.getLoadType()])));
+    std::chrono::milliseconds waitTime(stopQueueTimer(*iter));
 
     std::shared_ptr<api::StorageMessage> msg = std::move(iter->_command);
     document::Bucket bucket(iter->_bucket);
@@ -999,23 +1102,6 @@ FileStorHandlerImpl::Stripe::flush()
     }
 }
 
-namespace {
-
-bool message_type_is_merge_related(api::MessageType::Id msg_type_id) {
-    switch (msg_type_id) {
-    case api::MessageType::MERGEBUCKET_ID:
-    case api::MessageType::MERGEBUCKET_REPLY_ID:
-    case api::MessageType::GETBUCKETDIFF_ID:
-    case api::MessageType::GETBUCKETDIFF_REPLY_ID:
-    case api::MessageType::APPLYBUCKETDIFF_ID:
-    case api::MessageType::APPLYBUCKETDIFF_REPLY_ID:
-        return true;
-    default: return false;
-    }
-}
-
-}
-
 void FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket,
                                           api::LockingRequirements reqOfReleasedLock,
                                           api::StorageMessage::Id lockMsgId) {
@@ -1036,6 +1122,10 @@ void FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket,
         assert(!entry._exclusiveLock);
         auto shared_iter = entry._sharedLocks.find(lockMsgId);
         assert(shared_iter != entry._sharedLocks.end());
+        if (message_type_is_iterator_related(shared_iter->second.msgType)) {
+            assert(_active_iterators > 0);
+            --_active_iterators;
+        }
         entry._sharedLocks.erase(shared_iter);
     }
 
@@ -1061,6 +1151,9 @@ void FileStorHandlerImpl::Stripe::lock(const monitor_guard &, const document::Bu
         auto inserted = entry._sharedLocks.insert(std::make_pair(lockEntry.msgId, lockEntry));
         (void) inserted;
         assert(inserted.second);
+        if (message_type_is_iterator_related(lockEntry.msgType)) {
+            ++_active_iterators;
+        }
     }
 }
 
@@ -1093,6 +1186,13 @@ FileStorHandlerImpl::Stripe::operationIsInhibited(const monitor_guard & guard, c
     {
         return true;
     }
+    // Visitor iteration is bounded the same way as merges, so that
+    // client operations are not starved while nodes are being visited.
+    if (message_type_is_iterator_related(msg.getType().getId())
+        && (_active_iterators >= _owner._max_active_iterators_per_stripe))
+    {
+        return true;
+    }
     return isLocked(guard, bucket, msg.lockingRequirements());
 }
 
@@ -128,6 +128,7 @@ public:
         void failOperations(const document::Bucket & bucket, const api::ReturnCode & code);
 
         FileStorHandler::LockedMessage getNextMessage(vespalib::duration timeout);
+        std::shared_ptr<api::StorageMessage> getNextMessageForLockedBucket(const document::Bucket& bucket);
         void dumpQueue(std::ostream & os) const;
         void dumpActiveHtml(std::ostream & os) const;
         void dumpQueueHtml(std::ostream & os) const;
@@ -141,6 +142,7 @@ public:
         // with its locking requirements.
         FileStorHandler::LockedMessage getMessage(monitor_guard & guard, PriorityIdx & idx,
                                                   PriorityIdx::iterator iter);
+        std::chrono::milliseconds stopQueueTimer(const MessageEntry& entry);
         using LockedBuckets = vespalib::hash_map<document::Bucket, MultiLockEntry, document::Bucket::hash>;
         const FileStorHandlerImpl      &_owner;
         MessageSender                  &_messageSender;
@@ -150,6 +152,7 @@ public:
         std::unique_ptr<PriorityQueue>  _queue;
         LockedBuckets                   _lockedBuckets;
         uint32_t                        _active_merges;
+        uint32_t                        _active_iterators;
     };
 
     class BucketLock : public FileStorHandler::BucketLockInterface {
@@ -186,6 +189,7 @@ public:
     bool schedule(const std::shared_ptr<api::StorageMessage>&) override;
 
     FileStorHandler::LockedMessage getNextMessage(uint32_t stripeId) override;
+    std::shared_ptr<api::StorageMessage> getNextMessageForLockedBucket(const BucketLockInterface& lock) override;
 
     void remapQueueAfterDiskMove(const document::Bucket& bucket) override;
     void remapQueueAfterJoin(const RemapInfo& source, RemapInfo& target) override;
@@ -241,6 +245,7 @@ private:
     std::map<document::Bucket, MergeStatus::SP> _mergeStates;
     vespalib::duration    _getNextMessageTimeout;
     const uint32_t        _max_active_merges_per_stripe; // Read concurrently by stripes.
+    const uint32_t        _max_active_iterators_per_stripe; // Read concurrently by stripes.
     mutable std::mutex              _pauseMonitor;
     mutable std::condition_variable _pauseCond;
     std::atomic<bool>               _paused;
@@ -18,8 +18,13 @@
 #include <vespa/storageapi/message/persistence.h>
 #include <vespa/storageapi/message/removelocation.h>
 #include <vespa/storageapi/message/stat.h>
-#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <atomic>
 
 #include <vespa/log/bufferedlogger.h>
 LOG_SETUP(".persistence.filestor.manager");
@@ -901,34 +906,91 @@ void FileStorManager::update_reported_state_after_db_init() {
     _component.getStateUpdater().setReportedNodeState(ns);
 }
 
+void FileStorManager::report_bucket_db_init_progress(double progress) {
+    auto state_lock = _component.getStateUpdater().grabStateChangeLock();
+    auto ns = *_component.getStateUpdater().getReportedNodeState();
+    if (progress <= ns.getInitProgress().getValue()) {
+        return;
+    }
+    ns.setInitProgress(progress);
+    _component.getStateUpdater().setReportedNodeState(ns);
+}
+
+namespace {
+
+constexpr size_t BUCKET_DB_INIT_PARTITIONS_PER_THREAD = 4;
+constexpr int BUCKET_DB_INIT_PROGRESS_INTERVAL_MS = 1000;
+
+}
+
 void FileStorManager::initialize_bucket_databases_from_provider() {
     framework::MilliSecTimer start_time(_component.getClock());
+    struct SpaceBuckets {
+        document::BucketSpace space;
+        StorBucketDatabase*   db;
+        spi::BucketIdListResult::List buckets;
+    };
+    std::vector<SpaceBuckets> spaces;
     size_t bucket_count = 0;
     for (const auto& elem : _component.getBucketSpaceRepo()) {
         const auto bucket_space = elem.first;
-        const auto bucket_result = _provider->listBuckets(bucket_space);
+        auto bucket_result = _provider->listBuckets(bucket_space);
         assert(!bucket_result.hasError());
-        const auto& buckets = bucket_result.getList();
+        auto buckets = bucket_result.getList();
         LOG(debug, "Fetching bucket info for %zu buckets in space '%s'",
             buckets.size(), elem.first.toString().c_str());
-        auto& db = elem.second->bucketDatabase();
-
         for (const auto& bucket : buckets) {
             _component.getMinUsedBitsTracker().update(bucket);
-            // TODO replace with far more efficient bulk insert API
-            auto entry = db.get(bucket, "FileStorManager::initialize_bucket_databases_from_provider",
-                                StorBucketDatabase::CREATE_IF_NONEXISTING);
-            assert(!entry.preExisted());
-            auto spi_bucket = spi::Bucket(document::Bucket(bucket_space, bucket));
-            auto provider_result = _provider->getBucketInfo(spi_bucket);
-            assert(!provider_result.hasError());
-            entry->setBucketInfo(PersistenceUtil::convertBucketInfo(provider_result.getBucketInfo()));
-            entry.write();
         }
+        // Sorting by key gives each partition a contiguous bucket range of the database.
+        std::sort(buckets.begin(), buckets.end(), [](const auto& lhs, const auto& rhs) {
+            return (lhs.toKey() < rhs.toKey());
+        });
         bucket_count += buckets.size();
+        spaces.push_back({bucket_space, &elem.second->bucketDatabase(), std::move(buckets)});
     }
+
+    // Bucket info is fetched from the provider using as many threads as there are persistence
+    // threads, since that is the concurrency the provider is already set up to handle.
+    const size_t num_threads = std::max(_threads.size(), size_t(1));
+    const size_t partition_size = std::max(bucket_count / (num_threads * BUCKET_DB_INIT_PARTITIONS_PER_THREAD), size_t(1));
+    std::vector<std::tuple<const SpaceBuckets*, size_t, size_t>> partitions;
+    for (const auto& space : spaces) {
+        for (size_t begin = 0; begin < space.buckets.size(); begin += partition_size) {
+            partitions.emplace_back(&space, begin, std::min(begin + partition_size, space.buckets.size()));
+        }
+    }
+    std::atomic<size_t> buckets_done(0);
+    vespalib::CountDownLatch latch(partitions.size());
+    vespalib::ThreadStackExecutor executor(num_threads, 128 * 1024);
+    for (const auto& partition : partitions) {
+        executor.execute(vespalib::makeLambdaTask([this, &partition, &buckets_done, &latch]() {
+            const auto& [space, begin, end] = partition;
+            for (size_t i = begin; i < end; ++i) {
+                const auto& bucket = space->buckets[i];
+                auto entry = space->db->get(bucket, "FileStorManager::initialize_bucket_databases_from_provider",
+                                            StorBucketDatabase::CREATE_IF_NONEXISTING);
+                assert(!entry.preExisted());
+                auto spi_bucket = spi::Bucket(document::Bucket(space->space, bucket));
+                auto provider_result = _provider->getBucketInfo(spi_bucket);
+                assert(!provider_result.hasError());
+                entry->setBucketInfo(PersistenceUtil::convertBucketInfo(provider_result.getBucketInfo()));
+                entry.write();
+            }
+            buckets_done.fetch_add(end - begin, std::memory_order_relaxed);
+            latch.countDown();
+        }));
+    }
+    while (!latch.await(BUCKET_DB_INIT_PROGRESS_INTERVAL_MS)) {
+        const size_t done = buckets_done.load(std::memory_order_relaxed);
+        LOG(debug, "Fetched bucket info for %zu of %zu buckets", done, bucket_count);
+        report_bucket_db_init_progress(double(done) / bucket_count);
+    }
+    executor.shutdown().sync();
+
     const double elapsed = start_time.getElapsedTimeAsDouble();
-    LOG(info, "Completed listing of %zu buckets in %.2g milliseconds", bucket_count, elapsed);
+    LOG(info, "Completed listing of %zu buckets in %.2g milliseconds using %zu threads",
+        bucket_count, elapsed, num_threads);
     _metrics->bucket_db_init_latency.addValue(elapsed);
 
     update_reported_state_after_db_init();
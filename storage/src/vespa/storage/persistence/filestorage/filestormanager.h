@@ -168,6 +168,7 @@ private:
     void updateState();
     void propagateClusterStates();
     void update_reported_state_after_db_init();
+    void report_bucket_db_init_progress(double progress);
 };
 
 } // storage
@@ -9,6 +9,12 @@ namespace storage {
 using metrics::MetricSet;
 using metrics::LoadTypeSet;
 
+namespace {
+
+constexpr double LATENCY_HISTOGRAM_RESOLUTION_MS = 0.01;
+
+}
+
 FileStorThreadMetrics::Op::Op(const std::string& id, const std::string& name, MetricSet* owner)
     : MetricSet(id, {}, name + " load in filestor thread", owner),
       _name(name),
@@ -19,6 +25,12 @@ FileStorThreadMetrics::Op::Op(const std::string& id, const std::string& name, Me
 
 FileStorThreadMetrics::Op::~Op() = default;
 
+void
+FileStorThreadMetrics::Op::addLatency(double latencyMs)
+{
+    latency.addValue(latencyMs);
+}
+
 MetricSet *
 FileStorThreadMetrics::Op::clone(std::vector<Metric::UP>& ownerList,
                                  CopyType copyType,
@@ -34,13 +46,23 @@ FileStorThreadMetrics::Op::clone(std::vector<Metric::UP>& ownerList,
 template <typename BaseOp>
 FileStorThreadMetrics::OpWithRequestSize<BaseOp>::OpWithRequestSize(const std::string& id, const std::string& name, MetricSet* owner)
         : BaseOp(id, name, owner),
-          request_size("request_size", {}, "Size of requests, in bytes", this)
+          request_size("request_size", {}, "Size of requests, in bytes", this),
+          latency_histogram("latency_histogram", {}, "Latency distribution of successful requests, in ms",
+                            LATENCY_HISTOGRAM_RESOLUTION_MS, this)
 {
 }
 
 template <typename BaseOp>
 FileStorThreadMetrics::OpWithRequestSize<BaseOp>::~OpWithRequestSize() = default;
 
+template <typename BaseOp>
+void
+FileStorThreadMetrics::OpWithRequestSize<BaseOp>::addLatency(double latencyMs)
+{
+    BaseOp::addLatency(latencyMs);
+    latency_histogram.addValue(latencyMs);
+}
+
 // FIXME this has very non-intuitive semantics, ending up with copy&paste patterns
 template <typename BaseOp>
 MetricSet*
@@ -195,7 +217,14 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
       averageQueueWaitingTime(loadTypes,
                               metrics::DoubleAverageMetric("averagequeuewait", {},
                                                            "Average time an operation spends in input queue."),
-                              this)
+                              this),
+      averageClientQueueWaitingTime("averagequeuewait_client", {},
+                                    "Average time a client put, remove, update, get or revert spends in input queue.",
+                                    this),
+      averageMergeQueueWaitingTime("averagequeuewait_merge", {},
+                                   "Average time a merge related operation spends in input queue.", this),
+      averageVisitorQueueWaitingTime("averagequeuewait_visitor", {},
+                                     "Average time a visitor iteration spends in input queue.", this)
 {
 }
 
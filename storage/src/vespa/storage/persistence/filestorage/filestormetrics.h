@@ -31,17 +31,24 @@ struct FileStorThreadMetrics : public metrics::MetricSet
 
         MetricSet * clone(std::vector<Metric::UP>& ownerList, CopyType copyType,
                           MetricSet* owner, bool includeUnused) const override;
+
+        /** Record the latency (ms) of a successful request. */
+        virtual void addLatency(double latencyMs);
     };
 
     template <typename BaseOp>
     struct OpWithRequestSize : BaseOp {
         metrics::LongAverageMetric request_size;
+        // Only tracked for the document operations, as a histogram per op type and thread is not free.
+        metrics::HistogramMetric latency_histogram;
 
         OpWithRequestSize(const std::string& id, const std::string& name, MetricSet* owner = nullptr);
         ~OpWithRequestSize() override;
 
         MetricSet * clone(std::vector<Metric::UP>& ownerList, CopyType copyType,
                           MetricSet* owner, bool includeUnused) const override;
+
+        void addLatency(double latencyMs) override;
     };
 
     template <typename BaseOp>
@@ -130,6 +137,9 @@ class FileStorStripeMetrics : public metrics::MetricSet
 public:
     using SP = std::shared_ptr<FileStorStripeMetrics>;
     metrics::LoadMetric<metrics::DoubleAverageMetric> averageQueueWaitingTime;
+    metrics::DoubleAverageMetric averageClientQueueWaitingTime;
+    metrics::DoubleAverageMetric averageMergeQueueWaitingTime;
+    metrics::DoubleAverageMetric averageVisitorQueueWaitingTime;
     FileStorStripeMetrics(const std::string& name, const std::string& description,
                           const metrics::LoadTypeSet& loadTypes);
     ~FileStorStripeMetrics() override;
@@ -7,6 +7,8 @@
 #include <vespa/document/fieldset/fieldsets.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <algorithm>
 
 #include <vespa/log/log.h>
@@ -18,14 +20,16 @@ MergeHandler::MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
                            const vespalib::string & clusterName, const framework::Clock & clock,
                            uint32_t maxChunkSize,
                            bool enableMergeLocalNodeChooseDocsOptimalization,
-                           uint32_t commonMergeChainOptimalizationMinimumSize)
+                           uint32_t commonMergeChainOptimalizationMinimumSize,
+                           const vespalib::compression::CompressionConfig & payloadCompression)
     : _clock(clock),
       _clusterName(clusterName),
       _env(env),
       _spi(spi),
       _maxChunkSize(maxChunkSize),
       _enableMergeLocalNodeChooseDocsOptimalization(enableMergeLocalNodeChooseDocsOptimalization),
-      _commonMergeChainOptimalizationMinimumSize(commonMergeChainOptimalizationMinimumSize)
+      _commonMergeChainOptimalizationMinimumSize(commonMergeChainOptimalizationMinimumSize),
+      _payloadCompression(payloadCompression)
 {
 }
 
@@ -313,6 +317,68 @@ namespace {
         return api::StorageMessageAddress(clusterName, lib::NodeType::STORAGE, node);
     }
 
+    /**
+     * A serialized document always starts with a 16 bit version number
+     * which is far below 0xff00, so a leading 0xcb byte can never be the
+     * start of an uncompressed document payload.
+     */
+    constexpr uint8_t COMPRESSED_PAYLOAD_MAGIC = 0xcb;
+    constexpr size_t COMPRESSED_PAYLOAD_HEADER_SIZE = 1 + 1 + 4;
+
+    bool isCompressedPayload(const std::vector<char>& blob) {
+        return (blob.size() >= COMPRESSED_PAYLOAD_HEADER_SIZE)
+               && (static_cast<uint8_t>(blob[0]) == COMPRESSED_PAYLOAD_MAGIC);
+    }
+
+    /**
+     * Stores the serialized document in the blob, compressed according to
+     * config if that makes it smaller. Compressed payloads are prefixed with
+     * a magic byte, the compression type and the uncompressed size.
+     */
+    void storePayload(const vespalib::compression::CompressionConfig& config,
+                      const vespalib::nbostream& serialized,
+                      std::vector<char>& blob)
+    {
+        using vespalib::compression::CompressionConfig;
+        if (config.type != CompressionConfig::NONE && serialized.size() > config.minSize) {
+            vespalib::DataBuffer compressed(serialized.size() + COMPRESSED_PAYLOAD_HEADER_SIZE);
+            CompressionConfig::Type type = vespalib::compression::compress(
+                    config, vespalib::ConstBufferRef(serialized.peek(), serialized.size()), compressed, false);
+            if (CompressionConfig::isCompressed(type)
+                && (compressed.getDataLen() + COMPRESSED_PAYLOAD_HEADER_SIZE < serialized.size()))
+            {
+                vespalib::nbostream header(COMPRESSED_PAYLOAD_HEADER_SIZE);
+                header << COMPRESSED_PAYLOAD_MAGIC << static_cast<uint8_t>(type)
+                       << static_cast<uint32_t>(serialized.size());
+                blob.resize(header.size() + compressed.getDataLen());
+                memcpy(&blob[0], header.peek(), header.size());
+                memcpy(&blob[header.size()], compressed.getData(), compressed.getDataLen());
+                return;
+            }
+        }
+        blob.resize(serialized.size());
+        memcpy(&blob[0], serialized.peek(), serialized.size());
+    }
+
+    void decompressPayload(const std::vector<char>& blob, vespalib::DataBuffer& output) {
+        using vespalib::compression::CompressionConfig;
+        vespalib::nbostream header(&blob[0], COMPRESSED_PAYLOAD_HEADER_SIZE);
+        uint8_t magic(0);
+        uint8_t type(0);
+        uint32_t uncompressedSize(0);
+        header >> magic >> type >> uncompressedSize;
+        vespalib::compression::decompress(CompressionConfig::toType(type), uncompressedSize,
+                                          vespalib::ConstBufferRef(&blob[COMPRESSED_PAYLOAD_HEADER_SIZE],
+                                                                   blob.size() - COMPRESSED_PAYLOAD_HEADER_SIZE),
+                                          output, false);
+        if (output.getDataLen() != uncompressedSize) {
+            throw vespalib::IllegalStateException(
+                    vespalib::make_string("Decompressed merge payload has size %zu, expected %u",
+                                          output.getDataLen(), uncompressedSize),
+                    VESPA_STRLOC);
+        }
+    }
+
     void assertContainedInBucket(const document::DocumentId& docId,
                                  const document::BucketId& bucket,
                                  const document::BucketIdFactory& idFactory)
@@ -443,8 +509,7 @@ MergeHandler::fetchLocalData(
             e._docName = doc->getId().toString();
             vespalib::nbostream stream;
             doc->serialize(stream);
-            e._headerBlob.resize(stream.size());
-            memcpy(&e._headerBlob[0], stream.peek(), stream.size());
+            storePayload(_payloadCompression, stream, e._headerBlob);
             e._bodyBlob.clear();
         } else {
             const DocumentId* docId = docEntry.getDocumentId();
@@ -484,6 +549,13 @@ MergeHandler::deserializeDiffDocument(
         const document::DocumentTypeRepo& repo) const
 {
     auto doc = std::make_unique<Document>();
+    if (isCompressedPayload(e._headerBlob)) {
+        vespalib::DataBuffer uncompressed;
+        decompressPayload(e._headerBlob, uncompressed);
+        vespalib::nbostream hbuf(uncompressed.getData(), uncompressed.getDataLen());
+        doc->deserialize(repo, hbuf);
+        return doc;
+    }
     vespalib::nbostream hbuf(&e._headerBlob[0], e._headerBlob.size());
     if (e._bodyBlob.size() > 0) {
         // TODO Remove this branch and add warning on error.
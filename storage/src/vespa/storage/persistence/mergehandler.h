@@ -19,6 +19,7 @@
 #include <vespa/storage/persistence/filestorage/mergestatus.h>
 #include <vespa/storageapi/message/bucket.h>
 #include <vespa/storage/common/messagesender.h>
+#include <vespa/vespalib/util/compressionconfig.h>
 
 namespace storage {
 
@@ -38,7 +39,8 @@ public:
                  const vespalib::string & clusterName, const framework::Clock & clock,
                  uint32_t maxChunkSize = 4190208,
                  bool enableMergeLocalNodeChooseDocsOptimalization = true,
-                 uint32_t commonMergeChainOptimalizationMinimumSize = 64);
+                 uint32_t commonMergeChainOptimalizationMinimumSize = 64,
+                 const vespalib::compression::CompressionConfig & payloadCompression = vespalib::compression::CompressionConfig());
 
     bool buildBucketInfoList(
             const spi::Bucket& bucket,
@@ -73,6 +75,7 @@ private:
     uint32_t                  _maxChunkSize;
     bool                      _enableMergeLocalNodeChooseDocsOptimalization;
     uint32_t                  _commonMergeChainOptimalizationMinimumSize;
+    vespalib::compression::CompressionConfig _payloadCompression;
 
     /** Returns a reply if merge is complete */
     api::StorageReply::SP processBucketMerge(const spi::Bucket& bucket,
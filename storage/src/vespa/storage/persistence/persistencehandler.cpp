@@ -7,6 +7,27 @@ LOG_SETUP(".persistence.persistencehandler");
 
 namespace storage {
 
+namespace {
+
+// Bounds the time a single bucket can occupy a persistence thread.
+constexpr uint32_t MAX_BATCH_SIZE = 32;
+
+vespalib::compression::CompressionConfig
+selectMergePayloadCompression(const vespa::config::content::StorFilestorConfig & cfg) {
+    using vespalib::compression::CompressionConfig;
+    using Compression = vespa::config::content::StorFilestorConfig::MergePayloadCompression;
+    switch (cfg.mergePayloadCompression) {
+        case Compression::LZ4:
+            return CompressionConfig(CompressionConfig::LZ4, cfg.mergePayloadCompressionLevel, 90);
+        case Compression::ZSTD:
+            return CompressionConfig(CompressionConfig::ZSTD, cfg.mergePayloadCompressionLevel, 90);
+        default:
+            return CompressionConfig();
+    }
+}
+
+}
+
 PersistenceHandler::PersistenceHandler(vespalib::ISequencedTaskExecutor & sequencedExecutor,
                                       const ServiceLayerComponent & component,
                                       const vespa::config::content::StorFilestorConfig & cfg,
@@ -20,7 +41,8 @@ PersistenceHandler::PersistenceHandler(vespalib::ISequencedTaskExecutor & sequen
       _mergeHandler(_env, provider, component.getClusterName(), _clock,
                     cfg.bucketMergeChunkSize,
                     cfg.enableMergeLocalNodeChooseDocsOptimalization,
-                    cfg.commonMergeChainOptimalizationMinimumSize),
+                    cfg.commonMergeChainOptimalizationMinimumSize,
+                    selectMergePayloadCompression(cfg)),
       _asyncHandler(_env, provider, sequencedExecutor, component.getBucketIdFactory()),
       _splitJoinHandler(_env, provider, bucketOwnershipNotifier, cfg.enableMultibitSplitOptimalization),
       _simpleHandler(_env, provider)
@@ -44,7 +66,7 @@ PersistenceHandler::handleCommandSplitByType(api::StorageCommand& msg, MessageTr
     case api::MessageType::REVERT_ID:
         return _simpleHandler.handleRevert(static_cast<api::RevertCommand&>(msg), std::move(tracker));
     case api::MessageType::CREATEBUCKET_ID:
-        return _simpleHandler.handleCreateBucket(static_cast<api::CreateBucketCommand&>(msg), std::move(tracker));
+        return _asyncHandler.handleCreateBucket(static_cast<api::CreateBucketCommand&>(msg), std::move(tracker));
     case api::MessageType::DELETEBUCKET_ID:
         return _simpleHandler.handleDeleteBucket(static_cast<api::DeleteBucketCommand&>(msg), std::move(tracker));
     case api::MessageType::JOINBUCKETS_ID:
@@ -149,4 +171,21 @@ PersistenceHandler::processLockedMessage(FileStorHandler::LockedMessage lock) co
     }
 }
 
+void
+PersistenceHandler::processLockedMessageBatch(FileStorHandler::LockedMessage lock) const {
+    FileStorHandler::BucketLockInterface::SP bucketLock = lock.first;
+    processLockedMessage(std::move(lock));
+    uint32_t batchSize = 1;
+    for (; batchSize < MAX_BATCH_SIZE; ++batchSize) {
+        auto msg = _env._fileStorHandler.getNextMessageForLockedBucket(*bucketLock);
+        if (!msg) {
+            break;
+        }
+        processLockedMessage(FileStorHandler::LockedMessage(bucketLock, std::move(msg)));
+    }
+    if (batchSize > 1) {
+        _env._metrics.batchingSize.addValue(batchSize);
+    }
+}
+
 }
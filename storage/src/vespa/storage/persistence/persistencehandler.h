@@ -32,6 +32,12 @@ public:
 
     void processLockedMessage(FileStorHandler::LockedMessage lock) const;
 
+    /**
+     * Process the given message, then keep processing queued feed
+     * operations to the same bucket while still holding its lock.
+     */
+    void processLockedMessageBatch(FileStorHandler::LockedMessage lock) const;
+
     //TODO Rewrite tests to avoid this api leak
     const AsyncHandler & asyncHandler() const { return _asyncHandler; }
     const SplitJoinHandler & splitjoinHandler() const { return _splitJoinHandler; }
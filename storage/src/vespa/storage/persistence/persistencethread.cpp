@@ -39,7 +39,7 @@ PersistenceThread::run(framework::ThreadHandle& thread)
         FileStorHandler::LockedMessage lock(_fileStorHandler.getNextMessage(_stripeId));
 
         if (lock.first) {
-            _persistenceHandler.processLockedMessage(std::move(lock));
+            _persistenceHandler.processLockedMessageBatch(std::move(lock));
         }
     }
     LOG(debug, "Closing down persistence thread");
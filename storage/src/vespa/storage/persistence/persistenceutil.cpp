@@ -102,7 +102,7 @@ MessageTracker::sendReply() {
             }
         }
         if (getReply().getResult().success()) {
-            _metric->latency.addValue(_timer.getElapsedTimeAsDouble());
+            _metric->addLatency(_timer.getElapsedTimeAsDouble());
         }
         LOG(spam, "Sending reply up: %s %" PRIu64,
             getReply().toString().c_str(), getReply().getMsgId());
@@ -193,4 +193,12 @@ ProviderErrorWrapper::updateAsync(const spi::Bucket &bucket, spi::Timestamp ts,
     _impl.updateAsync(bucket, ts, std::move(upd), context, std::move(onComplete));
 }
 
+void
+ProviderErrorWrapper::createBucketAsync(const spi::Bucket &bucket, spi::Context &context,
+                                        spi::OperationComplete::UP onComplete)
+{
+    onComplete->addResultHandler(this);
+    _impl.createBucketAsync(bucket, context, std::move(onComplete));
+}
+
 } // ns storage
@@ -5,6 +5,7 @@
 #include <vespa/storage/common/nodestateupdater.h>
 #include <vespa/storage/persistence/messages.h>
 #include <vespa/messagebus/message.h>
+#include <vespa/messagebus/dynamicthrottlepolicy.h>
 #include <vespa/config/common/exceptions.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -193,6 +194,7 @@ MergeThrottler::MergeThrottler(
       _queue(),
       _maxQueueSize(1024),
       _throttlePolicy(new mbus::StaticThrottlePolicy()),
+      _use_dynamic_throttling(false),
       _queueSequence(0),
       _messageLock(),
       _stateLock(),
@@ -226,13 +228,35 @@ MergeThrottler::configure(std::unique_ptr<vespa::config::content::core::StorServ
     if (newConfig->resourceExhaustionMergeBackPressureDurationSecs < 0.0) {
         throw config::InvalidConfigException("Merge back-pressure duration cannot be less than 0");
     }
-    if (static_cast<double>(newConfig->maxMergesPerNode)
-        != _throttlePolicy->getMaxPendingCount())
-    {
-        LOG(debug, "Setting new max pending count from max_merges_per_node: %d",
-            newConfig->maxMergesPerNode);
-        _throttlePolicy->setMaxPendingCount(newConfig->maxMergesPerNode);
+    if (newConfig->mergeThrottlingPolicy.minWindowSize < 1) {
+        throw config::InvalidConfigException("Cannot have a min merge throttling window size of less than 1");
+    }
+    using MergeThrottlingPolicy = vespa::config::content::core::StorServerConfig::MergeThrottlingPolicy;
+    const bool use_dynamic_throttling = (newConfig->mergeThrottlingPolicy.type == MergeThrottlingPolicy::Type::DYNAMIC);
+    if (use_dynamic_throttling) {
+        if (!_use_dynamic_throttling) {
+            LOG(debug, "Switching to dynamic merge throttling policy");
+            _throttlePolicy = std::make_unique<mbus::DynamicThrottlePolicy>(newConfig->mergeThrottlingPolicy.windowSizeIncrement);
+        }
+        auto& policy = dynamic_cast<mbus::DynamicThrottlePolicy&>(*_throttlePolicy);
+        LOG(debug, "Setting dynamic merge window size bounds to [%d, %d]",
+            newConfig->mergeThrottlingPolicy.minWindowSize, newConfig->maxMergesPerNode);
+        policy.setMinWindowSize(std::min(newConfig->mergeThrottlingPolicy.minWindowSize, newConfig->maxMergesPerNode));
+        policy.setMaxPendingCount(newConfig->maxMergesPerNode);
+    } else {
+        if (_use_dynamic_throttling) {
+            LOG(debug, "Switching to static merge throttling policy");
+            _throttlePolicy = std::make_unique<mbus::StaticThrottlePolicy>();
+        }
+        if (static_cast<double>(newConfig->maxMergesPerNode)
+            != _throttlePolicy->getMaxPendingCount())
+        {
+            LOG(debug, "Setting new max pending count from max_merges_per_node: %d",
+                newConfig->maxMergesPerNode);
+            _throttlePolicy->setMaxPendingCount(newConfig->maxMergesPerNode);
+        }
     }
+    _use_dynamic_throttling = use_dynamic_throttling;
     LOG(debug, "Setting new max queue size to %d",
         newConfig->maxMergeQueueSize);
     _maxQueueSize = newConfig->maxMergeQueueSize;
@@ -153,6 +153,7 @@ private:
     MergePriorityQueue _queue;
     std::size_t _maxQueueSize;
     mbus::StaticThrottlePolicy::UP _throttlePolicy;
+    bool _use_dynamic_throttling;
     uint64_t _queueSequence; // TODO: move into a stable priority queue class
     mutable std::mutex _messageLock;
     std::condition_variable _messageCond;
@@ -187,6 +188,11 @@ public:
 
     bool onSetSystemState(const std::shared_ptr<api::SetSystemStateCommand>& stateCmd) override;
 
+    /**
+     * Callback method for config system (IFetcherCallback)
+     */
+    void configure(std::unique_ptr<vespa::config::content::core::StorServerConfig> newConfig) override;
+
     /*
      * When invoked, merges to the node will be BUSY-bounced by the throttler
      * for a configurable period of time instead of being processed.
@@ -259,11 +265,6 @@ private:
         std::string getSequenceString() const;
     };
 
-    /**
-     * Callback method for config system (IFetcherCallback)
-     */
-    void configure(std::unique_ptr<vespa::config::content::core::StorServerConfig> newConfig) override;
-
     // NOTE: unless explicitly specified, all the below functions require
     // _sync lock to be held upon call (usually implicitly via MessageGuard)
 
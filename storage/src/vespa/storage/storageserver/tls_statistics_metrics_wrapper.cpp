@@ -9,7 +9,13 @@ TlsStatisticsMetricsWrapper::EndpointMetrics::EndpointMetrics(vespalib::stringre
       tls_connections_established("tls-connections-established", {},
               "Number of secure mTLS connections established", this),
       insecure_connections_established("insecure-connections-established", {},
-              "Number of insecure (plaintext) connections established", this)
+              "Number of insecure (plaintext) connections established", this),
+      tls_records_encoded("tls-records-encoded", {},
+              "Number of TLS records encoded", this),
+      tls_bytes_encoded("tls-bytes-encoded", {},
+              "Number of plaintext bytes encoded into TLS records", this),
+      tls_bytes_decoded("tls-bytes-decoded", {},
+              "Number of plaintext bytes decoded from TLS records", this)
 {}
 
 TlsStatisticsMetricsWrapper::EndpointMetrics::~EndpointMetrics() = default;
@@ -44,6 +50,12 @@ void TlsStatisticsMetricsWrapper::update_metrics_with_snapshot_delta() {
     client.tls_connections_established.set(client_delta.tls_connections);
     server.insecure_connections_established.set(server_delta.insecure_connections);
     server.tls_connections_established.set(server_delta.tls_connections);
+    client.tls_records_encoded.set(client_delta.encoded_tls_records);
+    client.tls_bytes_encoded.set(client_delta.encoded_tls_bytes);
+    client.tls_bytes_decoded.set(client_delta.decoded_tls_bytes);
+    server.tls_records_encoded.set(server_delta.encoded_tls_records);
+    server.tls_bytes_encoded.set(server_delta.encoded_tls_bytes);
+    server.tls_bytes_decoded.set(server_delta.decoded_tls_bytes);
 
     // We have underlying stats for both server and client here, but for the
     // moment we just aggregate them up into combined metrics. Can be trivially
@@ -18,6 +18,9 @@ class TlsStatisticsMetricsWrapper : public metrics::MetricSet {
 
         metrics::LongCountMetric tls_connections_established;
         metrics::LongCountMetric insecure_connections_established;
+        metrics::LongCountMetric tls_records_encoded;
+        metrics::LongCountMetric tls_bytes_encoded;
+        metrics::LongCountMetric tls_bytes_decoded;
     };
 
     EndpointMetrics client;
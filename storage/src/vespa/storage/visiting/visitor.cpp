@@ -735,7 +735,7 @@ Visitor::onCreateIteratorReply(
 
     LOG(debug, "Visitor '%s' starting to visit bucket %s.",
         _id.c_str(), bucketId.toString().c_str());
-    auto cmd = std::make_shared<GetIterCommand>(bucket, bucketState.getIteratorId(), _docBlockSize);
+    auto cmd = std::make_shared<GetIterCommand>(bucket, bucketState.getIteratorId(), nextIteratorBlockSize());
     cmd->setLoadType(_initiatingCmd->getLoadType());
     cmd->getTrace().setLevel(_traceLevel);
     cmd->setPriority(_priority);
@@ -941,6 +941,17 @@ Visitor::continueVisitor()
     }
 }
 
+uint32_t
+Visitor::nextIteratorBlockSize() const
+{
+    constexpr uint32_t minBlockSize = 1024;
+    const uint32_t used = _visitorTarget.getMemoryUsage();
+    if (used >= _memoryUsageLimit) {
+        return std::min(_docBlockSize, minBlockSize);
+    }
+    return std::min(_docBlockSize, std::max(_memoryUsageLimit - used, minBlockSize));
+}
+
 void
 Visitor::getStatus(std::ostream& out, bool verbose) const
 {
@@ -1141,7 +1152,7 @@ Visitor::getIterators()
             continue;
         }
         auto cmd = std::make_shared<GetIterCommand>(
-                bucketState.getBucket(), bucketState.getIteratorId(), _docBlockSize);
+                bucketState.getBucket(), bucketState.getIteratorId(), nextIteratorBlockSize());
         cmd->setLoadType(_initiatingCmd->getLoadType());
         cmd->getTrace().setLevel(_traceLevel);
         cmd->setPriority(_priority);
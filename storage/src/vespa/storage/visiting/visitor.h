@@ -525,6 +525,14 @@ private:
      */
     bool getIterators();
 
+    /**
+     * Returns the max number of bytes to request in the next GetIter. Never
+     * asks for more than what is left of the memory budget towards the
+     * client, so a slow client throttles reading from the provider instead
+     * of having the visitor buffer up a full document block per iterator.
+     */
+    uint32_t nextIteratorBlockSize() const;
+
     /**
      * Attempt to send the message kept in msgMeta over the destination session,
      * automatically queuing for future transmission if a maximum number of
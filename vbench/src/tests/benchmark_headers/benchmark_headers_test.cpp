@@ -67,6 +67,16 @@ TEST("require that benchmark headers can be set") {
     EXPECT_EQUAL(headers.full_coverage.value, 14.0);
 }
 
+TEST("require that benchmark header names are case insensitive") {
+    vbench::BenchmarkHeaders headers;
+    headers.handleHeader("x-yahoo-vespa-numhits", "1");
+    headers.handleHeader("X-YAHOO-VESPA-SEARCHTIME", "2");
+    EXPECT_TRUE(headers.num_hits.is_set);
+    EXPECT_EQUAL(headers.num_hits.value, 1.0);
+    EXPECT_TRUE(headers.search_time.is_set);
+    EXPECT_EQUAL(headers.search_time.value, 2.0);
+}
+
 TEST("require that benchmark headers can be converted to string") {
     vbench::BenchmarkHeaders headers;
     headers.handleHeader("X-Yahoo-Vespa-NumErrors", "4");
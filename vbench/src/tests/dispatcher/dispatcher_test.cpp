@@ -57,4 +57,16 @@ TEST_FF("dispatcher poll timeout", MyHandler(), Dispatcher<int>(f1)) {
     EXPECT_FALSE(f2.waitForThreads(1, 2));
 }
 
+TEST_FF("dispatcher with backlog queues objects until requested", MyHandler(), Dispatcher<int>(f1, true)) {
+    f2.handle(std::unique_ptr<int>(new int(1)));
+    f2.handle(std::unique_ptr<int>(new int(2)));
+    EXPECT_EQUAL(-1, f1.value);
+    EXPECT_EQUAL(1, *f2.provide());
+    f2.close();
+    f2.handle(std::unique_ptr<int>(new int(3)));
+    EXPECT_EQUAL(-1, f1.value);
+    EXPECT_EQUAL(2, *f2.provide());
+    EXPECT_TRUE(f2.provide().get() == nullptr);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
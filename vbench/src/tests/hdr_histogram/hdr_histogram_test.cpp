@@ -0,0 +1,71 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST("require that empty histogram reports zero") {
+    HdrHistogram hist(0.001);
+    EXPECT_EQUAL(0u, hist.count());
+    EXPECT_EQUAL(0.0, hist.mean());
+    EXPECT_EQUAL(0.0, hist.percentile(99.0));
+}
+
+TEST("require that min, max and mean are exact") {
+    HdrHistogram hist(0.001);
+    hist.add(1.0);
+    hist.add(2.0);
+    hist.add(6.0);
+    EXPECT_EQUAL(3u, hist.count());
+    EXPECT_EQUAL(1.0, hist.min());
+    EXPECT_EQUAL(6.0, hist.max());
+    EXPECT_APPROX(3.0, hist.mean(), 10e-6);
+}
+
+TEST("require that small values are exact in units of the resolution") {
+    HdrHistogram hist(1.0);
+    for (size_t i = 1; i <= 100; ++i) {
+        hist.add(i);
+    }
+    EXPECT_EQUAL(50.0, hist.percentile(50.0));
+    EXPECT_EQUAL(99.0, hist.percentile(99.0));
+    EXPECT_EQUAL(100.0, hist.percentile(100.0));
+}
+
+TEST("require that percentiles have bounded relative error and are not under-reported") {
+    HdrHistogram hist(0.000001);
+    for (size_t i = 1; i <= 100000; ++i) {
+        hist.add(0.0001 * i);
+    }
+    for (double per: {50.0, 90.0, 99.0, 99.9, 99.99}) {
+        double expect = 0.0001 * std::ceil(per * 1000.0);
+        double actual = hist.percentile(per);
+        EXPECT_GREATER_EQUAL(actual, expect * 0.9999);
+        EXPECT_LESS_EQUAL(actual, expect * 1.016);
+    }
+    EXPECT_EQUAL(hist.max(), hist.percentile(100.0));
+}
+
+TEST("require that tail values are reflected in high percentiles only") {
+    HdrHistogram hist(0.000001);
+    for (size_t i = 0; i < 999; ++i) {
+        hist.add(0.001);
+    }
+    hist.add(10.0);
+    EXPECT_APPROX(0.001, hist.percentile(99.9), 0.00002);
+    EXPECT_EQUAL(10.0, hist.percentile(99.99));
+}
+
+TEST("require that percentile distribution has hdr histogram format") {
+    HdrHistogram hist(0.000001);
+    for (size_t i = 1; i <= 1000; ++i) {
+        hist.add(0.001 * i);
+    }
+    string dist = hist.percentileDistribution(1000.0);
+    fprintf(stderr, "%s", dist.c_str());
+    EXPECT_EQUAL(0u, dist.find("       Value     Percentile TotalCount 1/(1-Percentile)\n\n"));
+    EXPECT_NOT_EQUAL(string::npos, dist.find("    1000.000 1.000000000000       1000\n"));
+    EXPECT_NOT_EQUAL(string::npos, dist.find("#[Total count    =         1000"));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
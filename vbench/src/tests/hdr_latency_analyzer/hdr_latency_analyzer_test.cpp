@@ -0,0 +1,57 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+void post(double scheduledTime, double startTime, double endTime, Handler<Request> &handler,
+          Request::Status status = Request::STATUS_OK)
+{
+    Request::UP req(new Request());
+    req->scheduledTime(scheduledTime).status(status).startTime(startTime).endTime(endTime);
+    handler.handle(std::move(req));
+}
+
+TEST_FF("require that latency is measured from scheduled time", RequestSink(), HdrLatencyAnalyzer(f1, true, 1.0)) {
+    post(1.0, 1.0, 1.5, f2);
+    post(1.0, 3.0, 3.5, f2);
+    EXPECT_EQUAL(2u, f2.latency().count());
+    EXPECT_APPROX(0.5, f2.latency().min(), 10e-6);
+    EXPECT_APPROX(2.5, f2.latency().max(), 10e-6);
+    ASSERT_EQUAL(2u, f2.series().size());
+    EXPECT_EQUAL(2u, f2.series()[1].latency.count());
+}
+
+TEST_FF("require that latency can be measured from start time", RequestSink(), HdrLatencyAnalyzer(f1, false, 1.0)) {
+    post(1.0, 1.0, 1.5, f2);
+    post(1.0, 3.0, 3.5, f2);
+    EXPECT_APPROX(0.5, f2.latency().min(), 10e-6);
+    EXPECT_APPROX(0.5, f2.latency().max(), 10e-6);
+    ASSERT_EQUAL(4u, f2.series().size());
+    EXPECT_EQUAL(1u, f2.series()[1].latency.count());
+    EXPECT_EQUAL(1u, f2.series()[3].latency.count());
+}
+
+TEST_FF("require that failed and dropped requests are counted per interval", RequestSink(), HdrLatencyAnalyzer(f1, true, 0.5)) {
+    post(0.1, 0.1, 0.2, f2);
+    post(0.2, 0.2, 0.3, f2, Request::STATUS_FAILED);
+    post(0.7, 0.7, 0.7, f2, Request::STATUS_DROPPED);
+    EXPECT_EQUAL(1u, f2.latency().count());
+    ASSERT_EQUAL(2u, f2.series().size());
+    EXPECT_EQUAL(1u, f2.series()[0].latency.count());
+    EXPECT_EQUAL(1u, f2.series()[0].failed);
+    EXPECT_EQUAL(0u, f2.series()[0].dropped);
+    EXPECT_EQUAL(0u, f2.series()[1].latency.count());
+    EXPECT_EQUAL(1u, f2.series()[1].dropped);
+    string series = f2.timeSeries();
+    fprintf(stderr, "%s", series.c_str());
+    EXPECT_NOT_EQUAL(string::npos, series.find("0.5\t0\t0\t1\t"));
+}
+
+TEST_FF("require that requests are passed along", RequestSink(), HdrLatencyAnalyzer(f1, true, 1.0)) {
+    post(0.0, 0.0, 1.0, f2);
+    EXPECT_EQUAL(1u, f2.latency().count());
+    fprintf(stderr, "%s", f2.summary().c_str());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
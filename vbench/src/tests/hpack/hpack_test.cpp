@@ -0,0 +1,90 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+using hpack::Header;
+
+string fromHex(const string &hex) {
+    string dst;
+    for (size_t i = 0; (i + 1) < hex.size(); i += 2) {
+        dst.push_back(char(strtol(hex.substr(i, 2).c_str(), nullptr, 16)));
+    }
+    return dst;
+}
+
+std::vector<Header> decode(hpack::Decoder &decoder, const string &hex) {
+    string block = fromHex(hex);
+    std::vector<Header> headers;
+    EXPECT_TRUE(decoder.decode(block.data(), block.size(), headers));
+    return headers;
+}
+
+void checkHeaders(const std::vector<Header> &expect, const std::vector<Header> &actual) {
+    ASSERT_EQUAL(expect.size(), actual.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_EQUAL(expect[i].first, actual[i].first);
+        EXPECT_EQUAL(expect[i].second, actual[i].second);
+    }
+}
+
+TEST("require that huffman coded strings can be decoded") {
+    string data = fromHex("f1e3c2e5f23a6ba0ab90f4ff");
+    string dst;
+    EXPECT_TRUE(hpack::decodeHuffman(data.data(), data.size(), dst));
+    EXPECT_EQUAL("www.example.com", dst);
+}
+
+TEST("require that invalid huffman padding is rejected") {
+    string data = fromHex("f1e3c2e5f23a6ba0ab90f4fe");
+    string dst;
+    EXPECT_FALSE(hpack::decodeHuffman(data.data(), data.size(), dst));
+}
+
+TEST("require that request examples from RFC 7541 can be decoded") {
+    hpack::Decoder decoder;
+    TEST_DO(checkHeaders({{":method", "GET"}, {":scheme", "http"}, {":path", "/"},
+                          {":authority", "www.example.com"}},
+                    decode(decoder, "828684418cf1e3c2e5f23a6ba0ab90f4ff")));
+    EXPECT_EQUAL(57u, decoder.tableSize());
+    TEST_DO(checkHeaders({{":method", "GET"}, {":scheme", "http"}, {":path", "/"},
+                          {":authority", "www.example.com"}, {"cache-control", "no-cache"}},
+                    decode(decoder, "828684be5886a8eb10649cbf")));
+    EXPECT_EQUAL(110u, decoder.tableSize());
+    TEST_DO(checkHeaders({{":method", "GET"}, {":scheme", "https"}, {":path", "/index.html"},
+                          {":authority", "www.example.com"}, {"custom-key", "custom-value"}},
+                    decode(decoder, "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf")));
+    EXPECT_EQUAL(164u, decoder.tableSize());
+    EXPECT_EQUAL(3u, decoder.numEntries());
+}
+
+TEST("require that dynamic table size updates evict entries") {
+    hpack::Decoder decoder;
+    decode(decoder, "828684418cf1e3c2e5f23a6ba0ab90f4ff");
+    EXPECT_EQUAL(1u, decoder.numEntries());
+    TEST_DO(checkHeaders({{":method", "GET"}}, decode(decoder, "2082")));
+    EXPECT_EQUAL(0u, decoder.numEntries());
+    EXPECT_EQUAL(0u, decoder.tableSize());
+}
+
+TEST("require that references outside the tables are rejected") {
+    hpack::Decoder decoder;
+    string block = fromHex("be");
+    std::vector<Header> headers;
+    EXPECT_FALSE(decoder.decode(block.data(), block.size(), headers));
+}
+
+TEST("require that encoded headers can be decoded") {
+    string block;
+    hpack::encodeHeader(":method", "GET", block);
+    hpack::encodeHeader(":path", "/search/?query=" + string(200, 'x'), block);
+    hpack::encodeHeader("x-yahoo-vespa-benchmarkdata", "true", block);
+    hpack::Decoder decoder;
+    std::vector<Header> headers;
+    EXPECT_TRUE(decoder.decode(block.data(), block.size(), headers));
+    TEST_DO(checkHeaders({{":method", "GET"}, {":path", "/search/?query=" + string(200, 'x')},
+                          {"x-yahoo-vespa-benchmarkdata", "true"}}, headers));
+    EXPECT_EQUAL(0u, decoder.numEntries());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
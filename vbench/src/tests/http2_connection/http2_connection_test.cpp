@@ -0,0 +1,153 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+#include <vespa/vespalib/net/crypto_engine.h>
+
+using namespace vbench;
+
+using InputReader = vespalib::InputReader;
+using OutputWriter = vespalib::OutputWriter;
+
+auto null_crypto = std::make_shared<vespalib::NullCryptoEngine>();
+
+struct Frame {
+    uint8_t type;
+    uint8_t flags;
+    uint32_t stream;
+    string payload;
+    Frame() : type(0), flags(0), stream(0), payload() {}
+};
+
+bool readFrame(InputReader &in, Frame &frame) {
+    Memory hdr = in.read(9);
+    if (in.failed()) {
+        return false;
+    }
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(hdr.data);
+    size_t len = (size_t(p[0]) << 16) | (size_t(p[1]) << 8) | p[2];
+    frame.type = p[3];
+    frame.flags = p[4];
+    frame.stream = ((uint32_t(p[5] & 0x7f) << 24) | (uint32_t(p[6]) << 16) | (uint32_t(p[7]) << 8) | p[8]);
+    Memory payload = in.read(len);
+    frame.payload = string(payload.data, payload.size);
+    return !in.failed();
+}
+
+void writeFrame(Stream &stream, uint8_t type, uint8_t flags, uint32_t id, const string &payload) {
+    OutputWriter out(stream, 256);
+    size_t len = payload.size();
+    char hdr[9] = { char(len >> 16), char(len >> 8), char(len), char(type), char(flags),
+                    char(id >> 24), char(id >> 16), char(id >> 8), char(id) };
+    out.write(hdr, sizeof(hdr));
+    out.write(payload.data(), payload.size());
+}
+
+struct Server {
+    Stream::UP stream;
+    std::vector<Frame> requests;
+    Server(ServerSocket &socket) : stream(socket.accept(*null_crypto)), requests() {}
+    void awaitRequests(size_t n) {
+        InputReader in(*stream);
+        Memory preface = in.read(24);
+        EXPECT_EQUAL(string("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"), string(preface.data, preface.size));
+        writeFrame(*stream, 0x4, 0, 0, ""); // SETTINGS
+        Frame frame;
+        while ((requests.size() < n) && readFrame(in, frame)) {
+            if (frame.type == 0x1) { // HEADERS
+                EXPECT_EQUAL(0x5, frame.flags); // END_STREAM | END_HEADERS
+                requests.push_back(frame);
+            }
+        }
+    }
+    void respond(uint32_t id, const string &status, const string &content) {
+        string headers;
+        hpack::encodeHeader(":status", status, headers);
+        hpack::encodeHeader("x-yahoo-vespa-numhits", "10", headers);
+        hpack::encodeHeader("content-type", "text/plain", headers);
+        writeFrame(*stream, 0x1, 0x4, id, headers);       // HEADERS, END_HEADERS
+        writeFrame(*stream, 0x0, 0x0, id, content);       // DATA
+        writeFrame(*stream, 0x0, 0x1, id, "");            // DATA, END_STREAM
+    }
+};
+
+struct Fixture {
+    ServerSocket server_socket;
+    Http2Connection conn;
+    Fixture() : server_socket(), conn(null_crypto, ServerSpec("localhost", server_socket.port())) {}
+};
+
+TEST_MT_F("require that concurrent requests are multiplexed on a single connection", 3, Fixture()) {
+    if (thread_id == 0) {
+        Server server(f1.server_socket);
+        server.awaitRequests(2);
+        ASSERT_EQUAL(2u, server.requests.size());
+        hpack::Decoder decoder;
+        std::vector<hpack::Header> headers;
+        for (const Frame &frame: server.requests) {
+            EXPECT_TRUE(decoder.decode(frame.payload.data(), frame.payload.size(), headers));
+        }
+        ASSERT_EQUAL(14u, headers.size());
+        EXPECT_EQUAL(string(":method"), headers[0].first);
+        EXPECT_EQUAL(string("GET"), headers[0].second);
+        EXPECT_EQUAL(string(":scheme"), headers[1].first);
+        EXPECT_EQUAL(string("http"), headers[1].second);
+        EXPECT_EQUAL(string(":path"), headers[3].first);
+        EXPECT_EQUAL(string("x-yahoo-vespa-benchmarkdata"), headers[5].first);
+        EXPECT_NOT_EQUAL(server.requests[0].stream, server.requests[1].stream);
+        // respond in reverse order
+        for (size_t i = server.requests.size(); i-- > 0; ) {
+            server.respond(server.requests[i].stream, "200", strfmt("content %u", server.requests[i].stream));
+        }
+        TEST_BARRIER();
+    } else {
+        SimpleHttpResultHandler handler;
+        EXPECT_TRUE(f1.conn.fetch(strfmt("/search/?thread=%zu", thread_id), handler));
+        EXPECT_EQUAL(0u, handler.failures().size());
+        ASSERT_EQUAL(1u, handler.headers().size());
+        EXPECT_EQUAL(string("x-yahoo-vespa-numhits"), handler.headers()[0].first);
+        EXPECT_EQUAL(string("10"), handler.headers()[0].second);
+        string content(handler.content().data, handler.content().size);
+        EXPECT_EQUAL(0u, content.find("content "));
+        TEST_BARRIER();
+    }
+}
+
+TEST_MT_F("require that failed requests and connections are reported", 2, Fixture()) {
+    if (thread_id == 0) {
+        {
+            Server server(f1.server_socket);
+            server.awaitRequests(1);
+            ASSERT_EQUAL(1u, server.requests.size());
+            server.respond(server.requests[0].stream, "404", "not found");
+            TEST_BARRIER();
+        }
+        TEST_BARRIER();
+    } else {
+        SimpleHttpResultHandler handler1;
+        EXPECT_FALSE(f1.conn.fetch("/not/found", handler1));
+        ASSERT_EQUAL(1u, handler1.failures().size());
+        EXPECT_EQUAL(string("HTTP status not 200: '404'"), handler1.failures()[0]);
+        EXPECT_TRUE(f1.conn.usable());
+        TEST_BARRIER(); // server closes the connection
+        TEST_BARRIER();
+        SimpleHttpResultHandler handler2;
+        EXPECT_FALSE(f1.conn.fetch("/foo", handler2));
+        EXPECT_EQUAL(1u, handler2.failures().size());
+        EXPECT_FALSE(f1.conn.usable());
+    }
+}
+
+TEST("require that requests fail when the server cannot be reached") {
+    int port;
+    {
+        ServerSocket socket;
+        port = socket.port();
+    }
+    Http2Connection conn(null_crypto, ServerSpec("localhost", port));
+    SimpleHttpResultHandler handler;
+    EXPECT_FALSE(conn.fetch("/foo", handler));
+    EXPECT_EQUAL(1u, handler.failures().size());
+    EXPECT_FALSE(conn.usable());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -6,6 +6,7 @@
 #include "provider.h"
 #include "closeable.h"
 #include <vespa/vespalib/util/gate.h>
+#include <deque>
 #include <vector>
 
 namespace vbench {
@@ -17,6 +18,12 @@ namespace vbench {
  * currently waiting for objects, the objects will be passed along to
  * a predefined fallback handler instead. A closed dispatcher will
  * provide nil objects and handle incoming objects by deleting them.
+ *
+ * If the dispatcher is created with a backlog, objects arriving when
+ * no components are waiting are queued and provided (in order) to
+ * the next components requesting objects instead of being passed to
+ * the fallback handler. Queued objects are still provided after the
+ * dispatcher is closed.
  **/
 template <typename T>
 class Dispatcher : public Handler<T>,
@@ -32,10 +39,12 @@ private:
     Handler<T>               &_fallback;
     mutable std::mutex        _lock;
     std::vector<ThreadState*> _threads;
+    bool                      _useBacklog;
+    std::deque<std::unique_ptr<T>> _backlog;
     bool                      _closed;
 
 public:
-    explicit Dispatcher(Handler<T> &fallback);
+    explicit Dispatcher(Handler<T> &fallback, bool useBacklog = false);
     ~Dispatcher() override;
     bool waitForThreads(size_t threads, size_t pollCnt) const;
     void close() override;
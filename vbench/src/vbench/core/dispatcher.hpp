@@ -5,10 +5,12 @@
 namespace vbench {
 
 template <typename T>
-Dispatcher<T>::Dispatcher(Handler<T> &fallback)
+Dispatcher<T>::Dispatcher(Handler<T> &fallback, bool useBacklog)
     : _fallback(fallback),
       _lock(),
       _threads(),
+      _useBacklog(useBacklog),
+      _backlog(),
       _closed(false)
 {
 }
@@ -60,6 +62,8 @@ Dispatcher<T>::handle(std::unique_ptr<T> obj)
         guard.unlock();
         state->object = std::move(obj);
         state->gate.countDown();
+    } else if (_useBacklog && !_closed) {
+        _backlog.push_back(std::move(obj));
     } else {
         bool closed = _closed;
         guard.unlock();
@@ -76,7 +80,10 @@ Dispatcher<T>::provide()
     ThreadState state;
     {
         std::unique_lock guard(_lock);
-        if (!_closed) {
+        if (!_backlog.empty()) {
+            state.object = std::move(_backlog.front());
+            _backlog.pop_front();
+        } else if (!_closed) {
             _threads.push_back(&state);
             guard.unlock();
             state.gate.await();
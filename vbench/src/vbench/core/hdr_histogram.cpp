@@ -0,0 +1,120 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hdr_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vbench {
+
+namespace {
+
+constexpr size_t SUB_BUCKET_BITS = 7;
+constexpr size_t HALF_SUB_BUCKETS = size_t(1) << (SUB_BUCKET_BITS - 1);
+constexpr size_t TICKS_PER_HALF_DISTANCE = 5;
+
+size_t mostSignificantBit(size_t value) {
+    return 63 - __builtin_clzl(value);
+}
+
+} // namespace vbench::<unnamed>
+
+size_t
+HdrHistogram::bucketOf(size_t units)
+{
+    if (units < (HALF_SUB_BUCKETS << 1)) {
+        return units;
+    }
+    size_t shift = mostSignificantBit(units) - (SUB_BUCKET_BITS - 1);
+    return (shift * HALF_SUB_BUCKETS) + (units >> shift);
+}
+
+size_t
+HdrHistogram::bucketEnd(size_t bucket)
+{
+    if (bucket < (HALF_SUB_BUCKETS << 1)) {
+        return bucket;
+    }
+    size_t shift = (bucket / HALF_SUB_BUCKETS) - 1;
+    size_t start = (HALF_SUB_BUCKETS + (bucket % HALF_SUB_BUCKETS)) << shift;
+    return start + (size_t(1) << shift) - 1;
+}
+
+HdrHistogram::HdrHistogram(double resolution)
+    : _resolution(resolution),
+      _buckets(),
+      _count(0),
+      _min(0.0),
+      _max(0.0),
+      _total(0.0)
+{
+}
+
+HdrHistogram::~HdrHistogram() = default;
+
+void
+HdrHistogram::add(double value)
+{
+    value = std::max(value, 0.0);
+    if (_count == 0 || value < _min) {
+        _min = value;
+    }
+    if (_count == 0 || value > _max) {
+        _max = value;
+    }
+    ++_count;
+    _total += value;
+    size_t bucket = bucketOf((size_t)(value / _resolution + 0.5));
+    if (bucket >= _buckets.size()) {
+        _buckets.resize(bucket + 1, 0);
+    }
+    ++_buckets[bucket];
+}
+
+double
+HdrHistogram::percentile(double per) const
+{
+    if (_count == 0) {
+        return 0.0;
+    }
+    per = std::min(std::max(per, 0.0), 100.0);
+    size_t rank = std::max(size_t(1), (size_t)std::ceil((per / 100.0) * _count));
+    size_t seen = 0;
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            return std::min(std::max(bucketEnd(i) * _resolution, _min), _max);
+        }
+    }
+    return _max;
+}
+
+string
+HdrHistogram::percentileDistribution(double scale) const
+{
+    string str = strfmt("%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    if (_count > 0) {
+        double level = 0.0;
+        size_t seen = 0;
+        for (size_t i = 0; i < _buckets.size(); ++i) {
+            if (_buckets[i] == 0) {
+                continue;
+            }
+            seen += _buckets[i];
+            double value = std::min(std::max(bucketEnd(i) * _resolution, _min), _max) * scale;
+            double reached = (100.0 * seen) / _count;
+            while (level <= reached && seen < _count) {
+                str += strfmt("%12.3f %2.12f %10zu %14.2f\n", value, level / 100.0, seen, 100.0 / (100.0 - level));
+                double halvings = std::floor(std::log2(100.0 / (100.0 - level)));
+                level += 100.0 / (TICKS_PER_HALF_DISTANCE * std::pow(2.0, halvings + 1));
+            }
+            if (seen == _count) {
+                str += strfmt("%12.3f %2.12f %10zu\n", _max * scale, 1.0, seen);
+            }
+        }
+    }
+    str += strfmt("#[Mean    = %12.3f, Max           = %12.3f]\n", mean() * scale, _max * scale);
+    str += strfmt("#[Total count    = %12zu, Buckets  = %12zu]\n", _count, _buckets.size());
+    return str;
+}
+
+} // namespace vbench
@@ -0,0 +1,51 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "string.h"
+#include <vector>
+
+namespace vbench {
+
+/**
+ * Histogram with bounded relative error over a large value range, in
+ * the spirit of HdrHistogram. Values are counted in units of the given
+ * resolution; below 128 units each unit has its own bucket, and above
+ * that each power of two is split into 64 buckets, giving at most 1.6%
+ * relative error. Percentiles are reported as the highest value
+ * equivalent to the bucket they fall in, so tail latencies are never
+ * under-reported. Buckets are allocated as needed.
+ **/
+class HdrHistogram
+{
+private:
+    double              _resolution;
+    std::vector<size_t> _buckets;
+    size_t              _count;
+    double              _min;
+    double              _max;
+    double              _total;
+
+    static size_t bucketOf(size_t units);
+    static size_t bucketEnd(size_t bucket);
+
+public:
+    explicit HdrHistogram(double resolution);
+    ~HdrHistogram();
+    void add(double value);
+    size_t count() const { return _count; }
+    double min() const { return _min; }
+    double max() const { return _max; }
+    double mean() const { return (_count > 0) ? (_total / _count) : 0.0; }
+    double percentile(double per) const;
+
+    /**
+     * Percentile distribution in the text format produced by
+     * HdrHistogram (outputPercentileDistribution), with values
+     * multiplied by the given scale, suitable for plotting with
+     * standard HdrHistogram tools.
+     **/
+    string percentileDistribution(double scale) const;
+};
+
+} // namespace vbench
@@ -2,6 +2,7 @@
 
 #include "benchmark_headers.h"
 #include <map>
+#include <strings.h>
 
 namespace vbench {
 
@@ -24,10 +25,16 @@ struct HeaderTraverser {
     virtual ~HeaderTraverser() { }
     virtual void header(const string &name, double value) = 0;
 };
+// header names are case insensitive (and always lower case in HTTP/2)
+struct NameLess {
+    bool operator()(const string &a, const string &b) const {
+        return (strcasecmp(a.c_str(), b.c_str()) < 0);
+    }
+};
 struct HeaderMapper {
     typedef BenchmarkHeaders::Value BenchmarkHeaders::*ValueRef;
-    typedef std::map<string,ValueRef> HeaderMap;
-    typedef std::map<string,ValueRef>::iterator HeaderEntry;
+    typedef std::map<string,ValueRef,NameLess> HeaderMap;
+    typedef HeaderMap::iterator HeaderEntry;
     HeaderMap map;
     HeaderMapper() : map() {
         map[NUM_HITS]        = &BenchmarkHeaders::num_hits;
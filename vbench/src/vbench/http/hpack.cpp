@@ -0,0 +1,334 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hpack.h"
+#include <cassert>
+
+namespace vbench::hpack {
+
+namespace {
+
+struct StaticEntry {
+    const char *name;
+    const char *value;
+};
+
+const StaticEntry static_table[] = {
+    {":authority", ""}, {":method", "GET"}, {":method", "POST"}, {":path", "/"},
+    {":path", "/index.html"}, {":scheme", "http"}, {":scheme", "https"}, {":status", "200"},
+    {":status", "204"}, {":status", "206"}, {":status", "304"}, {":status", "400"},
+    {":status", "404"}, {":status", "500"}, {"accept-charset", ""}, {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""}, {"accept-ranges", ""}, {"accept", ""}, {"access-control-allow-origin", ""},
+    {"age", ""}, {"allow", ""}, {"authorization", ""}, {"cache-control", ""},
+    {"content-disposition", ""}, {"content-encoding", ""}, {"content-language", ""}, {"content-length", ""},
+    {"content-location", ""}, {"content-range", ""}, {"content-type", ""}, {"cookie", ""},
+    {"date", ""}, {"etag", ""}, {"expect", ""}, {"expires", ""},
+    {"from", ""}, {"host", ""}, {"if-match", ""}, {"if-modified-since", ""},
+    {"if-none-match", ""}, {"if-range", ""}, {"if-unmodified-since", ""}, {"last-modified", ""},
+    {"link", ""}, {"location", ""}, {"max-forwards", ""}, {"proxy-authenticate", ""},
+    {"proxy-authorization", ""}, {"range", ""}, {"referer", ""}, {"refresh", ""},
+    {"retry-after", ""}, {"server", ""}, {"set-cookie", ""}, {"strict-transport-security", ""},
+    {"transfer-encoding", ""}, {"user-agent", ""}, {"vary", ""}, {"via", ""},
+    {"www-authenticate", ""}
+};
+constexpr size_t STATIC_TABLE_SIZE = sizeof(static_table) / sizeof(static_table[0]);
+constexpr size_t ENTRY_OVERHEAD = 32;
+
+// huffman code table from RFC 7541 appendix B (EOS excluded)
+const uint32_t huffman_codes[256] = {
+    0x00001ff8, 0x007fffd8, 0x0fffffe2, 0x0fffffe3, 0x0fffffe4, 0x0fffffe5, 0x0fffffe6, 0x0fffffe7,
+    0x0fffffe8, 0x00ffffea, 0x3ffffffc, 0x0fffffe9, 0x0fffffea, 0x3ffffffd, 0x0fffffeb, 0x0fffffec,
+    0x0fffffed, 0x0fffffee, 0x0fffffef, 0x0ffffff0, 0x0ffffff1, 0x0ffffff2, 0x3ffffffe, 0x0ffffff3,
+    0x0ffffff4, 0x0ffffff5, 0x0ffffff6, 0x0ffffff7, 0x0ffffff8, 0x0ffffff9, 0x0ffffffa, 0x0ffffffb,
+    0x00000014, 0x000003f8, 0x000003f9, 0x00000ffa, 0x00001ff9, 0x00000015, 0x000000f8, 0x000007fa,
+    0x000003fa, 0x000003fb, 0x000000f9, 0x000007fb, 0x000000fa, 0x00000016, 0x00000017, 0x00000018,
+    0x00000000, 0x00000001, 0x00000002, 0x00000019, 0x0000001a, 0x0000001b, 0x0000001c, 0x0000001d,
+    0x0000001e, 0x0000001f, 0x0000005c, 0x000000fb, 0x00007ffc, 0x00000020, 0x00000ffb, 0x000003fc,
+    0x00001ffa, 0x00000021, 0x0000005d, 0x0000005e, 0x0000005f, 0x00000060, 0x00000061, 0x00000062,
+    0x00000063, 0x00000064, 0x00000065, 0x00000066, 0x00000067, 0x00000068, 0x00000069, 0x0000006a,
+    0x0000006b, 0x0000006c, 0x0000006d, 0x0000006e, 0x0000006f, 0x00000070, 0x00000071, 0x00000072,
+    0x000000fc, 0x00000073, 0x000000fd, 0x00001ffb, 0x0007fff0, 0x00001ffc, 0x00003ffc, 0x00000022,
+    0x00007ffd, 0x00000003, 0x00000023, 0x00000004, 0x00000024, 0x00000005, 0x00000025, 0x00000026,
+    0x00000027, 0x00000006, 0x00000074, 0x00000075, 0x00000028, 0x00000029, 0x0000002a, 0x00000007,
+    0x0000002b, 0x00000076, 0x0000002c, 0x00000008, 0x00000009, 0x0000002d, 0x00000077, 0x00000078,
+    0x00000079, 0x0000007a, 0x0000007b, 0x00007ffe, 0x000007fc, 0x00003ffd, 0x00001ffd, 0x0ffffffc,
+    0x000fffe6, 0x003fffd2, 0x000fffe7, 0x000fffe8, 0x003fffd3, 0x003fffd4, 0x003fffd5, 0x007fffd9,
+    0x003fffd6, 0x007fffda, 0x007fffdb, 0x007fffdc, 0x007fffdd, 0x007fffde, 0x00ffffeb, 0x007fffdf,
+    0x00ffffec, 0x00ffffed, 0x003fffd7, 0x007fffe0, 0x00ffffee, 0x007fffe1, 0x007fffe2, 0x007fffe3,
+    0x007fffe4, 0x001fffdc, 0x003fffd8, 0x007fffe5, 0x003fffd9, 0x007fffe6, 0x007fffe7, 0x00ffffef,
+    0x003fffda, 0x001fffdd, 0x000fffe9, 0x003fffdb, 0x003fffdc, 0x007fffe8, 0x007fffe9, 0x001fffde,
+    0x007fffea, 0x003fffdd, 0x003fffde, 0x00fffff0, 0x001fffdf, 0x003fffdf, 0x007fffeb, 0x007fffec,
+    0x001fffe0, 0x001fffe1, 0x003fffe0, 0x001fffe2, 0x007fffed, 0x003fffe1, 0x007fffee, 0x007fffef,
+    0x000fffea, 0x003fffe2, 0x003fffe3, 0x003fffe4, 0x007ffff0, 0x003fffe5, 0x003fffe6, 0x007ffff1,
+    0x03ffffe0, 0x03ffffe1, 0x000fffeb, 0x0007fff1, 0x003fffe7, 0x007ffff2, 0x003fffe8, 0x01ffffec,
+    0x03ffffe2, 0x03ffffe3, 0x03ffffe4, 0x07ffffde, 0x07ffffdf, 0x03ffffe5, 0x00fffff1, 0x01ffffed,
+    0x0007fff2, 0x001fffe3, 0x03ffffe6, 0x07ffffe0, 0x07ffffe1, 0x03ffffe7, 0x07ffffe2, 0x00fffff2,
+    0x001fffe4, 0x001fffe5, 0x03ffffe8, 0x03ffffe9, 0x0ffffffd, 0x07ffffe3, 0x07ffffe4, 0x07ffffe5,
+    0x000fffec, 0x00fffff3, 0x000fffed, 0x001fffe6, 0x003fffe9, 0x001fffe7, 0x001fffe8, 0x007ffff3,
+    0x003fffea, 0x003fffeb, 0x01ffffee, 0x01ffffef, 0x00fffff4, 0x00fffff5, 0x03ffffea, 0x007ffff4,
+    0x03ffffeb, 0x07ffffe6, 0x03ffffec, 0x03ffffed, 0x07ffffe7, 0x07ffffe8, 0x07ffffe9, 0x07ffffea,
+    0x07ffffeb, 0x0ffffffe, 0x07ffffec, 0x07ffffed, 0x07ffffee, 0x07ffffef, 0x07fffff0, 0x03ffffee,
+};
+const uint8_t huffman_code_len[256] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+     6, 10, 10, 12, 13,  6,  8, 11, 10, 10,  8, 11,  8,  6,  6,  6,
+     5,  5,  5,  6,  6,  6,  6,  6,  6,  6,  7,  8, 15,  6, 12, 10,
+    13,  6,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,
+     7,  7,  7,  7,  7,  7,  7,  7,  8,  7,  8, 13, 19, 13, 14,  6,
+    15,  5,  6,  5,  6,  5,  6,  6,  6,  5,  7,  7,  6,  6,  6,  5,
+     6,  7,  6,  5,  5,  6,  7,  7,  7,  7,  7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+};
+
+constexpr size_t MAX_CODE_LEN = 30;
+
+/**
+ * The huffman code is canonical; codes of the same length are
+ * consecutive numbers when symbols are sorted by (length, symbol),
+ * so decoding only needs the first code and first symbol of each
+ * length.
+ **/
+struct HuffmanDecodeTable {
+    uint32_t first_code[MAX_CODE_LEN + 1];
+    uint32_t count[MAX_CODE_LEN + 1];
+    uint32_t offset[MAX_CODE_LEN + 1];
+    uint8_t  symbols[256];
+    HuffmanDecodeTable() : first_code(), count(), offset(), symbols() {
+        size_t pos = 0;
+        for (size_t len = 1; len <= MAX_CODE_LEN; ++len) {
+            offset[len] = pos;
+            for (size_t sym = 0; sym < 256; ++sym) {
+                if (huffman_code_len[sym] == len) {
+                    if (count[len] == 0) {
+                        first_code[len] = huffman_codes[sym];
+                    }
+                    assert(huffman_codes[sym] == first_code[len] + count[len]);
+                    ++count[len];
+                    symbols[pos++] = sym;
+                }
+            }
+        }
+    }
+};
+
+const HuffmanDecodeTable &huffmanDecodeTable() {
+    static HuffmanDecodeTable table;
+    return table;
+}
+
+void encodeInt(uint8_t flags, size_t prefixBits, size_t value, string &dst) {
+    size_t limit = (size_t(1) << prefixBits) - 1;
+    if (value < limit) {
+        dst.push_back(char(flags | value));
+        return;
+    }
+    dst.push_back(char(flags | limit));
+    value -= limit;
+    while (value >= 128) {
+        dst.push_back(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    dst.push_back(char(value));
+}
+
+void encodeString(const string &str, string &dst) {
+    encodeInt(0x00, 7, str.size(), dst);
+    dst.append(str);
+}
+
+struct Reader {
+    const uint8_t *pos;
+    const uint8_t *end;
+    Reader(const char *data, size_t len)
+        : pos(reinterpret_cast<const uint8_t *>(data)), end(pos + len) {}
+    bool empty() const { return (pos == end); }
+    bool readInt(size_t prefixBits, size_t &value) {
+        if (empty()) {
+            return false;
+        }
+        size_t limit = (size_t(1) << prefixBits) - 1;
+        value = (*pos++ & limit);
+        if (value < limit) {
+            return true;
+        }
+        for (size_t shift = 0; shift < 56; shift += 7) {
+            if (empty()) {
+                return false;
+            }
+            uint8_t byte = *pos++;
+            value += size_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool readString(string &str) {
+        if (empty()) {
+            return false;
+        }
+        bool huffman = ((*pos & 0x80) != 0);
+        size_t len;
+        if (!readInt(7, len) || (size_t(end - pos) < len)) {
+            return false;
+        }
+        const char *data = reinterpret_cast<const char *>(pos);
+        pos += len;
+        if (huffman) {
+            str.clear();
+            return decodeHuffman(data, len, str);
+        }
+        str.assign(data, len);
+        return true;
+    }
+};
+
+} // namespace vbench::hpack::<unnamed>
+
+void
+encodeHeader(const string &name, const string &value, string &dst)
+{
+    for (size_t i = 0; i < STATIC_TABLE_SIZE; ++i) {
+        if (name == static_table[i].name) {
+            // literal header field without indexing, indexed name
+            encodeInt(0x00, 4, i + 1, dst);
+            encodeString(value, dst);
+            return;
+        }
+    }
+    // literal header field without indexing, new name
+    dst.push_back(char(0x00));
+    encodeString(name, dst);
+    encodeString(value, dst);
+}
+
+bool
+decodeHuffman(const char *data, size_t len, string &dst)
+{
+    const HuffmanDecodeTable &table = huffmanDecodeTable();
+    uint32_t code = 0;
+    size_t codeLen = 0;
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t byte = data[i];
+        for (int bit = 7; bit >= 0; --bit) {
+            code = (code << 1) | ((byte >> bit) & 1);
+            ++codeLen;
+            if (codeLen > MAX_CODE_LEN) {
+                return false; // EOS or garbage
+            }
+            if ((code - table.first_code[codeLen]) < table.count[codeLen]) {
+                dst.push_back(char(table.symbols[table.offset[codeLen] + (code - table.first_code[codeLen])]));
+                code = 0;
+                codeLen = 0;
+            }
+        }
+    }
+    // padding must be a prefix of EOS (all ones), shorter than 8 bits
+    return ((codeLen < 8) && (code == ((uint32_t(1) << codeLen) - 1)));
+}
+
+Decoder::Decoder()
+    : _table(),
+      _tableSize(0),
+      _maxTableSize(DEFAULT_TABLE_SIZE),
+      _tableSizeLimit(DEFAULT_TABLE_SIZE)
+{
+}
+
+Decoder::~Decoder() = default;
+
+void
+Decoder::evict(size_t maxSize)
+{
+    while (_tableSize > maxSize) {
+        const Header &last = _table.back();
+        _tableSize -= (last.first.size() + last.second.size() + ENTRY_OVERHEAD);
+        _table.pop_back();
+    }
+}
+
+void
+Decoder::insert(Header header)
+{
+    size_t size = header.first.size() + header.second.size() + ENTRY_OVERHEAD;
+    if (size > _maxTableSize) {
+        evict(0);
+        return;
+    }
+    evict(_maxTableSize - size);
+    _tableSize += size;
+    _table.push_front(std::move(header));
+}
+
+bool
+Decoder::lookup(size_t index, Header &header) const
+{
+    if (index == 0) {
+        return false;
+    }
+    if (index <= STATIC_TABLE_SIZE) {
+        header.first = static_table[index - 1].name;
+        header.second = static_table[index - 1].value;
+        return true;
+    }
+    index -= (STATIC_TABLE_SIZE + 1);
+    if (index < _table.size()) {
+        header = _table[index];
+        return true;
+    }
+    return false;
+}
+
+bool
+Decoder::decode(const char *data, size_t len, std::vector<Header> &headers)
+{
+    Reader reader(data, len);
+    while (!reader.empty()) {
+        uint8_t first = *reader.pos;
+        size_t index;
+        Header header;
+        if ((first & 0x80) != 0) { // indexed header field
+            if (!reader.readInt(7, index) || !lookup(index, header)) {
+                return false;
+            }
+            headers.push_back(std::move(header));
+            continue;
+        }
+        if ((first & 0xe0) == 0x20) { // dynamic table size update
+            if (!reader.readInt(5, index) || (index > _tableSizeLimit)) {
+                return false;
+            }
+            _maxTableSize = index;
+            evict(_maxTableSize);
+            continue;
+        }
+        bool incremental = ((first & 0xc0) == 0x40);
+        if (!reader.readInt(incremental ? 6 : 4, index)) {
+            return false;
+        }
+        if (index == 0) {
+            if (!reader.readString(header.first)) {
+                return false;
+            }
+        } else if (!lookup(index, header)) {
+            return false;
+        }
+        if (!reader.readString(header.second)) {
+            return false;
+        }
+        if (incremental) {
+            insert(header);
+        }
+        headers.push_back(std::move(header));
+    }
+    return true;
+}
+
+} // namespace vbench::hpack
@@ -0,0 +1,60 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vbench/core/string.h>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace vbench {
+
+/**
+ * Minimal HPACK (RFC 7541) header compression for HTTP/2 clients.
+ *
+ * The encoder emits all headers as literals without indexing (using
+ * static table names where possible) and without huffman coding,
+ * which means it keeps no state. The decoder supports the full
+ * format, including the dynamic table and huffman coded strings, and
+ * must see every header block on a connection in order.
+ **/
+namespace hpack {
+
+using Header = std::pair<string, string>;
+
+void encodeHeader(const string &name, const string &value, string &dst);
+
+class Decoder
+{
+private:
+    std::deque<Header> _table; // newest first
+    size_t             _tableSize;
+    size_t             _maxTableSize;
+    size_t             _tableSizeLimit;
+
+    void evict(size_t maxSize);
+    void insert(Header header);
+    bool lookup(size_t index, Header &header) const;
+
+public:
+    static constexpr size_t DEFAULT_TABLE_SIZE = 4096;
+
+    Decoder();
+    ~Decoder();
+    size_t tableSize() const { return _tableSize; }
+    size_t numEntries() const { return _table.size(); }
+
+    /**
+     * Decode a complete header block, appending the headers to
+     * 'headers'. Returns false if the block is malformed, in which
+     * case the decoder state is undefined and the connection must be
+     * abandoned.
+     **/
+    bool decode(const char *data, size_t len, std::vector<Header> &headers);
+};
+
+bool decodeHuffman(const char *data, size_t len, string &dst);
+
+} // namespace vbench::hpack
+
+} // namespace vbench
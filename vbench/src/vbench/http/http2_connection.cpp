@@ -0,0 +1,594 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "http2_connection.h"
+#include <vespa/vespalib/net/socket_options.h>
+#include <vespa/vespalib/net/socket_spec.h>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+
+namespace vbench {
+
+namespace {
+
+constexpr size_t READ_SIZE = 32768;
+constexpr size_t FRAME_HEADER_SIZE = 9;
+constexpr size_t MAX_FRAME_SIZE = 16384;
+constexpr uint32_t MAX_WINDOW_SIZE = 0x7fffffff;
+constexpr uint32_t DEFAULT_WINDOW_SIZE = 65535;
+constexpr size_t WINDOW_UPDATE_THRESHOLD = (1u << 30);
+constexpr uint32_t MAX_STREAM_ID = 0x7fffffff;
+
+const char CLIENT_PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+namespace frame {
+constexpr uint8_t DATA          = 0x0;
+constexpr uint8_t HEADERS       = 0x1;
+constexpr uint8_t RST_STREAM    = 0x3;
+constexpr uint8_t SETTINGS      = 0x4;
+constexpr uint8_t PUSH_PROMISE  = 0x5;
+constexpr uint8_t PING          = 0x6;
+constexpr uint8_t GOAWAY        = 0x7;
+constexpr uint8_t WINDOW_UPDATE = 0x8;
+constexpr uint8_t CONTINUATION  = 0x9;
+} // namespace vbench::<unnamed>::frame
+
+namespace flag {
+constexpr uint8_t END_STREAM  = 0x1;
+constexpr uint8_t ACK         = 0x1;
+constexpr uint8_t END_HEADERS = 0x4;
+constexpr uint8_t PADDED      = 0x8;
+constexpr uint8_t PRIORITY    = 0x20;
+} // namespace vbench::<unnamed>::flag
+
+namespace setting {
+constexpr uint16_t ENABLE_PUSH            = 0x2;
+constexpr uint16_t MAX_CONCURRENT_STREAMS = 0x3;
+constexpr uint16_t INITIAL_WINDOW_SIZE    = 0x4;
+} // namespace vbench::<unnamed>::setting
+
+constexpr uint32_t CANCEL = 0x8;
+
+uint32_t read_u32(const char *src) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(src);
+    return ((uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]));
+}
+
+void append_u16(string &dst, uint16_t value) {
+    dst.push_back(char(value >> 8));
+    dst.push_back(char(value));
+}
+
+void append_u32(string &dst, uint32_t value) {
+    append_u16(dst, value >> 16);
+    append_u16(dst, value);
+}
+
+void append_frame(string &dst, uint8_t type, uint8_t flags, uint32_t streamId,
+                  const char *payload, size_t len)
+{
+    dst.push_back(char(len >> 16));
+    dst.push_back(char(len >> 8));
+    dst.push_back(char(len));
+    dst.push_back(char(type));
+    dst.push_back(char(flags));
+    append_u32(dst, streamId & MAX_STREAM_ID);
+    dst.append(payload, len);
+}
+
+void append_frame(string &dst, uint8_t type, uint8_t flags, uint32_t streamId, const string &payload) {
+    append_frame(dst, type, flags, streamId, payload.data(), payload.size());
+}
+
+void append_window_update(string &dst, uint32_t streamId, uint32_t increment) {
+    string payload;
+    append_u32(payload, increment);
+    append_frame(dst, frame::WINDOW_UPDATE, 0, streamId, payload);
+}
+
+void append(vespalib::SimpleBuffer &dst, const string &data) {
+    if (!data.empty()) {
+        memcpy(dst.reserve(data.size()).data, data.data(), data.size());
+        dst.commit(data.size());
+    }
+}
+
+bool is_blocked(ssize_t res, int error) {
+    return ((res < 0) && ((error == EWOULDBLOCK) || (error == EAGAIN)));
+}
+
+bool strip_padding(uint8_t flags, const char *&payload, size_t &len) {
+    if ((flags & flag::PADDED) != 0) {
+        if (len < 1) {
+            return false;
+        }
+        size_t pad = uint8_t(payload[0]);
+        if (pad >= len) {
+            return false;
+        }
+        ++payload;
+        len -= (pad + 1);
+    }
+    return true;
+}
+
+} // namespace vbench::<unnamed>
+
+void
+Http2Connection::wakeup()
+{
+    char token = 0;
+    ssize_t res = ::write(_wakeupPipe[1], &token, 1);
+    (void) res; // pipe full means a wakeup is already pending
+}
+
+bool
+Http2Connection::connect()
+{
+    auto tweak = [](vespalib::SocketHandle &handle) {
+        return handle.set_nodelay(true);
+    };
+    auto spec = vespalib::SocketSpec::from_host_port(_server.host, _server.port);
+    vespalib::SocketHandle handle = spec.client_address().connect(tweak);
+    if (!handle.valid()) {
+        return false;
+    }
+    _socket = _crypto->create_client_crypto_socket(std::move(handle), spec);
+    vespalib::SocketOptions::set_blocking(_socket->get_fd(), true);
+    for (;;) {
+        switch (_socket->handshake()) {
+        case CryptoSocket::HandshakeResult::FAIL:
+            return false;
+        case CryptoSocket::HandshakeResult::DONE:
+            vespalib::SocketOptions::set_blocking(_socket->get_fd(), false);
+            return true;
+        case CryptoSocket::HandshakeResult::NEED_READ:
+        case CryptoSocket::HandshakeResult::NEED_WRITE:
+            break;
+        case CryptoSocket::HandshakeResult::NEED_WORK:
+            _socket->do_handshake_work();
+        }
+    }
+}
+
+bool
+Http2Connection::readInput()
+{
+    size_t chunk = std::max(READ_SIZE, _socket->min_read_buffer_size());
+    for (;;) {
+        auto dst = _input.reserve(chunk);
+        ssize_t res = _socket->read(dst.data, dst.size);
+        if (res > 0) {
+            _input.commit(res);
+        } else if (res == 0) {
+            _error = "connection closed by server";
+            return false;
+        } else if (is_blocked(res, errno)) {
+            break;
+        } else {
+            _error = strfmt("read error: %s", strerror(errno));
+            return false;
+        }
+    }
+    for (;;) {
+        auto dst = _input.reserve(chunk);
+        ssize_t res = _socket->drain(dst.data, dst.size);
+        if (res > 0) {
+            _input.commit(res);
+        } else if (res == 0) {
+            return true;
+        } else {
+            _error = strfmt("read error: %s", strerror(errno));
+            return false;
+        }
+    }
+}
+
+bool
+Http2Connection::writeOutput()
+{
+    _needWrite = false;
+    for (auto data = _output.obtain(); data.size > 0; data = _output.obtain()) {
+        ssize_t res = _socket->write(data.data, data.size);
+        if (res > 0) {
+            _output.evict(res);
+        } else if (is_blocked(res, errno)) {
+            _needWrite = true;
+            return true;
+        } else {
+            _error = strfmt("write error: %s", strerror(errno));
+            return false;
+        }
+    }
+    for (;;) {
+        ssize_t res = _socket->flush();
+        if (res == 0) {
+            return true;
+        } else if (is_blocked(res, errno)) {
+            _needWrite = true;
+            return true;
+        } else if (res < 0) {
+            _error = strfmt("write error: %s", strerror(errno));
+            return false;
+        }
+    }
+}
+
+Http2Connection::Stream *
+Http2Connection::findStream(uint32_t streamId)
+{
+    std::lock_guard guard(_lock);
+    auto pos = _streams.find(streamId);
+    return (pos == _streams.end()) ? nullptr : pos->second;
+}
+
+void
+Http2Connection::completeStream(uint32_t streamId, bool failed)
+{
+    std::lock_guard guard(_lock);
+    auto pos = _streams.find(streamId);
+    if (pos != _streams.end()) {
+        Stream &stream = *pos->second;
+        _streams.erase(pos);
+        stream.failed = failed;
+        stream.done = true;
+        stream.cond.notify_one();
+        _cond.notify_all();
+    }
+}
+
+void
+Http2Connection::failStreams(uint32_t minStreamId, const string &reason)
+{
+    std::vector<uint32_t> failed;
+    {
+        std::lock_guard guard(_lock);
+        for (auto pos = _streams.lower_bound(minStreamId); pos != _streams.end(); ++pos) {
+            failed.push_back(pos->first);
+        }
+    }
+    for (uint32_t streamId: failed) {
+        // streams are only completed by the io thread, so they are still alive
+        findStream(streamId)->handler.handleFailure(reason);
+        completeStream(streamId, true);
+    }
+}
+
+void
+Http2Connection::fail(const string &reason)
+{
+    {
+        std::lock_guard guard(_lock);
+        _usable = false;
+        _failure = reason;
+        _cond.notify_all();
+    }
+    failStreams(0, strfmt("http2 connection failed: %s", reason.c_str()));
+}
+
+bool
+Http2Connection::handleHeaderBlock(uint32_t streamId, bool endStream)
+{
+    std::vector<hpack::Header> headers;
+    if (!_decoder.decode(_headerBlock.data(), _headerBlock.size(), headers)) {
+        _error = "malformed header block";
+        return false;
+    }
+    _headerBlock.clear();
+    Stream *stream = findStream(streamId);
+    if (stream == nullptr) {
+        return true; // stream was reset by us
+    }
+    if (!stream->gotHeaders) {
+        string status;
+        for (const auto &header: headers) {
+            if (header.first == ":status") {
+                status = header.second;
+            }
+        }
+        if ((status.size() == 3) && (status[0] == '1')) {
+            return true; // informational response
+        }
+        stream->gotHeaders = true;
+        if (status != "200") {
+            stream->handler.handleFailure(strfmt("HTTP status not 200: '%s'", status.c_str()));
+            if (!endStream) {
+                string payload;
+                append_u32(payload, CANCEL);
+                string out;
+                append_frame(out, frame::RST_STREAM, 0, streamId, payload);
+                append(_output, out);
+            }
+            completeStream(streamId, true);
+            return true;
+        }
+        for (const auto &header: headers) {
+            if (header.first.find("x-yahoo-vespa-") == 0) {
+                stream->handler.handleHeader(header.first, header.second);
+            }
+        }
+    }
+    if (endStream) {
+        completeStream(streamId, false);
+    }
+    return true;
+}
+
+bool
+Http2Connection::handleFrame(uint8_t type, uint8_t flags, uint32_t streamId, const char *payload, size_t len)
+{
+    if ((_headerStreamId != 0) && ((type != frame::CONTINUATION) || (streamId != _headerStreamId))) {
+        _error = "expected CONTINUATION frame";
+        return false;
+    }
+    string out;
+    switch (type) {
+    case frame::DATA: {
+        _unackedBytes += len;
+        if (_unackedBytes >= WINDOW_UPDATE_THRESHOLD) {
+            append_window_update(out, 0, _unackedBytes);
+            _unackedBytes = 0;
+        }
+        if (!strip_padding(flags, payload, len)) {
+            _error = "invalid padding in DATA frame";
+            return false;
+        }
+        Stream *stream = findStream(streamId);
+        if (stream != nullptr) {
+            if (len > 0) {
+                stream->handler.handleContent(Memory(payload, len));
+            }
+            if ((flags & flag::END_STREAM) != 0) {
+                completeStream(streamId, false);
+            }
+        }
+        break;
+    }
+    case frame::HEADERS:
+        if (!strip_padding(flags, payload, len)) {
+            _error = "invalid padding in HEADERS frame";
+            return false;
+        }
+        if ((flags & flag::PRIORITY) != 0) {
+            if (len < 5) {
+                _error = "short HEADERS frame";
+                return false;
+            }
+            payload += 5;
+            len -= 5;
+        }
+        _headerBlock.assign(payload, len);
+        _headerEndStream = ((flags & flag::END_STREAM) != 0);
+        if ((flags & flag::END_HEADERS) != 0) {
+            return handleHeaderBlock(streamId, _headerEndStream);
+        }
+        _headerStreamId = streamId;
+        break;
+    case frame::CONTINUATION:
+        if (_headerStreamId == 0) {
+            _error = "unexpected CONTINUATION frame";
+            return false;
+        }
+        _headerBlock.append(payload, len);
+        if ((flags & flag::END_HEADERS) != 0) {
+            _headerStreamId = 0;
+            return handleHeaderBlock(streamId, _headerEndStream);
+        }
+        break;
+    case frame::RST_STREAM: {
+        Stream *stream = findStream(streamId);
+        if (stream != nullptr) {
+            uint32_t error = (len >= 4) ? read_u32(payload) : 0;
+            stream->handler.handleFailure(strfmt("stream reset by server: error code %u", error));
+            completeStream(streamId, true);
+        }
+        break;
+    }
+    case frame::SETTINGS:
+        if ((flags & flag::ACK) == 0) {
+            for (size_t i = 0; (i + 6) <= len; i += 6) {
+                uint16_t id = (uint16_t(uint8_t(payload[i])) << 8) | uint8_t(payload[i + 1]);
+                uint32_t value = read_u32(payload + i + 2);
+                if (id == setting::MAX_CONCURRENT_STREAMS) {
+                    std::lock_guard guard(_lock);
+                    _maxStreams = value;
+                    _cond.notify_all();
+                }
+            }
+            append_frame(out, frame::SETTINGS, flag::ACK, 0, nullptr, 0);
+        }
+        break;
+    case frame::PUSH_PROMISE:
+        _error = "unexpected PUSH_PROMISE frame";
+        return false;
+    case frame::PING:
+        if ((flags & flag::ACK) == 0) {
+            append_frame(out, frame::PING, flag::ACK, 0, payload, len);
+        }
+        break;
+    case frame::GOAWAY: {
+        uint32_t lastStreamId = (len >= 4) ? (read_u32(payload) & MAX_STREAM_ID) : 0;
+        {
+            std::lock_guard guard(_lock);
+            _usable = false;
+            _failure = "connection shut down by server";
+            _cond.notify_all();
+        }
+        failStreams(lastStreamId + 1, "connection shut down by server");
+        break;
+    }
+    default: // PRIORITY, WINDOW_UPDATE and unknown frames are ignored
+        break;
+    }
+    append(_output, out);
+    return true;
+}
+
+void
+Http2Connection::run()
+{
+    if (!connect()) {
+        fail(strfmt("connect failed: host: %s, port: %d", _server.host.c_str(), _server.port));
+        return;
+    }
+    {
+        string out(CLIENT_PREFACE, sizeof(CLIENT_PREFACE) - 1);
+        string settings;
+        append_u16(settings, setting::ENABLE_PUSH);
+        append_u32(settings, 0);
+        append_u16(settings, setting::INITIAL_WINDOW_SIZE);
+        append_u32(settings, MAX_WINDOW_SIZE);
+        append_frame(out, frame::SETTINGS, 0, 0, settings);
+        append_window_update(out, 0, MAX_WINDOW_SIZE - DEFAULT_WINDOW_SIZE);
+        append(_output, out);
+    }
+    for (;;) {
+        {
+            std::lock_guard guard(_lock);
+            if (_shutdown) {
+                break;
+            }
+            append(_output, _pending);
+            _pending.clear();
+        }
+        // frames received before the connection failed are still handled
+        bool ok = (writeOutput() && readInput());
+        bool parsing = true;
+        for (auto data = _input.obtain(); parsing && (data.size >= FRAME_HEADER_SIZE); data = _input.obtain()) {
+            const unsigned char *hdr = reinterpret_cast<const unsigned char *>(data.data);
+            size_t len = (size_t(hdr[0]) << 16) | (size_t(hdr[1]) << 8) | size_t(hdr[2]);
+            if (data.size < (FRAME_HEADER_SIZE + len)) {
+                break;
+            }
+            uint32_t streamId = read_u32(data.data + 5) & MAX_STREAM_ID;
+            parsing = handleFrame(hdr[3], hdr[4], streamId, data.data + FRAME_HEADER_SIZE, len);
+            _input.evict(FRAME_HEADER_SIZE + len);
+        }
+        if (!ok || !parsing) {
+            break;
+        }
+        if (_output.get().size > 0) {
+            continue; // frames produced while handling input
+        }
+        pollfd fds[2];
+        fds[0].fd = _socket->get_fd();
+        fds[0].events = _needWrite ? (POLLIN | POLLOUT) : POLLIN;
+        fds[1].fd = _wakeupPipe[0];
+        fds[1].events = POLLIN;
+        fds[0].revents = fds[1].revents = 0;
+        if (::poll(fds, 2, -1) > 0 && (fds[1].revents & POLLIN) != 0) {
+            char tokens[64];
+            while (::read(_wakeupPipe[0], tokens, sizeof(tokens)) > 0) {}
+        }
+    }
+    fail(_error.empty() ? string("connection shut down") : _error);
+    if (_socket) {
+        _socket->half_close();
+    }
+}
+
+Http2Connection::Http2Connection(CryptoEngine::SP crypto, const ServerSpec &server)
+    : _crypto(std::move(crypto)),
+      _server(server),
+      _lock(),
+      _cond(),
+      _streams(),
+      _pending(),
+      _nextStreamId(1),
+      _maxStreams(100),
+      _usable(true),
+      _shutdown(false),
+      _failure(),
+      _wakeupPipe{-1, -1},
+      _socket(),
+      _input(),
+      _output(),
+      _needWrite(false),
+      _decoder(),
+      _headerStreamId(0),
+      _headerEndStream(false),
+      _headerBlock(),
+      _unackedBytes(0),
+      _error(),
+      _thread(*this)
+{
+    if (::pipe(_wakeupPipe) != 0) {
+        _usable = false;
+        _failure = "could not create wakeup pipe";
+        return;
+    }
+    vespalib::SocketOptions::set_blocking(_wakeupPipe[0], false);
+    vespalib::SocketOptions::set_blocking(_wakeupPipe[1], false);
+    _thread.start();
+}
+
+Http2Connection::~Http2Connection()
+{
+    {
+        std::lock_guard guard(_lock);
+        _shutdown = true;
+    }
+    if (_wakeupPipe[1] >= 0) {
+        wakeup();
+        _thread.join();
+        ::close(_wakeupPipe[0]);
+        ::close(_wakeupPipe[1]);
+    }
+}
+
+bool
+Http2Connection::usable()
+{
+    std::lock_guard guard(_lock);
+    return _usable;
+}
+
+bool
+Http2Connection::fetch(const string &url, HttpResultHandler &handler)
+{
+    string block;
+    hpack::encodeHeader(":method", "GET", block);
+    hpack::encodeHeader(":scheme", _crypto->use_tls_when_client() ? "https" : "http", block);
+    hpack::encodeHeader(":authority", strfmt("%s:%d", _server.host.c_str(), _server.port), block);
+    hpack::encodeHeader(":path", url, block);
+    hpack::encodeHeader("user-agent", "vbench", block);
+    hpack::encodeHeader("x-yahoo-vespa-benchmarkdata", "true", block);
+    hpack::encodeHeader("x-yahoo-vespa-benchmarkdata-coverage", "true", block);
+    Stream stream(handler);
+    std::unique_lock guard(_lock);
+    while (_usable && (_streams.size() >= _maxStreams)) {
+        _cond.wait(guard);
+    }
+    if (!_usable) {
+        string reason = strfmt("http2 connection failed: %s", _failure.c_str());
+        guard.unlock();
+        handler.handleFailure(reason);
+        return false;
+    }
+    uint32_t streamId = _nextStreamId;
+    _nextStreamId += 2;
+    if (_nextStreamId > MAX_STREAM_ID) {
+        _usable = false;
+        _failure = "stream ids exhausted";
+    }
+    _streams[streamId] = &stream;
+    size_t offset = 0;
+    do {
+        size_t len = std::min(MAX_FRAME_SIZE, block.size() - offset);
+        uint8_t flags = ((offset + len) == block.size()) ? flag::END_HEADERS : 0;
+        if (offset == 0) {
+            append_frame(_pending, frame::HEADERS, flags | flag::END_STREAM, streamId, block.data(), len);
+        } else {
+            append_frame(_pending, frame::CONTINUATION, flags, streamId, block.data() + offset, len);
+        }
+        offset += len;
+    } while (offset < block.size());
+    wakeup();
+    while (!stream.done) {
+        stream.cond.wait(guard);
+    }
+    return !stream.failed;
+}
+
+} // namespace vbench
@@ -0,0 +1,105 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "hpack.h"
+#include "http_result_handler.h"
+#include "server_spec.h"
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/vespalib/net/crypto_engine.h>
+#include <vespa/vespalib/util/runnable.h>
+#include <vespa/vespalib/util/thread.h>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+namespace vbench {
+
+/**
+ * A HTTP/2 connection to a specific server, multiplexing concurrent
+ * requests from multiple threads as separate streams. Requests are
+ * sent with prior knowledge of HTTP/2 support (h2c) for plain
+ * connections; TLS connections should offer 'h2' by ALPN.
+ *
+ * All network io is done by an internal thread using a non-blocking
+ * crypto socket, since TLS does not allow concurrent reading and
+ * writing from different threads. Response headers and content are
+ * passed to the result handler from the io thread while the
+ * requesting thread is waiting for the response.
+ *
+ * A connection that failed or was shut down by the server is no
+ * longer usable; requests in flight fail, and new requests fail
+ * immediately.
+ **/
+class Http2Connection : public vespalib::Runnable
+{
+public:
+    using CryptoEngine = vespalib::CryptoEngine;
+    using CryptoSocket = vespalib::CryptoSocket;
+    using SimpleBuffer = vespalib::SimpleBuffer;
+    typedef std::shared_ptr<Http2Connection> SP;
+
+private:
+    struct Stream {
+        HttpResultHandler      &handler;
+        std::condition_variable cond;
+        bool                    gotHeaders;
+        bool                    done;
+        bool                    failed;
+        Stream(HttpResultHandler &h)
+            : handler(h), cond(), gotHeaders(false), done(false), failed(false) {}
+    };
+
+    CryptoEngine::SP          _crypto;
+    ServerSpec                _server;
+    std::mutex                _lock;
+    std::condition_variable   _cond;
+    std::map<uint32_t,Stream*> _streams;
+    string                    _pending;
+    uint32_t                  _nextStreamId;
+    uint32_t                  _maxStreams;
+    bool                      _usable;
+    bool                      _shutdown;
+    string                    _failure;
+    int                       _wakeupPipe[2];
+
+    // used by the io thread only
+    CryptoSocket::UP          _socket;
+    SimpleBuffer              _input;
+    SimpleBuffer              _output;
+    bool                      _needWrite;
+    hpack::Decoder            _decoder;
+    uint32_t                  _headerStreamId;
+    bool                      _headerEndStream;
+    string                    _headerBlock;
+    size_t                    _unackedBytes;
+    string                    _error;
+
+    vespalib::Thread          _thread;
+
+    void wakeup();
+    bool connect();
+    bool readInput();
+    bool writeOutput();
+    bool handleFrame(uint8_t type, uint8_t flags, uint32_t streamId, const char *payload, size_t len);
+    bool handleHeaderBlock(uint32_t streamId, bool endStream);
+    Stream *findStream(uint32_t streamId);
+    void completeStream(uint32_t streamId, bool failed);
+    void failStreams(uint32_t minStreamId, const string &reason);
+    void fail(const string &reason);
+    void run() override;
+
+public:
+    Http2Connection(CryptoEngine::SP crypto, const ServerSpec &server);
+    ~Http2Connection();
+    const ServerSpec &server() const { return _server; }
+    bool usable();
+
+    /**
+     * Perform a GET request for the given url, blocking until the
+     * response is complete. Returns true if the request succeeded.
+     **/
+    bool fetch(const string &url, HttpResultHandler &handler);
+};
+
+} // namespace vbench
@@ -0,0 +1,35 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "http2_connection_pool.h"
+
+namespace vbench {
+
+Http2ConnectionPool::Http2ConnectionPool(CryptoEngine::SP crypto, size_t connectionsPerServer)
+    : _lock(),
+      _map(),
+      _crypto(std::move(crypto)),
+      _connectionsPerServer(std::max(connectionsPerServer, size_t(1)))
+{
+}
+
+Http2ConnectionPool::~Http2ConnectionPool() = default;
+
+Http2Connection::SP
+Http2ConnectionPool::getConnection(const ServerSpec &server)
+{
+    std::lock_guard guard(_lock);
+    Entry &entry = _map[server];
+    if (entry.conns.size() < _connectionsPerServer) {
+        entry.conns.push_back(std::make_shared<Http2Connection>(_crypto, server));
+        return entry.conns.back();
+    }
+    Http2Connection::SP &conn = entry.conns[entry.next];
+    entry.next = (entry.next + 1) % entry.conns.size();
+    if (!conn->usable()) {
+        // requests still using the old connection keep it alive
+        conn = std::make_shared<Http2Connection>(_crypto, server);
+    }
+    return conn;
+}
+
+} // namespace vbench
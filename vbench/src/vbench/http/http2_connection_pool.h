@@ -0,0 +1,47 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "http2_connection.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace vbench {
+
+/**
+ * A fixed number of shared HTTP/2 connections per server. Requests
+ * are spread across the connections of a server round-robin, and
+ * each connection multiplexes the requests given to it. Connections
+ * that are no longer usable are replaced on demand.
+ **/
+class Http2ConnectionPool
+{
+private:
+    struct Entry {
+        std::vector<Http2Connection::SP> conns;
+        size_t next;
+        Entry() : conns(), next(0) {}
+    };
+    using CryptoEngine = vespalib::CryptoEngine;
+
+    std::mutex                  _lock;
+    std::map<ServerSpec, Entry> _map;
+    CryptoEngine::SP            _crypto;
+    size_t                      _connectionsPerServer;
+
+public:
+    Http2ConnectionPool(CryptoEngine::SP crypto, size_t connectionsPerServer);
+    ~Http2ConnectionPool();
+    Http2Connection::SP getConnection(const ServerSpec &server);
+
+    /**
+     * Perform a GET request against the given server using one of
+     * its pooled connections.
+     **/
+    bool fetch(const ServerSpec &server, const string &url, HttpResultHandler &handler) {
+        return getConnection(server)->fetch(url, handler);
+    }
+};
+
+} // namespace vbench
@@ -16,6 +16,7 @@
 #include <vbench/vbench/server_tagger.h>
 #include <vbench/vbench/request.h>
 #include <vbench/vbench/latency_analyzer.h>
+#include <vbench/vbench/hdr_latency_analyzer.h>
 #include <vbench/core/input_file_reader.h>
 #include <vbench/core/line_reader.h>
 #include <vbench/core/string.h>
@@ -25,6 +26,7 @@
 #include <vespa/vespalib/data/memory.h>
 #include <vespa/vespalib/io/mapped_file_input.h>
 #include <vbench/core/time_queue.h>
+#include <vbench/core/hdr_histogram.h>
 #include <vespa/vespalib/data/output_writer.h>
 #include <vbench/core/socket.h>
 #include <vbench/core/handler_thread.h>
@@ -46,4 +48,7 @@
 #include <vbench/http/http_connection.h>
 #include <vbench/http/server_spec.h>
 #include <vbench/http/http_connection_pool.h>
+#include <vbench/http/hpack.h>
+#include <vbench/http/http2_connection.h>
+#include <vbench/http/http2_connection_pool.h>
 
@@ -0,0 +1,94 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hdr_latency_analyzer.h"
+#include <cmath>
+
+namespace vbench {
+
+HdrLatencyAnalyzer::Interval &
+HdrLatencyAnalyzer::intervalAt(double time)
+{
+    size_t idx = (size_t)std::floor(std::max(time, 0.0) / _interval);
+    while (idx >= _series.size()) {
+        _series.emplace_back();
+    }
+    return _series[idx];
+}
+
+HdrLatencyAnalyzer::HdrLatencyAnalyzer(Handler<Request> &next, bool fromScheduledTime, double interval)
+    : _next(next),
+      _fromScheduledTime(fromScheduledTime),
+      _interval((interval > 0.0) ? interval : 1.0),
+      _latency(RESOLUTION),
+      _series()
+{
+}
+
+HdrLatencyAnalyzer::~HdrLatencyAnalyzer() = default;
+
+void
+HdrLatencyAnalyzer::handle(Request::UP request)
+{
+    if (_fromScheduledTime) {
+        addRequest(request->scheduledTime(), request->status(), request->scheduledLatency());
+    } else {
+        addRequest(request->startTime(), request->status(), request->latency());
+    }
+    _next.handle(std::move(request));
+}
+
+void
+HdrLatencyAnalyzer::report()
+{
+    fprintf(stdout, "%s\n", summary().c_str());
+    fprintf(stdout, "%s\n", timeSeries().c_str());
+    fprintf(stdout, "%s\n", _latency.percentileDistribution(1000.0).c_str());
+}
+
+void
+HdrLatencyAnalyzer::addRequest(double time, Request::Status status, double latency)
+{
+    Interval &interval = intervalAt(time);
+    if (status == Request::STATUS_OK) {
+        _latency.add(latency);
+        interval.latency.add(latency);
+    } else if (status == Request::STATUS_DROPPED) {
+        ++interval.dropped;
+    } else {
+        ++interval.failed;
+    }
+}
+
+string
+HdrLatencyAnalyzer::summary() const
+{
+    string str = strfmt("HdrLatency (from %s time) {\n", _fromScheduledTime ? "scheduled" : "start");
+    str += strfmt("  count: %zu\n", _latency.count());
+    str += strfmt("  min: %g\n", _latency.min());
+    str += strfmt("  avg: %g\n", _latency.mean());
+    str += strfmt("  max: %g\n", _latency.max());
+    str += strfmt("  50%%: %g\n", _latency.percentile(50.0));
+    str += strfmt("  90%%: %g\n", _latency.percentile(90.0));
+    str += strfmt("  99%%: %g\n", _latency.percentile(99.0));
+    str += strfmt("  99.9%%: %g\n", _latency.percentile(99.9));
+    str += strfmt("  99.99%%: %g\n", _latency.percentile(99.99));
+    str += "}\n";
+    return str;
+}
+
+string
+HdrLatencyAnalyzer::timeSeries() const
+{
+    string str = "#time\tok\tfailed\tdropped\tavg\t50%\t99%\t99.9%\tmax\n";
+    for (size_t i = 0; i < _series.size(); ++i) {
+        const Interval &interval = _series[i];
+        str += strfmt("%g\t%zu\t%zu\t%zu\t%g\t%g\t%g\t%g\t%g\n", i * _interval,
+                      interval.latency.count(), interval.failed, interval.dropped,
+                      interval.latency.mean(), interval.latency.percentile(50.0),
+                      interval.latency.percentile(99.0), interval.latency.percentile(99.9),
+                      interval.latency.max());
+    }
+    return str;
+}
+
+} // namespace vbench
@@ -0,0 +1,52 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "analyzer.h"
+#include <vbench/core/hdr_histogram.h>
+
+namespace vbench {
+
+/**
+ * Component recording the latency of successful requests in HDR
+ * histograms, both in total and per time interval. By default,
+ * latency is measured from the scheduled time of the request rather
+ * than the time it was actually sent, and requests are assigned to
+ * intervals by scheduled time. Combined with an open loop request
+ * scheduler, this reports the latency seen by users sending requests
+ * at the target rate, also when the server stalls.
+ **/
+class HdrLatencyAnalyzer : public Analyzer
+{
+public:
+    static constexpr double RESOLUTION = 0.000001; // 1 us
+
+    struct Interval {
+        HdrHistogram latency;
+        size_t       failed;
+        size_t       dropped;
+        Interval() : latency(RESOLUTION), failed(0), dropped(0) {}
+    };
+
+private:
+    Handler<Request>      &_next;
+    bool                   _fromScheduledTime;
+    double                 _interval;
+    HdrHistogram           _latency;
+    std::vector<Interval>  _series;
+
+    Interval &intervalAt(double time);
+
+public:
+    HdrLatencyAnalyzer(Handler<Request> &next, bool fromScheduledTime, double interval);
+    ~HdrLatencyAnalyzer() override;
+    void handle(Request::UP request) override;
+    void report() override;
+    void addRequest(double time, Request::Status status, double latency);
+    const HdrHistogram &latency() const { return _latency; }
+    const std::vector<Interval> &series() const { return _series; }
+    string summary() const;
+    string timeSeries() const;
+};
+
+} // namespace vbench
@@ -6,6 +6,7 @@
 #include "server_tagger.h"
 #include "qps_tagger.h"
 #include "latency_analyzer.h"
+#include "hdr_latency_analyzer.h"
 #include "qps_analyzer.h"
 #include "request_dumper.h"
 #include "ignore_before.h"
@@ -46,6 +47,11 @@ NativeFactory::createAnalyzer(const vespalib::slime::Inspector &spec,
     if (type == "LatencyAnalyzer") {
         return Analyzer::UP(new LatencyAnalyzer(next));
     }
+    if (type == "HdrLatencyAnalyzer") {
+        bool fromScheduledTime = !spec["from_start_time"].asBool();
+        double interval = spec["interval"].valid() ? spec["interval"].asDouble() : 1.0;
+        return Analyzer::UP(new HdrLatencyAnalyzer(next, fromScheduledTime, interval));
+    }
     if (type == "QpsAnalyzer") {
         return Analyzer::UP(new QpsAnalyzer(next));
     }
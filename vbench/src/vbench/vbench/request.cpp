@@ -50,6 +50,7 @@ Request::toString() const
     str += strfmt("  startTime: %g\n", _startTime);
     str += strfmt("  endTime: %g\n", _endTime);
     str += strfmt("  latency: %g\n", latency());
+    str += strfmt("  scheduledLatency: %g\n", scheduledLatency());
     str += strfmt("  size: %zu\n", _size);
     str += _headers.toString();
     str += "}\n";
@@ -22,18 +22,20 @@ RequestScheduler::run()
     }
 }
 
-RequestScheduler::RequestScheduler(CryptoEngine::SP crypto, Handler<Request> &next, size_t numWorkers)
+RequestScheduler::RequestScheduler(CryptoEngine::SP crypto, Handler<Request> &next, size_t numWorkers,
+                                   bool openLoop, size_t http2Connections)
     : _timer(),
       _proxy(next),
       _queue(10.0, 0.020),
       _droppedTagger(_proxy),
-      _dispatcher(_droppedTagger),
+      _dispatcher(_droppedTagger, openLoop),
       _thread(*this),
-      _connectionPool(std::move(crypto), _timer),
+      _connectionPool(crypto, _timer),
+      _http2Pool((http2Connections > 0) ? std::make_unique<Http2ConnectionPool>(std::move(crypto), http2Connections) : nullptr),
       _workers()
 {
     for (size_t i = 0; i < numWorkers; ++i) {
-        _workers.push_back(std::unique_ptr<Worker>(new Worker(_dispatcher, _proxy, _connectionPool, _timer)));
+        _workers.push_back(std::unique_ptr<Worker>(new Worker(_dispatcher, _proxy, _connectionPool, _timer, _http2Pool.get())));
     }
     _dispatcher.waitForThreads(numWorkers, 256);
 }
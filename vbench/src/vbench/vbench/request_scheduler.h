@@ -15,6 +15,16 @@ namespace vbench {
  * Component responsible for dispatching requests to workers at the
  * appropriate time based on what start time the requests are tagged
  * with.
+ *
+ * By default, requests are dropped if no worker is available when
+ * they are due. In open loop mode, requests wait for the next
+ * available worker instead, so that latency measured from the
+ * scheduled time includes the time spent waiting for the server to
+ * catch up (avoiding coordinated omission).
+ *
+ * If a number of HTTP/2 connections per server is given, requests
+ * are multiplexed over that many shared HTTP/2 connections instead
+ * of using one HTTP/1.1 connection per worker.
  **/
 class RequestScheduler : public Handler<Request>,
                          public vespalib::Runnable,
@@ -28,13 +38,15 @@ private:
     Dispatcher<Request>     _dispatcher;
     vespalib::Thread        _thread;
     HttpConnectionPool      _connectionPool;
+    std::unique_ptr<Http2ConnectionPool> _http2Pool;
     std::vector<Worker::UP> _workers;
 
     void run() override;
 public:
     typedef std::unique_ptr<RequestScheduler> UP;
     using CryptoEngine = vespalib::CryptoEngine;
-    RequestScheduler(CryptoEngine::SP crypto, Handler<Request> &next, size_t numWorkers);
+    RequestScheduler(CryptoEngine::SP crypto, Handler<Request> &next, size_t numWorkers,
+                     bool openLoop = false, size_t http2Connections = 0);
     void abort();
     void handle(Request::UP request) override;
     void start() override;
@@ -25,7 +25,7 @@ string maybe_load(const vespalib::slime::Inspector &file_ref) {
     return "";
 }
 
-CryptoEngine::SP setup_crypto(const vespalib::slime::Inspector &tls) {
+CryptoEngine::SP setup_crypto(const vespalib::slime::Inspector &tls, bool http2) {
     if (!tls.valid()) {
         return std::make_shared<vespalib::NullCryptoEngine>();
     }
@@ -35,6 +35,9 @@ CryptoEngine::SP setup_crypto(const vespalib::slime::Inspector &tls) {
             private_key_pem(maybe_load(tls["private-key"])).
             authorized_peers(vespalib::net::tls::AuthorizedPeers::allow_all_authenticated()).
             disable_hostname_validation(true); // TODO configurable or default false!
+    if (http2) {
+        ts_builder.alpn_protocols({"h2"});
+    }
     return std::make_shared<vespalib::TlsCryptoEngine>(vespalib::net::tls::TransportSecurityOptions(std::move(ts_builder)));
 }
 
@@ -47,7 +50,8 @@ VBench::VBench(const vespalib::Slime &cfg)
       _inputs(),
       _taint()
 {
-    CryptoEngine::SP crypto = setup_crypto(cfg.get()["tls"]);
+    size_t http2Connections = cfg.get()["http2_connections"].asLong();
+    CryptoEngine::SP crypto = setup_crypto(cfg.get()["tls"], (http2Connections > 0));
     _analyzers.push_back(Analyzer::UP(new RequestSink()));
     vespalib::slime::Inspector &analyzers = cfg.get()["analyze"];
     for (size_t i = analyzers.children(); i-- > 0; ) {
@@ -58,7 +62,9 @@ VBench::VBench(const vespalib::Slime &cfg)
     }
     _scheduler.reset(new RequestScheduler(crypto,
                                           *_analyzers.back(),
-                                          cfg.get()["http_threads"].asLong()));
+                                          cfg.get()["http_threads"].asLong(),
+                                          cfg.get()["open_loop"].asBool(),
+                                          http2Connections));
     vespalib::slime::Inspector &inputs = cfg.get()["inputs"];
     for (size_t i = inputs.children(); i-- > 0; ) {
         vespalib::slime::Inspector &input = inputs[i];
@@ -4,6 +4,7 @@
 
 #include "analyzer.h"
 #include "generator.h"
+#include "hdr_latency_analyzer.h"
 #include "latency_analyzer.h"
 #include "native_factory.h"
 #include "qps_analyzer.h"
@@ -14,18 +14,24 @@ Worker::run()
             break;
         }
         request->startTime(_timer.sample());
-        HttpClient::fetch(_pool, request->server(), request->url(), *request);
+        if (_http2Pool != nullptr) {
+            _http2Pool->fetch(request->server(), request->url(), *request);
+        } else {
+            HttpClient::fetch(_pool, request->server(), request->url(), *request);
+        }
         request->endTime(_timer.sample());
         _next.handle(std::move(request));
     }
 }
 
 Worker::Worker(Provider<Request> &provider, Handler<Request> &next,
-               HttpConnectionPool &pool, Timer &timer)
+               HttpConnectionPool &pool, Timer &timer,
+               Http2ConnectionPool *http2Pool)
     : _thread(*this),
       _provider(provider),
       _next(next),
       _pool(pool),
+      _http2Pool(http2Pool),
       _timer(timer)
 {
     _thread.start();
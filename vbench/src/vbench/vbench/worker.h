@@ -6,6 +6,7 @@
 #include <vbench/core/provider.h>
 #include <vbench/core/handler.h>
 #include <vbench/http/http_connection_pool.h>
+#include <vbench/http/http2_connection_pool.h>
 #include <vespa/vespalib/util/runnable.h>
 #include <vespa/vespalib/util/thread.h>
 #include <vespa/vespalib/util/joinable.h>
@@ -16,7 +17,8 @@ namespace vbench {
  * Obtains requests from a request provider, performs the requests and
  * passes the requests along to a request handler. Runs its own
  * internal thread that will stop when the request provider starts
- * handing out empty requests.
+ * handing out empty requests. Requests are sent over HTTP/2 if a
+ * HTTP/2 connection pool is given.
  **/
 class Worker : public vespalib::Runnable,
                public vespalib::Joinable
@@ -26,13 +28,15 @@ private:
     Provider<Request>  &_provider;
     Handler<Request>   &_next;
     HttpConnectionPool &_pool;
+    Http2ConnectionPool *_http2Pool;
     Timer              &_timer;
 
     void run() override;
 public:
     typedef std::unique_ptr<Worker> UP;
     Worker(Provider<Request> &provider, Handler<Request> &next,
-           HttpConnectionPool &pool, Timer &timer);
+           HttpConnectionPool &pool, Timer &timer,
+           Http2ConnectionPool *http2Pool = nullptr);
     void join() override { _thread.join(); }
 };
 
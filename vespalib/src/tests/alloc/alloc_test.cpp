@@ -56,6 +56,10 @@ TEST("test basics") {
         EXPECT_EQUAL(100u, h.size());
         EXPECT_TRUE(h.get() != nullptr);
     }
+    for (size_t alignment : {512ul, 1024ul, 4096ul}) {
+        Alloc h = Alloc::allocAlignedHeap(100, alignment);
+        EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(h.get()) % alignment);
+    }
     {
         Alloc h = Alloc::allocMMap(100);
         EXPECT_EQUAL(4096u, h.size());
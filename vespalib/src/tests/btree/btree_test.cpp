@@ -2,6 +2,7 @@
 #include <vespa/log/log.h>
 LOG_SETUP("btree_test");
 #include <vespa/vespalib/testkit/testapp.h>
+#include <map>
 #include <string>
 #include <vespa/vespalib/btree/btreeroot.h>
 #include <vespa/vespalib/btree/btreebuilder.h>
@@ -232,6 +233,7 @@ private:
     void requireThatTreeRemoveStealWorks();
     void requireThatNodeRemoveWorks();
     void requireThatNodeLowerBoundWorks();
+    void requireThatNodeLinearSearchMatchesBinarySearch();
     void requireThatWeCanInsertAndRemoveFromTree();
     void requireThatSortedTreeInsertWorks();
     void requireThatCornerCaseTreeFindWorks();
@@ -253,6 +255,9 @@ private:
     void
     requireThatApplyWorks();
 
+    void
+    requireThatApplyMergesLargeBatchIntoTree();
+
     void
     requireThatIteratorDistanceWorks(int numEntries);
 
@@ -718,6 +723,43 @@ Test::requireThatNodeLowerBoundWorks()
     cleanup(g, m, nPair.ref, n);
 }
 
+namespace {
+
+// Same order as std::less<int>, but uses binary search in nodes.
+struct BinarySearchLess {
+    bool operator()(int lhs, int rhs) const { return lhs < rhs; }
+};
+
+}
+
+void
+Test::requireThatNodeLinearSearchMatchesBinarySearch()
+{
+    using NodeAllocator = SetTreeL::NodeAllocatorType;
+    using LeafNode = SetTreeL::LeafNodeType;
+    GenerationHandler g;
+    NodeAllocator m;
+    LeafNode::RefPair nPair = m.allocLeafNode();
+    LeafNode *n = nPair.data;
+    for (uint32_t i = 0; i < 11; ++i) {
+        n->insert(i, 3 * i + 1, BTreeNoLeafData());
+    }
+    for (uint32_t sidx = 0; sidx <= n->validSlots(); ++sidx) {
+        for (int key = 0; key < 36; ++key) {
+            EXPECT_EQUAL(n->lower_bound(sidx, key, BinarySearchLess()),
+                         n->lower_bound(sidx, key, std::less<int>()));
+            EXPECT_EQUAL(n->upper_bound(sidx, key, BinarySearchLess()),
+                         n->upper_bound(sidx, key, std::less<int>()));
+        }
+    }
+    EXPECT_EQUAL(0u, n->lower_bound(1, std::less<int>()));
+    EXPECT_EQUAL(1u, n->upper_bound(0, 1, std::less<int>()));
+    EXPECT_EQUAL(4u, n->lower_bound(11, std::less<int>()));
+    EXPECT_EQUAL(10u, n->lower_bound(31, std::less<int>()));
+    EXPECT_EQUAL(11u, n->lower_bound(32, std::less<int>()));
+    cleanup(g, m, nPair.ref, n);
+}
+
 void
 generateData(std::vector<LeafPair> & data, size_t numEntries)
 {
@@ -1440,6 +1482,58 @@ Test::requireThatApplyWorks()
     s.trimHoldLists(g.getFirstUsedGeneration());
 }
 
+void
+Test::requireThatApplyMergesLargeBatchIntoTree()
+{
+    using TreeStore = BTreeStore<uint32_t, uint32_t, btree::NoAggregated, std::less<uint32_t>,
+                                 BTreeDefaultTraits>;
+    using KeyDataType = TreeStore::KeyDataType;
+    GenerationHandler g;
+    TreeStore s;
+    std::vector<KeyDataType> additions;
+    std::vector<uint32_t> removals;
+    std::map<uint32_t, uint32_t> exp;
+
+    EntryRef root;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        additions.push_back(KeyDataType(2 * i, i));
+        exp[2 * i] = i;
+    }
+    s.apply(root, &additions[0], &additions[0] + additions.size(), nullptr, nullptr);
+    s.freeze();
+    // Dense batch of additions, updates and removals, merged by building a new tree
+    additions.clear();
+    for (uint32_t i = 100; i < 1500; i += 3) {
+        if (i % 2 == 0 && i % 4 != 0) {
+            removals.push_back(i);
+            exp.erase(i);
+        } else {
+            additions.push_back(KeyDataType(i, i + 7));
+            exp[i] = i + 7;
+        }
+    }
+    additions.push_back(KeyDataType(5000, 42));
+    exp[5000] = 42;
+    s.apply(root, &additions[0], &additions[0] + additions.size(),
+                  &removals[0], &removals[0] + removals.size());
+    EXPECT_EQUAL(exp.size(), s.size(root));
+    auto itr = s.begin(root);
+    for (const auto &entry : exp) {
+        if (!EXPECT_TRUE(itr.valid())) break;
+        EXPECT_EQUAL(entry.first, itr.getKey());
+        EXPECT_EQUAL(entry.second, itr.getData());
+        ++itr;
+    }
+    EXPECT_FALSE(itr.valid());
+
+    s.clear(root);
+    s.clearBuilder();
+    s.freeze();
+    s.transferHoldLists(g.getCurrentGeneration());
+    g.incGeneration();
+    s.trimHoldLists(g.getFirstUsedGeneration());
+}
+
 class MyTreeTestIterator : public MyTree::Iterator
 {
 public:
@@ -1578,6 +1672,7 @@ Test::Main()
     requireThatTreeRemoveStealWorks();
     requireThatNodeRemoveWorks();
     requireThatNodeLowerBoundWorks();
+    requireThatNodeLinearSearchMatchesBinarySearch();
     requireThatWeCanInsertAndRemoveFromTree();
     requireThatSortedTreeInsertWorks();
     requireThatCornerCaseTreeFindWorks();
@@ -1590,6 +1685,7 @@ Test::Main()
     requireThatUpdateOfKeyWorks();
     requireThatSmallNodesWorks();
     requireThatApplyWorks();
+    requireThatApplyMergesLargeBatchIntoTree();
     requireThatIteratorDistanceWorks();
     requireThatForeachKeyWorks();
 
@@ -0,0 +1,176 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/btree/btreeroot.h>
+#include <vespa/vespalib/btree/btreebuilder.h>
+#include <vespa/vespalib/btree/btreenodeallocator.h>
+#include <vespa/vespalib/btree/btree.h>
+#include <vespa/vespalib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/btree/btreeiterator.hpp>
+#include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/btree/btreebuilder.hpp>
+#include <vespa/vespalib/btree/btree.hpp>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/time.h>
+
+#include <vespa/fastos/app.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("seekspeed");
+
+namespace vespalib::btree {
+
+enum class SeekMethod
+{
+    LINEAR,
+    BINARY
+};
+
+/*
+ * Orders like std::less<int>, but being a different type it makes the
+ * nodes use binary search.
+ */
+struct BinarySearchLess {
+    bool operator()(int lhs, int rhs) const { return lhs < rhs; }
+};
+
+class SeekSpeed : public FastOS_Application
+{
+    template <typename Traits, SeekMethod seekMethod>
+    void
+    workLoop(int loops, bool enableLinear, bool enableBinary, int leafSlots);
+    void usage();
+    int Main() override;
+};
+
+
+namespace {
+
+const char *seekMethodName(SeekMethod seekMethod)
+{
+    switch (seekMethod) {
+    case SeekMethod::LINEAR:
+        return "linear";
+    default:
+        return "binary";
+    }
+}
+
+}
+
+template <typename Traits, SeekMethod seekMethod>
+void
+SeekSpeed::workLoop(int loops, bool enableLinear, bool enableBinary, int leafSlots)
+{
+    if ((seekMethod == SeekMethod::LINEAR && !enableLinear) ||
+        (seekMethod == SeekMethod::BINARY && !enableBinary) ||
+        (leafSlots != 0 &&
+         leafSlots != static_cast<int>(Traits::LEAF_SLOTS)))
+        return;
+    using CompareT = std::conditional_t<seekMethod == SeekMethod::LINEAR, std::less<int>, BinarySearchLess>;
+    using Tree = BTree<int, int, btree::NoAggregated, CompareT, Traits>;
+    using Builder = typename Tree::Builder;
+    Tree tree;
+    Builder builder(tree.getAllocator());
+    size_t numEntries = 1000000;
+    size_t numSeeks = 10000000;
+    for (size_t i = 0; i < numEntries; ++i) {
+        builder.insert(2 * i, 0);
+    }
+    tree.assign(builder);
+    assert(numEntries == tree.size());
+    assert(tree.isValid());
+    vespalib::Rand48 rnd;
+    rnd.srand48(32);
+    std::vector<int> keys;
+    keys.reserve(numSeeks);
+    for (size_t i = 0; i < numSeeks; ++i) {
+        keys.push_back(rnd.lrand48() % (2 * numEntries));
+    }
+    for (int l = 0; l < loops; ++l) {
+        vespalib::Timer timer;
+        uint64_t sum = 0;
+        for (int key : keys) {
+            auto itr = tree.lowerBound(key);
+            if (itr.valid()) {
+                sum += itr.getKey();
+            }
+        }
+        double used = vespalib::to_s(timer.elapsed());
+        printf("Elapsed time for %ld lower bound seeks is %8.5f, "
+               "search=%s, fanout=%u,%u, sum=%" PRIu64 "\n",
+               numSeeks,
+               used,
+               seekMethodName(seekMethod),
+               static_cast<int>(Traits::LEAF_SLOTS),
+               static_cast<int>(Traits::INTERNAL_SLOTS),
+               sum);
+        fflush(stdout);
+    }
+}
+
+
+void
+SeekSpeed::usage()
+{
+    printf("seekspeed "
+           "[-F <leafSlots>] "
+           "[-b] "
+           "[-c <numLoops>] "
+           "[-l]\n");
+}
+
+int
+SeekSpeed::Main()
+{
+    int argi;
+    char c;
+    const char *optArg;
+    argi = 1;
+    int loops = 1;
+    bool binary = false;
+    bool linear = false;
+    int leafSlots = 0;
+    while ((c = GetOpt("F:bc:l", optArg, argi)) != -1) {
+        switch (c) {
+        case 'F':
+            leafSlots = atoi(optArg);
+            break;
+        case 'b':
+            binary = true;
+            break;
+        case 'c':
+            loops = atoi(optArg);
+            break;
+        case 'l':
+            linear = true;
+            break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    if (!binary && !linear) {
+        binary = true;
+        linear = true;
+    }
+
+    using SmallTraits = BTreeTraits<4, 4, 31, false>;
+    using DefTraits = BTreeDefaultTraits;
+    using LargeTraits = BTreeTraits<32, 16, 10, true>;
+    using HugeTraits = BTreeTraits<64, 16, 10, true>;
+    workLoop<SmallTraits, SeekMethod::LINEAR>(loops, linear, binary, leafSlots);
+    workLoop<DefTraits, SeekMethod::LINEAR>(loops, linear, binary, leafSlots);
+    workLoop<LargeTraits, SeekMethod::LINEAR>(loops, linear, binary, leafSlots);
+    workLoop<HugeTraits, SeekMethod::LINEAR>(loops, linear, binary, leafSlots);
+    workLoop<SmallTraits, SeekMethod::BINARY>(loops, linear, binary, leafSlots);
+    workLoop<DefTraits, SeekMethod::BINARY>(loops, linear, binary, leafSlots);
+    workLoop<LargeTraits, SeekMethod::BINARY>(loops, linear, binary, leafSlots);
+    workLoop<HugeTraits, SeekMethod::BINARY>(loops, linear, binary, leafSlots);
+    return 0;
+}
+
+}
+
+FASTOS_MAIN(vespalib::btree::SeekSpeed);
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -67,6 +69,73 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+namespace {
+
+vespalib::string
+make_doc(uint32_t id)
+{
+    return make_string("{\"title\":\"Title of document number %u\",\"body\":\"This is the body text of document %u, "
+                       "which is mostly the same for all documents\",\"popularity\":%u}", id, id, id * 7);
+}
+
+ZStdDictionary::SP
+train_dictionary(uint32_t num_docs)
+{
+    DataBuffer samples;
+    std::vector<size_t> sizes;
+    for (uint32_t i = 0; i < num_docs; ++i) {
+        vespalib::string doc = make_doc(i);
+        samples.writeBytes(doc.data(), doc.size());
+        sizes.push_back(doc.size());
+    }
+    return ZStdDictionary::train(ConstBufferRef(samples.getData(), samples.getDataLen()), sizes, 4096, 3);
+}
+
+size_t
+zstd_compressed_size(const vespalib::string & doc, const ZStdDictionary * dictionary)
+{
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 3, 100);
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, ConstBufferRef(doc.data(), doc.size()), compressed, false, dictionary));
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, doc.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()),
+               decompressed, false, dictionary);
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+    return compressed.getDataLen();
+}
+
+}
+
+TEST("require that zstd dictionary can be trained and used for compression") {
+    auto dictionary = train_dictionary(1000);
+    ASSERT_TRUE(dictionary);
+    EXPECT_LESS_EQUAL(dictionary->getRaw().size(), 4096u);
+    EXPECT_NOT_EQUAL(0u, dictionary->getId());
+    vespalib::string doc = make_doc(12345);
+    size_t plain = zstd_compressed_size(doc, nullptr);
+    size_t with_dictionary = zstd_compressed_size(doc, dictionary.get());
+    EXPECT_LESS(with_dictionary * 2, plain);
+}
+
+TEST("require that zstd dictionary can be recreated from its raw form") {
+    auto trained = train_dictionary(1000);
+    ASSERT_TRUE(trained);
+    ZStdDictionary copy(trained->getRaw(), 3);
+    EXPECT_EQUAL(trained->getId(), copy.getId());
+    vespalib::string doc = make_doc(777);
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 3, 100);
+    DataBuffer compressed;
+    compress(cfg, ConstBufferRef(doc.data(), doc.size()), compressed, false, trained.get());
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, doc.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()),
+               decompressed, false, &copy);
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
+TEST("require that zstd dictionary training fails without enough samples") {
+    EXPECT_FALSE(train_dictionary(2));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
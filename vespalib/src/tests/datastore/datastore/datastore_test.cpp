@@ -553,6 +553,51 @@ TEST(DataStoreTest, require_that_buffer_growth_works)
                     4, 0, HUGE_PAGE_ARRAY_SIZE / 2, HUGE_PAGE_ARRAY_SIZE * 5);
 }
 
+namespace {
+
+class MyMemoryAllocator : public MemoryAllocator {
+    const MemoryAllocator &_allocator;
+public:
+    mutable uint32_t allocs;
+    mutable uint32_t frees;
+    MyMemoryAllocator()
+        : _allocator(*MemoryAllocator::select_allocator()),
+          allocs(0),
+          frees(0)
+    {
+    }
+    PtrAndSize alloc(size_t sz) const override {
+        ++allocs;
+        return _allocator.alloc(sz);
+    }
+    void free(PtrAndSize alloc) const override {
+        ++frees;
+        _allocator.free(alloc);
+    }
+    size_t resize_inplace(PtrAndSize, size_t) const override { return 0; }
+};
+
+}
+
+TEST(DataStoreTest, require_that_memory_allocator_for_buffer_type_is_used)
+{
+    MyMemoryAllocator allocator;
+    {
+        using RefType = EntryRefT<22>;
+        DataStoreT<RefType> store;
+        BufferType<int> type(1, 1, RefType::offsetSize());
+        type.set_memory_allocator(&allocator);
+        EXPECT_EQ(&allocator, type.get_memory_allocator());
+        uint32_t typeId = store.addType(&type);
+        store.initActiveBuffers();
+        RefType ref = store.allocator<int>(typeId).alloc(42).ref;
+        EXPECT_EQ(42, *store.getEntry<int>(ref));
+        EXPECT_LT(0u, allocator.allocs);
+        store.dropBuffers();
+    }
+    EXPECT_EQ(allocator.allocs, allocator.frees);
+}
+
 using RefType15 = EntryRefT<15>; // offsetSize=32768
 
 namespace {
@@ -101,7 +101,9 @@ struct TestBase : public ::testing::Test {
         store.trimHoldLists(generation);
     }
     void compactWorst() {
-        auto remapper = store.compact_worst(true, true);
+        remap(store.compact_worst(true, true));
+    }
+    void remap(std::unique_ptr<typename UniqueStoreT::Remapper> remapper) {
         std::vector<EntryRef> refs;
         for (const auto &elem : refStore) {
             refs.push_back(elem.first);
@@ -257,6 +259,46 @@ TYPED_TEST(TestBase, store_can_be_compacted)
     this->assertStoreContent();
 }
 
+TYPED_TEST(TestBase, store_can_be_compacted_incrementally)
+{
+    EntryRef val0Ref = this->add(this->values[0]);
+    EntryRef val1Ref = this->add(this->values[1]);
+    this->remove(this->add(this->values[2]));
+    this->trimHoldLists();
+    uint32_t val1BufferId = this->getBufferId(val1Ref);
+
+    EXPECT_FALSE(this->store.compact_worst_step(true, true, 1));
+    EXPECT_TRUE(this->store.is_compacting());
+    // The old values are used until all values have been moved.
+    EXPECT_EQ(val0Ref, this->add(this->values[0]));
+    this->remove(val0Ref);
+    this->remove(val0Ref);
+    EntryRef val2Ref = this->add(this->values[2]);
+    EXPECT_NE(val1BufferId, this->getBufferId(val2Ref));
+    std::unique_ptr<typename TypeParam::Remapper> remapper;
+    for (uint32_t steps = 0; !remapper; ++steps) {
+        ASSERT_LT(steps, 3u);
+        remapper = this->store.compact_worst_step(false, false, 1);
+    }
+    EXPECT_FALSE(this->store.is_compacting());
+    this->remap(std::move(remapper));
+    EXPECT_EQ(2u, this->refStore.size());
+    EXPECT_EQ(2u, this->store.getNumUniques());
+    this->assertStoreContent();
+    EntryRef newVal1Ref = this->getEntryRef(this->values[1]);
+    EXPECT_NE(val1BufferId, this->getBufferId(newVal1Ref));
+    this->assertGet(val1Ref, this->values[1]);
+    // Reference count was kept when moving the value.
+    EXPECT_EQ(newVal1Ref, this->add(this->values[1]));
+    this->remove(newVal1Ref);
+    this->remove(newVal1Ref);
+    EXPECT_EQ(1u, this->store.getNumUniques());
+    EXPECT_TRUE(this->store.bufferState(val1Ref).isOnHold());
+    this->trimHoldLists();
+    EXPECT_TRUE(this->store.bufferState(val1Ref).isFree());
+    this->assertStoreContent();
+}
+
 TYPED_TEST(TestBase, store_can_be_instantiated_with_builder)
 {
     auto builder = this->getBuilder(2);
@@ -0,0 +1,107 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
+#include <vespa/vespalib/fuzzy/levenshtein_distance.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+
+using namespace vespalib;
+
+namespace {
+
+std::optional<uint32_t> distance(const vespalib::string &left, const vespalib::string &right, uint32_t threshold) {
+    return LevenshteinDistance::calculate(FuzzyMatcher::fold(left, true), FuzzyMatcher::fold(right, true), threshold);
+}
+
+uint32_t full_distance(const std::vector<uint32_t> &left, const std::vector<uint32_t> &right) {
+    std::vector<uint32_t> prev(left.size() + 1);
+    std::vector<uint32_t> curr(left.size() + 1);
+    for (size_t i = 0; i <= left.size(); ++i) {
+        prev[i] = i;
+    }
+    for (size_t j = 1; j <= right.size(); ++j) {
+        curr[0] = j;
+        for (size_t i = 1; i <= left.size(); ++i) {
+            uint32_t cost = (left[i - 1] == right[j - 1]) ? 0 : 1;
+            curr[i] = std::min({prev[i - 1] + cost, prev[i] + 1, curr[i - 1] + 1});
+        }
+        std::swap(prev, curr);
+    }
+    return prev[left.size()];
+}
+
+}
+
+TEST(LevenshteinDistanceTest, distance_is_calculated_within_threshold) {
+    EXPECT_EQ(0u, distance("abc", "abc", 2).value());
+    EXPECT_EQ(1u, distance("abc", "abd", 2).value());
+    EXPECT_EQ(1u, distance("abc", "ab", 2).value());
+    EXPECT_EQ(1u, distance("ab", "abc", 2).value());
+    EXPECT_EQ(2u, distance("abc", "bca", 2).value());
+    EXPECT_EQ(3u, distance("", "abc", 3).value());
+    EXPECT_EQ(3u, distance("kitten", "sitting", 3).value());
+}
+
+TEST(LevenshteinDistanceTest, distance_above_threshold_gives_no_result) {
+    EXPECT_FALSE(distance("abc", "xyz", 2).has_value());
+    EXPECT_FALSE(distance("", "abc", 2).has_value());
+    EXPECT_FALSE(distance("kitten", "sitting", 2).has_value());
+    EXPECT_FALSE(distance("abcdef", "ab", 3).has_value());
+}
+
+TEST(LevenshteinDistanceTest, banded_distance_matches_full_distance) {
+    std::vector<uint32_t> left;
+    std::vector<uint32_t> right;
+    uint32_t seed = 42;
+    auto next = [&seed]() { seed = seed * 1103515245 + 12345; return (seed >> 16) & 0x7fff; };
+    for (size_t iter = 0; iter < 2000; ++iter) {
+        left.resize(next() % 10);
+        right.resize(next() % 10);
+        std::generate(left.begin(), left.end(), [&next]() { return 'a' + next() % 3; });
+        std::generate(right.begin(), right.end(), [&next]() { return 'a' + next() % 3; });
+        uint32_t expect = full_distance(left, right);
+        for (uint32_t threshold = 0; threshold < 5; ++threshold) {
+            auto actual = LevenshteinDistance::calculate(left, right, threshold);
+            if (expect <= threshold) {
+                ASSERT_TRUE(actual.has_value());
+                EXPECT_EQ(expect, actual.value());
+            } else {
+                EXPECT_FALSE(actual.has_value());
+            }
+        }
+    }
+}
+
+TEST(FuzzyMatcherTest, uncased_matching_folds_case) {
+    FuzzyMatcher matcher("Vespa", 1, 0, false);
+    EXPECT_TRUE(matcher.isMatch("vespa"));
+    EXPECT_TRUE(matcher.isMatch("VESPA"));
+    EXPECT_TRUE(matcher.isMatch("vesta"));
+    EXPECT_TRUE(matcher.isMatch("espa"));
+    EXPECT_FALSE(matcher.isMatch("vest"));
+    EXPECT_EQ("", matcher.getPrefix());
+}
+
+TEST(FuzzyMatcherTest, cased_matching_counts_case_differences_as_edits) {
+    FuzzyMatcher matcher("Vespa", 1, 0, true);
+    EXPECT_TRUE(matcher.isMatch("vespa"));
+    EXPECT_FALSE(matcher.isMatch("VESPA"));
+}
+
+TEST(FuzzyMatcherTest, locked_prefix_must_match_exactly) {
+    FuzzyMatcher matcher("Search", 2, 2, false);
+    EXPECT_EQ("se", matcher.getPrefix());
+    EXPECT_TRUE(matcher.isMatch("searhc"));
+    EXPECT_TRUE(matcher.isMatch("SEARCHED"));
+    EXPECT_FALSE(matcher.isMatch("sxarch"));
+    EXPECT_FALSE(matcher.isMatch("s"));
+}
+
+TEST(FuzzyMatcherTest, non_ascii_code_points_count_as_single_edits) {
+    FuzzyMatcher matcher("blåbær", 1, 0, false);
+    EXPECT_TRUE(matcher.isMatch("blabær"));
+    EXPECT_TRUE(matcher.isMatch("BLÅBÆR"));
+    EXPECT_FALSE(matcher.isMatch("blabar"));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,76 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/mpsc_queue.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace vespalib;
+
+TEST("require that values are popped in push order") {
+    MpscQueue<int> queue;
+    std::vector<int> out;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQUAL(0u, queue.pop_all(out));
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(!queue.push(2));
+    EXPECT_TRUE(!queue.push(3));
+    EXPECT_TRUE(!queue.empty());
+    EXPECT_EQUAL(3u, queue.pop_all(out));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.push(4));
+    EXPECT_EQUAL(1u, queue.pop_all(out));
+    ASSERT_EQUAL(4u, out.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQUAL(int(i + 1), out[i]);
+    }
+}
+
+TEST("require that move-only values are supported") {
+    MpscQueue<std::unique_ptr<int>> queue;
+    queue.push(std::make_unique<int>(5));
+    std::vector<std::unique_ptr<int>> out;
+    EXPECT_EQUAL(1u, queue.pop_all(out));
+    EXPECT_EQUAL(5, *out[0]);
+}
+
+TEST("require that values left in the queue are destroyed with it") {
+    auto value = std::make_shared<int>(7);
+    {
+        MpscQueue<std::shared_ptr<int>> queue;
+        queue.push(value);
+        queue.push(value);
+        EXPECT_EQUAL(3, value.use_count());
+    }
+    EXPECT_EQUAL(1, value.use_count());
+}
+
+struct Pair {
+    size_t producer;
+    size_t seq;
+};
+
+TEST_MT_F("require that each producer's values are popped in order", 4, MpscQueue<Pair>()) {
+    constexpr size_t num_values = 50000;
+    if (thread_id == 0) {
+        std::vector<size_t> next(num_threads, 0);
+        std::vector<Pair> out;
+        size_t received = 0;
+        while (received < (num_values * (num_threads - 1))) {
+            out.clear();
+            received += f1.pop_all(out);
+            for (const Pair &p: out) {
+                EXPECT_EQUAL(next[p.producer], p.seq);
+                next[p.producer] = p.seq + 1;
+            }
+        }
+        EXPECT_TRUE(f1.empty());
+    } else {
+        for (size_t i = 0; i < num_values; ++i) {
+            f1.push(Pair{thread_id, i});
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
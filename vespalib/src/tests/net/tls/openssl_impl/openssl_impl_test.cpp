@@ -769,6 +769,24 @@ TEST_F("Success statistics are incremented on OK authorization", CertFixture) {
     EXPECT_EQUAL(1u, client_stats.tls_connections);
 }
 
+TEST_F("Record and byte statistics are incremented on encode and decode", Fixture) {
+    ASSERT_TRUE(f.handshake());
+    auto server_before = ConnectionStatistics::get(true).snapshot();
+    auto client_before = ConnectionStatistics::get(false).snapshot();
+
+    vespalib::string client_plaintext = "Hellooo world! :D";
+    ASSERT_FALSE(f.client_encode(client_plaintext).failed);
+    vespalib::string server_plaintext_out;
+    ASSERT_TRUE(f.server_decode(server_plaintext_out, 256).frame_decoded_ok());
+
+    auto server_stats = ConnectionStatistics::get(true).snapshot().subtract(server_before);
+    auto client_stats = ConnectionStatistics::get(false).snapshot().subtract(client_before);
+    EXPECT_EQUAL(1u, client_stats.encoded_tls_records);
+    EXPECT_EQUAL(client_plaintext.size(), client_stats.encoded_tls_bytes);
+    EXPECT_EQUAL(0u, server_stats.encoded_tls_records);
+    EXPECT_EQUAL(client_plaintext.size(), server_stats.decoded_tls_bytes);
+}
+
 // TODO we can't test embedded nulls since the OpenSSL v3 extension APIs
 // take in null terminated strings as arguments... :I
 
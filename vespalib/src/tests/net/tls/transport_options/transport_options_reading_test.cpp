@@ -172,6 +172,16 @@ TEST("TransportSecurityOptions builder does not disable hostname validation by d
     EXPECT_FALSE(ts_opts.disable_hostname_validation());
 }
 
+TEST("TransportSecurityOptions builder can set ALPN protocols, which are kept when copying") {
+    auto ts_builder = vespalib::net::tls::TransportSecurityOptions::Params().
+            ca_certs_pem("foo").
+            alpn_protocols({"h2", "http/1.1"});
+    TransportSecurityOptions ts_opts(std::move(ts_builder));
+    std::vector<vespalib::string> expected({"h2", "http/1.1"});
+    EXPECT_TRUE(expected == ts_opts.alpn_protocols());
+    EXPECT_TRUE(expected == ts_opts.copy_without_private_key().alpn_protocols());
+}
+
 TEST("hostname validation can be explicitly disabled") {
     const char* json = R"({"files":{"private-key":"dummy_privkey.txt",
                                     "certificates":"dummy_certs.txt",
@@ -32,6 +32,27 @@ TEST("require that prefix detection sometimes underestimates the prefix size") {
     EXPECT_EQUAL("", RegexpUtil::get_prefix("^foo|^foobar"));
 }
 
+TEST("require that required literal detection works") {
+    EXPECT_EQUAL("", RegexpUtil::get_required_literal(""));
+    EXPECT_EQUAL("foo", RegexpUtil::get_required_literal("foo"));
+    EXPECT_EQUAL("foo", RegexpUtil::get_required_literal("^foo$"));
+    EXPECT_EQUAL("barbaz", RegexpUtil::get_required_literal("foo.*barbaz"));
+    EXPECT_EQUAL("foo", RegexpUtil::get_required_literal("foo[a-z]+ba"));
+    EXPECT_EQUAL("fo", RegexpUtil::get_required_literal("foo?"));
+    EXPECT_EQUAL("fo", RegexpUtil::get_required_literal("foo*"));
+    EXPECT_EQUAL("fo", RegexpUtil::get_required_literal("foo{0,2}"));
+    EXPECT_EQUAL("foo", RegexpUtil::get_required_literal("foo+"));
+    EXPECT_EQUAL("a.b", RegexpUtil::get_required_literal("x\\da\\.b"));
+    EXPECT_EQUAL("bar", RegexpUtil::get_required_literal("[]fo]bar"));
+    EXPECT_EQUAL("", RegexpUtil::get_required_literal("foo|bar"));
+    EXPECT_EQUAL("", RegexpUtil::get_required_literal("(foo)?bar"));
+}
+
+TEST("require that required literal is found in strings made from substring and suffix") {
+    EXPECT_EQUAL("a.b*c", RegexpUtil::get_required_literal(RegexpUtil::make_from_substring("a.b*c")));
+    EXPECT_EQUAL("a.b*c", RegexpUtil::get_required_literal(RegexpUtil::make_from_suffix("a.b*c")));
+}
+
 const std::string special("^|()[]{}.*?+\\$");
 
 struct ExprFixture {
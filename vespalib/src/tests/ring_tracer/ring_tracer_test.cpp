@@ -0,0 +1,106 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/ring_tracer.h>
+#include <thread>
+
+using namespace vespalib;
+
+RT_Tag tag0("tag0");
+RT_Tag tag1("tag1");
+RT_Tag wrap_tag("wrap tag");
+RT_Tag mt_tag("mt tag");
+
+std::vector<RingTracer::Record> extract_tag(const RT_Tag &tag, steady_time a, steady_time b) {
+    std::vector<RingTracer::Record> result;
+    for (const auto &record: RingTracer::extract(a, b)) {
+        if (record.tag_id == tag.id()) {
+            result.push_back(record);
+        }
+    }
+    return result;
+}
+
+std::vector<RingTracer::Record> extract_tag(const RT_Tag &tag) {
+    return extract_tag(tag, steady_time(), steady_clock::now() + 1h);
+}
+
+TEST("require that tag ids are equal if and only if tag names are equal") {
+    RT_Tag tag1_too("tag1");
+    EXPECT_NOT_EQUAL(tag0.id(), tag1.id());
+    EXPECT_EQUAL(tag1_too.id(), tag1.id());
+}
+
+TEST("require that samples are extracted ordered by start time") {
+    {
+        RT_Sample outer(tag0);
+        { RT_Sample inner(tag1); }
+    }
+    auto list = RingTracer::extract(steady_time(), steady_clock::now() + 1h);
+    ASSERT_EQUAL(list.size(), 2u);
+    EXPECT_EQUAL(list[0].tag_id, tag0.id());
+    EXPECT_EQUAL(list[0].tag_name(), "tag0");
+    EXPECT_EQUAL(list[1].tag_id, tag1.id());
+    EXPECT_EQUAL(list[1].tag_name(), "tag1");
+    EXPECT_EQUAL(list[0].thread_id, list[1].thread_id);
+    EXPECT_TRUE(list[0].start <= list[1].start);
+    EXPECT_TRUE(list[0].stop >= list[1].stop);
+    EXPECT_TRUE(list[0].elapsed() >= list[1].elapsed());
+}
+
+TEST("require that only samples overlapping with the time window are extracted") {
+    { RT_Sample sample(tag0); }
+    std::this_thread::sleep_for(2ms);
+    auto t1 = steady_clock::now();
+    std::this_thread::sleep_for(2ms);
+    { RT_Sample sample(tag0); }
+    auto t2 = steady_clock::now();
+    std::this_thread::sleep_for(2ms);
+    { RT_Sample sample(tag0); }
+    auto list = extract_tag(tag0, t1, t2);
+    ASSERT_EQUAL(list.size(), 1u);
+    EXPECT_TRUE(list[0].start > t1);
+    EXPECT_TRUE(list[0].stop <= t2);
+}
+
+TEST("require that only the most recent samples of a thread are kept") {
+    auto before = steady_clock::now();
+    for (size_t i = 0; i < RingTracer::RING_SIZE + 10; ++i) {
+        RT_Sample sample(wrap_tag);
+    }
+    auto list = extract_tag(wrap_tag);
+    EXPECT_EQUAL(list.size(), RingTracer::RING_SIZE);
+    EXPECT_EQUAL(extract_tag(tag0).size(), 0u);
+    EXPECT_TRUE(list[0].start >= before);
+}
+
+TEST("require that rings of exited threads are reused") {
+    std::thread([](){ RT_Sample sample(tag1); }).join();
+    size_t num_threads = RingTracer::num_threads();
+    std::thread([](){ RT_Sample sample(tag1); }).join();
+    std::thread([](){ RT_Sample sample(tag1); }).join();
+    EXPECT_EQUAL(RingTracer::num_threads(), num_threads);
+    auto list = extract_tag(tag1);
+    EXPECT_EQUAL(list.size(), 3u);
+}
+
+TEST_MT("require that samples can be extracted while being logged", 4) {
+    if (thread_id == 0) {
+        for (size_t i = 0; i < 100; ++i) {
+            auto list = extract_tag(mt_tag);
+            for (const auto &record: list) {
+                EXPECT_TRUE(record.start <= record.stop);
+            }
+        }
+        TEST_BARRIER();
+    } else {
+        for (size_t i = 0; i < 3 * RingTracer::RING_SIZE; ++i) {
+            RT_Sample sample(mt_tag);
+        }
+        TEST_BARRIER();
+    }
+    TEST_BARRIER();
+    EXPECT_EQUAL(extract_tag(mt_tag).size(), 3 * RingTracer::RING_SIZE);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
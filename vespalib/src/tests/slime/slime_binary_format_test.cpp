@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/data/slime/binary_view.h>
 #include <vespa/vespalib/data/simple_buffer.h>
 #include "type_traits.h"
 #include <vespa/vespalib/util/stringfmt.h>
@@ -670,4 +671,52 @@ TEST("require that decode failure results in 0 return value") {
     EXPECT_EQUAL(BinaryFormat::decode(buf.get(), slime), 0u);
 }
 
+TEST("require that binary view inspects the same value as the decoded slime") {
+    Slime slime = from_json("{a:true,b:-7,c:2.5,d:'foo',e:[1,[],{x:'bar'}],f:{y:{z:null}},g:[]}");
+    slime.get().setData("h", Memory("data"));
+    SimpleBuffer buf;
+    BinaryFormat::encode(slime, buf);
+    BinaryView view(buf.get());
+    EXPECT_EQUAL(view.decoded_bytes(), buf.get().size);
+    EXPECT_TRUE(view.get() == slime.get());
+    EXPECT_TRUE(slime.get() == view.get());
+    EXPECT_EQUAL(view.get().fields(), 8u);
+    EXPECT_EQUAL(view.get()["b"].asLong(), -7);
+    EXPECT_EQUAL(view.get()["c"].asLong(), 2);
+    EXPECT_EQUAL(view.get()["e"][2]["x"].asString().make_string(), "bar");
+    EXPECT_EQUAL(view.get()["e"].entries(), 3u);
+    EXPECT_TRUE(view.get()["f"]["y"]["z"].valid());
+    EXPECT_FALSE(view.get()["f"]["y"]["w"].valid());
+    EXPECT_FALSE(view.get()["e"][3].valid());
+    EXPECT_EQUAL(view.get()["h"].asData().make_string(), "data");
+    EXPECT_EQUAL(view.get()[Symbol(slime.lookup("d"))].asString().make_string(), "foo");
+    EXPECT_EQUAL(view.get()["d"].toString(), slime.get()["d"].toString());
+}
+
+TEST("require that binary view can be injected into slime") {
+    Slime expect = from_json("{a:[1,2,3],b:{c:'foo'}}");
+    SimpleBuffer buf;
+    BinaryFormat::encode(expect, buf);
+    BinaryView view(buf.get());
+    Slime actual;
+    inject(view.get()["b"], SlimeInserter(actual));
+    EXPECT_EQUAL(actual.get()["c"].asString().make_string(), "foo");
+    Slime copy;
+    inject(view.get(), SlimeInserter(copy));
+    EXPECT_EQUAL(expect, copy);
+}
+
+TEST("require that binary view of invalid input is invalid") {
+    SimpleBuffer buf;
+    buf.add(char(0)); // empty symbol table, but no value
+    BinaryView view(buf.get());
+    EXPECT_FALSE(view.get().valid());
+    EXPECT_EQUAL(view.decoded_bytes(), 0u);
+    SimpleBuffer huge;
+    huge.add(char(0)).add(encode_type_and_meta(ARRAY::ID, 0));
+    huge.add(char(0xff)).add(char(0xff)).add(char(0xff)).add(char(0x7f));
+    BinaryView huge_view(huge.get());
+    EXPECT_FALSE(huge_view.get().valid());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -4,6 +4,7 @@
 #include <vespa/vespalib/data/input.h>
 #include <vespa/vespalib/data/memory_input.h>
 #include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/vespalib/test/chunked_input.h>
 #include <iostream>
 #include <fstream>
 
@@ -385,4 +386,22 @@ TEST("require that multiple adjacent values can be decoded from a single input")
     EXPECT_EQUAL(input.obtain().size, 0u);
 }
 
+TEST("require that long strings are decoded correctly across input chunks") {
+    std::string plain;
+    for (size_t i = 0; i < 1000; ++i) {
+        plain.push_back('a' + (i % 26));
+    }
+    std::string json = "{\"" + plain + "\":[\"" + plain + "\\n" + plain + "\",'x\"" + plain + "']}";
+    std::string expect_value = plain + "\n" + plain;
+    for (size_t chunk_size : {1u, 7u, 16u, 17u, 4096u}) {
+        Slime slime;
+        MemoryInput memory_input(json);
+        vespalib::test::ChunkedInput input(memory_input, chunk_size);
+        EXPECT_EQUAL(json.size(), vespalib::slime::JsonFormat::decode(input, slime));
+        const auto &arr = slime.get()[plain];
+        EXPECT_EQUAL(expect_value, arr[0].asString().make_string());
+        EXPECT_EQUAL("x\"" + plain, arr[1].asString().make_string());
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -449,4 +449,43 @@ TEST("require that mark/revert works as expected") {
     EXPECT_EQUAL(stash.count_used(), 0u);
 }
 
+TEST("require that recycle grows chunk size until allocations fit in a single chunk") {
+    Stash stash(1024);
+    size_t destruct_small = 0;
+    size_t destruct_large = 0;
+    auto fill = [&]() {
+        for (size_t i = 0; i < 10; ++i) {
+            stash.alloc(200);
+            stash.create<Small>(destruct_small);
+        }
+        stash.create<Large>(destruct_large);
+    };
+    fill();
+    EXPECT_GREATER(stash.get_memory_usage().allocatedBytes(), 2 * stash.get_chunk_size());
+    stash.recycle();
+    EXPECT_EQUAL(destruct_small, 10u);
+    EXPECT_EQUAL(destruct_large, 1u);
+    EXPECT_GREATER(stash.get_chunk_size(), 1024u);
+    EXPECT_EQUAL(stash.count_used(), chunk_header_size());
+    for (size_t round = 0; round < 3; ++round) {
+        fill();
+        EXPECT_EQUAL(stash.get_memory_usage().allocatedBytes(), stash.get_chunk_size());
+        size_t chunk_size = stash.get_chunk_size();
+        stash.recycle();
+        EXPECT_EQUAL(stash.get_chunk_size(), chunk_size);
+    }
+    EXPECT_EQUAL(destruct_small, 40u);
+    EXPECT_EQUAL(destruct_large, 4u);
+}
+
+TEST("require that recycle does not grow chunk size beyond the given limit") {
+    Stash stash(1024);
+    stash.alloc(100000);
+    stash.recycle(8192);
+    EXPECT_EQUAL(stash.get_chunk_size(), 8192u);
+    stash.alloc(100000);
+    stash.recycle(8192);
+    EXPECT_EQUAL(stash.get_chunk_size(), 8192u);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,97 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/stllike/swiss_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <map>
+#include <random>
+
+using vespalib::swiss_map;
+
+TEST(SwissMapTest, empty_map_has_no_entries) {
+    swiss_map<uint32_t, uint32_t> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(0u, map.size());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.find(7) == map.end());
+}
+
+TEST(SwissMapTest, insert_find_and_overwrite) {
+    swiss_map<vespalib::string, int> map;
+    EXPECT_TRUE(map.insert(std::make_pair("foo", 1)).second);
+    EXPECT_TRUE(map.insert(std::make_pair("bar", 2)).second);
+    EXPECT_FALSE(map.insert(std::make_pair("foo", 3)).second);
+    EXPECT_EQ(2u, map.size());
+    EXPECT_EQ(1, map.find("foo")->second);
+    EXPECT_EQ(2, map["bar"]);
+    map["baz"] = 4;
+    EXPECT_EQ(3u, map.size());
+    EXPECT_EQ(4, map.find("baz")->second);
+}
+
+TEST(SwissMapTest, erased_entries_are_not_found_and_slots_are_reused) {
+    swiss_map<uint32_t, uint32_t> map;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        map[i] = i;
+    }
+    size_t capacity = map.capacity();
+    for (size_t round = 0; round < 10; ++round) {
+        for (uint32_t i = 0; i < 1000; ++i) {
+            map.erase(i);
+        }
+        EXPECT_TRUE(map.empty());
+        EXPECT_TRUE(map.find(500) == map.end());
+        for (uint32_t i = 0; i < 1000; ++i) {
+            map[i] = i + round;
+        }
+    }
+    EXPECT_EQ(1000u, map.size());
+    EXPECT_EQ(capacity, map.capacity());
+    EXPECT_EQ(509u, map.find(500)->second);
+}
+
+TEST(SwissMapTest, map_behaves_like_std_map_under_random_operations) {
+    swiss_map<uint32_t, uint32_t> map;
+    std::map<uint32_t, uint32_t> expect;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> key_dist(0, 5000);
+    for (size_t i = 0; i < 100000; ++i) {
+        uint32_t key = key_dist(gen);
+        if ((i % 3) == 0) {
+            map.erase(key);
+            expect.erase(key);
+        } else {
+            map[key] = i;
+            expect[key] = i;
+        }
+    }
+    ASSERT_EQ(expect.size(), map.size());
+    size_t visited = 0;
+    for (const auto &entry : map) {
+        ASSERT_EQ(1u, expect.count(entry.first));
+        EXPECT_EQ(expect[entry.first], entry.second);
+        ++visited;
+    }
+    EXPECT_EQ(expect.size(), visited);
+    visited = 0;
+    map.for_each([&visited](const auto &) { ++visited; });
+    EXPECT_EQ(expect.size(), visited);
+    for (uint32_t key = 0; key <= 5000; ++key) {
+        EXPECT_EQ(expect.count(key) != 0, map.find(key) != map.end());
+    }
+}
+
+TEST(SwissMapTest, reserve_size_avoids_growing) {
+    swiss_map<uint32_t, uint32_t> map(1000);
+    size_t capacity = map.capacity();
+    EXPECT_LE(1000u, capacity - capacity / 8);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        map[i] = i;
+    }
+    EXPECT_EQ(capacity, map.capacity());
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.find(1) == map.end());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,48 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/bfloat16.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cmath>
+
+using vespalib::BFloat16;
+using vespalib::nbostream;
+
+TEST(BFloat16Test, exactly_representable_values_survive_round_trip)
+{
+    for (float value: {0.0f, 1.0f, -1.0f, 0.5f, 2.0f, 3.0f, 1024.0f, -0.125f, 255.0f}) {
+        EXPECT_EQ(value, float(BFloat16(value)));
+    }
+}
+
+TEST(BFloat16Test, conversion_from_float_rounds_to_nearest_even)
+{
+    // 1 + 2^-8 is halfway between 1 and 1 + 2^-7; ties go to even (1)
+    EXPECT_EQ(1.0f, float(BFloat16(1.0f + std::ldexp(1.0f, -8))));
+    // 1 + 3*2^-8 is halfway between 1 + 2^-7 and 1 + 2^-6; ties go to even
+    EXPECT_EQ(1.0f + std::ldexp(1.0f, -6), float(BFloat16(1.0f + 3 * std::ldexp(1.0f, -8))));
+    // slightly above halfway rounds up
+    EXPECT_EQ(1.0f + std::ldexp(1.0f, -7), float(BFloat16(1.0f + std::ldexp(1.0f, -8) + std::ldexp(1.0f, -16))));
+}
+
+TEST(BFloat16Test, special_values_are_preserved)
+{
+    EXPECT_TRUE(std::isinf(float(BFloat16(std::numeric_limits<float>::infinity()))));
+    EXPECT_TRUE(std::isnan(float(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_TRUE(std::isnan(float(std::numeric_limits<BFloat16>::quiet_NaN())));
+    EXPECT_EQ(float(std::numeric_limits<BFloat16>::lowest()), -float(std::numeric_limits<BFloat16>::max()));
+}
+
+TEST(BFloat16Test, bfloat16_is_serialized_as_its_bits)
+{
+    nbostream stream;
+    stream << BFloat16(1.5f) << BFloat16(-3.0f);
+    EXPECT_EQ(4u, stream.size());
+    BFloat16 a;
+    BFloat16 b;
+    stream >> a >> b;
+    EXPECT_EQ(1.5f, float(a));
+    EXPECT_EQ(-3.0f, float(b));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
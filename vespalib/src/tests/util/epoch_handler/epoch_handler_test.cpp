@@ -0,0 +1,174 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/epoch_handler.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/generationholder.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using vespalib::EpochHandler;
+using vespalib::GenerationHeldBase;
+using vespalib::GenerationHolder;
+using vespalib::IllegalStateException;
+using Guard = EpochHandler::Guard;
+using Reader = EpochHandler::Reader;
+
+TEST(EpochHandlerTest, generation_can_be_increased)
+{
+    EpochHandler eh;
+    EXPECT_EQ(0u, eh.getCurrentGeneration());
+    EXPECT_EQ(0u, eh.getFirstUsedGeneration());
+    eh.incGeneration();
+    EXPECT_EQ(1u, eh.getCurrentGeneration());
+    EXPECT_EQ(1u, eh.getFirstUsedGeneration());
+    EXPECT_EQ(2u, eh.getNextGeneration());
+}
+
+TEST(EpochHandlerTest, readers_can_take_guards)
+{
+    EpochHandler eh;
+    Reader r1(eh);
+    Reader r2(eh);
+    EXPECT_FALSE(eh.hasReaders());
+    {
+        Guard g1 = r1.takeGuard();
+        EXPECT_TRUE(g1.valid());
+        EXPECT_EQ(0u, g1.getGeneration());
+        EXPECT_EQ(1u, eh.getGenerationRefCount(0));
+        eh.incGeneration();
+        EXPECT_EQ(0u, eh.getFirstUsedGeneration());
+        {
+            Guard g2 = r2.takeGuard();
+            EXPECT_EQ(1u, g2.getGeneration());
+            EXPECT_EQ(1u, eh.getGenerationRefCount(0));
+            EXPECT_EQ(1u, eh.getGenerationRefCount(1));
+            EXPECT_EQ(2u, eh.getGenerationRefCount());
+        }
+        eh.incGeneration();
+        EXPECT_EQ(0u, eh.getFirstUsedGeneration());
+        EXPECT_EQ(1u, eh.getGenerationRefCount());
+        EXPECT_TRUE(eh.hasReaders());
+    }
+    EXPECT_EQ(0u, eh.getFirstUsedGeneration());
+    eh.updateFirstUsedGeneration();
+    EXPECT_EQ(2u, eh.getFirstUsedGeneration());
+    EXPECT_FALSE(eh.hasReaders());
+}
+
+TEST(EpochHandlerTest, nested_guards_keep_outermost_generation)
+{
+    EpochHandler eh;
+    Reader r(eh);
+    Guard g1 = r.takeGuard();
+    eh.incGeneration();
+    {
+        Guard g2 = r.takeGuard();
+        EXPECT_EQ(0u, g2.getGeneration());
+    }
+    EXPECT_EQ(1u, eh.getGenerationRefCount(0));
+    eh.incGeneration();
+    EXPECT_EQ(0u, eh.getFirstUsedGeneration());
+    g1 = Guard();
+    EXPECT_FALSE(g1.valid());
+    eh.updateFirstUsedGeneration();
+    EXPECT_EQ(2u, eh.getFirstUsedGeneration());
+}
+
+TEST(EpochHandlerTest, guards_can_be_moved)
+{
+    EpochHandler eh;
+    Reader r(eh);
+    Guard g1 = r.takeGuard();
+    Guard g2(std::move(g1));
+    EXPECT_FALSE(g1.valid());
+    EXPECT_TRUE(g2.valid());
+    EXPECT_EQ(1u, eh.getGenerationRefCount());
+    Guard g3;
+    g3 = std::move(g2);
+    EXPECT_FALSE(g2.valid());
+    EXPECT_EQ(1u, eh.getGenerationRefCount());
+    g3 = Guard();
+    EXPECT_EQ(0u, eh.getGenerationRefCount());
+}
+
+TEST(EpochHandlerTest, reader_slots_are_reused)
+{
+    EpochHandler eh(2);
+    EXPECT_EQ(2u, eh.getMaxReaders());
+    {
+        Reader r1(eh);
+        Reader r2(eh);
+        EXPECT_THROW(Reader r3(eh), IllegalStateException);
+    }
+    Reader r1(eh);
+    Reader r2(eh);
+    Guard g = r2.takeGuard();
+    EXPECT_EQ(1u, eh.getGenerationRefCount(0));
+}
+
+namespace {
+
+class MyHeld : public GenerationHeldBase
+{
+    std::vector<uint32_t> &_values;
+public:
+    MyHeld(std::vector<uint32_t> &values)
+        : GenerationHeldBase(values.size() * sizeof(uint32_t)),
+          _values(values)
+    {
+    }
+    ~MyHeld() override {
+        // Poison the values to catch readers using them after reclamation.
+        std::fill(_values.begin(), _values.end(), 0u);
+        delete &_values;
+    }
+};
+
+}
+
+TEST(EpochHandlerTest, held_data_is_not_freed_while_readers_use_it)
+{
+    constexpr uint32_t num_readers = 4;
+    constexpr uint32_t num_writes = 20000;
+    EpochHandler eh;
+    GenerationHolder holder;
+    std::atomic<std::vector<uint32_t> *> current(new std::vector<uint32_t>(64, 1u));
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> bad_reads(0);
+    std::vector<std::thread> readers;
+    for (uint32_t i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&]() {
+                Reader reader(eh);
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto guard = reader.takeGuard();
+                    const auto &values = *current.load(std::memory_order_acquire);
+                    uint32_t expected = values[0];
+                    for (uint32_t value : values) {
+                        if (value != expected || value == 0u) {
+                            ++bad_reads;
+                        }
+                    }
+                }
+            });
+    }
+    for (uint32_t i = 2; i < num_writes + 2; ++i) {
+        auto *old_values = current.exchange(new std::vector<uint32_t>(64, i), std::memory_order_release);
+        holder.hold(std::make_unique<MyHeld>(*old_values));
+        holder.transferHoldLists(eh.getCurrentGeneration());
+        eh.incGeneration();
+        holder.trimHoldLists(eh.getFirstUsedGeneration());
+    }
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(0u, bad_reads.load());
+    eh.updateFirstUsedGeneration();
+    holder.trimHoldLists(eh.getFirstUsedGeneration());
+    EXPECT_EQ(0u, holder.getHeldBytes());
+    delete current.load();
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,150 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using vespalib::alloc::Alloc;
+using vespalib::alloc::HugePageAllocator;
+using vespalib::alloc::MemoryAllocator;
+using NumaPolicy = HugePageAllocator::NumaPolicy;
+
+namespace {
+
+constexpr size_t huge_page_size = MemoryAllocator::HUGEPAGE_SIZE;
+
+struct MyAlloc
+{
+    const MemoryAllocator& allocator;
+    void* data;
+    size_t size;
+
+    MyAlloc(const MemoryAllocator& allocator_in, MemoryAllocator::PtrAndSize buf)
+        : allocator(allocator_in),
+          data(buf.first),
+          size(buf.second)
+    {
+    }
+
+    ~MyAlloc()
+    {
+        allocator.free(data, size);
+    }
+};
+
+bool
+is_huge_page_aligned(const void *buf)
+{
+    return (reinterpret_cast<uintptr_t>(buf) & (huge_page_size - 1)) == 0;
+}
+
+#ifdef __linux__
+int
+get_numa_mode(void *buf)
+{
+    int mode = -1;
+    if (syscall(SYS_get_mempolicy, &mode, nullptr, 0, buf, MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return mode;
+}
+#endif
+
+}
+
+TEST(HugePageAllocatorTest, zero_sized_allocation_is_handled)
+{
+    HugePageAllocator allocator;
+    MyAlloc buf(allocator, allocator.alloc(0));
+    EXPECT_EQ(nullptr, buf.data);
+    EXPECT_EQ(0u, buf.size);
+}
+
+TEST(HugePageAllocatorTest, small_allocation_is_taken_from_heap)
+{
+    HugePageAllocator allocator;
+    MyAlloc buf(allocator, allocator.alloc(1000));
+    EXPECT_NE(nullptr, buf.data);
+    EXPECT_EQ(1000u, buf.size);
+    memset(buf.data, 'x', buf.size);
+}
+
+TEST(HugePageAllocatorTest, large_allocation_is_rounded_up_to_huge_pages)
+{
+    HugePageAllocator allocator;
+    MyAlloc buf(allocator, allocator.alloc(huge_page_size + 1));
+    EXPECT_NE(nullptr, buf.data);
+    EXPECT_EQ(2 * huge_page_size, buf.size);
+    EXPECT_TRUE(is_huge_page_aligned(buf.data));
+    memset(buf.data, 'x', buf.size);
+}
+
+TEST(HugePageAllocatorTest, large_allocation_can_be_freed_with_requested_size)
+{
+    HugePageAllocator huge_page_allocator;
+    const MemoryAllocator &allocator = huge_page_allocator;
+    auto buf = allocator.alloc(3 * huge_page_size - 10);
+    EXPECT_EQ(3 * huge_page_size, buf.second);
+    memset(buf.first, 'x', buf.second);
+    allocator.free(buf.first, 3 * huge_page_size - 10);
+}
+
+TEST(HugePageAllocatorTest, interleave_policy_is_applied)
+{
+    HugePageAllocator allocator(NumaPolicy::INTERLEAVE);
+    MyAlloc buf(allocator, allocator.alloc(4 * huge_page_size));
+    memset(buf.data, 'x', buf.size);
+#ifdef __linux__
+    int mode = get_numa_mode(buf.data);
+    if (mode >= 0) {
+        EXPECT_EQ(MPOL_INTERLEAVE, mode);
+    }
+#endif
+}
+
+TEST(HugePageAllocatorTest, bind_policy_is_applied)
+{
+    HugePageAllocator allocator(NumaPolicy::BIND, 0);
+    EXPECT_EQ(NumaPolicy::BIND, allocator.get_numa_policy());
+    EXPECT_EQ(0u, allocator.get_numa_node());
+    MyAlloc buf(allocator, allocator.alloc(huge_page_size));
+    memset(buf.data, 'x', buf.size);
+#ifdef __linux__
+    int mode = get_numa_mode(buf.data);
+    if (mode >= 0) {
+        EXPECT_EQ(MPOL_BIND, mode);
+    }
+#endif
+}
+
+TEST(HugePageAllocatorTest, numa_node_out_of_range_is_rejected)
+{
+    EXPECT_THROW(HugePageAllocator(NumaPolicy::BIND, 100000), vespalib::IllegalArgumentException);
+}
+
+TEST(HugePageAllocatorTest, rcu_vector_can_use_allocator)
+{
+    HugePageAllocator allocator;
+    vespalib::GenerationHolder holder;
+    {
+        vespalib::RcuVectorBase<int64_t> vec(holder, Alloc::alloc_with_allocator(&allocator));
+        for (int64_t i = 0; i < 1000000; ++i) {
+            vec.push_back(i);
+        }
+        EXPECT_EQ(999999, vec[999999]);
+        EXPECT_TRUE(is_huge_page_aligned(&vec[0]));
+        holder.transferHoldLists(0);
+        holder.trimHoldLists(1);
+    }
+    holder.transferHoldLists(1);
+    holder.trimHoldLists(2);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/util/md5.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <vector>
 
 namespace vespalib {
 
@@ -32,6 +33,34 @@ TEST("MD5 output matches Wikipedia test vectors") {
     EXPECT_EQUAL("e4d909c290d0fb1ca068ffaddf22cbd0", md5_hash_of("The quick brown fox jumps over the lazy dog."));
 }
 
+TEST("multi-buffer MD5 matches single buffer MD5 for all message lengths") {
+    // lengths span several blocks and the padding boundaries, and the
+    // count is not a multiple of the number of lanes
+    std::vector<string> msgs;
+    for (size_t len = 0; len < 203; ++len) {
+        string msg;
+        for (size_t i = 0; i < len; ++i) {
+            msg.push_back(char('a' + ((i * 7 + len) % 26)));
+        }
+        msgs.push_back(msg);
+    }
+    std::vector<const void *> data;
+    std::vector<size_t> lens;
+    std::vector<unsigned char> keys(16 * msgs.size());
+    std::vector<unsigned char *> key_ptrs;
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        data.push_back(msgs[i].data());
+        lens.push_back(msgs[i].size());
+        key_ptrs.push_back(&keys[16 * i]);
+    }
+    fastc_md5sum_multi(data.data(), lens.data(), key_ptrs.data(), msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        unsigned char expect[16];
+        fastc_md5sum(msgs[i].data(), msgs[i].size(), expect);
+        EXPECT_EQUAL(0, memcmp(expect, key_ptrs[i], 16));
+    }
+}
+
 }
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,102 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/mmap_file_allocator.h>
+#include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+
+using vespalib::alloc::MemoryAllocator;
+using vespalib::alloc::MmapFileAllocator;
+using vespalib::alloc::MmapFileAllocatorFactory;
+
+namespace {
+
+vespalib::string basedir("mmap-file-allocator-dir");
+
+struct MyAlloc
+{
+    const MemoryAllocator& allocator;
+    void* data;
+    size_t size;
+
+    MyAlloc(MemoryAllocator& allocator_in, MemoryAllocator::PtrAndSize buf)
+        : allocator(allocator_in),
+          data(buf.first),
+          size(buf.second)
+    {
+    }
+
+    ~MyAlloc()
+    {
+        allocator.free(data, size);
+    }
+};
+
+}
+
+class MmapFileAllocatorTest : public ::testing::Test
+{
+protected:
+    MmapFileAllocator _allocator;
+
+public:
+    MmapFileAllocatorTest();
+    ~MmapFileAllocatorTest();
+};
+
+MmapFileAllocatorTest::MmapFileAllocatorTest()
+    : _allocator(basedir)
+{
+}
+
+MmapFileAllocatorTest::~MmapFileAllocatorTest() = default;
+
+TEST_F(MmapFileAllocatorTest, zero_sized_allocation_is_handled)
+{
+    MyAlloc buf(_allocator, _allocator.alloc(0));
+    EXPECT_EQ(nullptr, buf.data);
+    EXPECT_EQ(0u, buf.size);
+}
+
+TEST_F(MmapFileAllocatorTest, mmap_file_allocator_works)
+{
+    MyAlloc buf(_allocator, _allocator.alloc(4));
+    EXPECT_LE(4u, buf.size);
+    EXPECT_TRUE(buf.data != nullptr);
+    memcpy(buf.data, "1234", 4);
+    MyAlloc buf2(_allocator, _allocator.alloc(5));
+    EXPECT_LE(5u, buf2.size);
+    EXPECT_TRUE(buf2.data != nullptr);
+    EXPECT_TRUE(buf.data != buf2.data);
+    memcpy(buf2.data, "67890", 5);
+    EXPECT_EQ(0, memcmp(buf.data, "1234", 4));
+    EXPECT_EQ(0, memcmp(buf2.data, "67890", 5));
+    EXPECT_EQ(buf.size + buf2.size, _allocator.get_end_offset());
+    EXPECT_EQ(0u, _allocator.resize_inplace(MemoryAllocator::PtrAndSize(buf.data, buf.size), buf.size * 2));
+}
+
+TEST(MmapFileAllocatorFactoryTest, no_allocator_is_made_when_not_set_up)
+{
+    MmapFileAllocatorFactory::instance().setup("");
+    EXPECT_FALSE(MmapFileAllocatorFactory::instance().make_memory_allocator("foo"));
+}
+
+TEST(MmapFileAllocatorFactoryTest, allocator_is_made_when_set_up)
+{
+    MmapFileAllocatorFactory::instance().setup(basedir);
+    auto allocator = MmapFileAllocatorFactory::instance().make_memory_allocator("foo");
+    ASSERT_TRUE(allocator);
+    EXPECT_TRUE(vespalib::isDirectory(basedir + "/0.foo"));
+    {
+        MyAlloc buf(*allocator, allocator->alloc(4));
+        memcpy(buf.data, "1234", 4);
+        EXPECT_EQ(0, memcmp(buf.data, "1234", 4));
+    }
+    allocator.reset();
+    EXPECT_FALSE(vespalib::isDirectory(basedir + "/0.foo"));
+    MmapFileAllocatorFactory::instance().setup("");
+    vespalib::rmdir(basedir, true);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,81 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/numa_nodes.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <atomic>
+#include <fstream>
+
+using vespalib::NumaNodes;
+using vespalib::Runnable;
+using vespalib::SimpleThreadBundle;
+using CpuList = NumaNodes::CpuList;
+
+namespace {
+
+vespalib::string basedir("numa-nodes-dir");
+
+void make_node(const vespalib::string &name, const vespalib::string &cpulist)
+{
+    vespalib::mkdir(basedir + "/" + name, true);
+    std::ofstream out(basedir + "/" + name + "/cpulist");
+    out << cpulist << std::endl;
+}
+
+struct Counter : Runnable {
+    std::atomic<size_t> &count;
+    explicit Counter(std::atomic<size_t> &count_in) : count(count_in) {}
+    void run() override { ++count; }
+};
+
+}
+
+TEST(NumaNodesTest, cpu_list_can_be_parsed)
+{
+    EXPECT_EQ((CpuList{0, 1, 2, 3, 8, 10, 11}), NumaNodes::parse_cpu_list("0-3,8,10-11"));
+    EXPECT_EQ((CpuList{5}), NumaNodes::parse_cpu_list("5\n"));
+    EXPECT_EQ(CpuList(), NumaNodes::parse_cpu_list(""));
+}
+
+TEST(NumaNodesTest, malformed_cpu_list_gives_empty_list)
+{
+    EXPECT_EQ(CpuList(), NumaNodes::parse_cpu_list("0-"));
+    EXPECT_EQ(CpuList(), NumaNodes::parse_cpu_list("3-1"));
+    EXPECT_EQ(CpuList(), NumaNodes::parse_cpu_list("a,b"));
+}
+
+TEST(NumaNodesTest, cpus_per_node_are_read_from_sysfs_layout)
+{
+    vespalib::rmdir(basedir, true);
+    make_node("node1", "4-7");
+    make_node("node0", "0-3");
+    make_node("node2", "");
+    vespalib::mkdir(basedir + "/power", true);
+    auto nodes = NumaNodes::cpus_per_node(basedir);
+    ASSERT_EQ(2u, nodes.size());
+    EXPECT_EQ((CpuList{0, 1, 2, 3}), nodes[0]);
+    EXPECT_EQ((CpuList{4, 5, 6, 7}), nodes[1]);
+    vespalib::rmdir(basedir, true);
+}
+
+TEST(NumaNodesTest, missing_sysfs_layout_gives_no_nodes)
+{
+    EXPECT_TRUE(NumaNodes::cpus_per_node("no-such-dir").empty());
+}
+
+TEST(NumaNodesTest, pinned_thread_bundle_runs_all_targets)
+{
+    CpuList cpus{0};
+    SimpleThreadBundle bundle(3, cpus);
+    std::atomic<size_t> count(0);
+    std::vector<Counter> counters(3, Counter(count));
+    std::vector<Runnable*> targets;
+    for (auto &counter: counters) {
+        targets.push_back(&counter);
+    }
+    bundle.run(targets);
+    EXPECT_EQ(3u, count);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -51,6 +51,11 @@ public:
 
     void recursiveDelete(NodeRef node);
     void insert(const KeyT &key, const DataT &data);
+    /**
+     * Insert leaf node entries [start_idx, end_idx), which must be ordered
+     * after all entries inserted so far.
+     */
+    void insert_range(const LeafNodeType &node, uint32_t start_idx, uint32_t end_idx);
     NodeRef handover();
     void reuse();
     void clear();
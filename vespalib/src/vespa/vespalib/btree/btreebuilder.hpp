@@ -3,6 +3,7 @@
 #pragma once
 
 #include "btreebuilder.h"
+#include <algorithm>
 
 namespace vespalib::btree {
 
@@ -383,6 +384,29 @@ insert(const KeyT &key,
 }
 
 
+template <typename KeyT, typename DataT, typename AggrT,
+          size_t INTERNAL_SLOTS, size_t LEAF_SLOTS, class AggrCalcT>
+void
+BTreeBuilder<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS, AggrCalcT>::
+insert_range(const LeafNodeType &node, uint32_t start_idx, uint32_t end_idx)
+{
+    while (start_idx < end_idx) {
+        if (_leaf.data->validSlots() >= LeafNodeType::maxSlots())
+            allocNewLeafNode();
+        LeafNodeType *leaf = _leaf.data;
+        uint32_t idx = leaf->validSlots();
+        uint32_t count = std::min(end_idx - start_idx, LeafNodeType::maxSlots() - idx);
+        for (uint32_t i = 0; i < count; ++i) {
+            leaf->writeKey(idx + i, node.getKey(start_idx + i));
+            leaf->writeData(idx + i, node.getData(start_idx + i));
+        }
+        leaf->setValidSlots(idx + count);
+        start_idx += count;
+        _numInserts += count;
+    }
+}
+
+
 template <typename KeyT, typename DataT, typename AggrT,
           size_t INTERNAL_SLOTS, size_t LEAF_SLOTS, class AggrCalcT>
 typename BTreeBuilder<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS,
@@ -554,6 +554,47 @@ public:
             _leaf.getNode()->foreach_key_range(idx, eidx, func);
         }
     }
+
+    /**
+     * Call func with leaf node and entry range [start_idx, end_idx) as
+     * arguments for all leaf entries from this iterator position with keys
+     * ordered before key, and step iterator to the first entry not ordered
+     * before key.
+     */
+    template <typename CompareT, typename FunctionType>
+    void
+    foreach_leaf_range_before(const KeyType &key, CompareT comp, FunctionType func)
+    {
+        while (_leaf.getNode() != nullptr) {
+            const LeafNodeType *node = _leaf.getNode();
+            uint32_t idx = _leaf.getIdx();
+            uint32_t eidx = comp(node->getLastKey(), key) ? node->validSlots() : node->lower_bound(idx, key, comp);
+            if (idx < eidx) {
+                func(*node, idx, eidx);
+            }
+            if (eidx < node->validSlots()) {
+                _leaf.setIdx(eidx);
+                return;
+            }
+            findNextLeafNode();
+        }
+    }
+
+    /**
+     * Call func with leaf node and entry range [start_idx, end_idx) as
+     * arguments for all leaf entries from this iterator position to end of
+     * tree, and step iterator to end of tree.
+     */
+    template <typename FunctionType>
+    void
+    foreach_leaf_range_rest(FunctionType func)
+    {
+        while (_leaf.getNode() != nullptr) {
+            const LeafNodeType *node = _leaf.getNode();
+            func(*node, _leaf.getIdx(), node->validSlots());
+            findNextLeafNode();
+        }
+    }
 };
 
 
@@ -10,6 +10,8 @@
 #include <cassert>
 #include <utility>
 #include <cstddef>
+#include <functional>
+#include <type_traits>
 
 namespace vespalib::datastore {
 
@@ -196,6 +198,17 @@ protected:
         return *this;
     }
 
+    /*
+     * Integral keys ordered by std::less are searched by counting the
+     * smaller keys over all valid slots. The loop has no branches and is
+     * vectorized by the compiler, which beats a binary search for the few
+     * keys in a node.
+     */
+    template <typename CompareT>
+    static constexpr bool use_linear_search() {
+        return std::is_integral_v<KeyT> && std::is_same_v<CompareT, std::less<KeyT>>;
+    }
+
 public:
     const KeyT & getKey(uint32_t idx) const { return _keys[idx]; }
     const KeyT & getLastKey() const { return _keys[validSlots() - 1]; }
@@ -43,9 +43,18 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_linear_search<CompareT>()) {
+        (void) comp;
+        uint32_t idx = sidx;
+        for (uint32_t i = sidx; i < validSlots(); ++i) {
+            idx += (_keys[i] < key) ? 1 : 0;
+        }
+        return idx;
+    } else {
+        const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
+            (_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 template <typename KeyT, uint32_t NumSlots>
@@ -53,10 +62,7 @@ template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT & key, CompareT comp) const
 {
-    
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return lower_bound(0, key, comp);
 }
 
 
@@ -66,9 +72,18 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 upper_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_linear_search<CompareT>()) {
+        (void) comp;
+        uint32_t idx = sidx;
+        for (uint32_t i = sidx; i < validSlots(); ++i) {
+            idx += (key < _keys[i]) ? 0 : 1;
+        }
+        return idx;
+    } else {
+        const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
+            (_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 
@@ -154,6 +154,22 @@ public:
     void
     finishCompact(const std::vector<uint32_t> &toHold);
 
+    /**
+     * Start compaction of the small array buffer with most dead
+     * elements. Trees are never moved. Returns the ids of the buffers
+     * to pass to finishCompact() when all entries have been moved.
+     **/
+    std::vector<uint32_t>
+    startCompactWorstSmallArrays();
+
+    /**
+     * Move the small array referenced by ref to a new buffer if it is
+     * in a buffer being compacted. Returns the new reference, or ref
+     * if the entry was not moved.
+     **/
+    EntryRef
+    move(EntryRef ref);
+
 
     const KeyDataType *
     lower_bound(const KeyDataType *b, const KeyDataType *e,
@@ -365,6 +381,13 @@ public:
         return usage;
     }
 
+    /**
+     * Returns the memory usage of the buffers holding small arrays,
+     * which is the part of the store compacted by
+     * startCompactWorstSmallArrays().
+     **/
+    vespalib::MemoryUsage getSmallArraysMemoryUsage() const;
+
     void
     clearBuilder()
     {
@@ -143,6 +143,68 @@ finishCompact(const std::vector<uint32_t> &toHold)
 }
 
 
+template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
+          typename TraitsT, typename AggrCalcT>
+std::vector<uint32_t>
+BTreeStore<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
+startCompactWorstSmallArrays()
+{
+    uint32_t worstTypeId = clusterLimit;
+    size_t worstDeadElems = 0;
+    for (uint32_t bufferId = 0; bufferId < _store.getNumBuffers(); ++bufferId) {
+        const BufferState &state = _store.getBufferState(bufferId);
+        if (state.isActive() && isSmallArray(state.getTypeId()) && !state.getCompacting()) {
+            size_t deadElems = state.getDeadElems() - state.getTypeHandler()->getReservedElements(bufferId);
+            if (deadElems > worstDeadElems) {
+                worstTypeId = state.getTypeId();
+                worstDeadElems = deadElems;
+            }
+        }
+    }
+    std::vector<uint32_t> toHold;
+    if (worstTypeId != clusterLimit) {
+        toHold.push_back(_store.startCompactWorstBuffer(worstTypeId));
+    }
+    return toHold;
+}
+
+
+template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
+          typename TraitsT, typename AggrCalcT>
+typename BTreeStore<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::EntryRef
+BTreeStore<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
+move(EntryRef ref)
+{
+    if (!ref.valid() || !_store.getCompacting(ref)) {
+        return ref;
+    }
+    RefType iRef(ref);
+    uint32_t clusterSize = getClusterSize(iRef);
+    assert(clusterSize != 0);
+    return allocNewKeyDataCopy(getKeyDataEntry(iRef, clusterSize), clusterSize).ref;
+}
+
+
+template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
+          typename TraitsT, typename AggrCalcT>
+vespalib::MemoryUsage
+BTreeStore<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
+getSmallArraysMemoryUsage() const
+{
+    vespalib::MemoryUsage usage;
+    for (uint32_t bufferId = 0; bufferId < _store.getNumBuffers(); ++bufferId) {
+        const BufferState &state = _store.getBufferState(bufferId);
+        if (state.isActive() && isSmallArray(state.getTypeId())) {
+            usage.incAllocatedBytes(state.capacity() * sizeof(KeyDataType));
+            usage.incUsedBytes(state.size() * sizeof(KeyDataType));
+            usage.incDeadBytes(state.getDeadElems() * sizeof(KeyDataType));
+            usage.incAllocatedBytesOnHold(state.getHoldElems() * sizeof(KeyDataType));
+        }
+    }
+    return usage;
+}
+
+
 template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
           typename TraitsT, typename AggrCalcT>
 const typename BTreeStore<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
@@ -570,22 +632,18 @@ applyBuildTree(BTreeType *tree,
     Iterator itr = tree->begin(_allocator);
     Builder &builder = _builder;
     builder.reuse();
+    auto copy = [&builder](const LeafNodeType &node, uint32_t start_idx, uint32_t end_idx)
+                { builder.insert_range(node, start_idx, end_idx); };
     while (a != ae || r != re) {
         if (r != re && (a == ae || comp(*r, a->_key))) {
             // remove
-            while (itr.valid() && comp(itr.getKey(), *r)) {
-                builder.insert(itr.getKey(), itr.getData());
-                ++itr;
-            }
+            itr.foreach_leaf_range_before(*r, comp, copy);
             if (itr.valid() && !comp(*r, itr.getKey()))
                 ++itr;
             ++r;
         } else {
             // add or update
-            while (itr.valid() && comp(itr.getKey(), a->_key)) {
-                builder.insert(itr.getKey(), itr.getData());
-                ++itr;
-            }
+            itr.foreach_leaf_range_before(a->_key, comp, copy);
             if (itr.valid() && !comp(a->_key, itr.getKey()))
                 ++itr;
             builder.insert(a->_key, a->getData());
@@ -594,10 +652,7 @@ applyBuildTree(BTreeType *tree,
             ++a;
         }
     }
-    while (itr.valid()) {
-        builder.insert(itr.getKey(), itr.getData());
-        ++itr;
-    }
+    itr.foreach_leaf_range_rest(copy);
     tree->assign(builder, _allocator);
 }
 
@@ -741,7 +796,8 @@ applyTree(BTreeType *tree,
     uint32_t treeSize = tree->size(_allocator);
     size_t additionSize(ae - a);
     size_t removeSize(re - r);
-    uint64_t buildCost = treeSize * 2 + additionSize;
+    // Unchanged entries are copied to the new tree one leaf node range at a time
+    uint64_t buildCost = treeSize + additionSize;
     uint64_t modifyCost = (asmlog2(treeSize + additionSize) + 1) *
                           (additionSize + removeSize);
     if (modifyCost < buildCost)
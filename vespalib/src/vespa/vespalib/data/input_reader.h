@@ -5,6 +5,7 @@
 #include "memory.h"
 #include <vespa/vespalib/stllike/string.h>
 #include <vector>
+#include <cassert>
 
 namespace vespalib {
 
@@ -113,6 +114,24 @@ public:
      * @return Memory referencing the read bytes. Returns an empty
      *         Memory if the reader has failed.
      **/
+    /**
+     * Look at the data currently buffered without consuming it. Use
+     * 'skip' to consume (a prefix of) the returned data afterwards.
+     * The returned data is invalidated by any other read operation.
+     **/
+    Memory peek() {
+        obtain();
+        return Memory(data(), size());
+    }
+
+    /**
+     * Consume bytes previously returned by 'peek'.
+     **/
+    void skip(size_t bytes) {
+        assert(bytes <= size());
+        _pos += bytes;
+    }
+
     Memory read(size_t bytes) {
         if (__builtin_expect(obtain() >= bytes, true)) {
             Memory ret(data(), bytes);
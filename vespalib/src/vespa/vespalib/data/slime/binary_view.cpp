@@ -0,0 +1,275 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "binary_view.h"
+#include "binary_format.h"
+#include "array_traverser.h"
+#include "object_traverser.h"
+#include "json_format.h"
+#include "nix_value.h"
+#include <vespa/vespalib/data/memory_input.h>
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <limits>
+
+using namespace vespalib::slime::binary_format;
+
+namespace vespalib::slime {
+
+BinaryView::BinaryView(Memory data)
+    : _data(data),
+      _symbols(),
+      _index(),
+      _decoded_bytes(0),
+      _indexed(false)
+{
+}
+
+BinaryView::~BinaryView() = default;
+
+bool
+BinaryView::build_value(InputReader &in, size_t idx) const
+{
+    char byte = in.read();
+    uint32_t type = decode_type(byte);
+    uint32_t meta = decode_meta(byte);
+    uint64_t value = 0;
+    uint64_t size = 0;
+    switch (type) {
+    case NIX::ID:
+        break;
+    case BOOL::ID:
+        value = (meta != 0) ? 1 : 0;
+        break;
+    case LONG::ID:
+        value = read_bytes<false>(in, meta);
+        break;
+    case DOUBLE::ID:
+        value = read_bytes<true>(in, meta);
+        break;
+    case STRING::ID:
+    case DATA::ID:
+        size = read_size(in, meta);
+        value = in.read(size).data - _data.data;
+        break;
+    case ARRAY::ID:
+    case OBJECT::ID:
+        size = read_size(in, meta);
+        break;
+    }
+    if (in.failed() || (size > std::numeric_limits<uint32_t>::max())) {
+        in.fail("invalid value size");
+        return false;
+    }
+    size_t first_child = _index.size();
+    if ((type == ARRAY::ID) || (type == OBJECT::ID)) {
+        // each child takes at least one byte, which bounds the index size for malformed input
+        if (size > (_data.size - in.get_offset())) {
+            in.fail("too many children");
+            return false;
+        }
+        _index.resize(first_child + size);
+        for (size_t i = 0; i < size; ++i) {
+            if (type == OBJECT::ID) {
+                _index[first_child + i]._symbol = read_cmpr_ulong(in);
+            }
+            if (!build_value(in, first_child + i)) {
+                return false;
+            }
+        }
+    }
+    Value &self = _index[idx];
+    self._view = this;
+    self._type = type;
+    self._size = size;
+    self._first_child = first_child;
+    self._value = value;
+    return true;
+}
+
+bool
+BinaryView::build_index() const
+{
+    MemoryInput memory_input(_data);
+    InputReader in(memory_input);
+    uint64_t num_symbols = read_cmpr_ulong(in);
+    for (size_t i = 0; !in.failed() && (i < num_symbols); ++i) {
+        uint64_t size = read_cmpr_ulong(in);
+        _symbols.push_back(in.read(size));
+    }
+    _index.resize(1);
+    if (in.failed() || !build_value(in, 0)) {
+        return false;
+    }
+    _decoded_bytes = in.get_offset();
+    return true;
+}
+
+Inspector &
+BinaryView::get() const
+{
+    if (!_indexed) {
+        if (!build_index()) {
+            _symbols.clear();
+            _index.clear();
+            _decoded_bytes = 0;
+        }
+        _indexed = true;
+    }
+    if (_index.empty()) {
+        return *NixValue::invalid();
+    }
+    return _index[0];
+}
+
+size_t
+BinaryView::decoded_bytes() const
+{
+    get();
+    return _decoded_bytes;
+}
+
+Memory
+BinaryView::symbol_name(Symbol symbol) const
+{
+    get();
+    return (symbol.getValue() < _symbols.size()) ? _symbols[symbol.getValue()] : Memory();
+}
+
+//-----------------------------------------------------------------------------
+
+Type
+BinaryView::Value::type() const
+{
+    switch (_type) {
+    case BOOL::ID:   return BOOL::instance;
+    case LONG::ID:   return LONG::instance;
+    case DOUBLE::ID: return DOUBLE::instance;
+    case STRING::ID: return STRING::instance;
+    case DATA::ID:   return DATA::instance;
+    case ARRAY::ID:  return ARRAY::instance;
+    case OBJECT::ID: return OBJECT::instance;
+    }
+    return NIX::instance;
+}
+
+size_t
+BinaryView::Value::children() const
+{
+    return ((_type == ARRAY::ID) || (_type == OBJECT::ID)) ? _size : 0;
+}
+
+size_t
+BinaryView::Value::entries() const
+{
+    return (_type == ARRAY::ID) ? _size : 0;
+}
+
+size_t
+BinaryView::Value::fields() const
+{
+    return (_type == OBJECT::ID) ? _size : 0;
+}
+
+bool
+BinaryView::Value::asBool() const
+{
+    return (_type == BOOL::ID) && (_value != 0);
+}
+
+int64_t
+BinaryView::Value::asLong() const
+{
+    switch (_type) {
+    case LONG::ID:   return decode_zigzag(_value);
+    case DOUBLE::ID: return decode_double(_value);
+    }
+    return 0;
+}
+
+double
+BinaryView::Value::asDouble() const
+{
+    switch (_type) {
+    case LONG::ID:   return decode_zigzag(_value);
+    case DOUBLE::ID: return decode_double(_value);
+    }
+    return 0.0;
+}
+
+Memory
+BinaryView::Value::asString() const
+{
+    return (_type == STRING::ID) ? Memory(_view->_data.data + _value, _size) : Memory();
+}
+
+Memory
+BinaryView::Value::asData() const
+{
+    return (_type == DATA::ID) ? Memory(_view->_data.data + _value, _size) : Memory();
+}
+
+void
+BinaryView::Value::traverse(ArrayTraverser &at) const
+{
+    for (size_t i = 0; i < entries(); ++i) {
+        at.entry(i, child(i));
+    }
+}
+
+void
+BinaryView::Value::traverse(ObjectSymbolTraverser &ot) const
+{
+    for (size_t i = 0; i < fields(); ++i) {
+        const Value &field = child(i);
+        ot.field(Symbol(field._symbol), field);
+    }
+}
+
+void
+BinaryView::Value::traverse(ObjectTraverser &ot) const
+{
+    for (size_t i = 0; i < fields(); ++i) {
+        const Value &field = child(i);
+        ot.field(_view->symbol_name(Symbol(field._symbol)), field);
+    }
+}
+
+vespalib::string
+BinaryView::Value::toString() const
+{
+    SimpleBuffer buf;
+    JsonFormat::encode(*this, buf, false);
+    return buf.get().make_string();
+}
+
+Inspector &
+BinaryView::Value::operator[](size_t idx) const
+{
+    if (idx < entries()) {
+        return child(idx);
+    }
+    return *NixValue::invalid();
+}
+
+Inspector &
+BinaryView::Value::operator[](Symbol sym) const
+{
+    for (size_t i = 0; i < fields(); ++i) {
+        if (child(i)._symbol == sym.getValue()) {
+            return child(i);
+        }
+    }
+    return *NixValue::invalid();
+}
+
+Inspector &
+BinaryView::Value::operator[](Memory name) const
+{
+    for (size_t i = 0; i < fields(); ++i) {
+        if (_view->symbol_name(Symbol(child(i)._symbol)) == name) {
+            return child(i);
+        }
+    }
+    return *NixValue::invalid();
+}
+
+} // namespace vespalib::slime
@@ -0,0 +1,106 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "inspector.h"
+#include <vector>
+
+namespace vespalib { class InputReader; }
+
+namespace vespalib::slime {
+
+/**
+ * Read-only view of a value encoded with BinaryFormat, inspected
+ * directly in the encoded buffer instead of being decoded into a
+ * Slime object.
+ *
+ * On first access, a single pass over the buffer builds a flat
+ * offset index with one entry per value, where the children of each
+ * array or object are stored next to each other. Strings and data
+ * refer directly into the buffer, and no symbol table is built;
+ * objects map from symbols to names using the symbol table found at
+ * the start of the buffer. This makes it cheap to look at or copy
+ * (using inject) a few parts of a large encoded value.
+ *
+ * The encoded buffer must outlive the view and all inspectors
+ * obtained from it. Symbols passed to and from inspectors are the
+ * ones used in the encoded buffer. A buffer that fails to decode
+ * gives an invalid root inspector. The index is built without
+ * locking, so a view should not be shared between threads before it
+ * has been accessed once.
+ **/
+class BinaryView
+{
+public:
+    class Value;
+
+private:
+    Memory                     _data;
+    mutable std::vector<Memory> _symbols;
+    mutable std::vector<Value>  _index;
+    mutable size_t             _decoded_bytes;
+    mutable bool               _indexed;
+
+    bool build_index() const;
+    bool build_value(InputReader &in, size_t idx) const;
+
+public:
+    explicit BinaryView(Memory data);
+    BinaryView(const BinaryView &) = delete;
+    BinaryView &operator=(const BinaryView &) = delete;
+    ~BinaryView();
+
+    /**
+     * Obtain the root inspector, building the index if needed.
+     **/
+    Inspector &get() const;
+
+    /**
+     * Number of bytes making up the encoded value, or 0 if the
+     * buffer could not be decoded. Like the return value of
+     * BinaryFormat::decode.
+     **/
+    size_t decoded_bytes() const;
+
+    Memory symbol_name(Symbol symbol) const;
+
+    class Value final : public Inspector
+    {
+    private:
+        friend class BinaryView;
+        const BinaryView *_view;
+        uint32_t          _type;
+        uint32_t          _symbol;
+        uint32_t          _size;        // string/data size or number of children
+        uint32_t          _first_child; // index of first child for arrays and objects
+        uint64_t          _value;       // bool/long/double bits or string/data offset
+
+        Value &child(size_t idx) const { return _view->_index[_first_child + idx]; }
+    public:
+        Value() : _view(nullptr), _type(NIX::ID), _symbol(0), _size(0), _first_child(0), _value(0) {}
+
+        bool valid() const override { return true; }
+        Type type() const override;
+        size_t children() const override;
+        size_t entries() const override;
+        size_t fields() const override;
+
+        bool asBool() const override;
+        int64_t asLong() const override;
+        double asDouble() const override;
+        Memory asString() const override;
+        Memory asData() const override;
+
+        void traverse(ArrayTraverser &at) const override;
+        void traverse(ObjectSymbolTraverser &ot) const override;
+        void traverse(ObjectTraverser &ot) const override;
+
+        vespalib::string toString() const override;
+
+        Inspector &operator[](size_t idx) const override;
+        Inspector &operator[](Symbol sym) const override;
+        Inspector &operator[](Memory name) const override;
+    };
+};
+
+} // namespace vespalib::slime
@@ -9,6 +9,9 @@
 #include <cmath>
 #include <sstream>
 #include <cassert>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.data.slime.json_format");
@@ -175,6 +178,33 @@ JsonEncoder<COMPACT>::field(const Memory &symbol_name, const Inspector &inspecto
 
 //-----------------------------------------------------------------------------
 
+// Returns the number of leading characters that are neither a quote,
+// a backslash nor a null byte.
+size_t find_string_special(const char *data, size_t size) {
+    size_t pos = 0;
+#ifdef __SSE2__
+    const __m128i dquote = _mm_set1_epi8('"');
+    const __m128i squote = _mm_set1_epi8('\'');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i zero = _mm_setzero_si128();
+    for (; (pos + 16) <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, dquote), _mm_cmpeq_epi8(chunk, squote)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(chunk, backslash), _mm_cmpeq_epi8(chunk, zero)));
+        int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; pos < size; ++pos) {
+        switch (data[pos]) {
+        case '"': case '\'': case '\\': case '\0': return pos;
+        }
+    }
+    return pos;
+}
+
 struct JsonDecoder {
     InputReader &in;
     char c;
@@ -215,6 +245,17 @@ struct JsonDecoder {
         }
     }
 
+    /**
+     * Append the run of buffered characters needing no special
+     * handling inside a string directly, instead of one at a time.
+     **/
+    void skipPlainChars(vespalib::string &str) {
+        Memory buf = in.peek();
+        size_t n = find_string_special(buf.data, buf.size);
+        str.append(buf.data, n);
+        in.skip(n);
+    }
+
     uint32_t readHexValue(uint32_t len);
     uint32_t dequoteUtf16();
     void readString(vespalib::string &str);
@@ -346,6 +387,7 @@ JsonDecoder::readString(vespalib::string &str)
             return;
         default:
             str.push_back(c);
+            skipPlainChars(str);
             next();
             break;
         }
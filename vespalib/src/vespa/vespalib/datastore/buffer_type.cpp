@@ -35,7 +35,8 @@ BufferTypeBase::BufferTypeBase(uint32_t arraySize,
       _holdBuffers(0),
       _activeUsedElems(0),
       _holdUsedElems(0),
-      _lastUsedElems(nullptr)
+      _lastUsedElems(nullptr),
+      _memoryAllocator(nullptr)
 {
 }
 
@@ -105,6 +106,12 @@ BufferTypeBase::onFree(size_t usedElems)
     _holdUsedElems -= usedElems;
 }
 
+const alloc::MemoryAllocator*
+BufferTypeBase::get_memory_allocator() const
+{
+    return _memoryAllocator;
+}
+
 void
 BufferTypeBase::clampMaxArrays(uint32_t maxArrays)
 {
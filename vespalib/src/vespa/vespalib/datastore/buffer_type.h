@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <cstddef>
 
+namespace vespalib::alloc { class MemoryAllocator; }
+
 namespace vespalib::datastore {
 
 /**
@@ -28,6 +30,7 @@ protected:
     size_t _activeUsedElems;    // used elements in all but last active buffer
     size_t _holdUsedElems;  // used elements in all held buffers
     const size_t *_lastUsedElems; // used elements in last active buffer
+    const alloc::MemoryAllocator *_memoryAllocator; // nullptr means default memory allocator
 
 public:
     class CleanContext {
@@ -68,6 +71,18 @@ public:
 
     void clampMaxArrays(uint32_t maxArrays);
 
+    /**
+     * Returns the memory allocator used for buffers of this type,
+     * or nullptr if the default memory allocator should be used.
+     */
+    virtual const alloc::MemoryAllocator* get_memory_allocator() const;
+
+    /**
+     * Sets the memory allocator used for new buffers of this type, e.g. to
+     * back them with huge pages. The allocator must outlive the buffers.
+     */
+    void set_memory_allocator(const alloc::MemoryAllocator* allocator) { _memoryAllocator = allocator; }
+
     uint32_t getActiveBuffers() const { return _activeBuffers; }
     size_t getMaxArrays() const { return _maxArrays; }
     uint32_t getNumArraysForNewBuffer() const { return _numArraysForNewBuffer; }
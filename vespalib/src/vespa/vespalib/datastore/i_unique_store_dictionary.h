@@ -42,6 +42,11 @@ public:
     virtual EntryRef find(const EntryComparator& comp) = 0;
     virtual void remove(const EntryComparator& comp, EntryRef ref) = 0;
     virtual void move_entries(ICompactable& compactable) = 0;
+    /*
+     * Call callback for each key in dictionary order, starting after the given key (or with the first key
+     * if the given key is invalid), until the callback returns false.
+     */
+    virtual void foreach_key_after(const EntryComparator& comp, EntryRef key, const std::function<bool(EntryRef)>& callback) const = 0;
     virtual uint32_t get_num_uniques() const = 0;
     virtual vespalib::MemoryUsage get_memory_usage() const = 0;
     virtual void build(vespalib::ConstArrayRef<EntryRef>, vespalib::ConstArrayRef<uint32_t> ref_counts, std::function<void(EntryRef)> hold) = 0;
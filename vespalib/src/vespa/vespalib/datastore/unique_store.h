@@ -24,6 +24,8 @@ class UniqueStoreEnumerator;
 template <typename RefT>
 class UniqueStoreRemapper;
 
+namespace uniquestore { template <typename RefT, typename Allocator> class IncrementalCompactionContext; }
+
 /**
  * Datastore for unique values of type EntryT that is accessed via a
  * 32-bit EntryRef.
@@ -40,9 +42,11 @@ public:
     using Remapper = UniqueStoreRemapper<RefT>;
     using EntryConstRefType = typename Allocator::EntryConstRefType;
 private:
+    using IncrementalCompactionContext = uniquestore::IncrementalCompactionContext<RefT, Allocator>;
     Allocator _allocator;
     DataStoreType &_store;
     std::unique_ptr<IUniqueStoreDictionary> _dict;
+    std::unique_ptr<IncrementalCompactionContext> _compaction;
     using generation_t = vespalib::GenerationHandler::generation_t;
 
 public:
@@ -55,6 +59,15 @@ public:
     EntryConstRefType get(EntryRef ref) const { return _allocator.get(ref); }
     void remove(EntryRef ref);
     std::unique_ptr<Remapper> compact_worst(bool compact_memory, bool compact_address_space);
+    /**
+     * Incremental variant of compact_worst(). The first call starts compaction of the worst buffers,
+     * and each call moves at most max_moves values out of them. The dictionary and all references
+     * keep referring to the old values until every value has been moved. Then the dictionary is
+     * updated to the new values and a remapper is returned: the caller must remap its references
+     * and call done() on the remapper to complete the compaction.
+     */
+    std::unique_ptr<Remapper> compact_worst_step(bool compact_memory, bool compact_address_space, uint32_t max_moves);
+    bool is_compacting() const { return static_cast<bool>(_compaction); }
     vespalib::MemoryUsage getMemoryUsage() const;
     vespalib::MemoryUsage get_values_memory_usage() const { return _store.getMemoryUsage(); }
     vespalib::MemoryUsage get_dictionary_memory_usage() const { return _dict->get_memory_usage(); }
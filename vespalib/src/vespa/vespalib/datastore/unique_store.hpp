@@ -36,7 +36,8 @@ template <typename EntryT, typename RefT, typename Compare, typename Allocator>
 UniqueStore<EntryT, RefT, Compare, Allocator>::UniqueStore(std::unique_ptr<IUniqueStoreDictionary> dict)
     : _allocator(),
       _store(_allocator.get_data_store()),
-      _dict(std::move(dict))
+      _dict(std::move(dict)),
+      _compaction()
 {
 }
 
@@ -158,12 +159,150 @@ public:
     }
 };
 
+/*
+ * Compaction context used by UniqueStore::compact_worst_step(). The values in the buffers being
+ * compacted are copied in bounded steps, following dictionary order, while the dictionary and all
+ * references keep using the old values. Old values are not changed or reused while their buffer is
+ * compacted, and their reference counts stay authoritative until the compaction finishes.
+ */
+template <typename RefT, typename Allocator>
+class IncrementalCompactionContext : public UniqueStoreRemapper<RefT>, public ICompactable {
+private:
+    using UniqueStoreRemapper<RefT>::_compacting_buffer;
+    using UniqueStoreRemapper<RefT>::_mapping;
+    DataStoreBase &_dataStore;
+    IUniqueStoreDictionary &_dict;
+    Allocator &_allocator;
+    std::vector<uint32_t> _bufferIdsToCompact;
+    EntryRef _lastMoved;
+
+    EntryRef *mappedRef(EntryRef ref) {
+        RefT iRef(ref);
+        if (!_compacting_buffer[iRef.bufferId()]) {
+            return nullptr;
+        }
+        assert(iRef.offset() < _mapping[iRef.bufferId()].size());
+        return &_mapping[iRef.bufferId()][iRef.offset()];
+    }
+
+    // Used when updating the dictionary, the reference count of the old value is the current one.
+    EntryRef move(EntryRef oldRef) override {
+        EntryRef *mapped = mappedRef(oldRef);
+        if (mapped == nullptr) {
+            return oldRef;
+        }
+        if (!mapped->valid()) {
+            *mapped = _allocator.move(oldRef);
+        } else {
+            _allocator.get_wrapped(*mapped).set_ref_count(_allocator.get_wrapped(oldRef).get_ref_count());
+        }
+        return *mapped;
+    }
+
+    // Values removed after being copied are no longer in the dictionary, drop their copies.
+    void dropUnusedCopies() {
+        for (uint32_t bufferId : _bufferIdsToCompact) {
+            auto &mapping = _mapping[bufferId];
+            for (size_t offset = 0; offset < mapping.size(); ++offset) {
+                EntryRef &mapped = mapping[offset];
+                if (mapped.valid() && _allocator.get_wrapped(RefT(offset, bufferId)).get_ref_count() == 0u) {
+                    _allocator.hold(mapped);
+                    mapped = EntryRef();
+                }
+            }
+        }
+    }
+
+public:
+    IncrementalCompactionContext(DataStoreBase &dataStore,
+                                 IUniqueStoreDictionary &dict,
+                                 Allocator &allocator,
+                                 std::vector<uint32_t> bufferIdsToCompact)
+        : UniqueStoreRemapper<RefT>(),
+          ICompactable(),
+          _dataStore(dataStore),
+          _dict(dict),
+          _allocator(allocator),
+          _bufferIdsToCompact(std::move(bufferIdsToCompact)),
+          _lastMoved()
+    {
+        _compacting_buffer.resize(RefT::numBuffers());
+        _mapping.resize(RefT::numBuffers());
+        for (const auto bufferId : _bufferIdsToCompact) {
+            BufferState &state = _dataStore.getBufferState(bufferId);
+            _compacting_buffer[bufferId] = true;
+            _mapping[bufferId].resize(state.size());
+        }
+    }
+
+    /*
+     * Copy at most maxMoves values. Returns true when all values have been copied.
+     */
+    bool step(const EntryComparator &comp, uint32_t maxMoves) {
+        uint32_t moves = 0;
+        bool done = true;
+        _dict.foreach_key_after(comp, _lastMoved, [&](EntryRef ref) {
+            EntryRef *mapped = mappedRef(ref);
+            if (mapped == nullptr) {
+                return true;
+            }
+            if (!mapped->valid()) {
+                *mapped = _allocator.move(ref);
+                ++moves;
+            }
+            // The old value stays readable until the compaction is done, and is a safe resume position.
+            _lastMoved = ref;
+            if (moves >= maxMoves) {
+                done = false;
+                return false;
+            }
+            return true;
+        });
+        return done;
+    }
+
+    /*
+     * Update the dictionary to refer to the new values.
+     */
+    void finish() {
+        dropUnusedCopies();
+        _dict.move_entries(*this);
+    }
+
+    void done() override {
+        _dataStore.finishCompact(_bufferIdsToCompact);
+        _bufferIdsToCompact.clear();
+    }
+    ~IncrementalCompactionContext() override = default;
+};
+
+}
+
+template <typename EntryT, typename RefT, typename Compare, typename Allocator>
+std::unique_ptr<typename UniqueStore<EntryT, RefT, Compare, Allocator>::Remapper>
+UniqueStore<EntryT, RefT, Compare, Allocator>::compact_worst_step(bool compact_memory, bool compact_address_space, uint32_t max_moves)
+{
+    if (!_compaction) {
+        std::vector<uint32_t> bufferIdsToCompact = _store.startCompactWorstBuffers(compact_memory, compact_address_space);
+        if (bufferIdsToCompact.empty()) {
+            return std::unique_ptr<Remapper>();
+        }
+        _compaction = std::make_unique<IncrementalCompactionContext>(_store, *_dict, _allocator, std::move(bufferIdsToCompact));
+    }
+    EntryType unused{};
+    Compare comp(_store, unused);
+    if (!_compaction->step(comp, max_moves)) {
+        return std::unique_ptr<Remapper>();
+    }
+    _compaction->finish();
+    return std::move(_compaction);
 }
 
 template <typename EntryT, typename RefT, typename Compare, typename Allocator>
 std::unique_ptr<typename UniqueStore<EntryT, RefT, Compare, Allocator>::Remapper>
 UniqueStore<EntryT, RefT, Compare, Allocator>::compact_worst(bool compact_memory, bool compact_address_space)
 {
+    assert(!_compaction);
     std::vector<uint32_t> bufferIdsToCompact = _store.startCompactWorstBuffers(compact_memory, compact_address_space);
     if (bufferIdsToCompact.empty()) {
         return std::unique_ptr<Remapper>();
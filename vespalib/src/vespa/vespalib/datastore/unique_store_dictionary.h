@@ -44,6 +44,7 @@ public:
     EntryRef find(const EntryComparator& comp) override;
     void remove(const EntryComparator& comp, EntryRef ref) override;
     void move_entries(ICompactable& compactable) override;
+    void foreach_key_after(const EntryComparator& comp, EntryRef key, const std::function<bool(EntryRef)>& callback) const override;
     uint32_t get_num_uniques() const override;
     vespalib::MemoryUsage get_memory_usage() const override;
     void build(vespalib::ConstArrayRef<EntryRef>, vespalib::ConstArrayRef<uint32_t> ref_counts, std::function<void(EntryRef)> hold) override;
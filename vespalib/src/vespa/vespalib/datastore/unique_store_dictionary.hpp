@@ -142,6 +142,17 @@ UniqueStoreDictionary<DictionaryT, ParentT>::move_entries(ICompactable &compacta
     }
 }
 
+template <typename DictionaryT, typename ParentT>
+void
+UniqueStoreDictionary<DictionaryT, ParentT>::foreach_key_after(const EntryComparator& comp, EntryRef key,
+                                                               const std::function<bool(EntryRef)>& callback) const
+{
+    auto itr = key.valid() ? _dict.upperBound(key, comp) : _dict.begin();
+    while (itr.valid() && callback(itr.getKey())) {
+        ++itr;
+    }
+}
+
 template <typename DictionaryT, typename ParentT>
 uint32_t
 UniqueStoreDictionary<DictionaryT, ParentT>::get_num_uniques() const
@@ -0,0 +1,58 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fuzzy_matcher.h"
+#include "levenshtein_distance.h"
+#include <vespa/vespalib/text/lowercase.h>
+#include <vespa/vespalib/text/utf8.h>
+#include <algorithm>
+
+namespace vespalib {
+
+FuzzyMatcher::FuzzyMatcher(vespalib::stringref term, uint32_t max_edits, uint32_t prefix_size, bool cased)
+    : _max_edits(max_edits),
+      _prefix_size(prefix_size),
+      _cased(cased),
+      _folded_term_prefix(),
+      _folded_term_suffix(),
+      _prefix()
+{
+    std::vector<uint32_t> folded = fold(term, cased);
+    size_t split = std::min(size_t(prefix_size), folded.size());
+    _folded_term_prefix.assign(folded.begin(), folded.begin() + split);
+    _folded_term_suffix.assign(folded.begin() + split, folded.end());
+    Utf8Writer<vespalib::string> writer(_prefix);
+    for (uint32_t c : _folded_term_prefix) {
+        writer.putChar(c);
+    }
+}
+
+FuzzyMatcher::~FuzzyMatcher() = default;
+
+std::vector<uint32_t>
+FuzzyMatcher::fold(vespalib::stringref str, bool cased)
+{
+    std::vector<uint32_t> folded;
+    folded.reserve(str.size());
+    Utf8Reader r(str);
+    while (r.hasMore()) {
+        uint32_t c = r.getChar();
+        folded.push_back(cased ? c : LowerCase::convert(c));
+    }
+    return folded;
+}
+
+bool
+FuzzyMatcher::isMatch(vespalib::stringref target) const
+{
+    std::vector<uint32_t> folded = fold(target, _cased);
+    if (folded.size() < _folded_term_prefix.size()) {
+        return false;
+    }
+    if ( ! std::equal(_folded_term_prefix.begin(), _folded_term_prefix.end(), folded.begin())) {
+        return false;
+    }
+    folded.erase(folded.begin(), folded.begin() + _folded_term_prefix.size());
+    return LevenshteinDistance::calculate(_folded_term_suffix, folded, _max_edits).has_value();
+}
+
+}
@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Matches strings against a term, allowing up to max_edits insertions,
+ * deletions or substitutions of unicode code points.
+ *
+ * The first prefix_size code points of the term are locked and must
+ * match exactly. A dictionary lookup can use getPrefix() to restrict
+ * the candidate terms to the range starting with the locked prefix,
+ * and then only needs to check the candidates in that range with
+ * isMatch() instead of scanning the whole dictionary.
+ *
+ * Unless cased, both the term and the candidates are lowercased
+ * before comparing.
+ **/
+class FuzzyMatcher {
+private:
+    uint32_t              _max_edits;
+    uint32_t              _prefix_size;
+    bool                  _cased;
+    std::vector<uint32_t> _folded_term_prefix;
+    std::vector<uint32_t> _folded_term_suffix;
+    vespalib::string      _prefix;
+
+public:
+    FuzzyMatcher(vespalib::stringref term, uint32_t max_edits, uint32_t prefix_size, bool cased);
+    ~FuzzyMatcher();
+
+    bool isMatch(vespalib::stringref target) const;
+
+    /**
+     * Returns the locked prefix of the term as UTF-8. It is lowercased
+     * unless the matcher is cased.
+     **/
+    vespalib::stringref getPrefix() const { return _prefix; }
+    uint32_t getMaxEdits() const { return _max_edits; }
+    uint32_t getPrefixSize() const { return _prefix_size; }
+    bool isCased() const { return _cased; }
+
+    static std::vector<uint32_t> fold(vespalib::stringref str, bool cased);
+};
+
+}
@@ -0,0 +1,57 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "levenshtein_distance.h"
+#include <algorithm>
+#include <limits>
+
+namespace vespalib {
+
+std::optional<uint32_t>
+LevenshteinDistance::calculate(const std::vector<uint32_t> &left,
+                               const std::vector<uint32_t> &right,
+                               uint32_t threshold)
+{
+    // Let the shortest string be 'source'.
+    const std::vector<uint32_t> &source = (left.size() <= right.size()) ? left : right;
+    const std::vector<uint32_t> &target = (left.size() <= right.size()) ? right : left;
+    const uint32_t n = source.size();
+    const uint32_t m = target.size();
+    if ((m - n) > threshold) {
+        return std::nullopt;
+    }
+    if (n == 0) {
+        return m;
+    }
+    // Cells outside the band are treated as infinitely far away.
+    const uint32_t inf = std::numeric_limits<uint32_t>::max() - 1;
+    std::vector<uint32_t> prev(n + 1, inf);
+    std::vector<uint32_t> curr(n + 1, inf);
+    for (uint32_t i = 0; i <= std::min(n, threshold); ++i) {
+        prev[i] = i;
+    }
+    for (uint32_t j = 1; j <= m; ++j) {
+        const uint32_t first = (j > threshold) ? (j - threshold) : 1;
+        const uint32_t last = std::min(n, j + threshold);
+        curr[first - 1] = (first == 1 && j <= threshold) ? j : inf;
+        uint32_t row_min = curr[first - 1];
+        for (uint32_t i = first; i <= last; ++i) {
+            const uint32_t cost = (source[i - 1] == target[j - 1]) ? 0 : 1;
+            const uint32_t value = std::min({prev[i - 1] + cost, prev[i] + 1, curr[i - 1] + 1});
+            curr[i] = value;
+            row_min = std::min(row_min, value);
+        }
+        if (last < n) {
+            curr[last + 1] = inf;
+        }
+        if (row_min > threshold) {
+            return std::nullopt;
+        }
+        std::swap(prev, curr);
+    }
+    if (prev[n] > threshold) {
+        return std::nullopt;
+    }
+    return prev[n];
+}
+
+}
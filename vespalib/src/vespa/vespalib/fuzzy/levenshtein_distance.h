@@ -0,0 +1,25 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Calculates the Levenshtein distance between two strings of unicode
+ * code points, giving up as soon as the distance is known to exceed
+ * the given threshold. Only a band of width 2 * threshold + 1 around
+ * the diagonal of the distance matrix is computed, so the cost is
+ * O(threshold * length) rather than O(length^2).
+ **/
+class LevenshteinDistance {
+public:
+    static std::optional<uint32_t> calculate(const std::vector<uint32_t> &left,
+                                             const std::vector<uint32_t> &right,
+                                             uint32_t threshold);
+};
+
+}
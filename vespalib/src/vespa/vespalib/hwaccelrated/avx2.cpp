@@ -10,6 +10,11 @@ Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
 }
 
+size_t
+Avx2Accelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const {
+    return helper::binaryHammingDistance(a, b, sz);
+}
+
 double
 Avx2Accelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const {
     return avx::euclideanDistanceSelectAlignment<float, 32>(a, b, sz);
@@ -20,6 +25,21 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+double
+Avx2Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return helper::squaredEuclideanDistance(a, b, sz);
+}
+
+void
+Avx2Accelrator::convertBFloat16ToFloat(const BFloat16 * src, float * dest, size_t sz) const {
+    helper::convertBFloat16ToFloat(src, dest, sz);
+}
+
+void
+Avx2Accelrator::convertInt8ToFloat(const int8_t * src, float * dest, size_t sz) const {
+    helper::convertInt8ToFloat(src, dest, sz);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
@@ -30,4 +50,14 @@ Avx2Accelrator::or64(size_t offset, const std::vector<std::pair<const void *, bo
     helper::orChunks<32u, 2u>(offset, src, dest);
 }
 
+void
+Avx2Accelrator::andBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::andBlock<32u>(offset, bytes, src, dest);
+}
+
+void
+Avx2Accelrator::orBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::orBlock<32u>(offset, bytes, src, dest);
+}
+
 }
@@ -2,9 +2,34 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
 
 namespace vespalib:: hwaccelrated {
 
+namespace {
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+size_t
+binaryHammingDistanceVPopCnt(const void * a, const void * b, size_t sz) {
+    const char * ac = static_cast<const char *>(a);
+    const char * bc = static_cast<const char *>(b);
+    __m512i sum = _mm512_setzero_si512();
+    size_t i(0);
+    for (; (i + 64) <= sz; i += 64) {
+        __m512i diff = _mm512_xor_si512(_mm512_loadu_si512(ac + i), _mm512_loadu_si512(bc + i));
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(diff));
+    }
+    return _mm512_reduce_add_epi64(sum) + helper::binaryHammingDistance(ac + i, bc + i, sz - i);
+}
+
+}
+
+Avx512Accelrator::Avx512Accelrator()
+    : Avx2Accelrator(),
+      _hasVPopCnt(__builtin_cpu_supports("avx512vpopcntdq"))
+{
+}
+
 float
 Avx512Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -22,6 +47,14 @@ Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
 }
 
+size_t
+Avx512Accelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const {
+    if (_hasVPopCnt) {
+        return binaryHammingDistanceVPopCnt(a, b, sz);
+    }
+    return helper::binaryHammingDistance(a, b, sz);
+}
+
 double
 Avx512Accelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const {
     return avx::euclideanDistanceSelectAlignment<float, 64>(a, b, sz);
@@ -32,6 +65,21 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+double
+Avx512Accelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return helper::squaredEuclideanDistance(a, b, sz);
+}
+
+void
+Avx512Accelrator::convertBFloat16ToFloat(const BFloat16 * src, float * dest, size_t sz) const {
+    helper::convertBFloat16ToFloat(src, dest, sz);
+}
+
+void
+Avx512Accelrator::convertInt8ToFloat(const int8_t * src, float * dest, size_t sz) const {
+    helper::convertInt8ToFloat(src, dest, sz);
+}
+
 void
 Avx512Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<64, 1>(offset, src, dest);
@@ -42,4 +90,14 @@ Avx512Accelrator::or64(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<64, 1>(offset, src, dest);
 }
 
+void
+Avx512Accelrator::andBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::andBlock<64>(offset, bytes, src, dest);
+}
+
+void
+Avx512Accelrator::orBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::orBlock<64>(offset, bytes, src, dest);
+}
+
 }
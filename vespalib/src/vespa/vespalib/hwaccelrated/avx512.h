@@ -11,14 +11,24 @@ namespace vespalib::hwaccelrated {
  */
 class Avx512Accelrator : public Avx2Accelrator
 {
+private:
+    // Not all cpus with avx-512 support the VPOPCNTDQ extension.
+    bool _hasVPopCnt;
 public:
+    Avx512Accelrator();
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
     size_t populationCount(const uint64_t *a, size_t sz) const override;
+    size_t binaryHammingDistance(const void * a, const void * b, size_t sz) const override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const override;
+    void convertBFloat16ToFloat(const BFloat16 * src, float * dest, size_t sz) const override;
+    void convertInt8ToFloat(const int8_t * src, float * dest, size_t sz) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
+    void andBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
+    void orBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
 };
 
 }
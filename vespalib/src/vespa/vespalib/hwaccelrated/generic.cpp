@@ -155,6 +155,11 @@ GenericAccelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
 }
 
+size_t
+GenericAccelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const {
+    return helper::binaryHammingDistance(a, b, sz);
+}
+
 double
 GenericAccelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const {
     return euclideanDistanceT<float, 8>(a, b, sz);
@@ -165,6 +170,21 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return euclideanDistanceT<double, 4>(a, b, sz);
 }
 
+double
+GenericAccelrator::squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const {
+    return helper::squaredEuclideanDistance(a, b, sz);
+}
+
+void
+GenericAccelrator::convertBFloat16ToFloat(const BFloat16 * src, float * dest, size_t sz) const {
+    helper::convertBFloat16ToFloat(src, dest, sz);
+}
+
+void
+GenericAccelrator::convertInt8ToFloat(const int8_t * src, float * dest, size_t sz) const {
+    helper::convertInt8ToFloat(src, dest, sz);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
@@ -175,4 +195,14 @@ GenericAccelrator::or64(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<16,4>(offset, src, dest);
 }
 
+void
+GenericAccelrator::andBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::andBlock<16>(offset, bytes, src, dest);
+}
+
+void
+GenericAccelrator::orBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
+    helper::orBlock<16>(offset, bytes, src, dest);
+}
+
 }
@@ -86,6 +86,41 @@ verifyEuclideanDistance(const IAccelrated & accel) {
     }
 }
 
+void
+verifyCompactCells(const IAccelrated & accel) {
+    const size_t testLength(255);
+    srand(1);
+    std::vector<int8_t> a(testLength);
+    std::vector<int8_t> b(testLength);
+    std::vector<BFloat16> c(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = (rand() % 256) - 128;
+        b[i] = (rand() % 256) - 128;
+        c[i] = float(rand() % 1000) / 7.0f - 50.0f;
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        double sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            double diff = double(a[i]) - double(b[i]);
+            sum += diff * diff;
+        }
+        if (sum != accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j)) {
+            fprintf(stderr, "Accelrator is not computing int8 euclidean distance correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+        std::vector<float> fa(testLength - j);
+        std::vector<float> fc(testLength - j);
+        accel.convertInt8ToFloat(&a[j], &fa[0], testLength - j);
+        accel.convertBFloat16ToFloat(&c[j], &fc[0], testLength - j);
+        for (size_t i(j); i < testLength; i++) {
+            if ((fa[i - j] != float(a[i])) || (fc[i - j] != float(c[i]))) {
+                fprintf(stderr, "Accelrator is not converting compact cells to float correctly.\n");
+                LOG_ABORT("should not be reached");
+            }
+        }
+    }
+}
+
 void
 verifyPopulationCount(const IAccelrated & accel)
 {
@@ -104,6 +139,30 @@ verifyPopulationCount(const IAccelrated & accel)
     }
 }
 
+void
+verifyBinaryHammingDistance(const IAccelrated & accel)
+{
+    const size_t testLength(255);
+    srand(1);
+    std::vector<int8_t> a(testLength);
+    std::vector<int8_t> b(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = (rand() % 256) - 128;
+        b[i] = (rand() % 256) - 128;
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        size_t expected(0);
+        for (size_t i(j); i < testLength; i++) {
+            expected += __builtin_popcount(uint8_t(a[i] ^ b[i]));
+        }
+        size_t hwComputed = accel.binaryHammingDistance(&a[j], &b[j], testLength - j);
+        if (hwComputed != expected) {
+            fprintf(stderr, "Accelrator is not computing binaryHammingDistance correctly. Expected %zu, computed %zu\n", expected, hwComputed);
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
 void
 fill(std::vector<uint64_t> & v, size_t n) {
     v.reserve(n);
@@ -216,6 +275,41 @@ verifyAnd64(const IAccelrated & accel) {
     }
 }
 
+void
+verifyBlock(const IAccelrated & accel, bool isAnd) {
+    constexpr size_t numWords = 64;
+    std::vector<std::vector<uint64_t>> vectors(3);
+    for (auto & v : vectors) {
+        fill(v, numWords);
+    }
+    for (size_t offset = 0; offset < numWords; offset += 8) {
+        for (size_t i = 1; i <= vectors.size(); i++) {
+            std::vector<std::pair<const void *, bool>> vRefs;
+            for (size_t j(0); j < i; j++) {
+                vRefs.emplace_back(&vectors[j][0], shouldInvert(true));
+            }
+            std::vector<uint64_t> expected = optionallyInvert(vRefs[0].second, vectors[0]);
+            for (size_t j = 1; j < i; j++) {
+                if (isAnd) {
+                    simpleAndWith(expected, optionallyInvert(vRefs[j].second, vectors[j]));
+                } else {
+                    simpleOrWith(expected, optionallyInvert(vRefs[j].second, vectors[j]));
+                }
+            }
+            uint64_t dest[numWords] __attribute((aligned(64)));
+            size_t bytes = (numWords - offset) * sizeof(uint64_t);
+            if (isAnd) {
+                accel.andBlock(offset*sizeof(uint64_t), bytes, vRefs, dest);
+            } else {
+                accel.orBlock(offset*sizeof(uint64_t), bytes, vRefs, dest);
+            }
+            if (memcmp(&expected[offset], dest, bytes) != 0) {
+                LOG_ABORT("Accelerator fails to compute correct block AND/OR");
+            }
+        }
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -228,9 +322,13 @@ private:
         verifyDotproduct<int64_t>(accelrated);
         verifyEuclideanDistance<float>(accelrated);
         verifyEuclideanDistance<double>(accelrated);
+        verifyCompactCells(accelrated);
         verifyPopulationCount(accelrated);
+        verifyBinaryHammingDistance(accelrated);
         verifyAnd64(accelrated);
         verifyOr64(accelrated);
+        verifyBlock(accelrated, true);
+        verifyBlock(accelrated, false);
     }
 };
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <memory>
 #include <cstdint>
 #include <vector>
@@ -28,12 +29,22 @@ public:
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
     virtual size_t populationCount(const uint64_t *a, size_t sz) const = 0;
+    // Number of bits that differ between a and b, each being sz bytes
+    virtual size_t binaryHammingDistance(const void * a, const void * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const = 0;
+    // Expand sz compact cells from src into floats in dest
+    virtual void convertBFloat16ToFloat(const BFloat16 * src, float * dest, size_t sz) const = 0;
+    virtual void convertInt8ToFloat(const int8_t * src, float * dest, size_t sz) const = 0;
     // AND 64 bytes from multiple, optionally inverted sources
     virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
     // OR 64 bytes from multiple, optionally inverted sources
     virtual void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
+    // AND a block of bytes (a multiple of 64) from multiple, optionally inverted sources, one source at a time
+    virtual void andBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
+    // OR a block of bytes (a multiple of 64) from multiple, optionally inverted sources, one source at a time
+    virtual void orBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
 
     static const IAccelrated & getAccelerator() __attribute__((noinline));
 };
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/optimized.h>
 #include <cstring>
 
@@ -24,6 +25,24 @@ populationCount(const uint64_t *a, size_t sz) {
     return count;
 }
 
+inline size_t
+binaryHammingDistance(const void * a, const void * b, size_t sz) {
+    const char * ac = static_cast<const char *>(a);
+    const char * bc = static_cast<const char *>(b);
+    size_t count(0);
+    size_t i(0);
+    for (; (i + sizeof(uint64_t)) <= sz; i += sizeof(uint64_t)) {
+        uint64_t aw, bw;
+        memcpy(&aw, ac + i, sizeof(aw));
+        memcpy(&bw, bc + i, sizeof(bw));
+        count += Optimized::popCount(aw ^ bw);
+    }
+    for (; i < sz; i++) {
+        count += Optimized::popCount(uint32_t(uint8_t(ac[i] ^ bc[i])));
+    }
+    return count;
+}
+
 template<typename T>
 T get(const void * base, bool invert) {
     T v;
@@ -74,5 +93,80 @@ orChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src,
     }
 }
 
+template<unsigned ChunkSize>
+void
+andBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
+    typedef uint64_t Chunk __attribute__ ((vector_size (ChunkSize)));
+    static_assert(sizeof(Chunk) == ChunkSize, "sizeof(Chunk) == ChunkSize");
+    const size_t numChunks = bytes / ChunkSize;
+    Chunk * chunk = static_cast<Chunk *>(dest);
+    const Chunk * tmp = cast<Chunk>(src[0].first, offset);
+    for (size_t n=0; n < numChunks; n++) {
+        chunk[n] = get<Chunk>(tmp+n, src[0].second);
+    }
+    for (size_t i(1); i < src.size(); i++) {
+        tmp = cast<Chunk>(src[i].first, offset);
+        if (__builtin_expect(src[i].second, false)) {
+            for (size_t n=0; n < numChunks; n++) {
+                chunk[n] &= get<Chunk>(tmp+n, true);
+            }
+        } else {
+            for (size_t n=0; n < numChunks; n++) {
+                chunk[n] &= get<Chunk>(tmp+n, false);
+            }
+        }
+    }
+}
+
+template<unsigned ChunkSize>
+void
+orBlock(size_t offset, size_t bytes, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
+    typedef uint64_t Chunk __attribute__ ((vector_size (ChunkSize)));
+    static_assert(sizeof(Chunk) == ChunkSize, "sizeof(Chunk) == ChunkSize");
+    const size_t numChunks = bytes / ChunkSize;
+    Chunk * chunk = static_cast<Chunk *>(dest);
+    const Chunk * tmp = cast<Chunk>(src[0].first, offset);
+    for (size_t n=0; n < numChunks; n++) {
+        chunk[n] = get<Chunk>(tmp+n, src[0].second);
+    }
+    for (size_t i(1); i < src.size(); i++) {
+        tmp = cast<Chunk>(src[i].first, offset);
+        if (__builtin_expect(src[i].second, false)) {
+            for (size_t n=0; n < numChunks; n++) {
+                chunk[n] |= get<Chunk>(tmp+n, true);
+            }
+        } else {
+            for (size_t n=0; n < numChunks; n++) {
+                chunk[n] |= get<Chunk>(tmp+n, false);
+            }
+        }
+    }
+}
+
+inline double
+squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) {
+    int64_t sum(0);
+    for (size_t i(0); i < sz; i++) {
+        int32_t diff = int32_t(a[i]) - int32_t(b[i]);
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+inline void
+convertBFloat16ToFloat(const BFloat16 * src, float * dest, size_t sz) {
+    for (size_t i(0); i < sz; i++) {
+        uint32_t value = uint32_t(src[i].get_bits()) << 16;
+        memcpy(dest + i, &value, sizeof(float));
+    }
+}
+
+inline void
+convertInt8ToFloat(const int8_t * src, float * dest, size_t sz) {
+    for (size_t i(0); i < sz; i++) {
+        dest[i] = src[i];
+    }
+}
+
 }
 }
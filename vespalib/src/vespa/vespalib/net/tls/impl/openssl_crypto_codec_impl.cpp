@@ -406,6 +406,7 @@ EncodeResult OpenSslCryptoCodecImpl::encode(const char* plaintext, size_t plaint
             return encode_failed();
         }
         bytes_consumed = static_cast<size_t>(consumed);
+        ConnectionStatistics::get(_mode == Mode::Server).inc_encoded_tls_record(bytes_consumed);
     }
     const int produced = BIO_pending(_output_bio);
     return encoded_bytes(bytes_consumed, static_cast<size_t>(produced));
@@ -424,6 +425,9 @@ DecodeResult OpenSslCryptoCodecImpl::decode(const char* ciphertext, size_t ciphe
     const int input_pending_before = BIO_pending(_input_bio);
     auto produce_res = drain_and_produce_plaintext_from_ssl(plaintext, static_cast<int>(plaintext_size));
     const int input_pending_after = BIO_pending(_input_bio);
+    if (produce_res.bytes_produced > 0) {
+        ConnectionStatistics::get(_mode == Mode::Server).inc_decoded_tls_bytes(produce_res.bytes_produced);
+    }
 
     LOG_ASSERT(input_pending_before >= input_pending_after);
     const int consumed = input_pending_before - input_pending_after;
@@ -222,6 +222,9 @@ OpenSslTlsContextImpl::OpenSslTlsContextImpl(
     } else {
         set_accepted_cipher_suites(modern_iana_cipher_suites());
     }
+    if (!ts_opts.alpn_protocols().empty()) {
+        set_alpn_protocols(ts_opts.alpn_protocols());
+    }
 }
 
 OpenSslTlsContextImpl::~OpenSslTlsContextImpl() {
@@ -515,4 +518,21 @@ void OpenSslTlsContextImpl::set_accepted_cipher_suites(const std::vector<vespali
     }
 }
 
+void OpenSslTlsContextImpl::set_alpn_protocols(const std::vector<vespalib::string>& protocols) {
+    // Wire format is a sequence of length-prefixed protocol names
+    vespalib::string wire_protocols;
+    for (const auto& protocol : protocols) {
+        if (protocol.empty() || protocol.size() > 255) {
+            throw CryptoException("Invalid ALPN protocol name: '" + protocol + "'");
+        }
+        wire_protocols += static_cast<char>(protocol.size());
+        wire_protocols += protocol;
+    }
+    // Note: returns 0 on success, unlike most other OpenSSL functions
+    if (::SSL_CTX_set_alpn_protos(_ctx.get(), reinterpret_cast<const unsigned char*>(wire_protocols.data()),
+                                  wire_protocols.size()) != 0) {
+        throw CryptoException("SSL_CTX_set_alpn_protos failed");
+    }
+}
+
 }
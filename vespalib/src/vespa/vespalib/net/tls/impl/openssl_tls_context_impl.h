@@ -46,6 +46,8 @@ private:
     void enforce_peer_certificate_verification();
     void set_ssl_ctx_self_reference();
     void set_accepted_cipher_suites(const std::vector<vespalib::string>& ciphers);
+    // Only affects client connections; servers do not select application protocols.
+    void set_alpn_protocols(const std::vector<vespalib::string>& protocols);
 
     bool verify_trusted_certificate(::X509_STORE_CTX* store_ctx, const SocketAddress& peer_address);
 
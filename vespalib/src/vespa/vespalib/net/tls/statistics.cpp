@@ -16,6 +16,9 @@ ConnectionStatistics::Snapshot ConnectionStatistics::snapshot() const noexcept {
     s.failed_tls_handshakes      = failed_tls_handshakes.load(std::memory_order_relaxed);
     s.invalid_peer_credentials   = invalid_peer_credentials.load(std::memory_order_relaxed);
     s.broken_tls_connections     = broken_tls_connections.load(std::memory_order_relaxed);
+    s.encoded_tls_records        = encoded_tls_records.load(std::memory_order_relaxed);
+    s.encoded_tls_bytes          = encoded_tls_bytes.load(std::memory_order_relaxed);
+    s.decoded_tls_bytes          = decoded_tls_bytes.load(std::memory_order_relaxed);
     return s;
 }
 
@@ -26,6 +29,9 @@ ConnectionStatistics::Snapshot ConnectionStatistics::Snapshot::subtract(const Sn
     s.failed_tls_handshakes    = failed_tls_handshakes    - rhs.failed_tls_handshakes;
     s.invalid_peer_credentials = invalid_peer_credentials - rhs.invalid_peer_credentials;
     s.broken_tls_connections   = broken_tls_connections   - rhs.broken_tls_connections;
+    s.encoded_tls_records      = encoded_tls_records      - rhs.encoded_tls_records;
+    s.encoded_tls_bytes        = encoded_tls_bytes        - rhs.encoded_tls_bytes;
+    s.decoded_tls_bytes        = decoded_tls_bytes        - rhs.decoded_tls_bytes;
     return s;
 }
 
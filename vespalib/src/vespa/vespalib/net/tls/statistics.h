@@ -31,6 +31,12 @@ struct ConnectionStatistics {
     std::atomic<uint64_t> invalid_peer_credentials = 0;
     // Number of connections broken due to errors during TLS encoding or decoding
     std::atomic<uint64_t> broken_tls_connections   = 0;
+    // Number of TLS records encoded, and the plaintext bytes they carried.
+    // Many small records per byte means the peer is not batching its writes.
+    std::atomic<uint64_t> encoded_tls_records      = 0;
+    std::atomic<uint64_t> encoded_tls_bytes        = 0;
+    // Number of plaintext bytes decoded from received TLS records
+    std::atomic<uint64_t> decoded_tls_bytes        = 0;
 
     void inc_insecure_connections() noexcept {
         insecure_connections.fetch_add(1, std::memory_order_relaxed);
@@ -47,6 +53,13 @@ struct ConnectionStatistics {
     void inc_broken_tls_connections() noexcept {
         broken_tls_connections.fetch_add(1, std::memory_order_relaxed);
     }
+    void inc_encoded_tls_record(uint64_t plaintext_bytes) noexcept {
+        encoded_tls_records.fetch_add(1, std::memory_order_relaxed);
+        encoded_tls_bytes.fetch_add(plaintext_bytes, std::memory_order_relaxed);
+    }
+    void inc_decoded_tls_bytes(uint64_t plaintext_bytes) noexcept {
+        decoded_tls_bytes.fetch_add(plaintext_bytes, std::memory_order_relaxed);
+    }
 
     struct Snapshot {
         uint64_t insecure_connections     = 0;
@@ -54,6 +67,9 @@ struct ConnectionStatistics {
         uint64_t failed_tls_handshakes    = 0;
         uint64_t invalid_peer_credentials = 0;
         uint64_t broken_tls_connections   = 0;
+        uint64_t encoded_tls_records      = 0;
+        uint64_t encoded_tls_bytes        = 0;
+        uint64_t decoded_tls_bytes        = 0;
 
         Snapshot subtract(const Snapshot& rhs) const noexcept;
     };
@@ -12,7 +12,8 @@ TransportSecurityOptions::TransportSecurityOptions(Params params)
       _private_key_pem(std::move(params._private_key_pem)),
       _authorized_peers(std::move(params._authorized_peers)),
       _accepted_ciphers(std::move(params._accepted_ciphers)),
-      _disable_hostname_validation(params._disable_hostname_validation)
+      _disable_hostname_validation(params._disable_hostname_validation),
+      _alpn_protocols(std::move(params._alpn_protocols))
 {
 }
 
@@ -20,18 +21,20 @@ TransportSecurityOptions::TransportSecurityOptions(vespalib::string ca_certs_pem
                                                    vespalib::string cert_chain_pem,
                                                    vespalib::string private_key_pem,
                                                    AuthorizedPeers authorized_peers,
-                                                   bool disable_hostname_validation)
+                                                   bool disable_hostname_validation,
+                                                   std::vector<vespalib::string> alpn_protocols)
     : _ca_certs_pem(std::move(ca_certs_pem)),
       _cert_chain_pem(std::move(cert_chain_pem)),
       _private_key_pem(std::move(private_key_pem)),
       _authorized_peers(std::move(authorized_peers)),
-      _disable_hostname_validation(disable_hostname_validation)
+      _disable_hostname_validation(disable_hostname_validation),
+      _alpn_protocols(std::move(alpn_protocols))
 {
 }
 
 TransportSecurityOptions TransportSecurityOptions::copy_without_private_key() const {
     return TransportSecurityOptions(_ca_certs_pem, _cert_chain_pem, "",
-                                    _authorized_peers, _disable_hostname_validation);
+                                    _authorized_peers, _disable_hostname_validation, _alpn_protocols);
 }
 
 void secure_memzero(void* buf, size_t size) noexcept {
@@ -44,7 +47,8 @@ TransportSecurityOptions::Params::Params()
       _private_key_pem(),
       _authorized_peers(),
       _accepted_ciphers(),
-      _disable_hostname_validation(false)
+      _disable_hostname_validation(false),
+      _alpn_protocols()
 {
 }
 
@@ -15,6 +15,7 @@ class TransportSecurityOptions {
     AuthorizedPeers  _authorized_peers;
     std::vector<vespalib::string> _accepted_ciphers;
     bool _disable_hostname_validation;
+    std::vector<vespalib::string> _alpn_protocols;
 public:
     struct Params {
         vespalib::string _ca_certs_pem;
@@ -23,6 +24,7 @@ public:
         AuthorizedPeers  _authorized_peers;
         std::vector<vespalib::string> _accepted_ciphers;
         bool _disable_hostname_validation;
+        std::vector<vespalib::string> _alpn_protocols;
 
         Params();
         ~Params();
@@ -43,6 +45,11 @@ public:
             _disable_hostname_validation = disable;
             return *this;
         }
+        // Application protocols offered by clients, in order of preference (e.g. "h2")
+        Params& alpn_protocols(std::vector<vespalib::string> protocols) {
+            _alpn_protocols = std::move(protocols);
+            return *this;
+        }
     };
 
     explicit TransportSecurityOptions(Params params);
@@ -57,13 +64,15 @@ public:
     TransportSecurityOptions copy_without_private_key() const;
     const std::vector<vespalib::string>& accepted_ciphers() const noexcept { return _accepted_ciphers; }
     bool disable_hostname_validation() const noexcept { return _disable_hostname_validation; }
+    const std::vector<vespalib::string>& alpn_protocols() const noexcept { return _alpn_protocols; }
 
 private:
     TransportSecurityOptions(vespalib::string ca_certs_pem,
                              vespalib::string cert_chain_pem,
                              vespalib::string private_key_pem,
                              AuthorizedPeers authorized_peers,
-                             bool disable_hostname_validation);
+                             bool disable_hostname_validation,
+                             std::vector<vespalib::string> alpn_protocols);
 };
 
 // Zeroes out `size` bytes in `buf` in a way that shall never be optimized
@@ -0,0 +1,296 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "hash_fun.h"
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace vespalib {
+
+/**
+ * Open addressing hash map with the same api as vespalib::hash_map
+ * for the operations it supports.
+ *
+ * Each slot has a control byte that is either empty, deleted or holds
+ * the top 7 bits of the key hash. Lookups probe groups of 16 control
+ * bytes at a time, using SSE2 where available, and only compare keys
+ * for slots whose control byte matches. Keys and values are stored
+ * inline in a single slot array, so a successful lookup usually costs
+ * one control group load and one slot access, compared to following a
+ * bucket chain in hash_map.
+ *
+ * Both keys and values must be default constructible. Iterators and
+ * references are invalidated by insert when the table grows. Erased
+ * slots are marked deleted and are reclaimed by the next rehash.
+ **/
+template <typename K, typename V, typename H = vespalib::hash<K>, typename EQ = std::equal_to<>>
+class swiss_map
+{
+public:
+    using value_type = std::pair<K, V>;
+    using key_type = K;
+    using mapped_type = V;
+    static constexpr size_t GROUP_SIZE = 16;
+
+private:
+    using ctrl_t = int8_t;
+    static constexpr ctrl_t EMPTY = -128;
+    static constexpr ctrl_t DELETED = -2;
+
+    std::vector<ctrl_t>     _ctrl;  // capacity + GROUP_SIZE - 1 bytes, tail mirrors the head
+    std::vector<value_type> _slots;
+    size_t                  _mask;
+    size_t                  _size;
+    size_t                  _deleted;
+    H                       _hasher;
+    EQ                      _equal;
+
+    static bool is_full(ctrl_t c) { return c >= 0; }
+    static uint64_t mix(uint64_t h) { return h * 0x9E3779B97F4A7C15ul; }
+    static size_t h1(uint64_t h) { return h; }
+    static ctrl_t h2(uint64_t h) { return ctrl_t(h >> 57); }
+
+    static uint32_t match_byte(const ctrl_t *group, ctrl_t value) {
+#ifdef __SSE2__
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrl));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_SIZE; ++i) {
+            mask |= uint32_t(group[i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+    static uint32_t match_empty_or_deleted(const ctrl_t *group) {
+#ifdef __SSE2__
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+        return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_SIZE; ++i) {
+            mask |= uint32_t(group[i] < -1) << i;
+        }
+        return mask;
+#endif
+    }
+
+    void set_ctrl(size_t idx, ctrl_t value) {
+        _ctrl[idx] = value;
+        if (idx < GROUP_SIZE - 1) {
+            _ctrl[idx + _mask + 1] = value;
+        }
+    }
+
+    template <typename AltKey>
+    size_t find_index(const AltKey &key, uint64_t hash) const {
+        const ctrl_t tag = h2(hash);
+        size_t pos = h1(hash) & _mask;
+        for (size_t step = GROUP_SIZE; ; step += GROUP_SIZE) {
+            const ctrl_t *group = &_ctrl[pos];
+            for (uint32_t bits = match_byte(group, tag); bits != 0; bits &= (bits - 1)) {
+                size_t idx = (pos + __builtin_ctz(bits)) & _mask;
+                if (_equal(_slots[idx].first, key)) {
+                    return idx;
+                }
+            }
+            if (match_byte(group, EMPTY) != 0) {
+                return npos();
+            }
+            pos = (pos + step) & _mask;
+        }
+    }
+
+    size_t find_free(uint64_t hash) const {
+        size_t pos = h1(hash) & _mask;
+        for (size_t step = GROUP_SIZE; ; step += GROUP_SIZE) {
+            uint32_t bits = match_empty_or_deleted(&_ctrl[pos]);
+            if (bits != 0) {
+                return (pos + __builtin_ctz(bits)) & _mask;
+            }
+            pos = (pos + step) & _mask;
+        }
+    }
+
+    static size_t capacity_for(size_t wanted) {
+        size_t cap = GROUP_SIZE;
+        while ((cap - cap / 8) < wanted) {
+            cap *= 2;
+        }
+        return cap;
+    }
+
+    void init(size_t cap) {
+        _ctrl.assign(cap + GROUP_SIZE - 1, EMPTY);
+        _slots.clear();
+        _slots.resize(cap);
+        _mask = cap - 1;
+        _size = 0;
+        _deleted = 0;
+    }
+
+    void rehash(size_t cap) {
+        std::vector<ctrl_t> old_ctrl;
+        std::vector<value_type> old_slots;
+        old_ctrl.swap(_ctrl);
+        old_slots.swap(_slots);
+        size_t old_cap = _mask + 1;
+        init(cap);
+        for (size_t i = 0; i < old_cap; ++i) {
+            if (is_full(old_ctrl[i])) {
+                uint64_t hash = mix(_hasher(old_slots[i].first));
+                size_t idx = find_free(hash);
+                set_ctrl(idx, h2(hash));
+                _slots[idx] = std::move(old_slots[i]);
+                ++_size;
+            }
+        }
+    }
+
+    template <typename Value>
+    std::pair<size_t, bool> insert_index(Value &&value) {
+        uint64_t hash = mix(_hasher(value.first));
+        size_t idx = find_index(value.first, hash);
+        if (idx != npos()) {
+            return std::make_pair(idx, false);
+        }
+        size_t cap = _mask + 1;
+        if ((_size + _deleted + 1) > (cap - cap / 8)) {
+            // grow when mostly full of live entries, otherwise just purge deleted ones
+            rehash(((_size + 1) * 2 > (cap - cap / 8)) ? (cap * 2) : cap);
+        }
+        idx = find_free(hash);
+        if (_ctrl[idx] == DELETED) {
+            --_deleted;
+        }
+        set_ctrl(idx, h2(hash));
+        _slots[idx] = std::forward<Value>(value);
+        ++_size;
+        return std::make_pair(idx, true);
+    }
+
+    static constexpr size_t npos() { return size_t(-1); }
+
+public:
+    template <typename Map, typename Value>
+    class iterator_base {
+    private:
+        Map   *_map;
+        size_t _idx;
+        void skip() {
+            while ((_idx <= _map->_mask) && ! is_full(_map->_ctrl[_idx])) {
+                ++_idx;
+            }
+        }
+    public:
+        iterator_base(Map *map, size_t idx) : _map(map), _idx(idx) { skip(); }
+        Value &operator*() const { return _map->_slots[_idx]; }
+        Value *operator->() const { return &_map->_slots[_idx]; }
+        iterator_base &operator++() { ++_idx; skip(); return *this; }
+        bool operator==(const iterator_base &rhs) const { return (_idx == rhs._idx); }
+        bool operator!=(const iterator_base &rhs) const { return (_idx != rhs._idx); }
+        size_t index() const { return _idx; }
+    };
+    using iterator = iterator_base<swiss_map, value_type>;
+    using const_iterator = iterator_base<const swiss_map, const value_type>;
+    using insert_result = std::pair<iterator, bool>;
+
+    swiss_map(size_t reserveSize=0) : swiss_map(reserveSize, H(), EQ()) {}
+    swiss_map(size_t reserveSize, H hasher, EQ equality)
+        : _ctrl(), _slots(), _mask(0), _size(0), _deleted(0), _hasher(hasher), _equal(equality)
+    {
+        init(capacity_for(reserveSize));
+    }
+    swiss_map(swiss_map &&) noexcept = default;
+    swiss_map &operator=(swiss_map &&) noexcept = default;
+    swiss_map(const swiss_map &) = default;
+    swiss_map &operator=(const swiss_map &) = default;
+    ~swiss_map() = default;
+
+    iterator begin()                   { return iterator(this, 0); }
+    iterator end()                     { return iterator(this, _mask + 1); }
+    const_iterator begin()       const { return const_iterator(this, 0); }
+    const_iterator end()         const { return const_iterator(this, _mask + 1); }
+    size_t capacity()            const { return _mask + 1; }
+    size_t size()                const { return _size; }
+    bool empty()                 const { return (_size == 0); }
+
+    insert_result insert(const value_type &value) {
+        auto res = insert_index(value);
+        return insert_result(iterator(this, res.first), res.second);
+    }
+    insert_result insert(value_type &&value) {
+        auto res = insert_index(std::move(value));
+        return insert_result(iterator(this, res.first), res.second);
+    }
+    V &operator[](const K &key) {
+        return insert(value_type(key, V())).first->second;
+    }
+
+    template <typename AltKey = K>
+    iterator find(const AltKey &key) {
+        size_t idx = find_index(key, mix(_hasher(key)));
+        return (idx == npos()) ? end() : iterator(this, idx);
+    }
+    template <typename AltKey = K>
+    const_iterator find(const AltKey &key) const {
+        size_t idx = find_index(key, mix(_hasher(key)));
+        return (idx == npos()) ? end() : const_iterator(this, idx);
+    }
+
+    void erase(const K &key) {
+        size_t idx = find_index(key, mix(_hasher(key)));
+        if (idx != npos()) {
+            set_ctrl(idx, DELETED);
+            _slots[idx] = value_type();
+            --_size;
+            ++_deleted;
+        }
+    }
+    void erase(iterator it) { erase(it->first); }
+
+    /// Visits all entries; faster than iterating.
+    template <typename Func>
+    void for_each(Func func) const {
+        for (size_t i = 0; i <= _mask; ++i) {
+            if (is_full(_ctrl[i])) {
+                func(_slots[i]);
+            }
+        }
+    }
+
+    void clear() { init(GROUP_SIZE); }
+    void resize(size_t newSize) {
+        if (newSize > (capacity() - capacity() / 8)) {
+            rehash(capacity_for(newSize));
+        }
+    }
+    void swap(swiss_map &rhs) {
+        std::swap(_ctrl, rhs._ctrl);
+        std::swap(_slots, rhs._slots);
+        std::swap(_mask, rhs._mask);
+        std::swap(_size, rhs._size);
+        std::swap(_deleted, rhs._deleted);
+        std::swap(_hasher, rhs._hasher);
+        std::swap(_equal, rhs._equal);
+    }
+    size_t getMemoryConsumption() const {
+        return sizeof(swiss_map) + _ctrl.capacity() * sizeof(ctrl_t) + _slots.capacity() * sizeof(value_type);
+    }
+    size_t getMemoryUsed() const {
+        return sizeof(swiss_map) + _ctrl.size() * sizeof(ctrl_t) + _size * sizeof(value_type);
+    }
+};
+
+template <typename K, typename V, typename H, typename EQ>
+void swap(swiss_map<K, V, H, EQ> &a, swiss_map<K, V, H, EQ> &b)
+{
+    a.swap(b);
+}
+
+}
@@ -237,8 +237,8 @@ createAutoAllocatorsWithDefault() {
 
 AutoAllocatorsMapWithDefault  _G_availableAutoAllocators = createAutoAllocatorsWithDefault();
 alloc::HeapAllocator _G_heapAllocatorDefault;
-alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(1024);
-alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(4096);
+alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(4096);
+alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(1024);
 alloc::AlignedHeapAllocator _G_512BalignedHeapAllocator(512);
 alloc::MMapAllocator _G_mmapAllocatorDefault;
 
@@ -522,6 +522,12 @@ Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment) noexcept
     return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment), sz);
 }
 
+Alloc
+Alloc::alloc_with_allocator(const MemoryAllocator* allocator) noexcept
+{
+    return Alloc(allocator);
+}
+
 }
 
 }
@@ -141,6 +141,12 @@ public:
     bool operator == (const Array & rhs) const;
     bool operator != (const Array & rhs) const;
 
+    /**
+     * The underlying allocation. New arrays created from it use the same
+     * memory allocator.
+     */
+    const Alloc & getAlloc() const { return _array; }
+
     static Alloc stealAlloc(Array && rhs) {
         rhs._sz = 0;
         return std::move(rhs._array);
@@ -0,0 +1,84 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace vespalib {
+
+/**
+ * Class holding a 16-bit floating-point number ("brain float"). It
+ * has the same exponent range as a 32-bit float, but only 8 bits of
+ * precision (7 bits stored). It is stored as the upper 16 bits of
+ * the corresponding float, which makes conversion to float trivial.
+ * Conversion from float rounds to the nearest representable value
+ * (ties to even), and all arithmetic is done by converting to float.
+ **/
+class BFloat16 {
+private:
+    uint16_t _bits;
+    static constexpr uint16_t quiet_nan_bits = 0x7fc0;
+public:
+    constexpr BFloat16() noexcept : _bits(0) {}
+    BFloat16(float value) noexcept : _bits(float_to_bits(value)) {}
+    BFloat16(const BFloat16 &other) noexcept = default;
+    BFloat16 &operator=(const BFloat16 &other) noexcept = default;
+    BFloat16 &operator=(float value) noexcept {
+        _bits = float_to_bits(value);
+        return *this;
+    }
+
+    operator float() const noexcept { return bits_to_float(_bits); }
+    float to_float() const noexcept { return bits_to_float(_bits); }
+
+    constexpr uint16_t get_bits() const { return _bits; }
+    void assign_bits(uint16_t value) { _bits = value; }
+    static BFloat16 from_bits(uint16_t bits) noexcept {
+        BFloat16 result;
+        result._bits = bits;
+        return result;
+    }
+
+    static float bits_to_float(uint16_t bits) noexcept {
+        uint32_t value = (uint32_t(bits) << 16);
+        float result;
+        memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+
+    static uint16_t float_to_bits(float value) noexcept {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        if ((bits & 0x7fffffff) > 0x7f800000) {
+            return quiet_nan_bits | ((bits >> 16) & 0x8000);
+        }
+        // round to nearest, ties to even
+        bits += 0x7fff + ((bits >> 16) & 1);
+        return (bits >> 16);
+    }
+};
+
+static_assert(sizeof(BFloat16) == sizeof(uint16_t));
+
+}
+
+namespace std {
+template<> class numeric_limits<vespalib::BFloat16> {
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr int digits = 8;
+    static vespalib::BFloat16 min() noexcept { return vespalib::BFloat16::from_bits(0x0080); }
+    static vespalib::BFloat16 lowest() noexcept { return vespalib::BFloat16::from_bits(0xff7f); }
+    static vespalib::BFloat16 max() noexcept { return vespalib::BFloat16::from_bits(0x7f7f); }
+    static vespalib::BFloat16 epsilon() noexcept { return vespalib::BFloat16::from_bits(0x3c00); }
+    static vespalib::BFloat16 infinity() noexcept { return vespalib::BFloat16::from_bits(0x7f80); }
+    static vespalib::BFloat16 quiet_NaN() noexcept { return vespalib::BFloat16::from_bits(0x7fc0); }
+};
+}
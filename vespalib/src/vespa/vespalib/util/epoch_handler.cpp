@@ -0,0 +1,173 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "epoch_handler.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <cassert>
+
+namespace vespalib {
+
+EpochHandler::Guard::Guard(Reader &reader)
+    : _reader(&reader),
+      _generation(reader.enter())
+{
+}
+
+void
+EpochHandler::Guard::cleanup()
+{
+    if (_reader != nullptr) {
+        _reader->leave();
+        _reader = nullptr;
+    }
+}
+
+EpochHandler::Guard::Guard(Guard &&rhs) noexcept
+    : _reader(rhs._reader),
+      _generation(rhs._generation)
+{
+    rhs._reader = nullptr;
+}
+
+EpochHandler::Guard &
+EpochHandler::Guard::operator=(Guard &&rhs) noexcept
+{
+    if (&rhs != this) {
+        cleanup();
+        _reader = rhs._reader;
+        _generation = rhs._generation;
+        rhs._reader = nullptr;
+    }
+    return *this;
+}
+
+EpochHandler::Reader::Reader(const EpochHandler &handler)
+    : _handler(handler),
+      _slot(handler.registerReader()),
+      _depth(0),
+      _generation(0)
+{
+}
+
+EpochHandler::Reader::~Reader()
+{
+    assert(_depth == 0);
+    _handler.unregisterReader(_slot);
+}
+
+EpochHandler::generation_t
+EpochHandler::Reader::enter()
+{
+    if (_depth++ != 0) {
+        return _generation;
+    }
+    generation_t gen = _handler._generation.load(std::memory_order_relaxed);
+    for (;;) {
+        /*
+         * Publish the generation before reading data. Either the writer
+         * sees the published generation when scanning the slots, or it has
+         * bumped the generation, and the reader will retry with the new one.
+         */
+        _slot._generation.store(gen, std::memory_order_seq_cst);
+        generation_t check = _handler._generation.load(std::memory_order_seq_cst);
+        if (check == gen) {
+            break;
+        }
+        gen = check;
+    }
+    _generation = gen;
+    return gen;
+}
+
+EpochHandler::EpochHandler(uint32_t maxReaders)
+    : _generation(0),
+      _firstUsedGeneration(0),
+      _lock(),
+      _slots(std::make_unique<Slot[]>(maxReaders)),
+      _maxReaders(maxReaders),
+      _usedSlots(0)
+{
+}
+
+EpochHandler::~EpochHandler()
+{
+    assert(getGenerationRefCount() == 0);
+}
+
+EpochHandler::Slot &
+EpochHandler::registerReader() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    uint32_t usedSlots = _usedSlots.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < usedSlots; ++i) {
+        if (!_slots[i]._registered) {
+            _slots[i]._registered = true;
+            return _slots[i];
+        }
+    }
+    if (usedSlots >= _maxReaders) {
+        throw IllegalStateException(make_string("Cannot register more than %u epoch handler readers", _maxReaders));
+    }
+    Slot &slot = _slots[usedSlots];
+    slot._registered = true;
+    _usedSlots.store(usedSlots + 1, std::memory_order_seq_cst);
+    return slot;
+}
+
+void
+EpochHandler::unregisterReader(Slot &slot) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    assert(slot._generation.load(std::memory_order_relaxed) == idle);
+    slot._registered = false;
+}
+
+void
+EpochHandler::updateFirstUsedGeneration()
+{
+    generation_t first = getCurrentGeneration();
+    uint32_t usedSlots = _usedSlots.load(std::memory_order_seq_cst);
+    for (uint32_t i = 0; i < usedSlots; ++i) {
+        generation_t gen = _slots[i]._generation.load(std::memory_order_seq_cst);
+        if (gen != idle && static_cast<sgeneration_t>(gen - first) < 0) {
+            first = gen;
+        }
+    }
+    _firstUsedGeneration = first;
+}
+
+void
+EpochHandler::incGeneration()
+{
+    // Must be ordered before the scan of reader slots, see Reader::enter()
+    _generation.store(getNextGeneration(), std::memory_order_seq_cst);
+    updateFirstUsedGeneration();
+}
+
+uint32_t
+EpochHandler::getGenerationRefCount(generation_t gen) const
+{
+    uint32_t ret = 0;
+    uint32_t usedSlots = _usedSlots.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < usedSlots; ++i) {
+        if (_slots[i]._generation.load(std::memory_order_relaxed) == gen) {
+            ++ret;
+        }
+    }
+    return ret;
+}
+
+uint64_t
+EpochHandler::getGenerationRefCount() const
+{
+    uint64_t ret = 0;
+    uint32_t usedSlots = _usedSlots.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < usedSlots; ++i) {
+        if (_slots[i]._generation.load(std::memory_order_relaxed) != idle) {
+            ++ret;
+        }
+    }
+    return ret;
+}
+
+}
@@ -0,0 +1,165 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "generationhandler.h"
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace vespalib {
+
+/**
+ * Alternative to GenerationHandler using epoch based reclamation.
+ *
+ * Each reader thread registers a Reader, owning a slot on a separate
+ * cache line where it publishes the generation it is reading. Taking
+ * a guard only writes to the slot of the calling thread, thus readers
+ * never write to shared cache lines, at the cost of the writer
+ * scanning all reader slots when updating the first used generation.
+ *
+ * The writer side has the same semantics as GenerationHandler, and
+ * getFirstUsedGeneration() can be passed to GenerationHolder and the
+ * trimHoldLists() functions of data stores, btrees and rcu vectors.
+ **/
+class EpochHandler {
+public:
+    using generation_t = GenerationHandler::generation_t;
+    using sgeneration_t = GenerationHandler::sgeneration_t;
+
+private:
+    static constexpr generation_t idle = std::numeric_limits<generation_t>::max();
+
+    struct alignas(64) Slot {
+        std::atomic<generation_t> _generation;
+        bool                      _registered; // protected by _lock
+
+        Slot() noexcept : _generation(idle), _registered(false) { }
+    };
+
+public:
+    class Reader;
+
+    /**
+     * Class that keeps a reference to a generation until destroyed.
+     * Must be destroyed by the thread that took it.
+     **/
+    class Guard {
+    private:
+        Reader *_reader;
+        generation_t _generation;
+        void cleanup();
+    public:
+        Guard() noexcept : _reader(nullptr), _generation(0) { }
+        Guard(Reader &reader);
+        ~Guard() { cleanup(); }
+        Guard(const Guard &) = delete;
+        Guard & operator=(const Guard &) = delete;
+        Guard(Guard &&rhs) noexcept;
+        Guard & operator=(Guard &&rhs) noexcept;
+
+        bool valid() const { return _reader != nullptr; }
+        generation_t getGeneration() const { return _generation; }
+    };
+
+    /**
+     * Registration of a reader thread. Should be created once by each
+     * reader thread and kept while the thread is reading, as
+     * registration takes a lock. A reader is not thread safe, and
+     * guards taken by a thread are nested within each other.
+     **/
+    class Reader {
+    private:
+        friend class Guard;
+        const EpochHandler &_handler;
+        Slot               &_slot;
+        uint32_t            _depth;
+        generation_t        _generation;
+
+        generation_t enter();
+        void leave() {
+            if (--_depth == 0) {
+                _slot._generation.store(idle, std::memory_order_release);
+            }
+        }
+    public:
+        Reader(const EpochHandler &handler);
+        ~Reader();
+        Reader(const Reader &) = delete;
+        Reader & operator=(const Reader &) = delete;
+
+        /**
+         * Take a generation guard on the current generation. A nested
+         * guard gets the generation of the outermost guard.
+         **/
+        Guard takeGuard() { return Guard(*this); }
+    };
+
+private:
+    std::atomic<generation_t>     _generation;
+    generation_t                  _firstUsedGeneration;
+    mutable std::mutex            _lock;
+    std::unique_ptr<Slot[]>       _slots;
+    const uint32_t                _maxReaders;
+    mutable std::atomic<uint32_t> _usedSlots; // high water mark of registered slots
+
+    Slot &registerReader() const;
+    void unregisterReader(Slot &slot) const;
+
+public:
+    /**
+     * Creates a new epoch handler which can have up to maxReaders
+     * readers registered at the same time.
+     **/
+    EpochHandler(uint32_t maxReaders = 256);
+    ~EpochHandler();
+
+    /**
+     * Increases the current generation by 1.
+     * Should be called by the writer thread.
+     **/
+    void incGeneration();
+
+    /**
+     * Update first used generation by scanning the reader slots.
+     * Should be called by the writer thread.
+     */
+    void updateFirstUsedGeneration();
+
+    /**
+     * Returns the first generation guarded by a reader.  It might be too low
+     * if writer hasn't updated first used generation after last reader left.
+     */
+    generation_t getFirstUsedGeneration() const { return _firstUsedGeneration; }
+
+    /**
+     * Returns the current generation.
+     **/
+    generation_t getCurrentGeneration() const { return _generation.load(std::memory_order_relaxed); }
+
+    generation_t getNextGeneration() const { return getCurrentGeneration() + 1; }
+
+    /**
+     * Returns the number of reader threads holding a guard on the given
+     * generation.  Should be called by the writer thread.
+     */
+    uint32_t getGenerationRefCount(generation_t gen) const;
+
+    /**
+     * Returns the number of reader threads holding a generation guard.
+     * Should be called by the writer thread.
+     */
+    uint64_t getGenerationRefCount() const;
+
+    /**
+     * Returns true if we still have readers.  False positives and
+     * negatives are possible if readers come and go while writer
+     * updates generations.
+     */
+    bool hasReaders() const { return getGenerationRefCount() != 0; }
+
+    uint32_t getMaxReaders() const { return _maxReaders; }
+};
+
+}
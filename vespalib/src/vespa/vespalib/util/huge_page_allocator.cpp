@@ -0,0 +1,157 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "huge_page_allocator.h"
+#include "error.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.alloc.huge_page_allocator");
+
+namespace vespalib::alloc {
+
+namespace {
+
+constexpr size_t huge_page_size = MemoryAllocator::HUGEPAGE_SIZE;
+constexpr unsigned long max_numa_nodes = 1024;
+constexpr size_t bits_per_word = 8 * sizeof(unsigned long);
+
+std::atomic<bool> explicit_huge_pages_failure_logged(false);
+
+void *
+mmap_explicit_huge_pages(size_t sz)
+{
+#ifdef __linux__
+    void *buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+    if (buf != MAP_FAILED) {
+        return buf;
+    }
+    if (!explicit_huge_pages_failure_logged.exchange(true)) {
+        LOG(debug, "Failed allocating %zu bytes with explicit huge pages due to '%s'."
+            " Using transparent huge pages instead.", sz, getLastErrorString().c_str());
+    }
+#else
+    (void) sz;
+#endif
+    return nullptr;
+}
+
+void *
+mmap_transparent_huge_pages(size_t sz)
+{
+    // Over allocate to be able to trim the mapping to huge page alignment
+    size_t map_sz = sz + huge_page_size;
+    void *map_buf = mmap(nullptr, map_sz, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+    if (map_buf == MAP_FAILED) {
+        throw OOMException(make_string("Failed mmaping anonymous of size %zu errno(%d)", map_sz, errno));
+    }
+    char *start = static_cast<char *>(map_buf);
+    char *buf = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(start) + huge_page_size - 1) & ~(huge_page_size - 1));
+    char *end = start + map_sz;
+    if (buf != start) {
+        munmap(start, buf - start);
+    }
+    if (buf + sz != end) {
+        munmap(buf + sz, end - (buf + sz));
+    }
+#ifdef __linux__
+    madvise(buf, sz, MADV_HUGEPAGE);
+#endif
+    return buf;
+}
+
+}
+
+HugePageAllocator::HugePageAllocator(NumaPolicy numa_policy, uint32_t numa_node)
+    : _numa_policy(numa_policy),
+      _numa_node(numa_node)
+{
+    if (_numa_policy == NumaPolicy::BIND && _numa_node >= max_numa_nodes) {
+        throw IllegalArgumentException(make_string("NUMA node %u is out of range", _numa_node));
+    }
+}
+
+HugePageAllocator::~HugePageAllocator() = default;
+
+void
+HugePageAllocator::apply_numa_policy(void *buf, size_t sz) const
+{
+#ifdef __linux__
+    if (_numa_policy == NumaPolicy::DEFAULT) {
+        return;
+    }
+    unsigned long mask[max_numa_nodes / bits_per_word] = {};
+    int mode = MPOL_BIND;
+    if (_numa_policy == NumaPolicy::INTERLEAVE) {
+        if (syscall(SYS_get_mempolicy, nullptr, mask, max_numa_nodes, nullptr, MPOL_F_MEMS_ALLOWED) != 0) {
+            LOG(debug, "Failed getting allowed NUMA nodes due to '%s'", getLastErrorString().c_str());
+            return;
+        }
+        mode = MPOL_INTERLEAVE;
+    } else {
+        mask[_numa_node / bits_per_word] = 1ul << (_numa_node % bits_per_word);
+    }
+    if (syscall(SYS_mbind, buf, sz, mode, mask, max_numa_nodes, 0) != 0) {
+        LOG(debug, "Failed setting NUMA policy for %zu bytes due to '%s'", sz, getLastErrorString().c_str());
+    }
+#else
+    (void) buf;
+    (void) sz;
+#endif
+}
+
+HugePageAllocator::PtrAndSize
+HugePageAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0); // empty allocation
+    }
+    if (sz < huge_page_size) {
+        void *buf = malloc(sz);
+        if (buf == nullptr) {
+            throw OOMException(make_string("Failed allocating %zu bytes from heap", sz));
+        }
+        return PtrAndSize(buf, sz);
+    }
+    sz = roundUpToHugePages(sz);
+    void *buf = mmap_explicit_huge_pages(sz);
+    if (buf == nullptr) {
+        buf = mmap_transparent_huge_pages(sz);
+    }
+    apply_numa_policy(buf, sz);
+    return PtrAndSize(buf, sz);
+}
+
+void
+HugePageAllocator::free(PtrAndSize alloc) const
+{
+    if (alloc.second == 0) {
+        assert(alloc.first == nullptr);
+        return; // empty allocation
+    }
+    assert(alloc.first != nullptr);
+    if (alloc.second < huge_page_size) {
+        ::free(alloc.first);
+        return;
+    }
+    int retval = munmap(alloc.first, roundUpToHugePages(alloc.second));
+    assert(retval == 0);
+    (void) retval;
+}
+
+size_t
+HugePageAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0;
+}
+
+}
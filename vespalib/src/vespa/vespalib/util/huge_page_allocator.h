@@ -0,0 +1,42 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+
+namespace vespalib::alloc {
+
+/*
+ * Class handling large memory allocations backed by 2MB huge pages,
+ * reducing TLB misses when randomly accessing large buffers.
+ *
+ * Explicit huge pages (MAP_HUGETLB) are used when available. Otherwise
+ * the memory is aligned to the huge page size and transparent huge pages
+ * are requested with madvise. Allocations smaller than a huge page are
+ * taken from the heap.
+ *
+ * The NUMA policy decides where the pages of large allocations are placed:
+ * on the node of the thread first touching them (DEFAULT), interleaved over
+ * all allowed nodes (INTERLEAVE) or on the given node (BIND). Placement is
+ * best effort and is silently skipped if the kernel rejects it.
+ */
+class HugePageAllocator : public MemoryAllocator {
+public:
+    enum class NumaPolicy { DEFAULT, INTERLEAVE, BIND };
+private:
+    NumaPolicy _numa_policy;
+    uint32_t   _numa_node;
+
+    void apply_numa_policy(void *buf, size_t sz) const;
+public:
+    HugePageAllocator(NumaPolicy numa_policy = NumaPolicy::DEFAULT, uint32_t numa_node = 0);
+    ~HugePageAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const override;
+    size_t resize_inplace(PtrAndSize, size_t) const override;
+
+    NumaPolicy get_numa_policy() const noexcept { return _numa_policy; }
+    uint32_t get_numa_node() const noexcept { return _numa_node; }
+};
+
+}
@@ -288,3 +288,205 @@ void fastc_md5sum(const void *s, size_t len, unsigned char *key) {
     MD5_Final(key, &m5);
 }
 
+
+/*
+ * Multi-buffer MD5: MD5_LANES independent messages are hashed in lock-step,
+ * one message per lane of a vector, so that each step of the transformation
+ * is a single vector operation for all lanes. The vector type is expressed
+ * using the GCC vector extension, which lets the compiler use the widest
+ * vector unit enabled for the build (SSE2, AVX2, NEON) and fall back to
+ * scalar code otherwise. This pays off for the many short messages typical
+ * of document ids, where each message only needs one or two blocks.
+ */
+#define MD5_LANES 8
+
+typedef unsigned int MD5_vu32 __attribute__((vector_size(MD5_LANES * sizeof(unsigned int))));
+
+typedef struct {
+    const unsigned char *data;   /* start of the complete blocks taken directly from input */
+    unsigned long full_blocks;   /* number of complete blocks in input */
+    unsigned long blocks;        /* total number of blocks, including padding */
+    unsigned char tail[128];     /* remaining input with padding and bit length */
+} MD5_LANE;
+
+static void lane_init(MD5_LANE *lane, const void *s, size_t len) {
+    unsigned long rest = len & 0x3f;
+    unsigned long tail_size = (rest < 56) ? 64 : 128;
+    size_t bits = len << 3;
+    int i;
+
+    lane->data = (const unsigned char *) s;
+    lane->full_blocks = len >> 6;
+    lane->blocks = lane->full_blocks + (tail_size >> 6);
+    if (rest > 0) {
+        memcpy(lane->tail, lane->data + (len - rest), rest);
+    }
+    lane->tail[rest] = 0x80;
+    memset(&lane->tail[rest + 1], 0, tail_size - rest - 1);
+    for (i = 0; i < 8; ++i) {
+        lane->tail[tail_size - 8 + i] = (unsigned char)(bits >> (8 * i));
+    }
+}
+
+static const unsigned char *lane_block(const MD5_LANE *lane, unsigned long n) {
+    static const unsigned char zero_block[64] = { 0 };
+    if (n < lane->full_blocks) {
+        return lane->data + (n << 6);
+    }
+    if (n < lane->blocks) {
+        return lane->tail + ((n - lane->full_blocks) << 6);
+    }
+    return zero_block;
+}
+
+#undef GET
+#define GET(n) (x[(n)])
+
+static void body_multi(MD5_vu32 state[4], const MD5_LANE *lanes, unsigned long blocks) {
+    MD5_vu32 a, b, c, d;
+    MD5_vu32 saved_a, saved_b, saved_c, saved_d;
+    MD5_vu32 x[16];
+    MD5_vu32 active;
+    unsigned long n;
+    int i, j;
+
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+
+    for (n = 0; n < blocks; ++n) {
+        for (i = 0; i < MD5_LANES; ++i) {
+            const unsigned char *ptr = lane_block(&lanes[i], n);
+            for (j = 0; j < 16; ++j) {
+                x[j][i] = (MD5_u32plus)ptr[j * 4] |
+                          ((MD5_u32plus)ptr[j * 4 + 1] << 8) |
+                          ((MD5_u32plus)ptr[j * 4 + 2] << 16) |
+                          ((MD5_u32plus)ptr[j * 4 + 3] << 24);
+            }
+            active[i] = (n < lanes[i].blocks) ? 0xffffffff : 0;
+        }
+
+        saved_a = a;
+        saved_b = b;
+        saved_c = c;
+        saved_d = d;
+
+/* Round 1 */
+        STEP(F, a, b, c, d, GET(0), 0xd76aa478, 7)
+        STEP(F, d, a, b, c, GET(1), 0xe8c7b756, 12)
+        STEP(F, c, d, a, b, GET(2), 0x242070db, 17)
+        STEP(F, b, c, d, a, GET(3), 0xc1bdceee, 22)
+        STEP(F, a, b, c, d, GET(4), 0xf57c0faf, 7)
+        STEP(F, d, a, b, c, GET(5), 0x4787c62a, 12)
+        STEP(F, c, d, a, b, GET(6), 0xa8304613, 17)
+        STEP(F, b, c, d, a, GET(7), 0xfd469501, 22)
+        STEP(F, a, b, c, d, GET(8), 0x698098d8, 7)
+        STEP(F, d, a, b, c, GET(9), 0x8b44f7af, 12)
+        STEP(F, c, d, a, b, GET(10), 0xffff5bb1, 17)
+        STEP(F, b, c, d, a, GET(11), 0x895cd7be, 22)
+        STEP(F, a, b, c, d, GET(12), 0x6b901122, 7)
+        STEP(F, d, a, b, c, GET(13), 0xfd987193, 12)
+        STEP(F, c, d, a, b, GET(14), 0xa679438e, 17)
+        STEP(F, b, c, d, a, GET(15), 0x49b40821, 22)
+
+/* Round 2 */
+        STEP(G, a, b, c, d, GET(1), 0xf61e2562, 5)
+        STEP(G, d, a, b, c, GET(6), 0xc040b340, 9)
+        STEP(G, c, d, a, b, GET(11), 0x265e5a51, 14)
+        STEP(G, b, c, d, a, GET(0), 0xe9b6c7aa, 20)
+        STEP(G, a, b, c, d, GET(5), 0xd62f105d, 5)
+        STEP(G, d, a, b, c, GET(10), 0x02441453, 9)
+        STEP(G, c, d, a, b, GET(15), 0xd8a1e681, 14)
+        STEP(G, b, c, d, a, GET(4), 0xe7d3fbc8, 20)
+        STEP(G, a, b, c, d, GET(9), 0x21e1cde6, 5)
+        STEP(G, d, a, b, c, GET(14), 0xc33707d6, 9)
+        STEP(G, c, d, a, b, GET(3), 0xf4d50d87, 14)
+        STEP(G, b, c, d, a, GET(8), 0x455a14ed, 20)
+        STEP(G, a, b, c, d, GET(13), 0xa9e3e905, 5)
+        STEP(G, d, a, b, c, GET(2), 0xfcefa3f8, 9)
+        STEP(G, c, d, a, b, GET(7), 0x676f02d9, 14)
+        STEP(G, b, c, d, a, GET(12), 0x8d2a4c8a, 20)
+
+/* Round 3 */
+        STEP(H, a, b, c, d, GET(5), 0xfffa3942, 4)
+        STEP(H2, d, a, b, c, GET(8), 0x8771f681, 11)
+        STEP(H, c, d, a, b, GET(11), 0x6d9d6122, 16)
+        STEP(H2, b, c, d, a, GET(14), 0xfde5380c, 23)
+        STEP(H, a, b, c, d, GET(1), 0xa4beea44, 4)
+        STEP(H2, d, a, b, c, GET(4), 0x4bdecfa9, 11)
+        STEP(H, c, d, a, b, GET(7), 0xf6bb4b60, 16)
+        STEP(H2, b, c, d, a, GET(10), 0xbebfbc70, 23)
+        STEP(H, a, b, c, d, GET(13), 0x289b7ec6, 4)
+        STEP(H2, d, a, b, c, GET(0), 0xeaa127fa, 11)
+        STEP(H, c, d, a, b, GET(3), 0xd4ef3085, 16)
+        STEP(H2, b, c, d, a, GET(6), 0x04881d05, 23)
+        STEP(H, a, b, c, d, GET(9), 0xd9d4d039, 4)
+        STEP(H2, d, a, b, c, GET(12), 0xe6db99e5, 11)
+        STEP(H, c, d, a, b, GET(15), 0x1fa27cf8, 16)
+        STEP(H2, b, c, d, a, GET(2), 0xc4ac5665, 23)
+
+/* Round 4 */
+        STEP(I, a, b, c, d, GET(0), 0xf4292244, 6)
+        STEP(I, d, a, b, c, GET(7), 0x432aff97, 10)
+        STEP(I, c, d, a, b, GET(14), 0xab9423a7, 15)
+        STEP(I, b, c, d, a, GET(5), 0xfc93a039, 21)
+        STEP(I, a, b, c, d, GET(12), 0x655b59c3, 6)
+        STEP(I, d, a, b, c, GET(3), 0x8f0ccc92, 10)
+        STEP(I, c, d, a, b, GET(10), 0xffeff47d, 15)
+        STEP(I, b, c, d, a, GET(1), 0x85845dd1, 21)
+        STEP(I, a, b, c, d, GET(8), 0x6fa87e4f, 6)
+        STEP(I, d, a, b, c, GET(15), 0xfe2ce6e0, 10)
+        STEP(I, c, d, a, b, GET(6), 0xa3014314, 15)
+        STEP(I, b, c, d, a, GET(13), 0x4e0811a1, 21)
+        STEP(I, a, b, c, d, GET(4), 0xf7537e82, 6)
+        STEP(I, d, a, b, c, GET(11), 0xbd3af235, 10)
+        STEP(I, c, d, a, b, GET(2), 0x2ad7d2bb, 15)
+        STEP(I, b, c, d, a, GET(9), 0xeb86d391, 21)
+
+/* Lanes whose message has no more blocks keep their state */
+        a = saved_a + (a & active);
+        b = saved_b + (b & active);
+        c = saved_c + (c & active);
+        d = saved_d + (d & active);
+    }
+
+    state[0] = a;
+    state[1] = b;
+    state[2] = c;
+    state[3] = d;
+}
+
+void fastc_md5sum_multi(const void * const *s, const size_t *len, unsigned char * const *key, size_t n) {
+    MD5_LANE lanes[MD5_LANES];
+    MD5_vu32 state[4];
+    unsigned long blocks;
+    size_t first, i;
+
+    for (first = 0; first < n; first += MD5_LANES) {
+        blocks = 0;
+        for (i = 0; i < MD5_LANES; ++i) {
+            if (first + i < n) {
+                lane_init(&lanes[i], s[first + i], len[first + i]);
+            } else {
+                lanes[i].data = NULL;
+                lanes[i].full_blocks = 0;
+                lanes[i].blocks = 0;
+            }
+            if (lanes[i].blocks > blocks) {
+                blocks = lanes[i].blocks;
+            }
+            state[0][i] = 0x67452301;
+            state[1][i] = 0xefcdab89;
+            state[2][i] = 0x98badcfe;
+            state[3][i] = 0x10325476;
+        }
+        body_multi(state, lanes, blocks);
+        for (i = 0; (i < MD5_LANES) && (first + i < n); ++i) {
+            OUT(&key[first + i][0], state[0][i])
+            OUT(&key[first + i][4], state[1][i])
+            OUT(&key[first + i][8], state[2][i])
+            OUT(&key[first + i][12], state[3][i])
+        }
+    }
+}
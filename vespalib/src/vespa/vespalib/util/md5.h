@@ -6,11 +6,20 @@
 
 /* Returns pointer to a key in compacted format, ie 16 unsigned chars */
 
+/*
+ * fastc_md5sum_multi computes the same keys as calling fastc_md5sum for each
+ * of the n messages s[i] of length len[i], storing the result in key[i].
+ * Several messages are hashed in parallel using vector instructions, which
+ * is faster for batches of short messages like document ids.
+ */
+
 #ifdef __cplusplus
 extern "C" {
 void fastc_md5sum(const void *s, size_t len, unsigned char *key);
+void fastc_md5sum_multi(const void * const *s, const size_t *len, unsigned char * const *key, size_t n);
 }
 #else
 void fastc_md5sum(const void *s, size_t len, unsigned char *key);
+void fastc_md5sum_multi(const void * const *s, const size_t *len, unsigned char * const *key, size_t n);
 #endif
 
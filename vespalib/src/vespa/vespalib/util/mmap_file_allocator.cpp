@@ -0,0 +1,108 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_file_allocator.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <cassert>
+#include <cinttypes>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace vespalib::alloc {
+
+namespace {
+
+const size_t page_size = getpagesize();
+
+size_t
+round_up_to_page_size(size_t sz)
+{
+    return ((sz + (page_size - 1)) / page_size) * page_size;
+}
+
+}
+
+MmapFileAllocator::MmapFileAllocator(const vespalib::string& dir_name)
+    : _dir_name(dir_name),
+      _file(_dir_name + "/swapfile"),
+      _end_offset(0),
+      _allocations(),
+      _mutex()
+{
+    mkdir(_dir_name, true);
+    _file.open(O_RDWR | O_CREAT | O_TRUNC, false);
+}
+
+MmapFileAllocator::~MmapFileAllocator()
+{
+    assert(_allocations.empty());
+    _file.close();
+    _file.unlink();
+    rmdir(_dir_name, true);
+}
+
+MmapFileAllocator::PtrAndSize
+MmapFileAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0); // empty allocation
+    }
+    sz = round_up_to_page_size(sz);
+    std::lock_guard guard(_mutex);
+    uint64_t offset = _end_offset;
+    _end_offset += sz;
+    _file.resize(_end_offset);
+    void *buf = mmap(nullptr, sz,
+                     PROT_READ | PROT_WRITE,
+                     MAP_SHARED,
+                     _file.getFileDescriptor(),
+                     offset);
+    if (buf == MAP_FAILED) {
+        throw IoException(make_string("Failed mmap(nullptr, %zu, PROT_READ | PROT_WRITE, MAP_SHARED, %s(fd=%d), %" PRIu64 "). Reason given by OS = '%s'",
+                                      sz, _file.getFilename().c_str(), _file.getFileDescriptor(), offset, getLastErrorString().c_str()),
+                          IoException::getErrorType(errno), VESPA_STRLOC);
+    }
+    assert(buf != nullptr);
+    auto ins_res = _allocations.insert(std::make_pair(buf, SizeAndOffset(sz, offset)));
+    assert(ins_res.second);
+    int retval = madvise(buf, sz, MADV_RANDOM);
+    assert(retval == 0);
+    return PtrAndSize(buf, sz);
+}
+
+void
+MmapFileAllocator::free(PtrAndSize alloc) const
+{
+    if (alloc.second == 0) {
+        assert(alloc.first == nullptr);
+        return; // empty allocation
+    }
+    assert(alloc.first != nullptr);
+    SizeAndOffset size_and_offset;
+    {
+        std::lock_guard guard(_mutex);
+        auto itr = _allocations.find(alloc.first);
+        assert(itr != _allocations.end());
+        size_and_offset = itr->second;
+        _allocations.erase(itr);
+    }
+    assert(round_up_to_page_size(alloc.second) == size_and_offset.size);
+    int retval = madvise(alloc.first, size_and_offset.size, MADV_DONTNEED);
+    assert(retval == 0);
+    retval = munmap(alloc.first, size_and_offset.size);
+    assert(retval == 0);
+    // Release the disk space used by the allocation
+    retval = fallocate(_file.getFileDescriptor(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                       size_and_offset.offset, size_and_offset.size);
+    (void) retval;
+}
+
+size_t
+MmapFileAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0;
+}
+
+}
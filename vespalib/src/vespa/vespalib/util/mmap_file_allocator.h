@@ -0,0 +1,45 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <mutex>
+
+namespace vespalib::alloc {
+
+/*
+ * Class handling memory allocations backed by a file in the given directory.
+ * Should not be destructed before all allocations have been freed.
+ *
+ * The memory is mapped shared from the file, letting the kernel page
+ * data in on demand and write dirty pages back to the file, which allows
+ * storing more data than fits in memory.
+ */
+class MmapFileAllocator : public MemoryAllocator {
+    struct SizeAndOffset {
+        size_t   size;
+        uint64_t offset;
+        SizeAndOffset() noexcept : size(0u), offset(0u) {}
+        SizeAndOffset(size_t size_in, uint64_t offset_in) noexcept : size(size_in), offset(offset_in) {}
+    };
+    using Allocations = hash_map<void *, SizeAndOffset>;
+    const vespalib::string _dir_name;
+    mutable File           _file;
+    mutable uint64_t       _end_offset;
+    mutable Allocations    _allocations;
+    mutable std::mutex     _mutex;
+public:
+    MmapFileAllocator(const vespalib::string& dir_name);
+    ~MmapFileAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const override;
+    size_t resize_inplace(PtrAndSize, size_t) const override;
+
+    // For unit test
+    size_t get_end_offset() const noexcept { return _end_offset; }
+};
+
+}
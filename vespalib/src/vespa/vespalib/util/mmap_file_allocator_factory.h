@@ -0,0 +1,38 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "alloc.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <memory>
+
+namespace vespalib::alloc {
+
+/*
+ * Class for creating an mmap file allocator on demand.
+ *
+ * The directory where the files are placed is set up once at startup,
+ * e.g. by proton. If not set up, no allocator is created and the caller
+ * must fall back to the default memory allocation.
+ */
+class MmapFileAllocatorFactory {
+    vespalib::string      _dir_name;
+    std::atomic<uint64_t> _generation;
+
+    MmapFileAllocatorFactory();
+    ~MmapFileAllocatorFactory();
+    MmapFileAllocatorFactory(const MmapFileAllocatorFactory &) = delete;
+    MmapFileAllocatorFactory& operator=(const MmapFileAllocatorFactory &) = delete;
+public:
+    /*
+     * Sets the directory where allocator files are placed. Any existing
+     * content of the directory is removed. An empty name disables the factory.
+     */
+    void setup(const vespalib::string &dir_name);
+    std::unique_ptr<MemoryAllocator> make_memory_allocator(const vespalib::string& name);
+
+    static MmapFileAllocatorFactory& instance();
+};
+
+}
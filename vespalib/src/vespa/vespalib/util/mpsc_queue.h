@@ -0,0 +1,96 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace vespalib {
+
+/**
+ * A lock-free multi-producer single-consumer queue. Producers push
+ * onto an intrusive list with a single compare-and-swap. The consumer
+ * takes everything queued so far with a single exchange, so there is
+ * no ABA problem and no per-element synchronization on the consumer
+ * side. Elements pushed by the same thread are popped in push order.
+ *
+ * The queue does not block; parking an idle consumer is left to the
+ * user, who can use the return value of push to know when a consumer
+ * might need to be woken up.
+ **/
+template <typename T>
+class MpscQueue
+{
+private:
+    struct Node {
+        T     value;
+        Node *next;
+        Node(T &&value_in) : value(std::move(value_in)), next(nullptr) {}
+    };
+    std::atomic<Node *> _head;
+
+    static Node *reverse(Node *list) {
+        Node *result = nullptr;
+        while (list != nullptr) {
+            Node *next = list->next;
+            list->next = result;
+            result = list;
+            list = next;
+        }
+        return result;
+    }
+
+public:
+    MpscQueue() : _head(nullptr) {}
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+    ~MpscQueue() {
+        Node *list = _head.exchange(nullptr);
+        while (list != nullptr) {
+            Node *next = list->next;
+            delete list;
+            list = next;
+        }
+    }
+
+    /**
+     * Add a value to the queue. May be called by any thread.
+     *
+     * @return true if the queue was empty before this value was added
+     **/
+    bool push(T value) {
+        Node *node = new Node(std::move(value));
+        node->next = _head.load(std::memory_order_relaxed);
+        while (!_head.compare_exchange_weak(node->next, node)) {
+            // node->next was updated with the current head
+        }
+        return (node->next == nullptr);
+    }
+
+    /**
+     * Move all values currently in the queue to the back of the given
+     * container, oldest first. Must only be called by the consumer.
+     *
+     * @return the number of values moved
+     **/
+    template <typename Container>
+    size_t pop_all(Container &out) {
+        if (_head.load(std::memory_order_relaxed) == nullptr) {
+            return 0;
+        }
+        Node *list = reverse(_head.exchange(nullptr));
+        size_t cnt = 0;
+        while (list != nullptr) {
+            Node *next = list->next;
+            out.push_back(std::move(list->value));
+            delete list;
+            list = next;
+            ++cnt;
+        }
+        return cnt;
+    }
+
+    bool empty() const { return (_head.load() == nullptr); }
+};
+
+}
@@ -0,0 +1,114 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa_nodes.h"
+#include <vespa/vespalib/text/stringtokenizer.h>
+#include <dirent.h>
+#include <fstream>
+#include <map>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+bool parse_int(vespalib::stringref str, int &value) {
+    if (str.empty() || (str.size() > 9)) {
+        return false;
+    }
+    value = 0;
+    for (char c : str) {
+        if ((c < '0') || (c > '9')) {
+            return false;
+        }
+        value = (value * 10) + (c - '0');
+    }
+    return true;
+}
+
+}
+
+NumaNodes::CpuList
+NumaNodes::parse_cpu_list(const vespalib::string &list)
+{
+    CpuList cpus;
+    StringTokenizer ranges(list, ",");
+    for (auto range : ranges) {
+        if (range.empty()) {
+            continue;
+        }
+        int first = 0;
+        int last = 0;
+        auto dash = range.find('-');
+        if (dash == vespalib::stringref::npos) {
+            if (!parse_int(range, first)) {
+                return CpuList();
+            }
+            last = first;
+        } else if (!parse_int(range.substr(0, dash), first) ||
+                   !parse_int(range.substr(dash + 1), last) ||
+                   (last < first))
+        {
+            return CpuList();
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::vector<NumaNodes::CpuList>
+NumaNodes::cpus_per_node(const vespalib::string &sysfs_node_dir)
+{
+    std::map<int, CpuList> nodes;
+    DIR *dir = opendir(sysfs_node_dir.c_str());
+    if (dir == nullptr) {
+        return std::vector<CpuList>();
+    }
+    while (struct dirent *entry = readdir(dir)) {
+        vespalib::stringref name(entry->d_name);
+        int node = 0;
+        if ((name.size() > 4) && (name.substr(0, 4) == "node") && parse_int(name.substr(4), node)) {
+            std::ifstream file(sysfs_node_dir + "/" + name + "/cpulist");
+            std::string line;
+            if (std::getline(file, line)) {
+                CpuList cpus = parse_cpu_list(line);
+                if (!cpus.empty()) {
+                    nodes[node] = std::move(cpus);
+                }
+            }
+        }
+    }
+    closedir(dir);
+    std::vector<CpuList> result;
+    for (auto &entry : nodes) {
+        result.push_back(std::move(entry.second));
+    }
+    return result;
+}
+
+bool
+NumaNodes::pin_current_thread(const CpuList &cpus)
+{
+#ifdef __linux__
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : cpus) {
+        if ((cpu >= 0) && (cpu < CPU_SETSIZE)) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    return (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0);
+#else
+    (void) cpus;
+    return false;
+#endif
+}
+
+} // namespace vespalib
@@ -0,0 +1,37 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Simple access to the NUMA topology of the machine as exposed by
+ * sysfs, and pinning of threads to the cpus of a NUMA node.
+ **/
+struct NumaNodes {
+    using CpuList = std::vector<int>;
+
+    /**
+     * Parse a cpu list on the form used by sysfs (e.g. "0-3,8,10-11").
+     * Returns an empty list if the list is malformed.
+     **/
+    static CpuList parse_cpu_list(const vespalib::string &list);
+
+    /**
+     * The cpus of each NUMA node, ordered by node id. Nodes without
+     * cpus are skipped. Returns an empty vector if the topology is
+     * not available (e.g. not running on linux).
+     **/
+    static std::vector<CpuList> cpus_per_node(const vespalib::string &sysfs_node_dir = "/sys/devices/system/node");
+
+    /**
+     * Restrict the calling thread to run on the given cpus. Returns
+     * false if this is not supported or fails.
+     **/
+    static bool pin_current_thread(const CpuList &cpus);
+};
+
+} // namespace vespalib
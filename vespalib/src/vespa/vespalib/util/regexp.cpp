@@ -57,6 +57,69 @@ RegexpUtil::get_prefix(vespalib::stringref re)
     return prefix;
 }
 
+vespalib::string
+RegexpUtil::get_required_literal(vespalib::stringref re)
+{
+    vespalib::string best;
+    vespalib::string run;
+    auto end_run = [&best, &run]() {
+        if (run.size() > best.size()) {
+            best = run;
+        }
+        run.clear();
+    };
+    if (has_option(re)) {
+        return best;
+    }
+    const char *pos = re.data();
+    const char *end = re.data() + re.size();
+    while (pos < end) {
+        char c = *pos++;
+        if (c == '\\') {
+            if ((pos < end) && is_special(*pos)) {
+                run.push_back(*pos++);
+            } else {
+                end_run(); // character class escape like \d or \w
+                if (pos < end) {
+                    ++pos;
+                }
+            }
+        } else if (maybe_none(c)) {
+            if (!run.empty()) {
+                run.resize(run.size() - 1); // preceding atom is optional
+            }
+            end_run();
+            if (c == '{') {
+                while ((pos < end) && (*pos++ != '}')) { }
+            }
+        } else if (c == '+') {
+            end_run();
+        } else if (c == '[') {
+            end_run();
+            if ((pos < end) && (*pos == ']')) {
+                ++pos; // ']' first in a class is a literal
+            }
+            while ((pos < end) && (*pos != ']')) {
+                pos += ((*pos == '\\') && (pos + 1 < end)) ? 2 : 1;
+            }
+            if (pos < end) {
+                ++pos;
+            }
+            if ((pos < end) && maybe_none(*pos)) {
+                ++pos;
+            }
+        } else if ((c == '(') || (c == ')')) {
+            return vespalib::string();
+        } else if (is_special(c)) {
+            end_run(); // '^', '$' or '.'
+        } else {
+            run.push_back(c);
+        }
+    }
+    end_run();
+    return best;
+}
+
 vespalib::string
 RegexpUtil::make_from_suffix(vespalib::stringref suffix)
 {
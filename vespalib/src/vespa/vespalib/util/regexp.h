@@ -23,6 +23,18 @@ public:
      **/
     static vespalib::string get_prefix(vespalib::stringref re);
 
+    /**
+     * Look at the given regular expression and identify the longest
+     * literal string that must be present somewhere in a string for
+     * it to match. The expression is inspected conservatively; an
+     * empty string is returned for expressions containing options or
+     * groups, and when no such literal is found.
+     *
+     * @param re Regular expression.
+     * @return literal that must be present in matching strings
+     **/
+    static vespalib::string get_required_literal(vespalib::stringref re);
+
     /**
      * Make a regexp matching strings with the given suffix.
      *
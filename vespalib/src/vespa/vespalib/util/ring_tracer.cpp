@@ -0,0 +1,194 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "ring_tracer.h"
+#include <algorithm>
+
+namespace vespalib {
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Returns the ring of a thread to the free list when the thread exits.
+ * Samples logged after that (by destructors of other thread locals)
+ * end up in a sink ring that is never extracted.
+ **/
+struct RingTracer::ThreadBinding {
+    ThreadState *state;
+    ThreadBinding() : state(master().acquire_thread_state()) {}
+    ~ThreadBinding() {
+        static ThreadState sink(0);
+        _thread_state = &sink;
+        master().release_thread_state(state);
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+RingTracer &
+RingTracer::master()
+{
+    // never destructed, since threads may exit after static destruction
+    static RingTracer *instance = new RingTracer();
+    return *instance;
+}
+
+//-----------------------------------------------------------------------------
+
+thread_local RingTracer::ThreadState *RingTracer::_thread_state = nullptr;
+
+//-----------------------------------------------------------------------------
+
+RingTracer::Tag::Tag(const vespalib::string &name)
+    : _id(master().get_tag_id(name))
+{
+}
+
+RingTracer::Tag::~Tag() = default;
+
+//-----------------------------------------------------------------------------
+
+vespalib::string
+RingTracer::Record::tag_name() const
+{
+    return master().get_tag_name(tag_id);
+}
+
+//-----------------------------------------------------------------------------
+
+RingTracer::ThreadState::ThreadState(uint32_t thread_id)
+    : _thread_id(thread_id),
+      _written(0),
+      _ring(std::make_unique<LogEntry[]>(NUM_SLOTS))
+{
+}
+
+RingTracer::ThreadState::~ThreadState() = default;
+
+void
+RingTracer::ThreadState::extract(steady_time a, steady_time b, std::vector<Record> &list) const
+{
+    uint64_t end = _written.load(std::memory_order_acquire);
+    uint64_t begin = (end > RING_SIZE) ? (end - RING_SIZE) : 0;
+    std::vector<Record> found;
+    std::vector<uint64_t> positions;
+    for (uint64_t pos = begin; pos < end; ++pos) {
+        const LogEntry &entry = _ring[pos % NUM_SLOTS];
+        steady_time start(steady_clock::duration(entry.start.load(std::memory_order_relaxed)));
+        steady_time stop(steady_clock::duration(entry.stop.load(std::memory_order_relaxed)));
+        if ((stop > a) && (start < b)) {
+            found.emplace_back(_thread_id, entry.tag_id.load(std::memory_order_relaxed), start, stop);
+            positions.push_back(pos);
+        }
+    }
+    // entries may have been overwritten by the owning thread while we were reading them
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t written = _written.load(std::memory_order_relaxed);
+    uint64_t first_valid = (written > RING_SIZE) ? (written - RING_SIZE) : 0;
+    for (size_t i = 0; i < found.size(); ++i) {
+        if (positions[i] >= first_valid) {
+            list.push_back(found[i]);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+RingTracer::init_thread_state() noexcept
+{
+    static thread_local ThreadBinding binding;
+    _thread_state = binding.state;
+}
+
+//-----------------------------------------------------------------------------
+
+RingTracer::RingTracer()
+    : _lock(),
+      _state_list(),
+      _free_list(),
+      _tags(),
+      _tag_names()
+{
+}
+
+RingTracer::~RingTracer() = default;
+
+uint32_t
+RingTracer::get_tag_id(const vespalib::string &tag_name)
+{
+    std::lock_guard guard(_lock);
+    auto pos = _tags.find(tag_name);
+    if (pos != _tags.end()) {
+        return pos->second;
+    }
+    uint32_t id = _tags.size();
+    _tags[tag_name] = id;
+    _tag_names.push_back(tag_name);
+    return id;
+}
+
+vespalib::string
+RingTracer::get_tag_name(uint32_t tag_id)
+{
+    std::lock_guard guard(_lock);
+    if (tag_id < _tag_names.size()) {
+        return _tag_names[tag_id];
+    } else {
+        return "<undef>";
+    }
+}
+
+RingTracer::ThreadState *
+RingTracer::acquire_thread_state()
+{
+    std::lock_guard guard(_lock);
+    if (!_free_list.empty()) {
+        ThreadState *state = _free_list.back();
+        _free_list.pop_back();
+        return state;
+    }
+    uint32_t thread_id = _state_list.size();
+    _state_list.push_back(std::make_unique<ThreadState>(thread_id));
+    return _state_list.back().get();
+}
+
+void
+RingTracer::release_thread_state(ThreadState *state)
+{
+    std::lock_guard guard(_lock);
+    _free_list.push_back(state);
+}
+
+std::vector<RingTracer::Record>
+RingTracer::extract(steady_time a, steady_time b)
+{
+    RingTracer &self = master();
+    std::vector<Record> list;
+    {
+        std::lock_guard guard(self._lock);
+        for (const auto &state: self._state_list) {
+            state->extract(a, b, list);
+        }
+    }
+    std::stable_sort(list.begin(), list.end(),
+                     [](const Record &lhs, const Record &rhs) { return (lhs.start < rhs.start); });
+    return list;
+}
+
+vespalib::string
+RingTracer::tag_name(uint32_t tag_id)
+{
+    return master().get_tag_name(tag_id);
+}
+
+size_t
+RingTracer::num_threads()
+{
+    RingTracer &self = master();
+    std::lock_guard guard(self._lock);
+    return self._state_list.size();
+}
+
+//-----------------------------------------------------------------------------
+
+} // namespace vespalib
@@ -0,0 +1,157 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "time.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Always-on tracing of when and for how long different things happen
+ * across different threads, intended for finding the cause of
+ * latency spikes after the fact.
+ *
+ * The API mirrors vespalib::test::TimeTracer; a Tag represents a thing
+ * that can happen and should be constructed up front (typically as a
+ * static), while a Sample binds an instance of that thing to the
+ * current scope:
+ *
+ * <pre>
+ * RT_Tag my_tag("my task");
+ *
+ * void do_stuff() {
+ *     RT_Sample my_sample(my_tag);
+ *     ... perform 'my task'
+ * }
+ * </pre>
+ *
+ * Unlike TimeTracer, each thread logs into a fixed size ring buffer,
+ * so only the most recent samples of each thread are kept. Logging a
+ * sample is two clock reads and a few relaxed stores into memory owned
+ * by the calling thread. Rings of exited threads are reused by new
+ * threads, so thread ids identify rings rather than threads. Samples
+ * can be extracted concurrently with logging; samples overwritten while
+ * being extracted are dropped.
+ *
+ * Sampling is compiled out if VESPA_DISABLE_RING_TRACER is defined.
+ **/
+class RingTracer
+{
+public:
+    static constexpr size_t RING_SIZE = 4096;
+
+    class Tag {
+    private:
+        uint32_t _id;
+    public:
+        explicit Tag(const vespalib::string &name_in);
+        ~Tag();
+        uint32_t id() const { return _id; }
+    };
+
+#ifdef VESPA_DISABLE_RING_TRACER
+    class Sample {
+    public:
+        explicit Sample(const Tag &) noexcept {}
+    };
+#else
+    class Sample {
+    private:
+        uint32_t _tag_id;
+        steady_time _start;
+    public:
+        explicit Sample(const Tag &tag) noexcept : _tag_id(tag.id()), _start(steady_clock::now()) {}
+        ~Sample() noexcept { thread_state().add_log_entry(_tag_id, _start, steady_clock::now()); }
+    };
+#endif
+
+    struct Record {
+        uint32_t thread_id;
+        uint32_t tag_id;
+        steady_time start;
+        steady_time stop;
+        Record(uint32_t thread_id_in, uint32_t tag_id_in,
+               steady_time start_in, steady_time stop_in)
+            : thread_id(thread_id_in), tag_id(tag_id_in),
+              start(start_in), stop(stop_in) {}
+        duration elapsed() const { return stop - start; }
+        vespalib::string tag_name() const;
+    };
+
+    /**
+     * Extract all samples still in the rings that overlap with the
+     * given time window, ordered by start time.
+     **/
+    static std::vector<Record> extract(steady_time a, steady_time b);
+    static vespalib::string tag_name(uint32_t tag_id);
+    static size_t num_threads();
+
+private:
+    // one extra slot for the entry being written while extracting
+    static constexpr size_t NUM_SLOTS = RING_SIZE + 1;
+
+    struct LogEntry {
+        std::atomic<uint32_t> tag_id;
+        std::atomic<int64_t>  start;
+        std::atomic<int64_t>  stop;
+        LogEntry() noexcept : tag_id(0), start(0), stop(0) {}
+    };
+
+    class ThreadState {
+    private:
+        uint32_t              _thread_id;
+        std::atomic<uint64_t> _written;
+        std::unique_ptr<LogEntry[]> _ring;
+    public:
+        explicit ThreadState(uint32_t thread_id);
+        ~ThreadState();
+        uint32_t thread_id() const { return _thread_id; }
+        void add_log_entry(uint32_t tag_id, steady_time start, steady_time stop) noexcept {
+            uint64_t pos = _written.load(std::memory_order_relaxed);
+            // make the overwrite of an old entry visible only after the position update
+            std::atomic_thread_fence(std::memory_order_release);
+            LogEntry &entry = _ring[pos % NUM_SLOTS];
+            entry.tag_id.store(tag_id, std::memory_order_relaxed);
+            entry.start.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+            entry.stop.store(stop.time_since_epoch().count(), std::memory_order_relaxed);
+            _written.store(pos + 1, std::memory_order_release);
+        }
+        void extract(steady_time a, steady_time b, std::vector<Record> &list) const;
+    };
+    struct ThreadBinding;
+
+    static RingTracer &master();
+    static thread_local ThreadState *_thread_state;
+
+    static void init_thread_state() noexcept;
+    static ThreadState &thread_state() noexcept {
+        if (__builtin_expect((_thread_state == nullptr), false)) {
+            init_thread_state();
+        }
+        return *_thread_state;
+    }
+
+    std::mutex _lock;
+    std::vector<std::unique_ptr<ThreadState>> _state_list;
+    std::vector<ThreadState *> _free_list;
+    std::map<vespalib::string, uint32_t> _tags;
+    std::vector<vespalib::string> _tag_names;
+
+    RingTracer();
+    ~RingTracer();
+    uint32_t get_tag_id(const vespalib::string &tag_name);
+    vespalib::string get_tag_name(uint32_t tag_id);
+    ThreadState *acquire_thread_state();
+    void release_thread_state(ThreadState *state);
+};
+
+} // namespace vespalib
+
+using RT_Tag = vespalib::RingTracer::Tag;
+using RT_Sample = vespalib::RingTracer::Sample;
@@ -2,6 +2,7 @@
 
 #include "simple_thread_bundle.h"
 #include "exceptions.h"
+#include "numa_nodes.h"
 #include <cassert>
 
 using namespace vespalib::fixed_thread_bundle;
@@ -59,8 +60,14 @@ Signal::Signal() noexcept
 Signal::~Signal() = default;
 
 SimpleThreadBundle::Pool::Pool(size_t bundleSize)
+    : Pool(bundleSize, std::vector<int>())
+{
+}
+
+SimpleThreadBundle::Pool::Pool(size_t bundleSize, std::vector<int> cpus)
     : _lock(),
       _bundleSize(bundleSize),
+      _cpus(std::move(cpus)),
       _bundles()
 {
 }
@@ -84,7 +91,7 @@ SimpleThreadBundle::Pool::obtain()
             return ret;
         }
     }
-    return std::make_unique<SimpleThreadBundle>(_bundleSize);
+    return std::make_unique<SimpleThreadBundle>(_bundleSize, _cpus);
 }
 
 void
@@ -97,9 +104,24 @@ SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle)
 
 //-----------------------------------------------------------------------------
 
+void
+SimpleThreadBundle::Worker::run()
+{
+    if (!cpus.empty()) {
+        NumaNodes::pin_current_thread(cpus);
+    }
+    loop();
+}
+
 SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
+    : SimpleThreadBundle(size_in, std::vector<int>(), strategy)
+{
+}
+
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, std::vector<int> cpus, Strategy strategy)
     : _work(),
       _signals(),
+      _cpus(std::move(cpus)),
       _workers(),
       _hook()
 {
@@ -132,7 +154,7 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
             _hook = std::move(hook);
         } else {
             size_t signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
-            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook)));
+            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook), _cpus));
         }
     }
 }
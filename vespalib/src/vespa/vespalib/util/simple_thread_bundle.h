@@ -82,6 +82,8 @@ struct Signal {
 /**
  * A ThreadBundle implementation employing a fixed set of internal
  * threads. The internal Pool class can be used to recycle bundles.
+ * The internal threads may be restricted to a set of cpus (e.g. the
+ * cpus of a single NUMA node).
  **/
 class SimpleThreadBundle : public ThreadBundle
 {
@@ -97,10 +99,13 @@ public:
     private:
         std::mutex _lock;
         size_t     _bundleSize;
+        std::vector<int> _cpus;
         std::vector<SimpleThreadBundle*> _bundles;
 
     public:
         Pool(size_t bundleSize);
+        Pool(size_t bundleSize, std::vector<int> cpus);
+        const std::vector<int> &cpus() const { return _cpus; }
         ~Pool();
         SimpleThreadBundle::UP obtain();
         void release(SimpleThreadBundle::UP bundle);
@@ -112,10 +117,14 @@ private:
         Thread thread;
         Signal &signal;
         Runnable::UP hook;
-        Worker(Signal &s, Runnable::UP h) : thread(*this), signal(s), hook(std::move(h)) {
+        const std::vector<int> &cpus;
+        Worker(Signal &s, Runnable::UP h, const std::vector<int> &c)
+            : thread(*this), signal(s), hook(std::move(h)), cpus(c)
+        {
             thread.start();
         }
-        void run() override {
+        void run() override;
+        void loop() {
             for (size_t gen = 0; signal.wait(gen) > 0; ) {
                 hook->run();
             }
@@ -124,11 +133,13 @@ private:
 
     Work                    _work;
     std::vector<Signal>     _signals;
+    std::vector<int>        _cpus;
     std::vector<Worker::UP> _workers;
     Runnable::UP            _hook;
 
 public:
     SimpleThreadBundle(size_t size, Strategy strategy = USE_SIGNAL_LIST);
+    SimpleThreadBundle(size_t size, std::vector<int> cpus, Strategy strategy = USE_SIGNAL_LIST);
     ~SimpleThreadBundle();
     size_t size() const override;
     void run(const std::vector<Runnable*> &targets) override;
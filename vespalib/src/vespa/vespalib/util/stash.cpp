@@ -49,11 +49,14 @@ char *
 Stash::do_alloc(size_t size)
 {
     if (is_small(size)) {
+        _spilled += (_chunks != nullptr) ? _chunk_size : 0;
         void *chunk_mem = malloc(_chunk_size);
         _chunks = new (chunk_mem) stash::Chunk(_chunks);
         return _chunks->alloc(size, _chunk_size);
     } else {
         size_t allocate = sizeof(stash::DeleteMemory) + size;
+        _spilled += allocate;
+        _largest = std::max(_largest, allocate);
         char *mem = static_cast<char*>(malloc(allocate));
         _cleanup = new (mem) stash::DeleteMemory(allocate, _cleanup);
         return (mem + sizeof(stash::DeleteMemory));
@@ -63,14 +66,18 @@ Stash::do_alloc(size_t size)
 Stash::Stash(size_t chunk_size) noexcept
     : _chunks(nullptr),
       _cleanup(nullptr),
-      _chunk_size(std::max(size_t(128), chunk_size))
+      _chunk_size(std::max(size_t(128), chunk_size)),
+      _spilled(0),
+      _largest(0)
 {
 }
 
 Stash::Stash(Stash &&rhs) noexcept
     : _chunks(rhs._chunks),
       _cleanup(rhs._cleanup),
-      _chunk_size(rhs._chunk_size)
+      _chunk_size(rhs._chunk_size),
+      _spilled(rhs._spilled),
+      _largest(rhs._largest)
 {
     rhs._chunks = nullptr;
     rhs._cleanup = nullptr;
@@ -84,6 +91,8 @@ Stash::operator=(Stash &&rhs) noexcept
     _chunks = rhs._chunks;
     _cleanup = rhs._cleanup;
     _chunk_size = rhs._chunk_size;
+    _spilled = rhs._spilled;
+    _largest = rhs._largest;
     rhs._chunks = nullptr;
     rhs._cleanup = nullptr;
     return *this;
@@ -100,6 +109,32 @@ Stash::clear()
 {
     _cleanup = stash::run_cleanup(_cleanup);
     _chunks = stash::keep_one(_chunks);
+    _spilled = 0;
+    _largest = 0;
+}
+
+void
+Stash::recycle(size_t max_chunk_size)
+{
+    if (_spilled == 0) {
+        return clear();
+    }
+    size_t wanted = std::max(_chunk_size + _spilled, (_largest * 4) + 1);
+    size_t chunk_size = _chunk_size;
+    while ((chunk_size < wanted) && (chunk_size < max_chunk_size)) {
+        chunk_size *= 2;
+    }
+    _cleanup = stash::run_cleanup(_cleanup);
+    if (chunk_size == _chunk_size) {
+        _chunks = stash::keep_one(_chunks);
+    } else {
+        _chunks = stash::free_chunks(_chunks);
+        _chunk_size = chunk_size;
+        void *chunk_mem = malloc(_chunk_size);
+        _chunks = new (chunk_mem) stash::Chunk(nullptr);
+    }
+    _spilled = 0;
+    _largest = 0;
 }
 
 void
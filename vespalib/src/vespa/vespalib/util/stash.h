@@ -82,6 +82,8 @@ private:
     stash::Chunk   *_chunks;
     stash::Cleanup *_cleanup;
     size_t          _chunk_size;
+    size_t          _spilled;
+    size_t          _largest;
 
     char *do_alloc(size_t size);
     bool is_small(size_t size) const { return (size < (_chunk_size / 4)); }
@@ -137,6 +139,17 @@ public:
 
     void clear();
 
+    /**
+     * Clear the stash like 'clear', but if the previous round of
+     * allocations did not fit in a single chunk, the chunk size is
+     * grown (up to 'max_chunk_size') so that the same allocation
+     * pattern will fit in the single chunk kept for the next
+     * round. This is intended for stashes that are cleared and
+     * refilled in a loop, making repeated rounds malloc-free after
+     * the first few iterations.
+     **/
+    void recycle(size_t max_chunk_size = 16 * 1024 * 1024);
+
     Mark mark() const { return Mark(_cleanup, _chunks); }
     void revert(const Mark &mark);
 
@@ -3,6 +3,7 @@
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
@@ -33,6 +34,40 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(const ConstBufferRef & raw, int compressionLevel)
+    : _raw(raw.c_str(), raw.c_str() + raw.size()),
+      _compressionLevel(compressionLevel),
+      _cdict(ZSTD_createCDict(_raw.data(), _raw.size(), compressionLevel)),
+      _ddict(ZSTD_createDDict(_raw.data(), _raw.size()))
+{
+    assert(_cdict != nullptr);
+    assert(_ddict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const ConstBufferRef & samples, const std::vector<size_t> & sampleSizes,
+                      size_t maxSize, int compressionLevel)
+{
+    std::vector<char> raw(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(raw.data(), raw.size(), samples.c_str(), sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return SP();
+    }
+    return std::make_shared<ZStdDictionary>(ConstBufferRef(raw.data(), sz), compressionLevel);
+}
+
+uint32_t
+ZStdDictionary::getId() const
+{
+    return ZSTD_getDictID_fromDict(_raw.data(), _raw.size());
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -42,7 +77,16 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz;
+    if (_dictionary == nullptr) {
+        sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    } else if (_dictionary->getCompressionLevel() == config.compressionLevel) {
+        sz = ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, _dictionary->getCDict());
+    } else {
+        ConstBufferRef raw = _dictionary->getRaw();
+        sz = ZSTD_compress_usingDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                     raw.c_str(), raw.size(), config.compressionLevel);
+    }
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -54,7 +98,9 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = (_dictionary != nullptr)
+        ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen, _dictionary->getDDict())
+        : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
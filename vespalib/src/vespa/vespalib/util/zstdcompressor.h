@@ -2,15 +2,58 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary trained from samples of similar data. Small buffers compressed
+ * with a shared dictionary compress far better than they do on their own, as the
+ * content common to all of them is found in the dictionary instead.
+ * Buffers compressed with a dictionary can only be decompressed with the same dictionary.
+ **/
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    ZStdDictionary(const ConstBufferRef & raw, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+    /**
+     * Trains a dictionary of at most maxSize bytes from the given samples.
+     * @param samples all samples laid out back to back.
+     * @param sampleSizes the size of each sample.
+     * @return the dictionary, or an empty pointer if there was not enough sample data.
+     **/
+    static SP train(const ConstBufferRef & samples, const std::vector<size_t> & sampleSizes,
+                    size_t maxSize, int compressionLevel);
+    ConstBufferRef getRaw() const { return ConstBufferRef(_raw.data(), _raw.size()); }
+    uint32_t getId() const;
+    int getCompressionLevel() const { return _compressionLevel; }
+    const ZSTD_CDict_s * getCDict() const { return _cdict; }
+    const ZSTD_DDict_s * getDDict() const { return _ddict; }
+private:
+    std::vector<char> _raw;
+    int               _compressionLevel;
+    ZSTD_CDict_s    * _cdict;
+    ZSTD_DDict_s    * _ddict;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() : _dictionary(nullptr) { }
+    explicit ZStdCompressor(const ZStdDictionary * dictionary) : _dictionary(dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }
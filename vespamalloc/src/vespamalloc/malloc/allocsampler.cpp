@@ -0,0 +1,99 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "allocsampler.h"
+#include <vespamalloc/util/callstack.h>
+#include <algorithm>
+#include <limits>
+
+namespace vespamalloc {
+
+namespace {
+
+// How often a thread checks if sampling has been turned on while it is off.
+constexpr ssize_t RECHECK_INTERVAL = 0x40000000;
+constexpr size_t CLAIMED = std::numeric_limits<size_t>::max();
+
+size_t hashStack(const void * const * stack, size_t depth) {
+    size_t h(depth);
+    for (size_t i(0); i < depth; i++) {
+        h = (h * 31) ^ (size_t(stack[i]) >> 4);
+    }
+    return h;
+}
+
+}
+
+std::atomic<size_t> AllocSampler::_interval(0);
+std::atomic<size_t> AllocSampler::_numSites(0);
+std::atomic<size_t> AllocSampler::_lostSamples(0);
+AllocSampler::Site AllocSampler::_sites[AllocSampler::MaxSites];
+__thread ssize_t AllocSampler::_bytesUntilSample TLS_LINKAGE = 0;
+
+AllocSampler::Site *
+AllocSampler::findSite(const void * const * stack, size_t depth)
+{
+    size_t start(hashStack(stack, depth) % MaxSites);
+    for (size_t i(0); i < MaxSites; i++) {
+        Site & site = _sites[(start + i) % MaxSites];
+        size_t siteDepth = site._depth.load(std::memory_order_acquire);
+        if (siteDepth == 0) {
+            if ( ! site._depth.compare_exchange_strong(siteDepth, CLAIMED, std::memory_order_relaxed)) {
+                continue;
+            }
+            std::copy(stack, stack + depth, site._stack);
+            site._depth.store(depth, std::memory_order_release);
+            _numSites.fetch_add(1, std::memory_order_relaxed);
+            return &site;
+        }
+        if ((siteDepth == depth) && std::equal(stack, stack + depth, site._stack)) {
+            return &site;
+        }
+    }
+    return nullptr;
+}
+
+void
+AllocSampler::sample(size_t sz)
+{
+    size_t interval = getInterval();
+    if (interval == 0) {
+        _bytesUntilSample = RECHECK_INTERVAL;
+        return;
+    }
+    // Reset before capturing the stack, as backtrace may allocate.
+    _bytesUntilSample = interval;
+    void * stack[MaxStackDepth + 2];
+    int depth = backtrace(stack, NELEMS(stack));
+    // Skip ourselves and the allocator entry.
+    const size_t skip(2);
+    Site * site = (depth > int(skip)) ? findSite(stack + skip, depth - skip) : nullptr;
+    if (site != nullptr) {
+        site->_samples.fetch_add(1, std::memory_order_relaxed);
+        site->_bytes.fetch_add(std::max(sz, interval), std::memory_order_relaxed);
+    } else {
+        _lostSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+AllocSampler::info(FILE * os, size_t level)
+{
+    if ((level == 0) || ((getInterval() == 0) && (_numSites.load() == 0))) {
+        return;
+    }
+    fprintf(os, "AllocSampler interval(%ld) sites(%ld) lostSamples(%ld):\n",
+            getInterval(), _numSites.load(), _lostSamples.load());
+    for (const Site & site : _sites) {
+        size_t depth = site._depth.load(std::memory_order_acquire);
+        if ((depth == 0) || (depth == CLAIMED)) {
+            continue;
+        }
+        fprintf(os, "Samples(%6ld) EstimatedBytes(%12ld) ", site._samples.load(), site._bytes.load());
+        for (size_t i(0); i < depth; i++) {
+            StackReturnEntry(site._stack[i]).info(os);
+            fprintf(os, " from ");
+        }
+        fprintf(os, "\n");
+    }
+}
+
+}
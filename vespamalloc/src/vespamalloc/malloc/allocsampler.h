@@ -0,0 +1,52 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "common.h"
+#include "threadlist.h"
+#include <stdio.h>
+#include <sys/types.h>
+
+namespace vespamalloc {
+
+/**
+ * Sampling allocation profiler. Roughly every 'interval' bytes allocated by a thread
+ * the call stack of the allocation is recorded in a fixed size table of call sites.
+ * The table is printed as part of the allocator info, so it can be dumped on a live
+ * process with the dump signal. Overhead is bounded by the interval, and is a single
+ * thread local decrement when sampling is disabled (interval 0).
+ *
+ * Only allocations are counted. The production MemBlock has no header where a sample
+ * mark could be kept, so frees can not be attributed to the sampled call sites.
+ */
+class AllocSampler
+{
+public:
+    enum { MaxSites = 4096, MaxStackDepth = 16 };
+    static void setInterval(size_t interval) { _interval.store(interval, std::memory_order_relaxed); }
+    static size_t getInterval() { return _interval.load(std::memory_order_relaxed); }
+    static void onAlloc(size_t sz) {
+        _bytesUntilSample -= sz;
+        if (__builtin_expect(_bytesUntilSample < 0, false)) {
+            sample(sz);
+        }
+    }
+    static void info(FILE * os, size_t level) __attribute__((noinline));
+private:
+    class Site {
+    public:
+        constexpr Site() : _stack(), _depth(0), _samples(0), _bytes(0) { }
+        const void        * _stack[MaxStackDepth];
+        std::atomic<size_t> _depth;
+        std::atomic<size_t> _samples;
+        std::atomic<size_t> _bytes;
+    };
+    static void sample(size_t sz) __attribute__((noinline));
+    static Site * findSite(const void * const * stack, size_t depth);
+    static std::atomic<size_t> _interval;
+    static std::atomic<size_t> _numSites;
+    static std::atomic<size_t> _lostSamples;
+    static Site                _sites[MaxSites];
+    static __thread ssize_t    _bytesUntilSample TLS_LINKAGE;
+};
+
+}
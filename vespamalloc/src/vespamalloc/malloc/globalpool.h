@@ -36,6 +36,7 @@ private:
     ChunkSList * malloc(const Guard & guard, SizeClassT sc) __attribute__((noinline));
     ChunkSList * getChunks(const Guard & guard, size_t numChunks) __attribute__((noinline));
     ChunkSList * allocChunkList(const Guard & guard) __attribute__((noinline));
+    enum { EmptyRefillChunks = 8 };
     AllocPoolT(const AllocPoolT & ap);
     AllocPoolT & operator = (const AllocPoolT & ap);
 
@@ -52,7 +52,8 @@ AllocPoolT<MemBlockPtrT>::getFree(SizeClassT sc)
     while ((csl = ChunkSList::linkOut(empty)) == NULL) {
         Guard sync(_mutex);
         if (empty.load(std::memory_order_relaxed)._ptr == NULL) {
-            ChunkSList * ncsl(getChunks(sync, 1));
+            // Refill with several chunks to keep the threads off the mutex for a while.
+            ChunkSList * ncsl(getChunks(sync, EmptyRefillChunks));
             if (ncsl) {
                 ChunkSList::linkInList(empty, ncsl);
             } else {
@@ -8,6 +8,7 @@
 #include "threadpool.h"
 #include "threadlist.h"
 #include "threadproxy.h"
+#include "allocsampler.h"
 
 namespace vespamalloc {
 
@@ -67,6 +68,9 @@ public:
         _threadList.setParams(alwayReuseLimit, threadCacheLimit);
         _allocPool.setParams(alwayReuseLimit, threadCacheLimit);
     }
+    void setAllocSampleInterval(size_t interval) {
+        AllocSampler::setInterval(interval);
+    }
 private:
     void freeSC(void *ptr, SizeClassT sc);
     void crash() __attribute__((noinline));;
@@ -152,6 +156,7 @@ void MemoryManager<MemBlockPtrT, ThreadListT>::info(FILE * os, size_t level)
     _segment.info(os, level);
     _allocPool.info(os, level);
     _threadList.info(os, level);
+    AllocSampler::info(os, level);
     fflush(os);
 }
 
@@ -159,6 +164,7 @@ template <typename MemBlockPtrT, typename ThreadListT>
 void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz)
 {
     MemBlockPtrT mem;
+    AllocSampler::onAlloc(sz);
     ThreadPool & tp = _threadList.getCurrent();
     tp.malloc(mem.adjustSize(sz), mem);
     if (!mem.validFree()) {
@@ -174,6 +180,7 @@ template <typename MemBlockPtrT, typename ThreadListT>
 void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz, std::align_val_t alignment)
 {
     MemBlockPtrT mem;
+    AllocSampler::onAlloc(sz);
     ThreadPool & tp = _threadList.getCurrent();
     tp.malloc(mem.adjustSize(sz, alignment), mem);
     if (!mem.validFree()) {
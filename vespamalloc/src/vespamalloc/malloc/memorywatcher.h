@@ -70,6 +70,7 @@ private:
             bigblocklimit,
             fillvalue,
             dumpsignal,
+            allocsampleinterval,
             numberofentries  // Must be the last one
         };
         Params() __attribute__ ((noinline));
@@ -135,6 +136,7 @@ MemoryWatcher<T, S>::Params::Params()
     _params[          bigblocklimit] = NameValuePair("bigblocklimit", "0x80000000"); // 8M
     _params[              fillvalue] = NameValuePair("fillvalue", "0xa8"); // Means NO fill.
     _params[             dumpsignal] = NameValuePair("dumpsignal", "27"); // SIGPROF
+    _params[    allocsampleinterval] = NameValuePair("allocsampleinterval", "0"); // Bytes between sampled call stacks, 0 means off.
 }
 
 template <typename T, typename S>
@@ -219,6 +221,7 @@ void MemoryWatcher<T, S>::activateOptions()
                     _params[Params::threadcachelimit].valueAsLong());
     T::bigBlockLimit(_params[Params::bigblocklimit].valueAsLong());
     T::setFill(_params[Params::fillvalue].valueAsLong());
+    this->setAllocSampleInterval(_params[Params::allocsampleinterval].valueAsLong());
 
 }
 
@@ -70,6 +70,16 @@ DocumentTest::testStorageDocument()
 
     EXPECT_TRUE(!sdoc.setField(3, FieldValue::UP(new StringFieldValue("thud"))));
 
+    document::Document::UP partial(new document::Document(dt, DocumentId()));
+    partial->setValue(fa, StringFieldValue("foo"));
+    StorageDocument sdoc2(std::move(partial), fpmap, 3);
+    EXPECT_EQUAL(std::string("foo"), sdoc2.getField(0)->getAsString());
+    EXPECT_TRUE(sdoc2.getField(1) == nullptr);
+    // missing field is remembered
+    EXPECT_TRUE(sdoc2.getField(1) == nullptr);
+    EXPECT_TRUE(sdoc2.setField(1, FieldValue::UP(new StringFieldValue("qux"))));
+    EXPECT_EQUAL(std::string("qux"), sdoc2.getField(1)->getAsString());
+
     SharedFieldPathMap fim;
     StorageDocument s2(std::make_unique<document::Document>(), fim, 0);
     EXPECT_EQUAL(IdString().toString(), s2.docDoc().getId().toString());
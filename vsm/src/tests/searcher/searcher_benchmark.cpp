@@ -0,0 +1,92 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vsm/searcher/futf8strchrfieldsearcher.h>
+#include <vespa/vsm/searcher/utf8strchrfieldsearcher.h>
+#include <vespa/vsm/searcher/utf8substringsearcher.h>
+#include <vespa/searchlib/query/streaming/queryterm.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <random>
+
+using namespace vsm;
+using search::streaming::QueryNodeResultFactory;
+using search::streaming::QueryTerm;
+using search::streaming::QueryTermList;
+using vespalib::BenchmarkTimer;
+
+const double budget = 2.0;
+
+std::string make_text(size_t num_words, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<size_t> word_len(2, 10);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::string text;
+    for (size_t i = 0; i < num_words; ++i) {
+        if (i > 0) {
+            text.push_back(' ');
+        }
+        for (size_t len = word_len(gen); len > 0; --len) {
+            text.push_back('a' + letter(gen));
+        }
+    }
+    return text;
+}
+
+struct Query {
+    QueryNodeResultFactory factory;
+    std::vector<QueryTerm> terms;
+    QueryTermList list;
+    Query(size_t num_terms, QueryTerm::SearchTerm type) : factory(), terms(), list() {
+        std::mt19937 gen(num_terms);
+        std::uniform_int_distribution<int> letter(0, 25);
+        for (size_t i = 0; i < num_terms; ++i) {
+            std::string term;
+            for (size_t j = 0; j < 4; ++j) {
+                term.push_back('a' + letter(gen));
+            }
+            terms.emplace_back(factory.create(), term, "index", type);
+        }
+        for (auto &term: terms) {
+            list.push_back(&term);
+        }
+    }
+};
+
+void benchmark(const vespalib::string &name, FieldSearcher &searcher, QueryTerm::SearchTerm type,
+               size_t num_words, size_t num_terms)
+{
+    Query query(num_terms, type);
+    SharedSearcherBuf buf(new SearcherBuf());
+    searcher.prepare(query.list, buf);
+    SharedFieldPathMap field_paths(new FieldPathMapT());
+    field_paths->push_back(FieldPath());
+    StorageDocument doc(std::make_unique<document::Document>(), field_paths, 1);
+    doc.setField(0, std::make_unique<document::StringFieldValue>(make_text(num_words, 42)));
+    auto fun = [&]() {
+        searcher.search(doc);
+        for (auto &term: query.terms) {
+            term.reset();
+        }
+    };
+    double seconds = BenchmarkTimer::benchmark(fun, budget);
+    size_t bytes = doc.getField(0)->getAsString().size();
+    fprintf(stderr, "%-12s words=%6zu terms=%3zu: %10.3f us/doc, %8.1f MB/s\n", name.c_str(),
+            num_words, num_terms, seconds * 1000000.0, (bytes / seconds) / 1000000.0);
+}
+
+TEST("benchmark streaming string field searchers") {
+    for (size_t num_words: {100, 1000, 10000}) {
+        for (size_t num_terms: {1, 4, 16}) {
+            UTF8SubStringFieldSearcher substring(0);
+            benchmark("substring", substring, QueryTerm::SUBSTRINGTERM, num_words, num_terms);
+            UTF8StrChrFieldSearcher strchr(0);
+            benchmark("utf8 strchr", strchr, QueryTerm::WORD, num_words, num_terms);
+            FUTF8StrChrFieldSearcher fstrchr(0);
+            benchmark("futf8 strchr", fstrchr, QueryTerm::WORD, num_words, num_terms);
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
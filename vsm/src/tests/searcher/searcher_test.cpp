@@ -537,6 +537,19 @@ TEST("utf8 substring search") {
     }
 }
 
+TEST("utf8 substring search with many terms over long field") {
+    UTF8SubStringFieldSearcher fs(0);
+    std::string field = "the quick brown fox jumps over the lazy dog while zebras yawn";
+    assertString(fs, StringList().add("own").add("azy").add("yawn").add("ebra"),
+                 field, HitsList().add(Hits().add(2)).add(Hits().add(7)).add(Hits().add(11)).add(Hits().add(10)));
+    // more distinct first characters than handled by the first character filter
+    assertString(fs, StringList().add("qu").add("br").add("fo").add("ju").add("ov").add("la")
+                                 .add("do").add("wh").add("ze").add("ya"),
+                 field, HitsList().add(Hits().add(1)).add(Hits().add(2).add(10)).add(Hits().add(3)).add(Hits().add(4))
+                                  .add(Hits().add(5)).add(Hits().add(7)).add(Hits().add(8)).add(Hits().add(9))
+                                  .add(Hits().add(10)).add(Hits().add(11)));
+}
+
 TEST("utf8 substring search with empty term")
 {
     UTF8SubStringFieldSearcher fs(0);
@@ -16,6 +16,7 @@ StorageDocument::StorageDocument(document::Document::UP doc, const SharedFieldPa
     _doc(std::move(doc)),
     _fieldMap(fim),
     _cachedFields(getFieldCount()),
+    _lookedUpFields(getFieldCount(), false),
     _backedFields()
 { }
 
@@ -32,6 +33,11 @@ StorageDocument::getComplexField(FieldIdT fId) const
     if (_cachedFields[fId].getFieldValue() == NULL) {
         const FieldPath & fp = (*_fieldMap)[fId];
         if ( ! fp.empty() ) {
+            if (_lookedUpFields[fId]) {
+                // Field not present in document, no need to look it up again.
+                return _cachedFields[fId];
+            }
+            _lookedUpFields[fId] = true;
             const document::StructuredFieldValue * sfv = _doc.get();
             NestedIterator nested = fp.getFullRange();
             const document::FieldPathEntry& fvInfo = nested.cur();
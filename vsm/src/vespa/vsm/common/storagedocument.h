@@ -52,6 +52,7 @@ private:
     document::Document::UP _doc;
     SharedFieldPathMap     _fieldMap;
     mutable std::vector<SubDocument> _cachedFields;
+    mutable std::vector<bool> _lookedUpFields;
     mutable std::vector<document::FieldValue::UP> _backedFields;
 };
 
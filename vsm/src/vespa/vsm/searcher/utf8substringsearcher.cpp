@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/vsm/searcher/utf8substringsearcher.h>
+#include <cstring>
 
 using search::byte;
 using search::streaming::QueryTerm;
@@ -8,6 +9,76 @@ using search::streaming::QueryTermList;
 
 namespace vsm {
 
+namespace {
+
+/**
+ * Filter on the first character of the query terms, used to avoid
+ * comparing all terms at positions where none of them can start.
+ * Candidate positions are found 16 characters at a time using
+ * vector compares against each distinct first character.
+ **/
+class FirstCharFilter
+{
+    typedef uint32_t v4u32 __attribute__((vector_size(16)));
+    static constexpr size_t MAX_CHARS = 8;
+    v4u32  _chars[MAX_CHARS];
+    size_t _num_chars;
+    bool   _all;
+public:
+    static constexpr size_t BLOCK_SIZE = 16;
+    FirstCharFilter() : _chars(), _num_chars(0), _all(false) {}
+    void add(const cmptype_t * term, size_t tsz) {
+        if (tsz == 0) {
+            _all = true;
+            return;
+        }
+        for (size_t i = 0; i < _num_chars; ++i) {
+            if (_chars[i][0] == term[0]) {
+                return;
+            }
+        }
+        if (_num_chars == MAX_CHARS) {
+            _all = true;
+            return;
+        }
+        _chars[_num_chars++] = v4u32{term[0], term[0], term[0], term[0]};
+    }
+    // Returns a bit mask of the positions among the 'sz' (<= BLOCK_SIZE)
+    // next characters where a term may start.
+    uint32_t candidates(const cmptype_t * p, size_t sz) const {
+        if (_all) {
+            return 0xffff;
+        }
+        uint32_t mask = 0;
+        if (sz == BLOCK_SIZE) {
+            v4u32 v[4];
+            memcpy(v, p, sizeof(v));
+            v4u32 hit[4] = {};
+            for (size_t i = 0; i < _num_chars; ++i) {
+                for (size_t j = 0; j < 4; ++j) {
+                    hit[j] |= (v4u32)(v[j] == _chars[i]);
+                }
+            }
+            for (size_t j = 0; j < 4; ++j) {
+                for (size_t k = 0; k < 4; ++k) {
+                    mask |= (hit[j][k] & 1u) << (j * 4 + k);
+                }
+            }
+        } else {
+            for (size_t k = 0; k < sz; ++k) {
+                for (size_t i = 0; i < _num_chars; ++i) {
+                    if (p[k] == _chars[i][0]) {
+                        mask |= 1u << k;
+                    }
+                }
+            }
+        }
+        return mask;
+    }
+};
+
+}
+
 std::unique_ptr<FieldSearcher>
 UTF8SubStringFieldSearcher::duplicate() const
 {
@@ -27,17 +98,33 @@ UTF8SubStringFieldSearcher::matchTerms(const FieldRef & f, const size_t mintsz)
     const cmptype_t * fn(fntemp);
     const cmptype_t * fe = fn + fl;
     const cmptype_t * fre = fe - mintsz;
+    FirstCharFilter filter;
+    for (QueryTerm * qt : _qtl) {
+        const cmptype_t * term;
+        termsize_t tsz = qt->term(term);
+        filter.add(term, tsz);
+    }
+    const cmptype_t * block(fn);
+    const cmptype_t * block_end(fn);
+    uint32_t candidates(0);
     termcount_t words(0);
     for(words = 0; fn <= fre; ) {
-        for(QueryTermList::iterator it=_qtl.begin(), mt=_qtl.end(); it != mt; it++) {
-            QueryTerm & qt = **it;
-            const cmptype_t * term;
-            termsize_t tsz = qt.term(term);
-
-            const cmptype_t *tt=term, *et=term+tsz, *fnt=fn;
-            for (; (tt < et) && (*tt == *fnt); tt++, fnt++);
-            if (tt == et) {
-                addHit(qt, words);
+        if (fn >= block_end) {
+            block = fn;
+            block_end = fn + std::min(size_t(fe - fn), FirstCharFilter::BLOCK_SIZE);
+            candidates = filter.candidates(block, block_end - block);
+        }
+        if (candidates & (1u << (fn - block))) {
+            for(QueryTermList::iterator it=_qtl.begin(), mt=_qtl.end(); it != mt; it++) {
+                QueryTerm & qt = **it;
+                const cmptype_t * term;
+                termsize_t tsz = qt.term(term);
+
+                const cmptype_t *tt=term, *et=term+tsz, *fnt=fn;
+                for (; (tt < et) && (*tt == *fnt); tt++, fnt++);
+                if (tt == et) {
+                    addHit(qt, words);
+                }
             }
         }
         if ( ! Fast_UnicodeUtil::IsWordChar(*fn++) ) {